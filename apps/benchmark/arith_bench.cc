@@ -0,0 +1,224 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file arith_bench.cc
+ * \brief Microbenchmark of the arithmetic analyzers over a corpus of index expressions.
+ *
+ *  Usage: arith_bench [--corpus corpus.json] [--repeat N] [--filter name]
+ *
+ *  The corpus is the JSON written by arith_harvest.py, a map with the "exprs" to analyze
+ *  and the "ranges" of their loop variables. Without it, a synthetic corpus of fused, split,
+ *  tiled and convolution window indices is used.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/int_set.h>
+#include <tvm/arith/iter_affine_map.h>
+#include <tvm/node/serialization.h>
+#include <tvm/runtime/memory.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/op.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace tvm;
+using namespace tvm::tir;
+
+struct Corpus {
+  Array<PrimExpr> exprs;
+  Map<Var, Range> ranges;
+};
+
+// Index expressions in the shapes that the lowering of common operators produces.
+Corpus SyntheticCorpus() {
+  Corpus corpus;
+  std::vector<PrimExpr> exprs;
+  Var n("n");
+  corpus.ranges.Set(n, Range(1, 1024));
+  auto loop = [&](const std::string& name, int extent) {
+    Var var(name);
+    corpus.ranges.Set(var, Range(0, extent));
+    return var;
+  };
+  for (int factor : {2, 4, 8, 16, 32}) {
+    std::string suffix = std::to_string(factor);
+    // fused and split loops
+    int hw = factor * 7;
+    Var fused = loop("fused" + suffix, 64 * hw * hw);
+    exprs.push_back(floordiv(fused, hw * hw));
+    exprs.push_back(floormod(floordiv(fused, hw), hw));
+    exprs.push_back(floormod(fused, hw));
+    Var outer = loop("outer" + suffix, 256 / factor);
+    Var inner = loop("inner" + suffix, factor);
+    Var vec = loop("vec" + suffix, 4);
+    exprs.push_back(outer * factor + inner);
+    exprs.push_back((outer * factor + inner) * 4 + vec);
+    exprs.push_back(floordiv(outer * factor + inner, 4));
+    exprs.push_back(floormod((outer * factor + inner) * 4 + vec, 16));
+    exprs.push_back(outer * factor + inner < 250);
+    // convolution windows
+    Var oh = loop("oh" + suffix, hw);
+    Var kh = loop("kh" + suffix, 3);
+    exprs.push_back(oh * 2 + kh - 1);
+    exprs.push_back(if_then_else(1 <= oh * 2 + kh && oh * 2 + kh < hw * 2 + 1,
+                                 oh * 2 + kh - 1, 0));
+    exprs.push_back(floordiv(oh * 2 + kh, factor) * factor + floormod(oh * 2 + kh, factor));
+    // symbolic shapes
+    exprs.push_back(floordiv(n + factor - 1, factor) * factor);
+    exprs.push_back(min(outer * factor + inner, n - 1));
+    exprs.push_back(floordiv(outer * n + inner, n));
+    exprs.push_back(floormod(inner + n * factor, n));
+    exprs.push_back(max(outer * factor + inner - n, 0) + vec * n);
+  }
+  corpus.exprs = exprs;
+  return corpus;
+}
+
+Corpus LoadCorpus(const std::string& path) {
+  std::ifstream fs(path);
+  ICHECK(fs) << "Cannot open " << path;
+  std::stringstream ss;
+  ss << fs.rdbuf();
+  Map<String, ObjectRef> data = Downcast<Map<String, ObjectRef>>(LoadJSON(ss.str()));
+  Corpus corpus;
+  corpus.exprs = Downcast<Array<PrimExpr>>(data.at("exprs"));
+  corpus.ranges = Downcast<Map<Var, Range>>(data.at("ranges"));
+  return corpus;
+}
+
+// The ranges of the variables used by an expression.
+Map<Var, Range> UsedRanges(const PrimExpr& expr, const Map<Var, Range>& ranges) {
+  Map<Var, Range> used;
+  for (const Var& var : UndefinedVars(expr)) {
+    if (Optional<Range> range = ranges.Get(var)) {
+      used.Set(var, range.value());
+    }
+  }
+  return used;
+}
+
+void Run(const std::string& name, const Corpus& corpus, int repeat,
+         const std::function<void(size_t)>& fsetup, const std::function<void(size_t)>& frun) {
+  size_t num_exprs = corpus.exprs.size();
+  // warm up
+  fsetup(0);
+  for (size_t i = 0; i < num_exprs; ++i) frun(i);
+  runtime::ObjectPoolStats before = runtime::GetObjectPoolStats();
+  std::chrono::steady_clock::duration elapsed{0};
+  for (int r = 0; r < repeat; ++r) {
+    fsetup(r + 1);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_exprs; ++i) frun(i);
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+  runtime::ObjectPoolStats after = runtime::GetObjectPoolStats();
+  double calls = static_cast<double>(num_exprs) * repeat;
+  double ns = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(elapsed).count();
+  std::printf("%-24s %12.0f calls/s %12.1f ns/call %10.1f allocs/call\n", name.c_str(),
+              calls / ns * 1e9, ns / calls, (after.num_allocs - before.num_allocs) / calls);
+}
+
+int main(int argc, char** argv) {
+  std::string corpus_path, filter;
+  int repeat = 20;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--corpus") && i + 1 < argc) {
+      corpus_path = argv[++i];
+    } else if (!std::strcmp(argv[i], "--repeat") && i + 1 < argc) {
+      repeat = std::atoi(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::fprintf(stderr, "Usage: %s [--corpus corpus.json] [--repeat N] [--filter name]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+  Corpus corpus = corpus_path.empty() ? SyntheticCorpus() : LoadCorpus(corpus_path);
+  std::printf("%zu expressions, %zu variables, %d repeats\n", corpus.exprs.size(),
+              static_cast<size_t>(corpus.ranges.size()), repeat);
+
+  std::vector<Map<Var, Range>> used_ranges;
+  Map<Var, arith::IntSet> dom_map;
+  for (const PrimExpr& expr : corpus.exprs) {
+    used_ranges.push_back(UsedRanges(expr, corpus.ranges));
+  }
+  for (const auto& kv : corpus.ranges) {
+    dom_map.Set(kv.first, arith::IntSet::FromRange(kv.second));
+  }
+
+  // A fresh analyzer every repeat, so that the memoized bounds are not reused.
+  std::unique_ptr<arith::Analyzer> analyzer;
+  auto fbind = [&](size_t) {
+    analyzer = std::make_unique<arith::Analyzer>();
+    analyzer->Bind(corpus.ranges);
+  };
+  const runtime::PackedFunc* fclear_iter_map_cache =
+      runtime::Registry::Get("arith.ClearIterMapCache");
+  // Only cleared before the warm up, so the timed repeats hit the cache.
+  auto fclear = [&](size_t r) {
+    if (r == 0 && fclear_iter_map_cache) (*fclear_iter_map_cache)();
+  };
+  auto fdetect = [&](arith::Analyzer* ana, size_t i) {
+    const PrimExpr& expr = corpus.exprs[i];
+    if (expr.dtype().is_bool()) return;
+    arith::DetectIterMap({expr}, used_ranges[i], const_true(), arith::IterMapLevel::Surjective,
+                         ana);
+  };
+
+  struct Case {
+    std::string name;
+    std::function<void(size_t)> fsetup;
+    std::function<void(size_t)> frun;
+  };
+  std::vector<Case> cases = {
+      {"RewriteSimplifier", fbind,
+       [&](size_t i) { analyzer->rewrite_simplify(corpus.exprs[i]); }},
+      {"CanonicalSimplifier", fbind,
+       [&](size_t i) { analyzer->canonical_simplify(corpus.exprs[i]); }},
+      {"Simplify", fbind, [&](size_t i) { analyzer->Simplify(corpus.exprs[i]); }},
+      {"ConstIntBoundAnalyzer", fbind,
+       [&](size_t i) { analyzer->const_int_bound(corpus.exprs[i]); }},
+      {"ModularSetAnalyzer", fbind, [&](size_t i) { analyzer->modular_set(corpus.exprs[i]); }},
+      {"IntSet", fbind, [&](size_t i) { analyzer->int_set(corpus.exprs[i], dom_map); }},
+      // A bound analyzer never uses the cache of DetectIterMap.
+      {"DetectIterMap", fbind, [&](size_t i) { fdetect(analyzer.get(), i); }},
+      {"DetectIterMap(cached)", fclear,
+       [&](size_t i) {
+         arith::Analyzer ana;
+         fdetect(&ana, i);
+       }},
+  };
+  for (const Case& c : cases) {
+    if (filter.empty() || c.name.find(filter) != std::string::npos) {
+      Run(c.name, corpus, repeat, c.fsetup, c.frun);
+    }
+  }
+  return 0;
+}
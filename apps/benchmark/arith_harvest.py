@@ -0,0 +1,95 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Harvest the index expressions of a model for arith_bench.
+
+The model is built for llvm, and the buffer indices and loop ranges of every PrimFunc are
+collected after each TIR pass. The corpus is saved as the JSON that arith_bench loads.
+"""
+import argparse
+
+import tvm
+from tvm import relay
+from tvm.relay import testing
+
+
+def get_network(name, batch_size):
+    """Get the relay module of a network from relay.testing."""
+    if name.startswith("resnet"):
+        num_layers = int(name.split("-")[1])
+        mod, params = testing.resnet.get_workload(num_layers=num_layers, batch_size=batch_size)
+    elif name == "mobilenet":
+        mod, params = testing.mobilenet.get_workload(batch_size=batch_size)
+    elif name == "inception_v3":
+        mod, params = testing.inception_v3.get_workload(batch_size=batch_size)
+    else:
+        raise ValueError("Unsupported network: " + name)
+    return mod, params
+
+
+@tvm.instrument.pass_instrument
+class HarvestIndices:
+    """Collect the buffer indices and loop ranges of the PrimFuncs after every pass."""
+
+    def __init__(self, max_exprs):
+        self.max_exprs = max_exprs
+        self.exprs = []
+        self.hashes = set()
+        self.ranges = {}
+
+    def add(self, expr):
+        if len(self.exprs) >= self.max_exprs or isinstance(expr, (tvm.tir.IntImm, tvm.tir.Var)):
+            return
+        key = tvm.ir.structural_hash(expr)
+        if key not in self.hashes:
+            self.hashes.add(key)
+            self.exprs.append(expr)
+
+    def visit(self, node):
+        if isinstance(node, (tvm.tir.BufferLoad, tvm.tir.BufferStore)):
+            for index in node.indices:
+                self.add(index)
+        elif isinstance(node, tvm.tir.For):
+            self.ranges[node.loop_var] = tvm.ir.Range.from_min_extent(node.min, node.extent)
+        elif isinstance(node, tvm.tir.IfThenElse):
+            self.add(node.condition)
+
+    def run_after_pass(self, mod, info):
+        for func in mod.functions.values():
+            if isinstance(func, tvm.tir.PrimFunc):
+                tvm.tir.stmt_functor.post_order_visit(func.body, self.visit)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--network", default="resnet-18")
+    parser.add_argument("--batch-size", type=int, default=1)
+    parser.add_argument("--max-exprs", type=int, default=100000)
+    parser.add_argument("--output", default="arith_corpus.json")
+    args = parser.parse_args()
+
+    mod, params = get_network(args.network, args.batch_size)
+    harvest = HarvestIndices(args.max_exprs)
+    with tvm.transform.PassContext(opt_level=3, instruments=[harvest]):
+        relay.build(mod, target="llvm", params=params)
+    corpus = {"exprs": harvest.exprs, "ranges": harvest.ranges}
+    with open(args.output, "w") as f:
+        f.write(tvm.ir.save_json(corpus))
+    print("%d expressions, %d loops" % (len(harvest.exprs), len(harvest.ranges)))
+
+
+if __name__ == "__main__":
+    main()
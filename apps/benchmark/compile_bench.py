@@ -0,0 +1,253 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Compile time of relay.build by phase, and of the meta schedule tuning loop.
+
+Each model is compiled for each target in a fresh process, so that the peak memory of a case
+does not include the ones before it. A pass instrument charges the time of every pass, minus
+the time of the passes nested in it, to the phase of the pass: FoldConstant, FuseOps, the
+lowering of the operators by the TE compiler, the TIR passes, or the other passes. The time
+spent outside of any pass, mostly the LLVM or CUDA code generation, is the codegen phase.
+"""
+import argparse
+import json
+import multiprocessing
+import os
+import resource
+import tempfile
+import time
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.ir.instrument import pass_instrument
+from tvm.relay import testing
+
+PHASES = ["FoldConstant", "FuseOps", "LowerTE", "TIR", "other_passes", "codegen"]
+
+
+def phase_of(pass_name):
+    if pass_name in ("FoldConstant", "FuseOps", "LowerTE"):
+        return pass_name
+    if pass_name.startswith("tir."):
+        return "TIR"
+    return "other_passes"
+
+
+def current_rss_mb():
+    """The resident memory of the process, or its peak where /proc is not available."""
+    try:
+        with open("/proc/self/statm") as f:
+            return int(f.read().split()[1]) * os.sysconf("SC_PAGE_SIZE") / 2**20
+    except OSError:
+        return peak_rss_mb()
+
+
+def peak_rss_mb():
+    # ru_maxrss is in kilobytes on Linux.
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 2**10
+
+
+@pass_instrument
+class PhaseTimer:
+    """Charge the self time of each pass to its phase, and track the peak memory of the phases."""
+
+    def __init__(self):
+        self.seconds = {phase: 0.0 for phase in PHASES}
+        self.peak_mb = {phase: 0.0 for phase in PHASES}
+        self.top_level_seconds = 0.0
+        # The start time and the time of the nested passes of each running pass.
+        self._stack = []
+
+    def run_before_pass(self, mod, info):
+        self._stack.append([time.perf_counter(), 0.0])
+
+    def run_after_pass(self, mod, info):
+        start, nested = self._stack.pop()
+        elapsed = time.perf_counter() - start
+        phase = phase_of(info.name)
+        self.seconds[phase] += elapsed - nested
+        self.peak_mb[phase] = max(self.peak_mb[phase], current_rss_mb())
+        if self._stack:
+            self._stack[-1][1] += elapsed
+        else:
+            self.top_level_seconds += elapsed
+
+
+def transformer_block(data, prefix, num_heads, hidden, ffn, gated):
+    """A pre-norm transformer block on data of shape [seq_len, hidden]."""
+
+    def dense(x, name, units, bias=True):
+        y = relay.nn.dense(x, relay.var(name + "_weight"), units=units)
+        return relay.nn.bias_add(y, relay.var(name + "_bias"), axis=-1) if bias else y
+
+    def layer_norm(x, name):
+        return relay.nn.layer_norm(x, relay.var(name + "_gamma"), relay.var(name + "_beta"))
+
+    head_dim = hidden // num_heads
+    x = layer_norm(data, prefix + "ln1")
+
+    def heads(name):
+        y = dense(x, prefix + name, hidden, bias=not gated)
+        y = relay.reshape(y, (-1, num_heads, head_dim))
+        return relay.transpose(y, (1, 0, 2))
+
+    q, k, v = heads("q"), heads("k"), heads("v")
+    scores = relay.nn.batch_matmul(q, k) * relay.const(1.0 / np.sqrt(head_dim))
+    probs = relay.nn.softmax(scores)
+    attn = relay.nn.batch_matmul(probs, relay.transpose(v, (0, 2, 1)))
+    attn = relay.reshape(relay.transpose(attn, (1, 0, 2)), (-1, hidden))
+    data = data + dense(attn, prefix + "o", hidden, bias=not gated)
+
+    x = layer_norm(data, prefix + "ln2")
+    if gated:
+        gate = dense(x, prefix + "gate", ffn, bias=False)
+        up = dense(x, prefix + "up", ffn, bias=False)
+        x = gate * relay.sigmoid(gate) * up
+    else:
+        x = dense(x, prefix + "fc1", ffn)
+        x = x * relay.const(0.5) * (relay.const(1.0) + relay.erf(x * relay.const(0.5**0.5)))
+    return data + dense(x, prefix + "fc2", hidden, bias=not gated)
+
+
+def transformer(num_layers, seq_len, num_heads, hidden, ffn, gated=False):
+    data = relay.var("data", shape=(seq_len, hidden))
+    out = data
+    for i in range(num_layers):
+        out = transformer_block(out, "layer%d_" % i, num_heads, hidden, ffn, gated)
+    return testing.create_workload(relay.Function(relay.analysis.free_vars(out), out))
+
+
+def get_model(name):
+    """Return the module and the parameters of a model."""
+    if name == "resnet-50":
+        return testing.resnet.get_workload(num_layers=50, batch_size=1)
+    if name == "mobilenet-int8":
+        mod, params = testing.mobilenet.get_workload(batch_size=1)
+        with relay.quantize.qconfig(calibrate_mode="global_scale", global_scale=8.0):
+            return relay.quantize.quantize(mod, params), {}
+    if name == "bert-base":
+        return transformer(num_layers=12, seq_len=128, num_heads=12, hidden=768, ffn=3072)
+    if name == "llm-block":
+        # A decoder block of a 7B parameter model with a gated FFN, on a 2048 token prompt.
+        return transformer(1, seq_len=2048, num_heads=32, hidden=4096, ffn=11008, gated=True)
+    raise ValueError("Unknown model " + name)
+
+
+def compile_case(model, target):
+    """Compile a model in the calling process, and return the time and memory of each phase."""
+    mod, params = get_model(model)
+    timer = PhaseTimer()
+    start = time.perf_counter()
+    with tvm.transform.PassContext(opt_level=3, instruments=[timer]):
+        relay.build(mod, target=target, params=params)
+    total = time.perf_counter() - start
+    seconds = dict(timer.seconds)
+    seconds["codegen"] = total - timer.top_level_seconds
+    peak_mb = dict(timer.peak_mb)
+    peak_mb["codegen"] = current_rss_mb()
+    return {"total": total, "seconds": seconds, "peak_mb": peak_mb, "peak_rss_mb": peak_rss_mb()}
+
+
+def tune_case(model, target, trials):
+    """Tune a model with meta schedule, and return the tuning time per trial."""
+    # pylint: disable=import-outside-toplevel
+    from tvm import meta_schedule as ms
+
+    mod, params = get_model(model)
+    with tempfile.TemporaryDirectory() as work_dir:
+        start = time.perf_counter()
+        ms.relay_integration.tune_relay(
+            mod=mod,
+            params=params,
+            target=target,
+            work_dir=work_dir,
+            max_trials_global=trials,
+            num_trials_per_iter=min(trials, 64),
+        )
+        total = time.perf_counter() - start
+    return {"total": total, "per_trial": total / trials, "peak_rss_mb": peak_rss_mb()}
+
+
+def run_in_fresh_process(func, *args):
+    with multiprocessing.get_context("spawn").Pool(1) as pool:
+        return pool.apply(func, args)
+
+
+def entry(name, seconds, **counters):
+    ms = seconds * 1e3
+    result = {"name": name, "run_name": name, "run_type": "iteration", "iterations": 1}
+    result.update({"real_time": ms, "cpu_time": ms, "time_unit": "ms"})
+    result.update(counters)
+    return result
+
+
+def write_json(path, entries):
+    context = {
+        "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "num_cpus": multiprocessing.cpu_count(),
+        "tvm_version": tvm.__version__,
+        "time_unit": "ms",
+    }
+    with open(path, "w") as f:
+        json.dump({"context": context, "benchmarks": entries}, f, indent=2)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--models", default="resnet-50,bert-base,llm-block,mobilenet-int8", help="comma separated"
+    )
+    parser.add_argument("--targets", default="llvm,cuda", help="comma separated")
+    parser.add_argument(
+        "--tune-trials", type=int, default=0, help="meta schedule trials per model, on llvm"
+    )
+    parser.add_argument("--json", help="write the results in the format of Google Benchmark")
+    args = parser.parse_args()
+
+    entries = []
+    for target in args.targets.split(","):
+        if not tvm.runtime.enabled(target):
+            print("skip %s: not enabled in this build" % target)
+            continue
+        for model in args.models.split(","):
+            result = run_in_fresh_process(compile_case, model, target)
+            name = "%s/%s" % (model, target)
+            total, peak = result["total"], result["peak_rss_mb"]
+            print("%-28s total %8.2f s  peak %8.1f MB" % (name, total, peak))
+            entries.append(entry(name + "/total", total, peak_rss_mb=peak))
+            for phase in PHASES:
+                seconds, peak = result["seconds"][phase], result["peak_mb"][phase]
+                print("  %-14s %8.2f s  peak %8.1f MB" % (phase, seconds, peak))
+                entries.append(entry("%s/phase:%s" % (name, phase), seconds, peak_rss_mb=peak))
+
+    if args.tune_trials > 0:
+        for model in args.models.split(","):
+            target = "llvm -num-cores %d" % multiprocessing.cpu_count()
+            result = run_in_fresh_process(tune_case, model, target, args.tune_trials)
+            name = "%s/llvm/tune" % model
+            print("%-28s %8.3f s per trial" % (name, result["per_trial"]))
+            entries.append(
+                entry(name + "/trial", result["per_trial"], peak_rss_mb=result["peak_rss_mb"])
+            )
+
+    if args.json:
+        write_json(args.json, entries)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Startup time of the graph executor with the JSON and the binary graph formats.
+
+The graph is a synthetic chain of tiny kernels, so that loading the graph dominates the
+creation of the executor rather than allocating storage.
+"""
+import argparse
+import json
+import time
+
+import tvm
+from tvm import te
+from tvm.contrib import graph_executor
+
+
+def build_graph(num_nodes):
+    n = 4
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda *i: A(*i) + 1.0, name="B")
+    lib = tvm.build(te.create_schedule(B.op), [A, B], "llvm", name="myadd")
+
+    nodes = [{"op": "null", "name": "x", "inputs": []}]
+    for i in range(num_nodes):
+        attrs = {"func_name": "myadd", "flatten_data": "1", "num_inputs": "1", "num_outputs": "1"}
+        nodes.append({"op": "tvm_op", "name": "add%d" % i, "inputs": [[i, 0, 0]], "attrs": attrs})
+    num_entries = num_nodes + 1
+    graph = {
+        "nodes": nodes,
+        "arg_nodes": [0],
+        "node_row_ptr": list(range(num_entries + 1)),
+        "heads": [[num_nodes, 0, 0]],
+        "attrs": {
+            "shape": ["list_shape", [[n]] * num_entries],
+            "dltype": ["list_str", ["float32"] * num_entries],
+            # Two alternating storages, as planned for a chain.
+            "storage_id": ["list_int", [0] + [1 + i % 2 for i in range(num_nodes)]],
+        },
+    }
+    return json.dumps(graph), lib
+
+
+def time_create(graph, lib, repeat):
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        graph_executor.create(graph, lib, tvm.cpu(0))
+        best = min(best, time.perf_counter() - start)
+    return best * 1e3
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--num-nodes", type=int, default=20000)
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    graph_json, lib = build_graph(args.num_nodes)
+    graph_binary = tvm.get_global_func("tvm.graph_executor.json_to_binary")(graph_json)
+    print("nodes: %d" % args.num_nodes)
+    for name, graph in [("json", graph_json), ("binary", graph_binary)]:
+        ms = time_create(graph, lib, args.repeat)
+        print("%-6s %10d bytes  %8.2f ms" % (name, len(graph), ms))
@@ -0,0 +1,87 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Throughput of the Relay text parser on a large model.
+
+The model is printed once, then parsed back with the default options, without spans, and with
+the global functions parsed in parallel. The times include the type inference of the parsed
+module, which is the same for all of the options.
+"""
+import argparse
+import time
+
+import tvm
+from tvm import relay
+from tvm.relay import testing
+
+
+class Outline(relay.ExprMutator):
+    """Split a model into one global function per fused operator, like a lowered model."""
+
+    def __init__(self):
+        super().__init__()
+        self.funcs = {}
+
+    def visit_function(self, fn):
+        new_fn = super().visit_function(fn)
+        if fn.attrs is not None and "Primitive" in fn.attrs:
+            gvar = relay.GlobalVar("fused_%d" % len(self.funcs))
+            self.funcs[gvar] = new_fn.without_attr("Primitive")
+            return gvar
+        return new_fn
+
+    def outline(self, mod):
+        self.funcs[mod.get_global_var("main")] = self.visit(mod["main"])
+        return relay.transform.InferType()(tvm.IRModule(self.funcs))
+
+
+def get_text(network, batch_size):
+    if network == "inception_v3":
+        mod, _ = testing.inception_v3.get_workload(batch_size=batch_size)
+    else:
+        mod, _ = testing.resnet.get_workload(num_layers=50, batch_size=batch_size)
+    mod = relay.transform.InferType()(mod)
+    mod = relay.transform.FuseOps(fuse_opt_level=2)(mod)
+    return Outline().outline(mod).astext(show_meta_data=False)
+
+
+def time_parse(text, repeat, **kwargs):
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        relay.parse(text, **kwargs)
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--network", choices=["resnet-50", "inception_v3"], default="resnet-50")
+    parser.add_argument("--batch-size", type=int, default=1)
+    parser.add_argument("--num-threads", type=int, default=0)
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    source = get_text(args.network, args.batch_size)
+    mb = len(source) / 1e6
+    print("%s: %.2f MB of text" % (args.network, mb))
+    for name, options in [
+        ("default", {}),
+        ("no spans", {"track_spans": False}),
+        ("parallel", {"track_spans": False, "num_threads": args.num_threads}),
+    ]:
+        seconds = time_parse(source, args.repeat, **options)
+        print("%-10s %8.3f s  %8.2f MB/s" % (name, seconds, mb / seconds))
@@ -0,0 +1,435 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime_bench.cc
+ * \brief Microbenchmarks of the hot paths of the runtime.
+ *
+ *  Usage: runtime_bench [--filter name] [--min_time seconds] [--json out.json]
+ *
+ *  Each case runs for at least min_time seconds after a warm up. The JSON output follows the
+ *  format of Google Benchmark, so that the results of two commits can be compared by its
+ *  compare.py script. The RPC round trip is only measured when TVM is built with USE_RPC.
+ */
+#include <sys/socket.h>
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/bytecode.h>
+#include <tvm/runtime/vm/executable.h>
+#include <tvm/runtime/vm/vm.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if TVM_RUNTIME_BENCH_RPC
+#include "../../src/runtime/rpc/rpc_endpoint.h"
+#endif
+
+using namespace tvm;
+using namespace tvm::runtime;
+
+namespace {
+
+struct Case {
+  std::string name;
+  /*! \brief Run the case the given number of times. */
+  std::function<void(int64_t)> frun;
+  /*! \brief The number of items, e.g. instructions or operators, processed by one run. */
+  int64_t items_per_run{1};
+};
+
+struct Result {
+  std::string name;
+  int64_t iterations;
+  double ns_per_run;
+  int64_t items_per_run;
+};
+
+Result Measure(const Case& c, double min_time) {
+  using Clock = std::chrono::steady_clock;
+  auto time = [&](int64_t n) {
+    auto start = Clock::now();
+    c.frun(n);
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  };
+  // warm up
+  time(1);
+  int64_t n = 1;
+  double elapsed = time(n);
+  while (elapsed < min_time) {
+    // Aim 40% past the minimum time, at most 10x the previous number of runs.
+    double scale = elapsed > 0 ? min_time * 1.4 / elapsed : 10;
+    n = static_cast<int64_t>(n * std::min(std::max(scale, 1.1), 10.0)) + 1;
+    elapsed = time(n);
+  }
+  return Result{c.name, n, elapsed * 1e9 / n, c.items_per_run};
+}
+
+void WriteJSON(const std::string& path, const std::vector<Result>& results) {
+  std::ofstream os(path);
+  ICHECK(os) << "Cannot open " << path;
+  char date[64];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+  os << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n    \"num_cpus\": "
+     << std::thread::hardware_concurrency() << ",\n    \"time_unit\": \"ns\"\n  },\n"
+     << "  \"benchmarks\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    os << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"run_name\": \"" << r.name
+       << "\", \"run_type\": \"iteration\", \"iterations\": " << r.iterations
+       << ", \"real_time\": " << r.ns_per_run << ", \"cpu_time\": " << r.ns_per_run
+       << ", \"time_unit\": \"ns\", \"items_per_second\": "
+       << r.items_per_run * 1e9 / r.ns_per_run << "}";
+  }
+  os << "\n  ]\n}\n";
+}
+
+/*! \brief A module whose functions do nothing, the kernels of the no-op graph. */
+class NopModule : public ModuleNode {
+ public:
+  const char* type_key() const final { return "NopModule"; }
+  PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
+    return PackedFunc([](TVMArgs args, TVMRetValue* rv) {});
+  }
+};
+
+/*! \return The JSON of a chain of no-op kernels on a single float. */
+std::string NopGraphJSON(int num_ops) {
+  std::ostringstream nodes, row_ptr, storage_id, shape, dltype;
+  nodes << "{\"op\": \"null\", \"name\": \"x\", \"inputs\": []}";
+  for (int i = 0; i < num_ops; ++i) {
+    nodes << ", {\"op\": \"tvm_op\", \"name\": \"nop" << i << "\", \"attrs\": {\"func_name\": "
+          << "\"nop\", \"flatten_data\": \"0\", \"num_inputs\": \"1\", \"num_outputs\": \"1\"}, "
+          << "\"inputs\": [[" << i << ", 0, 0]]}";
+  }
+  for (int i = 0; i <= num_ops; ++i) {
+    const char* sep = i ? ", " : "";
+    row_ptr << sep << i;
+    storage_id << sep << (i == 0 ? 0 : 1 + i % 2);
+    shape << sep << "[1]";
+    dltype << sep << "\"float32\"";
+  }
+  row_ptr << ", " << num_ops + 1;
+  std::ostringstream os;
+  os << "{\"nodes\": [" << nodes.str() << "], \"arg_nodes\": [0], \"node_row_ptr\": ["
+     << row_ptr.str() << "], \"heads\": [[" << num_ops << ", 0, 0]], \"attrs\": {"
+     << "\"storage_id\": [\"list_int\", [" << storage_id.str() << "]], "
+     << "\"shape\": [\"list_shape\", [" << shape.str() << "]], "
+     << "\"dltype\": [\"list_str\", [" << dltype.str() << "]]}}";
+  return os.str();
+}
+
+/*! \return A VM running a straight line of register moves. */
+Module MoveChainVM(int num_moves) {
+  Device cpu{kDLCPU, 0};
+  auto exec = make_object<vm::Executable>();
+  exec->virtual_devices = {cpu};
+  exec->host_device_index = 0;
+  std::vector<vm::Instruction> instrs;
+  instrs.push_back(vm::Instruction::LoadConsti(0, 0));
+  for (int i = 0; i < num_moves; ++i) {
+    instrs.push_back(vm::Instruction::Move(i % 2, (i + 1) % 2));
+  }
+  instrs.push_back(vm::Instruction::Ret(num_moves % 2));
+  exec->functions.emplace_back("main", std::vector<std::string>{}, instrs, 2,
+                               std::vector<vm::Index>{});
+  exec->global_map["main"] = 0;
+  auto vm = make_object<vm::VirtualMachine>();
+  vm->LoadExecutable(exec);
+  Module mod(vm);
+  mod.GetFunction("init")(static_cast<int>(kDLCPU), 0, static_cast<int>(vm::kPooled));
+  return mod;
+}
+
+/*!
+ * \return The serialized bytecode of \p num_funcs functions of \p num_instrs instructions each,
+ *  mixing the common opcodes, in the compact or in the legacy format of the code section.
+ */
+std::string SerializedVM(int num_funcs, int num_instrs, bool compact) {
+  auto exec = make_object<vm::Executable>();
+  exec->virtual_devices = {Device{kDLCPU, 0}};
+  exec->host_device_index = 0;
+  exec->primitive_map["prim"] = 0;
+  for (int f = 0; f < num_funcs; ++f) {
+    std::vector<vm::Instruction> instrs;
+    for (int i = 0; i + 1 < num_instrs; ++i) {
+      switch (i % 6) {
+        case 0:
+          instrs.push_back(vm::Instruction::LoadConsti(i, i % 64));
+          break;
+        case 1:
+          instrs.push_back(vm::Instruction::AllocTensor(0, 0, {1, 3, 224, 224},
+                                                        DLDataType{kDLFloat, 32, 1}, i % 64));
+          break;
+        case 2:
+          instrs.push_back(vm::Instruction::InvokePacked(0, 3, 1, {i % 64, 1, 2}));
+          break;
+        case 3:
+          instrs.push_back(vm::Instruction::If(0, 1, 1, 2));
+          break;
+        case 4:
+          instrs.push_back(vm::Instruction::Goto(1));
+          break;
+        default:
+          instrs.push_back(vm::Instruction::Move(i % 64, (i + 1) % 64));
+      }
+    }
+    instrs.push_back(vm::Instruction::Ret(0));
+    std::string name = "func" + std::to_string(f);
+    exec->functions.emplace_back(name, std::vector<std::string>{}, instrs, 64,
+                                 std::vector<vm::Index>{});
+    exec->global_map[name] = f;
+  }
+  exec->save_compact_code = compact;
+  TVMByteArray bytes = exec->Save();
+  return std::string(bytes.data, bytes.size);
+}
+
+#if TVM_RUNTIME_BENCH_RPC
+/*! \brief A channel over a file descriptor, the client end of the loopback RPC session. */
+class FdChannel final : public RPCChannel {
+ public:
+  explicit FdChannel(int fd) : fd_(fd) {}
+  ~FdChannel() { close(fd_); }
+  size_t Send(const void* data, size_t size) final {
+    ssize_t n = write(fd_, data, size);
+    ICHECK_GE(n, 0) << "Send failed: " << strerror(errno);
+    return static_cast<size_t>(n);
+  }
+  size_t Recv(void* data, size_t size) final {
+    ssize_t n = read(fd_, data, size);
+    ICHECK_GE(n, 0) << "Recv failed: " << strerror(errno);
+    return static_cast<size_t>(n);
+  }
+
+ private:
+  int fd_;
+};
+#endif
+
+int NopParallelLambda(int task_id, TVMParallelGroupEnv* penv, void* cdata) { return 0; }
+
+TVM_REGISTER_GLOBAL("runtime_bench.echo").set_body([](TVMArgs args, TVMRetValue* rv) {
+  *rv = args[0];
+});
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string filter, json_path;
+  double min_time = 0.2;
+  for (int i = 1; i < argc; ++i) {
+    if (!std::strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (!std::strcmp(argv[i], "--min_time") && i + 1 < argc) {
+      min_time = std::atof(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+      json_path = argv[++i];
+    } else {
+      std::fprintf(stderr, "Usage: %s [--filter name] [--min_time seconds] [--json out.json]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+  Device cpu{kDLCPU, 0};
+  DLDataType f32{kDLFloat, 32, 1};
+  std::vector<Case> cases;
+
+  // PackedFunc calls, by arity and by argument type.
+  PackedFunc nop([](TVMArgs args, TVMRetValue* rv) {});
+  PackedFunc ret_int([](TVMArgs args, TVMRetValue* rv) { *rv = 1; });
+  NDArray small = NDArray::Empty({1}, f32, cpu);
+  std::string str(32, 'x');
+  cases.push_back({"PackedFunc/args:0", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop();
+                   }});
+  cases.push_back({"PackedFunc/args:1/int", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop(1);
+                   }});
+  cases.push_back({"PackedFunc/args:4/int", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop(1, 2, 3, 4);
+                   }});
+  cases.push_back({"PackedFunc/args:8/int", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop(1, 2, 3, 4, 5, 6, 7, 8);
+                   }});
+  cases.push_back({"PackedFunc/args:1/float", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop(1.0);
+                   }});
+  cases.push_back({"PackedFunc/args:1/str", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop(str);
+                   }});
+  cases.push_back({"PackedFunc/args:1/NDArray", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) nop(small);
+                   }});
+  cases.push_back({"PackedFunc/args:1/DLTensor", [&](int64_t n) {
+                     DLTensor* tensor = const_cast<DLTensor*>(small.operator->());
+                     for (int64_t i = 0; i < n; ++i) nop(tensor);
+                   }});
+  cases.push_back({"PackedFunc/ret:int", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) {
+                       int ret = ret_int();
+                       (void)ret;
+                     }
+                   }});
+  TypedPackedFunc<int(int, int)> add([](int a, int b) { return a + b; });
+  cases.push_back({"TypedPackedFunc/args:2/int", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) add(1, 2);
+                   }});
+
+  // NDArray allocation and views.
+  for (int64_t bytes : {int64_t{64}, int64_t{1} << 20}) {
+    cases.push_back({"NDArray::Empty/bytes:" + std::to_string(bytes), [=](int64_t n) {
+                       for (int64_t i = 0; i < n; ++i) NDArray::Empty({bytes / 4}, f32, cpu);
+                     }});
+  }
+  NDArray base = NDArray::Empty({1024}, f32, cpu);
+  cases.push_back({"NDArray::CreateView", [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) base.CreateView({32, 32}, f32);
+                   }});
+
+  // Fork-join of the thread pool.
+  int max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    cases.push_back({"TVMBackendParallelLaunch/threads:" + std::to_string(num_threads),
+                     [=](int64_t n) {
+                       for (int64_t i = 0; i < n; ++i) {
+                         TVMBackendParallelLaunch(NopParallelLambda, nullptr, num_threads);
+                       }
+                     }});
+  }
+
+  // The workspace pool, alone and nested as in a kernel with several temporaries.
+  for (uint64_t bytes : {uint64_t{1} << 10, uint64_t{1} << 20}) {
+    cases.push_back({"WorkspacePool/bytes:" + std::to_string(bytes), [=](int64_t n) {
+                       for (int64_t i = 0; i < n; ++i) {
+                         void* ptr = TVMBackendAllocWorkspace(kDLCPU, 0, bytes, kDLFloat, 32);
+                         TVMBackendFreeWorkspace(kDLCPU, 0, ptr);
+                       }
+                     }});
+  }
+  cases.push_back({"WorkspacePool/nested:4", [=](int64_t n) {
+                     void* ptrs[4];
+                     for (int64_t i = 0; i < n; ++i) {
+                       for (int j = 0; j < 4; ++j) {
+                         ptrs[j] = TVMBackendAllocWorkspace(kDLCPU, 0, 4096 << j, kDLFloat, 32);
+                       }
+                       for (int j = 3; j >= 0; --j) TVMBackendFreeWorkspace(kDLCPU, 0, ptrs[j]);
+                     }
+                   },
+                   4});
+
+  // The dispatch loop of the VM.
+  constexpr int kNumMoves = 256;
+  Module vm = MoveChainVM(kNumMoves);
+  PackedFunc vm_invoke = vm.GetFunction("invoke");
+  cases.push_back({"VM/dispatch/instructions:" + std::to_string(kNumMoves + 2),
+                   [&](int64_t n) {
+                     for (int64_t i = 0; i < n; ++i) vm_invoke("main");
+                   },
+                   kNumMoves + 2});
+
+  // Loading a VM executable, with the code section in each format.
+  constexpr int kNumFuncs = 64;
+  constexpr int kNumInstrs = 1024;
+  for (bool compact : {false, true}) {
+    std::string bytes = SerializedVM(kNumFuncs, kNumInstrs, compact);
+    cases.push_back({std::string("VM/load/format:") + (compact ? "compact" : "legacy"),
+                     [=](int64_t n) {
+                       for (int64_t i = 0; i < n; ++i) vm::Executable::Load(bytes, Module());
+                     },
+                     kNumFuncs * kNumInstrs});
+  }
+
+  // The graph executor on a graph of no-op kernels.
+  constexpr int kNumOps = 64;
+  const PackedFunc* fcreate = Registry::Get("tvm.graph_executor.create");
+  Module graph_executor;
+  PackedFunc graph_run;
+  if (fcreate != nullptr) {
+    graph_executor = (*fcreate)(NopGraphJSON(kNumOps), Module(make_object<NopModule>()),
+                                static_cast<int>(kDLCPU), 0)
+                         .operator Module();
+    graph_run = graph_executor.GetFunction("run");
+    cases.push_back({"GraphExecutor::Run/ops:" + std::to_string(kNumOps),
+                     [&](int64_t n) {
+                       for (int64_t i = 0; i < n; ++i) graph_run();
+                     },
+                     kNumOps});
+  }
+
+#if TVM_RUNTIME_BENCH_RPC
+  // Round trips to an RPC server in a thread of this process, over a socket pair.
+  const PackedFunc* fserver_loop = Registry::Get("rpc.ServerLoop");
+  std::thread server;
+  Module rpc_sess;
+  PackedFunc rpc_echo;
+  int fds[2];
+  if (fserver_loop != nullptr && socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) {
+    int server_fd = fds[1];
+    server = std::thread([fserver_loop, server_fd]() { (*fserver_loop)(server_fd); });
+    auto endpt = RPCEndpoint::Create(std::make_unique<FdChannel>(fds[0]), "client", "server");
+    endpt->InitRemoteSession(TVMArgs(nullptr, nullptr, 0));
+    rpc_sess = CreateRPCSessionModule(CreateClientSession(endpt));
+    rpc_echo = rpc_sess.GetFunction("runtime_bench.echo");
+    cases.push_back({"RPC/round_trip/int", [&](int64_t n) {
+                       for (int64_t i = 0; i < n; ++i) rpc_echo(1);
+                     }});
+  }
+#endif
+
+  std::vector<Result> results;
+  std::printf("%-44s %14s %14s %12s\n", "Benchmark", "ns/iter", "ns/item", "iterations");
+  for (const Case& c : cases) {
+    if (!filter.empty() && c.name.find(filter) == std::string::npos) continue;
+    Result r = Measure(c, min_time);
+    std::printf("%-44s %14.1f %14.2f %12lld\n", r.name.c_str(), r.ns_per_run,
+                r.ns_per_run / r.items_per_run, static_cast<long long>(r.iterations));
+    results.push_back(r);
+  }
+  if (!json_path.empty()) {
+    WriteJSON(json_path, results);
+  }
+
+#if TVM_RUNTIME_BENCH_RPC
+  if (server.joinable()) {
+    // Closing the session shuts the server loop down.
+    rpc_sess.GetFunction("CloseRPCConnection")();
+    server.join();
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,99 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Microbenchmark of the Relay VM interpreter overhead.
+
+The workloads run kernels on single-element tensors so that the measured time is dominated
+by the dispatch loop rather than by the kernels themselves:
+
+* chain: a straight line of tiny kernels, reported as time per executed instruction.
+* loop: a while loop with a scalar counter, exercising If, Goto and Invoke.
+"""
+import argparse
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.relay.loops import while_loop
+from tvm.runtime import vm as vm_rt
+
+
+def build_chain(length):
+    x = relay.var("x", shape=(1,), dtype="float32")
+    out = x
+    for _ in range(length):
+        out = relay.add(out, relay.const(1.0, "float32"))
+    return tvm.IRModule.from_expr(relay.Function([x], out)), [np.zeros((1,), "float32")]
+
+
+def build_loop(iterations):
+    i = relay.var("i", shape=(), dtype="int32")
+    acc = relay.var("acc", shape=(1,), dtype="float32")
+
+    def cond(i, _):
+        return i < relay.const(iterations, dtype="int32")
+
+    def body(i, acc):
+        return i + relay.const(1, "int32"), acc + relay.const(1.0, "float32")
+
+    loop = while_loop(cond, [i, acc], body)
+    x = relay.var("x", shape=(1,), dtype="float32")
+    ret = relay.TupleGetItem(loop(relay.const(0, dtype="int32"), x), 1)
+    mod = tvm.IRModule()
+    mod["main"] = relay.Function([x], ret)
+    return mod, [np.zeros((1,), "float32")]
+
+
+def count_instructions(exe, func_name="main"):
+    """Read the instruction count of a function from the bytecode dump."""
+    in_func = False
+    for line in exe.bytecode.splitlines():
+        if line.startswith("VM Function["):
+            in_func = line.split("]: ", 1)[1].startswith(func_name + "(")
+        elif in_func and line.startswith("# instruction count = "):
+            return int(line.split("=")[1])
+    raise ValueError("Cannot find function %s in the bytecode" % func_name)
+
+
+def benchmark(workload, size):
+    mod, args = build_chain(size) if workload == "chain" else build_loop(size)
+    # Disable fusion so that every operator becomes its own kernel.
+    with tvm.transform.PassContext(opt_level=0):
+        exe = relay.vm.compile(mod, target="llvm")
+    dev = tvm.cpu()
+    the_vm = vm_rt.VirtualMachine(exe, dev)
+    res = the_vm.benchmark(dev, *args, repeat=args_.repeat, number=args_.number)
+    mean_us = res.mean * 1e6
+    if workload == "chain":
+        per = mean_us / count_instructions(exe) * 1000
+        print("%-6s %6d  %10.2f us  %8.1f ns/instruction" % (workload, size, mean_us, per))
+    else:
+        per = mean_us / size * 1000
+        print("%-6s %6d  %10.2f us  %8.1f ns/iteration" % (workload, size, mean_us, per))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--workload", type=str, choices=["chain", "loop", "all"], default="all")
+    parser.add_argument("--size", type=int, default=1000, help="chain length or loop trip count")
+    parser.add_argument("--repeat", type=int, default=10)
+    parser.add_argument("--number", type=int, default=100)
+    args_ = parser.parse_args()
+
+    workloads = ["chain", "loop"] if args_.workload == "all" else [args_.workload]
+    for w in workloads:
+        benchmark(w, args_.size)
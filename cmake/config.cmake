@@ -110,6 +110,9 @@ set(USE_KHRONOS_SPIRV OFF)
 # whether enable SPIRV_KHR_DOT_PRODUCT
 set(USE_SPIRV_KHR_INTEGER_DOT_PRODUCT OFF)
 
+# whether enable SPIRV_KHR_COOPERATIVE_MATRIX, which needs SPIRV-Headers 1.3.255 or newer
+set(USE_SPIRV_KHR_COOPERATIVE_MATRIX OFF)
+
 # Whether enable OpenGL runtime
 set(USE_OPENGL OFF)
 
@@ -137,6 +140,9 @@ set(USE_GRAPH_EXECUTOR ON)
 # Whether enable tiny graph executor with CUDA Graph
 set(USE_GRAPH_EXECUTOR_CUDA_GRAPH ON)
 
+# Whether enable tiny graph executor with HIP Graph, requires USE_ROCM
+set(USE_GRAPH_EXECUTOR_HIP_GRAPH OFF)
+
 # Whether enable pipeline executor.
 set(USE_PIPELINE_EXECUTOR OFF)
 
@@ -405,6 +411,14 @@ set(BACKTRACE_ON_SEGFAULT OFF)
 # - /path/to/folder/containing/: Path to folder containing papi.pc.
 set(USE_PAPI OFF)
 
+# Whether to enable CUPTI support in profiling. CUPTI provides access to the
+# hardware counters of NVIDIA GPUs, per kernel, while profiling. Needs USE_CUDA
+# and CUDA 11.5 or newer.
+# Possible values:
+# - ON: enable CUPTI support, found in the extras/CUPTI folder of the CUDA toolkit.
+# - OFF: disable CUPTI support.
+set(USE_CUPTI OFF)
+
 # Whether to use GoogleTest for C++ unit tests. When enabled, the generated
 # build file (e.g. Makefile) will have a target "cpptest".
 # Possible values:
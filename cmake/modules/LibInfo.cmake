@@ -65,6 +65,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_CUBLAS="${USE_CUBLAS}"
     TVM_INFO_USE_CUDA="${USE_CUDA}"
     TVM_INFO_USE_CUDNN="${USE_CUDNN}"
+    TVM_INFO_USE_CUPTI="${USE_CUPTI}"
     TVM_INFO_USE_CUSTOM_LOGGING="${USE_CUSTOM_LOGGING}"
     TVM_INFO_USE_CUTLASS="${USE_CUTLASS}"
     TVM_INFO_USE_AMX="${USE_AMX}"
@@ -73,6 +74,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_ETHOSU="${USE_ETHOSU}"
     TVM_INFO_USE_FALLBACK_STL_MAP="${USE_FALLBACK_STL_MAP}"
     TVM_INFO_USE_GRAPH_EXECUTOR_CUDA_GRAPH="${USE_GRAPH_EXECUTOR_CUDA_GRAPH}"
+    TVM_INFO_USE_GRAPH_EXECUTOR_HIP_GRAPH="${USE_GRAPH_EXECUTOR_HIP_GRAPH}"
     TVM_INFO_USE_GRAPH_EXECUTOR="${USE_GRAPH_EXECUTOR}"
     TVM_INFO_USE_GTEST="${USE_GTEST}"
     TVM_INFO_USE_HEXAGON="${USE_HEXAGON}"
@@ -107,6 +109,7 @@ function(add_lib_info src_file)
     TVM_INFO_USE_RTTI="${USE_RTTI}"
     TVM_INFO_USE_RUST_EXT="${USE_RUST_EXT}"
     TVM_INFO_USE_SORT="${USE_SORT}"
+    TVM_INFO_USE_SPIRV_KHR_COOPERATIVE_MATRIX="${USE_SPIRV_KHR_COOPERATIVE_MATRIX}"
     TVM_INFO_USE_SPIRV_KHR_INTEGER_DOT_PRODUCT="${USE_SPIRV_KHR_INTEGER_DOT_PRODUCT}"
     TVM_INFO_USE_STACKVM_RUNTIME="${USE_STACKVM_RUNTIME}"
     TVM_INFO_USE_TARGET_ONNX="${USE_TARGET_ONNX}"
@@ -52,6 +52,15 @@ if(USE_ROCM)
     list(APPEND TVM_RUNTIME_LINKER_LIBS ${ROCM_ROCBLAS_LIBRARY})
   endif(USE_ROCBLAS)
 
+  if(USE_GRAPH_EXECUTOR_HIP_GRAPH)
+    if(NOT USE_GRAPH_EXECUTOR)
+      message(FATAL_ERROR "HIP Graph is only supported by graph executor, please set USE_GRAPH_EXECUTOR=ON")
+    endif()
+    message(STATUS "Build with Graph executor with HIP Graph support...")
+    tvm_file_glob(GLOB RUNTIME_HIP_GRAPH_SRCS src/runtime/graph_executor/hip_graph/*.cc)
+    list(APPEND RUNTIME_SRCS ${RUNTIME_HIP_GRAPH_SRCS})
+  endif()
+
   if(USE_THRUST)
     message(STATUS "Build with rocThrust support")
     # We need to override CXX to hipcc. This is required by rocthrust
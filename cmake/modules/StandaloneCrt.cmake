@@ -147,7 +147,9 @@ if(USE_MICRO)
 
   create_crt_library(memory
                     ${RUNTIME_CRT_SOURCE_DIR}/memory/page_allocator.c
-                    ${RUNTIME_CRT_SOURCE_DIR}/memory/stack_allocator.c)
+                    ${RUNTIME_CRT_SOURCE_DIR}/memory/stack_allocator.c
+                    ${RUNTIME_CRT_SOURCE_DIR}/memory/tlsf_allocator.c
+                    ${RUNTIME_CRT_SOURCE_DIR}/memory/tlsf_allocator_rpc.c)
 
   create_crt_library(microtvm_rpc_common
                     ${RUNTIME_CRT_SOURCE_DIR}/microtvm_rpc_common/crcccitt.c
@@ -0,0 +1,42 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+
+if(USE_CUDA AND USE_CUPTI)
+  # The range profiler and the metrics evaluator need CUDA 11.5 or newer.
+  set(CUPTI_ROOT_DIR ${CUDA_TOOLKIT_ROOT_DIR}/extras/CUPTI)
+  find_path(CUPTI_INCLUDE_DIR cupti_profiler_target.h
+    HINTS ${CUPTI_ROOT_DIR}/include ${CUDA_TOOLKIT_ROOT_DIR}/include)
+  find_library(CUPTI_LIBRARY cupti
+    HINTS ${CUPTI_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib64)
+  find_library(CUPTI_NVPERF_HOST_LIBRARY nvperf_host
+    HINTS ${CUPTI_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib64)
+  find_library(CUPTI_NVPERF_TARGET_LIBRARY nvperf_target
+    HINTS ${CUPTI_ROOT_DIR}/lib64 ${CUDA_TOOLKIT_ROOT_DIR}/lib64)
+  if(NOT CUPTI_INCLUDE_DIR OR NOT CUPTI_LIBRARY OR NOT CUPTI_NVPERF_HOST_LIBRARY
+     OR NOT CUPTI_NVPERF_TARGET_LIBRARY)
+    message(FATAL_ERROR "Cannot find CUPTI in ${CUPTI_ROOT_DIR}")
+  endif()
+  message(STATUS "Using CUPTI library ${CUPTI_LIBRARY}")
+  set(CUPTI_LIBRARIES ${CUPTI_LIBRARY} ${CUPTI_NVPERF_HOST_LIBRARY}
+    ${CUPTI_NVPERF_TARGET_LIBRARY} ${CUDA_CUDA_LIBRARY})
+  target_include_directories(tvm_runtime_objs PRIVATE ${CUPTI_INCLUDE_DIR})
+  target_link_libraries(tvm_runtime_objs PRIVATE ${CUPTI_LIBRARIES})
+  target_link_libraries(tvm PRIVATE ${CUPTI_LIBRARIES})
+  target_link_libraries(tvm_runtime PRIVATE ${CUPTI_LIBRARIES})
+  target_sources(tvm_runtime_objs PRIVATE src/runtime/contrib/cupti/cupti.cc)
+endif()
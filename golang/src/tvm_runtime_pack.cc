@@ -30,6 +30,8 @@
 #include "src/runtime/module.cc"
 #include "src/runtime/ndarray.cc"
 #include "src/runtime/object.cc"
+#include "src/runtime/profile_intrinsics.cc"
+#include "src/runtime/profiling.cc"
 #include "src/runtime/registry.cc"
 #include "src/runtime/thread_pool.cc"
 #include "src/runtime/threading_backend.cc"
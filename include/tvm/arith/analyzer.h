@@ -734,6 +734,45 @@ class TVM_DLL Analyzer {
    * \note Analyzer will call into sub-analyzers to get the result.
    */
   PrimExpr Simplify(const PrimExpr& expr, int steps = 2);
+
+  /*!
+   * \brief Enable or disable the memoization of Simplify.
+   *
+   *  When enabled, Simplify remembers its result for each expression object and number of
+   *  steps. Bind drops all the remembered results, and each constraint scope remembers its
+   *  own results which are dropped when the scope exits. Updates that bypass the Analyzer,
+   *  such as updating a sub-analyzer directly, must be followed by ClearSimplifyMemo.
+   *
+   * \param enable Whether to memoize Simplify.
+   */
+  void EnableSimplifyMemo(bool enable = true);
+  /*! \brief Drop all the remembered results of Simplify. */
+  void ClearSimplifyMemo();
+  /*! \return The hit, miss and invalidation counters of the Simplify memo. */
+  ObjectRef GetSimplifyMemoStats() const;
+  /*! \brief Reset the counters of the Simplify memo. */
+  void ResetSimplifyMemoStats();
+  /*!
+   * \brief Whether no variable is bound and no constraint scope is entered.
+   *
+   *  The results of such an analyzer with the default extensions only depend on
+   *  the given expressions, so they can be shared with other analyzers.
+   */
+  bool HasEmptyContext() const;
+  /*! \brief destructor */
+  ~Analyzer();
+
+ private:
+  friend class ConstraintContext;
+  class SimplifyMemo;
+  /*! \brief Simplify without the memo. */
+  PrimExpr SimplifyImpl(const PrimExpr& expr, int steps);
+  /*! \brief The memo of Simplify. */
+  std::unique_ptr<SimplifyMemo> simplify_memo_;
+  /*! \brief The number of calls to Bind. */
+  int64_t num_binds_{0};
+  /*! \brief The number of entered constraint scopes. */
+  int64_t constraint_depth_{0};
 };
 
 }  // namespace arith
@@ -310,6 +310,13 @@ class ProgramRunnerNode : public Object {
   bool enable_cpu_cache_flush;
   /*! \brief Which device to run on if multiple are avaialble. */
   int device;
+  /*!
+   * \brief If positive, the repeats go on until the 95% confidence interval on the mean is
+   * narrower than this fraction of the mean.
+   */
+  double max_rel_ci;
+  /*! \brief The cap on the duration of the adaptive repeats in milliseconds. */
+  int max_measure_ms;
 
   /*!
    * \brief Run measurement and return results.
@@ -394,9 +401,12 @@ class LocalRunner : public ProgramRunner {
    * \param cooldown_interval The cool down interval between two measurements.
    * \param enable_cpu_cache_flush Whether to flush cache on CPU between repeated measurements.
    * \param device Which device to run on if multiple are available.
+   * \param max_rel_ci If positive, the target relative confidence interval of adaptive repeats.
+   * \param max_measure_ms The cap on the duration of the adaptive repeats in milliseconds.
    */
   LocalRunner(int timeout, int number, int repeat, int min_repeat_ms, double cooldown_interval,
-              bool enable_cpu_cache_flush, int device);
+              bool enable_cpu_cache_flush, int device, double max_rel_ci = 0.0,
+              int max_measure_ms = 1000);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(LocalRunner, ProgramRunner, LocalRunnerNode);
 };
@@ -447,10 +457,13 @@ class RPCRunner : public ProgramRunner {
    * \param cooldown_interval The cool down interval between two measurements.
    * \param enable_cpu_cache_flush Whether to flush cache on CPU between repeated measurements.
    * \param device Which device to run on if multiple are available.
+   * \param max_rel_ci If positive, the target relative confidence interval of adaptive repeats.
+   * \param max_measure_ms The cap on the duration of the adaptive repeats in milliseconds.
    */
   RPCRunner(const String& key, const String& host, int port, int priority, int n_parallel,
             int timeout, int number, int repeat, int min_repeat_ms, double cooldown_interval,
-            bool enable_cpu_cache_flush, int device);
+            bool enable_cpu_cache_flush, int device, double max_rel_ci = 0.0,
+            int max_measure_ms = 1000);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(RPCRunner, ProgramRunner, RPCRunnerNode);
 };
@@ -41,6 +41,11 @@ class RecordToFileNode : public MeasureCallbackNode {
  public:
   /*! \brief The name of output file. */
   String filename;
+  /*!
+   * \brief The number of best records per workload and target kept in the index file next to the
+   * output file. 0 means no index is maintained.
+   */
+  int index_best_k;
 
   void Callback(const SearchPolicy& policy, const Array<MeasureInput>& inputs,
                 const Array<MeasureResult>& results) final;
@@ -58,8 +63,10 @@ class RecordToFile : public MeasureCallback {
   /*!
    * \brief The constructor.
    * \param filename The name of output file
+   * \param index_best_k The number of best records per workload and target kept in the index
+   * file, 0 for no index
    */
-  explicit RecordToFile(String filename);
+  explicit RecordToFile(String filename, int index_best_k = 0);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(RecordToFile, MeasureCallback, RecordToFileNode);
 };
@@ -90,6 +97,16 @@ class RecordReaderNode : public Object {
   std::pair<Array<MeasureInput>, Array<MeasureResult>> ReadLines(int max_size = -1,
                                                                  int skip_size = 0);
 
+  /*!
+   * \brief Read the best records of the log file through its index file, seeking to them
+   * directly. The records appended after the index is updated are indexed on the fly. Without an
+   * index file, all the records are read.
+   * \param workload_key The workload key of the records to be read, NullOpt for all workloads.
+   * \return The MeasureInputs and MeasureResults loaded from the log file, in the file order.
+   */
+  std::pair<Array<MeasureInput>, Array<MeasureResult>> ReadIndexed(
+      const Optional<String>& workload_key = NullOpt);
+
   static constexpr const char* _type_key = "auto_scheduler.RecordReader";
   TVM_DECLARE_FINAL_OBJECT_INFO(RecordReaderNode, Object);
 
@@ -134,6 +151,42 @@ void WriteMeasureRecords(std::ostream* os, const Array<MeasureInput>& inputs,
 void ReadMeasureRecord(const std::string& str, MeasureInputNode* inp, MeasureResultNode* res,
                        std::string* log_version);
 
+/*!
+ * \brief Get the name of the index file of a log file, which maps each workload and target to the
+ * byte offsets of its best records in the log file.
+ * \param filename The name of the log file.
+ * \return The name of the index file.
+ */
+std::string RecordIndexFileName(const std::string& filename);
+
+/*!
+ * \brief Append measure records to a log file, and update its index file.
+ * \param filename The name of the log file.
+ * \param inputs The MeasureInputs to be written.
+ * \param results The MeasureResults to be written.
+ * \param index_best_k The number of best records per workload and target kept in the index file,
+ * 0 for no index.
+ */
+void AppendMeasureRecords(const std::string& filename, const Array<MeasureInput>& inputs,
+                          const Array<MeasureResult>& results, int index_best_k);
+
+/*!
+ * \brief Build the index file of a log file from scratch.
+ * \param filename The name of the log file.
+ * \param best_k The number of best records per workload and target kept in the index file.
+ */
+void BuildRecordIndex(const std::string& filename, int best_k);
+
+/*!
+ * \brief Rewrite a log file down to the best records of each workload and target.
+ * \param in_filename The name of the log file to be compacted.
+ * \param out_filename The name of the log file written, which must differ from the input.
+ * \param best_k The number of best records kept per workload and target.
+ * \param build_index Whether to build the index file of the output.
+ */
+void CompactRecordFile(const std::string& in_filename, const std::string& out_filename, int best_k,
+                       bool build_index);
+
 }  // namespace auto_scheduler
 }  // namespace tvm
 
@@ -38,6 +38,7 @@
 #include <tvm/te/schedule_pass.h>
 #include <tvm/tir/function.h>
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -140,6 +141,66 @@ TVM_DLL IRModule LowerSchedule(te::Schedule sch, const Array<ObjectRef>& args,
 IRModule ScheduleToModule(te::Schedule sch, const Array<ObjectRef>& args, const std::string& name,
                           const std::unordered_map<te::Tensor, tir::Buffer>& binds,
                           GlobalVarSupply global_var_supply);
+/*!
+ * \brief The lowered functions and generated modules of previous builds, which a build reuses for
+ *  the functions and modules that did not change.
+ *
+ *  The functions of an input module are lowered one by one when none of them calls another, and
+ *  each is reused when its fingerprint, i.e. the structural hash of the function with the target,
+ *  the host target, the attributes of the module and the pass configuration, matches a previous
+ *  build. The host and device modules of a target are generated anew only when one of their
+ *  lowered functions changed. Nothing is cached when the pass configuration cannot be hashed,
+ *  e.g. when it holds custom passes.
+ */
+class BuildCacheNode : public Object {
+ public:
+  /*! \brief The number of lowered functions and generated modules reused. */
+  int64_t num_hits{0};
+  /*! \brief The number of lowered functions and generated modules built and added. */
+  int64_t num_misses{0};
+
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("num_hits", &num_hits);
+    v->Visit("num_misses", &num_misses);
+  }
+
+  /*!
+   * \brief Look up the value of a key.
+   * \param key The key, compared structurally.
+   * \param hash The structural hash of the key.
+   * \param deps The modules the value was built with, compared by identity.
+   * \return The value, or NullOpt if not cached.
+   */
+  Optional<ObjectRef> Lookup(const Array<ObjectRef>& key, size_t hash,
+                             const Array<runtime::Module>& deps = {});
+
+  /*! \brief Add the value of a key, see Lookup. */
+  void Insert(const Array<ObjectRef>& key, size_t hash, ObjectRef value,
+              const Array<runtime::Module>& deps = {});
+
+  static constexpr const char* _type_key = "driver.BuildCache";
+  TVM_DECLARE_FINAL_OBJECT_INFO(BuildCacheNode, Object);
+
+ private:
+  struct Entry {
+    Array<ObjectRef> key;
+    Array<runtime::Module> deps;
+    ObjectRef value;
+  };
+  std::mutex mutex_;
+  std::unordered_multimap<size_t, Entry> entries_;
+};
+
+/*!
+ * \brief Managed reference to BuildCacheNode.
+ * \sa BuildCacheNode
+ */
+class BuildCache : public ObjectRef {
+ public:
+  TVM_DLL BuildCache();
+  TVM_DEFINE_MUTABLE_NOTNULLABLE_OBJECT_REF_METHODS(BuildCache, ObjectRef, BuildCacheNode);
+};
+
 /*!
  * \brief Build a device and host module for a specific target from an IRModule.
  * \param funcs The functions to be built.
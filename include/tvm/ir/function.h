@@ -78,6 +78,11 @@ class BaseFuncNode : public RelayExprNode {
  public:
   /*! \brief Additional attributes storing the meta-data */
   DictAttrs attrs;
+  /*!
+   * \brief The structural hash of the function, the references to functions reset it in
+   *  CopyOnWrite and code mutating a function in place otherwise must reset it.
+   */
+  StructuralHashCache structural_hash_cache;
 
   /*!
    * \brief Get a function attribute.
@@ -63,6 +63,7 @@
 #include <tvm/runtime/container/string.h>
 #include <tvm/support/with.h>
 
+#include <functional>
 #include <string>
 #include <utility>
 
@@ -290,12 +291,21 @@ class PassInfoNode : public Object {
   /*! \brief The passes that are required to perform the current pass. */
   Array<String> required;
 
+  /*!
+   * \brief Whether a function level pass can run on several functions of a module at once.
+   *
+   *  Such a pass must not update the module and must not keep state that is shared
+   *  between the functions.
+   */
+  bool thread_safe = true;
+
   PassInfoNode() = default;
 
   void VisitAttrs(AttrVisitor* v) {
     v->Visit("opt_level", &opt_level);
     v->Visit("name", &name);
     v->Visit("required", &required);
+    v->Visit("thread_safe", &thread_safe);
   }
 
   static constexpr const char* _type_key = "transform.PassInfo";
@@ -314,8 +324,10 @@ class PassInfo : public ObjectRef {
    * \param opt_level The optimization level
    * \param name Name of the pass.
    * \param required  The passes that are required to perform the current pass.
+   * \param thread_safe Whether the pass can run on several functions at once.
    */
-  TVM_DLL PassInfo(int opt_level, String name, Array<runtime::String> required);
+  TVM_DLL PassInfo(int opt_level, String name, Array<runtime::String> required,
+                   bool thread_safe = true);
 
   TVM_DEFINE_OBJECT_REF_METHODS(PassInfo, ObjectRef, PassInfoNode);
 };
@@ -499,6 +511,49 @@ CreateModulePass(const runtime::TypedPackedFunc<IRModule(IRModule, PassContext)>
  */
 TVM_DLL Pass PrintIR(String header = "", bool show_meta_data = false);
 
+/*!
+ * \brief Get the number of threads that a function level pass runs its functions on.
+ *
+ *  It is 1 unless the pass is thread safe and the "transform.num_function_pass_threads" option
+ *  of the context asks for more threads, where 0 asks for one thread per core.
+ *
+ * \param pass_ctx The context of the pass.
+ * \param pass_info The pass.
+ * \param num_funcs The number of functions.
+ * \return The number of threads.
+ */
+TVM_DLL int NumFunctionPassThreads(const PassContext& pass_ctx, const PassInfo& pass_info,
+                                   size_t num_funcs);
+
+/*!
+ * \brief Call fvisit on the functions [0, num_funcs) of a function level pass.
+ *
+ *  The functions are visited concurrently on NumFunctionPassThreads threads, with pass_ctx
+ *  as the current context of every thread. The error of the first function that fails is
+ *  rethrown after all the calls are done.
+ *
+ * \param pass_ctx The context of the pass.
+ * \param pass_info The pass.
+ * \param num_funcs The number of functions.
+ * \param fvisit The function called with the index of each function.
+ */
+TVM_DLL void ForEachFunction(const PassContext& pass_ctx, const PassInfo& pass_info,
+                             size_t num_funcs, const std::function<void(size_t)>& fvisit);
+
+/*!
+ * \brief Call fvisit on the tasks [0, num_tasks) on num_threads threads.
+ *
+ *  Like ForEachFunction, pass_ctx is the current context of every thread and the error of
+ *  the first task that fails is rethrown after all the calls are done.
+ *
+ * \param pass_ctx The context of the pass.
+ * \param num_tasks The number of tasks.
+ * \param num_threads The number of threads, a value of 1 or less calls fvisit in order.
+ * \param fvisit The function called with the index of each task.
+ */
+TVM_DLL void ParallelForEach(const PassContext& pass_ctx, size_t num_tasks, int num_threads,
+                             const std::function<void(size_t)>& fvisit);
+
 }  // namespace transform
 }  // namespace tvm
 
@@ -21,6 +21,7 @@
 #define TVM_META_SCHEDULE_COST_MODEL_H_
 
 #include <tvm/meta_schedule/arg_info.h>
+#include <tvm/meta_schedule/feature_extractor.h>
 #include <tvm/meta_schedule/measure_candidate.h>
 #include <tvm/meta_schedule/runner.h>
 #include <tvm/node/reflection.h>
@@ -165,6 +166,28 @@ class CostModel : public runtime::ObjectRef {
                                        PyCostModelNode::FUpdate f_update,    //
                                        PyCostModelNode::FPredict f_predict,  //
                                        PyCostModelNode::FAsString f_as_string);
+  /*!
+   * \brief Create a gradient-boosted decision tree cost model, which is trained and run in C++
+   * with multiple threads, without calling into Python.
+   * \param extractor The feature extractor.
+   * \param num_warmup_samples The number of samples before which the predictions are random.
+   * \param max_depth The maximum depth of a tree.
+   * \param eta The learning rate.
+   * \param gamma The minimum loss reduction to split a node.
+   * \param min_child_weight The minimum sum of hessian in a child.
+   * \param reg_lambda The L2 regularization on the leaf values.
+   * \param max_rounds The maximum number of boosting rounds.
+   * \param early_stopping_rounds The number of rounds without improvement before stopping.
+   * \param num_bins The number of histogram bins of each feature, at most 256.
+   * \param adaptive_training Whether to skip retraining until the training set grows by 20%.
+   * \param seed The random seed, -1 for a random one.
+   * \return The cost model created.
+   */
+  TVM_DLL static CostModel GradientBoosting(FeatureExtractor extractor, int num_warmup_samples,
+                                            int max_depth, double eta, double gamma,
+                                            double min_child_weight, double reg_lambda,
+                                            int max_rounds, int early_stopping_rounds,
+                                            int num_bins, bool adaptive_training, int64_t seed);
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CostModel, ObjectRef, CostModelNode);
 };
 
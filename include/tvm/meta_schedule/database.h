@@ -483,6 +483,16 @@ class Database : public runtime::ObjectRef {
    */
   TVM_DLL static Database JSONDatabase(String path_workload, String path_tuning_record,
                                        bool allow_missing, String mod_eq_name = "structural");
+  /*!
+   * \brief Create a database stored in a single append-only binary file. Opening only indexes
+   * the entry headers; workloads and tuning records are deserialized on demand. Multiple
+   * processes may append to the same file concurrently.
+   * \param path The path to the database file.
+   * \param allow_missing Whether to create new file when the given path is not found.
+   * \param mod_eq_name A string to specify the module equality testing and hashing method.
+   */
+  TVM_DLL static Database BinaryDatabase(String path, bool allow_missing,
+                                         String mod_eq_name = "structural");
   /*!
    * \brief A database composed of multiple databases, allowing users to guide IR rewriting using
    * combined knowledge of those databases. To each query, it returns the best record among all the
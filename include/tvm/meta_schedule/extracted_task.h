@@ -19,6 +19,7 @@
 #ifndef TVM_META_SCHEDULE_EXTRACTED_TASK_H_
 #define TVM_META_SCHEDULE_EXTRACTED_TASK_H_
 
+#include <tvm/ir/expr.h>
 #include <tvm/ir/module.h>
 #include <tvm/node/reflection.h>
 #include <tvm/runtime/container/array.h>
@@ -51,6 +52,10 @@ class ExtractedTaskNode : public runtime::Object {
   Array<IRModule> dispatched;
   /*! \brief Weight of the task */
   int weight;
+  /*! \brief The module equality method `dispatched_hashes` are computed with, empty if none */
+  String module_equality;
+  /*! \brief The hashes of the dispatched low-level IRs, precomputed during task extraction */
+  Array<IntImm> dispatched_hashes;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("task_name", &task_name);
@@ -58,6 +63,8 @@ class ExtractedTaskNode : public runtime::Object {
     v->Visit("target", &target);
     v->Visit("dispatched", &dispatched);
     v->Visit("weight", &weight);
+    v->Visit("module_equality", &module_equality);
+    v->Visit("dispatched_hashes", &dispatched_hashes);
   }
 
   static constexpr const char* _type_key = "meta_schedule.ExtractedTask";
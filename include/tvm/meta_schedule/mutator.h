@@ -28,6 +28,9 @@
 #include <tvm/tir/schedule/schedule.h>
 #include <tvm/tir/schedule/trace.h>
 
+#include <functional>
+#include <vector>
+
 namespace tvm {
 namespace meta_schedule {
 
@@ -37,6 +40,12 @@ class Mutator;
 /*! \brief Mutator is designed to mutate the trace to explore the design space. */
 class MutatorNode : public runtime::Object {
  public:
+  /*!
+   * \brief The function to score a batch of mutated traces, e.g. with the cost model of the
+   * search, higher being better. The traces that are invalid are scored -inf.
+   */
+  using FScore = std::function<std::vector<double>(const std::vector<tir::Trace>&)>;
+
   /*! \brief Virtual destructor. */
   virtual ~MutatorNode() = default;
 
@@ -58,6 +67,20 @@ class MutatorNode : public runtime::Object {
   virtual Optional<tir::Trace> Apply(const tir::Trace& trace,
                                      support::LinearCongruentialEngine::TRandState* rand_state) = 0;
 
+  /*!
+   * \brief Apply the mutator function to the given trace, guided by the scores of the candidate
+   * mutations. By default the scores are not used.
+   * \param trace The given trace for mutation.
+   * \param rand_state The random state for mutation.
+   * \param f_score The function to score a batch of mutated traces.
+   * \return None if mutator failed, otherwise return the mutated trace.
+   */
+  virtual Optional<tir::Trace> ApplyGuided(
+      const tir::Trace& trace, support::LinearCongruentialEngine::TRandState* rand_state,
+      const FScore& f_score) {
+    return Apply(trace, rand_state);
+  }
+
   /*!
    * \brief Clone the mutator.
    * \return The cloned mutator.
@@ -96,8 +119,15 @@ class Mutator : public runtime::ObjectRef {
    * \return The string of the mutator.
    */
   using FAsString = runtime::TypedPackedFunc<String()>;
-  /*! \brief Create a Mutator that mutates the decision of instruction Sample-Perfect-Tile */
-  TVM_DLL static Mutator MutateTileSize();
+  /*!
+   * \brief Create a Mutator that mutates the decision of instruction Sample-Perfect-Tile
+   * \param num_candidates The number of neighboring decisions scored when the mutation is guided,
+   * of which the best is picked. If it is 1, the mutation is uniformly random.
+   * \param exploration The weight of the random bonus added to the scores, in [0, 1], to keep
+   * exploring the decisions the scores underrate.
+   * \return The mutator created
+   */
+  TVM_DLL static Mutator MutateTileSize(int num_candidates = 1, double exploration = 0.0);
   /*!
    * \brief Create a Mutator that mutates the parallel extent
    * \param max_jobs_per_core The maximum number of parallel jobs per core.
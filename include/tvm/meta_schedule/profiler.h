@@ -28,6 +28,8 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/target/target.h>
 
+#include <chrono>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -51,27 +53,101 @@ class ScopedTimer {
   runtime::TypedPackedFunc<void()> deferred_;
 };
 
+/*! \brief A scope profiled, as an event on the timeline */
+struct ProfilerEvent {
+  /*! \brief The name of the scope */
+  std::string name;
+  /*! \brief The task the scope belongs to, empty if none */
+  std::string task;
+  /*! \brief The id of the thread the scope runs on */
+  int64_t thread_id;
+  /*! \brief The start time, in microseconds since the profiler is created */
+  double start_us;
+  /*! \brief The duration in microseconds */
+  double duration_us;
+};
+
+/*! \brief The busy time of the workers in a pool, e.g. those of a builder or a runner */
+struct ProfilerWorkerPool {
+  /*! \brief The number of workers in the pool */
+  int num_workers = 0;
+  /*! \brief The number of jobs done */
+  int64_t num_jobs = 0;
+  /*! \brief The total time the workers are busy, in seconds */
+  double busy_sec = 0.0;
+};
+
 /*! \brief A generic profiler */
 class ProfilerNode : public runtime::Object {
  public:
+  using Clock = std::chrono::high_resolution_clock;
+
   /*! \brief The segments that are already profiled */
   std::unordered_map<std::string, double> stats_sec;
+  /*! \brief The segments that are already profiled, broken down by task */
+  std::unordered_map<std::string, std::unordered_map<std::string, double>> task_stats_sec;
+  /*! \brief The scopes profiled in order, for the timeline */
+  std::vector<ProfilerEvent> events;
+  /*! \brief The number of events dropped after the timeline is full */
+  int64_t num_dropped_events;
+  /*! \brief The busy time of each worker pool */
+  std::unordered_map<std::string, ProfilerWorkerPool> worker_pools;
+  /*! \brief The task being profiled, empty if none */
+  std::string current_task;
+  /*! \brief The time the profiler is created */
+  Clock::time_point start_time;
   /*! \brief Counter for the total time used */
   runtime::PackedFunc total_timer;
+  /*! \brief The mutex guarding the stats, which are recorded from multiple threads */
+  mutable std::mutex mutex;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     // `stats_sec` is not visited.
+    // `task_stats_sec` is not visited.
+    // `events` is not visited.
+    // `num_dropped_events` is not visited.
+    // `worker_pools` is not visited.
+    // `current_task` is not visited.
+    // `start_time` is not visited.
     // `total_timer` is not visited.
+    // `mutex` is not visited.
   }
 
   static constexpr const char* _type_key = "meta_schedule.Profiler";
   TVM_DECLARE_FINAL_OBJECT_INFO(ProfilerNode, runtime::Object);
 
  public:
+  /*! \brief The maximum number of events kept on the timeline */
+  static constexpr int64_t kMaxEvents = 1 << 20;
+
   /*! \brief Get the internal stats of the running time */
   Map<String, FloatImm> Get() const;
+  /*! \brief Get the internal stats of the running time of each task */
+  Map<String, Map<String, FloatImm>> GetTaskStats() const;
+  /*!
+   * \brief Get the utilization of each worker pool, i.e. the fraction of the time its workers are
+   * busy during the profiling
+   */
+  Map<String, FloatImm> GetUtilization() const;
   /*! \brief Return a summary of profiling results as table format */
   String Table() const;
+  /*! \brief Export the timeline in the Chrome trace event format, viewable in chrome://tracing */
+  String ExportTimeline() const;
+  /*!
+   * \brief Record a scope profiled
+   * \param name The name of the scope
+   * \param start The time the scope starts
+   * \param end The time the scope ends
+   */
+  void Record(const std::string& name, Clock::time_point start, Clock::time_point end);
+  /*!
+   * \brief Record the jobs done by the workers in a pool
+   * \param pool The name of the pool
+   * \param num_workers The number of workers in the pool
+   * \param num_jobs The number of jobs done
+   * \param busy_sec The total time the workers spend on the jobs, in seconds
+   */
+  void RecordWorkers(const String& pool, int num_workers, int64_t num_jobs, double busy_sec);
 };
 
 /*!
@@ -87,7 +163,10 @@ class Profiler : public runtime::ObjectRef {
   void EnterWithScope();
   /*! \brief Exiting the scope of the context manager */
   void ExitWithScope();
-  /*! \brief Returns the current profiler */
+  /*!
+   * \brief Returns the current profiler. On threads without a profiler of their own, e.g. the
+   * workers of the tuning loop, it is the profiler entered last on any thread.
+   */
   static Optional<Profiler> Current();
   /*!
    * \brief Profile the time usage in the given scope in the given name.
@@ -95,6 +174,12 @@ class Profiler : public runtime::ObjectRef {
    * \return A scope timer for time profiling.
    */
   static ScopedTimer TimedScope(String name);
+  /*!
+   * \brief Attribute the time profiled in the given scope to a task.
+   * \param task_name Name of the task.
+   * \return A scope timer which restores the previous task when exiting.
+   */
+  static ScopedTimer TaskScope(String task_name);
 };
 
 }  // namespace meta_schedule
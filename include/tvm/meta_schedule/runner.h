@@ -72,11 +72,14 @@ class RunnerResultNode : public runtime::Object {
  public:
   /*! \brief The run time in seconds.*/
   Optional<Array<FloatImm>> run_secs;
+  /*! \brief The sample variance of the run time in seconds squared, if there are 2 runs or more. */
+  Optional<FloatImm> run_sec_var;
   /*! \brief The error message, if any. */
   Optional<String> error_msg;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("run_secs", &run_secs);
+    v->Visit("run_sec_var", &run_sec_var);
     v->Visit("error_msg", &error_msg);
   }
 
@@ -91,7 +94,7 @@ class RunnerResultNode : public runtime::Object {
 class RunnerResult : public runtime::ObjectRef {
  public:
   /*!
-   * \brief Constructor
+   * \brief Constructor, which computes the variance of the run time.
    * \brief The run time in seconds.
    * \brief The error message, if any.
    */
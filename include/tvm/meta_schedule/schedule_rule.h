@@ -274,6 +274,20 @@ class ScheduleRule : public runtime::ObjectRef {
    */
   TVM_DLL static ScheduleRule AutoBind(int max_threadblocks, Array<Integer> thread_extents,
                                        int max_threads_per_block = -1);
+  /*!
+   * \brief Fuse the loop nests of independent sibling blocks horizontally, so that they are
+   * launched as a single kernel. The blocks under the fused loop are left for AutoBind to bind.
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule HorizontalFusion();
+  /*!
+   * \brief Mark the root block with a software prefetch distance, sampled from the candidates.
+   * The prefetches are inserted by the InjectSoftwarePrefetch pass during lowering.
+   * \param distances The candidate distances in loop iterations. Use 0 to derive the distance
+   * from the cost of the loop body, and a negative distance to disable the prefetches.
+   * \return The schedule rule created
+   */
+  TVM_DLL static ScheduleRule SoftwarePrefetch(Array<Integer> distances);
   /*!
    * \brief Create a schedule rule with customized methods on the python-side.
    * \param f_initialize_with_tune_context The packed function of `InitializeWithTuneContext`.
@@ -290,17 +304,19 @@ class ScheduleRule : public runtime::ObjectRef {
 
   /*! \brief Create default schedule rules for LLVM */
   TVM_DLL static Array<ScheduleRule, void> DefaultLLVM();
-  /*! \brief Create default schedule rules for x86 (AVX512 and VNNI) */
+  /*! \brief Create default schedule rules for x86 (AVX512, VNNI and AMX) */
   TVM_DLL static Array<ScheduleRule, void> DefaultX86(const String& type);
   /*! \brief Create default schedule rules for CUDA */
   TVM_DLL static Array<ScheduleRule, void> DefaultCUDA();
   /*! \brief Create default postprocessors for CUDA with TensorCore */
   TVM_DLL static Array<ScheduleRule, void> DefaultCUDATensorCore();
+  /*! \brief Create default schedule rules for Vulkan with cooperative matrices */
+  TVM_DLL static Array<ScheduleRule, void> DefaultVulkanTensorCore();
   /*! \brief Create default schedule rules for Hexagon */
   TVM_DLL static Array<ScheduleRule, void> DefaultHexagon();
   /*! \brief Create default schedule rules for Micro */
   TVM_DLL static Array<ScheduleRule, void> DefaultMicro();
-  /*! \brief Create default schedule rules for ARM CPU (NEON and DOTPROD) */
+  /*! \brief Create default schedule rules for ARM CPU (NEON, DOTPROD and I8MM) */
   TVM_DLL static Array<ScheduleRule, void> DefaultARM(const String& type);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(ScheduleRule, ObjectRef, ScheduleRuleNode);
@@ -112,6 +112,8 @@ class SearchStrategyNode : public runtime::Object {
   /*!
    * \brief Generate measure candidates from design spaces for measurement.
    * \return The measure candidates generated, nullptr if finished.
+   * \note The task scheduler generates the next batch while the previous one is being measured,
+   *  i.e. before its results are notified. The trials should be counted when generated.
    */
   virtual Optional<Array<MeasureCandidate>> GenerateMeasureCandidates() = 0;
 
@@ -205,6 +207,8 @@ class SearchStrategy : public runtime::ObjectRef {
    * \param genetic_mutate_prob The probability of mutation.
    * \param genetic_max_fail_count The maximum number to try evolving the given trace.
    * \param eps_greedy The ratio to select samples in a greedy fashion via their predicted score.
+   * \param warm_start_num_workloads The number of the nearest workloads of the same operator family
+   * in the database whose best traces seed the initial population, 0 to disable warm start.
    */
   TVM_DLL static SearchStrategy EvolutionarySearch(int population_size,         //
                                                    double init_measured_ratio,  //
@@ -213,7 +217,8 @@ class SearchStrategy : public runtime::ObjectRef {
                                                    int genetic_num_iters,       //
                                                    double genetic_mutate_prob,  //
                                                    int genetic_max_fail_count,  //
-                                                   double eps_greedy);
+                                                   double eps_greedy,           //
+                                                   int warm_start_num_workloads);
 
   TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(SearchStrategy, ObjectRef, SearchStrategyNode);
 };
@@ -59,6 +59,12 @@ class TaskRecordNode : public runtime::Object {
   Optional<Array<BuilderResult>> builder_results = NullOpt;
   /*! \brief Packed functions to fetch the runner results asynchronously. */
   Optional<Array<RunnerFuture>> runner_futures = NullOpt;
+  /*! \brief The next batch of measure candidates, built while the current batch is running. */
+  Optional<Array<MeasureCandidate>> next_candidates = NullOpt;
+  /*! \brief The building results of the next batch of measure candidates. */
+  Optional<Array<BuilderResult>> next_builder_results = NullOpt;
+  /*! \brief Whether the search strategy has no more measure candidates to generate. */
+  bool is_exhausted = false;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("ctx", &ctx);
@@ -71,6 +77,9 @@ class TaskRecordNode : public runtime::Object {
     v->Visit("measure_candidates", &measure_candidates);
     v->Visit("builder_results", &builder_results);
     v->Visit("runner_futures", &runner_futures);
+    v->Visit("next_candidates", &next_candidates);
+    v->Visit("next_builder_results", &next_builder_results);
+    v->Visit("is_exhausted", &is_exhausted);
   }
 
   static constexpr const char* _type_key = "meta_schedule.TaskRecord";
@@ -277,6 +286,21 @@ class TaskScheduler : public runtime::ObjectRef {
    */
   TVM_DLL static TaskScheduler GradientBased(PackedFunc logger, double alpha, int window_size,
                                              support::LinearCongruentialEngine::TRandState seed);
+  /*!
+   * \brief Create a task scheduler that tunes within a wall-clock time budget. It picks the task
+   * with the largest expected improvement of the weighted latency per second spent on it, where
+   * the time spent includes generation, building and running, and stops the tasks that converge.
+   * \param logger The tuning task's logging function.
+   * \param time_budget_sec The wall-clock time budget of tuning, in seconds.
+   * \param patience The number of rounds without improvement after which a task is stopped.
+   * \param alpha The parameter alpha to control gradient computation.
+   * \param window_size The parameter to control backward window size.
+   * \param seed The random seed.
+   * \return The task scheduler created.
+   */
+  TVM_DLL static TaskScheduler TimeBudget(PackedFunc logger, double time_budget_sec, int patience,
+                                          double alpha, int window_size,
+                                          support::LinearCongruentialEngine::TRandState seed);
   /*!
    * \brief Create a task scheduler with customized methods on the python-side.
    * \param logger The tuning task's logging function.
@@ -68,6 +68,8 @@ class PrinterConfigNode : public Object {
   int num_context_lines = -1;
   /*! \brief Whether to output with syntax sugar, set false for complete printing. */
   bool syntax_sugar = true;
+  /*! \brief The maximum number of elements printed of a constant array, -1 for all of them. */
+  int max_constant_elems = 200;
   /* \brief Object path to be underlined */
   Array<ObjectPath> path_to_underline = Array<ObjectPath>();
   /*! \brief Object path to be annotated. */
@@ -91,6 +93,7 @@ class PrinterConfigNode : public Object {
     v->Visit("print_line_numbers", &print_line_numbers);
     v->Visit("num_context_lines", &num_context_lines);
     v->Visit("syntax_sugar", &syntax_sugar);
+    v->Visit("max_constant_elems", &max_constant_elems);
     v->Visit("path_to_underline", &path_to_underline);
     v->Visit("path_to_annotate", &path_to_annotate);
     v->Visit("obj_to_underline", &obj_to_underline);
@@ -114,9 +117,18 @@ class TVMScriptPrinter {
  public:
   /* Convert the object to TVMScript format */
   static std::string Script(const ObjectRef& node, const Optional<PrinterConfig>& cfg);
+  /*!
+   * \brief Write the object in TVMScript format to a stream. Unlike Script, the printers of large
+   *  objects such as IRModule render them piece by piece, without holding all of the text.
+   */
+  static void ScriptToStream(const ObjectRef& node, const Optional<PrinterConfig>& cfg,
+                             std::ostream* os);
   // Allow registration to be printer.
   using FType = NodeFunctor<std::string(const ObjectRef&, const PrinterConfig&)>;
   TVM_DLL static FType& vtable();
+  // The printers writing to a stream, the others fall back to vtable.
+  using FStreamType = NodeFunctor<void(const ObjectRef&, const PrinterConfig&, std::ostream*)>;
+  TVM_DLL static FStreamType& stream_vtable();
 };
 
 #define TVM_OBJECT_ENABLE_SCRIPT_PRINTER()                                                      \
@@ -389,6 +389,22 @@ class SEqualHandlerDefault : public SEqualReducer::Handler {
    */
   virtual bool Equal(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars);
 
+  /*!
+   * \brief Check equality with the default handler, comparing the functions of IRModules
+   *  in parallel.
+   *
+   *  The result is the same as SEqualHandlerDefault(false, nullptr, false).Equal(lhs, rhs,
+   *  map_free_vars). Modules with a few functions, and modules that are not equal or whose
+   *  functions share nodes, are compared sequentially.
+   * \param lhs The left operand.
+   * \param rhs The right operand.
+   * \param map_free_vars Whether or not to remap variables if possible.
+   * \param num_threads The number of threads, -1 to use all the cores.
+   * \return The equality result.
+   */
+  TVM_DLL static bool ParallelEqual(const ObjectRef& lhs, const ObjectRef& rhs,
+                                    bool map_free_vars, int num_threads = -1);
+
  protected:
   /*!
    * \brief The dispatcher for equality testing of intermediate objects
@@ -27,6 +27,7 @@
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/ndarray.h>
 
+#include <atomic>
 #include <functional>
 #include <string>
 
@@ -92,6 +93,67 @@ class StructuralHash : public BaseValueHash {
   TVM_DLL uint64_t operator()(const ObjectRef& key) const;
 };
 
+/*!
+ * \brief The structural hash of a node, kept in the node by StructuralHash.
+ *
+ *  Nodes that are not changed once constructed can hold a cache, so that hashing them
+ *  again is a load. Copying a node does not copy its cache, and mutating a node in place
+ *  must Reset the cache, which copy on write of the nodes that hold one does.
+ *
+ *  Only the hash of the node as the root of a StructuralHash call without mapping free
+ *  variables is cached, as the hash of a node inside a larger object depends on the
+ *  variables defined around it.
+ */
+class StructuralHashCache {
+ public:
+  StructuralHashCache() = default;
+  StructuralHashCache(const StructuralHashCache&) {}
+  StructuralHashCache& operator=(const StructuralHashCache&) {
+    Reset();
+    return *this;
+  }
+  /*!
+   * \brief Get the cached hash.
+   * \param hashed_value The cached hash, only written when there is one.
+   * \return Whether there is a cached hash.
+   */
+  bool Get(uint64_t* hashed_value) const {
+    uint64_t value = value_.load(std::memory_order_relaxed);
+    if (value == kEmpty) return false;
+    *hashed_value = value;
+    return true;
+  }
+  /*!
+   * \brief Cache a hash, a hash equal to the empty marker is not cached.
+   * \param hashed_value The hash.
+   */
+  void Set(uint64_t hashed_value) const { value_.store(hashed_value, std::memory_order_relaxed); }
+  /*! \brief Drop the cached hash. */
+  void Reset() const { value_.store(kEmpty, std::memory_order_relaxed); }
+
+ private:
+  static constexpr uint64_t kEmpty = 0;
+  mutable std::atomic<uint64_t> value_{kEmpty};
+};
+
+/*!
+ * \brief Define CopyOnWrite of a reference to a node with a structural_hash_cache.
+ *
+ *  The cache is reset, as the returned node is about to be mutated.
+ * \param ObjectName The type of the node.
+ */
+#define TVM_DEFINE_OBJECT_REF_COW_METHOD_WITH_SHASH_CACHE(ObjectName) \
+  ObjectName* CopyOnWrite() {                                         \
+    ICHECK(data_ != nullptr);                                         \
+    if (!data_.unique()) {                                            \
+      auto n = make_object<ObjectName>(*(operator->()));              \
+      ObjectPtr<Object>(std::move(n)).swap(data_);                    \
+    }                                                                 \
+    ObjectName* node = static_cast<ObjectName*>(data_.get());         \
+    node->structural_hash_cache.Reset();                              \
+    return node;                                                      \
+  }
+
 /*!
  * \brief A Reducer class to reduce the structural hash value.
  *
@@ -231,6 +293,21 @@ class SHashHandlerDefault : public SHashReducer::Handler {
    */
   virtual uint64_t Hash(const ObjectRef& object, bool map_free_vars);
 
+  /*!
+   * \brief Hash an object with the default handler, hashing the functions of an IRModule
+   *  in parallel.
+   *
+   *  The result is the same as SHashHandlerDefault().Hash(object, map_free_vars). Modules
+   *  with a few functions, and modules whose functions share nodes that would hash
+   *  differently on their own, are hashed sequentially.
+   * \param object The object to be hashed.
+   * \param map_free_vars Whether or not to remap variables if possible.
+   * \param num_threads The number of threads, -1 to use all the cores.
+   * \return The hash result.
+   */
+  TVM_DLL static uint64_t ParallelHash(const ObjectRef& object, bool map_free_vars,
+                                       int num_threads = -1);
+
  protected:
   /*!
    * \brief The dispatcher for hashing of intermediate objects
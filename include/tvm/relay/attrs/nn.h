@@ -1111,6 +1111,33 @@ struct DensePackAttrs : public tvm::AttrsNode<DensePackAttrs> {
   }
 };
 
+/*! \brief Attributes for dense_weight_only operator. */
+struct DenseWeightOnlyAttrs : public tvm::AttrsNode<DenseWeightOnlyAttrs> {
+  int bits;
+  int group_size;
+  DataType out_dtype;
+
+  TVM_DECLARE_ATTRS(DenseWeightOnlyAttrs, "relay.attrs.DenseWeightOnlyAttrs") {
+    TVM_ATTR_FIELD(bits).set_default(4).describe("Number of bits of a quantized weight value.");
+    TVM_ATTR_FIELD(group_size)
+        .set_default(128)
+        .describe("Number of input channels sharing a scale.");
+    // use 0 bits to indicate none.
+    TVM_ATTR_FIELD(out_dtype)
+        .set_default(NullValue<DataType>())
+        .describe("Output data type, set to explicit type under mixed precision setting");
+  }
+};
+
+/*! \brief Attributes for dense_weight_only_pack operator. */
+struct DenseWeightOnlyPackAttrs : public tvm::AttrsNode<DenseWeightOnlyPackAttrs> {
+  int bits;
+
+  TVM_DECLARE_ATTRS(DenseWeightOnlyPackAttrs, "relay.attrs.DenseWeightOnlyPackAttrs") {
+    TVM_ATTR_FIELD(bits).set_default(4).describe("Number of bits of a quantized weight value.");
+  }
+};
+
 /*! \brief Attributes for batch matmul operator. */
 struct BatchMatmulAttrs : public tvm::AttrsNode<BatchMatmulAttrs> {
   DataType out_dtype;
@@ -1367,6 +1394,19 @@ struct LayerNormAttrs : public tvm::AttrsNode<LayerNormAttrs> {
   }
 };  // struct LayerNormAttrs
 
+/*! \brief Attributes used in fused_attention operator */
+struct FusedAttentionAttrs : public tvm::AttrsNode<FusedAttentionAttrs> {
+  double scale;
+  bool causal;
+
+  TVM_DECLARE_ATTRS(FusedAttentionAttrs, "relay.attrs.FusedAttentionAttrs") {
+    TVM_ATTR_FIELD(scale).set_default(0.0).describe(
+        "Scale applied to query * key^T. A non-positive value means 1 / sqrt(head_dim).");
+    TVM_ATTR_FIELD(causal).set_default(false).describe(
+        "If true, mask out keys that come after the query position.");
+  }
+};  // struct FusedAttentionAttrs
+
 /*! \brief Attributes used in group_norm operator */
 struct GroupNormAttrs : public tvm::AttrsNode<GroupNormAttrs> {
   int num_groups;
@@ -800,8 +800,8 @@ namespace runtime {
 template <>
 template <>
 inline ObjectPtr<relay::LetNode>
-ObjAllocatorBase<SimpleObjAllocator>::make_object<relay::LetNode>() {
-  using Derived = SimpleObjAllocator;
+ObjAllocatorBase<DefaultObjAllocator>::make_object<relay::LetNode>() {
+  using Derived = DefaultObjAllocator;
   using T = relay::LetNode;
   using Handler = typename Derived::template Handler<T>;
   static_assert(std::is_base_of<Object, T>::value, "make can only be used to create Object");
@@ -815,8 +815,8 @@ ObjAllocatorBase<SimpleObjAllocator>::make_object<relay::LetNode>() {
 template <>
 template <>
 inline ObjectPtr<relay::CallNode>
-ObjAllocatorBase<SimpleObjAllocator>::make_object<relay::CallNode>() {
-  using Derived = SimpleObjAllocator;
+ObjAllocatorBase<DefaultObjAllocator>::make_object<relay::CallNode>() {
+  using Derived = DefaultObjAllocator;
   using T = relay::CallNode;
   using Handler = typename Derived::template Handler<T>;
   static_assert(std::is_base_of<Object, T>::value, "make can only be used to create Object");
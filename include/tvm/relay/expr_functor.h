@@ -403,12 +403,41 @@ class ExprRewriter {
   }
 };
 
+/*!
+ * \brief The sub-expressions of an expression, numbered in post-DFS order without recursion.
+ *
+ * The inputs of a node are the sub-expressions ExprMutator visits, in the same order, including
+ * the bodies of functions, lets, ifs and match clauses, so a node is numbered after its inputs.
+ * The order is built once, with the ids of the inputs in flat arrays, so that a traversal keeps
+ * its state in vectors indexed by node id rather than in maps keyed by expression, and does not
+ * overflow the stack on very deep graphs.
+ */
+class PostDfsOrder {
+ public:
+  explicit PostDfsOrder(const Expr& expr);
+
+  /*! \return The number of nodes. The expression itself is the last one. */
+  size_t size() const { return nodes_.size(); }
+  /*! \return The node of id \p id. */
+  const Expr& operator[](size_t id) const { return nodes_[id]; }
+  /*! \return The number of inputs of node \p id. */
+  size_t num_inputs(size_t id) const { return input_begin_[id + 1] - input_begin_[id]; }
+  /*! \return The id of input \p i of node \p id. */
+  size_t input(size_t id, size_t i) const { return input_ids_[input_begin_[id] + i]; }
+
+ private:
+  std::vector<Expr> nodes_;
+  std::vector<size_t> input_begin_;
+  std::vector<size_t> input_ids_;
+};
+
 /*! \brief Non-recursive DFS Graph Traversal for Custom Rewriting Passes
  *
  * PostOrderRewrite does a non-recursive traversal of the graph in Post-DFS order and calls the
  * ExprRewriter's Rewrite functions on nodes once their inputs are rewritten. At each rewrite call,
  * PostOrderRewrite provides the original node and the node with altered inputs for use by the
- * ExprRewriter.
+ * ExprRewriter. The traversal follows a PostDfsOrder, so it neither recurses into functions, lets
+ * and ifs nor memoizes in a hash map.
  */
 Expr PostOrderRewrite(const Expr& expr, ExprRewriter* rewriter);
 
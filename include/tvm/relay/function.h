@@ -117,7 +117,7 @@ class Function : public BaseFunc {
                    tvm::DictAttrs attrs = NullValue<DictAttrs>(), Span span = Span());
 
   TVM_DEFINE_OBJECT_REF_METHODS(Function, BaseFunc, FunctionNode);
-  TVM_DEFINE_OBJECT_REF_COW_METHOD(FunctionNode);
+  TVM_DEFINE_OBJECT_REF_COW_METHOD_WITH_SHASH_CACHE(FunctionNode);
 };
 
 /*!
@@ -195,6 +195,10 @@ constexpr const char* kInline = "Inline";
 constexpr const char* kPartitionedFromPattern = "PartitionedFromPattern";
 /*! \brief Mark the function as only composed of reshape operations. */
 constexpr const char* kReshapeOnly = "relay.reshape_only";
+/*! \brief The indices of the parameters the output of a primitive function may be written into. */
+constexpr const char* kInplaceParams = "relay.inplace_params";
+/*! \brief The static upper bound of the dynamic result type of a primitive function. */
+constexpr const char* kShapeUpperBound = "relay.shape_upper_bound";
 
 }  // namespace attr
 
@@ -89,6 +89,13 @@ using TNonComputational = bool;
  */
 using TReshapeOp = bool;
 
+/*!
+ * \brief Mark whether the operator may write its output into the memory of an input of the same
+ *        type, which is the case when each output element only reads the same element of that
+ *        input. Defaults to whether the operator pattern is kElemWise.
+ */
+using TInplaceOp = bool;
+
 /*!
  * \brief Mark the operator whether output shape is data dependent.
  */
@@ -32,9 +32,24 @@ namespace relay {
 
 using MetaTable = Map<String, Array<ObjectRef>>;
 
+/*! \brief Options of the parser, trading its output for speed on large inputs. */
+struct ParseOptions {
+  /*!
+   * \brief Whether to set the spans of the parsed expressions. The diagnostics of the parser
+   *  itself point into the source either way.
+   */
+  bool track_spans = true;
+  /*!
+   * \brief The number of threads parsing the global functions of a module, 1 to parse them in
+   *  order on the calling thread, or 0 to use all of the cores.
+   */
+  int num_threads = 1;
+};
+
 IRModule ParseModule(const std::string& file_name, const std::string& file_content,
                      const Optional<IRModule>& init_module = Optional<IRModule>(),
-                     const MetaTable& init_meta_table = MetaTable());
+                     const MetaTable& init_meta_table = MetaTable(),
+                     const ParseOptions& options = ParseOptions());
 
 /*!
  * \brief This pass pretty-prints mod then parses it back so as to establish spans and sources
@@ -55,12 +55,13 @@ using Sequential = tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param thread_safe Whether the pass can run on several functions at once.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreateFunctionPass(
     const runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required);
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe = true);
 
 /*! \brief Remove let-bound expressions which do not effect the program result.
  *
@@ -102,6 +103,20 @@ TVM_DLL Pass DeadCodeElimination(bool inline_once = false, bool ignore_purity =
  */
 TVM_DLL Pass LazyGradientInit();
 
+/*!
+ * \brief Wrap segments of the dataflow of each function in annotation.checkpoint, so that the
+ * higher order gradient recomputes their intermediate values in the backward pass instead of
+ * keeping them alive.
+ *
+ * The segments end on values which are the only value of the segment used afterwards.
+ *
+ * \param memory_budget_bytes The bytes of the intermediate values of a segment, at most when
+ * possible. If 0, the values are split in sqrt(N) segments.
+ *
+ * \return the pass
+ */
+TVM_DLL Pass AnnotateCheckpoints(int64_t memory_budget_bytes = 0);
+
 /*!
  * \brief Fold constant expressions.
  *
@@ -399,6 +414,21 @@ TVM_DLL Pass MetaScheduleLayoutRewrite();
  */
 TVM_DLL Pass ConvertLayout(const Map<String, Array<String>>& desired_layouts);
 
+/*!
+ * \brief Convert the layouts like ConvertLayout, selecting the desired layouts of each call among
+ * candidates. The selection minimizes the cost of the kernels plus the cost of the layout
+ * transforms needed between the calls and at the boundary of the function.
+ *
+ * \param candidate_layouts Specify mapping of op_name to the candidate arrays of desired layouts
+ *                          for each input. Include the current layouts to allow keeping them.
+ * \param kernel_cost The function taking a call and desired layouts, returning the cost of the
+ *                    converted kernel in seconds, or a negative value if not supported. If null,
+ *                    only the layout transforms are accounted for.
+ * \return The pass.
+ */
+TVM_DLL Pass ConvertLayoutAuto(const Map<String, Array<Array<String>>>& candidate_layouts,
+                               runtime::PackedFunc kernel_cost);
+
 /*!
  * \brief Legalizes an expr with another expression.
  * \param legalize_map_attr_name The Op's attr name which corresponds to the legalize rule function.
@@ -166,6 +166,20 @@ TVM_DLL int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv);
  */
 TVM_DLL int TVMBackendRunOnce(void** handle, int (*f)(void*), void* cdata, int nbytes);
 
+/*!
+ * \brief Record the start or the end of a region instrumented by
+ *  tir.transform.InstrumentProfileIntrinsics.
+ *
+ *  The events are written into a preallocated per thread ring buffer and only
+ *  recorded between runtime.profiling.StartProfileIntrinsics and
+ *  runtime.profiling.StopProfileIntrinsics.
+ *
+ * \param id The id of the instrumented region.
+ * \param is_end Whether the region ends, otherwise it starts.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+TVM_DLL int TVMBackendProfileIntrinsic(int32_t id, int32_t is_end);
+
 #ifdef __cplusplus
 }  // TVM_EXTERN_C
 #endif
@@ -506,6 +506,20 @@ TVM_DLL int TVMArrayFromDLPack(DLManagedTensor* from, TVMArrayHandle* out);
  */
 TVM_DLL int TVMArrayToDLPack(TVMArrayHandle from, DLManagedTensor** out);
 
+/*!
+ * \brief Produce a DLMangedTensor from the array that shares data memory with
+ * the array, to be used on the stream of a consumer.
+ *
+ * The work submitted to the current stream of the device of the array is ordered
+ * before the work submitted to the consumer stream afterwards, without blocking the host.
+ * \param from The source array.
+ * \param consumer_stream The stream the consumer uses the array on.
+ * \param out The DLManagedTensor handle.
+ * \return 0 when success, nonzero when failure happens
+ */
+TVM_DLL int TVMArrayToDLPackWithStream(TVMArrayHandle from, TVMStreamHandle consumer_stream,
+                                       DLManagedTensor** out);
+
 /*!
  * \brief Delete (free) a DLManagedTensor's data.
  * \param dltensor Pointer to the DLManagedTensor.
@@ -28,6 +28,15 @@
 #define USE_FALLBACK_STL_MAP 0
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
 #include <algorithm>
 #include <unordered_map>
 #include <utility>
@@ -564,6 +573,10 @@ class SmallMapNode : public MapNode,
  * suggestion in [1] that also use triangle numbers for "next pointer" as well as sparing for list
  * head.
  *
+ * B5. Group scan of the metadata. Iteration skips empty slots a block at a time: the 16 metadata
+ * bytes of a block are compared against kEmptySlot with one SSE2 or NEON instruction, and the
+ * resulting bit mask of occupied slots gives the next one with a bit scan.
+ *
  * [1] https://github.com/skarupke/flat_hash_map
  * [2] https://programmingpraxis.com/2018/06/19/fibonacci-hash/
  * [3] https://fgiesen.wordpress.com/2015/02/22/triangular-numbers-mod-2n/
@@ -634,12 +647,8 @@ class DenseMapNode : public MapNode {
     if (slots_ == 0) {
       return iterator(0, this);
     }
-    for (uint64_t index = 0; index <= slots_; ++index) {
-      if (!ListNode(index, this).IsEmpty()) {
-        return iterator(index, this);
-      }
-    }
-    return iterator(slots_ + 1, this);
+    // The slot after the largest index wraps around to the first one.
+    return iterator(IncItr(static_cast<uint64_t>(-1)), this);
   }
   /*! \return end iterator */
   iterator end() const { return slots_ == 0 ? iterator(0, this) : iterator(slots_ + 1, this); }
@@ -921,10 +930,13 @@ class DenseMapNode : public MapNode {
    * \return The increased pointer
    */
   uint64_t IncItr(uint64_t index) const {
-    for (++index; index <= slots_; ++index) {
-      if (!ListNode(index, this).IsEmpty()) {
-        return index;
+    for (++index; index <= slots_;) {
+      uint64_t offset = index % kBlockCap;
+      uint32_t occupied = OccupiedSlots(data_[index / kBlockCap]) >> offset;
+      if (occupied != 0) {
+        return index + CountTrailingZeros(occupied);
       }
+      index += kBlockCap - offset;
     }
     return slots_ + 1;
   }
@@ -935,13 +947,63 @@ class DenseMapNode : public MapNode {
    */
   uint64_t DecItr(uint64_t index) const {
     while (index != 0) {
-      index -= 1;
-      if (!ListNode(index, this).IsEmpty()) {
-        return index;
+      uint64_t offset = (index - 1) % kBlockCap;
+      // The occupied slots of the block up to and including index - 1.
+      uint32_t occupied = OccupiedSlots(data_[(index - 1) / kBlockCap]) &
+                          ((uint32_t(2) << offset) - 1);
+      if (occupied != 0) {
+        return index - 1 - offset + (31 - CountLeadingZeros(occupied));
       }
+      index -= offset + 1;
     }
     return slots_ + 1;
   }
+  /*!
+   * \brief The slots of a block whose metadata is not kEmptySlot.
+   * \param block The block.
+   * \return A mask with the i-th bit set if the i-th slot of the block is occupied.
+   */
+  static uint32_t OccupiedSlots(const Block& block) {
+    const uint8_t* meta = block.bytes;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(meta));
+    __m128i empty = _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(kEmptySlot)));
+    return ~static_cast<uint32_t>(_mm_movemask_epi8(empty)) & 0xFFFFu;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    static const uint8_t kBitWeights[kBlockCap] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                                   1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t occupied = vmvnq_u8(vceqq_u8(vld1q_u8(meta), vdupq_n_u8(kEmptySlot)));
+    uint8x16_t bits = vandq_u8(occupied, vld1q_u8(kBitWeights));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) |
+           (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+#else
+    uint32_t occupied = 0;
+    for (int i = 0; i < kBlockCap; ++i) {
+      occupied |= static_cast<uint32_t>(meta[i] != kEmptySlot) << i;
+    }
+    return occupied;
+#endif
+  }
+  /*! \brief The number of trailing zero bits of a non-zero mask. */
+  static int CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+  }
+  /*! \brief The number of leading zero bits of a non-zero mask. */
+  static int CountLeadingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return 31 - static_cast<int>(index);
+#else
+    return __builtin_clz(mask);
+#endif
+  }
   /*!
    * \brief De-reference the pointer
    * \param index The pointer to be dereferenced
@@ -24,6 +24,8 @@
 #ifndef TVM_RUNTIME_CONTAINER_SHAPE_TUPLE_H_
 #define TVM_RUNTIME_CONTAINER_SHAPE_TUPLE_H_
 
+#include <algorithm>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -50,6 +52,16 @@ class ShapeTupleObj : public Object {
   /*! \brief ShapeTuple object which is moved from std::vector container. */
   class FromStd;
 
+  /*!
+   * \brief Create a shape tuple whose elements directly follow the object in the same
+   *  allocation.
+   * \param begin begin of iterator
+   * \param end end of iterator
+   * \param size The number of elements.
+   */
+  template <typename IterType>
+  static ObjectPtr<ShapeTupleObj> CreateInplace(IterType begin, IterType end, size_t size);
+
   friend class ShapeTuple;
 };
 
@@ -83,10 +95,19 @@ class ShapeTuple : public ObjectRef {
   /*! \brief The type of shape index element. */
   using index_type = ShapeTupleObj::index_type;
 
+  /*!
+   * \brief Shapes of up to this many elements are stored in the same allocation as the
+   *  object, even when constructed from a std::vector.
+   */
+  static constexpr size_t kMaxInplaceSize = 8;
+
   /*!
    * \brief Construct an empty shape tuple.
    */
-  ShapeTuple() : ShapeTuple(std::vector<index_type>()) {}
+  ShapeTuple() {
+    data_ = ShapeTupleObj::CreateInplace(static_cast<const index_type*>(nullptr),
+                                         static_cast<const index_type*>(nullptr), 0);
+  }
 
   /*!
    * \brief Constructor from iterator
@@ -95,7 +116,9 @@ class ShapeTuple : public ObjectRef {
    * \tparam IterType The type of iterator
    */
   template <typename IterType>
-  ShapeTuple(IterType begin, IterType end) : ShapeTuple(std::vector<index_type>(begin, end)) {}
+  ShapeTuple(IterType begin, IterType end) {
+    data_ = ShapeTupleObj::CreateInplace(begin, end, std::distance(begin, end));
+  }
 
   /*!
    * \brief constructor from initializer list
@@ -163,7 +186,21 @@ class ShapeTuple : public ObjectRef {
   TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(ShapeTuple, ObjectRef, ShapeTupleObj);
 };
 
+template <typename IterType>
+inline ObjectPtr<ShapeTupleObj> ShapeTupleObj::CreateInplace(IterType begin, IterType end,
+                                                             size_t size) {
+  auto ptr = make_inplace_array_object<ShapeTupleObj, index_type>(size);
+  ptr->size = size;
+  ptr->data = reinterpret_cast<index_type*>(ptr.get() + 1);
+  std::copy(begin, end, ptr->data);
+  return ptr;
+}
+
 inline ShapeTuple::ShapeTuple(std::vector<index_type> shape) {
+  if (shape.size() <= kMaxInplaceSize) {
+    data_ = ShapeTupleObj::CreateInplace(shape.begin(), shape.end(), shape.size());
+    return;
+  }
   auto ptr = make_object<ShapeTupleObj::FromStd>(std::move(shape));
   ptr->size = ptr->data_container.size();
   ptr->data = ptr->data_container.data();
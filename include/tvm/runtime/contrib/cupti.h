@@ -0,0 +1,51 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*!
+ * \brief Per-kernel performance counters of NVIDIA GPUs for profiling via CUPTI.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_CUPTI_H_
+#define TVM_RUNTIME_CONTRIB_CUPTI_H_
+
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/profiling.h>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+/*! \brief Construct a metric collector that collects data from the hardware
+ * performance counters of NVIDIA GPUs using the range profiler of the CUDA
+ * Profiling Tools Interface (CUPTI).
+ *
+ * Every kernel is replayed until all its counters are collected, so the
+ * durations of a profiling run with this collector are not meaningful.
+ *
+ * \param metrics A mapping from a device to the metrics that should be
+ * collected on that device. Metric names are the ones of Nsight Compute, you
+ * can list them with `ncu --query-metrics`. Devices without metrics collect
+ * the achieved occupancy, DRAM bytes, L2 hit rate, tensor core utilization and
+ * SM efficiency.
+ */
+TVM_DLL MetricCollector CreateCUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics);
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_CUPTI_H_
@@ -56,11 +56,70 @@ typedef struct TVMGraphExecutorGraphAttr {
 
 typedef struct TVMGraphExecutor TVMGraphExecutor;
 
+/*!
+ * \brief The leading bytes of a graph in the binary graph format, kTVMGraphBinaryMagic in the
+ *  C++ runtime.
+ */
+#define TVM_GRAPH_BINARY_MAGIC "TVMGRAPH"
+
+/*!
+ * \brief The leading bytes of a graph in the flat graph format, kTVMGraphFlatMagic in the
+ *  C++ runtime.
+ */
+#define TVM_GRAPH_FLAT_MAGIC "TVMGFLAT"
+
+/*!
+ * \brief The header of a graph in the flat graph format, see GraphExecutor::SaveGraphFlat.
+ *
+ *  The graph executor uses the tables of a flat graph in place, so the graph must be 8-byte
+ *  aligned and outlive the executor. The offsets are in bytes from the start of the graph.
+ */
+typedef struct TVMGraphFlatHeader {
+  char magic[8];
+  uint32_t nodes_count;
+  uint32_t input_nodes_count;
+  uint32_t node_row_ptr_count;
+  uint32_t outputs_count;
+  uint32_t entries_count;
+  /*! \brief Number of int64 dimensions stored for each entry shape. */
+  uint32_t shape_stride;
+  /*! \brief Offset of the TVMGraphFlatNode of each node. */
+  uint32_t nodes;
+  /*! \brief Offset of the uint32 argument node ids. */
+  uint32_t input_nodes;
+  /*! \brief Offset of the uint32 node_row_ptr elements. */
+  uint32_t node_row_ptr;
+  /*! \brief Offset of the uint32 node id, index and version of each output. */
+  uint32_t outputs;
+  /*! \brief Offset of the uint32 storage id of each entry. */
+  uint32_t storage_id;
+  /*! \brief Offset of the DLDataType of each entry. */
+  uint32_t dltype;
+  /*! \brief Offset of the uint32 ndim of each entry. */
+  uint32_t ndim;
+  /*! \brief Offset of the shape_stride int64 dimensions of each entry. */
+  uint32_t shape;
+} TVMGraphFlatHeader;
+
+/*! \brief A node of a graph in the flat graph format. */
+typedef struct TVMGraphFlatNode {
+  /*! \brief Offsets of the NUL-terminated op type, name and function name. */
+  uint32_t op_type;
+  uint32_t name;
+  uint32_t func_name;
+  uint32_t num_inputs;
+  uint32_t num_outputs;
+  uint32_t flatten_data;
+  /*! \brief Offset of the uint32 node id, index and version of each input. */
+  uint32_t inputs;
+  uint32_t inputs_count;
+} TVMGraphFlatNode;
+
 // public functions
 /*!
  * \brief Allocate a new GraphExecutor with TVMPlatformMemoryAllocate and initialize it.
  *
- * \param sym_json JSON-encoded graph.
+ * \param sym_json JSON-encoded graph, or a graph in the binary or flat graph format.
  * \param module_handle TVM Module that exposes the functions to call.
  * \param devices runtime execution device.
  * \param executor Pointer which receives a pointer to the newly-created instance.
@@ -139,6 +139,27 @@ tvm_crt_error_t TVMPlatformAfterMeasurement();
  */
 tvm_crt_error_t TVMPlatformGenerateRandom(uint8_t* buffer, size_t num_bytes);
 
+/*! \brief Start copying a buffer, e.g. with DMA, without waiting for the copy to complete.
+ *
+ * Called by the AOT executor to stream the constants of the next operator from read-only memory
+ * (e.g. flash) into the workspace while the current operator runs, when the constant-prefetch
+ * executor option is set. When not implemented, an internal weak-linked stub copies the buffer
+ * with memcpy.
+ *
+ * \param dst Pointer to the 0th byte of the destination.
+ * \param src Pointer to the 0th byte of the source.
+ * \param num_bytes Number of bytes to copy.
+ * eturn kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TVMPlatformMemcpyAsync(void* dst, const void* src, uint32_t num_bytes);
+
+/*! \brief Wait for the copy started by TVMPlatformMemcpyAsync into a buffer to complete.
+ *
+ * \param dst Pointer to the 0th byte of the destination passed to TVMPlatformMemcpyAsync.
+ * eturn kTvmErrorNoError if successful; a descriptive error code otherwise.
+ */
+tvm_crt_error_t TVMPlatformMemcpyWait(void* dst);
+
 /*! \brief Initialize TVM inference.
  *
  * Placeholder function for TVM inference initializations on a specific platform.
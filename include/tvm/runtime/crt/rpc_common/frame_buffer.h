@@ -49,6 +49,8 @@ class FrameBuffer {
 
   size_t Size() const { return num_valid_bytes_; }
 
+  size_t Capacity() const { return capacity_; }
+
  private:
   /*! \brief pointer to data buffer. */
   uint8_t* data_;
@@ -96,6 +96,7 @@ class Session {
       : local_nonce_{kInvalidNonce},
         session_id_{0},
         state_{State::kReset},
+        peer_max_packet_size_bytes_{0},
         receiver_{this},
         framer_{framer},
         receive_buffer_{receive_buffer},
@@ -182,6 +183,16 @@ class Session {
   /*! \brief Returns true if the session is in the established state. */
   bool IsEstablished() const { return state_ == State::kSessionEstablished; }
 
+  /*!
+   * \brief The largest packet the remote end can receive, in bytes.
+   *
+   * Each end advertises the capacity of its receive buffer in the session start messages, so that
+   * the other end can size its frames. A packet holds the session header and the message.
+   *
+   * \return The remote receive capacity, or 0 before a session is established.
+   */
+  size_t PeerMaxPacketSizeBytes() const { return peer_max_packet_size_bytes_; }
+
   /*!
    * \brief Clear the receive buffer and prepare to receive next message.
    *
@@ -192,7 +203,7 @@ class Session {
   void ClearReceiveBuffer();
 
   /*! \brief A version number used to check compatibility of the remote session implementation. */
-  static const constexpr uint8_t kVersion = 0x01;
+  static const constexpr uint8_t kVersion = 0x02;
 
  private:
   class SessionReceiver : public WriteStream {
@@ -220,7 +231,9 @@ class Session {
   tvm_crt_error_t SendInternal(MessageType message_type, const uint8_t* message_data,
                                size_t message_size_bytes);
 
-  void SendSessionStartReply(const SessionHeader& header);
+  tvm_crt_error_t SendSessionStart(MessageType message_type);
+
+  void SendSessionStartReply(const SessionHeader& header, uint32_t peer_max_packet_size_bytes);
 
   void ProcessStartSessionInit(const SessionHeader& header);
 
@@ -241,6 +254,7 @@ class Session {
   uint8_t local_nonce_;
   uint16_t session_id_;
   State state_;
+  uint32_t peer_max_packet_size_bytes_;
   SessionReceiver receiver_;
   Framer* framer_;
   FrameBuffer* receive_buffer_;
@@ -0,0 +1,105 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/crt/tlsf_allocator.h
+ * \brief A constant-time dynamic memory allocator for microcontrollers.
+ */
+
+#ifndef TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
+#define TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/page_allocator.h>
+
+/*! \brief Usage counters of a TLSF memory manager. */
+typedef struct TLSFMemoryManagerStats {
+  /*! \brief Bytes handed out to live allocations, after rounding to the alignment. */
+  size_t used_bytes;
+  /*! \brief The highest used_bytes since creation or the last TLSFMemoryManagerResetPeak. */
+  size_t peak_used_bytes;
+  /*! \brief Bytes of all the free blocks. */
+  size_t free_bytes;
+  /*! \brief Bytes of the largest free block, i.e. the largest allocation which can succeed. */
+  size_t largest_free_bytes;
+  /*! \brief The number of successful allocations. */
+  size_t num_allocations;
+  /*! \brief The number of allocations which failed. */
+  size_t num_failed_allocations;
+  /*! \brief The number of allocations which failed although free_bytes was large enough. */
+  size_t num_fragmented_failures;
+} TLSFMemoryManagerStats;
+
+/*!
+ * \brief Create a two-level segregated fit (TLSF) memory manager.
+ *
+ * Allocate and Free run in constant time. Free blocks are kept in size classes, 16-byte
+ * classes below 256 bytes and 16 classes per power of two above, found with two bitmaps.
+ * Allocations are rounded up to 16 bytes rather than to a page, which suits the many small
+ * tensors of models running in tens of KB of RAM. Freed blocks are merged with free
+ * neighbours at once.
+ *
+ * \param manager Pointer, initialized with the new MemoryManager.
+ * \param memory_pool Pointer to the global memory pool used by the CRT. The manager keeps its
+ *  state at the start of the pool.
+ * \param memory_pool_size_bytes Size of `memory_pool`, in bytes.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** manager, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes);
+
+/*!
+ * \brief Read the usage counters of a TLSF memory manager.
+ * \param manager A manager created by TLSFMemoryManagerCreate.
+ * \param stats Filled with the counters.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFMemoryManagerGetStats(MemoryManagerInterface* manager,
+                                          TLSFMemoryManagerStats* stats);
+
+/*!
+ * \brief Restart the peak usage from the current usage, e.g. before running a model.
+ * \param manager A manager created by TLSFMemoryManagerCreate.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFMemoryManagerResetPeak(MemoryManagerInterface* manager);
+
+/*!
+ * \brief Register the functions reading the counters of a TLSF memory manager over RPC.
+ *
+ * Call after TVMInitializeRuntime. "tvm.crt.memory.get_stats" fills an int64 tensor with the
+ * fields of TLSFMemoryManagerStats, in order. "tvm.crt.memory.reset_peak" calls
+ * TLSFMemoryManagerResetPeak.
+ *
+ * \param manager A manager created by TLSFMemoryManagerCreate.
+ * \return kTvmErrorNoError on success.
+ */
+tvm_crt_error_t TLSFMemoryManagerRegisterFuncs(MemoryManagerInterface* manager);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_TLSF_ALLOCATOR_H_
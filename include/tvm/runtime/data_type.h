@@ -27,6 +27,7 @@
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/logging.h>
 
+#include <cstring>
 #include <string>
 #include <type_traits>
 
@@ -70,12 +71,20 @@ class DataType {
    * \brief Constructor
    * \param code The type code.
    * \param bits The number of bits in the type.
-   * \param lanes The number of lanes.
+   * \param lanes The number of lanes, or the multiplier of vscale of a scalable vector.
+   * \param is_scalable Whether the vector has vscale * lanes lanes, with vscale only known at
+   *  runtime.
    */
-  DataType(int code, int bits, int lanes) {
+  DataType(int code, int bits, int lanes, bool is_scalable = false) {
     data_.code = static_cast<uint8_t>(code);
     data_.bits = static_cast<uint8_t>(bits);
-    data_.lanes = static_cast<uint16_t>(lanes);
+    if (is_scalable) {
+      ICHECK_GT(lanes, 1) << "The vscale factor of a scalable vector must be greater than 1";
+      // A scalable vector stores the negated vscale factor in the lanes.
+      data_.lanes = static_cast<uint16_t>(-lanes);
+    } else {
+      data_.lanes = static_cast<uint16_t>(lanes);
+    }
     if (code == kBFloat) {
       ICHECK_EQ(bits, 16);
     }
@@ -89,10 +98,29 @@ class DataType {
   int bits() const { return static_cast<int>(data_.bits); }
   /*! \return number of bytes to store each scalar. */
   int bytes() const { return (bits() + 7) / 8; }
-  /*! \return number of lanes in the data. */
-  int lanes() const { return static_cast<int>(data_.lanes); }
+  /*! \return number of lanes in the data, which is not known for a scalable vector. */
+  int lanes() const {
+    int lanes_as_int = static_cast<int16_t>(data_.lanes);
+    if (lanes_as_int < 0) {
+      LOG(FATAL) << "Can't fetch the lanes of a scalable vector at compile time, use "
+                    "vscale_factor() or get_lanes_or_vscale_factor() instead";
+    }
+    return lanes_as_int;
+  }
+  /*! \return the multiplier of vscale in the lanes of a scalable vector. */
+  int vscale_factor() const {
+    int lanes_as_int = static_cast<int16_t>(data_.lanes);
+    if (lanes_as_int >= -1) {
+      LOG(FATAL) << "A fixed length vector doesn't have a vscale factor";
+    }
+    return -lanes_as_int;
+  }
+  /*! \return the vscale factor of a scalable vector, otherwise the number of lanes. */
+  int get_lanes_or_vscale_factor() const {
+    return is_scalable_vector() ? vscale_factor() : lanes();
+  }
   /*! \return whether type is a scalar type. */
-  bool is_scalar() const { return lanes() == 1; }
+  bool is_scalar() const { return !is_scalable_vector() && lanes() == 1; }
   /*! \return whether type is a scalar type. */
   bool is_bool() const { return code() == DataType::kUInt && bits() == 1; }
   /*! \return whether type is a float type. */
@@ -113,18 +141,32 @@ class DataType {
   bool is_uint() const { return code() == DataType::kUInt; }
   /*! \return whether type is a handle type. */
   bool is_handle() const { return code() == DataType::kHandle && !is_void(); }
-  /*! \return whether type is a vector type. */
-  bool is_vector() const { return lanes() > 1; }
+  /*! \return whether type is a fixed length vector type. */
+  bool is_fixed_length_vector() const { return static_cast<int16_t>(data_.lanes) > 1; }
+  /*! \return whether type is a scalable vector type, with vscale * vscale_factor() lanes. */
+  bool is_scalable_vector() const { return static_cast<int16_t>(data_.lanes) < -1; }
+  /*! \return whether type is a vector type, either of fixed length or scalable. */
+  bool is_vector() const { return is_fixed_length_vector() || is_scalable_vector(); }
   /*! \return whether type is a bool vector type. */
   bool is_vector_bool() const { return is_vector() && bits() == 1; }
   /*! \return whether type is a Void type. */
-  bool is_void() const { return code() == DataType::kHandle && bits() == 0 && lanes() == 0; }
+  bool is_void() const {
+    return code() == DataType::kHandle && bits() == 0 && static_cast<int16_t>(data_.lanes) == 0;
+  }
   /*!
    * \brief Create a new data type by change lanes to a specified value.
    * \param lanes The target number of lanes.
    * \return the result type.
    */
   DataType with_lanes(int lanes) const { return DataType(data_.code, data_.bits, lanes); }
+  /*!
+   * \brief Create a new scalable vector data type by changing the vscale factor.
+   * \param vscale_factor The multiplier of vscale in the number of lanes.
+   * \return the result type.
+   */
+  DataType with_scalable_vscale_factor(int vscale_factor) const {
+    return DataType(data_.code, data_.bits, vscale_factor, true);
+  }
   /*!
    * \brief Create a new data type by change bits to a specified value.
    * \param bits The target number of bits.
@@ -171,23 +213,32 @@ class DataType {
    * \brief Construct an int type.
    * \param bits The number of bits in the type.
    * \param lanes The number of lanes.
+   * \param is_scalable Whether the data type is scalable.
    * \return The constructed data type.
    */
-  static DataType Int(int bits, int lanes = 1) { return DataType(kDLInt, bits, lanes); }
+  static DataType Int(int bits, int lanes = 1, bool is_scalable = false) {
+    return DataType(kDLInt, bits, lanes, is_scalable);
+  }
   /*!
    * \brief Construct an uint type.
    * \param bits The number of bits in the type.
    * \param lanes The number of lanes
+   * \param is_scalable Whether the data type is scalable.
    * \return The constructed data type.
    */
-  static DataType UInt(int bits, int lanes = 1) { return DataType(kDLUInt, bits, lanes); }
+  static DataType UInt(int bits, int lanes = 1, bool is_scalable = false) {
+    return DataType(kDLUInt, bits, lanes, is_scalable);
+  }
   /*!
    * \brief Construct an float type.
    * \param bits The number of bits in the type.
    * \param lanes The number of lanes
+   * \param is_scalable Whether the data type is scalable.
    * \return The constructed data type.
    */
-  static DataType Float(int bits, int lanes = 1) { return DataType(kDLFloat, bits, lanes); }
+  static DataType Float(int bits, int lanes = 1, bool is_scalable = false) {
+    return DataType(kDLFloat, bits, lanes, is_scalable);
+  }
   /*!
    * \brief Construct an bfloat type.
    * \param bits The number of bits in the type.
@@ -210,9 +261,12 @@ class DataType {
   /*!
    * \brief Construct a bool type.
    * \param lanes The number of lanes
+   * \param is_scalable Whether the data type is scalable.
    * \return The constructed data type.
    */
-  static DataType Bool(int lanes = 1) { return DataType::UInt(1, lanes); }
+  static DataType Bool(int lanes = 1, bool is_scalable = false) {
+    return DataType::UInt(1, lanes, is_scalable);
+  }
   /*!
    * \brief Construct a handle type.
    * \param bits The number of bits in the type.
@@ -356,8 +410,11 @@ inline std::ostream& operator<<(std::ostream& os, DLDataType t) {  // NOLINT(*)
   }
   if (t.code == kTVMOpaqueHandle) return os;
   os << static_cast<int>(t.bits);
-  if (t.lanes != 1) {
-    os << 'x' << static_cast<int>(t.lanes);
+  int16_t lanes = static_cast<int16_t>(t.lanes);
+  if (lanes > 1) {
+    os << 'x' << lanes;
+  } else if (lanes < -1) {
+    os << "xvscalex" << -lanes;
   }
   return os;
 }
@@ -420,7 +477,10 @@ inline DLDataType String2DLDataType(std::string s) {
   uint8_t bits = static_cast<uint8_t>(strtoul(scan, &xdelim, 10));
   if (bits != 0) t.bits = bits;
   char* endpt = xdelim;
-  if (*xdelim == 'x') {
+  if (strncmp(xdelim, "xvscalex", 8) == 0) {
+    int vscale_factor = static_cast<int>(strtoul(xdelim + 8, &endpt, 10));
+    t = DataType(t.code, t.bits, vscale_factor, true);
+  } else if (*xdelim == 'x') {
     t.lanes = static_cast<uint16_t>(strtoul(xdelim + 1, &endpt, 10));
   }
   ICHECK(endpt == s.c_str() + s.length()) << "unknown type " << s;
@@ -440,7 +500,7 @@ struct hash<tvm::DataType> {
   std::size_t operator()(tvm::DataType const& dtype) const {
     int a = dtype.code();
     int b = dtype.bits();
-    int c = dtype.lanes();
+    int c = static_cast<int16_t>(static_cast<DLDataType>(dtype).lanes);
     int d = cantor_pairing_function(a, b);
     return cantor_pairing_function(c, d);
   }
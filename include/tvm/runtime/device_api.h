@@ -166,6 +166,12 @@ class TVM_DLL DeviceAPI {
    * \param stream The stream to be set.
    */
   virtual void SetStream(Device dev, TVMStreamHandle stream) {}
+  /*!
+   * \brief Get the stream set for the calling thread.
+   * \param dev The device to get the stream of.
+   * \return The current stream, nullptr for the default stream.
+   */
+  virtual TVMStreamHandle GetCurrentStream(Device dev) { return nullptr; }
   /*!
    * \brief Synchronize 2 streams of execution.
    *
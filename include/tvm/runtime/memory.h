@@ -25,7 +25,10 @@
 
 #include <tvm/runtime/object.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -45,9 +48,13 @@ inline ObjectPtr<T> make_object(Args&&... args);
 // The current design allows swapping the
 // allocator pattern when necessary.
 //
+// make_object uses DefaultObjAllocator, which recycles the memory of released
+// objects in thread-local free lists, one per size class (PooledObjAllocator).
+// Define TVM_DISABLE_OBJECT_POOL to use plain new/delete instead, e.g. for
+// memory checkers.
+//
 // Possible future allocator optimizations:
 // - Arena allocator that gives ownership of memory to arena (deleter_= nullptr)
-// - Thread-local object pools: one pool per size and alignment requirement.
 // - Can specialize by type of object to give the specific allocator to each object.
 
 /*!
@@ -191,15 +198,127 @@ class SimpleObjAllocator : public ObjAllocatorBase<SimpleObjAllocator> {
   };
 };
 
+/*! \brief Allocation counters of the object pool of a thread. */
+struct ObjectPoolStats {
+  /*! \brief The number of blocks allocated. */
+  int64_t num_allocs{0};
+  /*! \brief The number of allocations served from a free list. */
+  int64_t num_reused{0};
+  /*! \brief The number of blocks released. */
+  int64_t num_frees{0};
+  /*! \brief The number of bytes held in the free lists. */
+  int64_t cached_bytes{0};
+};
+
+/*! \brief The alignment of the blocks of the object pool, the one of operator new. */
+constexpr size_t kObjectPoolAlignment = alignof(std::max_align_t);
+/*! \brief Larger blocks are not pooled. */
+constexpr size_t kObjectPoolMaxBytes = 512;
+
+/*!
+ * \brief Allocate a block from the object pool of the calling thread.
+ * \param nbytes The size of the block.
+ * \return The block, aligned to kObjectPoolAlignment.
+ */
+TVM_DLL void* ObjectPoolAlloc(size_t nbytes);
+
+/*!
+ * \brief Release a block to the object pool of the calling thread.
+ * \param ptr The block, which can come from the pool of another thread.
+ * \param nbytes The size the block was allocated with.
+ */
+TVM_DLL void ObjectPoolFree(void* ptr, size_t nbytes);
+
+/*! \return The allocation counters of the object pool of the calling thread. */
+TVM_DLL ObjectPoolStats GetObjectPoolStats();
+
+/*! \brief Release the free lists of the object pool of the calling thread. */
+TVM_DLL void ReleaseObjectPool();
+
+// Allocator that recycles memory through ObjectPoolAlloc and ObjectPoolFree.
+// Types with a larger alignment than the pool fall back to new/delete.
+class PooledObjAllocator : public ObjAllocatorBase<PooledObjAllocator> {
+ public:
+  template <typename T>
+  class Handler {
+   public:
+    using StorageType = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+    static constexpr bool kPooled = alignof(StorageType) <= kObjectPoolAlignment;
+
+    template <typename... Args>
+    static T* New(PooledObjAllocator*, Args&&... args) {
+      StorageType* data;
+      if constexpr (kPooled) {
+        data = static_cast<StorageType*>(ObjectPoolAlloc(sizeof(StorageType)));
+      } else {
+        data = new StorageType();
+      }
+      new (data) T(std::forward<Args>(args)...);
+      return reinterpret_cast<T*>(data);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      // See SimpleObjAllocator::Handler for the casts and the explicit destructor call.
+      T* tptr = static_cast<T*>(objptr);
+      tptr->T::~T();
+      if constexpr (kPooled) {
+        ObjectPoolFree(tptr, sizeof(StorageType));
+      } else {
+        delete reinterpret_cast<StorageType*>(tptr);
+      }
+    }
+  };
+
+  // The array is preceded by a header holding the size of the block.
+  template <typename ArrayType, typename ElemType>
+  class ArrayHandler {
+   public:
+    static_assert(alignof(ArrayType) % alignof(ElemType) == 0 &&
+                      sizeof(ArrayType) % alignof(ElemType) == 0,
+                  "element alignment constraint");
+    static_assert(alignof(ArrayType) <= kObjectPoolAlignment,
+                  "the array header is only aligned to the object pool");
+
+    template <typename... Args>
+    static ArrayType* New(PooledObjAllocator*, size_t num_elems, Args&&... args) {
+      size_t nbytes = kObjectPoolAlignment + sizeof(ArrayType) + num_elems * sizeof(ElemType);
+      char* block = static_cast<char*>(ObjectPoolAlloc(nbytes));
+      *reinterpret_cast<size_t*>(block) = nbytes;
+      void* data = block + kObjectPoolAlignment;
+      new (data) ArrayType(std::forward<Args>(args)...);
+      return reinterpret_cast<ArrayType*>(data);
+    }
+
+    static Object::FDeleter Deleter() { return Deleter_; }
+
+   private:
+    static void Deleter_(Object* objptr) {
+      ArrayType* tptr = static_cast<ArrayType*>(objptr);
+      tptr->ArrayType::~ArrayType();
+      char* block = reinterpret_cast<char*>(tptr) - kObjectPoolAlignment;
+      ObjectPoolFree(block, *reinterpret_cast<size_t*>(block));
+    }
+  };
+};
+
+#ifdef TVM_DISABLE_OBJECT_POOL
+using DefaultObjAllocator = SimpleObjAllocator;
+#else
+using DefaultObjAllocator = PooledObjAllocator;
+#endif
+
 template <typename T, typename... Args>
 inline ObjectPtr<T> make_object(Args&&... args) {
-  return SimpleObjAllocator().make_object<T>(std::forward<Args>(args)...);
+  return DefaultObjAllocator().make_object<T>(std::forward<Args>(args)...);
 }
 
 template <typename ArrayType, typename ElemType, typename... Args>
 inline ObjectPtr<ArrayType> make_inplace_array_object(size_t num_elems, Args&&... args) {
-  return SimpleObjAllocator().make_inplace_array<ArrayType, ElemType>(num_elems,
-                                                                      std::forward<Args>(args)...);
+  return DefaultObjAllocator().make_inplace_array<ArrayType, ElemType>(
+      num_elems, std::forward<Args>(args)...);
 }
 
 }  // namespace runtime
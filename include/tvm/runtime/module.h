@@ -269,6 +269,15 @@ class TVM_DLL ModuleNode : public Object {
  */
 TVM_DLL bool RuntimeEnabled(const String& target);
 
+/*!
+ * \brief Do the lazy initialization of a module and its imports for a device ahead of the
+ *  first call, e.g. load the kernels of the device modules and resolve them for the host code.
+ * \param mod The module.
+ * \param dev The device the module will run on.
+ * \sa symbol::tvm_module_preload
+ */
+TVM_DLL void PreloadModule(Module mod, DLDevice dev);
+
 /*! \brief namespace for constant symbols */
 namespace symbol {
 /*! \brief A PackedFunc that retrieves exported metadata. */
@@ -283,6 +292,11 @@ constexpr const char* tvm_set_device = "__tvm_set_device";
 constexpr const char* tvm_global_barrier_state = "__tvm_global_barrier_state";
 /*! \brief Prepare the global barrier before kernels that uses global barrier. */
 constexpr const char* tvm_prepare_global_barrier = "__tvm_prepare_global_barrier";
+/*!
+ * \brief A PackedFunc of device modules that takes a Device and does the lazy initialization
+ *  of the module for it, e.g. loading its kernels.
+ */
+constexpr const char* tvm_module_preload = "__tvm_module_preload";
 /*! \brief Placeholder for the module's entry function. */
 constexpr const char* tvm_module_main = "__tvm_main__";
 /*! \brief Prefix for parameter symbols emitted into the main program. */
@@ -137,6 +137,16 @@ class NDArray : public ObjectRef {
    * \return A DLManagedTensor
    */
   TVM_DLL DLManagedTensor* ToDLPack() const;
+  /*!
+   * \brief Create a reference view of NDArray that represents as DLManagedTensor, to be used
+   *  on the stream of a consumer.
+   *
+   *  The work submitted to the current stream of the device before is ordered before the work
+   *  submitted to \p consumer_stream after, with an event rather than a device synchronization.
+   * \param consumer_stream The stream the consumer uses the array on.
+   * \return A DLManagedTensor
+   */
+  TVM_DLL DLManagedTensor* ToDLPack(TVMStreamHandle consumer_stream) const;
   /*!
    * \brief Create an empty NDArray.
    * \param shape The shape of the new array.
@@ -178,8 +188,21 @@ class NDArray : public ObjectRef {
    * \return The created NDArray view.
    */
   TVM_DLL static NDArray FromDLPack(DLManagedTensor* tensor);
+  /*!
+   * \brief Create a NDArray backed by a dlpack tensor written on the stream of its producer.
+   *
+   *  The work submitted to \p producer_stream before is ordered before the work submitted to
+   *  the current stream of the device after, with an event rather than a device synchronization.
+   * \param tensor The DLPack tensor to copy from.
+   * \param producer_stream The stream the producer wrote the tensor on.
+   * \return The created NDArray view.
+   */
+  TVM_DLL static NDArray FromDLPack(DLManagedTensor* tensor, TVMStreamHandle producer_stream);
   /*!
    * \brief Function to copy data from one array to another.
+   *
+   *  When one array is float32 and the other float16 or bfloat16, the values are converted,
+   *  on the host.
    * \param from The source array.
    * \param to The target array.
    * \param stream The stream used in copy.
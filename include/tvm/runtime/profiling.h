@@ -31,6 +31,9 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <stack>
 #include <string>
 #include <unordered_map>
@@ -182,7 +185,8 @@ class ReportNode : public Object {
    * Each element is a mapping from metric name to value. Some metrics that
    * appear in every call are "Name" (the function name), "Argument Shapes",
    * and "Duration (us)". Values are one of `String`, `PercentNode`,
-   * `DurationNode`, or `CountNode`.
+   * `DurationNode`, or `CountNode`. Calls recorded by a `Profiler` also carry
+   * "Start (us)" and "Thread", which place them on a timeline.
    */
   Array<Map<String, ObjectRef>> calls;
   /*! \brief Metrics collected for the entire run of the model on a per-device basis.
@@ -251,6 +255,16 @@ class ReportNode : public Object {
    * \endcode
    */
   String AsJSON() const;
+  /*! \brief Convert the calls of this report to a timeline in the Chrome trace event format.
+   *
+   * Every call with a "Start (us)" metric becomes a complete event. Devices are
+   * shown as processes and the "Thread" metric of a call selects the thread
+   * within its device. The output can be loaded in `chrome://tracing` or in
+   * Perfetto (https://ui.perfetto.dev).
+   *
+   * Start times are taken on the host, durations come from the device timers.
+   */
+  String AsChromeTrace() const;
 
   static constexpr const char* _type_key = "runtime.profiling.Report";
   TVM_DECLARE_FINAL_OBJECT_INFO(ReportNode, Object);
@@ -340,6 +354,10 @@ struct CallFrame {
    * associated data (returned from MetricCollector.Start).
    */
   std::vector<std::pair<MetricCollector, ObjectRef>> extra_collectors;
+  /*! Host time at which the call started, in microseconds since the profiler started */
+  double start_us;
+  /*! Index of the thread which made the call */
+  int64_t thread;
 };
 
 /*! Runtime profiler for function and/or operator calls. Used in the graph
@@ -407,8 +425,8 @@ class Profiler {
   void StopCall(std::unordered_map<std::string, ObjectRef> extra_metrics = {});
   /*! \brief A report of total runtime between `Start` and `Stop` as
    *        well as individual statistics for each `StartCall`-`StopCall` pair.
-   *  \returns A `Report` that can either be formatted as CSV (with `.AsCSV`)
-   *  or as a human readable table (with `.AsTable`).
+   *  \returns A `Report` that can either be formatted as CSV (with `.AsCSV`),
+   *  as a human readable table (with `.AsTable`) or as a timeline (with `.AsChromeTrace`).
    */
   profiling::Report Report();
   /*! \brief Check if the profiler is currently running.
@@ -423,6 +441,104 @@ class Profiler {
   std::stack<CallFrame> in_flight_;
   std::vector<MetricCollector> collectors_;
   std::unordered_map<String, ObjectRef> configuration_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+/*! \brief Low overhead profiler timing the operators of every Nth request of an executor, so
+ * that it can stay on while serving.
+ *
+ * Unlike `Profiler`, the operators are not synchronized with the host one by
+ * one: the device timers of a sampled request are only read back at the next
+ * sampled request or when a report is made. The latencies of the last
+ * `kSampleWindow` samples of every operator are kept for percentiles.
+ *
+ * Example usage:
+ * \code{.cpp}
+ * SamplingProfiler sampler("Graph");
+ * sampler.SetInterval(100);
+ * // for every request
+ * bool sampled = sampler.BeginRequest();
+ * for (size_t i = 0; i < ops.size(); i++) {
+ *   if (sampled) sampler.StartOp(i, ops[i].name, dev);
+ *   ops[i]();
+ *   if (sampled) sampler.StopOp();
+ * }
+ * // on any thread
+ * std::cout << sampler.Report()->AsTable() << std::endl;
+ * \endcode
+ */
+class SamplingProfiler {
+ public:
+  /*! \brief The number of latest samples kept for every operator. */
+  static constexpr size_t kSampleWindow = 1024;
+  /*! \brief Constructor.
+   * \param executor The name of the executor, added to the configuration of the reports.
+   */
+  explicit SamplingProfiler(String executor) : executor_(executor) {}
+  /*! \brief Sample every `interval`th request and drop the samples collected so far.
+   * \param interval The sampling interval, 0 turns sampling off.
+   */
+  void SetInterval(int64_t interval);
+  /*! \brief Start a request.
+   * \returns Whether the operators of the request should be timed.
+   */
+  bool BeginRequest() {
+    int64_t interval = interval_.load(std::memory_order_relaxed);
+    if (interval <= 0 || num_requests_++ % interval != 0) return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    ResolvePending();
+    num_sampled_++;
+    return true;
+  }
+  /*! \brief Start timing an operator of a sampled request.
+   * \param index The index of the operator in the executor, its samples are kept under it.
+   * \param name The name of the operator.
+   * \param dev The device the operator runs on.
+   */
+  void StartOp(size_t index, String name, Device dev) {
+    current_ = PendingOp{index, name, dev, Timer::Start(dev)};
+  }
+  /*! \brief Stop timing the operator of the last `StartOp`. */
+  void StopOp() {
+    current_.timer->Stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(std::move(current_));
+  }
+  /*! \brief A report of the sampled operators. Can be called while requests run.
+   * \returns A call for every operator with the number of samples, the mean
+   *  latency as "Duration (us)" and the "p50 (us)", "p90 (us)" and "p99 (us)"
+   *  percentiles.
+   */
+  profiling::Report Report();
+
+ private:
+  struct PendingOp {
+    size_t index;
+    String name;
+    Device dev;
+    Timer timer;
+  };
+  struct OpSamples {
+    String name;
+    Device dev;
+    std::vector<double> window_us;
+    size_t next{0};
+    int64_t count{0};
+    double sum_us{0};
+  };
+  /*! \brief Read the timers of the pending operators into their samples, mutex_ must be held. */
+  void ResolvePending();
+
+  String executor_;
+  std::atomic<int64_t> interval_{0};
+  // only touched by the thread running the requests
+  uint64_t num_requests_{0};
+  PendingOp current_;
+  // guarded by mutex_
+  std::mutex mutex_;
+  int64_t num_sampled_{0};
+  std::vector<PendingOp> pending_;
+  std::vector<OpSamples> ops_;
 };
 
 /* \brief A duration in time. */
@@ -581,11 +697,45 @@ PackedFunc ProfileFunction(Module mod, std::string func_name, int device_type, i
  *        cooldown is activated.
  * \param f_preproc The function to be executed before we execute time
  *        evaluator.
+ * \param max_rel_ci If positive, keep repeating the measurement after `repeat` repeats until
+ *        the half width of the 95% confidence interval on the mean of the repeats falls below
+ *        this fraction of the mean. The returned result then contains a variable number of costs.
+ * \param max_measure_ms The cap on the duration of the repeats in milliseconds, which stops an
+ *        adaptive measurement that does not converge. Required when `max_rel_ci` is positive.
  * \return f_timer A timer function.
  */
 PackedFunc WrapTimeEvaluator(PackedFunc f, Device dev, int number, int repeat, int min_repeat_ms,
                              int limit_zero_time_iterations, int cooldown_interval_ms,
-                             int repeats_to_cooldown, PackedFunc f_preproc = nullptr);
+                             int repeats_to_cooldown, PackedFunc f_preproc = nullptr,
+                             double max_rel_ci = 0.0, int max_measure_ms = 0);
+
+/*! \brief The number of events kept in the ring buffer of every thread. */
+constexpr size_t kProfileIntrinsicRingEntries = 1 << 16;
+
+/*!
+ * \brief Start recording the regions instrumented by tir.transform.InstrumentProfileIntrinsics.
+ *
+ * Kernels built with the `tir.instrument_lwp` pass config call TVMBackendProfileIntrinsic at
+ * the start and the end of every instrumented loop nest. While recording, each call writes
+ * the region id and a cycle counter timestamp into a preallocated ring buffer of the calling
+ * thread, so the overhead stays low enough to time loops inside of a single fused kernel.
+ * The most recent `kProfileIntrinsicRingEntries` events of every thread are kept.
+ *
+ * Recording must not be started or stopped while instrumented kernels are running.
+ */
+void StartProfileIntrinsics();
+
+/*!
+ * \brief Stop recording the instrumented regions and decode the events into a report.
+ *
+ * Every matching pair of start and end events becomes one call named `region_<id>`, with
+ * "Duration (us)", "Start (us)" and "Thread" metrics, so `Report::AsTable` aggregates the
+ * time spent in every region. Events whose matching start was overwritten are dropped and
+ * counted in the "Dropped Events" configuration entry.
+ *
+ * \return The decoded report.
+ */
+Report StopProfileIntrinsics();
 
 }  // namespace profiling
 }  // namespace runtime
@@ -24,8 +24,11 @@
 #ifndef TVM_RUNTIME_THREADING_BACKEND_H_
 #define TVM_RUNTIME_THREADING_BACKEND_H_
 
+#include <tvm/runtime/c_backend_api.h>
+
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #if defined(__linux__) || defined(__ANDROID__)
@@ -89,6 +92,8 @@ class ThreadGroup {
     kSpecifyOneCorePerThread = -2,
     /*All threads will get the same core group affinity.*/
     kSpecifyThreadShareAllCore = -3,
+    /*Different threads will get different cores of one NUMA node.*/
+    kNumaNode = -4,
   };
   /*!
    * \brief configure the CPU id affinity
@@ -122,6 +127,26 @@ int MaxConcurrency();
  * \brief Setting the maximum number of available cores.
  */
 void SetMaxConcurrency(int value);
+/*! \brief The number of nesting levels of parallel regions which can be given a thread budget. */
+constexpr int kMaxNestedLevels = 8;
+/*!
+ * \brief Set the thread budget of parallel regions at a nesting level.
+ *
+ * Level 0 is the outermost parallel region, level 1 a region launched from inside a
+ * task of a level 0 region and so on. A nested region borrows idle workers of the
+ * thread pool, at most `value` threads including the calling one. Regions nested
+ * deeper than kMaxNestedLevels run serially. The initial budgets can be given by the
+ * `TVM_NESTED_NUM_THREADS` env variable as a comma separated list, e.g. "8,2".
+ *
+ * \param level The nesting level.
+ * \param value The maximum number of threads, 0 means no limit beyond the pool size.
+ */
+TVM_DLL void SetNestedMaxConcurrency(int level, int value);
+/*!
+ * \param level The nesting level.
+ * \return the thread budget of parallel regions at the nesting level, 0 means no limit.
+ */
+TVM_DLL int NestedMaxConcurrency(int level);
 /*!
  * \brief Reset the threads in the pool. All current threads are destroyed and
  * new ones are created.
@@ -133,19 +158,119 @@ void ResetThreadPool();
 /*!
  * \brief Configuring the CPU affinity mode for the working threads.
  * \param mode The preferred CPU type (1 = big, -1 = little, -2 = kSpecifyOneCorePerThread,
- *  -3 = kSpecifyThreadShareAllCore).
+ *  -3 = kSpecifyThreadShareAllCore, -4 = kNumaNode).
  * \param nthreads The number of threads to use (0 = use all).
  * \param cpus A list of CPUs is used to set the 'cpu affinity' for the worker threads.
+ *  For kNumaNode it holds the id of the NUMA node instead, the pool of the calling
+ *  thread is pinned to the cores of that node and CPU memory allocated by the calling
+ *  thread is bound to it. Configuring different nodes from different threads gives
+ *  one pool per node.
  */
 TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode, int nthreads,
                        std::vector<unsigned int> cpus);
 
+/*!
+ * \return The number of NUMA nodes of the system, 0 if it cannot be detected.
+ */
+TVM_DLL int NumNumaNodes();
+
+/*!
+ * \brief Get the CPUs belonging to a NUMA node.
+ * \param node The id of the NUMA node.
+ * \return The CPU ids, empty if the node does not exist.
+ */
+TVM_DLL std::vector<unsigned int> NumaNodeCPUs(int node);
+
+/*!
+ * \return The NUMA node the thread pool of the calling thread is bound to,
+ *  -1 if it is not bound to a node.
+ */
+TVM_DLL int BoundNumaNode();
+
+/*!
+ * \brief Record the NUMA node the thread pool of the calling thread is bound to.
+ * \param node The id of the NUMA node, -1 if the pool is not bound to a node.
+ */
+void SetBoundNumaNode(int node);
+
+/*!
+ * \brief Set the memory policy of a page aligned range of memory to prefer a NUMA node.
+ *  This is a no-op on systems without NUMA support.
+ * \param ptr The start of the memory, aligned to the page size.
+ * \param nbytes The size of the memory.
+ * \param node The id of the NUMA node.
+ */
+TVM_DLL void BindMemoryToNumaNode(void* ptr, size_t nbytes, int node);
+
+/*!
+ * \brief Create a named thread pool with one worker pinned to each of the given cores.
+ *
+ * Unlike the default pool of a thread, a named pool is shared by all the threads binding
+ * to it with ThreadPoolScope. Executors can be bound to a named pool, which gives each
+ * model served by a process its own set of cores.
+ *
+ * \param name The name of the pool.
+ * \param cpus The cores of the pool.
+ * \param exist_ok Whether to keep an existing pool of that name instead of failing.
+ * \note This does nothing when openmp is used.
+ */
+TVM_DLL void CreateThreadPool(const std::string& name, const std::vector<unsigned int>& cpus,
+                              bool exist_ok = false);
+
+/*!
+ * \brief RAII scope in which the parallel jobs of the calling thread are launched into a
+ *  named thread pool created by CreateThreadPool.
+ */
+class ThreadPoolScope {
+ public:
+  /*!
+   * \brief Bind the calling thread to a named pool.
+   * \param name The name of the pool, an empty name keeps the current pool.
+   */
+  TVM_DLL explicit ThreadPoolScope(const std::string& name);
+  TVM_DLL ~ThreadPoolScope();
+
+ private:
+  /*! \brief The pool the thread was bound to before. */
+  void* prev_pool_;
+};
+
 /*!
  * \brief Get the number of threads being used by the TVM runtime
  * \returns The number of threads used.
  */
 int32_t NumThreads();
 
+/*!
+ * \brief Configure the work-stealing mode of the thread pool.
+ *
+ * In work-stealing mode a parallel job launched without an explicit task count is split
+ * into `granularity` tasks per worker. Workers own a range of tasks each and steal from
+ * the others once their own range is drained, which balances uneven loop iterations.
+ * The initial mode can also be set by the `TVM_THREAD_POOL_WORK_STEALING` env variable.
+ *
+ * \param granularity The number of tasks per worker, 0 disables work stealing.
+ * \note This does nothing when openmp is used.
+ */
+TVM_DLL void ConfigureWorkStealing(int granularity);
+
+/*!
+ * \brief A launcher running parallel jobs on threads of its own, with the contract of
+ *  TVMBackendParallelLaunch.
+ */
+using ParallelLaunchBackend = int (*)(FTVMParallelLambda flambda, void* cdata, int num_task);
+
+/*!
+ * \brief Run the parallel jobs of the process with a launcher other than the thread pool.
+ *
+ * Device runtimes with their own hardware threads, e.g. the HVX threads of Hexagon, use this
+ * to take over TVMBackendParallelLaunch. Barriers work as long as every task of a job runs
+ * at the same time.
+ *
+ * \param backend The launcher, nullptr restores the thread pool.
+ */
+TVM_DLL void SetParallelLaunchBackend(ParallelLaunchBackend backend);
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
@@ -31,17 +31,60 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/vm/bytecode.h>
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 namespace tvm {
 namespace runtime {
+
+class LazyParams;
+
 namespace vm {
 
 struct VMFunction;
 
+/*!
+ * \brief The attribute, in \p Executable::op_attrs, of the shape functions reading only the
+ * shapes of their inputs. The VM memoizes their outputs by the contents of their inputs.
+ */
+constexpr const char* kPureShapeFuncAttr = "pure_shape_func";
+
+/*!
+ * \brief A variant of a primitive function compiled for fixed argument shapes.
+ *
+ * \p InvokePacked dispatches to the variant whenever the arguments of the primitive have
+ * exactly the shapes of \p shape_key, and to the generic kernel otherwise.
+ */
+struct ShapeSpecialization {
+  /*! \brief The rank followed by the dimensions of every tensor argument, outputs included. */
+  std::vector<int64_t> shape_key;
+  /*! \brief The name of the specialized kernel in the executable's library. */
+  std::string func_name;
+};
+
+/*!
+ * \brief Alternative kernels of a primitive, for instance tuned for different ranges of a
+ * dynamic dimension, and the one to invoke per shape bucket.
+ *
+ * A shape bucket is a \p ShapeSpecialization::shape_key with every dimension rounded up to a
+ * power of two. The VM invokes the kernel chosen for the bucket of the arguments, and may time
+ * the alternatives on the first invocations of a bucket without a choice to make one.
+ */
+struct KernelVariants {
+  /*! \brief The names of the alternative kernels in the executable's library. */
+  std::vector<std::string> func_names;
+  /*! \brief The name of the kernel chosen per shape bucket, the primitive's own or a variant. */
+  std::map<std::vector<int64_t>, std::string> choices;
+};
+
+/*! \return \p shape_key with every dimension rounded up to a power of two. */
+std::vector<int64_t> ShapeBucketKey(const std::vector<int64_t>& shape_key);
+
 /*!
  * \brief The executable emitted by the VM compiler.
  *
@@ -52,7 +95,8 @@ struct VMFunction;
  *  - Constant section, storing the constant pool.
  *  - Primitive name section, containing the function name of the primitive ops
  *  used by the virtual machine.
- *  - Code section, handling the VM functions and bytecode.
+ *  - Code section, handling the VM functions and bytecode, varint-encoded by default.
+ *  - Shape specialization section, the shape-specialized variants of primitives.
  */
 class TVM_DLL Executable : public ModuleNode {
  public:
@@ -129,6 +173,12 @@ class TVM_DLL Executable : public ModuleNode {
    */
   void MoveLateBoundConstantsToFile(const std::string& path, size_t byte_limit);
 
+  /*!
+   * \brief As for \p MoveLateBoundConstantsToFile, but save in a format whose page-aligned
+   * tensor payloads can be memory-mapped by \p LoadLateBoundConstantsFromFile.
+   */
+  void MoveLateBoundConstantsToMappableFile(const std::string& path, size_t byte_limit);
+
   /*!
    * \brief Get a map of all constants with larger that byte_limit in size.
    */
@@ -152,8 +202,81 @@ class TVM_DLL Executable : public ModuleNode {
 
   /*!
    * \brief As for \p LoadLateBoundConstantsFromStream, but load from file at \p path.
+   *
+   * Files written by \p MoveLateBoundConstantsToMappableFile are memory-mapped rather than
+   * read, the constants then alias the mapping instead of living on the heap.
+   *
+   * With \p lazy only the index of the file is read. Each constant is then read straight onto
+   * its device by \p LoadLazyConstant the first time a virtual machine loads it, and is never
+   * held on the host.
+   */
+  void LoadLateBoundConstantsFromFile(const std::string& path, bool lazy = false);
+
+  /*!
+   * \brief Read the lazily bound constant \p const_index onto \p dev.
+   *
+   * \param const_index The index of a late-bound constant.
+   * \param dev The device to read the constant onto.
+   *
+   * \return The device-resident constant.
+   */
+  NDArray LoadLazyConstant(Index const_index, Device dev);
+
+  /*!
+   * \brief Register \p func_name as the variant of primitive \p prim_name to invoke when its
+   * arguments have exactly the shapes \p arg_shapes. The kernel must be in the library, for
+   * instance imported from a static-shape build of the same model.
+   *
+   * \param prim_name The name of the generic primitive.
+   * \param arg_shapes The shape of every tensor argument of the primitive, outputs included.
+   * \param func_name The name of the specialized kernel.
+   */
+  void AddShapeSpecialization(const std::string& prim_name,
+                              const std::vector<std::vector<int64_t>>& arg_shapes,
+                              const std::string& func_name);
+
+  /*!
+   * \brief Register \p func_name as an alternative kernel of primitive \p prim_name. It must
+   * have the calling convention of the primitive and be in the library.
+   *
+   * \param prim_name The name of the generic primitive.
+   * \param func_name The name of the alternative kernel.
+   */
+  void AddKernelVariant(const std::string& prim_name, const std::string& func_name);
+
+  /*!
+   * \brief Choose the kernel of primitive \p prim_name for the shape bucket of \p arg_shapes.
+   *
+   * \param prim_name The name of the generic primitive.
+   * \param arg_shapes The shape of every tensor argument of the primitive, outputs included.
+   * \param func_name The name of the primitive or of one of its variants.
+   */
+  void SetVariantChoice(const std::string& prim_name,
+                        const std::vector<std::vector<int64_t>>& arg_shapes,
+                        const std::string& func_name);
+
+  /*!
+   * \brief Get the copy of constant \p const_index which lives on \p dev.
+   *
+   * The first caller for a given (constant, device) pair materializes the copy by invoking
+   * \p upload; every later caller, including other \p VirtualMachine instances created from
+   * this executable, gets the same object back. This way N VMs serving one executable on a
+   * device hold a single copy of the weights rather than N.
+   *
+   * \param const_index The index of the constant in \p constants.
+   * \param dev The device the constant must reside on.
+   * \param upload Produces the device-resident copy if it is not cached yet.
+   *
+   * \return The shared device-resident constant.
    */
-  void LoadLateBoundConstantsFromFile(const std::string& path);
+  ObjectRef GetDeviceConstant(Index const_index, Device dev,
+                              const std::function<ObjectRef()>& upload);
+
+  /*!
+   * \brief Drop the executable's references to all device-resident constants. Memory is
+   * returned once the virtual machines still using them are destroyed.
+   */
+  void ReleaseDeviceConstants();
 
   /*!
    * \brief Get the serialized form of the `functions`. This is
@@ -295,8 +418,25 @@ class TVM_DLL Executable : public ModuleNode {
   std::vector<VMFunction> functions;
   /*! \brief The index of the device holding each constant. */
   std::vector<Index> const_device_indexes;
+  /*! \brief The shape-specialized variants of each primitive, keyed by primitive name. */
+  std::map<std::string, std::vector<ShapeSpecialization>> shape_specializations;
+  /*! \brief The alternative kernels of each primitive, keyed by primitive name. */
+  std::map<std::string, KernelVariants> kernel_variants;
+  /*!
+   * \brief Whether \p Save writes the code section in the compact format, one string of
+   *  varint-encoded instructions per function, or as one vector of fields per instruction.
+   *  \p Load reads both.
+   */
+  bool save_compact_code = true;
 
  private:
+  /*! \brief The file of the late-bound constants when they are loaded lazily. */
+  std::shared_ptr<LazyParams> lazy_constants_;
+  /*! \brief Guards \p device_constants_. */
+  std::mutex device_constants_mutex_;
+  /*! \brief Device-resident constants shared by all VMs, indexed by device then constant. */
+  std::unordered_map<Device, std::vector<ObjectRef>> device_constants_;
+
   /*!
    * \brief Save the virtual devices
    *
@@ -367,6 +507,34 @@ class TVM_DLL Executable : public ModuleNode {
    */
   void LoadCodeSection(dmlc::Stream* strm);
 
+  /*!
+   * \brief Save the shape-specialized primitives.
+   *
+   * \param strm The output stream.
+   */
+  void SaveShapeSpecializationSection(dmlc::Stream* strm);
+
+  /*!
+   * \brief Load the shape-specialized primitives, if any.
+   *
+   * \param strm The input stream.
+   */
+  void LoadShapeSpecializationSection(dmlc::Stream* strm);
+
+  /*!
+   * \brief Save the kernel variants of the primitives and their choices.
+   *
+   * \param strm The output stream.
+   */
+  void SaveKernelVariantSection(dmlc::Stream* strm);
+
+  /*!
+   * \brief Load the kernel variants of the primitives, if any.
+   *
+   * \param strm The input stream.
+   */
+  void LoadKernelVariantSection(dmlc::Stream* strm);
+
   /*! \brief The serialized bytecode. */
   std::string code_;
 };
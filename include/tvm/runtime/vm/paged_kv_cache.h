@@ -0,0 +1,138 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tvm/runtime/vm/paged_kv_cache.h
+ * \brief A key/value cache of the attention layers, in fixed-size pages shared by sequences.
+ */
+#ifndef TVM_RUNTIME_VM_PAGED_KV_CACHE_H_
+#define TVM_RUNTIME_VM_PAGED_KV_CACHE_H_
+
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/object.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief The keys and values of the tokens of many sequences, stored in a pool of pages.
+ *
+ *  The pool is allocated once, with shape [num_layers, 2, num_pages, page_size, num_heads,
+ *  head_dim], where the second axis selects the keys or the values. A sequence holds a list of
+ *  pages, its page table, and grows a page at a time. A forked sequence shares the pages of its
+ *  parent, and copies its last page before writing to it.
+ *
+ *  A forward pass of a batch of sequences starts with BeginForward, which reserves the pages of
+ *  the new tokens and uploads the page table and lengths of the batch, then calls Append for
+ *  every layer before running its attention kernel, e.g. topi.nn.paged_attention.
+ */
+class PagedKVCacheObj : public Object {
+ public:
+  /*! \brief The pool of pages. */
+  NDArray pages;
+  /*! \brief The int32 page table of the batch of the current forward pass, [batch, max_pages]. */
+  NDArray page_table;
+  /*! \brief The int32 lengths of the batch of the current forward pass, new tokens included. */
+  NDArray seq_lens;
+
+  PagedKVCacheObj(int64_t num_layers, int64_t num_heads, int64_t head_dim, int64_t page_size,
+                  int64_t num_pages, DLDataType dtype, Device dev, AllocatorType alloc_type);
+
+  /*! \brief Add an empty sequence. */
+  void AddSequence(int64_t seq_id);
+  /*! \brief Remove a sequence and release its pages. */
+  void RemoveSequence(int64_t seq_id);
+  /*! \brief Add a sequence sharing the tokens of \p parent_seq_id. */
+  void ForkSequence(int64_t parent_seq_id, int64_t child_seq_id);
+  /*! \return The number of tokens of a sequence. */
+  int64_t GetSequenceLength(int64_t seq_id) const;
+  /*! \return The number of pages held by no sequence. */
+  int64_t NumFreePages() const { return static_cast<int64_t>(free_pages_.size()); }
+
+  /*!
+   * \brief Start a forward pass appending \p append_lengths tokens to the sequences \p seq_ids.
+   *  It fails without changing the cache when the free pages do not hold the new tokens.
+   */
+  void BeginForward(ShapeTuple seq_ids, ShapeTuple append_lengths);
+  /*!
+   * \brief Write the keys and values of the new tokens of a layer.
+   * \param key The keys of shape [num_tokens, num_heads, head_dim], the tokens of the sequences
+   *  of the forward pass concatenated in order.
+   * \param value The values, with the shape of the keys.
+   */
+  void Append(int64_t layer, NDArray key, NDArray value);
+
+  static constexpr const uint32_t _type_index = TypeIndex::kDynamic;
+  static constexpr const char* _type_key = "vm.PagedKVCache";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PagedKVCacheObj, Object);
+
+ private:
+  struct Sequence {
+    std::vector<int32_t> pages;
+    int64_t length{0};
+  };
+
+  int32_t AllocPage();
+  void ReleasePage(int32_t page);
+  /*! \brief Copy the first \p num_slots tokens of a page, in every layer. */
+  void CopyPage(int32_t src, int32_t dst, int64_t num_slots);
+  /*!
+   * \brief Get a flat view of the pool, from token \p slot of \p page.
+   * \param shape The number of elements of the view, which must outlive it.
+   */
+  DLTensor SlotView(int64_t layer, int kv, int32_t page, int64_t slot, int64_t* shape) const;
+  Sequence& GetSequence(int64_t seq_id);
+
+  int64_t num_layers_;
+  int64_t num_pages_;
+  int64_t page_size_;
+  /*! \brief The number of elements of a token in a layer, num_heads * head_dim. */
+  int64_t token_elems_;
+  Allocator* allocator_;
+  std::unordered_map<int64_t, Sequence> seqs_;
+  std::vector<int32_t> free_pages_;
+  /*! \brief The number of sequences holding each page. */
+  std::vector<int32_t> ref_counts_;
+  /*! \brief The sequences of the current forward pass and their lengths before it. */
+  std::vector<int64_t> fwd_seq_ids_;
+  std::vector<int64_t> fwd_begins_;
+  std::vector<int64_t> fwd_lengths_;
+};
+
+/*! \brief Reference to a paged key/value cache. */
+class PagedKVCache : public ObjectRef {
+ public:
+  PagedKVCache(int64_t num_layers, int64_t num_heads, int64_t head_dim, int64_t page_size,
+               int64_t num_pages, DLDataType dtype, Device dev,
+               AllocatorType alloc_type = kPooled);
+
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(PagedKVCache, ObjectRef, PagedKVCacheObj);
+};
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_PAGED_KV_CACHE_H_
@@ -24,15 +24,19 @@
 #ifndef TVM_RUNTIME_VM_VM_H_
 #define TVM_RUNTIME_VM_VM_H_
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/container/closure.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/bytecode.h>
 #include <tvm/runtime/vm/executable.h>
 #include <tvm/runtime/vm/memory_manager.h>
 
+#include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -41,6 +45,9 @@
 
 namespace tvm {
 namespace runtime {
+
+class AsyncRunQueue;
+
 namespace vm {
 
 /*!
@@ -118,6 +125,8 @@ struct VMFrame {
   Index args;
   /*! \brief A pointer into the caller function's instructions. */
   const Instruction* code;
+  /*! \brief A pointer into the caller function's dispatch codes, parallel to \p code. */
+  const uint8_t* dispatch_code{nullptr};
 
   /*! \brief Statically allocated space for objects */
   std::vector<ObjectRef> register_file;
@@ -197,13 +206,14 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    * \param obj The object to write to.
    */
   inline void WriteRegister(RegName reg, const ObjectRef& obj);
+  inline void WriteRegister(RegName reg, ObjectRef&& obj);
 
   /*!
    * \brief Read a VM register.
    * \param reg The register to read from.
    * \return The read object.
    */
-  ObjectRef ReadRegister(RegName reg) const;
+  const ObjectRef& ReadRegister(RegName reg) const;
 
   /*!
    * \brief Read a VM register and cast it to int32_t
@@ -253,6 +263,16 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
   virtual void InvokePacked(Index packed_index, const PackedFunc& func, Index arg_count,
                             Index output_size, const std::vector<ObjectRef>& args);
 
+  /*!
+   * \brief Invoke a pure shape function, or copy its memoized outputs when its inputs were seen
+   * recently.
+   * \param instr The InvokePacked instruction of the shape function.
+   * \param func The PackedFunction to be invoked.
+   * \param args Arguments to the PackedFunction.
+   */
+  void InvokeShapeFunc(const Instruction& instr, const PackedFunc& func,
+                       const std::vector<ObjectRef>& args);
+
   /*!
    * \brief Initialize the virtual machine for a set of (physical) devices.
    * \param physical_devices The set of TVM devices.
@@ -261,6 +281,25 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
   void Init(const std::vector<Device>& physical_devices,
             const std::vector<AllocatorType>& alloc_types);
 
+  /*!
+   * \brief Upload every constant to its device now instead of on the first \p LoadConst,
+   * so that the cold-start cost is not paid by the first request.
+   */
+  void PreloadConstants();
+
+  /*!
+   * \brief Upload the constants and do the lazy initialization of the kernels for the devices
+   *  of the VM, without invoking any function, so that the first request is not slowed down.
+   */
+  void Warmup();
+
+  /*!
+   * \brief Make constant \p const_index available in the constant pool, reusing the
+   * device-resident copy shared through the executable when one exists.
+   * \param const_index The index of the constant.
+   */
+  void LoadConstant(Index const_index);
+
   /*! \brief Run VM dispatch loop. */
   void RunLoop(const std::vector<Index>& output_tensor_reg_indices = {});
 
@@ -329,7 +368,7 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
    *
    * \param instr Instruction that will be executed after this hook fires
    */
-  virtual void OpStartHook(Instruction instr);
+  virtual void OpStartHook(const Instruction& instr);
 
   /*!
    * \brief Internal hook for profiling the end of an op.
@@ -422,15 +461,94 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
 
   bool FindIndex(const std::vector<Index>& indices, Index val) const;
 
+  /*!
+   * \brief Collect the rank and dimensions of every tensor in \p args into \p key, the format
+   * of \p ShapeSpecialization::shape_key.
+   */
+  static void MakeShapeKey(const std::vector<ObjectRef>& args, std::vector<int64_t>* key);
+
+  /*! \brief Get the dispatch codes of \p func, which must belong to the executable. */
+  const uint8_t* GetDispatchCode(const VMFunction& func) const;
+
+  /*!
+   * \brief Execute the instruction of the same name. Shared between the plain handlers of
+   * the dispatch loop and the superinstructions fusing them.
+   */
+  inline void ExecuteLoadConst(const Instruction& instr);
+  inline void ExecuteInvokePacked(const Instruction& instr);
+
+  /*! \brief The candidate kernels of a primitive with variants, see \p KernelVariants. */
+  struct VariantDispatch {
+    /*! \brief The names and functions of the candidates, the generic kernel first. */
+    std::vector<std::pair<std::string, PackedFunc>> candidates;
+    /*! \brief The index of the candidate chosen per shape bucket. */
+    std::map<std::vector<int64_t>, size_t> choices;
+    /*! \brief The timings of the shape buckets whose candidates are being timed. */
+    struct Trials {
+      /*! \brief The fastest invocation of each candidate, in seconds. */
+      std::vector<double> best;
+      /*! \brief The number of timed invocations. */
+      int count{0};
+    };
+    std::map<std::vector<int64_t>, Trials> trials;
+  };
+
+  /*!
+   * \brief Pick the kernel of a primitive with variants for the bucket of \p shape_key_,
+   * stored into \p bucket_key_.
+   * \param variants The variants of the primitive.
+   * \param func Set to the chosen kernel, if the bucket has one.
+   * \return The index of the candidate to time, or -1 if none is.
+   */
+  int SelectVariant(const VariantDispatch& variants, const PackedFunc** func);
+  /*!
+   * \brief Invoke and time a candidate kernel for the bucket \p bucket_key_, choosing the
+   * fastest once every candidate was timed \p variant_trials_ times.
+   */
+  void InvokeVariantTrial(const Instruction& instr, VariantDispatch* variants, int candidate,
+                          const std::vector<ObjectRef>& args);
+  inline void ExecuteAllocStorage(const Instruction& instr);
+  inline void ExecuteAllocTensor(const Instruction& instr,
+                                 const std::vector<Index>& output_tensor_reg_indices);
+
  protected:
   /*! \brief The virtual machine's packed function table. */
   std::vector<PackedFunc> packed_funcs_;
+  /*!
+   * \brief The addresses of the packed functions that are symbols of the kernel library,
+   *  called directly by InvokePacked, nullptr for the others.
+   */
+  std::vector<TVMBackendPackedCFunc> packed_cfuncs_;
   /*! \brief The current stack of call frames. */
   std::vector<VMFrame> frames_;
   /*! \brief The fuction table index of the current function. */
   Index func_index_;
   /*! \brief The current pointer to the code section. */
   const Instruction* code_;
+  /*!
+   * \brief The dispatch code of each instruction of the current function: its opcode, or a
+   * superinstruction covering it and the instructions that follow.
+   */
+  const uint8_t* dispatch_code_{nullptr};
+  /*! \brief The dispatch codes of every function, computed when loading the executable. */
+  std::vector<std::vector<uint8_t>> dispatch_codes_;
+  /*! \brief For each packed function, its shape-specialized variants and their shape keys. */
+  std::vector<std::vector<std::pair<std::vector<int64_t>, PackedFunc>>> specialized_funcs_;
+  /*! \brief Whether to count the argument shapes each packed function is invoked with. */
+  bool record_kernel_shapes_{false};
+  /*! \brief For each packed function, the number of invocations per observed shape key. */
+  std::vector<std::map<std::vector<int64_t>, int64_t>> kernel_shape_counts_;
+  /*! \brief Scratch space for the shape key of the packed function being invoked. */
+  std::vector<int64_t> shape_key_;
+  /*! \brief For each packed function, its kernel variants if it has any. */
+  std::vector<VariantDispatch> variant_dispatch_;
+  /*! \brief The shape bucket of the packed function being invoked, if it has variants. */
+  std::vector<int64_t> bucket_key_;
+  /*!
+   * \brief The timed invocations of every variant before choosing one for a shape bucket, 0
+   * to invoke the generic kernel for the buckets without a choice.
+   */
+  int variant_trials_{3};
   /*! \brief The virtual machine PC. */
   Index pc_;
   /*! \brief The special return register. */
@@ -457,9 +575,35 @@ class TVM_DLL VirtualMachine : public runtime::ModuleNode {
   std::vector<Allocator*> allocators_;
   /*!
    * \brief The constant pool for runtime. It caches the device dependent
-   * object to avoid rellocation of constants during inference.
+   * object to avoid rellocation of constants during inference. The objects are
+   * shared with the other VMs running the same executable on the same device.
    */
   std::vector<ObjectRef> const_pool_;
+  /*! \brief The named thread pool the kernels run on, empty for the default pool. */
+  std::string thread_pool_;
+  /*! \brief Times the packed functions of every Nth invocation. */
+  profiling::SamplingProfiler sampler_{"VM"};
+  /*! \brief Whether the current invocation is sampled. */
+  bool sampled_{false};
+  /*! \brief The name of each packed function, filled when sampling is turned on. */
+  std::vector<String> packed_names_;
+  /*! \brief Serializes the asynchronous invocations, created on first use. */
+  std::shared_ptr<AsyncRunQueue> async_queue_;
+  /*! \brief The memoized outputs of a shape function, most recently used first. */
+  struct ShapeFuncCache {
+    using Entries = std::list<std::pair<std::vector<int64_t>, std::vector<NDArray>>>;
+    Entries entries;
+    /*! \brief The entries by the rank, dimensions and contents of every input. */
+    std::map<std::vector<int64_t>, Entries::iterator> index;
+  };
+  /*! \brief For each packed function, whether it is a pure shape function. */
+  std::vector<bool> is_pure_shape_func_;
+  /*! \brief For each packed function, its memoized outputs if it is a pure shape function. */
+  std::vector<ShapeFuncCache> shape_func_caches_;
+  /*! \brief The maximum number of memoized outputs per shape function, 0 to disable. */
+  size_t shape_func_cache_size_{16};
+  /*! \brief The shape function invocations skipped since the cache size was set. */
+  int64_t shape_func_cache_hits_{0};
 };
 
 }  // namespace vm
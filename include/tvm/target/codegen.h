@@ -56,10 +56,13 @@ runtime::Module Build(IRModule mod, Target target);
  * \param m The host module with the imports.
  * \param system_lib Whether expose as system library.
  * \param c_symbol_prefix Optional symbol prefix of the blob symbol.
+ * \param compression The compression of the imported modules, "none" or "lz4". When set, each
+ *  module is decoded on its first use after loading, rather than when the library is loaded.
  * \return cstr The C string representation of the file.
  */
 std::string PackImportsToC(const runtime::Module& m, bool system_lib,
-                           const std::string& c_symbol_prefix = "");
+                           const std::string& c_symbol_prefix = "",
+                           const std::string& compression = "");
 
 /*!
  * \brief Pack imported device library to a LLVM module.
@@ -71,12 +74,14 @@ std::string PackImportsToC(const runtime::Module& m, bool system_lib,
  * \param system_lib Whether expose as system library.
  * \param target_triple LLVM target triple
  * \param c_symbol_prefix Optional symbol prefix of the blob symbol.
+ * \param compression The compression of the imported modules, see PackImportsToC.
  *
  * \return runtime::Module The generated LLVM module.
  */
 runtime::Module PackImportsToLLVM(const runtime::Module& m, bool system_lib,
                                   const std::string& target_triple,
-                                  const std::string& c_symbol_prefix = "");
+                                  const std::string& c_symbol_prefix = "",
+                                  const std::string& compression = "");
 }  // namespace codegen
 }  // namespace tvm
 #endif  // TVM_TARGET_CODEGEN_H_
@@ -93,6 +93,21 @@ TVM_DLL double EstimateTIRFlops(const Stmt& stmt);
  */
 TVM_DLL double EstimateTIRFlops(const IRModule& mod);
 
+/*!
+ * \brief Estimate the bytes moved from and to global memory by a PrimFunc, assuming each
+ *  byte of the regions of the global buffers it reads and writes is moved once.
+ * \param func The PrimFunc to be estimated.
+ * \return The estimated bytes.
+ */
+TVM_DLL double EstimateTIRBytes(const PrimFunc& func);
+
+/*!
+ * \brief Estimate the bytes moved from and to global memory by the PrimFuncs in an IRModule.
+ * \param mod The IRModule to be estimated.
+ * \return The estimated bytes.
+ */
+TVM_DLL double EstimateTIRBytes(const IRModule& mod);
+
 /*!
  * \brief Find undefined vars in the statement.
  * \param stmt The statement to be checked.
@@ -663,6 +663,89 @@ TVM_DLL const Op& ptx_cp_async();
 TVM_DLL const Op& ptx_commit_group();
 TVM_DLL const Op& ptx_wait_group();
 
+/*!
+ * \brief tvm intrinsics for the ptx mbarrier in shared memory, which tracks the arrival of
+ *        threads and the completion of asynchronous bulk copies.
+ *
+ * void ptx_init_barrier_thread_count(Var barrier_ptr, Expr barrier_offset, int thread_count);
+ * void ptx_arrive_barrier(Var barrier_ptr, Expr barrier_offset);
+ * void ptx_arrive_barrier_expect_tx(Var barrier_ptr, Expr barrier_offset, int byte_count);
+ * void ptx_wait_barrier(Var barrier_ptr, Expr barrier_offset, Expr phase);
+ *
+ */
+TVM_DLL const Op& ptx_init_barrier_thread_count();
+TVM_DLL const Op& ptx_arrive_barrier();
+TVM_DLL const Op& ptx_arrive_barrier_expect_tx();
+TVM_DLL const Op& ptx_wait_barrier();
+
+/*!
+ * \brief tvm intrinsic for the ptx bulk async copy of a contiguous region from global to shared
+ *        memory, whose completion is signaled on an mbarrier (sm_90).
+ *
+ * void ptx_cp_async_bulk(Var shared_ptr, Expr shared_offset, Var global_ptr, Expr global_offset,
+ *                        Expr bytes, Var barrier_ptr, Expr barrier_offset);
+ *
+ */
+TVM_DLL const Op& ptx_cp_async_bulk();
+
+/*!
+ * \brief tvm intrinsic for the ptx bulk async copy of a tile of a tensor from global to shared
+ *        memory through the tensor memory accelerator (sm_90). The tensor map is the address of
+ *        a CUtensorMap in global memory, encoded by runtime.cuTensorMapEncodeTiled. The
+ *        completion is signaled on an mbarrier.
+ *
+ * void ptx_cp_async_bulk_tensor(int dim, Var shared_ptr, Expr shared_offset, Var tensor_map,
+ *                               Var barrier_ptr, Expr barrier_offset, Expr coord_0, ...,
+ *                               Expr coord_{dim-1});
+ *
+ */
+TVM_DLL const Op& ptx_cp_async_bulk_tensor();
+
+/*!
+ * \brief tvm intrinsic for the ptx barrier across all the threads of the thread block
+ *        cluster, which also orders their accesses to distributed shared memory (sm_90).
+ *
+ * void ptx_cluster_sync();
+ *
+ */
+TVM_DLL const Op& ptx_cluster_sync();
+
+/*!
+ * \brief tvm intrinsic for the ptx load of an element of the shared memory of another thread
+ *        block of the cluster, through distributed shared memory (sm_90). The shared memory
+ *        buffer is mapped to the same address in the thread block of rank block_rank.
+ *
+ * Expr ptx_ld_shared_cluster(Var shared_ptr, Expr shared_offset, Expr block_rank);
+ *
+ */
+TVM_DLL const Op& ptx_ld_shared_cluster();
+
+/*!
+ * \brief tvm intrinsic for the ptx warpgroup level asynchronous matrix multiply accumulate
+ *        (sm_90a), with both multiplicands in shared memory. Both A (m x k) and B (n x k) are
+ *        k-major, in the layout written by a bulk tensor copy with the given swizzle of 0, 32,
+ *        64 or 128 bytes. The accumulator is held in the registers of the 128 threads of the
+ *        warpgroup. The result is added to C when scale_out is nonzero and overwrites it else.
+ *
+ * void ptx_wgmma_ss(StringImm shape, StringImm A_dtype, StringImm B_dtype, StringImm C_dtype,
+ *                   Var a_ptr, Expr a_offset, Var b_ptr, Expr b_offset,
+ *                   Var c_ptr, Expr c_offset, int swizzle_bytes, Expr scale_out);
+ *
+ */
+TVM_DLL const Op& ptx_wgmma_ss();
+
+/*!
+ * \brief tvm intrinsics for the fence, commit and wait of the ptx wgmma (sm_90a).
+ *
+ * void ptx_wgmma_fence();
+ * void ptx_wgmma_commit_group();
+ * void ptx_wgmma_wait_group(int num);
+ *
+ */
+TVM_DLL const Op& ptx_wgmma_fence();
+TVM_DLL const Op& ptx_wgmma_commit_group();
+TVM_DLL const Op& ptx_wgmma_wait_group();
+
 /*!
  * \brief tvm intrinsic for storing the result of PTX MMA into a destination pointer.
  *        For example, if each thread in a warp of size 32 has 4 elements from the result of
@@ -797,6 +880,16 @@ TVM_DLL const Op& start_profile_intrinsic();
  */
 TVM_DLL const Op& end_profile_intrinsic();
 
+/*!
+ * \brief The runtime multiplier of the lanes of scalable vectors.
+ *
+ *  int32 vscale();
+ *
+ *  A scalable vector type of n lanes in the type string, e.g. float32xvscalex4, holds
+ *  vscale() * n elements, fixed by the hardware vector length of SVE or RVV.
+ */
+TVM_DLL const Op& vscale();
+
 /*! \brief The kind of structure field info used in intrinsic */
 enum TVMStructFieldKind : int {
   // array head address
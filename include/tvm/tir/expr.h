@@ -630,23 +630,30 @@ class BufferLoadNode : public PrimExprNode {
   Buffer buffer;
   /*! \brief The indices location to be loaded. */
   Array<PrimExpr> indices;
+  /*!
+   * \brief The boolean vector of the lanes to load, the other lanes are zero and their
+   *  locations are not accessed. Every lane is loaded when it is not defined.
+   */
+  Optional<PrimExpr> predicate;
 
   void VisitAttrs(AttrVisitor* v) {
     v->Visit("dtype", &(this->dtype));
     v->Visit("buffer", &buffer);
     v->Visit("indices", &indices);
+    v->Visit("predicate", &predicate);
     v->Visit("span", &span);
   }
 
   bool SEqualReduce(const BufferLoadNode* other, SEqualReducer equal) const {
     return equal(dtype, other->dtype) && equal(buffer, other->buffer) &&
-           equal(indices, other->indices);
+           equal(indices, other->indices) && equal(predicate, other->predicate);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
     hash_reduce(dtype);
     hash_reduce(buffer);
     hash_reduce(indices);
+    hash_reduce(predicate);
   }
 
   static constexpr const char* _type_key = "tir.BufferLoad";
@@ -675,7 +682,8 @@ class BufferLoadNode : public PrimExprNode {
  */
 class BufferLoad : public PrimExpr {
  public:
-  TVM_DLL explicit BufferLoad(Buffer buffer, Array<PrimExpr> indices, Span span = Span());
+  TVM_DLL explicit BufferLoad(Buffer buffer, Array<PrimExpr> indices,
+                              Optional<PrimExpr> predicate = NullOpt, Span span = Span());
   TVM_DEFINE_OBJECT_REF_METHODS(BufferLoad, PrimExpr, BufferLoadNode);
   TVM_DEFINE_OBJECT_REF_COW_METHOD(BufferLoadNode);
 };
@@ -738,6 +746,9 @@ class ProducerLoad : public PrimExpr {
  *  Examples:
  *  - ramp(0, 1, 3) = [0, 1, 2]
  *  - ramp(1, 2, 4) = [1, 3, 5, 7]
+ *
+ *  A ramp of a negative number of lanes -n is a scalable vector of vscale * n lanes,
+ *  following the encoding of the lanes of a scalable DataType.
  */
 class RampNode : public PrimExprNode {
  public:
@@ -745,7 +756,7 @@ class RampNode : public PrimExprNode {
   PrimExpr base;
   /*! \brief The stride of each step. */
   PrimExpr stride;
-  /*! \brief Total number of lanes. */
+  /*! \brief Total number of lanes, -n for the vscale * n lanes of a scalable vector. */
   int lanes;
 
   void VisitAttrs(AttrVisitor* v) {
@@ -783,12 +794,16 @@ class Ramp : public PrimExpr {
   TVM_DEFINE_OBJECT_REF_COW_METHOD(RampNode);
 };
 
-/*! \brief Create a vector where all the elements are value. */
+/*!
+ * \brief Create a vector where all the elements are value.
+ *
+ *  Like a ramp, a broadcast of -n lanes is a scalable vector of vscale * n lanes.
+ */
 class BroadcastNode : public PrimExprNode {
  public:
   /*! \brief The base value. */
   PrimExpr value;
-  /*! \brief The number of lanes. */
+  /*! \brief The number of lanes, -n for the vscale * n lanes of a scalable vector. */
   int lanes;
 
   void VisitAttrs(AttrVisitor* v) {
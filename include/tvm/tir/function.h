@@ -167,7 +167,7 @@ class PrimFunc : public BaseFunc {
                    DictAttrs attrs = NullValue<DictAttrs>(), Span span = Span());
 
   TVM_DEFINE_OBJECT_REF_METHODS(PrimFunc, BaseFunc, PrimFuncNode);
-  TVM_DEFINE_OBJECT_REF_COW_METHOD(PrimFuncNode);
+  TVM_DEFINE_OBJECT_REF_COW_METHOD_WITH_SHASH_CACHE(PrimFuncNode);
 };
 
 /*!
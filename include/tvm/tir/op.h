@@ -655,6 +655,29 @@ TVM_DLL PrimExpr trunc(PrimExpr x, Span span = Span());
  */
 TVM_DLL PrimExpr LargeUIntImm(DataType dtype, int64_t low, int64_t high, Span span = Span());
 
+/*!
+ * \brief Construct a call to vscale, the runtime multiplier of the lanes of scalable vectors.
+ * \param span The location of this operation in the source.
+ * \return The constructed expression.
+ */
+TVM_DLL PrimExpr vscale(Span span = Span());
+
+/*!
+ * \brief Get the number of lanes of a vector as an expression.
+ * \param lanes The lanes of a Ramp or Broadcast, -n for a scalable vector.
+ * \param dtype The data type of the result.
+ * \return The constant lanes, or vscale() * n for a scalable vector.
+ */
+TVM_DLL PrimExpr VectorLanesToExpr(int lanes, DataType dtype = DataType::Int(32));
+
+/*!
+ * \brief Get the lanes of a Ramp or Broadcast from the number of lanes of a vector.
+ * \param lanes The number of lanes, a constant or vscale() * n for a scalable vector.
+ * \return The lanes, -n for a scalable vector, or NullOpt when lanes is not a positive constant
+ *  or vscale() * n with n > 1.
+ */
+TVM_DLL Optional<Integer> VectorLanesFromExpr(const PrimExpr& lanes);
+
 /*!
  * \brief Execute a multiplication between two Q-numbers x and y
  * followed by a right shift s. The mathematical expression is:
@@ -958,8 +981,10 @@ inline PrimExpr MakeConstScalar(DataType t, bool value, Span span) {
 
 template <typename ValueType, typename>
 inline PrimExpr make_const(DataType t, ValueType value, Span span) {
-  if (t.lanes() == 1) {
+  if (t.is_scalar()) {
     return MakeConstScalar(t, value, span);
+  } else if (t.is_scalable_vector()) {
+    return tir::Broadcast(MakeConstScalar(t.element_of(), value, span), -t.vscale_factor(), span);
   } else {
     return tir::Broadcast(MakeConstScalar(t.element_of(), value, span), t.lanes(), span);
   }
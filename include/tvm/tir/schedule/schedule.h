@@ -331,6 +331,19 @@ class ScheduleNode : public runtime::Object {
    * \return The new loop after merge
    */
   virtual LoopRV Merge(const Array<LoopRV>& loop_rvs) = 0;
+  /*!
+   * \brief Fuse a list of sibling loops horizontally, so that their bodies run one after another
+   * in a single loop. It requires:
+   * 1) The loops are consecutive children of the same parent.
+   * 2) The loops can't have annotations or thread bindings, and must start with 0.
+   * 3) The loops have constant extents, or their extents are equal.
+   * 4) The blocks under different loops don't depend on each other.
+   * The extent of the new loop is the maximum of the extents, and the blocks under a shorter loop
+   * are guarded by predicates.
+   * \param loop_rvs The loops to be fused
+   * \return The new loop after fusion
+   */
+  virtual LoopRV HorizontalFuse(const Array<LoopRV>& loop_rvs) = 0;
   /*!
    * \brief Fuse a list of consecutive loops into one. It requires:
    * 1) The loops can't have annotations or thread bindings.
@@ -231,23 +231,30 @@ class BufferStoreNode : public StmtNode {
   PrimExpr value;
   /*! \brief The indices location to be stored. */
   Array<PrimExpr> indices;
+  /*!
+   * \brief The boolean vector of the lanes to store, the locations of the other lanes are not
+   *  accessed. Every lane is stored when it is not defined.
+   */
+  Optional<PrimExpr> predicate;
 
   void VisitAttrs(AttrVisitor* v) {
     v->Visit("buffer", &buffer);
     v->Visit("value", &value);
     v->Visit("indices", &indices);
+    v->Visit("predicate", &predicate);
     v->Visit("span", &span);
   }
 
   bool SEqualReduce(const BufferStoreNode* other, SEqualReducer equal) const {
     return equal(buffer, other->buffer) && equal(value, other->value) &&
-           equal(indices, other->indices);
+           equal(indices, other->indices) && equal(predicate, other->predicate);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
     hash_reduce(buffer);
     hash_reduce(value);
     hash_reduce(indices);
+    hash_reduce(predicate);
   }
 
   static constexpr const char* _type_key = "tir.BufferStore";
@@ -261,7 +268,7 @@ class BufferStoreNode : public StmtNode {
 class BufferStore : public Stmt {
  public:
   TVM_DLL explicit BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
-                               Span span = Span());
+                               Optional<PrimExpr> predicate = NullOpt, Span span = Span());
 
   TVM_DEFINE_OBJECT_REF_METHODS(BufferStore, Stmt, BufferStoreNode);
   TVM_DEFINE_OBJECT_REF_COW_METHOD(BufferStoreNode);
@@ -1424,6 +1431,11 @@ constexpr const char* reduce_scope = "reduce_scope";
 constexpr const char* pragma_auto_unroll_max_step = "pragma_auto_unroll_max_step";
 /*! \brief Pragma: unroll explicit */
 constexpr const char* pragma_unroll_explicit = "pragma_unroll_explicit";
+/*!
+ * \brief Pragma: software prefetch distance, in iterations of the innermost loops in its scope,
+ *  0 to derive it from the cost of the loop body. See tir::transform::InjectSoftwarePrefetch.
+ */
+constexpr const char* pragma_software_prefetch_distance = "pragma_software_prefetch_distance";
 /*! \brief Mark region is guarded by the pragma extension */
 constexpr const char* pragma_scope_prefix = "pragma_";
 /*! \brief Import C source or file into the final code gen module */
@@ -1540,6 +1552,18 @@ constexpr const char* fragment_shape = "fragment_shape";
  */
 constexpr const char* fragment_layout = "fragment_layout";
 
+/*!
+ * \brief Mark the thread block cluster of a cuda kernel (sm_90). The node is the array of the
+ *        cluster sizes in x, y and z, the value is the number of blocks in a cluster.
+ */
+constexpr const char* cluster_dims = "cluster_dims";
+
+/*!
+ * \brief Mark a persistent kernel, whose blocks must all be resident on the device at once. The
+ *        value is the number of blocks an SM must hold.
+ */
+constexpr const char* persistent_kernel = "persistent_kernel";
+
 /*!
  * \brief Mark that the kernel is hand threaded and doesn't need syncs inserted
  */
@@ -1571,6 +1595,13 @@ constexpr const char* software_pipeline_order = "software_pipeline_order";
  */
 constexpr const char* software_pipeline_async_stages = "software_pipeline_async_stages";
 
+/*! \brief Mark the loop as a warp-specialized software pipeline, with the number of slots of the
+ *         ring buffers between its stage 0 (producers) and stage 1 (consumers) as the value.
+ * \note The threads bound to threadIdx.x are doubled. The additional threads run the producers
+ *       and the original threads run the consumers, synchronized with mbarriers in shared memory.
+ */
+constexpr const char* software_pipeline_warp_specialize = "software_pipeline_warp_specialize";
+
 /*! \brief Mark the buffers which is const access and can be transformed layout. */
 constexpr const char* layout_free_buffers = "layout_free_buffers";
 
@@ -51,12 +51,13 @@ using tvm::transform::Sequential;
  * \param opt_level The optimization level of the function pass.
  * \param name The name of the function pass.
  * \param required The list of the passes that the function pass is dependent on.
+ * \param thread_safe Whether the pass can run on several functions at once.
  *
  * \return The created function pass.
  */
 TVM_DLL Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required);
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe = true);
 
 /*!
  * \brief Inject prefetch instructions into stmt.
@@ -65,6 +66,17 @@ TVM_DLL Pass CreatePrimFuncPass(
  */
 TVM_DLL Pass InjectPrefetch();
 
+/*!
+ * \brief Insert software prefetches for the strided accesses to global buffers in the
+ *  innermost serial loops of CPU functions.
+ *
+ *  The pass applies to the loops under the "pragma_software_prefetch_distance" attribute,
+ *  or to all the loops if enabled by the "tir.InjectSoftwarePrefetch" pass config.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass InjectSoftwarePrefetch();
+
 // TODO(tvm-team): consolidate configs to the PassContext
 /*!
  * \brief Flatten the multi-dimensional read/write
@@ -114,6 +126,17 @@ TVM_DLL Pass LiftAttrScope(String attr_key);
  */
 TVM_DLL Pass LoopPartition();
 
+/*!
+ * \brief Specialize the PrimFunc for the dynamic shapes divisible by its tile factors.
+ *
+ *  The body is guarded by a runtime check of the divisibility of the shape vars by the
+ *  factors of the ceildiv loop extents. In the guarded fast path, the trip counts are exact
+ *  and the boundary checks are removed; the original body is kept as the fallback.
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass SpecializeDivisibleShapes();
+
 /*!
  * \brief Lower vectorization loops.
  *
@@ -143,6 +166,10 @@ TVM_DLL Pass InjectDoubleBuffer();
  *  Trying to share space between allocations to make
  *  a static allocation plan when possible.
  *
+ *  With the "tir.StorageRewrite" config option reuse_across_dtypes, the allocations of
+ *  different byte-addressable dtypes of the same scope share storage by bytes, and with
+ *  report_reuse the shared allocations are attached to the PrimFunc as "tir.storage_reuse".
+ *
  * \return The pass.
  */
 TVM_DLL Pass StorageRewrite();
@@ -151,6 +178,10 @@ TVM_DLL Pass StorageRewrite();
  * \brief unroll the constant loop marked by unroll.
  * This pass also automatically attach pragma unroll tag to loops which meets the standard.
  *
+ * A loop under the pragma_unroll_and_jam attribute is unrolled by the factor of the attribute,
+ * with the copies jammed into its inner loop when the iterations of the loop write disjoint
+ * elements.
+ *
  * \return The pass.
  */
 TVM_DLL Pass UnrollLoop();
@@ -323,6 +354,17 @@ TVM_DLL Pass SkipAssert();
  */
 TVM_DLL Pass ThreadSync(String storage_scope);
 
+/*!
+ * \brief Merge the consecutive kernel launches of the CUDA functions into persistent kernels.
+ *
+ *  A merged kernel launches as many blocks as the SMs of the target hold at once, which run the
+ *  blocks of the kernels in turn, with global barriers between the dependent kernels. The target
+ *  must set -multi_processor_count. Experimental, enabled by "tir.experimental_persistent_kernel".
+ *
+ * \return The pass.
+ */
+TVM_DLL Pass MergePersistentKernel();
+
 /*!
  * \brief Lower cross thread alleduce.
  *
@@ -380,6 +422,10 @@ TVM_DLL Pass CombineContextCall();
 /*!
  * \brief Narrow down PrimExpr datatype in stmt to target_bits.
  *
+ *  With the tir.narrow_datatype_guard config, on by default for GPU targets, the indices
+ *  depending on dynamic shapes are also narrowed, under a runtime check that the buffers
+ *  hold fewer than 2^(target_bits-1) elements.
+ *
  * \param target_bits The target bits
  *
  * \note Run this pass after storage flatten.
@@ -600,7 +646,11 @@ TVM_DLL Pass InstallDebugSpans();
 TVM_DLL Pass UnifyThreadBinding();
 
 /*!
- *  A pass to merge multiple TIR-level dynamic shared memory allocations into one
+ *  A pass to merge multiple TIR-level dynamic shared memory allocations into one,
+ *  reusing the memory of the buffers whose lifetimes do not overlap.
+ *
+ *  If the "tir.merge_static_smem" pass config option is set, the static shared memory
+ *  allocations of each kernel are merged too, together with the dynamic ones.
  */
 TVM_DLL Pass MergeDynamicSharedMemoryAllocations();
 
@@ -718,6 +768,12 @@ TVM_DLL Pass UnifiedStaticMemoryPlanner();
  * should be executed in advance of block C by one iteration. The order 0 and 1 specifies the order
  * of block B and C inside the body block inside the result TIR.
  *
+ * With the annotation "software_pipeline_warp_specialize", stage 0 and stage 1 of the loop are run
+ * by different threads instead: the loop bound to threadIdx.x is doubled, the additional threads
+ * run stage 0 (producers) and the original threads run stage 1 (consumers). The shared buffers
+ * written by the producers become ring buffers with the annotated number of slots, and the two
+ * roles hand over each slot with a pair of mbarriers.
+ *
  * \return The IR transform pass.
  */
 TVM_DLL Pass InjectSoftwarePipeline();
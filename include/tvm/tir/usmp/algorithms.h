@@ -76,6 +76,42 @@ Map<BufferInfo, PoolAllocation> HillClimb(const Array<BufferInfo>& buffer_info_a
 Map<BufferInfo, PoolAllocation> HillClimb(const Array<BufferInfo>& buffer_info_arr,
                                           const Integer& memory_pressure);
 
+/*!
+ * \brief The branch-and-bound algorithm to plan memory
+ *
+ * This will search the orders of placing the buffers at the lowest offset where
+ * they fit, pruned by a lower bound of the pool sizes, until the search space or
+ * the time budget set by the tir.usmp.optimal_time_budget_ms option is exhausted.
+ * The search starts from the orders of greedy_by_size and greedy_by_conflicts.
+ *
+ * \return A Map of BufferInfo objects and their associated PoolAllocation
+ */
+Map<BufferInfo, PoolAllocation> Optimal(const Array<BufferInfo>& buffer_info_arr,
+                                        const Integer& memory_pressure);
+
+/*!
+ * \brief Computes a lower bound of the size of each pool used by an allocation
+ *
+ * The bound of a pool is the largest total size of a set of pairwise conflicting
+ * buffers allocated in it, which is not larger than the size of any allocation of
+ * these buffers to the pool.
+ *
+ * \return A Map of the PoolInfo objects used by \p buffer_pool_allocations and their lower bound
+ */
+Map<PoolInfo, Integer> PoolSizeLowerBounds(
+    const Array<BufferInfo>& buffer_info_arr,
+    const Map<BufferInfo, PoolAllocation>& buffer_pool_allocations);
+
+/*!
+ * \brief Orders the pool candidates of the BufferInfo objects by their access cost
+ *
+ * This will sort the pool candidates of each BufferInfo by the cost of an access
+ * derived from the latency and bandwidth of the pools, and then remove the pools
+ * cheaper than the one where the BufferInfo fits when they are placed in the order
+ * of their access density, leaving the cheap pools to the frequently accessed ones.
+ */
+void AssignPoolsByAccessCost(const Array<BufferInfo>& buffer_info_arr);
+
 }  // namespace algo
 }  // namespace usmp
 }  // namespace tir
@@ -50,6 +50,16 @@ constexpr const char* kUSMPUseWorkspaceIO = "tir.usmp.use_workspace_io";
  * The algorithm should be provided as registered PackedFunc with the name tir.usmp.algorithm.NAME
  */
 constexpr const char* kUSMPCustomAlgorithmOption = "tir.usmp.custom_algorithm";
+/*!
+ * \brief PassContext option to set the time budget in milliseconds of the "optimal" memory
+ * planning algorithm in USMP
+ */
+constexpr const char* kUSMPOptimalTimeBudgetOption = "tir.usmp.optimal_time_budget_ms";
+/*!
+ * \brief PassContext option to order the pool candidates of the buffers by their access cost
+ * before memory planning in USMP, so the most accessed bytes get the fastest pools
+ */
+constexpr const char* kUSMPAccessAwareOption = "tir.usmp.access_aware";
 
 namespace tir {
 namespace usmp {
@@ -81,6 +91,8 @@ struct BufferInfoNode : public Object {
   Array<ObjectRef> conflicts;
   /*! \brief Whether BufferInfo object retains info about IO tensors or intermediaries */
   BufferInfoKind kind;
+  /*! \brief The estimated number of accesses to the buffer, weighted by loop trip counts */
+  int64_t access_count = 0;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("name_hint", &name_hint);
@@ -89,12 +101,14 @@ struct BufferInfoNode : public Object {
     v->Visit("alignment", &alignment);
     v->Visit("conflicts", &conflicts);
     v->Visit("kind", &kind);
+    v->Visit("access_count", &access_count);
   }
 
   bool SEqualReduce(const BufferInfoNode* other, SEqualReducer equal) const {
     return equal(name_hint, other->name_hint) && equal(size_bytes, other->size_bytes) &&
            equal(pool_candidates, other->pool_candidates) && equal(alignment, other->alignment) &&
-           equal(conflicts, other->conflicts) && equal(kind, other->kind);
+           equal(conflicts, other->conflicts) && equal(kind, other->kind) &&
+           equal(access_count, other->access_count);
   }
 
   void SHashReduce(SHashReducer hash_reduce) const {
@@ -104,6 +118,7 @@ struct BufferInfoNode : public Object {
     hash_reduce(conflicts);
     hash_reduce(pool_candidates);
     hash_reduce(kind);
+    hash_reduce(access_count);
   }
   /*!
    * \brief Set the liveness conflicts of this BufferInfo
@@ -111,6 +126,12 @@ struct BufferInfoNode : public Object {
    * \param conflicting_buffer_info_objs An array of BufferInfo that conflicts in liveness
    */
   TVM_DLL void SetConflicts(Array<ObjectRef> conflicting_buffer_info_objs);
+  /*!
+   * \brief Set the estimated number of accesses to this BufferInfo
+   *
+   * \param access_count The number of accesses, weighted by loop trip counts
+   */
+  TVM_DLL void SetAccessCount(int64_t access_count);
 
   static constexpr const char* _type_key = "tir.usmp.BufferInfo";
   TVM_DECLARE_FINAL_OBJECT_INFO(BufferInfoNode, Object);
@@ -41,6 +41,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -62,6 +63,11 @@ Array<PrimExpr> InferEinsumShape(const std::string& subscripts,
 /*!
  * \brief Evaluates the Einstein summation convention on the operands.
  *
+ * Equations with three or more operands are decomposed into a sequence of pairwise
+ * contractions following EinsumContractionPath. Each intermediate is laid out as
+ * (batch labels, free labels of the lhs, free labels of the rhs), the output layout of
+ * batch_matmul.
+ *
  * \param subscripts_str Specifies the subscripts for summation as comma separated list of
  * subscript labels.
  * \param inputs Arrays for the operation.
@@ -91,6 +97,23 @@ struct EinsumEquation {
   Subscript output;
 };
 
+/*!
+ * \brief Find the order of pairwise contractions for an Einsum with three or more operands.
+ *
+ * Each step (i, j) contracts the i-th and j-th entries of the current operand list, removes them
+ * from the list and appends the intermediate result to its end. The path minimizing the total
+ * number of multiply-adds is searched exhaustively for a small number of operands, larger
+ * equations are contracted greedily.
+ *
+ * \param equation The Einsum equation.
+ * \param input_shapes The shapes of the input tensors.
+ *
+ * \return The contraction path. It is empty if the equation is better evaluated as a single
+ * compute, e.g. when it has fewer than three operands, uses an ellipsis or has symbolic shapes.
+ */
+std::vector<std::pair<int, int>> EinsumContractionPath(const EinsumEquation& equation,
+                                                       const Array<Array<PrimExpr>>& input_shapes);
+
 }  // namespace topi
 }  // namespace tvm
 #endif  // TVM_TOPI_EINSUM_H_
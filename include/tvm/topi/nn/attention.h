@@ -0,0 +1,137 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \brief Fused attention op constructions
+ * \file nn/attention.h
+ */
+#ifndef TVM_TOPI_NN_ATTENTION_H_
+#define TVM_TOPI_NN_ATTENTION_H_
+
+#include <tvm/te/operation.h>
+#include <tvm/topi/detail/constant_utils.h>
+#include <tvm/topi/reduction.h>
+#include <tvm/topi/tags.h>
+
+#include <cmath>
+#include <string>
+
+namespace tvm {
+namespace topi {
+namespace nn {
+
+using namespace tvm::te;
+
+/*!
+ * \brief Fused scaled dot-product attention, softmax(scale * Q * K^T) * V.
+ *
+ * The computation is split into row-wise stages (scores, row max, row sum of exponentials,
+ * weighted accumulation and normalization) that only depend on the (batch, head, query) row
+ * they belong to. A schedule that computes every intermediate stage at the row loop of the
+ * output keeps the working set at O(kv_len) per row instead of materializing the full
+ * [q_len, kv_len] attention matrix, and each stage stays a separate block that can be tiled
+ * independently by meta_schedule.
+ *
+ * \param query 4-D tensor with shape [batch, heads, q_len, head_dim]
+ * \param key 4-D tensor with shape [batch, heads, kv_len, head_dim]
+ * \param value 4-D tensor with shape [batch, heads, kv_len, value_dim]
+ * \param scale The scale applied to Q * K^T. A non-positive value means 1 / sqrt(head_dim).
+ * \param causal Whether to mask out keys that come after the query position. The query rows
+ *               are aligned to the end of the key sequence, so query i attends to keys
+ *               [0, i + kv_len - q_len].
+ * \param name The name of the operation
+ * \param tag The tag to mark the operation
+ *
+ * \return A Tensor with shape [batch, heads, q_len, value_dim]
+ */
+inline Tensor fused_attention(const Tensor& query, const Tensor& key, const Tensor& value,
+                              double scale, bool causal, std::string name = "T_fused_attention",
+                              std::string tag = "fused_attention_output") {
+  ICHECK_EQ(query->shape.size(), 4) << "fused_attention requires 4-D query";
+  ICHECK_EQ(key->shape.size(), 4) << "fused_attention requires 4-D key";
+  ICHECK_EQ(value->shape.size(), 4) << "fused_attention requires 4-D value";
+
+  auto batch = query->shape[0];
+  auto heads = query->shape[1];
+  auto q_len = query->shape[2];
+  auto head_dim = query->shape[3];
+  auto kv_len = key->shape[2];
+  auto value_dim = value->shape[3];
+  auto dtype = query->dtype;
+
+  if (scale <= 0) {
+    ICHECK(head_dim.as<IntImmNode>()) << "fused_attention requires an explicit scale when "
+                                      << "head_dim is not a constant";
+    scale = 1.0 / std::sqrt(static_cast<double>(detail::GetConstInt(head_dim)));
+  }
+
+  tvm::Map<String, ObjectRef> attrs;
+  attrs.Set("causal", Bool(causal));
+
+  auto d = tvm::te::reduce_axis(Range(0, head_dim), "d");
+  auto scores = tvm::te::compute(
+      {batch, heads, q_len, kv_len},
+      [&](Var b, Var h, Var i, Var j) {
+        return tvm::sum(query(b, h, i, d) * key(b, h, j, d), {d});
+      },
+      name + "_scores", "fused_attention_scores");
+
+  // Scaled and masked score, inlined into every consumer of the raw scores.
+  auto offset = kv_len - q_len;
+  auto masked = [&](const PrimExpr& b, const PrimExpr& h, const PrimExpr& i, const PrimExpr& j) {
+    PrimExpr s = scores(b, h, i, j) * make_const(dtype, scale);
+    if (causal) {
+      s = tvm::if_then_else(j > i + offset, tvm::min_value(dtype), s);
+    }
+    return s;
+  };
+
+  auto j1 = tvm::te::reduce_axis(Range(0, kv_len), "j");
+  auto row_max = tvm::te::compute(
+      {batch, heads, q_len},
+      [&](Var b, Var h, Var i) { return tvm::max(masked(b, h, i, j1), Array<IterVar>{j1}); },
+      name + "_max", "fused_attention_max");
+
+  auto j2 = tvm::te::reduce_axis(Range(0, kv_len), "j");
+  auto row_sum = tvm::te::compute(
+      {batch, heads, q_len},
+      [&](Var b, Var h, Var i) {
+        return tvm::sum(tvm::exp(masked(b, h, i, j2) - row_max(b, h, i)), {j2});
+      },
+      name + "_sum", "fused_attention_sum");
+
+  auto j3 = tvm::te::reduce_axis(Range(0, kv_len), "j");
+  auto acc = tvm::te::compute(
+      {batch, heads, q_len, value_dim},
+      [&](Var b, Var h, Var i, Var e) {
+        return tvm::sum(tvm::exp(masked(b, h, i, j3) - row_max(b, h, i)) * value(b, h, j3, e),
+                        {j3});
+      },
+      name + "_acc", "fused_attention_acc");
+
+  return tvm::te::compute(
+      {batch, heads, q_len, value_dim},
+      [&](Var b, Var h, Var i, Var e) { return acc(b, h, i, e) / row_sum(b, h, i); }, name, tag,
+      attrs);
+}
+
+}  // namespace nn
+}  // namespace topi
+}  // namespace tvm
+#endif  // TVM_TOPI_NN_ATTENTION_H_
@@ -95,15 +95,28 @@ class NDArrayBase(object):
         """Shape of this array"""
         return tuple(self.handle.contents.shape[i] for i in range(self.handle.contents.ndim))
 
-    def to_dlpack(self):
+    def to_dlpack(self, stream=None):
         """Produce an array from a DLPack Tensor without copying memory
 
+        Parameters
+        ----------
+        stream : int, optional
+            The handle of the stream the consumer uses the array on. The work submitted
+            to the current stream of the device is ordered before it.
+
         Returns
         -------
         dlpack : DLPack tensor view of the array data
         """
         handle = ctypes.c_void_p()
-        check_call(_LIB.TVMArrayToDLPack(self.handle, ctypes.byref(handle)))
+        if stream is None:
+            check_call(_LIB.TVMArrayToDLPack(self.handle, ctypes.byref(handle)))
+        else:
+            check_call(
+                _LIB.TVMArrayToDLPackWithStream(
+                    self.handle, ctypes.c_void_p(stream), ctypes.byref(handle)
+                )
+            )
         return ctypes.pythonapi.PyCapsule_New(handle, _c_str_dltensor, _c_dlpack_deleter)
 
 
@@ -145,6 +145,9 @@ cdef extern from "tvm/runtime/c_runtime_api.h":
                            DLTensorHandle* out) nogil
     int TVMArrayToDLPack(DLTensorHandle arr_from,
                          DLManagedTensor** out) nogil
+    int TVMArrayToDLPackWithStream(DLTensorHandle arr_from,
+                                   TVMStreamHandle consumer_stream,
+                                   DLManagedTensor** out) nogil
     void TVMDLManagedTensorCallDeleter(DLManagedTensor* dltensor)
     int TVMObjectFree(ObjectHandle obj)
     int TVMObjectGetTypeIndex(ObjectHandle obj, unsigned* out_index)
@@ -99,19 +99,32 @@ cdef class NDArrayBase:
         CHECK_CALL(c_api_ret_code)
         return target_nd
 
-    def to_dlpack(self):
+    def to_dlpack(self, stream=None):
         """Produce an array from a DLPack Tensor without copying memory
 
+        Parameters
+        ----------
+        stream : int, optional
+            The handle of the stream the consumer uses the array on. The work submitted
+            to the current stream of the device is ordered before it.
+
         Returns
         -------
         dlpack : DLPack tensor view of the array data
         """
         cdef DLManagedTensor* dltensor
         cdef int c_api_ret_code
+        cdef TVMStreamHandle consumer_stream
         if self.c_is_view != 0:
             raise ValueError("to_dlpack do not work with memory views")
-        with nogil:
-            c_api_ret_code = TVMArrayToDLPack(self.chandle, &dltensor)
+        if stream is None:
+            with nogil:
+                c_api_ret_code = TVMArrayToDLPack(self.chandle, &dltensor)
+        else:
+            consumer_stream = <TVMStreamHandle><size_t>stream
+            with nogil:
+                c_api_ret_code = TVMArrayToDLPackWithStream(
+                    self.chandle, consumer_stream, &dltensor)
         CHECK_CALL(c_api_ret_code)
         return pycapsule.PyCapsule_New(dltensor, _c_str_dltensor, _c_dlpack_deleter)
 
@@ -115,6 +115,10 @@ class DataType(ctypes.Structure):
         "float64": {"type_code": DataTypeCode.FLOAT, "bits": 64, "lanes": 1},
     }
 
+    # The lanes are an int16 in C++, scalable vectors store the negated vscale factor.
+    _SCALABLE_LANES_BASE = 0x10000
+    _SCALABLE_LANES_MIN = 0x8000
+
     def __init__(self, type_str):
         super(DataType, self).__init__()
         numpy_str_map = DataType.NUMPY2STR
@@ -135,7 +139,11 @@ class DataType(ctypes.Structure):
 
         arr = type_str.split("x")
         head = arr[0]
-        self.lanes = int(arr[1]) if len(arr) > 1 else 1
+        if len(arr) == 3 and arr[1] == "vscale":
+            # A scalable vector stores the negated vscale factor in the lanes.
+            self.lanes = DataType._SCALABLE_LANES_BASE - int(arr[2])
+        else:
+            self.lanes = int(arr[1]) if len(arr) > 1 else 1
         bits = 32
 
         if head.startswith("int"):
@@ -188,10 +196,23 @@ class DataType(ctypes.Structure):
 
             type_name = "custom[%s]" % tvm.runtime._ffi_api._datatype_get_type_name(self.type_code)
         x = "%s%d" % (type_name, self.bits)
-        if self.lanes != 1:
+        if self.is_scalable:
+            x += "xvscalex%d" % self.vscale_factor
+        elif self.lanes != 1:
             x += "x%d" % self.lanes
         return x
 
+    @property
+    def is_scalable(self):
+        """Whether the type is a scalable vector of vscale * vscale_factor lanes."""
+        return self.lanes >= DataType._SCALABLE_LANES_MIN and self.lanes < 0xFFFF
+
+    @property
+    def vscale_factor(self):
+        """The multiplier of vscale in the lanes of a scalable vector."""
+        assert self.is_scalable, "A fixed length vector doesn't have a vscale factor"
+        return DataType._SCALABLE_LANES_BASE - self.lanes
+
     def __eq__(self, other):
         return (
             self.bits == other.bits
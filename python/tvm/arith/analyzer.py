@@ -98,6 +98,9 @@ class Analyzer:
         self._rewrite_simplify = _mod("rewrite_simplify")
         self._get_rewrite_simplify_stats = _mod("get_rewrite_simplify_stats")
         self._reset_rewrite_simplify_stats = _mod("reset_rewrite_simplify_stats")
+        self._enable_simplify_memo = _mod("enable_simplify_memo")
+        self._get_simplify_memo_stats = _mod("get_simplify_memo_stats")
+        self._reset_simplify_memo_stats = _mod("reset_simplify_memo_stats")
         self._canonical_simplify = _mod("canonical_simplify")
         self._int_set = _mod("int_set")
         self._enter_constraint_context = _mod("enter_constraint_context")
@@ -176,6 +179,26 @@ class Analyzer:
     def reset_rewrite_simplify_stats(self):
         self._reset_rewrite_simplify_stats()
 
+    def enable_simplify_memo(self, enable=True):
+        """Enable or disable the memoization of simplify.
+
+        The results are remembered per expression object, and dropped
+        by bind and at the exit of constraint scopes.
+
+        Parameters
+        ----------
+        enable : bool
+            Whether to memoize simplify.
+        """
+        self._enable_simplify_memo(enable)
+
+    @property
+    def simplify_memo_stats(self):
+        return self._get_simplify_memo_stats()
+
+    def reset_simplify_memo_stats(self):
+        self._reset_simplify_memo_stats()
+
     def canonical_simplify(self, expr):
         """Simplify expression via canonicalization.
 
@@ -52,7 +52,10 @@ from .measure import (
 from .measure_record import (
     RecordReader,
     RecordToFile,
+    build_record_index,
+    compact_record_file,
     load_best_record,
+    load_indexed_records,
     load_records,
     save_records,
 )
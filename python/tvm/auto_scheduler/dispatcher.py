@@ -33,7 +33,7 @@ from tvm.contrib.utils import tempdir
 from tvm.tir.expr import FloatImm
 from .cost_model import RandomModel, XGBModel
 from .measure import LocalRPCMeasureContext
-from .measure_record import RecordToFile, load_records
+from .measure_record import RecordToFile, load_indexed_records, load_records
 from .search_policy import PreloadMeasuredStates, SketchPolicy
 from .search_task import SearchTask, TuningOptions
 from .utils import calc_workload_dis_factor, decode_workload_key
@@ -208,7 +208,8 @@ class ApplyHistoryBest(DispatchContext):
                 rec = str(rec)
 
             if isinstance(rec, str):
-                rec = load_records(rec)
+                # Only the best records are used, which are all in the index if there is one
+                rec = load_records(rec) if n_lines is not None else load_indexed_records(rec)
                 joint_records += rec
             else:
                 if rec is not None:
@@ -236,6 +236,23 @@ def get_per_store_features_from_states(
     return unpack_feature(byte_arr)[0]
 
 
+def clear_feature_cache() -> None:
+    """Clear the cache of the features extracted from states, which are keyed by the task and the
+    transform steps of a state, so the states recurring in the search are lowered only once."""
+    _ffi_api.ClearFeatureCache()
+
+
+def feature_cache_size() -> int:
+    """Get the number of states whose features are cached.
+
+    Returns
+    -------
+    size: int
+        The number of states cached
+    """
+    return int(_ffi_api.FeatureCacheSize())
+
+
 def get_per_store_feature_names(max_n_bufs: Optional[int] = None) -> List[str]:
     """Get the name of every element in the feature vector. Use this for debug and inspection.
 
@@ -381,6 +381,12 @@ class LocalRunner(ProgramRunner):
         This is only has effect on CPU task.
     device: int = 0
         Which device to run on if multiple are available.
+    max_rel_ci : float = 0.0
+        If positive, keep repeating the measurement after `repeat` repeats until the half
+        width of the 95% confidence interval on the mean falls below this fraction of the mean.
+    max_measure_ms : int = 1000
+        The cap on the duration of the repeats in milliseconds, when `max_rel_ci` is positive.
+        It should stay well below `timeout`.
     """
 
     def __init__(
@@ -392,6 +398,8 @@ class LocalRunner(ProgramRunner):
         cooldown_interval=0.0,
         enable_cpu_cache_flush=False,
         device=0,
+        max_rel_ci=0.0,
+        max_measure_ms=1000,
     ):
         if enable_cpu_cache_flush:
             number = 1
@@ -406,6 +414,8 @@ class LocalRunner(ProgramRunner):
             cooldown_interval,
             enable_cpu_cache_flush,
             device,
+            max_rel_ci,
+            max_measure_ms,
         )
 
 
@@ -456,6 +466,12 @@ class RPCRunner(ProgramRunner):
         This is only has effect on CPU task.
     device: int = 0
         Which device to run on if multiple are available.
+    max_rel_ci : float = 0.0
+        If positive, keep repeating the measurement after `repeat` repeats until the half
+        width of the 95% confidence interval on the mean falls below this fraction of the mean.
+    max_measure_ms : int = 1000
+        The cap on the duration of the repeats in milliseconds, when `max_rel_ci` is positive.
+        It should stay well below `timeout`.
     """
 
     def __init__(
@@ -472,6 +488,8 @@ class RPCRunner(ProgramRunner):
         cooldown_interval=0.0,
         enable_cpu_cache_flush=False,
         device=0,
+        max_rel_ci=0.0,
+        max_measure_ms=1000,
     ):
         self.__init_handle_by_constructor__(
             _ffi_api.RPCRunner,
@@ -487,6 +505,8 @@ class RPCRunner(ProgramRunner):
             cooldown_interval,
             enable_cpu_cache_flush,
             device,
+            max_rel_ci,
+            max_measure_ms,
         )
 
         if check_remote(key, host, port, priority, timeout):
@@ -539,6 +559,12 @@ class LocalRPCMeasureContext:
         This is only has effect on CPU task.
     device: int = 0
         Which device to run on if multiple are available.
+    max_rel_ci : float = 0.0
+        If positive, keep repeating the measurement after `repeat` repeats until the half
+        width of the 95% confidence interval on the mean falls below this fraction of the mean.
+    max_measure_ms : int = 1000
+        The cap on the duration of the repeats in milliseconds, when `max_rel_ci` is positive.
+        It should stay well below `timeout`.
     """
 
     def __init__(
@@ -552,6 +578,8 @@ class LocalRPCMeasureContext:
         cooldown_interval=0.0,
         enable_cpu_cache_flush=False,
         device=0,
+        max_rel_ci=0.0,
+        max_measure_ms=1000,
     ):
         # pylint: disable=import-outside-toplevel
         from tvm.rpc.server import Server
@@ -579,6 +607,8 @@ class LocalRPCMeasureContext:
             cooldown_interval,
             enable_cpu_cache_flush,
             device,
+            max_rel_ci,
+            max_measure_ms,
         )
         # Wait for the processes to start
         time.sleep(0.5)
@@ -882,6 +912,8 @@ def _timed_eval_func(
     enable_cpu_cache_flush,
     verbose,
     device,
+    max_rel_ci,
+    max_measure_ms,
 ):
     inp = MeasureInput.deserialize(inp_serialized)
     tic = time.time()
@@ -903,6 +935,8 @@ def _timed_eval_func(
             repeat=repeat,
             min_repeat_ms=min_repeat_ms,
             f_preproc=f_prepare,
+            max_rel_ci=max_rel_ci,
+            max_measure_ms=max_measure_ms,
         )
     # pylint: disable=broad-except
     except Exception:
@@ -959,6 +993,8 @@ def local_run(
     enable_cpu_cache_flush=False,
     verbose=1,
     device=0,
+    max_rel_ci=0.0,
+    max_measure_ms=1000,
 ):
     """
     Run function of LocalRunner to test the performance of the input BuildResults.
@@ -1000,6 +1036,12 @@ def local_run(
         Verbosity level. 0 for silent, 1 to output information during program measuring.
     device: int = 0
         Which device to run on if multiple are available.
+    max_rel_ci : float = 0.0
+        If positive, keep repeating the measurement after `repeat` repeats until the half
+        width of the 95% confidence interval on the mean falls below this fraction of the mean.
+    max_measure_ms : int = 1000
+        The cap on the duration of the repeats in milliseconds, when `max_rel_ci` is positive.
+        It should stay well below `timeout`.
 
     Returns
     -------
@@ -1036,6 +1078,8 @@ def local_run(
                     enable_cpu_cache_flush,
                     verbose,
                     device,
+                    max_rel_ci,
+                    max_measure_ms,
                 ),
             )
             if isinstance(res, TimeoutError):
@@ -1083,6 +1127,8 @@ def _rpc_run(
     enable_cpu_cache_flush,
     verbose,
     device,
+    max_rel_ci,
+    max_measure_ms,
 ):
     inp = MeasureInput.deserialize(inp_serialized)
     tic = time.time()
@@ -1107,6 +1153,8 @@ def _rpc_run(
             repeat=repeat,
             min_repeat_ms=min_repeat_ms,
             f_preproc=f_prepare,
+            max_rel_ci=max_rel_ci,
+            max_measure_ms=max_measure_ms,
         )
     # pylint: disable=broad-except
     except Exception:
@@ -1182,7 +1230,7 @@ def _rpc_run_worker(args):
     res : MeasureResult
         The measure result of this Runner thread.
     """
-    _, build_res, _, _, _, _, _, timeout, _, _, _, _, _, verbose, _ = args
+    _, build_res, _, _, _, _, _, timeout, _, _, _, _, _, verbose, _, _, _ = args
     if build_res.error_no != MeasureErrorNo.NO_ERROR:
         return (
             (MAX_FLOAT,),
@@ -1226,6 +1274,8 @@ def rpc_runner_run(
     enable_cpu_cache_flush=False,
     verbose=1,
     device=0,
+    max_rel_ci=0.0,
+    max_measure_ms=1000,
 ):
     """Run function of RPCRunner to test the performance of the input BuildResults.
 
@@ -1276,6 +1326,12 @@ def rpc_runner_run(
         Verbosity level. 0 for silent, 1 to output information during program measuring.
     device: int = 0
         Which device to run on if multiple are available.
+    max_rel_ci : float = 0.0
+        If positive, keep repeating the measurement after `repeat` repeats until the half
+        width of the 95% confidence interval on the mean falls below this fraction of the mean.
+    max_measure_ms : int = 1000
+        The cap on the duration of the repeats in milliseconds, when `max_rel_ci` is positive.
+        It should stay well below `timeout`.
 
     Returns
     -------
@@ -1304,6 +1360,8 @@ def rpc_runner_run(
                 enable_cpu_cache_flush,
                 verbose,
                 device,
+                max_rel_ci,
+                max_measure_ms,
             )
             for inp, build_res in zip(inputs, build_results)
         ],
@@ -42,13 +42,17 @@ class RecordToFile(MeasureCallback):
     ----------
     filename : str
         File name for this callback to write log to.
+    index_best_k : int = 0
+        If positive, keep an index of the `index_best_k` best records of each workload and target
+        in `filename + ".index"`, updated as records are written, which lets the readers load
+        the best records without parsing the whole file. See `load_indexed_records`.
     """
 
-    def __init__(self, filename):
+    def __init__(self, filename, index_best_k=0):
         dirname = os.path.dirname(os.path.abspath(filename))
         if not os.path.exists(dirname):
             os.makedirs(dirname)
-        self.__init_handle_by_constructor__(_ffi_api.RecordToFile, filename)
+        self.__init_handle_by_constructor__(_ffi_api.RecordToFile, filename, index_best_k)
 
 
 @tvm._ffi.register_object("auto_scheduler.RecordReader")
@@ -125,6 +129,27 @@ class RecordReader(Object):
         self.check_workload_key(inputs)
         return inputs, results
 
+    def read_indexed(self, workload_key=None):
+        """Read the records in the index of the log file. The index is brought up to date with the
+        records appended after it, and it is not written back. If the log file has no index, all
+        the records are read.
+
+        Parameters
+        ----------
+        workload_key : Optional[str]
+            The workload key of the records to read. None to read the records of all workloads.
+
+        Returns
+        -------
+        inputs : List[auto_scheduler.measure.MeasureInput]
+            The MeasureInputs of the best records in the log file, in the order of the file.
+        results : List[auto_scheduler.measure.MeasureResult]
+            The MeasureResults of the best records in the log file, in the order of the file.
+        """
+        inputs, results = _ffi_api.RecordReaderReadIndexed(self, workload_key)
+        self.check_workload_key(inputs)
+        return inputs, results
+
     def __iter__(self):
         while True:
             ret = _ffi_api.RecordReaderReadNext(self)
@@ -194,7 +219,26 @@ def load_records(filename):
     return zip(*RecordReader(filename).read_lines())
 
 
-def save_records(filename, inputs, results):
+def load_indexed_records(filename, workload_key=None):
+    """
+    Load the best measurement records from a file through its index, or all the records if the
+    file has no index.
+
+    Parameters
+    ----------
+    filename : str
+        File name to load log from.
+    workload_key : Optional[str]
+        The workload key of the records to load. None to load the records of all workloads.
+
+    Returns
+    -------
+    logs : List[auto_scheduler.measure.MeasureInput, auto_scheduler.measure.MeasureResult]
+    """
+    return zip(*RecordReader(filename).read_indexed(workload_key))
+
+
+def save_records(filename, inputs, results, index_best_k=0):
     """
     Append measure records to file.
 
@@ -206,11 +250,53 @@ def save_records(filename, inputs, results):
         The MeasureInputs to be written.
     results: List[MeasureResults]
         The MeasureResults to be written.
+    index_best_k : int = 0
+        If positive, update the index of the `index_best_k` best records of each workload and
+        target in `filename + ".index"`.
     """
     dirname = os.path.dirname(os.path.abspath(filename))
     if not os.path.exists(dirname):
         os.makedirs(dirname)
-    _ffi_api.SaveRecords(filename, inputs, results)
+    _ffi_api.SaveRecords(filename, inputs, results, index_best_k)
+
+
+def build_record_index(filename, best_k=1):
+    """
+    Build the index of the best records of each workload and target of a log file in
+    `filename + ".index"`, replacing the existing one.
+
+    Parameters
+    ----------
+    filename : str
+        File name of the log.
+    best_k : int = 1
+        The number of best records of each workload and target to index.
+    """
+    _ffi_api.BuildRecordIndex(filename, best_k)
+
+
+def compact_record_file(in_file, out_file, best_k=1, build_index=True):
+    """
+    Write the best records of each workload and target of a log file to another file, in the order
+    of the input file. Unlike `distill_record_file`, the records are copied without being
+    deserialized, and the output file is overwritten.
+
+    Parameters
+    ----------
+    in_file : str
+        The filename of input.
+    out_file : str
+        The filename of output.
+    best_k : int = 1
+        The number of best records of each workload and target to keep.
+    build_index : bool = True
+        Whether to build the index of the output file.
+    """
+    dirname = os.path.dirname(os.path.abspath(out_file))
+    if not os.path.exists(dirname):
+        os.makedirs(dirname)
+    _ffi_api.CompactRecordFile(in_file, out_file, best_k, build_index)
+    logger.info("Compact the best %d record(s) from %s to %s", best_k, in_file, out_file)
 
 
 def load_best_record(filename, workload_key=None, target=None, include_compatible=False):
@@ -242,7 +328,9 @@ def load_best_record(filename, workload_key=None, target=None, include_compatibl
     best_inp = None
     best_res = None
 
-    for inp, res in log_reader:
+    # The best record of each workload and target is in the index if the file has one
+    inputs, results = log_reader.read_indexed(None if include_compatible else workload_key)
+    for inp, res in zip(inputs, results):
         if res.error_no != MeasureErrorNo.NO_ERROR:
             continue
         if target and inp.task.target.kind.name != target.kind.name:
@@ -344,9 +432,12 @@ def distill_record_file(in_file, out_file):
 def main():
     """The main function for CLI."""
     parser = argparse.ArgumentParser()
-    parser.add_argument("--mode", choices=["distill"], default="distill")
+    parser.add_argument("--mode", choices=["distill", "compact", "index"], default="distill")
     parser.add_argument("-i", "--input", type=str, help="input file")
     parser.add_argument("-o", "--output", type=str, default=None, help="output file")
+    parser.add_argument(
+        "--best-k", type=int, default=1, help="number of best records per workload and target"
+    )
 
     args = parser.parse_args()
     logging.basicConfig()
@@ -355,12 +446,21 @@ def main():
     if args.mode == "distill":
         args.output = args.output or args.input + ".best.json"
         distill_record_file(args.input, args.output)
+    elif args.mode == "compact":
+        args.output = args.output or args.input + ".best.json"
+        compact_record_file(args.input, args.output, args.best_k)
+    elif args.mode == "index":
+        build_record_index(args.input, args.best_k)
 
 
 """
 Usage:
 * Distill the best entries from a large log file
 e.g. python -m tvm.auto_scheduler.measure_record --mode distill -i input.json
+* Compact a large log file to the best k entries of each workload and target, with an index
+e.g. python -m tvm.auto_scheduler.measure_record --mode compact --best-k 3 -i input.json
+* Build the index of a log file
+e.g. python -m tvm.auto_scheduler.measure_record --mode index --best-k 3 -i input.json
 """
 if __name__ == "__main__":
     main()
@@ -80,6 +80,7 @@ class GraphModuleCudaGraph(graph_executor.GraphModule):
         self._start_capture = module["start_capture"]
         self._end_capture = module["end_capture"]
         self._run_cuda_graph = module["run_cuda_graph"]
+        self._set_cuda_graph_cache_size = module["set_cuda_graph_cache_size"]
         self._cuda_graph_captured = False
         graph_executor.GraphModule.__init__(self, module)
 
@@ -99,10 +100,26 @@ class GraphModuleCudaGraph(graph_executor.GraphModule):
         """Run the CUDA graph for tvm_op graph
 
         Run the captured CUDA graph instance instead of the
-        for-loop kernel launch of default graph executor
+        for-loop kernel launch of default graph executor.
+        Inputs and outputs rebound with set_input_zero_copy or
+        set_output_zero_copy are picked up by capturing again,
+        or from the cache of graphs when the binding was seen before.
         """
         self._run_cuda_graph()
 
+    def set_cuda_graph_cache_size(self, size):
+        """Set how many instantiated CUDA graphs are kept
+
+        Each zero-copy binding of inputs and outputs has its own graph, the
+        least recently used one is updated in place when the cache is full.
+
+        Parameters
+        ----------
+        size : int
+            The maximum number of instantiated graphs, 4 by default.
+        """
+        self._set_cuda_graph_cache_size(size)
+
     def run(self, **input_dict):
         """A run wrapper for graph capture / launch, user can just
         change default graph executor to cuda graph executor, and
@@ -118,15 +118,48 @@ def select_gemm_kernel(
     batched,
     find_first_valid,
     use_multiprocessing,
+    dynamic_m_buckets=(),
 ):
     """Run CUTLASS profiler to select the best kernel, or return the default one for dynamic
-    workloads."""
+    workloads. When only M is dynamic, also select the best kernel for each upper bound of M in
+    dynamic_m_buckets, to dispatch on M at runtime.
+
+    Returns the name and the definitions of the kernels, and the list of (kernel name, upper
+    bound of M) of the buckets, where the last bound is -1 to hold all M."""
+    buckets = []
     if any(isinstance(s, tvm.tir.Any) for s in [MM, KK, NN]):
         out = cutlass_profiler.get_default(
             op_type, out_dtype, arg0_dtype, arg1_dtype, use_3xtf32, batched=batched
         )
         name, cutlass_op_def = out["name"], out["opdef"]
         logger.info("Picked the default kernel %s", name)
+
+        if dynamic_m_buckets and not any(isinstance(s, tvm.tir.Any) for s in [KK, NN]):
+            op_defs = {name: cutlass_op_def}
+            bounds = sorted(int(bound) for bound in dynamic_m_buckets)
+            for i, bound in enumerate(bounds):
+                bucket_name, bucket_op_def, _ = cutlass_profiler.profile(
+                    op_type,
+                    bound,
+                    NN,
+                    KK,
+                    out_dtype,
+                    arg0_dtype,
+                    arg1_dtype,
+                    use_3xtf32,
+                    batched=batched,
+                    find_first_valid=find_first_valid,
+                    use_multiprocessing=use_multiprocessing,
+                )
+                op_defs.setdefault(bucket_name, bucket_op_def)
+                bound = bound if i + 1 < len(bounds) else -1
+                # Merge the consecutive buckets which select the same kernel.
+                if buckets and buckets[-1][0] == bucket_name:
+                    buckets[-1] = (bucket_name, bound)
+                else:
+                    buckets.append((bucket_name, bound))
+            cutlass_op_def = "\n".join(op_defs.values())
+            logger.info("Picked the kernels %s for the buckets of M", buckets)
     else:
         name, cutlass_op_def, _ = cutlass_profiler.profile(
             op_type,
@@ -146,7 +179,16 @@ def select_gemm_kernel(
         else:
             logger.info("Picked the first kernel found %s", name)
 
-    return name, cutlass_op_def
+    return name, cutlass_op_def, buckets
+
+
+def _bucket_attrs(buckets):
+    if not buckets:
+        return {}
+    return {
+        "cutlass_op_bucket_names": [name for name, _ in buckets],
+        "cutlass_op_bucket_bounds": [bound for _, bound in buckets],
+    }
 
 
 def handle_batch_matmul(
@@ -160,13 +202,14 @@ def handle_batch_matmul(
     use_3xtf32,
     find_first_valid,
     use_multiprocessing,
+    dynamic_m_buckets=(),
 ):
     """Profile and select a kernel for batch_matmul op workload."""
     MM = arg0_shape[1]
     KK = arg0_shape[2]
     NN = arg1_shape[1]
 
-    name, cutlass_op_def = select_gemm_kernel(
+    name, cutlass_op_def, buckets = select_gemm_kernel(
         cutlass_profiler,
         op_type,
         MM,
@@ -179,9 +222,10 @@ def handle_batch_matmul(
         True,
         find_first_valid,
         use_multiprocessing,
+        dynamic_m_buckets,
     )
 
-    return {
+    attrs = {
         "batch": arg0_shape[0],
         "batch_stride_A": arg0_shape[1] * arg0_shape[2],
         "batch_stride_B": arg1_shape[1] * arg1_shape[2],
@@ -192,6 +236,8 @@ def handle_batch_matmul(
         "ldb": "K",
         "ldc": "N",
     }
+    attrs.update(_bucket_attrs(buckets))
+    return attrs
 
 
 def handle_dense(
@@ -205,13 +251,14 @@ def handle_dense(
     use_3xtf32,
     find_first_valid,
     use_multiprocessing,
+    dynamic_m_buckets=(),
 ):
     """Profile and select a kernel for dense op workload."""
     MM = arg0_shape[0]
     KK = arg0_shape[1]
     NN = arg1_shape[0]
 
-    name, cutlass_op_def = select_gemm_kernel(
+    name, cutlass_op_def, buckets = select_gemm_kernel(
         cutlass_profiler,
         op_type,
         MM,
@@ -224,17 +271,20 @@ def handle_dense(
         False,
         find_first_valid,
         use_multiprocessing,
+        dynamic_m_buckets,
     )
 
     assert "tn_align" in name, "Only supports (row_major, col_major) input layout for now."
 
-    return {
+    attrs = {
         "cutlass_op_def": cutlass_op_def,
         "cutlass_op_name": name,
         "lda": "K",
         "ldb": "K",
         "ldc": "N",
     }
+    attrs.update(_bucket_attrs(buckets))
+    return attrs
 
 
 def handle_conv2d(
@@ -307,6 +357,8 @@ def tune_cutlass_kernels(
     find_first_valid=False,
     use_multiprocessing=False,
     tmp_dir="./tmp",
+    dynamic_m_buckets=[],
+    tuning_cache=None,
 ):
     """Given a module partitioned for CUTLASS offloading, profile each workload to select which
     kernels to emit.
@@ -345,6 +397,16 @@ def tune_cutlass_kernels(
     tmp_dir : string, optional
         A temporary directory where intermediate compiled artifacts will be stored.
 
+    dynamic_m_buckets : list of int, optional
+        Upper bounds of M for the dense and batch_matmul workloads whose M is the only dynamic
+        dimension. The best kernel is profiled for each bound, and the generated code dispatches
+        on M at runtime to the kernel of the smallest bound which holds it, or of the largest
+        bound. When empty, such workloads use the default kernel.
+
+    tuning_cache : string, optional
+        A JSON file where the kernels selected by profiling are stored, and looked up before
+        profiling, to reuse them across builds.
+
     Returns
     -------
     mod : IRModule
@@ -353,8 +415,8 @@ def tune_cutlass_kernels(
     num_cutlass_partition : int
         The number of partitioned functions created for CUTLASS.
     """
-    gemm_profiler = CutlassGemmProfiler(sm, _get_cutlass_path(), tmp_dir)
-    conv2d_profiler = CutlassConv2DProfiler(sm, _get_cutlass_path(), tmp_dir)
+    gemm_profiler = CutlassGemmProfiler(sm, _get_cutlass_path(), tmp_dir, tuning_cache)
+    conv2d_profiler = CutlassConv2DProfiler(sm, _get_cutlass_path(), tmp_dir, tuning_cache)
     num_cutlass_partition = 0
     for var in mod.get_global_vars():
         fun_name = var.name_hint
@@ -370,6 +432,7 @@ def tune_cutlass_kernels(
                 use_multiprocessing,
                 gemm_profiler,
                 conv2d_profiler,
+                dynamic_m_buckets,
             )
             mod.update_func(var, new_func)
 
@@ -385,6 +448,7 @@ def tune_cutlass_function(
     use_multiprocessing,
     gemm_profiler,
     conv2d_profiler,
+    dynamic_m_buckets=[],
 ):
     """Given a function intended to be offloaded to CUTLASS,  profile each workload to select which
     kernels to emit.
@@ -422,6 +486,10 @@ def tune_cutlass_function(
     conv2d_profiler : CutlassConv2DProfiler
         Profiler for conv2d operators. May cach results between tuned functions.
 
+    dynamic_m_buckets : list of int, optional
+        Upper bounds of M to select kernels for, when M is the only dynamic dimension of a dense
+        or batch_matmul workload.
+
     Returns
     -------
     annot_func : Function
@@ -488,6 +556,7 @@ def tune_cutlass_function(
                 use_3xtf32,
                 find_first_valid,
                 use_multiprocessing,
+                dynamic_m_buckets,
             )
         )
     elif "dense" in op_type:
@@ -503,6 +572,7 @@ def tune_cutlass_function(
                 use_3xtf32,
                 find_first_valid,
                 use_multiprocessing,
+                dynamic_m_buckets,
             )
         )
     else:
@@ -581,8 +651,10 @@ def compile_for_cutlass(mod, cutlass_target):
             "profile_all_alignments",
             "find_first_valid",
             "use_multiprocessing",
+            "dynamic_m_buckets",
         ]
     }
+    tuning_config["tuning_cache"] = cutlass_target.attrs.get("tuning_cache") or None
     compile_config = {
         key: cutlass_target.attrs.get(key) for key in ["sm", "threads", "use_fast_math"]
     }
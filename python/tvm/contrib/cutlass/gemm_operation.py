@@ -251,7 +251,12 @@ class EmitGemmInstance:
 
 
 def instantiate_gemm_template(attrs, func_args):
-    """Return CUTLASS host code for GEMM based on a template and the provided attribute map."""
+    """Return CUTLASS host code for GEMM based on a template and the provided attribute map.
+
+    If attrs has "op_buckets", a list of (kernel name, upper bound of M) tuned for dynamic M, the
+    code dispatches on M at runtime to the first kernel of a bucket which holds M, and whose
+    alignment divides M, or to the kernel "cutlass_op_name" otherwise. A bound of -1 holds all M.
+    """
 
     template = """
   using ElementInputA = ${ElementInputA};
@@ -261,7 +266,6 @@ def instantiate_gemm_template(attrs, func_args):
 
   ${cutlass_op_def}
 
-  using ${kernel} = Operation_${cutlass_op_name};
   int M = ${M};
   int N = ${N};
   int K = ${K};
@@ -272,7 +276,9 @@ def instantiate_gemm_template(attrs, func_args):
   void* ptr_b = (void*)(${arg1}->data);
   ${bias_decl}
   void* ptr_out = (void*)(out0->data);
-
+${launch}"""
+    launch_template = """
+  using ${kernel} = Operation_${launch_op_name};
   typename ${kernel}::Arguments arguments{
    problem_size,
    {static_cast<ElementInputA*>(ptr_a), ${lda}}, ${batch_stride_A}
@@ -292,11 +298,34 @@ def instantiate_gemm_template(attrs, func_args):
   status = gemm_op();
   CHECK(status == cutlass::Status::kSuccess);
 """
+
+    def launch(op_name, indent=""):
+        code = substitute_template(launch_template, {"launch_op_name": op_name})
+        return "".join(indent + line if line.strip() else line for line in code.splitlines(True))
+
+    dispatch = ""
+    for name, bound in attrs.pop("op_buckets", []):
+        alignment = int(name.rsplit("_align", 1)[1])
+        conds = []
+        if bound > 0:
+            conds.append(f"M <= {bound}")
+        if alignment > 1:
+            conds.append(f"M % {alignment} == 0")
+        if not conds:
+            attrs["cutlass_op_name"] = name
+            break
+        dispatch += "  " if not dispatch else " else "
+        dispatch += f"if ({' && '.join(conds)}) {{{launch(name, '  ')}  }}"
+    if dispatch:
+        launch_code = dispatch + f" else {{{launch(attrs['cutlass_op_name'], '  ')}  }}\n"
+    else:
+        launch_code = launch(attrs["cutlass_op_name"])
+
     has_bias = "bias" in attrs["op_type"]
     is_gelu = "gelu" in attrs["op_type"]
     batched = "batch_matmul" in attrs["op_type"]
 
-    aux_map = {"kernel": "Gemm"}
+    aux_map = {"kernel": "Gemm", "launch": launch_code}
 
     if has_bias:
         aux_map.update(
@@ -20,7 +20,7 @@ from functools import partial
 from .conv2d_operation import Conv2dOperation, EmitConv2dInstance
 from .gen_gemm import CutlassGemmProfiler
 from .conv2d_profiler import Conv2dProfilerEmitter
-from .gen_tensor_op import ProfilerEngine, GENERATOR_FUNC_TABLE, EPILOGUE_MAP
+from .gen_tensor_op import ProfilerEngine, TuningCache, GENERATOR_FUNC_TABLE, EPILOGUE_MAP
 from .library import (
     DataType,
     EpilogueFunctor,
@@ -174,14 +174,19 @@ def enumerate_conv2d_operators(
 
 
 class CutlassConv2DProfiler:
-    """Profile all candidate kernels and select the best one."""
+    """Profile all candidate kernels and select the best one.
 
-    def __init__(self, sm, cutlass_path, binary_path):
+    The selected kernels are cached in memory, and in the JSON file cache_path if given, see
+    TuningCache.
+    """
+
+    def __init__(self, sm, cutlass_path, binary_path, cache_path=None):
         self.gemm_profiler = CutlassGemmProfiler(sm, cutlass_path, binary_path)
         self.sm = sm
         assert sm in GENERATOR_FUNC_TABLE, f"sm{sm} not supported yet."
         self.engine = ProfilerEngine(sm, cutlass_path, binary_path)
         self.cache = {}
+        self.tuning_cache = TuningCache(cache_path)
 
     def get_default(
         self,
@@ -265,6 +270,21 @@ class CutlassConv2DProfiler:
         if workload in self.cache:
             return self.cache[workload]
 
+        cache_workload = (
+            ("conv2d", self.sm, conv_kind.name, stride_support.name)
+            + tuple(int(x) for x in workload)
+            + (
+                out_dtype,
+                data_dtype,
+                weight_dtype,
+                use_3xtf32,
+                ",".join(str(k) for k in split_k_slices),
+                profile_all_alignments,
+                find_first_valid,
+            )
+        )
+        record = self.tuning_cache.get(cache_workload)
+
         ops = GENERATOR_FUNC_TABLE[self.sm](
             out_dtype,
             data_dtype,
@@ -277,6 +297,14 @@ class CutlassConv2DProfiler:
             accumlator_dtype="float32" if conv_kind == ConvKind.Wgrad else out_dtype,
         )
 
+        if record is not None:
+            filtered = list(filter(lambda op: op["name"] == record["name"], ops))
+            if filtered:
+                op = filtered[0]
+                op["runtime"] = record["runtime"]
+                self.cache[workload] = op
+                return op
+
         if not find_first_valid:
             self.engine.compile_all(ops, use_multiprocessing)
 
@@ -289,11 +317,12 @@ class CutlassConv2DProfiler:
             out = self.engine.evaluate(op, args.split(" "))
             op["runtime"] = out
             if out < float("inf") and find_first_valid:
-                self.cache[workload] = op
-                return op
+                break
+        else:
+            op = min(ops, key=lambda i: i["runtime"])
 
-        op = min(ops, key=lambda i: i["runtime"])
         self.cache[workload] = op
+        self.tuning_cache.put(cache_workload, op["name"], op["runtime"])
         return op
 
     def profile(
@@ -18,7 +18,7 @@
 """GEMM kernel generator and profiler for CUTLASS."""
 from .gemm_operation import EmitGemmInstance, GemmOperation
 from .gemm_profiler import GemmProfilerEmitter
-from .gen_tensor_op import EPILOGUE_MAP, GENERATOR_FUNC_TABLE, ProfilerEngine
+from .gen_tensor_op import EPILOGUE_MAP, GENERATOR_FUNC_TABLE, ProfilerEngine, TuningCache
 from .library import (
     DataType,
     DataTypeTag,
@@ -146,13 +146,18 @@ DEFAULT_KERNELS = {
 
 
 class CutlassGemmProfiler:
-    """Profile all candidate kernels and select the best one."""
+    """Profile all candidate kernels and select the best one.
 
-    def __init__(self, sm, cutlass_path, binary_path):
+    The selected kernels are cached in memory, and in the JSON file cache_path if given, see
+    TuningCache.
+    """
+
+    def __init__(self, sm, cutlass_path, binary_path, cache_path=None):
         assert sm in GENERATOR_FUNC_TABLE and sm in DEFAULT_KERNELS, f"sm{sm} not supported yet."
         self.engine = ProfilerEngine(sm, cutlass_path, binary_path)
         self.sm = sm
         self.cache = {}
+        self.tuning_cache = TuningCache(cache_path)
 
     def get_default(
         self, op_type, out_dtype, arg0_dtype, arg1_dtype, use_3xtf32=True, batched=False
@@ -214,6 +219,21 @@ class CutlassGemmProfiler:
             op = self.cache[(M, N, K)]
             return op
 
+        workload = (
+            "gemm",
+            self.sm,
+            int(M),
+            int(N),
+            int(K),
+            out_dtype,
+            arg0_dtype,
+            arg1_dtype,
+            use_3xtf32,
+            profile_all_alignments,
+            find_first_valid,
+        )
+        record = self.tuning_cache.get(workload)
+
         # TODO(masahi): CUTLASS alignment check on gemm kernels is too restrictive.
         # See https://github.com/NVIDIA/cutlass/issues/362.
         # When the above issue is resolved, we can remove the alignment check on M below.
@@ -230,6 +250,14 @@ class CutlassGemmProfiler:
             accumlator_dtype=out_dtype,
         )
 
+        if record is not None:
+            filtered = list(filter(lambda op: op["name"] == record["name"], ops))
+            if filtered:
+                op = filtered[0]
+                op["runtime"] = record["runtime"]
+                self.cache[(M, N, K)] = op
+                return op
+
         if not find_first_valid:
             self.engine.compile_all(ops, use_multiprocessing)
 
@@ -237,11 +265,12 @@ class CutlassGemmProfiler:
             out = self.engine.evaluate(op, [M, N, K])
             op["runtime"] = out
             if out < float("inf") and find_first_valid:
-                self.cache[(M, N, K)] = op
-                return op
+                break
+        else:
+            op = min(ops, key=lambda i: i["runtime"])
 
-        op = min(ops, key=lambda i: i["runtime"])
         self.cache[(M, N, K)] = op
+        self.tuning_cache.put(workload, op["name"], op["runtime"])
         return op
 
     def profile(
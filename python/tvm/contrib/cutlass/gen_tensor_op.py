@@ -16,6 +16,7 @@
 # under the License.
 # pylint: disable=invalid-name
 """Common functions and classes for CUTLASS GEMM and Conv2d geneator."""
+import json
 import logging
 import os
 import re
@@ -424,6 +425,54 @@ class ProfilerEngine:
         return rt
 
 
+class TuningCache:
+    """A persistent cache of the kernels selected by profiling.
+
+    The records map a workload, i.e. the problem shape, the dtypes, the architecture and the
+    profiling options, to the name of the selected kernel and its runtime. They are stored in a
+    JSON file, so that the builds which use the same file, in the same or other processes, do not
+    profile the same workloads again. Without a path, the records are kept in memory only.
+    """
+
+    def __init__(self, path=None):
+        self.path = path
+        self.records = {}
+        if path and os.path.exists(path):
+            self.records = self._load()
+
+    def _load(self):
+        try:
+            with open(self.path) as f:
+                return json.load(f)
+        except (OSError, ValueError):
+            logger.warning("Ignoring the invalid CUTLASS tuning cache %s", self.path)
+            return {}
+
+    @staticmethod
+    def _key(workload):
+        return "/".join(str(x) for x in workload)
+
+    def get(self, workload):
+        """Return the record of a workload, or None if it was not profiled."""
+        return self.records.get(self._key(workload))
+
+    def put(self, workload, name, runtime):
+        """Record the kernel selected for a workload, and write the records to the file."""
+        self.records[self._key(workload)] = {"name": name, "runtime": runtime}
+        if not self.path:
+            return
+        # Merge the records written by other builds in the meantime.
+        if os.path.exists(self.path):
+            records = self._load()
+            records.update(self.records)
+            self.records = records
+        dirname = os.path.dirname(os.path.abspath(self.path))
+        os.makedirs(dirname, exist_ok=True)
+        with tempfile.NamedTemporaryFile("w", dir=dirname, delete=False, suffix=".json") as f:
+            json.dump(self.records, f, indent=1, sort_keys=True)
+        os.replace(f.name, self.path)
+
+
 class CodegenResult(Object):
     """The holder for the generated code and required headers."""
 
@@ -457,6 +506,14 @@ def instantiate_template(func_name, annotations, func_args):
         if k in annotations:
             attrs[k] = annotations[k]
 
+    if "cutlass_op_bucket_names" in annotations:
+        attrs["op_buckets"] = [
+            (str(name), int(bound))
+            for name, bound in zip(
+                annotations["cutlass_op_bucket_names"], annotations["cutlass_op_bucket_bounds"]
+            )
+        ]
+
     arg0_shape = annotations["arg0_shape"]
     arg1_shape = annotations["arg1_shape"]
     attrs["ElementInputA"] = DataTypeTag[dtype_map[annotations["arg0_dtype"]]]
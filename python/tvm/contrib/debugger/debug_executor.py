@@ -115,6 +115,7 @@ class GraphModuleDebug(graph_executor.GraphModule):
         self._dump_path = None
         self._run_individual = module["run_individual"]
         self._run_individual_node = module["run_individual_node"]
+        self._run_pipelined = module["run_pipelined"]
         self._debug_get_output = module["debug_get_output"]
         self._execute_node = module["execute_node"]
         self._get_node_output = module["get_node_output"]
@@ -412,6 +413,39 @@ class GraphModuleDebug(graph_executor.GraphModule):
             results.append([*ret])
         return results
 
+    def run_pipelined(self, number=10, warmup=1):
+        """Run the whole graph and get the time of each op in each run.
+
+        Unlike `run_individual`, the ops of a run are issued back to back and the device is only
+        synchronized once per run, so the measurement does not stall the device between the ops.
+        The time of each op is measured by the timer of the device, e.g. by events on the stream
+        of a GPU; on the devices without a timer, each op is still synchronized.
+
+        Parameters
+        ----------
+        number: int, optional
+            The number of runs to measure.
+
+        warmup: int, optional
+            The number of runs executed before the measurement, and discarded.
+
+        Returns
+        -------
+        A list of module BenchmarkResult, one per node, holding the time of the node in each run.
+        """
+        res = self._run_pipelined(number, warmup)
+        results = []
+        offset = 0
+        format_size = "@q"
+        (nodes_count,) = struct.unpack_from(format_size, res, offset)
+        offset += struct.calcsize(format_size)
+        format_data = "@" + number * "d"
+        for _ in range(0, nodes_count):
+            ret = struct.unpack_from(format_data, res, offset)
+            offset += struct.calcsize(format_data)
+            results.append(BenchmarkResult(list(ret)))
+        return results
+
     def run_individual_node(
         self,
         index,
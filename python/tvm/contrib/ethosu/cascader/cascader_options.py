@@ -55,6 +55,9 @@ class CascaderOptions(Object):
         Disable culling of block configs.
     enable_striping : bool
         A boolean option to enable striping
+    plan_time_budget : float
+        The time in seconds after which the Plan search stops growing cascades and plans the
+        remaining Parts on their own, keeping the best Plans found so far. 0 for no limit.
 
     """
 
@@ -72,6 +75,7 @@ class CascaderOptions(Object):
         enable_multi_dimensional_striping: bool = False,
         disable_block_culling: bool = True,
         enable_striping: bool = False,
+        plan_time_budget: float = 0.0,
     ):
         self.__init_handle_by_constructor__(
             _ffi_api.CascaderOptions,
@@ -87,4 +91,5 @@ class CascaderOptions(Object):
             enable_multi_dimensional_striping,
             disable_block_culling,
             enable_striping,
+            plan_time_budget,
         )
@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 """Minimum graph executor that executes graph containing TVM PackedFunc."""
+import ctypes
+
 import numpy as np
 import tvm._ffi
 
@@ -22,6 +24,7 @@ from tvm.rpc import _ffi_api as _rpc_ffi_api
 from tvm.rpc import base as rpc_base
 from tvm._ffi.base import string_types
 from tvm._ffi.runtime_ctypes import Device
+from tvm.runtime.executor.async_run import submit
 
 
 def create(graph_json_str, libmod, device):
@@ -29,8 +32,9 @@ def create(graph_json_str, libmod, device):
 
     Parameters
     ----------
-    graph_json_str : str
-        The graph to be deployed in json format output by json graph.
+    graph_json_str : str or bytearray
+        The graph to be deployed in json format output by json graph,
+        or in the binary graph format.
         The graph can contain operator(tvm_op) that points to the name
         of PackedFunc in the libmod.
 
@@ -54,7 +58,7 @@ def create(graph_json_str, libmod, device):
     for examples to directly construct a GraphModule from an exported
     relay compiled library.
     """
-    assert isinstance(graph_json_str, string_types)
+    assert isinstance(graph_json_str, (string_types, bytes, bytearray))
 
     dev, num_rpc_dev, device_type_id = get_device(libmod, device)
 
@@ -263,6 +267,50 @@ class GraphModule(object):
             self.set_input(**input_dict)
         self._run()
 
+    def warmup(self):
+        """Do the lazy initialization of the kernels, e.g. loading the device modules, without
+        running the graph, so that the first run is not slowed down by it.
+        """
+        self.module["warmup"]()
+
+    def run_async(self, **input_dict):
+        """Run forward execution of the graph asynchronously.
+
+        The runs of the executor execute one after the other on a small pool of host
+        threads, on a stream of their own on a GPU, so that the calling thread is not
+        blocked. The executor must not be used synchronously while runs are pending.
+
+        Parameters
+        ----------
+        input_dict: dict of str to NDArray
+            List of input values to be feed to
+
+        Returns
+        -------
+        future : concurrent.futures.Future
+            The future of the list of outputs, copied out of the executor.
+        """
+        args = []
+        for key, value in input_dict.items():
+            if not isinstance(value, tvm.runtime.NDArray):
+                value = tvm.nd.array(value)
+            args += [key, value]
+        return submit(self.module["run_async"], *args, convert=list)
+
+    def run_on_stream(self, stream):
+        """Run forward execution of the graph on a given GPU stream.
+
+        The operators are issued to the stream instead of the current stream of the
+        device, so that a consumer of the outputs, or producer of the inputs, working
+        on the same stream is ordered with the graph without synchronizing the host.
+
+        Parameters
+        ----------
+        stream : int
+            The handle of the stream, e.g. torch.cuda.current_stream().cuda_stream.
+        """
+        self.module["run_on_stream"](ctypes.c_void_p(stream))
+
     def get_num_outputs(self):
         """Get the number of outputs from the graph
 
@@ -381,6 +429,23 @@ class GraphModule(object):
         """
         self._load_params(bytearray(params_bytes))
 
+    def load_params_from_file(self, path, lazy=False):
+        """Load parameters from a file of serialized parameter dict.
+
+        The tensors are streamed into the graph one at a time, so the file is never
+        held in memory as a whole. float32 parameters of float16 or bfloat16 inputs, and
+        the converse, are converted while they are loaded.
+
+        Parameters
+        ----------
+        path : str
+            The path of a file written by :py:func:`tvm.runtime.save_param_dict`.
+
+        lazy : bool
+            Only read the index of the file now, the parameters are read at the first run.
+        """
+        self.module["load_params_from_file"](path, lazy)
+
     def share_params(self, other, params_bytes):
         """Share parameters from pre-existing GraphExecutor instance.
 
@@ -394,6 +459,83 @@ class GraphModule(object):
         """
         self._share_params(other.module, bytearray(params_bytes))
 
+    def set_thread_pool(self, name):
+        """Run the operators on a named thread pool.
+
+        Parameters
+        ----------
+        name : str
+            The name of a pool created by :py:func:`tvm.runtime.create_thread_pool`,
+            an empty string restores the default thread pool.
+        """
+        self.module["set_thread_pool"](name)
+
+    def set_inter_op_threads(self, num_threads):
+        """Run independent operators of the graph concurrently.
+
+        Each inter-op thread runs the parallel loops of its operators on its own share of
+        the cores, so the threads do not oversubscribe them.
+
+        Parameters
+        ----------
+        num_threads : int
+            The number of operators run at the same time, 1 runs them one by one.
+        """
+        self.module["set_inter_op_threads"](num_threads)
+
+    def set_num_streams(self, num_streams):
+        """Run independent operators of the graph on several GPU streams.
+
+        Operators are assigned to streams following the critical path of the graph, and
+        streams wait on each other where the graph crosses them. Under CUDA graph capture
+        the schedule is recorded into the captured graph.
+
+        Parameters
+        ----------
+        num_streams : int
+            The number of streams, 1 runs every operator on the current stream.
+        """
+        self.module["set_num_streams"](num_streams)
+
+    def set_weight_prefetch(self, max_region_bytes):
+        """Prefetch the parameters of the next operator into VTCM while the current one runs.
+
+        Hexagon only. Two VTCM regions are used in turn, and the operators read the VTCM
+        copies of their parameters. Parameters not fitting a region stay in DDR.
+
+        Parameters
+        ----------
+        max_region_bytes : int
+            The size bound of each of the two VTCM regions, 0 turns prefetch off.
+        """
+        self.module["set_weight_prefetch"](max_region_bytes)
+
+    def set_sampling_interval(self, interval):
+        """Time the operators of every Nth run with the device timers.
+
+        Unlike the debug executor, the operators are not synchronized one by one, so sampling
+        can stay on while serving. Only runs executing the operators one by one on the
+        current stream are sampled. Setting the interval drops the samples so far.
+
+        Parameters
+        ----------
+        interval : int
+            Sample every ``interval``-th run, 0 turns sampling off.
+        """
+        self.module["set_sampling_interval"](interval)
+
+    def get_sampled_profile(self):
+        """Get the latencies of the sampled operators.
+
+        Returns
+        -------
+        report : tvm.runtime.profiling.Report
+            A call for every operator with its number of samples, its mean latency and
+            its ``p50 (us)``, ``p90 (us)`` and ``p99 (us)`` latency percentiles over the
+            latest samples.
+        """
+        return self.module["get_sampled_profile"]()
+
     def __getitem__(self, key):
         """Get internal module function
 
@@ -512,3 +654,76 @@ class GraphModule(object):
             cooldown_interval_ms=cooldown_interval_ms,
             repeats_to_cooldown=repeats_to_cooldown,
         )()
+
+
+class GraphModulePool(object):
+    """A bounded pool of replicas of a graph executor.
+
+    The replicas share the graph, the compiled code and the parameters of the
+    base module, each one only allocates the storage of its activations. Use
+    one replica per concurrent request.
+
+    Parameters
+    ----------
+    base : GraphModule
+        The module to replicate, with its parameters loaded.
+
+    max_size : int
+        The maximum number of replicas, checkout blocks while they are all in use.
+
+    Examples
+    --------
+
+    .. code-block:: python
+
+        pool = graph_executor.GraphModulePool(base, max_size=8)
+        with pool.replica() as mod:
+            mod.set_input("x", data)
+            mod.run()
+            out = mod.get_output(0).numpy()
+    """
+
+    def __init__(self, base, max_size):
+        fcreate = tvm._ffi.get_global_func("tvm.graph_executor.create_pool")
+        self.module = fcreate(base.module, max_size)
+        self._checkout = self.module["checkout"]
+        self._return = self.module["return"]
+
+    def checkout(self):
+        """Take an idle replica from the pool, it must be given back with checkin.
+
+        Returns
+        -------
+        replica : GraphModule
+            The replica.
+        """
+        return GraphModule(self._checkout())
+
+    def checkin(self, replica):
+        """Give a replica obtained from checkout back to the pool.
+
+        Parameters
+        ----------
+        replica : GraphModule
+            The replica.
+        """
+        self._return(replica.module)
+
+    def replica(self):
+        """Check out a replica for the duration of a with statement."""
+        pool = self
+
+        class _Scope(object):
+            def __enter__(self):
+                self.replica = pool.checkout()
+                return self.replica
+
+            def __exit__(self, ptype, value, trace):
+                pool.checkin(self.replica)
+
+        return _Scope()
+
+    @property
+    def num_replicas(self):
+        """The number of replicas created so far."""
+        return self.module["num_replicas"]()
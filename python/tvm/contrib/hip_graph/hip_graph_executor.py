@@ -0,0 +1,140 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Graph executor with HIP Graph"""
+import tvm._ffi
+
+from tvm._ffi.base import string_types
+from tvm.contrib import graph_executor
+
+
+def create(graph_json_str, libmod, device):
+    """Create a runtime executor module given a graph and module.
+
+    Parameters
+    ----------
+    graph_json_str : str
+        The graph to be deployed in json format output by json graph.
+        The graph can contain operator(tvm_op) that points to the name
+        of PackedFunc in the libmod.
+
+    libmod : tvm.runtime.Module
+        The module of the corresponding function
+
+    device : Device
+        The device to deploy the module, only supports ROCm GPU
+
+    Returns
+    -------
+    graph_module : GraphModuleHipGraph
+        HIP graph executor module that can be used to execute the graph.
+    """
+    assert isinstance(graph_json_str, string_types)
+    try:
+        dev, num_rpc_dev, device_type_id = graph_executor.get_device(libmod, device)
+        if num_rpc_dev == len(dev):
+            fcreate = dev[0]._rpc_sess.get_function("tvm.graph_executor_hip_graph.create")
+        else:
+            fcreate = tvm._ffi.get_global_func("tvm.graph_executor_hip_graph.create")
+    except ValueError:
+        raise ValueError(
+            "To enable HIP graph support (experimental), please set "
+            "'(USE_GRAPH_EXECUTOR_HIP_GRAPH ON)' in config.cmake and rebuild TVM"
+        )
+
+    return GraphModuleHipGraph(fcreate(graph_json_str, libmod, *device_type_id))
+
+
+class GraphModuleHipGraph(graph_executor.GraphModule):
+    """HIP graph executor module.
+
+    This is the ROCm counterpart of
+    :py:class:`tvm.contrib.cuda_graph.cuda_graph_executor.GraphModuleCudaGraph`,
+    launching the captured graph instead of each kernel.
+
+    Parameters
+    ----------
+    module : Module
+        The internal tvm module that holds the actual graph functions.
+    """
+
+    def __init__(self, module):
+        self._start_capture = module["start_capture"]
+        self._end_capture = module["end_capture"]
+        self._run_hip_graph = module["run_hip_graph"]
+        self._set_hip_graph_cache_size = module["set_hip_graph_cache_size"]
+        self._hip_graph_captured = False
+        graph_executor.GraphModule.__init__(self, module)
+
+    def capture_hip_graph(self):
+        """Capture a HIP graph for tvm_op graph
+
+        This should be called before run_hip_graph() to capture and
+        instantiate a HIP graph instance.
+        """
+        self._run()  # load the code objects before capturing
+        self._start_capture()
+        self._run()
+        self._end_capture()
+        self._hip_graph_captured = True
+
+    def run_hip_graph(self):
+        """Run the HIP graph for tvm_op graph
+
+        Inputs and outputs rebound with set_input_zero_copy or
+        set_output_zero_copy are picked up by capturing again,
+        or from the cache of graphs when the binding was seen before.
+        """
+        self._run_hip_graph()
+
+    def set_hip_graph_cache_size(self, size):
+        """Set how many instantiated HIP graphs are kept
+
+        Parameters
+        ----------
+        size : int
+            The maximum number of instantiated graphs, 4 by default.
+        """
+        self._set_hip_graph_cache_size(size)
+
+    def run(self, **input_dict):
+        """Run the graph, capturing a HIP graph on the first call and
+        launching it afterwards
+
+        Parameters
+        ----------
+        input_dict: dict of str to NDArray
+            List of input values to be feed to
+        """
+        if input_dict:
+            self.set_input(**input_dict)
+        if not self._hip_graph_captured:
+            self.capture_hip_graph()
+        else:
+            self._run_hip_graph()
+
+    def debug_get_output(self, node, out):
+        """Run graph up to node and get the output to out
+
+        Parameters
+        ----------
+        node : int / str
+            The node index or name
+
+        out : NDArray
+            The output array container
+        """
+        raise NotImplementedError("Please use debugger.debug_executor as graph_executor instead.")
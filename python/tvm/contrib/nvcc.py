@@ -64,6 +64,9 @@ def compile_cuda(code, target_format="ptx", arch=None, options=None, path_target
         compute_version = "".join(
             get_target_compute_version(Target.current(allow_none=True)).split(".")
         )
+        if compute_version == "90":
+            # The wgmma and the other arch specific features of Hopper need sm_90a.
+            compute_version = "90a"
         arch = ["-gencode", f"arch=compute_{compute_version},code=sm_{compute_version}"]
 
     temp = utils.tempdir()
@@ -185,8 +188,20 @@ def get_cuda_version(cuda_path=None):
 
 @tvm._ffi.register_func
 def tvm_callback_cuda_compile(code, target):  # pylint: disable=unused-argument
-    """use nvcc to generate fatbin code for better optimization"""
-    ptx = compile_cuda(code, target_format="fatbin")
+    """use nvcc to generate fatbin code for better optimization
+
+    When the ``cuda.sass_archs`` option of the PassContext lists SASS architectures, e.g.
+    ``["sm_80", "sm_86"]``, the fatbin embeds the cubin of each of them.
+    """
+    arch = None
+    sass_archs = tvm.transform.PassContext.current().config.get("cuda.sass_archs", None)
+    if sass_archs:
+        arch = []
+        for sass_arch in sass_archs:
+            if not sass_arch.startswith("sm_"):
+                raise ValueError(f"Expect a SASS architecture such as sm_80, got {sass_arch}")
+            arch += ["-gencode", f"arch=compute_{sass_arch[3:]},code={sass_arch}"]
+    ptx = compile_cuda(code, target_format="fatbin", arch=arch)
     return ptx
 
 
@@ -275,7 +290,8 @@ def get_target_compute_version(target=None):
     # 2. Target.current()
     target = target or Target.current()
     if target and target.arch:
-        major, minor = target.arch.split("_")[1]
+        # Drop the suffix of the arch specific targets, e.g. sm_90a.
+        major, minor = target.arch.split("_")[1].rstrip("a")
         return major + "." + minor
 
     # 3. GPU compute version
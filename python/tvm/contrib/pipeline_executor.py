@@ -59,6 +59,9 @@ class PipelineModule(object):
         self._get_num_inputs = self.module["get_num_inputs"]
         self._get_input_pipeline_map = self.module["get_input_pipeline_map"]
         self._get_pipe_execute_count = self.module["get_execute_count"]
+        self._get_statistics = self.module["get_statistics"]
+        self._start_profiling = self.module["start_profiling"]
+        self._stop_profiling = self.module["stop_profiling"]
 
     def run(self):
         """Run the pipeline executor."""
@@ -163,6 +166,35 @@ class PipelineModule(object):
         """
         return self._get_pipe_execute_count()
 
+    def get_statistics(self):
+        """Get the scheduling counters of every module of the pipeline.
+
+        Returns
+        -------
+        statistics : List[dict]
+            For each module: the number of runs and of requests, the average micro-batch size,
+            the average run latency, the time spent waiting for its children to free a slot
+            of their queues, and the occupancy and the capacity of its input queues as
+            ``[input_index, occupancy, capacity]`` triples.
+        """
+        return json.loads(self._get_statistics())
+
+    def start_profiling(self):
+        """Start recording every run of every module of the pipeline."""
+        self._start_profiling()
+
+    def stop_profiling(self):
+        """Stop recording the runs.
+
+        Returns
+        -------
+        report : tvm.runtime.profiling.Report
+            A call for every run since :py:meth:`start_profiling`. In the timeline of
+            :py:meth:`tvm.runtime.profiling.Report.chrome_trace` the runs of module ``i`` are
+            on the thread ``i + 1``.
+        """
+        return self._stop_profiling()
+
     @property
     def num_outputs(self):
         """Get the number of outputs.
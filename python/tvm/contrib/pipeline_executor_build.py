@@ -418,6 +418,11 @@ class PipelineConfig(object):
             self.dev = None
             self.export_cc = None
             self.cpu_affinity = ""
+            # The most requests coalesced into one run, the module has to be built with a
+            # first axis holding that many requests on every input and output.
+            self.micro_batch = 1
+            # The most requests waiting in each input queue, 0 for the default.
+            self.queue_capacity = 0
             self.idx = None
             self.mod = mod
             self.input_params = InferType()(mod)["main"].params
@@ -594,6 +599,8 @@ class PipelineConfig(object):
 
             mconf["mod_idx"] = module.idx
             mconf["cpu_affinity"] = module.cpu_affinity
+            mconf["micro_batch"] = module.micro_batch
+            mconf["queue_capacity"] = module.queue_capacity
             mconf["output"] = output_conf
 
             module_connection[mod] = {
@@ -0,0 +1,408 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Automatic partitioning of a Relay module into balanced pipeline executor stages.
+
+The operators of the module are laid out in topological order and cut into one contiguous
+segment per device. The cuts minimize the steady-state bottleneck of the pipeline, that is the
+slowest stage, where the time of a stage is the profiled time of its operators plus the time
+of copying its inputs from the stages before it on other devices.
+"""
+import functools
+import re
+
+import numpy as np
+
+import tvm
+from tvm import relay
+from tvm.contrib import pipeline_executor_build
+from tvm.contrib.debugger import debug_executor
+from tvm.relay.build_module import bind_params_by_name
+
+
+class PipelinePartition(object):
+    """The result of :py:func:`partition`.
+
+    Attributes
+    ----------
+    config : PipelineConfig
+        The pipeline configuration, ready for :py:func:`pipeline_executor_build.build`.
+
+    stages : List[tvm.IRModule]
+        The module of every stage, in pipeline order.
+
+    stage_costs : List[float]
+        The estimated time of every stage in microseconds, transfers included.
+
+    bottleneck : float
+        The estimated time of the slowest stage in microseconds, which bounds the throughput.
+    """
+
+    def __init__(self, config, stages, stage_costs):
+        self.config = config
+        self.stages = stages
+        self.stage_costs = stage_costs
+        self.bottleneck = max(stage_costs)
+
+
+def _same_device(dev_a, dev_b):
+    return dev_a.device_type == dev_b.device_type and dev_a.device_id == dev_b.device_id
+
+
+def _tensor_bytes(checked_type):
+    """The size of a tensor typed value, or None when the value is not a static tensor."""
+    if not isinstance(checked_type, relay.TensorType):
+        return None
+    shape = [int(dim) if isinstance(dim, tvm.tir.IntImm) else None for dim in checked_type.shape]
+    if None in shape:
+        return None
+    return int(np.prod(shape)) * tvm.runtime.DataType(checked_type.dtype).bits // 8
+
+
+def _arguments(expr):
+    if isinstance(expr, relay.Call):
+        return list(expr.args)
+    if isinstance(expr, relay.Tuple):
+        return list(expr.fields)
+    if isinstance(expr, relay.TupleGetItem):
+        return [expr.tuple_value]
+    return []
+
+
+class _Dataflow(object):
+    """The operators of a function in topological order, with their producers and consumers."""
+
+    def __init__(self, func):
+        self.func = func
+        body = func.body
+        # The values the function returns, they become the pipeline outputs.
+        self.results = list(body.fields) if isinstance(body, relay.Tuple) else [body]
+        self.nodes = []
+
+        def visit(expr):
+            if isinstance(expr, (relay.Call, relay.TupleGetItem)) or (
+                isinstance(expr, relay.Tuple) and not expr.same_as(body)
+            ):
+                if isinstance(expr, relay.Call) and not isinstance(expr.op, tvm.ir.Op):
+                    raise ValueError(f"Only calls to operators can be partitioned, not {expr.op}")
+                self.nodes.append(expr)
+
+        relay.analysis.post_order_visit(body, visit)
+        self.index = {node: i for i, node in enumerate(self.nodes)}
+        for result in self.results:
+            if result not in self.index:
+                raise ValueError("Every result of the function must be computed by an operator")
+        self.params = list(func.params)
+        # The indices of the nodes consuming every node and every parameter.
+        self.consumers = {value: [] for value in self.nodes + self.params}
+        for i, node in enumerate(self.nodes):
+            for arg in _arguments(node):
+                if arg in self.consumers:
+                    self.consumers[arg].append(i)
+
+    def producer(self, value):
+        """The index of the node computing a value, -1 for a parameter."""
+        return self.index.get(value, -1)
+
+
+def _normalize_kernel_name(name):
+    name = re.sub(r"^tvmgen_\w*?_fused_", "", name)
+    return re.sub(r"_\d+$", "", name)
+
+
+def _profile_costs(dataflow, target, dev, number):
+    """Profile the operators of the function on a device, in microseconds per node.
+
+    Every operator is compiled on its own and timed by the debug executor. The kernels are then
+    matched to the operators in order by name, kernels introduced by the compiler are charged to
+    the operator before them.
+    """
+    mod = tvm.IRModule.from_expr(dataflow.func)
+    with tvm.transform.PassContext(opt_level=3, config={"relay.FuseOps.max_depth": 1}):
+        lib = relay.build(mod, target=target)
+    gmod = debug_executor.create(lib.get_graph_json(), lib.lib, dev)
+    for param in dataflow.params:
+        ttype = param.checked_type
+        shape = [int(dim) for dim in ttype.shape]
+        data = np.random.uniform(size=shape).astype(ttype.dtype)
+        gmod.set_input(param.name_hint, data)
+    durations = None
+    names = None
+    for _ in range(number):
+        calls = gmod.profile().calls
+        times = [call["Duration (us)"].microseconds for call in calls]
+        durations = times if durations is None else [a + b for a, b in zip(durations, times)]
+        names = [str(call["Name"]) for call in calls]
+    gmod.exit()
+
+    costs = [0.0] * len(dataflow.nodes)
+    keys = [
+        node.op.name.replace(".", "_") if isinstance(node, relay.Call) else None
+        for node in dataflow.nodes
+    ]
+    cursor = 0
+    for name, duration in zip(names, durations):
+        kernel = _normalize_kernel_name(name)
+        match = next(
+            (i for i in range(cursor, len(keys)) if keys[i] and kernel.startswith(keys[i])), None
+        )
+        if match is not None:
+            cursor = match + 1
+        costs[max(cursor - 1, 0)] += duration / number
+    return costs
+
+
+def _solve(costs, transfer, num_stages):
+    """Cut the nodes into contiguous stages minimizing the slowest stage.
+
+    Parameters
+    ----------
+    costs : List[List[float]]
+        The time of every node on the device of every stage.
+
+    transfer : Callable[[int, int, int], float]
+        ``transfer(stage, begin, end)`` is the time of copying the inputs of the stage covering
+        nodes ``[begin, end)`` from the stages before it, infinity when the cut is not possible.
+
+    num_stages : int
+        The number of stages.
+
+    Returns
+    -------
+    bounds : List[int]
+        The first node of every stage followed by the number of nodes.
+    """
+    num_nodes = len(costs[0])
+    if num_nodes < num_stages:
+        raise ValueError(f"Can not cut {num_nodes} operators into {num_stages} stages")
+    prefix = [np.concatenate([[0.0], np.cumsum(stage_costs)]) for stage_costs in costs]
+    inf = float("inf")
+    # best[k][j] is the bottleneck of cutting the first j nodes into k + 1 stages.
+    best = [[inf] * (num_nodes + 1) for _ in range(num_stages)]
+    choice = [[0] * (num_nodes + 1) for _ in range(num_stages)]
+    for j in range(1, num_nodes + 1):
+        best[0][j] = prefix[0][j]
+    for k in range(1, num_stages):
+        for j in range(k + 1, num_nodes + 1):
+            for i in range(k, j):
+                if best[k - 1][i] == inf:
+                    continue
+                cost = max(best[k - 1][i], prefix[k][j] - prefix[k][i] + transfer(k, i, j))
+                if cost < best[k][j]:
+                    best[k][j] = cost
+                    choice[k][j] = i
+    if best[num_stages - 1][num_nodes] == inf:
+        raise ValueError("No cut of the module lets only tensors cross the stages")
+    bounds = [num_nodes]
+    for k in range(num_stages - 1, 0, -1):
+        bounds.append(choice[k][bounds[-1]])
+    bounds.append(0)
+    return bounds[::-1]
+
+
+def _build_stage(dataflow, begin, end):
+    """Extract the nodes [begin, end) into a function.
+
+    Returns the function, the values it takes as inputs by input name, and the values it
+    returns in output order.
+    """
+    memo = {}
+    inputs = {}
+
+    def input_var(value, name):
+        if value not in memo:
+            memo[value] = relay.var(name, value.checked_type)
+            inputs[name] = value
+        return memo[value]
+
+    def rebuild(expr):
+        if expr in memo:
+            return memo[expr]
+        if isinstance(expr, relay.Var):
+            return input_var(expr, expr.name_hint)
+        if isinstance(expr, relay.Constant):
+            return expr
+        index = dataflow.index[expr]
+        if index < begin:
+            return input_var(expr, f"data_n_{index}")
+        args = [rebuild(arg) for arg in _arguments(expr)]
+        if isinstance(expr, relay.Call):
+            new_expr = relay.Call(expr.op, args, expr.attrs, expr.type_args, expr.span)
+        elif isinstance(expr, relay.Tuple):
+            new_expr = relay.Tuple(args)
+        else:
+            new_expr = relay.TupleGetItem(args[0], expr.index)
+        memo[expr] = new_expr
+        return new_expr
+
+    for node in dataflow.nodes[begin:end]:
+        rebuild(node)
+    outputs = []
+    for value in list(dataflow.nodes[begin:end]) + dataflow.params:
+        consumers = dataflow.consumers[value]
+        if isinstance(value, relay.Var):
+            # An input of the module is passed on by the stage using it first.
+            if not consumers or not begin <= min(consumers) < end:
+                continue
+        if any(i >= end for i in consumers) or value in dataflow.results:
+            outputs.append(value)
+    if not outputs:
+        raise ValueError(f"The stage of operators [{begin}, {end}) computes nothing used")
+    # A parameter passed on to later stages is forwarded by a copy, as a global input only
+    # feeds one stage.
+    fields = [memo[v] if not isinstance(v, relay.Var) else relay.copy(memo[v]) for v in outputs]
+    body = relay.Tuple(fields) if len(fields) > 1 else fields[0]
+    func = relay.Function([memo[value] for value in inputs.values()], body)
+    return func, inputs, outputs
+
+
+def partition(
+    mod,
+    devices,
+    params=None,
+    transfer_bandwidth=8e9,
+    cost_model=None,
+    number=3,
+):
+    """Partition a Relay module into balanced pipeline stages, one per device.
+
+    Parameters
+    ----------
+    mod : tvm.IRModule
+        The module, its main function is a dataflow graph of operators over tensors.
+
+    devices : List[Tuple[Union[str, Target], Device]]
+        The target and the device of every stage, in pipeline order. A device may appear more
+        than once, stages on one device hand their tensors over without copying them.
+
+    params : Optional[Dict[str, NDArray]]
+        The parameters, bound into the stages as constants.
+
+    transfer_bandwidth : float
+        The bandwidth of copies between different devices in bytes per second.
+
+    cost_model : Optional[Callable[[relay.Expr, Tuple[Target, Device]], float]]
+        Estimating the time of an operator on a device in microseconds. By default every
+        operator is profiled on every distinct device.
+
+    number : int
+        The number of profiled runs the operator times are averaged over.
+
+    Returns
+    -------
+    partition : PipelinePartition
+        The stages, their estimated times and the pipeline configuration connecting them.
+    """
+    func = mod["main"]
+    if params:
+        func = bind_params_by_name(func, params)
+    func = relay.transform.InferType()(tvm.IRModule.from_expr(func))["main"]
+    dataflow = _Dataflow(func)
+    if len(set(param.name_hint for param in dataflow.params)) != len(dataflow.params):
+        raise ValueError("The inputs of the module must have distinct names")
+
+    # The time of every node on the device of every stage.
+    device_costs = {}
+    costs = []
+    for target, dev in devices:
+        key = (str(target), dev.device_type, dev.device_id)
+        if key not in device_costs:
+            if cost_model is not None:
+                device_costs[key] = [cost_model(node, (target, dev)) for node in dataflow.nodes]
+            else:
+                device_costs[key] = _profile_costs(dataflow, target, dev, number)
+        costs.append(device_costs[key])
+
+    # For every value used by an operator: the node computing it, -1 for an input, and the
+    # nodes using it in order.
+    uses = [
+        (dataflow.producer(value), sorted(consumers), value)
+        for value, consumers in dataflow.consumers.items()
+        if consumers
+    ]
+
+    def source_node(producer, consumers):
+        # An input of the module is passed on by the stage using it first.
+        return producer if producer >= 0 else consumers[0]
+
+    @functools.lru_cache(maxsize=None)
+    def crossing_bytes(begin, end):
+        """The size of the values the stage covering nodes [begin, end) takes from the stages
+        before it, None when one of them is not a tensor."""
+        nbytes = 0
+        for producer, consumers, value in uses:
+            if source_node(producer, consumers) < begin and any(
+                begin <= i < end for i in consumers
+            ):
+                value_bytes = _tensor_bytes(value.checked_type)
+                if value_bytes is None:
+                    return None
+                nbytes += value_bytes
+        return nbytes
+
+    def estimate_transfer(stage, begin, end):
+        nbytes = crossing_bytes(begin, end)
+        if nbytes is None:
+            return float("inf")
+        # The stages are not known yet, assume the inputs come from the previous stage.
+        if _same_device(devices[stage - 1][1], devices[stage][1]):
+            return 0.0
+        return nbytes / transfer_bandwidth * 1e6
+
+    bounds = _solve(costs, estimate_transfer, len(devices))
+
+    def stage_of(node):
+        return next(k for k in range(len(devices)) if bounds[k] <= node < bounds[k + 1])
+
+    stages = []
+    infos = []
+    stage_costs = []
+    for k in range(len(devices)):
+        begin, end = bounds[k], bounds[k + 1]
+        stage_func, inputs, outputs = _build_stage(dataflow, begin, end)
+        stages.append(tvm.IRModule.from_expr(stage_func))
+        infos.append((inputs, outputs))
+        seconds = 0.0
+        for producer, consumers, value in uses:
+            source = source_node(producer, consumers)
+            if source >= begin or not any(begin <= i < end for i in consumers):
+                continue
+            if not _same_device(devices[stage_of(source)][1], devices[k][1]):
+                seconds += _tensor_bytes(value.checked_type) / transfer_bandwidth
+        stage_costs.append(float(sum(costs[k][begin:end])) + seconds * 1e6)
+
+    config = pipeline_executor_build.PipelineConfig()
+    producer_of = {}
+    for k, (_, outputs) in enumerate(infos):
+        for output_idx, value in enumerate(outputs):
+            producer_of.setdefault(value, (k, output_idx))
+    for k, (inputs, _) in enumerate(infos):
+        stage_mod = stages[k]
+        target, dev = devices[k]
+        config[stage_mod].target = target
+        config[stage_mod].dev = dev
+        for name, value in inputs.items():
+            if value in producer_of and producer_of[value][0] < k:
+                source, output_idx = producer_of[value]
+                config[stages[source]]["output"][output_idx].connect(
+                    config[stage_mod]["input"][name]
+                )
+            else:
+                config["input"][name].connect(config[stage_mod]["input"][name])
+    for result_idx, result in enumerate(dataflow.results):
+        source, output_idx = producer_of[result]
+        config[stages[source]]["output"][output_idx].connect(config["output"][str(result_idx)])
+    return PipelinePartition(config, stages, stage_costs)
@@ -25,7 +25,7 @@ import tvm.tir
 
 from tvm import te
 
-from tvm.runtime import Module
+from tvm.runtime import Module, Object
 from tvm.runtime import ndarray
 from tvm.ir import container
 from tvm.tir import PrimFunc
@@ -39,6 +39,20 @@ from tvm.driver import _ffi_api as _driver_ffi
 from . import _ffi_api as ffi
 
 
+@tvm._ffi.register_object("driver.BuildCache")
+class BuildCache(Object):
+    """A cache of the lowered and generated modules of :any:`build`, reused by a later build.
+
+    Each PrimFunc of a module is lowered on its own and reused while it, the targets and the
+    pass configuration are structurally unchanged, so that rebuilding after editing one function
+    lowers only that function. The code of a target is generated again when any of its functions
+    changed. The cache lives in memory and is safe to share across threads.
+    """
+
+    def __init__(self):
+        self.__init_handle_by_constructor__(_driver_ffi.BuildCache)
+
+
 def get_binds(args, compact=False, binds=None):
     """Internal function to get binds and arg_list given arguments.
     Parameters
@@ -147,6 +161,7 @@ def build(
     ] = None,  # Type is annotated this way to avoid cyclic dependency
     name: Optional[str] = "default_function",
     binds: Optional[Mapping[tensor.Tensor, Buffer]] = None,
+    build_cache: Optional[BuildCache] = None,
 ):
     """Build a function with arguments as signature. Code will be generated
     for devices coupled with target information.
@@ -181,6 +196,9 @@ def build(
         Dictionary that maps the binding of symbolic buffer to Tensor.
         By default, a new buffer is created for each tensor in the argument.
 
+    build_cache : Optional[BuildCache]
+        The cache to reuse the unchanged functions of a previous build from.
+
     Returns
     -------
     ret : tvm.module
@@ -278,7 +296,7 @@ def build(
 
     annotated_mods, target_host = Target.canon_target_map_and_host(annotated_mods, target_host)
 
-    rt_mod_host = _driver_ffi.tir_to_runtime(annotated_mods, target_host)
+    rt_mod_host = _driver_ffi.tir_to_runtime(annotated_mods, target_host, build_cache)
 
     annotated_mods, target_host = Target.canon_target_map_and_host(annotated_mods, target_host)
 
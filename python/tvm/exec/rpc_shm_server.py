@@ -0,0 +1,39 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=protected-access
+"""Serve an RPC client on the same host through shared memory.
+
+Started by tvm.rpc.ShmSession, with the file descriptor of the shared
+memory as the last argument.
+"""
+import sys
+
+from tvm.rpc import _ffi_api, server
+
+
+def main():
+    """Main function"""
+    if len(sys.argv) not in (2, 3):
+        print("Usage: [load_library] <shm_fd>")
+        return
+    load_library = sys.argv[1] if len(sys.argv) == 3 else None
+    _temp = server._server_env(load_library)
+    _ffi_api.ShmServerLoop(int(sys.argv[-1]))
+
+
+if __name__ == "__main__":
+    main()
@@ -149,7 +149,42 @@ def save_json(node) -> str:
     return _ffi_node_api.SaveJSON(node)
 
 
-def structural_equal(lhs, rhs, map_free_vars=False):
+def load_binary(data) -> Object:
+    """Load tvm object from the bytes of save_binary.
+
+    Parameters
+    ----------
+    data : bytes or bytearray
+        The saved bytes
+
+    Returns
+    -------
+    node : Object
+        The loaded tvm node.
+    """
+    return _ffi_node_api.LoadBinary(bytes(data))
+
+
+def save_binary(node) -> bytearray:
+    """Save tvm object in the compact binary format.
+
+    Unlike save_json, the strings are stored once and the NDArrays as raw bytes,
+    which makes the result smaller and faster to load.
+
+    Parameters
+    ----------
+    node : Object
+        A TVM object to be saved.
+
+    Returns
+    -------
+    data : bytearray
+        Saved bytes.
+    """
+    return _ffi_node_api.SaveBinary(node)
+
+
+def structural_equal(lhs, rhs, map_free_vars=False, num_threads=0):
     """Check structural equality of lhs and rhs.
 
     The structural equality is recursively defined in the DAG of IRNodes.
@@ -186,6 +221,10 @@ def structural_equal(lhs, rhs, map_free_vars=False):
         Whether free variables (i.e. variables without a definition site) should be mapped
         as equal to each other.
 
+    num_threads : int
+        The number of threads to compare the functions of IRModules with, 0 to compare
+        sequentially and -1 to use all the cores. The result does not depend on it.
+
     Return
     ------
     result : bool
@@ -198,6 +237,8 @@ def structural_equal(lhs, rhs, map_free_vars=False):
     """
     lhs = tvm.runtime.convert(lhs)
     rhs = tvm.runtime.convert(rhs)
+    if num_threads != 0:
+        return bool(_ffi_node_api.StructuralEqualParallel(lhs, rhs, map_free_vars, num_threads))  # type: ignore # pylint: disable=no-member
     return bool(_ffi_node_api.StructuralEqual(lhs, rhs, False, map_free_vars))  # type: ignore # pylint: disable=no-member
 
 
@@ -259,7 +300,7 @@ def assert_structural_equal(lhs, rhs, map_free_vars=False):
     _ffi_node_api.StructuralEqual(lhs, rhs, True, map_free_vars)  # type: ignore # pylint: disable=no-member
 
 
-def structural_hash(node, map_free_vars=False):
+def structural_hash(node, map_free_vars=False, num_threads=0):
     """Compute structural hash of node
 
     The structural hash value is recursively defined in the DAG of IRNodes.
@@ -289,6 +330,10 @@ def structural_hash(node, map_free_vars=False):
         by the order of their occurrences. Otherwise, we will hash by
         their in-memory pointer address.
 
+    num_threads : int
+        The number of threads to hash the functions of IRModules with, 0 to hash
+        sequentially and -1 to use all the cores. The result does not depend on it.
+
     Return
     ------
     result : int
@@ -298,6 +343,8 @@ def structural_hash(node, map_free_vars=False):
     --------
     structrual_equal
     """
+    if num_threads != 0:
+        return _ffi_node_api.StructuralHashParallel(node, map_free_vars, num_threads)  # type: ignore # pylint: disable=no-member
     return _ffi_node_api.StructuralHash(node, map_free_vars)  # type: ignore # pylint: disable=no-member
 
 
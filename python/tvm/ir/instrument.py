@@ -255,3 +255,57 @@ class PassTimingInstrument(tvm.runtime.Object):
                 profiles = timing_inst.render()
         """
         return _ffi_instrument_api.RenderTimePassProfiles()
+
+
+@tvm._ffi.register_object("instrument.PassProfilingInstrument")
+class PassProfilingInstrument(tvm.runtime.Object):
+    """A pass instrument implemented in C++ recording, for every pass, the wall time, the growth of
+    the peak resident memory of the process, the objects allocated by the thread running it and the
+    number of IR objects reachable from the module before and after it. The passes run by another
+    pass, like the ones of a Sequential, are nested under it.
+
+    The records are reset when entering a PassContext, and can be retrieved after exiting it.
+
+    Parameters
+    ----------
+    count_ir_nodes : bool
+        Whether to count the IR objects of the module before and after each pass, which walks the
+        whole module.
+    """
+
+    def __init__(self, count_ir_nodes=True):
+        self.__init_handle_by_constructor__(
+            _ffi_instrument_api.MakePassProfilingInstrument, count_ir_nodes
+        )
+
+    def render(self):
+        """Render the records as an indented tree of passes
+
+        Returns
+        -------
+        report : str
+            One line per pass run, with its time, the time spent in the pass itself in brackets,
+            its peak memory growth, its object allocations and its IR size before and after.
+
+        Examples
+        --------
+
+        .. code-block:: python
+
+            profiler = PassProfilingInstrument()
+            with tvm.transform.PassContext(opt_level=3, instruments=[profiler]):
+                lib = relay.build(mod, target="llvm")
+            print(profiler.render())
+        """
+        return _ffi_instrument_api.PassProfilingInstrumentRender(self)
+
+    def chrome_trace(self):
+        """Get the records in the Chrome trace event format, e.g. for chrome://tracing
+
+        Returns
+        -------
+        trace : str
+            The JSON trace, with one complete event per pass run holding the measurements in its
+            arguments.
+        """
+        return _ffi_instrument_api.PassProfilingInstrumentChromeTrace(self)
@@ -42,10 +42,17 @@ class PassInfo(tvm.runtime.Object):
 
     required : List[str]
         The list of passes that are required by a certain pass.
+
+    thread_safe : bool
+        Whether a function pass can run on several functions at once, see the
+        "transform.num_function_pass_threads" config. Passes written in python
+        are not by default, as they would contend for the GIL.
     """
 
-    def __init__(self, opt_level, name, required=None):
-        self.__init_handle_by_constructor__(_ffi_transform_api.PassInfo, opt_level, name, required)
+    def __init__(self, opt_level, name, required=None, thread_safe=False):
+        self.__init_handle_by_constructor__(
+            _ffi_transform_api.PassInfo, opt_level, name, required, thread_safe
+        )
 
 
 @tvm._ffi.register_object("transform.PassContext")
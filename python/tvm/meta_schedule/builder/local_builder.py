@@ -26,6 +26,7 @@ from tvm.target import Target
 
 from ...contrib.popen_pool import MapResult, PopenPoolExecutor, StatusKind
 from ..logging import get_logger
+from ..profiler import Profiler, timed_call
 from ..utils import cpu_count, derived_object, get_global_func_with_default_on_worker
 from .builder import BuilderInput, BuilderResult, PyBuilder
 
@@ -161,8 +162,9 @@ class LocalBuilder(PyBuilder):
         )
 
         # Dispatch the build inputs to the worker processes.
+        busy_sec = 0.0
         for map_result in pool.map_with_error_catching(
-            lambda x: _worker_func(*x),
+            lambda x: timed_call(_worker_func, *x),
             [
                 (
                     self.f_build,
@@ -175,8 +177,11 @@ class LocalBuilder(PyBuilder):
             ],
         ):
             if map_result.status == StatusKind.COMPLETE:
-                results.append(BuilderResult(map_result.value, None))
+                artifact_path, elapsed = map_result.value
+                busy_sec += elapsed
+                results.append(BuilderResult(artifact_path, None))
             elif map_result.status == StatusKind.TIMEOUT:
+                busy_sec += self.timeout_sec
                 results.append(
                     BuilderResult(
                         None,
@@ -193,6 +198,7 @@ class LocalBuilder(PyBuilder):
             else:
                 raise ValueError("Unreachable: unexpected result: {map_result}")
         del pool
+        Profiler.record_workers("LocalBuilder", self.max_workers, len(build_inputs), busy_sec)
         return results
 
     def _sanity_check(self) -> None:
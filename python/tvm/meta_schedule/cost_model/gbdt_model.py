@@ -0,0 +1,96 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Gradient-boosted decision tree cost model implemented in C++"""
+from typing import Optional
+
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from ..feature_extractor import FeatureExtractor
+from .cost_model import CostModel
+
+
+@register_object("meta_schedule.GradientBoostingModel")
+class GBDTModel(CostModel):
+    """Gradient-boosted decision tree cost model.
+
+    It is trained with the same objective as `XGBModel`, but both training and prediction run in
+    C++ with `TuneContext.num_threads` threads, so tuning does not call into Python to query or
+    update the cost model. The training data is saved together with the trees.
+
+    Parameters
+    ----------
+    extractor : FeatureExtractor.FeatureExtractorType
+        The feature extractor for the model.
+    num_warmup_samples : int
+        The number of samples that are used for warmup, i.e., the first few samples are predicted
+        with random results.
+    max_depth : int
+        The maximum depth of a tree.
+    eta : float
+        The learning rate.
+    gamma : float
+        The minimum loss reduction to split a node.
+    min_child_weight : float
+        The minimum sum of hessian in a child.
+    reg_lambda : float
+        The L2 regularization on the leaf values.
+    max_rounds : int
+        The maximum number of boosting rounds.
+    early_stopping_rounds : int
+        The number of rounds without improvement of the training error before stopping.
+    num_bins : int
+        The number of histogram bins each feature is quantized into, at most 256.
+    adaptive_training : bool
+        Whether use adaptive training to reduce tuning time.
+    seed : Optional[int]
+        The random seed, None for a random one.
+    """
+
+    def __init__(
+        self,
+        *,
+        extractor: FeatureExtractor.FeatureExtractorType = "per-store-feature",
+        num_warmup_samples: int = 100,
+        max_depth: int = 10,
+        eta: float = 0.2,
+        gamma: float = 0.001,
+        min_child_weight: float = 0.0,
+        reg_lambda: float = 1.0,
+        max_rounds: int = 1000,
+        early_stopping_rounds: int = 50,
+        num_bins: int = 64,
+        adaptive_training: bool = True,
+        seed: Optional[int] = None,
+    ):
+        if not isinstance(extractor, FeatureExtractor):
+            extractor = FeatureExtractor.create(extractor)
+        self.__init_handle_by_constructor__(
+            _ffi_api.CostModelGradientBoosting,  # type: ignore # pylint: disable=no-member
+            extractor,
+            num_warmup_samples,
+            max_depth,
+            eta,
+            gamma,
+            min_child_weight,
+            reg_lambda,
+            max_rounds,
+            early_stopping_rounds,
+            num_bins,
+            adaptive_training,
+            -1 if seed is None else seed,
+        )
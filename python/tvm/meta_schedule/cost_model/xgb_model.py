@@ -28,6 +28,7 @@ from ...runtime import NDArray
 from ..cost_model import PyCostModel
 from ..feature_extractor import FeatureExtractor
 from ..logging import get_logger
+from ..profiler import Profiler
 from ..runner import RunnerResult
 from ..search_strategy import MeasureCandidate
 from ..utils import cpu_count, derived_object, shash2hex
@@ -478,7 +479,8 @@ class XGBModel(PyCostModel):
                 return 1e10
             return float(np.median([float(s) for s in x.run_secs]))
 
-        new_features = [_feature(x) for x in self.extractor.extract_from(context, candidates)]
+        with Profiler.timeit("XGBModel/ExtractFeatures"):
+            new_features = [_feature(x) for x in self.extractor.extract_from(context, candidates)]
         new_mean_costs = [_mean_cost(x) for x in results]
 
         # Filter instances with no features
@@ -523,13 +525,14 @@ class XGBModel(PyCostModel):
         self.last_train_size = self.data_size
 
         # Step 5. Re-train the model
-        self._train(
-            xs=list(itertools_chain.from_iterable([g.features for g in self.data.values()])),
-            ys=np.concatenate(
-                [g.min_cost / g.costs for g in self.data.values()],
-                axis=0,
-            ),
-        )
+        with Profiler.timeit("XGBModel/Train"):
+            self._train(
+                xs=list(itertools_chain.from_iterable([g.features for g in self.data.values()])),
+                ys=np.concatenate(
+                    [g.min_cost / g.costs for g in self.data.values()],
+                    axis=0,
+                ),
+            )
 
     def predict(
         self,
@@ -0,0 +1,236 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""A database shared by multiple tuning jobs through a TVM RPC server"""
+import functools
+import json
+import os
+import time
+from typing import Dict, List, Optional, Tuple
+
+import tvm
+from tvm import rpc
+from tvm.ir import IRModule
+
+from ..utils import derived_object
+from .binary_database import BinaryDatabase
+from .database import PyDatabase, TuningRecord, Workload
+from .memory_database import MemoryDatabase
+
+_SERVER_FUNC_PREFIX = "meta_schedule.database_server."
+
+# The database opened by the server, keyed by the process that opened it. The RPC server forks
+# a process per session, which must not share the file lock of its parent.
+_SERVER_STATE: Dict[str, object] = {"pid": None, "database": None}
+
+
+def _server_database(path: str, module_equality: str) -> BinaryDatabase:
+    if _SERVER_STATE["pid"] != os.getpid():
+        _SERVER_STATE["database"] = BinaryDatabase(
+            path,
+            allow_missing=True,
+            module_equality=module_equality,
+        )
+        _SERVER_STATE["pid"] = os.getpid()
+    return _SERVER_STATE["database"]  # type: ignore
+
+
+def _register_server_funcs(path: str, module_equality: str) -> None:
+    """Register the functions the clients call on the server, all taking and returning JSON
+    strings. The tuning records are stored in a BinaryDatabase at `path`."""
+    database = functools.partial(_server_database, path, module_equality)
+
+    def has_workload(workload_json: str) -> bool:
+        workload = Workload.from_json(json.loads(workload_json))
+        return database().has_workload(workload.mod)
+
+    def commit_workload(workload_json: str) -> None:
+        workload = Workload.from_json(json.loads(workload_json))
+        database().commit_workload(workload.mod)
+
+    def commit_tuning_record(workload_json: str, record_json: str) -> None:
+        workload = Workload.from_json(json.loads(workload_json))
+        workload = database().commit_workload(workload.mod)
+        record = TuningRecord.from_json(json.loads(record_json), workload)
+        database().commit_tuning_record(record)
+
+    def get_top_k(workload_json: str, top_k: int) -> str:
+        workload = Workload.from_json(json.loads(workload_json))
+        if not database().has_workload(workload.mod):
+            return json.dumps([])
+        workload = database().commit_workload(workload.mod)
+        records = database().get_top_k(workload, top_k)
+        return json.dumps([record.as_json() for record in records])
+
+    def get_all_tuning_records() -> str:
+        records = database().get_all_tuning_records()
+        return json.dumps([[record.workload.as_json(), record.as_json()] for record in records])
+
+    def size() -> int:
+        return len(database())
+
+    for name, func in [
+        ("has_workload", has_workload),
+        ("commit_workload", commit_workload),
+        ("commit_tuning_record", commit_tuning_record),
+        ("get_top_k", get_top_k),
+        ("get_all_tuning_records", get_all_tuning_records),
+        ("size", size),
+    ]:
+        tvm.register_func(_SERVER_FUNC_PREFIX + name, func, override=True)
+
+
+def serve(
+    path: str,
+    host: str = "0.0.0.0",
+    port: int = 9190,
+    port_end: int = 9199,
+    *,
+    module_equality: str = "structural",
+    tracker_addr: Optional[Tuple[str, int]] = None,
+    key: str = "",
+) -> rpc.Server:
+    """Start a server that shares the tuning records in a database file with RPCDatabase clients.
+
+    Parameters
+    ----------
+    path : str
+        The path to the database file, opened as a BinaryDatabase.
+    host : str
+        The host url of the server.
+    port : int
+        The port to be bind to.
+    port_end : int
+        The end port to search.
+    module_equality : str
+        The module equality testing and hashing method of the database,
+        see `BinaryDatabase` for the candidates.
+    tracker_addr : Optional[Tuple[str, int]]
+        The address of RPC Tracker in tuple(host, ip) format.
+        If is not None, the server will register itself to the tracker.
+    key : str
+        The key used to identify the server in tracker.
+
+    Returns
+    -------
+    server : rpc.Server
+        The server, which stops when terminated or garbage collected.
+    """
+    return rpc.Server(
+        host=host,
+        port=port,
+        port_end=port_end,
+        tracker_addr=tracker_addr,
+        key=key,
+        server_init_callback=functools.partial(_register_server_funcs, path, module_equality),
+    )
+
+
+@derived_object
+class RPCDatabase(PyDatabase):
+    """A database client of the server started by `serve`, which lets several tuning jobs,
+    possibly on different machines, share their tuning records.
+
+    Workloads are cached on the client, so each of them is sent to the server once. The top-k
+    records of a workload are cached for `cache_ttl` seconds, and dropped as soon as this client
+    commits a record of the workload.
+
+    Parameters
+    ----------
+    host : str
+        The host url of the server.
+    port : int
+        The port of the server.
+    module_equality : str
+        The module equality testing and hashing method used for the client-side cache.
+        It should match the one of the server.
+    cache_ttl : float
+        The number of seconds the top-k records of a workload are cached for.
+    session_timeout : int
+        The duration of the RPC session in seconds, 0 means no timeout.
+    """
+
+    def __init__(
+        self,
+        host: str,
+        port: int,
+        *,
+        module_equality: str = "structural",
+        cache_ttl: float = 10.0,
+        session_timeout: int = 0,
+    ) -> None:
+        super().__init__()
+        self.session = rpc.connect(host, port, session_timeout=session_timeout)
+        self.cache_ttl = cache_ttl
+        self._workloads = MemoryDatabase(module_equality=module_equality)
+        self._top_k: Dict[Workload, Tuple[float, int, List[TuningRecord]]] = {}
+        self._remote: Dict[str, tvm.runtime.PackedFunc] = {}
+
+    def _call(self, name: str, *args):
+        if name not in self._remote:
+            self._remote[name] = self.session.get_function(_SERVER_FUNC_PREFIX + name)
+        return self._remote[name](*args)
+
+    def _workload_json(self, workload: Workload) -> str:
+        return json.dumps(workload.as_json())
+
+    def has_workload(self, mod: IRModule) -> bool:
+        if self._workloads.has_workload(mod):
+            return True
+        return bool(self._call("has_workload", self._workload_json(Workload(mod))))
+
+    def commit_workload(self, mod: IRModule) -> Workload:
+        if not self._workloads.has_workload(mod):
+            workload = self._workloads.commit_workload(mod)
+            self._call("commit_workload", self._workload_json(workload))
+            return workload
+        return self._workloads.commit_workload(mod)
+
+    def commit_tuning_record(self, record: TuningRecord) -> None:
+        workload = self.commit_workload(record.workload.mod)
+        self._top_k.pop(workload, None)
+        self._call(
+            "commit_tuning_record",
+            self._workload_json(workload),
+            json.dumps(record.as_json()),
+        )
+
+    def get_top_k(self, workload: Workload, top_k: int) -> List[TuningRecord]:
+        workload = self.commit_workload(workload.mod)
+        cached = self._top_k.get(workload, None)
+        if cached is not None:
+            timestamp, cached_k, records = cached
+            if time.time() - timestamp < self.cache_ttl and (
+                cached_k >= top_k or len(records) < cached_k
+            ):
+                return records[:top_k]
+        records = [
+            TuningRecord.from_json(record, workload)
+            for record in json.loads(self._call("get_top_k", self._workload_json(workload), top_k))
+        ]
+        self._top_k[workload] = (time.time(), top_k, records)
+        return records
+
+    def get_all_tuning_records(self) -> List[TuningRecord]:
+        results = []
+        for workload_json, record_json in json.loads(self._call("get_all_tuning_records")):
+            # The workloads of the server need not be committed to it again
+            workload = self._workloads.commit_workload(Workload.from_json(workload_json).mod)
+            results.append(TuningRecord.from_json(record_json, workload))
+        return results
+
+    def __len__(self) -> int:
+        return int(self._call("size"))
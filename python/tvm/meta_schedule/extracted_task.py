@@ -18,7 +18,7 @@
 from typing import List
 
 from tvm._ffi import register_object
-from tvm.ir import IRModule
+from tvm.ir import IntImm, IRModule
 from tvm.runtime import Object
 from tvm.target import Target
 
@@ -41,12 +41,22 @@ class ExtractedTask(Object):
         A list of low-level IRs that the high-level IR could potentially dispatch to
     weight : int
         The weight of the task
+
+    Attributes
+    ----------
+    module_equality : str
+        The module equality method the hashes of the dispatched IRs are computed with,
+        empty if they are not computed
+    dispatched_hashes : List[IntImm]
+        The hashes of the dispatched IRs, precomputed during task extraction
     """
 
     task_name: str
     mod: IRModule
     dispatched: List[IRModule]
     weight: int
+    module_equality: str
+    dispatched_hashes: List[IntImm]
 
     def __init__(
         self,
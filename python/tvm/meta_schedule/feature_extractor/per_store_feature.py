@@ -38,6 +38,9 @@ class PerStoreFeature(FeatureExtractor):
         The number of bytes in a cache line.
     extract_workload : bool
         Whether to extract features in the workload in tuning context or not.
+    feature_cache_size : int
+        The maximum number of candidate modules whose features are cached, 0 to disable the cache.
+        Features are cached by the structural hash of the candidate module.
     """
 
     buffers_per_store: int
@@ -57,6 +60,7 @@ class PerStoreFeature(FeatureExtractor):
         arith_intensity_curve_num_samples: int = 10,
         cache_line_bytes: int = 64,
         extract_workload: bool = False,
+        feature_cache_size: int = 4096,
     ):
         self.__init_handle_by_constructor__(
             _ffi_api.FeatureExtractorPerStoreFeature,  # type: ignore # pylint: disable=no-member
@@ -64,4 +68,5 @@ class PerStoreFeature(FeatureExtractor):
             arith_intensity_curve_num_samples,
             cache_line_bytes,
             extract_workload,
+            feature_cache_size,
         )
@@ -23,9 +23,20 @@ from .mutator import Mutator
 
 @register_object("meta_schedule.MutateTileSize")
 class MutateTileSize(Mutator):
-    """Mutator that mutates the decision of instruction Sample-Perfect-Tile"""
+    """Mutator that mutates the decision of instruction Sample-Perfect-Tile
 
-    def __init__(self) -> None:
+    Parameters
+    ----------
+    num_candidates : int
+        The number of neighboring decisions scored by the cost model when the mutation is guided
+        by the search strategy. 1 means mutating randomly.
+    exploration : float
+        The weight of the random bonus mixed into the scores, in [0, 1].
+    """
+
+    def __init__(self, num_candidates: int = 1, exploration: float = 0.0) -> None:
         self.__init_handle_by_constructor__(
             _ffi_api.MutatorMutateTileSize,  # type: ignore # pylint: disable=no-member
+            num_candidates,
+            exploration,
         )
@@ -15,7 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """Meta Schedule Mutator."""
-from typing import TYPE_CHECKING, Callable, Dict, Optional
+from typing import TYPE_CHECKING, Callable, Dict, List, Optional
 
 # isort: off
 from typing_extensions import Literal
@@ -63,6 +63,33 @@ class Mutator(Object):
         """
         return _ffi_api.MutatorApply(self, trace, -1)  # type: ignore # pylint: disable=no-member
 
+    def apply_guided(
+        self,
+        trace: Trace,
+        f_score: Callable[[List[Trace]], List[float]],
+    ) -> Optional[Trace]:
+        """Apply the mutator function to the given trace, guided by a scorer of the candidates.
+
+        Parameters
+        ----------
+        trace : Trace
+            The given trace for mutation.
+        f_score : Callable[[List[Trace]], List[float]]
+            The function that scores a batch of mutated traces, higher is better.
+            Invalid traces are scored -inf.
+
+        Returns
+        -------
+        trace : Optional[Trace]
+            None if mutator failed, otherwise return the mutated trace.
+        """
+        return _ffi_api.MutatorApplyGuided(  # type: ignore # pylint: disable=no-member
+            self,
+            trace,
+            -1,
+            lambda traces: [float(score) for score in f_score(list(traces))],
+        )
+
     def clone(self) -> "Mutator":
         """Clone the mutator.
 
@@ -79,6 +106,7 @@ class Mutator(Object):
             "llvm",
             "cuda",
             "cuda-tensorcore",
+            "vulkan-tensorcore",
             "hexagon",
         ]
     ) -> Dict["Mutator", float]:
@@ -86,7 +114,7 @@ class Mutator(Object):
 
         Parameters
         ----------
-        kind : Literal["llvm", "cuda", "cuda-tensorcore", "hexagon"]
+        kind : Literal["llvm", "cuda", "cuda-tensorcore", "vulkan-tensorcore", "hexagon"]
             The kind of mutators.
 
         Returns
@@ -99,6 +127,7 @@ class Mutator(Object):
             "llvm": _ffi_api.MutatorDefaultLLVM,  # type: ignore
             "cuda": _ffi_api.MutatorDefaultCUDA,  # type: ignore
             "cuda-tensorcore": _ffi_api.MutatorDefaultCUDATensorCore,  # type: ignore
+            "vulkan-tensorcore": _ffi_api.MutatorDefaultCUDATensorCore,  # type: ignore
             "hexagon": _ffi_api.MutatorDefaultHexagon,  # type: ignore
             # pylint: enable=no-member
         }
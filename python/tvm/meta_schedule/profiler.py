@@ -16,8 +16,9 @@
 # under the License.
 # pylint: disable=used-before-assignment
 """A context manager that profiles tuning time cost for different parts."""
+import time
 from contextlib import contextmanager
-from typing import Dict, Optional
+from typing import Any, Callable, Dict, Optional, Tuple
 
 from tvm._ffi import register_object
 from tvm.runtime import Object
@@ -38,10 +39,31 @@ class Profiler(Object):
         """Get the profiling results in seconds"""
         return _ffi_api.ProfilerGet(self)  # type: ignore # pylint: disable=no-member
 
+    def get_task_stats(self) -> Dict[str, Dict[str, float]]:
+        """Get the profiling results in seconds, broken down by task"""
+        return _ffi_api.ProfilerGetTaskStats(self)  # type: ignore # pylint: disable=no-member
+
+    def get_utilization(self) -> Dict[str, float]:
+        """Get the fraction of the time the workers of each pool are busy"""
+        return _ffi_api.ProfilerGetUtilization(self)  # type: ignore # pylint: disable=no-member
+
     def table(self) -> str:
         """Get the profiling results in a table format"""
         return _ffi_api.ProfilerTable(self)  # type: ignore # pylint: disable=no-member
 
+    def export_timeline(self, path: str) -> None:
+        """Export the timeline of the scopes profiled in the Chrome trace event format,
+        which can be viewed in chrome://tracing or Perfetto.
+
+        Parameters
+        ----------
+        path : str
+            The path to the JSON file to be written.
+        """
+        timeline = _ffi_api.ProfilerExportTimeline(self)  # type: ignore # pylint: disable=no-member
+        with open(path, "w", encoding="utf-8") as file:
+            file.write(timeline)
+
     def __enter__(self) -> "Profiler":
         """Entering the scope of the context manager"""
         _ffi_api.ProfilerEnterWithScope(self)  # type: ignore # pylint: disable=no-member
@@ -70,3 +92,52 @@ class Profiler(Object):
                     f()
 
         return _timeit()
+
+    @staticmethod
+    def task_scope(task_name: str):
+        """Attribute the time profiled in a block of code to a task"""
+
+        @contextmanager
+        def _task_scope():
+            try:
+                f = _ffi_api.ProfilerTaskScope(  # type: ignore # pylint: disable=no-member
+                    task_name
+                )
+                yield
+            finally:
+                if f:
+                    f()
+
+        return _task_scope()
+
+    @staticmethod
+    def record_workers(pool: str, num_workers: int, num_jobs: int, busy_sec: float) -> None:
+        """Record the jobs done by the workers of a pool in the current profiler, if any.
+
+        Parameters
+        ----------
+        pool : str
+            The name of the pool.
+        num_workers : int
+            The number of workers in the pool.
+        num_jobs : int
+            The number of jobs done.
+        busy_sec : float
+            The total time the workers spend on the jobs, in seconds.
+        """
+        _ffi_api.ProfilerRecordWorkers(  # type: ignore # pylint: disable=no-member
+            pool, num_workers, num_jobs, busy_sec
+        )
+
+
+def timed_call(func: Callable, *args) -> Tuple[Any, float]:
+    """Call a function, e.g. in a worker process, and measure how long it takes.
+
+    Returns
+    -------
+    result : Tuple[Any, float]
+        The result of the function, and the time it takes in seconds.
+    """
+    start = time.perf_counter()
+    result = func(*args)
+    return result, time.perf_counter() - start
@@ -40,7 +40,12 @@ class EvaluatorConfig(NamedTuple):
         Minimum repeat time in ms. if the execution latency is too short,
         increase the number of runs to the given time (in ms) to reduce the measurement error.
     enable_cpu_cache_flush: bool
-        Whether to flush the cache on CPU.
+        Whether to flush the cache on CPU before each repeat, for cold-cache measurement.
+    max_rel_ci: float
+        If positive, keep repeating after `repeat` repeats until the half width of the 95%
+        confidence interval on the mean falls below this fraction of the mean.
+    max_measure_ms: int
+        The cap on the duration of the repeats in ms, when `max_rel_ci` is positive.
 
     Note
     ----
@@ -52,6 +57,8 @@ class EvaluatorConfig(NamedTuple):
     repeat: int = 1
     min_repeat_ms: int = 100
     enable_cpu_cache_flush: bool = False
+    max_rel_ci: float = 0.0
+    max_measure_ms: int = 1000
 
     @staticmethod
     def _normalized(config: Optional["EvaluatorConfig"]) -> "EvaluatorConfig":
@@ -62,6 +69,8 @@ class EvaluatorConfig(NamedTuple):
             repeat=config.repeat,
             min_repeat_ms=config.min_repeat_ms,
             enable_cpu_cache_flush=config.enable_cpu_cache_flush,
+            max_rel_ci=config.max_rel_ci,
+            max_measure_ms=config.max_measure_ms,
         )
         return config
 
@@ -18,6 +18,7 @@
 from contextlib import contextmanager
 from typing import Callable, List, Optional, Union
 import subprocess
+import time
 
 import tvm
 
@@ -284,6 +285,7 @@ class LocalRunner(PyRunner):
 
     def run(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
         results: List[RunnerFuture] = []
+        start = time.perf_counter()
         for runner_input in runner_inputs:
             future = self.pool.submit(
                 _worker_func,
@@ -307,6 +309,10 @@ class LocalRunner(PyRunner):
                 error_message = "LocalRunner: An exception occurred\n" + str(exception)
             local_future = LocalRunnerFuture(res=result, error_message=error_message)
             results.append(local_future)  # type: ignore
+        # The inputs are run one after another on the only worker
+        Profiler.record_workers(
+            "LocalRunner", 1, len(runner_inputs), time.perf_counter() - start
+        )
         return results
 
     def _sanity_check(self) -> None:
@@ -18,14 +18,14 @@
 import concurrent.futures
 import os.path as osp
 from contextlib import contextmanager
-from typing import Callable, List, Optional, Union
+from typing import Callable, Dict, List, Optional, Tuple, Union
 
 from tvm.contrib.popen_pool import PopenPoolExecutor
 from tvm.rpc import RPCSession
 from tvm.runtime import Device, Module
 
 from ..logging import get_logger
-from ..profiler import Profiler
+from ..profiler import Profiler, timed_call
 from ..utils import (
     derived_object,
     get_global_func_on_rpc_session,
@@ -93,12 +93,20 @@ class RPCRunnerFuture(PyRunnerFuture):
         The concurrent function to check when the function is done and to return the result.
     timeout_sec: float
         The timeout in seconds.
+    index: Optional[int]
+        The index of the runner input in its batch, None if it is not run in a batch.
     """
 
     future: concurrent.futures.Future
     timeout_sec: float
+    index: Optional[int]
 
-    def __init__(self, future: concurrent.futures.Future, timeout_sec: float) -> None:
+    def __init__(
+        self,
+        future: concurrent.futures.Future,
+        timeout_sec: float,
+        index: Optional[int] = None,
+    ) -> None:
         """Constructor
 
         Parameters
@@ -107,17 +115,27 @@ class RPCRunnerFuture(PyRunnerFuture):
             The concurrent function to check when the function is done and to return the result.
         timeout_sec: float
             The timeout in seconds.
+        index: Optional[int]
+            The index of the runner input in its batch, None if it is not run in a batch.
         """
         super().__init__()
         self.future = future
         self.timeout_sec = timeout_sec
+        self.index = index
 
     def done(self) -> bool:
         return self.future.done()
 
     def result(self) -> RunnerResult:
         try:
-            run_secs: List[float] = self.future.result()
+            run_secs, elapsed = self.future.result()
+            # A batch is recorded once, by its first input
+            if not self.index:
+                Profiler.record_workers("RPCRunner", 0, 1, elapsed)
+            if self.index is not None:
+                run_secs, error_msg = run_secs[self.index]
+                if error_msg is not None:
+                    raise RuntimeError(error_msg)
         except TimeoutError:
             return RunnerResult(
                 None,
@@ -155,6 +173,10 @@ class RPCRunner(PyRunner):
         The function name to run the evaluator or the function itself.
     f_cleanup: Optional[str, Callable]
         The function name to cleanup the session or the function itself.
+    max_batch_size: int
+        The maximum number of runner inputs measured in a single RPC session.
+    max_workers: int
+        The number of worker processes in the popen pool.
     pool: PopenPoolExecutor
         The popen pool executor.
 
@@ -229,6 +251,8 @@ class RPCRunner(PyRunner):
     f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None]
     f_run_evaluator: Union[T_RUN_EVALUATOR, str, None]
     f_cleanup: Union[T_CLEANUP, str, None]
+    max_batch_size: int
+    max_workers: int
 
     pool: PopenPoolExecutor
 
@@ -245,6 +269,7 @@ class RPCRunner(PyRunner):
         f_cleanup: Union[T_CLEANUP, str, None] = None,
         max_workers: Optional[int] = None,
         initializer: Optional[Callable[[], None]] = None,
+        max_batch_size: int = 1,
     ) -> None:
         """Constructor
 
@@ -272,6 +297,11 @@ class RPCRunner(PyRunner):
             The maximum number of connections. Defaults to 1.
         initializer: Optional[Callable[[], None]]
             The initializer function.
+        max_batch_size: int
+            The maximum number of runner inputs measured in a single RPC session. When it is
+            larger than 1, the runner inputs are split into batches, each of which is measured
+            in one session, reusing the arguments allocated across the runner inputs with the
+            same arguments info. The session timeout is scaled by the size of the batch.
         """
         super().__init__()
         self.rpc_config = RPCConfig._normalized(rpc_config)
@@ -283,9 +313,13 @@ class RPCRunner(PyRunner):
         self.f_alloc_argument = f_alloc_argument
         self.f_run_evaluator = f_run_evaluator
         self.f_cleanup = f_cleanup
+        if max_batch_size < 1:
+            raise ValueError(f"max_batch_size must be positive, but got {max_batch_size}")
+        self.max_batch_size = max_batch_size
         if max_workers is None:
             max_workers = 1
         logger.info("RPCRunner: max_workers = %d", max_workers)
+        self.max_workers = max_workers
         self.pool = PopenPoolExecutor(
             max_workers=max_workers,
             initializer=initializer,
@@ -293,10 +327,14 @@ class RPCRunner(PyRunner):
         self._sanity_check()
 
     def run(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
+        Profiler.record_workers("RPCRunner", self.max_workers, 0, 0.0)
+        if self.max_batch_size > 1:
+            return self._run_batched(runner_inputs)
         results: List[RunnerFuture] = []
         for runner_input in runner_inputs:
             future = RPCRunnerFuture(
                 future=self.pool.submit(
+                    timed_call,
                     _worker_func,
                     self.f_create_session,
                     self.f_upload_module,
@@ -315,6 +353,39 @@ class RPCRunner(PyRunner):
             results.append(future)  # type: ignore
         return results
 
+    def _run_batched(self, runner_inputs: List[RunnerInput]) -> List[RunnerFuture]:
+        results: List[RunnerFuture] = []
+        for start in range(0, len(runner_inputs), self.max_batch_size):
+            batch = runner_inputs[start : start + self.max_batch_size]
+            timeout_sec = self.rpc_config.session_timeout_sec * len(batch)
+            future = self.pool.submit(
+                timed_call,
+                _batch_worker_func,
+                self.f_create_session,
+                self.f_upload_module,
+                self.f_alloc_argument,
+                self.f_run_evaluator,
+                self.f_cleanup,
+                self.rpc_config._replace(session_timeout_sec=timeout_sec),
+                self.evaluator_config,
+                self.alloc_repeat,
+                [str(runner_input.artifact_path) for runner_input in batch],
+                [str(runner_input.device_type) for runner_input in batch],
+                [
+                    tuple(arg_info.as_json() for arg_info in runner_input.args_info)
+                    for runner_input in batch
+                ],
+            )
+            for index in range(len(batch)):
+                results.append(
+                    RPCRunnerFuture(  # type: ignore
+                        future=future,
+                        timeout_sec=timeout_sec,
+                        index=index,
+                    )
+                )
+        return results
+
     def _sanity_check(self) -> None:
         def _check(
             f_create_session,
@@ -399,7 +470,7 @@ def _worker_func(
                 alloc_repeat,
             )
         # Step 4: Run time_evaluator
-        with Profiler.timeit("LocalRunner/run_evaluator"):
+        with Profiler.timeit("RPCRunner/run_evaluator"):
             costs: List[float] = f_run_evaluator(
                 session,
                 rt_mod,
@@ -410,6 +481,80 @@ def _worker_func(
     return costs
 
 
+def _batch_worker_func(
+    _f_create_session: Union[T_CREATE_SESSION, str, None],
+    _f_upload_module: Union[T_UPLOAD_MODULE, str, None],
+    _f_alloc_argument: Union[T_ALLOC_ARGUMENT, str, None],
+    _f_run_evaluator: Union[T_RUN_EVALUATOR, str, None],
+    _f_cleanup: Union[T_CLEANUP, str, None],
+    rpc_config: RPCConfig,
+    evaluator_config: EvaluatorConfig,
+    alloc_repeat: int,
+    artifact_paths: List[str],
+    device_types: List[str],
+    args_infos: List[T_ARG_INFO_JSON_OBJ_LIST],
+) -> List[Tuple[Optional[List[float]], Optional[str]]]:
+    """Measure a batch of runner inputs in a single session. The failure of a runner input is
+    returned as its error message, while that of the session fails the whole batch."""
+    # Step 0. Get the registered functions
+    f_create_session: T_CREATE_SESSION = get_global_func_with_default_on_worker(
+        _f_create_session, default_create_session
+    )
+    f_upload_module: T_UPLOAD_MODULE = get_global_func_with_default_on_worker(
+        _f_upload_module, default_upload_module
+    )
+    f_alloc_argument: T_ALLOC_ARGUMENT = get_global_func_with_default_on_worker(
+        _f_alloc_argument, default_alloc_argument
+    )
+    f_run_evaluator: T_RUN_EVALUATOR = get_global_func_with_default_on_worker(
+        _f_run_evaluator, default_run_evaluator
+    )
+    f_cleanup: T_CLEANUP = get_global_func_with_default_on_worker(_f_cleanup, default_cleanup)
+    # Step 1. Create session
+    with Profiler.timeit("RPCRunner/create_session"):
+        session: RPCSession = f_create_session(rpc_config)
+    devices: Dict[str, Device] = {}
+    # The arguments allocated, keyed by the device type and the arguments info
+    allocated: Dict[Tuple[str, str], List[T_ARGUMENT_LIST]] = {}
+    results: List[Tuple[Optional[List[float]], Optional[str]]] = []
+    for index, (artifact_path, device_type, args_info) in enumerate(
+        zip(artifact_paths, device_types, args_infos)
+    ):
+        # All the artifacts share the same file name, in different local directories
+        remote_path: Optional[str] = None
+        try:
+            if device_type not in devices:
+                devices[device_type] = session.device(dev_type=device_type, dev_id=0)
+            device = devices[device_type]
+            # Step 2. Upload the module
+            with Profiler.timeit("RPCRunner/upload_module"):
+                remote_path = f"{index}_{osp.basename(artifact_path)}"
+                rt_mod: Module = f_upload_module(session, artifact_path, remote_path)
+            # Step 3: Allocate input arguments, or reuse the ones of the same arguments info
+            with Profiler.timeit("RPCRunner/alloc_argument"):
+                key = (device_type, str(args_info))
+                if key not in allocated:
+                    allocated[key] = f_alloc_argument(session, device, args_info, alloc_repeat)
+                repeated_args: List[T_ARGUMENT_LIST] = allocated[key]
+            # Step 4: Run time_evaluator
+            with Profiler.timeit("RPCRunner/run_evaluator"):
+                costs: List[float] = f_run_evaluator(
+                    session,
+                    rt_mod,
+                    device,
+                    evaluator_config,
+                    repeated_args,
+                )
+            results.append((costs, None))
+        except Exception as exception:  # pylint: disable=broad-except
+            results.append((None, str(exception)))
+        finally:
+            # Final step. Always clean up
+            with Profiler.timeit("RPCRunner/cleanup"):
+                f_cleanup(session, remote_path)
+    return results
+
+
 def default_create_session(rpc_config: RPCConfig) -> RPCSession:
     """Default function to create the session
 
@@ -80,11 +80,14 @@ class RunnerResult(Object):
     ----------
     run_secs : Optional[List[float]]
         The run time in seconds.
+    run_sec_var : Optional[float]
+        The sample variance of the run time in seconds squared, if there are 2 runs or more.
     error_msg : Optional[str]
         The error message, if any.
     """
 
     run_secs: Optional[List[float]]
+    run_sec_var: Optional[float]
     error_msg: Optional[str]
 
     def __init__(
@@ -24,6 +24,7 @@ from .apply_custom_rule import ApplyCustomRule
 from .auto_bind import AutoBind
 from .auto_inline import AutoInline, InlineConstantScalars
 from .cross_thread_reduction import CrossThreadReduction
+from .horizontal_fusion import HorizontalFusion
 from .multi_level_tiling import (
     MultiLevelTiling,
     MultiLevelTilingTensorCore,
@@ -34,3 +35,4 @@ from .multi_level_tiling import (
 from .parallel_vectorize_unroll import ParallelizeVectorizeUnroll
 from .random_compute_location import RandomComputeLocation
 from .schedule_rule import PyScheduleRule, ScheduleRule
+from .software_prefetch import SoftwarePrefetch
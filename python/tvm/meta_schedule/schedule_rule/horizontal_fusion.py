@@ -0,0 +1,35 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Horizontal fusion rule that fuses the loop nests of independent sibling blocks"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from .schedule_rule import ScheduleRule
+
+
+@register_object("meta_schedule.HorizontalFusion")
+class HorizontalFusion(ScheduleRule):
+    """Fuse the loop nests of independent sibling blocks horizontally, so that they are launched
+    as a single kernel. The spatial loops leading each nest are fused first, and the fused loops
+    are then fused by `Schedule.horizontal_fuse`. The blocks under the fused loop are left for
+    AutoBind to bind, so this rule should run before it.
+    """
+
+    def __init__(self) -> None:
+        self.__init_handle_by_constructor__(
+            _ffi_api.ScheduleRuleHorizontalFusion,  # type: ignore # pylint: disable=no-member
+        )
@@ -45,6 +45,11 @@ class EvolutionarySearch(SearchStrategy):
         The maximum number to retry mutation.
     eps_greedy : float
         The ratio of greedy selected samples in the final picks.
+    warm_start_num_workloads : int
+        The number of the nearest workloads of the same operator family in the database, e.g. the
+        same anchor op with different shapes, whose best traces seed the initial population when
+        the workload being tuned has too few measured samples. Tile sizes are adapted by ratio.
+        0 disables warm start.
     """
 
     population_size: int
@@ -54,6 +59,7 @@ class EvolutionarySearch(SearchStrategy):
     genetic_mutate_prob: float
     genetic_max_fail_count: int
     eps_greedy: float
+    warm_start_num_workloads: int
 
     def __init__(
         self,
@@ -66,6 +72,7 @@ class EvolutionarySearch(SearchStrategy):
         genetic_mutate_prob: float = 0.85,
         genetic_max_fail_count: int = 10,
         eps_greedy: float = 0.05,
+        warm_start_num_workloads: int = 0,
     ) -> None:
         """Constructor"""
         self.__init_handle_by_constructor__(
@@ -78,4 +85,5 @@ class EvolutionarySearch(SearchStrategy):
             genetic_mutate_prob,
             genetic_max_fail_count,
             eps_greedy,
+            warm_start_num_workloads,
         )
@@ -142,6 +142,11 @@ class SearchStrategy(Object):
         -------
         measure_candidates : Optional[List[IRModule]]
             The measure candidates generated, None if finished.
+
+        Note
+        ----
+        The task scheduler generates the next batch while the previous one is being measured,
+        i.e. before its results are notified. The trials should be counted when generated.
         """
         return _ffi_api.SearchStrategyGenerateMeasureCandidates(self)  # type: ignore # pylint: disable=no-member
 
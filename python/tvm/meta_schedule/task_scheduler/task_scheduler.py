@@ -51,6 +51,9 @@ class TaskRecord(Object):
     measure_candidates: List[MeasureCandidate]
     builder_results: List[BuilderResult]
     runner_results: List[RunnerResult]
+    next_candidates: List[MeasureCandidate]
+    next_builder_results: List[BuilderResult]
+    is_exhausted: bool
 
 
 @register_object("meta_schedule.TaskScheduler")
@@ -169,7 +172,7 @@ class TaskScheduler(Object):
 
     @staticmethod
     def create(  # pylint: disable=keyword-arg-before-vararg
-        kind: Literal["round-robin", "gradient"] = "gradient",
+        kind: Literal["round-robin", "gradient", "time-budget"] = "gradient",
         *args,
         **kwargs,
     ) -> "TaskScheduler":
@@ -177,12 +180,15 @@ class TaskScheduler(Object):
         from . import (  # pylint: disable=import-outside-toplevel
             GradientBased,
             RoundRobin,
+            TimeBudget,
         )
 
         if kind == "round-robin":
             return RoundRobin(*args, **kwargs)  # type: ignore
         if kind == "gradient":
             return GradientBased(*args, **kwargs)
+        if kind == "time-budget":
+            return TimeBudget(*args, **kwargs)
         raise ValueError(f"Unknown TaskScheduler name: {kind}")
 
 
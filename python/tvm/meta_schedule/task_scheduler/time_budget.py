@@ -0,0 +1,68 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Time Budget Task Scheduler"""
+from tvm._ffi import register_object
+
+from .. import _ffi_api
+from ..logging import get_logger, get_logging_func
+from .task_scheduler import TaskScheduler
+
+logger = get_logger(__name__)  # pylint: disable=invalid-name
+
+
+@register_object("meta_schedule.TimeBudget")
+class TimeBudget(TaskScheduler):
+    """Task scheduler that tunes within a wall-clock time budget.
+
+    It picks the task with the largest expected improvement of the weighted latency per second
+    spent on it, counting the time of generation, building and running, and stops the tasks whose
+    best latency has not improved for `patience` rounds, leaving their time to the others.
+    """
+
+    def __init__(
+        self,
+        time_budget_sec: float,
+        *,
+        patience: int = 5,
+        alpha: float = 0.2,
+        window_size: int = 3,
+        seed: int = -1,
+    ) -> None:
+        """Constructor.
+
+        Parameters
+        ----------
+        time_budget_sec : float
+            The wall-clock time budget of tuning, in seconds.
+        patience : int = 5
+            The number of rounds without improvement after which a task is stopped.
+        alpha : float = 0.2
+            The parameter alpha in gradient computation.
+        window_size : int = 3
+            The parameter to control backward window size in gradient computation.
+        seed : int = -1
+            The random seed.
+        """
+        self.__init_handle_by_constructor__(
+            _ffi_api.TaskSchedulerTimeBudget,  # type: ignore # pylint: disable=no-member
+            get_logging_func(logger),
+            time_budget_sec,
+            patience,
+            alpha,
+            window_size,
+            seed,
+        )
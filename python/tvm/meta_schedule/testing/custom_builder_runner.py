@@ -130,6 +130,8 @@ def run_with_graph_executor(
         f_preproc="cache_flush_cpu_non_first_arg"
         if evaluator_config.enable_cpu_cache_flush
         else "",
+        max_rel_ci=evaluator_config.max_rel_ci,
+        max_measure_ms=evaluator_config.max_measure_ms,
     )
     repeated_costs = []
     for args in repeated_args:
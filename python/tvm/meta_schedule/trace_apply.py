@@ -15,6 +15,9 @@
 # specific language governing permissions and limitations
 # under the License.
 """Specialized applications of trace"""
+from typing import Optional
+
+from ..ir import IRModule
 from ..tir.schedule import Schedule, Trace
 from ..target import Target
 from . import _ffi_api
@@ -37,3 +40,26 @@ def schedule_using_anchor_trace(sch: Schedule, anchor_trace: Trace, target: Targ
         The compilation target
     """
     _ffi_api.ScheduleUsingAnchorTrace(sch, anchor_trace, target)  # type: ignore
+
+
+def transfer_trace(mod: IRModule, design_space: Trace, trace: Trace) -> Optional[Trace]:
+    """Transfer the decisions of a trace tuned on another workload of the same operator family,
+    e.g. the same anchor op with different shapes, onto a design space of a module. Tile sizes are
+    adapted to the loop extents of the module by keeping their ratios.
+
+    Parameters
+    ----------
+    mod : IRModule
+        The module to be scheduled
+    design_space : Trace
+        The trace of a design space of the module, whose instructions match those of `trace`
+    trace : Trace
+        The trace tuned on the other workload
+
+    Returns
+    -------
+    transferred : Optional[Trace]
+        The trace of the design space with the decisions transferred, or None if the trace does
+        not match the design space or cannot be applied to the module
+    """
+    return _ffi_api.TransferTrace(mod, design_space, trace)  # type: ignore
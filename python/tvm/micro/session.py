@@ -27,6 +27,7 @@ from typing import Union
 
 from tvm.runtime.executor.aot_executor import AotModule
 from ..error import register_error
+from ..runtime import ndarray
 from .._ffi import get_global_func, register_func
 from ..contrib import graph_executor
 from ..contrib import utils
@@ -103,6 +104,34 @@ class Session:
             self.get_system_lib(), self.device, "default"
         )
 
+    def get_memory_stats(self):
+        """Read the usage counters of the device memory manager.
+
+        Needs firmware using the TLSF memory manager which called
+        ``TLSFMemoryManagerRegisterFuncs``.
+
+        Returns
+        -------
+        stats : Dict[str, int]
+            The fields of ``TLSFMemoryManagerStats``, by name.
+        """
+        names = [
+            "used_bytes",
+            "peak_used_bytes",
+            "free_bytes",
+            "largest_free_bytes",
+            "num_allocations",
+            "num_failed_allocations",
+            "num_fragmented_failures",
+        ]
+        stats = ndarray.empty((len(names),), "int64", self.device)
+        self._rpc.get_function("tvm.crt.memory.get_stats")(stats)
+        return dict(zip(names, (int(x) for x in stats.numpy())))
+
+    def reset_memory_peak(self):
+        """Restart the peak usage of the device memory manager from the current usage."""
+        self._rpc.get_function("tvm.crt.memory.reset_peak")()
+
     def _wrap_transport_read(self, n, timeout_microsec):
         try:
             return self.transport.read(
@@ -416,7 +416,7 @@ def _create_cascader(
     return _cascader
 
 
-def _ethos_u55_cascader(sram, enable_striping) -> Callable:
+def _ethos_u55_cascader(sram, enable_striping, plan_time_budget=0.0) -> Callable:
     # TODO(ekalda): Extract the flash info from ConstantPools once it is implemented
     flash = MemoryRegion(name="FLASH", size=10**7, read_bandwidth=4, write_bandwidth=4)
 
@@ -430,6 +430,7 @@ def _ethos_u55_cascader(sram, enable_striping) -> Callable:
         max_open_plans=8,
         max_closed_plans=32,
         enable_striping=enable_striping,
+        plan_time_budget=plan_time_budget,
     )
     return _create_cascader(
         options=cascader_options,
@@ -524,7 +525,10 @@ def relay_to_tir(mod: tvm.ir.IRModule) -> tvm.ir.IRModule:
 
         memory_pressure = _calculate_memory_pressure(mod)
         sram = extract_memory_info(workspace_memory_pools.pools[0], memory_pressure)
-        tir_mod = LowerToTIR(_ethos_u55_cascader(sram, util.is_striping_enabled()))(mod)
+        cascader = _ethos_u55_cascader(
+            sram, util.is_striping_enabled(), util.get_cascader_time_budget()
+        )
+        tir_mod = LowerToTIR(cascader)(mod)
     else:
         scheduler = None if util.is_copying_constants_disabled() else copy_constants()
         tir_mod = LowerToTIR(scheduler)(mod)
@@ -555,7 +555,7 @@ def EncodeConstants(const_dict):
                     offset = new_indices[0]
                     if offset != 0 and new_buffer in new_buffer_to_split_idx:
                         offset = new_buffer_to_split_idx[new_buffer]
-                    return tvm.tir.BufferLoad(buf_remap[stmt.buffer], [offset], stmt.span)
+                    return tvm.tir.BufferLoad(buf_remap[stmt.buffer], [offset], span=stmt.span)
 
             if isinstance(stmt, tvm.tir.AttrStmt):
                 node_pointer = stmt.node
@@ -838,7 +838,7 @@ def RemoveConcatenates():
                 new_indices = list(stmt.indices)
                 new_indices[replace_info.axis] += replace_info.offset
                 # The new buffer store node that stores the tensor directly into the concat buffer
-                new_store = tvm.tir.BufferStore(concat_buffer, stmt.value, new_indices, stmt.span)
+                new_store = tvm.tir.BufferStore(concat_buffer, stmt.value, new_indices, span=stmt.span)
                 return new_store
         if isinstance(stmt, tvm.tir.BufferLoad):
             if stmt.buffer in buffer_replace_map:
@@ -848,7 +848,7 @@ def RemoveConcatenates():
                 concat_buffer = replace_info.buffer
                 new_indices = list(stmt.indices)
                 new_indices[replace_info.axis] += replace_info.offset
-                new_load = tvm.tir.BufferLoad(concat_buffer, new_indices, stmt.span)
+                new_load = tvm.tir.BufferLoad(concat_buffer, new_indices, span=stmt.span)
                 return new_load
         if isinstance(stmt, tvm.tir.BufferRealize):
             if stmt.buffer in buffer_replace_map:
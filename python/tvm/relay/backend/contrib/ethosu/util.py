@@ -270,6 +270,12 @@ def is_striping_enabled() -> bool:
     return bool(compiler_attrs.enable_striping)
 
 
+def get_cascader_time_budget() -> float:
+    """Get the time budget in seconds of the cascader Plan search, 0 for no limit"""
+    compiler_attrs = tvm.get_global_func("relay.ext.ethos-u.get_compiler_attrs")()
+    return float(compiler_attrs.cascader_time_budget)
+
+
 def get_arg_count(func):
     """Helper function to get the number of
     arguments in a python function"""
@@ -21,6 +21,7 @@ import warnings
 from ..._ffi.base import string_types
 from ..._ffi.registry import get_global_func
 from ...runtime import ndarray
+from .memory_report import estimate_peak_memory
 
 
 class ExecutorFactoryModule:
@@ -44,6 +45,21 @@ class ExecutorFactoryModule:
         """Return the generated library"""
         raise NotImplementedError
 
+    def get_peak_memory_report(self, overhead_bytes=0):
+        """Estimate the peak memory of the model per device type, without running it.
+
+        Parameters
+        ----------
+        overhead_bytes : int
+            The executor and allocator overhead to add to the estimate of each device type.
+
+        Returns
+        -------
+        report : tvm.relay.backend.memory_report.PeakMemoryReport
+            The estimate per device type, with the breakdown by operator.
+        """
+        return estimate_peak_memory(self.function_metadata, overhead_bytes)
+
     def __getitem__(self, item):
         return self.module.__getitem__(item)
 
@@ -159,7 +175,8 @@ class GraphExecutorFactoryModule(ExecutorFactoryModule):
         Internal representation of the Executor
     graph_json_str : the json graph to be deployed in json format output by graph compiler.
         The graph can contain operator(tvm_op) that points to the name of
-        PackedFunc in the libmod.
+        PackedFunc in the libmod. The deployed module also accepts the graph
+        in the binary graph format, see get_graph_binary.
     libmod : tvm.Module
         The module of the corresponding function
     libmod_name: str
@@ -181,7 +198,7 @@ class GraphExecutorFactoryModule(ExecutorFactoryModule):
         params,
         function_metadata,
     ):
-        assert isinstance(graph_json_str, string_types)
+        assert isinstance(graph_json_str, (string_types, bytes, bytearray))
         fcreate = get_global_func("tvm.graph_executor_factory.create")
         args = []
         for k, v in params.items():
@@ -211,6 +228,29 @@ class GraphExecutorFactoryModule(ExecutorFactoryModule):
     def get_graph_json(self):
         return self.graph_json
 
+    def get_graph_binary(self):
+        """Get the graph in the binary graph format, which loads without a JSON parser.
+
+        Returns
+        -------
+        graph_binary : bytearray
+            The binary graph.
+        """
+        if isinstance(self.graph_json, (bytes, bytearray)):
+            return self.graph_json
+        return get_global_func("tvm.graph_executor.json_to_binary")(self.graph_json)
+
+    def get_graph_flat(self):
+        """Get the graph in the flat graph format, which the CRT graph executor uses in place.
+
+        Returns
+        -------
+        graph_flat : bytearray
+            The flat graph.
+        """
+        assert isinstance(self.graph_json, string_types), "The flat graph is built from JSON"
+        return get_global_func("tvm.graph_executor.json_to_flat")(self.graph_json)
+
     def get_executor_config(self):
         return self.graph_json
 
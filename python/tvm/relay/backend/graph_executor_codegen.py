@@ -47,6 +47,8 @@ class GraphExecutorCodegen(object):
         self._init = self._mod["init"]
         self._codegen = self._mod["codegen"]
         self._get_graph_json = self._mod["get_graph_json"]
+        self._get_graph_binary = self._mod["get_graph_binary"]
+        self._get_graph_flat = self._mod["get_graph_flat"]
         self._list_params_name = self._mod["list_params_name"]
         self._get_param_by_name = self._mod["get_param_by_name"]
         self._get_irmodule = self._mod["get_irmodule"]
@@ -87,3 +89,29 @@ class GraphExecutorCodegen(object):
             arr.copyto(param)
             params[key] = param
         return graph_json, lowered_func, params
+
+    def get_graph_binary(self):
+        """Get the graph of the last codegen in the binary graph format.
+
+        The binary graph loads faster than the JSON graph, the graph executors
+        accept both.
+
+        Returns
+        -------
+        graph_binary : bytearray
+            The binary graph.
+        """
+        return self._get_graph_binary()
+
+    def get_graph_flat(self):
+        """Get the graph of the last codegen in the flat graph format.
+
+        The CRT graph executor uses the tables of the flat graph in place, so
+        the graph can stay in flash. Place it at an 8-byte aligned address.
+
+        Returns
+        -------
+        graph_flat : bytearray
+            The flat graph.
+        """
+        return self._get_graph_flat()
@@ -0,0 +1,218 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Compile-time estimate of the peak memory of a built model."""
+from typing import Dict, List, Optional
+
+from ...runtime import Device
+
+MAIN_FUNC_NAME_STR = "__tvm_main__"
+
+
+class DeviceMemory:
+    """The estimated memory of a model on one device type.
+
+    Attributes
+    ----------
+    device_type : int
+        The DLPack device type.
+    activation_bytes : int
+        The planned storage of the intermediate tensors of the main function.
+    constant_bytes : int
+        The parameters and other constants of the main function.
+    io_bytes : int
+        The inputs and outputs of the main function.
+    max_operator_workspace_bytes : int
+        The largest workspace of the operators, which run one at a time.
+    peak_operator : Optional[str]
+        The operator with the largest workspace.
+    overhead_bytes : int
+        The executor and allocator overhead given to the estimate.
+    """
+
+    def __init__(self, device_type: int):
+        self.device_type = device_type
+        self.activation_bytes = 0
+        self.constant_bytes = 0
+        self.io_bytes = 0
+        self.max_operator_workspace_bytes = 0
+        self.peak_operator = None
+        self.overhead_bytes = 0
+
+    @property
+    def peak_bytes(self) -> int:
+        """The estimated peak memory on the device."""
+        return (
+            self.activation_bytes
+            + self.constant_bytes
+            + self.io_bytes
+            + self.max_operator_workspace_bytes
+            + self.overhead_bytes
+        )
+
+
+class OperatorMemory:
+    """The memory an operator uses on one device type.
+
+    Attributes
+    ----------
+    name : str
+        The name of the operator function.
+    device_type : int
+        The DLPack device type.
+    workspace_bytes : int
+        The workspace the operator allocates.
+    io_bytes : int
+        The arguments of the operator.
+    live_bytes : int
+        The memory in use on the device while the operator runs, at most.
+    """
+
+    def __init__(self, name: str, device_type: int, workspace_bytes: int, io_bytes: int):
+        self.name = name
+        self.device_type = device_type
+        self.workspace_bytes = workspace_bytes
+        self.io_bytes = io_bytes
+        self.live_bytes = 0
+
+
+class PeakMemoryReport:
+    """Compile-time estimate of the peak memory of a model, per device type, with a breakdown
+    by operator.
+
+    The estimate of a device type is the sum of the planned storage of the intermediate
+    tensors, the constants, the inputs and outputs, the largest operator workspace and the
+    overhead given to :py:func:`estimate_peak_memory`.
+
+    Attributes
+    ----------
+    devices : Dict[int, DeviceMemory]
+        The estimate per DLPack device type.
+    operators : List[OperatorMemory]
+        The operators, sorted by decreasing memory in use while they run.
+    """
+
+    def __init__(self, devices: Dict[int, DeviceMemory], operators: List[OperatorMemory]):
+        self.devices = devices
+        self.operators = operators
+
+    def peak_bytes(self, device: Optional[Device] = None) -> int:
+        """Return the estimated peak memory of a device type, or of the largest one.
+
+        Parameters
+        ----------
+        device : Optional[Device]
+            The device. If not given, the largest estimate over the device types is returned.
+
+        Returns
+        -------
+        peak_bytes : int
+            The estimated peak memory.
+        """
+        if device is not None:
+            entry = self.devices.get(device.device_type)
+            return entry.peak_bytes if entry is not None else 0
+        return max([entry.peak_bytes for entry in self.devices.values()], default=0)
+
+    def fits(self, device: Device, capacity_bytes: int) -> bool:
+        """Return whether the model is estimated to fit in the memory of a device."""
+        return self.peak_bytes(device) <= capacity_bytes
+
+    def table(self) -> str:
+        """Format the report as a human readable table."""
+        lines = [
+            f"{'Device':>8} {'Activations':>14} {'Constants':>14} {'IO':>14} "
+            f"{'Workspace':>14} {'Overhead':>14} {'Peak':>14}"
+        ]
+        for device_type, entry in sorted(self.devices.items()):
+            lines.append(
+                f"{device_type:>8} {entry.activation_bytes:>14} {entry.constant_bytes:>14} "
+                f"{entry.io_bytes:>14} {entry.max_operator_workspace_bytes:>14} "
+                f"{entry.overhead_bytes:>14} {entry.peak_bytes:>14}"
+            )
+        lines.append("")
+        lines.append(f"{'Operator':<48} {'Device':>8} {'Workspace':>14} {'IO':>14} {'Live':>14}")
+        for op in self.operators:
+            lines.append(
+                f"{op.name:<48} {op.device_type:>8} {op.workspace_bytes:>14} "
+                f"{op.io_bytes:>14} {op.live_bytes:>14}"
+            )
+        return "\n".join(lines)
+
+    def __str__(self):
+        return self.table()
+
+
+def estimate_peak_memory(function_metadata, overhead_bytes: int = 0) -> PeakMemoryReport:
+    """Estimate the peak memory of a built model from the function metadata of its build,
+    without running it.
+
+    Parameters
+    ----------
+    function_metadata : Map<String, FunctionInfo>
+        The function metadata of the executor factory module returned by relay.build.
+
+    overhead_bytes : int
+        The executor and allocator overhead to add to the estimate of each device type, e.g.
+        the size of the graph executor or VM state and of the allocator bookkeeping.
+
+    Returns
+    -------
+    report : PeakMemoryReport
+        The estimate per device type, with the breakdown by operator.
+    """
+    devices = {}
+
+    def _device(target):
+        device_type = int(target.get_target_device_type())
+        if device_type not in devices:
+            devices[device_type] = DeviceMemory(device_type)
+            devices[device_type].overhead_bytes = overhead_bytes
+        return devices[device_type]
+
+    if MAIN_FUNC_NAME_STR in function_metadata:
+        main_info = function_metadata[MAIN_FUNC_NAME_STR]
+        for target, size in main_info.workspace_sizes.items():
+            _device(target).activation_bytes += int(size)
+        for target, size in main_info.constant_sizes.items():
+            _device(target).constant_bytes += int(size)
+        for target, size in main_info.io_sizes.items():
+            _device(target).io_bytes += int(size)
+
+    operators = []
+    for func_name, info in function_metadata.items():
+        if func_name == MAIN_FUNC_NAME_STR:
+            continue
+        for target, size in info.workspace_sizes.items():
+            io_bytes = int(info.io_sizes.get(target, 0))
+            entry = _device(target)
+            op = OperatorMemory(str(func_name), entry.device_type, int(size), io_bytes)
+            operators.append(op)
+            if op.workspace_bytes > entry.max_operator_workspace_bytes:
+                entry.max_operator_workspace_bytes = op.workspace_bytes
+                entry.peak_operator = op.name
+
+    for op in operators:
+        entry = devices[op.device_type]
+        op.live_bytes = (
+            entry.activation_bytes
+            + entry.constant_bytes
+            + entry.io_bytes
+            + op.workspace_bytes
+            + entry.overhead_bytes
+        )
+    operators.sort(key=lambda op: op.live_bytes, reverse=True)
+    return PeakMemoryReport(devices, operators)
@@ -18,15 +18,19 @@
 """Mostly helper methods which interface the main C++ Collage implementation with Python.
    See relay.transform.CollagePartition for the main Collage entrypoint."""
 
+import json
 import logging
 import os
 import math
 import tempfile
+from concurrent.futures import ThreadPoolExecutor
 
 import numpy as np
 
 import tvm
+from tvm import rpc
 from tvm._ffi.registry import register_func, register_object
+from tvm.contrib.popen_pool import PopenPoolExecutor
 from tvm.runtime import Object
 from . import _ffi_api
 
@@ -86,12 +90,9 @@ def vm_estimate_seconds(device, the_vm, func_name, args):
     )
 
 
-@register_func("tvm.relay.collage.estimate_seconds")
-def estimate_seconds(mod, target):
-    """Returns the mean execution time of "main" in mod on target with params. The module
-    may contain "Primitive" functions, possibly with "Compiler" attributes."""
-    device = tvm.device(target.get_target_device_type())
-
+def compile_to_estimate(mod, target):
+    """Returns the VM bytecode of mod compiled for target, and the path of its exported library,
+    or None if mod cannot be built."""
     try:
         # Build the module.
         logging.info("Compiling module to estimate")
@@ -101,7 +102,7 @@ def estimate_seconds(mod, target):
         # eg trying to build an nn.batch_norm on GPU, which has no schedule since we assume it
         # is only ever used with a tuple projection which is rewritten away.
         logging.info("Assigning module infinite cost since unable to build: %s", err)
-        return math.inf
+        return None
 
     # Finalize compilation
     tmp_dir = tempfile.mkdtemp()
@@ -109,10 +110,13 @@ def estimate_seconds(mod, target):
     lib_path = os.path.join(tmp_dir, "library.so")
     # TODO(mbs): Avoid nvcc dependency?
     lib.export_library(lib_path, workspace_dir=tmp_dir, cc="nvcc")
-    lib = tvm.runtime.load_module(lib_path)
-    exe = tvm.runtime.vm.Executable.load_exec(code, lib)
+    return bytes(code), lib_path
 
-    # Benchmark the module.
+
+def measure_to_estimate(mod, code, lib, device):
+    """Returns the median execution time, in seconds, of "main" in mod compiled to code and lib,
+    on device."""
+    exe = tvm.runtime.vm.Executable.load_exec(code, lib)
     the_vm = tvm.runtime.vm.VirtualMachine(exe, device)
     func_name = "main"
     main_args = {v.name_hint: arg_for(v.checked_type, device) for v in mod[func_name].params}
@@ -122,6 +126,88 @@ def estimate_seconds(mod, target):
     return profile.median  # seconds
 
 
+@register_func("tvm.relay.collage.estimate_seconds")
+def estimate_seconds(mod, target):
+    """Returns the mean execution time of "main" in mod on target with params. The module
+    may contain "Primitive" functions, possibly with "Compiler" attributes."""
+    device = tvm.device(target.get_target_device_type())
+    compiled = compile_to_estimate(mod, target)
+    if compiled is None:
+        return math.inf
+    code, lib_path = compiled
+    return measure_to_estimate(mod, code, tvm.runtime.load_module(lib_path), device)
+
+
+def _compile_to_estimate_worker(mod_json, target_json, pass_context_json):
+    """Runs compile_to_estimate in a worker process, under the pass context of the caller."""
+    mod = tvm.ir.load_json(mod_json)
+    target = tvm.target.Target(json.loads(target_json))
+    opt_level, config_json = json.loads(pass_context_json)
+    config = dict(tvm.ir.load_json(config_json).items())
+    with tvm.transform.PassContext(opt_level=opt_level, config=config):
+        return compile_to_estimate(mod, target)
+
+
+@register_func("tvm.relay.collage.estimate_seconds_batch")
+def estimate_seconds_batch(mods, targets):
+    """Returns the mean execution times of "main" in each of mods on the corresponding targets.
+
+    The modules are compiled in parallel worker processes. They are then measured one at a time
+    on the local device, or in parallel on "relay.collage.rpc_num_devices" remote devices
+    requested with "relay.collage.rpc_key" from the RPC tracker at "relay.collage.rpc_tracker",
+    given as "host:port", when configured in the current pass context."""
+    pass_context = tvm.transform.PassContext.current()
+    config = pass_context.config
+    pass_context_json = json.dumps([pass_context.opt_level, tvm.ir.save_json(config)])
+
+    with PopenPoolExecutor(max_workers=os.cpu_count()) as pool:
+        futures = [
+            pool.submit(
+                _compile_to_estimate_worker,
+                tvm.ir.save_json(mod),
+                json.dumps(target.export()),
+                pass_context_json,
+            )
+            for mod, target in zip(mods, targets)
+        ]
+        compiled = []
+        for future in futures:
+            try:
+                compiled.append(future.result())
+            except Exception as err:  # pylint: disable=broad-except
+                logging.info("Assigning module infinite cost since the build failed: %s", err)
+                compiled.append(None)
+
+    seconds = [math.inf] * len(mods)
+    indices = [i for i, result in enumerate(compiled) if result is not None]
+    tracker = str(config.get("relay.collage.rpc_tracker", ""))
+    if not tracker:
+        for i in indices:
+            code, lib_path = compiled[i]
+            device = tvm.device(targets[i].get_target_device_type())
+            lib = tvm.runtime.load_module(lib_path)
+            seconds[i] = measure_to_estimate(mods[i], code, lib, device)
+    else:
+        host, port = tracker.rsplit(":", 1)
+        key = str(config.get("relay.collage.rpc_key", ""))
+        num_devices = int(config.get("relay.collage.rpc_num_devices", 1))
+
+        def measure_remotely(worker):
+            session = rpc.connect_tracker(host, int(port)).request(key)
+            for i in indices[worker::num_devices]:
+                code, lib_path = compiled[i]
+                remote_name = "collage_estimate_%d.so" % i
+                session.upload(lib_path, target=remote_name)
+                lib = session.load_module(remote_name)
+                device = session.device(targets[i].get_target_device_type())
+                seconds[i] = measure_to_estimate(mods[i], code, lib, device)
+
+        with ThreadPoolExecutor(max_workers=num_devices) as executor:
+            list(executor.map(measure_remotely, range(num_devices)))
+
+    return [tvm.tir.FloatImm("float64", value) for value in seconds]
+
+
 def make_labelled_dfpattern_partition_rule_wrapper(compiler, pattern_tuple):
     """Returns a DFPatternPartitionRule representing one (label, pattern, predicate) entry from
     the pattern table for external codegen compiler"""
@@ -40,6 +40,10 @@ reg.register_broadcast_schedule("nn.relu")
 reg.register_strategy("nn.softmax", strategy.softmax_strategy)
 
 
+# fused_attention
+reg.register_strategy("nn.fused_attention", strategy.fused_attention_strategy)
+
+
 # fast softmax
 reg.register_strategy("nn.fast_softmax", strategy.fast_softmax_strategy)
 
@@ -108,6 +112,18 @@ def alter_op_layout_dense(attrs, inputs, tinfos, out_type):
 reg.register_strategy("nn.contrib_dense_pack", strategy.dense_pack_strategy)
 
 
+# dense_weight_only
+reg.register_strategy("nn.dense_weight_only", strategy.dense_weight_only_strategy)
+
+
+@reg.register_compute("nn.dense_weight_only_pack")
+def compute_dense_weight_only_pack(attrs, inputs, out_type):
+    return [topi.nn.dense_weight_only_pack(inputs[0], attrs.bits)]
+
+
+reg.register_injective_schedule("nn.dense_weight_only_pack")
+
+
 # fifo_buffer
 @reg.register_compute("nn.fifo_buffer")
 def compute_fifo_buffer(attrs, inputs, out_type):
@@ -1667,6 +1667,68 @@ def contrib_dense_pack(data, weight, weight_layout="NC", units=None, out_dtype="
     return _make.contrib_dense_pack(data, weight, weight_layout, units, out_dtype)
 
 
+def dense_weight_only(data, packed_weight, scales, bits=4, group_size=128, out_dtype=""):
+    """Dense operator with a weight quantized to a few bits.
+    Applies a linear transformation, dequantizing the weight while it is reduced
+
+    .. math::
+
+    `Y = X * (W * S)^T`
+
+    The input channels of the weight are quantized in groups of `group_size`, each
+    group of an output channel sharing a scale.
+
+    Parameters
+    ----------
+    data : tvm.relay.Expr
+        The input data to the operator,
+        of shape `(batch, units_in)`.
+
+    packed_weight : tvm.relay.Expr
+        The quantized weight packed by dense_weight_only_pack,
+        of shape `(units, units_in * bits // 32)` and type uint32.
+
+    scales : tvm.relay.Expr
+        The scales of the groups of the weight,
+        of shape `(units, units_in // group_size)`.
+
+    bits : int, optional
+        The number of bits of a quantized value, 2, 4 or 8.
+
+    group_size : int, optional
+        The number of input channels sharing a scale.
+
+    out_dtype : str, optional
+        Specifies the output data type for mixed precision dense.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The computed result.
+    """
+    return _make.dense_weight_only(data, packed_weight, scales, bits, group_size, out_dtype)
+
+
+def dense_weight_only_pack(weight, bits=4):
+    """Pack a weight quantized to a few bits into 32-bit words, for dense_weight_only.
+
+    Parameters
+    ----------
+    weight : tvm.relay.Expr
+        The quantized weight, of shape `(units, units_in)` and an integer type
+        holding values in the signed range of `bits`.
+
+    bits : int, optional
+        The number of bits of a quantized value, 2, 4 or 8.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The packed weight, of shape `(units, units_in * bits // 32)` and type uint32.
+    """
+    return _make.dense_weight_only_pack(weight, bits)
+
+
 def fifo_buffer(data, buffer, axis):
     """FIFO buffer to enable computation reuse in CNNs with sliding indow input
 
@@ -2161,6 +2223,42 @@ def layer_norm(data, gamma, beta, axis=-1, epsilon=1e-5, center=True, scale=True
     return _make.layer_norm(data, gamma, beta, axis, epsilon, center, scale)
 
 
+def fused_attention(query, key, value, scale=None, causal=False):
+    r"""Fused scaled dot-product attention.
+
+    .. math::
+
+        out = softmax(scale * query * key^T) * value
+
+    The softmax is computed row by row, so the full (q_len, kv_len) attention
+    matrix is never materialized.
+
+    Parameters
+    ----------
+    query : tvm.relay.Expr
+        The query with shape (batch, heads, q_len, head_dim).
+
+    key : tvm.relay.Expr
+        The key with shape (batch, heads, kv_len, head_dim).
+
+    value : tvm.relay.Expr
+        The value with shape (batch, heads, kv_len, value_dim).
+
+    scale : float, optional
+        The scale applied to query * key^T. Defaults to 1 / sqrt(head_dim).
+
+    causal : bool, optional, default=False
+        If True, mask out keys after the query position. Query rows are aligned
+        to the end of the key sequence.
+
+    Returns
+    -------
+    result : tvm.relay.Expr
+        The output with shape (batch, heads, q_len, value_dim).
+    """
+    return _make.fused_attention(query, key, value, 0.0 if scale is None else scale, causal)
+
+
 def group_norm(data, gamma, beta, num_groups, axis=1, epsilon=1e-5, center=True, scale=True):
     r"""
     Group normalization normalizes over group of channels for each training examples.
@@ -79,6 +79,16 @@ class DensePackAttrs(Attrs):
     """Attributes for nn.contrib_dense_pack"""
 
 
+@tvm._ffi.register_object("relay.attrs.DenseWeightOnlyAttrs")
+class DenseWeightOnlyAttrs(Attrs):
+    """Attributes for nn.dense_weight_only"""
+
+
+@tvm._ffi.register_object("relay.attrs.DenseWeightOnlyPackAttrs")
+class DenseWeightOnlyPackAttrs(Attrs):
+    """Attributes for nn.dense_weight_only_pack"""
+
+
 @tvm._ffi.register_object("relay.attrs.BatchMatmulAttrs")
 class BatchMatmulAttrs(Attrs):
     """Attributes for nn.batch_matmul"""
@@ -484,6 +494,11 @@ class LayerNormAttrs(Attrs):
     """Attributes used in layer norm operators"""
 
 
+@tvm._ffi.register_object("relay.attrs.FusedAttentionAttrs")
+class FusedAttentionAttrs(Attrs):
+    """Attributes used in fused_attention operators"""
+
+
 @tvm._ffi.register_object("relay.attrs.NdarraySizeAttrs")
 class NdarraySizeAttrs(Attrs):
     """Attributes used in ndarray_size operators"""
@@ -94,6 +94,18 @@ def softmax_strategy_cuda(attrs, inputs, out_type, target):
     return strategy
 
 
+@fused_attention_strategy.register(["cuda", "gpu"])
+def fused_attention_strategy_cuda(attrs, inputs, out_type, target):
+    """fused_attention cuda strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.nn.fused_attention),
+        wrap_topi_schedule(topi.cuda.schedule_fused_attention),
+        name="fused_attention.cuda",
+    )
+    return strategy
+
+
 @fast_softmax_strategy.register(["cuda", "gpu"])
 def fast_softmax_strategy_cuda(attrs, inputs, out_type, target):
     """fast_softmax cuda strategy"""
@@ -1016,6 +1028,18 @@ def batch_matmul_strategy_cuda(attrs, inputs, out_type, target):
     return strategy
 
 
+@dense_weight_only_strategy.register(["cuda", "gpu"])
+def dense_weight_only_strategy_cuda(attrs, inputs, out_type, target):
+    """dense_weight_only cuda strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_dense_weight_only(topi.nn.dense_weight_only),
+        wrap_topi_schedule(topi.gpu.schedule_dense_weight_only),
+        name="dense_weight_only.gpu",
+    )
+    return strategy
+
+
 @sparse_dense_strategy.register(["cuda", "gpu"])
 def sparse_dense_strategy_cuda(attrs, inputs, out_type, target):
     """sparse dense cuda strategy"""
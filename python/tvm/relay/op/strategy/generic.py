@@ -167,6 +167,28 @@ def softmax_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+# fused_attention
+def wrap_compute_fused_attention(topi_compute):
+    """Wrap fused_attention topi compute"""
+
+    def _compute_fused_attention(attrs, inputs, out_type):
+        return [topi_compute(inputs[0], inputs[1], inputs[2], attrs.scale, attrs.causal)]
+
+    return _compute_fused_attention
+
+
+@override_native_generic_func("fused_attention_strategy")
+def fused_attention_strategy(attrs, inputs, out_type, target):
+    """fused_attention generic strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_fused_attention(topi.nn.fused_attention),
+        wrap_topi_schedule(topi.generic.schedule_fused_attention),
+        name="fused_attention.generic",
+    )
+    return strategy
+
+
 @override_native_generic_func("fast_softmax_strategy")
 def fast_softmax_strategy(attrs, inputs, out_type, target):
     """fast softmax generic strategy"""
@@ -896,6 +918,33 @@ def dense_pack_strategy(attrs, inputs, out_type, target):
     return strategy
 
 
+def wrap_compute_dense_weight_only(topi_compute):
+    """wrap dense_weight_only topi compute"""
+
+    def _compute_dense_weight_only(attrs, inputs, out_type):
+        out_dtype = attrs.out_dtype
+        out_dtype = inputs[0].dtype if out_dtype == "" else out_dtype
+        data, packed_weight, scales = inputs
+        return [
+            topi_compute(data, packed_weight, scales, attrs.bits, attrs.group_size, out_dtype)
+        ]
+
+    return _compute_dense_weight_only
+
+
+@override_native_generic_func("dense_weight_only_strategy")
+def dense_weight_only_strategy(attrs, inputs, out_type, target):
+    """dense_weight_only generic strategy"""
+    logger.warning("dense_weight_only is not optimized for this platform.")
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_dense_weight_only(topi.nn.dense_weight_only),
+        wrap_topi_schedule(topi.generic.schedule_dense),
+        name="dense_weight_only.generic",
+    )
+    return strategy
+
+
 # batch_matmul
 def wrap_compute_batch_matmul(
     topi_compute,
@@ -611,6 +611,18 @@ def dense_pack_strategy_cpu(attrs, inputs, out_type, target):
     return strategy
 
 
+@dense_weight_only_strategy.register("cpu")
+def dense_weight_only_strategy_cpu(attrs, inputs, out_type, target):
+    """dense_weight_only x86 strategy"""
+    strategy = _op.OpStrategy()
+    strategy.add_implementation(
+        wrap_compute_dense_weight_only(topi.nn.dense_weight_only),
+        wrap_topi_schedule(topi.x86.schedule_dense_weight_only),
+        name="dense_weight_only.x86",
+    )
+    return strategy
+
+
 @batch_matmul_strategy.register("cpu")
 def batch_matmul_strategy_cpu(attrs, inputs, out_type, target):
     """batch_matmul x86 strategy"""
@@ -19,7 +19,26 @@
 from . import _ffi_api_parser
 
 
-def parse(source, source_name="from_string", init_module=None, init_meta_table=None):
+def parse(
+    source,
+    source_name="from_string",
+    init_module=None,
+    init_meta_table=None,
+    track_spans=True,
+    num_threads=1,
+):
+    """Parse a Relay module from text.
+
+    Parameters
+    ----------
+    track_spans : bool
+        Whether to set the spans of the parsed expressions. The parse errors point into the
+        source either way.
+
+    num_threads : int
+        The number of threads parsing the global functions, 1 to parse them in order on the
+        calling thread, or 0 to use all of the cores.
+    """
     if init_meta_table is None:
         init_meta_table = {}
     return _ffi_api_parser.ParseModuleInContext(  # type: ignore # pylint: disable=no-member
@@ -27,6 +46,8 @@ def parse(source, source_name="from_string", init_module=None, init_meta_table=N
         source,
         init_module,
         init_meta_table,
+        track_spans,
+        num_threads,
     )
 
 
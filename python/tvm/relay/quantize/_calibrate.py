@@ -17,7 +17,9 @@
 """Find scales for quantization on the dataset."""
 from __future__ import absolute_import
 import logging
-import multiprocessing as mp
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
 import numpy as np
 import tvm
 import tvm.driver
@@ -30,25 +32,134 @@ from .. import expr as _expr
 from .. import analysis as _analysis
 from .. import build_module as _build_module
 from ...contrib import graph_executor
-from .kl_divergence import _find_scale_by_kl
+from .kl_divergence import _find_scale_by_kl_hist
 
+# The number of bins of the histograms of absolute values the percentiles are found from.
+_PERCENTILE_NUM_BINS = 65536
 
-def _get_profile_runtime(mod):
+
+def _get_profile_runtimes(mod, num_workers):
+    """Build the stats collector of the module once, and create a graph executor for each worker,
+    on its own device of the target kind when available."""
     func = mod["main"]
     func = _quantize.CreateStatsCollector(func)
 
     if tvm.target.Target.current():
         target = tvm.target.Target.current()
-        dev = tvm.device(target.kind.name)
+        kind = target.kind.name
     else:
-        target = "llvm"
-        dev = tvm.device(target)
+        target = kind = "llvm"
 
     with tvm.transform.PassContext(opt_level=3):
         lib = _build_module.build(func, target=target)
-    runtime = graph_executor.GraphModule(lib["default"](dev))
+    runtimes = []
+    for i in range(num_workers):
+        dev = tvm.device(kind, i)
+        if not dev.exist:
+            dev = tvm.device(kind, 0)
+        runtimes.append(graph_executor.GraphModule(lib["default"](dev)))
+    return runtimes
+
+
+def _get_profile_runtime(mod):
+    return _get_profile_runtimes(mod, 1)[0]
+
+
+def _stream_stats(runtimes, dataset, accumulate):
+    """Run the batches of the dataset on the runtimes in parallel, passing the flattened outputs
+    of each batch to `accumulate`, which must be thread-safe."""
+    batches = iter(dataset)
+    lock = threading.Lock()
+
+    def work(runtime):
+        num_outputs = runtime.get_num_outputs()
+        while True:
+            with lock:
+                batch = next(batches, None)
+            if batch is None:
+                return
+            runtime.set_input(**batch)
+            runtime.run()
+            accumulate([runtime.get_output(j).numpy().reshape(-1) for j in range(num_outputs)])
+
+    with ThreadPoolExecutor(max_workers=len(runtimes)) as pool:
+        for future in [pool.submit(work, runtime) for runtime in runtimes]:
+            future.result()
+
+
+class _StatsAccumulator:
+    """The statistics of each output of the stats collector, accumulated over the batches."""
+
+    def __init__(self, num_outputs):
+        self._lock = threading.Lock()
+        self.min = np.full(num_outputs, np.inf, dtype="float32")
+        self.max = np.full(num_outputs, -np.inf, dtype="float32")
+        self.hists = None
+        self.hist_edges = None
+
+    def add_min_max(self, outputs):
+        mins = [np.min(output) for output in outputs]
+        maxs = [np.max(output) for output in outputs]
+        with self._lock:
+            np.minimum(self.min, mins, out=self.min)
+            np.maximum(self.max, maxs, out=self.max)
+
+    def add_hists(self, outputs, ranges, num_bins, absolute):
+        results = [
+            np.histogram(np.abs(output) if absolute else output, bins=num_bins, range=value_range)
+            for output, value_range in zip(outputs, ranges)
+        ]
+        with self._lock:
+            if self.hists is None:
+                self.hists = [hist.astype("int64") for hist, _ in results]
+                self.hist_edges = [hist_edges for _, hist_edges in results]
+            else:
+                for i, (hist, _) in enumerate(results):
+                    self.hists[i] += hist
+
+
+def collect_hists(mod, dataset, num_bins, absolute=False):
+    """Given an annotated graph, collect the histogram of each simulated_quantize op input over
+    the calibration dataset. The dataset is streamed twice, once for the ranges and once for the
+    histograms, through `calibrate_num_workers` graph executors in parallel, so the memory used
+    does not grow with the dataset.
+
+    Parameters
+    ----------
+    mod: Module
+        The simulation graph after annotation.
+
+    dataset: Iterable[NDArray]
+        The calibration dataset.
 
-    return runtime
+    num_bins: int
+        The number of bins of the histograms.
+
+    absolute: bool
+        Whether to collect the histograms of the absolute values over [0, max], instead of the
+        histograms of the values over [-max, max], with max the maximum absolute value.
+
+    Returns
+    -------
+    ret: Tuple[List[np.ndarray], List[np.ndarray]]
+        The histogram and the bin edges of each input.
+    """
+    cfg = quantize.current_qconfig()
+    runtimes = _get_profile_runtimes(mod, max(cfg.calibrate_num_workers, 1))
+    if iter(dataset) is dataset:
+        # Both passes iterate over the dataset.
+        dataset = list(dataset)
+    stats = _StatsAccumulator(runtimes[0].get_num_outputs())
+    logging.info("collecting statistics for calibration...")
+    _stream_stats(runtimes, dataset, stats.add_min_max)
+    thresholds = np.maximum(np.abs(stats.min), np.abs(stats.max))
+    ranges = [(0, thres) if absolute else (-thres, thres) for thres in thresholds]
+    _stream_stats(
+        runtimes,
+        dataset,
+        lambda outputs: stats.add_hists(outputs, ranges, num_bins, absolute),
+    )
+    return stats.hists, stats.hist_edges
 
 
 def collect_stats(mod, dataset, chunk_by=-1):
@@ -91,13 +202,9 @@ def collect_stats(mod, dataset, chunk_by=-1):
 
 
 def _kl_scale(mod, dataset):
-    cfg = quantize.current_qconfig()
-    chunk_by = cfg.calibrate_chunk_by
-    scales = []
-    for samples in collect_stats(mod, dataset, chunk_by):
-        logging.info("finding threshold with kl for calibration...")
-        with mp.Pool() as pool:
-            scales += list(pool.map(_find_scale_by_kl, samples))
+    hists, hist_edges = collect_hists(mod, dataset, num_bins=8001)
+    logging.info("finding threshold with kl for calibration...")
+    scales = [_find_scale_by_kl_hist(hist, edges) for hist, edges in zip(hists, hist_edges)]
 
     def func(_):
         scale = scales[func.scale_idx]
@@ -116,14 +223,20 @@ def _find_scale_by_percentile(arr, percentile=0.99999):
     return np.partition(x, max_k)[max_k]
 
 
+def _find_scale_by_percentile_hist(hist, hist_edges, percentile=0.99999):
+    """The percentile of the absolute values of a tensor from their histogram, rounded up to the
+    edge of its bin."""
+    max_k = int(np.sum(hist) * percentile)
+    idx = int(np.searchsorted(np.cumsum(hist), max_k, side="right"))
+    return hist_edges[min(idx + 1, len(hist_edges) - 1)]
+
+
 def _percentile_scale(mod, dataset):
-    cfg = quantize.current_qconfig()
-    chunk_by = cfg.calibrate_chunk_by
-    scales = []
-    for samples in collect_stats(mod, dataset, chunk_by):
-        logging.info("finding threshold with percentile for calibration...")
-        with mp.Pool() as pool:
-            scales += list(pool.map(_find_scale_by_percentile, samples))
+    hists, hist_edges = collect_hists(mod, dataset, _PERCENTILE_NUM_BINS, absolute=True)
+    logging.info("finding threshold with percentile for calibration...")
+    scales = [
+        _find_scale_by_percentile_hist(hist, edges) for hist, edges in zip(hists, hist_edges)
+    ]
 
     def func(_):
         scale = scales[func.scale_idx]
@@ -135,10 +248,34 @@ def _percentile_scale(mod, dataset):
     return func
 
 
+def _weight_channel_axes(func, quantize_op):
+    """The output channel axis of each weight simulated_quantize consumed by conv2d or dense."""
+    channel_axes = {}
+
+    def visit_func(expr):
+        if not isinstance(expr, _expr.Call) or not isinstance(expr.op, tvm.ir.Op):
+            return
+        if expr.op.name == "nn.conv2d":
+            axis = expr.attrs.kernel_layout.index("O")
+        elif expr.op.name == "nn.dense":
+            axis = 0
+        else:
+            return
+        weight = expr.args[1]
+        if isinstance(weight, _expr.Call) and weight.op == quantize_op:
+            channel_axes.setdefault(weight, axis)
+
+    _analysis.post_order_visit(func, visit_func)
+    return channel_axes
+
+
 def _set_params(mod, input_scale_func, weight_scale_func):
     quantize_op = _op.get("relay.op.annotation.simulated_quantize")
     cfg = quantize.current_qconfig()
     const_params = {}
+    channel_axes = {}
+    if cfg.weight_per_channel:
+        channel_axes = _weight_channel_axes(mod["main"], quantize_op)
 
     def visit_func(expr):
         """visitor function for traverse"""
@@ -152,7 +289,7 @@ def _set_params(mod, input_scale_func, weight_scale_func):
             # set scale
             if kind == quantize.QAnnotateKind.WEIGHT:
                 assert isinstance(expr.args[0], _expr.Constant)
-                scale = weight_scale_func(expr)
+                scale = weight_scale_func(expr, channel_axes.get(expr))
             else:
                 scale = input_scale_func(expr)
 
@@ -175,18 +312,31 @@ def _set_params(mod, input_scale_func, weight_scale_func):
 
 
 # weight scale functions
-def _power2_scale(sq_call):  # pylint: disable=unused-argument
-    """calculate weight scale with nearest mode-2 scale"""
+def _channel_max(weight, channel_axis):
+    """The maximum absolute value of each channel, shaped to broadcast along the channel axis,
+    with 1.0 for the channels of zeros."""
+    axes = tuple(i for i in range(weight.ndim) if i != channel_axis)
+    val = np.amax(np.abs(weight), axis=axes, keepdims=True).astype("float32")
+    return np.where(val > 0, val, np.float32(1.0))
+
+
+def _power2_scale(sq_call, channel_axis=None):  # pylint: disable=unused-argument
+    """calculate weight scale with nearest mode-2 scale, per channel if given an axis"""
     var = sq_call.args[0]
     assert isinstance(var, _expr.Constant)
+    if channel_axis is not None:
+        val = _channel_max(var.data.numpy(), channel_axis)
+        return np.power(2.0, np.ceil(np.log2(val))).astype("float32")
     val = np.amax(np.abs(var.data.numpy()))
     return 2 ** np.math.ceil(np.math.log(val, 2)) if val > 0 else 1.0
 
 
-def _max_scale(sq_call):
-    """calculate weight scale with maximum absolute value"""
+def _max_scale(sq_call, channel_axis=None):
+    """calculate weight scale with maximum absolute value, per channel if given an axis"""
     var = sq_call.args[0]
     assert isinstance(var, _expr.Constant)
+    if channel_axis is not None:
+        return _channel_max(var.data.numpy(), channel_axis)
     val = np.amax(np.abs(var.data.numpy()))
     return val
 
@@ -39,14 +39,23 @@ def _find_scale_by_kl(arr, quantized_dtype="int8", num_bins=8001, num_quantized_
         # We need to move negative bins to positive bins to fit uint8 range.
         num_quantized_bins = num_quantized_bins * 2 + 1
 
+    hist, hist_edges = np.histogram(arr, bins=num_bins, range=(-thres, thres))
+    return _find_scale_by_kl_hist(hist, hist_edges, num_quantized_bins)
+
+
+def _find_scale_by_kl_hist(hist, hist_edges, num_quantized_bins=255):
+    """Find the optimal threshold from the histogram of a tensor over [-thres, thres], which
+    may be accumulated over several batches."""
+
     def get_pointer(arr, ctypes_type):
         ptr = arr.ctypes.data_as(ctypes.POINTER(ctypes_type))
         return ctypes.cast(ptr, ctypes.c_void_p)
 
-    hist, hist_edges = np.histogram(arr, bins=num_bins, range=(-thres, thres))
-    hist_ptr = get_pointer(hist.astype(np.int32), ctypes.c_int)
+    hist = np.ascontiguousarray(hist, dtype=np.int32)
+    hist_edges = np.ascontiguousarray(hist_edges, dtype=np.float32)
+    hist_ptr = get_pointer(hist, ctypes.c_int)
     hist_edges_ptr = get_pointer(hist_edges, ctypes.c_float)
 
     return _quantize.FindScaleByKLMinimization(
-        hist_ptr, hist_edges_ptr, num_bins, num_quantized_bins
+        hist_ptr, hist_edges_ptr, hist.size, num_quantized_bins
     )
@@ -86,6 +86,8 @@ class QConfig(Object):
         "debug_enabled_ops": None,
         "rounding": "UPWARD",
         "calibrate_chunk_by": -1,
+        "calibrate_num_workers": 1,
+        "weight_per_channel": False,
         "partition_conversions": "disabled",
     }
 
@@ -180,6 +182,15 @@ def qconfig(**kwargs):
     rounding: "UPWARD" or "TONEAREST"
         Rounding direction for fixed point multiplications.
 
+    calibrate_num_workers: int
+        The number of graph executors running the calibration dataset in parallel, each on its
+        own device of the target kind when available. Their statistics are accumulated batch by
+        batch, without keeping the outputs of the whole dataset.
+
+    weight_per_channel: boolean
+        Whether to find the scales of conv2d and dense weights per output channel. The outputs
+        of these ops are rescaled to a per-tensor scale right after them.
+
     partition_conversions: 'disabled', 'enabled', or 'fully_integral'
         If set to 'enabled' or 'fully_integral', partitions a quantized
         result into a module containing
@@ -16,7 +16,7 @@
 # under the License.
 # pylint: disable=line-too-long,unused-argument
 """Default behavior for ops in mixed_precision pass. Import this file to use."""
-from typing import List
+from typing import Any, Dict, Iterable, List
 
 from tvm.relay.op import register_mixed_precision_conversion
 
@@ -198,3 +198,54 @@ def generic_follow_op(call_node: "relay.Call", mixed_precision_type: str) -> Lis
 @register_func_to_op_list(list_ops=DEFAULT_NEVER_LIST)
 def generic_never_op(call_node: "relay.Call", mixed_precision_type: str) -> List:
     return [MIXED_PRECISION_NEVER] + get_generic_out_dtypes(call_node, mixed_precision_type)
+
+
+def calibrate_fp8(
+    mod: "tvm.IRModule",
+    dataset: Iterable[Dict[str, Any]],
+    mixed_precision_type: str = "e4m3_float8",
+    target: str = "llvm",
+) -> List[float]:
+    """Calibrate the per-tensor scales of ToMixedPrecision to FP8 dtypes, by running the FP32
+    module on a dataset and recording the absolute maximum of each arg converted to FP8.
+
+    Parameters
+    ----------
+    mod: tvm.IRModule
+        The FP32 module, whose "main" function is calibrated.
+    dataset: Iterable[Dict[str, Any]]
+        The inputs of "main", by parameter name, for each calibration sample.
+    mixed_precision_type: str
+        The FP8 dtype, "e4m3_float8" or "e5m2_float8".
+    target: str
+        The target to run the calibration on.
+
+    Returns
+    -------
+    fp8_amax : List[float]
+        The absolute maximum of each FP8 arg, to pass to ToMixedPrecision.
+    """
+    # pylint: disable=import-outside-toplevel
+    import numpy as np
+
+    import tvm
+    from tvm import relay
+
+    from . import _ffi_api
+
+    mod = relay.transform.InferType()(mod)
+    func = mod["main"]
+    taps = list(_ffi_api.FP8CalibrationTaps(func, mixed_precision_type))
+    if not taps:
+        return []
+    functions = {gvar: f for gvar, f in mod.functions.items() if gvar.name_hint != "main"}
+    calib_mod = tvm.IRModule.from_expr(relay.Function(func.params, relay.Tuple(taps)), functions)
+    run = relay.create_executor(
+        "graph", mod=calib_mod, device=tvm.device(target, 0), target=target
+    ).evaluate()
+    amax = [0.0] * len(taps)
+    for inputs in dataset:
+        outputs = run(**inputs)
+        for i, output in enumerate(outputs):
+            amax[i] = max(amax[i], float(np.abs(output.numpy()).max()))
+    return amax
@@ -261,6 +261,25 @@ def LazyGradientInit():
     return _ffi_api.LazyGradientInit()
 
 
+def AnnotateCheckpoints(memory_budget_bytes=0):
+    """Wrap segments of the dataflow of each function in annotation.checkpoint, so that the
+    higher order gradient recomputes their intermediate values in the backward pass instead of
+    keeping them alive. Run it before ``relay.transform.gradient(..., mode="higher_order")``.
+
+    Parameters
+    ----------
+    memory_budget_bytes : int
+        The bytes of the intermediate values of a segment, at most when possible. If 0, the
+        values are split in sqrt(N) segments, N being the number of values.
+
+    Returns
+    -------
+    ret: tvm.transform.Pass
+        The registered pass that annotates the checkpoints.
+    """
+    return _ffi_api.AnnotateCheckpoints(memory_budget_bytes)
+
+
 def FoldConstantExpr(expr, mod, fold_qnn=False):
     """Fold the constant expressions in a Relay program.
     Parameters
@@ -511,6 +530,67 @@ def ConvertLayout(desired_layouts):
     return _ffi_api.ConvertLayout(desired_layouts)
 
 
+def ConvertLayoutAuto(candidate_layouts, kernel_cost=None, database=None, target=None):
+    """Convert the layouts like ConvertLayout, selecting the desired layouts of each call among
+    candidates. The selection minimizes the cost of the kernels plus the cost of the layout
+    transforms needed between the calls and at the boundary of the function.
+
+    Parameters
+    ----------
+    candidate_layouts : map of op_name to list of list of layouts
+        Specify a mapping of operator names to the candidate lists of layouts to convert to, each
+        in the format of ConvertLayout. An example for nn.conv2d could be:
+        {"nn.conv2d": [["NCHW", "default"], ["NHWC", "default"]]}. Include the current layouts to
+        allow keeping them.
+
+    kernel_cost : Optional[Callable[[tvm.relay.Call, List[str]], float]]
+        The function returning the cost of a call converted to the given layouts in seconds,
+        or a negative value if not supported. If not given, the costs are queried from
+        `database`, or only the layout transforms are accounted for.
+
+    database : Optional[tvm.meta_schedule.Database]
+        The tuning database the kernel costs are queried from when `kernel_cost` is not given.
+        Candidates whose kernels have no tuning record are not selected.
+
+    target : Optional[tvm.target.Target]
+        The target of the tuning records, required with `database`.
+
+    Returns
+    -------
+    pass: FunctionPass
+      The pass.
+    """
+    if kernel_cost is None and database is not None:
+        if target is None:
+            raise ValueError("`target` is required to query kernel costs from `database`")
+        kernel_cost = _database_kernel_cost(database, tvm.target.Target(target))
+    return _ffi_api.ConvertLayoutAuto(candidate_layouts, kernel_cost)
+
+
+def _database_kernel_cost(database, target):
+    """The kernel cost of ConvertLayoutAuto, from the tuning records of the converted kernels."""
+    # pylint: disable=import-outside-toplevel
+    from tvm.meta_schedule.relay_integration import extract_tasks
+
+    def kernel_cost(call, layouts):
+        params = [relay.var("p%d" % i, arg.checked_type) for i, arg in enumerate(call.args)]
+        func = relay.Function(params, relay.Call(call.op, params, call.attrs))
+        mod = ConvertLayout({call.op.name: list(layouts)})(tvm.IRModule.from_expr(func))
+        cost = 0.0
+        for task in extract_tasks(mod, target, params=None):
+            record = database.query_tuning_record(task.dispatched[0], target, task.task_name)
+            if record is None or not record.run_secs:
+                # The layout transforms around the kernel are accounted for by the pass.
+                if "layout_transform" in task.task_name:
+                    continue
+                return -1.0
+            run_secs = [float(sec) for sec in record.run_secs]
+            cost += task.weight * sum(run_secs) / len(run_secs)
+        return cost
+
+    return kernel_cost
+
+
 def Legalize(legalize_map_attr_name="FTVMLegalize"):
     """Legalizes an expression with another expression.
     This pass can be used to replace an expr with another expr for target
@@ -1163,6 +1243,36 @@ def Conv2dToSparse2(layout, kernel_size, blocksize, sparsity_threshold):
     return _ffi_api.Conv2dToSparse2(layout, kernel_size, *blocksize, sparsity_threshold)
 
 
+def ToSparseAuto(blocksizes=((16, 1), (8, 1), (4, 1)), sparsity_threshold=0.5, kernel_cost=None):
+    """
+    Rewrite ```nn.dense``` and 1x1 ```nn.conv2d``` operations with freezed block sparse weights
+    to ```nn.sparse_dense``` and ```nn.sparse_conv2d```, detecting the sparse weights in the pass
+    instead of ```analysis.sparse_dense.process_params```. Among the block sizes the sparsity of
+    a weight reaches the threshold for, the cheapest BSR version is selected, and replaces the
+    operation when cheaper than it.
+
+    Parameters
+    ----------
+    blocksizes : List[Tuple[int, int]]
+        Candidate blocksizes for the BSR matrices.
+
+    sparsity_threshold : float
+        Minimal sparsity of the weight in a blocksize for converting with it.
+
+    kernel_cost : Optional[Callable[[tvm.relay.Call], float]]
+        The function returning the cost of a dense or sparse call in seconds, or a negative value
+        if not supported. The sparse calls are not type inferred. If not given, the costs are
+        estimated from the number of multiply-adds and nonzero blocks.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered ToSparseAuto pass.
+    """
+    blocksizes = [list(blocksize) for blocksize in blocksizes]
+    return _ffi_api.ToSparseAuto(blocksizes, sparsity_threshold, kernel_cost)
+
+
 def SimplifyFCTranspose(target_weight_name):
     """
     Rewrite ```y = nn.dense(x, transpose(w, [1, 0]))``` to ```y = nn.dense(x, wt)```
@@ -1203,6 +1313,12 @@ def PlanDevices(config):
     config. However data and computations which must be hosted on a CPU (such as shapes and
     shape functions) use the host virtual device of the config.
 
+    When the "relay.PlanDevices.auto_placement" pass config option is true, primitive calls which
+    are not annotated are first placed on the primitive target minimizing their estimated cost
+    plus the cost of copies between devices. Calls such as argwhere and non-maximum suppression
+    stay on the CPU. A function registered as "relay.PlanDevices.op_cost", taking a call and a
+    target and returning seconds (negative for the built-in estimate), overrides the estimate.
+
     Parameters
     ----------
     config : tvm.CompilationConfig
@@ -1224,6 +1340,22 @@ def ManifestLifetimes():
     return _ffi_api.ManifestLifetimes()
 
 
+def AnnotateShapeUpperBounds():
+    """
+    Annotate the fused primitive calls of main whose results have dynamic shapes with static
+    upper bounds of their result types. The bounds are inferred from the upper bounds of the
+    input shapes given by the pass config option "relay.vm.shape_upper_bounds", a list of
+    [input name, upper bound shape] pairs. ManifestAlloc then sizes the storages of these
+    results for the bounds.
+
+    Returns
+    -------
+    ret : tvm.transform.Pass
+        The registered pass that annotates the upper bounds.
+    """
+    return _ffi_api.AnnotateShapeUpperBounds()
+
+
 def FoldExplicitPadding():
     """
     FoldExplicitPadding finds explict padding before an op that can support
@@ -1340,7 +1472,7 @@ def FlattenAtrousConv():
     return _ffi_api.FlattenAtrousConv()
 
 
-def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1):
+def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1, fp8_amax=None):
     """
     Automatic mixed precision rewriter. Rewrite an FP32 relay graph into a version
     where as many operations as possible are in the target mixed_precision_type.
@@ -1348,7 +1480,9 @@ def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1):
     Parameters
     ----------
     mixed_precision_type: str
-      The target datatype to transform operations in the graph to use.
+      The target datatype to transform operations in the graph to use. With "e4m3_float8"
+      or "e5m2_float8", the conv, dense and batch_matmul like operations run on per-tensor
+      scaled FP8 args, and the other operations are kept in FP32.
 
     missing_op_mode: int
       Determines how to handle ops not registered with FTVMMixedPrecisionConversionType
@@ -1363,6 +1497,11 @@ def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1):
       This parameter is not part of explicit arguments of the transformation, but should
       be passed through tvm.transform.PassContext.
 
+    fp8_amax: Optional[List[float]]
+      The calibrated absolute maximum of each FP8 arg, as returned by
+      `mixed_precision.calibrate_fp8`. The scales of the args without it are computed
+      at runtime.
+
     Returns
     -------
     ret : tvm.transform.Pass
@@ -1370,7 +1509,8 @@ def ToMixedPrecision(mixed_precision_type="float16", missing_op_mode=1):
     """
     if missing_op_mode < 0 or missing_op_mode > 2:
         raise ValueError("Missing op mode is either 0, 1, or 2")
-    return _ffi_api.ToMixedPrecision(mixed_precision_type, missing_op_mode)
+    fp8_amax = [tvm.tir.FloatImm("float32", amax) for amax in (fp8_amax or [])]
+    return _ffi_api.ToMixedPrecision(mixed_precision_type, missing_op_mode, fp8_amax)
 
 
 def SplitArgs(max_function_args):
@@ -20,6 +20,7 @@ import os
 import socket
 import stat
 import struct
+import sys
 import time
 
 import tvm._ffi
@@ -72,6 +73,30 @@ class RPCSession(object):
         """
         return self._sess.get_function(name)
 
+    def get_function_async(self, name, mod=None):
+        """Get a function sending its calls without waiting for them to return.
+
+        A call returns a future at once, calling the future waits for the call
+        and returns its result or raises its error. The calls in flight are
+        served by the remote in order, so issuing several of them before waiting
+        hides the round-trip latency of the connection.
+
+        Parameters
+        ----------
+        name : str
+            The name of the function
+
+        mod : Optional[tvm.runtime.Module]
+            The remote module containing the function, a global function of the
+            session by default.
+
+        Returns
+        -------
+        f : Function
+            The result function.
+        """
+        return _ffi_api.GetAsyncFunction(mod if mod is not None else self._sess, name)
+
     def device(self, dev_type, dev_id=0):
         """Construct a remote device.
 
@@ -280,6 +305,23 @@ class PopenSession(RPCSession):
         RPCSession.__init__(self, _popen_session(binary))
 
 
+class ShmSession(RPCSession):
+    """RPCSession interface backed by a server process on the same host,
+    communicating through shared memory.
+
+    Parameters
+    ----------
+    cmd : Optional[List[str]]
+        The command starting the server, the file descriptor of the shared
+        memory is appended to it. By default a server in a new Python process.
+    """
+
+    def __init__(self, cmd=None):
+        if cmd is None:
+            cmd = [sys.executable, "-m", "tvm.exec.rpc_shm_server"]
+        RPCSession.__init__(self, _ffi_api.CreateShmClient(*cmd))
+
+
 class TrackerSession(object):
     """Tracker client session.
 
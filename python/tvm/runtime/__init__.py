@@ -23,7 +23,7 @@ from .object_path import ObjectPath, ObjectPathPair
 from .script_printer import Scriptable
 from .object_generic import ObjectGeneric, ObjectTypes
 from .ndarray import NDArray, DataType, DataTypeCode, Device
-from .module import Module, num_threads
+from .module import Module, num_threads, create_thread_pool
 from .profiling import Report
 
 # function exposures
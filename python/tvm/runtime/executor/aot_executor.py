@@ -18,6 +18,9 @@
 
 import numpy as np
 
+from ..ndarray import NDArray, array
+from .async_run import submit
+
 
 class AotModule(object):
     """Wraps the AOT executor runtime.Module.
@@ -113,6 +116,36 @@ class AotModule(object):
             self.set_input(**input_dict)
         self._run()
 
+    def warmup(self):
+        """Do the lazy initialization of the kernels, e.g. loading the device modules, without
+        running the model, so that the first run is not slowed down by it.
+        """
+        self.module["warmup"]()
+
+    def run_async(self, **input_dict):
+        """Run forward execution of the model asynchronously.
+
+        The runs of the executor execute one after the other on a small pool of host
+        threads, so that the calling thread is not blocked. The executor must not be
+        used synchronously while runs are pending.
+
+        Parameters
+        ----------
+        input_dict: dict of str to NDArray
+            List of input values to be feed to
+
+        Returns
+        -------
+        future : concurrent.futures.Future
+            The future of the list of outputs, copied out of the executor.
+        """
+        args = []
+        for key, value in input_dict.items():
+            if not isinstance(value, NDArray):
+                value = array(value)
+            args += [key, value]
+        return submit(self.module["run_async"], *args, convert=list)
+
     def get_num_outputs(self):
         """Get the number of outputs from the model
 
@@ -165,6 +198,79 @@ class AotModule(object):
         """
         return self._get_input_index(name)
 
+    def load_params(self, params_bytes):
+        """Load parameters from serialized byte array of parameter dict.
+
+        Parameters
+        ----------
+        params_bytes : bytearray
+            The serialized parameter dict.
+        """
+        self.module["load_params"](bytearray(params_bytes))
+
+    def load_params_from_file(self, path):
+        """Load parameters from a file of serialized parameter dict.
+
+        The tensors are streamed into the inputs one at a time, so the file is never
+        held in memory as a whole.
+
+        Parameters
+        ----------
+        path : str
+            The path of a file written by :py:func:`tvm.runtime.save_param_dict`.
+        """
+        self.module["load_params_from_file"](path)
+
+    def create_context(self):
+        """Create an execution context of the model.
+
+        The context shares the code, the constants and the parameters loaded by
+        :py:meth:`load_params` with this module, and only owns its other inputs, its
+        outputs and its workspace pools. The contexts of one module can thus run
+        concurrently, e.g. one per thread, without duplicating the constants.
+
+        Returns
+        -------
+        context : AotModule
+            The execution context.
+        """
+        return AotModule(self.module["create_context"]())
+
+    def set_thread_pool(self, name):
+        """Run the model on a named thread pool.
+
+        Parameters
+        ----------
+        name : str
+            The name of a pool created by :py:func:`tvm.runtime.create_thread_pool`,
+            an empty string restores the default thread pool.
+        """
+        self.module["set_thread_pool"](name)
+
+    def set_sampling_interval(self, interval):
+        """Time every Nth run with the device timers, so that it can stay on while serving.
+
+        The operators are inlined in the entrypoint of the model, so a run is timed as a
+        whole. Setting the interval drops the samples so far.
+
+        Parameters
+        ----------
+        interval : int
+            Sample every ``interval``-th run, 0 turns sampling off.
+        """
+        self.module["set_sampling_interval"](interval)
+
+    def get_sampled_profile(self):
+        """Get the latencies of the sampled runs.
+
+        Returns
+        -------
+        report : tvm.runtime.profiling.Report
+            The number of samples, the mean latency and the ``p50 (us)``, ``p90 (us)``
+            and ``p99 (us)`` latency percentiles over the latest samples.
+        """
+        return self.module["get_sampled_profile"]()
+
     def get_output(self, index, out=None):
         """Get index-th output to out
 
@@ -0,0 +1,57 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Futures of the asynchronous runs of the executors."""
+import concurrent.futures
+
+from tvm._ffi.base import TVMError
+
+
+def submit(run_async, *args, convert=None):
+    """Call the asynchronous run function of an executor.
+
+    The run executes on a pool of host threads of the runtime, after the previous
+    asynchronous runs of the executor. On an accelerator, the pool thread issues it
+    to a stream of its own.
+
+    Parameters
+    ----------
+    run_async : PackedFunc
+        The run_async or invoke_async function of the executor, called with a callback
+        followed by args.
+
+    args : list
+        The arguments of the run.
+
+    convert : Optional[Callable]
+        Converts the result of the run into the result of the future.
+
+    Returns
+    -------
+    future : concurrent.futures.Future
+        The future of the result of the run.
+    """
+    future = concurrent.futures.Future()
+    future.set_running_or_notify_cancel()
+
+    def _callback(result, error):
+        if error:
+            future.set_exception(TVMError(error))
+        else:
+            future.set_result(convert(result) if convert else result)
+
+    run_async(_callback, *args)
+    return future
@@ -73,6 +73,21 @@ class BenchmarkResult:
         self.min = np.min(self.results)
         self.max = np.max(self.results)
 
+    def percentile(self, q):
+        """Compute a percentile of the results.
+
+        Parameters
+        ----------
+        q : float or Sequence[float]
+            The percentile(s) to compute, between 0 and 100.
+
+        Returns
+        -------
+        percentile : float or np.ndarray
+            The percentile(s) of the results, in seconds.
+        """
+        return np.percentile(self.results, q)
+
     def __repr__(self):
         return (
             f"BenchmarkResult(min={self.min}, mean={self.mean}, median={self.median}, "
@@ -317,6 +332,8 @@ class Module(object):
         cooldown_interval_ms=0,
         repeats_to_cooldown=1,
         f_preproc="",
+        max_rel_ci=0.0,
+        max_measure_ms=0,
     ):
         """Get an evaluator that measures time cost of running function.
 
@@ -361,6 +378,15 @@ class Module(object):
         f_preproc: str, optional
             The preprocess function name we want to execute before executing the time evaluator.
 
+        max_rel_ci: float, optional
+            If positive, keep repeating the measurement after `repeat` repeats until the half
+            width of the 95% confidence interval on the mean of the repeats falls below this
+            fraction of the mean, e.g. 0.01 for 1%.
+
+        max_measure_ms: int, optional
+            The cap on the duration of all repeats in milliseconds, which stops an adaptive
+            measurement that does not converge. Required when `max_rel_ci` is positive.
+
         Note
         ----
         The function will be invoked  (1 + number x repeat) times,
@@ -370,7 +396,8 @@ class Module(object):
         -------
         ftimer : function
             The function that takes same argument as func and returns a BenchmarkResult.
-            The ProfileResult reports `repeat` time costs in seconds.
+            The ProfileResult reports `repeat` time costs in seconds, or at least `repeat` of
+            them when `max_rel_ci` is positive.
         """
         try:
             feval = _ffi_api.RPCTimeEvaluator(
@@ -385,13 +412,15 @@ class Module(object):
                 cooldown_interval_ms,
                 repeats_to_cooldown,
                 f_preproc,
+                max_rel_ci,
+                max_measure_ms,
             )
 
             def evaluator(*args):
                 """Internal wrapped evaluator."""
                 # Wrap feval so we can add more stats in future.
                 blob = feval(*args)
-                fmt = "@" + ("d" * repeat)
+                fmt = "@" + ("d" * (len(blob) // struct.calcsize("d")))
                 results = struct.unpack(fmt, blob)
                 return BenchmarkResult(results)
 
@@ -434,7 +463,16 @@ class Module(object):
     def _collect_dso_modules(self):
         return self._collect_from_import_tree(lambda m: m.is_dso_exportable)
 
-    def export_library(self, file_name, fcompile=None, addons=None, workspace_dir=None, **kwargs):
+    def export_library(
+        self,
+        file_name,
+        fcompile=None,
+        addons=None,
+        workspace_dir=None,
+        compress_imports=None,
+        lazy_imports=True,
+        **kwargs,
+    ):
         """
         Export the module and all imported modules into a single device library.
 
@@ -466,6 +504,17 @@ class Module(object):
             artifacts when exporting the module.
             If this is not provided a temporary dir will be created.
 
+        compress_imports : str, optional
+            The compression of the imported device modules packed into the library,
+            "none" or "lz4". When set, each imported module is decoded on its first use
+            instead of when the library is loaded.
+
+        lazy_imports : bool, optional
+            Whether the imported modules are packed uncompressed to be decoded on their first
+            use when compress_imports is not set. With the names of their functions recorded,
+            a loaded library only decodes and initializes the modules whose functions are used.
+            Set it to False for libraries loaded by a runtime predating lazy imports.
+
         kwargs : dict, optional
             Additional arguments passed to fcompile
 
@@ -562,20 +611,26 @@ class Module(object):
 
         if self.imported_modules:
             pack_lib_prefix = system_lib_prefix if system_lib_prefix else ""
+            if compress_imports is None:
+                compress_imports = "none" if lazy_imports else ""
 
             if enabled("llvm") and llvm_target_string:
                 path_obj = os.path.join(
                     workspace_dir, f"{pack_lib_prefix}devc.{global_object_format}"
                 )
                 m = _ffi_api.ModulePackImportsToLLVM(
-                    self, is_system_lib, llvm_target_string, pack_lib_prefix
+                    self, is_system_lib, llvm_target_string, pack_lib_prefix, compress_imports
                 )
                 m.save(path_obj)
                 files.append(path_obj)
             else:
                 path_cc = os.path.join(workspace_dir, f"{pack_lib_prefix}devc.c")
                 with open(path_cc, "w") as f:
-                    f.write(_ffi_api.ModulePackImportsToC(self, is_system_lib, pack_lib_prefix))
+                    f.write(
+                        _ffi_api.ModulePackImportsToC(
+                            self, is_system_lib, pack_lib_prefix, compress_imports
+                        )
+                    )
                 files.append(path_cc)
 
         # The imports could contain a c module but the object format could be tar
@@ -696,6 +751,23 @@ def enabled(target):
     return _ffi_api.RuntimeEnabled(target)
 
 
+def create_thread_pool(name, cpus):
+    """Create a named thread pool with one worker pinned to each of the given cores.
+
+    Executors bound to the pool with ``set_thread_pool`` run their parallel kernels
+    on its cores only, which isolates models served from the same process.
+
+    Parameters
+    ----------
+    name : str
+        The name of the pool.
+
+    cpus : List[int]
+        The cores of the pool.
+    """
+    _ffi_api.CreateThreadPool(name, [str(cpu) for cpu in cpus])
+
+
 def num_threads() -> int:
     """Get the number of threads in use by the TVM runtime.
 
@@ -68,7 +68,7 @@ class NDArray(NDArrayBase):
         """Device of this array"""
         return self.handle.contents.device
 
-    def __dlpack__(self, stream=None):  # pylint: disable=unused-argument
+    def __dlpack__(self, stream=None):
         """Export the array for consumption by from_dlpack() as a DLPack capsule.
 
         Parameters
@@ -77,13 +77,22 @@ class NDArray(NDArrayBase):
             A Python integer representing a pointer to a stream.
             Stream is provided by the consumer to the producer to instruct the producer
             to ensure that operations can safely be performed on the array.
+            Following the DLPack convention, None is the default stream, 1 and 2 the
+            legacy and per-thread default streams of CUDA, and -1 skips the ordering.
+            The work submitted to the current stream of the device is ordered before
+            the consumer stream with an event, without blocking the host.
 
         Returns
         -------
         capsule : PyCapsule
             A DLPack capsule for the array, containing a DLPackManagedTensor.
         """
-        return self.to_dlpack()
+        device_type = self.device.device_type
+        if stream == -1 or device_type not in (Device.kDLCUDA, Device.kDLROCM):
+            return self.to_dlpack()
+        if stream is None:
+            stream = 1 if device_type == Device.kDLCUDA else 0
+        return self.to_dlpack(stream)
 
     def __dlpack_device__(self):
         """Return a tuple of device_type, device_id in DLPack convention"""
@@ -383,6 +392,9 @@ def from_dlpack(dltensor):
     data. Removes the original DLPack tensor's destructor as now the array is
     responsible for destruction.
 
+    For a GPU object with __dlpack__, the current stream of its device is passed to
+    the producer, which orders its pending work before it without blocking the host.
+
     Parameters
     ----------
     dltensor : object with __dlpack__ attribute or a DLPack capsule
@@ -397,7 +409,19 @@ def from_dlpack(dltensor):
         return _from_dlpack(dltensor)
 
     if hasattr(dltensor, "__dlpack__"):
-        dlpack_caps = dltensor.__dlpack__()
+        stream = None
+        if hasattr(dltensor, "__dlpack_device__"):
+            device_type, device_id = dltensor.__dlpack_device__()
+            if device_type in (Device.kDLCUDA, Device.kDLROCM):
+                stream = _ffi_api.TVMGetCurrentStream(device_type, device_id)
+                stream = stream.value if stream is not None else None
+                # The DLPack convention reserves 0 on CUDA, whose default stream is 1.
+                if not stream:
+                    stream = 1 if device_type == Device.kDLCUDA else 0
+        if stream is None:
+            dlpack_caps = dltensor.__dlpack__()
+        else:
+            dlpack_caps = dltensor.__dlpack__(stream=stream)
         return _from_dlpack(dlpack_caps)
     raise AttributeError("Required attribute __dlpack__ not found")
 
@@ -155,6 +155,20 @@ class Report(Object):
         """
         return _ffi_api.AsJSON(self)
 
+    def chrome_trace(self):
+        """Convert the calls of this report to a timeline in the Chrome trace event format.
+
+        The output can be loaded in ``chrome://tracing`` or in Perfetto
+        (https://ui.perfetto.dev). Devices are shown as processes and calls are
+        placed on the thread that made them.
+
+        Returns
+        -------
+        trace : str
+            The timeline as JSON.
+        """
+        return _ffi_api.AsChromeTrace(self)
+
     @classmethod
     def from_json(cls, s):
         """Deserialize a report from JSON.
@@ -269,6 +283,39 @@ def profile_function(mod, dev, collectors, func_name=None, warmup_iters=10):
     )
 
 
+def start_profile_intrinsics():
+    """Start recording the loop nests instrumented by
+    :py:func:`tvm.tir.transform.InstrumentProfileIntrinsics`.
+
+    Functions built for an LLVM CPU target with the ``tir.instrument_lwp`` pass
+    config record a cycle counter timestamp into a per thread ring buffer at the
+    start and the end of every instrumented loop nest, so hotspots inside of a
+    single fused kernel are visible.
+
+    Example
+    -------
+
+    .. code-block: python
+        with tvm.transform.PassContext(config={"tir.instrument_lwp": True}):
+            f = tvm.build(my_func, target="llvm")
+        tvm.runtime.profiling.start_profile_intrinsics()
+        f(*args)
+        print(tvm.runtime.profiling.stop_profile_intrinsics())
+    """
+    _ffi_api.StartProfileIntrinsics()
+
+
+def stop_profile_intrinsics():
+    """Stop recording the instrumented loop nests.
+
+    Returns
+    -------
+    report : Report
+        One call named ``region_<id>`` per execution of an instrumented loop nest.
+    """
+    return _ffi_api.StopProfileIntrinsics()
+
+
 # We only enable this class when TVM is build with PAPI support
 if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=True) is not None:
 
@@ -291,3 +338,32 @@ if _ffi.get_global_func("runtime.profiling.PAPIMetricCollector", allow_missing=T
             for dev, names in metric_names.items():
                 wrapped[DeviceWrapper(dev)] = names
             self.__init_handle_by_constructor__(_ffi_api.PAPIMetricCollector, wrapped)
+
+
+# We only enable this class when TVM is build with CUPTI support
+if _ffi.get_global_func("runtime.profiling.CUPTIMetricCollector", allow_missing=True) is not None:
+
+    @_ffi.register_object("runtime.profiling.CUPTIMetricCollector")
+    class CUPTIMetricCollector(MetricCollector):
+        """Collects the hardware counters of every kernel on NVIDIA GPUs using the
+        CUDA Profiling Tools Interface (CUPTI).
+
+        Kernels are replayed until all their counters are collected, so durations of a
+        profiling run with this collector are not meaningful.
+        """
+
+        def __init__(self, metric_names: Optional[Dict[Device, Sequence[str]]] = None):
+            """
+            Parameters
+            ----------
+            metric_names : Optional[Dict[Device, Sequence[str]]]
+                List of per-device metrics to collect. Metric names are the ones of
+                Nsight Compute, you can list them by running `ncu --query-metrics` from
+                the command line. Devices without metrics collect the achieved occupancy,
+                DRAM bytes, L2 hit rate, tensor core utilization and SM efficiency.
+            """
+            metric_names = {} if metric_names is None else metric_names
+            wrapped = dict()
+            for dev, names in metric_names.items():
+                wrapped[DeviceWrapper(dev)] = names
+            self.__init_handle_by_constructor__(_ffi_api.CUPTIMetricCollector, wrapped)
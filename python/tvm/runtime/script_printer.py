@@ -44,6 +44,7 @@ class PrinterConfig(Object):
     path_to_annotate: Optional[Dict[ObjectPath, str]]
     obj_to_underline: Optional[List[Object]]
     obj_to_annotate: Optional[Dict[Object, str]]
+    max_constant_elems: int
 
     def __init__(
         self,
@@ -64,6 +65,7 @@ class PrinterConfig(Object):
         path_to_annotate: Optional[Dict[ObjectPath, str]] = None,
         obj_to_underline: Optional[List[Object]] = None,
         obj_to_annotate: Optional[Dict[Object, str]] = None,
+        max_constant_elems: int = 200,
     ) -> None:
         if num_context_lines is None:
             num_context_lines = -1
@@ -83,6 +85,7 @@ class PrinterConfig(Object):
             "path_to_annotate": path_to_annotate,
             "obj_to_underline": obj_to_underline,
             "obj_to_annotate": obj_to_annotate,
+            "max_constant_elems": max_constant_elems,
         }
 
         if name is not None:
@@ -96,6 +99,11 @@ def _script(obj: Object, config: PrinterConfig) -> str:
     return _ffi_node_api.TVMScriptPrinterScript(obj, config)  # type: ignore # pylint: disable=no-member
 
 
+def _script_to_file(obj: Object, path: str, config: PrinterConfig) -> None:
+    # pylint: disable=no-member
+    _ffi_node_api.TVMScriptPrinterScriptToFile(obj, config, path)  # type: ignore
+
+
 def _relax_script(obj: Object, config: PrinterConfig) -> str:
     func = get_global_func("script.printer.ReprPrintRelax")
     return func(obj, config)
@@ -123,6 +131,7 @@ class Scriptable:
         path_to_annotate: Optional[Dict[ObjectPath, str]] = None,
         obj_to_underline: Optional[List[Object]] = None,
         obj_to_annotate: Optional[Dict[Object, str]] = None,
+        max_constant_elems: int = 200,
     ) -> str:
         """Print TVM IR into TVMScript text format
 
@@ -161,6 +170,8 @@ class Scriptable:
             Object to be underlined
         obj_to_annotate : Optional[Dict[Object, str]] = None
             Object to be annotated
+        max_constant_elems : int = 200
+            The maximum number of elements printed of a constant array, -1 to print all of them
 
         Returns
         -------
@@ -186,9 +197,26 @@ class Scriptable:
                 path_to_annotate=path_to_annotate,
                 obj_to_underline=obj_to_underline,
                 obj_to_annotate=obj_to_annotate,
+                max_constant_elems=max_constant_elems,
             ),
         )
 
+    def script_to_file(self, path: str, **kwargs) -> None:
+        """Print TVM IR into TVMScript text format and write it to a file.
+
+        An IRModule is rendered one function at a time, so that printing a large module does
+        not hold the text of all of its functions in memory. The metadata and the line numbers
+        cannot be written this way.
+
+        Parameters
+        ----------
+        path : str
+            The file to write to
+        kwargs
+            The printer configuration, the same as the keyword arguments of script()
+        """
+        _script_to_file(self, path, PrinterConfig(**kwargs))
+
     def show(
         self,
         style: Optional[str] = None,
@@ -26,6 +26,7 @@ import tvm
 from tvm.runtime import Module
 from tvm._ffi.runtime_ctypes import TVMByteArray
 from tvm._ffi import base as _base
+from .executor.async_run import submit
 from .object import Object
 from . import _ffi_api, container
 from ..rpc.base import RPC_SESS_MASK
@@ -91,6 +92,12 @@ class Executable(object):
         self._get_late_bound_consts = self.mod["get_late_bound_consts"]
         self._load_late_bound_consts = self.mod["load_late_bound_consts"]
         self._load_late_bound_consts_from_map = self.mod["load_late_bound_consts_from_map"]
+        self._release_device_constants = self.mod["release_device_constants"]
+        self._add_shape_specialization = self.mod["add_shape_specialization"]
+        self._get_shape_specializations = self.mod["get_shape_specializations"]
+        self._add_kernel_variant = self.mod["add_kernel_variant"]
+        self._set_variant_choice = self.mod["set_variant_choice"]
+        self._get_kernel_variants = self.mod["get_kernel_variants"]
 
     def save(self):
         """Save the Relay VM Executable.
@@ -311,22 +318,138 @@ class Executable(object):
         self._function_params[func_name] = params
         return params
 
-    def move_late_bound_consts(self, path, byte_limit):
-        """Move all constants of byte size greater or equal to byte_limit to file at path"""
-        return self._move_late_bound_consts(path, byte_limit)
+    def move_late_bound_consts(self, path, byte_limit, mappable=False):
+        """Move all constants of byte size greater or equal to byte_limit to file at path.
+
+        With mappable=True the file stores page-aligned tensor payloads, and
+        load_late_bound_consts memory-maps it instead of reading it into memory."""
+        return self._move_late_bound_consts(path, byte_limit, mappable)
 
     def get_late_bound_consts(self, byte_limit):
         """Return all constants of byte size greater or equal to byte_limit"""
         return self._get_late_bound_consts(byte_limit)
 
-    def load_late_bound_consts(self, path):
-        """Re-load constants previously saved to file at path"""
-        return self._load_late_bound_consts(path)
+    def load_late_bound_consts(self, path, lazy=False):
+        """Re-load constants previously saved to file at path
+
+        Parameters
+        ----------
+        path : str
+            The file the constants were saved to.
+
+        lazy : bool
+            Only read the index of the file now. Each constant is then read straight onto
+            its device the first time a virtual machine uses it.
+        """
+        return self._load_late_bound_consts(path, lazy)
 
     def load_late_bound_consts_from_map(self, map):
         """Re-load constants supplied in map"""
         return self._load_late_bound_consts_from_map(map)
 
+    def add_shape_specialization(self, prim_name, arg_shapes, func_name):
+        """Dispatch the primitive to a shape-specialized kernel for the given argument shapes.
+
+        Parameters
+        ----------
+        prim_name : str
+            The name of the generic primitive, see :py:attr:`primitive_ops`.
+
+        arg_shapes : List[Tuple[int]]
+            The shape of every tensor argument of the primitive, outputs included.
+
+        func_name : str
+            The name of the specialized kernel, which must be in the executable's library.
+            The specialization is saved with the executable.
+        """
+        shapes = [tvm.runtime.ShapeTuple(shape) for shape in arg_shapes]
+        self._add_shape_specialization(prim_name, shapes, func_name)
+
+    @property
+    def shape_specializations(self):
+        """The shape-specialized kernels of each primitive.
+
+        Returns
+        -------
+        ret : Dict[str, List[Tuple[List[Tuple[int]], str]]]
+            For each primitive, the argument shapes and name of every specialized kernel.
+        """
+        ret = {}
+        for prim_name, specs in self._get_shape_specializations().items():
+            ret[str(prim_name)] = [(_decode_shape_key(key), str(name)) for key, name in specs]
+        return ret
+
+    def add_kernel_variant(self, prim_name, func_name):
+        """Add an alternative kernel of the primitive, for instance tuned for another range of
+        a dynamic dimension.
+
+        The VM invokes the kernel chosen for the shape bucket of the arguments, every dimension
+        rounded up to a power of two. Buckets without a choice time every kernel on their first
+        invocations and keep the fastest, see :py:meth:`VirtualMachine.set_variant_trials`.
+
+        Parameters
+        ----------
+        prim_name : str
+            The name of the generic primitive, see :py:attr:`primitive_ops`.
+
+        func_name : str
+            The name of the variant, which must be in the executable's library and have the
+            calling convention of the primitive. The variant is saved with the executable.
+        """
+        self._add_kernel_variant(prim_name, func_name)
+
+    def set_variant_choice(self, prim_name, arg_shapes, func_name):
+        """Choose the kernel of the primitive for the shape bucket of the given shapes.
+
+        Parameters
+        ----------
+        prim_name : str
+            The name of the generic primitive.
+
+        arg_shapes : List[Tuple[int]]
+            The shape of every tensor argument of the primitive, outputs included.
+
+        func_name : str
+            The name of the primitive or of one of its variants. The choice is saved with the
+            executable, so the choices of :py:meth:`VirtualMachine.get_variant_choices` are
+            persisted this way.
+        """
+        shapes = [tvm.runtime.ShapeTuple(shape) for shape in arg_shapes]
+        self._set_variant_choice(prim_name, shapes, func_name)
+
+    @property
+    def kernel_variants(self):
+        """The kernel variants of each primitive.
+
+        Returns
+        -------
+        ret : Dict[str, Tuple[List[str], List[Tuple[List[Tuple[int]], str]]]]
+            For each primitive, the names of its variants and the kernel chosen per shape
+            bucket.
+        """
+        ret = {}
+        for prim_name, (names, choices) in self._get_kernel_variants().items():
+            ret[str(prim_name)] = (
+                [str(name) for name in names],
+                [(_decode_shape_key(key), str(name)) for key, name in choices],
+            )
+        return ret
+
+    def release_device_constants(self):
+        """Drop the device-resident constants shared by the VMs created from this executable.
+        The memory is freed once those VMs are destroyed."""
+        return self._release_device_constants()
+
+
+def _decode_shape_key(key):
+    """Split a flat shape key (rank followed by the dimensions, per tensor) into shapes."""
+    key, shapes, pos = list(key), [], 0
+    while pos < len(key):
+        ndim = int(key[pos])
+        shapes.append(tuple(int(dim) for dim in key[pos + 1 : pos + 1 + ndim]))
+        pos += 1 + ndim
+    return shapes
+
 
 class VirtualMachine(object):
     """Relay VM runtime.
@@ -342,15 +465,18 @@ class VirtualMachine(object):
 
     memory_cfg : str or Dict[tvm.runtime.Device, str], optional
         Config the type of memory allocator. The allocator type can be ["naive",
-        "pooled"]. If memory_cfg is None, all devices will use pooled allocator
-        by default. If memory_cfg is string, all devices will use the specified
-        allocator type. If memory_cfg is a dict, each device uses the allocator
-        type specified in the dict, or pooled allocator if not specified in the
-        dict.
+        "pooled", "best_fit", "stream_ordered"]. "stream_ordered" leaves the caching to the
+        stream ordered allocator of the device, e.g. cudaMallocAsync. If memory_cfg is None,
+        all devices will use pooled allocator by default. If memory_cfg is string, all
+        devices will use the specified allocator type. If memory_cfg is a dict, each device
+        uses the allocator type specified in the dict, or pooled allocator if not specified
+        in the dict.
     """
 
     NAIVE_ALLOCATOR = 1
     POOLED_ALLOCATOR = 2
+    BEST_FIT_ALLOCATOR = 3
+    STREAM_ORDERED_ALLOCATOR = 4
 
     def __init__(self, exe, device, memory_cfg=None):
         """
@@ -418,9 +544,13 @@ class VirtualMachine(object):
         if memory_cfg is None:
             memory_cfg = {}
         elif isinstance(memory_cfg, str):
-            assert memory_cfg in ["naive", "pooled"]
+            assert memory_cfg in ["naive", "pooled", "best_fit", "stream_ordered"]
             if memory_cfg == "naive":
                 default_alloc_type = VirtualMachine.NAIVE_ALLOCATOR
+            elif memory_cfg == "best_fit":
+                default_alloc_type = VirtualMachine.BEST_FIT_ALLOCATOR
+            elif memory_cfg == "stream_ordered":
+                default_alloc_type = VirtualMachine.STREAM_ORDERED_ALLOCATOR
             memory_cfg = {}
         elif not isinstance(memory_cfg, dict):
             raise TypeError(
@@ -520,6 +650,28 @@ class VirtualMachine(object):
             self.set_input(func_name, *args, **kwargs)
         return self._invoke(func_name)
 
+    def invoke_async(self, func_name, *args):
+        """Invoke a function asynchronously.
+
+        The invocations of the VM execute one after the other on a small pool of host
+        threads, on a stream of their own on a GPU, so that the calling thread is not
+        blocked. The VM must not be used synchronously while invocations are pending.
+
+        Parameters
+        ----------
+        func_name : str
+            The name of the function.
+
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The arguments to the function.
+
+        Returns
+        -------
+        future : concurrent.futures.Future
+            The future of the output.
+        """
+        return submit(self.module["invoke_async"], func_name, *convert(args))
+
     def run(self, *args, **kwargs):
         """Run the main function.
 
@@ -604,6 +756,133 @@ class VirtualMachine(object):
         """
         return [self._get_output(i) for i in range(self._get_num_outputs())]
 
+    def set_thread_pool(self, name):
+        """Run the kernels on a named thread pool.
+
+        Parameters
+        ----------
+        name : str
+            The name of a pool created by :py:func:`tvm.runtime.create_thread_pool`,
+            an empty string restores the default thread pool.
+        """
+        self.module["set_thread_pool"](name)
+
+    def record_kernel_shapes(self, enable=True):
+        """Count the argument shapes each primitive is invoked with.
+
+        The hot shapes found this way are the candidates for
+        :py:meth:`Executable.add_shape_specialization`. Disabling the recording clears the
+        counts.
+        """
+        self.module["set_record_kernel_shapes"](enable)
+
+    def get_kernel_shapes(self):
+        """Get the argument shapes recorded since :py:meth:`record_kernel_shapes`.
+
+        Returns
+        -------
+        ret : Dict[str, List[Tuple[List[Tuple[int]], int]]]
+            For each primitive, the observed argument shapes with their invocation count,
+            most frequent first.
+        """
+        ret = {}
+        for prim_name, (keys, counts) in self.module["get_kernel_shapes"]().items():
+            shapes = [(_decode_shape_key(key), int(count)) for key, count in zip(keys, counts)]
+            ret[str(prim_name)] = sorted(shapes, key=lambda item: -item[1])
+        return ret
+
+    def set_variant_trials(self, trials):
+        """Set how many times every kernel variant is timed before choosing one for a shape
+        bucket, see :py:meth:`Executable.add_kernel_variant`. The timings so far are dropped.
+
+        Parameters
+        ----------
+        trials : int
+            The timed invocations per variant, 3 by default, 0 invokes the generic kernel for
+            the buckets without a choice.
+        """
+        self.module["set_variant_trials"](trials)
+
+    def get_variant_choices(self):
+        """Get the kernel chosen per shape bucket of the primitives with variants.
+
+        Returns
+        -------
+        ret : Dict[str, List[Tuple[List[Tuple[int]], str]]]
+            For each primitive, the bucketed argument shapes and the name of their kernel,
+            which can be saved with :py:meth:`Executable.set_variant_choice`.
+        """
+        ret = {}
+        for prim_name, choices in self.module["get_variant_choices"]().items():
+            ret[str(prim_name)] = [(_decode_shape_key(key), str(name)) for key, name in choices]
+        return ret
+
+    def set_shape_func_cache_size(self, size):
+        """Set how many outputs of each shape function are memoized.
+
+        The shape functions reading only the shapes of their inputs are skipped when invoked
+        again with recently seen input shapes, their memoized outputs are used instead. Setting
+        the size drops the memoized outputs.
+
+        Parameters
+        ----------
+        size : int
+            The maximum number of memoized outputs per shape function, 16 by default,
+            0 turns memoization off.
+        """
+        self.module["set_shape_func_cache_size"](size)
+
+    def get_shape_func_cache_hits(self):
+        """Get the number of shape function invocations skipped since the cache size was set.
+
+        Returns
+        -------
+        hits : int
+            The number of memoized shape function outputs used.
+        """
+        return self.module["get_shape_func_cache_hits"]()
+
+    def set_sampling_interval(self, interval):
+        """Time the primitives of every Nth invocation with the device timers.
+
+        Unlike :py:class:`tvm.runtime.profiler_vm.VirtualMachineProfiler`, the primitives
+        are not synchronized one by one, so sampling can stay on while serving. Setting the
+        interval drops the samples so far.
+
+        Parameters
+        ----------
+        interval : int
+            Sample every ``interval``-th invocation, 0 turns sampling off.
+        """
+        self.module["set_sampling_interval"](interval)
+
+    def get_sampled_profile(self):
+        """Get the latencies of the sampled primitives.
+
+        Returns
+        -------
+        report : tvm.runtime.profiling.Report
+            A call for every primitive with its number of samples, its mean latency and its
+            ``p50 (us)``, ``p90 (us)`` and ``p99 (us)`` latency percentiles over the latest
+            samples.
+        """
+        return self.module["get_sampled_profile"]()
+
+    def preload_constants(self):
+        """Upload all constants to their devices now rather than on the first invocation.
+
+        The uploaded constants are shared with every other VM created from the same
+        executable on the same device.
+        """
+        self.module["preload_constants"]()
+
+    def warmup(self):
+        """Upload the constants and do the lazy initialization of the kernels, e.g. loading the
+        device modules, without invoking any function, so that the first request is not slowed
+        down by it.
+        """
+        self.module["warmup"]()
+
     def get_input_index(self, input_name, func_name="main"):
         """Get inputs index via input name.
         Parameters
@@ -736,3 +1015,194 @@ class VirtualMachine(object):
             cooldown_interval_ms=cooldown_interval_ms,
             repeats_to_cooldown=repeats_to_cooldown,
         )(func_name)
+
+
+class Batcher(object):
+    """Coalesces the requests to a function of a VM into batches.
+
+    A worker thread waits for the oldest pending request for at most max_latency_ms, or
+    until the pending requests fill the largest bucket. It concatenates their inputs along
+    the batch axis, pads them with zeros to the smallest bucket holding them and slices
+    the outputs back along the same axis. The function is compiled with a dynamic batch
+    dimension and only ever runs on the bucket sizes. Inputs and outputs are on the CPU.
+
+    Parameters
+    ----------
+    vm : VirtualMachine
+        The VM invoking the function. It must not be used otherwise while batching.
+
+    func_name : str
+        The name of the function.
+
+    buckets : list of int
+        The batch sizes the function is invoked with.
+
+    max_latency_ms : float
+        The longest time a request waits for the batch to fill up.
+
+    batch_axis : int
+        The batch axis of the inputs and outputs.
+    """
+
+    def __init__(
+        self, vm, func_name="main", buckets=(1, 2, 4, 8), max_latency_ms=1.0, batch_axis=0
+    ):
+        self.module = _ffi_api._VMBatcher(
+            vm.module,
+            func_name,
+            tvm.runtime.ShapeTuple([int(b) for b in buckets]),
+            batch_axis,
+            int(max_latency_ms * 1000),
+        )
+
+    def submit(self, *args):
+        """Queue a request.
+
+        Parameters
+        ----------
+        args : list[tvm.runtime.NDArray] or list[np.ndarray]
+            The inputs of the function, with the same extent along the batch axis.
+
+        Returns
+        -------
+        future : concurrent.futures.Future
+            The future of the output of the request.
+        """
+        return submit(self.module["submit"], *convert(args))
+
+    def stop(self):
+        """Run the pending requests and stop the worker thread."""
+        self.module["stop"]()
+
+
+@tvm._ffi.register_object("vm.PagedKVCache")
+class PagedKVCache(Object):
+    """The keys and values of the attention layers of many sequences, stored in a pool
+    of fixed-size pages.
+
+    A sequence holds a page table and grows a page at a time, so that the cache of a
+    sequence is neither reallocated nor padded to the maximum length. A forked sequence
+    shares the pages of its parent until it writes to them. A forward pass calls
+    begin_forward, then append for every layer before running the attention kernel of
+    the layer, e.g. topi.nn.paged_attention, on pages, page_table and seq_lens.
+
+    Parameters
+    ----------
+    num_layers : int
+        The number of attention layers.
+
+    num_heads : int
+        The number of key/value heads.
+
+    head_dim : int
+        The dimension of a head.
+
+    page_size : int
+        The number of tokens of a page.
+
+    num_pages : int
+        The number of pages of the pool, allocated on creation.
+
+    dtype : str
+        The type of the keys and values.
+
+    device : tvm.runtime.Device
+        The device of the pool.
+
+    alloc_type : int
+        The type of the VM allocator of the pool, 2 for the pooled allocator.
+    """
+
+    def __init__(
+        self,
+        num_layers,
+        num_heads,
+        head_dim,
+        page_size,
+        num_pages,
+        dtype="float16",
+        device=None,
+        alloc_type=2,
+    ):
+        device = tvm.cpu() if device is None else device
+        self.__init_handle_by_constructor__(
+            _ffi_api.PagedKVCache,
+            num_layers,
+            num_heads,
+            head_dim,
+            page_size,
+            num_pages,
+            dtype,
+            device,
+            alloc_type,
+        )
+
+    def add_sequence(self, seq_id):
+        """Add an empty sequence."""
+        _ffi_api.PagedKVCacheAddSequence(self, seq_id)
+
+    def remove_sequence(self, seq_id):
+        """Remove a sequence and release its pages."""
+        _ffi_api.PagedKVCacheRemoveSequence(self, seq_id)
+
+    def fork_sequence(self, parent_seq_id, child_seq_id):
+        """Add a sequence sharing the tokens of another one."""
+        _ffi_api.PagedKVCacheForkSequence(self, parent_seq_id, child_seq_id)
+
+    def get_sequence_length(self, seq_id):
+        """Get the number of tokens of a sequence."""
+        return _ffi_api.PagedKVCacheGetSequenceLength(self, seq_id)
+
+    @property
+    def num_free_pages(self):
+        """The number of pages held by no sequence."""
+        return _ffi_api.PagedKVCacheNumFreePages(self)
+
+    def begin_forward(self, seq_ids, append_lengths):
+        """Start a forward pass, reserving the pages of the new tokens of a batch.
+
+        Parameters
+        ----------
+        seq_ids : list of int
+            The sequences of the batch.
+
+        append_lengths : list of int
+            The number of new tokens of each sequence.
+        """
+        _ffi_api.PagedKVCacheBeginForward(
+            self,
+            tvm.runtime.ShapeTuple([int(i) for i in seq_ids]),
+            tvm.runtime.ShapeTuple([int(n) for n in append_lengths]),
+        )
+
+    def append(self, layer, key, value):
+        """Write the keys and values of the new tokens of a layer.
+
+        Parameters
+        ----------
+        layer : int
+            The layer.
+
+        key : tvm.runtime.NDArray
+            The keys of shape [num_tokens, num_heads, head_dim], the new tokens of the
+            sequences of the forward pass concatenated in order.
+
+        value : tvm.runtime.NDArray
+            The values, with the shape of the keys.
+        """
+        _ffi_api.PagedKVCacheAppend(self, layer, key, value)
+
+    @property
+    def pages(self):
+        """The pool of shape [num_layers, 2, num_pages, page_size, num_heads, head_dim]."""
+        return _ffi_api.PagedKVCacheGetPages(self)
+
+    @property
+    def page_table(self):
+        """The int32 page table of the current forward pass, [batch, max_pages]."""
+        return _ffi_api.PagedKVCacheGetPageTable(self)
+
+    @property
+    def seq_lens(self):
+        """The int32 lengths of the sequences of the current forward pass."""
+        return _ffi_api.PagedKVCacheGetSeqLens(self)
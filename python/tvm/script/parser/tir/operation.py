@@ -49,6 +49,12 @@ def _register_expr_op(ty: Type):  # pylint: disable=invalid-name
         else:
             return tir.Or(a, b)
 
+    def _get_lanes(dtype: str):
+        dtype = DataType(dtype)
+        if dtype.is_scalable:
+            return tir.vscale() * dtype.vscale_factor
+        return dtype.lanes
+
     def _get_type_str(dtype: str):
         if DataType(dtype).lanes == 1:
             return dtype
@@ -91,10 +97,10 @@ def _register_expr_op(ty: Type):  # pylint: disable=invalid-name
         if DataType(a.dtype).lanes == DataType(b.dtype).lanes:
             return op(a, b)
         elif DataType(a.dtype).lanes == 1 and DataType(a.dtype).lanes != DataType(b.dtype).lanes:
-            broadcast_a = tir.Broadcast(a, DataType(b.dtype).lanes)
+            broadcast_a = tir.Broadcast(a, _get_lanes(b.dtype))
             return op(broadcast_a, b)
         elif DataType(b.dtype).lanes == 1 and DataType(a.dtype).lanes != DataType(b.dtype).lanes:
-            broadcast_b = tir.Broadcast(b, DataType(a.dtype).lanes)
+            broadcast_b = tir.Broadcast(b, _get_lanes(a.dtype))
             return op(a, broadcast_b)
         else:
             raise TypeError("do not know how to deal with it.")
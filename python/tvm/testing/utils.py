@@ -914,6 +914,15 @@ requires_rocm = Feature(
     parent_features="gpu",
 )
 
+# Mark a test as requiring the HIP Graph executor to run
+requires_hipgraph = Feature(
+    "hipgraph",
+    "HIP Graph",
+    cmake_flag="USE_GRAPH_EXECUTOR_HIP_GRAPH",
+    target_kind_enabled="rocm",
+    parent_features="rocm",
+)
+
 # Mark a test as requiring a matrixcore to run
 requires_matrixcore = Feature(
     "matrixcore",
@@ -50,7 +50,7 @@ from .op import call_llvm_intrin, call_llvm_pure_intrin, ret, all, any, min_valu
 from .op import tvm_check_return
 from .op import tvm_stack_alloca, tvm_stack_make_shape, tvm_stack_make_array
 from .op import tvm_tuple, tvm_struct_get, tvm_struct_set
-from .op import address_of, lookup_param, assume, undef
+from .op import address_of, lookup_param, assume, undef, vscale
 from .op import tvm_thread_allreduce, type_annotation, tvm_access_ptr, tvm_throw_last_error
 from .op import (
     tvm_load_matrix_sync,
@@ -61,6 +61,10 @@ from .op import (
 )
 from .op import ptx_mma, ptx_mma_sp, mma_store, mma_fill
 from .op import ptx_ldmatrix, ptx_cp_async, ptx_commit_group, ptx_wait_group
+from .op import ptx_init_barrier_thread_count, ptx_arrive_barrier, ptx_arrive_barrier_expect_tx
+from .op import ptx_wait_barrier, ptx_cp_async_bulk, ptx_cp_async_bulk_tensor
+from .op import ptx_cluster_sync, ptx_ld_shared_cluster
+from .op import ptx_wgmma_ss, ptx_wgmma_fence, ptx_wgmma_commit_group, ptx_wgmma_wait_group
 from .op import vectorlow, vectorhigh, vectorcombine
 from .op import infinity, reinterpret
 from .op import exp, exp2, exp10, log, log2, log10, log1p, ldexp, clz
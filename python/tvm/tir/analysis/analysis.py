@@ -262,6 +262,23 @@ def estimate_tir_flops(stmt_or_mod: Union[Stmt, IRModule]) -> float:
     return _ffi_api.EstimateTIRFlops(stmt_or_mod)  # type: ignore # pylint: disable=no-member
 
 
+def estimate_tir_bytes(func_or_mod: Union[PrimFunc, IRModule]) -> float:
+    """Estimate the bytes moved from and to global memory by a PrimFunc, assuming each byte of
+    the regions of the global buffers it reads and writes is moved once.
+
+    Parameters
+    ----------
+    func_or_mod: Union[PrimFunc, IRModule]
+        The PrimFunc or IRModule to be estimated.
+
+    Returns
+    -------
+    bytes: float
+        The estimated bytes.
+    """
+    return _ffi_api.EstimateTIRBytes(func_or_mod)  # type: ignore # pylint: disable=no-member
+
+
 # NOTE: relay_func_type in the following two functions should be relay.FuncType however that would
 # introduce a cycling dependency. We make do with Object.
 
@@ -1025,13 +1025,16 @@ class BufferLoad(PrimExprWithOp):
     indices : List[PrimExpr]
         The buffer indices.
 
+    predicate : Optional[PrimExpr]
+        The boolean vector of the lanes to load, every lane is loaded when it is None.
+
     span : Optional[Span]
         The location of this itervar in the source code.
     """
 
-    def __init__(self, buffer, indices, span=None):
+    def __init__(self, buffer, indices, predicate=None, span=None):
         self.__init_handle_by_constructor__(
-            _ffi_api.BufferLoad, buffer, indices, span  # type: ignore
+            _ffi_api.BufferLoad, buffer, indices, predicate, span  # type: ignore
         )
 
 
@@ -1069,8 +1072,8 @@ class Ramp(PrimExprWithOp):
     stride : ramp stride
         The stride of the ramp.
 
-    lanes : int
-        The lanes of the expression.
+    lanes : Union[int, PrimExpr]
+        The lanes of the expression, or vscale() * n for a scalable vector.
 
     span : Optional[Span]
         The location of this itervar in the source code.
@@ -1091,8 +1094,8 @@ class Broadcast(PrimExprWithOp):
     value : PrimExpr
         The value of the expression.
 
-    lanes : int
-        The lanes of the expression.
+    lanes : Union[int, PrimExpr]
+        The lanes of the expression, or vscale() * n for a scalable vector.
 
     span : Optional[Span]
         The location of this itervar in the source code.
@@ -436,6 +436,19 @@ def undef():
     return call_intrin("int32", "tir.undef")
 
 
+def vscale():
+    """Get the runtime multiplier of the lanes of scalable vectors
+
+    A scalable vector type such as float32xvscalex4 holds vscale() * 4 elements.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("int32", "tir.vscale")
+
+
 def call_tir(global_var: tvm.ir.GlobalVar, *args):
     """Performs a call into another PrimFunc in the same IRModule
 
@@ -1390,6 +1403,359 @@ def ptx_wait_group(num):
     return call_intrin("", "tir.ptx_wait_group", num)
 
 
+def ptx_init_barrier_thread_count(barrier_ptr, barrier_offset, thread_count):
+    """TVM intrinsic for ptx mbarrier initialization
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-mbarrier-init
+
+    Parameters
+    ----------
+    barrier_ptr : Var
+        The pointer variable of the uint64 mbarriers in shared memory.
+
+    barrier_offset : Expr
+        The offset of the mbarrier.
+
+    thread_count : int
+        The number of threads expected to arrive at the mbarrier in every phase.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        "", "tir.ptx_init_barrier_thread_count", barrier_ptr, barrier_offset, thread_count
+    )
+
+
+def ptx_arrive_barrier(barrier_ptr, barrier_offset):
+    """TVM intrinsic for ptx mbarrier arrive
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-mbarrier-arrive
+
+    Parameters
+    ----------
+    barrier_ptr : Var
+        The pointer variable of the uint64 mbarriers in shared memory.
+
+    barrier_offset : Expr
+        The offset of the mbarrier.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_arrive_barrier", barrier_ptr, barrier_offset)
+
+
+def ptx_arrive_barrier_expect_tx(barrier_ptr, barrier_offset, byte_count):
+    """TVM intrinsic for ptx mbarrier arrive, which also expects the given number of bytes to be
+    completed on the mbarrier by bulk async copies
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-mbarrier-expect-tx
+
+    Parameters
+    ----------
+    barrier_ptr : Var
+        The pointer variable of the uint64 mbarriers in shared memory.
+
+    barrier_offset : Expr
+        The offset of the mbarrier.
+
+    byte_count : Expr
+        The number of bytes the pending bulk async copies complete on the mbarrier.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        "", "tir.ptx_arrive_barrier_expect_tx", barrier_ptr, barrier_offset, byte_count
+    )
+
+
+def ptx_wait_barrier(barrier_ptr, barrier_offset, phase):
+    """TVM intrinsic for ptx mbarrier wait
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-mbarrier-test-wait-mbarrier-try-wait
+
+    Parameters
+    ----------
+    barrier_ptr : Var
+        The pointer variable of the uint64 mbarriers in shared memory.
+
+    barrier_offset : Expr
+        The offset of the mbarrier.
+
+    phase : Expr
+        The parity of the phase to wait for.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wait_barrier", barrier_ptr, barrier_offset, phase)
+
+
+def ptx_cp_async_bulk(
+    shared_ptr, shared_offset, global_ptr, global_offset, bytes, barrier_ptr, barrier_offset
+):
+    """TVM intrinsic for ptx bulk async copy of a contiguous region from global to shared memory
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-cp-async-bulk
+
+    Parameters
+    ----------
+    shared_ptr : Var
+        The shared memory pointer variable.
+
+    shared_offset : Expr
+        The offset of shared memory pointer.
+
+    global_ptr : Var
+        The global memory pointer variable.
+
+    global_offset : Expr
+        The offset of global memory pointer.
+
+    bytes : Expr
+        The data size to copy, a multiple of 16.
+
+    barrier_ptr : Var
+        The pointer variable of the mbarriers the completion is signaled on.
+
+    barrier_offset : Expr
+        The offset of the mbarrier.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        "",
+        "tir.ptx_cp_async_bulk",
+        shared_ptr,
+        shared_offset,
+        global_ptr,
+        global_offset,
+        bytes,
+        barrier_ptr,
+        barrier_offset,
+    )
+
+
+def ptx_cp_async_bulk_tensor(
+    dim, shared_ptr, shared_offset, tensor_map, barrier_ptr, barrier_offset, *coords
+):
+    """TVM intrinsic for ptx bulk async copy of a tile of a tensor from global to shared memory
+    through the tensor memory accelerator
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-cp-async-bulk-tensor
+
+    Parameters
+    ----------
+    dim : int
+        The number of dimensions of the tensor.
+
+    shared_ptr : Var
+        The shared memory pointer variable.
+
+    shared_offset : Expr
+        The offset of shared memory pointer.
+
+    tensor_map : Var
+        The pointer to the CUtensorMap of the tensor in global memory, as encoded by
+        runtime.cuTensorMapEncodeTiled.
+
+    barrier_ptr : Var
+        The pointer variable of the mbarriers the completion is signaled on.
+
+    barrier_offset : Expr
+        The offset of the mbarrier.
+
+    coords : List[Expr]
+        The element coordinates of the tile in the tensor, innermost dimension first.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        "",
+        "tir.ptx_cp_async_bulk_tensor",
+        dim,
+        shared_ptr,
+        shared_offset,
+        tensor_map,
+        barrier_ptr,
+        barrier_offset,
+        *coords,
+    )
+
+
+def ptx_cluster_sync():
+    """TVM intrinsic for the ptx barrier across all the threads of the thread block cluster
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#parallel-synchronization-and-communication-instructions-barrier-cluster
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_cluster_sync")
+
+
+def ptx_ld_shared_cluster(dtype, shared_ptr, shared_offset, block_rank):
+    """TVM intrinsic for ptx load of an element of the shared memory of another thread block
+    of the cluster through distributed shared memory
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#data-movement-and-conversion-instructions-mapa
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the element.
+
+    shared_ptr : Var
+        The shared memory pointer variable.
+
+    shared_offset : Expr
+        The offset of shared memory pointer.
+
+    block_rank : Expr
+        The rank of the thread block in the cluster.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(dtype, "tir.ptx_ld_shared_cluster", shared_ptr, shared_offset, block_rank)
+
+
+def ptx_wgmma_ss(
+    dtype,
+    shape,
+    A_dtype,
+    B_dtype,
+    C_dtype,
+    multiplicand_a,
+    a_index,
+    multiplicand_b,
+    b_index,
+    accumulator,
+    c_index,
+    swizzle_bytes,
+    scale_out,
+):
+    """TVM intrinsic for ptx warpgroup level asynchronous matrix multiply accumulate, with both
+    multiplicands in shared memory
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-mma-async
+
+    Parameters
+    ----------
+    dtype : str
+        The data type of the result.
+
+    shape : str
+        The shape of the wgmma, e.g. m64n128k16.
+
+    A_dtype : str
+        The data type of multiplicand A.
+
+    B_dtype : str
+        The data type of multiplicand B.
+
+    C_dtype : str
+        The data type of the accumulator.
+
+    multiplicand_a : Var
+        The shared memory pointer variable of the k-major multiplicand A.
+
+    a_index : Expr
+        The offset of multiplicand A.
+
+    multiplicand_b : Var
+        The shared memory pointer variable of the k-major multiplicand B.
+
+    b_index : Expr
+        The offset of multiplicand B.
+
+    accumulator : Var
+        The accumulator registers of the thread.
+
+    c_index : Expr
+        The offset of the accumulator.
+
+    swizzle_bytes : int
+        The swizzle of the multiplicands in shared memory, 0, 32, 64 or 128.
+
+    scale_out : Expr
+        Whether to add the result to the accumulator, the accumulator is overwritten if zero.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin(
+        dtype,
+        "tir.ptx_wgmma_ss",
+        shape,
+        A_dtype,
+        B_dtype,
+        C_dtype,
+        multiplicand_a,
+        a_index,
+        multiplicand_b,
+        b_index,
+        accumulator,
+        c_index,
+        swizzle_bytes,
+        scale_out,
+    )
+
+
+def ptx_wgmma_fence():
+    """TVM intrinsic for the ptx fence before the wgmma of a warpgroup
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-fence
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wgmma_fence")
+
+
+def ptx_wgmma_commit_group():
+    """TVM intrinsic for the ptx commit of the pending wgmma of a warpgroup
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-commit-group
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wgmma_commit_group")
+
+
+def ptx_wgmma_wait_group(num):
+    """TVM intrinsic for the ptx wait of the committed wgmma groups of a warpgroup
+    https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#asynchronous-warpgroup-level-matrix-instructions-wgmma-wait-group
+
+    Parameters
+    ----------
+    num : int
+        The number of the most recent wgmma groups that may still be pending.
+
+    Returns
+    -------
+    call : PrimExpr
+        The call expression.
+    """
+    return call_intrin("", "tir.ptx_wgmma_wait_group", num)
+
+
 def vectorlow(dtype, vec):
     """Get the low level half of the vector
 
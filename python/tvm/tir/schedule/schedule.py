@@ -660,6 +660,84 @@ class Schedule(Object):
         """
         return _ffi_api.ScheduleMerge(self, loops)  # type: ignore # pylint: disable=no-member
 
+    @type_checked
+    def horizontal_fuse(self, *loops: List[LoopRV]) -> LoopRV:
+        """Fuse a list of sibling loops horizontally, so that their bodies run one after another
+        in a single loop. It requires:
+        1) The loops are consecutive children of the same parent.
+        2) The loops can't have annotations or thread bindings, and must start with 0.
+        3) The loops have constant extents, or their extents are equal.
+        4) The blocks under different loops don't depend on each other.
+        The extent of the new loop is the maximum of the extents, and the blocks under a shorter
+        loop are guarded by predicates.
+
+        Parameters
+        ----------
+        *loops : List[LoopRV]
+            The loops to be fused
+
+        Returns
+        -------
+        fused_loop : LoopRV
+            The new loop after fusion
+
+        Examples
+        --------
+
+        Before applying horizontal_fuse, in TensorIR, the IR is:
+
+        .. code-block:: python
+
+            @T.prim_func
+            def before_horizontal_fuse(
+                A: T.Buffer((128,), "float32"),
+                B: T.Buffer((128,), "float32"),
+                C: T.Buffer((64,), "float32"),
+                D: T.Buffer((64,), "float32"),
+            ) -> None:
+                for i in range(128):
+                    with T.block("B"):
+                        vi = T.axis.spatial(128, i)
+                        B[vi] = A[vi] * 2.0
+                for i in range(64):
+                    with T.block("D"):
+                        vi = T.axis.spatial(64, i)
+                        D[vi] = C[vi] + 1.0
+
+        Create the schedule and do horizontal_fuse:
+
+        .. code-block:: python
+
+            sch = tir.Schedule(before_horizontal_fuse)
+            (i1,) = sch.get_loops(sch.get_block("B"))
+            (i2,) = sch.get_loops(sch.get_block("D"))
+            sch.horizontal_fuse(i1, i2)
+            print(sch.mod["main"].script())
+
+        After applying horizontal_fuse, the IR becomes:
+
+        .. code-block:: python
+
+            @T.prim_func
+            def after_horizontal_fuse(
+                A: T.Buffer((128,), "float32"),
+                B: T.Buffer((128,), "float32"),
+                C: T.Buffer((64,), "float32"),
+                D: T.Buffer((64,), "float32"),
+            ) -> None:
+                # the 2 loops are fused into 1
+                for i_h in range(128):
+                    with T.block("B"):
+                        vi = T.axis.spatial(128, i_h)
+                        B[vi] = A[vi] * 2.0
+                    with T.block("D"):
+                        vi = T.axis.spatial(64, i_h)
+                        T.where(i_h < 64)
+                        D[vi] = C[vi] + 1.0
+        """
+        # pylint: disable-next=no-member
+        return _ffi_api.ScheduleHorizontalFuse(self, loops)  # type: ignore
+
     @type_checked
     def fuse(self, *loops: List[LoopRV], preserve_unit_iters: bool = True) -> LoopRV:
         """Fuse a list of consecutive loops into one. It requires:
@@ -158,6 +158,76 @@ def get_dotprod_intrin(in_dtype, out_dtype):
     return dot_prod_desc, dot_prod_impl
 
 
+def get_mmla_intrin(lhs_dtype, rhs_dtype, out_dtype):
+    """Generator of the i8mm intrins, computing C[2, 2] += A[2, 8] * B[2, 8]^T in one
+    instruction. The rows of A, B and C need not be contiguous."""
+    if lhs_dtype == "uint8" and rhs_dtype == "int8":
+        instr = "usmmla.v4i32.v16i8"
+    elif lhs_dtype == "uint8":
+        instr = "ummla.v4i32.v16i8"
+    else:  # if lhs_dtype == "int8"
+        instr = "smmla.v4i32.v16i8"
+
+    out_dtype_x2 = f"{out_dtype}x2"
+    out_dtype_x4 = f"{out_dtype}x4"
+
+    @T.prim_func
+    def mmla_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(a, (2, 8), dtype=lhs_dtype, offset_factor=1)
+        B = T.match_buffer(b, (2, 8), dtype=rhs_dtype, offset_factor=1)
+        C = T.match_buffer(c, (2, 2), dtype=out_dtype, offset_factor=1)
+        with T.block("root"):
+            T.reads(C[0:2, 0:2], A[0:2, 0:8], B[0:2, 0:8])
+            T.writes(C[0:2, 0:2])
+            for i, j, k in T.grid(2, 2, 8):
+                with T.block("update"):
+                    vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                    C[vi, vj] = C[vi, vj] + T.cast(A[vi, vk], dtype=out_dtype) * T.cast(
+                        B[vj, vk], dtype=out_dtype
+                    )
+
+    @T.prim_func
+    def mmla_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        sa = T.int32()
+        sb = T.int32()
+        sc = T.int32()
+        A = T.match_buffer(a, (2, 8), dtype=lhs_dtype, offset_factor=1, strides=[sa, 1])
+        B = T.match_buffer(b, (2, 8), dtype=rhs_dtype, offset_factor=1, strides=[sb, 1])
+        C = T.match_buffer(c, (2, 2), dtype=out_dtype, offset_factor=1, strides=[sc, 1])
+        with T.block("root"):
+            T.reads(C[0:2, 0:2], A[0:2, 0:8], B[0:2, 0:8])
+            T.writes(C[0:2, 0:2])
+
+            vec_a = T.vectorcombine(
+                A.vload([0, 0], dtype=f"{lhs_dtype}x8"),
+                A.vload([1, 0], dtype=f"{lhs_dtype}x8"),
+                dtype=f"{lhs_dtype}x16",
+            )
+            vec_b = T.vectorcombine(
+                B.vload([0, 0], dtype=f"{rhs_dtype}x8"),
+                B.vload([1, 0], dtype=f"{rhs_dtype}x8"),
+                dtype=f"{rhs_dtype}x16",
+            )
+            vec_c = T.vectorcombine(
+                C.vload([0, 0], dtype=out_dtype_x2),
+                C.vload([1, 0], dtype=out_dtype_x2),
+                dtype=out_dtype_x4,
+            )
+
+            vec_res = T.call_llvm_pure_intrin(
+                T.llvm_lookup_intrinsic_id(f"llvm.aarch64.neon.{instr}"),
+                T.uint32(3),
+                vec_c,
+                vec_a,
+                vec_b,
+                dtype=out_dtype_x4,
+            )
+            C[0, T.ramp(T.int32(0), 1, 2)] = T.vectorlow(vec_res, dtype=out_dtype_x2)
+            C[1, T.ramp(T.int32(0), 1, 2)] = T.vectorhigh(vec_res, dtype=out_dtype_x2)
+
+    return mmla_desc, mmla_impl
+
+
 ARM_DOT_4x4_i8_NEON_INTRIN = "dot_4x4_i8i8s32_neon"
 ARM_DOT_4x4_i8_SDOT_INTRIN = "dot_4x4_i8i8s32_sdot"
 ARM_DOT_4x4_u8_UDOT_INTRIN = "dot_4x4_u8u8u32_udot"
@@ -170,3 +240,16 @@ TensorIntrin.register(ARM_DOT_4x4_i8_SDOT_INTRIN, *get_dotprod_intrin("int8", "i
 TensorIntrin.register(ARM_DOT_4x4_u8_UDOT_INTRIN, *get_dotprod_intrin("uint8", "uint32"))
 
 TensorIntrin.register(ARM_DOT_4x4_u8_HDOT_INTRIN, *get_dotprod_intrin("uint8", "int32"))
+
+ARM_MMLA_2x2x8_i8_SMMLA_INTRIN = "mmla_2x2x8_i8i8s32_smmla"
+ARM_MMLA_2x2x8_u8_UMMLA_INTRIN = "mmla_2x2x8_u8u8u32_ummla"
+ARM_MMLA_2x2x8_u8_HMMLA_INTRIN = "mmla_2x2x8_u8u8i32_hmmla"
+ARM_MMLA_2x2x8_u8i8_USMMLA_INTRIN = "mmla_2x2x8_u8i8s32_usmmla"
+
+TensorIntrin.register(ARM_MMLA_2x2x8_i8_SMMLA_INTRIN, *get_mmla_intrin("int8", "int8", "int32"))
+
+TensorIntrin.register(ARM_MMLA_2x2x8_u8_UMMLA_INTRIN, *get_mmla_intrin("uint8", "uint8", "uint32"))
+
+TensorIntrin.register(ARM_MMLA_2x2x8_u8_HMMLA_INTRIN, *get_mmla_intrin("uint8", "uint8", "int32"))
+
+TensorIntrin.register(ARM_MMLA_2x2x8_u8i8_USMMLA_INTRIN, *get_mmla_intrin("uint8", "int8", "int32"))
@@ -1495,3 +1495,228 @@ TensorIntrin.register(
 def index_map_m16n8k8_matrixC(ind):
     i, j = ind[0], ind[1]
     return convert([(i // 8) // 2, j // 8, (i // 8) % 2, (j % 8) % 2])
+
+
+######## WGMMA intrinsics ########
+
+# The threads of a warpgroup, which computes a wgmma together.
+WARPGROUP_SIZE = 128
+WGMMA_M_DIM = 64
+
+
+def get_index_wgmma_C(elem_offset, stride):
+    """The offset of the registers of a 64 x n tile of a lowered wgmma.accumulator buffer."""
+    i = elem_offset // stride
+    j = elem_offset % stride
+    return (i // WGMMA_M_DIM) * (stride // 8) * 4 + (j // 8) * 4
+
+
+def wgmma_accumulator_layout(tx, b, h, p):
+    """The element of a 64 x n wgmma accumulator held in the register of (b, h, p) of thread tx.
+
+    Every warp holds 16 rows of the accumulator, in the layout of the m16n8 accumulators of mma.
+    """
+    return (tx // 32) * 16 + (tx % 32) // 4 + h * 8, b * 8 + (tx % 4) * 2 + p
+
+
+def get_wgmma_init_intrin(n_dim: int, dtype: str) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of wgmma init intrins"""
+    zero = IntImm("int32", 0).astype(dtype)
+
+    @T.prim_func
+    def wgmma_init_desc(c: T.handle) -> None:
+        dst = T.match_buffer(
+            c, (WGMMA_M_DIM, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        with T.block("root"):
+            T.reads()
+            T.writes(dst[0:WGMMA_M_DIM, 0:n_dim])
+            for i, j in T.grid(WGMMA_M_DIM, n_dim):
+                with T.block("init"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    dst[vi, vj] = zero
+
+    @T.prim_func
+    def wgmma_init_impl(c: T.handle) -> None:
+        dst = T.match_buffer(
+            c, (WGMMA_M_DIM, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+
+        with T.block("root"):
+            T.reads()
+            T.writes(dst[0:WGMMA_M_DIM, 0:n_dim])
+            tx = T.env_thread("threadIdx.x")
+            T.launch_thread(tx, WARPGROUP_SIZE)
+            for b, h, p in T.grid(n_dim // 8, 2, 2):
+                row, col = T.meta_var(wgmma_accumulator_layout(tx, b, h, p))
+                dst[row, col] = zero
+
+    return wgmma_init_desc, wgmma_init_impl
+
+
+def get_wgmma_sync_intrin(
+    n_dim: int, in_dtype: str, out_dtype: str, shared_scope: str = "shared.dyn"
+) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of wgmma sync intrins.
+
+    A (64 x k) and B (n x k) are k-major tiles in shared memory, of 32 bytes per row written by
+    bulk tensor copies with the 32 byte swizzle.
+    """
+    k_dim = {"float16": 16, "bfloat16": 16, "int8": 32, "uint8": 32}[in_dtype]
+    dtype_abbrv = {
+        "float16": "fp16",
+        "bfloat16": "bf16",
+        "float32": "fp32",
+        "int8": "int8",
+        "uint8": "uint8",
+        "int32": "int32",
+    }
+
+    def maybe_cast(v):
+        if in_dtype != out_dtype:
+            return Cast(out_dtype, v)
+        return v
+
+    @T.prim_func
+    def wgmma_sync_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(
+            a, (WGMMA_M_DIM, k_dim), in_dtype, align=64, offset_factor=1, scope=shared_scope
+        )
+        B = T.match_buffer(
+            b, (n_dim, k_dim), in_dtype, align=64, offset_factor=1, scope=shared_scope
+        )
+        C = T.match_buffer(
+            c, (WGMMA_M_DIM, n_dim), out_dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+
+        with T.block("root"):
+            T.reads(C[0:WGMMA_M_DIM, 0:n_dim], A[0:WGMMA_M_DIM, 0:k_dim], B[0:n_dim, 0:k_dim])
+            T.writes(C[0:WGMMA_M_DIM, 0:n_dim])
+            for i, j, k in T.grid(WGMMA_M_DIM, n_dim, k_dim):
+                with T.block("wgmma_sync"):
+                    vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                    C[vi, vj] = C[vi, vj] + maybe_cast(A[vi, vk]) * maybe_cast(B[vj, vk])
+
+    @T.prim_func
+    def wgmma_sync_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(
+            a, (WGMMA_M_DIM, k_dim), in_dtype, align=64, offset_factor=1, scope=shared_scope
+        )
+        B = T.match_buffer(
+            b, (n_dim, k_dim), in_dtype, align=64, offset_factor=1, scope=shared_scope
+        )
+        c0 = T.int32()
+        c1 = T.int32()
+        C = T.match_buffer(
+            c,
+            (WGMMA_M_DIM, n_dim),
+            out_dtype,
+            align=64,
+            offset_factor=1,
+            scope="wgmma.accumulator",
+            strides=[c0, c1],
+        )
+
+        with T.block("root"):
+            T.reads(C[0:WGMMA_M_DIM, 0:n_dim], A[0:WGMMA_M_DIM, 0:k_dim], B[0:n_dim, 0:k_dim])
+            T.writes(C[0:WGMMA_M_DIM, 0:n_dim])
+            tx = T.env_thread("threadIdx.x")
+            T.launch_thread(tx, WARPGROUP_SIZE)
+            T.evaluate(T.ptx_wgmma_fence())
+            T.evaluate(
+                T.ptx_wgmma_ss(
+                    f"m{WGMMA_M_DIM}n{n_dim}k{k_dim}",
+                    dtype_abbrv[in_dtype],
+                    dtype_abbrv[in_dtype],
+                    dtype_abbrv[out_dtype],
+                    A.data,
+                    A.elem_offset,
+                    B.data,
+                    B.elem_offset,
+                    C.data,
+                    get_index_wgmma_C(C.elem_offset, c0),
+                    32,
+                    1,
+                    dtype=out_dtype,
+                )
+            )
+            T.evaluate(T.ptx_wgmma_commit_group())
+            T.evaluate(T.ptx_wgmma_wait_group(0))
+
+    return wgmma_sync_desc, wgmma_sync_impl
+
+
+def get_wgmma_store_intrin(n_dim: int, dtype: str, scope: str) -> Tuple[PrimFunc, PrimFunc]:
+    """Generator of wgmma store intrins"""
+
+    @T.prim_func
+    def wgmma_store_desc(a: T.handle, c: T.handle) -> None:
+        src = T.match_buffer(
+            a, (WGMMA_M_DIM, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        dst = T.match_buffer(c, (WGMMA_M_DIM, n_dim), dtype, align=64, offset_factor=1, scope=scope)
+
+        with T.block("root"):
+            T.reads(src[0:WGMMA_M_DIM, 0:n_dim])
+            T.writes(dst[0:WGMMA_M_DIM, 0:n_dim])
+            for i, j in T.grid(WGMMA_M_DIM, n_dim):
+                with T.block("wgmma_store"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    dst[vi, vj] = src[vi, vj]
+
+    @T.prim_func
+    def wgmma_store_impl(a: T.handle, c: T.handle) -> None:
+        src = T.match_buffer(
+            a, (WGMMA_M_DIM, n_dim), dtype, align=64, offset_factor=1, scope="wgmma.accumulator"
+        )
+        s0 = T.int32()
+        s1 = T.int32()
+        dst = T.match_buffer(
+            c,
+            (WGMMA_M_DIM, n_dim),
+            dtype,
+            align=64,
+            offset_factor=1,
+            scope=scope,
+            strides=[s0, s1],
+        )
+
+        with T.block("root"):
+            T.reads(src[0:WGMMA_M_DIM, 0:n_dim])
+            T.writes(dst[0:WGMMA_M_DIM, 0:n_dim])
+            tx = T.env_thread("threadIdx.x")
+            T.launch_thread(tx, WARPGROUP_SIZE)
+            for b, h, p in T.grid(n_dim // 8, 2, 2):
+                row, col = T.meta_var(wgmma_accumulator_layout(tx, b, h, p))
+                dst[row, col] = src[row, col]
+
+    return wgmma_store_desc, wgmma_store_impl
+
+
+for _n_dim in [64, 128]:
+    TensorIntrin.register(f"wgmma_init_m64n{_n_dim}_f32", *get_wgmma_init_intrin(_n_dim, "float32"))
+    TensorIntrin.register(f"wgmma_init_m64n{_n_dim}_f16", *get_wgmma_init_intrin(_n_dim, "float16"))
+    TensorIntrin.register(
+        f"wgmma_sync_m64n{_n_dim}k16_f16f16f32",
+        *get_wgmma_sync_intrin(_n_dim, "float16", "float32"),
+    )
+    TensorIntrin.register(
+        f"wgmma_sync_m64n{_n_dim}k16_f16f16f16",
+        *get_wgmma_sync_intrin(_n_dim, "float16", "float16"),
+    )
+    for _scope in ["global", "shared.dyn"]:
+        _scope_suffix = _scope.replace(".", "_")
+        TensorIntrin.register(
+            f"wgmma_store_m64n{_n_dim}_f32_{_scope_suffix}",
+            *get_wgmma_store_intrin(_n_dim, "float32", _scope),
+        )
+        TensorIntrin.register(
+            f"wgmma_store_m64n{_n_dim}_f16_{_scope_suffix}",
+            *get_wgmma_store_intrin(_n_dim, "float16", _scope),
+        )
+
+
+@register_func("tir.index_map_wgmma.accumulator")
+def index_map_wgmma_accumulator(ind):
+    i, j = ind[0], ind[1]
+    return convert([i // 64, j // 8, (i % 16) // 8, j % 2])
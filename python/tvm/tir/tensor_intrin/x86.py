@@ -101,6 +101,173 @@ def dot_product_16x4_u8i8i32_avx512(
         )
 
 
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_desc(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+        for i in T.serial(0, 16):
+            for k in T.serial(0, 2):
+                with T.block("update"):
+                    vi, vk = T.axis.remap("SR", [i, k])
+                    C[vi] = C[vi] + T.cast(A[vk], "float32") * T.cast(B[vi, vk], "float32")
+
+
+@T.prim_func
+def dot_product_16x2_bf16bf16f32_avx512_bf16(
+    A: T.Buffer((2,), "bfloat16", offset_factor=1),
+    B: T.Buffer((16, 2), "bfloat16", offset_factor=1),
+    C: T.Buffer((16,), "float32", offset_factor=1),
+) -> None:
+    with T.block("root"):
+        T.reads(C[0:16], A[0:2], B[0:16, 0:2])
+        T.writes(C[0:16])
+
+        A_bf16x2 = A.vload([0], "bfloat16x2")
+        A_i32 = T.reinterpret(A_bf16x2, dtype="int32")
+
+        B_bf16x32 = B.vload([0, 0], dtype="bfloat16x32")
+        B_i32x16 = T.reinterpret(B_bf16x32, dtype="int32x16")
+        C_f32x16 = C.vload([0], dtype="float32x16")
+
+        C[T.ramp(T.int32(0), 1, 16)] = T.call_llvm_pure_intrin(
+            T.llvm_lookup_intrinsic_id("llvm.x86.avx512bf16.dpbf16ps.512"),
+            T.uint32(3),
+            C_f32x16,
+            T.broadcast(A_i32, 16),
+            B_i32x16,
+            dtype="float32x16",
+        )
+
+
+# AMX-TMUL intrinsics, updating a single 16x16 accumulator tile. All the tiles are configured
+# as 16 rows of 64 bytes by every call, as the tile configuration is a per thread state that
+# the threads of a parallel loop would not share otherwise. The B operand is packed in the
+# VNNI layout, with the four int8 or two bfloat16 elements of a dot product adjacent.
+AMX_TILE_ROWS = 16
+AMX_TILE_COLSB = 64
+
+
+def get_amx_intrin(in_dtype):
+    """Generate the description and implementation of an AMX-TMUL intrinsic."""
+    if in_dtype == "uint8":
+        a_dtype, b_dtype, out_dtype, vnni, dpbxx = "uint8", "int8", "int32", 4, "llvm.x86.tdpbusd"
+    else:
+        assert in_dtype == "bfloat16"
+        a_dtype, b_dtype, out_dtype, vnni = "bfloat16", "bfloat16", "float32", 2
+        dpbxx = "llvm.x86.tdpbf16ps"
+    m_dim = n_dim = AMX_TILE_ROWS
+    k_dim = AMX_TILE_COLSB * vnni // 4
+    a_bytes = 4 // vnni
+    # The palette 1 configuration words: the palette id, the column bytes of the eight tiles as
+    # 16 bit fields, and their rows as 8 bit fields.
+    colsb_word = AMX_TILE_COLSB | (AMX_TILE_COLSB << 16)
+    rows_word = AMX_TILE_ROWS * 0x01010101
+
+    @T.prim_func
+    def amx_desc(a: T.handle, b: T.handle, c: T.handle) -> None:
+        A = T.match_buffer(a, (m_dim, k_dim), a_dtype, offset_factor=1)
+        B = T.match_buffer(b, (k_dim // vnni, n_dim, vnni), b_dtype, offset_factor=1)
+        C = T.match_buffer(c, (m_dim, n_dim), out_dtype, offset_factor=1)
+
+        with T.block("root"):
+            T.reads(C[0:m_dim, 0:n_dim], A[0:m_dim, 0:k_dim], B[0 : k_dim // vnni, 0:n_dim, 0:vnni])
+            T.writes(C[0:m_dim, 0:n_dim])
+            for i, j, k in T.grid(m_dim, n_dim, k_dim):
+                with T.block("update"):
+                    vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+                    C[vi, vj] = C[vi, vj] + T.cast(A[vi, vk], out_dtype) * T.cast(
+                        B[vk // vnni, vj, vk % vnni], out_dtype
+                    )
+
+    @T.prim_func
+    def amx_impl(a: T.handle, b: T.handle, c: T.handle) -> None:
+        s0 = T.int32()
+        s1 = T.int32()
+        s2 = T.int32()
+        A = T.match_buffer(a, (m_dim, k_dim), a_dtype, offset_factor=1, strides=[s0, 1])
+        B = T.match_buffer(
+            b, (k_dim // vnni, n_dim, vnni), b_dtype, offset_factor=1, strides=[s1, vnni, 1]
+        )
+        C = T.match_buffer(c, (m_dim, n_dim), out_dtype, offset_factor=1, strides=[s2, 1])
+
+        with T.block("root"):
+            T.reads(C[0:m_dim, 0:n_dim], A[0:m_dim, 0:k_dim], B[0 : k_dim // vnni, 0:n_dim, 0:vnni])
+            T.writes(C[0:m_dim, 0:n_dim])
+            cfg = T.decl_buffer((16,), "int32", scope="local")
+            for i in T.unroll(16):
+                cfg[i] = 0
+            cfg[0] = 1
+            for i in T.unroll(4):
+                cfg[4 + i] = colsb_word
+            for i in T.unroll(2):
+                cfg[12 + i] = rows_word
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.ldtilecfg"),
+                    T.uint32(0),
+                    cfg.access_ptr("r"),
+                    dtype="int32",
+                )
+            )
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.tileloadd64"),
+                    T.uint32(0),
+                    T.uint8(0),
+                    C.access_ptr("r"),
+                    T.cast(s2 * 4, "int64"),
+                    dtype="int32",
+                )
+            )
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.tileloadd64"),
+                    T.uint32(0),
+                    T.uint8(1),
+                    A.access_ptr("r"),
+                    T.cast(s0 * a_bytes, "int64"),
+                    dtype="int32",
+                )
+            )
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.tileloadd64"),
+                    T.uint32(0),
+                    T.uint8(2),
+                    B.access_ptr("r"),
+                    T.cast(s1 * a_bytes, "int64"),
+                    dtype="int32",
+                )
+            )
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id(dpbxx),
+                    T.uint32(0),
+                    T.uint8(0),
+                    T.uint8(1),
+                    T.uint8(2),
+                    dtype="int32",
+                )
+            )
+            T.evaluate(
+                T.call_llvm_intrin(
+                    T.llvm_lookup_intrinsic_id("llvm.x86.tilestored64"),
+                    T.uint32(0),
+                    T.uint8(0),
+                    C.access_ptr("w"),
+                    T.cast(s2 * 4, "int64"),
+                    dtype="int32",
+                )
+            )
+
+    return amx_desc, amx_impl
+
+
 VNNI_DOT_16x4_INTRIN = "dot_16x4_vnni"
 
 TensorIntrin.register(
@@ -112,3 +279,19 @@ AVX512_DOT_16x4_INTRIN = "dot_16x4_avx512"
 TensorIntrin.register(
     AVX512_DOT_16x4_INTRIN, dot_product_16x4_u8i8i32_desc, dot_product_16x4_u8i8i32_avx512
 )
+
+AVX512_BF16_DOT_16x2_INTRIN = "dot_16x2_avx512_bf16"
+
+TensorIntrin.register(
+    AVX512_BF16_DOT_16x2_INTRIN,
+    dot_product_16x2_bf16bf16f32_desc,
+    dot_product_16x2_bf16bf16f32_avx512_bf16,
+)
+
+AMX_INT8_16x16x64_INTRIN = "dot_16x16x64_amx_int8"
+
+TensorIntrin.register(AMX_INT8_16x16x64_INTRIN, *get_amx_intrin("uint8"))
+
+AMX_BF16_16x16x32_INTRIN = "dot_16x16x32_amx_bf16"
+
+TensorIntrin.register(AMX_BF16_16x16x32_INTRIN, *get_amx_intrin("bfloat16"))
@@ -59,6 +59,23 @@ def InjectPrefetch():
     return _ffi_api.InjectPrefetch()  # type: ignore
 
 
+def InjectSoftwarePrefetch():
+    """Insert software prefetches for the strided accesses to global buffers
+    in the innermost serial loops of CPU functions.
+
+    The pass applies to the loops under the "software_prefetch_distance" pragma,
+    whose value is the distance in loop iterations (0 to derive it from the cost
+    of the loop body), or to all the loops if the "enable" field of the
+    "tir.InjectSoftwarePrefetch" pass config is set.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.InjectSoftwarePrefetch()  # type: ignore
+
+
 def ApplyLayoutTransforms():
     """Reshape buffers that appear in the "layout_transform_map"
     fucntion attribute.
@@ -165,6 +182,21 @@ def LoopPartition():
     return _ffi_api.LoopPartition()  # type: ignore
 
 
+def SpecializeDivisibleShapes():
+    """Specialize the PrimFunc for the dynamic shapes divisible by its tile factors.
+
+    The body is guarded by a runtime check of the divisibility of the shape vars by the
+    factors of the ceildiv loop extents. In the guarded fast path, the trip counts are exact
+    and the boundary checks are removed; the original body is kept as the fallback.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.SpecializeDivisibleShapes()  # type: ignore
+
+
 def VectorizeLoop(enable_vectorize: bool = True):
     """Lower vectorization loops.
 
@@ -222,6 +254,13 @@ def StorageRewrite():
     Trying to share space between allocations to make
     a static allocation plan when possible.
 
+    The ``"tir.StorageRewrite"`` pass config takes two options. With
+    ``reuse_across_dtypes``, allocations of different byte-addressable
+    dtypes in the same scope share storage by bytes, e.g. an int32
+    accumulator may reuse a freed int8 staging buffer. With
+    ``report_reuse``, the shared allocations are attached to the
+    PrimFunc as the ``"tir.storage_reuse"`` attribute.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -235,6 +274,17 @@ def UnrollLoop():
 
     This pass also automatically attach pragma unroll tag to loops which meets the standard.
 
+    With the ``auto_max_instructions`` option of the ``"tir.UnrollLoop"`` pass
+    config, a loop is only unrolled automatically when its estimated instruction
+    count is within the budget. A budget of -1 is derived from the instruction
+    cache of the target.
+
+    A loop under the ``pragma_unroll_and_jam`` attribute, e.g. from
+    ``s[op].pragma(axis, "unroll_and_jam", factor)`` or the
+    ``"pragma_unroll_and_jam"`` loop annotation, is unrolled by the factor. When
+    its body is a loop and its iterations write disjoint elements, the copies are
+    jammed into the inner loop.
+
     Returns
     -------
     fpass : tvm.transform.Pass
@@ -550,6 +600,21 @@ def ThreadSync(storage_scope: str):
     return _ffi_api.ThreadSync(storage_scope)  # type: ignore
 
 
+def MergePersistentKernel():
+    """Merge the consecutive kernel launches of the CUDA functions into persistent kernels.
+
+    A merged kernel launches as many blocks as the SMs of the target hold at once, which run
+    the blocks of the kernels in turn, with global barriers between the dependent kernels.
+    The target must set ``-multi_processor_count``.
+
+    Returns
+    -------
+    fpass : tvm.transform.Pass
+        The result pass
+    """
+    return _ffi_api.MergePersistentKernel()  # type: ignore
+
+
 def LowerThreadAllreduce():
     """Lower cross thread alleduce.
 
@@ -645,6 +710,10 @@ def CombineContextCall():
 def NarrowDataType(target_bits: int):
     """Narrow down PrimExpr datatype in stmt to target_bits.
 
+    With the ``tir.narrow_datatype_guard`` config, on by default for GPU targets, the indices
+    depending on dynamic shapes are also narrowed, under a runtime check that the buffers hold
+    fewer than 2^(target_bits-1) elements.
+
     Parameters
     ----------
     target_bits : int
@@ -762,6 +831,13 @@ class HoistedLetBindings(enum.Flag):
     All = RequiredByConditional | LetStmt | LetExpr
     """ Enable all hoisting of let bindings """
 
+    BufferLoad = 8
+    """ Loop-invariant buffer loads, bound to a new variable.  A load is
+    hoisted out of a loop only if the loop iterates at least once and
+    writes no buffer which may alias the loaded one: buffers alias
+    unless one of them is allocated in the function, or both are
+    arguments of a function with the tir.noalias attribute. """
+
 
 def HoistExpression():
     """Generalized verison of HoistIfThenElse.
@@ -772,6 +848,7 @@ def HoistExpression():
     * LetStmt bindings
     * IfThenElse conditions
     * Boolean operators
+    * Buffer loads, if HoistedLetBindings.BufferLoad is set
 
     Returns
     -------
@@ -962,7 +1039,12 @@ def UnifyThreadBinding():
 
 def MergeDynamicSharedMemoryAllocations():
     """This pass merges multiple TIR-level dynamic shared memory allocations
-    into one allocation.
+    into one allocation, reusing the memory of the buffers whose lifetimes do
+    not overlap.
+
+    If the "tir.merge_static_smem" pass config option is set, the static
+    shared memory allocations of each kernel are merged too, together with
+    the dynamic ones.
 
     Returns
     -------
@@ -81,6 +81,10 @@ class BufferInfo(Object):
         """Sets the conflicting array of buffer info objects"""
         _ffi_api.BufferInfoSetConflicts(self, conflicts)
 
+    def set_access_count(self, access_count: int):
+        """Sets the estimated number of accesses to the buffer, weighted by loop trip counts"""
+        _ffi_api.BufferInfoSetAccessCount(self, access_count)
+
 
 @register_object("tir.usmp.PoolAllocation")
 class PoolAllocation(Object):
@@ -35,6 +35,7 @@ from .conv3d_winograd import *
 from . import conv3d_alter_op
 from .reduction import schedule_reduce
 from .softmax import *
+from .attention import schedule_fused_attention, schedule_paged_attention
 from .injective import schedule_injective, schedule_elemwise, schedule_broadcast
 from .dense import *
 from .pooling import *
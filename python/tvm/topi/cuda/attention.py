@@ -0,0 +1,103 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Schedule for fused attention operator"""
+from tvm import te
+from ..nn.attention import fused_attention_stages
+from ..utils import traverse_inline
+
+
+def _schedule_fused_attention(s, output):
+    scores, row_max, row_sum, acc = fused_attention_stages(output)
+    num_thread = 64
+    block_x = te.thread_axis("blockIdx.x")
+    thread_x = te.thread_axis((0, num_thread), "threadIdx.x")
+
+    # One thread block per (batch, head, query) row.
+    b, h, i, e = s[output].op.axis
+    row = s[output].fuse(b, h, i)
+    tx, ei = s[output].split(e, nparts=num_thread)
+    s[output].bind(row, block_x)
+    s[output].bind(tx, thread_x)
+
+    # Each thread accumulates its own slice of the value dimension.
+    s[acc].compute_at(s[output], ei)
+
+    # The score row is shared by the whole block.
+    s[scores].set_scope("shared")
+    s[scores].compute_at(s[output], row)
+    jo, _ = s[scores].split(s[scores].op.axis[3], nparts=num_thread)
+    s[scores].bind(jo, thread_x)
+
+    # Row statistics use a cross-thread reduction over the key dimension.
+    for stat in (row_max, row_sum):
+        s[stat].compute_at(s[output], row)
+        ko, _ = s[stat].split(s[stat].op.reduce_axis[0], nparts=num_thread)
+        s[stat].bind(ko, thread_x)
+
+
+def schedule_fused_attention(outs):
+    """Schedule for fused_attention op.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of fused_attention in the format
+          of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag == "fused_attention_output":
+            _schedule_fused_attention(s, op.output(0))
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
+def schedule_paged_attention(outs):
+    """Schedule for paged_attention op.
+
+    A thread block computes a query row, as for fused_attention. The page table of the
+    sequence is read by every thread that gathers a key or a value.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of paged_attention in the format
+          of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag == "paged_attention_output":
+            _schedule_fused_attention(s, op.output(0))
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
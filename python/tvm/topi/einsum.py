@@ -42,3 +42,23 @@ def einsum(subscripts, *operand):
     """
 
     return cpp.einsum(subscripts, operand)
+
+
+def einsum_path(subscripts, *shapes):
+    """Find the order of pairwise contractions used to evaluate an einsum.
+
+    Parameters
+    ----------
+    subscripts : string
+        Specifies the subscripts for summation as comma separated list of subscript labels.
+
+    shapes : tuple of list of int
+        The shapes of the operands.
+
+    Returns
+    -------
+    path : list of tuple of int
+        Each step (i, j) contracts the i-th and j-th operands of the current list and appends
+        the result to its end. The path is empty if the einsum is evaluated as a single compute.
+    """
+    return [tuple(int(x) for x in step) for step in cpp.einsum_path(subscripts, shapes)]
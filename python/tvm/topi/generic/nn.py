@@ -18,6 +18,8 @@
 """Generic nn operators"""
 from tvm import te
 from .default import default_schedule as _default_schedule
+from ..nn.attention import fused_attention_stages
+from ..utils import traverse_inline
 
 
 def schedule_conv1d_ncw(outs):
@@ -849,6 +851,59 @@ def schedule_batch_matmul(outs):
     return _default_schedule(outs, False)
 
 
+def schedule_fused_attention(outs):
+    """Schedule for fused_attention
+
+    Every intermediate stage is computed at the output row loop, so only one row
+    of the attention matrix is live at a time.
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of fused_attention
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    return _schedule_attention_rows(outs, "fused_attention_output")
+
+
+def schedule_paged_attention(outs):
+    """Schedule for paged_attention
+
+    Parameters
+    ----------
+    outs: Array of Tensor
+          The computation graph description of paged_attention
+          in the format of an array of tensors.
+
+    Returns
+    -------
+    sch: Schedule
+        The computation schedule for the op.
+    """
+    return _schedule_attention_rows(outs, "paged_attention_output")
+
+
+def _schedule_attention_rows(outs, output_tag):
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag == output_tag:
+            output = op.output(0)
+            row = s[output].op.axis[2]
+            for stage in fused_attention_stages(output):
+                s[stage].compute_at(s[output], row)
+            s[output].vectorize(s[output].op.axis[3])
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
+
+
 def schedule_batch_norm(outs):
     """Schedule for batch_norm
 
@@ -251,3 +251,37 @@ def _schedule_dense_large_batch(cfg, s, C):
     s[BB].bind(ty, te.thread_axis("threadIdx.y"))
     s[BB].bind(tx, te.thread_axis("threadIdx.x"))
     s[BB].double_buffer()
+
+
+def schedule_dense_weight_only(outs):
+    """Schedule dense_weight_only on GPU.
+
+    A block computes an output element, its threads splitting the reduction, so that
+    the packed weight of a small batch is read once and coalesced.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag == "dense_weight_only":
+            C = op.output(0)
+            _, kf = s[C].split(C.op.reduce_axis[0], factor=64)
+            CF = s.rfactor(C, kf)
+
+            if C.op in s.outputs:
+                Out = C
+            else:
+                Out = s.outputs[0].output(0)
+                s[C].compute_at(s[Out], s[Out].op.axis[1])
+            s[Out].bind(s[Out].op.axis[0], te.thread_axis("blockIdx.y"))
+            s[Out].bind(s[Out].op.axis[1], te.thread_axis("blockIdx.x"))
+
+            tx = s[C].op.reduce_axis[0]
+            thread_x = te.thread_axis("threadIdx.x")
+            s[C].bind(tx, thread_x)
+            s[CF].compute_at(s[C], tx)
+            s[C].set_store_predicate(thread_x.var.equal(0))
+            s[Out].set_store_predicate(thread_x.var.equal(0))
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
@@ -41,6 +41,7 @@ from .upsampling import *
 from .instance_norm import instance_norm
 from .layer_norm import layer_norm
 from .group_norm import group_norm
+from .attention import fused_attention, paged_attention
 from .local_response_norm import *
 from .bitserial_conv2d import *
 from .bitserial_dense import *
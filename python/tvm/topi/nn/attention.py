@@ -0,0 +1,182 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Fused attention operator."""
+import math
+
+import tvm
+from tvm import te
+
+from .. import cpp
+from ..utils import get_const_int
+
+
+def fused_attention(query, key, value, scale=None, causal=False):
+    """Fused scaled dot-product attention, softmax(scale * query * key^T) * value.
+
+    The softmax is computed row by row, so a schedule that computes the intermediate
+    stages at the output row never materializes the full attention matrix.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, head_dim]
+
+    key : tvm.te.Tensor
+        4-D with shape [batch, heads, kv_len, head_dim]
+
+    value : tvm.te.Tensor
+        4-D with shape [batch, heads, kv_len, value_dim]
+
+    scale : Optional[float]
+        The scale applied to query * key^T. Defaults to 1 / sqrt(head_dim).
+
+    causal : bool
+        Whether to mask out keys after the query position. Query rows are aligned to
+        the end of the key sequence.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, value_dim]
+    """
+    return cpp.nn.fused_attention(query, key, value, 0.0 if scale is None else scale, causal)
+
+
+def paged_attention(query, pages, page_table, seq_lens, layer, scale=None, causal=True):
+    """Attention of the new tokens of a batch of sequences to the keys and values of a
+    paged KV cache, tvm.runtime.vm.PagedKVCache.
+
+    The keys and values are read through the page table of each sequence, so the
+    sequences of a batch share the pool of pages and have their own length. The stages
+    are the ones of fused_attention, and so are the schedules.
+
+    Parameters
+    ----------
+    query : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, head_dim], the queries of the last q_len
+        tokens of each sequence, e.g. 1 when decoding.
+
+    pages : tvm.te.Tensor
+        6-D with shape [num_layers, 2, num_pages, page_size, heads, head_dim]
+
+    page_table : tvm.te.Tensor
+        2-D int32 with shape [batch, max_pages]
+
+    seq_lens : tvm.te.Tensor
+        1-D int32 with shape [batch], the number of tokens of each sequence, the new ones
+        included.
+
+    layer : Union[int, tvm.tir.PrimExpr]
+        The layer of the pool to read.
+
+    scale : Optional[float]
+        The scale applied to query * key^T. Defaults to 1 / sqrt(head_dim).
+
+    causal : bool
+        Whether to mask out keys after the query position. Query rows are aligned to
+        the end of each sequence.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        4-D with shape [batch, heads, q_len, head_dim]
+    """
+    batch, heads, q_len, head_dim = query.shape
+    page_size = pages.shape[3]
+    kv_len = page_table.shape[1] * page_size
+    dtype = query.dtype
+    if scale is None:
+        scale = 1.0 / math.sqrt(get_const_int(head_dim))
+
+    def _cache(kv, b, h, j, e):
+        page = page_table[b, tvm.tir.indexdiv(j, page_size)]
+        return pages[layer, kv, page, tvm.tir.indexmod(j, page_size), h, e]
+
+    d = te.reduce_axis((0, head_dim), name="d")
+    scores = te.compute(
+        (batch, heads, q_len, kv_len),
+        lambda b, h, i, j: te.sum(query[b, h, i, d] * _cache(0, b, h, j, d), axis=d),
+        name="T_paged_attention_scores",
+        tag="paged_attention_scores",
+    )
+
+    # Scaled score, masked past the end of the sequence or of the query position.
+    def _masked(b, h, i, j):
+        limit = seq_lens[b] - q_len + i + 1 if causal else seq_lens[b]
+        s = scores[b, h, i, j] * tvm.tir.const(scale, dtype)
+        return tvm.tir.if_then_else(j < limit, s, tvm.te.min_value(dtype))
+
+    j1 = te.reduce_axis((0, kv_len), name="j")
+    row_max = te.compute(
+        (batch, heads, q_len),
+        lambda b, h, i: te.max(_masked(b, h, i, j1), axis=j1),
+        name="T_paged_attention_max",
+        tag="paged_attention_max",
+    )
+
+    j2 = te.reduce_axis((0, kv_len), name="j")
+    row_sum = te.compute(
+        (batch, heads, q_len),
+        lambda b, h, i: te.sum(te.exp(_masked(b, h, i, j2) - row_max[b, h, i]), axis=j2),
+        name="T_paged_attention_sum",
+        tag="paged_attention_sum",
+    )
+
+    j3 = te.reduce_axis((0, kv_len), name="j")
+    acc = te.compute(
+        (batch, heads, q_len, head_dim),
+        lambda b, h, i, e: te.sum(
+            te.exp(_masked(b, h, i, j3) - row_max[b, h, i]) * _cache(1, b, h, j3, e), axis=j3
+        ),
+        name="T_paged_attention_acc",
+        tag="paged_attention_acc",
+    )
+
+    return te.compute(
+        (batch, heads, q_len, head_dim),
+        lambda b, h, i, e: acc[b, h, i, e] / row_sum[b, h, i],
+        name="T_paged_attention",
+        tag="paged_attention_output",
+        attrs={"causal": causal},
+    )
+
+
+def fused_attention_stages(output):
+    """Get the intermediate stages of a fused_attention or paged_attention output.
+
+    Parameters
+    ----------
+    output : tvm.te.Tensor
+        The output of fused_attention or paged_attention.
+
+    Returns
+    -------
+    stages : Tuple[tvm.te.Tensor, tvm.te.Tensor, tvm.te.Tensor, tvm.te.Tensor]
+        The scores, row max, row sum and accumulation stages.
+    """
+    prefix = output.op.tag[: -len("output")]
+    stages = {}
+
+    def _collect(tensor):
+        tag = tensor.op.tag
+        if tag.startswith(prefix) and tag not in stages:
+            stages[tag] = tensor
+            for inp in tensor.op.input_tensors:
+                _collect(inp)
+
+    _collect(output)
+    return tuple(stages[prefix + name] for name in ("scores", "max", "sum", "acc"))
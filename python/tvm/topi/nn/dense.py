@@ -20,6 +20,7 @@ import tvm
 from tvm import auto_scheduler, te
 
 from .. import tag
+from ..utils import get_const_tuple
 
 
 def matmul(
@@ -293,6 +294,102 @@ def dense_pack(data, weight, bias=None, out_dtype=None):
     return C
 
 
+def dense_weight_only_pack(weight, bits=4):
+    """Pack the low-bit quantized weight of dense_weight_only into 32-bit words.
+
+    The values are stored in two's complement, the first of each word in its least
+    significant bits.
+
+    Parameters
+    ----------
+    weight : tvm.te.Tensor
+        2-D with shape [out_dim, in_dim], of an integer type holding values in the
+        signed range of `bits`.
+
+    bits : int
+        The number of bits of a quantized value, 2, 4 or 8.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D uint32 with shape [out_dim, in_dim * bits // 32]
+    """
+    assert bits in (2, 4, 8), f"Unsupported number of bits {bits}"
+    per_word = 32 // bits
+    N, K = get_const_tuple(weight.shape)
+    assert K % per_word == 0, f"in_dim {K} is not a multiple of {per_word}"
+
+    def _pack(n, w):
+        word = tvm.tir.const(0, "uint32")
+        for i in range(per_word):
+            value = weight[n, w * per_word + i].astype("int32") & ((1 << bits) - 1)
+            word = word | (value.astype("uint32") << tvm.tir.const(i * bits, "uint32"))
+        return word
+
+    return te.compute((N, K // per_word), _pack, name="T_dense_weight_only_pack", tag=tag.INJECTIVE)
+
+
+def dense_weight_only(data, packed_weight, scales, bits=4, group_size=128, out_dtype=None):
+    """Dense with a weight quantized to a few bits, in groups of `group_size` input
+    channels sharing a scale.
+
+    The weight is dequantized in the reduction, so it is read from memory in its packed
+    form, which bounds the time of the small batches.
+
+    Parameters
+    ----------
+    data : tvm.te.Tensor
+        2-D with shape [batch, in_dim]
+
+    packed_weight : tvm.te.Tensor
+        2-D uint32 with shape [out_dim, in_dim * bits // 32], as given by
+        dense_weight_only_pack.
+
+    scales : tvm.te.Tensor
+        2-D with shape [out_dim, in_dim // group_size]
+
+    bits : int
+        The number of bits of a quantized value, 2, 4 or 8.
+
+    group_size : int
+        The number of input channels sharing a scale.
+
+    out_dtype : Optional[str]
+        The output type. This is used for mixed precision.
+
+    Returns
+    -------
+    output : tvm.te.Tensor
+        2-D with shape [batch, out_dim]
+    """
+    assert bits in (2, 4, 8), f"Unsupported number of bits {bits}"
+    if out_dtype is None:
+        out_dtype = data.dtype
+    per_word = 32 // bits
+    M, K = data.shape
+    N = packed_weight.shape[0]
+
+    idxdiv = tvm.tir.indexdiv
+    idxmod = tvm.tir.indexmod
+
+    def _weight(n, k):
+        word = packed_weight[n, idxdiv(k, per_word)]
+        shift = (idxmod(k, per_word) * bits).astype("uint32")
+        value = ((word >> shift) & tvm.tir.const((1 << bits) - 1, "uint32")).astype("int32")
+        # Sign-extend the value.
+        value = value - ((value >> (bits - 1)) << bits)
+        return value.astype(scales.dtype) * scales[n, idxdiv(k, group_size)]
+
+    k = te.reduce_axis((0, K), name="k")
+    return te.compute(
+        (M, N),
+        lambda i, j: te.sum(data[i, k].astype(out_dtype) * _weight(j, k).astype(out_dtype), axis=k),
+        name="T_dense_weight_only",
+        tag="dense_weight_only",
+        attrs={"bits": bits},
+    )
+
+
 @tvm.target.generic_func
 def dense_alter_layout(attrs, inputs, tinfos, out_type):
     """Change dense layout.
@@ -39,6 +39,7 @@ from .depthwise_conv2d_python import (
 )
 from .dilate_python import dilate_python
 from .softmax_python import softmax_python, log_softmax_python
+from .attention_python import fused_attention_python
 from .resize_python import resize1d_python, resize2d_python, resize3d_python
 from .reorg_python import reorg_python
 from .roi_align_python import roi_align_nchw_python, roi_align_nhwc_python
@@ -0,0 +1,55 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=invalid-name
+"""Fused attention operation in python"""
+import numpy as np
+
+
+def fused_attention_python(q_np, k_np, v_np, scale=None, causal=False):
+    """Scaled dot-product attention.
+    Parameters
+    ----------
+    q_np : numpy.ndarray
+        4-D query with shape [batch, heads, q_len, head_dim]
+
+    k_np : numpy.ndarray
+        4-D key with shape [batch, heads, kv_len, head_dim]
+
+    v_np : numpy.ndarray
+        4-D value with shape [batch, heads, kv_len, value_dim]
+
+    scale : Optional[float]
+        Scale applied to q * k^T, defaults to 1 / sqrt(head_dim)
+
+    causal : bool
+        Whether to mask out keys after the query position
+
+    Returns
+    -------
+    output_np : numpy.ndarray
+        4-D output with shape [batch, heads, q_len, value_dim]
+    """
+    if scale is None:
+        scale = 1.0 / np.sqrt(q_np.shape[-1])
+    scores = np.matmul(q_np, np.swapaxes(k_np, -1, -2)) * scale
+    if causal:
+        q_len, kv_len = scores.shape[-2:]
+        mask = np.triu(np.ones((q_len, kv_len), dtype=bool), k=kv_len - q_len + 1)
+        scores = np.where(mask, np.finfo(scores.dtype).min, scores)
+    e = np.exp(scores - np.amax(scores, axis=-1, keepdims=True))
+    p = e / np.sum(e, axis=-1, keepdims=True)
+    return np.matmul(p, v_np).astype(q_np.dtype)
@@ -649,3 +649,29 @@ def dense_dynamic(A, B, bias, dtype):
 def schedule_dense_dynamic(outs):
     """Create schedule for dense_dynamic."""
     return generic.schedule_extern(outs)
+
+
+def schedule_dense_weight_only(outs):
+    """Create schedule for dense_weight_only.
+
+    Each core reduces a block of output channels. The inner loop over the values of
+    a packed word is unrolled, so that the word is loaded and unpacked in registers.
+    """
+    outs = [outs] if isinstance(outs, te.tensor.Tensor) else outs
+    s = te.create_schedule([x.op for x in outs])
+
+    def _callback(op):
+        if op.tag == "dense_weight_only":
+            C = op.output(0)
+            fused = C.op not in s.outputs
+            Out = s.outputs[0].output(0) if fused else C
+            i, j = s[Out].op.axis
+            jo, ji = s[Out].split(j, factor=16)
+            s[Out].parallel(s[Out].fuse(i, jo))
+            if fused:
+                s[C].compute_at(s[Out], ji)
+            _, ki = s[C].split(s[C].op.reduce_axis[0], factor=32 // int(op.attrs["bits"]))
+            s[C].unroll(ki)
+
+    traverse_inline(s, outs[0].op, _callback)
+    return s
@@ -15,7 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 """Utilities for computing an approximate roofline model"""
-from typing import Dict, Optional, Union
+from typing import Dict, List, Optional, Union
 
 import numpy as np
 
@@ -188,12 +188,52 @@ def roofline_from_existing(
             call["Percent of Theoretical Optimal"] = profiling.Ratio(
                 per_compute_bound if compute_bound else per_mem_bound
             )
+            # The attainable FLOP/s of the roofline, from the bytes of the regions the kernel
+            # touches in global memory, i.e. assuming each of them is moved exactly once.
+            compulsory_bytes = tir.analysis.estimate_tir_bytes(prim)
+            if compulsory_bytes > 0 and flops > 0:
+                attainable_flops = min(peak_flops, flops / compulsory_bytes * peak_bandwidth)
+                call["Compulsory Bytes"] = profiling.Count(int(compulsory_bytes))
+                call["Attainable FLOP/s"] = profiling.Ratio(attainable_flops)
+                call["Percent of Attainable"] = profiling.Ratio(
+                    flops / runtime / attainable_flops * 100.0
+                )
             new_calls.append(call)
         else:
             new_calls.append(call)
     return profiling.Report(new_calls, report.device_metrics, new_configuration)
 
 
+def kernels_by_roofline_gap(report: profiling.Report) -> List[Dict]:
+    """Rank the kernels of a roofline report by the time they lose to their roofline.
+
+    The time lost by a call is its duration times the fraction of the attainable FLOP/s it
+    does not achieve, so that tuning can start with the kernels it is the most profitable for.
+
+    Parameters
+    ----------
+    report : profiling.Report
+        Profiling report from :py:func:`roofline_analysis` or
+        :py:func:`roofline_from_existing`.
+
+    Returns
+    -------
+    calls : List[Dict]
+        The calls with the "Percent of Attainable" metric, along with their lost time in
+        microseconds as "Roofline Gap (us)", sorted by decreasing lost time.
+    """
+    calls = []
+    for call in report.calls:
+        if "Percent of Attainable" not in call.keys():
+            continue
+        call = dict(call)
+        duration = call["Duration (us)"].microseconds
+        achieved = min(call["Percent of Attainable"].ratio, 100.0) / 100.0
+        call["Roofline Gap (us)"] = duration * (1.0 - achieved)
+        calls.append(call)
+    return sorted(calls, key=lambda call: call["Roofline Gap (us)"], reverse=True)
+
+
 def roofline_analysis(
     mod: IRModule,
     params: Dict[str, nd.NDArray],
@@ -224,6 +264,13 @@ def roofline_analysis(
       - Arithmetic Intensity: ratio of FLOPs per byte of data.
       - FLOP/s: floating point operations per second.
       - Bandwidth: Number of bytes loaded per second.
+      - Compulsory Bytes: bytes of the regions of the global buffers read and
+        written by the operator, see :py:func:`tvm.tir.analysis.estimate_tir_bytes`.
+      - Attainable FLOP/s: the roofline at the arithmetic intensity of the
+        compulsory bytes, i.e. the minimum of the peak FLOP/s and of the peak
+        bandwidth times the intensity.
+      - Percent of Attainable: percent of the attainable FLOP/s achieved. Use
+        :py:func:`kernels_by_roofline_gap` to rank the operators by it.
 
     Parameters
     ----------
@@ -25,19 +25,142 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "product_normal_form.h"
 
 namespace tvm {
 namespace arith {
 
+/*! \brief The counters of the Simplify memo. */
+struct SimplifyMemoStatsNode : Object {
+  int64_t hits{0};
+  int64_t misses{0};
+  int64_t invalidations{0};
+
+  void VisitAttrs(AttrVisitor* v) {
+    v->Visit("hits", &hits);
+    v->Visit("misses", &misses);
+    v->Visit("invalidations", &invalidations);
+  }
+
+  static constexpr const char* _type_key = "arith.SimplifyMemoStats";
+  TVM_DECLARE_FINAL_OBJECT_INFO(SimplifyMemoStatsNode, Object);
+};
+
+TVM_REGISTER_NODE_TYPE(SimplifyMemoStatsNode);
+
+TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
+    .set_dispatch<SimplifyMemoStatsNode>([](const ObjectRef& node, ReprPrinter* p) {
+      auto* ptr = node.as<SimplifyMemoStatsNode>();
+      p->stream << "SimplifyMemoStats(hits = " << ptr->hits << ", misses = " << ptr->misses
+                << ", invalidations = " << ptr->invalidations << ")";
+    });
+
+/*!
+ * \brief The results of Analyzer::Simplify, one table per constraint scope.
+ *
+ *  The tables hold the expressions alive, so that the identity of a key is never reused.
+ */
+class Analyzer::SimplifyMemo {
+ public:
+  bool enabled{false};
+
+  const PrimExpr* Find(const PrimExpr& expr, int steps) {
+    auto& table = scopes_.back();
+    auto it = table.find({expr, steps});
+    if (it == table.end()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    return &it->second;
+  }
+
+  void Insert(const PrimExpr& expr, int steps, const PrimExpr& result) {
+    auto& table = scopes_.back();
+    // Keep the memory bounded on passes that simplify many distinct expressions.
+    if (table.size() >= kMaxEntries) table.clear();
+    table.emplace(Key{expr, steps}, result);
+  }
+
+  // Start a table for a new constraint scope, return the function to end it.
+  // The scopes are tracked even when disabled, so that the memo can be enabled in a scope.
+  std::function<void()> EnterConstraint() {
+    size_t depth = scopes_.size();
+    scopes_.emplace_back();
+    return [this, depth]() { scopes_.resize(depth); };
+  }
+
+  void Clear() {
+    if (!enabled) return;
+    ++stats_.invalidations;
+    for (auto& table : scopes_) {
+      table.clear();
+    }
+  }
+
+  void Disable() {
+    Clear();
+    enabled = false;
+  }
+
+  ObjectRef GetStats() const { return ObjectRef(make_object<SimplifyMemoStatsNode>(stats_)); }
+
+  void ResetStats() { stats_ = SimplifyMemoStatsNode(); }
+
+ private:
+  struct Key {
+    PrimExpr expr;
+    int steps;
+    bool operator==(const Key& other) const {
+      return expr.same_as(other.expr) && steps == other.steps;
+    }
+  };
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return ObjectPtrHash()(key.expr) ^ (static_cast<size_t>(key.steps) << 1);
+    }
+  };
+  static constexpr size_t kMaxEntries = 1 << 16;
+  std::vector<std::unordered_map<Key, PrimExpr, KeyHash>> scopes_{1};
+  SimplifyMemoStatsNode stats_;
+};
+
 Analyzer::Analyzer()
     : const_int_bound(this),
       modular_set(this),
       rewrite_simplify(this),
       canonical_simplify(this),
-      int_set(this) {}
+      int_set(this),
+      simplify_memo_(std::make_unique<SimplifyMemo>()) {}
+
+Analyzer::~Analyzer() {}
+
+void Analyzer::EnableSimplifyMemo(bool enable) {
+  if (enable) {
+    simplify_memo_->enabled = true;
+  } else {
+    simplify_memo_->Disable();
+  }
+}
+
+void Analyzer::ClearSimplifyMemo() { simplify_memo_->Clear(); }
+
+ObjectRef Analyzer::GetSimplifyMemoStats() const { return simplify_memo_->GetStats(); }
+
+void Analyzer::ResetSimplifyMemoStats() { simplify_memo_->ResetStats(); }
+
+bool Analyzer::HasEmptyContext() const {
+  return num_binds_ == 0 && constraint_depth_ == 0 &&
+         rewrite_simplify.GetEnabledExtensions() == RewriteSimplifier::kNone;
+}
 
 void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
+  simplify_memo_->Clear();
+  ++num_binds_;
   PrimExpr new_expr = expr;
   new_expr = this->canonical_simplify(new_expr);
   new_expr = this->rewrite_simplify(new_expr);
@@ -52,6 +175,8 @@ void Analyzer::Bind(const Var& var, const PrimExpr& expr, bool allow_override) {
 
 void Analyzer::Bind(const Var& var, const Range& range, bool allow_override) {
   ICHECK(range.defined());
+  simplify_memo_->Clear();
+  ++num_binds_;
   if (tir::is_one(range->extent)) {
     this->Bind(var, range->min, allow_override);
   } else {
@@ -77,6 +202,9 @@ void ConstraintContext::EnterWithScope() {
   recovery_functions_.push_back(analyzer_->rewrite_simplify.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->int_set.EnterConstraint(constraint_));
   recovery_functions_.push_back(analyzer_->transitive_comparisons.EnterConstraint(constraint_));
+  recovery_functions_.push_back(analyzer_->simplify_memo_->EnterConstraint());
+  ++analyzer_->constraint_depth_;
+  recovery_functions_.push_back([analyzer = analyzer_]() { --analyzer->constraint_depth_; });
 }
 
 void ConstraintContext::ExitWithScope() {
@@ -180,6 +308,18 @@ bool Analyzer::CanProve(const PrimExpr& expr, ProofStrength strength) {
 }
 
 PrimExpr Analyzer::Simplify(const PrimExpr& expr, int steps) {
+  if (simplify_memo_->enabled && !expr->IsInstance<IntImmNode>()) {
+    if (const PrimExpr* res = simplify_memo_->Find(expr, steps)) {
+      return *res;
+    }
+    PrimExpr res = SimplifyImpl(expr, steps);
+    simplify_memo_->Insert(expr, steps, res);
+    return res;
+  }
+  return SimplifyImpl(expr, steps);
+}
+
+PrimExpr Analyzer::SimplifyImpl(const PrimExpr& expr, int steps) {
   PrimExpr res = expr;
 
   // Always starts with a canonical simplification, as some structural property
@@ -235,6 +375,15 @@ TVM_REGISTER_GLOBAL("arith.CreateAnalyzer").set_body([](TVMArgs args, TVMRetValu
     } else if (name == "reset_rewrite_simplify_stats") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { self->rewrite_simplify.ResetStatsCounters(); });
+    } else if (name == "enable_simplify_memo") {
+      return PackedFunc(
+          [self](TVMArgs args, TVMRetValue* ret) { self->EnableSimplifyMemo(args[0]); });
+    } else if (name == "get_simplify_memo_stats") {
+      return PackedFunc(
+          [self](TVMArgs args, TVMRetValue* ret) { *ret = self->GetSimplifyMemoStats(); });
+    } else if (name == "reset_simplify_memo_stats") {
+      return PackedFunc(
+          [self](TVMArgs args, TVMRetValue* ret) { self->ResetSimplifyMemoStats(); });
     } else if (name == "canonical_simplify") {
       return PackedFunc(
           [self](TVMArgs args, TVMRetValue* ret) { *ret = self->canonical_simplify(args[0]); });
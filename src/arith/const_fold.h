@@ -72,7 +72,7 @@ inline Optional<PrimExpr> TryConstFold(PrimExpr a);
  * \return the checked result.
  */
 inline bool IsIndexType(const DataType& type) {
-  return type.is_int() && type.lanes() == 1 && (type.bits() == 32 || type.bits() == 64);
+  return type.is_int() && type.is_scalar() && (type.bits() == 32 || type.bits() == 64);
 }
 
 /*! \brief Helper to get const folding result repr in int64. */
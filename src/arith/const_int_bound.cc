@@ -172,6 +172,8 @@ class ConstIntBoundAnalyzer::Impl
     // Entry(op) = Union(Entry(base + i * stride) | 0 <= i < lanes)
     // Note that `base + i * stride` is linear w.r.t. `i`
     // Entry(op) = Union(Entry(base + i * stride) | i = 0, i = lanes-1)
+    // The lanes of a scalable vector are only known at runtime.
+    if (op->dtype.is_scalable_vector()) return Everything(op->dtype);
     Entry a = VisitExpr(op->base);
     Entry b = VisitExpr(op->base + (op->lanes - 1) * op->stride);
     return Union(a, b);
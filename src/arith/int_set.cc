@@ -463,7 +463,7 @@ class IntervalSetEvaluator : public ExprFunctor<IntervalSet(const PrimExpr&)> {
     ICHECK(eval_vec_);
     IntervalSet base = Eval(op->base);
     PVar<IntImm> stride;
-    if (stride.Match(op->stride)) {
+    if (stride.Match(op->stride) && !op->dtype.is_scalable_vector()) {
       DataType t = op->base.dtype();
       int64_t vstride = stride.Eval()->value;
       if (vstride > 0) {
@@ -957,7 +957,7 @@ IntSet EvalSet(PrimExpr e, const Map<Var, IntSet>& dom_map) {
 
 IntSet IntSet::Vector(PrimExpr x) {
   // short cut: simply get single point
-  if (x.dtype().lanes() == 1) {
+  if (x.dtype().is_scalar()) {
     return IntSet::SinglePoint(x);
   } else {
     // vector case.
@@ -28,6 +28,9 @@
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "../support/utils.h"
@@ -1413,9 +1416,98 @@ bool IterRangeSanityCheck(const Map<Var, Range>& iter_ranges) {
   return true;
 }
 
-IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
-                            const PrimExpr& predicate, IterMapLevel check_level,
-                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+/*!
+ * \brief A bounded least recently used cache of the results of DetectIterMap.
+ *
+ *  Only the results of analyzers with an empty context are cached, as they only depend on
+ *  the inputs. The inputs are compared structurally with the variables compared by identity.
+ */
+class IterMapCache {
+ public:
+  struct Key {
+    Array<ObjectRef> inputs;
+    int check_level;
+    bool simplify_trivial_iterators;
+    size_t hash;
+
+    Key(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+        const PrimExpr& predicate, IterMapLevel check_level, bool simplify_trivial_iterators)
+        : inputs({indices, input_iters, predicate}),
+          check_level(static_cast<int>(check_level)),
+          simplify_trivial_iterators(simplify_trivial_iterators) {
+      hash = support::HashCombine(StructuralHash()(inputs), this->check_level);
+      hash = support::HashCombine(hash, simplify_trivial_iterators);
+    }
+
+    bool operator==(const Key& other) const {
+      return hash == other.hash && check_level == other.check_level &&
+             simplify_trivial_iterators == other.simplify_trivial_iterators &&
+             StructuralEqual()(inputs, other.inputs);
+    }
+  };
+
+  static IterMapCache* Global() {
+    static IterMapCache* inst = new IterMapCache();
+    return inst;
+  }
+
+  bool Find(const Key& key, IterMapResult* result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = index_.equal_range(key.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->first == key) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        *result = Copy(it->second->second);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Insert(Key key, const IterMapResult& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kCapacity) {
+      auto range = index_.equal_range(entries_.back().first.hash);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == std::prev(entries_.end())) {
+          index_.erase(it);
+          break;
+        }
+      }
+      entries_.pop_back();
+    }
+    size_t hash = key.hash;
+    entries_.emplace_front(std::move(key), Copy(result));
+    index_.emplace(hash, entries_.begin());
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    entries_.clear();
+  }
+
+ private:
+  // The callers may update the result in place, so each of them gets its own.
+  static IterMapResult Copy(const IterMapResult& result) {
+    IterMapResult copy;
+    copy->indices = result->indices;
+    copy->errors = result->errors;
+    copy->padding_predicate = result->padding_predicate;
+    return copy;
+  }
+
+  static constexpr size_t kCapacity = 1024;
+  std::mutex mutex_;
+  /*! \brief The entries from the most to the least recently used. */
+  std::list<std::pair<Key, IterMapResult>> entries_;
+  std::unordered_multimap<size_t, std::list<std::pair<Key, IterMapResult>>::iterator> index_;
+};
+
+IterMapResult DetectIterMapImpl(const Array<PrimExpr>& indices,
+                                const Map<Var, Range>& input_iters, const PrimExpr& predicate,
+                                IterMapLevel check_level, arith::Analyzer* analyzer,
+                                bool simplify_trivial_iterators) {
   IterMapResult result;
 
   // Overall detection algorithm is divided into two steps:
@@ -1498,6 +1590,28 @@ IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range
   return result;
 }
 
+IterMapResult DetectIterMap(const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
+                            const PrimExpr& predicate, IterMapLevel check_level,
+                            arith::Analyzer* analyzer, bool simplify_trivial_iterators) {
+  if (!analyzer->HasEmptyContext()) {
+    return DetectIterMapImpl(indices, input_iters, predicate, check_level, analyzer,
+                             simplify_trivial_iterators);
+  }
+  IterMapCache* cache = IterMapCache::Global();
+  IterMapCache::Key key(indices, input_iters, predicate, check_level,
+                        simplify_trivial_iterators);
+  IterMapResult result;
+  if (cache->Find(key, &result)) return result;
+  result = DetectIterMapImpl(indices, input_iters, predicate, check_level, analyzer,
+                             simplify_trivial_iterators);
+  cache->Insert(std::move(key), result);
+  return result;
+}
+
+TVM_REGISTER_GLOBAL("arith.ClearIterMapCache").set_body_typed([]() {
+  IterMapCache::Global()->Clear();
+});
+
 TVM_REGISTER_GLOBAL("arith.DetectIterMap")
     .set_body_typed([](const Array<PrimExpr>& indices, const Map<Var, Range>& input_iters,
                        const PrimExpr& input_pred, int check_level,
@@ -57,7 +57,7 @@ class Scalarizer : public ExprMutator {
     }
   }
   PrimExpr VisitExpr_(const LetNode* op) final {
-    if (op->value.dtype().lanes() == 1) {
+    if (op->value.dtype().is_scalar()) {
       return ExprMutator::VisitExpr_(op);
     }
 
@@ -22,6 +22,7 @@
  * \brief Feature extraction for the cost model
  */
 
+#include <dmlc/json.h>
 #include <tvm/arith/analyzer.h>
 #include <tvm/auto_scheduler/feature.h>
 #include <tvm/auto_scheduler/measure.h>
@@ -40,7 +41,9 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <mutex>
 #include <numeric>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
@@ -1360,29 +1363,74 @@ void GetPerStoreFeatureName(int max_n_bufs, std::vector<std::string>* ret) {
   // section total : 3
 }
 
-void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, int max_n_bufs,
-                                   std::vector<float>* feature, std::atomic<int>* error_ct) {
-  auto [sch, tensors] = task->compute_dag.ApplySteps(state->transform_steps);
+/*!
+ * \brief The features of the states extracted, keyed by the task and the serialized transform
+ * steps of a state. The states proposed by the search policies recur across the rounds of the
+ * evolutionary search and the updates of the cost model, and they need not be lowered again.
+ */
+class FeatureCache {
+ public:
+  /*! \brief The number of states cached, beyond which the cache is cleared */
+  static constexpr size_t kCapacity = 8192;
 
-  // When inlining, replace const matrices with const values.
-  // Produces wrong IR, but good enough for feature extraction, and
-  // can improve the speed of feature extraction/search.  Must be
-  // called before ScheduleToModule to have an effect.
-  sch = sch.normalize_for_feature_extraction();
+  static FeatureCache* Global() {
+    static FeatureCache cache;
+    return &cache;
+  }
 
-  try {
-    const std::string& name = "main";
-    auto pass_ctx = tvm::transform::PassContext::Current();
+  /*! \brief Look up the feature of a state, an empty feature meaning the state is invalid */
+  bool Get(const std::string& key, std::vector<float>* feature) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return false;
+    }
+    *feature = it->second;
+    return true;
+  }
 
-    auto mod = ScheduleToModule(sch, Array<ObjectRef>{tensors.begin(), tensors.end()}, name,
-                                std::unordered_map<te::Tensor, te::Buffer>(),
-                                GlobalVarSupply(NameSupply("")));
+  void Put(const std::string& key, const std::vector<float>& feature) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= kCapacity) {
+      entries_.clear();
+    }
+    entries_.emplace(key, feature);
+  }
 
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+  }
+
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<float>> entries_;
+};
+
+/*!
+ * \brief The context of feature extraction shared by all the states of a task, built once on the
+ * calling thread, whose PassContext is the one configuring the lowering.
+ */
+struct FeatureExtractionContext {
+  /*! \brief The search task */
+  SearchTask task;
+  /*! \brief The passes checking the validity of a state on the target, if any */
+  Optional<tvm::transform::Pass> verify;
+  /*! \brief The prefix of the cache keys of the states of the task */
+  std::string key_prefix;
+
+  FeatureExtractionContext(const SearchTask& task, int max_n_bufs) : task(task) {
+    auto pass_ctx = tvm::transform::PassContext::Current();
     bool disable_vectorize =
         pass_ctx->GetConfig<Bool>("tir.disable_vectorize", Bool(false)).value();
     bool instrument_bound_checkers =
         pass_ctx->GetConfig<Bool>("tir.instrument_bound_checkers", Bool(false)).value();
-
+    const HardwareParams& hw = task->hardware_params;
     if (IsGPUTask(task)) {
       auto pass_list = Array<tvm::transform::Pass>();
       // Phase 0
@@ -1396,20 +1444,74 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
       pass_list.push_back(tir::transform::StorageRewrite());
       pass_list.push_back(tir::transform::Simplify());
       tvm::Map<String, tvm::PrimExpr> gpu_params{
-          {"max_shared_memory_per_block", task->hardware_params->max_shared_memory_per_block},
-          {"max_local_memory_per_block", task->hardware_params->max_local_memory_per_block},
-          {"max_threads_per_block", task->hardware_params->max_threads_per_block},
-          {"max_vector_bytes", task->hardware_params->vector_unit_bytes},
-          {"max_vthread", task->hardware_params->max_vthread_extent},
+          {"max_shared_memory_per_block", hw->max_shared_memory_per_block},
+          {"max_local_memory_per_block", hw->max_local_memory_per_block},
+          {"max_threads_per_block", hw->max_threads_per_block},
+          {"max_vector_bytes", hw->vector_unit_bytes},
+          {"max_vthread", hw->max_vthread_extent},
       };
       pass_list.push_back(tir::transform::VerifyGPUCode(gpu_params));
-      const auto& optimize = tir::transform::Sequential(pass_list);
-      optimize(mod);
+      verify = tir::transform::Sequential(pass_list);
+    } else if (IsHexagonTask(task)) {
+      verify = tir::transform::Sequential({tir::transform::VerifyVTCMLimit(task->target)});
     }
-    if (IsHexagonTask(task)) {
-      Target target = task->target;
-      const auto& optimize = tir::transform::Sequential({tir::transform::VerifyVTCMLimit(target)});
-      optimize(mod);
+    // The workload key does not identify the computation of the tasks created without a workload
+    // registered, so the key also has the hash of the printed ComputeDAG
+    std::string dag = task->compute_dag.PrintDAG();
+    std::ostringstream os;
+    os << task->workload_key << '\t' << std::hash<std::string>()(dag) << '\t'
+       << task->target->str() << '\t' << max_n_bufs << ' '
+       << hw->cache_line_bytes << ' ' << hw->max_shared_memory_per_block << ' '
+       << hw->max_local_memory_per_block << ' ' << hw->max_threads_per_block << ' '
+       << hw->vector_unit_bytes << ' ' << hw->max_vthread_extent << ' ' << disable_vectorize
+       << instrument_bound_checkers << '\t';
+    key_prefix = os.str();
+  }
+};
+
+/*! \brief Serialize the transform steps of a state, as in the measure records */
+std::string SerializeTransformSteps(const Array<Step>& transform_steps) {
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginArray(false);
+  for (const Step& step : transform_steps) {
+    writer.WriteArraySeperator();
+    writer.BeginArray(false);
+    step->WriteToRecord(&writer);
+    writer.EndArray();
+  }
+  writer.EndArray();
+  return os.str();
+}
+
+void GetPerStoreFeaturesWorkerFunc(const FeatureExtractionContext& ctx, const State& state,
+                                   int max_n_bufs, std::vector<float>* feature,
+                                   std::atomic<int>* error_ct) {
+  const SearchTask& task = ctx.task;
+  std::string key = ctx.key_prefix + SerializeTransformSteps(state->transform_steps);
+  if (FeatureCache::Global()->Get(key, feature)) {
+    if (feature->empty()) {
+      (*error_ct)++;
+    }
+    return;
+  }
+
+  auto [sch, tensors] = task->compute_dag.ApplySteps(state->transform_steps);
+
+  // When inlining, replace const matrices with const values.
+  // Produces wrong IR, but good enough for feature extraction, and
+  // can improve the speed of feature extraction/search.  Must be
+  // called before ScheduleToModule to have an effect.
+  sch = sch.normalize_for_feature_extraction();
+
+  try {
+    const std::string& name = "main";
+    auto mod = ScheduleToModule(sch, Array<ObjectRef>{tensors.begin(), tensors.end()}, name,
+                                std::unordered_map<te::Tensor, te::Buffer>(),
+                                GlobalVarSupply(NameSupply("")));
+    if (ctx.verify.defined()) {
+      // The lowered module is only checked, the features are extracted before these passes
+      ctx.verify.value()(mod);
     }
     const auto& optimize =
         tir::transform::Sequential(Array<tvm::transform::Pass>{tir::transform::Simplify()});
@@ -1417,8 +1519,10 @@ void GetPerStoreFeaturesWorkerFunc(const SearchTask& task, const State& state, i
     PrimFunc prim_func = Downcast<PrimFunc>(mod->Lookup(name));
     GetPerStoreFeature(prim_func, task->hardware_params->cache_line_bytes, max_n_bufs, feature);
   } catch (Error& e) {
+    feature->clear();
     (*error_ct)++;
   }
+  FeatureCache::Global()->Put(key, *feature);
 }
 
 void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask& task,
@@ -1428,10 +1532,11 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const SearchTask&
   features->assign(states.size(), std::vector<float>());
 
   std::atomic<int> error_ct(0);
+  FeatureExtractionContext ctx(task, max_n_bufs);
 
   support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&task, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(task, states[i], max_n_bufs,
+                        [&ctx, &states, &max_n_bufs, &features, &error_ct](int i) {
+                          GetPerStoreFeaturesWorkerFunc(ctx, states[i], max_n_bufs,
                                                         &(*features)[i], &error_ct);
                         });
 }
@@ -1443,12 +1548,52 @@ void GetPerStoreFeaturesFromStates(const Array<State>& states, const std::vector
   features->assign(states.size(), std::vector<float>());
 
   std::atomic<int> error_ct(0);
+  // The states of a task share its context
+  std::vector<FeatureExtractionContext> contexts;
+  std::vector<size_t> context_ids(states.size());
+  std::unordered_map<const SearchTaskNode*, size_t> task_to_context;
+  for (size_t i = skip_first_n_feature_extraction; i < states.size(); ++i) {
+    auto it = task_to_context.find(tasks[i].get());
+    if (it == task_to_context.end()) {
+      it = task_to_context.emplace(tasks[i].get(), contexts.size()).first;
+      contexts.emplace_back(tasks[i], max_n_bufs);
+    }
+    context_ids[i] = it->second;
+  }
 
-  support::parallel_for(skip_first_n_feature_extraction, states.size(),
-                        [&tasks, &states, &max_n_bufs, &features, &error_ct](int i) {
-                          GetPerStoreFeaturesWorkerFunc(tasks[i], states[i], max_n_bufs,
-                                                        &(*features)[i], &error_ct);
-                        });
+  support::parallel_for(
+      skip_first_n_feature_extraction, states.size(),
+      [&contexts, &context_ids, &states, &max_n_bufs, &features, &error_ct](int i) {
+        GetPerStoreFeaturesWorkerFunc(contexts[context_ids[i]], states[i], max_n_bufs,
+                                      &(*features)[i], &error_ct);
+      });
+}
+
+/*!
+ * \brief Get the ComputeDAG of a workload key, which is analyzed once per workload and shared
+ * by the tasks rebuilt from the measure records.
+ */
+ComputeDAG GetComputeDAGFromWorkloadKey(const std::string& workload_key) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, ComputeDAG> dags;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = dags.find(workload_key);
+    if (it != dags.end()) {
+      return it->second;
+    }
+  }
+  const auto* workload_key_to_tensors =
+      tvm::runtime::Registry::Get("auto_scheduler.workload_key_to_tensors");
+  ICHECK(workload_key_to_tensors != nullptr);
+  Array<te::Tensor> tensors = (*workload_key_to_tensors)(workload_key);
+  ComputeDAG dag(tensors);
+  std::lock_guard<std::mutex> lock(mutex);
+  if (dags.size() >= FeatureCache::kCapacity) {
+    dags.clear();
+  }
+  dags.emplace(workload_key, dag);
+  return dag;
 }
 
 void GetPerStoreFeaturesFromFile(const std::string& filename, int max_lines, int max_n_bufs,
@@ -1466,10 +1611,6 @@ void GetPerStoreFeaturesFromFile(const std::string& filename, int max_lines, int
   // task_id -> min_cost
   std::vector<float> min_costs;
 
-  const auto* workload_key_to_tensors =
-      tvm::runtime::Registry::Get("auto_scheduler.workload_key_to_tensors");
-  ICHECK(workload_key_to_tensors != nullptr);
-
   // read from file
   RecordReader reader(filename);
   auto cur_inp = make_object<MeasureInputNode>();
@@ -1484,13 +1625,12 @@ void GetPerStoreFeaturesFromFile(const std::string& filename, int max_lines, int
     auto find_res = task_cache.find(key);
     if (find_res == task_cache.end()) {
       // rebuild task
-      Array<te::Tensor> tensors = (*workload_key_to_tensors)(workload_key);
       Target target = cur_inp->task->target;
       Target target_host = cur_inp->task->target_host;
       CheckAndUpdateHostConsistency(&target, &target_host);
-      task = SearchTask(ComputeDAG(tensors), workload_key, target, target_host,
-                        cur_inp->task->hardware_params, cur_inp->task->layout_rewrite_option,
-                        cur_inp->task->task_input_names);
+      task = SearchTask(GetComputeDAGFromWorkloadKey(workload_key), workload_key, target,
+                        target_host, cur_inp->task->hardware_params,
+                        cur_inp->task->layout_rewrite_option, cur_inp->task->task_input_names);
       task_id = task_cache.size();
 
       // compute min cost for each task
@@ -1535,10 +1675,6 @@ void GetPerStoreFeaturesFromMeasurePairs(const Array<MeasureInput>& inputs,
   // task_id -> min_cost
   std::vector<float> min_costs;
 
-  const auto* workload_key_to_tensors =
-      tvm::runtime::Registry::Get("auto_scheduler.workload_key_to_tensors");
-  ICHECK(workload_key_to_tensors != nullptr);
-
   tasks.reserve(inputs.size());
   normalized_throughputs->reserve(inputs.size());
   task_ids->reserve(inputs.size());
@@ -1556,14 +1692,13 @@ void GetPerStoreFeaturesFromMeasurePairs(const Array<MeasureInput>& inputs,
       } else {
         // The measure input is incomplete, rebuild task for incomplete measure pairs read from file
         try {
-          Array<te::Tensor> tensors = (*workload_key_to_tensors)(workload_key);
           Target target = inputs[i]->task->target;
           Target target_host = inputs[i]->task->target_host;
           CheckAndUpdateHostConsistency(&target, &target_host);
-          task =
-              SearchTask(ComputeDAG(tensors), workload_key, target, target_host,
-                         inputs[i]->task->hardware_params, inputs[i]->task->layout_rewrite_option,
-                         inputs[i]->task->task_input_names);
+          task = SearchTask(GetComputeDAGFromWorkloadKey(workload_key), workload_key, target,
+                            target_host, inputs[i]->task->hardware_params,
+                            inputs[i]->task->layout_rewrite_option,
+                            inputs[i]->task->task_input_names);
         } catch (std::exception& e) {
           // Cannot build ComputeDAG from workload key, the task may have not been registered in
           // this search round
@@ -1758,5 +1893,13 @@ TVM_REGISTER_GLOBAL("auto_scheduler.FeaturesFromPrimFunc")
       return ary;
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.ClearFeatureCache").set_body_typed([]() {
+  FeatureCache::Global()->Clear();
+});
+
+TVM_REGISTER_GLOBAL("auto_scheduler.FeatureCacheSize").set_body_typed([]() {
+  return static_cast<int64_t>(FeatureCache::Global()->Size());
+});
+
 }  // namespace auto_scheduler
 }  // namespace tvm
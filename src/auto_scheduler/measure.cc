@@ -127,7 +127,8 @@ Array<BuildResult> LocalBuilderNode::Build(const Array<MeasureInput>& inputs, in
 
 /********** LocalRunner **********/
 LocalRunner::LocalRunner(int timeout, int number, int repeat, int min_repeat_ms,
-                         double cooldown_interval, bool enable_cpu_cache_flush, int device) {
+                         double cooldown_interval, bool enable_cpu_cache_flush, int device,
+                         double max_rel_ci, int max_measure_ms) {
   ObjectPtr<LocalRunnerNode> node = make_object<LocalRunnerNode>();
   node->timeout = timeout;
   node->number = number;
@@ -136,6 +137,8 @@ LocalRunner::LocalRunner(int timeout, int number, int repeat, int min_repeat_ms,
   node->cooldown_interval = cooldown_interval;
   node->enable_cpu_cache_flush = enable_cpu_cache_flush;
   node->device = device;
+  node->max_rel_ci = max_rel_ci;
+  node->max_measure_ms = max_measure_ms;
   data_ = std::move(node);
 }
 
@@ -144,7 +147,7 @@ Array<MeasureResult> LocalRunnerNode::Run(const Array<MeasureInput>& inputs,
   if (const auto* f = runtime::Registry::Get("auto_scheduler.local_runner.run")) {
     Array<MeasureResult> results =
         (*f)(inputs, build_results, timeout, number, repeat, min_repeat_ms, cooldown_interval,
-             enable_cpu_cache_flush, verbose, device);
+             enable_cpu_cache_flush, verbose, device, max_rel_ci, max_measure_ms);
     return results;
   }
   LOG(FATAL) << "auto_scheduler.local_runner.run is not registered. "
@@ -156,7 +159,8 @@ Array<MeasureResult> LocalRunnerNode::Run(const Array<MeasureInput>& inputs,
 /********** RPCRunner **********/
 RPCRunner::RPCRunner(const String& key, const String& host, int port, int priority, int n_parallel,
                      int timeout, int number, int repeat, int min_repeat_ms,
-                     double cooldown_interval, bool enable_cpu_cache_flush, int device) {
+                     double cooldown_interval, bool enable_cpu_cache_flush, int device,
+                     double max_rel_ci, int max_measure_ms) {
   auto node = make_object<RPCRunnerNode>();
   node->key = key;
   node->host = host;
@@ -170,6 +174,8 @@ RPCRunner::RPCRunner(const String& key, const String& host, int port, int priori
   node->cooldown_interval = cooldown_interval;
   node->enable_cpu_cache_flush = enable_cpu_cache_flush;
   node->device = device;
+  node->max_rel_ci = max_rel_ci;
+  node->max_measure_ms = max_measure_ms;
   data_ = std::move(node);
 }
 
@@ -178,7 +184,8 @@ Array<MeasureResult> RPCRunnerNode::Run(const Array<MeasureInput>& inputs,
   if (const auto* f = runtime::Registry::Get("auto_scheduler.rpc_runner.run")) {
     Array<MeasureResult> results =
         (*f)(inputs, build_results, key, host, port, priority, n_parallel, timeout, number, repeat,
-             min_repeat_ms, cooldown_interval, enable_cpu_cache_flush, verbose, device);
+             min_repeat_ms, cooldown_interval, enable_cpu_cache_flush, verbose, device, max_rel_ci,
+             max_measure_ms);
     return results;
   } else {
     LOG(FATAL) << "auto_scheduler.rpc_runner.run is not registered. "
@@ -411,17 +418,20 @@ TVM_REGISTER_GLOBAL("auto_scheduler.LocalBuilder")
 
 TVM_REGISTER_GLOBAL("auto_scheduler.LocalRunner")
     .set_body_typed([](int timeout, int number, int repeat, int min_repeat_ms,
-                       double cooldown_interval, bool enable_cpu_cache_flush, int device) {
+                       double cooldown_interval, bool enable_cpu_cache_flush, int device,
+                       double max_rel_ci, int max_measure_ms) {
       return LocalRunner(timeout, number, repeat, min_repeat_ms, cooldown_interval,
-                         enable_cpu_cache_flush, device);
+                         enable_cpu_cache_flush, device, max_rel_ci, max_measure_ms);
     });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.RPCRunner")
     .set_body_typed([](const String& key, const String& host, int port, int priority,
                        int n_parallel, int timeout, int number, int repeat, int min_repeat_ms,
-                       double cooldown_interval, bool enable_cpu_cache_flush, int device) {
+                       double cooldown_interval, bool enable_cpu_cache_flush, int device,
+                       double max_rel_ci, int max_measure_ms) {
       return RPCRunner(key, host, port, priority, n_parallel, timeout, number, repeat,
-                       min_repeat_ms, cooldown_interval, enable_cpu_cache_flush, device);
+                       min_repeat_ms, cooldown_interval, enable_cpu_cache_flush, device,
+                       max_rel_ci, max_measure_ms);
     });
 
 }  // namespace auto_scheduler
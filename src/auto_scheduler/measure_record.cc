@@ -28,7 +28,11 @@
 #include <tvm/auto_scheduler/transform_step.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <fstream>
+#include <iomanip>
+#include <map>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -310,9 +314,11 @@ namespace auto_scheduler {
 TVM_REGISTER_OBJECT_TYPE(RecordToFileNode);
 TVM_REGISTER_OBJECT_TYPE(RecordReaderNode);
 
-RecordToFile::RecordToFile(String filename) {
+RecordToFile::RecordToFile(String filename, int index_best_k) {
+  CHECK_GE(index_best_k, 0) << "ValueError: `index_best_k` must be non-negative";
   auto node = make_object<RecordToFileNode>();
   node->filename = std::move(filename);
+  node->index_best_k = index_best_k;
   data_ = std::move(node);
 }
 
@@ -349,10 +355,224 @@ void ReadMeasureRecord(const std::string& str, MeasureInputNode* inp, MeasureRes
   }
 }
 
+/********** Record index **********/
+
+/*!
+ * \brief The index of a log file, which keeps the byte offsets of the best records of each workload
+ * and target. It is stored as a text file, one line per workload and target:
+ * `workload_key \t target \t offset:cost,offset:cost,...`, after a header line with the size of
+ * the log file indexed and the number of best records kept.
+ */
+class RecordIndex {
+ public:
+  /*! \brief The key of an entry, i.e. the workload key and the target string */
+  using Key = std::pair<std::string, std::string>;
+  /*! \brief The best records of an entry, as pairs of cost and offset sorted by the cost */
+  using Records = std::vector<std::pair<double, int64_t>>;
+
+  explicit RecordIndex(int best_k) : best_k_(best_k) {}
+
+  /*!
+   * \brief Open the index of a log file, rebuilding it if it is missing or out of date, and
+   * indexing the records appended after it is updated.
+   * \param filename The name of the log file
+   * \param best_k The number of best records kept, -1 to accept any index file found
+   * \return The index, or NullOpt if best_k is -1 and there is no index file
+   */
+  static std::optional<RecordIndex> Open(const std::string& filename, int best_k) {
+    std::optional<RecordIndex> index = Load(RecordIndexFileName(filename));
+    int64_t log_size = FileSize(filename);
+    if (!index.has_value() || index->log_size_ > log_size ||
+        (best_k != -1 && index->best_k_ != best_k)) {
+      // The log file is rewritten, or the index is built with a different k
+      if (best_k == -1 && !index.has_value()) {
+        return std::nullopt;
+      }
+      index = RecordIndex(best_k == -1 ? index->best_k_ : best_k);
+    }
+    index->Scan(filename);
+    return index;
+  }
+
+  /*! \brief Index a record */
+  void Add(const MeasureInputNode* inp, const MeasureResultNode* res, int64_t offset) {
+    if (res->error_no != static_cast<int>(MeasureErrorNO::kNoError) || res->costs.empty()) {
+      return;
+    }
+    double cost = 0.0;
+    for (const PrimExpr& c : res->costs) {
+      const auto* fimm = c.as<FloatImmNode>();
+      ICHECK(fimm != nullptr) << "ValueError: The costs of a record must be floats";
+      cost += fimm->value;
+    }
+    cost /= res->costs.size();
+    Records& records = entries_[Key(inp->task->workload_key, inp->task->target->str())];
+    auto it = std::upper_bound(records.begin(), records.end(), std::make_pair(cost, offset));
+    records.insert(it, std::make_pair(cost, offset));
+    if (static_cast<int>(records.size()) > best_k_) {
+      records.pop_back();
+    }
+  }
+
+  /*! \brief Index the records of a log file after the part already indexed */
+  void Scan(const std::string& filename) {
+    std::ifstream infile(filename, std::ifstream::in | std::ifstream::binary);
+    if (!infile.is_open()) {
+      return;
+    }
+    infile.seekg(log_size_);
+    auto inp = make_object<MeasureInputNode>();
+    auto res = make_object<MeasureResultNode>();
+    std::string line, log_version;
+    for (int64_t offset = log_size_; std::getline(infile, line);) {
+      if (infile.eof()) {
+        // An incomplete last line, which is being written
+        break;
+      }
+      if (!line.empty() && line[0] != '#' && line[0] != ' ') {
+        ReadMeasureRecord(line, inp.get(), res.get(), &log_version);
+        Add(inp.get(), res.get(), offset);
+      }
+      offset += line.size() + 1;
+      log_size_ = offset;
+    }
+  }
+
+  /*! \brief Save the index to a file */
+  void Save(const std::string& filename) const {
+    std::ofstream ofs(filename, std::ofstream::out | std::ofstream::trunc);
+    ofs << log_size_ << ' ' << best_k_ << '\n' << std::setprecision(17);
+    for (const auto& kv : entries_) {
+      ofs << kv.first.first << '\t' << kv.first.second << '\t';
+      for (size_t i = 0; i < kv.second.size(); ++i) {
+        ofs << (i == 0 ? "" : ",") << kv.second[i].second << ':' << kv.second[i].first;
+      }
+      ofs << '\n';
+    }
+  }
+
+  /*! \brief The sorted offsets of the best records of a workload, or all workloads if NullOpt */
+  std::vector<int64_t> Offsets(const Optional<String>& workload_key) const {
+    std::vector<int64_t> offsets;
+    for (const auto& kv : entries_) {
+      if (workload_key.defined() && kv.first.first != workload_key.value()) {
+        continue;
+      }
+      for (const auto& record : kv.second) {
+        offsets.push_back(record.second);
+      }
+    }
+    std::sort(offsets.begin(), offsets.end());
+    return offsets;
+  }
+
+  /*! \brief The size of the log file indexed */
+  int64_t log_size() const { return log_size_; }
+  /*! \brief Set the size of the log file indexed */
+  void set_log_size(int64_t log_size) { log_size_ = log_size; }
+
+ private:
+  static int64_t FileSize(const std::string& filename) {
+    std::ifstream infile(filename, std::ifstream::ate | std::ifstream::binary);
+    return infile.is_open() ? static_cast<int64_t>(infile.tellg()) : 0;
+  }
+
+  static std::optional<RecordIndex> Load(const std::string& filename) {
+    std::ifstream infile(filename);
+    int64_t log_size;
+    int best_k;
+    if (!infile.is_open() || !(infile >> log_size >> best_k)) {
+      return std::nullopt;
+    }
+    RecordIndex index(best_k);
+    index.log_size_ = log_size;
+    std::string line;
+    std::getline(infile, line);
+    while (std::getline(infile, line)) {
+      size_t p1 = line.find('\t');
+      size_t p2 = line.find('\t', p1 + 1);
+      if (p1 == std::string::npos || p2 == std::string::npos) {
+        return std::nullopt;
+      }
+      Records& records = index.entries_[Key(line.substr(0, p1), line.substr(p1 + 1, p2 - p1 - 1))];
+      std::istringstream is(line.substr(p2 + 1));
+      int64_t offset;
+      double cost;
+      char colon, comma;
+      while (is >> offset >> colon >> cost) {
+        records.emplace_back(cost, offset);
+        is >> comma;
+      }
+    }
+    return index;
+  }
+
+  /*! \brief The number of best records kept per workload and target */
+  int best_k_;
+  /*! \brief The size of the log file indexed */
+  int64_t log_size_ = 0;
+  /*! \brief The best records of each workload and target */
+  std::map<Key, Records> entries_;
+};
+
+std::string RecordIndexFileName(const std::string& filename) { return filename + ".index"; }
+
+void AppendMeasureRecords(const std::string& filename, const Array<MeasureInput>& inputs,
+                          const Array<MeasureResult>& results, int index_best_k) {
+  if (index_best_k <= 0) {
+    std::ofstream ofs(filename, std::ofstream::app);
+    WriteMeasureRecords(&ofs, inputs, results);
+    return;
+  }
+  // Index the file up to its end, so the offsets of the records appended are known
+  RecordIndex index = RecordIndex::Open(filename, index_best_k).value();
+  int64_t offset = index.log_size();
+  std::ofstream ofs(filename, std::ofstream::app | std::ofstream::binary);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    std::ostringstream os;
+    WriteMeasureRecords(&os, {inputs[i]}, {results[i]});
+    std::string record = os.str();
+    ofs << record;
+    index.Add(inputs[i].get(), results[i].get(), offset);
+    offset += record.size();
+  }
+  ofs.close();
+  index.set_log_size(offset);
+  index.Save(RecordIndexFileName(filename));
+}
+
+void BuildRecordIndex(const std::string& filename, int best_k) {
+  CHECK_GT(best_k, 0) << "ValueError: `best_k` must be positive";
+  RecordIndex index(best_k);
+  index.Scan(filename);
+  index.Save(RecordIndexFileName(filename));
+}
+
+void CompactRecordFile(const std::string& in_filename, const std::string& out_filename, int best_k,
+                       bool build_index) {
+  CHECK_GT(best_k, 0) << "ValueError: `best_k` must be positive";
+  CHECK_NE(in_filename, out_filename) << "ValueError: Cannot compact a log file in place";
+  RecordIndex index(best_k);
+  index.Scan(in_filename);
+  std::ifstream infile(in_filename, std::ifstream::in | std::ifstream::binary);
+  std::ofstream ofs(out_filename, std::ofstream::out | std::ofstream::trunc);
+  std::string line;
+  for (int64_t offset : index.Offsets(NullOpt)) {
+    infile.seekg(offset);
+    std::getline(infile, line);
+    ofs << line << '\n';
+  }
+  ofs.close();
+  if (build_index) {
+    BuildRecordIndex(out_filename, best_k);
+  }
+}
+
+/********** Record to file and record reader **********/
+
 void RecordToFileNode::Callback(const SearchPolicy& policy, const Array<MeasureInput>& inputs,
                                 const Array<MeasureResult>& results) {
-  std::ofstream ofs(filename, std::ofstream::app);
-  WriteMeasureRecords(&ofs, inputs, results);
+  AppendMeasureRecords(filename, inputs, results, index_best_k);
 }
 
 RecordReader::RecordReader(String filename) {
@@ -403,9 +623,34 @@ std::pair<Array<MeasureInput>, Array<MeasureResult>> RecordReaderNode::ReadLines
   return std::make_pair(inputs, results);
 }
 
-TVM_REGISTER_GLOBAL("auto_scheduler.RecordToFile").set_body_typed([](const String& filename) {
-  return RecordToFile(filename);
-});
+std::pair<Array<MeasureInput>, Array<MeasureResult>> RecordReaderNode::ReadIndexed(
+    const Optional<String>& workload_key) {
+  std::optional<RecordIndex> index = RecordIndex::Open(filename, /*best_k=*/-1);
+  if (!index.has_value()) {
+    infile.clear();
+    infile.seekg(0);
+    return ReadLines();
+  }
+  std::ifstream log_file(filename, std::ifstream::in | std::ifstream::binary);
+  Array<MeasureInput> inputs;
+  Array<MeasureResult> results;
+  std::string log_version;
+  for (int64_t offset : index->Offsets(workload_key)) {
+    auto inp = make_object<MeasureInputNode>();
+    auto res = make_object<MeasureResultNode>();
+    log_file.seekg(offset);
+    std::getline(log_file, cur_line_);
+    ReadMeasureRecord(cur_line_, inp.get(), res.get(), &log_version);
+    inputs.push_back(MeasureInput(inp));
+    results.push_back(MeasureResult(res));
+  }
+  return std::make_pair(inputs, results);
+}
+
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordToFile")
+    .set_body_typed([](const String& filename, int index_best_k) {
+      return RecordToFile(filename, index_best_k);
+    });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.RecordReader").set_body_typed([](const String& filename) {
   return RecordReader(filename);
@@ -417,6 +662,12 @@ TVM_REGISTER_GLOBAL("auto_scheduler.RecordReaderReadLines")
       return Array<ObjectRef>{res.first, res.second};
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.RecordReaderReadIndexed")
+    .set_body_typed([](RecordReader reader, Optional<String> workload_key) {
+      const auto& res = reader->ReadIndexed(workload_key);
+      return Array<ObjectRef>{res.first, res.second};
+    });
+
 TVM_REGISTER_GLOBAL("auto_scheduler.RecordReaderReadNext").set_body_typed([](RecordReader reader) {
   auto inp = make_object<MeasureInputNode>();
   auto res = make_object<MeasureResultNode>();
@@ -445,11 +696,15 @@ TVM_REGISTER_GLOBAL("auto_scheduler.WriteMeasureRecords")
     });
 
 TVM_REGISTER_GLOBAL("auto_scheduler.SaveRecords")
-    .set_body_typed([](String filename, Array<MeasureInput> in, Array<MeasureResult> res) {
-      std::ofstream ofs(filename, std::ofstream::app);
-      WriteMeasureRecords(&ofs, in, res);
+    .set_body_typed([](String filename, Array<MeasureInput> in, Array<MeasureResult> res,
+                       int index_best_k) {
+      AppendMeasureRecords(filename, in, res, index_best_k);
     });
 
+TVM_REGISTER_GLOBAL("auto_scheduler.BuildRecordIndex").set_body_typed(BuildRecordIndex);
+
+TVM_REGISTER_GLOBAL("auto_scheduler.CompactRecordFile").set_body_typed(CompactRecordFile);
+
 TVM_REGISTER_GLOBAL("auto_scheduler.SerializeMeasureInput")
     .set_body_typed([](const MeasureInput& input) {
       std::ostringstream os;
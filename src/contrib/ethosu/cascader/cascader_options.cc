@@ -38,6 +38,7 @@ void CascaderOptionsNode::VisitAttrs(AttrVisitor* v) {
   v->Visit("enable_multi_dimensional_striping", &enable_multi_dimensional_striping);
   v->Visit("disable_block_culling", &disable_block_culling);
   v->Visit("enable_striping", &enable_striping);
+  v->Visit("plan_time_budget", &plan_time_budget);
 }
 
 CascaderOptions::CascaderOptions(const MemoryRegion& cascade_region, int max_proposals,
@@ -45,7 +46,7 @@ CascaderOptions::CascaderOptions(const MemoryRegion& cascade_region, int max_pro
                                  int max_closed_plans, int always_copy_size,
                                  bool disable_pareto_plans, bool disable_pareto_proposals,
                                  bool enable_multi_dimensional_striping, bool disable_block_culling,
-                                 bool enable_striping) {
+                                 bool enable_striping, double plan_time_budget) {
   auto n = make_object<CascaderOptionsNode>();
   n->cascade_region = std::move(cascade_region);
   n->max_proposals = max_proposals;
@@ -59,6 +60,7 @@ CascaderOptions::CascaderOptions(const MemoryRegion& cascade_region, int max_pro
   n->enable_multi_dimensional_striping = enable_multi_dimensional_striping;
   n->disable_block_culling = disable_block_culling;
   n->enable_striping = enable_striping;
+  n->plan_time_budget = plan_time_budget;
   data_ = std::move(n);
 }
 
@@ -67,11 +69,12 @@ TVM_REGISTER_GLOBAL("contrib.ethosu.cascader.CascaderOptions")
                        int max_plan_size, int max_open_plans, int max_closed_plans,
                        int always_copy_size, bool disable_pareto_plans,
                        bool disable_pareto_proposals, bool enable_multi_dimensional_striping,
-                       bool disable_block_culling, bool enable_striping) {
-      return CascaderOptions(
-          cascade_region, max_proposals, stripe_factors, max_plan_size, max_open_plans,
-          max_closed_plans, always_copy_size, disable_pareto_plans, disable_pareto_proposals,
-          enable_multi_dimensional_striping, disable_block_culling, enable_striping);
+                       bool disable_block_culling, bool enable_striping, double plan_time_budget) {
+      return CascaderOptions(cascade_region, max_proposals, stripe_factors, max_plan_size,
+                             max_open_plans, max_closed_plans, always_copy_size,
+                             disable_pareto_plans, disable_pareto_proposals,
+                             enable_multi_dimensional_striping, disable_block_culling,
+                             enable_striping, plan_time_budget);
     });
 
 TVM_REGISTER_NODE_TYPE(CascaderOptionsNode);
@@ -63,6 +63,11 @@ class CascaderOptionsNode : public Object {
   bool disable_block_culling;
   /*! \brief A boolean option to enable striping. */
   bool enable_striping;
+  /*!
+   * \brief The time in seconds after which the Plan search stops growing cascades and plans the
+   * remaining Parts on their own, or 0 for no limit.
+   */
+  double plan_time_budget;
 
   static constexpr const char* _type_key = "contrib.ethosu.cascader.CascaderOptions";
   TVM_DECLARE_FINAL_OBJECT_INFO(CascaderOptionsNode, Object)
@@ -75,7 +80,7 @@ class CascaderOptions : public ObjectRef {
                   int max_plan_size, int max_open_plans, int max_closed_plans, int always_copy_size,
                   bool disable_pareto_plans, bool disable_pareto_proposals,
                   bool enable_multi_dimensional_striping, bool disable_block_culling,
-                  bool multi_dimensional_striping);
+                  bool multi_dimensional_striping, double plan_time_budget = 0);
 
   TVM_DEFINE_OBJECT_REF_METHODS(CascaderOptions, ObjectRef, CascaderOptionsNode);
 };
@@ -92,6 +92,13 @@ float EthosuPartNode::CalculateCost(const BlockConfig& block_config,
 }
 
 const BlockConfig EthosuPartNode::GetBlockConfig(const StripeConfig& output_stripe_config) {
+  {
+    std::lock_guard<std::mutex> lock(block_config_mutex_);
+    auto it = block_config_cache_.find(output_stripe_config);
+    if (it != block_config_cache_.end()) {
+      return it->second;
+    }
+  }
   BlockConfig best_block_config = valid_block_configs_[0];
   float best_cost = CalculateCost(best_block_config, output_stripe_config);
   std::vector<int> output_stripe_shape = output_stripe_config->GetShape();
@@ -105,6 +112,8 @@ const BlockConfig EthosuPartNode::GetBlockConfig(const StripeConfig& output_stri
       best_cost = relative_cost;
     }
   }
+  std::lock_guard<std::mutex> lock(block_config_mutex_);
+  block_config_cache_.emplace(output_stripe_config, best_block_config);
   return best_block_config;
 }
 
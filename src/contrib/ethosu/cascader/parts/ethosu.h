@@ -26,10 +26,13 @@
 
 #include <tvm/runtime/object.h>
 
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "../block_config.h"
 #include "../graph.h"
+#include "../stripe_config.h"
 
 namespace tvm {
 namespace contrib {
@@ -42,6 +45,7 @@ class EthosuPartNode : public PartNode {
   /*!
    * \brief Get the optimal BlockConfig to use given a StripeConfig
    * \param output_stripe_config The output StripeConfig.
+   * \note The choice is memoized per StripeConfig, and may be queried from several threads.
    */
   const BlockConfig GetBlockConfig(const StripeConfig& output_stripe_config);
   /*!
@@ -95,6 +99,10 @@ class EthosuPartNode : public PartNode {
   int weight_tensor_idx_;
   /*! \brief Number of sub-kernels the kernel has been split into */
   int subkernels_;
+  /*! \brief The BlockConfigs chosen for the output StripeConfigs queried so far */
+  std::unordered_map<StripeConfig, BlockConfig> block_config_cache_;
+  /*! \brief The mutex guarding block_config_cache_ */
+  std::mutex block_config_mutex_;
 };
 
 /*!
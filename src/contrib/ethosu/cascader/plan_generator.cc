@@ -25,6 +25,7 @@
 #include <tvm/support/parallel_for.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <map>
 #include <set>
@@ -337,114 +338,127 @@ std::pair<int, int> GetCopyCyclesHint(const TensorConfig& tensor_config) {
   return {mem2mem_cycles, initial_mem2mem_cycles};
 }
 
+// Generate the single-Part Plans of a Part for one output StripeConfig
 std::vector<Plan> GenerateSinglePlans(
-    const Part& part, const std::vector<StripeConfig>& output_stripe_configs,
+    const Part& part, const StripeConfig& output_stripe_config,
     const std::unordered_map<Tensor, std::vector<MemoryRegion>, ObjectPtrHash, ObjectPtrEqual>&
         home_map,
     const CascaderOptions& options) {
   std::vector<Plan> plans;
   std::vector<Part> part_group{part};
-  // Create a selection of Plans per output_stripe_config
-  for (const auto& output_stripe_config : output_stripe_configs) {
-    // Calculate the input_stripe_configs
-    auto input_stripe_configs = part->CalculateInputStripeConfigs(output_stripe_config);
-    // From the input_stripe_configs, now derive all the possible input TensorConfigs
-    std::vector<std::vector<TensorConfig>> all_possible_input_configs;
-    size_t i = 0;
-    for (const auto& stripe_config : input_stripe_configs) {
-      Tensor tensor = part->GetInputTensors()[i];
-      all_possible_input_configs.push_back(
-          GetPossibleInputConfigs(stripe_config, tensor, home_map.at(tensor), options));
-      i++;
+  // Calculate the input_stripe_configs
+  auto input_stripe_configs = part->CalculateInputStripeConfigs(output_stripe_config);
+  // From the input_stripe_configs, now derive all the possible input TensorConfigs
+  std::vector<std::vector<TensorConfig>> all_possible_input_configs;
+  size_t i = 0;
+  for (const auto& stripe_config : input_stripe_configs) {
+    Tensor tensor = part->GetInputTensors()[i];
+    all_possible_input_configs.push_back(
+        GetPossibleInputConfigs(stripe_config, tensor, home_map.at(tensor), options));
+    i++;
+  }
+  // Now work out all the possible combinations of input TensorConfigs
+  auto input_config_combinations = EnumerateCombinations<TensorConfig>(all_possible_input_configs);
+  Tensor output_tensor = part->GetOutputTensor();
+  // Then determine the possible output TensorConfigs (no combinations here because there's only
+  // one output)
+  auto output_configs = GetPossibleOutputConfigs(output_stripe_config, output_tensor,
+                                                 home_map.at(output_tensor), options);
+  // Calculate the performance information for the output_stripe_config for both the recompute and
+  // rolling cases
+  PerformanceInfo rolling_perf =
+      part->GetPerformanceInfo(output_stripe_config, BufferMode::ROLLING);
+  PerformanceInfo recompute_perf =
+      part->GetPerformanceInfo(output_stripe_config, BufferMode::RECOMPUTE);
+  // For all the possible input TensorConfig combinations
+  for (const auto& input_configs : input_config_combinations) {
+    std::vector<TensorConfig> tensor_configs;
+    std::vector<TensorConfig> open_input_configs;
+    // Add the input TensorConfigs to the 'tensor_configs' and
+    // record which input TensorConfigs are 'open' (i.e. 'INTERIOR')
+    for (const auto& input_config : input_configs) {
+      tensor_configs.push_back(input_config);
+      if (input_config->GetState() == TensorConfigState::INTERIOR) {
+        open_input_configs.push_back(input_config);
+      }
     }
-    // Now work out all the possible combinations of input TensorConfigs
-    auto input_config_combinations =
-        EnumerateCombinations<TensorConfig>(all_possible_input_configs);
-    Tensor output_tensor = part->GetOutputTensor();
-    // Then determine the possible output TensorConfigs (no combinations here because there's only
-    // one output)
-    auto output_configs = GetPossibleOutputConfigs(output_stripe_config, output_tensor,
-                                                   home_map.at(output_tensor), options);
-    // Calculate the performance information for the output_stripe_config for both the recompute and
-    // rolling cases
-    PerformanceInfo rolling_perf =
-        part->GetPerformanceInfo(output_stripe_config, BufferMode::ROLLING);
-    PerformanceInfo recompute_perf =
-        part->GetPerformanceInfo(output_stripe_config, BufferMode::RECOMPUTE);
-    // For all the possible input TensorConfig combinations
-    for (const auto& input_configs : input_config_combinations) {
-      std::vector<TensorConfig> tensor_configs;
-      std::vector<TensorConfig> open_input_configs;
-      // Add the input TensorConfigs to the 'tensor_configs' and
-      // record which input TensorConfigs are 'open' (i.e. 'INTERIOR')
-      for (const auto& input_config : input_configs) {
-        tensor_configs.push_back(input_config);
-        if (input_config->GetState() == TensorConfigState::INTERIOR) {
-          open_input_configs.push_back(input_config);
-        }
+    for (const auto& output_config : output_configs) {
+      // Add the output TensorConfig to the tensor_configs and to
+      // the open configs (if it's 'INTERIOR')
+      tensor_configs.push_back(output_config);
+      std::vector<TensorConfig> open_configs = open_input_configs;
+      if (output_config->GetState() == TensorConfigState::INTERIOR) {
+        open_configs.push_back(output_config);
       }
-      for (const auto& output_config : output_configs) {
-        // Add the output TensorConfig to the tensor_configs and to
-        // the open configs (if it's 'INTERIOR')
-        tensor_configs.push_back(output_config);
-        std::vector<TensorConfig> open_configs = open_input_configs;
-        if (output_config->GetState() == TensorConfigState::INTERIOR) {
-          open_configs.push_back(output_config);
-        }
-        int bandwidth_cycles = 0;
-        int compute_cycles = 0;
-        int mem2mem_cycles = 0;
-        int initial_mem2mem_cycles = 0;
+      int bandwidth_cycles = 0;
+      int compute_cycles = 0;
+      int mem2mem_cycles = 0;
+      int initial_mem2mem_cycles = 0;
 
-        // Pick the correct performance info based on the BufferMode
-        PerformanceInfo perf_info;
-        if (output_config->GetBufferMode() == BufferMode::RECOMPUTE) {
-          perf_info = recompute_perf;
-        } else {
-          perf_info = rolling_perf;
-        }
-        // Calculate the bandwidth cycles by multiplying the bytes read/written by the
-        // bandwidth of the memories
-        BlockConfig block_config = perf_info->block_config;
-        for (size_t i = 0; i < input_configs.size(); i++) {
-          Tensor tensor = input_configs[i]->GetTensor();
-          MemoryRegion copy_region = input_configs[i]->GetCopyRegion();
+      // Pick the correct performance info based on the BufferMode
+      PerformanceInfo perf_info;
+      if (output_config->GetBufferMode() == BufferMode::RECOMPUTE) {
+        perf_info = recompute_perf;
+      } else {
+        perf_info = rolling_perf;
+      }
+      // Calculate the bandwidth cycles by multiplying the bytes read/written by the
+      // bandwidth of the memories
+      BlockConfig block_config = perf_info->block_config;
+      for (size_t i = 0; i < input_configs.size(); i++) {
+        Tensor tensor = input_configs[i]->GetTensor();
+        MemoryRegion copy_region = input_configs[i]->GetCopyRegion();
 
-          if (input_configs[i]->DoCopy()) {
-            std::pair<int, int> ret = GetCopyCyclesHint(input_configs[i]);
-            mem2mem_cycles += ret.first;
-            initial_mem2mem_cycles += ret.second;
-          }
-          float read_efficiency =
-              GetTransferEfficiency(tensor, block_config->GetInputBlockShape(), copy_region);
-          bandwidth_cycles +=
-              (perf_info->read_bytes[i] / copy_region->read_bandwidth) * read_efficiency;
+        if (input_configs[i]->DoCopy()) {
+          std::pair<int, int> ret = GetCopyCyclesHint(input_configs[i]);
+          mem2mem_cycles += ret.first;
+          initial_mem2mem_cycles += ret.second;
         }
-        MemoryRegion write_region = output_config->GetCopyRegion();
-        float write_efficiency = GetTransferEfficiency(
-            output_config->GetTensor(), block_config->GetOutputBlockShape(), write_region);
-
+        float read_efficiency =
+            GetTransferEfficiency(tensor, block_config->GetInputBlockShape(), copy_region);
         bandwidth_cycles +=
-            perf_info->write_bytes / write_region->write_bandwidth * write_efficiency;
-        compute_cycles = perf_info->compute_cycles;
-        // Take the max of compute and bandwidth cycles as we assume compute cycles
-        // can hide memory latency
-        int cycles = std::max(std::max(compute_cycles, bandwidth_cycles), mem2mem_cycles);
-        if (cycles > mem2mem_cycles) {
-          // NPU cycles are the bottleneck - add initial mem2mem transfer cycles
-          cycles += initial_mem2mem_cycles;
-        }
+            (perf_info->read_bytes[i] / copy_region->read_bandwidth) * read_efficiency;
+      }
+      MemoryRegion write_region = output_config->GetCopyRegion();
+      float write_efficiency = GetTransferEfficiency(
+          output_config->GetTensor(), block_config->GetOutputBlockShape(), write_region);
 
-        int memory_usage =
-            GetInteriorMemoryUsage(input_configs, output_config, options->cascade_region);
-        plans.push_back(Plan(tensor_configs, open_configs, output_config, part_group,
-                             options->cascade_region, memory_usage, cycles));
+      bandwidth_cycles += perf_info->write_bytes / write_region->write_bandwidth * write_efficiency;
+      compute_cycles = perf_info->compute_cycles;
+      // Take the max of compute and bandwidth cycles as we assume compute cycles
+      // can hide memory latency
+      int cycles = std::max(std::max(compute_cycles, bandwidth_cycles), mem2mem_cycles);
+      if (cycles > mem2mem_cycles) {
+        // NPU cycles are the bottleneck - add initial mem2mem transfer cycles
+        cycles += initial_mem2mem_cycles;
       }
+
+      int memory_usage =
+          GetInteriorMemoryUsage(input_configs, output_config, options->cascade_region);
+      plans.push_back(Plan(tensor_configs, open_configs, output_config, part_group,
+                           options->cascade_region, memory_usage, cycles));
     }
   }
   return plans;
 }
 
+std::vector<Plan> GenerateSinglePlans(
+    const Part& part, const std::vector<StripeConfig>& output_stripe_configs,
+    const std::unordered_map<Tensor, std::vector<MemoryRegion>, ObjectPtrHash, ObjectPtrEqual>&
+        home_map,
+    const CascaderOptions& options) {
+  // The output StripeConfigs are independent, evaluate them in parallel and keep their order
+  std::vector<std::vector<Plan>> plans_by_config(output_stripe_configs.size());
+  support::parallel_for(0, output_stripe_configs.size(), [&](int i) {
+    plans_by_config[i] = GenerateSinglePlans(part, output_stripe_configs[i], home_map, options);
+  });
+  std::vector<Plan> plans;
+  for (const auto& config_plans : plans_by_config) {
+    plans.insert(plans.end(), config_plans.begin(), config_plans.end());
+  }
+  return plans;
+}
+
 std::unordered_map<std::vector<Part>, std::vector<Plan>> GenerateGraphPlans(
     const CascaderGraph& graph,
     const std::unordered_map<Tensor, std::vector<MemoryRegion>, ObjectPtrHash, ObjectPtrEqual>&
@@ -470,28 +484,58 @@ std::unordered_map<std::vector<Part>, std::vector<Plan>> GenerateGraphPlans(
   std::unordered_map<std::vector<Part>,
                      std::unordered_map<std::vector<TensorConfig>, std::vector<Plan>>>
       open_plans;
-  // Traverse the graph in a reverse topological order (should be enforced by GetPartOrder)
-  for (const auto& part : graph->GetPartOrder()) {
-    // First generate all the possible StripeConfigs for the Part assuming that it will become the
-    // output of a Plan. The number generated is a function of stripe_factors and the number of
-    // cascadable dimensions in the Part.
+  const std::vector<Part>& part_order = graph->GetPartOrder();
+  // First generate all the possible StripeConfigs for each Part assuming that it will become the
+  // output of a Plan, and their single Part Plans. The number generated is a function of
+  // stripe_factors and the number of cascadable dimensions in the Part. These don't depend on the
+  // other Parts, so they're generated for all the Parts in parallel.
+  std::vector<std::vector<Plan>> own_plans(part_order.size());
+  support::parallel_for(0, part_order.size(), [&](int i) {
     std::vector<StripeConfig> stripe_configs =
-        GenerateOutputStripeConfigs(part, options->stripe_factors, options->enable_striping,
+        GenerateOutputStripeConfigs(part_order[i], options->stripe_factors,
+                                    options->enable_striping,
                                     options->enable_multi_dimensional_striping);
+    own_plans[i] = GenerateSinglePlans(part_order[i], stripe_configs, home_map, options);
+  });
+  // Past the time budget, stop growing cascades and keep the Plans found so far
+  auto start = std::chrono::steady_clock::now();
+  bool out_of_time = false;
+  // Traverse the graph in a reverse topological order (should be enforced by GetPartOrder)
+  for (size_t part_idx = 0; part_idx < part_order.size(); ++part_idx) {
+    const Part& part = part_order[part_idx];
+    if (!out_of_time && options->plan_time_budget > 0) {
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      if (elapsed.count() > options->plan_time_budget) {
+        out_of_time = true;
+        LOG(WARNING) << "The cascader Plan search exceeded its time budget of "
+                     << options->plan_time_budget << "s, the remaining "
+                     << part_order.size() - part_idx << " Parts are not cascaded";
+      }
+    }
+    std::vector<Plan> single_part_plans = std::move(own_plans[part_idx]);
     // Check to see if the output Tensor is part of any existing open Plans
-    if (stripe_configs_by_tensor.find(part->GetOutputTensor()) != stripe_configs_by_tensor.end()) {
+    if (!out_of_time &&
+        stripe_configs_by_tensor.find(part->GetOutputTensor()) != stripe_configs_by_tensor.end()) {
       // If there are other open Plans which have this Part's output Tensor as an input, then
       // additionally consider the StripeConfigs of those open TensorConfigs so that we have the
       // option to merge into those open Plans.
       const std::set<StripeConfig>& connecting_configs =
           stripe_configs_by_tensor.at(part->GetOutputTensor());
-      std::copy(connecting_configs.begin(), connecting_configs.end(),
-                std::back_inserter(stripe_configs));
+      auto connecting_plans = GenerateSinglePlans(
+          part, std::vector<StripeConfig>(connecting_configs.begin(), connecting_configs.end()),
+          home_map, options);
+      single_part_plans.insert(single_part_plans.end(), connecting_plans.begin(),
+                               connecting_plans.end());
     }
-    // Generate all the single Part Plans for the previously determined StripeConfigs
-    auto single_part_plans = GenerateSinglePlans(part, stripe_configs, home_map, options);
     std::vector<Plan> plans;
     for (const auto& partial_plan : single_part_plans) {
+      if (out_of_time) {
+        // Only the Plans standing on their own are kept, nothing will close the open ones
+        if (partial_plan->IsClosed()) {
+          plans.push_back(partial_plan);
+        }
+        continue;
+      }
       // If the output TensorConfig of the Plan is 'INTERIOR', then it must be merged with
       // another open Plan
       if (partial_plan->GetOutputConfig()->GetState() == TensorConfigState::INTERIOR) {
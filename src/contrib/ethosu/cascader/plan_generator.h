@@ -99,6 +99,10 @@ std::vector<Plan> GenerateSinglePlans(const Part& part,
  *
  * Once every Part has been visited, return the Plans with no open TensorConfigs indexed by Part
  * group.
+ *
+ * The single Part Plans of step 1 are generated for all the Parts in parallel up front. Once
+ * the plan_time_budget of the options is exceeded, steps 2 and 4 are skipped and only the closed
+ * Plans of the remaining Parts are kept.
  */
 std::unordered_map<std::vector<Part>, std::vector<Plan>> GenerateGraphPlans(
     const CascaderGraph& graph, const HomeMap& home_map, const CascaderOptions& options);
@@ -24,18 +24,23 @@
 #include <dmlc/thread_local.h>
 #include <tvm/driver/driver_api.h>
 #include <tvm/ir/transform.h>
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/executor.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/target/codegen.h>
 #include <tvm/te/operation.h>
 #include <tvm/tir/analysis.h>
+#include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
 #include <mutex>
 #include <stack>
 
+#include "internal_driver_api.h"
+
 namespace tvm {
 
 // Register build pipeline related options
@@ -55,6 +60,8 @@ TVM_REGISTER_PASS_CONFIG_OPTION("tir.use_async_copy", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.instrument_lwp", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.vtcm_capacity", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.ptx_ldg32", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.specialize_divisible_shapes", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.experimental_persistent_kernel", Bool);
 
 // WARNING: May cause coherency issues resulting data miscompares
 // Experimental feature that, when enabled by the runtime, bypasses the cache when using DMA. When
@@ -153,6 +160,8 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
       pass_ctx->GetConfig<Bool>("tir.enable_equiv_terms_in_cse_tir", Bool(false)).value();
 
   bool ptx_ldg32 = pass_ctx->GetConfig<Bool>("tir.ptx_ldg32", Bool(false)).value();
+  bool specialize_divisible_shapes =
+      pass_ctx->GetConfig<Bool>("tir.specialize_divisible_shapes", Bool(false)).value();
 
   // Get any user-added passes
   Array<Array<ObjectRef>> add_lower_pass =
@@ -223,6 +232,9 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
   pass_list.insert(pass_list.end(), user_lower_phase1.begin(), user_lower_phase1.end());
 
   // PHASE 2
+  if (specialize_divisible_shapes) {
+    pass_list.push_back(tir::transform::SpecializeDivisibleShapes());
+  }
   if (!disable_loop_partition) {
     pass_list.push_back(tir::transform::LoopPartition());
   }
@@ -265,7 +277,7 @@ Array<tvm::transform::Pass> CreatePassList(bool disable_loop_partition) {
       tir::transform::CommonSubexprElimTIR(!disable_cse_tir, enable_equiv_terms_in_cse_tir));
 
   // This pass instruments the loops with the profile builtin calls to capture the runtime
-  // performance data (only enabled for Hexagon at the moment). To ensure that no other
+  // performance data (lowered for Hexagon and for the LLVM CPU targets). To ensure that no other
   // optimizations are performed on the instrumented code, this pass must be added at the end
   // of the list.
   if (instrument_lwp) {
@@ -430,8 +442,146 @@ std::pair<IRModule, IRModule> SplitMixedModule(IRModule mod_mixed, const Target&
   return {host_mod, device_mod};
 }
 
-runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
-                             const Target& target_host_arg) {
+TVM_REGISTER_NODE_TYPE(BuildCacheNode);
+
+BuildCache::BuildCache() { data_ = make_object<BuildCacheNode>(); }
+
+Optional<ObjectRef> BuildCacheNode::Lookup(const Array<ObjectRef>& key, size_t hash,
+                                           const Array<runtime::Module>& deps) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = entries_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Entry& entry = it->second;
+    bool same_deps = entry.deps.size() == deps.size();
+    for (size_t i = 0; same_deps && i < deps.size(); ++i) {
+      same_deps = entry.deps[i].same_as(deps[i]);
+    }
+    if (!same_deps) continue;
+    if (StructuralEqual()(entry.key, key)) {
+      ++num_hits;
+      return entry.value;
+    }
+  }
+  return NullOpt;
+}
+
+void BuildCacheNode::Insert(const Array<ObjectRef>& key, size_t hash, ObjectRef value,
+                            const Array<runtime::Module>& deps) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_misses;
+  entries_.emplace(hash, Entry{key, deps, value});
+}
+
+TVM_REGISTER_GLOBAL("driver.BuildCache").set_body_typed([]() { return BuildCache(); });
+
+namespace {
+
+/*!
+ * \brief The key of a cached build step, with the target, host target and pass configuration.
+ * \param hash The structural hash of the key.
+ * \return The key, or NullOpt if it cannot be hashed.
+ */
+Optional<Array<ObjectRef>> BuildCacheKey(const char* step, ObjectRef input, const Target& target,
+                                         const Target& target_host, size_t* hash) {
+  Array<ObjectRef> key = {String(step), input, String(target->str()),
+                          String(target_host.defined() ? target_host->str() : ""),
+                          transform::PassContext::Current()->config};
+  try {
+    *hash = StructuralHash()(key);
+  } catch (const std::exception&) {
+    // e.g. a pass configuration holding custom passes
+    return NullOpt;
+  }
+  return key;
+}
+
+/*! \brief Whether the PrimFuncs of a module can be lowered one by one, i.e. none calls another. */
+bool CanSplitPerFunction(const IRModule& mod) {
+  if (mod->functions.size() <= 1) return false;
+  for (const auto& kv : mod->functions) {
+    const auto* func = kv.second.as<tir::PrimFuncNode>();
+    if (func == nullptr) return false;
+    bool calls_global = false;
+    tir::PostOrderVisit(func->body, [&calls_global](const ObjectRef& node) {
+      if (const auto* call = node.as<tir::CallNode>()) {
+        calls_global |= call->op->IsInstance<GlobalVarNode>();
+      }
+    });
+    if (calls_global) return false;
+  }
+  return true;
+}
+
+/*! \brief SplitMixedModule, reusing the lowered modules of a previous build. */
+std::pair<IRModule, IRModule> SplitMixedModuleCached(IRModule mod, const Target& target,
+                                                     const Target& target_host, BuildCache cache) {
+  auto split = [&](IRModule input) -> std::pair<IRModule, IRModule> {
+    size_t hash;
+    Optional<Array<ObjectRef>> key = BuildCacheKey("split", input, target, target_host, &hash);
+    if (key) {
+      if (auto cached = cache->Lookup(key.value(), hash)) {
+        auto pair = Downcast<Array<IRModule>>(cached.value());
+        return {pair[0], pair[1]};
+      }
+    }
+    auto pair = SplitMixedModule(input, target, target_host);
+    if (key) cache->Insert(key.value(), hash, Array<IRModule>{pair.first, pair.second});
+    return pair;
+  };
+  if (!CanSplitPerFunction(mod)) {
+    return split(mod);
+  }
+  // Annotate the entry function of the whole module, as the modules of one function each would
+  // all have their function annotated as the entry.
+  IRModule annotated = tir::transform::AnnotateEntryFunc()(mod);
+  IRModule host_mod(Map<GlobalVar, BaseFunc>(), {}, {}, {}, mod->attrs);
+  IRModule device_mod(Map<GlobalVar, BaseFunc>(), {}, {}, {}, mod->attrs);
+  for (const auto& kv : annotated->functions) {
+    IRModule single(Map<GlobalVar, BaseFunc>({{kv.first, kv.second}}), {}, {}, {}, mod->attrs);
+    auto pair = split(single);
+    IRModule host_part = pair.first;
+    if (!kv.second->HasNonzeroAttr(tir::attr::kIsEntryFunc) &&
+        host_part->ContainGlobalVar(kv.first->name_hint)) {
+      GlobalVar gvar = host_part->GetGlobalVar(kv.first->name_hint);
+      if (auto func = host_part->Lookup(gvar).as<tir::PrimFunc>()) {
+        host_part = host_part->ShallowCopy();
+        host_part->Update(gvar, WithoutAttr(func.value(), tir::attr::kIsEntryFunc));
+      }
+    }
+    host_mod->Update(host_part);
+    device_mod->Update(pair.second);
+  }
+  return {host_mod, device_mod};
+}
+
+/*!
+ * \brief codegen::Build, reusing the module generated by a previous build.
+ * \param deps The modules to import into the generated module.
+ */
+runtime::Module BuildCached(IRModule mod, const Target& target, Optional<BuildCache> cache,
+                            const Array<runtime::Module>& deps = {}) {
+  size_t hash;
+  Optional<Array<ObjectRef>> key;
+  if (cache) {
+    key = BuildCacheKey("codegen", mod, target, Target(), &hash);
+    if (key) {
+      if (auto cached = cache.value()->Lookup(key.value(), hash, deps)) {
+        return Downcast<runtime::Module>(cached.value());
+      }
+    }
+  }
+  runtime::Module built = codegen::Build(mod, target);
+  for (const auto& dep : deps) {
+    built.Import(dep);
+  }
+  if (key) cache.value()->Insert(key.value(), hash, built, deps);
+  return built;
+}
+
+}  // namespace
+
+runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg, const Target& target_host_arg,
+                             Optional<BuildCache> cache) {
   std::vector<runtime::Module> device_modules;
   Map<Target, IRModule> inputs = inputs_arg;
   Target target_host = target_host_arg;
@@ -467,7 +617,8 @@ runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
     if (it.second.defined()) {
       const Target& target = it.first;
       const IRModule& ir_module = it.second;
-      auto pair = SplitMixedModule(ir_module, target, target_host);
+      auto pair = cache ? SplitMixedModuleCached(ir_module, target, target_host, cache.value())
+                        : SplitMixedModule(ir_module, target, target_host);
       auto& host_mod = pair.first;
       auto& device_mod = pair.second;
 
@@ -483,30 +634,31 @@ runtime::Module TIRToRuntime(const Map<Target, IRModule>& inputs_arg,
           target->GetTargetDeviceType() == target_host->GetTargetDeviceType();
       bool non_host_target_kind = target->kind != target_host->kind;
       if (overrides_host_target && non_host_target_kind) {
-        device_modules.push_back(codegen::Build(host_mod, it.first));
+        device_modules.push_back(BuildCached(host_mod, it.first, cache));
       } else {
         mhost_all->Update(host_mod);
       }
 
       if (device_mod->functions.size() != 0) {
-        device_modules.push_back(codegen::Build(device_mod, it.first));
+        device_modules.push_back(BuildCached(device_mod, it.first, cache));
       }
     }
   }
 
-  runtime::Module mhost = codegen::Build(mhost_all, target_host);
+  Array<runtime::Module> imports;
   for (const auto& it : device_modules) {
     if (it.operator->()) {
-      mhost.Import(it);
+      imports.push_back(it);
     }
   }
-
-  return mhost;
+  // The host module is reused only along with the same device modules, which it imports.
+  return BuildCached(mhost_all, target_host, cache, imports);
 }
 
 TVM_REGISTER_GLOBAL("driver.tir_to_runtime")
-    .set_body_typed([](const Map<Target, IRModule>& inputs_arg, Target host_target) {
-      return TIRToRuntime(inputs_arg, host_target);
+    .set_body_typed([](const Map<Target, IRModule>& inputs_arg, Target host_target,
+                       Optional<BuildCache> cache) {
+      return TIRToRuntime(inputs_arg, host_target, cache);
     });
 
 // Build for heterogeneous execution when targets are specified as
@@ -558,6 +710,12 @@ transform::Sequential MixedModulePassManager(IRModule mixed_mod, Target target)
 
   mixed_pass_list.push_back(tir::transform::AnnotateEntryFunc());
 
+  bool persistent_kernel =
+      pass_ctx->GetConfig<Bool>("tir.experimental_persistent_kernel", Bool(false)).value();
+  if (persistent_kernel) {
+    mixed_pass_list.push_back(tir::transform::MergePersistentKernel());
+  }
+
   bool detect_global_barrier =
       pass_ctx->GetConfig<Bool>("tir.detect_global_barrier", Bool(false)).value();
   if (detect_global_barrier) {
@@ -582,6 +740,8 @@ transform::Sequential MixedModulePassManager(IRModule mixed_mod, Target target)
     mixed_pass_list.push_back(tir::transform::InjectPTXLDG32());
   }
 
+  mixed_pass_list.push_back(tir::transform::InjectSoftwarePrefetch());
+
   mixed_pass_list.push_back(tir::transform::AnnotateDeviceRegions());
   mixed_pass_list.push_back(tir::transform::SplitHostDevice());
 
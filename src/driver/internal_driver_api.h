@@ -27,6 +27,7 @@
 #ifndef TVM_DRIVER_INTERNAL_DRIVER_API_H_
 #define TVM_DRIVER_INTERNAL_DRIVER_API_H_
 
+#include <tvm/driver/driver_api.h>
 #include <tvm/ir/module.h>
 #include <tvm/target/target.h>
 
@@ -39,9 +40,11 @@ namespace tvm {
  * \param input The map contains target to an IRModule.
  * \param target_host The target for building host code. To use the default,
  *        pass Target().
+ * \param cache The cache of previous builds to reuse, if any, see BuildCacheNode.
  * \return The built module that contains code for different processors.
  */
-runtime::Module TIRToRuntime(const Map<Target, IRModule>& input, const Target& target_host);
+runtime::Module TIRToRuntime(const Map<Target, IRModule>& input, const Target& target_host,
+                             Optional<BuildCache> cache = NullOpt);
 
 }  // namespace tvm
 
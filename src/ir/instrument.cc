@@ -24,10 +24,22 @@
 #include <dmlc/thread_local.h>
 #include <tvm/ir/instrument.h>
 #include <tvm/ir/transform.h>
+#include <tvm/node/reflection.h>
 #include <tvm/node/repr_printer.h>
+#include <tvm/runtime/memory.h>
 #include <tvm/runtime/registry.h>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include <mutex>
 #include <stack>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../support/str_escape.h"
 
 namespace tvm {
 namespace instrument {
@@ -334,5 +346,253 @@ TVM_REGISTER_GLOBAL("instrument.MakePassTimingInstrument").set_body_typed([]() {
                             run_before_pass, run_after_pass);
 });
 
+/*! \return The peak resident set size of the process in bytes, or 0 if unknown. */
+int64_t PeakResidentBytes() {
+#ifdef _WIN32
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+  return static_cast<int64_t>(usage.ru_maxrss);
+#else
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/*! \return The number of distinct objects reachable from \p root through their attributes. */
+int64_t CountReachableObjects(const ObjectRef& root) {
+  class ChildCollector : public AttrVisitor {
+   public:
+    explicit ChildCollector(std::vector<const Object*>* stack) : stack_(stack) {}
+    void Visit(const char* key, double* value) final {}
+    void Visit(const char* key, int64_t* value) final {}
+    void Visit(const char* key, uint64_t* value) final {}
+    void Visit(const char* key, int* value) final {}
+    void Visit(const char* key, bool* value) final {}
+    void Visit(const char* key, std::string* value) final {}
+    void Visit(const char* key, void** value) final {}
+    void Visit(const char* key, DataType* value) final {}
+    void Visit(const char* key, runtime::NDArray* value) final {}
+    void Visit(const char* key, ObjectRef* value) final {
+      if (value->defined()) stack_->push_back(value->get());
+    }
+
+   private:
+    std::vector<const Object*>* stack_;
+  };
+
+  std::unordered_set<const Object*> visited;
+  std::vector<const Object*> stack;
+  ChildCollector collector(&stack);
+  if (root.defined()) stack.push_back(root.get());
+  while (!stack.empty()) {
+    const Object* node = stack.back();
+    stack.pop_back();
+    if (!visited.insert(node).second) continue;
+    if (node->IsInstance<runtime::ArrayNode>()) {
+      for (const ObjectRef& elem : *static_cast<const runtime::ArrayNode*>(node)) {
+        if (elem.defined()) stack.push_back(elem.get());
+      }
+    } else if (node->IsInstance<runtime::MapNode>()) {
+      for (const auto& kv : *static_cast<const runtime::MapNode*>(node)) {
+        if (kv.first.defined()) stack.push_back(kv.first.get());
+        if (kv.second.defined()) stack.push_back(kv.second.get());
+      }
+    } else {
+      ReflectionVTable::Global()->VisitAttrs(const_cast<Object*>(node), &collector);
+    }
+  }
+  return static_cast<int64_t>(visited.size());
+}
+
+/*!
+ * \brief An instrument recording the wall time, the growth of the peak resident memory, the
+ * object allocations and the IR size of every pass, nested under the passes running them like
+ * Sequential. It reports them as an indented tree or as a Chrome trace.
+ */
+class PassProfilingInstrumentNode : public PassInstrumentNode {
+ public:
+  /*! \brief Whether to count the IR objects reachable from the module before and after a pass. */
+  bool count_ir_nodes{true};
+
+  void VisitAttrs(AttrVisitor* v) {
+    PassInstrumentNode::VisitAttrs(v);
+    v->Visit("count_ir_nodes", &count_ir_nodes);
+  }
+
+  void EnterPassContext() const final {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+    roots_.clear();
+    stacks_.clear();
+    origin_ = Clock::now();
+  }
+
+  void ExitPassContext() const final {}
+
+  bool ShouldRun(const IRModule&, const transform::PassInfo&) const final { return true; }
+
+  void RunBeforePass(const IRModule& mod, const transform::PassInfo& info) const final {
+    int64_t num_nodes = count_ir_nodes ? CountReachableObjects(mod) : -1;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Record record;
+    record.name = info->name;
+    record.thread = ThreadIndex(std::this_thread::get_id());
+    record.nodes_before = num_nodes;
+    record.peak_rss_before = PeakResidentBytes();
+    record.allocs_before = runtime::GetObjectPoolStats().num_allocs;
+    std::vector<size_t>& stack = stacks_[std::this_thread::get_id()];
+    (stack.empty() ? roots_ : records_[stack.back()].children).push_back(records_.size());
+    stack.push_back(records_.size());
+    // Started last, so that the measurements above are not counted in the pass
+    record.start = Clock::now();
+    records_.push_back(std::move(record));
+  }
+
+  void RunAfterPass(const IRModule& mod, const transform::PassInfo& info) const final {
+    Clock::time_point end = Clock::now();
+    int64_t num_allocs = runtime::GetObjectPoolStats().num_allocs;
+    int64_t peak_rss = PeakResidentBytes();
+    int64_t num_nodes = count_ir_nodes ? CountReachableObjects(mod) : -1;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<size_t>& stack = stacks_[std::this_thread::get_id()];
+    ICHECK(!stack.empty()) << "mismatched enter/exit for pass profiling";
+    Record& record = records_[stack.back()];
+    stack.pop_back();
+    ICHECK_EQ(record.name, info->name) << "mismatched enter/exit for pass profiling";
+    record.duration = std::chrono::duration_cast<Duration>(end - record.start);
+    record.num_allocs = num_allocs - record.allocs_before;
+    record.peak_rss_delta = peak_rss - record.peak_rss_before;
+    record.nodes_after = num_nodes;
+  }
+
+  /*! \return The passes as an indented tree, with the time spent in each pass itself. */
+  String Render() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream os;
+    os << std::fixed;
+    // (depth, record index)
+    std::vector<std::pair<size_t, size_t>> stack;
+    for (auto it = roots_.rbegin(); it != roots_.rend(); ++it) {
+      stack.emplace_back(0, *it);
+    }
+    while (!stack.empty()) {
+      auto [depth, index] = stack.back();
+      stack.pop_back();
+      const Record& record = records_[index];
+      Duration self_duration = record.duration;
+      for (auto it = record.children.rbegin(); it != record.children.rend(); ++it) {
+        self_duration -= records_[*it].duration;
+        stack.emplace_back(depth + 1, *it);
+      }
+      for (size_t i = 0; i < depth; ++i) {
+        os << "\t";
+      }
+      os << record.name << ": " << std::setprecision(0) << record.duration.count() << "us ["
+         << self_duration.count() << "us] peak rss +" << std::setprecision(2)
+         << record.peak_rss_delta / 1048576.0 << "MB, " << record.num_allocs << " allocs";
+      if (record.nodes_before >= 0) {
+        os << ", " << record.nodes_before << " -> " << record.nodes_after << " nodes";
+      }
+      if (record.thread != 0) {
+        os << " (thread " << record.thread << ")";
+      }
+      os << "\n";
+    }
+    return os.str();
+  }
+
+  /*! \return The passes as complete events of the Chrome trace event format. */
+  String ChromeTrace() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+    for (size_t i = 0; i < records_.size(); ++i) {
+      const Record& record = records_[i];
+      Duration start = std::chrono::duration_cast<Duration>(record.start - origin_);
+      os << (i == 0 ? "\n" : ",\n") << "  {\"name\": \""
+         << support::StrEscape(record.name.data(), record.name.size())
+         << "\", \"cat\": \"pass\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << record.thread
+         << ", \"ts\": " << start.count() << ", \"dur\": " << record.duration.count()
+         << ", \"args\": {\"peak_rss_delta\": " << record.peak_rss_delta
+         << ", \"num_allocs\": " << record.num_allocs;
+      if (record.nodes_before >= 0) {
+        os << ", \"nodes_before\": " << record.nodes_before
+           << ", \"nodes_after\": " << record.nodes_after;
+      }
+      os << "}}";
+    }
+    os << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    return os.str();
+  }
+
+  static constexpr const char* _type_key = "instrument.PassProfilingInstrument";
+  TVM_DECLARE_FINAL_OBJECT_INFO(PassProfilingInstrumentNode, PassInstrumentNode);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using Duration = std::chrono::duration<double, std::micro>;
+
+  /*! \brief The measurements of a pass run. */
+  struct Record {
+    String name;
+    /*! \brief The index of the thread running the pass, in the order the threads were seen. */
+    int thread{0};
+    Clock::time_point start;
+    Duration duration{0};
+    int64_t peak_rss_before{0};
+    /*! \brief The growth of the peak resident set size of the process, in bytes. */
+    int64_t peak_rss_delta{0};
+    int64_t allocs_before{0};
+    /*! \brief The objects allocated by the thread running the pass. */
+    int64_t num_allocs{0};
+    /*! \brief The IR objects before and after the pass, or -1 when not counted. */
+    int64_t nodes_before{-1};
+    int64_t nodes_after{-1};
+    /*! \brief The passes run by this pass. */
+    std::vector<size_t> children;
+  };
+
+  int ThreadIndex(std::thread::id id) const {
+    return thread_ids_.emplace(id, static_cast<int>(thread_ids_.size())).first->second;
+  }
+
+  // The passes of a context may run on several threads, e.g. function passes in parallel.
+  mutable std::mutex mutex_;
+  mutable std::vector<Record> records_;
+  /*! \brief The passes not run by another pass of their thread. */
+  mutable std::vector<size_t> roots_;
+  /*! \brief The passes running on each thread. */
+  mutable std::unordered_map<std::thread::id, std::vector<size_t>> stacks_;
+  mutable std::unordered_map<std::thread::id, int> thread_ids_;
+  mutable Clock::time_point origin_{Clock::now()};
+};
+
+TVM_REGISTER_NODE_TYPE(PassProfilingInstrumentNode);
+
+TVM_REGISTER_GLOBAL("instrument.MakePassProfilingInstrument")
+    .set_body_typed([](bool count_ir_nodes) {
+      auto n = make_object<PassProfilingInstrumentNode>();
+      n->name = "PassProfilingInstrument";
+      n->count_ir_nodes = count_ir_nodes;
+      return PassInstrument(n);
+    });
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilingInstrumentRender")
+    .set_body_typed([](PassInstrument instrument) {
+      const auto* node = instrument.as<PassProfilingInstrumentNode>();
+      ICHECK(node) << "expected a PassProfilingInstrument, got " << instrument->name;
+      return node->Render();
+    });
+
+TVM_REGISTER_GLOBAL("instrument.PassProfilingInstrumentChromeTrace")
+    .set_body_typed([](PassInstrument instrument) {
+      const auto* node = instrument.as<PassProfilingInstrumentNode>();
+      ICHECK(node) << "expected a PassProfilingInstrument, got " << instrument->name;
+      return node->ChromeTrace();
+    });
+
 }  // namespace instrument
 }  // namespace tvm
@@ -27,11 +27,16 @@
 #include <tvm/node/structural_hash.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
+#include <tvm/support/parallel_for.h>
 
+#include <algorithm>
 #include <chrono>
+#include <exception>
 #include <iomanip>
 #include <stack>
 #include <unordered_set>
+#include <vector>
 
 #include "../runtime/object_internal.h"
 
@@ -43,6 +48,7 @@ using tvm::runtime::TVMArgs;
 using tvm::runtime::TVMRetValue;
 
 TVM_REGISTER_PASS_CONFIG_OPTION("testing.immutable_module", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("transform.num_function_pass_threads", Integer);
 
 struct PassContextThreadLocalEntry {
   /*! \brief The default pass context. */
@@ -82,6 +88,50 @@ PassContext PassContext::Current() {
   }
 }
 
+int NumFunctionPassThreads(const PassContext& pass_ctx, const PassInfo& pass_info,
+                           size_t num_funcs) {
+  if (!pass_info->thread_safe || num_funcs <= 1) return 1;
+  int num_threads = pass_ctx->GetConfig<Integer>("transform.num_function_pass_threads", Integer(1))
+                        .value()
+                        ->value;
+  if (num_threads <= 0) num_threads = runtime::threading::MaxConcurrency();
+  return std::max(1, std::min<int>(num_threads, static_cast<int>(num_funcs)));
+}
+
+void ForEachFunction(const PassContext& pass_ctx, const PassInfo& pass_info, size_t num_funcs,
+                     const std::function<void(size_t)>& fvisit) {
+  ParallelForEach(pass_ctx, num_funcs, NumFunctionPassThreads(pass_ctx, pass_info, num_funcs),
+                  fvisit);
+}
+
+void ParallelForEach(const PassContext& pass_ctx, size_t num_tasks, int num_threads,
+                     const std::function<void(size_t)>& fvisit) {
+  num_threads = std::min<int>(num_threads, static_cast<int>(num_tasks));
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      fvisit(i);
+    }
+    return;
+  }
+  std::vector<std::exception_ptr> errors(num_tasks);
+  auto fworker = [&](int thread_id, int task_id) {
+    // The passes look up their config in the current context. Unlike EnterWithScope,
+    // this does not enter the instruments again.
+    PassContextThreadLocalEntry* entry = RelayPassContextThreadLocalStore::Get();
+    entry->context_stack.push(pass_ctx);
+    try {
+      fvisit(task_id);
+    } catch (...) {
+      errors[task_id] = std::current_exception();
+    }
+    entry->context_stack.pop();
+  };
+  support::parallel_for_dynamic(0, static_cast<int>(num_tasks), num_threads, fworker);
+  for (const std::exception_ptr& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
 // linearly scan the pass array to match pass_name
 bool PassArrayContains(const Array<runtime::String>& pass_array, const std::string& pass_name) {
   for (auto x : pass_array) {
@@ -341,11 +391,13 @@ class ModulePass : public Pass {
   TVM_DEFINE_OBJECT_REF_METHODS(ModulePass, Pass, ModulePassNode);
 };
 
-PassInfo::PassInfo(int opt_level, String name, tvm::Array<runtime::String> required) {
+PassInfo::PassInfo(int opt_level, String name, tvm::Array<runtime::String> required,
+                   bool thread_safe) {
   auto pass_info = make_object<PassInfoNode>();
   pass_info->opt_level = opt_level;
   pass_info->name = std::move(name);
   pass_info->required = std::move(required);
+  pass_info->thread_safe = thread_safe;
   data_ = std::move(pass_info);
 }
 
@@ -462,8 +514,8 @@ Pass CreateModulePass(const runtime::TypedPackedFunc<IRModule(IRModule, PassCont
 TVM_REGISTER_NODE_TYPE(PassInfoNode);
 
 TVM_REGISTER_GLOBAL("transform.PassInfo")
-    .set_body_typed([](int opt_level, String name, tvm::Array<String> required) {
-      return PassInfo(opt_level, name, required);
+    .set_body_typed([](int opt_level, String name, tvm::Array<String> required, bool thread_safe) {
+      return PassInfo(opt_level, name, required, thread_safe);
     });
 
 TVM_REGISTER_GLOBAL("transform.Info").set_body([](TVMArgs args, TVMRetValue* ret) {
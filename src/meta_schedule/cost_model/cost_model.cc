@@ -34,12 +34,14 @@ void PyCostModelNode::Save(const String& path) {
 void PyCostModelNode::Update(const TuneContext& context, const Array<MeasureCandidate>& candidates,
                              const Array<RunnerResult>& results) {
   ICHECK(f_update != nullptr) << "PyCostModel's Update method not implemented!";
+  auto _ = Profiler::TimedScope("PyCostModel/Update");
   f_update(context, candidates, results);
 }
 
 std::vector<double> PyCostModelNode::Predict(const TuneContext& context,
                                              const Array<MeasureCandidate>& candidates) {
   ICHECK(f_predict != nullptr) << "PyCostModel's Predict method not implemented!";
+  auto _ = Profiler::TimedScope("PyCostModel/Predict");
   std::vector<double> result(candidates.size(), 0.0);
   f_predict(context, candidates, result.data());
   return result;
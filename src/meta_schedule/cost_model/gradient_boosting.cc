@@ -0,0 +1,551 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+
+#include "../../runtime/file_utils.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*! \brief A node of a regression tree, which is a leaf if `feature` is negative. */
+struct GBDTTreeNode {
+  /*! \brief The index of the feature to split on. */
+  int32_t feature;
+  /*! \brief The histogram bin to split at, the rows in it or in the bins below go left. */
+  int32_t bin;
+  /*! \brief The feature value to split at, the rows with a smaller value go left. */
+  float threshold;
+  /*! \brief The index of the left child, the right child immediately follows it. */
+  int32_t left;
+  /*! \brief The output of the leaf. */
+  float value;
+};
+
+using GBDTTree = std::vector<GBDTTreeNode>;
+
+/*!
+ * \brief The training set of the model. Each sample is a measured candidate with one feature row
+ * per buffer store, and its prediction is the sum of the predictions of its rows.
+ */
+struct GBDTDataset {
+  /*! \brief The number of features in a row. */
+  int num_features = -1;
+  /*! \brief The feature rows of all samples, in row-major order. */
+  std::vector<float> features;
+  /*! \brief The rows of sample `i` are `[row_ptr[i], row_ptr[i + 1])`. */
+  std::vector<int64_t> row_ptr = {0};
+  /*! \brief The measured cost of each sample. */
+  std::vector<double> costs;
+  /*! \brief The hash of the workload each sample belongs to. */
+  std::vector<uint64_t> groups;
+
+  int64_t NumSamples() const { return costs.size(); }
+  int64_t NumRows() const { return row_ptr.back(); }
+
+  /*!
+   * \brief Append the feature rows of a sample.
+   * \param features The feature matrix of shape [num_rows, num_features], in float32 or float64.
+   * \return The number of rows appended.
+   */
+  int64_t AppendRows(const runtime::NDArray& feature) {
+    ICHECK_EQ(feature->ndim, 2) << "ValueError: Expect a 2-D feature matrix";
+    int64_t n_rows = feature->shape[0];
+    int n_features = feature->shape[1];
+    if (n_rows == 0) {
+      return 0;
+    }
+    if (num_features == -1) {
+      num_features = n_features;
+    }
+    CHECK_EQ(num_features, n_features) << "ValueError: Inconsistent length of feature vectors";
+    int64_t n = n_rows * n_features;
+    if (feature->dtype.bits == 32) {
+      const float* data = static_cast<const float*>(feature->data);
+      features.insert(features.end(), data, data + n);
+    } else {
+      ICHECK_EQ(feature->dtype.bits, 64) << "ValueError: Expect float32 or float64 features";
+      const double* data = static_cast<const double*>(feature->data);
+      features.insert(features.end(), data, data + n);
+    }
+    row_ptr.push_back(row_ptr.back() + n_rows);
+    return n_rows;
+  }
+
+  /*! \return The label of each sample, i.e. the best cost of its workload divided by its cost. */
+  std::vector<double> Labels() const {
+    std::unordered_map<uint64_t, double> min_costs;
+    for (int64_t i = 0, n = NumSamples(); i < n; ++i) {
+      auto it = min_costs.emplace(groups[i], costs[i]).first;
+      it->second = std::min(it->second, costs[i]);
+    }
+    std::vector<double> labels;
+    labels.reserve(NumSamples());
+    for (int64_t i = 0, n = NumSamples(); i < n; ++i) {
+      labels.push_back(min_costs.at(groups[i]) / costs[i]);
+    }
+    return labels;
+  }
+};
+
+/*! \brief Predict a single feature row with a tree. */
+inline float PredictRow(const GBDTTree& tree, const float* row) {
+  int node = 0;
+  while (tree[node].feature >= 0) {
+    node = tree[node].left + (row[tree[node].feature] < tree[node].threshold ? 0 : 1);
+  }
+  return tree[node].value;
+}
+
+/*!
+ * \brief The trainer of gradient-boosted trees. It fits the sum of the row predictions of each
+ * sample to its label with the square error weighted by the label, so that the model focuses on
+ * the fast candidates, the same objective as the pack-sum format of the XGBoost model.
+ * Split finding uses quantized features and is parallelized over the features.
+ */
+class GBDTTrainer {
+ public:
+  struct Config {
+    int max_depth;
+    double eta;
+    double gamma;
+    double min_child_weight;
+    double reg_lambda;
+    int max_rounds;
+    int early_stopping_rounds;
+    int num_bins;
+    int num_threads;
+  };
+
+  GBDTTrainer(const GBDTDataset& data, const Config& config)
+      : data_(data),
+        config_(config),
+        n_rows_(data.NumRows()),
+        n_features_(data.num_features),
+        labels_(data.Labels()) {
+    row_labels_.resize(n_rows_);
+    row_sample_.resize(n_rows_);
+    for (int64_t i = 0, n = data.NumSamples(); i < n; ++i) {
+      for (int64_t r = data.row_ptr[i]; r < data.row_ptr[i + 1]; ++r) {
+        row_labels_[r] = labels_[i];
+        row_sample_[r] = i;
+      }
+    }
+    Quantize();
+  }
+
+  /*! \brief The relative decrease of the training error for a round to count as an improvement. */
+  static constexpr double kMinRelativeImprovement = 1e-3;
+
+  /*! \brief Train the trees, with early stopping on the training error. */
+  std::vector<GBDTTree> Train() {
+    std::vector<GBDTTree> trees;
+    std::vector<double> margins(n_rows_, 0.0);
+    std::vector<double> sample_preds = SamplePredictions(margins);
+    std::vector<double> grad(n_rows_), hess(n_rows_);
+    double best_error = std::numeric_limits<double>::infinity();
+    int best_round = -1;
+    for (int round = 0; round < config_.max_rounds; ++round) {
+      for (int64_t r = 0; r < n_rows_; ++r) {
+        double y = row_labels_[r];
+        grad[r] = (sample_preds[row_sample_[r]] - y) * y;
+        hess[r] = y;
+      }
+      GBDTTree tree = BuildTree(grad, hess);
+      support::parallel_for_dynamic(0, n_rows_, config_.num_threads, [&](int, int r) {
+        margins[r] += PredictBinnedRow(tree, r);
+      });
+      trees.push_back(std::move(tree));
+      sample_preds = SamplePredictions(margins);
+      double error = 0.0;
+      for (int64_t r = 0; r < n_rows_; ++r) {
+        double diff = sample_preds[row_sample_[r]] - row_labels_[r];
+        error += diff * diff;
+      }
+      error = std::sqrt(error / std::max<int64_t>(n_rows_, 1));
+      // Tiny improvements on the training set are not worth more trees
+      if (error < best_error * (1.0 - kMinRelativeImprovement)) {
+        best_error = error;
+        best_round = round;
+      } else if (round - best_round >= config_.early_stopping_rounds) {
+        break;
+      }
+    }
+    trees.resize(best_round + 1);
+    return trees;
+  }
+
+ private:
+  /*! \brief The split found for a tree node. */
+  struct Split {
+    double gain = 0.0;
+    int feature = -1;
+    int bin = -1;
+  };
+
+  /*! \brief Compute the quantile cuts of each feature and quantize the features with them. */
+  void Quantize() {
+    cuts_.resize(n_features_);
+    bins_.resize(n_features_ * n_rows_);
+    support::parallel_for_dynamic(0, n_features_, config_.num_threads, [&](int, int f) {
+      std::vector<float> values;
+      values.reserve(n_rows_);
+      for (int64_t r = 0; r < n_rows_; ++r) {
+        values.push_back(data_.features[r * n_features_ + f]);
+      }
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+      // A value falls into the bin indexed by the number of cuts not greater than it
+      std::vector<float>& cuts = cuts_[f];
+      int n_values = values.size();
+      if (n_values <= config_.num_bins) {
+        cuts.assign(values.begin() + std::min(n_values, 1), values.end());
+      } else {
+        for (int i = 1; i < config_.num_bins; ++i) {
+          float cut = values[static_cast<int64_t>(i) * n_values / config_.num_bins];
+          if (cuts.empty() || cuts.back() < cut) {
+            cuts.push_back(cut);
+          }
+        }
+      }
+      for (int64_t r = 0; r < n_rows_; ++r) {
+        float v = data_.features[r * n_features_ + f];
+        bins_[f * n_rows_ + r] = std::upper_bound(cuts.begin(), cuts.end(), v) - cuts.begin();
+      }
+    });
+  }
+
+  std::vector<double> SamplePredictions(const std::vector<double>& margins) const {
+    std::vector<double> preds(data_.NumSamples(), 0.0);
+    for (int64_t r = 0; r < n_rows_; ++r) {
+      preds[row_sample_[r]] += margins[r];
+    }
+    return preds;
+  }
+
+  float PredictBinnedRow(const GBDTTree& tree, int64_t r) const {
+    int node = 0;
+    while (tree[node].feature >= 0) {
+      const GBDTTreeNode& n = tree[node];
+      node = n.left + (bins_[n.feature * n_rows_ + r] <= n.bin ? 0 : 1);
+    }
+    return tree[node].value;
+  }
+
+  double Score(double g, double h) const { return g * g / (h + config_.reg_lambda); }
+
+  /*! \brief Find the best split of the given rows on one feature. */
+  Split FindSplit(const std::vector<int64_t>& rows, int f, double sum_g, double sum_h,
+                  const std::vector<double>& grad, const std::vector<double>& hess) const {
+    int n_bins = cuts_[f].size() + 1;
+    std::vector<double> hist_g(n_bins, 0.0), hist_h(n_bins, 0.0);
+    std::vector<int64_t> hist_n(n_bins, 0);
+    const uint8_t* bins = bins_.data() + f * n_rows_;
+    for (int64_t r : rows) {
+      hist_g[bins[r]] += grad[r];
+      hist_h[bins[r]] += hess[r];
+      hist_n[bins[r]] += 1;
+    }
+    Split best;
+    double parent = Score(sum_g, sum_h);
+    double g_left = 0.0, h_left = 0.0;
+    int64_t n_left = 0;
+    int64_t n_total = rows.size();
+    for (int b = 0; b + 1 < n_bins; ++b) {
+      g_left += hist_g[b];
+      h_left += hist_h[b];
+      n_left += hist_n[b];
+      double g_right = sum_g - g_left;
+      double h_right = sum_h - h_left;
+      if (n_left == 0 || n_left == n_total || h_left < config_.min_child_weight ||
+          h_right < config_.min_child_weight) {
+        continue;
+      }
+      double gain = Score(g_left, h_left) + Score(g_right, h_right) - parent;
+      if (gain > best.gain) {
+        best.gain = gain;
+        best.feature = f;
+        best.bin = b;
+      }
+    }
+    return best;
+  }
+
+  GBDTTree BuildTree(const std::vector<double>& grad, const std::vector<double>& hess) const {
+    GBDTTree tree(1);
+    std::vector<int64_t> all_rows(n_rows_);
+    std::iota(all_rows.begin(), all_rows.end(), 0);
+    // The nodes to be expanded, with their rows and depth
+    std::vector<std::tuple<int, std::vector<int64_t>, int>> stack;
+    stack.emplace_back(0, std::move(all_rows), 0);
+    while (!stack.empty()) {
+      int node = std::get<0>(stack.back());
+      std::vector<int64_t> rows = std::move(std::get<1>(stack.back()));
+      int depth = std::get<2>(stack.back());
+      stack.pop_back();
+      double sum_g = 0.0, sum_h = 0.0;
+      for (int64_t r : rows) {
+        sum_g += grad[r];
+        sum_h += hess[r];
+      }
+      Split best;
+      if (depth < config_.max_depth && rows.size() >= 2) {
+        std::vector<Split> splits(n_features_);
+        support::parallel_for_dynamic(0, n_features_, config_.num_threads, [&](int, int f) {
+          splits[f] = FindSplit(rows, f, sum_g, sum_h, grad, hess);
+        });
+        for (const Split& split : splits) {
+          if (split.gain > best.gain) {
+            best = split;
+          }
+        }
+      }
+      if (best.feature == -1 || best.gain <= config_.gamma) {
+        tree[node] = GBDTTreeNode{-1, -1, 0.0f, -1,
+                                  static_cast<float>(-sum_g / (sum_h + config_.reg_lambda) *
+                                                     config_.eta)};
+        continue;
+      }
+      int left = tree.size();
+      tree[node] = GBDTTreeNode{best.feature, best.bin, cuts_[best.feature][best.bin], left, 0.0f};
+      tree.resize(left + 2);
+      std::vector<int64_t> left_rows, right_rows;
+      const uint8_t* bins = bins_.data() + best.feature * n_rows_;
+      for (int64_t r : rows) {
+        (bins[r] <= best.bin ? left_rows : right_rows).push_back(r);
+      }
+      stack.emplace_back(left, std::move(left_rows), depth + 1);
+      stack.emplace_back(left + 1, std::move(right_rows), depth + 1);
+    }
+    return tree;
+  }
+
+  const GBDTDataset& data_;
+  Config config_;
+  int64_t n_rows_;
+  int n_features_;
+  std::vector<double> labels_;
+  std::vector<double> row_labels_;
+  std::vector<int64_t> row_sample_;
+  /*! \brief The cuts of each feature. */
+  std::vector<std::vector<float>> cuts_;
+  /*! \brief The quantized features, in column-major order. */
+  std::vector<uint8_t> bins_;
+};
+
+/*! \brief A gradient-boosted decision tree cost model that is trained and run in C++. */
+class GradientBoostingModelNode : public CostModelNode {
+ public:
+  using TRandState = support::LinearCongruentialEngine::TRandState;
+
+  /*! \brief The feature extractor. */
+  FeatureExtractor extractor{nullptr};
+  /*! \brief The number of samples before which the predictions are random. */
+  int num_warmup_samples;
+  /*! \brief The maximum depth of a tree. */
+  int max_depth;
+  /*! \brief The learning rate. */
+  double eta;
+  /*! \brief The minimum loss reduction to split a node. */
+  double gamma;
+  /*! \brief The minimum sum of hessian in a child. */
+  double min_child_weight;
+  /*! \brief The L2 regularization on the leaf values. */
+  double reg_lambda;
+  /*! \brief The maximum number of boosting rounds. */
+  int max_rounds;
+  /*! \brief The number of rounds without improvement before the training stops. */
+  int early_stopping_rounds;
+  /*! \brief The number of histogram bins of each feature, at most 256. */
+  int num_bins;
+  /*! \brief Whether to skip retraining until the training set grows by 20%. */
+  bool adaptive_training;
+  /*! \brief The random state, used for predictions in warmup. */
+  TRandState rand_state;
+
+  /*! \brief The training set. */
+  GBDTDataset data_;
+  /*! \brief The trained trees. */
+  std::vector<GBDTTree> trees_;
+  /*! \brief The number of samples at the last training. */
+  int64_t last_train_size_ = 0;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("extractor", &extractor);
+    v->Visit("num_warmup_samples", &num_warmup_samples);
+    v->Visit("max_depth", &max_depth);
+    v->Visit("eta", &eta);
+    v->Visit("gamma", &gamma);
+    v->Visit("min_child_weight", &min_child_weight);
+    v->Visit("reg_lambda", &reg_lambda);
+    v->Visit("max_rounds", &max_rounds);
+    v->Visit("early_stopping_rounds", &early_stopping_rounds);
+    v->Visit("num_bins", &num_bins);
+    v->Visit("adaptive_training", &adaptive_training);
+    v->Visit("rand_state", &rand_state);
+    // `data_` is not visited
+    // `trees_` is not visited
+    // `last_train_size_` is not visited
+  }
+
+  static constexpr uint64_t kMagic = 0x314D444254424447;  // "GDBTBDM1"
+
+  void Load(const String& path) final {
+    std::string blob;
+    runtime::LoadBinaryFromFile(path, &blob);
+    dmlc::MemoryStringStream mstrm(&blob);
+    uint64_t magic = 0;
+    CHECK(mstrm.Read(&magic) && magic == kMagic)
+        << "ValueError: Not a gradient boosting cost model file: " << path;
+    GBDTDataset data;
+    std::vector<GBDTTree> trees;
+    int64_t last_train_size = 0;
+    CHECK(mstrm.Read(&data.num_features) && mstrm.Read(&data.features) &&
+          mstrm.Read(&data.row_ptr) && mstrm.Read(&data.costs) && mstrm.Read(&data.groups) &&
+          mstrm.Read(&trees) && mstrm.Read(&last_train_size))
+        << "ValueError: Corrupted gradient boosting cost model file: " << path;
+    data_ = std::move(data);
+    trees_ = std::move(trees);
+    last_train_size_ = last_train_size;
+  }
+
+  void Save(const String& path) final {
+    std::string blob;
+    dmlc::MemoryStringStream mstrm(&blob);
+    mstrm.Write(kMagic);
+    mstrm.Write(data_.num_features);
+    mstrm.Write(data_.features);
+    mstrm.Write(data_.row_ptr);
+    mstrm.Write(data_.costs);
+    mstrm.Write(data_.groups);
+    mstrm.Write(trees_);
+    mstrm.Write(last_train_size_);
+    runtime::SaveBinaryToFile(path, blob);
+  }
+
+  void Update(const TuneContext& context, const Array<MeasureCandidate>& candidates,
+              const Array<RunnerResult>& results) final {
+    auto _ = Profiler::TimedScope("GBDTModel/Update");
+    ICHECK_EQ(candidates.size(), results.size());
+    if (candidates.empty()) {
+      return;
+    }
+    uint64_t group = context->mod.defined() ? StructuralHash()(context->mod.value()) : 0;
+    Array<runtime::NDArray> features = extractor->ExtractFrom(context, candidates);
+    ICHECK_EQ(features.size(), candidates.size());
+    for (int i = 0, n = candidates.size(); i < n; ++i) {
+      // Candidates with no buffer store have no features to learn from
+      if (data_.AppendRows(features[i]) == 0) {
+        continue;
+      }
+      const RunnerResult& result = results[i];
+      bool ok = result->run_secs.defined() && !result->run_secs.value().empty();
+      data_.costs.push_back(ok ? GetRunMsMedian(result) : 1e10);
+      data_.groups.push_back(group);
+    }
+    int64_t data_size = data_.NumSamples();
+    if (data_size == 0 ||
+        (adaptive_training && data_size - last_train_size_ < last_train_size_ / 5)) {
+      return;
+    }
+    last_train_size_ = data_size;
+    GBDTTrainer::Config config;
+    config.max_depth = max_depth;
+    config.eta = eta;
+    config.gamma = gamma;
+    config.min_child_weight = min_child_weight;
+    config.reg_lambda = reg_lambda;
+    config.max_rounds = max_rounds;
+    config.early_stopping_rounds = early_stopping_rounds;
+    config.num_bins = num_bins;
+    config.num_threads = context->num_threads;
+    trees_ = GBDTTrainer(data_, config).Train();
+  }
+
+  std::vector<double> Predict(const TuneContext& context,
+                              const Array<MeasureCandidate>& candidates) final {
+    auto _ = Profiler::TimedScope("GBDTModel/Predict");
+    int n = candidates.size();
+    std::vector<double> result(n, 0.0);
+    if (data_.NumSamples() < num_warmup_samples || trees_.empty()) {
+      support::LinearCongruentialEngine rand_engine(&rand_state);
+      std::uniform_real_distribution<double> dist(0.0, 1.0);
+      for (int i = 0; i < n; ++i) {
+        result[i] = dist(rand_engine);
+      }
+      return result;
+    }
+    Array<runtime::NDArray> features = extractor->ExtractFrom(context, candidates);
+    ICHECK_EQ(features.size(), candidates.size());
+    support::parallel_for_dynamic(0, n, context->num_threads, [&](int, int i) {
+      GBDTDataset sample;
+      sample.num_features = data_.num_features;
+      int64_t n_rows = sample.AppendRows(features[i]);
+      double score = 0.0;
+      for (int64_t r = 0; r < n_rows; ++r) {
+        const float* row = sample.features.data() + r * sample.num_features;
+        for (const GBDTTree& tree : trees_) {
+          score += PredictRow(tree, row);
+        }
+      }
+      result[i] = score;
+    });
+    return result;
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.GradientBoostingModel";
+  TVM_DECLARE_FINAL_OBJECT_INFO(GradientBoostingModelNode, CostModelNode);
+};
+
+CostModel CostModel::GradientBoosting(FeatureExtractor extractor, int num_warmup_samples,
+                                      int max_depth, double eta, double gamma,
+                                      double min_child_weight, double reg_lambda, int max_rounds,
+                                      int early_stopping_rounds, int num_bins,
+                                      bool adaptive_training, int64_t seed) {
+  CHECK_GE(max_depth, 1) << "ValueError: `max_depth` must be positive";
+  CHECK_GE(max_rounds, 1) << "ValueError: `max_rounds` must be positive";
+  CHECK(num_bins >= 2 && num_bins <= 256) << "ValueError: `num_bins` must be in [2, 256]";
+  CHECK(seed == -1 || seed >= 0) << "ValueError: Invalid random state: " << seed;
+  ObjectPtr<GradientBoostingModelNode> n = make_object<GradientBoostingModelNode>();
+  n->extractor = std::move(extractor);
+  n->num_warmup_samples = num_warmup_samples;
+  n->max_depth = max_depth;
+  n->eta = eta;
+  n->gamma = gamma;
+  n->min_child_weight = min_child_weight;
+  n->reg_lambda = reg_lambda;
+  n->max_rounds = max_rounds;
+  n->early_stopping_rounds = early_stopping_rounds;
+  n->num_bins = num_bins;
+  n->adaptive_training = adaptive_training;
+  n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
+  return CostModel(n);
+}
+
+TVM_REGISTER_NODE_TYPE(GradientBoostingModelNode);
+TVM_REGISTER_GLOBAL("meta_schedule.CostModelGradientBoosting")
+    .set_body_typed(CostModel::GradientBoosting);
+
+}  // namespace meta_schedule
+}  // namespace tvm
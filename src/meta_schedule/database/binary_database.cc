@@ -0,0 +1,438 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#include "../module_equality.h"
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*
+ * Layout of a binary database file, all integers are little-endian:
+ *
+ *   BinaryDatabaseHeader
+ *   { BinaryDatabaseEntry, JSON payload, zero padding to 8 bytes }*
+ *
+ * Entries are only ever appended, each with a single write under an exclusive file lock, so the
+ * index is rebuilt by walking the fixed-size entry headers without parsing any payload.
+ */
+constexpr uint64_t kBinaryDatabaseMagic = 0x314244534D4D5654;  // "TVMMSDB1"
+
+struct BinaryDatabaseHeader {
+  uint64_t magic;
+  /*! \brief The module equality the workload hashes were computed with, NUL-padded */
+  char mod_eq_name[24];
+};
+static_assert(sizeof(BinaryDatabaseHeader) == 32, "BinaryDatabaseHeader must be 32 bytes");
+
+struct BinaryDatabaseEntry {
+  enum Kind : uint32_t { kWorkload = 1, kTuningRecord = 2 };
+  uint32_t kind;
+  /*! \brief Whether the tuning record is valid, see TuningRecordNode::IsValid */
+  uint32_t valid;
+  uint64_t payload_size;
+  /*! \brief The structural hash of a workload, or the entry offset of a record's workload */
+  uint64_t key;
+  /*! \brief The mean run time of a tuning record */
+  double mean_run_secs;
+};
+static_assert(sizeof(BinaryDatabaseEntry) == 32, "BinaryDatabaseEntry must be 32 bytes");
+
+/*!
+ * \brief A file shared between processes that is only appended to. The content is mapped into
+ * memory and remapped when other writers have grown the file.
+ */
+class AppendOnlyFile {
+ public:
+  AppendOnlyFile(const std::string& path, bool allow_missing) : path_(path) {
+#if !defined(_WIN32)
+    struct stat st;
+    CHECK(allow_missing || stat(path.c_str(), &st) == 0)
+        << "ValueError: File doesn't exist: " << path;
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    CHECK_GE(fd_, 0) << "ValueError: Cannot open file: " << path;
+#else
+    std::ifstream is(path, std::ios::binary);
+    if (!is.good()) {
+      CHECK(allow_missing) << "ValueError: File doesn't exist: " << path;
+      std::ofstream os(path, std::ios::binary);
+      CHECK(os.good()) << "ValueError: Cannot create new file: " << path;
+    }
+#endif
+    Refresh();
+  }
+
+  ~AppendOnlyFile() {
+#if !defined(_WIN32)
+    if (data_ != nullptr) munmap(data_, size_);
+    close(fd_);
+#endif
+  }
+
+  /*! \brief Pick up the bytes appended since the last refresh. */
+  void Refresh() {
+#if !defined(_WIN32)
+    struct stat st;
+    CHECK_EQ(fstat(fd_, &st), 0) << "ValueError: Cannot stat file: " << path_;
+    uint64_t size = st.st_size;
+    if (size == size_) return;
+    if (data_ != nullptr) munmap(data_, size_);
+    data_ = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+    CHECK(data_ != MAP_FAILED) << "ValueError: Cannot mmap file: " << path_;
+    size_ = size;
+#else
+    std::ifstream is(path_, std::ios::binary);
+    is.seekg(0, std::ios::end);
+    uint64_t size = is.tellg();
+    if (size > buffer_.size()) {
+      uint64_t old_size = buffer_.size();
+      buffer_.resize(size);
+      is.seekg(old_size);
+      is.read(&buffer_[old_size], size - old_size);
+    }
+#endif
+  }
+
+  /*!
+   * \brief Append bytes to the end of the file. The file lock must be held.
+   * \return The offset the bytes are written at.
+   */
+  uint64_t Append(const std::string& bytes) {
+    Refresh();
+    uint64_t offset = size();
+#if !defined(_WIN32)
+    for (size_t written = 0; written < bytes.size();) {
+      ssize_t n = write(fd_, bytes.data() + written, bytes.size() - written);
+      CHECK_GT(n, 0) << "ValueError: Cannot write to file: " << path_;
+      written += n;
+    }
+#else
+    std::ofstream os(path_, std::ios::binary | std::ios::app);
+    CHECK(os.good()) << "ValueError: Cannot open the file to write: " << path_;
+    os.write(bytes.data(), bytes.size());
+#endif
+    Refresh();
+    return offset;
+  }
+
+  /*! \brief Take the exclusive lock shared with other processes. */
+  void lock() {
+#if !defined(_WIN32)
+    CHECK_EQ(flock(fd_, LOCK_EX), 0) << "ValueError: Cannot lock file: " << path_;
+#endif
+  }
+
+  /*! \brief Release the exclusive lock. */
+  void unlock() {
+#if !defined(_WIN32)
+    flock(fd_, LOCK_UN);
+#endif
+  }
+
+#if !defined(_WIN32)
+  const char* data() const { return static_cast<const char*>(data_); }
+  uint64_t size() const { return size_; }
+#else
+  const char* data() const { return buffer_.data(); }
+  uint64_t size() const { return buffer_.size(); }
+#endif
+
+ private:
+  std::string path_;
+#if !defined(_WIN32)
+  int fd_{-1};
+  void* data_{nullptr};
+  uint64_t size_{0};
+#else
+  std::string buffer_;
+#endif
+};
+
+/*!
+ * \brief A database stored in a single append-only binary file. Only the entry headers are read
+ * when the file is opened; workloads are deserialized when first looked up and tuning records
+ * when they are returned.
+ */
+class BinaryDatabaseNode : public DatabaseNode {
+ public:
+  explicit BinaryDatabaseNode(String mod_eq_name = "structural")
+      : DatabaseNode(mod_eq_name), mod_eq_name_(mod_eq_name) {}
+
+  /*! \brief The path to the database file */
+  String path;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("path", &path);
+    // `file_` is not visited
+    // `workloads_` is not visited
+    // `workloads_by_hash_` is not visited
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.BinaryDatabase";
+  TVM_DECLARE_FINAL_OBJECT_INFO(BinaryDatabaseNode, DatabaseNode);
+
+ public:
+  bool HasWorkload(const IRModule& mod) final {
+    Sync();
+    return FindWorkload(mod, GetModuleEquality().Hash(mod)) != nullptr;
+  }
+
+  Workload CommitWorkload(const IRModule& mod) final {
+    WorkloadNode::THashCode shash = GetModuleEquality().Hash(mod);
+    Sync();
+    if (WorkloadSlot* slot = FindWorkload(mod, shash)) {
+      return slot->workload.value();
+    }
+    std::lock_guard<AppendOnlyFile> lock(*file_);
+    // Another process may have committed the same workload before the lock was taken
+    Sync();
+    if (WorkloadSlot* slot = FindWorkload(mod, shash)) {
+      return slot->workload.value();
+    }
+    Workload workload(mod, shash);
+    BinaryDatabaseEntry entry{BinaryDatabaseEntry::kWorkload, 0, 0, shash, 0.0};
+    uint64_t offset = Append(entry, JSONDumps(workload->AsJSON()));
+    workloads_.at(offset).workload = workload;
+    return workload;
+  }
+
+  void CommitTuningRecord(const TuningRecord& record) final {
+    Sync();
+    WorkloadSlot* slot = FindWorkload(record->workload->mod, record->workload->shash);
+    CHECK(slot != nullptr) << "ValueError: The workload of the tuning record is not committed";
+    BinaryDatabaseEntry entry{
+        BinaryDatabaseEntry::kTuningRecord, record->IsValid(), 0, slot->offset,
+        SortTuningRecordByMeanRunSecs::Mean(record->run_secs.value_or({}))};
+    std::lock_guard<AppendOnlyFile> lock(*file_);
+    Append(entry, JSONDumps(record->AsJSON()));
+  }
+
+  Array<TuningRecord> GetTopK(const Workload& workload, int top_k) final {
+    CHECK_GE(top_k, 0) << "ValueError: top_k must be non-negative";
+    if (top_k == 0) {
+      return {};
+    }
+    Sync();
+    WorkloadSlot* slot = FindWorkload(workload->mod, workload->shash);
+    if (slot == nullptr) {
+      return {};
+    }
+    Array<TuningRecord> results;
+    results.reserve(top_k);
+    for (const auto& kv : slot->records) {
+      if (!kv.second.valid) {
+        continue;
+      }
+      results.push_back(LoadTuningRecord(kv.second.offset, slot->workload.value()));
+      if (results.size() == static_cast<size_t>(top_k)) {
+        break;
+      }
+    }
+    return results;
+  }
+
+  Array<TuningRecord> GetAllTuningRecords() final {
+    Sync();
+    std::vector<std::tuple<double, uint64_t, WorkloadSlot*>> records;
+    records.reserve(num_records_);
+    for (auto& kv : workloads_) {
+      for (const auto& record : kv.second.records) {
+        records.emplace_back(record.first, record.second.offset, &kv.second);
+      }
+    }
+    std::sort(records.begin(), records.end(),
+              [](const auto& a, const auto& b) { return std::get<0>(a) < std::get<0>(b); });
+    Array<TuningRecord> results;
+    results.reserve(records.size());
+    for (const auto& [mean_run_secs, offset, slot] : records) {
+      results.push_back(LoadTuningRecord(offset, LoadWorkload(slot)));
+    }
+    return results;
+  }
+
+  int64_t Size() final {
+    Sync();
+    return num_records_;
+  }
+
+  /*!
+   * \brief Open the database file, creating it if allowed.
+   * \param allow_missing Whether to create the file when it does not exist.
+   */
+  void Open(bool allow_missing) {
+    file_ = std::make_unique<AppendOnlyFile>(path, allow_missing);
+    if (file_->size() == 0) {
+      std::lock_guard<AppendOnlyFile> lock(*file_);
+      file_->Refresh();
+      if (file_->size() == 0) {
+        BinaryDatabaseHeader header{};
+        header.magic = kBinaryDatabaseMagic;
+        std::strncpy(header.mod_eq_name, mod_eq_name_.c_str(), sizeof(header.mod_eq_name) - 1);
+        file_->Append(std::string(reinterpret_cast<const char*>(&header), sizeof(header)));
+      }
+    }
+    BinaryDatabaseHeader header;
+    CHECK_GE(file_->size(), sizeof(header)) << "ValueError: Truncated database file: " << path;
+    std::memcpy(&header, file_->data(), sizeof(header));
+    CHECK_EQ(header.magic, kBinaryDatabaseMagic) << "ValueError: Not a database file: " << path;
+    std::string file_mod_eq_name(header.mod_eq_name,
+                                 strnlen(header.mod_eq_name, sizeof(header.mod_eq_name)));
+    CHECK_EQ(file_mod_eq_name, std::string(mod_eq_name_))
+        << "ValueError: The database " << path << " is hashed with a different module equality";
+    scanned_ = sizeof(header);
+    Sync();
+  }
+
+ private:
+  /*! \brief A tuning record entry in the file */
+  struct RecordSlot {
+    uint64_t offset;
+    bool valid;
+  };
+
+  /*! \brief A workload entry in the file and its tuning records sorted by mean run time */
+  struct WorkloadSlot {
+    uint64_t offset;
+    Optional<Workload> workload;
+    std::multimap<double, RecordSlot> records;
+  };
+
+  /*! \brief Index the entries appended to the file since the last call. */
+  void Sync() {
+    file_->Refresh();
+    const char* data = file_->data();
+    uint64_t size = file_->size();
+    while (scanned_ + sizeof(BinaryDatabaseEntry) <= size) {
+      BinaryDatabaseEntry entry;
+      std::memcpy(&entry, data + scanned_, sizeof(entry));
+      uint64_t end = scanned_ + sizeof(entry) + AlignUp(entry.payload_size);
+      if (end > size) {
+        // A concurrent writer has not finished this entry yet
+        break;
+      }
+      if (entry.kind == BinaryDatabaseEntry::kWorkload) {
+        workloads_[scanned_].offset = scanned_;
+        workloads_by_hash_[entry.key].push_back(scanned_);
+      } else if (entry.kind == BinaryDatabaseEntry::kTuningRecord) {
+        auto it = workloads_.find(entry.key);
+        CHECK(it != workloads_.end())
+            << "ValueError: Corrupted database " << path << ": dangling tuning record at offset "
+            << scanned_;
+        it->second.records.emplace(entry.mean_run_secs, RecordSlot{scanned_, entry.valid != 0});
+        ++num_records_;
+      } else {
+        LOG(FATAL) << "ValueError: Corrupted database " << path << ": unknown entry kind "
+                   << entry.kind << " at offset " << scanned_;
+      }
+      scanned_ = end;
+    }
+  }
+
+  /*! \brief Append an entry with its payload and index it. The file lock must be held. */
+  uint64_t Append(BinaryDatabaseEntry entry, const std::string& payload) {
+    // Index whatever other processes have written so far, the new entry comes right after
+    Sync();
+    entry.payload_size = payload.size();
+    std::string bytes(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    bytes += payload;
+    bytes.resize(sizeof(entry) + AlignUp(payload.size()), '\0');
+    uint64_t offset = file_->Append(bytes);
+    CHECK_EQ(offset, scanned_) << "ValueError: Corrupted database " << path
+                               << ": incomplete entry at offset " << scanned_;
+    Sync();
+    return offset;
+  }
+
+  /*! \brief Find the workload structurally equal to `mod`, nullptr if there is none. */
+  WorkloadSlot* FindWorkload(const IRModule& mod, WorkloadNode::THashCode shash) {
+    auto it = workloads_by_hash_.find(shash);
+    if (it == workloads_by_hash_.end()) {
+      return nullptr;
+    }
+    for (uint64_t offset : it->second) {
+      WorkloadSlot* slot = &workloads_.at(offset);
+      if (GetModuleEquality().Equal(LoadWorkload(slot)->mod, mod)) {
+        return slot;
+      }
+    }
+    return nullptr;
+  }
+
+  Workload LoadWorkload(WorkloadSlot* slot) {
+    if (!slot->workload.defined()) {
+      slot->workload = Workload::FromJSON(JSONLoads(Payload(slot->offset)));
+    }
+    return slot->workload.value();
+  }
+
+  TuningRecord LoadTuningRecord(uint64_t offset, const Workload& workload) {
+    return TuningRecord::FromJSON(JSONLoads(Payload(offset)), workload);
+  }
+
+  std::string Payload(uint64_t offset) const {
+    BinaryDatabaseEntry entry;
+    std::memcpy(&entry, file_->data() + offset, sizeof(entry));
+    return std::string(file_->data() + offset + sizeof(entry), entry.payload_size);
+  }
+
+  static uint64_t AlignUp(uint64_t size) { return (size + 7) / 8 * 8; }
+
+  /*! \brief The module equality the database is hashed with */
+  String mod_eq_name_;
+  /*! \brief The database file */
+  std::unique_ptr<AppendOnlyFile> file_;
+  /*! \brief The offset up to which the file has been indexed */
+  uint64_t scanned_{0};
+  /*! \brief The workloads, keyed by their entry offset */
+  std::unordered_map<uint64_t, WorkloadSlot> workloads_;
+  /*! \brief The entry offsets of the workloads with each structural hash */
+  std::unordered_map<WorkloadNode::THashCode, std::vector<uint64_t>> workloads_by_hash_;
+  /*! \brief The number of tuning records */
+  int64_t num_records_{0};
+};
+
+Database Database::BinaryDatabase(String path, bool allow_missing, String mod_eq_name) {
+  ObjectPtr<BinaryDatabaseNode> n = make_object<BinaryDatabaseNode>(mod_eq_name);
+  n->path = path;
+  n->Open(allow_missing);
+  return Database(n);
+}
+
+TVM_REGISTER_NODE_TYPE(BinaryDatabaseNode);
+TVM_REGISTER_GLOBAL("meta_schedule.DatabaseBinaryDatabase")
+    .set_body_typed(Database::BinaryDatabase);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -80,12 +80,15 @@ class JSONDatabaseNode : public DatabaseNode {
   std::unordered_map<Workload, int, WorkloadHash, WorkloadEqual> workloads2idx_;
   /*! \brief All the tuning records in the database */
   std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs> tuning_records_;
+  /*! \brief The tuning records of each workload, indexed by the value in `workloads2idx_` */
+  std::vector<std::multiset<TuningRecord, SortTuningRecordByMeanRunSecs>> records_by_workload_;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("path_workload", &path_workload);
     v->Visit("path_tuning_record", &path_tuning_record);
     // `workloads2idx_` is not visited
     // `tuning_records_` is not visited
+    // `records_by_workload_` is not visited
   }
 
   static constexpr const char* _type_key = "meta_schedule.JSONDatabase";
@@ -111,10 +114,11 @@ class JSONDatabaseNode : public DatabaseNode {
   }
 
   void CommitTuningRecord(const TuningRecord& record) {
-    this->tuning_records_.insert(record);
+    int workload_idx = this->workloads2idx_.at(record->workload);
+    this->AddTuningRecord(record, workload_idx);
     JSONFileAppendLine(this->path_tuning_record,
                        JSONDumps(Array<ObjectRef>{
-                           /*workload_index=*/Integer(this->workloads2idx_.at(record->workload)),
+                           /*workload_index=*/Integer(workload_idx),
                            /*tuning_record=*/record->AsJSON()  //
                        }));
   }
@@ -124,19 +128,21 @@ class JSONDatabaseNode : public DatabaseNode {
     if (top_k == 0) {
       return {};
     }
+    auto it = this->workloads2idx_.find(workload);
+    if (it == this->workloads2idx_.end() ||
+        it->second >= static_cast<int>(this->records_by_workload_.size())) {
+      return {};
+    }
+    // Records without valid run time are sorted to the end of each bucket
     Array<TuningRecord> results;
     results.reserve(top_k);
-    for (const TuningRecord& record : this->tuning_records_) {
-      auto run_secs = record->run_secs;
+    for (const TuningRecord& record : this->records_by_workload_[it->second]) {
       if (!record->IsValid()) {
         continue;
       }
-      if (record->workload.same_as(workload) ||
-          WorkloadEqual(GetModuleEquality())(record->workload, workload)) {
-        results.push_back(record);
-        if (results.size() == static_cast<size_t>(top_k)) {
-          break;
-        }
+      results.push_back(record);
+      if (results.size() == static_cast<size_t>(top_k)) {
+        break;
       }
     }
     return results;
@@ -152,6 +158,19 @@ class JSONDatabaseNode : public DatabaseNode {
   }
 
   int64_t Size() { return tuning_records_.size(); }
+
+  /*!
+   * \brief Add a tuning record to the in-memory tables.
+   * \param record The tuning record.
+   * \param workload_idx The index of its workload in `workloads2idx_`.
+   */
+  void AddTuningRecord(const TuningRecord& record, int workload_idx) {
+    if (workload_idx >= static_cast<int>(records_by_workload_.size())) {
+      records_by_workload_.resize(workload_idx + 1);
+    }
+    records_by_workload_[workload_idx].insert(record);
+    tuning_records_.insert(record);
+  }
 };
 
 Database Database::JSONDatabase(String path_workload, String path_tuning_record, bool allow_missing,
@@ -160,13 +179,17 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
   ObjectPtr<JSONDatabaseNode> n = make_object<JSONDatabaseNode>(mod_eq_name);
   // Load `n->workloads2idx_` from `path_workload`
   std::vector<Workload> workloads;
+  // The index in `workloads2idx_` of the workload on each line of the workload file
+  std::vector<int> workload_idx;
   {
     std::vector<ObjectRef> json_objs = JSONFileReadLines(path_workload, num_threads, allow_missing);
     int n_objs = json_objs.size();
     n->workloads2idx_.reserve(n_objs);
-    workloads.reserve(n_objs);
-    for (int i = 0; i < n_objs; ++i) {
-      Workload workload = Workload::FromJSON(json_objs[i]);
+    workloads.resize(n_objs, Workload{nullptr});
+    workload_idx.reserve(n_objs);
+    // Deserializing and hashing the modules dominates the loading time, do it in parallel
+    support::parallel_for_dynamic(0, n_objs, num_threads, [&](int thread_id, int task_id) {
+      Workload workload = Workload::FromJSON(json_objs[task_id]);
       auto recalc_hash = n->GetModuleEquality().Hash(workload->mod);
       // Todo(tvm-team): re-enable the shash check when we get environment
       // independent structural hash values.
@@ -175,8 +198,12 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
         wkl->shash = recalc_hash;
         workload = Workload(wkl);
       }
-      n->workloads2idx_.emplace(workload, i);
-      workloads.push_back(workload);
+      workloads[task_id] = workload;
+    });
+    for (int i = 0; i < n_objs; ++i) {
+      auto it = n->workloads2idx_.emplace(workloads[i], i).first;
+      workloads[i] = it->first;
+      workload_idx.push_back(it->second);
     }
   }
   // Load `n->tuning_records_` from `path_tuning_record`
@@ -203,8 +230,9 @@ Database Database::JSONDatabase(String path_workload, String path_tuning_record,
                        << e.what();
           }
         });
-    for (const TuningRecord& record : records) {
-      n->tuning_records_.insert(record);
+    for (int i = 0, n_records = records.size(); i < n_records; ++i) {
+      const ArrayNode* arr = json_objs[i].as<ArrayNode>();
+      n->AddTuningRecord(records[i], workload_idx[Downcast<Integer>(arr->at(0)).IntValue()]);
     }
   }
   n->path_workload = path_workload;
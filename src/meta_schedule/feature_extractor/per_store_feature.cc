@@ -19,7 +19,9 @@
 #include <tvm/tir/transform.h>
 
 #include <cmath>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <string>
 #include <unordered_map>
@@ -214,31 +216,6 @@ int64_t GetVarStride(const std::vector<MultiIndex>& multi_indices, const IntVec&
   return (result == kNotFound) ? 0 : result;
 }
 
-/*!
- * \brief Converts a 2-dimensional STL vector to a TVM NDArray
- * \param src The source 2-dimensional STL vector
- * \param second_dim_size The length of the second dimension. When the first dim of src is 0,
- * second_dim_size must be specified, and in such case the shape of the result NDArray is
- * (0, second_dim_size).
- * \return The converted TVM NDArray
- */
-runtime::NDArray AsNDArray(const std::vector<std::vector<double>>& src, int second_dim_size = -1) {
-  int n = src.size();
-  ICHECK(!src.empty() || second_dim_size != -1);
-  int m = src.empty() ? second_dim_size : src[0].size();
-  runtime::NDArray tgt = runtime::NDArray::Empty(
-      /*shape=*/{n, m},
-      /*dtype=*/DLDataType{kDLFloat, 64, 1},
-      /*ctx=*/DLDevice{kDLCPU, 0});
-  double* data = static_cast<double*>(tgt->data);
-  for (const std::vector<double>& row : src) {
-    for (double v : row) {
-      *data++ = v;
-    }
-  }
-  return tgt;
-}
-
 }  // namespace utils
 
 namespace transform {
@@ -1356,6 +1333,77 @@ class PerStoreFeatureCollector : private StmtVisitor {
 namespace tvm {
 namespace meta_schedule {
 
+/*!
+ * \brief A bounded LRU cache of the per-store features of candidate modules, keyed by their
+ * structural hash. Mutation often produces candidates identical to ones seen before.
+ */
+class FeatureCache {
+ public:
+  /*! \brief The features of the buffer stores of a module, concatenated. */
+  using Features = std::shared_ptr<const std::vector<double>>;
+
+  /*! \brief The maximum number of modules cached. */
+  size_t capacity = 0;
+
+  /*!
+   * \brief Look up the features of a module.
+   * \param mod The module.
+   * \param shash The structural hash of the module.
+   * \return The features cached, nullptr if missing.
+   */
+  Features Get(const IRModule& mod, size_t shash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = index_.equal_range(shash);
+    for (auto it = range.first; it != range.second; ++it) {
+      std::list<Entry>::iterator entry = it->second;
+      if (StructuralEqual()(entry->mod, mod)) {
+        entries_.splice(entries_.begin(), entries_, entry);
+        return entry->features;
+      }
+    }
+    return nullptr;
+  }
+
+  /*!
+   * \brief Cache the features of a module, evicting the least recently used one if full.
+   * \param mod The module.
+   * \param shash The structural hash of the module.
+   * \param features The features of the module.
+   */
+  void Put(const IRModule& mod, size_t shash, Features features) {
+    if (capacity == 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_front(Entry{mod, shash, std::move(features)});
+    index_.emplace(shash, entries_.begin());
+    while (entries_.size() > capacity) {
+      std::list<Entry>::iterator last = std::prev(entries_.end());
+      auto range = index_.equal_range(last->shash);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == last) {
+          index_.erase(it);
+          break;
+        }
+      }
+      entries_.pop_back();
+    }
+  }
+
+ private:
+  struct Entry {
+    IRModule mod;
+    size_t shash;
+    Features features;
+  };
+
+  std::mutex mutex_;
+  /*! \brief The entries, from the most recently used to the least. */
+  std::list<Entry> entries_;
+  /*! \brief The entries indexed by hash. */
+  std::unordered_multimap<size_t, std::list<Entry>::iterator> index_;
+};
+
 class PerStoreFeatureNode : public FeatureExtractorNode {
  public:
   int buffers_per_store;
@@ -1363,52 +1411,73 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
   int cache_line_bytes;
   bool extract_workload;
   int feature_vector_length;
+  /*! \brief The features of the candidates seen before. */
+  FeatureCache cache_;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     v->Visit("buffers_per_store", &buffers_per_store);
     v->Visit("arith_intensity_curve_num_samples", &arith_intensity_curve_num_samples);
     v->Visit("cache_line_bytes", &cache_line_bytes);
     v->Visit("feature_vector_length", &feature_vector_length);
+    // `cache_` is not visited
   }
 
-  void ExtractSingle(IRModule mod, bool is_gpu, std::vector<std::vector<double>>* results) {
+  /*!
+   * \brief Extract the features of the buffer stores in a module, except the workload features.
+   * \param mod The module, which is transformed in place.
+   * \param is_gpu Whether the target is a GPU.
+   * \return The features of the stores, concatenated into a single buffer.
+   */
+  std::vector<double> ExtractSingle(IRModule mod, bool is_gpu) {
     static transform::Sequential passes = tir::transform::PassListForPerStoreFeature();
     mod = passes(std::move(mod));
     std::vector<tir::Feature> features = tir::PerStoreFeatureCollector::Collect(
         is_gpu, this->cache_line_bytes, this->arith_intensity_curve_num_samples, mod);
-    int n_features = features.size();
-    results->resize(n_features);
-    for (int i = 0; i < n_features; ++i) {
-      const tir::Feature& feature = features[i];
-      std::vector<double>& result = (*results)[i];
-      result.reserve(feature_vector_length);
+    std::vector<double> result;
+    result.reserve(features.size() * feature_vector_length);
+    for (const tir::Feature& feature : features) {
       feature.group1->Export(&result);
       feature.group2->Export(&result, this->buffers_per_store);
       feature.group3->Export(&result);
       feature.group4->Export(&result, feature.group5->outer_prod);
       feature.group5->Export(&result);
     }
+    return result;
   }
 
   Array<runtime::NDArray> ExtractFrom(const TuneContext& tune_context,
                                       const Array<MeasureCandidate>& candidates) {
+    auto _ = Profiler::TimedScope("FeatureExtractor/PerStoreFeature");
     bool is_gpu = tune_context->target.value()->kind->name == "cuda";
     std::vector<runtime::NDArray> results;
     results.resize(candidates.size());
-    std::unique_ptr<tir::group6::Feature> feature_group6 = nullptr;
+    std::vector<double> workload_feature;
     if (extract_workload) {
-      feature_group6 = std::make_unique<tir::group6::Feature>(tune_context->mod.value());
+      tir::group6::Feature(tune_context->mod.value()).Export(&workload_feature);
     }
-    auto f = [this, is_gpu, &feature_group6, &candidates, &results](int, int task_id) -> void {
-      const auto& candidate = candidates[task_id];
-      std::vector<std::vector<double>> features;
-      ExtractSingle(DeepCopyIRModule(candidate->sch->mod()), is_gpu, &features);
-      if (extract_workload) {
-        for (auto& feature : features) {
-          feature_group6->Export(&feature);
-        }
+    int n_store_features = feature_vector_length - workload_feature.size();
+    auto f = [this, is_gpu, n_store_features, &workload_feature, &candidates, &results](
+                 int, int task_id) -> void {
+      IRModule mod = candidates[task_id]->sch->mod();
+      size_t shash = StructuralHash()(mod);
+      FeatureCache::Features features = cache_.Get(mod, shash);
+      if (features == nullptr) {
+        features = std::make_shared<const std::vector<double>>(
+            ExtractSingle(DeepCopyIRModule(mod), is_gpu));
+        cache_.Put(mod, shash, features);
+      }
+      int64_t n = features->size() / n_store_features;
+      runtime::NDArray result = runtime::NDArray::Empty(
+          /*shape=*/{n, feature_vector_length},
+          /*dtype=*/DLDataType{kDLFloat, 64, 1},
+          /*ctx=*/DLDevice{kDLCPU, 0});
+      const double* src = features->data();
+      double* dst = static_cast<double*>(result->data);
+      for (int64_t i = 0; i < n; ++i, src += n_store_features) {
+        dst = std::copy(src, src + n_store_features, dst);
+        dst = std::copy(workload_feature.begin(), workload_feature.end(), dst);
       }
-      results[task_id] = tir::utils::AsNDArray(features, this->feature_vector_length);
+      results[task_id] = result;
     };
     support::parallel_for_dynamic(0, candidates.size(), tune_context->num_threads, f);
     return results;
@@ -1420,7 +1489,9 @@ class PerStoreFeatureNode : public FeatureExtractorNode {
 
 FeatureExtractor FeatureExtractor::PerStoreFeature(int buffers_per_store,
                                                    int arith_intensity_curve_num_samples,
-                                                   int cache_line_bytes, bool extract_workload) {
+                                                   int cache_line_bytes, bool extract_workload,
+                                                   int feature_cache_size) {
+  CHECK_GE(feature_cache_size, 0) << "ValueError: `feature_cache_size` must be non-negative";
   ObjectPtr<PerStoreFeatureNode> n = make_object<PerStoreFeatureNode>();
   n->buffers_per_store = buffers_per_store;
   n->arith_intensity_curve_num_samples = arith_intensity_curve_num_samples;
@@ -1434,6 +1505,7 @@ FeatureExtractor FeatureExtractor::PerStoreFeature(int buffers_per_store,
   if (extract_workload) {
     n->feature_vector_length += tir::group6::Feature::kCount;
   }
+  n->cache_.capacity = feature_cache_size;
   return FeatureExtractor(n);
 }
 
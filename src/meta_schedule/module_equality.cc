@@ -24,16 +24,76 @@
 #include <tvm/tir/analysis.h>
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 #include "../node/ndarray_hash_equal.h"
 
 namespace tvm {
 namespace meta_schedule {
 
+/*!
+ * \brief A thread-safe memo of values computed from objects. The objects are kept alive by the
+ * memo, so that their addresses are not reused by other objects while memoized.
+ */
+template <typename TValue>
+class ObjectMemo {
+ public:
+  template <typename FCompute>
+  TValue Get(const ObjectRef& key, FCompute f_compute) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = memo_.find(key.get());
+      if (it != memo_.end()) {
+        return it->second.second;
+      }
+    }
+    // Compute out of the lock, racing threads compute the same value
+    TValue value = f_compute();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (memo_.size() >= kMaxSize) {
+      memo_.clear();
+    }
+    memo_.emplace(key.get(), std::make_pair(key, value));
+    return value;
+  }
+
+ private:
+  /*! \brief The number of objects memoized, beyond which the memo is cleared. */
+  static constexpr size_t kMaxSize = 16384;
+  std::mutex mutex_;
+  std::unordered_map<const Object*, std::pair<ObjectRef, TValue>> memo_;
+};
+
+class ModuleHashMemo : public ObjectMemo<size_t> {
+ public:
+  /*! \brief Get the memo shared by the instances of a module equality method. */
+  static std::shared_ptr<ModuleHashMemo> Global(const std::string& mod_eq_name) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::shared_ptr<ModuleHashMemo>> memos;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<ModuleHashMemo>& memo = memos[mod_eq_name];
+    if (memo == nullptr) {
+      memo = std::make_shared<ModuleHashMemo>();
+    }
+    return memo;
+  }
+};
+
+size_t ModuleEquality::Hash(IRModule mod) const {
+  if (memo_ == nullptr) {
+    return ComputeHash(mod);
+  }
+  return memo_->Get(mod, [this, &mod]() { return ComputeHash(mod); });
+}
+
 class ModuleEqualityStructural : public ModuleEquality {
  public:
-  size_t Hash(IRModule mod) const { return tvm::StructuralHash()(mod); }
-  bool Equal(IRModule lhs, IRModule rhs) const { return tvm::StructuralEqual()(lhs, rhs); }
+  size_t ComputeHash(IRModule mod) const { return SHashHandlerDefault::ParallelHash(mod, false); }
+  bool Equal(IRModule lhs, IRModule rhs) const {
+    return SEqualHandlerDefault::ParallelEqual(lhs, rhs, false);
+  }
   String GetName() const { return "structural"; }
 };
 
@@ -69,29 +129,55 @@ class SHashHandlerIgnoreNDArray : public SHashHandlerDefault {
 
 class ModuleEqualityIgnoreNDArray : public ModuleEquality {
  public:
-  size_t Hash(IRModule mod) const { return SHashHandlerIgnoreNDArray().Hash(mod, false); }
+  size_t ComputeHash(IRModule mod) const { return SHashHandlerIgnoreNDArray().Hash(mod, false); }
   bool Equal(IRModule lhs, IRModule rhs) const {
     return SEqualHandlerIgnoreNDArray().Equal(lhs, rhs, false);
   }
   String GetName() const { return "ignore-ndarray"; }
 };
 
+/*! \brief The anchor block of a PrimFunc, and the hash of the block */
+struct AnchorBlockInfo {
+  Optional<tir::Block> block;
+  size_t hash;
+};
+
+/*!
+ * \brief Find the anchor block of the entry function of a module, memoized per PrimFunc, as
+ * PrimFuncs are immutable and shared by the modules wrapping them.
+ */
+AnchorBlockInfo FindAnchorBlockMemoized(const IRModule& mod) {
+  static ObjectMemo<AnchorBlockInfo> memo;
+  const tir::PrimFuncNode* func = tir::FindEntryFunc(mod, nullptr);
+  if (func == nullptr) {
+    return AnchorBlockInfo{NullOpt, 0};
+  }
+  return memo.Get(GetRef<tir::PrimFunc>(func), [&mod]() {
+    if (const tir::BlockNode* block = tir::FindAnchorBlock(mod)) {
+      return AnchorBlockInfo{GetRef<tir::Block>(block),
+                             SHashHandlerIgnoreNDArray().Hash(GetRef<tir::Block>(block), false)};
+    }
+    return AnchorBlockInfo{NullOpt, 0};
+  });
+}
+
 // The NDArray-ignoring variant of structural equal / hash is used for the module equality
 // on the extracted anchor blocks.
 class ModuleEqualityAnchorBlock : public ModuleEquality {
-  size_t Hash(IRModule mod) const {
-    auto anchor_block = tir::FindAnchorBlock(mod);
-    if (anchor_block) {
-      return SHashHandlerIgnoreNDArray().Hash(GetRef<tir::Block>(anchor_block), false);
+  size_t ComputeHash(IRModule mod) const {
+    AnchorBlockInfo anchor_block = FindAnchorBlockMemoized(mod);
+    if (anchor_block.block.defined()) {
+      return anchor_block.hash;
     }
-    return ModuleEqualityIgnoreNDArray().Hash(mod);
+    return ModuleEqualityIgnoreNDArray().ComputeHash(mod);
   }
   bool Equal(IRModule lhs, IRModule rhs) const {
-    auto anchor_block_lhs = tir::FindAnchorBlock(lhs);
-    auto anchor_block_rhs = tir::FindAnchorBlock(rhs);
-    if (anchor_block_lhs && anchor_block_rhs) {
-      return SEqualHandlerIgnoreNDArray().Equal(GetRef<tir::Block>(anchor_block_lhs),
-                                                GetRef<tir::Block>(anchor_block_rhs), false);
+    Optional<tir::Block> anchor_block_lhs = FindAnchorBlockMemoized(lhs).block;
+    Optional<tir::Block> anchor_block_rhs = FindAnchorBlockMemoized(rhs).block;
+    if (anchor_block_lhs.defined() && anchor_block_rhs.defined()) {
+      return anchor_block_lhs.same_as(anchor_block_rhs) ||
+             SEqualHandlerIgnoreNDArray().Equal(anchor_block_lhs.value(), anchor_block_rhs.value(),
+                                                false);
     }
     return ModuleEqualityIgnoreNDArray().Equal(lhs, rhs);
   }
@@ -99,14 +185,18 @@ class ModuleEqualityAnchorBlock : public ModuleEquality {
 };
 
 std::unique_ptr<ModuleEquality> ModuleEquality::Create(const std::string& mod_eq_name) {
+  std::unique_ptr<ModuleEquality> result;
   if (mod_eq_name == "structural") {
-    return std::make_unique<ModuleEqualityStructural>();
+    result = std::make_unique<ModuleEqualityStructural>();
   } else if (mod_eq_name == "ignore-ndarray") {
-    return std::make_unique<ModuleEqualityIgnoreNDArray>();
+    result = std::make_unique<ModuleEqualityIgnoreNDArray>();
   } else if (mod_eq_name == "anchor-block") {
-    return std::make_unique<ModuleEqualityAnchorBlock>();
+    result = std::make_unique<ModuleEqualityAnchorBlock>();
+  } else {
+    LOG(FATAL) << "Unknown module equality " << mod_eq_name;
   }
-  LOG(FATAL) << "Unknown module equality " << mod_eq_name;
+  result->memo_ = ModuleHashMemo::Global(mod_eq_name);
+  return result;
 }
 
 }  // namespace meta_schedule
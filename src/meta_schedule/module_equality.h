@@ -27,12 +27,21 @@
 namespace tvm {
 namespace meta_schedule {
 
+class ModuleHashMemo;
+
 /*! \brief Method to compute hash and determine equality of modules  */
 class ModuleEquality {
  public:
   virtual ~ModuleEquality() = default;
 
-  virtual size_t Hash(IRModule mod) const = 0;
+  /*!
+   * \brief Hash a module. The hash of each module is memoized and shared by all the instances of
+   * the same method, so a module hashed during task extraction is not rehashed when the database
+   * looks it up. Modules must not be mutated after being hashed.
+   * \param mod The module to be hashed
+   * \return The hash of the module
+   */
+  size_t Hash(IRModule mod) const;
   virtual bool Equal(IRModule lhs, IRModule rhs) const = 0;
   virtual String GetName() const = 0;
 
@@ -50,6 +59,14 @@ class ModuleEquality {
    * \return An owning pointer to the created instance
    */
   static std::unique_ptr<ModuleEquality> Create(const std::string& mod_eq_name);
+
+ protected:
+  /*! \brief Compute the hash of a module, without memoization. */
+  virtual size_t ComputeHash(IRModule mod) const = 0;
+
+ private:
+  /*! \brief The memoized hashes shared by the instances of the method. */
+  std::shared_ptr<ModuleHashMemo> memo_;
 };
 
 /*! \brief Functor to compute hash a module using the provided method. */
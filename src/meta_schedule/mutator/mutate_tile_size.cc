@@ -16,8 +16,13 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include <cmath>
+#include <limits>
 #include <mutex>
+#include <random>
+#include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "../utils.h"
 
@@ -51,10 +56,21 @@ int64_t Product(const std::vector<int64_t>& array) {
   return result;
 }
 
-/*! \brief A mutator that mutates the tile size */
+/*!
+ * \brief A mutator that mutates the tile size. When guided, it scores a batch of neighboring
+ * decisions and picks the best, with a random bonus for exploration.
+ */
 class MutateTileSizeNode : public MutatorNode {
  public:
-  void VisitAttrs(tvm::AttrVisitor* v) {}
+  /*! \brief The number of neighboring decisions scored when the mutation is guided. */
+  int num_candidates;
+  /*! \brief The weight of the random bonus added to the scores. */
+  double exploration;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    v->Visit("num_candidates", &num_candidates);
+    v->Visit("exploration", &exploration);
+  }
   static constexpr const char* _type_key = "meta_schedule.MutateTileSize";
   TVM_DECLARE_FINAL_OBJECT_INFO(MutateTileSizeNode, MutatorNode);
 
@@ -64,6 +80,9 @@ class MutateTileSizeNode : public MutatorNode {
   // Inherit from `MutatorNode`
   Optional<Trace> Apply(const Trace& trace, TRandState* rand_state) final;
   // Inherit from `MutatorNode`
+  Optional<Trace> ApplyGuided(const Trace& trace, TRandState* rand_state,
+                              const FScore& f_score) final;
+  // Inherit from `MutatorNode`
   Mutator Clone() const final {
     ObjectPtr<MutateTileSizeNode> n = make_object<MutateTileSizeNode>(*this);
     return Mutator(n);
@@ -186,8 +205,8 @@ struct FactorMemo {
   std::mutex mutex_;
 };
 
-Optional<Trace> MutateSampleTileSize(const Trace& trace, Instruction inst,
-                                     std::vector<int64_t> tiles, TRandState* rand_state) {
+Optional<ObjectRef> MutateSampleTileSize(const Instruction& inst, std::vector<int64_t> tiles,
+                                         TRandState* rand_state) {
   int n_splits = tiles.size();
   // Step 1. Choose two loops, `x` and `y`
   int x, y;
@@ -225,13 +244,12 @@ Optional<Trace> MutateSampleTileSize(const Trace& trace, Instruction inst,
     }
     tiles[x] /= divide_factor;
     tiles[y] *= divide_factor;
-    return trace->WithDecision(inst, support::AsArray<int64_t, ObjectRef>(tiles),
-                               /*remove_postproc=*/true);
+    return support::AsArray<int64_t, ObjectRef>(tiles);
   }
 }
 
-Optional<Trace> MutateSampleVectorize(const Trace& trace, Instruction inst,
-                                      int64_t original_decision, TRandState* rand_state) {
+Optional<ObjectRef> MutateSampleVectorize(const Instruction& inst, int64_t original_decision,
+                                          TRandState* rand_state) {
   ICHECK_EQ(inst->attrs.size(), 2);
   std::vector<double> probs =
       support::AsVector<FloatImm, double>(Downcast<Array<FloatImm>>(inst->attrs[1]));
@@ -240,33 +258,113 @@ Optional<Trace> MutateSampleVectorize(const Trace& trace, Instruction inst,
   if (result >= original_decision) {
     result += 1;
   }
-  return trace->WithDecision(inst, Integer(result), /*remove_postproc=*/true);
+  return Integer(result);
 }
 
+/*! \brief The sampler of the mutations of the tile sizes and vector lengths in a trace */
+class TileSizeMutationSampler {
+ public:
+  explicit TileSizeMutationSampler(const Trace& trace) {
+    FindSamplePerfectTile(trace, &sample_perfect_tile_insts_, &sample_perfect_tile_tiles_);
+    FindSampleVectorize(trace, &sample_vectorize_insts_, &sample_vectorize_decisions_);
+  }
+
+  /*!
+   * \brief Sample a mutation
+   * \param rand_state The random state
+   * \param inst The instruction whose decision is mutated
+   * \return The new decision of the instruction, or NullOpt if failed
+   */
+  Optional<ObjectRef> Sample(TRandState* rand_state, Instruction* inst) const {
+    int size_a = sample_perfect_tile_insts_.size();
+    int size_b = sample_vectorize_insts_.size();
+    if (size_a == 0 && size_b == 0) {
+      return NullOpt;
+    }
+    int n = tir::SampleInt(rand_state, 0, size_a + size_b);
+    if (n < size_a) {
+      *inst = sample_perfect_tile_insts_[n];
+      return MutateSampleTileSize(*inst, sample_perfect_tile_tiles_[n], rand_state);
+    } else {
+      n -= size_a;
+      *inst = sample_vectorize_insts_[n];
+      return MutateSampleVectorize(*inst, sample_vectorize_decisions_[n], rand_state);
+    }
+  }
+
+ private:
+  std::vector<Instruction> sample_perfect_tile_insts_;
+  std::vector<std::vector<int64_t>> sample_perfect_tile_tiles_;
+  std::vector<Instruction> sample_vectorize_insts_;
+  std::vector<int64_t> sample_vectorize_decisions_;
+};
+
 Optional<Trace> MutateTileSizeNode::Apply(const Trace& trace, TRandState* rand_state) {
-  std::vector<Instruction> sample_perfect_tile_insts;
-  std::vector<Instruction> sample_vectorize_insts;
-  std::vector<std::vector<int64_t>> sample_perfect_tile_tiles;
-  std::vector<int64_t> sample_vectorize_decisions;
-  FindSamplePerfectTile(trace, &sample_perfect_tile_insts, &sample_perfect_tile_tiles);
-  FindSampleVectorize(trace, &sample_vectorize_insts, &sample_vectorize_decisions);
-  int size_a = sample_perfect_tile_insts.size();
-  int size_b = sample_vectorize_insts.size();
-  if (size_a == 0 && size_b == 0) {
+  Instruction inst{nullptr};
+  if (Optional<ObjectRef> decision = TileSizeMutationSampler(trace).Sample(rand_state, &inst)) {
+    return trace->WithDecision(inst, decision.value(), /*remove_postproc=*/true);
+  }
+  return NullOpt;
+}
+
+Optional<Trace> MutateTileSizeNode::ApplyGuided(const Trace& trace, TRandState* rand_state,
+                                                const FScore& f_score) {
+  if (num_candidates <= 1 || f_score == nullptr) {
+    return Apply(trace, rand_state);
+  }
+  // Step 1. Sample distinct neighbors of the trace, each of which mutates a single decision
+  TileSizeMutationSampler sampler(trace);
+  std::vector<Trace> candidates;
+  std::unordered_set<std::string> visited;
+  candidates.reserve(num_candidates);
+  for (int i = 0, max_tries = 2 * num_candidates;
+       i < max_tries && static_cast<int>(candidates.size()) < num_candidates; ++i) {
+    Instruction inst{nullptr};
+    Optional<ObjectRef> decision = sampler.Sample(rand_state, &inst);
+    if (!decision.defined()) {
+      continue;
+    }
+    std::ostringstream os;
+    os << inst.get() << ':' << decision.value();
+    if (visited.insert(os.str()).second) {
+      candidates.push_back(trace->WithDecision(inst, decision.value(), /*remove_postproc=*/true));
+    }
+  }
+  if (candidates.empty()) {
     return NullOpt;
   }
-  int n = tir::SampleInt(rand_state, 0, size_a + size_b);
-  if (n < size_a) {
-    return MutateSampleTileSize(trace, sample_perfect_tile_insts[n], sample_perfect_tile_tiles[n],
-                                rand_state);
-  } else {
-    n -= size_a;
-    return MutateSampleVectorize(trace, sample_vectorize_insts[n], sample_vectorize_decisions[n],
-                                 rand_state);
+  // Step 2. Score the neighbors, and pick the best one after adding the random bonus
+  std::vector<double> scores = f_score(candidates);
+  ICHECK_EQ(scores.size(), candidates.size());
+  support::LinearCongruentialEngine rand_engine(rand_state);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  int best = -1;
+  double best_score = -std::numeric_limits<double>::infinity();
+  for (int i = 0, n = candidates.size(); i < n; ++i) {
+    if (std::isinf(scores[i]) && scores[i] < 0) {
+      continue;
+    }
+    double score = (1.0 - exploration) * scores[i] + exploration * dist(rand_engine);
+    if (best == -1 || score > best_score) {
+      best = i;
+      best_score = score;
+    }
   }
+  if (best == -1) {
+    return NullOpt;
+  }
+  return candidates[best];
 }
 
-Mutator Mutator::MutateTileSize() { return Mutator(make_object<MutateTileSizeNode>()); }
+Mutator Mutator::MutateTileSize(int num_candidates, double exploration) {
+  CHECK_GE(num_candidates, 1) << "ValueError: `num_candidates` must be positive";
+  CHECK(0.0 <= exploration && exploration <= 1.0)
+      << "ValueError: `exploration` must be in [0, 1], but gets: " << exploration;
+  ObjectPtr<MutateTileSizeNode> n = make_object<MutateTileSizeNode>();
+  n->num_candidates = num_candidates;
+  n->exploration = exploration;
+  return Mutator(n);
+}
 
 TVM_REGISTER_NODE_TYPE(MutateTileSizeNode);
 TVM_REGISTER_GLOBAL("meta_schedule.MutatorMutateTileSize").set_body_typed(Mutator::MutateTileSize);
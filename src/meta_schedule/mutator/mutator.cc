@@ -102,6 +102,21 @@ TVM_REGISTER_GLOBAL("meta_schedule.MutatorApply")
       TRandState seed_ = (seed != -1) ? seed : support::LinearCongruentialEngine::DeviceRandom();
       return self->Apply(trace, &seed_);
     });
+TVM_REGISTER_GLOBAL("meta_schedule.MutatorApplyGuided")
+    .set_body_typed([](Mutator self, tir::Trace trace, TRandState seed,
+                       PackedFunc f_score) -> Optional<tir::Trace> {
+      TRandState seed_ = (seed != -1) ? seed : support::LinearCongruentialEngine::DeviceRandom();
+      MutatorNode::FScore score = [&f_score](const std::vector<tir::Trace>& traces) {
+        Array<FloatImm> scores = f_score(Array<tir::Trace>(traces.begin(), traces.end()));
+        std::vector<double> result;
+        result.reserve(scores.size());
+        for (const FloatImm& score : scores) {
+          result.push_back(score->value);
+        }
+        return result;
+      };
+      return self->ApplyGuided(trace, &seed_, score);
+    });
 TVM_REGISTER_GLOBAL("meta_schedule.MutatorClone").set_body_method<Mutator>(&MutatorNode::Clone);
 TVM_REGISTER_GLOBAL("meta_schedule.MutatorPyMutator").set_body_typed(Mutator::PyMutator);
 TVM_REGISTER_GLOBAL("meta_schedule.MutatorDefaultLLVM").set_body_typed(Mutator::DefaultLLVM);
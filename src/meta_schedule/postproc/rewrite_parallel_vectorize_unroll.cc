@@ -16,6 +16,7 @@
  * specific language governing permissions and limitations
  * under the License.
  */
+#include "../../target/parsers/aprofile.h"
 #include "../utils.h"
 
 namespace tvm {
@@ -355,10 +356,29 @@ bool FindAnnotatedRootBlock(const Schedule& sch, ParsedAnnotation* parsed, Block
   return false;
 }
 
-void RewriteFuseSplitParallelVectorize(const Schedule& sch, Array<LoopRV>* loop_rvs, int vec_len) {
+/*!
+ * \brief The split factor of a vector length agnostic loop, vscale times the lanes of a 128 bit
+ *  vector of the element type written by the block.
+ */
+Optional<PrimExpr> ScalableVectorFactor(const Schedule& sch, const BlockRV& block_rv) {
+  const BlockNode* block = TVM_SREF_TO_BLOCK(sch->GetSRef(block_rv));
+  if (block->writes.empty()) {
+    return NullOpt;
+  }
+  int bits = block->writes[0]->buffer->dtype.bits();
+  if (bits <= 0 || bits > 64 || 128 % bits != 0) {
+    return NullOpt;
+  }
+  return vscale() * (128 / bits);
+}
+
+void RewriteFuseSplitParallelVectorize(const Schedule& sch, Array<LoopRV>* loop_rvs, int vec_len,
+                                       Optional<PrimExpr> scalable_factor = NullOpt) {
   size_t n_loops = loop_rvs->size();
   LoopRV fused = sch->Fuse({loop_rvs->begin(), loop_rvs->end()});
-  Array<LoopRV> split = sch->Split(fused, {NullOpt, Integer(vec_len)});
+  // A scalable factor does not divide the extent in general, the split predicates the tail.
+  PrimExpr factor = scalable_factor.value_or(Integer(vec_len));
+  Array<LoopRV> split = sch->Split(fused, {NullOpt, factor});
   ICHECK_EQ(split.size(), 2);
   const LoopRV& outer = split[0];
   const LoopRV& inner = split[1];
@@ -408,7 +428,22 @@ using tir::Schedule;
 
 class RewriteParallelVectorizeUnrollNode : public PostprocNode {
  public:
-  void InitializeWithTuneContext(const TuneContext& context) final {}
+  void InitializeWithTuneContext(const TuneContext& context) final {
+    use_scalable_vectors_ = false;
+    Target target = context->target.value_or(Target(nullptr));
+    if (!target.defined() || target->kind->name != "llvm") {
+      return;
+    }
+    if (target::parsers::aprofile::IsArch(target->Export())) {
+      TargetJSON target_json = target::parsers::aprofile::ParseTarget(target->Export());
+      TargetFeatures features = Downcast<TargetFeatures>(target_json.at("features"));
+      use_scalable_vectors_ = Downcast<Bool>(features.at("has_sve"));
+    } else if (Optional<Array<String>> mattr = target->GetAttr<Array<String>>("mattr")) {
+      for (const String& attr : mattr.value()) {
+        use_scalable_vectors_ |= attr == "+v";
+      }
+    }
+  }
 
   bool Apply(const Schedule& sch) final {
     tir::ParsedAnnotation parsed_root;
@@ -424,7 +459,10 @@ class RewriteParallelVectorizeUnrollNode : public PostprocNode {
         const int loops_num = loop_rvs.size();
         if (parsed.num_parallel_loops == loops_num && parsed.num_vectorize_loops == loops_num) {
           // Fuse, split, vectorize and parallelize
-          tir::RewriteFuseSplitParallelVectorize(sch, &loop_rvs, parsed.max_vectorize_extent);
+          Optional<PrimExpr> scalable_factor =
+              use_scalable_vectors_ ? tir::ScalableVectorFactor(sch, block_rv) : NullOpt;
+          tir::RewriteFuseSplitParallelVectorize(sch, &loop_rvs, parsed.max_vectorize_extent,
+                                                 scalable_factor);
         } else {
           // Parallel
           if (parsed.num_parallel_loops > 0) {
@@ -453,6 +491,9 @@ class RewriteParallelVectorizeUnrollNode : public PostprocNode {
     return Postproc(n);
   }
 
+  /*! \brief Whether the target has scalable vectors, SVE or the RISC-V vector extension. */
+  bool use_scalable_vectors_ = false;
+
   static constexpr const char* _type_key = "meta_schedule.RewriteParallelVectorizeUnroll";
   TVM_DECLARE_FINAL_OBJECT_INFO(RewriteParallelVectorizeUnrollNode, PostprocNode);
 };
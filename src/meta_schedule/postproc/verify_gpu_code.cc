@@ -178,6 +178,9 @@ class VerifyGPUCodeNode : public PostprocNode {
           pass_list.push_back(tir::transform::InjectVirtualThread());
           pass_list.push_back(tir::transform::InjectDoubleBuffer());
           pass_list.push_back(tir::transform::StorageRewrite());
+          // The shared memory of a buffer is only reused after a barrier, as in the build.
+          pass_list.push_back(tir::transform::ThreadSync("shared"));
+          pass_list.push_back(tir::transform::ThreadSync("shared.dyn"));
           pass_list.push_back(tir::transform::MergeDynamicSharedMemoryAllocations());
           pass_list.push_back(tir::transform::LowerIntrin());
           // Convert Function to IRModule
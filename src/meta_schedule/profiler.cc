@@ -17,7 +17,12 @@
  * under the License.
  */
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <iomanip>
+#include <thread>
 
+#include "../support/str_escape.h"
 #include "./utils.h"
 
 namespace tvm {
@@ -26,6 +31,7 @@ namespace meta_schedule {
 /**************** Profiler ****************/
 
 Map<String, FloatImm> ProfilerNode::Get() const {
+  std::lock_guard<std::mutex> lock(mutex);
   Map<String, FloatImm> ret;
   for (const auto& kv : stats_sec) {
     ret.Set(kv.first, FloatImm(DataType::Float(64), kv.second));
@@ -33,7 +39,37 @@ Map<String, FloatImm> ProfilerNode::Get() const {
   return ret;
 }
 
+Map<String, Map<String, FloatImm>> ProfilerNode::GetTaskStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Map<String, Map<String, FloatImm>> ret;
+  for (const auto& task : task_stats_sec) {
+    Map<String, FloatImm> stats;
+    for (const auto& kv : task.second) {
+      stats.Set(kv.first, FloatImm(DataType::Float(64), kv.second));
+    }
+    ret.Set(task.first, stats);
+  }
+  return ret;
+}
+
+Map<String, FloatImm> ProfilerNode::GetUtilization() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = stats_sec.find("Total");
+  double total = it != stats_sec.end()
+                     ? it->second
+                     : std::chrono::duration<double>(Clock::now() - start_time).count();
+  Map<String, FloatImm> ret;
+  for (const auto& kv : worker_pools) {
+    const ProfilerWorkerPool& pool = kv.second;
+    double capacity = total * pool.num_workers;
+    double utilization = capacity > 0.0 ? pool.busy_sec / capacity : 0.0;
+    ret.Set(kv.first, FloatImm(DataType::Float(64), utilization));
+  }
+  return ret;
+}
+
 String ProfilerNode::Table() const {
+  std::lock_guard<std::mutex> lock(mutex);
   CHECK(!stats_sec.empty()) << "ValueError: The stats are empty. Please run the profiler first.";
   CHECK(stats_sec.count("Total"))
       << "ValueError: The total time is not recorded. This method should be called only after "
@@ -64,25 +100,84 @@ String ProfilerNode::Table() const {
     }
   }
   p.Separator();
+  if (!worker_pools.empty()) {
+    p.Row() << ""
+            << "Worker pool"
+            << "Busy (min)"
+            << "Utilization";
+    p.Separator();
+    for (const auto& kv : worker_pools) {
+      const ProfilerWorkerPool& pool = kv.second;
+      double capacity = total * pool.num_workers;
+      p.Row() << "" << kv.first << pool.busy_sec / 60.0
+              << (capacity > 0.0 ? pool.busy_sec / capacity * 100.0 : 0.0);
+    }
+    p.Separator();
+  }
   return p.AsStr();
 }
 
+String ProfilerNode::ExportTimeline() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  // Number the threads in the order they first appear
+  std::unordered_map<int64_t, int> thread_ids;
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+  os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const ProfilerEvent& event = events[i];
+    int tid = thread_ids.emplace(event.thread_id, thread_ids.size()).first->second;
+    os << (i == 0 ? "\n" : ",\n")                                     //
+       << "{\"name\": \"" << support::StrEscape(event.name) << "\", "  //
+       << "\"cat\": \"" << support::StrEscape(event.task) << "\", "   //
+       << "\"ph\": \"X\", \"pid\": 0, \"tid\": " << tid << ", "       //
+       << "\"ts\": " << event.start_us << ", \"dur\": " << event.duration_us << "}";
+  }
+  os << "\n], \"otherData\": {\"num_dropped_events\": " << num_dropped_events << "}}";
+  return os.str();
+}
+
+void ProfilerNode::Record(const std::string& name, Clock::time_point start, Clock::time_point end) {
+  double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e9;
+  int64_t thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+  std::lock_guard<std::mutex> lock(mutex);
+  stats_sec[name] += duration;
+  if (!current_task.empty()) {
+    task_stats_sec[current_task][name] += duration;
+  }
+  if (static_cast<int64_t>(events.size()) < kMaxEvents) {
+    double start_us =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(start - start_time).count() / 1e3;
+    events.push_back(ProfilerEvent{name, current_task, thread_id, start_us, duration * 1e6});
+  } else {
+    ++num_dropped_events;
+  }
+}
+
+void ProfilerNode::RecordWorkers(const String& pool, int num_workers, int64_t num_jobs,
+                                 double busy_sec) {
+  std::lock_guard<std::mutex> lock(mutex);
+  ProfilerWorkerPool& stats = worker_pools[pool];
+  stats.num_workers = std::max(stats.num_workers, num_workers);
+  stats.num_jobs += num_jobs;
+  stats.busy_sec += busy_sec;
+}
+
 Profiler::Profiler() {
   ObjectPtr<ProfilerNode> n = make_object<ProfilerNode>();
   n->stats_sec.clear();
+  n->num_dropped_events = 0;
+  n->start_time = ProfilerNode::Clock::now();
   n->total_timer = nullptr;
   data_ = n;
 }
 
 PackedFunc ProfilerTimedScope(String name) {
   if (Optional<Profiler> opt_profiler = Profiler::Current()) {
-    return TypedPackedFunc<void()>([profiler = opt_profiler.value(),                  //
-                                    tik = std::chrono::high_resolution_clock::now(),  //
+    return TypedPackedFunc<void()>([profiler = opt_profiler.value(),  //
+                                    tik = ProfilerNode::Clock::now(),  //
                                     name = std::move(name)]() {
-      auto tok = std::chrono::high_resolution_clock::now();
-      double duration =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(tok - tik).count() / 1e9;
-      profiler->stats_sec[name] += duration;
+      profiler->Record(name, tik, ProfilerNode::Clock::now());
     });
   }
   return nullptr;
@@ -90,6 +185,27 @@ PackedFunc ProfilerTimedScope(String name) {
 
 ScopedTimer Profiler::TimedScope(String name) { return ScopedTimer(ProfilerTimedScope(name)); }
 
+PackedFunc ProfilerTaskScope(String task_name) {
+  if (Optional<Profiler> opt_profiler = Profiler::Current()) {
+    Profiler profiler = opt_profiler.value();
+    std::string prev_task;
+    {
+      std::lock_guard<std::mutex> lock(profiler->mutex);
+      prev_task = std::move(profiler->current_task);
+      profiler->current_task = task_name;
+    }
+    return TypedPackedFunc<void()>([profiler, prev_task = std::move(prev_task)]() {
+      std::lock_guard<std::mutex> lock(profiler->mutex);
+      profiler->current_task = prev_task;
+    });
+  }
+  return nullptr;
+}
+
+ScopedTimer Profiler::TaskScope(String task_name) {
+  return ScopedTimer(ProfilerTaskScope(task_name));
+}
+
 /**************** Context Manager ****************/
 
 std::vector<Profiler>* ThreadLocalProfilers() {
@@ -97,13 +213,43 @@ std::vector<Profiler>* ThreadLocalProfilers() {
   return &profilers;
 }
 
+/*! \brief The profilers entered on all threads, which threads without their own profiler use */
+struct GlobalProfilers {
+  std::mutex mutex;
+  std::vector<Profiler> profilers;
+  /*! \brief The size of `profilers`, checked without locking when no profiler is entered */
+  std::atomic<int> num_profilers{0};
+
+  static GlobalProfilers* Get() {
+    static GlobalProfilers inst;
+    return &inst;
+  }
+};
+
 void Profiler::EnterWithScope() {
   ThreadLocalProfilers()->push_back(*this);
+  GlobalProfilers* global = GlobalProfilers::Get();
+  {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    global->profilers.push_back(*this);
+    global->num_profilers = global->profilers.size();
+  }
   (*this)->total_timer = ProfilerTimedScope("Total");
 }
 
 void Profiler::ExitWithScope() {
   ThreadLocalProfilers()->pop_back();
+  GlobalProfilers* global = GlobalProfilers::Get();
+  {
+    std::lock_guard<std::mutex> lock(global->mutex);
+    std::vector<Profiler>& profilers = global->profilers;
+    auto it = std::find_if(profilers.rbegin(), profilers.rend(),
+                           [this](const Profiler& profiler) { return profiler.same_as(*this); });
+    if (it != profilers.rend()) {
+      profilers.erase(std::next(it).base());
+    }
+    global->num_profilers = profilers.size();
+  }
   if ((*this)->total_timer != nullptr) {
     (*this)->total_timer();
     (*this)->total_timer = nullptr;
@@ -112,11 +258,18 @@ void Profiler::ExitWithScope() {
 
 Optional<Profiler> Profiler::Current() {
   std::vector<Profiler>* profilers = ThreadLocalProfilers();
-  if (profilers->empty()) {
-    return NullOpt;
-  } else {
+  if (!profilers->empty()) {
     return profilers->back();
   }
+  GlobalProfilers* global = GlobalProfilers::Get();
+  if (global->num_profilers == 0) {
+    return NullOpt;
+  }
+  std::lock_guard<std::mutex> lock(global->mutex);
+  if (global->profilers.empty()) {
+    return NullOpt;
+  }
+  return global->profilers.back();
 }
 
 TVM_REGISTER_NODE_TYPE(ProfilerNode);
@@ -129,8 +282,21 @@ TVM_REGISTER_GLOBAL("meta_schedule.ProfilerExitWithScope")
     .set_body_method(&Profiler::ExitWithScope);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerCurrent").set_body_typed(Profiler::Current);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerGet").set_body_method<Profiler>(&ProfilerNode::Get);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerGetTaskStats")
+    .set_body_method<Profiler>(&ProfilerNode::GetTaskStats);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerGetUtilization")
+    .set_body_method<Profiler>(&ProfilerNode::GetUtilization);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerTable").set_body_method<Profiler>(&ProfilerNode::Table);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerExportTimeline")
+    .set_body_method<Profiler>(&ProfilerNode::ExportTimeline);
 TVM_REGISTER_GLOBAL("meta_schedule.ProfilerTimedScope").set_body_typed(ProfilerTimedScope);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerTaskScope").set_body_typed(ProfilerTaskScope);
+TVM_REGISTER_GLOBAL("meta_schedule.ProfilerRecordWorkers")
+    .set_body_typed([](String pool, int num_workers, int64_t num_jobs, double busy_sec) {
+      if (Optional<Profiler> profiler = Profiler::Current()) {
+        profiler.value()->RecordWorkers(pool, num_workers, num_jobs, busy_sec);
+      }
+    });
 
 }  // namespace meta_schedule
 }  // namespace tvm
@@ -32,6 +32,19 @@ RunnerInput::RunnerInput(String artifact_path, String device_type, Array<ArgInfo
 RunnerResult::RunnerResult(Optional<Array<FloatImm>> run_secs, Optional<String> error_msg) {
   ObjectPtr<RunnerResultNode> n = make_object<RunnerResultNode>();
   n->run_secs = run_secs;
+  if (run_secs.defined() && run_secs.value().size() >= 2) {
+    double mean = 0.0;
+    for (const FloatImm& sec : run_secs.value()) {
+      mean += sec->value;
+    }
+    mean /= run_secs.value().size();
+    double var = 0.0;
+    for (const FloatImm& sec : run_secs.value()) {
+      var += (sec->value - mean) * (sec->value - mean);
+    }
+    var /= run_secs.value().size() - 1;
+    n->run_sec_var = FloatImm(DataType::Float(64), var);
+  }
   n->error_msg = error_msg;
   this->data_ = n;
 }
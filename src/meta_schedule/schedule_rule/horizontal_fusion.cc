@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+/*!
+ * \brief Check if a loop is the root of a loop nest that can be fused horizontally, i.e. a chain
+ * of single-child loops around a single block, and count its leading spatial loops
+ * \param loop_sref The sref to the outermost loop of the nest
+ * \param block_sref The sref to the block under the nest, if it is a candidate
+ * \return The number of leading spatial loops, 0 if the nest is not a candidate
+ */
+int NumHorizontalFusibleLoops(const ScheduleState& self, const StmtSRef& loop_sref,
+                              StmtSRef* block_sref) {
+  int n_spatial = 0;
+  bool in_prefix = true;
+  const StmtNode* stmt = loop_sref->stmt;
+  while (const auto* loop = stmt->as<ForNode>()) {
+    if (!loop->annotations.empty() || loop->thread_binding.defined()) {
+      return 0;
+    }
+    if (in_prefix && is_zero(loop->min) &&
+        GetLoopIterType(self->stmt2ref.at(loop)) == IterVarType::kDataPar) {
+      ++n_spatial;
+    } else {
+      in_prefix = false;
+    }
+    stmt = loop->body.get();
+  }
+  const auto* realize = stmt->as<BlockRealizeNode>();
+  if (realize == nullptr) {
+    return 0;
+  }
+  *block_sref = self->stmt2ref.at(realize->block.get());
+  return n_spatial;
+}
+
+}  // namespace tir
+}  // namespace tvm
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief Fuse the loop nests of independent sibling blocks under the root block horizontally, so
+ * that they are launched as a single kernel. The spatial loops leading each nest are fused first,
+ * and the fused loops are then fused horizontally.
+ */
+class HorizontalFusionNode : public ScheduleRuleNode {
+ public:
+  // Inherited from ScheduleRuleNode
+  void InitializeWithTuneContext(const TuneContext& context) final {}
+
+  // Inherited from ScheduleRuleNode
+  Array<tir::Schedule> Apply(const tir::Schedule& sch, const tir::BlockRV& block_rv) final {
+    using tir::StmtSRef;
+    const tir::ScheduleState& self = sch->state();
+    // Step 1. Find the loop nest of the block, whose outermost loop is under the root block
+    Array<tir::LoopRV> loop_rvs = sch->GetLoops(block_rv);
+    if (loop_rvs.empty()) {
+      return {sch};
+    }
+    StmtSRef loop_sref = sch->GetSRef(loop_rvs[0]);
+    const tir::StmtSRefNode* root_sref = loop_sref->parent;
+    if (root_sref == nullptr || root_sref->parent != nullptr) {
+      return {sch};
+    }
+    const auto* seq = TVM_SREF_TO_BLOCK(GetRef<StmtSRef>(root_sref))->body.as<tir::SeqStmtNode>();
+    if (seq == nullptr) {
+      return {sch};
+    }
+    // Step 2. Collect the run of consecutive candidate nests around it
+    std::vector<StmtSRef> block_srefs;
+    std::vector<int> n_spatial;
+    int self_index = -1;
+    for (const tir::Stmt& stmt : seq->seq) {
+      StmtSRef block_sref{nullptr};
+      int n = 0;
+      if (const auto* loop = stmt.as<tir::ForNode>()) {
+        n = tir::NumHorizontalFusibleLoops(self, self->stmt2ref.at(loop), &block_sref);
+      }
+      if (n == 0) {
+        if (self_index != -1) {
+          break;
+        }
+        block_srefs.clear();
+        n_spatial.clear();
+        continue;
+      }
+      if (stmt.get() == loop_sref->stmt) {
+        self_index = block_srefs.size();
+      }
+      block_srefs.push_back(block_sref);
+      n_spatial.push_back(n);
+    }
+    if (self_index == -1) {
+      return {sch};
+    }
+    // Step 3. Partition the run greedily into groups of independent nests, and take the group
+    // containing the block
+    tir::BlockScope scope = self->GetBlockScope(GetRef<StmtSRef>(root_sref));
+    int begin = 0;
+    int end = 1;
+    for (int n = block_srefs.size(); end < n; ++end) {
+      bool independent = true;
+      for (int i = begin; i < end && independent; ++i) {
+        for (const tir::Dependency& dep : scope->GetDepsBySrc(block_srefs[i])) {
+          if (dep->dst.same_as(block_srefs[end])) {
+            independent = false;
+            break;
+          }
+        }
+      }
+      if (!independent) {
+        if (end > self_index) {
+          break;
+        }
+        begin = end;
+      }
+    }
+    if (end - begin < 2) {
+      return {sch};
+    }
+    // Step 4. Fuse the leading spatial loops of each nest, and then fuse the nests horizontally
+    tir::Schedule new_sch = sch->Copy();
+    try {
+      Array<tir::LoopRV> fused;
+      for (int i = begin; i < end; ++i) {
+        const tir::BlockNode* block = TVM_SREF_TO_BLOCK(block_srefs[i]);
+        Array<tir::LoopRV> loops = new_sch->GetLoops(new_sch->GetBlock(block->name_hint));
+        if (n_spatial[i] == 1) {
+          fused.push_back(loops[0]);
+        } else {
+          Array<tir::LoopRV> spatial_loops{loops.begin(), loops.begin() + n_spatial[i]};
+          fused.push_back(new_sch->Fuse(spatial_loops, /*preserve_unit_iters=*/true));
+        }
+      }
+      new_sch->HorizontalFuse(fused);
+    } catch (const tvm::runtime::Error& e) {
+      return {sch};
+    }
+    return {new_sch};
+  }
+
+  // Inherited from ScheduleRuleNode
+  ScheduleRule Clone() const final {
+    ObjectPtr<HorizontalFusionNode> n = make_object<HorizontalFusionNode>(*this);
+    return ScheduleRule(n);
+  }
+
+ public:
+  void VisitAttrs(tvm::AttrVisitor* v) {}
+
+  static constexpr const char* _type_key = "meta_schedule.HorizontalFusion";
+  TVM_DECLARE_FINAL_OBJECT_INFO(HorizontalFusionNode, ScheduleRuleNode);
+};
+
+ScheduleRule ScheduleRule::HorizontalFusion() {
+  ObjectPtr<HorizontalFusionNode> n = make_object<HorizontalFusionNode>();
+  return ScheduleRule(n);
+}
+
+TVM_REGISTER_NODE_TYPE(HorizontalFusionNode);
+TVM_REGISTER_GLOBAL("meta_schedule.ScheduleRuleHorizontalFusion")
+    .set_body_typed(ScheduleRule::HorizontalFusion);
+
+}  // namespace meta_schedule
+}  // namespace tvm
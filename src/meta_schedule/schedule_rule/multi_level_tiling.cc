@@ -21,6 +21,9 @@
 #include <tvm/meta_schedule/schedule_rule.h>
 
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -43,6 +46,62 @@ std::vector<int> GetReadBufferNDims(const StmtSRef& block_sref) {
   return results;
 }
 
+int64_t EstimateTileFootprint(const ScheduleState& self, const StmtSRef& block_sref,
+                              const StmtSRef& loop_sref, const runtime::StorageScope& scope,
+                              bool reads_only) {
+  const BlockNode* block = TVM_SREF_TO_BLOCK(block_sref);
+  Map<Var, PrimExpr> bindings = GetBindings(GetBlockRealize(self, block_sref));
+  Map<Var, arith::IntSet> relaxed = arith::AsIntSet(
+      LoopDomainOfSRefTreePath(GetRef<StmtSRef>(block_sref->parent), loop_sref, scope));
+  // The loops that are not relaxed bound the extents of the regions
+  arith::Analyzer analyzer;
+  for (const StmtSRefNode* p = block_sref->parent; p != nullptr; p = p->parent) {
+    if (const auto* loop = p->StmtAs<ForNode>()) {
+      analyzer.Bind(loop->loop_var, Range::FromMinExtent(loop->min, loop->extent));
+    }
+  }
+  std::unordered_set<const BufferNode*> written;
+  if (reads_only) {
+    for (const BufferRegion& region : block->writes) {
+      written.insert(region->buffer.get());
+    }
+  }
+  std::unordered_map<const BufferNode*, int64_t> buffer_bytes;
+  for (const Array<BufferRegion>& regions : {block->reads, block->writes}) {
+    for (const BufferRegion& region : regions) {
+      const BufferNode* buffer = region->buffer.get();
+      if (reads_only && written.count(buffer)) {
+        continue;
+      }
+      int64_t bytes = (buffer->dtype.bits() * buffer->dtype.lanes() + 7) / 8;
+      for (int i = 0, n = region->region.size(); i < n; ++i) {
+        const Range& range = region->region[i];
+        arith::IntSet lo = arith::EvalSet(Substitute(range->min, bindings), relaxed);
+        arith::IntSet hi =
+            arith::EvalSet(Substitute(range->min + range->extent - 1, bindings), relaxed);
+        if (!lo.HasLowerBound() || !hi.HasUpperBound()) {
+          return -1;
+        }
+        int64_t extent = analyzer.const_int_bound(hi.max() - lo.min() + 1)->max_value;
+        if (extent == arith::ConstIntBound::kPosInf) {
+          return -1;
+        }
+        if (const auto* dim = buffer->shape[i].as<IntImmNode>()) {
+          extent = std::min(extent, dim->value);
+        }
+        bytes *= std::max<int64_t>(extent, 1);
+      }
+      int64_t& max_bytes = buffer_bytes[buffer];
+      max_bytes = std::max(max_bytes, bytes);
+    }
+  }
+  int64_t result = 0;
+  for (const auto& kv : buffer_bytes) {
+    result += kv.second;
+  }
+  return result;
+}
+
 }  // namespace tir
 }  // namespace tvm
 
@@ -91,12 +150,17 @@ void MultiLevelTilingNode::InitializeWithTuneContext(const TuneContext& context)
           // is theoretically feasible, but no guarantee for great performance.
           this->stages = {4, 5};
         }
+        // the mbarrier waits of the warp-specialized pipeline require sm_90
+        this->warp_specialize = std::stoi(sm) >= 90;
       } catch (const std::invalid_argument& e) {
         LOG(WARNING) << "ValueError: Unable to parse `target.arch`: " << sm
                      << ". Details: " << e.what();
       }
     }
   }
+  if (Optional<Integer> v = context->target.value()->GetAttr<Integer>("l1-cache-size")) {
+    this->l1_cache_bytes_ = v.value()->value;
+  }
   logger = context->logger;
 }
 
@@ -184,7 +248,7 @@ std::pair<Array<tir::ExprRV>, Array<tir::LoopRV>> MultiLevelTilingNode::SplitLoo
   Array<tir::ExprRV> factors = sch->SamplePerfectTile(
       /*loop=*/loop,
       /*n=*/n_tiles,
-      /*max_innermost_factor=*/max_innermost_factor);
+      /*max_innermost_factor=*/MaxInnermostFactor(sch, block));
   Array<tir::LoopRV> splits = sch->Split(/*loop=*/loop,
                                          /*factors=*/{factors.begin(), factors.end()});
   return {factors, splits};
@@ -331,6 +395,20 @@ std::vector<State> MultiLevelTilingNode::AddAsyncPipeline(State state) const {
                              Array<Integer>{0});
     ret.push_back(std::move(new_state));
   }
+  if (this->warp_specialize) {
+    // The producer warps fill as many slots as the async pipeline keeps versions of the buffers.
+    for (int stage : this->stages) {
+      State new_state = state->Copy();
+      LoopRV r_loop_fused = new_state->sch->Fuse(new_state->tiles[r_indices_[0]]);
+      new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_stage,
+                               Array<Integer>{0, 0, 1});
+      new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_order,
+                               Array<Integer>{0, 1, 2});
+      new_state->sch->Annotate(r_loop_fused, tir::attr::software_pipeline_warp_specialize,
+                               Integer(stage - 1));
+      ret.push_back(std::move(new_state));
+    }
+  }
   return ret;
 }
 
@@ -369,6 +447,170 @@ void MultiLevelTilingNode::AnnotateCooperativeFetching(Schedule* sch,
   }
 }
 
+int MultiLevelTilingNode::MaxInnermostFactor(const Schedule& sch,
+                                             const tir::BlockRV& block_rv) const {
+  if (l1_cache_bytes_ <= 0) {
+    return max_innermost_factor;
+  }
+  // The bytes of an element of each buffer, and the number of block vars indexing it
+  const tir::BlockNode* block = TVM_SREF_TO_BLOCK(sch->GetSRef(block_rv));
+  std::vector<std::pair<int64_t, int>> buffers;
+  std::unordered_set<const tir::BufferNode*> visited;
+  for (const Array<tir::BufferRegion>& regions : {block->reads, block->writes}) {
+    for (const tir::BufferRegion& region : regions) {
+      const tir::BufferNode* buffer = region->buffer.get();
+      if (!visited.insert(buffer).second) {
+        continue;
+      }
+      int n_vars = 0;
+      for (const tir::IterVar& iter_var : block->iter_vars) {
+        for (const Range& range : region->region) {
+          if (tir::UsesVar(range->min, [&](const tir::VarNode* v) {
+                return v == iter_var->var.get();
+              })) {
+            ++n_vars;
+            break;
+          }
+        }
+      }
+      buffers.emplace_back((buffer->dtype.bits() * buffer->dtype.lanes() + 7) / 8, n_vars);
+    }
+  }
+  // With every innermost factor at most `factor`, the innermost tile occupies at most
+  // sum(bytes * factor ^ n_vars) bytes. Find the largest factor that fits in L1.
+  auto f_fits = [&](int factor) -> bool {
+    double total = 0.0;
+    for (const auto& [bytes, n_vars] : buffers) {
+      total += bytes * std::pow(static_cast<double>(factor), n_vars);
+    }
+    return total <= l1_cache_bytes_;
+  };
+  constexpr int kMaxFactor = 1 << 16;
+  int lo = 1;
+  int hi = max_innermost_factor == -1 ? kMaxFactor : max_innermost_factor;
+  if (f_fits(hi)) {
+    return max_innermost_factor;
+  }
+  while (lo + 1 < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (f_fits(mid)) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+std::unique_ptr<TileFootprintChecker> TileFootprintChecker::Create(const Target& target) {
+  std::unique_ptr<TileFootprintChecker> checker(new TileFootprintChecker());
+  if (IsGPUTarget(target->kind->name)) {
+    if (Optional<Integer> v = target->GetAttr<Integer>("max_shared_memory_per_block")) {
+      checker->max_shared_memory_per_block_ = v.value()->value;
+    }
+  } else {
+    if (Optional<Integer> v = target->GetAttr<Integer>("l1-cache-size")) {
+      checker->l1_cache_bytes_ = v.value()->value;
+    }
+    if (Optional<Integer> v = target->GetAttr<Integer>("l2-cache-size")) {
+      checker->l2_cache_bytes_ = v.value()->value;
+    }
+  }
+  if (checker->l1_cache_bytes_ <= 0 && checker->l2_cache_bytes_ <= 0 &&
+      checker->max_shared_memory_per_block_ <= 0) {
+    return nullptr;
+  }
+  return checker;
+}
+
+bool TileFootprintChecker::Check(const Schedule& sch) const {
+  const tir::ScheduleState& self = sch->state();
+  bool valid = true;
+  for (const auto& kv : sch->mod()->functions) {
+    const auto* func = kv.second.as<tir::PrimFuncNode>();
+    if (func == nullptr) {
+      continue;
+    }
+    tir::PreOrderVisit(func->body, [&](const ObjectRef& obj) -> bool {
+      if (!valid) {
+        return false;
+      }
+      if (const auto* block = obj.as<tir::BlockNode>()) {
+        if (Optional<String> structure =
+                tir::GetAnn<String>(block, tir::attr::meta_schedule_tiling_structure)) {
+          valid = CheckBlock(self, self->stmt2ref.at(block), structure.value());
+        }
+      }
+      return true;
+    });
+    if (!valid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TileFootprintChecker::CheckBlock(const tir::ScheduleState& self,
+                                      const tir::StmtSRef& block_sref,
+                                      const String& structure) const {
+  // Step 1. Count the spatial and reduction block vars, which are tiled
+  int n_spatial = 0;
+  int n_reduce = 0;
+  for (IterVarType iter_type : tir::GetBlockVarTypes(block_sref)) {
+    if (iter_type == IterVarType::kDataPar) {
+      ++n_spatial;
+    } else if (iter_type == IterVarType::kCommReduce) {
+      ++n_reduce;
+    } else {
+      return true;
+    }
+  }
+  // Step 2. Find the innermost loop of each level. A level has a loop per block var, or a single
+  // loop if it is fused and bound to a thread axis.
+  Array<tir::StmtSRef> loops = tir::GetLoops(block_sref);
+  std::vector<int> level_ends;
+  int first_reduce = -1;
+  int last_reduce = -1;
+  int n_loops = 0;
+  for (int i = 0, n = structure.size(); i < n; ++i) {
+    char c = structure.data()[i];
+    int n_level_loops = c == 'S' ? n_spatial : n_reduce;
+    if (c == 'R') {
+      first_reduce = first_reduce == -1 ? i : first_reduce;
+      last_reduce = i;
+    }
+    if (n_level_loops > 0 && n_loops < static_cast<int>(loops.size()) &&
+        TVM_SREF_TO_FOR(loops[n_loops])->kind == tir::ForKind::kThreadBinding) {
+      n_level_loops = 1;
+    }
+    n_loops += n_level_loops;
+    level_ends.push_back(n_loops - 1);
+  }
+  if (n_loops != static_cast<int>(loops.size()) || n_reduce == 0 || first_reduce == -1) {
+    // The loop nest is changed after tiling, or there is no reuse to check
+    return true;
+  }
+  // Step 3. Check the working set of each level against its cache
+  auto f_fits = [&](int level, int64_t capacity, const char* scope, bool reads_only) -> bool {
+    if (capacity <= 0 || level < 0 || level_ends[level] < 0) {
+      return true;
+    }
+    int64_t footprint = tir::EstimateTileFootprint(self, block_sref, loops[level_ends[level]],
+                                                   runtime::StorageScope::Create(scope),
+                                                   reads_only);
+    return footprint <= capacity;
+  };
+  return f_fits(last_reduce - 1, l1_cache_bytes_, "global", /*reads_only=*/false) &&
+         f_fits(first_reduce - 1, l2_cache_bytes_, "global", /*reads_only=*/false) &&
+         f_fits(first_reduce, max_shared_memory_per_block_, "shared", /*reads_only=*/true);
+}
+
+TVM_REGISTER_GLOBAL("meta_schedule.CheckTileFootprint")
+    .set_body_typed([](Target target, Schedule sch) -> bool {
+      std::unique_ptr<TileFootprintChecker> checker = TileFootprintChecker::Create(target);
+      return checker == nullptr || checker->Check(sch);
+    });
+
 // Constructor
 
 ScheduleRule ScheduleRule::MultiLevelTiling(String structure, Optional<Array<String>> tile_binds,
@@ -20,12 +20,15 @@
 #define TVM_META_SCHEDULE_SCHEDULE_RULE_MULTI_LEVEL_TILING_H_
 
 #include <tvm/meta_schedule/schedule_rule.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/schedule/schedule.h>
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "../../runtime/thread_storage_scope.h"
 #include "../../support/array.h"
 
 namespace tvm {
@@ -40,6 +43,21 @@ namespace tir {
  */
 std::vector<int> GetReadBufferNDims(const StmtSRef& block_sref);
 
+/*!
+ * \brief Estimate the bytes of the buffer regions a block accesses in one iteration of a loop
+ * around it, i.e. with the loops under the loop relaxed
+ * \param self The schedule state
+ * \param block_sref The block to be processed
+ * \param loop_sref The loop around the block
+ * \param scope The storage scope of the working set. If it is not global, the thread bindings
+ * sharing the storage are relaxed as well
+ * \param reads_only Whether only the buffers read but not written by the block are counted
+ * \return The bytes estimated, or -1 if they cannot be bounded
+ */
+int64_t EstimateTileFootprint(const ScheduleState& self, const StmtSRef& block_sref,
+                              const StmtSRef& loop_sref, const runtime::StorageScope& scope,
+                              bool reads_only);
+
 }  // namespace tir
 }  // namespace tvm
 
@@ -188,6 +206,9 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
   // Annotate a block to use cooperative fetching
   void AnnotateCooperativeFetching(tir::Schedule* sch, const tir::BlockRV& block) const;
 
+  // The maximum innermost factor of the tiles of a block, so that its innermost tile fits in L1
+  int MaxInnermostFactor(const tir::Schedule& sch, const tir::BlockRV& block_rv) const;
+
  public:
   /*!
    * \brief The tiling structure. Recommended:
@@ -215,6 +236,10 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
   int max_threads_per_block_;
   /*! \brief All available async pipeline stages. */
   std::vector<int> stages;
+  /*! \brief Whether to also try the warp-specialized pipeline of each number of stages. */
+  bool warp_specialize = false;
+  /*! \brief The size of the L1 cache in bytes, -1 if unknown */
+  int64_t l1_cache_bytes_;
   /*! \brief The logging function */
   PackedFunc logger;
   /*! \brief The function to overwrite the default condition for applying MultiLevelTiling. */
@@ -231,6 +256,7 @@ class MultiLevelTilingNode : public ScheduleRuleNode {
     // `r_indices_` is not visited
     // `thread_warp_size_` is not visited
     // `max_threads_per_block` is not visited
+    // `l1_cache_bytes_` is not visited
   }
 
   static constexpr const char* _type_key = "meta_schedule.MultiLevelTiling";
@@ -264,9 +290,49 @@ ObjectPtr<NodeType> MultiLevelTilingInitCommon(String structure, Optional<Array<
   }
   n->thread_warp_size_ = -1;
   n->max_threads_per_block_ = -1;
+  n->l1_cache_bytes_ = -1;
   return n;
 }
 
+/*!
+ * \brief A check of the working sets of the blocks tiled by MultiLevelTiling against the cache
+ * capacities of a target, which rejects the candidates whose tiles obviously overflow the caches.
+ * The working set of a tile level is the bytes of the buffer regions a block accesses in one
+ * iteration of the innermost loop of the level:
+ * - on CPU, the tiles under the last reduction level must fit in L1, and the tiles under the
+ *   first reduction level in L2, as given by the `l1-cache-size` and `l2-cache-size` attributes;
+ * - on GPU, the tiles read in one iteration of the first reduction level, which the threads of a
+ *   block share, must fit in `max_shared_memory_per_block`.
+ */
+class TileFootprintChecker {
+ public:
+  /*!
+   * \brief Create the checker of a target.
+   * \param target The target.
+   * \return The checker created, or nullptr if the target describes no cache capacity.
+   */
+  static std::unique_ptr<TileFootprintChecker> Create(const Target& target);
+
+  /*!
+   * \brief Check if the tiles of a schedule fit in the caches.
+   * \param sch The schedule, before postprocessing.
+   * \return False if a working set surely overflows its cache, true otherwise.
+   */
+  bool Check(const tir::Schedule& sch) const;
+
+ private:
+  /*! \brief Check the tiles of a block annotated with its tiling structure. */
+  bool CheckBlock(const tir::ScheduleState& self, const tir::StmtSRef& block_sref,
+                  const String& structure) const;
+
+  /*! \brief The size of the L1 cache in bytes, -1 if unknown. */
+  int64_t l1_cache_bytes_ = -1;
+  /*! \brief The size of the L2 cache in bytes, -1 if unknown. */
+  int64_t l2_cache_bytes_ = -1;
+  /*! \brief The maximum bytes of shared memory per block, -1 if unknown. */
+  int64_t max_shared_memory_per_block_ = -1;
+};
+
 }  // namespace meta_schedule
 }  // namespace tvm
 
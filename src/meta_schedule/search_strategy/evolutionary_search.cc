@@ -17,7 +17,12 @@
  * under the License.
  */
 
+#include <limits>
+
 #include "../module_equality.h"
+#include "../schedule_rule/multi_level_tiling.h"
+#include "../static_validity.h"
+#include "../trace_apply.h"
 #include "../utils.h"
 
 #define TVM_META_SCHEDULE_CHECK_PROB_RANGE(p, name)                               \
@@ -273,6 +278,22 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     CostModel cost_model_{nullptr};
     /*! \brief The token registered for the given workload in database. */
     Workload token_{nullptr};
+    /*! \brief The traces transferred from similar workloads in the database, nearest first. */
+    std::vector<tir::Trace> transferred_traces_;
+    /*! \brief Whether the traces are already transferred from similar workloads. */
+    bool is_transferred_ = false;
+    /*! \brief The checker rejecting invalid schedules before postprocessing, nullptr if none. */
+    std::unique_ptr<StaticValidityChecker> validity_checker_;
+    /*! \brief The checker rejecting tiles overflowing the caches, nullptr if none. */
+    std::unique_ptr<TileFootprintChecker> footprint_checker_;
+    /*! \brief The schedules rejected by the checker, fed to the cost model as negative samples. */
+    std::vector<Schedule> rejected_;
+    /*! \brief The mutex guarding `rejected_`. */
+    std::mutex rejected_mutex_;
+    /*! \brief The mutex guarding the cost model queried by the guided mutators. */
+    std::mutex predict_mutex_;
+    /*! \brief The cache of trace prefixes, so that the mutated traces resume from their parents. */
+    std::unique_ptr<TracePrefixCache> prefix_cache_;
 
     explicit State(EvolutionarySearchNode* self, int max_trials, int num_trials_per_iter,
                    Array<Schedule> design_space_schedules, Database database, CostModel cost_model)
@@ -297,6 +318,33 @@ class EvolutionarySearchNode : public SearchStrategyNode {
       this->database_ = database;
       this->cost_model_ = cost_model;
       this->token_ = database->CommitWorkload(mod);
+      if (ctx->target.defined()) {
+        this->validity_checker_ = StaticValidityChecker::Create(ctx->target.value());
+        this->footprint_checker_ = TileFootprintChecker::Create(ctx->target.value());
+      }
+      // Each replay caches a prefix per decision after the point it resumes from, so the capacity
+      // is a few prefixes for each trace of the population
+      this->prefix_cache_ = std::make_unique<TracePrefixCache>(self->population_size * 4);
+    }
+
+    /*!
+     * \brief Create the check of the schedules before postprocessing, which records the schedules
+     * rejected by the tile footprint checker or the static validity checker.
+     * \return The check created, or nullptr if there is no checker for the target.
+     */
+    ThreadedTraceApply::FPrecheck MakePrecheck() {
+      if (validity_checker_ == nullptr && footprint_checker_ == nullptr) {
+        return nullptr;
+      }
+      return [this](const Schedule& sch) -> bool {
+        if ((footprint_checker_ == nullptr || footprint_checker_->Check(sch)) &&
+            (validity_checker_ == nullptr || validity_checker_->Check(sch->mod()))) {
+          return true;
+        }
+        std::lock_guard<std::mutex> lock(rejected_mutex_);
+        rejected_.push_back(sch);
+        return false;
+      };
     }
 
     /*!
@@ -305,6 +353,18 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      * \return The picked best candidates.
      */
     inline std::vector<Schedule> PickBestFromDatabase(int num);
+    /*!
+     * \brief Transfer the best traces of the nearest workloads of the same operator family in the
+     * database onto the design spaces, adapting the tile sizes to the workload being tuned.
+     * \return The traces transferred, nearest first.
+     */
+    inline std::vector<tir::Trace> TransferFromSimilarWorkloads();
+    /*!
+     * \brief Pick up candidates transferred from similar workloads in the database.
+     * \param num The number of traces to produce.
+     * \return The picked candidates.
+     */
+    inline std::vector<Schedule> PickTransferred(int num);
     /*!
      * \brief Sample the initial population from previous measured results and randomly generated
      *  traces via trace replaying.
@@ -328,6 +388,12 @@ class EvolutionarySearchNode : public SearchStrategyNode {
      */
     inline std::vector<Schedule> PickWithEpsGreedy(const std::vector<Schedule>& inits,
                                                    const std::vector<Schedule>& bests, int num);
+    /*!
+     * \brief Feed the schedules rejected by the static checks to the cost model as
+     * negative samples, and clear them.
+     * \param num The maximum number of schedules to feed.
+     */
+    inline void UpdateCostModelWithRejected(int num);
     /*! \brief An interface method to be called by it's counterpart in EvolutionarySearchNode */
     inline Optional<Array<MeasureCandidate>> GenerateMeasureCandidates();
     /*! \brief An interface method to be called by it's counterpart in EvolutionarySearchNode */
@@ -377,6 +443,9 @@ class EvolutionarySearchNode : public SearchStrategyNode {
   /*** Configuration: pick states for measurement ***/
   /*! \brief The ratio of measurements to use randomly sampled states. */
   double eps_greedy;
+  /*** Configuration: warm start ***/
+  /*! \brief The number of similar workloads whose best traces seed the initial population. */
+  int warm_start_num_workloads;
 
   void VisitAttrs(tvm::AttrVisitor* v) {
     // `context_` is not visited
@@ -396,6 +465,8 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     v->Visit("genetic_max_fail_count", &genetic_max_fail_count);
     /*** Configuration: pick states for measurement ***/
     v->Visit("eps_greedy", &eps_greedy);
+    /*** Configuration: warm start ***/
+    v->Visit("warm_start_num_workloads", &warm_start_num_workloads);
   }
 
   static constexpr const char* _type_key = "meta_schedule.EvolutionarySearch";
@@ -464,6 +535,7 @@ class EvolutionarySearchNode : public SearchStrategyNode {
     n->genetic_mutate_prob = this->genetic_mutate_prob;
     n->genetic_max_fail_count = this->genetic_max_fail_count;
     n->eps_greedy = this->eps_greedy;
+    n->warm_start_num_workloads = this->warm_start_num_workloads;
     n->ctx_ = this->ctx_;
     n->rand_state_ = this->rand_state_;
     n->state_ = nullptr;  // cleared the state
@@ -480,7 +552,7 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
     measured_traces.push_back(record->trace);
   }
   int actual_num = measured_traces.size();
-  ThreadedTraceApply pp(self->postprocs_);
+  ThreadedTraceApply pp(self->postprocs_, /*precheck=*/nullptr, prefix_cache_.get());
   std::vector<Schedule> results(actual_num, Schedule{nullptr});
   auto f_proc_measured = [this, &measured_traces, &results, &pp](int thread_id,
                                                                  int trace_id) -> void {
@@ -501,9 +573,96 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickBestFromDatabase(int nu
   return results;
 }
 
+std::vector<tir::Trace> EvolutionarySearchNode::State::TransferFromSimilarWorkloads() {
+  auto _ = Profiler::TimedScope("EvoSearch/TransferFromSimilarWorkloads");
+  const ModuleEquality& module_equality = database_->GetModuleEquality();
+  const IRModule& mod = per_thread_data_.at(0).mod;
+  // Step 1. Group the measured records by workload, except the one being tuned
+  std::unordered_map<Workload, std::vector<std::pair<double, tir::Trace>>, ObjectPtrHash,
+                     ObjectPtrEqual>
+      records;
+  for (const TuningRecord& record : database_->GetAllTuningRecords()) {
+    if (!record->run_secs.defined() || record->run_secs.value().empty()) {
+      continue;
+    }
+    double sum = 0.0;
+    for (const FloatImm& run_sec : record->run_secs.value()) {
+      sum += run_sec->value;
+    }
+    records[record->workload].emplace_back(sum / record->run_secs.value().size(), record->trace);
+  }
+  // Step 2. Transfer the best record of each workload to find the nearest workloads
+  struct Candidate {
+    double distance;
+    int design_space_index;
+    std::vector<std::pair<double, tir::Trace>>* records;
+  };
+  std::vector<Candidate> candidates;
+  for (auto& kv : records) {
+    const Workload& workload = kv.first;
+    std::vector<std::pair<double, tir::Trace>>& workload_records = kv.second;
+    if (workload.same_as(token_) || module_equality.Equal(workload->mod, token_->mod)) {
+      continue;
+    }
+    std::sort(workload_records.begin(), workload_records.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (int i = 0, n = design_spaces.size(); i < n; ++i) {
+      double distance = 0.0;
+      if (TransferTrace(mod, design_spaces[i], workload_records[0].second, &distance).defined()) {
+        candidates.push_back(Candidate{distance, i, &workload_records});
+        break;
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+  if (static_cast<int>(candidates.size()) > self->warm_start_num_workloads) {
+    candidates.resize(self->warm_start_num_workloads);
+  }
+  // Step 3. Transfer the best records of the nearest workloads
+  int max_per_workload = self->population_size * self->init_measured_ratio;
+  std::vector<tir::Trace> results;
+  for (const Candidate& candidate : candidates) {
+    int n = std::min<int>(candidate.records->size(), max_per_workload);
+    for (int i = 0; i < n; ++i) {
+      double distance = 0.0;
+      if (Optional<tir::Trace> trace =
+              TransferTrace(mod, design_spaces[candidate.design_space_index],
+                            candidate.records->at(i).second, &distance)) {
+        results.push_back(trace.value());
+      }
+    }
+  }
+  TVM_PY_LOG(INFO, self->ctx_->logger)
+      << "Transferred " << results.size() << " trace(s) from " << candidates.size()
+      << " similar workload(s) in the database";
+  return results;
+}
+
+std::vector<Schedule> EvolutionarySearchNode::State::PickTransferred(int num) {
+  auto _ = Profiler::TimedScope("EvoSearch/PickTransferred");
+  if (!is_transferred_) {
+    transferred_traces_ = TransferFromSimilarWorkloads();
+    is_transferred_ = true;
+  }
+  int actual_num = std::min<int>(num, transferred_traces_.size());
+  ThreadedTraceApply pp(self->postprocs_, /*precheck=*/nullptr, prefix_cache_.get());
+  std::vector<Schedule> results(actual_num, Schedule{nullptr});
+  auto f_proc_transferred = [this, &results, &pp](int thread_id, int trace_id) -> void {
+    PerThreadData& data = this->per_thread_data_.at(thread_id);
+    if (Optional<Schedule> sch =
+            pp.Apply(data.mod, this->transferred_traces_.at(trace_id), &data.rand_state)) {
+      results.at(trace_id) = sch.value();
+    }
+  };
+  support::parallel_for_dynamic(0, actual_num, self->ctx_->num_threads, f_proc_transferred);
+  results.erase(std::remove(results.begin(), results.end(), Schedule{nullptr}), results.end());
+  return results;
+}
+
 std::vector<Schedule> EvolutionarySearchNode::State::SampleInitPopulation(int num) {
   auto _ = Profiler::TimedScope("EvoSearch/SampleInitPopulation");
-  ThreadedTraceApply pp(self->postprocs_);
+  ThreadedTraceApply pp(self->postprocs_, MakePrecheck());
   std::vector<Schedule> out_schs;
   int fail_count = 0;
   while (static_cast<int>(out_schs.size()) < self->init_min_unmeasured &&
@@ -575,7 +734,7 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
     }
     {
       auto _ = Profiler::TimedScope("EvoSearch/Evolve/Mutation");
-      ThreadedTraceApply pp(self->postprocs_);
+      ThreadedTraceApply pp(self->postprocs_, MakePrecheck(), prefix_cache_.get());
       ConcurrentBitmask cbmask(self->population_size);
       std::vector<Schedule> next_population(self->population_size, Schedule{nullptr});
       // The worker function
@@ -596,7 +755,35 @@ std::vector<Schedule> EvolutionarySearchNode::State::EvolveWithCostModel(
           if (Optional<Mutator> opt_mutator = mutator_sampler()) {
             // Decision: mutate
             Mutator mutator = opt_mutator.value();
-            if (Optional<tir::Trace> new_trace = mutator->Apply(trace, rand_state)) {
+            // The schedules of the traces scored by a guided mutator, so they are applied once
+            std::unordered_map<const Object*, Schedule> scored;
+            MutatorNode::FScore f_score = [&](const std::vector<tir::Trace>& traces) {
+              std::vector<double> scores(traces.size(), -std::numeric_limits<double>::infinity());
+              std::vector<Schedule> schs;
+              std::vector<int> indices;
+              for (int i = 0, n = traces.size(); i < n; ++i) {
+                if (Optional<Schedule> sch = pp.Apply(mod, traces[i], rand_state)) {
+                  scored[traces[i].get()] = sch.value();
+                  schs.push_back(sch.value());
+                  indices.push_back(i);
+                }
+              }
+              if (!schs.empty()) {
+                std::lock_guard<std::mutex> lock(predict_mutex_);
+                std::vector<double> valid_scores = PredictNormalizedScore(
+                    schs, GetRef<TuneContext>(self->ctx_), this->cost_model_);
+                for (int i = 0, n = indices.size(); i < n; ++i) {
+                  scores[indices[i]] = valid_scores[i];
+                }
+              }
+              return scores;
+            };
+            if (Optional<tir::Trace> new_trace = mutator->ApplyGuided(trace, rand_state, f_score)) {
+              auto it = scored.find(new_trace.get());
+              if (it != scored.end()) {
+                result = it->second;
+                break;
+              }
               if (Optional<Schedule> sch = pp.Apply(mod, new_trace.value(), rand_state)) {
                 // note that sch's trace is different from new_trace
                 // because it contains post-processing information
@@ -696,6 +883,35 @@ std::vector<Schedule> EvolutionarySearchNode::State::PickWithEpsGreedy(
   return results;
 }
 
+void EvolutionarySearchNode::State::UpdateCostModelWithRejected(int num) {
+  auto _ = Profiler::TimedScope("EvoSearch/UpdateCostModelWithRejected");
+  std::vector<Schedule> rejected;
+  {
+    std::lock_guard<std::mutex> lock(rejected_mutex_);
+    rejected.swap(rejected_);
+  }
+  if (rejected.empty() || !cost_model_.defined()) {
+    return;
+  }
+  // Keep the feedback small, as the rejected schedules are much cheaper to find than measured ones
+  if (static_cast<int>(rejected.size()) > num) {
+    std::vector<int> indices =
+        tir::SampleWithoutReplacement(&self->rand_state_, rejected.size(), num);
+    std::vector<Schedule> sampled;
+    sampled.reserve(num);
+    for (int i : indices) {
+      sampled.push_back(rejected[i]);
+    }
+    rejected.swap(sampled);
+  }
+  Array<RunnerResult> results(
+      rejected.size(), RunnerResult(NullOpt, String("Rejected by the static checks")));
+  cost_model_->Update(GetRef<TuneContext>(self->ctx_), AssembleCandidates(rejected), results);
+  TVM_PY_LOG(INFO, self->ctx_->logger)
+      << "Updated the cost model with " << rejected.size()
+      << " candidate(s) rejected by the static checks";
+}
+
 Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasureCandidates() {
   if (st >= max_trials) {
     return NullOpt;
@@ -711,9 +927,16 @@ Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasure
   inits.reserve(pop);
 
   TVM_PY_LOG(INFO, self->ctx_->logger) << "Generating candidates......";
-  std::vector<Schedule> measured = PickBestFromDatabase(pop * self->init_measured_ratio);
+  int num_measured = pop * self->init_measured_ratio;
+  std::vector<Schedule> measured = PickBestFromDatabase(num_measured);
   TVM_PY_LOG(INFO, self->ctx_->logger)
       << "Picked top " << measured.size() << " candidate(s) from database";
+  if (self->warm_start_num_workloads > 0 && static_cast<int>(measured.size()) < num_measured) {
+    std::vector<Schedule> transferred = PickTransferred(num_measured - measured.size());
+    TVM_PY_LOG(INFO, self->ctx_->logger)
+        << "Picked " << transferred.size() << " candidate(s) transferred from similar workloads";
+    measured.insert(measured.end(), transferred.begin(), transferred.end());
+  }
   std::vector<Schedule> unmeasured = SampleInitPopulation(pop - measured.size());
   if (static_cast<int>(unmeasured.size()) < self->init_min_unmeasured) {
     TVM_PY_LOG(WARNING, self->ctx_->logger)
@@ -729,20 +952,22 @@ Optional<Array<MeasureCandidate>> EvolutionarySearchNode::State::GenerateMeasure
   std::vector<Schedule> picks = PickWithEpsGreedy(unmeasured, bests, sample_num);
   TVM_PY_LOG(INFO, self->ctx_->logger)
       << "Sending " << picks.size() << " candidates(s) for measurement";
+  UpdateCostModelWithRejected(sample_num);
   if (picks.empty()) {
     ++this->num_empty_iters;
     if (this->num_empty_iters >= self->num_empty_iters_before_early_stop) {
       return NullOpt;
     }
   }
+  // The trials are counted when generated, so that the next batch can be generated while this
+  // one is still being measured
+  st += picks.size();
+  ed += picks.size();
   return AssembleCandidates(picks);
 }
 
 void EvolutionarySearchNode::State::NotifyRunnerResults(
-    const Array<MeasureCandidate>& measure_candidates, const Array<RunnerResult>& results) {
-  st += results.size();
-  ed += results.size();
-}
+    const Array<MeasureCandidate>& measure_candidates, const Array<RunnerResult>& results) {}
 
 size_t EvolutionarySearchNode::State::ModuleHash(const IRModule& mod) const {
   return database_->GetModuleEquality().Hash(mod);
@@ -755,8 +980,11 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
                                                   int genetic_num_iters,       //
                                                   double genetic_mutate_prob,  //
                                                   int genetic_max_fail_count,  //
-                                                  double eps_greedy) {
+                                                  double eps_greedy,           //
+                                                  int warm_start_num_workloads) {
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(init_measured_ratio, "Initial measured ratio");
+  CHECK_GE(warm_start_num_workloads, 0)
+      << "ValueError: `warm_start_num_workloads` must be non-negative";
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(genetic_mutate_prob, "Mutation probability");
   TVM_META_SCHEDULE_CHECK_PROB_RANGE(eps_greedy, "Greedy pick probability");
   ObjectPtr<EvolutionarySearchNode> n = make_object<EvolutionarySearchNode>();
@@ -769,6 +997,7 @@ SearchStrategy SearchStrategy::EvolutionarySearch(int population_size,         /
   n->genetic_max_fail_count = genetic_max_fail_count;
   n->genetic_mutate_prob = genetic_mutate_prob;
   n->eps_greedy = eps_greedy;
+  n->warm_start_num_workloads = warm_start_num_workloads;
   return SearchStrategy(n);
 }
 
@@ -143,14 +143,13 @@ inline Optional<Array<MeasureCandidate>> ReplayFuncNode::State::GenerateMeasureC
       }
     }
   }
-  return result;
-}
-
-inline void ReplayFuncNode::State::NotifyRunnerResults(const Array<RunnerResult>& results) {
   st += num_trials_per_iter;
   ed += num_trials_per_iter;
+  return result;
 }
 
+inline void ReplayFuncNode::State::NotifyRunnerResults(const Array<RunnerResult>& results) {}
+
 SearchStrategy SearchStrategy::ReplayFunc() {
   ObjectPtr<ReplayFuncNode> n = make_object<ReplayFuncNode>();
   return SearchStrategy(n);
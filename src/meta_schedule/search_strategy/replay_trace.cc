@@ -176,14 +176,13 @@ inline Optional<Array<MeasureCandidate>> ReplayTraceNode::State::GenerateMeasure
     if (result.defined()) {
       filtered.push_back(result);
     }
-  return filtered;
-}
-
-inline void ReplayTraceNode::State::NotifyRunnerResults(const Array<RunnerResult>& results) {
   st += num_trials_per_iter;
   ed += num_trials_per_iter;
+  return filtered;
 }
 
+inline void ReplayTraceNode::State::NotifyRunnerResults(const Array<RunnerResult>& results) {}
+
 SearchStrategy SearchStrategy::ReplayTrace(int max_fail_count) {
   ObjectPtr<ReplayTraceNode> n = make_object<ReplayTraceNode>();
   n->max_fail_count = max_fail_count;
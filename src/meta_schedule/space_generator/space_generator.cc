@@ -24,6 +24,12 @@ namespace meta_schedule {
 
 String GetRuleKindFromTarget(const Target& target) {
   if (target->kind->name == "llvm") {
+    static const PackedFunc* f_check_amx = runtime::Registry::Get("tvm.target.x86.target_has_amx");
+    ICHECK(f_check_amx != nullptr) << "The `target_has_amx` func is not in tvm registry.";
+    if (target->GetAttr<String>("mcpu") &&
+        (*f_check_amx)(target->GetAttr<String>("mcpu").value())) {
+      return "amx";
+    }
     static const PackedFunc* f_check_vnni =
         runtime::Registry::Get("tvm.target.x86.target_has_vnni");
     ICHECK(f_check_vnni != nullptr) << "The `target_has_vnni` func is not in tvm registry.";
@@ -44,6 +50,10 @@ String GetRuleKindFromTarget(const Target& target) {
     TargetFeatures afeatures = Downcast<TargetFeatures>(target_json.at("features"));
 
     if (Downcast<Bool>(afeatures.at("has_dotprod"))) {
+      // The i8mm rules fall back to the dot product ones for the shapes they do not tile.
+      if (Downcast<Bool>(afeatures.at("has_matmul_i8"))) {
+        return "i8mm";
+      }
       return "dotprod";
     }
     if (Downcast<Bool>(afeatures.at("has_asimd"))) {
@@ -71,6 +81,12 @@ String GetRuleKindFromTarget(const Target& target) {
     }
     return "cuda";
   }
+  if (target->kind->name == "vulkan") {
+    if (target->GetAttr<Bool>("supports_cooperative_matrix").value_or(Bool(false)) ||
+        target->GetAttr<Bool>("supports_cooperative_matrix_khr").value_or(Bool(false))) {
+      return "vulkan-tensorcore";
+    }
+  }
 
   if (IsGPUTarget(target->kind->name)) {
     return "cuda";
@@ -105,10 +121,18 @@ void SpaceGeneratorNode::InitializeWithTuneContext(const TuneContext& context) {
       default_sch_rules = ScheduleRule::DefaultCUDATensorCore();
       default_postprocs = Postproc::DefaultCUDATensorCore();
       default_mutator_probs = Mutator::DefaultCUDATensorCore();
+    } else if (kind == "vulkan-tensorcore") {
+      default_sch_rules = ScheduleRule::DefaultVulkanTensorCore();
+      default_postprocs = Postproc::DefaultCUDATensorCore();
+      default_mutator_probs = Mutator::DefaultCUDATensorCore();
     } else if (kind == "hexagon") {
       default_sch_rules = ScheduleRule::DefaultHexagon();
       default_postprocs = Postproc::DefaultHexagon();
       default_mutator_probs = Mutator::DefaultHexagon();
+    } else if (kind == "amx") {
+      default_sch_rules = ScheduleRule::DefaultX86("amx");
+      default_postprocs = Postproc::DefaultCPUTensorization();
+      default_mutator_probs = Mutator::DefaultLLVM();
     } else if (kind == "vnni") {
       default_sch_rules = ScheduleRule::DefaultX86("vnni");
       default_postprocs = Postproc::DefaultCPUTensorization();
@@ -129,6 +153,10 @@ void SpaceGeneratorNode::InitializeWithTuneContext(const TuneContext& context) {
       default_sch_rules = ScheduleRule::DefaultARM("dotprod");
       default_postprocs = Postproc::DefaultCPUTensorization();
       default_mutator_probs = Mutator::DefaultLLVM();
+    } else if (kind == "i8mm") {
+      default_sch_rules = ScheduleRule::DefaultARM("i8mm");
+      default_postprocs = Postproc::DefaultCPUTensorization();
+      default_mutator_probs = Mutator::DefaultLLVM();
     } else {
       LOG(FATAL) << "Unsupported kind: " << kind;
       throw;
@@ -0,0 +1,203 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "static_validity.h"
+
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+
+#include "../tir/schedule/utils.h"
+#include "utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+using namespace tir;
+
+/*!
+ * \brief Estimate the resources used by each kernel of a PrimFunc. To never reject a valid
+ * candidate, the buffers are only counted while they are live on the path from the kernel root,
+ * i.e. the buffers of sibling subtrees, which later passes may let share storage, are not summed.
+ */
+class KernelResourceEstimator : private StmtVisitor {
+ public:
+  struct Limits {
+    int64_t max_threads_per_block;
+    int64_t max_shared_memory_per_block;
+    int64_t registers_per_block;
+  };
+
+  static bool Check(const PrimFunc& func, const Limits& limits) {
+    KernelResourceEstimator estimator(limits);
+    estimator.VisitStmt(func->body);
+    return estimator.valid_;
+  }
+
+ private:
+  explicit KernelResourceEstimator(const Limits& limits) : limits_(limits) {}
+
+  void VisitStmt_(const ForNode* loop) final {
+    if (!valid_) {
+      return;
+    }
+    runtime::ThreadScope thread_scope = GetThreadScope(loop);
+    bool is_thread_idx = IsThreadIdx(thread_scope);
+    if (!in_kernel_ && (is_thread_idx || IsBlockIdx(thread_scope))) {
+      EnterKernel(loop);
+      return;
+    }
+    if (is_thread_idx && in_kernel_) {
+      const int64_t* extent = GetLoopIntExtent(loop);
+      int dim = thread_scope.dim_index;
+      if (extent != nullptr && dim >= 0 && dim < 3) {
+        thread_extent_[dim] = std::max(thread_extent_[dim], *extent);
+      }
+      ++thread_depth_;
+      StmtVisitor::VisitStmt_(loop);
+      --thread_depth_;
+      return;
+    }
+    StmtVisitor::VisitStmt_(loop);
+  }
+
+  void VisitStmt_(const BlockNode* block) final {
+    if (!valid_) {
+      return;
+    }
+    int64_t shared_bytes = 0;
+    int64_t local_bytes = 0;
+    if (in_kernel_) {
+      for (const Buffer& buffer : block->alloc_buffers) {
+        runtime::StorageScope scope = runtime::StorageScope::Create(buffer.scope());
+        if (scope.rank == runtime::StorageRank::kShared) {
+          shared_bytes += GetBufferBytes(buffer);
+        } else if (scope.rank == runtime::StorageRank::kLocal && thread_depth_ > 0) {
+          local_bytes += GetBufferBytes(buffer);
+        }
+      }
+    }
+    live_shared_bytes_ += shared_bytes;
+    live_local_bytes_ += local_bytes;
+    max_shared_bytes_ = std::max(max_shared_bytes_, live_shared_bytes_);
+    max_local_bytes_ = std::max(max_local_bytes_, live_local_bytes_);
+    StmtVisitor::VisitStmt_(block);
+    live_shared_bytes_ -= shared_bytes;
+    live_local_bytes_ -= local_bytes;
+  }
+
+  void EnterKernel(const ForNode* loop) {
+    in_kernel_ = true;
+    thread_extent_[0] = thread_extent_[1] = thread_extent_[2] = 1;
+    max_shared_bytes_ = max_local_bytes_ = 0;
+    // The kernel root itself may be the outermost threadIdx loop
+    VisitStmt_(loop);
+    in_kernel_ = false;
+    int64_t num_threads = thread_extent_[0] * thread_extent_[1] * thread_extent_[2];
+    int64_t local_words = (max_local_bytes_ + 3) / 4;
+    if (num_threads > limits_.max_threads_per_block ||
+        max_shared_bytes_ > limits_.max_shared_memory_per_block ||
+        (limits_.registers_per_block > 0 &&
+         local_words * num_threads > limits_.registers_per_block)) {
+      valid_ = false;
+    }
+  }
+
+  /*! \return The number of bytes of a buffer, 0 if its shape is not constant. */
+  static int64_t GetBufferBytes(const Buffer& buffer) {
+    int64_t numel = 1;
+    for (const PrimExpr& dim : buffer->shape) {
+      const int64_t* extent = as_const_int(dim);
+      if (extent == nullptr) {
+        return 0;
+      }
+      numel *= *extent;
+    }
+    return numel * buffer->dtype.bytes() * buffer->dtype.lanes();
+  }
+
+  /*! \brief The limits of the target. */
+  const Limits& limits_;
+  /*! \brief Whether all the kernels visited are within the limits. */
+  bool valid_ = true;
+  /*! \brief Whether the visitor is inside a kernel. */
+  bool in_kernel_ = false;
+  /*! \brief The number of threadIdx loops around the statement visited. */
+  int thread_depth_ = 0;
+  /*! \brief The extent of threadIdx.x/y/z of the kernel visited. */
+  int64_t thread_extent_[3] = {1, 1, 1};
+  /*! \brief The bytes of shared/local buffers live at the statement visited. */
+  int64_t live_shared_bytes_ = 0;
+  int64_t live_local_bytes_ = 0;
+  /*! \brief The maximum bytes of shared/local buffers live at once in the kernel visited. */
+  int64_t max_shared_bytes_ = 0;
+  int64_t max_local_bytes_ = 0;
+};
+
+std::unique_ptr<StaticValidityChecker> StaticValidityChecker::Create(const Target& target) {
+  if (!IsGPUTarget(target->kind->name)) {
+    return nullptr;
+  }
+  Optional<Integer> max_threads_per_block = target->GetAttr<Integer>("max_threads_per_block");
+  Optional<Integer> max_shared_memory_per_block =
+      target->GetAttr<Integer>("max_shared_memory_per_block");
+  if (!max_threads_per_block.defined() || !max_shared_memory_per_block.defined()) {
+    return nullptr;
+  }
+  std::unique_ptr<StaticValidityChecker> checker(new StaticValidityChecker());
+  checker->max_threads_per_block_ = max_threads_per_block.value()->value;
+  checker->max_shared_memory_per_block_ = max_shared_memory_per_block.value()->value;
+  if (Optional<Integer> registers_per_block = target->GetAttr<Integer>("registers_per_block")) {
+    checker->registers_per_block_ = registers_per_block.value()->value;
+  }
+  return checker;
+}
+
+bool StaticValidityChecker::Check(const IRModule& mod) const {
+  IRModule lowered{nullptr};
+  try {
+    lowered = tvm::transform::Sequential({
+        tir::transform::PlanAndUpdateBufferAllocationLocation(),
+        tir::transform::ConvertBlocksToOpaque(),
+        tir::transform::CompactBufferAllocation(),
+    })(mod);
+  } catch (const dmlc::Error& e) {
+    // Leave the candidates that cannot be analyzed to the postprocessors
+    return true;
+  }
+  KernelResourceEstimator::Limits limits{max_threads_per_block_, max_shared_memory_per_block_,
+                                         registers_per_block_};
+  for (const auto& kv : lowered->functions) {
+    if (const auto* prim_func = kv.second.as<PrimFuncNode>()) {
+      if (!KernelResourceEstimator::Check(GetRef<PrimFunc>(prim_func), limits)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+TVM_REGISTER_GLOBAL("meta_schedule.CheckStaticValidity")
+    .set_body_typed([](Target target, IRModule mod) -> bool {
+      std::unique_ptr<StaticValidityChecker> checker = StaticValidityChecker::Create(target);
+      return checker == nullptr || checker->Check(mod);
+    });
+
+}  // namespace meta_schedule
+}  // namespace tvm
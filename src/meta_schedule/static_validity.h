@@ -0,0 +1,67 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_STATIC_VALIDITY_H_
+#define TVM_META_SCHEDULE_STATIC_VALIDITY_H_
+
+#include <tvm/ir/module.h>
+#include <tvm/target/target.h>
+
+#include <memory>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief A cheap static check of the resources a scheduled module uses on a GPU, which rejects
+ * candidates that can never pass `VerifyGPUCode` or launch, before they are postprocessed and
+ * built. The estimates are taken on the schedule before postprocessing, with buffers compacted:
+ * - the number of threads per block, i.e. the product of the threadIdx extents of a kernel;
+ * - the shared memory per block, i.e. the total size of the shared buffers of a kernel;
+ * - the registers per block, i.e. the size of the local buffers of a thread in 32-bit words,
+ *   times the number of threads per block.
+ */
+class StaticValidityChecker {
+ public:
+  /*!
+   * \brief Create the checker of a target.
+   * \param target The target.
+   * \return The checker created, or nullptr if the target is not a GPU or lacks the limits.
+   */
+  static std::unique_ptr<StaticValidityChecker> Create(const Target& target);
+
+  /*!
+   * \brief Check if a scheduled module fits in the resource limits of the target.
+   * \param mod The module scheduled, before postprocessing.
+   * \return False if the module surely exceeds a limit, true otherwise.
+   */
+  bool Check(const IRModule& mod) const;
+
+ private:
+  /*! \brief The maximum number of threads per block. */
+  int64_t max_threads_per_block_ = -1;
+  /*! \brief The maximum number of bytes of shared memory per block. */
+  int64_t max_shared_memory_per_block_ = -1;
+  /*! \brief The number of registers per block, -1 if unknown. */
+  int64_t registers_per_block_ = -1;
+};
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_STATIC_VALIDITY_H_
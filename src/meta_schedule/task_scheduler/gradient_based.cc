@@ -63,8 +63,12 @@ class GradientBasedNode final : public TaskSchedulerNode {
       TVM_PY_LOG_CLEAR_SCREEN(this->logger);
       this->PrintTuningStatistics();
     }
-    if (round_robin_rounds_ < n_tasks) {
-      return round_robin_rounds_++;
+    while (round_robin_rounds_ < n_tasks) {
+      int task_id = round_robin_rounds_++;
+      // Tasks may be terminated before tuning starts, e.g. those already tuned in the database
+      if (!this->tasks_[task_id]->is_terminated) {
+        return task_id;
+      }
     }
     if (round_robin_rounds_ == n_tasks) {
       for (int i = 0; i < n_tasks; ++i) {
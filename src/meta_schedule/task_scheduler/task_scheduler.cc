@@ -40,14 +40,38 @@ TaskRecord::TaskRecord(TuneContext ctx, double task_weight) {
 
 void SendToBuilder(TaskRecordNode* self, const Builder& builder) {
   auto _ = Profiler::TimedScope("SendToBuilder");
-  Array<MeasureCandidate> candidates = self->measure_candidates.value();
+  Array<MeasureCandidate> candidates = self->next_candidates.value();
   Target target = self->ctx->target.value();
   Array<BuilderInput> inputs;
   inputs.reserve(candidates.size());
   for (const MeasureCandidate& candidate : candidates) {
     inputs.push_back(BuilderInput(candidate->sch->mod(), target));
   }
-  self->builder_results = builder->Build(inputs);
+  self->next_builder_results = builder->Build(inputs);
+}
+
+/*!
+ * \brief Generate and build the next batch of measure candidates of a task. It is called while the
+ * current batch of the task is running, so that building overlaps with measurement.
+ * \param self The task
+ * \param builder The builder
+ * \param logger The logger of the task scheduler
+ */
+void PrepareNextBatch(TaskRecordNode* self, const Builder& builder, const PackedFunc& logger) {
+  ICHECK(!self->next_candidates.defined());
+  Optional<Array<MeasureCandidate>> candidates{NullOpt};
+  {
+    auto _ = Profiler::TimedScope("GenerateMeasureCandidates");
+    candidates = self->ctx->search_strategy.value()->GenerateMeasureCandidates();
+  }
+  if (candidates.defined()) {
+    self->next_candidates = candidates;
+    TVM_PY_LOG(INFO, logger) << "Sending " << candidates.value().size()
+                             << " sample(s) to builder";
+    SendToBuilder(self, builder);
+  } else {
+    self->is_exhausted = true;
+  }
 }
 
 void SendToRunner(TaskRecordNode* self, const Runner& runner) {
@@ -158,9 +182,13 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
     double weight = task_weights[i]->value;
     TVM_PY_LOG(INFO, this->logger) << "Initializing Task #" << i << ": " << ctx->task_name;
     TVM_PY_LOG(INFO, ctx->logger) << "Initializing Task #" << i << ": " << ctx->task_name;
+    auto _ = Profiler::TaskScope(ctx->task_name.value_or(""));
     this->tasks_.push_back(TaskRecord(ctx, weight));
-    Array<tir::Schedule> design_spaces =
-        ctx->space_generator.value()->GenerateDesignSpace(ctx->mod.value());
+    Array<tir::Schedule> design_spaces{nullptr};
+    {
+      auto _ = Profiler::TimedScope("GenerateDesignSpace");
+      design_spaces = ctx->space_generator.value()->GenerateDesignSpace(ctx->mod.value());
+    }
     TVM_PY_LOG(INFO, ctx->logger) << "Total " << design_spaces.size()
                                   << " design space(s) generated";
     for (int i = 0, n = design_spaces.size(); i < n; ++i) {
@@ -171,8 +199,38 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
                                     << sch->mod() << "\n"
                                     << Concat(trace->AsPython(false), "\n");
     }
-    ctx->search_strategy.value()->PreTuning(max_trials_per_task, num_trials_per_iter, design_spaces,
-                                            database, cost_model);
+    {
+      auto _ = Profiler::TimedScope("PreTuning");
+      ctx->search_strategy.value()->PreTuning(max_trials_per_task, num_trials_per_iter,
+                                              design_spaces, database, cost_model);
+    }
+  }
+  if (database.defined()) {
+    // A task whose workload already has a full budget of measured records, e.g. in a database
+    // shared with other tuning jobs, is not tuned again
+    for (int task_id = 0; task_id < n_tasks; ++task_id) {
+      TaskRecordNode* task = this->tasks_[task_id].get();
+      const IRModule& mod = task->ctx->mod.value();
+      if (!database.value()->HasWorkload(mod)) {
+        continue;
+      }
+      Array<TuningRecord> records =
+          database.value()->GetTopK(database.value()->CommitWorkload(mod), max_trials_per_task);
+      if (static_cast<int>(records.size()) < max_trials_per_task) {
+        continue;
+      }
+      for (const TuningRecord& record : records) {
+        const Array<FloatImm>& run_secs = record->run_secs.value();
+        double sum = 0.0;
+        for (const FloatImm& run_sec : run_secs) {
+          sum += run_sec->value;
+        }
+        task->latency_ms.push_back(sum / run_secs.size() * 1000.0);
+      }
+      TVM_PY_LOG(INFO, this->logger) << "Task #" << task_id << " already has " << records.size()
+                                     << " tuning record(s) in the database, skipped";
+      TerminateTask(task_id);
+    }
   }
 
   int num_trials_already = 0;
@@ -180,26 +238,37 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
     TVM_PY_LOG(INFO, this->logger)
         << "TaskScheduler picks Task #" << task_id << ": " << tasks_[task_id]->ctx->task_name;
     TaskRecordNode* task = tasks_[task_id].get();
+    auto _ = Profiler::TaskScope(task->ctx->task_name.value_or(""));
     ICHECK(!task->is_terminated);
     ICHECK(!task->runner_futures.defined());
     if (static_cast<int>(task->latency_ms.size()) >= max_trials_per_task) {
       TerminateTask(task_id);
       continue;
     }
-    if (Optional<Array<MeasureCandidate>> candidates = task->measure_candidates =
-            task->ctx->search_strategy.value()->GenerateMeasureCandidates()) {
-      int num_candidates = candidates.value().size();
-      num_trials_already += num_candidates;
-      TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to builder";
-      SendToBuilder(task, builder);
-      TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to runner";
-      SendToRunner(task, runner);
-    } else {
+    if (!task->next_candidates.defined() && !task->is_exhausted) {
+      PrepareNextBatch(task, builder, this->logger);
+    }
+    if (task->is_exhausted) {
       TerminateTask(task_id);
+      continue;
+    }
+    task->measure_candidates = task->next_candidates;
+    task->builder_results = task->next_builder_results;
+    task->next_candidates = NullOpt;
+    task->next_builder_results = NullOpt;
+    int num_candidates = task->measure_candidates.value().size();
+    num_trials_already += num_candidates;
+    TVM_PY_LOG(INFO, this->logger) << "Sending " << num_candidates << " sample(s) to runner";
+    SendToRunner(task, runner);
+    // Build the next batch while the runner is busy with this one, if the budget allows
+    if (num_trials_already < max_trials_global &&
+        static_cast<int>(task->latency_ms.size()) + num_candidates < max_trials_per_task) {
+      PrepareNextBatch(task, builder, this->logger);
     }
   }
   for (int task_id = 0; task_id < n_tasks; ++task_id) {
     TaskRecordNode* task = this->tasks_[task_id].get();
+    auto _ = Profiler::TaskScope(task->ctx->task_name.value_or(""));
     if (!task->is_terminated) {
       if (task->runner_futures.defined()) {
         JoinRunningTask(task_id);
@@ -212,6 +281,7 @@ void TaskSchedulerNode::Tune(Array<TuneContext> ctxs, Array<FloatImm> task_weigh
 
 Array<RunnerResult> TaskSchedulerNode::JoinRunningTask(int task_id) {
   TaskRecordNode* task = this->tasks_[task_id].get();
+  auto _ = Profiler::TaskScope(task->ctx->task_name.value_or(""));
   ICHECK(task->runner_futures.defined());
   Array<RunnerResult> results;
   {
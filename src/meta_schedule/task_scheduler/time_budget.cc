@@ -0,0 +1,241 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <chrono>
+
+#include "../utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief The task scheduler that tunes within a wall-clock time budget. It picks the task with the
+ * largest expected improvement of the weighted latency per second spent on it, and stops the tasks
+ * whose best latency has not improved for a number of rounds.
+ */
+class TimeBudgetNode final : public TaskSchedulerNode {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  /*! \brief The wall-clock time budget of tuning, in seconds. */
+  double time_budget_sec;
+  /*! \brief The number of rounds without improvement after which a task is stopped. */
+  int patience;
+  /*! \brief The parameter alpha to control gradient computation. */
+  double alpha;
+  /*! \brief The parameter to control backward window size. */
+  int window_size;
+  /*! \brief The random state. */
+  support::LinearCongruentialEngine::TRandState rand_state;
+
+  /*! \brief The time tuning started. */
+  Clock::time_point start_time_;
+  /*! \brief The task picked last, whose iteration is being timed, -1 if none. */
+  int last_task_id_;
+  /*! \brief The time the last task was picked. */
+  Clock::time_point last_pick_time_;
+  /*! \brief The number of tasks picked in the initial round-robin. */
+  int round_robin_rounds_;
+  /*! \brief The seconds spent on each task, including generation, building and running. */
+  std::vector<double> seconds_spent_;
+  /*! \brief The best latency of each task after each round. */
+  std::vector<std::vector<double>> best_latency_history_;
+  /*! \brief The number of rounds since the best latency of each task improved. */
+  std::vector<int> rounds_without_improvement_;
+
+  void VisitAttrs(tvm::AttrVisitor* v) {
+    TaskSchedulerNode::VisitAttrs(v);
+    v->Visit("time_budget_sec", &time_budget_sec);
+    v->Visit("patience", &patience);
+    v->Visit("alpha", &alpha);
+    v->Visit("window_size", &window_size);
+    // `rand_state` is not visited.
+    // `start_time_` is not visited.
+    // `last_task_id_` is not visited.
+    // `last_pick_time_` is not visited.
+    // `round_robin_rounds_` is not visited.
+    // `seconds_spent_` is not visited.
+    // `best_latency_history_` is not visited.
+    // `rounds_without_improvement_` is not visited.
+  }
+
+  static constexpr const char* _type_key = "meta_schedule.TimeBudget";
+  TVM_DECLARE_FINAL_OBJECT_INFO(TimeBudgetNode, TaskSchedulerNode);
+
+ public:
+  void Tune(Array<TuneContext> tasks, Array<FloatImm> task_weights, int max_trials_global,
+            int max_trials_per_task, int num_trials_per_iter, Builder builder, Runner runner,
+            Array<MeasureCallback> measure_callbacks, Optional<Database> database,
+            Optional<CostModel> cost_model) final {
+    int n_tasks = tasks.size();
+    start_time_ = Clock::now();
+    last_task_id_ = -1;
+    round_robin_rounds_ = 0;
+    seconds_spent_.assign(n_tasks, 0.0);
+    best_latency_history_.assign(n_tasks, std::vector<double>());
+    rounds_without_improvement_.assign(n_tasks, 0);
+    TaskSchedulerNode::Tune(tasks, task_weights, max_trials_global, max_trials_per_task,
+                            num_trials_per_iter, builder, runner, measure_callbacks, database,
+                            cost_model);
+  }
+
+  int NextTaskId() final {
+    int n_tasks = this->tasks_.size();
+    // Step 1. Charge the time of the last iteration to the task picked
+    Clock::time_point now = Clock::now();
+    if (last_task_id_ != -1) {
+      seconds_spent_[last_task_id_] += Seconds(now - last_pick_time_);
+      last_task_id_ = -1;
+    }
+    if (round_robin_rounds_ == 0) {
+      TVM_PY_LOG_CLEAR_SCREEN(this->logger);
+      this->PrintTuningStatistics();
+    }
+    // Step 2. Stop if the time budget is used up
+    if (Seconds(now - start_time_) >= time_budget_sec) {
+      TVM_PY_LOG(INFO, this->logger)
+          << "Time budget of " << time_budget_sec << " second(s) is used up";
+      return -1;
+    }
+    // Step 3. Check if it's in round robin mode.
+    int task_id = -1;
+    while (task_id == -1 && round_robin_rounds_ < n_tasks) {
+      if (!this->tasks_[round_robin_rounds_]->is_terminated) {
+        task_id = round_robin_rounds_;
+      }
+      ++round_robin_rounds_;
+    }
+    if (task_id == -1) {
+      task_id = SelectTask();
+    }
+    if (task_id == -1) {
+      return -1;
+    }
+    if (this->tasks_[task_id]->runner_futures.defined()) {
+      JoinRunningTask(task_id);
+    }
+    last_task_id_ = task_id;
+    last_pick_time_ = Clock::now();
+    return task_id;
+  }
+
+  Array<RunnerResult> JoinRunningTask(int task_id) final {
+    Clock::time_point start = Clock::now();
+    Array<RunnerResult> results = TaskSchedulerNode::JoinRunningTask(task_id);
+    seconds_spent_[task_id] += Seconds(Clock::now() - start);
+    TaskRecordNode* task = this->tasks_[task_id].get();
+    if (task->latency_ms.size() > 0) {
+      double best = *std::min_element(task->latency_ms.begin(), task->latency_ms.end());
+      std::vector<double>& history = best_latency_history_[task_id];
+      if (!history.empty() && best >= history.back()) {
+        ++rounds_without_improvement_[task_id];
+      } else {
+        rounds_without_improvement_[task_id] = 0;
+      }
+      history.push_back(best);
+    }
+    return results;
+  }
+
+ private:
+  static double Seconds(Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+  }
+
+  /*!
+   * \brief Stop the tasks that have converged, and select the task alive with the largest expected
+   * improvement of the weighted latency per second.
+   * \return The id of the task selected, -1 if all tasks are terminated.
+   */
+  int SelectTask() {
+    int n_tasks = this->tasks_.size();
+    // Step 1. Collect the tasks that are not terminated yet, stopping those that have converged
+    std::vector<int> tasks_alive;
+    tasks_alive.reserve(n_tasks);
+    for (int i = 0; i < n_tasks; ++i) {
+      this->TouchTask(i);
+      TaskRecordNode* task = this->tasks_[i].get();
+      if (task->is_terminated) {
+        continue;
+      }
+      if (rounds_without_improvement_[i] >= patience) {
+        if (task->runner_futures.defined()) {
+          this->JoinRunningTask(i);
+        }
+        if (rounds_without_improvement_[i] >= patience) {
+          TVM_PY_LOG(INFO, this->logger) << "Task #" << i << " has not improved for "
+                                         << rounds_without_improvement_[i] << " round(s), stopped";
+          this->TerminateTask(i);
+          continue;
+        }
+      }
+      tasks_alive.push_back(i);
+    }
+    if (tasks_alive.empty()) {
+      return -1;
+    }
+    // Step 2. Estimate the improvement of the weighted latency per second of each task alive
+    std::vector<double> gain;
+    gain.reserve(tasks_alive.size());
+    for (int task_id : tasks_alive) {
+      const std::vector<double>& best_latency = this->best_latency_history_.at(task_id);
+      int n = best_latency.size();
+      int w = this->window_size;
+      if (n > 0 && best_latency[n - 1] < 1e9) {
+        double best = best_latency[n - 1];
+        double g1 = (n >= 1 + w) ? (best_latency[n - 1 - w] - best) / w : 0.0;
+        double g2 = best / n;
+        double g = alpha * g1 + (1 - alpha) * g2;
+        double seconds_per_round = std::max(seconds_spent_[task_id] / n, 1e-6);
+        gain.push_back(g * this->tasks_[task_id]->task_weight / seconds_per_round);
+      } else {
+        // If the best time cost is unavailable, it means some task is not valid. Skip it.
+        gain.push_back(-1e9);
+      }
+    }
+    // Step 3. Select the task with the largest gain
+    auto max_gain = std::max_element(gain.begin(), gain.end());
+    auto min_gain = std::min_element(gain.begin(), gain.end());
+    if (*max_gain == *min_gain) {
+      return tasks_alive[tir::SampleInt(&this->rand_state, 0, tasks_alive.size())];
+    }
+    return tasks_alive[std::distance(gain.begin(), max_gain)];
+  }
+};
+
+TaskScheduler TaskScheduler::TimeBudget(PackedFunc logger, double time_budget_sec, int patience,
+                                        double alpha, int window_size,
+                                        support::LinearCongruentialEngine::TRandState seed) {
+  CHECK_GT(time_budget_sec, 0.0) << "ValueError: `time_budget_sec` must be positive";
+  CHECK_GT(patience, 0) << "ValueError: `patience` must be positive";
+  ObjectPtr<TimeBudgetNode> n = make_object<TimeBudgetNode>();
+  n->logger = logger;
+  n->time_budget_sec = time_budget_sec;
+  n->patience = patience;
+  n->alpha = alpha;
+  n->window_size = window_size;
+  n->rand_state = support::LinearCongruentialEngine::NormalizeSeed(seed);
+  return TaskScheduler(n);
+}
+
+TVM_REGISTER_NODE_TYPE(TimeBudgetNode);
+TVM_REGISTER_GLOBAL("meta_schedule.TaskSchedulerTimeBudget")
+    .set_body_typed(TaskScheduler::TimeBudget);
+
+}  // namespace meta_schedule
+}  // namespace tvm
@@ -21,6 +21,9 @@
 #include <tvm/tir/analysis.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -254,8 +257,121 @@ void ScheduleUsingAnchorTrace(Schedule sch, const Trace& anchor_trace, const tvm
   }
 }
 
+// Returns the divisors of n in ascending order
+std::vector<int64_t> GetDivisors(int64_t n) {
+  std::vector<int64_t> small, large;
+  for (int64_t d = 1; d * d <= n; ++d) {
+    if (n % d == 0) {
+      small.push_back(d);
+      if (d * d != n) {
+        large.push_back(n / d);
+      }
+    }
+  }
+  small.insert(small.end(), large.rbegin(), large.rend());
+  return small;
+}
+
+// Adapt the tile sizes of a loop to a new extent, keeping the ratios between the tiles in log scale
+Array<Integer> AdaptTileSizes(const Array<Integer>& tiles, int64_t extent,
+                              int64_t max_innermost_factor) {
+  int n = tiles.size();
+  int64_t old_extent = 1;
+  for (const Integer& tile : tiles) {
+    old_extent *= tile->value;
+  }
+  double scale = old_extent > 1 ? std::log(extent) / std::log(old_extent) : 0.0;
+  std::vector<int64_t> result(n, 1);
+  int64_t remaining = extent;
+  // The outermost tile takes whatever remains
+  for (int i = n - 1; i > 0; --i) {
+    double target = scale * std::log(std::max<int64_t>(tiles[i]->value, 1));
+    int64_t best = 1;
+    double best_diff = std::numeric_limits<double>::infinity();
+    for (int64_t d : GetDivisors(remaining)) {
+      if (i == n - 1 && max_innermost_factor != -1 && d > max_innermost_factor) {
+        break;
+      }
+      double diff = std::abs(std::log(d) - target);
+      if (diff < best_diff) {
+        best = d;
+        best_diff = diff;
+      }
+    }
+    result[i] = best;
+    remaining /= best;
+  }
+  result[0] = remaining;
+  return support::AsArray<int64_t, Integer>(result);
+}
+
+Optional<Trace> TransferTrace(const IRModule& mod, const Trace& design_space, const Trace& trace,
+                              double* distance) {
+  static auto kind_sample_perfect_tile = InstructionKind::Get("SamplePerfectTile");
+  static auto kind_enter_postproc = InstructionKind::Get("EnterPostproc");
+  // Step 1. Match the instructions of the design space with those of the trace
+  int n = design_space->insts.size();
+  int n_trace = 0;
+  while (n_trace < static_cast<int>(trace->insts.size()) &&
+         !trace->insts[n_trace]->kind.same_as(kind_enter_postproc)) {
+    ++n_trace;
+  }
+  if (n != n_trace) {
+    return NullOpt;
+  }
+  std::unordered_map<const Object*, ObjectRef> decisions;
+  for (int i = 0; i < n; ++i) {
+    const Instruction& inst = design_space->insts[i];
+    const Instruction& other = trace->insts[i];
+    if (!inst->kind.same_as(other->kind) || !StructuralEqual()(inst->attrs, other->attrs)) {
+      return NullOpt;
+    }
+    if (Optional<ObjectRef> decision = trace->GetDecision(other)) {
+      decisions.emplace(inst.get(), decision.value());
+    }
+  }
+  // Step 2. Replay the design space with the decisions of the trace, adapting the tile sizes
+  Schedule sch = Schedule::Traced(mod, /*seed=*/-1, /*debug_mask=*/0,
+                                  /*error_render_level=*/ScheduleErrorRenderLevel::kNone);
+  *distance = 0.0;
+  try {
+    Trace(design_space->insts, {})
+        ->ApplyToSchedule(
+            sch, /*remove_postproc=*/true,
+            [&](const Instruction& inst, const Array<ObjectRef>& inputs,
+                const Array<ObjectRef>& attrs, const Optional<ObjectRef>&) -> ObjectRef {
+              auto it = decisions.find(inst.get());
+              if (it == decisions.end()) {
+                return ObjectRef{nullptr};
+              }
+              if (!inst->kind.same_as(kind_sample_perfect_tile)) {
+                return it->second;
+              }
+              Array<Integer> tiles = Downcast<Array<Integer>>(it->second);
+              const int64_t* extent = GetLoopIntExtent(sch->Get(Downcast<LoopRV>(inputs[0])).get());
+              if (extent == nullptr) {
+                return tiles;
+              }
+              int64_t old_extent = 1;
+              for (const Integer& tile : tiles) {
+                old_extent *= tile->value;
+              }
+              *distance += std::abs(std::log(*extent) - std::log(std::max<int64_t>(old_extent, 1)));
+              return AdaptTileSizes(tiles, *extent, Downcast<Integer>(attrs[1])->value);
+            });
+  } catch (const std::exception&) {
+    return NullOpt;
+  }
+  return sch->trace().value();
+}
+
 TVM_REGISTER_GLOBAL("meta_schedule.ScheduleUsingAnchorTrace")
     .set_body_typed(ScheduleUsingAnchorTrace);
+TVM_REGISTER_GLOBAL("meta_schedule.TransferTrace")
+    .set_body_typed([](IRModule mod, Trace design_space, Trace trace) -> Optional<Trace> {
+      double distance = 0.0;
+      return TransferTrace(mod, design_space, trace, &distance);
+    });
 
 }  // namespace meta_schedule
 }  // namespace tvm
@@ -42,6 +42,22 @@ namespace meta_schedule {
 void ScheduleUsingAnchorTrace(tir::Schedule sch, const tir::Trace& anchor_trace,
                               const tvm::Target& target);
 
+/*!
+ * \brief Transfer the decisions of a trace tuned on another workload of the same operator family,
+ * e.g. the same anchor op with different shapes, onto a design space of a module. The instructions
+ * of the design space must match those of the trace one by one. Tile sizes are adapted to the
+ * loop extents of the module by keeping their ratios, and other decisions are kept as they are.
+ * \param mod The module to be scheduled.
+ * \param design_space The trace of a design space of the module.
+ * \param trace The trace tuned on the other workload.
+ * \param distance The distance between the two workloads, which is the sum of the absolute log
+ * ratios between the extents of the loops tiled.
+ * \return The trace of the design space with the decisions transferred, or NullOpt if the trace
+ * does not match the design space or cannot be applied to the module.
+ */
+Optional<tir::Trace> TransferTrace(const IRModule& mod, const tir::Trace& design_space,
+                                   const tir::Trace& trace, double* distance);
+
 }  // namespace meta_schedule
 }  // namespace tvm
 
@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "trace_prefix_cache.h"
+
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
+
+#include <utility>
+
+#include "utils.h"
+
+namespace tvm {
+namespace meta_schedule {
+
+using namespace tir;
+
+/*! \brief The producers of the random variables, i.e. the instruction and output indices hashed */
+using ProducerMap = std::unordered_map<const Object*, size_t>;
+
+/*! \brief Hash an input of an instruction, where random variables are hashed by their producers */
+size_t HashInput(const ObjectRef& input, const ProducerMap& producers) {
+  if (!input.defined()) {
+    return 0;
+  }
+  if (input->IsInstance<BlockRVNode>() || input->IsInstance<LoopRVNode>() ||
+      input->IsInstance<VarNode>()) {
+    auto it = producers.find(input.get());
+    return it != producers.end() ? it->second : ObjectPtrHash()(input);
+  }
+  if (const auto* arr = input.as<ArrayNode>()) {
+    size_t result = arr->size();
+    for (const ObjectRef& elem : *arr) {
+      result = support::HashCombine(result, HashInput(elem, producers));
+    }
+    return result;
+  }
+  if (input->IsInstance<StringObj>() || input->IsInstance<IntImmNode>() ||
+      input->IsInstance<FloatImmNode>()) {
+    return StructuralHash()(input);
+  }
+  // Expressions and index maps of random variables are only compared when matching
+  return input->type_index();
+}
+
+/*! \brief Check if two inputs, both translated to the random variables of a schedule, are equal */
+bool InputEqual(const ObjectRef& lhs, const ObjectRef& rhs) {
+  if (lhs.same_as(rhs)) {
+    return true;
+  }
+  if (!lhs.defined() || !rhs.defined()) {
+    return false;
+  }
+  const auto* lhs_arr = lhs.as<ArrayNode>();
+  const auto* rhs_arr = rhs.as<ArrayNode>();
+  if (lhs_arr != nullptr || rhs_arr != nullptr) {
+    if (lhs_arr == nullptr || rhs_arr == nullptr || lhs_arr->size() != rhs_arr->size()) {
+      return false;
+    }
+    for (size_t i = 0; i < lhs_arr->size(); ++i) {
+      if (!InputEqual(lhs_arr->at(i), rhs_arr->at(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Distinct block and loop random variables, which have no structural equality
+  if (lhs->IsInstance<BlockRVNode>() || lhs->IsInstance<LoopRVNode>() ||
+      rhs->IsInstance<BlockRVNode>() || rhs->IsInstance<LoopRVNode>()) {
+    return false;
+  }
+  return StructuralEqual()(lhs, rhs);
+}
+
+/*!
+ * \brief Hash the prefixes of a trace.
+ * \param trace The trace.
+ * \param n The number of instructions to hash.
+ * \return The hashes of the prefixes of length 0 to n.
+ */
+std::vector<size_t> HashPrefixes(const Trace& trace, int n) {
+  std::vector<size_t> hashes;
+  hashes.reserve(n + 1);
+  hashes.push_back(0);
+  ProducerMap producers;
+  for (int i = 0; i < n; ++i) {
+    const Instruction& inst = trace->insts[i];
+    size_t hash = support::HashCombine(hashes.back(), ObjectPtrHash()(inst->kind));
+    hash = support::HashCombine(hash, StructuralHash()(inst->attrs));
+    for (const ObjectRef& input : inst->inputs) {
+      hash = support::HashCombine(hash, HashInput(input, producers));
+    }
+    if (Optional<ObjectRef> decision = trace->GetDecision(inst)) {
+      hash = support::HashCombine(hash, StructuralHash()(decision.value()));
+    }
+    for (int j = 0, n_outputs = inst->outputs.size(); j < n_outputs; ++j) {
+      producers[inst->outputs[j].get()] = support::HashCombine(support::HashCombine(0, i), j);
+    }
+    hashes.push_back(hash);
+  }
+  return hashes;
+}
+
+/*!
+ * \brief Match the prefix of a trace with the trace replayed on a schedule.
+ * \param trace The trace.
+ * \param n The length of the prefix.
+ * \param replayed The trace replayed on the schedule.
+ * \param rv_map The map from the random variables of the trace to the schedule, if matched.
+ * \return Whether the prefix matches the trace replayed.
+ */
+bool MatchPrefix(const Trace& trace, int n, const Trace& replayed,
+                 std::unordered_map<const Object*, const Object*>* rv_map) {
+  if (static_cast<int>(replayed->insts.size()) != n) {
+    return false;
+  }
+  rv_map->clear();
+  for (int i = 0; i < n; ++i) {
+    const Instruction& inst = trace->insts[i];
+    const Instruction& replayed_inst = replayed->insts[i];
+    if (!inst->kind.same_as(replayed_inst->kind) ||
+        inst->inputs.size() != replayed_inst->inputs.size() ||
+        inst->outputs.size() != replayed_inst->outputs.size() ||
+        !StructuralEqual()(inst->attrs, replayed_inst->attrs)) {
+      return false;
+    }
+    Optional<ObjectRef> decision = trace->GetDecision(inst);
+    Optional<ObjectRef> replayed_decision = replayed->GetDecision(replayed_inst);
+    if (decision.defined() != replayed_decision.defined() ||
+        (decision.defined() && !StructuralEqual()(decision, replayed_decision))) {
+      return false;
+    }
+    Array<ObjectRef> inputs = TranslateInputRVs(inst->inputs, *rv_map);
+    for (int j = 0, n_inputs = inputs.size(); j < n_inputs; ++j) {
+      if (!InputEqual(inputs[j], replayed_inst->inputs[j])) {
+        return false;
+      }
+    }
+    TranslateAddOutputRVs(inst->outputs, replayed_inst->outputs, rv_map);
+  }
+  return true;
+}
+
+Schedule TracePrefixCache::Apply(const Trace& trace, const std::function<Schedule()>& f_fork,
+                                 TRandState* rand_state) {
+  int n = GetNumValidInstructions(trace->insts, /*remove_postproc=*/true);
+  std::vector<size_t> hashes = HashPrefixes(trace, n);
+  // Step 1. Resume from the longest prefix cached, right before an instruction with a decision
+  Schedule sch{nullptr};
+  std::unordered_map<const Object*, const Object*> rv_map;
+  int start = 0;
+  for (int i = n - 1; i > 0 && !sch.defined(); --i) {
+    if (!trace->GetDecision(trace->insts[i]).defined()) {
+      continue;
+    }
+    for (const SnapshotPtr& snapshot : Get(hashes[i])) {
+      if (MatchPrefix(trace, i, snapshot->sch->trace().value(), &rv_map)) {
+        {
+          std::lock_guard<std::mutex> lock(snapshot->mutex);
+          sch = snapshot->sch->Copy();
+        }
+        sch->Seed(ForkSeed(rand_state));
+        Touch(snapshot);
+        start = i;
+        break;
+      }
+    }
+  }
+  if (!sch.defined()) {
+    sch = f_fork();
+    rv_map.clear();
+  }
+  // Step 2. Replay the rest, caching the prefixes before the instructions with a decision.
+  // The prefixes stop being cached once an instruction samples without a decision given.
+  bool is_deterministic = true;
+  for (int i = start; i < n; ++i) {
+    const Instruction& inst = trace->insts[i];
+    Optional<ObjectRef> decision = trace->GetDecision(inst);
+    if (i > start && is_deterministic && decision.defined()) {
+      Put(hashes[i], sch);
+    }
+    Array<ObjectRef> inputs = TranslateInputRVs(inst->inputs, rv_map);
+    Array<ObjectRef> outputs = inst->kind->f_apply_to_schedule(sch, inputs, inst->attrs, decision);
+    TranslateAddOutputRVs(inst->outputs, outputs, &rv_map);
+    if (!decision.defined() && is_deterministic) {
+      Trace replayed = sch->trace().value();
+      is_deterministic = !replayed->GetDecision(replayed->insts.back()).defined();
+    }
+  }
+  return sch;
+}
+
+std::vector<TracePrefixCache::SnapshotPtr> TracePrefixCache::Get(size_t hash) {
+  std::vector<SnapshotPtr> results;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = index_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    results.push_back(*it->second);
+  }
+  return results;
+}
+
+void TracePrefixCache::Touch(const SnapshotPtr& snapshot) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto range = index_.equal_range(snapshot->hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (*it->second == snapshot) {
+      snapshots_.splice(snapshots_.begin(), snapshots_, it->second);
+      return;
+    }
+  }
+}
+
+void TracePrefixCache::Put(size_t hash, const Schedule& sch) {
+  if (capacity_ == 0) {
+    return;
+  }
+  SnapshotPtr snapshot = std::make_shared<Snapshot>();
+  snapshot->hash = hash;
+  snapshot->sch = sch->Copy();
+  std::lock_guard<std::mutex> lock(mutex_);
+  snapshots_.push_front(std::move(snapshot));
+  index_.emplace(hash, snapshots_.begin());
+  while (snapshots_.size() > capacity_) {
+    std::list<SnapshotPtr>::iterator last = std::prev(snapshots_.end());
+    auto range = index_.equal_range((*last)->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        index_.erase(it);
+        break;
+      }
+    }
+    snapshots_.pop_back();
+  }
+}
+
+}  // namespace meta_schedule
+}  // namespace tvm
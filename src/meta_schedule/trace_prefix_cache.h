@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef TVM_META_SCHEDULE_TRACE_PREFIX_CACHE_H_
+#define TVM_META_SCHEDULE_TRACE_PREFIX_CACHE_H_
+
+#include <tvm/support/random_engine.h>
+#include <tvm/tir/schedule/schedule.h>
+#include <tvm/tir/schedule/trace.h>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace meta_schedule {
+
+/*!
+ * \brief A thread-safe cache of the schedules replayed up to the prefixes of traces, so that a
+ * trace only differing from a trace replayed before in its later decisions, e.g. a mutated one,
+ * resumes from the schedule of their common prefix instead of being replayed from scratch.
+ *
+ * The prefixes cached end right before the instructions with a decision, which are the points
+ * where mutated traces start to differ. Two prefixes match if their instructions have the same
+ * kinds, attributes and decisions, and take the same inputs, where the random variables are
+ * compared by the instructions producing them.
+ */
+class TracePrefixCache {
+ public:
+  using TRandState = support::LinearCongruentialEngine::TRandState;
+
+  /*!
+   * \brief Constructor
+   * \param capacity The maximum number of prefixes cached, evicting the least recently used.
+   */
+  explicit TracePrefixCache(size_t capacity) : capacity_(capacity) {}
+
+  /*!
+   * \brief Replay a trace up to its postprocessing instructions, resuming from the schedule of
+   * its longest prefix cached, and cache the schedules of its prefixes replayed.
+   * \param trace The trace to replay.
+   * \param f_fork The function creating a fresh schedule, to replay the trace from scratch.
+   * \param rand_state The random state to seed the schedule resumed with.
+   * \return The schedule with the trace replayed.
+   */
+  tir::Schedule Apply(const tir::Trace& trace, const std::function<tir::Schedule()>& f_fork,
+                      TRandState* rand_state);
+
+ private:
+  /*! \brief The schedule replayed up to a prefix of a trace. */
+  struct Snapshot {
+    /*! \brief The hash of the prefix. */
+    size_t hash;
+    /*! \brief The schedule, never modified but copied. Its trace is the prefix replayed. */
+    tir::Schedule sch;
+    /*! \brief The mutex guarding the copying of the schedule. */
+    std::mutex mutex;
+  };
+  using SnapshotPtr = std::shared_ptr<Snapshot>;
+
+  /*! \return The snapshots whose prefix has the hash given. */
+  std::vector<SnapshotPtr> Get(size_t hash);
+  /*! \brief Mark a snapshot as the most recently used, if it is not evicted yet. */
+  void Touch(const SnapshotPtr& snapshot);
+  /*! \brief Cache a snapshot, evicting the least recently used one if full. */
+  void Put(size_t hash, const tir::Schedule& sch);
+
+  /*! \brief The maximum number of prefixes cached. */
+  size_t capacity_;
+  /*! \brief The mutex guarding `snapshots_` and `index_`. */
+  std::mutex mutex_;
+  /*! \brief The snapshots, from the most recently used to the least. */
+  std::list<SnapshotPtr> snapshots_;
+  /*! \brief The snapshots indexed by the hash of their prefix. */
+  std::unordered_multimap<size_t, std::list<SnapshotPtr>::iterator> index_;
+};
+
+}  // namespace meta_schedule
+}  // namespace tvm
+
+#endif  // TVM_META_SCHEDULE_TRACE_PREFIX_CACHE_H_
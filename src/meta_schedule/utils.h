@@ -43,7 +43,11 @@
 #include <tvm/tir/transform.h>
 
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -55,6 +59,7 @@
 #include "../support/utils.h"
 #include "../tir/schedule/primitive.h"
 #include "../tir/schedule/utils.h"
+#include "./trace_prefix_cache.h"
 
 #define TVM_PY_LOG(logging_level, logger)                                \
   ::tvm::meta_schedule::PyLogMessage(__FILE__, __LINE__, logger,         \
@@ -303,9 +308,24 @@ inline tir::BlockRV GetRVFromSRef(const tir::Schedule& sch, const tir::StmtSRef&
  * for each postprocessor
  */
 struct ThreadedTraceApply {
-  /*! \brief Constructor */
-  explicit ThreadedTraceApply(const Array<Postproc>& postprocs)
-      : n_(postprocs.size()), items_(new Item[n_]) {
+  /*!
+   * \brief A cheap check of the schedule before it is postprocessed, which returns false to reject
+   * the schedule
+   */
+  using FPrecheck = std::function<bool(const tir::Schedule&)>;
+
+  /*!
+   * \brief Constructor
+   * \param postprocs The postprocessors
+   * \param precheck The check before postprocessing, nullptr if none
+   * \param prefix_cache The cache of trace prefixes to resume the replays from, nullptr if none
+   */
+  explicit ThreadedTraceApply(const Array<Postproc>& postprocs, FPrecheck precheck = nullptr,
+                              TracePrefixCache* prefix_cache = nullptr)
+      : n_(postprocs.size()),
+        items_(new Item[n_]),
+        precheck_(std::move(precheck)),
+        prefix_cache_(prefix_cache) {
     for (int i = 0; i < n_; ++i) {
       items_[i].postproc = postprocs[i];
       items_[i].fail_counter = 0;
@@ -320,19 +340,31 @@ struct ThreadedTraceApply {
    * \param mod The IRModule to be applied
    * \param trace The trace to apply to the IRModule
    * \param rand_state The random seed
-   * \return The schedule created, or NullOpt if any postprocessor fails
+   * \return The schedule created, or NullOpt if the precheck or any postprocessor fails
    */
   Optional<tir::Schedule> Apply(const IRModule& mod, const tir::Trace& trace,
                                 TRandState* rand_state) {
-    tir::Schedule sch =
-        tir::Schedule::Traced(mod,
-                              /*rand_state=*/ForkSeed(rand_state),
-                              /*debug_mode=*/0,
-                              /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
-
-    trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
+    tir::Schedule sch{nullptr};
+    {
+      auto _ = Profiler::TimedScope("TraceApply/Replay");
+      if (prefix_cache_ != nullptr) {
+        sch = prefix_cache_->Apply(
+            trace, [this, &mod, rand_state]() { return Fork(mod, rand_state); }, rand_state);
+      } else {
+        sch = Fork(mod, rand_state);
+        trace->ApplyToSchedule(sch, /*remove_postproc=*/true);
+      }
+    }
+    if (precheck_ != nullptr) {
+      auto _ = Profiler::TimedScope("TraceApply/Precheck");
+      if (!precheck_(sch)) {
+        precheck_fail_counter_++;
+        return NullOpt;
+      }
+    }
     sch->EnterPostproc();
 
+    auto _ = Profiler::TimedScope("TraceApply/Postproc");
     for (int i = 0; i < n_; ++i) {
       Item& item = items_[i];
       if (!item.postproc->Apply(sch)) {
@@ -343,9 +375,49 @@ struct ThreadedTraceApply {
     return sch;
   }
 
+  /*!
+   * \brief Fork a fresh schedule of an IRModule. The schedule state of each module, including
+   * its sref tree and block info, is built once and copied afterwards, which is much cheaper than
+   * building it again for every trace applied.
+   * \param mod The IRModule to be scheduled
+   * \param rand_state The random seed
+   * \return The schedule forked, with an empty trace
+   */
+  tir::Schedule Fork(const IRModule& mod, TRandState* rand_state) {
+    InitSchedule* init = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(init_schs_mutex_);
+      std::unique_ptr<InitSchedule>& entry = init_schs_[mod.get()];
+      if (entry == nullptr) {
+        entry = std::make_unique<InitSchedule>();
+        entry->mod = mod;
+        entry->sch =
+            tir::Schedule::Traced(mod,
+                                  /*rand_state=*/-1,
+                                  /*debug_mode=*/0,
+                                  /*error_render_level=*/tir::ScheduleErrorRenderLevel::kNone);
+      }
+      init = entry.get();
+    }
+    tir::Schedule sch{nullptr};
+    {
+      // Copying forks the random state of the initial schedule, so it is guarded
+      std::lock_guard<std::mutex> lock(init->mutex);
+      sch = init->sch->Copy();
+    }
+    sch->Seed(ForkSeed(rand_state));
+    return sch;
+  }
+
   /*! \brief Returns a string summarizing the failures on each postprocessor */
   std::string SummarizeFailures() const {
     std::ostringstream os;
+    if (precheck_ != nullptr) {
+      os << "Precheck: " << precheck_fail_counter_.load() << " rejection(s)";
+      if (n_ != 0) {
+        os << "\n";
+      }
+    }
     for (int i = 0; i < n_; ++i) {
       const Item& item = items_[i];
       os << "Postproc #" << i << " [" << item.postproc  //
@@ -366,10 +438,30 @@ struct ThreadedTraceApply {
     std::atomic<int> fail_counter{0};
   };
 
+  /*! \brief The schedule of an IRModule before any trace is applied. */
+  struct InitSchedule {
+    /*! \brief The IRModule, kept alive so that its address is not reused. */
+    IRModule mod{nullptr};
+    /*! \brief The schedule, never modified but copied. */
+    tir::Schedule sch{nullptr};
+    /*! \brief The mutex guarding the copying of the schedule. */
+    std::mutex mutex;
+  };
+
   /*! \brief The number of total postprocessors. */
   int n_;
   /*! \brief The pointer to the list of postprocessor items. */
   Item* items_;
+  /*! \brief The check before postprocessing, nullptr if none. */
+  FPrecheck precheck_;
+  /*! \brief The thread-safe counter of the schedules rejected by the precheck. */
+  std::atomic<int> precheck_fail_counter_{0};
+  /*! \brief The cache of trace prefixes, not owned, nullptr if none. */
+  TracePrefixCache* prefix_cache_;
+  /*! \brief The initial schedule of each IRModule scheduled, keyed by the module. */
+  std::unordered_map<const IRModuleNode*, std::unique_ptr<InitSchedule>> init_schs_;
+  /*! \brief The mutex guarding `init_schs_`. */
+  std::mutex init_schs_mutex_;
 };
 
 /*!
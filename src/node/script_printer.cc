@@ -21,6 +21,8 @@
 #include <tvm/node/script_printer.h>
 #include <tvm/runtime/registry.h>
 
+#include <fstream>
+
 namespace tvm {
 
 TVMScriptPrinter::FType& TVMScriptPrinter::vtable() {
@@ -35,6 +37,20 @@ std::string TVMScriptPrinter::Script(const ObjectRef& node, const Optional<Print
   return TVMScriptPrinter::vtable()(node, cfg.value_or(PrinterConfig()));
 }
 
+TVMScriptPrinter::FStreamType& TVMScriptPrinter::stream_vtable() {
+  static FStreamType inst;
+  return inst;
+}
+
+void TVMScriptPrinter::ScriptToStream(const ObjectRef& node, const Optional<PrinterConfig>& cfg,
+                                      std::ostream* os) {
+  if (node.defined() && TVMScriptPrinter::stream_vtable().can_dispatch(node)) {
+    TVMScriptPrinter::stream_vtable()(node, cfg.value_or(PrinterConfig()), os);
+  } else {
+    *os << TVMScriptPrinter::Script(node, cfg);
+  }
+}
+
 PrinterConfig::PrinterConfig(Map<String, ObjectRef> config_dict) {
   runtime::ObjectPtr<PrinterConfigNode> n = make_object<PrinterConfigNode>();
   if (auto v = config_dict.Get("name")) {
@@ -88,6 +104,9 @@ PrinterConfig::PrinterConfig(Map<String, ObjectRef> config_dict) {
   if (auto v = config_dict.Get("syntax_sugar")) {
     n->syntax_sugar = Downcast<IntImm>(v)->value;
   }
+  if (auto v = config_dict.Get("max_constant_elems")) {
+    n->max_constant_elems = Downcast<IntImm>(v)->value;
+  }
   this->data_ = std::move(n);
 }
 
@@ -96,5 +115,13 @@ TVM_REGISTER_GLOBAL("node.PrinterConfig").set_body_typed([](Map<String, ObjectRe
   return PrinterConfig(config_dict);
 });
 TVM_REGISTER_GLOBAL("node.TVMScriptPrinterScript").set_body_typed(TVMScriptPrinter::Script);
+TVM_REGISTER_GLOBAL("node.TVMScriptPrinterScriptToFile")
+    .set_body_typed([](ObjectRef node, Optional<PrinterConfig> cfg, String path) {
+      std::ofstream os(path);
+      ICHECK(os) << "ValueError: Cannot open " << path << " for writing";
+      TVMScriptPrinter::ScriptToStream(node, cfg, &os);
+      os << '\n';
+      ICHECK(os) << "IOError: Failed to write TVMScript to " << path;
+    });
 
 }  // namespace tvm
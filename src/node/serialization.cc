@@ -32,9 +32,16 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "../runtime/object_internal.h"
 #include "../support/base64.h"
@@ -468,6 +475,43 @@ class JSONAttrSetter : public AttrVisitor {
   }
 };
 
+// Sort the nodes so that every node comes after the nodes in its data and fields.
+template <typename TNode>
+std::vector<size_t> TopoSortNodes(const std::vector<TNode>& nodes) {
+  size_t n_nodes = nodes.size();
+  std::vector<size_t> topo_order;
+  std::vector<size_t> in_degree(n_nodes, 0);
+  for (const TNode& jnode : nodes) {
+    for (size_t i : jnode.data) {
+      ++in_degree[i];
+    }
+    for (size_t i : jnode.fields) {
+      ++in_degree[i];
+    }
+  }
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (in_degree[i] == 0) {
+      topo_order.push_back(i);
+    }
+  }
+  for (size_t p = 0; p < topo_order.size(); ++p) {
+    const TNode& jnode = nodes[topo_order[p]];
+    for (size_t i : jnode.data) {
+      if (--in_degree[i] == 0) {
+        topo_order.push_back(i);
+      }
+    }
+    for (size_t i : jnode.fields) {
+      if (--in_degree[i] == 0) {
+        topo_order.push_back(i);
+      }
+    }
+  }
+  ICHECK_EQ(topo_order.size(), n_nodes) << "Cyclic reference detected in the serialized graph";
+  std::reverse(std::begin(topo_order), std::end(topo_order));
+  return topo_order;
+}
+
 // json graph structure to store node
 struct JSONGraph {
   // the root of the graph
@@ -527,40 +571,7 @@ struct JSONGraph {
     return g;
   }
 
-  std::vector<size_t> TopoSort() const {
-    size_t n_nodes = nodes.size();
-    std::vector<size_t> topo_order;
-    std::vector<size_t> in_degree(n_nodes, 0);
-    for (const JSONNode& jnode : nodes) {
-      for (size_t i : jnode.data) {
-        ++in_degree[i];
-      }
-      for (size_t i : jnode.fields) {
-        ++in_degree[i];
-      }
-    }
-    for (size_t i = 0; i < n_nodes; ++i) {
-      if (in_degree[i] == 0) {
-        topo_order.push_back(i);
-      }
-    }
-    for (size_t p = 0; p < topo_order.size(); ++p) {
-      const JSONNode& jnode = nodes[topo_order[p]];
-      for (size_t i : jnode.data) {
-        if (--in_degree[i] == 0) {
-          topo_order.push_back(i);
-        }
-      }
-      for (size_t i : jnode.fields) {
-        if (--in_degree[i] == 0) {
-          topo_order.push_back(i);
-        }
-      }
-    }
-    ICHECK_EQ(topo_order.size(), n_nodes) << "Cyclic reference detected in JSON file";
-    std::reverse(std::begin(topo_order), std::end(topo_order));
-    return topo_order;
-  }
+  std::vector<size_t> TopoSort() const { return TopoSortNodes(nodes); }
 };
 
 std::string SaveJSON(const ObjectRef& n) {
@@ -622,7 +633,529 @@ ObjectRef LoadJSON(std::string json_str) {
   return ObjectRef(nodes.at(jgraph.root));
 }
 
+/*!
+ * \brief The binary format of a graph, all numbers are little endian.
+ *
+ * \code
+ *
+ *  uint64 kTVMNodeBinaryMagic
+ *  uint32 kTVMNodeBinaryVersion
+ *  uint32 the string id of the TVM version
+ *  uint64 number of strings, then per string: uint64 size, bytes
+ *  uint64 root node
+ *  uint64 number of nodes, then per node:
+ *    uint32 string id of the type key, kBinaryNoString for None
+ *    uint8 BinaryNodeKind and the content of the kind
+ *  uint64 number of tensors, then per tensor:
+ *    DLDataType, int32 ndim, int64 shape[ndim], uint64 number of bytes,
+ *    zero padding to kBinaryTensorAlignment from the start, bytes
+ *
+ * \endcode
+ *
+ *  Every string, the type keys and field names included, is stored once in the string
+ *  table, and fields are stored by the id of their name so that loading does not depend
+ *  on the order of the fields.
+ */
+constexpr uint64_t kTVMNodeBinaryMagic = 0x4245444F4E4D5654;  // "TVMNODEB"
+constexpr uint32_t kTVMNodeBinaryVersion = 1;
+constexpr uint32_t kBinaryNoString = std::numeric_limits<uint32_t>::max();
+constexpr size_t kBinaryTensorAlignment = 64;
+
+/*! \brief The content of a node in the binary format. */
+enum class BinaryNodeKind : uint8_t {
+  /*! \brief uint32 string id of the repr bytes. */
+  kReprBytes = 0,
+  /*! \brief uint64 size, then uint64 node per element. */
+  kArray = 1,
+  /*! \brief uint64 size, then uint32 string id of the key and uint64 node per element. */
+  kStrMap = 2,
+  /*! \brief uint64 size, then uint64 key node and uint64 value node per element. */
+  kMap = 3,
+  /*! \brief uint32 number of fields, then a BinaryField per field. */
+  kFields = 4,
+};
+
+/*! \brief The type of the value of a field in the binary format. */
+enum class BinaryFieldType : uint8_t {
+  kInt = 0,
+  kUInt = 1,
+  kDouble = 2,
+  kBool = 3,
+  kString = 4,
+  kDataType = 5,
+  kTensor = 6,
+  kObject = 7,
+};
+
+/*! \brief A field in the binary format, stored as uint32 key, uint8 type and uint64 value. */
+struct BinaryField {
+  /*! \brief The string id of the field name. */
+  uint32_t key;
+  /*! \brief The type of the value. */
+  BinaryFieldType type;
+  /*! \brief The value, or the string id, tensor or node of it. */
+  uint64_t value;
+};
+
+/*! \brief A node in the binary format. */
+struct BinaryNode {
+  /*! \brief The string id of the type key. */
+  uint32_t type_key{kBinaryNoString};
+  /*! \brief The content of the node. */
+  BinaryNodeKind kind{BinaryNodeKind::kFields};
+  /*! \brief The string id of the repr bytes. */
+  uint32_t repr_bytes{kBinaryNoString};
+  /*! \brief The string ids of the keys of a map. */
+  std::vector<uint32_t> keys;
+  /*! \brief The values of a map or array. */
+  std::vector<size_t> data;
+  /*! \brief The fields of the node. */
+  std::vector<BinaryField> attrs;
+  /*! \brief The nodes of the object fields, the dependencies for loading. */
+  std::vector<size_t> fields;
+};
+
+// Append the binary format of a graph to a string.
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(std::string* out) : out_(out) {}
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Can only write plain values");
+    WriteBytes(&value, sizeof(T));
+  }
+  void WriteBytes(const void* data, size_t size) {
+    out_->append(static_cast<const char*>(data), size);
+  }
+  void Align(size_t alignment) {
+    out_->resize((out_->size() + alignment - 1) / alignment * alignment);
+  }
+
+ private:
+  std::string* out_;
+};
+
+// Read the binary format of a graph from a string.
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  T Read() {
+    static_assert(std::is_trivially_copyable<T>::value, "Can only read plain values");
+    T value;
+    std::memcpy(&value, ReadBytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+  const char* ReadBytes(size_t size) {
+    ICHECK_LE(size, size_ - pos_) << "The binary serialized graph is truncated";
+    const char* ptr = data_ + pos_;
+    pos_ += size;
+    return ptr;
+  }
+  void Align(size_t alignment) { ReadBytes((pos_ + alignment - 1) / alignment * alignment - pos_); }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t pos_{0};
+};
+
+// Helper class to populate the binary node
+// using the existing index.
+class BinaryAttrGetter : public AttrVisitor {
+ public:
+  const std::unordered_map<Object*, size_t>* node_index_;
+  const std::unordered_map<DLTensor*, size_t>* tensor_index_;
+  BinaryNode* node_;
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  // Get the id of a string in the string table.
+  uint32_t Intern(const std::string& value) {
+    auto it = string_index_.emplace(value, static_cast<uint32_t>(strings_.size()));
+    if (it.second) {
+      ICHECK_LT(strings_.size(), kBinaryNoString) << "Too many strings to serialize";
+      strings_.push_back(&it.first->first);
+    }
+    return it.first->second;
+  }
+
+  void Visit(const char* key, double* value) final {
+    uint64_t bits;
+    std::memcpy(&bits, value, sizeof(bits));
+    Add(key, BinaryFieldType::kDouble, bits);
+  }
+  void Visit(const char* key, int64_t* value) final {
+    Add(key, BinaryFieldType::kInt, static_cast<uint64_t>(*value));
+  }
+  void Visit(const char* key, uint64_t* value) final { Add(key, BinaryFieldType::kUInt, *value); }
+  void Visit(const char* key, int* value) final {
+    Add(key, BinaryFieldType::kInt, static_cast<uint64_t>(static_cast<int64_t>(*value)));
+  }
+  void Visit(const char* key, bool* value) final { Add(key, BinaryFieldType::kBool, *value); }
+  void Visit(const char* key, std::string* value) final {
+    Add(key, BinaryFieldType::kString, Intern(*value));
+  }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to serialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    DLDataType dtype = *value;
+    Add(key, BinaryFieldType::kDataType,
+        static_cast<uint64_t>(dtype.code) | (static_cast<uint64_t>(dtype.bits) << 8) |
+            (static_cast<uint64_t>(dtype.lanes) << 16));
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    Add(key, BinaryFieldType::kTensor,
+        tensor_index_->at(const_cast<DLTensor*>((*value).operator->())));
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    Add(key, BinaryFieldType::kObject, node_index_->at(const_cast<Object*>(value->get())));
+  }
+
+  // Get the node
+  void Get(Object* node) {
+    *node_ = BinaryNode();
+    if (node == nullptr) return;
+    node_->type_key = Intern(node->GetTypeKey());
+    std::string repr_bytes;
+    if (reflection_->GetReprBytes(node, &repr_bytes)) {
+      node_->kind = BinaryNodeKind::kReprBytes;
+      node_->repr_bytes = Intern(repr_bytes);
+    } else if (node->IsInstance<ArrayNode>()) {
+      ArrayNode* n = static_cast<ArrayNode*>(node);
+      node_->kind = BinaryNodeKind::kArray;
+      for (size_t i = 0; i < n->size(); ++i) {
+        node_->data.push_back(node_index_->at(const_cast<Object*>(n->at(i).get())));
+      }
+    } else if (node->IsInstance<MapNode>()) {
+      MapNode* n = static_cast<MapNode*>(node);
+      bool is_str_map = std::all_of(n->begin(), n->end(), [](const auto& v) {
+        return v.first->template IsInstance<StringObj>();
+      });
+      node_->kind = is_str_map ? BinaryNodeKind::kStrMap : BinaryNodeKind::kMap;
+      for (const auto& kv : *n) {
+        if (is_str_map) {
+          node_->keys.push_back(Intern(Downcast<String>(kv.first)));
+        } else {
+          node_->data.push_back(node_index_->at(const_cast<Object*>(kv.first.get())));
+        }
+        node_->data.push_back(node_index_->at(const_cast<Object*>(kv.second.get())));
+      }
+    } else {
+      node_->kind = BinaryNodeKind::kFields;
+      reflection_->VisitAttrs(node, this);
+    }
+  }
+
+  /*! \brief The string table, in the order of the ids. */
+  std::vector<const std::string*> strings_;
+
+ private:
+  void Add(const char* key, BinaryFieldType type, uint64_t value) {
+    node_->attrs.push_back({Intern(key), type, value});
+  }
+
+  std::unordered_map<std::string, uint32_t> string_index_;
+};
+
+// Helper class to set the attributes of a node
+// from given binary node.
+class BinaryAttrSetter : public AttrVisitor {
+ public:
+  const std::vector<std::string>* strings_;
+  const std::vector<ObjectPtr<Object>>* node_list_;
+  const std::vector<runtime::NDArray>* tensor_list_;
+  BinaryNode* node_;
+
+  ReflectionVTable* reflection_ = ReflectionVTable::Global();
+
+  void Visit(const char* key, double* value) final {
+    uint64_t bits = GetValue(key, BinaryFieldType::kDouble);
+    std::memcpy(value, &bits, sizeof(bits));
+  }
+  void Visit(const char* key, int64_t* value) final {
+    *value = static_cast<int64_t>(GetValue(key, BinaryFieldType::kInt));
+  }
+  void Visit(const char* key, uint64_t* value) final {
+    *value = GetValue(key, BinaryFieldType::kUInt);
+  }
+  void Visit(const char* key, int* value) final {
+    *value = static_cast<int>(static_cast<int64_t>(GetValue(key, BinaryFieldType::kInt)));
+  }
+  void Visit(const char* key, bool* value) final {
+    *value = GetValue(key, BinaryFieldType::kBool) != 0;
+  }
+  void Visit(const char* key, std::string* value) final {
+    *value = GetString(GetValue(key, BinaryFieldType::kString));
+  }
+  void Visit(const char* key, void** value) final {
+    LOG(FATAL) << "not allowed to deserialize a pointer";
+  }
+  void Visit(const char* key, DataType* value) final {
+    uint64_t bits = GetValue(key, BinaryFieldType::kDataType);
+    DLDataType dtype;
+    dtype.code = static_cast<uint8_t>(bits & 0xFF);
+    dtype.bits = static_cast<uint8_t>((bits >> 8) & 0xFF);
+    dtype.lanes = static_cast<uint16_t>((bits >> 16) & 0xFFFF);
+    *value = DataType(dtype);
+  }
+  void Visit(const char* key, runtime::NDArray* value) final {
+    *value = tensor_list_->at(GetValue(key, BinaryFieldType::kTensor));
+  }
+  void Visit(const char* key, ObjectRef* value) final {
+    *value = ObjectRef(node_list_->at(GetValue(key, BinaryFieldType::kObject)));
+  }
+
+  // set node to be current binary node
+  void Set(ObjectPtr<Object>* node, BinaryNode* bnode) {
+    // Skip None and the objects that have their own repr bytes
+    if (node->get() == nullptr || bnode->kind == BinaryNodeKind::kReprBytes) {
+      return;
+    }
+    if (bnode->kind == BinaryNodeKind::kArray) {
+      std::vector<ObjectRef> container;
+      container.reserve(bnode->data.size());
+      for (size_t index : bnode->data) {
+        container.push_back(ObjectRef(node_list_->at(index)));
+      }
+      Array<ObjectRef> array(container);
+      *node = runtime::ObjectInternal::MoveObjectPtr(&array);
+      return;
+    }
+    if (bnode->kind == BinaryNodeKind::kStrMap || bnode->kind == BinaryNodeKind::kMap) {
+      std::unordered_map<ObjectRef, ObjectRef, ObjectHash, ObjectEqual> container;
+      if (bnode->kind == BinaryNodeKind::kStrMap) {
+        ICHECK_EQ(bnode->data.size(), bnode->keys.size());
+        for (size_t i = 0; i < bnode->data.size(); ++i) {
+          container[String(GetString(bnode->keys[i]))] = ObjectRef(node_list_->at(bnode->data[i]));
+        }
+      } else {
+        ICHECK_EQ(bnode->data.size() % 2, 0U);
+        for (size_t i = 0; i < bnode->data.size(); i += 2) {
+          container[ObjectRef(node_list_->at(bnode->data[i]))] =
+              ObjectRef(node_list_->at(bnode->data[i + 1]));
+        }
+      }
+      Map<ObjectRef, ObjectRef> map(container);
+      *node = runtime::ObjectInternal::MoveObjectPtr(&map);
+      return;
+    }
+    node_ = bnode;
+    reflection_->VisitAttrs(node->get(), this);
+  }
+
+ private:
+  const std::string& GetString(uint64_t id) const {
+    ICHECK_LT(id, strings_->size()) << "Invalid string id in the binary serialized graph";
+    return (*strings_)[id];
+  }
+
+  uint64_t GetValue(const char* key, BinaryFieldType type) const {
+    for (const BinaryField& field : node_->attrs) {
+      if (GetString(field.key) == key) {
+        ICHECK(field.type == type) << "Wrong value type for field " << key;
+        return field.value;
+      }
+    }
+    LOG(FATAL) << "BinaryReader: cannot find field " << key;
+    return 0;
+  }
+};
+
+std::string SaveBinary(const ObjectRef& n) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "The binary serialization needs a little endian host";
+  NodeIndexer indexer;
+  indexer.MakeIndex(const_cast<Object*>(n.get()));
+  BinaryAttrGetter getter;
+  getter.node_index_ = &indexer.node_index_;
+  getter.tensor_index_ = &indexer.tensor_index_;
+  uint32_t version = getter.Intern(TVM_VERSION);
+  std::vector<BinaryNode> nodes(indexer.node_list_.size());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    getter.node_ = &nodes[i];
+    getter.Get(indexer.node_list_[i]);
+  }
+
+  std::string blob;
+  BinaryWriter writer(&blob);
+  writer.Write(kTVMNodeBinaryMagic);
+  writer.Write(kTVMNodeBinaryVersion);
+  writer.Write(version);
+  writer.Write(static_cast<uint64_t>(getter.strings_.size()));
+  for (const std::string* str : getter.strings_) {
+    writer.Write(static_cast<uint64_t>(str->size()));
+    writer.WriteBytes(str->data(), str->size());
+  }
+  writer.Write(static_cast<uint64_t>(indexer.node_index_.at(const_cast<Object*>(n.get()))));
+  writer.Write(static_cast<uint64_t>(nodes.size()));
+  for (const BinaryNode& node : nodes) {
+    writer.Write(node.type_key);
+    if (node.type_key == kBinaryNoString) continue;
+    writer.Write(node.kind);
+    switch (node.kind) {
+      case BinaryNodeKind::kReprBytes:
+        writer.Write(node.repr_bytes);
+        break;
+      case BinaryNodeKind::kArray:
+      case BinaryNodeKind::kMap:
+        writer.Write(static_cast<uint64_t>(node.data.size()));
+        for (size_t index : node.data) {
+          writer.Write(static_cast<uint64_t>(index));
+        }
+        break;
+      case BinaryNodeKind::kStrMap:
+        writer.Write(static_cast<uint64_t>(node.data.size()));
+        for (size_t i = 0; i < node.data.size(); ++i) {
+          writer.Write(node.keys[i]);
+          writer.Write(static_cast<uint64_t>(node.data[i]));
+        }
+        break;
+      case BinaryNodeKind::kFields:
+        writer.Write(static_cast<uint32_t>(node.attrs.size()));
+        for (const BinaryField& field : node.attrs) {
+          writer.Write(field.key);
+          writer.Write(field.type);
+          writer.Write(field.value);
+        }
+        break;
+    }
+  }
+  writer.Write(static_cast<uint64_t>(indexer.tensor_list_.size()));
+  for (DLTensor* tensor : indexer.tensor_list_) {
+    writer.Write(tensor->dtype);
+    writer.Write(tensor->ndim);
+    writer.WriteBytes(tensor->shape, sizeof(int64_t) * tensor->ndim);
+    uint64_t data_byte_size = runtime::GetDataSize(*tensor);
+    writer.Write(data_byte_size);
+    writer.Align(kBinaryTensorAlignment);
+    if (tensor->device.device_type == kDLCPU && runtime::IsContiguous(*tensor)) {
+      writer.WriteBytes(static_cast<const char*>(tensor->data) + tensor->byte_offset,
+                        data_byte_size);
+    } else {
+      std::vector<uint8_t> bytes(data_byte_size);
+      ICHECK_EQ(TVMArrayCopyToBytes(tensor, bytes.data(), data_byte_size), 0) << TVMGetLastError();
+      writer.WriteBytes(bytes.data(), data_byte_size);
+    }
+  }
+  return blob;
+}
+
+ObjectRef LoadBinary(const std::string& blob) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "The binary serialization needs a little endian host";
+  ReflectionVTable* reflection = ReflectionVTable::Global();
+  BinaryReader reader(blob.data(), blob.size());
+  ICHECK_EQ(reader.Read<uint64_t>(), kTVMNodeBinaryMagic) << "Not a binary serialized graph";
+  uint32_t version = reader.Read<uint32_t>();
+  ICHECK_LE(version, kTVMNodeBinaryVersion)
+      << "The binary serialized graph is newer than this TVM can load";
+  reader.Read<uint32_t>();
+  std::vector<std::string> strings(reader.Read<uint64_t>());
+  for (std::string& str : strings) {
+    uint64_t size = reader.Read<uint64_t>();
+    str.assign(reader.ReadBytes(size), size);
+  }
+  size_t root = reader.Read<uint64_t>();
+  std::vector<BinaryNode> bnodes(reader.Read<uint64_t>());
+  auto read_index = [&]() {
+    uint64_t index = reader.Read<uint64_t>();
+    ICHECK_LT(index, bnodes.size()) << "Invalid node in the binary serialized graph";
+    return static_cast<size_t>(index);
+  };
+  for (BinaryNode& bnode : bnodes) {
+    bnode.type_key = reader.Read<uint32_t>();
+    if (bnode.type_key == kBinaryNoString) continue;
+    bnode.kind = reader.Read<BinaryNodeKind>();
+    switch (bnode.kind) {
+      case BinaryNodeKind::kReprBytes:
+        bnode.repr_bytes = reader.Read<uint32_t>();
+        break;
+      case BinaryNodeKind::kArray:
+      case BinaryNodeKind::kMap:
+        bnode.data.resize(reader.Read<uint64_t>());
+        for (size_t& index : bnode.data) {
+          index = read_index();
+        }
+        break;
+      case BinaryNodeKind::kStrMap: {
+        uint64_t size = reader.Read<uint64_t>();
+        for (uint64_t i = 0; i < size; ++i) {
+          bnode.keys.push_back(reader.Read<uint32_t>());
+          bnode.data.push_back(read_index());
+        }
+        break;
+      }
+      case BinaryNodeKind::kFields: {
+        bnode.attrs.resize(reader.Read<uint32_t>());
+        for (BinaryField& field : bnode.attrs) {
+          field.key = reader.Read<uint32_t>();
+          field.type = reader.Read<BinaryFieldType>();
+          field.value = reader.Read<uint64_t>();
+          if (field.type == BinaryFieldType::kObject) {
+            ICHECK_LT(field.value, bnodes.size()) << "Invalid node in the binary serialized graph";
+            bnode.fields.push_back(static_cast<size_t>(field.value));
+          }
+        }
+        break;
+      }
+      default:
+        LOG(FATAL) << "Invalid node kind in the binary serialized graph";
+    }
+  }
+  ICHECK_LT(root, bnodes.size()) << "Invalid root in the binary serialized graph";
+  std::vector<runtime::NDArray> tensors(reader.Read<uint64_t>());
+  for (runtime::NDArray& tensor : tensors) {
+    DLDataType dtype = reader.Read<DLDataType>();
+    int ndim = reader.Read<int>();
+    std::vector<int64_t> shape(ndim);
+    std::memcpy(shape.data(), reader.ReadBytes(sizeof(int64_t) * ndim), sizeof(int64_t) * ndim);
+    uint64_t data_byte_size = reader.Read<uint64_t>();
+    reader.Align(kBinaryTensorAlignment);
+    tensor = runtime::NDArray::Empty(ShapeTuple(shape), dtype, {kDLCPU, 0});
+    ICHECK_EQ(runtime::GetDataSize(*tensor.operator->()), data_byte_size)
+        << "Wrong tensor size in the binary serialized graph";
+    std::memcpy(tensor->data, reader.ReadBytes(data_byte_size), data_byte_size);
+  }
+
+  auto get_string = [&](uint32_t id) -> const std::string& {
+    ICHECK_LT(id, strings.size()) << "Invalid string id in the binary serialized graph";
+    return strings[id];
+  };
+  // Pass 1: create all non-container objects
+  std::vector<ObjectPtr<Object>> nodes(bnodes.size(), nullptr);
+  for (size_t i = 0; i < bnodes.size(); ++i) {
+    const BinaryNode& bnode = bnodes[i];
+    if (bnode.type_key != kBinaryNoString) {
+      nodes[i] = reflection->CreateInitObject(
+          get_string(bnode.type_key),
+          bnode.kind == BinaryNodeKind::kReprBytes ? get_string(bnode.repr_bytes) : "");
+    }
+  }
+  // Pass 2: topo sort, the field dependencies are recorded while reading
+  std::vector<size_t> topo_order = TopoSortNodes(bnodes);
+  // Pass 3: set all values
+  BinaryAttrSetter setter;
+  setter.strings_ = &strings;
+  setter.node_list_ = &nodes;
+  setter.tensor_list_ = &tensors;
+  for (size_t i : topo_order) {
+    setter.Set(&nodes[i], &bnodes[i]);
+  }
+  return ObjectRef(nodes.at(root));
+}
+
 TVM_REGISTER_GLOBAL("node.SaveJSON").set_body_typed(SaveJSON);
 
 TVM_REGISTER_GLOBAL("node.LoadJSON").set_body_typed(LoadJSON);
+
+TVM_REGISTER_GLOBAL("node.SaveBinary").set_body([](TVMArgs args, TVMRetValue* rv) {
+  std::string blob = SaveBinary(args[0]);
+  TVMByteArray arr;
+  arr.data = blob.data();
+  arr.size = blob.size();
+  *rv = arr;
+});
+
+TVM_REGISTER_GLOBAL("node.LoadBinary").set_body_typed(LoadBinary);
 }  // namespace tvm
@@ -26,8 +26,15 @@
 #include <tvm/node/reflection.h>
 #include <tvm/node/structural_equal.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "ndarray_hash_equal.h"
 
@@ -253,6 +260,10 @@ class SEqualHandlerDefault::Impl {
       if (!lhs.defined() && rhs.defined()) return false;
       if (!rhs.defined() && lhs.defined()) return false;
       if (lhs->type_index() != rhs->type_index()) return false;
+      if (track_visits_) {
+        visited_lhs_.push_back(lhs.get());
+        visited_rhs_.push_back(rhs.get());
+      }
       auto it = equal_map_lhs_.find(lhs);
       if (it != equal_map_lhs_.end()) {
         return it->second.same_as(rhs);
@@ -279,6 +290,9 @@ class SEqualHandlerDefault::Impl {
   }
 
   ObjectRef MapLhsToRhs(const ObjectRef& lhs) {
+    if (track_visits_) {
+      visited_lhs_.push_back(lhs.get());
+    }
     auto it = equal_map_lhs_.find(lhs);
     if (it != equal_map_lhs_.end()) return it->second;
     return ObjectRef(nullptr);
@@ -310,6 +324,9 @@ class SEqualHandlerDefault::Impl {
     return RunTasks();
   }
 
+  static bool ParallelEqual(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars,
+                            int num_threads);
+
   // The default equal as registered in the structural equal vtable.
   bool DispatchSEqualReduce(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars,
                             const Optional<ObjectPathPair>& current_paths) {
@@ -466,6 +483,21 @@ class SEqualHandlerDefault::Impl {
 
   bool IsPathTracingEnabled() const { return first_mismatch_ != nullptr; }
 
+  // Equality check that keeps the equality maps of the previous checks.
+  bool EqualKeepMaps(const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars) {
+    ICHECK(!IsPathTracingEnabled());
+    task_stack_.clear();
+    pending_tasks_.clear();
+    if (!SEqualReduce(lhs, rhs, map_free_vars, NullOpt)) {
+      return false;
+    }
+    if (pending_tasks_.empty()) return true;
+    ICHECK_EQ(pending_tasks_.size(), 1U);
+    task_stack_.emplace_back(std::move(pending_tasks_.back()));
+    pending_tasks_.clear();
+    return RunTasks();
+  }
+
   // The owner of this impl
   SEqualHandlerDefault* parent_;
   // list of pending tasks to be pushed to the stack.
@@ -491,8 +523,130 @@ class SEqualHandlerDefault::Impl {
   Optional<ObjectRef> root_rhs_;
   // whether to defer fails
   bool defer_fails_;
+  // The fields below are only used by ParallelEqual.
+  // whether to record the objects the check looks up in the equality maps.
+  bool track_visits_{false};
+  // the lhs objects looked up in the equality maps.
+  std::vector<const Object*> visited_lhs_;
+  // the rhs objects looked up in the equality maps.
+  std::vector<const Object*> visited_rhs_;
 };
 
+// Compare the functions of two IRModules on their own, in parallel.
+//
+// The functions of the modules are compared with the global vars mapped, which is what
+// IRModuleNode::SEqualReduce does before comparing them, but unlike the sequential check
+// every function starts without the equality maps of the functions compared before it.
+// The maps only change the check of an object that is looked up in them, so the result
+// is the sequential result when no function looks up an object another function maps.
+// Modules that are not equal that way are compared sequentially.
+bool SEqualHandlerDefault::Impl::ParallelEqual(const ObjectRef& lhs, const ObjectRef& rhs,
+                                               bool map_free_vars, int num_threads) {
+  constexpr size_t kMinParallelFunctions = 8;
+  auto sequential = [&]() {
+    return SEqualHandlerDefault(false, nullptr, false).Equal(lhs, rhs, map_free_vars);
+  };
+  if (num_threads < 0) {
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  const auto* lhs_mod = lhs.as<IRModuleNode>();
+  const auto* rhs_mod = rhs.as<IRModuleNode>();
+  if (lhs_mod == nullptr || rhs_mod == nullptr || num_threads < 2 ||
+      lhs_mod->functions.size() < kMinParallelFunctions ||
+      lhs_mod->functions.size() != rhs_mod->functions.size()) {
+    return sequential();
+  }
+  // The attributes and the type definitions are compared around the functions.
+  auto no_attrs = [](const DictAttrs& attrs) { return !attrs.defined() || attrs->dict.empty(); };
+  if (!no_attrs(lhs_mod->attrs) || !no_attrs(rhs_mod->attrs) ||
+      lhs_mod->attrs.defined() != rhs_mod->attrs.defined() ||
+      !lhs_mod->type_definitions.empty() || !rhs_mod->type_definitions.empty()) {
+    return sequential();
+  }
+  std::vector<std::pair<GlobalVar, GlobalVar>> gvars;
+  for (const auto& gv : lhs_mod->GetGlobalVars()) {
+    if (!rhs_mod->ContainGlobalVar(gv->name_hint)) return sequential();
+    gvars.emplace_back(gv, rhs_mod->GetGlobalVar(gv->name_hint));
+  }
+  std::vector<std::pair<BaseFunc, BaseFunc>> funcs;
+  for (const auto& pair : gvars) {
+    auto lhs_it = lhs_mod->functions.find(pair.first);
+    auto rhs_it = rhs_mod->functions.find(pair.second);
+    if (lhs_it == lhs_mod->functions.end() || rhs_it == rhs_mod->functions.end()) {
+      return sequential();
+    }
+    funcs.emplace_back((*lhs_it).second, (*rhs_it).second);
+  }
+
+  struct FunctionEqual {
+    bool equal{false};
+    std::vector<const Object*> mapped_lhs;
+    std::vector<const Object*> mapped_rhs;
+    std::vector<const Object*> visited_lhs;
+    std::vector<const Object*> visited_rhs;
+  };
+  std::vector<FunctionEqual> results(funcs.size());
+  std::atomic<bool> all_equal{true};
+  int threads = std::min(num_threads, static_cast<int>(funcs.size()));
+  support::parallel_for_dynamic(0, static_cast<int>(funcs.size()), threads, [&](int, int k) {
+    if (!all_equal.load(std::memory_order_relaxed)) return;
+    SEqualHandlerDefault handler(false, nullptr, false);
+    Impl* impl = handler.impl;
+    FunctionEqual& result = results[k];
+    for (const auto& pair : gvars) {
+      if (!impl->EqualKeepMaps(pair.first, pair.second, true)) {
+        all_equal = false;
+        return;
+      }
+    }
+    size_t num_seeds = impl->equal_map_lhs_.size();
+    impl->track_visits_ = true;
+    result.equal = impl->EqualKeepMaps(funcs[k].first, funcs[k].second, map_free_vars);
+    if (!result.equal) {
+      all_equal = false;
+      return;
+    }
+    for (const auto& kv : impl->equal_map_lhs_) {
+      result.mapped_lhs.push_back(kv.first.get());
+      result.mapped_rhs.push_back(kv.second.get());
+    }
+    ICHECK_GE(result.mapped_lhs.size(), num_seeds);
+    result.visited_lhs = std::move(impl->visited_lhs_);
+    result.visited_rhs = std::move(impl->visited_rhs_);
+  });
+  if (!all_equal) return sequential();
+
+  // The function mapping every object, the global vars are mapped by every function alike.
+  std::unordered_set<const Object*> seeds;
+  for (const auto& pair : gvars) {
+    seeds.insert(pair.first.get());
+    seeds.insert(pair.second.get());
+  }
+  auto independent = [&](std::vector<const Object*> FunctionEqual::*mapped,
+                         std::vector<const Object*> FunctionEqual::*visited) {
+    std::unordered_map<const Object*, size_t> owners;
+    for (size_t k = 0; k < results.size(); ++k) {
+      for (const Object* object : results[k].*mapped) {
+        if (seeds.count(object)) continue;
+        auto it = owners.emplace(object, k);
+        if (!it.second && it.first->second != k) return false;
+      }
+    }
+    for (size_t k = 0; k < results.size(); ++k) {
+      for (const Object* object : results[k].*visited) {
+        auto it = owners.find(object);
+        if (it != owners.end() && it->second != k) return false;
+      }
+    }
+    return true;
+  };
+  if (!independent(&FunctionEqual::mapped_lhs, &FunctionEqual::visited_lhs) ||
+      !independent(&FunctionEqual::mapped_rhs, &FunctionEqual::visited_rhs)) {
+    return sequential();
+  }
+  return true;
+}
+
 SEqualHandlerDefault::SEqualHandlerDefault(bool assert_mode,
                                            Optional<ObjectPathPair>* first_mismatch,
                                            bool defer_fails) {
@@ -521,6 +675,11 @@ bool SEqualHandlerDefault::Equal(const ObjectRef& lhs, const ObjectRef& rhs, boo
   return impl->Equal(lhs, rhs, map_free_vars);
 }
 
+bool SEqualHandlerDefault::ParallelEqual(const ObjectRef& lhs, const ObjectRef& rhs,
+                                         bool map_free_vars, int num_threads) {
+  return Impl::ParallelEqual(lhs, rhs, map_free_vars, num_threads);
+}
+
 bool SEqualHandlerDefault::DispatchSEqualReduce(const ObjectRef& lhs, const ObjectRef& rhs,
                                                 bool map_free_vars,
                                                 const Optional<ObjectPathPair>& current_paths) {
@@ -544,6 +703,12 @@ TVM_REGISTER_GLOBAL("node.GetFirstStructuralMismatch")
       return first_mismatch;
     });
 
+TVM_REGISTER_GLOBAL("node.StructuralEqualParallel")
+    .set_body_typed([](const ObjectRef& lhs, const ObjectRef& rhs, bool map_free_vars,
+                       int num_threads) {
+      return SEqualHandlerDefault::ParallelEqual(lhs, rhs, map_free_vars, num_threads);
+    });
+
 bool StructuralEqual::operator()(const ObjectRef& lhs, const ObjectRef& rhs) const {
   return SEqualHandlerDefault(false, nullptr, false).Equal(lhs, rhs, false);
 }
@@ -20,6 +20,8 @@
  * \file src/node/structural_hash.cc
  */
 #include <dmlc/memory_io.h>
+#include <tvm/ir/function.h>
+#include <tvm/ir/module.h>
 #include <tvm/node/functor.h>
 #include <tvm/node/node.h>
 #include <tvm/node/object_path.h>
@@ -28,9 +30,13 @@
 #include <tvm/runtime/container/adt.h>
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 
 #include <algorithm>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "../support/base64.h"
 #include "../support/str_escape.h"
@@ -78,12 +84,37 @@ class SHashHandlerDefault::Impl {
     bool graph_node_hash{false};
     /*! \brief whether to map the free variables. */
     bool map_free_vars;
+    /*!
+     * \brief Whether the hash depends on the free var or graph node counters,
+     *  only tracked when track_dependence_ is set.
+     */
+    bool dependent{false};
 
     Task() = default;
     explicit Task(ObjectRef object, uint64_t reduced_hash, bool map_free_vars)
         : object(object), reduced_hash(reduced_hash), map_free_vars(map_free_vars) {}
   };
 
+  /*! \brief The hash of an object computed ahead, used in place of visiting the object. */
+  struct DeferredHash {
+    /*! \brief The hash of the object. */
+    uint64_t hashed_value{0};
+    /*! \brief The number of free var counters the visit of the object takes. */
+    uint32_t num_free_vars{0};
+    /*! \brief The number of graph node counters the visit of the object takes. */
+    uint32_t num_graph_nodes{0};
+  };
+
+  /*! \brief The first visit of an object with a DeferredHash. */
+  struct DeferredVisit {
+    /*! \brief The object. */
+    const Object* object;
+    /*! \brief The free var counter before the visit. */
+    uint32_t free_var_begin;
+    /*! \brief The graph node counter before the visit. */
+    uint32_t graph_node_begin;
+  };
+
   void MarkGraphNode() {
     // need to push to pending tasks in this case
     ICHECK(!allow_push_to_stack_ && !task_stack_.empty());
@@ -94,8 +125,15 @@ class SHashHandlerDefault::Impl {
     auto it = hash_memo_.find(key);
     if (it != hash_memo_.end()) {
       hash_value[0] = it->second;
+      // the hash being reduced now uses the value.
+      if (IsDependent(key) && !task_stack_.empty()) {
+        task_stack_.back().dependent = true;
+      }
       return true;
     }
+    if (track_dependence_) {
+      missed_lookups_.push_back(key.get());
+    }
     return false;
   }
 
@@ -109,6 +147,7 @@ class SHashHandlerDefault::Impl {
       // use counter value.
       uint64_t value = std::hash<uint64_t>()(free_var_counter_++);
       pending_tasks_.emplace_back(Task(ObjectRef(nullptr), value, false));
+      pending_tasks_.back().dependent = true;
     } else {
       // use pointer hash
       uint64_t value = std::hash<const runtime::Object*>()(var);
@@ -127,6 +166,7 @@ class SHashHandlerDefault::Impl {
     auto it = hash_memo_.find(object);
     if (it != hash_memo_.end()) {
       pending_tasks_.emplace_back(Task(ObjectRef(nullptr), it->second, false));
+      pending_tasks_.back().dependent = IsDependent(object);
     } else {
       // Push a pending task with initial value.
       pending_tasks_.emplace_back(Task(object, object->GetTypeKeyHash(), map_free_vars));
@@ -149,9 +189,12 @@ class SHashHandlerDefault::Impl {
     ICHECK_EQ(result_stack_.size(), 1U);
     uint64_t ret = result_stack_.back();
     result_stack_.pop_back();
+    result_dependent_.clear();
     return ret;
   }
 
+  static uint64_t ParallelHash(const ObjectRef& object, bool map_free_vars, int num_threads);
+
   void DispatchSHash(const ObjectRef& object, bool map_free_vars) {
     ICHECK(object.defined());
     vtable_->SHashReduce(object.get(), SHashReducer(parent_, map_free_vars));
@@ -164,8 +207,48 @@ class SHashHandlerDefault::Impl {
   void PopTaskStack() {
     const auto& entry = task_stack_.back();
     result_stack_.push_back(entry.reduced_hash);
+    if (track_dependence_) {
+      result_dependent_.push_back(entry.dependent);
+    }
     task_stack_.pop_back();
   }
+  /*!
+   * \brief Whether the memorized hash of an object depends on the counters.
+   * \param object The object.
+   */
+  bool IsDependent(const ObjectRef& object) const {
+    return track_dependence_ && dependent_.count(object.get()) != 0;
+  }
+  /*!
+   * \brief Pop the dependence of the results of the children of a task.
+   * \param stack_begin The location of the first child result.
+   * \return Whether any child result depends on the counters.
+   */
+  bool ReduceDependence(uint64_t stack_begin) {
+    bool dependent = std::any_of(result_dependent_.begin() + stack_begin, result_dependent_.end(),
+                                 [](bool value) { return value; });
+    result_dependent_.resize(stack_begin);
+    return dependent;
+  }
+  /*!
+   * \brief Use the DeferredHash of the object of a task if it has one.
+   * \param entry The task.
+   * \return Whether the object has a DeferredHash.
+   */
+  bool ApplyDeferredHash(Task* entry) {
+    if (deferred_ == nullptr) return false;
+    auto it = deferred_->find(entry->object.get());
+    if (it == deferred_->end()) return false;
+    if (deferred_visits_.empty() && deferred_prefix_memo_ != nullptr) {
+      *deferred_prefix_memo_ = hash_memo_;
+    }
+    deferred_visits_.push_back({entry->object.get(), free_var_counter_, graph_node_counter_});
+    entry->reduced_hash = it->second.hashed_value;
+    free_var_counter_ += it->second.num_free_vars;
+    graph_node_counter_ += it->second.num_graph_nodes;
+    hash_memo_[entry->object] = entry->reduced_hash;
+    return true;
+  }
   /*!
    * \brief Compute the reduced hash value for the task.
    * \param task The indicated task.
@@ -188,6 +271,9 @@ class SHashHandlerDefault::Impl {
       // Caution: entry becomes invalid when the stack changes
       auto& entry = task_stack_.back();
       if (entry.children_expanded) {
+        if (track_dependence_) {
+          entry.dependent = ReduceDependence(entry.result_stack_index) || entry.dependent;
+        }
         // reduce hash
         entry.reduced_hash = ReduceHash(entry);
         // When all the children has expanded and visited.
@@ -196,14 +282,19 @@ class SHashHandlerDefault::Impl {
         if (it != hash_memo_.end()) {
           // use the pre-computed hash for the object.
           entry.reduced_hash = it->second;
+          entry.dependent = IsDependent(entry.object);
         } else {
           // Append the graph node counter to the hash
           // so that we can distinguish DAG from trees.
           if (entry.graph_node_hash) {
             entry.reduced_hash = support::HashCombine(entry.reduced_hash,
                                                       std::hash<uint64_t>()(graph_node_counter_++));
+            entry.dependent = true;
           }
           hash_memo_[entry.object] = entry.reduced_hash;
+          if (track_dependence_ && entry.dependent) {
+            dependent_.insert(entry.object.get());
+          }
         }
         // send value to parent.
         this->PopTaskStack();
@@ -215,6 +306,9 @@ class SHashHandlerDefault::Impl {
         auto it = hash_memo_.find(entry.object);
         if (it != hash_memo_.end()) {
           entry.reduced_hash = it->second;
+          entry.dependent = IsDependent(entry.object);
+          this->PopTaskStack();
+        } else if (ApplyDeferredHash(&entry)) {
           this->PopTaskStack();
         } else {
           // NOTE: important to modify entry before visit.
@@ -256,8 +350,162 @@ class SHashHandlerDefault::Impl {
   ReflectionVTable* vtable_ = ReflectionVTable::Global();
   // map from lhs to rhs
   std::unordered_map<ObjectRef, uint64_t, ObjectPtrHash, ObjectPtrEqual> hash_memo_;
+  // The fields below are only used by ParallelHash.
+  // whether to track the objects whose hash depends on the counters.
+  bool track_dependence_{false};
+  // whether the results in result_stack_ depend on the counters.
+  std::vector<bool> result_dependent_;
+  // the memorized objects whose hash depends on the counters.
+  std::unordered_set<const Object*> dependent_;
+  // the objects LookupHashedValue did not find.
+  std::vector<const Object*> missed_lookups_;
+  // the hashes computed ahead, used in place of visiting the objects.
+  const std::unordered_map<const Object*, DeferredHash>* deferred_{nullptr};
+  // the first visits of the objects in deferred_, in order.
+  std::vector<DeferredVisit> deferred_visits_;
+  // where to copy hash_memo_ at the first visit of an object in deferred_.
+  std::unordered_map<ObjectRef, uint64_t, ObjectPtrHash, ObjectPtrEqual>* deferred_prefix_memo_{
+      nullptr};
 };
 
+// Hash the functions of an IRModule on their own, in parallel.
+//
+// The hash of a function inside the module depends on the state of the hashing when the
+// function is reached: the free var and graph node counters, and the memorized objects.
+// The functions are hashed in four steps so that the result equals the sequential hash.
+//
+// 1. Hash the module with the functions skipped, to get the state at every function.
+// 2. Hash every function on its own, to get the counters it takes and the objects whose
+//    hash depends on the counters.
+// 3. Hash every function again, starting from the counters of the sequential hashing.
+// 4. Hash the module with the hashes of the functions in place of the functions.
+//
+// Step 3 gives the sequential hash of a function as long as the objects the function visits
+// are not memorized differently by the functions hashed before it, which step 2 checks.
+// The module is hashed sequentially otherwise.
+uint64_t SHashHandlerDefault::Impl::ParallelHash(const ObjectRef& object, bool map_free_vars,
+                                                 int num_threads) {
+  // Hashing the functions twice only pays off with a few threads.
+  constexpr size_t kMinParallelFunctions = 8;
+  constexpr int kMinParallelThreads = 3;
+  if (num_threads < 0) {
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  std::vector<ObjectRef> funcs;
+  if (const auto* mod = object.as<IRModuleNode>()) {
+    std::unordered_set<const Object*> visited;
+    for (const auto& kv : mod->functions) {
+      if (visited.insert(kv.second.get()).second) {
+        funcs.push_back(kv.second);
+      }
+    }
+  }
+  if (funcs.size() < kMinParallelFunctions || num_threads < kMinParallelThreads) {
+    return SHashHandlerDefault().Hash(object, map_free_vars);
+  }
+
+  // Step 1.
+  std::unordered_map<const Object*, DeferredHash> deferred;
+  for (const auto& func : funcs) {
+    deferred[func.get()] = DeferredHash();
+  }
+  std::vector<DeferredVisit> visits;
+  std::unordered_map<ObjectRef, uint64_t, ObjectPtrHash, ObjectPtrEqual> prefix_memo;
+  {
+    SHashHandlerDefault skeleton;
+    skeleton.impl->deferred_ = &deferred;
+    skeleton.impl->deferred_prefix_memo_ = &prefix_memo;
+    skeleton.impl->Hash(object, map_free_vars);
+    visits = std::move(skeleton.impl->deferred_visits_);
+  }
+  if (visits.size() != funcs.size()) {
+    return SHashHandlerDefault().Hash(object, map_free_vars);
+  }
+
+  struct FunctionHash {
+    DeferredHash hash;
+    std::unordered_map<ObjectRef, uint64_t, ObjectPtrHash, ObjectPtrEqual> memo;
+    std::unordered_set<const Object*> dependent;
+    std::vector<const Object*> missed_lookups;
+  };
+  std::vector<FunctionHash> results(visits.size());
+  auto hash_functions = [&](const std::vector<DeferredVisit>& starts, bool track_dependence) {
+    int threads = std::min(num_threads, static_cast<int>(starts.size()));
+    support::parallel_for_dynamic(0, static_cast<int>(starts.size()), threads, [&](int, int k) {
+      SHashHandlerDefault handler;
+      Impl* impl = handler.impl;
+      impl->hash_memo_ = prefix_memo;
+      impl->free_var_counter_ = starts[k].free_var_begin;
+      impl->graph_node_counter_ = starts[k].graph_node_begin;
+      impl->track_dependence_ = track_dependence;
+      FunctionHash& result = results[k];
+      result.hash.hashed_value =
+          impl->Hash(GetRef<ObjectRef>(starts[k].object), map_free_vars);
+      result.hash.num_free_vars = impl->free_var_counter_ - starts[k].free_var_begin;
+      result.hash.num_graph_nodes = impl->graph_node_counter_ - starts[k].graph_node_begin;
+      result.memo = std::move(impl->hash_memo_);
+      result.dependent = std::move(impl->dependent_);
+      result.missed_lookups = std::move(impl->missed_lookups_);
+    });
+  };
+
+  // Step 2.
+  std::vector<DeferredVisit> starts;
+  for (const auto& visit : visits) {
+    starts.push_back({visit.object, 0, 0});
+  }
+  hash_functions(starts, true);
+  struct Owner {
+    size_t index;
+    uint64_t hashed_value;
+    bool dependent;
+  };
+  // The first function memorizing an object, in the order of the sequential hashing.
+  std::unordered_map<const Object*, Owner> owners;
+  for (size_t k = 0; k < results.size(); ++k) {
+    for (const auto& kv : results[k].memo) {
+      if (prefix_memo.count(kv.first)) continue;
+      bool dependent = results[k].dependent.count(kv.first.get()) != 0;
+      auto it = owners.emplace(kv.first.get(), Owner{k, kv.second, dependent});
+      if (!it.second && (dependent || it.first->second.dependent ||
+                         it.first->second.hashed_value != kv.second)) {
+        return SHashHandlerDefault().Hash(object, map_free_vars);
+      }
+    }
+  }
+  for (size_t k = 0; k < results.size(); ++k) {
+    for (const Object* key : results[k].missed_lookups) {
+      auto it = owners.find(key);
+      if (it != owners.end() && it->second.index < k) {
+        return SHashHandlerDefault().Hash(object, map_free_vars);
+      }
+    }
+  }
+
+  // Step 3.
+  uint32_t num_free_vars = 0;
+  uint32_t num_graph_nodes = 0;
+  for (size_t k = 0; k < visits.size(); ++k) {
+    starts[k].free_var_begin = visits[k].free_var_begin + num_free_vars;
+    starts[k].graph_node_begin = visits[k].graph_node_begin + num_graph_nodes;
+    num_free_vars += results[k].hash.num_free_vars;
+    num_graph_nodes += results[k].hash.num_graph_nodes;
+  }
+  hash_functions(starts, false);
+
+  // Step 4.
+  SHashHandlerDefault handler;
+  for (size_t k = 0; k < visits.size(); ++k) {
+    deferred[visits[k].object] = results[k].hash;
+    for (auto& kv : results[k].memo) {
+      if (prefix_memo.count(kv.first) || deferred.count(kv.first.get())) continue;
+      handler.impl->hash_memo_.emplace(kv.first, kv.second);
+    }
+  }
+  handler.impl->deferred_ = &deferred;
+  return handler.impl->Hash(object, map_free_vars);
+}
+
 SHashHandlerDefault::SHashHandlerDefault() { impl = new Impl(this); }
 SHashHandlerDefault::~SHashHandlerDefault() { delete impl; }
 
@@ -287,14 +535,44 @@ void SHashHandlerDefault::DispatchSHash(const ObjectRef& key, bool map_free_vars
   impl->DispatchSHash(key, map_free_vars);
 }
 
+uint64_t SHashHandlerDefault::ParallelHash(const ObjectRef& object, bool map_free_vars,
+                                           int num_threads) {
+  return Impl::ParallelHash(object, map_free_vars, num_threads);
+}
+
+// Hash the root of a hashing, through the cache of the nodes holding one.
+static uint64_t HashRoot(const ObjectRef& object, bool map_free_vars) {
+  const StructuralHashCache* cache = nullptr;
+  if (!map_free_vars) {
+    if (const auto* func = object.as<BaseFuncNode>()) {
+      cache = &func->structural_hash_cache;
+    }
+  }
+  uint64_t hashed_value;
+  if (cache != nullptr && cache->Get(&hashed_value)) {
+    return hashed_value;
+  }
+  hashed_value = SHashHandlerDefault().Hash(object, map_free_vars);
+  if (cache != nullptr) {
+    cache->Set(hashed_value);
+  }
+  return hashed_value;
+}
+
 TVM_REGISTER_GLOBAL("node.StructuralHash")
     .set_body_typed([](const ObjectRef& object, bool map_free_vars) -> int64_t {
-      uint64_t hashed_value = SHashHandlerDefault().Hash(object, map_free_vars);
+      uint64_t hashed_value = HashRoot(object, map_free_vars);
+      return static_cast<int64_t>(hashed_value);
+    });
+
+TVM_REGISTER_GLOBAL("node.StructuralHashParallel")
+    .set_body_typed([](const ObjectRef& object, bool map_free_vars, int num_threads) -> int64_t {
+      uint64_t hashed_value = SHashHandlerDefault::ParallelHash(object, map_free_vars, num_threads);
       return static_cast<int64_t>(hashed_value);
     });
 
 uint64_t StructuralHash::operator()(const ObjectRef& object) const {
-  return SHashHandlerDefault().Hash(object, false);
+  return HashRoot(object, false);
 }
 
 // SEQualReduce traits for runtime containers.
@@ -19,6 +19,7 @@
 
 #include "./graph_partitioner.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace tvm {
@@ -108,6 +109,9 @@ std::vector<GraphPartitioner::Group*> GraphPartitioner::Partition(
   for (int phase = 0; phase < 3; ++phase) {
     this->RunFuse(graph, post_dom_tree, phase);
   }
+  if (group_cost_ != nullptr) {
+    this->RunCostGuidedFuse(graph, post_dom_tree);
+  }
   return std::move(groups_);
 }
 
@@ -220,6 +224,20 @@ size_t GraphPartitioner::CountFusedNodesWithNewChild(IndexedForwardGraph::Node*
   return target->FindRoot()->num_nodes + CountNodesUptoSink_(child, dom_parent);
 }
 
+void GraphPartitioner::CollectGroupsUptoSink_(IndexedForwardGraph::Node* src,
+                                              IndexedForwardGraph::Node* sink,
+                                              std::vector<Group*>* groups) {
+  if (src == sink || visited_.count(src)) return;
+  visited_.insert(src);
+  Group* gnode = groups_[src->index]->FindRoot();
+  if (std::find(groups->begin(), groups->end(), gnode) == groups->end()) {
+    groups->push_back(gnode);
+  }
+  for (auto link = src->outputs.head; link != nullptr; link = link->next) {
+    CollectGroupsUptoSink_(link->value.node, sink, groups);
+  }
+}
+
 void GraphPartitioner::InitGroups(const IndexedForwardGraph& graph) {
   groups_.resize(graph.post_dfs_order.size());
   for (size_t nid = 0; nid < groups_.size(); ++nid) {
@@ -330,5 +348,57 @@ void GraphPartitioner::RunFuse(const IndexedForwardGraph& graph,    //
   }
 }
 
+void GraphPartitioner::RunCostGuidedFuse(const IndexedForwardGraph& graph,
+                                         const DominatorTree& post_dom_tree) {
+  // The nodes of each group
+  std::unordered_map<Group*, std::vector<const tvm::Object*>> members;
+  for (size_t nid = 0; nid < groups_.size(); ++nid) {
+    members[groups_[nid]->FindRoot()].push_back(graph.post_dfs_order[nid]->ref);
+  }
+  // A group without an anchor, up to a reduction, can be fused further
+  auto fusable = [](const Group* group) {
+    return group->pattern <= kCommReduce && group->anchor_ref == nullptr;
+  };
+  for (size_t nid = 0; nid < groups_.size(); ++nid) {
+    auto* graph_node = graph.post_dfs_order[nid];
+    auto* dom_node = post_dom_tree.nodes[nid];
+    Group* group_node = groups_[nid]->FindRoot();
+    // Fuse the whole groups from their roots
+    if (group_node->root_ref != graph_node->ref || !fusable(group_node)) continue;
+    if (dom_node->parent == nullptr) continue;
+    IndexedForwardGraph::Node* sink = dom_node->parent->gnode;
+    Group* sink_group = groups_[sink->index]->FindRoot();
+    if (sink_group == group_node || !fusable(sink_group)) continue;
+    // Unlike the op pattern rules, the paths may go through reductions and multiple consumers.
+    auto fcond = [](OpPatternKind kind, bool is_sink) { return kind <= kCommReduce; };
+    if (!CheckPath(graph_node, sink, fcond)) continue;
+    if (CountFusedNodesWithNewChild(graph_node, sink) > max_fuse_depth_) continue;
+    // Compare the estimated time of the groups apart and fused
+    std::vector<Group*> fused_groups;
+    visited_.clear();
+    CollectGroupsUptoSink_(graph_node, sink, &fused_groups);
+    fused_groups.push_back(sink_group);
+    if (!std::all_of(fused_groups.begin(), fused_groups.end(), fusable)) continue;
+    std::vector<const tvm::Object*> fused_nodes;
+    double separate_cost = 0.0;
+    OpPatternKind pattern = kElemWise;
+    for (Group* group : fused_groups) {
+      const std::vector<const tvm::Object*>& nodes = members[group];
+      separate_cost += group_cost_(nodes);
+      fused_nodes.insert(fused_nodes.end(), nodes.begin(), nodes.end());
+      pattern = std::max(pattern, group->pattern);
+    }
+    double fused_cost = group_cost_(fused_nodes);
+    if (fused_cost > (1.0 - min_gain_) * separate_cost) continue;
+    CommitFuse(graph_node, sink);
+    Group* fused_group = groups_[sink->index]->FindRoot();
+    fused_group->pattern = pattern;
+    for (Group* group : fused_groups) {
+      members.erase(group);
+    }
+    members[fused_group] = std::move(fused_nodes);
+  }
+}
+
 }  // namespace relay
 }  // namespace tvm
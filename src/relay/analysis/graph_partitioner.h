@@ -27,6 +27,7 @@
 
 #include <tvm/relay/op_attr_types.h>
 
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -157,13 +158,34 @@ class DominatorTree {
   Node* GetNode(support::Arena* arena, IndexedForwardGraph::Node* gnode);
 };
 
+/*!
+ * \brief The cost model guiding the fusions beyond the op pattern rules, which estimates the time
+ * in seconds to run a group of nodes, given by their references, as one fused function.
+ */
+using FGroupCost = std::function<double(const std::vector<const tvm::Object*>& nodes)>;
+
 /*!
  * \brief A partition of the graph marked by union find data structure.
  */
 class GraphPartitioner {
  public:
-  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth)
-      : arena_(arena), opt_level_(opt_level), max_fuse_depth_(max_fuse_depth) {}
+  /*!
+   * \brief The constructor.
+   * \param arena The arena used for node allocation.
+   * \param opt_level The optimization level of fusion.
+   * \param max_fuse_depth The maximum number of operations in one fused function.
+   * \param group_cost If defined, the cost model of an additional phase which also fuses reductions
+   * into their post-dominators, through paths with reductions and multiple consumers, when the
+   * estimated time of the fused group is lower than that of the groups apart by `min_gain`.
+   * \param min_gain The minimum relative time saved by a fusion of the additional phase.
+   */
+  explicit GraphPartitioner(support::Arena* arena, int opt_level, size_t max_fuse_depth,
+                            FGroupCost group_cost = nullptr, double min_gain = 0.0)
+      : arena_(arena),
+        opt_level_(opt_level),
+        max_fuse_depth_(max_fuse_depth),
+        group_cost_(std::move(group_cost)),
+        min_gain_(min_gain) {}
   /*!
    * \brief Group as a union find data structure.
    */
@@ -205,6 +227,10 @@ class GraphPartitioner {
   int opt_level_;
   /*! \brief The maximum number of operations in one fused function */
   size_t max_fuse_depth_;
+  /*! \brief The cost model of the cost-guided fusion phase, which is skipped if undefined */
+  FGroupCost group_cost_;
+  /*! \brief The minimum relative time saved by a cost-guided fusion */
+  double min_gain_;
   /*! \brief The internal groups. */
   std::vector<Group*> groups_;
   /*! \brief internal field used for deduplication */
@@ -260,8 +286,15 @@ class GraphPartitioner {
   // Initialize the groups.
   void InitGroups(const IndexedForwardGraph& graph);
 
+  // Collect the groups of the nodes between src and sink, sink excluded.
+  void CollectGroupsUptoSink_(IndexedForwardGraph::Node* src, IndexedForwardGraph::Node* sink,
+                              std::vector<Group*>* groups);
+
   // execute the fusion algorithm.
   void RunFuse(const IndexedForwardGraph& graph, const DominatorTree& post_dom_tree, int phase);
+
+  // execute the cost-guided fusion, after the fusion by op patterns.
+  void RunCostGuidedFuse(const IndexedForwardGraph& graph, const DominatorTree& post_dom_tree);
 };
 
 }  // namespace relay
@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/backend/aot/prefetch_constants.cc
+ * \brief Streaming of the constants of the operators called by the AOT main function into
+ * workspace buffers, overlapped with the execution of the previous operator.
+ */
+
+#include "./prefetch_constants.h"
+
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace relay {
+namespace backend {
+namespace aot {
+
+namespace {
+
+/*! \brief Whether \p call is the call of an operator by the AOT main function. */
+bool IsOperatorCall(const tir::CallNode* call) {
+  return call->op.same_as(tir::builtin::call_extern()) ||
+         call->op.same_as(tir::builtin::tvm_call_cpacked()) ||
+         call->op.same_as(tir::builtin::tvm_call_packed());
+}
+
+/*! \brief Replaces the constants passed to the operator calls by their prefetched copies. */
+class ConstantArgReplacer : public tir::StmtExprMutator {
+ public:
+  explicit ConstantArgReplacer(const Map<tir::Var, tir::Var>& copies) : copies_(copies) {}
+
+  PrimExpr VisitExpr_(const tir::CallNode* op) final {
+    auto call = Downcast<tir::Call>(tir::StmtExprMutator::VisitExpr_(op));
+    if (!IsOperatorCall(call.get())) {
+      return std::move(call);
+    }
+    Array<PrimExpr> args;
+    for (const PrimExpr& arg : call->args) {
+      const auto* var = arg.as<tir::VarNode>();
+      if (var != nullptr && copies_.count(GetRef<tir::Var>(var))) {
+        args.push_back(copies_[GetRef<tir::Var>(var)]);
+      } else {
+        args.push_back(arg);
+      }
+    }
+    return tir::Call(call->dtype, call->op, args, call->span);
+  }
+
+ private:
+  Map<tir::Var, tir::Var> copies_;
+};
+
+class ConstantPrefetcher : public tir::StmtMutator {
+ public:
+  explicit ConstantPrefetcher(int64_t max_bytes) : max_bytes_(max_bytes) {}
+
+  tir::Stmt VisitStmt_(const tir::AllocateConstNode* op) final {
+    constants_[op->buffer_var] = op;
+    return tir::StmtMutator::VisitStmt_(op);
+  }
+
+  tir::Stmt VisitStmt_(const tir::SeqStmtNode* op) final {
+    std::vector<size_t> op_indices;
+    std::vector<Array<tir::Var>> op_constants;
+    for (size_t i = 0; i < op->seq.size(); ++i) {
+      Array<tir::Var> constants = UsedConstants(op->seq[i]);
+      int64_t total_bytes = 0;
+      for (const tir::Var& constant : constants) {
+        total_bytes += ConstantBytes(constant);
+      }
+      if (!constants.empty() && (max_bytes_ <= 0 || total_bytes <= max_bytes_)) {
+        op_indices.push_back(i);
+        op_constants.push_back(constants);
+      }
+    }
+    // Nothing to overlap the copy of a single operator's constants with.
+    if (op_indices.size() < 2) {
+      return tir::StmtMutator::VisitStmt_(op);
+    }
+
+    std::vector<Map<tir::Var, tir::Var>> op_copies;
+    for (const Array<tir::Var>& constants : op_constants) {
+      Map<tir::Var, tir::Var> copies;
+      for (const tir::Var& constant : constants) {
+        const tir::AllocateConstNode* allocate_const = constants_[constant];
+        copies.Set(constant, tir::Var(constant->name_hint + "_prefetch",
+                                      PointerType(PrimType(allocate_const->dtype),
+                                                  "global.workspace")));
+      }
+      op_copies.push_back(copies);
+    }
+
+    Array<tir::Stmt> seq{StartCopies(op_constants[0], op_copies[0])};
+    size_t k = 0;
+    for (size_t i = 0; i < op->seq.size(); ++i) {
+      if (k < op_indices.size() && i == op_indices[k]) {
+        for (const tir::Var& constant : op_constants[k]) {
+          seq.push_back(CheckReturn("TVMPlatformMemcpyWait", {op_copies[k][constant]}));
+        }
+        if (k + 1 < op_indices.size()) {
+          seq.push_back(StartCopies(op_constants[k + 1], op_copies[k + 1]));
+        }
+        seq.push_back(ConstantArgReplacer(op_copies[k])(op->seq[i]));
+        ++k;
+      } else {
+        seq.push_back(VisitStmt(op->seq[i]));
+      }
+    }
+
+    tir::Stmt body = tir::SeqStmt::Flatten(seq);
+    for (const Map<tir::Var, tir::Var>& copies : op_copies) {
+      for (const auto& kv : copies) {
+        const tir::AllocateConstNode* allocate_const = constants_[kv.first];
+        body = tir::Allocate(kv.second, allocate_const->dtype, allocate_const->extents,
+                             tir::const_true(), body);
+      }
+    }
+    return body;
+  }
+
+ private:
+  /*! \brief The constants passed to the operator calls of \p stmt, in order of first use. */
+  Array<tir::Var> UsedConstants(const tir::Stmt& stmt) {
+    Array<tir::Var> constants;
+    if (!stmt->IsInstance<tir::EvaluateNode>()) {
+      return constants;
+    }
+    std::unordered_set<const tir::VarNode*> seen;
+    tir::PostOrderVisit(stmt, [this, &constants, &seen](const ObjectRef& node) {
+      const auto* call = node.as<tir::CallNode>();
+      if (call == nullptr || !IsOperatorCall(call)) {
+        return;
+      }
+      for (const PrimExpr& arg : call->args) {
+        const auto* var = arg.as<tir::VarNode>();
+        if (var != nullptr && constants_.count(GetRef<tir::Var>(var)) && seen.insert(var).second) {
+          constants.push_back(GetRef<tir::Var>(var));
+        }
+      }
+    });
+    return constants;
+  }
+
+  int64_t ConstantBytes(const tir::Var& constant) {
+    const tir::AllocateConstNode* allocate_const = constants_[constant];
+    int64_t bytes = allocate_const->dtype.bytes() * allocate_const->dtype.lanes();
+    for (const PrimExpr& extent : allocate_const->extents) {
+      const auto* int_extent = extent.as<IntImmNode>();
+      ICHECK(int_extent) << "Constant " << constant << " must have a static shape";
+      bytes *= int_extent->value;
+    }
+    return bytes;
+  }
+
+  tir::Stmt CheckReturn(const char* func_name, Array<PrimExpr> args) {
+    args.insert(args.begin(), tir::StringImm(func_name));
+    tir::Call call(DataType::Int(32), tir::builtin::call_extern(), args);
+    return tir::Evaluate(tir::Call(DataType::Int(32), tir::builtin::tvm_check_return(),
+                                   {tir::make_const(DataType::Int(32), 0),
+                                    tir::make_const(DataType::Int(32), -1), call}));
+  }
+
+  tir::Stmt StartCopies(const Array<tir::Var>& constants, const Map<tir::Var, tir::Var>& copies) {
+    Array<tir::Stmt> seq;
+    for (const tir::Var& constant : constants) {
+      seq.push_back(CheckReturn("TVMPlatformMemcpyAsync",
+                                {copies[constant], constant,
+                                 tir::make_const(DataType::UInt(32), ConstantBytes(constant))}));
+    }
+    return tir::SeqStmt::Flatten(seq);
+  }
+
+  int64_t max_bytes_;
+  std::unordered_map<tir::Var, const tir::AllocateConstNode*, ObjectPtrHash, ObjectPtrEqual>
+      constants_;
+};
+
+}  // namespace
+
+tir::PrimFunc PrefetchConstants(const tir::PrimFunc& main_func, int64_t max_bytes) {
+  tir::PrimFunc func = main_func;
+  func.CopyOnWrite()->body = ConstantPrefetcher(max_bytes)(main_func->body);
+  return func;
+}
+
+}  // namespace aot
+}  // namespace backend
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,52 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TVM_RELAY_BACKEND_AOT_PREFETCH_CONSTANTS_H_
+#define TVM_RELAY_BACKEND_AOT_PREFETCH_CONSTANTS_H_
+
+#include <tvm/tir/function.h>
+
+namespace tvm {
+namespace relay {
+namespace backend {
+namespace aot {
+
+/*! \brief Stream the constants of the operators called by the AOT main function from their
+ * read-only memory into workspace buffers, overlapping the copy with the previous operator.
+ *
+ * Before each operator using constants, the copies of its constants started before the previous
+ * such operator are waited for with TVMPlatformMemcpyWait, then the copies of the constants of
+ * the next such operator are started with TVMPlatformMemcpyAsync, and the operator is called
+ * with the workspace copies in place of the constants. Each copy is a "global.workspace"
+ * allocation live from the start of its copy to its operator, so that USMP (or StorageRewrite)
+ * plans them as a double buffer in the workspace pools.
+ *
+ * \param main_func The AOT main function, as created by the AOT executor codegen.
+ * \param max_bytes The largest total size of the constants of an operator to prefetch, or 0 for
+ * no limit. The constants of larger operators are read in place.
+ * \return The main function with the constant prefetches.
+ */
+tir::PrimFunc PrefetchConstants(const tir::PrimFunc& main_func, int64_t max_bytes);
+
+}  // namespace aot
+}  // namespace backend
+}  // namespace relay
+}  // namespace tvm
+
+#endif  // TVM_RELAY_BACKEND_AOT_PREFETCH_CONSTANTS_H_
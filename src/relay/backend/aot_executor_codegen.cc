@@ -50,6 +50,7 @@
 #include "../op/call/call.h"
 #include "../op/memory/device_copy.h"
 #include "../transforms/device_aware_visitors.h"
+#include "./aot/prefetch_constants.h"
 #include "./name_transforms.h"
 #include "./te_compiler.h"
 #include "./utils.h"
@@ -1222,6 +1223,14 @@ class AOTExecutorCodegen : public MixedModeVisitor {
     Array<tir::Var> outputs =
         Array<tir::Var>(outputs_begin_iterator, main_func_params_end_iterator - devices.size());
 
+    if (executor_config->GetAttr<Bool>("constant-prefetch").value_or(Bool(false))) {
+      CHECK(runtime_config->name == kTvmRuntimeCrt)
+          << "The constant-prefetch executor option requires the crt runtime, which provides "
+          << "TVMPlatformMemcpyAsync and TVMPlatformMemcpyWait";
+      int64_t max_bytes =
+          executor_config->GetAttr<Integer>("constant-prefetch-bytes").value_or(Integer(0))->value;
+      tir_main_func = aot::PrefetchConstants(tir_main_func, max_bytes);
+    }
     lowered_mod->Update(GlobalVar(::tvm::runtime::symbol::tvm_module_main), tir_main_func);
     // Parallel for loops are not supported in AoT codegen.
     lowered_mod = tir::transform::ConvertForLoopsToSerial()(lowered_mod);
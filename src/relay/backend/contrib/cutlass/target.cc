@@ -61,6 +61,13 @@ TVM_REGISTER_TARGET_KIND("cutlass", kDLCUDA)
     .add_attr_option<Bool>("find_first_valid", Bool(false))
     // Whether to compile profiler executables for different kernels in parallel.
     .add_attr_option<Bool>("use_multiprocessing", Bool(false))
+    // Upper bounds of M for the GEMMs whose M is the only dynamic dimension. The best kernel is
+    // profiled for each bound, and the generated code dispatches on M at runtime. When empty, such
+    // GEMMs use a default kernel.
+    .add_attr_option<Array<Integer>>("dynamic_m_buckets", Array<Integer>())
+    // A JSON file where the kernels selected by profiling are stored and looked up, to reuse them
+    // across builds. When empty, the selected kernels are not persisted.
+    .add_attr_option<String>("tuning_cache", String(""))
     // Number of threads to use during compilation, or -1 to use number of cpus.
     .add_attr_option<Integer>("threads", Integer(-1))
     // Whether to replace sigmoid with tanh.
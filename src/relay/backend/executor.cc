@@ -93,7 +93,9 @@ TVM_REGISTER_EXECUTOR("aot")
     .add_attr_option<Bool>("unpacked-api")
     .add_attr_option<String>("interface-api")
     .add_attr_option<Integer>("workspace-byte-alignment")
-    .add_attr_option<Integer>("constant-byte-alignment");
+    .add_attr_option<Integer>("constant-byte-alignment")
+    .add_attr_option<Bool>("constant-prefetch")
+    .add_attr_option<Integer>("constant-prefetch-bytes");
 
 TVM_REGISTER_EXECUTOR("graph").add_attr_option<Bool>("link-params", Bool(false));
 
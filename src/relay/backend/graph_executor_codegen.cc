@@ -648,6 +648,18 @@ class GraphExecutorCodegenModule : public runtime::ModuleNode {
     } else if (name == "get_graph_json") {
       return PackedFunc(
           [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->output_.graph_json; });
+    } else if (name == "get_graph_binary") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        const PackedFunc* fconvert = runtime::Registry::Get("tvm.graph_executor.json_to_binary");
+        ICHECK(fconvert != nullptr) << "The graph executor is not enabled in the runtime";
+        *rv = (*fconvert)(this->output_.graph_json);
+      });
+    } else if (name == "get_graph_flat") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        const PackedFunc* fconvert = runtime::Registry::Get("tvm.graph_executor.json_to_flat");
+        ICHECK(fconvert != nullptr) << "The graph executor is not enabled in the runtime";
+        *rv = (*fconvert)(this->output_.graph_json);
+      });
     } else if (name == "list_params_name") {
       return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
         Array<runtime::String> ret;
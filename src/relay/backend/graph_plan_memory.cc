@@ -31,6 +31,11 @@
 #include <tvm/runtime/container/array.h>
 #include <tvm/tir/op.h>
 
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <utility>
+
 #include "../../runtime/texture.h"
 #include "../../support/arena.h"
 #include "../op/annotation/annotation.h"
@@ -51,6 +56,135 @@ using backend::StaticMemoryPlan;
 using backend::StorageInfo;
 using IntegerArray = Array<Integer>;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.graph_plan_memory.algorithm", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.graph_plan_memory.hill_climb_budget_ms", Integer);
+
+/*! \brief The size and lifetime of the storage of an intermediate result. */
+struct StorageInterval {
+  /*! \brief The number of bytes. */
+  size_t bytes;
+  /*! \brief The index of the call producing the result. */
+  int start;
+  /*! \brief The index of the last call reading the result. */
+  int end;
+
+  bool Overlaps(const StorageInterval& that) const {
+    return start <= that.end && that.start <= end;
+  }
+};
+
+/*!
+ * \brief The peak of the bytes alive at once, a lower bound of any memory plan.
+ * \param intervals The storage intervals.
+ * \return The peak number of bytes.
+ */
+size_t PeakLiveBytes(const std::vector<StorageInterval>& intervals) {
+  std::vector<std::pair<int, int64_t>> events;
+  for (const StorageInterval& interval : intervals) {
+    events.emplace_back(interval.start, interval.bytes);
+    events.emplace_back(interval.end + 1, -static_cast<int64_t>(interval.bytes));
+  }
+  // At the same time, release before allocating
+  std::sort(events.begin(), events.end());
+  int64_t live = 0;
+  int64_t peak = 0;
+  for (const auto& event : events) {
+    live += event.second;
+    peak = std::max(peak, live);
+  }
+  return peak;
+}
+
+/*!
+ * \brief Assign the intervals in the given order to storages. Each goes to the smallest storage
+ * large enough among those free during its lifetime, or else grows the largest free storage, or
+ * else gets a new storage.
+ * \param intervals The storage intervals.
+ * \param order The order to assign the intervals in.
+ * \param storage_of The storage assigned to each interval.
+ * \return The total bytes of the storages.
+ */
+size_t AssignStorages(const std::vector<StorageInterval>& intervals, const std::vector<int>& order,
+                      std::vector<int>* storage_of) {
+  std::vector<size_t> storage_bytes;
+  std::vector<std::vector<int>> storage_members;
+  storage_of->assign(intervals.size(), -1);
+  for (int i : order) {
+    const StorageInterval& interval = intervals[i];
+    int best_fit = -1;
+    int largest = -1;
+    for (int sid = 0; sid < static_cast<int>(storage_bytes.size()); ++sid) {
+      bool is_free = std::none_of(storage_members[sid].begin(), storage_members[sid].end(),
+                                  [&](int j) { return intervals[j].Overlaps(interval); });
+      if (!is_free) continue;
+      if (storage_bytes[sid] >= interval.bytes) {
+        if (best_fit == -1 || storage_bytes[sid] < storage_bytes[best_fit]) best_fit = sid;
+      } else if (largest == -1 || storage_bytes[sid] > storage_bytes[largest]) {
+        largest = sid;
+      }
+    }
+    int sid = best_fit != -1 ? best_fit : largest;
+    if (sid == -1) {
+      sid = storage_bytes.size();
+      storage_bytes.push_back(0);
+      storage_members.emplace_back();
+    }
+    storage_bytes[sid] = std::max(storage_bytes[sid], interval.bytes);
+    storage_members[sid].push_back(i);
+    (*storage_of)[i] = sid;
+  }
+  size_t total = 0;
+  for (size_t bytes : storage_bytes) {
+    total += bytes;
+  }
+  return total;
+}
+
+/*!
+ * \brief Plan the storages of the intervals offline.
+ * \param intervals The storage intervals.
+ * \param algorithm "greedy_by_size" assigns the intervals from the largest, "hill_climb" then
+ * keeps swapping two intervals of the order while it does not increase the total bytes, within
+ * the time budget.
+ * \param budget_ms The time budget of "hill_climb" in milliseconds.
+ * \return The storage assigned to each interval.
+ */
+std::vector<int> PlanStorages(const std::vector<StorageInterval>& intervals,
+                              const std::string& algorithm, int64_t budget_ms) {
+  std::vector<int> order(intervals.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return intervals[a].bytes != intervals[b].bytes ? intervals[a].bytes > intervals[b].bytes
+                                                     : intervals[a].start < intervals[b].start;
+  });
+  std::vector<int> best_storage_of;
+  size_t best_total = AssignStorages(intervals, order, &best_storage_of);
+  if (algorithm != "hill_climb" || intervals.size() < 2) {
+    return best_storage_of;
+  }
+  size_t lower_bound = PeakLiveBytes(intervals);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget_ms);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> pick(0, static_cast<int>(order.size()) - 1);
+  std::vector<int> storage_of;
+  while (best_total > lower_bound && std::chrono::steady_clock::now() < deadline) {
+    int a = pick(rng);
+    int b = pick(rng);
+    if (a == b) continue;
+    std::swap(order[a], order[b]);
+    size_t total = AssignStorages(intervals, order, &storage_of);
+    if (total <= best_total) {
+      best_total = total;
+      best_storage_of.swap(storage_of);
+    } else {
+      std::swap(order[a], order[b]);
+    }
+  }
+  return best_storage_of;
+}
+
 class StorageAllocaBaseVisitor : public transform::DeviceAwareExprVisitor {
  public:
   StorageAllocaBaseVisitor() : transform::DeviceAwareExprVisitor(Optional<IRModule>()) {}
@@ -228,8 +362,32 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   StaticMemoryPlan Plan(const Function& func) {
     VLOG_CONTEXT << "StorageAllocator";
     VLOG(1) << "planning:" << std::endl << PrettyPrint(func);
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+    algorithm_ = pass_ctx
+                     ->GetConfig<String>("relay.backend.graph_plan_memory.algorithm",
+                                         String("greedy"))
+                     .value();
+    ICHECK(algorithm_ == "greedy" || algorithm_ == "greedy_by_size" || algorithm_ == "hill_climb")
+        << "ValueError: Unknown graph memory planning algorithm " << algorithm_
+        << ", expected one of greedy, greedy_by_size and hill_climb";
+    hill_climb_budget_ms_ =
+        pass_ctx
+            ->GetConfig<Integer>("relay.backend.graph_plan_memory.hill_climb_budget_ms",
+                                 Integer(100))
+            .value()
+            ->value;
     prototype_ = StorageAllocaInit(&arena_).GetInitTokenMap(func);
     this->Run(func);
+    // The results alive at the end are read by the last call at the latest
+    for (const auto& kv : open_lifetimes_) {
+      lifetimes_[kv.second].second.end = num_calls_;
+    }
+    open_lifetimes_.clear();
+    if (algorithm_ != "greedy") {
+      PlanOffline();
+    }
+    VLOG(1) << "planned " << PlannedBytes() << " bytes for the intermediate results with the "
+            << algorithm_ << " algorithm, with a lower bound of " << LowerBoundBytes() << " bytes";
 
     // The value of smap contains two integer arrays where the first array
     // contains the planned storage ids and the second holds the device types.
@@ -270,6 +428,33 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     return backend::StaticMemoryPlan(smap);
   }
 
+  /*! \return The total bytes of the storages of the intermediate results in 1d memory. */
+  size_t PlannedBytes() const {
+    std::unordered_map<int64_t, size_t> storage_bytes;
+    for (const auto& lifetime : lifetimes_) {
+      size_t& bytes = storage_bytes[lifetime.first->storage_id];
+      bytes = std::max(bytes, lifetime.second.bytes);
+    }
+    size_t total = 0;
+    for (const auto& kv : storage_bytes) {
+      total += kv.second;
+    }
+    return total;
+  }
+
+  /*! \return The lower bound of PlannedBytes, the sum of the peak bytes alive on each device. */
+  size_t LowerBoundBytes() const {
+    size_t total = 0;
+    for (const std::vector<size_t>& group : GroupLifetimesByDevice()) {
+      std::vector<StorageInterval> intervals;
+      for (size_t i : group) {
+        intervals.push_back(lifetimes_[i].second);
+      }
+      total += PeakLiveBytes(intervals);
+    }
+    return total;
+  }
+
  protected:
   // override create token by getting token as prototype requirements.
   void CreateTokenOnDevice(const ExprNode* op, const VirtualDevice& virtual_device,
@@ -282,7 +467,22 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     for (StorageToken* tok : it->second) {
       ICHECK(tok->virtual_device == virtual_device);
       if (can_realloc) {
-        tokens.push_back(allocator_.Request(tok));
+        if (TokenAllocator::Is2DStorage(tok)) {
+          tokens.push_back(allocator_.Request(tok));
+          continue;
+        }
+        StorageToken* allocated_tok = nullptr;
+        if (algorithm_ == "greedy") {
+          allocated_tok = allocator_.Request(tok);
+        } else {
+          // The storage id is planned offline, after the lifetimes are known
+          allocated_tok = tok;
+          allocated_tok->max_bytes = allocator_.GetMemorySize(tok);
+        }
+        StorageInterval interval{allocator_.GetMemorySize(tok), num_calls_, num_calls_};
+        open_lifetimes_[allocated_tok] = lifetimes_.size();
+        lifetimes_.emplace_back(allocated_tok, interval);
+        tokens.push_back(allocated_tok);
       } else {
         // Allocate a new token,
         StorageToken* allocated_tok = allocator_.Alloc(tok);
@@ -311,6 +511,80 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     token_map_[op] = {input_token};
   }
 
+  // Release the token if it is no longer used, ending the lifetime of the result it holds.
+  void CheckForRelease(StorageToken* tok) {
+    auto it = open_lifetimes_.find(tok);
+    if (it != open_lifetimes_.end() && tok->ref_counter == 0) {
+      lifetimes_[it->second].second.end = num_calls_;
+      open_lifetimes_.erase(it);
+    }
+    // The tokens planned offline have no storage id yet, and are not reused online
+    if (tok->storage_id >= 0) {
+      allocator_.CheckForRelease(tok);
+    }
+  }
+
+  // Group the indices of the lifetimes by the virtual devices of their tokens.
+  std::vector<std::vector<size_t>> GroupLifetimesByDevice() const {
+    std::vector<std::vector<size_t>> groups;
+    for (size_t i = 0; i < lifetimes_.size(); ++i) {
+      const StorageToken* tok = lifetimes_[i].first;
+      auto it = std::find_if(groups.begin(), groups.end(), [&](const std::vector<size_t>& group) {
+        return lifetimes_[group.front()].first->is_compatible(*tok);
+      });
+      if (it == groups.end()) {
+        groups.push_back({i});
+      } else {
+        it->push_back(i);
+      }
+    }
+    return groups;
+  }
+
+  // Assign the storage ids of the intermediate results on each device from their lifetimes.
+  void PlanOffline() {
+    for (const std::vector<size_t>& group : GroupLifetimesByDevice()) {
+      std::vector<StorageInterval> intervals;
+      for (size_t i : group) {
+        intervals.push_back(lifetimes_[i].second);
+      }
+      std::vector<int> storage_of = PlanStorages(intervals, algorithm_, hill_climb_budget_ms_);
+      std::unordered_map<int, int64_t> storage_ids;
+      for (size_t k = 0; k < group.size(); ++k) {
+        StorageToken* tok = lifetimes_[group[k]].first;
+        auto it = storage_ids.find(storage_of[k]);
+        if (it == storage_ids.end()) {
+          it = storage_ids.emplace(storage_of[k], allocator_.NewStorageId()).first;
+        }
+        tok->storage_id = it->second;
+      }
+    }
+  }
+
+  // Find the token of an argument the lowered call may write its output into, which is read for
+  // the last time by the call, or nullptr if none.
+  StorageToken* FindInplaceToken(const CallNode* call_node, const CallLoweredProps& props) {
+    if (!props.lowered_func.defined()) return nullptr;
+    Array<Integer> inplace_params = GetInplaceParams(props);
+    if (inplace_params.empty()) return nullptr;
+    auto it = prototype_.find(call_node);
+    ICHECK(it != prototype_.end());
+    if (it->second.size() != 1U || TokenAllocator::Is2DStorage(it->second[0])) return nullptr;
+    StorageToken* prototype = it->second[0];
+    for (const Integer& index : inplace_params) {
+      const std::vector<StorageToken*>& tokens = GetToken(props.arguments[index.IntValue()]);
+      if (tokens.size() != 1U) continue;
+      StorageToken* tok = tokens[0];
+      // The parameters and the outputs of the function are never released, so are never reused.
+      if (tok->ref_counter == 1 && tok->is_compatible(*prototype) &&
+          !TokenAllocator::Is2DStorage(tok) &&
+          tok->max_bytes >= allocator_.GetMemorySize(prototype)) {
+        return tok;
+      }
+    }
+    return nullptr;
+  }
+
   using StorageAllocaBaseVisitor::DeviceAwareVisitExpr_;
 
   // The call map
@@ -335,10 +609,14 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     // TODO(tvm-team) Update checks of flat memory enablement when we support
     // opaque-nd memory planning to skip this path.
     // TODO(mbs): "reshape" cleanup.
+    ++num_calls_;
     CallLoweredProps call_lowered_props = GetCallLoweredProps(call_node);
     if (call_lowered_props.lowered_func.defined() && IsReshapeOnly(call_lowered_props)) {
       ICHECK_EQ(call_lowered_props.arguments.size(), 1U);
       ReuseInputToken(call_node, args[0]);
+    } else if (StorageToken* inplace_token = FindInplaceToken(call_node, call_lowered_props)) {
+      // write the output into an input read for the last time.
+      ReuseInputToken(call_node, inplace_token);
     } else {
       // create token for the call node.
       CreateToken(call_node, true);
@@ -346,11 +624,11 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
 
     // check if there is orphaned output that can be released immediately.
     for (StorageToken* tok : token_map_.at(call_node)) {
-      allocator_.CheckForRelease(tok);
+      CheckForRelease(tok);
     }
     for (StorageToken* tok : args) {
       tok->ref_counter -= 1;
-      allocator_.CheckForRelease(tok);
+      CheckForRelease(tok);
     }
   }
 
@@ -368,6 +646,7 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
     void CheckForRelease(StorageToken* tok) {
       return Is2DStorage(tok) ? token_2d_.CheckForRelease(tok) : token_1d_.CheckForRelease(tok);
     }
+    int64_t NewStorageId() { return storage_ids_++; }
 
     size_t GetMemorySize(StorageToken* tok) {
       // TODO(amalyshe): figure out who requries sizes and for what
@@ -399,11 +678,33 @@ class StorageAllocator : public StorageAllocaBaseVisitor {
   std::unordered_map<const ExprNode*, std::vector<StorageToken*>> prototype_;
   /*! \brief token allocator for optimizing 1d and 2d token alloc requests */
   TokenAllocator allocator_;
+  /*! \brief The planning algorithm of the intermediate results in 1d memory */
+  std::string algorithm_{"greedy"};
+  /*! \brief The time budget of the hill_climb algorithm in milliseconds */
+  int64_t hill_climb_budget_ms_{100};
+  /*! \brief The number of calls visited so far, which orders the lifetimes */
+  int num_calls_{0};
+  /*! \brief The token and the lifetime of each intermediate result in 1d memory */
+  std::vector<std::pair<StorageToken*, StorageInterval>> lifetimes_;
+  /*! \brief The index in lifetimes_ of the result each token holds, until it is released */
+  std::unordered_map<StorageToken*, size_t> open_lifetimes_;
 };
 
 StaticMemoryPlan GraphPlanMemory(const Function& func) { return StorageAllocator().Plan(func); }
 
+/*!
+ * \brief Plan the memory of a function, and report the total bytes planned for its intermediate
+ * results against the peak bytes alive at once, a lower bound of any plan.
+ */
+Map<String, IntImm> GraphPlanMemoryStats(const Function& func) {
+  StorageAllocator allocator;
+  allocator.Plan(func);
+  return {{"planned_bytes", IntImm(DataType::Int(64), allocator.PlannedBytes())},
+          {"lower_bound_bytes", IntImm(DataType::Int(64), allocator.LowerBoundBytes())}};
+}
+
 TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemory").set_body_typed(GraphPlanMemory);
+TVM_REGISTER_GLOBAL("relay.backend.GraphPlanMemoryStats").set_body_typed(GraphPlanMemoryStats);
 
 }  // namespace relay
 }  // namespace tvm
@@ -123,6 +123,10 @@ Array<meta_schedule::ExtractedTask> ExtractTask(IRModule mod, Target target,
     // Note that the cache is key-ed on the tir mod, rather than the relay mod
     IRModule relay_mod({{GlobalVar(fused_name), relay_func}});
     ExtractedTask task(fused_name, relay_mod, target, {tir_mod}, 1);
+    // The hash is memoized by the lookup above, and carried so that it is never recomputed
+    task->module_equality = mod_eq_name;
+    task->dispatched_hashes = {
+        IntImm(DataType::Int(64), static_cast<int64_t>(mod_eq->Hash(tir_mod)))};
     tasks.push_back(task);
     cache.emplace(tir_mod, task);
   }
@@ -93,6 +93,7 @@
 #include <tvm/ir/attrs.h>
 #include <tvm/ir/function.h>
 #include <tvm/ir/name_supply.h>
+#include <tvm/node/serialization.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/annotation.h>
 #include <tvm/relay/attrs/call.h>
@@ -102,16 +103,24 @@
 #include <tvm/relay/op.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/te/schedule.h>
 #include <tvm/te/schedule_pass.h>
 #include <tvm/tir/transform.h>
 #include <tvm/topi/tags.h>
 
+#include <cstdio>
+#include <fstream>
 #include <functional>
+#include <iomanip>
 #include <limits>
 #include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -158,6 +167,62 @@ class TECompilerImpl : public TECompilerNode {
     return LowerInternal(key, global_var_supply_)->cached_func;
   }
 
+  void LowerInParallel(const std::vector<CCacheKey>& keys, int num_threads) final {
+    // Create the tensor expressions in order, so the names are the ones Lower would give.
+    std::vector<std::pair<CCacheKey, CCacheValue>> pending;
+    std::vector<size_t> to_lower;
+    std::vector<std::pair<std::string, ObjectRef>> disk_entries;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      std::unordered_set<CCacheKey> seen;
+      for (const CCacheKey& key : keys) {
+        if (cache_.count(key) || !seen.insert(key).second) continue;
+        cur_ccache_key_ = key;
+        CCacheValue value(make_object<CCacheValueNode>());
+        Optional<String> opt_compiler = key->source_func->GetAttr<String>(attr::kCompiler);
+        ObjectRef disk_context;
+        std::string disk_path;
+        if (opt_compiler.defined()) {
+          PrepareExternalFunc(key, opt_compiler.value(), value, global_var_supply_);
+        } else {
+          With<Target> target_scope(key->target);
+          disk_path = DiskCachePath(key, &disk_context);
+          if (disk_path.empty() ||
+              !LoadFromDiskCache(disk_path, disk_context, key, value, global_var_supply_)) {
+            value->cached_func = PrimFuncFor(key->source_func, key->target, global_var_supply_,
+                                             constant_name_supply_);
+            to_lower.push_back(pending.size());
+          }
+        }
+        pending.emplace_back(key, value);
+        disk_entries.emplace_back(disk_path, disk_context);
+      }
+    }
+    VLOG(1) << "lowering " << to_lower.size() << " functions on " << num_threads << " threads";
+    // The name supplies are not thread safe, the lowering of each function gets a supply which
+    // only holds the name of that function.
+    tvm::transform::ParallelForEach(
+        tvm::transform::PassContext::Current(), to_lower.size(), num_threads, [&](size_t i) {
+          const CCacheKey& key = pending[to_lower[i]].first;
+          const CCacheValue& value = pending[to_lower[i]].second;
+          With<Target> target_scope(key->target);
+          GlobalVar prim_fn_var = value->cached_func->prim_fn_var;
+          LowerCachedFunc(key, value,
+                          GlobalVarSupply(NameSupply(""), {{prim_fn_var->name_hint, prim_fn_var}}));
+        });
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i : to_lower) {
+      if (!disk_entries[i].first.empty()) {
+        SaveToDiskCache(disk_entries[i].first, disk_entries[i].second, pending[i].first,
+                        pending[i].second, global_var_supply_);
+      }
+    }
+    for (const auto& kv : pending) {
+      // The uses are counted by Lower.
+      cache_.emplace(kv.first, kv.second);
+    }
+  }
+
   // For now, build one module per function.
   PackedFunc JIT(const CCacheKey& key) final {
     CCacheValue value = LowerInternal(key, GlobalVarSupply(NameSupply("")));
@@ -361,29 +426,7 @@ class TECompilerImpl : public TECompilerNode {
 
     Optional<String> opt_compiler = key->source_func->GetAttr<String>(attr::kCompiler);
     if (opt_compiler.defined()) {
-      // Don't compile now since we don't have anywhere to put the resulting runtime module.
-      // Instead place the original definition in the cache and wait for LowerExternalFunctions.
-      IRModule ir_module({}, {});
-      Optional<String> opt_global_symbol =
-          key->source_func->GetAttr<String>(tvm::attr::kGlobalSymbol);
-      ICHECK(opt_global_symbol.defined()) << "External function has not been attached a name yet.";
-      // Note that the source_func may already be bound to a global function in the module
-      // we are compiling, in which case we should not attempt to make its name unique w.r.t.
-      // the module's globals. Furthermore, the external codegen tool must bind the compiled
-      // function to the "global_symbol" attribute on the source_func. So do not use GetUniqueName
-      // here.
-      auto global_var = global_var_supply->UniqueGlobalFor(opt_global_symbol.value(), false);
-      global_var->checked_type_ = key->source_func->checked_type();
-      ir_module->Add(global_var, key->source_func);
-      value->cached_func = CachedFunc(key->target, global_var, {}, {}, te::Schedule{nullptr},
-                                      tir::PrimFunc{nullptr}, {}, ir_module);
-      // Collect these here as it's removed in LowerExternalFunctions()
-      device_contexts_.Set(value->cached_func->prim_fn_var, opt_compiler.value());
-      VLOG(1) << "preparing to use external codegen '" << opt_compiler.value()
-              << "' with name:" << std::endl
-              << PrettyPrint(value->cached_func->prim_fn_var) << std::endl
-              << "and definitions:" << std::endl
-              << PrettyPrint(value->cached_func->funcs);
+      PrepareExternalFunc(key, opt_compiler.value(), value, global_var_supply);
       return value;
     }
 
@@ -391,9 +434,50 @@ class TECompilerImpl : public TECompilerNode {
     With<Target> target_scope(key->target);
 
     ICHECK(!value->cached_func.defined());
+    ObjectRef disk_context;
+    std::string disk_path = DiskCachePath(key, &disk_context);
+    if (!disk_path.empty() &&
+        LoadFromDiskCache(disk_path, disk_context, key, value, global_var_supply)) {
+      return value;
+    }
     value->cached_func =
         PrimFuncFor(key->source_func, key->target, global_var_supply, constant_name_supply_);
+    LowerCachedFunc(key, value, global_var_supply);
+    if (!disk_path.empty()) {
+      SaveToDiskCache(disk_path, disk_context, key, value, global_var_supply);
+    }
+    return value;
+  }
 
+  // Place the original definition of an external function in the cache of value.
+  void PrepareExternalFunc(const CCacheKey& key, const String& compiler, CCacheValue value,
+                           GlobalVarSupply global_var_supply) {
+    // Don't compile now since we don't have anywhere to put the resulting runtime module.
+    // Instead place the original definition in the cache and wait for LowerExternalFunctions.
+    IRModule ir_module({}, {});
+    Optional<String> opt_global_symbol =
+        key->source_func->GetAttr<String>(tvm::attr::kGlobalSymbol);
+    ICHECK(opt_global_symbol.defined()) << "External function has not been attached a name yet.";
+    // Note that the source_func may already be bound to a global function in the module
+    // we are compiling, in which case we should not attempt to make its name unique w.r.t.
+    // the module's globals. Furthermore, the external codegen tool must bind the compiled
+    // function to the "global_symbol" attribute on the source_func. So do not use GetUniqueName
+    // here.
+    auto global_var = global_var_supply->UniqueGlobalFor(opt_global_symbol.value(), false);
+    global_var->checked_type_ = key->source_func->checked_type();
+    ir_module->Add(global_var, key->source_func);
+    value->cached_func = CachedFunc(key->target, global_var, {}, {}, te::Schedule{nullptr},
+                                    tir::PrimFunc{nullptr}, {}, ir_module);
+    // Collect these here as it's removed in LowerExternalFunctions()
+    device_contexts_.Set(value->cached_func->prim_fn_var, compiler);
+    VLOG(1) << "preparing to use external codegen '" << compiler << "' with name:" << std::endl
+            << PrettyPrint(value->cached_func->prim_fn_var) << std::endl
+            << "and definitions:" << std::endl
+            << PrettyPrint(value->cached_func->funcs);
+  }
+
+  // Lower the tensor expressions or the PrimFunc of the cached function of value to TIR.
+  void LowerCachedFunc(const CCacheKey& key, CCacheValue value, GlobalVarSupply global_var_supply) {
     if (value->cached_func->prim_func.defined()) {
       VLOG(1) << "Lowering PrimFunc";
       IRModule lowered = tvm::LowerPrimFunc(value->cached_func->prim_func.value(),
@@ -461,12 +545,129 @@ class TECompilerImpl : public TECompilerNode {
       ICHECK(value->cached_func->funcs->Lookup(value->cached_func->prim_fn_var)
                  .as<tir::PrimFuncNode>());
     }
+    // The output of an in-place function may alias one of its inputs.
+    if (backend::IsInplaceEnabled() && !backend::GetInplaceParams(key->source_func).empty()) {
+      Map<GlobalVar, BaseFunc> funcs = value->cached_func->funcs->functions;
+      for (const auto& kv : funcs) {
+        if (auto prim_func = kv.second.as<tir::PrimFunc>()) {
+          value->cached_func->funcs->Update(
+              kv.first, WithAttr(prim_func.value(), tir::attr::kNoAlias, Bool(false)));
+        }
+      }
+    }
     VLOG(1) << "lowered to name:" << std::endl
             << PrettyPrint(value->cached_func->prim_fn_var) << std::endl
             << "with definitions:" << std::endl
             << PrettyPrint(value->cached_func->funcs);
+  }
 
-    return value;
+  /*!
+   * \brief Get the path of the entry of \p key in the disk cache.
+   * \param key The key.
+   * \param context Set to the lowering context, which the entry must have been lowered in.
+   * \return The path, or empty when the disk cache is not used for the key.
+   */
+  std::string DiskCachePath(const CCacheKey& key, ObjectRef* context) {
+    transform::PassContext pass_ctx = transform::PassContext::Current();
+    Optional<String> opt_dir =
+        pass_ctx->GetConfig<String>("relay.backend.te_compiler_cache_dir", String(""));
+    if (!opt_dir.defined() || opt_dir.value().empty()) return "";
+    // The memory scopes of the parameters are not part of the structural hash of the key.
+    if (!key->virtual_device->memory_scope.empty()) return "";
+    for (const Var& param : key->source_func->params) {
+      if (!param->virtual_device()->memory_scope.empty()) return "";
+    }
+    Map<String, ObjectRef> config;
+    for (const auto& kv : pass_ctx->config) {
+      if (kv.first != "relay.backend.te_compiler_cache_dir") config.Set(kv.first, kv.second);
+    }
+    Map<String, ObjectRef> ctx = {{"version", String(TVM_VERSION)},
+                                  {"target", String(key->target->str())},
+                                  {"opt_level", Integer(pass_ctx->opt_level)},
+                                  {"required_pass", pass_ctx->required_pass},
+                                  {"disabled_pass", pass_ctx->disabled_pass},
+                                  {"config", config}};
+    size_t hash = key->Hash();
+    hash = dmlc::HashCombine(hash, tvm::StructuralHash()(ctx));
+    *context = ctx;
+    std::ostringstream os;
+    os << opt_dir.value() << "/" << std::hex << std::setw(16) << std::setfill('0') << hash
+       << ".tvmbin";
+    return os.str();
+  }
+
+  // Set the cached function of value from the disk cache, return false if there is no entry.
+  bool LoadFromDiskCache(const std::string& path, const ObjectRef& context, const CCacheKey& key,
+                         CCacheValue value, GlobalVarSupply global_var_supply) {
+    std::ifstream fs(path, std::ios::in | std::ios::binary);
+    if (!fs) return false;
+    std::stringstream blob;
+    blob << fs.rdbuf();
+    Map<String, ObjectRef> entry;
+    try {
+      entry = Downcast<Map<String, ObjectRef>>(LoadBinary(blob.str()));
+    } catch (const Error& e) {
+      LOG(WARNING) << "Ignoring the invalid TE compiler cache entry " << path << ": " << e.what();
+      return false;
+    }
+    // Entries of colliding hashes are overwritten by the last function lowered.
+    if (!tvm::StructuralEqual()(entry["context"], context) ||
+        !tvm::StructuralEqual()(entry["source_func"], key->source_func)) {
+      return false;
+    }
+    IRModule funcs = Downcast<IRModule>(entry["funcs"]);
+    ICHECK_EQ(funcs->functions.size(), 1);
+    // Give the function the name Lower would have given it.
+    GlobalVar prim_fn_var = global_var_supply->FreshGlobal(Downcast<String>(entry["name"]));
+    prim_fn_var->checked_type_ = key->source_func->checked_type();
+    BaseFunc func = WithAttr(Downcast<tir::PrimFunc>((*funcs->functions.begin()).second),
+                             tvm::attr::kGlobalSymbol, prim_fn_var->name_hint);
+    IRModule lowered({{prim_fn_var, func}});
+    value->cached_func = CachedFunc(key->target, prim_fn_var, {}, {}, te::Schedule{nullptr},
+                                    tir::PrimFunc{nullptr}, {}, lowered);
+    VLOG(1) << "loaded " << PrettyPrint(prim_fn_var) << " from " << path;
+    return true;
+  }
+
+  // Write the cached function of value to the disk cache.
+  void SaveToDiskCache(const std::string& path, const ObjectRef& context, const CCacheKey& key,
+                       const CCacheValue& value, GlobalVarSupply global_var_supply) {
+    const CachedFunc& cached_func = value->cached_func;
+    // Constants are named across functions, and a kept schedule cannot be loaded again.
+    if (cached_func->funcs->functions.size() != 1 || !cached_func->constant_tensors.empty() ||
+        (cached_func->schedule.defined() && cached_func->schedule->keep_schedule_record)) {
+      return;
+    }
+    // Store the name without the prefix and without the suffix FreshGlobal made it unique with.
+    NameSupply name_supply = global_var_supply->name_supply_;
+    std::string name = cached_func->prim_fn_var->name_hint;
+    if (!name_supply->prefix_.empty() && name.rfind(name_supply->prefix_ + "_", 0) == 0) {
+      name = name.substr(name_supply->prefix_.size() + 1);
+    }
+    size_t pos = name.find_last_of('_');
+    if (pos != std::string::npos && pos + 1 < name.size() &&
+        name.find_first_not_of("0123456789", pos + 1) == std::string::npos &&
+        name_supply->ContainsName(name.substr(0, pos))) {
+      name = name.substr(0, pos);
+    }
+    Map<String, ObjectRef> entry = {{"context", context},
+                                    {"source_func", key->source_func},
+                                    {"name", String(name)},
+                                    {"funcs", cached_func->funcs}};
+    // Write to a temporary file first, so other processes never read a partial entry.
+    std::string tmp_path = path + "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+      std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+      if (!fs) {
+        LOG(WARNING) << "Cannot write the TE compiler cache entry " << tmp_path;
+        return;
+      }
+      std::string blob = SaveBinary(entry);
+      fs.write(blob.data(), blob.size());
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+      std::remove(tmp_path.c_str());
+    }
   }
 
   // implement lowered shape func
@@ -552,6 +753,9 @@ TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_auto_scheduler", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_meta_schedule", Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.use_meta_schedule_dispatch", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.tir_converter", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.num_lowering_threads", Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.te_compiler_cache_dir", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.backend.enable_inplace", Bool);
 
 TVM_REGISTER_GLOBAL("relay.backend._TECompilerGlobal").set_body_typed([]() {
   return TECompiler::Global();
@@ -587,6 +791,60 @@ TVM_REGISTER_GLOBAL("relay.backend._TECompilerListItems").set_body_typed([](TECo
 
 using AnalysisRemapping = std::unordered_map<Expr, Expr, ObjectHash, ObjectEqual>;
 
+/*!
+ * \brief Returns the primitive function associated with \p expr, or nullptr if none, where
+ * \p primitive_functions binds the let-bound variables known to be primitive.
+ */
+BaseFunc ResolveToPrimitive(
+    const IRModule& module,
+    const std::unordered_map<const VarNode*, BaseFunc>& primitive_functions, const Expr& expr) {
+  static const Op& debug_op = Op::Get("debug");
+  // NOTE: We can't assume expr->checked_type_ is defined, so can't early exit for first-order
+  // expressions.
+  if (const auto* global_var_node = expr.as<GlobalVarNode>()) {
+    if (!module->ContainGlobalVar(global_var_node->name_hint)) {
+      // TODO(mbs): extern function cleanup
+      // Assume the function is extern and thus no longer in the IRModule.
+      return {};
+    } else {
+      BaseFunc base_func = module->Lookup(GetRef<GlobalVar>(global_var_node));
+      return ResolveToPrimitive(module, primitive_functions, base_func);
+    }
+  } else if (auto prim_func = expr.as<tir::PrimFunc>()) {
+    return prim_func.value();
+  } else if (const auto* var_node = expr.as<VarNode>()) {
+    auto itr = primitive_functions.find(var_node);
+    if (itr == primitive_functions.end()) {
+      // Not bound to a primitive function.
+      return {};
+    } else {
+      return itr->second;
+    }
+  } else if (const auto* function_node = expr.as<FunctionNode>()) {
+    if (function_node->HasNonzeroAttr(attr::kExtern)) {
+      // We have a regular call to an 'extern' function. The call itself needs to be rewritten
+      // to call_lowered form, and any required dynamic shape functions generated and
+      // cross-linked.
+      return GetRef<Function>(function_node);
+    } else if (function_node->HasNonzeroAttr(attr::kPrimitive)) {
+      if (const auto* call_node = function_node->body.as<CallNode>()) {
+        if (call_node->op == debug_op) {
+          // Debug 'primitives' are not lowered.
+          return {};
+        }
+      }
+      // We have a regular call to a 'primitive' function (possibly with a 'Compiler' attribute).
+      // We need to lower and rewrite the call.
+      return GetRef<Function>(function_node);
+    } else {
+      // Not marked as primitive during partitioning or TVM fusion.
+      return {};
+    }
+  } else {
+    return {};
+  }
+}
+
 /*!
  * \brief Rewrites call expressions to Relay Functions marked as "primitive"
  * to calls to the corresponding TIR PrimFunc for the appropriate target.
@@ -633,57 +891,13 @@ class LowerTensorExprMutator : public DeviceAwareExprMutator {
         module_(std::move(module)),
         process_fn_(std::move(process_fn)),
         config_(std::move(config)),
-        compiler_(std::move(compiler)),
-        debug_op_(Op::Get("debug")) {}
+        compiler_(std::move(compiler)) {}
 
   /*!
    *  \brief Returns the primitive function associated with \p expr, or nullptr if none.
    */
   BaseFunc ResolveToPrimitive(const Expr& expr) {
-    // NOTE: We can't assume expr->checked_type_ is defined, so can't early exit for first-order
-    // expressions.
-    if (const auto* global_var_node = expr.as<GlobalVarNode>()) {
-      if (!module_->ContainGlobalVar(global_var_node->name_hint)) {
-        // TODO(mbs): extern function cleanup
-        // Assume the function is extern and thus no longer in the IRModule.
-        return {};
-      } else {
-        BaseFunc base_func = module_->Lookup(GetRef<GlobalVar>(global_var_node));
-        return ResolveToPrimitive(base_func);
-      }
-    } else if (auto prim_func = expr.as<tir::PrimFunc>()) {
-      return prim_func.value();
-    } else if (const auto* var_node = expr.as<VarNode>()) {
-      auto itr = primitive_functions_.find(var_node);
-      if (itr == primitive_functions_.end()) {
-        // Not bound to a primitive function.
-        return {};
-      } else {
-        return itr->second;
-      }
-    } else if (const auto* function_node = expr.as<FunctionNode>()) {
-      if (function_node->HasNonzeroAttr(attr::kExtern)) {
-        // We have a regular call to an 'extern' function. The call itself needs to be rewritten
-        // to call_lowered form, and any required dynamic shape functions generated and
-        // cross-linked.
-        return GetRef<Function>(function_node);
-      } else if (function_node->HasNonzeroAttr(attr::kPrimitive)) {
-        if (const auto* call_node = function_node->body.as<CallNode>()) {
-          if (call_node->op == debug_op_) {
-            // Debug 'primitives' are not lowered.
-            return {};
-          }
-        }
-        // We have a regular call to a 'primitive' function (possibly with a 'Compiler' attribute).
-        // We need to lower and rewrite the call.
-        return GetRef<Function>(function_node);
-      } else {
-        // Not marked as primitive during partitioning or TVM fusion.
-        return {};
-      }
-    } else {
-      return {};
-    }
+    return tec::ResolveToPrimitive(module_, primitive_functions_, expr);
   }
 
   /*!
@@ -755,6 +969,14 @@ class LowerTensorExprMutator : public DeviceAwareExprMutator {
     if (!opt_compiler && original_function->HasNonzeroAttr(attr::kReshapeOnly)) {
       call_lowered_attrs.metadata.Set(attr::kReshapeOnly, tvm::Integer(1));
     }
+    if (const auto* function_node = original_function.as<FunctionNode>()) {
+      if (!opt_compiler && backend::IsInplaceEnabled()) {
+        Array<Integer> inplace_params = backend::GetInplaceParams(GetRef<Function>(function_node));
+        if (!inplace_params.empty()) {
+          call_lowered_attrs.metadata.Set(attr::kInplaceParams, inplace_params);
+        }
+      }
+    }
 
     call_lowered_attrs.metadata.Set("relay_attrs", original_function->attrs);
     call_lowered_attrs.metadata.Set("all_prim_fn_vars", all_prim_fn_vars);
@@ -947,17 +1169,89 @@ class LowerTensorExprMutator : public DeviceAwareExprMutator {
   // lowered for multiple device types, each which will be assigned a fresh var.
   std::unordered_map<const VarNode*, BaseFunc> primitive_functions_;
   TECompiler compiler_;
-  // Cache ops that need to be frequently used later to reduce lookup overhead.
-  const Op& debug_op_;
+};
+
+/*!
+ * \brief Collects the keys of the primitive functions which \p LowerTensorExprMutator will lower
+ * with \p TECompiler::Lower, in the order it will lower them.
+ */
+class PrimitiveKeyCollector : public DeviceAwareExprVisitor {
+ public:
+  PrimitiveKeyCollector(IRModule module, CompilationConfig config)
+      : DeviceAwareExprVisitor(module), module_(std::move(module)), config_(std::move(config)) {}
+
+  std::vector<CCacheKey> Collect(const Function& func) {
+    VisitExpr(func);
+    return std::move(keys_);
+  }
+
+ private:
+  void PreVisitLetBinding_(const Var& var, const Expr& value) final {
+    DeviceAwareExprVisitor::PreVisitLetBinding_(var, value);
+    BaseFunc prim_func = ResolveToPrimitive(module_, primitive_functions_, value);
+    if (prim_func.defined()) {
+      primitive_functions_.emplace(var.get(), prim_func);
+    }
+  }
+
+  void DeviceAwareVisitExpr_(const FunctionNode* function_node) final {
+    if (!function_node->HasNonzeroAttr(attr::kPrimitive) &&
+        !function_node->HasNonzeroAttr(attr::kExtern)) {
+      DeviceAwareExprVisitor::DeviceAwareVisitExpr_(function_node);
+    }
+  }
+
+  void DeviceAwareVisitExpr_(const CallNode* call_node) final {
+    // Same order as the mutator, the arguments are lowered before the callee.
+    for (const auto& arg : call_node->args) {
+      VisitExpr(arg);
+    }
+    VisitExpr(call_node->op);
+
+    BaseFunc primitive_func = ResolveToPrimitive(module_, primitive_functions_, call_node->op);
+    const auto* function_node = primitive_func.as<FunctionNode>();
+    if (function_node == nullptr || function_node->HasNonzeroAttr(attr::kExtern) ||
+        GetDeviceCopyProps(function_node->body).body.defined()) {
+      // Not lowered, or already lowered.
+      return;
+    }
+    Target target;
+    if (Optional<String> opt_compiler = function_node->GetAttr<String>(attr::kCompiler)) {
+      target = config_->FindPrimitiveTargetForKind(opt_compiler.value())
+                   .value_or(Target("ext_dev"));
+    } else {
+      VirtualDevice virtual_device = GetVirtualDevice(GetRef<Call>(call_node));
+      if (virtual_device->IsFullyUnconstrained()) return;
+      target = virtual_device->target;
+    }
+    keys_.emplace_back(GetRef<Function>(function_node), target,
+                       GetVirtualDevice(GetRef<Call>(call_node)));
+  }
+
+  IRModule module_;
+  CompilationConfig config_;
+  std::unordered_map<const VarNode*, BaseFunc> primitive_functions_;
+  std::vector<CCacheKey> keys_;
 };
 
 Pass LowerTensorExpr(TECompiler compiler, ProcessFn process_fn, CompilationConfig config) {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function func, IRModule module, PassContext ctx) {
+        int num_threads = ctx->GetConfig<Integer>("relay.backend.num_lowering_threads", Integer(1))
+                              .value()
+                              ->value;
+        if (num_threads <= 0) num_threads = runtime::threading::MaxConcurrency();
+        if (num_threads > 1) {
+          // Lower the primitive functions up front, the mutator then finds them in the cache.
+          TECompiler(compiler)->LowerInParallel(
+              PrimitiveKeyCollector(module, config).Collect(func), num_threads);
+        }
         LowerTensorExprMutator lower_te(module, process_fn, config, compiler);
         return Downcast<Function>(lower_te.Mutate(func));
       };
-  return CreateFunctionPass(pass_func, 0, "LowerTensorExpr", {});
+  // The mutator names and lowers the functions in order, and updates the metadata through
+  // process_fn, so the functions of the module are not mutated concurrently.
+  return CreateFunctionPass(pass_func, 0, "LowerTensorExpr", {}, /*thread_safe=*/false);
 }
 
 backend::FunctionInfo UpdateMainWorkspaceSize(const IRModule& mod, const CompilationConfig& config,
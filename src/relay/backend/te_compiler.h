@@ -48,6 +48,7 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "../transforms/infer_layout_utils.h"
 #include "../transforms/pass_utils.h"
@@ -82,6 +83,19 @@ class TECompilerNode : public Object {
    */
   virtual CachedFunc Lower(const CCacheKey& key, const String mod_name) = 0;
 
+  /*!
+   * \brief Lower the keys which are not cached yet on several threads, so that the calls to
+   * Lower for them hit the cache.
+   *
+   *  The global names are assigned in the order of \p keys, which is the order in which Lower
+   *  would have seen them, only the lowering to TIR runs concurrently. External functions are
+   *  left to Lower.
+   *
+   * \param keys The keys of the functions.
+   * \param num_threads The number of threads.
+   */
+  virtual void LowerInParallel(const std::vector<CCacheKey>& keys, int num_threads) = 0;
+
   /* Return all functions which have been lowered by the compiler in an IRModule, annotated with
    * their target. */
   virtual IRModule GetLoweredFunctions() = 0;
@@ -102,7 +102,7 @@ void TokenAllocator1D::CheckForRelease(StorageToken* tok) {
 
 StorageToken* TokenAllocator2D::Request(StorageToken* prototype) {
   auto shape = GetSize2D(prototype);
-  const int64_t max_ratio = 5;
+  const int64_t max_ratio = runtime::kTextureReuseMaxRatio;
   int64_t min_added_size_x = std::numeric_limits<int64_t>::max();
   int64_t min_added_size_y = std::numeric_limits<int64_t>::max();
   int64_t min_wasted_size_x = std::numeric_limits<int64_t>::max();
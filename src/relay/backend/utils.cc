@@ -25,11 +25,14 @@
 
 #include "utils.h"
 
+#include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/parser.h>
 #include <tvm/relay/qnn/transform.h>
 #include <tvm/runtime/ndarray.h>
 #include <tvm/tir/stmt_functor.h>
 
+#include <algorithm>
+
 #include "../../te/operation/create_primfunc.h"
 
 namespace tvm {
@@ -432,6 +435,51 @@ Optional<tir::PrimFunc> DefaultTIRConverterImpl(const Array<te::Tensor>& args,
   return func;
 }
 
+Array<Integer> GetInplaceParams(const Function& func) {
+  static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+  static bool has_finplace = Op::HasAttrMap("TInplaceOp");
+  Array<Integer> result;
+  const Type& ret_type = func->body->checked_type();
+  if (!ret_type->IsInstance<TensorTypeNode>()) return result;
+  auto is_inplace_op = [&](const Expr& expr) {
+    const auto* call = expr.as<CallNode>();
+    if (call == nullptr || !call->op->IsInstance<OpNode>()) return false;
+    Op op = Downcast<Op>(call->op);
+    bool is_elemwise = fpattern.get(op, kOpaque) == kElemWise;
+    return has_finplace ? Op::GetAttrMap<TInplaceOp>("TInplaceOp").get(op, is_elemwise)
+                        : is_elemwise;
+  };
+  for (size_t i = 0; i < func->params.size(); ++i) {
+    const Var& param = func->params[i];
+    if (!StructuralEqual()(param->checked_type(), ret_type)) continue;
+    // The expressions depending on the parameter, which must all be in-place of the output type
+    std::unordered_set<const Object*> dependents = {param.get()};
+    bool inplace = true;
+    PostOrderVisit(func->body, [&](const Expr& expr) {
+      Array<Expr> inputs;
+      if (const auto* call = expr.as<CallNode>()) {
+        inputs = call->args;
+      } else if (const auto* tuple = expr.as<TupleNode>()) {
+        inputs = tuple->fields;
+      } else if (const auto* tuple_get_item = expr.as<TupleGetItemNode>()) {
+        inputs = {tuple_get_item->tuple};
+      }
+      if (std::none_of(inputs.begin(), inputs.end(),
+                       [&](const Expr& input) { return dependents.count(input.get()); })) {
+        return;
+      }
+      dependents.insert(expr.get());
+      if (!is_inplace_op(expr) || !StructuralEqual()(expr->checked_type(), ret_type)) {
+        inplace = false;
+      }
+    });
+    if (inplace && dependents.count(func->body.get())) {
+      result.push_back(Integer(i));
+    }
+  }
+  return result;
+}
+
 TVM_REGISTER_GLOBAL("relay.backend.tir_converter.default")
     .set_body_typed([](const Array<te::Tensor>& args,
                        const Array<runtime::NDArray>& constants) -> Optional<tir::PrimFunc> {
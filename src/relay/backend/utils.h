@@ -641,6 +641,16 @@ inline int UseMetaScheduleDispatch() {
       .value()
       ->value;
 }
+/*!
+ * \brief Return whether primitive functions may write their outputs into the memory of their
+ * inputs in the pass context.
+ */
+inline bool IsInplaceEnabled() {
+  return transform::PassContext::Current()
+      ->GetConfig<Bool>("relay.backend.enable_inplace", Bool(false))
+      .value();
+}
+
 /*!
  * \brief Method in TECompiler to convert TE compute to scheduleable TIR
  * \param args The arguments of the TE compute
@@ -756,6 +766,14 @@ void UpdateAutoSchedulerOpWeights(const IRModule& module);
  */
 std::vector<int64_t> ShapeToJSON(tvm::Array<IndexExpr> shape);
 
+/*!
+ * \brief Get the parameters of a primitive function its output may be written into, those of the
+ * output type which only flow to the output through in-place operators of the output type.
+ * \param func The primitive function.
+ * \return The indices of the parameters.
+ */
+Array<Integer> GetInplaceParams(const Function& func);
+
 }  // namespace backend
 }  // namespace relay
 }  // namespace tvm
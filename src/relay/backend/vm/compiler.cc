@@ -63,6 +63,7 @@ namespace relay {
 namespace transform {
 
 Pass LambdaLift();
+Pass AnnotateShapeUpperBounds();
 Pass LabelOps();
 
 Pass MemoryPlan() {
@@ -1093,6 +1094,9 @@ IRModule VMCompiler::OptimizeModuleImpl(IRModule mod) {
     }
   }
 
+  // Bound the dynamic shapes by the upper bounds of the input shapes, if any.
+  pass_seqs.push_back(transform::AnnotateShapeUpperBounds());
+
   pass_seqs.push_back(transform::ToANormalForm());
   pass_seqs.push_back(transform::InferType());
   pass_seqs.push_back(transform::LambdaLift());
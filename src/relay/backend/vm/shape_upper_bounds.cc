@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/backend/vm/shape_upper_bounds.cc
+ * \brief Annotate the primitive calls whose results have dynamic shapes with static upper bounds
+ * of their result types, given the upper bounds of the shapes of the inputs of main. NOTE: the
+ * input IR should be fused but not lowered yet.
+ */
+
+#include <tvm/relay/analysis.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../transforms/pass_utils.h"
+
+namespace tvm {
+namespace relay {
+namespace transform {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.vm.shape_upper_bounds", Array<Array<ObjectRef>>);
+
+/*!
+ * \brief Helper class to annotate the primitive functions of calls with the upper bounds of their
+ * result types.
+ */
+class UpperBoundAnnotator : public ExprMutator {
+ public:
+  explicit UpperBoundAnnotator(const std::unordered_map<const CallNode*, Type>* upper_bounds)
+      : upper_bounds_(upper_bounds) {}
+
+  Expr VisitExpr_(const CallNode* call_node) final {
+    Call call = Downcast<Call>(ExprMutator::VisitExpr_(call_node));
+    auto it = upper_bounds_->find(call_node);
+    if (it == upper_bounds_->end()) {
+      return std::move(call);
+    }
+    Function func = Downcast<Function>(call->op);
+    func = WithAttr(std::move(func), attr::kShapeUpperBound, it->second);
+    return WithFields(std::move(call), std::move(func));
+  }
+
+ private:
+  /*! \brief The upper bound of the result type of each primitive call to annotate. */
+  const std::unordered_map<const CallNode*, Type>* upper_bounds_;
+};
+
+Pass AnnotateShapeUpperBounds() {
+  runtime::TypedPackedFunc<IRModule(IRModule, PassContext)> pass_func =
+      [](IRModule mod, PassContext pc) -> IRModule {
+    Array<Array<ObjectRef>> config =
+        pc->GetConfig<Array<Array<ObjectRef>>>("relay.vm.shape_upper_bounds", {}).value();
+    if (config.empty() || !mod->ContainGlobalVar("main")) {
+      return mod;
+    }
+    GlobalVar main_var = mod->GetGlobalVar("main");
+    std::unordered_map<std::string, Array<Integer>> input_upper_bounds;
+    for (const Array<ObjectRef>& entry : config) {
+      CHECK_EQ(entry.size(), 2U) << "ValueError: Expect each entry of relay.vm.shape_upper_bounds "
+                                    "to be an input name and the upper bound of its shape";
+      input_upper_bounds[Downcast<String>(entry[0])] = Downcast<Array<Integer>>(entry[1]);
+    }
+    // Step 1. Retype the parameters of main to the upper bounds of their shapes
+    Function main = Downcast<Function>(mod->Lookup(main_var));
+    Map<Var, Expr> bind_map;
+    for (const Var& param : main->params) {
+      auto it = input_upper_bounds.find(param->name_hint());
+      if (it == input_upper_bounds.end()) continue;
+      const auto* tensor_type = param->checked_type().as<TensorTypeNode>();
+      CHECK(tensor_type != nullptr && tensor_type->shape.size() == it->second.size())
+          << "ValueError: The upper bound " << it->second << " does not match the type "
+          << param->checked_type() << " of input " << param->name_hint();
+      Array<PrimExpr> shape;
+      for (size_t i = 0; i < tensor_type->shape.size(); ++i) {
+        const PrimExpr& dim = tensor_type->shape[i];
+        shape.push_back(dim->IsInstance<AnyNode>() ? PrimExpr(it->second[i]) : dim);
+      }
+      bind_map.Set(param, Var(param->name_hint(), TensorType(shape, tensor_type->dtype)));
+    }
+    if (bind_map.empty()) {
+      return mod;
+    }
+    IRModule bounded_mod = mod->ShallowCopy();
+    bounded_mod->Update(main_var, Downcast<Function>(Bind(main, bind_map)));
+    bounded_mod = InferType()(bounded_mod);
+    Function bounded_main = Downcast<Function>(bounded_mod->Lookup(main_var));
+    // Step 2. Match the calls of main with the calls of the retyped main, in the same post order
+    std::vector<const CallNode*> calls;
+    std::vector<const CallNode*> bounded_calls;
+    PostOrderVisit(main->body, [&calls](const Expr& expr) {
+      if (const auto* call = expr.as<CallNode>()) calls.push_back(call);
+    });
+    PostOrderVisit(bounded_main->body, [&bounded_calls](const Expr& expr) {
+      if (const auto* call = expr.as<CallNode>()) bounded_calls.push_back(call);
+    });
+    ICHECK_EQ(calls.size(), bounded_calls.size());
+    std::unordered_map<const CallNode*, Type> upper_bounds;
+    for (size_t i = 0; i < calls.size(); ++i) {
+      const auto* func = calls[i]->op.as<FunctionNode>();
+      if (func == nullptr || !func->HasNonzeroAttr(attr::kPrimitive)) continue;
+      // The results whose shapes stay dynamic depend on data rather than on the input shapes
+      if (IsDynamic(calls[i]->checked_type()) && !IsDynamic(bounded_calls[i]->checked_type())) {
+        upper_bounds.emplace(calls[i], bounded_calls[i]->checked_type());
+      }
+    }
+    if (upper_bounds.empty()) {
+      return mod;
+    }
+    // Step 3. Annotate the primitive functions of the calls
+    Function annotated = Downcast<Function>(UpperBoundAnnotator(&upper_bounds).Mutate(main));
+    mod.CopyOnWrite();
+    mod->Update(main_var, annotated);
+    return mod;
+  };
+  return CreateModulePass(pass_func, 0, "AnnotateShapeUpperBounds", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.AnnotateShapeUpperBounds")
+    .set_body_typed(AnnotateShapeUpperBounds);
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
@@ -24,6 +24,12 @@
 
 #include "./candidate_function_cache.h"
 
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
 namespace tvm {
 namespace relay {
 namespace collage {
@@ -44,6 +50,50 @@ GlobalVar CandidateFunctionCache::GetGlobalSymbol(const Function& function) {
   return GetEntry(/*label=*/"", function).global_symbol;
 }
 
+void CandidateFunctionCache::LoadCosts(const std::string& path) {
+  cost_path_ = path;
+  std::ifstream is(path);
+  std::string line;
+  // Each line is "<structural hash>\t<target>\t<cost>". Later lines override earlier ones.
+  while (std::getline(is, line)) {
+    size_t pos = line.rfind('\t');
+    if (pos == std::string::npos) continue;
+    double value = std::strtod(line.c_str() + pos + 1, nullptr);
+    if (std::isnan(value)) continue;
+    loaded_costs_.insert_or_assign(line.substr(0, pos),
+                                   std::isinf(value) ? Cost::Invalid() : Cost::Value(value));
+  }
+  VLOG(1) << "Loaded " << loaded_costs_.size() << " costs from " << path;
+}
+
+Cost CandidateFunctionCache::LoadedCost(const Function& function, const Target& target) const {
+  if (loaded_costs_.empty()) {
+    return Cost::Unknown();
+  }
+  auto itr = loaded_costs_.find(CostKey(function, target));
+  return itr == loaded_costs_.end() ? Cost::Unknown() : itr->second;
+}
+
+void CandidateFunctionCache::SaveCost(const Function& function, const Target& target, Cost cost) {
+  if (cost_path_.empty() || cost.is_unknown()) {
+    return;
+  }
+  std::ofstream os(cost_path_, std::ios::app);
+  os << CostKey(function, target) << "\t";
+  if (cost.is_invalid()) {
+    os << "inf";
+  } else {
+    os << std::setprecision(17) << cost.value();
+  }
+  os << std::endl;
+}
+
+std::string CandidateFunctionCache::CostKey(const Function& function, const Target& target) {
+  std::ostringstream os;
+  os << std::hex << StructuralHash()(function) << "\t" << target->str();
+  return os.str();
+}
+
 }  // namespace collage
 }  // namespace relay
 }  // namespace tvm
@@ -26,6 +26,7 @@
 #define TVM_RELAY_COLLAGE_CANDIDATE_FUNCTION_CACHE_H_
 
 #include <tvm/relay/function.h>
+#include <tvm/target/target.h>
 
 #include <memory>
 #include <string>
@@ -67,9 +68,31 @@ class CandidateFunctionCache : public transform::GlobalSymbolCache {
 
   GlobalVar GetGlobalSymbol(const Function& function) final;
 
+  /*!
+   * \brief Loads the costs estimated by previous runs, possibly for other models, from the file at
+   * \p path. The costs estimated from now on are appended to the file.
+   */
+  void LoadCosts(const std::string& path);
+
+  /*!
+   * \brief Returns the cost of \p function on \p target loaded from the cost file, or the unknown
+   * cost.
+   */
+  Cost LoadedCost(const Function& function, const Target& target) const;
+
+  /*! \brief Appends the cost of \p function on \p target to the cost file, if any. */
+  void SaveCost(const Function& function, const Target& target, Cost cost);
+
  private:
+  /*! \brief Returns the key of \p function on \p target in the cost file. */
+  static std::string CostKey(const Function& function, const Target& target);
+
   std::shared_ptr<NameSupply> name_supply_;
   std::unordered_map<Function, Entry, StructuralHash, StructuralEqual> cache_;
+  /*! \brief The path of the cost file, empty if costs are not persisted. */
+  std::string cost_path_;
+  /*! \brief The costs loaded from the cost file, by key. */
+  std::unordered_map<std::string, Cost> loaded_costs_;
 };
 
 }  // namespace collage
@@ -166,43 +166,68 @@ Function EtaExpandTuples(const Function& function) {
 Cost CandidatePartitionNode::EstimatedCost(
     const DataflowGraph& dataflow_graph, const CostEstimator& cost_estimator,
     const std::shared_ptr<CandidateFunctionCache>& cache) const {
-  if (cost_.is_unknown()) {
-    VLOG_CONTEXT << "spec " << partition_spec_name();
-    Function extracted_function = sub_graph_->ExtractAsFunction(dataflow_graph);
-    VLOG(2) << "Extracted function:" << std::endl << PrettyPrint(extracted_function);
-    extracted_function = EtaExpandTuples(extracted_function);
-    VLOG(2) << "Validating function:" << std::endl << PrettyPrint(extracted_function);
-    String error = partition_spec()->validate_sub_graph_func_(extracted_function);
-    if (!error.empty()) {
-      cost_ = Cost::Invalid();
-      VLOG(1) << "Unable to rewrite function: " << error;
-    } else {
-      // The extracted function may be the eta-expansion of a "Primitive" function.
-      // If so we want the cached external name and cost to be w.r.t. that function
-      // rather than the outer so that we'll get a cache hit when we outline functions
-      // in the final program.
-      Function primitive_function = GetPrimitiveFunction(extracted_function);
-      CandidateFunctionCache::Entry& entry =
-          cache->GetEntry(sub_graph_->label_, primitive_function);
-      if (entry.cost.is_unknown()) {
-        IRModule mod = IRModule::FromExpr(extracted_function);
-        VLOG(1) << "Outlining:" << std::endl << PrettyPrint(mod);
-        mod = OutlineCompilerFunctions(cache)(mod);
-        VLOG(1) << "Estimating cost of:" << std::endl
-                << PrettyPrint(mod) << std::endl
-                << "using target " << target()->ToDebugString();
-        entry.cost = cost_estimator->Estimate(mod, target());
-        VLOG(1) << "Measured cost as " << entry.cost.ToString();
-      } else {
-        VLOG(1) << "Reusing cost " << entry.cost.ToString()
-                << " cached in candidate function cache";
-      }
-      cost_ = entry.cost;
+  Function function;
+  Optional<IRModule> mod = PrepareEstimate(dataflow_graph, cache, &function);
+  if (mod.defined()) {
+    VLOG(1) << "Estimating cost of:" << std::endl
+            << PrettyPrint(mod.value()) << std::endl
+            << "using target " << target()->ToDebugString();
+    Cost cost = cost_estimator->Estimate(mod.value(), target());
+    VLOG(1) << "Measured cost as " << cost.ToString();
+    FinishEstimate(cache, function, cost);
+  }
+  return cost_;
+}
+
+Optional<IRModule> CandidatePartitionNode::PrepareEstimate(
+    const DataflowGraph& dataflow_graph, const std::shared_ptr<CandidateFunctionCache>& cache,
+    Function* function) const {
+  if (!cost_.is_unknown()) {
+    VLOG(1) << "Reusing cost " << cost_.ToString() << " cached in candidate";
+    return NullOpt;
+  }
+  VLOG_CONTEXT << "spec " << partition_spec_name();
+  Function extracted_function = sub_graph_->ExtractAsFunction(dataflow_graph);
+  VLOG(2) << "Extracted function:" << std::endl << PrettyPrint(extracted_function);
+  extracted_function = EtaExpandTuples(extracted_function);
+  VLOG(2) << "Validating function:" << std::endl << PrettyPrint(extracted_function);
+  String error = partition_spec()->validate_sub_graph_func_(extracted_function);
+  if (!error.empty()) {
+    cost_ = Cost::Invalid();
+    VLOG(1) << "Unable to rewrite function: " << error;
+    return NullOpt;
+  }
+  // The extracted function may be the eta-expansion of a "Primitive" function.
+  // If so we want the cached external name and cost to be w.r.t. that function
+  // rather than the outer so that we'll get a cache hit when we outline functions
+  // in the final program.
+  *function = GetPrimitiveFunction(extracted_function);
+  CandidateFunctionCache::Entry& entry = cache->GetEntry(sub_graph_->label_, *function);
+  if (entry.cost.is_unknown()) {
+    entry.cost = cache->LoadedCost(*function, target());
+    if (!entry.cost.is_unknown()) {
+      VLOG(1) << "Reusing cost " << entry.cost.ToString() << " loaded from cost file";
     }
   } else {
-    VLOG(1) << "Reusing cost " << cost_.ToString() << " cached in candidate";
+    VLOG(1) << "Reusing cost " << entry.cost.ToString() << " cached in candidate function cache";
   }
-  return cost_;
+  if (!entry.cost.is_unknown()) {
+    cost_ = entry.cost;
+    return NullOpt;
+  }
+  IRModule mod = IRModule::FromExpr(extracted_function);
+  VLOG(1) << "Outlining:" << std::endl << PrettyPrint(mod);
+  return OutlineCompilerFunctions(cache)(mod);
+}
+
+void CandidatePartitionNode::FinishEstimate(const std::shared_ptr<CandidateFunctionCache>& cache,
+                                            const Function& function, Cost cost) const {
+  CandidateFunctionCache::Entry& entry = cache->GetEntry(/*label=*/"", function);
+  if (entry.cost.is_unknown()) {
+    entry.cost = cost;
+    cache->SaveCost(function, target(), cost);
+  }
+  cost_ = entry.cost;
 }
 
 CandidatePartition::CandidatePartition(String rule_name, SubGraph sub_graph,
@@ -103,6 +103,22 @@ class CandidatePartitionNode : public Object {
   Cost EstimatedCost(const DataflowGraph& dataflow_graph, const CostEstimator& cost_estimator,
                      const std::shared_ptr<CandidateFunctionCache>& cache) const;
 
+  /*!
+   * \brief Returns the module whose estimated cost is the cost of the candidate partition, and sets
+   * \p function to the function sharing that cost in \p cache. Returns null if the cost is already
+   * known, either cached in the candidate, in \p cache, or loaded from the cost file of \p cache.
+   */
+  Optional<IRModule> PrepareEstimate(const DataflowGraph& dataflow_graph,
+                                     const std::shared_ptr<CandidateFunctionCache>& cache,
+                                     Function* function) const;
+
+  /*!
+   * \brief Caches \p cost, estimated for the module returned by \p PrepareEstimate, in the
+   * candidate and for \p function in \p cache.
+   */
+  void FinishEstimate(const std::shared_ptr<CandidateFunctionCache>& cache,
+                      const Function& function, Cost cost) const;
+
   /*!
    * \brief Returns a brief description of candidate suitable for debugging output.
    */
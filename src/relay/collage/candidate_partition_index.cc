@@ -24,6 +24,9 @@
 
 #include "./candidate_partition_index.h"
 
+#include <algorithm>
+#include <tuple>
+
 #include "./gather_partition_specs.h"
 #include "./prune_candidates.h"
 #include "./utils.h"
@@ -52,16 +55,44 @@ void CandidatePartitionIndex::Index(const Array<PartitionSpec>& partition_specs)
 
 void CandidatePartitionIndex::EstimateAllCosts(
     const CostEstimator cost_estimator, const std::shared_ptr<CandidateFunctionCache>& cache) {
-  size_t n = 0;
+  // Collect the modules to estimate, once per distinct function.
+  std::unordered_map<Function, size_t, StructuralHash, StructuralEqual> function_to_estimate;
+  std::vector<std::tuple<CandidatePartition, Function, size_t>> pending;
+  Array<IRModule> mods;
+  Array<Target> targets;
   for (PostDfsIndex index = 0; index < dataflow_graph_->size(); ++index) {
     for (const auto& candidate : first_inside_index_to_candidates_[index]) {
-      LOG(INFO) << "Estimating cost of candidate " << candidate->ToSummary(*dataflow_graph_) << " ["
-                << n++ << "/" << size_ << "]";
-      // Cost will be cached in candidate as a side effect.
-      Cost cost = candidate->EstimatedCost(*dataflow_graph_, cost_estimator, cache);
-      LOG(INFO) << "Candidate has cost " << cost.ToString();
+      Function function;
+      Optional<IRModule> mod = candidate->PrepareEstimate(*dataflow_graph_, cache, &function);
+      if (!mod.defined()) {
+        continue;
+      }
+      auto [itr, inserted] = function_to_estimate.emplace(function, mods.size());
+      if (inserted) {
+        mods.push_back(mod.value());
+        targets.push_back(candidate->target());
+      }
+      pending.emplace_back(candidate, function, itr->second);
     }
   }
+  LOG(INFO) << "Estimating cost of " << mods.size() << " distinct functions for " << size_
+            << " candidates";
+  // Estimate in batches, which the estimator may spread over workers and devices.
+  std::vector<Cost> costs;
+  for (size_t begin = 0; begin < mods.size(); begin += kEstimateBatchSize) {
+    size_t end = std::min(begin + kEstimateBatchSize, mods.size());
+    LOG(INFO) << "Estimating cost of functions [" << begin << ", " << end << ")/" << mods.size();
+    Array<IRModule> batch_mods(mods.begin() + begin, mods.begin() + end);
+    Array<Target> batch_targets(targets.begin() + begin, targets.begin() + end);
+    std::vector<Cost> batch_costs = cost_estimator->EstimateBatch(batch_mods, batch_targets);
+    ICHECK_EQ(batch_costs.size(), end - begin);
+    costs.insert(costs.end(), batch_costs.begin(), batch_costs.end());
+  }
+  for (const auto& [candidate, function, estimate_index] : pending) {
+    candidate->FinishEstimate(cache, function, costs[estimate_index]);
+    VLOG(1) << "Candidate " << candidate->ToSummary(*dataflow_graph_) << " has cost "
+            << costs[estimate_index].ToString();
+  }
 }
 
 std::string CandidatePartitionIndex::ToSummary() const {
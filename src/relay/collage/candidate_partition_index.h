@@ -57,10 +57,15 @@ class CandidatePartitionIndex {
     return first_inside_index_to_candidates_[index];
   }
 
-  /*! \brief Estimates the casts of all candidates in the index. Each candidate caches its cost. */
+  /*!
+   * \brief Estimates the casts of all candidates in the index. Each candidate caches its cost.
+   * The distinct functions are estimated in batches of \p kEstimateBatchSize.
+   */
   void EstimateAllCosts(const CostEstimator cost_estimator,
                         const std::shared_ptr<CandidateFunctionCache>& cache);
 
+  static constexpr size_t kEstimateBatchSize = 64;
+
   size_t size() const { return size_; }
 
   std::string ToSummary() const;
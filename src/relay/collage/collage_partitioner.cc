@@ -56,6 +56,10 @@ namespace {
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.tvm_max_depth", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.byoc_max_depth", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.byoc_fusion_style", Array<String>);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.cost_cache_path", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.rpc_tracker", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.rpc_key", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.collage.rpc_num_devices", Integer);
 /*!
  * \brief Represents the overall expression after some number of non-overlapping candidate
  * partitions have been applied.
@@ -324,6 +328,11 @@ transform::Pass CollagePartition(CompilationConfig config, CostEstimator cost_es
 
         auto cache =
             std::make_shared<CandidateFunctionCache>(std::make_shared<NameSupply>("collage"));
+        Optional<String> cost_cache_path =
+            ctxt->GetConfig("relay.collage.cost_cache_path", Optional<String>());
+        if (cost_cache_path.defined() && !cost_cache_path.value().empty()) {
+          cache->LoadCosts(cost_cache_path.value());
+        }
 
         IRModule out_mod = mod->ShallowCopy();
         for (const auto& kv : mod->functions) {
@@ -37,12 +37,8 @@ CostEstimator::CostEstimator() {
   data_ = std::move(node);
 }
 
-Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) const {
-  // TODO(mbs): Eventually should be abstract. For now bounce to the Python local impl.
-  static const runtime::PackedFunc* estimate_seconds =
-      runtime::Registry::Get("tvm.relay.collage.estimate_seconds");
-  ICHECK(estimate_seconds);
-  const double value = (*estimate_seconds)(mod, target);
+namespace {
+Cost CostFromSeconds(double value) {
   if (std::isinf(value)) {
     return Cost::Invalid();
   } else if (std::isnan(value)) {
@@ -51,6 +47,37 @@ Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) cons
     return Cost::Value(value);
   }
 }
+}  // namespace
+
+Cost CostEstimatorNode::Estimate(const IRModule& mod, const Target& target) const {
+  // TODO(mbs): Eventually should be abstract. For now bounce to the Python local impl.
+  static const runtime::PackedFunc* estimate_seconds =
+      runtime::Registry::Get("tvm.relay.collage.estimate_seconds");
+  ICHECK(estimate_seconds);
+  const double value = (*estimate_seconds)(mod, target);
+  return CostFromSeconds(value);
+}
+
+std::vector<Cost> CostEstimatorNode::EstimateBatch(const Array<IRModule>& mods,
+                                                   const Array<Target>& targets) const {
+  ICHECK_EQ(mods.size(), targets.size());
+  std::vector<Cost> costs;
+  costs.reserve(mods.size());
+  static const runtime::PackedFunc* estimate_seconds_batch =
+      runtime::Registry::Get("tvm.relay.collage.estimate_seconds_batch");
+  if (type_index() != CostEstimatorNode::RuntimeTypeIndex() || estimate_seconds_batch == nullptr) {
+    for (size_t i = 0; i < mods.size(); ++i) {
+      costs.push_back(Estimate(mods[i], targets[i]));
+    }
+    return costs;
+  }
+  Array<FloatImm> seconds = (*estimate_seconds_batch)(mods, targets);
+  ICHECK_EQ(seconds.size(), mods.size());
+  for (const FloatImm& value : seconds) {
+    costs.push_back(CostFromSeconds(value->value));
+  }
+  return costs;
+}
 
 TVM_REGISTER_GLOBAL("relay.collage.CostEstimator").set_body_typed([]() { return CostEstimator(); });
 
@@ -27,6 +27,8 @@
 
 #include <tvm/relay/function.h>
 
+#include <vector>
+
 #include "./cost.h"
 
 namespace tvm {
@@ -54,6 +56,15 @@ class CostEstimatorNode : public Object {
    */
   virtual Cost Estimate(const IRModule& mod, const Target& target) const;
 
+  /*!
+   * \brief Returns the estimated costs of running "main" in each of \p mods using the corresponding
+   * \p targets. The estimates are independent, so may be made in parallel. By default they are
+   * made one at a time by \p Estimate, except for this local estimator which hands the whole batch
+   * to Python to compile in parallel and measure across the available devices.
+   */
+  virtual std::vector<Cost> EstimateBatch(const Array<IRModule>& mods,
+                                          const Array<Target>& targets) const;
+
   static constexpr const char* _type_key = "relay.collage.CostEstimator";
   TVM_DECLARE_BASE_OBJECT_INFO(CostEstimatorNode, Object);
 };
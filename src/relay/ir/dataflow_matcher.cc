@@ -557,14 +557,56 @@ class MatchExtractor : public ExprMutator {
   const std::unordered_map<Expr, Var, ObjectPtrHash, ObjectPtrEqual> inputs_;
 };
 
+/*!
+ * \brief Collect the names of the operators called by the expressions \p pattern matches.
+ * \return False if the pattern can also match other expressions.
+ */
+bool CollectRootOps(const DFPattern& pattern, std::unordered_set<std::string>* ops) {
+  if (const auto* call = pattern.as<CallPatternNode>()) {
+    if (const auto* expr_pattern = call->op.as<ExprPatternNode>()) {
+      if (const auto* op = expr_pattern->expr.as<OpNode>()) {
+        ops->insert(op->name);
+        // The matcher also associates multiplications and divisions.
+        if (op->name == "multiply" || op->name == "divide") {
+          ops->insert("multiply");
+          ops->insert("divide");
+        }
+        return true;
+      }
+    }
+    return false;
+  } else if (const auto* alt = pattern.as<AltPatternNode>()) {
+    return CollectRootOps(alt->left, ops) && CollectRootOps(alt->right, ops);
+  } else if (const auto* attr = pattern.as<AttrPatternNode>()) {
+    return CollectRootOps(attr->pattern, ops);
+  } else if (const auto* type = pattern.as<TypePatternNode>()) {
+    return CollectRootOps(type->pattern, ops);
+  } else if (const auto* shape = pattern.as<ShapePatternNode>()) {
+    return CollectRootOps(shape->pattern, ops);
+  } else if (const auto* dtype = pattern.as<DataTypePatternNode>()) {
+    return CollectRootOps(dtype->pattern, ops);
+  } else if (const auto* dominator = pattern.as<DominatorPatternNode>()) {
+    return CollectRootOps(dominator->child, ops);
+  }
+  return false;
+}
+
 /*! \brief Group expressions that match the pattern */
 const std::unordered_map<int, PatternGrouper::Group>& PatternGrouper::GroupMatches(
-    const DFPattern& pattern, const Expr& pre) {
+    const DFPattern& pattern, const Expr& pre, ExprSet* unmatched) {
   groups_.clear();
   gid_assignments_.clear();
 
   pattern_ = pattern;
   pattern_graph_ = CreateIndexedGraph(pattern_);
+  root_ops_.clear();
+  anchored_ = CollectRootOps(pattern_, &root_ops_);
+  unmatched_ = unmatched;
+  for (PostDfsIndex index = 0; unmatched_ && index < pattern_graph_->size(); ++index) {
+    if (pattern_graph_->index_to_node(index)->ref().as<DominatorPatternNode>()) {
+      unmatched_ = nullptr;
+    }
+  }
   std::unique_ptr<IndexedGraph<Expr>> expr_graph = CreateIndexedGraph(pre);
   DFPatternMatcher matcher(expr_graph.get());
   matcher_ = &matcher;
@@ -585,13 +627,28 @@ void PatternGrouper::VisitExprs() {
                          [&pre_partitioned](const Expr& expr) { pre_partitioned.insert(expr); });
         }
       }
-      if (pre_partitioned.count(current) == 0 && matcher_->Match(pattern_, current)) {
-        CreateGroup(current);
+      if (pre_partitioned.count(current) == 0 && IsAnchor(current) &&
+          !(unmatched_ && unmatched_->count(current))) {
+        if (matcher_->Match(pattern_, current)) {
+          CreateGroup(current);
+        } else if (unmatched_) {
+          unmatched_->insert(current);
+        }
       }
     }
   }
 }
 
+bool PatternGrouper::IsAnchor(const Expr& expr) const {
+  if (!anchored_) return true;
+  if (const auto* call = expr.as<CallNode>()) {
+    if (const auto* op = call->op.as<OpNode>()) {
+      return root_ops_.count(op->name) != 0;
+    }
+  }
+  return false;
+}
+
 void PatternGrouper::CreateGroup(const Expr& expr) {
   VLOG(1) << "Creating group for:" << std::endl << PrettyPrint(expr);
 
@@ -798,6 +855,10 @@ Expr PatternRewriter::Rewrite(const Array<DFPatternCallback>& callbacks, const E
   ICHECK(structural_equal) << "node.StructuralEqual is not registered.";
   // Keep track of callbacks that have finished rewriting
   std::unordered_map<DFPatternCallback, bool, ObjectPtrHash, ObjectPtrEqual> done;
+  // The expressions each callback did not match, skipped while they are left unchanged. The type
+  // inference rebuilds the whole graph, so they are not kept for the callbacks requiring types.
+  std::unordered_map<DFPatternCallback, PatternGrouper::ExprSet, ObjectPtrHash, ObjectPtrEqual>
+      unmatched;
   do {
     last = post;
     for (auto callback : callbacks) {
@@ -808,7 +869,8 @@ Expr PatternRewriter::Rewrite(const Array<DFPatternCallback>& callbacks, const E
           post = InferTypeWithModule(post, mod_);
         }
         auto grouper = PatternGrouper();
-        groups_ = grouper.GroupMatches(callback_->pattern, post);
+        groups_ = grouper.GroupMatches(callback_->pattern, post,
+                                       callback_->require_type ? nullptr : &unmatched[callback]);
         gid_assignments_ = grouper.GetGIDAssignments();
         memo_.clear();
         VLOG(1) << "pre rewritten:" << std::endl << PrettyPrint(pre);
@@ -823,7 +885,10 @@ Expr PatternRewriter::Rewrite(const Array<DFPatternCallback>& callbacks, const E
         }
       }
     }
-    equal = (*structural_equal)(last, post, false, true);
+    equal = last.same_as(post);
+    if (!equal) {
+      equal = (*structural_equal)(last, post, false, true);
+    }
   } while (!equal && count < 100);
   if (count >= 100) {
     LOG(FATAL) << "Observed 100 rewrite passes, possible conflicting passes?";
@@ -32,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "indexed_graph.h"
@@ -97,6 +98,8 @@ class DFPatternMatcher : public DFPatternFunctor<bool(const DFPattern&, const Ex
  */
 class PatternGrouper {
  public:
+  using ExprSet = std::unordered_set<Expr, ObjectPtrHash, ObjectPtrEqual>;
+
   /*! \brief Internal Group class for storing analysis */
   struct Group {
     Expr root_node;
@@ -111,8 +114,15 @@ class PatternGrouper {
   inline const std::unordered_map<Expr, int, ObjectPtrHash, ObjectPtrEqual>& GetGIDAssignments() {
     return gid_assignments_;
   }
-  /*! \brief Group expressions that match the pattern */
-  const std::unordered_map<int, Group>& GroupMatches(const DFPattern& pattern, const Expr& pre);
+  /*!
+   * \brief Group expressions that match the pattern
+   * \param unmatched The expressions known not to match the pattern, which are skipped and
+   *  extended with the new mismatches. A match only depends on the inputs of an expression,
+   *  so the unchanged expressions of a rewritten graph are not matched again. It is ignored
+   *  for dominator patterns, which also depend on the consumers.
+   */
+  const std::unordered_map<int, Group>& GroupMatches(const DFPattern& pattern, const Expr& pre,
+                                                     ExprSet* unmatched = nullptr);
 
  protected:
   /*! \brief Iteratively traverse the Expression in pre-order to find subgraphs
@@ -140,8 +150,14 @@ class PatternGrouper {
    * lift the constant into the arguments of the partitioned function.
    */
   bool EmbedConst(const Expr& expr, const DFPattern pattern);
+  /*! \brief Whether the pattern can match \p expr, judging by the operator of its root. */
+  bool IsAnchor(const Expr& expr) const;
   // Internal State
   DFPattern pattern_;
+  /*! \brief The operators the root of the pattern calls, if it only matches calls to them. */
+  std::unordered_set<std::string> root_ops_;
+  bool anchored_ = false;
+  ExprSet* unmatched_ = nullptr;
   std::unordered_map<int, Group> groups_;
   std::unordered_map<Expr, int, ObjectPtrHash, ObjectPtrEqual> gid_assignments_;
   DFPatternMatcher* matcher_ = nullptr;
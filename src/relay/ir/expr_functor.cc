@@ -104,50 +104,114 @@ Expr MixedModeMutator::VisitExpr(const Expr& expr) {
   }
 }
 
-class PostOrderRewriter : public MixedModeMutator {
- public:
-  explicit PostOrderRewriter(ExprRewriter* rewriter) : rewriter_(rewriter) {}
-
-  Expr DispatchVisitExpr(const Expr& expr) final {
-    auto post = ExprFunctor::VisitExpr(expr);
-    return rewriter_->Rewrite(expr, post);
-  }
-
-  using MixedModeMutator::VisitExpr_;
+namespace {
+
+/*! \return The inputs of \p expr, in the order ExprMutator visits them. */
+std::vector<Expr> MutatorInputs(const Expr& expr) {
+  std::vector<Expr> inputs;
+  if (const auto* call = expr.as<CallNode>()) {
+    inputs.push_back(call->op);
+    for (const Expr& arg : call->args) inputs.push_back(arg);
+  } else if (const auto* tuple = expr.as<TupleNode>()) {
+    for (const Expr& field : tuple->fields) inputs.push_back(field);
+  } else if (const auto* get_item = expr.as<TupleGetItemNode>()) {
+    inputs.push_back(get_item->tuple);
+  } else if (const auto* func = expr.as<FunctionNode>()) {
+    for (const Var& param : func->params) inputs.push_back(param);
+    inputs.push_back(func->body);
+  } else if (const auto* let = expr.as<LetNode>()) {
+    inputs = {let->var, let->value, let->body};
+  } else if (const auto* if_node = expr.as<IfNode>()) {
+    inputs = {if_node->cond, if_node->true_branch, if_node->false_branch};
+  } else if (const auto* ref_create = expr.as<RefCreateNode>()) {
+    inputs.push_back(ref_create->value);
+  } else if (const auto* ref_read = expr.as<RefReadNode>()) {
+    inputs.push_back(ref_read->ref);
+  } else if (const auto* ref_write = expr.as<RefWriteNode>()) {
+    inputs = {ref_write->ref, ref_write->value};
+  } else if (const auto* match = expr.as<MatchNode>()) {
+    for (const Clause& clause : match->clauses) inputs.push_back(clause->rhs);
+    inputs.push_back(match->data);
+  }
+  return inputs;
+}
 
-  Expr VisitExpr_(const LetNode* node) final {
-    auto pre_visit = [this](const LetNode* op) {
-      Expr var = this->Mutate(op->var);
-      Expr value = this->Mutate(op->value);
-    };
-    auto post_visit = [this, node](const LetNode* op) {
-      Var var = Downcast<Var>(this->Mutate(op->var));
-      Expr value = this->Mutate(op->value);
-      Expr body = this->Mutate(op->body);
-      Expr expr = GetRef<Expr>(op);
-      Expr post;
-      if (var.same_as(op->var) && value.same_as(op->value) && body.same_as(op->body)) {
-        post = expr;
-      } else {
-        post = Let(var, value, body);
-      }
-      //  avoid rewriting the first LetNode twice
-      if (op == node) {
-        this->memo_[expr] = post;
-      } else {
-        this->memo_[expr] = this->rewriter_->Rewrite(expr, post);
+/*!
+ * \brief Rebuild \p expr on its rewritten inputs, as ExprMutator does.
+ * \param input The rewritten input of the given position in MutatorInputs.
+ */
+template <typename FInput>
+Expr WithInputs(const Expr& expr, FInput input) {
+  if (const auto* call = expr.as<CallNode>()) {
+    Array<Expr> args;
+    for (size_t i = 0; i < call->args.size(); ++i) args.push_back(input(i + 1));
+    return WithFields(GetRef<Call>(call), input(0), args);
+  } else if (const auto* tuple = expr.as<TupleNode>()) {
+    Array<Expr> fields;
+    for (size_t i = 0; i < tuple->fields.size(); ++i) fields.push_back(input(i));
+    return WithFields(GetRef<Tuple>(tuple), fields);
+  } else if (const auto* get_item = expr.as<TupleGetItemNode>()) {
+    return WithFields(GetRef<TupleGetItem>(get_item), input(0));
+  } else if (const auto* func = expr.as<FunctionNode>()) {
+    Array<Var> params;
+    for (size_t i = 0; i < func->params.size(); ++i) params.push_back(Downcast<Var>(input(i)));
+    return WithFields(GetRef<Function>(func), params, input(func->params.size()));
+  } else if (const auto* let = expr.as<LetNode>()) {
+    return WithFields(GetRef<Let>(let), Downcast<Var>(input(0)), input(1), input(2));
+  } else if (const auto* if_node = expr.as<IfNode>()) {
+    return WithFields(GetRef<If>(if_node), input(0), input(1), input(2));
+  } else if (const auto* ref_create = expr.as<RefCreateNode>()) {
+    return WithFields(GetRef<RefCreate>(ref_create), input(0));
+  } else if (const auto* ref_read = expr.as<RefReadNode>()) {
+    return WithFields(GetRef<RefRead>(ref_read), input(0));
+  } else if (const auto* ref_write = expr.as<RefWriteNode>()) {
+    return WithFields(GetRef<RefWrite>(ref_write), input(0), input(1));
+  } else if (const auto* match = expr.as<MatchNode>()) {
+    Array<Clause> clauses;
+    for (size_t i = 0; i < match->clauses.size(); ++i) {
+      clauses.push_back(WithFields(match->clauses[i], NullOpt, input(i)));
+    }
+    return WithFields(GetRef<Match>(match), input(match->clauses.size()), clauses);
+  }
+  return expr;
+}
+
+}  // namespace
+
+PostDfsOrder::PostDfsOrder(const Expr& expr) {
+  std::unordered_map<const Object*, size_t> ids;
+  // The nodes whose inputs are pushed are visited the second time they are on top.
+  std::vector<std::pair<Expr, bool>> stack = {{expr, false}};
+  input_begin_.push_back(0);
+  while (!stack.empty()) {
+    auto& top = stack.back();
+    if (ids.count(top.first.get())) {
+      stack.pop_back();
+    } else if (!top.second) {
+      top.second = true;
+      std::vector<Expr> inputs = MutatorInputs(top.first);
+      for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+        if (!ids.count(it->get())) stack.emplace_back(*it, false);
       }
-    };
-    ExpandANormalForm(node, pre_visit, post_visit);
-    return memo_[GetRef<Expr>(node)];
+    } else {
+      Expr node = std::move(top.first);
+      stack.pop_back();
+      for (const Expr& input : MutatorInputs(node)) input_ids_.push_back(ids.at(input.get()));
+      input_begin_.push_back(input_ids_.size());
+      ids.emplace(node.get(), nodes_.size());
+      nodes_.push_back(std::move(node));
+    }
   }
-
- protected:
-  ExprRewriter* rewriter_;
-};
+}
 
 Expr PostOrderRewrite(const Expr& expr, ExprRewriter* rewriter) {
-  return PostOrderRewriter(rewriter).VisitExpr(expr);
+  PostDfsOrder order(expr);
+  std::vector<Expr> memo(order.size());
+  for (size_t id = 0; id < order.size(); ++id) {
+    Expr post = WithInputs(order[id], [&](size_t i) { return memo[order.input(id, i)]; });
+    memo[id] = rewriter->Rewrite(order[id], post);
+  }
+  return memo.back();
 }
 
 Expr ExprMutator::VisitExpr(const Expr& expr) {
@@ -130,10 +130,12 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   for (const auto& kv : mod->functions) {
     // only process optimizable Relay Functions
     if (const auto* function_node = AsOptimizableFunctionNode(kv.second)) {
-      Function updated_func = pass_func(GetRef<Function>(function_node), updated_mod, pass_ctx);
-      updates.push_back({kv.first, std::move(updated_func)});
+      updates.push_back({kv.first, GetRef<Function>(function_node)});
     }
   }
+  tvm::transform::ForEachFunction(pass_ctx, pass_info, updates.size(), [&](size_t i) {
+    updates[i].second = pass_func(updates[i].second, updated_mod, pass_ctx);
+  });
 
   for (const auto& pair : updates) {
     updated_mod->Add(pair.first, pair.second, true);
@@ -154,8 +156,8 @@ IRModule FunctionPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreateFunctionPass(
     const runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required) {
-  PassInfo pass_info = PassInfo(opt_level, name, required);
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, thread_safe);
   return FunctionPass(pass_func, pass_info);
 }
 
@@ -135,5 +135,13 @@ bool IsReshapeOnly(const CallLoweredProps& props) {
   return false;
 }
 
+Array<Integer> GetInplaceParams(const CallLoweredProps& props) {
+  auto it = props.attrs.metadata.find(attr::kInplaceParams);
+  if (it != props.attrs.metadata.end()) {
+    return Downcast<Array<Integer>>((*it).second);
+  }
+  return {};
+}
+
 }  // namespace relay
 }  // namespace tvm
@@ -90,6 +90,12 @@ Call GetAnyCall(const CallNode* call_node);
  */
 bool IsReshapeOnly(const CallLoweredProps& props);
 
+/*!
+ * \brief Returns the indices of the arguments the lowered call described by \p props may write
+ * its output into, empty unless in-place execution was enabled when lowering.
+ */
+Array<Integer> GetInplaceParams(const CallLoweredProps& props);
+
 }  // namespace relay
 }  // namespace tvm
 
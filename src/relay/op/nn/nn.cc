@@ -306,6 +306,126 @@ RELAY_REGISTER_OP("nn.contrib_dense_pack")
 
 // ------------------- relay.nn.contrib_dense_pack
 
+// ------------------- relay.nn.dense_weight_only
+TVM_REGISTER_NODE_TYPE(DenseWeightOnlyAttrs);
+
+Expr MakeDenseWeightOnly(Expr data, Expr packed_weight, Expr scales, int bits, int group_size,
+                         DataType out_dtype) {
+  auto attrs = make_object<DenseWeightOnlyAttrs>();
+  attrs->bits = bits;
+  attrs->group_size = group_size;
+  attrs->out_dtype = out_dtype;
+  static const Op& op = Op::Get("nn.dense_weight_only");
+  return Call(op, {data, packed_weight, scales}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.dense_weight_only").set_body_typed(MakeDenseWeightOnly);
+
+bool DenseWeightOnlyRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                        const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 4);
+  const auto* data = types[0].as<TensorTypeNode>();
+  const auto* packed_weight = types[1].as<TensorTypeNode>();
+  const auto* scales = types[2].as<TensorTypeNode>();
+  if (data == nullptr || packed_weight == nullptr || scales == nullptr) return false;
+
+  const DenseWeightOnlyAttrs* param = attrs.as<DenseWeightOnlyAttrs>();
+  ICHECK(param != nullptr);
+  ICHECK(param->bits == 2 || param->bits == 4 || param->bits == 8)
+      << "Unsupported number of bits " << param->bits;
+  ICHECK_GT(param->group_size, 0);
+
+  ICHECK_EQ(data->shape.size(), 2) << "Only 2D data is supported";
+  ICHECK_EQ(packed_weight->shape.size(), 2) << "Expect packed weight to be 2D";
+  ICHECK_EQ(scales->shape.size(), 2) << "Expect scales to be 2D";
+  ICHECK(packed_weight->dtype == DataType::UInt(32)) << "Expect packed weight to be uint32";
+
+  PrimExpr in_dim = data->shape[1];
+  reporter->AssertEQ(packed_weight->shape[1] * (32 / param->bits), in_dim);
+  reporter->AssertEQ(scales->shape[0], packed_weight->shape[0]);
+  reporter->AssertEQ(scales->shape[1] * param->group_size, in_dim);
+
+  Array<tvm::PrimExpr> oshape = data->shape;
+  oshape.Set(1, packed_weight->shape[0]);
+
+  DataType out_dtype = param->out_dtype;
+  if (out_dtype.bits() == 0) {
+    out_dtype = data->dtype;
+  }
+  reporter->Assign(types[3], TensorType(oshape, out_dtype));
+  return true;
+}
+
+RELAY_REGISTER_OP("nn.dense_weight_only")
+    .describe(R"code(Applies a linear transformation :math:`Y = XW^T` with a weight quantized
+to a few bits, dequantized while it is reduced.
+
+- **data**: `(batch, input_dim)`
+- **packed_weight**: `(units, input_dim * bits // 32)`, as given by dense_weight_only_pack.
+- **scales**: `(units, input_dim // group_size)`
+- **out**: `(batch, units)`.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<DenseWeightOnlyAttrs>()
+    .set_num_inputs(3)
+    .add_argument("data", "2D Tensor", "Input data.")
+    .add_argument("packed_weight", "2D Tensor", "Packed quantized weight matrix.")
+    .add_argument("scales", "2D Tensor", "Scales of the groups of the weight.")
+    .set_support_level(10)
+    .add_type_rel("DenseWeightOnly", DenseWeightOnlyRel)
+    .set_attr<TOpPattern>("TOpPattern", kOutEWiseFusable);
+
+// ------------------- relay.nn.dense_weight_only
+
+// ------------------- relay.nn.dense_weight_only_pack
+TVM_REGISTER_NODE_TYPE(DenseWeightOnlyPackAttrs);
+
+Expr MakeDenseWeightOnlyPack(Expr weight, int bits) {
+  auto attrs = make_object<DenseWeightOnlyPackAttrs>();
+  attrs->bits = bits;
+  static const Op& op = Op::Get("nn.dense_weight_only_pack");
+  return Call(op, {weight}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.dense_weight_only_pack")
+    .set_body_typed(MakeDenseWeightOnlyPack);
+
+bool DenseWeightOnlyPackRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                            const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 2);
+  const auto* weight = types[0].as<TensorTypeNode>();
+  if (weight == nullptr) return false;
+
+  const DenseWeightOnlyPackAttrs* param = attrs.as<DenseWeightOnlyPackAttrs>();
+  ICHECK(param != nullptr);
+  ICHECK(param->bits == 2 || param->bits == 4 || param->bits == 8)
+      << "Unsupported number of bits " << param->bits;
+  ICHECK_EQ(weight->shape.size(), 2) << "Expect weight to be 2D";
+  ICHECK(weight->dtype.is_int() || weight->dtype.is_uint()) << "Expect an integer weight";
+
+  Array<tvm::PrimExpr> oshape = weight->shape;
+  oshape.Set(1, indexdiv(weight->shape[1], 32 / param->bits));
+  reporter->Assign(types[1], TensorType(oshape, DataType::UInt(32)));
+  return true;
+}
+
+RELAY_REGISTER_OP("nn.dense_weight_only_pack")
+    .describe(R"code(Packs a weight quantized to a few bits into 32-bit words, for
+dense_weight_only.
+
+- **weight**: `(units, input_dim)`, holding values in the signed range of `bits`.
+- **out**: `(units, input_dim * bits // 32)`, of type uint32.
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<DenseWeightOnlyPackAttrs>()
+    .set_num_inputs(1)
+    .add_argument("weight", "2D Tensor", "Quantized weight matrix.")
+    .set_support_level(10)
+    .add_type_rel("DenseWeightOnlyPack", DenseWeightOnlyPackRel)
+    .set_attr<TOpPattern>("TOpPattern", kInjective);
+
+// ------------------- relay.nn.dense_weight_only_pack
+
 // relay.leaky_relu
 TVM_REGISTER_NODE_TYPE(LeakyReluAttrs);
 
@@ -1026,6 +1146,70 @@ RELAY_REGISTER_OP("nn.layer_norm")
     .set_support_level(1)
     .add_type_rel("LayerNorm", LayerNormRel);
 
+// fused_attention
+TVM_REGISTER_NODE_TYPE(FusedAttentionAttrs);
+
+bool FusedAttentionRel(const Array<Type>& types, int num_inputs, const Attrs& attrs,
+                       const TypeReporter& reporter) {
+  ICHECK_EQ(types.size(), 4);
+  const auto* query = types[0].as<TensorTypeNode>();
+  const auto* key = types[1].as<TensorTypeNode>();
+  const auto* value = types[2].as<TensorTypeNode>();
+  if (query == nullptr || key == nullptr || value == nullptr) return false;
+  ICHECK_EQ(query->shape.size(), 4) << "fused_attention expects 4-D query, got " << query->shape;
+  ICHECK_EQ(key->shape.size(), 4) << "fused_attention expects 4-D key, got " << key->shape;
+  ICHECK_EQ(value->shape.size(), 4) << "fused_attention expects 4-D value, got " << value->shape;
+  for (int i = 0; i < 2; ++i) {
+    ICHECK(reporter->AssertEQ(query->shape[i], key->shape[i]) &&
+           reporter->AssertEQ(query->shape[i], value->shape[i]))
+        << "fused_attention batch and head dimensions must match: " << query->shape << " vs "
+        << key->shape << " vs " << value->shape;
+  }
+  ICHECK(reporter->AssertEQ(query->shape[3], key->shape[3]))
+      << "fused_attention query and key head dimensions must match: " << query->shape << " vs "
+      << key->shape;
+  ICHECK(reporter->AssertEQ(key->shape[2], value->shape[2]))
+      << "fused_attention key and value sequence lengths must match: " << key->shape << " vs "
+      << value->shape;
+  Array<IndexExpr> oshape{query->shape[0], query->shape[1], query->shape[2], value->shape[3]};
+  reporter->Assign(types[3], TensorType(oshape, query->dtype));
+  return true;
+}
+
+Expr MakeFusedAttention(Expr query, Expr key, Expr value, double scale, bool causal) {
+  auto attrs = make_object<FusedAttentionAttrs>();
+  attrs->scale = scale;
+  attrs->causal = causal;
+  static const Op& op = Op::Get("nn.fused_attention");
+  return Call(op, {query, key, value}, Attrs(attrs), {});
+}
+
+TVM_REGISTER_GLOBAL("relay.op.nn._make.fused_attention").set_body_typed(MakeFusedAttention);
+
+RELAY_REGISTER_OP("nn.fused_attention")
+    .describe(R"code(Fused scaled dot-product attention.
+
+.. math::
+
+  out = softmax(scale * query * key^T) * value
+
+The softmax is computed row by row and never materializes the full attention matrix.
+
+- **query**: `(batch, heads, q_len, head_dim)`
+- **key**: `(batch, heads, kv_len, head_dim)`
+- **value**: `(batch, heads, kv_len, value_dim)`
+- **out**: `(batch, heads, q_len, value_dim)`
+
+)code" TVM_ADD_FILELINE)
+    .set_attrs_type<FusedAttentionAttrs>()
+    .set_num_inputs(3)
+    .add_argument("query", "4D Tensor", "The query.")
+    .add_argument("key", "4D Tensor", "The key.")
+    .add_argument("value", "4D Tensor", "The value.")
+    .set_support_level(10)
+    .add_type_rel("FusedAttention", FusedAttentionRel)
+    .set_attr<TOpPattern>("TOpPattern", kOpaque);
+
 // group_norm
 TVM_REGISTER_NODE_TYPE(GroupNormAttrs);
 
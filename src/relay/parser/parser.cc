@@ -32,9 +32,13 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/support/parallel_for.h>
 #include <tvm/target/virtual_device.h>
 
+#include <exception>
 #include <fstream>
+#include <memory>
+#include <thread>
 
 #include "../../support/scalars.h"
 #include "./meta_ref.h"
@@ -284,8 +288,9 @@ class Parser {
   /*! \brief The current position in the token stream. */
   int pos;
 
-  /*! \brief The token stream for the parser. */
-  std::vector<Token> tokens;
+  /*! \brief The token stream for the parser, shared with the parsers of the global functions. */
+  std::shared_ptr<const std::vector<Token>> token_storage;
+  const std::vector<Token>& tokens;
 
   /*! \brief The configured operator table. */
   OperatorTable op_table;
@@ -314,13 +319,20 @@ class Parser {
   /*! \brief The metadata section. */
   MetaTable meta_table;
 
-  Parser(IRModule module, DiagnosticContext ctx, const Source& source, std::vector<Token> tokens,
-         OperatorTable op_table, MetaTable table)
+  /*! \brief Whether to set the spans of the parsed expressions. */
+  bool track_spans{true};
+
+  /*! \brief The number of threads parsing the global functions of a module. */
+  int num_threads{1};
+
+  Parser(IRModule module, DiagnosticContext ctx, const Source& source,
+         std::shared_ptr<const std::vector<Token>> tokens, OperatorTable op_table, MetaTable table)
       : module(module),
         diag_ctx(ctx),
         source(source),
         pos(0),
-        tokens(tokens),
+        token_storage(tokens),
+        tokens(*token_storage),
         op_table(op_table),
         ignore_whitespace(true),
         meta_table(table) {
@@ -566,8 +578,19 @@ class Parser {
     return Bracket(TokenType::kLCurly, TokenType::kRCurly, parser);
   }
 
+  /*! \return The span of a token to set on the parsed expressions, if the spans are tracked. */
+  Span SpanOf(const Token& token) const { return track_spans ? token->span : Span(); }
+
+  /*! \return The span covering both spans, if the spans are tracked. */
+  Span MergeSpans(const Span& lhs, const Span& rhs) const {
+    return track_spans ? lhs.Merge(rhs) : Span();
+  }
+
   template <typename R>
   R WithSpan(std::function<R()> parser) {
+    if (!track_spans) {
+      return parser();
+    }
     auto start_span = Peek()->span;
     VLOG(9) << "WithSpan: start_span = " << start_span;
     R ast = parser();
@@ -740,9 +763,86 @@ class Parser {
     return SemVer(0, 0, 5);
   }
 
+  /*!
+   * \brief Skip the definition of a global function, without parsing it.
+   * \return The position of the definition.
+   */
+  int SkipFunctionDef() {
+    int start = pos;
+    // The body is the first curly bracket outside of the parameters and the types.
+    int depth = 0;
+    bool in_body = false;
+    while (Peek()->token_type != TokenType::kEndOfFile) {
+      TokenType token_type = tokens[pos]->token_type;
+      pos++;
+      if (token_type == TokenType::kOpenParen || token_type == TokenType::kLSquare ||
+          token_type == TokenType::kLCurly) {
+        in_body |= depth == 0 && token_type == TokenType::kLCurly;
+        depth++;
+      } else if (token_type == TokenType::kCloseParen || token_type == TokenType::kRSquare ||
+                 token_type == TokenType::kRCurly) {
+        depth--;
+        if (depth == 0 && in_body) break;
+      }
+    }
+    return start;
+  }
+
+  /*!
+   * \brief Parse the global functions skipped by SkipFunctionDef, each on a parser of its own.
+   *
+   *  The functions only share the tables of the names defined at the top level, which are
+   *  complete once all definitions were skipped, so they are parsed in parallel. The
+   *  diagnostics of the functions are collected and emitted in the order of the definitions.
+   */
+  void ParseFunctionDefsInParallel(const std::vector<std::pair<GlobalVar, int>>& skipped,
+                                   Definitions* defs) {
+    struct Result {
+      Function func;
+      DiagnosticContext diag_ctx{nullptr};
+      std::exception_ptr error;
+    };
+    std::vector<Result> results(skipped.size());
+    // Rendered by diag_ctx once all functions are parsed.
+    DiagnosticRenderer collect(TypedPackedFunc<void(DiagnosticContext)>([](DiagnosticContext) {}));
+    support::parallel_for_dynamic(
+        0, static_cast<int>(skipped.size()), num_threads, [&](int, int k) {
+          Result& result = results[k];
+          result.diag_ctx = DiagnosticContext(module, collect);
+          Parser parser(module, result.diag_ctx, source, token_storage, op_table, meta_table);
+          parser.track_spans = track_spans;
+          parser.global_names = global_names;
+          parser.type_names = type_names;
+          parser.ctors = ctors;
+          parser.pos = skipped[k].second;
+          try {
+            result.func = parser.WithSpan<Function>([&]() { return parser.ParseFunctionDef(); });
+          } catch (...) {
+            result.error = std::current_exception();
+          }
+        });
+    std::exception_ptr error;
+    for (size_t k = 0; k < skipped.size(); ++k) {
+      for (const Diagnostic& diagnostic : results[k].diag_ctx->diagnostics) {
+        diag_ctx.Emit(diagnostic);
+      }
+      if (results[k].error && !error) {
+        error = results[k].error;
+      }
+      defs->funcs.push_back(GlobalFunc(skipped[k].first, results[k].func));
+    }
+    if (error) {
+      // Render the diagnostics of the failure if any, before rethrowing it.
+      diag_ctx.Render();
+      std::rethrow_exception(error);
+    }
+  }
+
   /*! \brief Parse zero or more Relay definitions. */
   Definitions ParseDefinitions() {
     Definitions defs;
+    // The global functions skipped to be parsed in parallel, with their positions.
+    std::vector<std::pair<GlobalVar, int>> skipped;
 
     while (true) {
       auto next = Peek();
@@ -752,8 +852,12 @@ class Parser {
           auto global_tok = Match(TokenType::kGlobal);
           auto global_name = global_tok.ToString();
           auto global = AddOrGet(&global_names, global_name);
+          if (num_threads > 1) {
+            skipped.emplace_back(global, SkipFunctionDef());
+            continue;
+          }
           auto func = WithSpan<relay::Function>([&]() { return ParseFunctionDef(); });
-          ICHECK(func->span.defined()) << "spans must be set in parser";
+          ICHECK(!track_spans || func->span.defined()) << "spans must be set in parser";
           defs.funcs.push_back(GlobalFunc(global, func));
           continue;
         }
@@ -771,6 +875,9 @@ class Parser {
           defs.types.push_back(type_def);
         }
         default:
+          if (!skipped.empty()) {
+            ParseFunctionDefsInParallel(skipped, &defs);
+          }
           return defs;
       }
     }
@@ -950,11 +1057,12 @@ class Parser {
         exprs.pop_back();
         while (exprs.size()) {
           auto value = exprs.back();
-          ICHECK(value->span.defined()) << "parser must set expression spans.";
+          ICHECK(!track_spans || value->span.defined()) << "parser must set expression spans.";
           exprs.pop_back();
-          body = relay::Let(Var("", IncompleteType()), value, body, value->span.Merge(body->span));
+          body = relay::Let(Var("", IncompleteType()), value, body,
+                            MergeSpans(value->span, body->span));
         }
-        ICHECK(body->span.defined()) << "parser must set expression spans.";
+        ICHECK(!track_spans || body->span.defined()) << "parser must set expression spans.";
         return body;
       }
     });
@@ -999,7 +1107,7 @@ class Parser {
         Match(TokenType::kSemicolon);
         AddGraphBinding(next, val);
       } else if (next->token_type == TokenType::kLet) {
-        auto span = next->span;
+        auto span = SpanOf(next);
         // Parse the 'let'.
         Consume(TokenType::kLet);
 
@@ -1046,7 +1154,7 @@ class Parser {
         } else {
           // We can now build the let binding up backwards.
           for (auto binding = bindings.rbegin(); binding != bindings.rend(); binding++) {
-            auto span = body->span.Merge(std::get<2>(*binding));
+            auto span = MergeSpans(body->span, std::get<2>(*binding));
             body = relay::Let(std::get<0>(*binding), std::get<1>(*binding), body, span);
           }
           return body;
@@ -1284,7 +1392,7 @@ class Parser {
         auto op = opt_op[0];
 
         Expr right = WithSpan<Expr>([this] { return ParseCallExpr(); });
-        ICHECK(right->span.defined());
+        ICHECK(!track_spans || right->span.defined());
 
         // If the operator stack is empty
         // we parse an operator and expression
@@ -1312,8 +1420,8 @@ class Parser {
           Expr left = exprs.back();
           exprs.pop_back();
           ICHECK(new_op.op.defined()) << "a call op must be set " << new_op.op;
-          exprs.push_back(
-              relay::Call(new_op.op, {left, right}, Attrs(), {}, left->span.Merge(right->span)));
+          exprs.push_back(relay::Call(new_op.op, {left, right}, Attrs(), {},
+                                      MergeSpans(left->span, right->span)));
         }
 
         exprs.push_back(right);
@@ -1328,8 +1436,8 @@ class Parser {
         Expr left = exprs.back();
         exprs.pop_back();
         ICHECK(new_op.op.defined()) << "a call op must be set " << new_op.op;
-        exprs.push_back(
-            relay::Call(new_op.op, {left, right}, Attrs(), {}, left->span.Merge(right->span)));
+        exprs.push_back(relay::Call(new_op.op, {left, right}, Attrs(), {},
+                                    MergeSpans(left->span, right->span)));
       }
 
       ICHECK_EQ(ops.size(), 0) << "No operations should be left on the operation stack.";
@@ -1530,15 +1638,15 @@ class Parser {
         case TokenType::kFloat: {
           Consume(next->token_type);
           auto number = NumberToNDArray(next);
-          Expr e = Constant(number, next->span);
-          ICHECK(e->span.defined()) << "constant spans must be defined";
+          Expr e = Constant(number, SpanOf(next));
+          ICHECK(!track_spans || e->span.defined()) << "constant spans must be defined";
           return e;
         }
         case TokenType::kBoolean: {
           Consume(TokenType::kBoolean);
           int64_t value = Downcast<tvm::Integer>(next->data).IntValue();
-          Expr e = Constant(support::BoolToNDArray(value), next->span);
-          ICHECK(e->span.defined()) << "constant spans must be defined";
+          Expr e = Constant(support::BoolToNDArray(value), SpanOf(next));
+          ICHECK(!track_spans || e->span.defined()) << "constant spans must be defined";
           return e;
         }
         // Parse a local of the form `%x`.
@@ -1577,7 +1685,7 @@ class Parser {
         case TokenType::kFn: {
           Consume(TokenType::kFn);
           Expr e = ParseFunctionDef();
-          ICHECK(e->span.defined()) << "function spans must be defined.\n" << e;
+          ICHECK(!track_spans || e->span.defined()) << "function spans must be defined.\n" << e;
           return e;
         }
         case TokenType::kIf: {
@@ -1612,7 +1720,7 @@ class Parser {
           });
         }
         case TokenType::kOpenParen: {
-          Span sp = next->span;
+          Span sp = SpanOf(next);
           Consume(TokenType::kOpenParen);
           // parse '(' ')'
           if (WhenMatch(TokenType::kCloseParen)) {
@@ -1632,15 +1740,15 @@ class Parser {
                   auto element = ParseExpr();
                   auto comma = Peek();
                   if (WhenMatch(TokenType::kComma)) {
-                    sp = sp.Merge(element->span.Merge(comma->span));
+                    sp = MergeSpans(sp, MergeSpans(element->span, SpanOf(comma)));
                   } else {
-                    sp = sp.Merge(element->span);
+                    sp = MergeSpans(sp, element->span);
                   }
                   exprs.push_back(element);
                 }
               }
               Expr tuple = Tuple(exprs, sp);
-              ICHECK(tuple->span.defined()) << "tuple span should be defined";
+              ICHECK(!track_spans || tuple->span.defined()) << "tuple span should be defined";
               return tuple;
             }
           }
@@ -1656,7 +1764,7 @@ class Parser {
     if (WhenMatch(TokenType::kPeriod)) {
       auto token = Match(TokenType::kInteger);
       auto index = token.ToNumber();
-      auto span = token->span.Merge(expr->span);
+      auto span = MergeSpans(SpanOf(token), expr->span);
       VLOG(9) << "Parser::ParseAtomicExpr: tuple get item";
       return relay::TupleGetItem(expr, index, span);
     } else {
@@ -1895,7 +2003,7 @@ Parser InitParser(const std::string& file_name, const std::string& file_content,
   auto diag_ctx = DiagnosticContext::Default(module);
   auto tokens_and_table = Tokenize(diag_ctx, source);
 
-  auto tokens = tokens_and_table.first;
+  auto tokens = std::make_shared<const std::vector<Token>>(std::move(tokens_and_table.first));
   MetaTable meta_data_table = tokens_and_table.second.ToMetadata();
 
   // Merge any entries in init_meta_table into anything captured in the #[metadata] section
@@ -1916,10 +2024,15 @@ Parser InitParser(const std::string& file_name, const std::string& file_content,
 }
 
 IRModule ParseModule(const std::string& file_name, const std::string& file_content,
-                     const Optional<IRModule>& init_module, const MetaTable& init_meta_table) {
+                     const Optional<IRModule>& init_module, const MetaTable& init_meta_table,
+                     const ParseOptions& options) {
   VLOG_CONTEXT << "ParseModule";
   VLOG(9) << "parsing and type-checking " << file_name;
   auto parser = InitParser(file_name, file_content, init_module, init_meta_table);
+  parser.track_spans = options.track_spans;
+  parser.num_threads = options.num_threads > 0
+                           ? options.num_threads
+                           : static_cast<int>(std::thread::hardware_concurrency());
   auto mod = parser.ParseModule();
   ICHECK(mod.defined()) << "The parser must return a non-null module.";
   // NB(@jroesch): it is very important that we render any errors before we proceed
@@ -1961,8 +2074,12 @@ Pass AnnotateSpans() {
 
 TVM_REGISTER_GLOBAL("relay.parser.ParseModuleInContext")
     .set_body_typed([](const std::string& file_name, const std::string& file_content,
-                       const Optional<IRModule>& init_module, const MetaTable& init_meta_table) {
-      return ParseModule(file_name, file_content, init_module, init_meta_table);
+                       const Optional<IRModule>& init_module, const MetaTable& init_meta_table,
+                       bool track_spans, int num_threads) {
+      ParseOptions options;
+      options.track_spans = track_spans;
+      options.num_threads = num_threads;
+      return ParseModule(file_name, file_content, init_module, init_meta_table, options);
     });
 
 TVM_REGISTER_GLOBAL("relay.parser.ParseModule").set_body([](TVMArgs args, TVMRetValue* ret) {
@@ -584,8 +584,19 @@ struct Tokenizer {
   void Tokenize() {
     VLOG(9) << "tvm::relay::Tokenize";
     while (this->More()) {
+      // The parser skips the whitespace and the comments, which would otherwise make up most of
+      // the tokens of pretty printed text, so they are dropped here rather than allocated.
+      if (IsWhitespace(Peek())) {
+        Next();
+        continue;
+      }
       auto token = TokenizeOnce();
       ICHECK(token.defined());
+      if (token->token_type == TokenType::kNewline ||
+          token->token_type == TokenType::kLineComment ||
+          token->token_type == TokenType::kComment) {
+        continue;
+      }
       this->tokens.push_back(token);
     }
     this->tokens.push_back(NewToken(TokenType::kEndOfFile));
@@ -603,6 +614,7 @@ struct Tokenizer {
 
 inline std::vector<Token> Condense(const std::vector<Token>& tokens, Token* table) {
   std::vector<Token> out;
+  out.reserve(tokens.size());
   bool found_metadata = false;
 
   for (size_t i = 0; i < tokens.size(); i++) {
@@ -689,7 +701,7 @@ inline std::pair<std::vector<Token>, Token> Tokenize(const DiagnosticContext& ct
   for (auto token : tokens) {
     ICHECK(token.defined());
   }
-  return {tokens, meta_table};
+  return {std::move(tokens), meta_table};
 }
 
 }  // namespace relay
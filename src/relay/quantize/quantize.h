@@ -74,6 +74,8 @@ class QConfigNode : public Object {
   Array<Expr> debug_enabled_ops = Array<Expr>(ObjectPtr<Object>(nullptr));
   std::string rounding = "UPWARD";
   int calibrate_chunk_by = -1;
+  int calibrate_num_workers = 1;
+  bool weight_per_channel = false;
   std::string partition_conversions = "disabled";
 
   void VisitAttrs(AttrVisitor* v) {
@@ -93,6 +95,8 @@ class QConfigNode : public Object {
     v->Visit("debug_enabled_ops", &debug_enabled_ops);
     v->Visit("rounding", &rounding);
     v->Visit("calibrate_chunk_by", &calibrate_chunk_by);
+    v->Visit("calibrate_num_workers", &calibrate_num_workers);
+    v->Visit("weight_per_channel", &weight_per_channel);
     v->Visit("partition_conversions", &partition_conversions);
   }
 
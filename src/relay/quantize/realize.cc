@@ -31,6 +31,8 @@
 #include <tvm/relay/attrs/annotation.h>
 #include <tvm/relay/transform.h>
 
+#include <algorithm>
+
 #include "../op/annotation/annotation.h"
 #include "../qnn/utils.h"
 #include "../transforms/fold_constant.h"
@@ -89,6 +91,36 @@ inline Expr MulAndDiv(Expr data, float s1, float s2, DataType dtype,
   }
 }
 
+inline bool IsScalarScale(const Expr& dom_scale) {
+  const auto* n = dom_scale.as<ConstantNode>();
+  ICHECK(n) << "dom_scale should be a constant";
+  return n->is_scalar();
+}
+
+/*
+ * \brief Rescale the output of an op on a weight with per-channel scales `rhs_scale` to the
+ * per-tensor scale `lhs_scale * max(rhs_scale)`, so the ops after it see scalar scales.
+ */
+inline Expr RescalePerChannel(const Call& ref_call, Expr data, const Expr& lhs_scale,
+                              const Expr& rhs_scale, int channel_axis, DataType dtype) {
+  const QConfig& cfg = QConfig::Current();
+  runtime::NDArray scales = Downcast<Constant>(rhs_scale)->data;
+  int64_t num_scales = 1;
+  for (int64_t extent : scales.Shape()) num_scales *= extent;
+  std::vector<float> values(num_scales);
+  scales.CopyToBytes(values.data(), values.size() * sizeof(float));
+  float max_scale = *std::max_element(values.begin(), values.end());
+  std::vector<double> multipliers;
+  for (float value : values) multipliers.push_back(value / max_scale);
+  const auto* out_type = ref_call->type_as<TensorTypeNode>();
+  ICHECK_EQ(out_type->shape[channel_axis].as<IntImmNode>()->value, num_scales);
+  data = qnn::FixedPointMultiplyPerChannel(data, multipliers, out_type->shape, channel_axis,
+                                           cfg->rounding);
+  float dom_scale = GetScalarFromConstant<float>(lhs_scale) * max_scale;
+  return QRealizeIntExpr(Cast(data, dtype), MakeConstantScalar(DataType::Float(32), dom_scale),
+                         dtype);
+}
+
 Expr QuantizeRealize(const Call& ref_call, const Array<Expr>& new_args, const ObjectRef& ctx) {
   const QConfig& cfg = QConfig::Current();
   // do not handle data type cast
@@ -99,7 +131,6 @@ Expr QuantizeRealize(const Call& ref_call, const Array<Expr>& new_args, const Ob
   Expr clip_min = new_args[2];
   Expr clip_max = new_args[3];
 
-  float dom_scale_imm = GetScalarFromConstant<float>(dom_scale);
   float clip_min_imm = GetScalarFromConstant<float>(clip_min);
   float clip_max_imm = GetScalarFromConstant<float>(clip_max);
 
@@ -151,7 +182,14 @@ Expr QuantizeRealize(const Call& ref_call, const Array<Expr>& new_args, const Ob
   // quantize from real
   ICHECK(!new_args[0]->IsInstance<TempExprNode>());
   Expr data = new_args[0];
-  Expr scaled_data = Multiply(data, MakeConstantScalar(DataType::Float(32), 1 / dom_scale_imm));
+  Expr scaled_data;
+  if (IsScalarScale(dom_scale)) {
+    float dom_scale_imm = GetScalarFromConstant<float>(dom_scale);
+    scaled_data = Multiply(data, MakeConstantScalar(DataType::Float(32), 1 / dom_scale_imm));
+  } else {
+    // per-channel weight scales
+    scaled_data = Divide(data, dom_scale);
+  }
   Expr round_data = Clip(Round(scaled_data), clip_min_imm, clip_max_imm);
   return QRealizeIntExpr(round_data, dom_scale, DataType::Float(32));
 }
@@ -196,6 +234,12 @@ Expr Conv2dRealize(const Call& ref_call, const Array<Expr>& new_args, const Obje
     attrs->out_dtype = out_dtype;
 
     Expr ret = Call(ref_call->op, {ldata, rdata}, Attrs(attrs), ref_call->type_args);
+    if (!IsScalarScale(rhs->dom_scale)) {
+      std::string out_layout = attrs->out_layout.empty() ? attrs->data_layout : attrs->out_layout;
+      int channel_axis = Layout(out_layout).IndexOf(LayoutAxis::Get('C'));
+      return RescalePerChannel(ref_call, ret, lhs->dom_scale, rhs->dom_scale, channel_axis,
+                               out_dtype);
+    }
     Expr mul = Multiply(lhs->dom_scale, rhs->dom_scale);
     Expr dom_scale = FoldConstantExpr(mul);
     return QRealizeIntExpr(ret, dom_scale, out_dtype);
@@ -259,6 +303,11 @@ Expr DenseRealize(const Call& ref_call, const Array<Expr>& new_args, const Objec
   attrs->out_dtype = out_dtype;
 
   Expr ret = Call(ref_call->op, {ldata, rdata}, Attrs(attrs), ref_call->type_args);
+  if (!IsScalarScale(rhs->dom_scale)) {
+    int channel_axis = static_cast<int>(ref_call->type_as<TensorTypeNode>()->shape.size()) - 1;
+    return RescalePerChannel(ref_call, ret, lhs->dom_scale, rhs->dom_scale, channel_axis,
+                             out_dtype);
+  }
   Expr mul = Multiply(lhs->dom_scale, rhs->dom_scale);
   Expr dom_scale = FoldConstantExpr(mul);
   return QRealizeIntExpr(ret, dom_scale, out_dtype);
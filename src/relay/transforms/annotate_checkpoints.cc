@@ -0,0 +1,257 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file annotate_checkpoints.cc
+ * \brief Select the checkpoints of the rematerialization of a dataflow function.
+ *
+ * The higher order gradient keeps the intermediate values of the forward computation alive
+ * for the backward pass, except inside of an annotation.checkpoint, whose argument is
+ * recomputed in the backward pass. This pass splits the dataflow of a function in segments and
+ * wraps each segment but the last in an annotation.checkpoint, so that only the outputs of the
+ * segments and the intermediate values of one segment are alive at a time.
+ *
+ * The segments end on the nodes which are the only value of the segment used afterwards, and
+ * their intermediate values are bounded by the memory budget. Without a budget, the values are
+ * split in sqrt(N) segments of balanced sizes.
+ */
+#include <tvm/relay/analysis.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include "let_list.h"
+
+namespace tvm {
+namespace relay {
+
+namespace {
+
+/*! \brief Returns the bytes of the tensors of a type, 0 if they have dynamic shapes. */
+int64_t TypeBytes(const Type& type) {
+  if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+    int64_t bytes = (tensor_type->dtype.bits() * tensor_type->dtype.lanes() + 7) / 8;
+    for (const PrimExpr& dim : tensor_type->shape) {
+      const auto* imm = dim.as<IntImmNode>();
+      if (imm == nullptr) {
+        return 0;
+      }
+      bytes *= imm->value;
+    }
+    return bytes;
+  } else if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+    int64_t bytes = 0;
+    for (const Type& field : tuple_type->fields) {
+      bytes += TypeBytes(field);
+    }
+    return bytes;
+  }
+  return 0;
+}
+
+/*!
+ * \brief Collects the values of a dataflow expression in post-DFS order, or fails if the
+ * expression is not dataflow of operator calls.
+ */
+class DataflowOrder : public ExprVisitor {
+ public:
+  bool Collect(const Expr& body) {
+    VisitExpr(body);
+    return dataflow_;
+  }
+
+  std::vector<Expr> order;
+
+ private:
+  void VisitExpr_(const CallNode* op) final {
+    if (!op->op.as<OpNode>()) {
+      dataflow_ = false;
+      return;
+    }
+    for (const Expr& arg : op->args) {
+      VisitExpr(arg);
+    }
+    order.push_back(GetRef<Expr>(op));
+  }
+
+  void VisitExpr_(const TupleNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    order.push_back(GetRef<Expr>(op));
+  }
+
+  void VisitExpr_(const TupleGetItemNode* op) final {
+    ExprVisitor::VisitExpr_(op);
+    order.push_back(GetRef<Expr>(op));
+  }
+
+  void VisitExpr_(const VarNode* op) final {}
+  void VisitExpr_(const ConstantNode* op) final {}
+  void VisitExpr_(const LetNode* op) final { dataflow_ = false; }
+  void VisitExpr_(const IfNode* op) final { dataflow_ = false; }
+  void VisitExpr_(const FunctionNode* op) final { dataflow_ = false; }
+  void VisitExpr_(const MatchNode* op) final { dataflow_ = false; }
+  void VisitExpr_(const RefCreateNode* op) final { dataflow_ = false; }
+  void VisitExpr_(const RefReadNode* op) final { dataflow_ = false; }
+  void VisitExpr_(const RefWriteNode* op) final { dataflow_ = false; }
+
+  bool dataflow_{true};
+};
+
+/*! \brief Returns the operands of a value of the dataflow. */
+Array<Expr> Operands(const Expr& value) {
+  if (const auto* call = value.as<CallNode>()) {
+    return call->args;
+  } else if (const auto* tuple = value.as<TupleNode>()) {
+    return tuple->fields;
+  }
+  const auto* get_item = value.as<TupleGetItemNode>();
+  ICHECK(get_item);
+  return {get_item->tuple};
+}
+
+/*! \brief Rebuilds a value of the dataflow on the given operands. */
+Expr Rebuild(const Expr& value, const Array<Expr>& operands) {
+  if (const auto* call = value.as<CallNode>()) {
+    return Call(call->op, operands, call->attrs, call->type_args, call->span);
+  } else if (const auto* tuple = value.as<TupleNode>()) {
+    return Tuple(operands, tuple->span);
+  }
+  const auto* get_item = value.as<TupleGetItemNode>();
+  ICHECK(get_item);
+  return TupleGetItem(operands[0], get_item->index, get_item->span);
+}
+
+Function AnnotateCheckpointsInFunction(const Function& func, int64_t memory_budget_bytes) {
+  DataflowOrder dataflow;
+  if (!dataflow.Collect(func->body) || dataflow.order.size() < 2) {
+    return func;
+  }
+  const std::vector<Expr>& order = dataflow.order;
+  size_t num_values = order.size();
+
+  // The index of the last value using each value.
+  std::unordered_map<const Object*, size_t> index;
+  for (size_t i = 0; i < num_values; ++i) {
+    index[order[i].get()] = i;
+  }
+  std::vector<size_t> last_use(num_values, 0);
+  for (size_t i = 0; i < num_values; ++i) {
+    last_use[i] = i;
+    for (const Expr& operand : Operands(order[i])) {
+      auto it = index.find(operand.get());
+      if (it != index.end()) {
+        last_use[it->second] = std::max(last_use[it->second], i);
+      }
+    }
+  }
+
+  std::vector<int64_t> bytes(num_values);
+  int64_t total_bytes = 0;
+  for (size_t i = 0; i < num_values; ++i) {
+    bytes[i] = TypeBytes(order[i]->checked_type());
+    total_bytes += bytes[i];
+  }
+  int64_t limit = memory_budget_bytes;
+  if (limit <= 0) {
+    int64_t num_segments = static_cast<int64_t>(std::ceil(std::sqrt(num_values)));
+    limit = std::max<int64_t>(total_bytes / num_segments, 1);
+  }
+
+  // A segment can end on a tensor value when none of the values of the segment before it is
+  // used after it.
+  std::vector<size_t> checkpoints;
+  size_t used_until = 0;
+  int64_t segment_bytes = 0;
+  int64_t candidate = -1;
+  for (size_t i = 0; i + 1 < num_values; ++i) {
+    segment_bytes += bytes[i];
+    if (segment_bytes > limit && candidate >= 0) {
+      checkpoints.push_back(candidate);
+      used_until = 0;
+      segment_bytes = bytes[i];
+      for (size_t j = candidate + 1; j < i; ++j) {
+        used_until = std::max(used_until, last_use[j]);
+        segment_bytes += bytes[j];
+      }
+      candidate = -1;
+    }
+    if (used_until <= i && order[i]->checked_type().as<TensorTypeNode>()) {
+      candidate = i;
+    }
+    used_until = std::max(used_until, last_use[i]);
+  }
+  if (checkpoints.empty()) {
+    return func;
+  }
+
+  static const Op& checkpoint_op = Op::Get("annotation.checkpoint");
+  std::unordered_map<const Object*, Expr> rebuilt;
+  auto rebuild = [&rebuilt](const Expr& value) {
+    Array<Expr> operands;
+    for (const Expr& operand : Operands(value)) {
+      auto it = rebuilt.find(operand.get());
+      operands.push_back(it != rebuilt.end() ? it->second : operand);
+    }
+    return Rebuild(value, operands);
+  };
+  Expr body = LetList::With([&](LetList* outer) {
+    size_t begin = 0;
+    for (size_t end : checkpoints) {
+      Expr segment = LetList::With([&](LetList* inner) {
+        for (size_t i = begin; i <= end; ++i) {
+          rebuilt[order[i].get()] = inner->Push(rebuild(order[i]));
+        }
+        return rebuilt[order[end].get()];
+      });
+      rebuilt[order[end].get()] = outer->Push(Call(checkpoint_op, {segment}));
+      begin = end + 1;
+    }
+    for (size_t i = begin; i < num_values; ++i) {
+      rebuilt[order[i].get()] = outer->Push(rebuild(order[i]));
+    }
+    return rebuilt[order.back().get()];
+  });
+  return WithFields(func, func->params, body);
+}
+
+}  // namespace
+
+namespace transform {
+
+Pass AnnotateCheckpoints(int64_t memory_budget_bytes) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        if (f->HasNonzeroAttr(attr::kPrimitive) || f->GetAttr<String>(attr::kCompiler)) {
+          return f;
+        }
+        return AnnotateCheckpointsInFunction(f, memory_budget_bytes);
+      };
+  return CreateFunctionPass(pass_func, 1, "AnnotateCheckpoints", {"InferType"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.AnnotateCheckpoints").set_body_typed(AnnotateCheckpoints);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
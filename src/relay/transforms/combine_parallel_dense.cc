@@ -25,6 +25,8 @@
  * This pass replaces dense ops that share the same input node, same shape,
  * and don't have "units" defined with a single batch matrix multiplication.
  * The inputs of the new batch_matmul is the stack of the original inputs.
+ * Dense ops with different numbers of output units have their weights padded
+ * to the largest one, as long as the padding at most doubles the units.
  * Elemwise and broadcast ops following dense are also combined if possible.
  *
  * This prevents launching multiple kernels in networks with multiple
@@ -38,6 +40,7 @@
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -58,12 +61,24 @@ class ParallelDenseToBatchCombiner : public ParallelOpBatchCombiner {
 
  protected:
   Call MakeCombinedOp(const Group& branches) {
+    // The weights are padded with zeros to the largest number of output units.
+    int64_t max_units = -1;
+    for (const auto& branch : branches) {
+      max_units = std::max(max_units, Units(branch[0]));
+    }
     Array<Expr> new_args;
     size_t num_args = branches[0][0]->args.size();
     for (size_t i = 0; i < num_args; i++) {
       Array<Expr> arg_from_all_branches;
       for (const auto& branch : branches) {
-        arg_from_all_branches.push_back(branch[0]->args[i]);
+        Expr arg = branch[0]->args[i];
+        int64_t units = Units(branch[0]);
+        if (i == 1 && units != -1 && units < max_units) {
+          Array<Array<Integer>> pad_width{{0, Integer(max_units - units)}, {0, 0}};
+          DataType dtype = arg->type_as<TensorTypeNode>()->dtype;
+          arg = MakePad(arg, pad_width, MakeConstantScalar(dtype, 0), "constant");
+        }
+        arg_from_all_branches.push_back(arg);
       }
 
       new_args.push_back(MakeStack(Tuple(arg_from_all_branches), 0));
@@ -85,8 +100,25 @@ class ParallelDenseToBatchCombiner : public ParallelOpBatchCombiner {
     const auto* weight_a = a->args[1]->type_as<TensorTypeNode>();
     const auto* weight_b = b->args[1]->type_as<TensorTypeNode>();
 
-    return eq(attrs_a->out_dtype, attrs_b->out_dtype) &&
-           eq(weight_a->shape[0], weight_b->shape[0]) && eq(weight_a->shape[1], weight_b->shape[1]);
+    if (!eq(attrs_a->out_dtype, attrs_b->out_dtype) ||
+        !eq(weight_a->shape[1], weight_b->shape[1])) {
+      return false;
+    }
+    if (eq(weight_a->shape[0], weight_b->shape[0])) {
+      return true;
+    }
+    // Different output units are padded, unless that wastes more than the units computed.
+    int64_t units_a = Units(a), units_b = Units(b);
+    return units_a > 0 && units_b > 0 &&
+           std::max(units_a, units_b) <= 2 * std::min(units_a, units_b);
+  }
+
+ private:
+  /*! \brief Returns the static number of output units of the dense, -1 if unknown. */
+  static int64_t Units(const CallNode* dense) {
+    const auto* weight = dense->args[1]->type_as<TensorTypeNode>();
+    const int64_t* units = tir::as_const_int(weight->shape[0]);
+    return units == nullptr ? -1 : *units;
   }
 };
 
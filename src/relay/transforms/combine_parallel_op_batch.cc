@@ -42,6 +42,8 @@
  *       add+elemwise (2,2,2)
  *          /       \
  *
+ * Branches whose last axes have different extents, such as dense ops with different units,
+ * are padded to the largest extent before stacking, and sliced back after the split.
  */
 
 #include "./combine_parallel_op_batch.h"
@@ -53,6 +55,7 @@
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -63,6 +66,23 @@
 namespace tvm {
 namespace relay {
 
+/*! \brief Returns the static extent of the last axis of a tensor type, -1 if unknown. */
+static int64_t LastAxisExtent(const Type& type) {
+  const auto* tensor_type = type.as<TensorTypeNode>();
+  if (tensor_type == nullptr || tensor_type->shape.empty()) return -1;
+  const int64_t* extent = tir::as_const_int(tensor_type->shape.back());
+  return extent == nullptr ? -1 : *extent;
+}
+
+/*! \brief Returns the largest extent of the last axis of the outputs at depth of the branches. */
+static int64_t MaxLastAxisExtent(const Group& branches, size_t depth) {
+  int64_t max_extent = -1;
+  for (const auto& branch : branches) {
+    max_extent = std::max(max_extent, LastAxisExtent(branch[depth]->checked_type()));
+  }
+  return max_extent;
+}
+
 ParallelOpBatchCombiner::ParallelOpBatchCombiner(const std::string& op_name,
                                                  const std::string& batch_op_name,
                                                  uint64_t min_num_branches)
@@ -118,7 +138,17 @@ bool ParallelOpBatchCombiner::IsArgCompatible(const CallNode* a, const CallNode*
   if (!eq(ta->dtype, tb->dtype) || ta->shape.size() != tb->shape.size()) return false;
 
   for (size_t i = 0; i < ta->shape.size(); i++) {
-    if (!eq(ta->shape[i], tb->shape[i])) return false;
+    if (eq(ta->shape[i], tb->shape[i])) continue;
+    // The last axes may differ if they broadcast, or follow the extents of the outputs, which
+    // are padded to the largest one.
+    if (i + 1 != ta->shape.size()) return false;
+    int64_t extent_a = LastAxisExtent(a->args[index]->checked_type());
+    int64_t extent_b = LastAxisExtent(b->args[index]->checked_type());
+    if ((extent_a != 1 && extent_a != LastAxisExtent(a->checked_type())) ||
+        (extent_b != 1 && extent_b != LastAxisExtent(b->checked_type())) || extent_a == -1 ||
+        extent_b == -1) {
+      return false;
+    }
   }
   return true;
 }
@@ -128,6 +158,7 @@ Call ParallelOpBatchCombiner::MakeCombinedCallFromFollowingOps(const Expr& data,
                                                                size_t parent_index) {
   Array<Expr> new_args;
   const CallNode* call = branches[0][depth];
+  int64_t max_extent = MaxLastAxisExtent(branches, depth);
 
   for (size_t i = 0; i < call->args.size(); i++) {
     if (i == parent_index) {
@@ -135,6 +166,11 @@ Call ParallelOpBatchCombiner::MakeCombinedCallFromFollowingOps(const Expr& data,
       continue;
     }
 
+    bool same_extents = true;
+    for (const auto& branch : branches) {
+      same_extents &= LastAxisExtent(branch[depth]->args[i]->checked_type()) ==
+                      LastAxisExtent(call->args[i]->checked_type());
+    }
     Array<Expr> tuple;
     for (const auto& branch : branches) {
       // if the shape of the arg is of shape (j,),
@@ -142,11 +178,19 @@ Call ParallelOpBatchCombiner::MakeCombinedCallFromFollowingOps(const Expr& data,
       Expr arg = branch[depth]->args[i];
       const TensorTypeNode* arg_tensor = arg->type_as<TensorTypeNode>();
       if (arg_tensor->shape.size() == 1) {
-        Expr expanded_arg = MakeExpandDims(arg, 0, 1);
-        tuple.push_back(expanded_arg);
-      } else {
-        tuple.push_back(arg);
+        arg = MakeExpandDims(arg, 0, 1);
+      }
+      // Bring the last axes to the padded extent of the outputs, so the args can be stacked.
+      int64_t extent = LastAxisExtent(branch[depth]->args[i]->checked_type());
+      if (!same_extents && extent == 1) {
+        arg = MakeRepeat(arg, max_extent, -1);
+      } else if (!same_extents && extent < max_extent) {
+        size_t ndim = std::max<size_t>(arg_tensor->shape.size(), 2);
+        Array<Array<Integer>> pad_width(ndim, Array<Integer>{0, 0});
+        pad_width.Set(ndim - 1, Array<Integer>{0, Integer(max_extent - extent)});
+        arg = MakePad(arg, pad_width, MakeConstantScalar(arg_tensor->dtype, 0), "constant");
       }
+      tuple.push_back(arg);
     }
 
     auto stack = MakeStack(Tuple(tuple), 0);
@@ -159,10 +203,21 @@ Call ParallelOpBatchCombiner::MakeCombinedCallFromFollowingOps(const Expr& data,
 void ParallelOpBatchCombiner::UpdateGroupOutput(const Expr& data, const Group& branches,
                                                 size_t depth, ExprSubstMap* subst_map) {
   int index = 0;
+  int64_t max_extent = MaxLastAxisExtent(branches, depth);
   auto split = MakeSplit(data, Integer(branches.size()), 0);
   for (const auto& branch : branches) {
     auto split_data = TupleGetItem(split, index++);
-    auto squeezed_data = MakeSqueeze(split_data, {0});
+    Expr squeezed_data = MakeSqueeze(split_data, {0});
+    // Slice off the padding of the branches narrower than the largest one.
+    int64_t extent = LastAxisExtent(branch[depth]->checked_type());
+    if (extent < max_extent) {
+      size_t ndim = branch[depth]->type_as<TensorTypeNode>()->shape.size();
+      Array<Integer> begin(ndim, 0);
+      Array<Integer> end(ndim, -1);
+      Array<Integer> strides(ndim, 1);
+      end.Set(ndim - 1, Integer(extent));
+      squeezed_data = MakeStridedSlice(squeezed_data, begin, end, strides, "size");
+    }
     subst_map->insert({GetRef<Expr>(branch[depth]), squeezed_data});
   }
 }
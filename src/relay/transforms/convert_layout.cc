@@ -23,13 +23,17 @@
           other expressions. This pass can be used for computing convolution in
           custom layouts or other general weight pre-transformation.
  */
+#include <tvm/node/reflection.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/transform.h>
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
 #include <tvm/te/operation.h>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -58,6 +62,15 @@ class ConvertTransformMemorizerNode : public TransformMemorizerNode {
   explicit ConvertTransformMemorizerNode(Map<String, Array<String>> desired_layouts)
       : desired_layouts_(std::move(desired_layouts)) {}
 
+  /*!
+   * \brief Initializes the desired layouts of each call.
+   * \param call_layouts Mapping of the original calls to their desired layouts for each input.
+   *                     The calls not in the mapping keep their layouts.
+   */
+  explicit ConvertTransformMemorizerNode(
+      std::unordered_map<const CallNode*, Array<String>> call_layouts)
+      : call_layouts_(std::move(call_layouts)), select_per_call_(true) {}
+
   /*!
    * \brief Defines the call transformation for ConvertLayout pass. The new layouts should be the
    * desired layout as specified by the user.
@@ -73,8 +86,14 @@ class ConvertTransformMemorizerNode : public TransformMemorizerNode {
     Expr new_e;
     bool modified = false;
     if (fconvert_layout.count(op)) {
-      auto desired_layouts = desired_layouts_;
-      if (desired_layouts.find(op->name) != desired_layouts.end()) {
+      Optional<Array<String>> op_desired_layouts;
+      auto it = call_layouts_.find(ref_call.get());
+      if (it != call_layouts_.end()) {
+        op_desired_layouts = it->second;
+      } else if (desired_layouts_.find(op->name) != desired_layouts_.end()) {
+        op_desired_layouts = desired_layouts_.at(op->name);
+      }
+      if (op_desired_layouts.defined()) {
         tvm::Array<tvm::te::Tensor> tinfos;
         for (auto& expr : ref_call->args) {
           if (expr->checked_type()->IsInstance<TupleTypeNode>()) {
@@ -89,13 +108,13 @@ class ConvertTransformMemorizerNode : public TransformMemorizerNode {
           }
         }
 
-        Array<String> op_desired_layouts = desired_layouts.at(op->name);
-        Expr altered_value = fconvert_layout[op](new_attrs, new_args, tinfos, op_desired_layouts);
+        Expr altered_value =
+            fconvert_layout[op](new_attrs, new_args, tinfos, op_desired_layouts.value());
         if (altered_value.defined()) {
           new_e = altered_value;
           modified = true;
         }
-      } else {
+      } else if (!select_per_call_) {
         LOG(WARNING) << "Desired layout(s) not specified for op: " << op->name;
       }
     }
@@ -114,6 +133,10 @@ class ConvertTransformMemorizerNode : public TransformMemorizerNode {
 
   /*! \brief A mapping of op_name to array of desired layouts for each input. */
   Map<String, Array<String>> desired_layouts_;
+  /*! \brief A mapping of the original calls to array of desired layouts for each input. */
+  std::unordered_map<const CallNode*, Array<String>> call_layouts_;
+  /*! \brief Whether the desired layouts were selected per call, by ConvertLayoutAuto. */
+  bool select_per_call_{false};
 };
 
 /*!
@@ -144,6 +167,343 @@ Expr ConvertLayout(const Expr& expr, const Map<String, Array<String>>& desired_l
   return ForwardRewrite(expr, LayoutRewriter<ConvertTransformMemorizer>, fcontext);
 }
 
+/*!
+ * \brief Selects the desired layouts of each call among candidates, minimizing the cost of the
+ * kernels plus the cost of the layout transforms between the calls.
+ *
+ * The calls with candidates are linked when the output of one flows into the data input of the
+ * other, through any number of calls which adapt to their input layout. A transform is paid on a
+ * link whose ends have different data layouts, and on the links with the parameters and the result
+ * of the function if the call changes its data layout. This is a labeling problem with Potts
+ * interactions, solved by alpha-expansion: each move lets any set of calls switch to one data
+ * layout, taking the minimum cut of a graph, until no move reduces the cost.
+ */
+class LayoutSelector {
+ public:
+  LayoutSelector(Map<String, Array<Array<String>>> candidates, PackedFunc kernel_cost)
+      : candidates_(std::move(candidates)), kernel_cost_(std::move(kernel_cost)) {}
+
+  std::unordered_map<const CallNode*, Array<String>> Select(const Function& func) {
+    // Step 1. Collect the calls with candidates, and the layout transforms they may need.
+    std::unordered_map<const ExprNode*, std::vector<int>> sources;
+    PostOrderVisit(func->body, [&](const Expr& e) {
+      std::vector<int>& srcs = sources[e.get()];
+      if (e->IsInstance<VarNode>()) {
+        srcs.push_back(kBoundary);
+      } else if (const auto* call = e.as<CallNode>()) {
+        if (const auto* op = call->op.as<OpNode>()) {
+          if (candidates_.count(op->name) && !call->args.empty()) {
+            int id = AddNode(call, candidates_.at(op->name));
+            for (int src : sources[call->args[0].get()]) {
+              AddEdge(src, id, call->args[0]->checked_type());
+            }
+            srcs.push_back(id);
+            return;
+          }
+        }
+        for (const Expr& arg : call->args) {
+          MergeSources(sources[arg.get()], &srcs);
+        }
+      } else if (const auto* tuple = e.as<TupleNode>()) {
+        for (const Expr& field : tuple->fields) {
+          MergeSources(sources[field.get()], &srcs);
+        }
+      } else if (const auto* get_item = e.as<TupleGetItemNode>()) {
+        MergeSources(sources[get_item->tuple.get()], &srcs);
+      }
+    });
+    for (int src : sources[func->body.get()]) {
+      AddEdge(src, kBoundary, func->body->checked_type());
+    }
+    // Step 2. Expand each data layout in turn, until no expansion reduces the cost.
+    std::vector<std::string> labels;
+    for (const Node& node : nodes_) {
+      for (const auto& kv : node.kernel_costs) {
+        if (std::find(labels.begin(), labels.end(), kv.first) == labels.end()) {
+          labels.push_back(kv.first);
+        }
+      }
+    }
+    int64_t cost = Cost();
+    for (bool improved = true; improved;) {
+      improved = false;
+      for (const std::string& label : labels) {
+        std::vector<std::string> prev_labels;
+        for (Node& node : nodes_) {
+          prev_labels.push_back(node.label);
+        }
+        Expand(label);
+        int64_t new_cost = Cost();
+        if (new_cost < cost) {
+          cost = new_cost;
+          improved = true;
+        } else {
+          for (size_t i = 0; i < nodes_.size(); ++i) {
+            nodes_[i].label = prev_labels[i];
+          }
+        }
+      }
+    }
+    // Step 3. Take the cheapest candidate of each call with the data layout selected.
+    std::unordered_map<const CallNode*, Array<String>> result;
+    for (const Node& node : nodes_) {
+      auto it = node.candidates.find(node.label);
+      if (it != node.candidates.end()) {
+        result[node.call] = it->second;
+      }
+    }
+    return result;
+  }
+
+ private:
+  /*! \brief A call with candidate layouts. */
+  struct Node {
+    const CallNode* call;
+    /*! \brief The data layout of the call before conversion. */
+    std::string original;
+    /*! \brief The data layout selected. */
+    std::string label;
+    /*! \brief The cheapest kernel of each feasible data layout, in nanoseconds. */
+    std::unordered_map<std::string, int64_t> kernel_costs;
+    /*! \brief The cheapest candidate of each feasible data layout. */
+    std::unordered_map<std::string, Array<String>> candidates;
+    /*! \brief The cost of the transforms if the call changes its data layout, in nanoseconds. */
+    int64_t boundary_cost;
+  };
+  /*! \brief A tensor flowing between two calls, and the cost of transforming its layout. */
+  struct Edge {
+    int u;
+    int v;
+    int64_t cost;
+  };
+
+  /*! \brief The parameters and the result of the function, which keep their layouts. */
+  static constexpr int kBoundary = -1;
+  /*! \brief The number of sources tracked per expression, the others are dropped. */
+  static constexpr size_t kMaxSources = 16;
+  /*! \brief The memory bandwidth and launch overhead assumed for layout_transform. */
+  static constexpr double kBandwidth = 2e10;
+  static constexpr double kLaunchOverhead = 2e-6;
+  /*! \brief The cost of an unsupported data layout, which no cut can afford. */
+  static constexpr int64_t kInfeasible = int64_t(1) << 40;
+
+  int AddNode(const CallNode* call, const Array<Array<String>>& candidates) {
+    Node node{call, OriginalDataLayout(call), "", {}, {}, 0};
+    for (const Array<String>& layouts : candidates) {
+      double cost = 0.0;
+      if (kernel_cost_ != nullptr) {
+        cost = kernel_cost_(GetRef<Call>(call), layouts);
+      }
+      // A negative cost marks a candidate the call does not support.
+      if (layouts.empty() || cost < 0.0) continue;
+      std::string label = layouts[0];
+      int64_t nanos = std::min(static_cast<int64_t>(std::llround(cost * 1e9)), kInfeasible);
+      auto it = node.kernel_costs.find(label);
+      if (it == node.kernel_costs.end() || nanos < it->second) {
+        node.kernel_costs[label] = nanos;
+        node.candidates[label] = layouts;
+      }
+    }
+    // Start from the original data layout, which is kept when no candidate is feasible.
+    node.label = node.original;
+    if (!node.kernel_costs.count(node.original)) {
+      if (node.kernel_costs.empty()) {
+        node.kernel_costs[node.original] = 0;
+      } else {
+        auto cheapest = std::min_element(
+            node.kernel_costs.begin(), node.kernel_costs.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+        node.label = cheapest->first;
+      }
+    }
+    nodes_.push_back(std::move(node));
+    return static_cast<int>(nodes_.size()) - 1;
+  }
+
+  void AddEdge(int u, int v, const Type& type) {
+    if (u == kBoundary && v == kBoundary) return;
+    int64_t cost = std::llround((kLaunchOverhead + 2 * TypeBytes(type) / kBandwidth) * 1e9);
+    if (u == kBoundary || v == kBoundary) {
+      nodes_[u == kBoundary ? v : u].boundary_cost += cost;
+    } else if (u != v) {
+      edges_.push_back({u, v, cost});
+    }
+  }
+
+  int64_t UnaryCost(const Node& node, const std::string& label) const {
+    auto it = node.kernel_costs.find(label);
+    if (it == node.kernel_costs.end()) return kInfeasible;
+    return it->second + (label != node.original ? node.boundary_cost : 0);
+  }
+
+  int64_t Cost() const {
+    int64_t cost = 0;
+    for (const Node& node : nodes_) {
+      cost += UnaryCost(node, node.label);
+    }
+    for (const Edge& edge : edges_) {
+      if (nodes_[edge.u].label != nodes_[edge.v].label) cost += edge.cost;
+    }
+    return cost;
+  }
+
+  /*!
+   * \brief Lets the calls switch to the data layout if that reduces the cost, by the minimum cut
+   * of a graph whose source side keeps the current layout and whose sink side switches.
+   */
+  void Expand(const std::string& label) {
+    int n = nodes_.size();
+    int source = n, sink = n + 1;
+    MinCut graph(n + 2);
+    // Adds the cost `coef` * x_i, where x_i is whether the call switches, up to a constant.
+    auto add_linear = [&](int i, int64_t coef) {
+      if (coef > 0) {
+        graph.AddEdge(source, i, coef);
+      } else {
+        graph.AddEdge(i, sink, -coef);
+      }
+    };
+    for (int i = 0; i < n; ++i) {
+      if (nodes_[i].label != label) {
+        graph.AddEdge(source, i, UnaryCost(nodes_[i], label));
+        graph.AddEdge(i, sink, UnaryCost(nodes_[i], nodes_[i].label));
+      }
+    }
+    // The Potts interaction of a link, decomposed over the cut as in Kolmogorov and Zabih.
+    for (const Edge& edge : edges_) {
+      const std::string& lu = nodes_[edge.u].label;
+      const std::string& lv = nodes_[edge.v].label;
+      int64_t keep_keep = lu != lv ? edge.cost : 0;
+      int64_t keep_switch = lu != label ? edge.cost : 0;
+      int64_t switch_keep = label != lv ? edge.cost : 0;
+      // E = keep_keep + (switch_keep - keep_keep) * x_u + (0 - switch_keep) * x_v
+      //     + (keep_switch + switch_keep - keep_keep) * (1 - x_u) * x_v
+      add_linear(edge.u, switch_keep - keep_keep);
+      add_linear(edge.v, -switch_keep);
+      graph.AddEdge(edge.u, edge.v, keep_switch + switch_keep - keep_keep);
+    }
+    std::vector<bool> keep = graph.SourceSide(source, sink);
+    for (int i = 0; i < n; ++i) {
+      if (!keep[i]) nodes_[i].label = label;
+    }
+  }
+
+  /*! \brief The minimum s-t cut of a small graph, by Edmonds-Karp. */
+  class MinCut {
+   public:
+    explicit MinCut(int n) : adjacency_(n) {}
+
+    void AddEdge(int u, int v, int64_t capacity) {
+      if (capacity <= 0) return;
+      adjacency_[u].push_back(arcs_.size());
+      arcs_.push_back({v, capacity});
+      adjacency_[v].push_back(arcs_.size());
+      arcs_.push_back({u, 0});
+    }
+
+    /*! \brief Returns whether each node is on the source side of the minimum cut. */
+    std::vector<bool> SourceSide(int source, int sink) {
+      while (true) {
+        std::vector<int> parent_arc = Reach(source);
+        if (parent_arc[sink] == -1) break;
+        int64_t flow = std::numeric_limits<int64_t>::max();
+        for (int v = sink; v != source; v = arcs_[parent_arc[v] ^ 1].to) {
+          flow = std::min(flow, arcs_[parent_arc[v]].capacity);
+        }
+        for (int v = sink; v != source; v = arcs_[parent_arc[v] ^ 1].to) {
+          arcs_[parent_arc[v]].capacity -= flow;
+          arcs_[parent_arc[v] ^ 1].capacity += flow;
+        }
+      }
+      std::vector<int> parent_arc = Reach(source);
+      std::vector<bool> result(adjacency_.size());
+      for (size_t v = 0; v < adjacency_.size(); ++v) {
+        result[v] = static_cast<int>(v) == source || parent_arc[v] != -1;
+      }
+      return result;
+    }
+
+   private:
+    struct Arc {
+      int to;
+      int64_t capacity;
+    };
+
+    /*! \brief Breadth-first search in the residual graph, returning the arc into each node. */
+    std::vector<int> Reach(int source) const {
+      std::vector<int> parent_arc(adjacency_.size(), -1);
+      std::vector<int> queue{source};
+      for (size_t head = 0; head < queue.size(); ++head) {
+        for (int arc : adjacency_[queue[head]]) {
+          int v = arcs_[arc].to;
+          if (arcs_[arc].capacity > 0 && v != source && parent_arc[v] == -1) {
+            parent_arc[v] = arc;
+            queue.push_back(v);
+          }
+        }
+      }
+      return parent_arc;
+    }
+
+    std::vector<std::vector<int>> adjacency_;
+    std::vector<Arc> arcs_;
+  };
+
+  /*! \brief The original data layout, which also stands for the layout at the boundary. */
+  static std::string OriginalDataLayout(const CallNode* call) {
+    if (call->attrs.defined()) {
+      auto* attrs = const_cast<BaseAttrsNode*>(call->attrs.get());
+      std::vector<std::string> names = ReflectionVTable::Global()->ListAttrNames(attrs);
+      if (std::find(names.begin(), names.end(), "data_layout") != names.end()) {
+        String layout = ReflectionVTable::Global()->GetAttr(attrs, "data_layout");
+        return layout;
+      }
+    }
+    return "";
+  }
+
+  static void MergeSources(const std::vector<int>& from, std::vector<int>* to) {
+    for (int src : from) {
+      if (to->size() < kMaxSources && std::find(to->begin(), to->end(), src) == to->end()) {
+        to->push_back(src);
+      }
+    }
+  }
+
+  static double TypeBytes(const Type& type) {
+    if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+      double bytes = tensor_type->dtype.bytes() * tensor_type->dtype.lanes();
+      for (const PrimExpr& dim : tensor_type->shape) {
+        const auto* extent = dim.as<IntImmNode>();
+        if (extent == nullptr) return 0.0;
+        bytes *= extent->value;
+      }
+      return bytes;
+    }
+    double bytes = 0.0;
+    if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+      for (const Type& field : tuple_type->fields) {
+        bytes += TypeBytes(field);
+      }
+    }
+    return bytes;
+  }
+
+  Map<String, Array<Array<String>>> candidates_;
+  PackedFunc kernel_cost_;
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+};
+
+Expr ConvertLayoutAuto(const Function& func, const Map<String, Array<Array<String>>>& candidates,
+                       const PackedFunc& kernel_cost) {
+  ConvertTransformMemorizer transformMemorizer(make_object<ConvertTransformMemorizerNode>(
+      LayoutSelector(candidates, kernel_cost).Select(func)));
+  auto fcontext = [&](const Call& call) -> ObjectRef { return transformMemorizer; };
+
+  return ForwardRewrite(func, LayoutRewriter<ConvertTransformMemorizer>, fcontext);
+}
+
 }  // namespace convert_op_layout
 
 namespace transform {
@@ -158,6 +518,18 @@ Pass ConvertLayout(const Map<String, Array<String>>& desired_layouts) {
 
 TVM_REGISTER_GLOBAL("relay._transform.ConvertLayout").set_body_typed(ConvertLayout);
 
+Pass ConvertLayoutAuto(const Map<String, Array<Array<String>>>& candidate_layouts,
+                       PackedFunc kernel_cost) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(
+            relay::convert_op_layout::ConvertLayoutAuto(f, candidate_layouts, kernel_cost));
+      };
+  return CreateFunctionPass(pass_func, 3, "ConvertLayoutAuto", {"InferType", "CanonicalizeOps"});
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.ConvertLayoutAuto").set_body_typed(ConvertLayoutAuto);
+
 TVM_REGISTER_GLOBAL("relay._transform.InferCorrectLayoutOutput")
     .set_body_typed([](Array<Layout> input_layouts, Array<Layout> output_layouts, Attrs new_attrs) {
       return InferCorrectLayoutOutput(input_layouts, output_layouts, new_attrs);
@@ -0,0 +1,330 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ *
+ * \file convert_sparse_auto.cc
+ *
+ * \brief Detect block sparse constant weights of dense and 1x1 conv2d operators, and convert
+ * the operators to their BSR sparse versions when cheaper.
+ */
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+#include <tvm/tir/op.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace relay {
+
+/*! \brief A weight matrix in BSR format. */
+struct BSRWeight {
+  int block_h;
+  int block_w;
+  std::vector<float> data;
+  std::vector<int32_t> indices;
+  std::vector<int32_t> indptr;
+};
+
+/*!
+ * \brief A row-major float32 weight matrix of shape [rows, cols], where each row produces one
+ * output channel.
+ */
+class WeightMatrix {
+ public:
+  WeightMatrix(std::vector<float> values, int64_t rows, int64_t cols)
+      : values_(std::move(values)), rows_(rows), cols_(cols) {}
+
+  /*! \brief The number of blocks of the given shape with a nonzero element, -1 if not tiled. */
+  int64_t CountNonzeroBlocks(int block_h, int block_w) const {
+    if (block_h <= 0 || block_w <= 0 || rows_ % block_h != 0 || cols_ % block_w != 0) {
+      return -1;
+    }
+    int64_t count = 0;
+    for (int64_t bi = 0; bi < rows_ / block_h; ++bi) {
+      for (int64_t bj = 0; bj < cols_ / block_w; ++bj) {
+        count += IsNonzeroBlock(bi, bj, block_h, block_w);
+      }
+    }
+    return count;
+  }
+
+  BSRWeight ToBSR(int block_h, int block_w) const {
+    BSRWeight bsr{block_h, block_w, {}, {}, {}};
+    for (int64_t bi = 0; bi < rows_ / block_h; ++bi) {
+      bsr.indptr.push_back(bsr.indices.size());
+      for (int64_t bj = 0; bj < cols_ / block_w; ++bj) {
+        if (!IsNonzeroBlock(bi, bj, block_h, block_w)) continue;
+        for (int i = 0; i < block_h; ++i) {
+          for (int j = 0; j < block_w; ++j) {
+            bsr.data.push_back(At(bi * block_h + i, bj * block_w + j));
+          }
+        }
+        bsr.indices.push_back(bj);
+      }
+    }
+    bsr.indptr.push_back(bsr.indices.size());
+    return bsr;
+  }
+
+  int64_t rows() const { return rows_; }
+  int64_t cols() const { return cols_; }
+
+ private:
+  float At(int64_t i, int64_t j) const { return values_[i * cols_ + j]; }
+
+  bool IsNonzeroBlock(int64_t bi, int64_t bj, int block_h, int block_w) const {
+    for (int i = 0; i < block_h; ++i) {
+      for (int j = 0; j < block_w; ++j) {
+        if (At(bi * block_h + i, bj * block_w + j) != 0.0f) return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<float> values_;
+  int64_t rows_;
+  int64_t cols_;
+};
+
+// Mutate ```nn.dense``` and 1x1 ```nn.conv2d``` with block sparse constant weights to
+// ```nn.sparse_dense``` and ```nn.sparse_conv2d```
+class AutoSparseMutator : public ExprRewriter {
+ public:
+  AutoSparseMutator(const Array<Array<Integer>>& block_sizes, double sparsity_threshold,
+                    PackedFunc kernel_cost)
+      : dense_op_(Op::Get("nn.dense")),
+        conv2d_op_(Op::Get("nn.conv2d")),
+        sparse_dense_op_(Op::Get("nn.sparse_dense")),
+        sparse_conv2d_op_(Op::Get("nn.sparse_conv2d")),
+        sparsity_threshold_(sparsity_threshold),
+        kernel_cost_(std::move(kernel_cost)) {
+    for (const auto& block_size : block_sizes) {
+      ICHECK_EQ(block_size.size(), 2) << "Block sizes should be pairs of (height, width)";
+      block_sizes_.emplace_back(block_size[0]->value, block_size[1]->value);
+    }
+  }
+
+  Expr Rewrite_(const CallNode* pre, const Expr& post) override {
+    const auto* weight = pre->args.size() == 2 ? pre->args[1].as<ConstantNode>() : nullptr;
+    if (!weight || !IsFloat32(DataType(weight->data->dtype)) || !IsFloat32(DataTypeOf(pre->args[0]))) {
+      return post;
+    }
+    Expr data = Downcast<Call>(post)->args[0];
+    if (pre->op == dense_op_) {
+      const auto* attrs = pre->attrs.as<DenseAttrs>();
+      if (DimOf(pre->args[0]) != 2 || (!attrs->out_dtype.is_void() && attrs->out_dtype != f32)) {
+        return post;
+      }
+      // The weight of dense is [units, in_features] already.
+      const auto& shape = weight->data.Shape();
+      WeightMatrix matrix(CopyValues(weight->data), shape[0], shape[1]);
+      return Select(pre, post, matrix, [&](const BSRWeight& bsr) {
+        auto attrs = make_object<SparseDenseAttrs>();
+        return Call(sparse_dense_op_, WithBSR(data, bsr), Attrs(attrs));
+      });
+    }
+    if (pre->op == conv2d_op_) {
+      const auto* attrs = pre->attrs.as<Conv2DAttrs>();
+      std::string layout = attrs->data_layout;
+      if (!IsPointwise(attrs) || (!attrs->out_dtype.is_void() && attrs->out_dtype != f32)) {
+        return post;
+      }
+      const auto& shape = weight->data.Shape();
+      std::vector<float> values = CopyValues(weight->data);
+      if (layout == "NCHW" && attrs->kernel_layout == "OIHW" && shape[2] == 1 && shape[3] == 1) {
+        WeightMatrix matrix(std::move(values), shape[0], shape[1]);
+        return Select(pre, post, matrix, [&](const BSRWeight& bsr) {
+          return MakeSparseConv2d(data, bsr, layout);
+        });
+      }
+      if (layout == "NHWC" && attrs->kernel_layout == "HWIO" && shape[0] == 1 && shape[1] == 1) {
+        // Transpose the [in_channels, out_channels] weight to one row per output channel.
+        int64_t ci = shape[2], co = shape[3];
+        std::vector<float> transposed(values.size());
+        for (int64_t i = 0; i < ci; ++i) {
+          for (int64_t o = 0; o < co; ++o) transposed[o * ci + i] = values[i * co + o];
+        }
+        WeightMatrix matrix(std::move(transposed), co, ci);
+        return Select(pre, post, matrix, [&](const BSRWeight& bsr) {
+          return MakeSparseConv2d(data, bsr, layout);
+        });
+      }
+    }
+    return post;
+  }
+
+ private:
+  /*!
+   * \brief Pick the cheapest BSR version of the call among the block sizes whose sparsity reaches
+   * the threshold, and return it when cheaper than the dense call.
+   */
+  template <typename FMakeSparse>
+  Expr Select(const CallNode* pre, const Expr& post, const WeightMatrix& matrix,
+              FMakeSparse make_sparse) {
+    double dense_cost = DenseCost(pre, matrix);
+    if (dense_cost < 0) return post;
+    Optional<Expr> best;
+    double best_cost = dense_cost;
+    for (const auto& block_size : block_sizes_) {
+      int block_h = block_size.first, block_w = block_size.second;
+      int64_t nnz_blocks = matrix.CountNonzeroBlocks(block_h, block_w);
+      if (nnz_blocks < 0) continue;
+      double density = static_cast<double>(nnz_blocks) * block_h * block_w /
+                       (static_cast<double>(matrix.rows()) * matrix.cols());
+      if (1.0 - density < sparsity_threshold_) continue;
+      Expr sparse = make_sparse(matrix.ToBSR(block_h, block_w));
+      double cost = SparseCost(pre, sparse, matrix, nnz_blocks, block_h, block_w);
+      if (cost >= 0 && cost < best_cost) {
+        best = sparse;
+        best_cost = cost;
+      }
+    }
+    return best.defined() ? best.value() : post;
+  }
+
+  double DenseCost(const CallNode* pre, const WeightMatrix& matrix) const {
+    if (kernel_cost_ != nullptr) {
+      return kernel_cost_(GetRef<Call>(pre));
+    }
+    return 2.0 * OutputRows(pre) * matrix.rows() * matrix.cols() / kFlops;
+  }
+
+  double SparseCost(const CallNode* pre, const Expr& sparse, const WeightMatrix& matrix,
+                    int64_t nnz_blocks, int block_h, int block_w) const {
+    if (kernel_cost_ != nullptr) {
+      return kernel_cost_(sparse);
+    }
+    // The sparse kernels vectorize within blocks only and pay for gathering the inputs of each
+    // block, so small blocks run well below the throughput of the dense kernels.
+    double block_flops = 2.0 * block_h * block_w * kSparsePenalty + kBlockOverheadFlops;
+    return OutputRows(pre) * (nnz_blocks * block_flops + matrix.rows()) / kFlops;
+  }
+
+  /*! \brief The number of rows of the input multiplied by the weight, 1 if unknown. */
+  static double OutputRows(const CallNode* pre) {
+    const auto* type = pre->args[0]->checked_type_.as<TensorTypeNode>();
+    double rows = 1.0;
+    if (type == nullptr) return rows;
+    const auto* attrs = pre->attrs.as<Conv2DAttrs>();
+    for (size_t i = 0; i + 1 < type->shape.size(); ++i) {
+      // The channels of NCHW are the second dimension.
+      size_t axis = (attrs && attrs->data_layout == "NCHW" && i > 0) ? i + 1 : i;
+      if (const auto* extent = type->shape[axis].as<IntImmNode>()) rows *= extent->value;
+    }
+    return rows;
+  }
+
+  static bool IsPointwise(const Conv2DAttrs* attrs) {
+    auto is_one = [](const PrimExpr& e) { return tir::is_const_int(e, 1); };
+    auto is_zero = [](const PrimExpr& e) { return tir::is_const_int(e, 0); };
+    return attrs->groups == 1 &&
+           std::all_of(attrs->kernel_size.begin(), attrs->kernel_size.end(), is_one) &&
+           std::all_of(attrs->strides.begin(), attrs->strides.end(), is_one) &&
+           std::all_of(attrs->dilation.begin(), attrs->dilation.end(), is_one) &&
+           std::all_of(attrs->padding.begin(), attrs->padding.end(), is_zero);
+  }
+
+  static bool IsFloat32(DataType dtype) { return dtype == DataType::Float(32); }
+
+  static DataType DataTypeOf(const Expr& expr) {
+    const auto* type = expr->checked_type_.as<TensorTypeNode>();
+    return type ? type->dtype : DataType::Void();
+  }
+
+  static int DimOf(const Expr& expr) {
+    const auto* type = expr->checked_type_.as<TensorTypeNode>();
+    return type ? type->shape.size() : -1;
+  }
+
+  static std::vector<float> CopyValues(const runtime::NDArray& array) {
+    int64_t size = 1;
+    for (int64_t extent : array.Shape()) size *= extent;
+    std::vector<float> values(size);
+    array.CopyToBytes(values.data(), values.size() * sizeof(float));
+    return values;
+  }
+
+  Array<Expr> WithBSR(const Expr& data, const BSRWeight& bsr) const {
+    DLDevice dev_cpu0{DLDeviceType::kDLCPU, 0};
+    int64_t nnz = bsr.indices.size();
+    auto weight_data = runtime::NDArray::Empty({nnz, bsr.block_h, bsr.block_w}, f32, dev_cpu0);
+    auto weight_indices = runtime::NDArray::Empty({nnz}, DataType::Int(32), dev_cpu0);
+    auto weight_indptr = runtime::NDArray::Empty({static_cast<int64_t>(bsr.indptr.size())},
+                                                 DataType::Int(32), dev_cpu0);
+    weight_data.CopyFromBytes(bsr.data.data(), bsr.data.size() * sizeof(float));
+    weight_indices.CopyFromBytes(bsr.indices.data(), bsr.indices.size() * sizeof(int32_t));
+    weight_indptr.CopyFromBytes(bsr.indptr.data(), bsr.indptr.size() * sizeof(int32_t));
+    return {data, Constant(weight_data), Constant(weight_indices), Constant(weight_indptr)};
+  }
+
+  Expr MakeSparseConv2d(const Expr& data, const BSRWeight& bsr, const std::string& layout) const {
+    auto attrs = make_object<SparseConv2DAttrs>();
+    attrs->layout = layout;
+    attrs->kernel_size = Array<IndexExpr>{1, 1};
+    return Call(sparse_conv2d_op_, WithBSR(data, bsr), Attrs(attrs));
+  }
+
+  /*! \brief The assumed throughput of the dense kernels, in flops per second. */
+  static constexpr double kFlops = 1e11;
+  /*! \brief The slowdown of the multiply-adds of the sparse kernels relative to dense ones. */
+  static constexpr double kSparsePenalty = 1.5;
+  /*! \brief The overhead of each nonzero block, in flops of the dense kernels. */
+  static constexpr double kBlockOverheadFlops = 16.0;
+
+  const DataType f32 = DataType::Float(32);
+  // Cached op
+  const Op& dense_op_;
+  const Op& conv2d_op_;
+  const Op& sparse_dense_op_;
+  const Op& sparse_conv2d_op_;
+  std::vector<std::pair<int, int>> block_sizes_;
+  double sparsity_threshold_;
+  PackedFunc kernel_cost_;
+};  // class AutoSparseMutator
+
+Expr ToSparseAuto(const Expr& e, const Array<Array<Integer>>& block_sizes,
+                  double sparsity_threshold, const PackedFunc& kernel_cost) {
+  auto rewriter = AutoSparseMutator(block_sizes, sparsity_threshold, kernel_cost);
+  return PostOrderRewrite(e, &rewriter);
+}
+
+namespace transform {
+
+// Convert a model with freezed params, detecting the sparse weights in the pass.
+Pass ToSparseAuto(const Array<Array<Integer>>& block_sizes, double sparsity_threshold,
+                  PackedFunc kernel_cost) {
+  runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
+      [=](Function f, IRModule m, PassContext pc) {
+        return Downcast<Function>(
+            relay::ToSparseAuto(f, block_sizes, sparsity_threshold, kernel_cost));
+      };
+  Pass pass = CreateFunctionPass(pass_func, 4, "ToSparseAuto", {"InferType"});
+  return Sequential({InferType(), pass, InferType()}, "ToSparseAuto");
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.ToSparseAuto").set_body_typed(ToSparseAuto);
+
+}  // namespace transform
+
+}  // namespace relay
+}  // namespace tvm
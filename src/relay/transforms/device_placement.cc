@@ -0,0 +1,495 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/device_placement.cc
+ * \brief Chooses the devices of the primitive calls left unconstrained by "on_device" annotations.
+ *
+ * Every primitive call of a function becomes a node of a dataflow graph, whose edges go from the
+ * calls producing a value (looking through tuples and projections) to the calls consuming it.
+ * Each node has an estimated time on every candidate device, and each edge whose ends are on
+ * different devices costs the time of copying the value. The total is minimized by a greedy
+ * assignment in post-dfs order, followed by sweeps moving single nodes to their best device
+ * given their producers and consumers until no move improves the total. Calls already annotated
+ * with a device are fixed to it.
+ *
+ * The placement is recorded by wrapping every placed call in an "on_device" annotation
+ * constraining its body only, so the remaining phases of \p PlanDevices insert the "device_copy"
+ * calls needed between calls placed on different devices.
+ */
+
+#include "./device_placement.h"
+
+#include <tvm/relay/attrs/nn.h>
+#include <tvm/relay/expr_functor.h>
+#include <tvm/relay/transform.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../op/memory/on_device.h"
+
+namespace tvm {
+namespace relay {
+namespace transform {
+
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.PlanDevices.auto_placement", Bool);
+
+namespace {
+
+/*! \brief The roofline parameters of a kind of device. */
+struct DeviceCostParams {
+  /*! \brief The peak floating point operations per second. */
+  double peak_flops;
+  /*! \brief The memory bandwidth in bytes per second. */
+  double bandwidth;
+  /*! \brief The overhead of launching a kernel in seconds. */
+  double launch_overhead;
+};
+
+DeviceCostParams CostParamsFor(DLDeviceType device_type) {
+  switch (device_type) {
+    case kDLCPU:
+      return {1e11, 2e10, 1e-6};
+    case kDLCUDA:
+    case kDLROCM:
+    case kDLOpenCL:
+    case kDLVulkan:
+    case kDLMetal:
+      return {1e13, 5e11, 1e-5};
+    default:
+      return {2e12, 5e10, 2e-5};
+  }
+}
+
+/*! \brief The bandwidth of copies between devices in bytes per second. */
+constexpr double kCopyBandwidth = 1e10;
+/*! \brief The latency of a copy between devices in seconds. */
+constexpr double kCopyLatency = 2e-5;
+/*! \brief The maximum number of refinement sweeps. */
+constexpr int kMaxSweeps = 16;
+
+/*!
+ * \brief Returns true if \p op_name is an operator with data dependent control flow or output
+ * shapes, which accelerators run much slower than the CPU.
+ */
+bool IsHostPreferredOp(const std::string& op_name) {
+  static const std::unordered_set<std::string> kHostPreferredOps = {
+      "argwhere",
+      "unique",
+      "vision.get_valid_counts",
+      "vision.non_max_suppression",
+      "vision.all_class_non_max_suppression",
+      "vision.proposal",
+  };
+  return kHostPreferredOps.count(op_name) > 0;
+}
+
+/*!
+ * \brief Returns true if \p op_name is an operator whose device is decided by the special rules
+ * of \p PlanDevices rather than by placement.
+ */
+bool IsDeviceSpecialOp(const std::string& op_name) {
+  return op_name == "on_device" || op_name == "device_copy" || op_name == "shape_of" ||
+         op_name.compare(0, 3, "vm.") == 0 || op_name.compare(0, 7, "memory.") == 0;
+}
+
+double NumElements(const Type& type) {
+  double num = 0.0;
+  if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+    num = 1.0;
+    for (const PrimExpr& dim : tensor_type->shape) {
+      const auto* extent = dim.as<IntImmNode>();
+      num *= extent != nullptr ? extent->value : 1;
+    }
+  } else if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+    for (const Type& field : tuple_type->fields) {
+      num += NumElements(field);
+    }
+  }
+  return num;
+}
+
+double Bytes(const Type& type) {
+  if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+    return NumElements(type) * tensor_type->dtype.bytes();
+  } else if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+    double bytes = 0.0;
+    for (const Type& field : tuple_type->fields) {
+      bytes += Bytes(field);
+    }
+    return bytes;
+  }
+  return 0.0;
+}
+
+/*!
+ * \brief Returns the floating point operations of \p call, counting the multiply-adds of the
+ * convolutions and matrix multiplications and one operation per output element otherwise.
+ */
+double Flops(const Call& call, const std::string& op_name) {
+  double out_elems = NumElements(call->checked_type());
+  if (call->args.size() < 2) {
+    return out_elems;
+  }
+  const Type& lhs_type = call->args[0]->checked_type();
+  const Type& rhs_type = call->args[1]->checked_type();
+  const auto* lhs_tensor = lhs_type.as<TensorTypeNode>();
+  const auto* rhs_tensor = rhs_type.as<TensorTypeNode>();
+  if (lhs_tensor == nullptr || rhs_tensor == nullptr || lhs_tensor->shape.empty()) {
+    return out_elems;
+  }
+  if (op_name.compare(0, 7, "nn.conv") == 0) {
+    // Each output element reduces over a slice of the weight of one output channel
+    std::string kernel_layout;
+    if (const auto* attrs = call->attrs.as<Conv2DAttrs>()) {
+      kernel_layout = attrs->kernel_layout;
+    } else if (const auto* attrs = call->attrs.as<Conv1DAttrs>()) {
+      kernel_layout = attrs->kernel_layout;
+    } else if (const auto* attrs = call->attrs.as<Conv3DAttrs>()) {
+      kernel_layout = attrs->kernel_layout;
+    }
+    size_t pos = kernel_layout.find('O');
+    if (pos == std::string::npos || pos >= rhs_tensor->shape.size()) {
+      return out_elems;
+    }
+    const auto* out_channels = rhs_tensor->shape[pos].as<IntImmNode>();
+    if (out_channels == nullptr || out_channels->value == 0) {
+      return out_elems;
+    }
+    return 2.0 * out_elems * NumElements(rhs_type) / out_channels->value;
+  }
+  if (op_name == "nn.dense" || op_name == "nn.matmul" || op_name == "nn.batch_matmul") {
+    const auto* reduction = lhs_tensor->shape.back().as<IntImmNode>();
+    return 2.0 * out_elems * (reduction != nullptr ? reduction->value : 1);
+  }
+  return out_elems;
+}
+
+/*! \brief A primitive call in the dataflow graph of placement. */
+struct PlacementNode {
+  /*! \brief The call. */
+  const CallNode* call;
+  /*! \brief The indexes of the nodes producing the arguments of the call. */
+  std::vector<size_t> producers;
+  /*! \brief The indexes of the nodes consuming the result of the call. */
+  std::vector<size_t> consumers;
+  /*! \brief The estimated time of the call on each candidate device, in seconds. */
+  std::vector<double> cost;
+  /*! \brief The time of copying the result of the call to another device, in seconds. */
+  double copy_cost = 0.0;
+  /*! \brief The index of the candidate the call is fixed to, or -1 if free. */
+  int fixed = -1;
+  /*! \brief Whether the result of the call is (part of) the result of the function. */
+  bool is_output = false;
+};
+
+/*! \brief Builds the dataflow graph of the primitive calls of a function body. */
+class PlacementGraphBuilder : public ExprVisitor {
+ public:
+  PlacementGraphBuilder(const std::vector<VirtualDevice>& candidates, const PackedFunc* op_cost)
+      : candidates_(candidates), op_cost_(op_cost) {}
+
+  std::vector<PlacementNode> Build(const Function& func) {
+    VisitExpr(func->body);
+    for (size_t producer : Producers({func->body})) {
+      nodes_[producer].is_output = true;
+    }
+    return std::move(nodes_);
+  }
+
+ private:
+  void VisitExpr_(const FunctionNode* function_node) final {
+    // Local functions are placed as a whole by PlanDevices, their body is not visited.
+  }
+
+  void VisitExpr_(const CallNode* call_node) final {
+    OnDeviceProps props = GetOnDeviceProps(call_node);
+    if (props.body.defined()) {
+      const auto* body_call = props.body.as<CallNode>();
+      if (body_call != nullptr && props.constrain_body &&
+          !props.virtual_device->IsFullyUnconstrained()) {
+        fixed_.emplace(body_call, props.virtual_device->device_type());
+      }
+      ExprVisitor::VisitExpr_(call_node);
+      return;
+    }
+    ExprVisitor::VisitExpr_(call_node);
+    const auto* op_node = call_node->op.as<OpNode>();
+    if (op_node == nullptr || IsDeviceSpecialOp(op_node->name) ||
+        !call_node->checked_type_.defined()) {
+      return;
+    }
+    PlacementNode node;
+    node.call = call_node;
+    node.producers = Producers(call_node->args);
+    auto it = fixed_.find(call_node);
+    if (it != fixed_.end()) {
+      for (size_t i = 0; i < candidates_.size(); ++i) {
+        if (candidates_[i]->device_type() == it->second) {
+          node.fixed = static_cast<int>(i);
+        }
+      }
+      if (node.fixed == -1) {
+        // Fixed to a device which is not a candidate, leave it out of the placement
+        return;
+      }
+    }
+    double bytes = Bytes(call_node->checked_type());
+    for (const Expr& arg : call_node->args) {
+      bytes += Bytes(arg->checked_type());
+    }
+    double flops = Flops(GetRef<Call>(call_node), op_node->name);
+    for (const VirtualDevice& candidate : candidates_) {
+      node.cost.push_back(Cost(GetRef<Call>(call_node), op_node->name, candidate, flops, bytes));
+    }
+    node.copy_cost = Bytes(call_node->checked_type()) / kCopyBandwidth + kCopyLatency;
+    size_t index = nodes_.size();
+    for (size_t producer : node.producers) {
+      nodes_[producer].consumers.push_back(index);
+    }
+    node_index_.emplace(call_node, index);
+    nodes_.push_back(std::move(node));
+  }
+
+  double Cost(const Call& call, const std::string& op_name, const VirtualDevice& candidate,
+              double flops, double bytes) {
+    if (op_cost_ != nullptr) {
+      double cost = (*op_cost_)(call, candidate->target);
+      if (cost >= 0.0) {
+        return cost;
+      }
+    }
+    if (candidate->device_type() != kDLCPU && IsHostPreferredOp(op_name)) {
+      return std::numeric_limits<double>::infinity();
+    }
+    DeviceCostParams params = CostParamsFor(candidate->device_type());
+    return std::max(flops / params.peak_flops, bytes / params.bandwidth) +
+           params.launch_overhead;
+  }
+
+  /*! \brief Returns the nodes producing \p exprs, looking through tuples and annotations. */
+  std::vector<size_t> Producers(const Array<Expr>& exprs) {
+    std::vector<size_t> producers;
+    std::vector<Expr> stack(exprs.rbegin(), exprs.rend());
+    while (!stack.empty()) {
+      Expr sub_expr = stack.back();
+      stack.pop_back();
+      if (const auto* tuple_node = sub_expr.as<TupleNode>()) {
+        for (auto it = tuple_node->fields.rbegin(); it != tuple_node->fields.rend(); ++it) {
+          stack.push_back(*it);
+        }
+      } else if (const auto* tuple_get_item_node = sub_expr.as<TupleGetItemNode>()) {
+        stack.push_back(tuple_get_item_node->tuple);
+      } else if (const auto* call_node = sub_expr.as<CallNode>()) {
+        OnDeviceProps props = GetOnDeviceProps(call_node);
+        if (props.body.defined()) {
+          stack.push_back(props.body);
+        } else {
+          auto it = node_index_.find(call_node);
+          if (it != node_index_.end() &&
+              std::find(producers.begin(), producers.end(), it->second) == producers.end()) {
+            producers.push_back(it->second);
+          }
+        }
+      }
+    }
+    return producers;
+  }
+
+  /*! \brief The candidate devices. */
+  const std::vector<VirtualDevice>& candidates_;
+  /*! \brief The user supplied cost of a call on a target, or nullptr. */
+  const PackedFunc* op_cost_;
+  /*! \brief The nodes in post-dfs order. */
+  std::vector<PlacementNode> nodes_;
+  /*! \brief Maps the calls of the graph to their node index. */
+  std::unordered_map<const CallNode*, size_t> node_index_;
+  /*! \brief The device type of the calls annotated by "on_device". */
+  std::unordered_map<const CallNode*, DLDeviceType> fixed_;
+};
+
+/*!
+ * \brief Returns the cost of placing \p nodes[index] on candidate \p device given the placement
+ * of its neighbours, excluding the consumers if \p with_consumers is false.
+ */
+double LocalCost(const std::vector<PlacementNode>& nodes, const std::vector<int>& placement,
+                 size_t index, int device, int default_device, bool with_consumers) {
+  const PlacementNode& node = nodes[index];
+  double cost = node.cost[device];
+  for (size_t producer : node.producers) {
+    if (placement[producer] != device) {
+      cost += nodes[producer].copy_cost;
+    }
+  }
+  if (with_consumers) {
+    for (size_t consumer : node.consumers) {
+      if (placement[consumer] != device) {
+        cost += node.copy_cost;
+      }
+    }
+  }
+  if (node.is_output && device != default_device) {
+    cost += node.copy_cost;
+  }
+  return cost;
+}
+
+/*! \brief Returns the index of the candidate chosen for every node. */
+std::vector<int> Solve(const std::vector<PlacementNode>& nodes, size_t num_candidates,
+                       int default_device) {
+  std::vector<int> placement(nodes.size(), default_device);
+  auto best_device = [&](size_t index, bool with_consumers) {
+    int best = placement[index];
+    double best_cost = LocalCost(nodes, placement, index, best, default_device, with_consumers);
+    for (int device = 0; device < static_cast<int>(num_candidates); ++device) {
+      double cost = LocalCost(nodes, placement, index, device, default_device, with_consumers);
+      // Require a strict improvement so that the sweeps terminate
+      if (cost < best_cost - 1e-12) {
+        best = device;
+        best_cost = cost;
+      }
+    }
+    return best;
+  };
+  // Greedy assignment in post-dfs order, where all producers are placed before their consumers
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    placement[i] = nodes[i].fixed != -1 ? nodes[i].fixed : best_device(i, false);
+  }
+  // Refine by moving single nodes while the total improves
+  for (int sweep = 0; sweep < kMaxSweeps; ++sweep) {
+    bool changed = false;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      if (nodes[i].fixed != -1) continue;
+      int device = best_device(i, true);
+      if (device != placement[i]) {
+        placement[i] = device;
+        changed = true;
+      }
+    }
+    if (!changed) break;
+  }
+  return placement;
+}
+
+/*! \brief Wraps the placed calls in "on_device" annotations. */
+class PlacementRewriter : public ExprMutator {
+ public:
+  explicit PlacementRewriter(std::unordered_map<const CallNode*, VirtualDevice> placement)
+      : placement_(std::move(placement)) {}
+
+ private:
+  Expr VisitExpr_(const FunctionNode* function_node) final {
+    // Local functions were not placed.
+    return GetRef<Function>(function_node);
+  }
+
+  Expr VisitExpr_(const CallNode* call_node) final {
+    Expr new_call = ExprMutator::VisitExpr_(call_node);
+    auto it = placement_.find(call_node);
+    if (it == placement_.end()) {
+      return new_call;
+    }
+    return OnDevice(new_call, it->second, /*constrain_result=*/false, /*constrain_body=*/true);
+  }
+
+  /*! \brief The device chosen for every free call. */
+  std::unordered_map<const CallNode*, VirtualDevice> placement_;
+};
+
+/*! \brief Returns \p func with its primitive calls placed on the cheapest candidates. */
+Function PlaceFunction(const Function& func, const std::vector<VirtualDevice>& candidates,
+                       int default_device, const PackedFunc* op_cost) {
+  PlacementGraphBuilder builder(candidates, op_cost);
+  std::vector<PlacementNode> nodes = builder.Build(func);
+  std::vector<int> placement = Solve(nodes, candidates.size(), default_device);
+  std::unordered_map<const CallNode*, VirtualDevice> chosen;
+  bool off_default = false;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i].fixed != -1) continue;
+    chosen.emplace(nodes[i].call, candidates[placement[i]]);
+    off_default = off_default || placement[i] != default_device;
+  }
+  if (!off_default) {
+    return func;
+  }
+  VLOG(1) << "placed " << chosen.size() << " call(s) by cost";
+  Expr body = PlacementRewriter(std::move(chosen)).Mutate(func->body);
+  return WithFields(func, func->params, body);
+}
+
+}  // namespace
+
+tvm::transform::Pass PlaceDevicesByCost(CompilationConfig config) {
+  return tvm::transform::CreateModulePass(
+      [config = std::move(config)](IRModule mod, tvm::transform::PassContext ctxt) -> IRModule {
+        if (!ctxt->GetConfig<Bool>("relay.PlanDevices.auto_placement", Bool(false)).value()) {
+          return mod;
+        }
+        // One candidate per device type, preferring the default device for its type
+        std::vector<VirtualDevice> candidates;
+        int default_device = -1;
+        for (const Target& target : config->primitive_targets) {
+          if (target.IsExternalCodegen()) continue;
+          auto device_type = static_cast<DLDeviceType>(target->GetTargetDeviceType());
+          bool seen = std::any_of(candidates.begin(), candidates.end(),
+                                  [&](const VirtualDevice& candidate) {
+                                    return candidate->device_type() == device_type;
+                                  });
+          if (seen) continue;
+          if (device_type == config->default_primitive_virtual_device->device_type()) {
+            default_device = static_cast<int>(candidates.size());
+            candidates.push_back(config->default_primitive_virtual_device);
+          } else {
+            candidates.push_back(
+                config->CanonicalVirtualDevice(VirtualDevice::ForDeviceType(device_type, 0)));
+          }
+        }
+        if (candidates.size() < 2 || default_device == -1) {
+          return mod;
+        }
+        const PackedFunc* op_cost = runtime::Registry::Get("relay.PlanDevices.op_cost");
+        mod = InferType()(mod);
+        std::vector<std::pair<GlobalVar, Function>> placed;
+        for (const auto& kv : mod->functions) {
+          const auto* func = kv.second.as<FunctionNode>();
+          if (func == nullptr || func->HasNonzeroAttr(attr::kPrimitive) ||
+              func->GetAttr<String>(attr::kCompiler).defined()) {
+            continue;
+          }
+          placed.emplace_back(
+              kv.first, PlaceFunction(GetRef<Function>(func), candidates, default_device, op_cost));
+        }
+        for (const auto& kv : placed) {
+          mod->Add(kv.first, kv.second, /*update=*/true);
+        }
+        return mod;
+      },
+      /*opt_level=*/0, "PlanDevicesPlaceByCost", {});
+}
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
@@ -0,0 +1,58 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/relay/transforms/device_placement.h
+ * \brief Cost-based placement of the primitive calls not annotated with a device, run by
+ * \p PlanDevices when the "relay.PlanDevices.auto_placement" pass config option is set.
+ */
+
+#ifndef TVM_RELAY_TRANSFORMS_DEVICE_PLACEMENT_H_
+#define TVM_RELAY_TRANSFORMS_DEVICE_PLACEMENT_H_
+
+#include <tvm/ir/transform.h>
+#include <tvm/target/compilation_config.h>
+
+namespace tvm {
+namespace relay {
+namespace transform {
+
+/*!
+ * \brief Returns a pass which, if the "relay.PlanDevices.auto_placement" pass config option is
+ * true, chooses a \p VirtualDevice for every primitive call not already constrained by an
+ * "on_device" annotation and records it with a new "on_device" annotation.
+ *
+ * The candidates are one \p VirtualDevice per device type of the primitive targets of \p config.
+ * The choice minimizes the estimated time of the calls on their devices plus the time of the
+ * copies between the devices of producers and consumers. The time of a call is taken from the
+ * "relay.PlanDevices.op_cost" global function if registered, taking the call and the \p Target of
+ * the candidate and returning the time in seconds (negative to fall back to the built-in
+ * estimate), otherwise from a roofline estimate. Calls which are known to run poorly on
+ * accelerators, such as non-maximum suppression and argwhere, are kept on the CPU.
+ *
+ * Leaves the module unchanged if there are fewer than two candidates or every call is placed on
+ * the default primitive device, in which case \p PlanDevices defaulting gives the same result.
+ */
+tvm::transform::Pass PlaceDevicesByCost(CompilationConfig config);
+
+}  // namespace transform
+}  // namespace relay
+}  // namespace tvm
+
+#endif  // TVM_RELAY_TRANSFORMS_DEVICE_PLACEMENT_H_
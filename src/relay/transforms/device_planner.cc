@@ -127,6 +127,10 @@
  * assignment of the remaining unconstrained sub-expressions as an optimiziation problem in itself.
  * This requires a formal notion of 'choicepoint' inside the compiler which can integrate with
  * automation.
+ * When the "relay.PlanDevices.auto_placement" pass config option is set, the primitive calls are
+ * instead placed before Phase 0 by estimating their cost on every primitive target and the cost of
+ * the copies between them, see device_placement.h. The result is captured by "on_device" calls,
+ * so the defaulting above only applies to what remains unconstrained.
  *
  * Phase 4
  * -------
@@ -288,6 +292,7 @@
 #include "../op/memory/device_copy.h"
 #include "../op/memory/on_device.h"
 #include "./device_domains.h"
+#include "./device_placement.h"
 
 namespace tvm {
 namespace relay {
@@ -1520,6 +1525,7 @@ tvm::transform::Pass PlanDevicesCore(CompilationConfig config) {
 // This function is declared in the public <tvm/relay/transform.h>.
 tvm::transform::Pass PlanDevices(CompilationConfig config) {
   std::vector<Pass> passes;
+  passes.emplace_back(PlaceDevicesByCost(config));
   passes.emplace_back(Rewrite());
   passes.emplace_back(Check(config));
   passes.emplace_back(InferType());
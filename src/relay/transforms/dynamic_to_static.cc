@@ -326,7 +326,8 @@ Pass DynamicToStatic() {
       [=](Function f, IRModule m, PassContext pc) {
         return Downcast<Function>(DynamicToStatic(f, m));
       };
-  return CreateFunctionPass(pass_func, 2, "DynamicToStatic", {});
+  // Updates the functions of the module while it folds them.
+  return CreateFunctionPass(pass_func, 2, "DynamicToStatic", {}, /*thread_safe=*/false);
 }
 
 TVM_REGISTER_GLOBAL("relay._transform.DynamicToStatic").set_body_typed([]() {
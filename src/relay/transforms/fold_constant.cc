@@ -20,6 +20,8 @@
 /*!
  * \file constant_folding.cc
  */
+#include <tvm/node/structural_equal.h>
+#include <tvm/node/structural_hash.h>
 #include <tvm/relay/analysis.h>
 #include <tvm/relay/attrs/annotation.h>
 #include <tvm/relay/attrs/transform.h>
@@ -32,6 +34,12 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/object.h>
 
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../op/memory/on_device.h"
 #include "./pattern_utils.h"
 
@@ -63,6 +71,177 @@ bool IsComplexConstant(const Expr& expr) {
   }
 }
 
+/*!
+ * \brief Returns whether a call to \p op with constant arguments is evaluated by the constant
+ * folder. Calls to \p shape_of and \p ndarray_size are only evaluated from the types of their
+ * arguments, and are not included.
+ */
+bool IsFoldableOp(const Op& op, bool fold_qnn) {
+  static auto op_stateful = Op::GetAttrMap<TOpIsStateful>("TOpIsStateful");
+  static auto fnoncomputational = Op::GetAttrMap<TNonComputational>("TNonComputational");
+  static auto qnn_canonicalize = Op::GetAttrMap<FTVMLegalize>("FTVMQnnCanonicalize");
+  static const Op& device_copy_op = Op::Get("device_copy");
+  static const Op& shape_of_op = Op::Get("shape_of");
+  static const Op& vm_shape_of_op = Op::Get("vm.shape_of");
+  static const Op& ndarray_size_op = Op::Get("ndarray_size");
+  if (op_stateful.get(op, false)) {
+    // skip stateful ops.
+    return false;
+  }
+  bool is_no_qnn_canonicalized = !qnn_canonicalize.count(op);
+  bool is_no_computational = fnoncomputational.count(op) && fnoncomputational[op];
+  if (is_no_computational && (is_no_qnn_canonicalized || !fold_qnn)) {
+    return false;
+  }
+  // We should think about potentially constant evaluation over these ops too.
+  return op != device_copy_op && op != shape_of_op && op != vm_shape_of_op &&
+         op != ndarray_size_op;
+}
+
+/*! \brief Returns the number of bytes of the tensors in a value or the constants of an expression */
+size_t NumBytes(const ObjectRef& value) {
+  size_t bytes = 0;
+  if (const auto* array = value.as<runtime::NDArray::Container>()) {
+    bytes = runtime::GetDataSize(array->dl_tensor);
+  } else if (auto opt = value.as<runtime::ADT>()) {
+    for (size_t i = 0; i < opt.value().size(); ++i) {
+      bytes += NumBytes(opt.value()[i]);
+    }
+  } else if (const auto* expr = value.as<RelayExprNode>()) {
+    PostOrderVisit(GetRef<Expr>(expr), [&bytes](const Expr& e) {
+      if (const auto* constant = e.as<ConstantNode>()) {
+        bytes += runtime::GetDataSize(*constant->data.operator->());
+      }
+    });
+  }
+  return bytes;
+}
+
+/*!
+ * \brief The values of the expressions evaluated by the constant folder, shared by all the runs of
+ * the pass in a process, which fold the same subexpressions when the same model is compiled again.
+ * The expressions are looked up by structural equality.
+ */
+class ConstantFoldingCache {
+ public:
+  /*! \brief The bytes of the expressions and values cached, beyond which the cache is cleared */
+  static constexpr size_t kMaxBytes = size_t(1) << 28;
+
+  static ConstantFoldingCache* Global() {
+    static ConstantFoldingCache cache;
+    return &cache;
+  }
+
+  Optional<ObjectRef> Get(const Expr& expr, size_t hash) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto range = entries_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (StructuralEqual()(it->second.first, expr)) {
+        return it->second.second;
+      }
+    }
+    return NullOpt;
+  }
+
+  void Put(const Expr& expr, size_t hash, const ObjectRef& value) {
+    size_t bytes = NumBytes(expr) + NumBytes(value);
+    if (bytes > kMaxBytes) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes_ + bytes > kMaxBytes) {
+      entries_.clear();
+      bytes_ = 0;
+    }
+    entries_.emplace(hash, std::make_pair(expr, value));
+    bytes_ += bytes;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_multimap<size_t, std::pair<Expr, ObjectRef>> entries_;
+  size_t bytes_ = 0;
+};
+
+/*!
+ * \brief Collects the maximal subgraphs of calls over constants, which the \p ConstantFolder would
+ * otherwise evaluate call by call, compiling a module for each of them. Returns the roots of the
+ * subgraphs, i.e. the foldable calls with a consumer which is not a foldable call.
+ */
+class ConstantSubgraphCollector : public MixedModeVisitor {
+ public:
+  explicit ConstantSubgraphCollector(bool fold_qnn) : fold_qnn_(fold_qnn) {}
+
+  std::vector<Call> Collect(const Expr& expr) {
+    VisitExpr(expr);
+    std::vector<Call> roots;
+    for (const Call& call : foldable_calls_) {
+      // A call visited more often than used by foldable calls has another consumer
+      if (visit_counter_[call.get()] > foldable_uses_[call.get()]) {
+        roots.push_back(call);
+      }
+    }
+    return roots;
+  }
+
+ private:
+  using MixedModeVisitor::VisitExpr_;
+
+  void VisitExpr_(const FunctionNode* function_node) final {
+    // The constant folder does not fold in primitive functions.
+    if (!function_node->HasNonzeroAttr(attr::kPrimitive)) {
+      MixedModeVisitor::VisitExpr_(function_node);
+    }
+  }
+
+  void VisitExpr_(const CallNode* call_node) final {
+    // The arguments are visited before in post order.
+    const auto* op_node = call_node->op.as<OpNode>();
+    if (call_node->args.empty() || op_node == nullptr ||
+        !IsFoldableOp(GetRef<Op>(op_node), fold_qnn_) ||
+        !std::all_of(call_node->args.begin(), call_node->args.end(),
+                     [this](const Expr& arg) { return IsFoldableArg(arg); })) {
+      return;
+    }
+    foldable_.insert(call_node);
+    foldable_calls_.push_back(GetRef<Call>(call_node));
+    for (const Expr& arg : call_node->args) {
+      CountFoldableUses(arg);
+    }
+  }
+
+  bool IsFoldableArg(const Expr& expr) {
+    Expr body = IgnoreOnDevice(expr);
+    if (body->IsInstance<ConstantNode>()) {
+      return true;
+    } else if (const auto* tuple_node = body.as<TupleNode>()) {
+      return std::all_of(tuple_node->fields.begin(), tuple_node->fields.end(),
+                         [this](const Expr& field) { return IsFoldableArg(field); });
+    } else {
+      return foldable_.count(body.get());
+    }
+  }
+
+  void CountFoldableUses(const Expr& expr) {
+    Expr body = IgnoreOnDevice(expr);
+    if (const auto* tuple_node = body.as<TupleNode>()) {
+      for (const Expr& field : tuple_node->fields) {
+        CountFoldableUses(field);
+      }
+    } else if (foldable_.count(body.get())) {
+      ++foldable_uses_[body.get()];
+    }
+  }
+
+  bool fold_qnn_;
+  /*! \brief The foldable calls. */
+  std::unordered_set<const Object*> foldable_;
+  /*! \brief The foldable calls in post order. */
+  std::vector<Call> foldable_calls_;
+  /*! \brief The number of uses of each foldable call as the argument of a foldable call. */
+  std::unordered_map<const Object*, size_t> foldable_uses_;
+};
+
 // TODO(tvm-team) consider combine dead-code with constant folder.
 // or make a more powerful partial evaluator.
 class ConstantFolder : public MixedModeMutator {
@@ -70,12 +249,20 @@ class ConstantFolder : public MixedModeMutator {
   explicit ConstantFolder(IRModule module, bool fold_qnn)
       : module_(std::move(module)),
         fold_qnn_(fold_qnn),
-        device_copy_op_(Op::Get("device_copy")),
         shape_of_op_(Op::Get("shape_of")),
         vm_shape_of_op_(Op::Get("vm.shape_of")),
         cast_op_(Op::Get("cast")),
         ndarray_size_op_(Op::Get("ndarray_size")) {}
 
+  /*!
+   * \brief Fold the constants of \p expr. The maximal subgraphs of calls over constants are
+   * evaluated together first, in one module, and the rest is folded call by call.
+   */
+  Expr Fold(const Expr& expr) {
+    EvaluateConstantSubgraphs(expr);
+    return VisitExpr(expr);
+  }
+
  private:
   using ExprMutator::VisitExpr_;
 
@@ -181,16 +368,7 @@ class ConstantFolder : public MixedModeMutator {
     if (Optional<Expr> opt_result = EvaluateNdarraySize(pre_call)) {
       return opt_result.value();
     }
-    static auto fnoncomputational = Op::GetAttrMap<TNonComputational>("TNonComputational");
-    static auto qnn_canonicalize = Op::GetAttrMap<FTVMLegalize>("FTVMQnnCanonicalize");
-    bool is_no_qnn_canonicalized = !qnn_canonicalize.count(op);
-    bool is_no_computational = fnoncomputational.count(op) && fnoncomputational[op];
-    if (is_no_computational && (is_no_qnn_canonicalized || !fold_qnn_)) {
-      return std::move(post_call);
-    }
-    if (op == device_copy_op_ || op == shape_of_op_ || op == vm_shape_of_op_ ||
-        op == ndarray_size_op_) {
-      // We should think about potentially constant evaluation over these ops too.
+    if (!IsFoldableOp(op, fold_qnn_)) {
       return std::move(post_call);
     }
     if (!std::all_of(post_call->args.begin(), post_call->args.end(), IsComplexConstant)) {
@@ -251,7 +429,57 @@ class ConstantFolder : public MixedModeMutator {
   Expr ConstEvaluate(const Expr& expr) {
     VLOG_CONTEXT << "ConstEvaluate";
     VLOG(1) << "Evaluating :" << std::endl << PrettyPrint(expr);
+    size_t hash = StructuralHash()(expr);
+    Optional<ObjectRef> value = ConstantFoldingCache::Global()->Get(expr, hash);
+    if (!value.defined()) {
+      value = Evaluate(expr);
+      ConstantFoldingCache::Global()->Put(expr, hash, value.value());
+    }
+    Expr result = ObjectToExpr(value.value());
+    VLOG(1) << "Evaluated to constant:" << std::endl << PrettyPrint(result);
+    return result;
+  }
+
+  /*!
+   * \brief Evaluate the maximal subgraphs of calls over constants in \p expr in one module, and
+   * memoize their values, so they are not folded call by call. Folds nothing if the evaluation
+   * fails, leaving the subgraphs to be folded call by call as usual.
+   */
+  void EvaluateConstantSubgraphs(const Expr& expr) {
+    std::vector<Call> roots = ConstantSubgraphCollector(fold_qnn_).Collect(expr);
+    std::vector<Call> to_evaluate;
+    std::vector<size_t> hashes;
+    for (const Call& root : roots) {
+      size_t hash = StructuralHash()(root);
+      if (Optional<ObjectRef> value = ConstantFoldingCache::Global()->Get(root, hash)) {
+        memo_[root] = ObjectToExpr(value.value());
+      } else {
+        to_evaluate.push_back(root);
+        hashes.push_back(hash);
+      }
+    }
+    if (to_evaluate.empty()) {
+      return;
+    }
+    VLOG(1) << "Evaluating " << to_evaluate.size() << " constant subgraph(s) together";
+    ObjectRef values;
+    try {
+      values = to_evaluate.size() == 1
+                   ? Evaluate(to_evaluate[0])
+                   : Evaluate(Tuple(Array<Expr>(to_evaluate.begin(), to_evaluate.end())));
+    } catch (const Error& e) {
+      VLOG(1) << "Failed to evaluate the constant subgraphs together: " << e.what();
+      return;
+    }
+    for (size_t i = 0; i < to_evaluate.size(); ++i) {
+      ObjectRef value = to_evaluate.size() == 1 ? values : Downcast<runtime::ADT>(values)[i];
+      ConstantFoldingCache::Global()->Put(to_evaluate[i], hashes[i], value);
+      memo_[to_evaluate[i]] = ObjectToExpr(value);
+    }
+  }
 
+  // Evaluate an expression on the CPU.
+  ObjectRef Evaluate(const Expr& expr) {
     // We'll invoke the interpreter using the generic CPU device and target. Technically there's
     // no guarantee the results will be bitwise equal what we'd get on the true device, however to
     // support cross-compilation we don't want to assume the true device is available.
@@ -267,10 +495,8 @@ class ConstantFolder : public MixedModeMutator {
     // always use graph executor with no link-params
     dict.Set(tvm::attr::kExecutor,
              relay::Executor::Create("graph", {{"link-params", Bool(false)}}));
-    Expr result = ObjectToExpr(Eval(expr, module_->type_definitions, module_->Imports(),
-                                    eval_cpu_dev_, eval_cpu_target_, dict));
-    VLOG(1) << "Evaluated to constant:" << std::endl << PrettyPrint(result);
-    return result;
+    return Eval(expr, module_->type_definitions, module_->Imports(), eval_cpu_dev_,
+                eval_cpu_target_, dict);
   }
 
   /*!
@@ -403,7 +629,6 @@ class ConstantFolder : public MixedModeMutator {
   Target eval_cpu_target_{"llvm"};
 
   // Cache the following ops for equivalence checking in this pass.
-  const Op& device_copy_op_;
   const Op& shape_of_op_;
   const Op& vm_shape_of_op_;
   const Op& cast_op_;
@@ -420,7 +645,7 @@ TVM_REGISTER_GLOBAL("relay.analysis.check_constant").set_body_typed(IsComplexCon
 Expr FoldConstantExpr(const Expr& expr, const IRModule& mod, bool fold_qnn) {
   VLOG_CONTEXT << "FoldConstantExpr";
   VLOG(1) << "folding:" << std::endl << PrettyPrint(expr);
-  Expr result = ConstantFolder(mod, fold_qnn).VisitExpr(expr);
+  Expr result = ConstantFolder(mod, fold_qnn).Fold(expr);
   VLOG(1) << "folded to:" << std::endl << PrettyPrint(result);
   return result;
 }
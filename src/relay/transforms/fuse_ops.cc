@@ -29,10 +29,14 @@
 #include <tvm/relay/expr_functor.h>
 #include <tvm/relay/op_attr_types.h>
 #include <tvm/relay/transform.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/op.h>
 
+#include <algorithm>
+
 #include "../../support/arena.h"
 #include "../analysis/graph_partitioner.h"
+#include "../backend/te_compiler_cache.h"
 #include "../op/annotation/annotation.h"
 #include "./pass_utils.h"
 #include "./pattern_utils.h"
@@ -83,14 +87,18 @@ using support::LinkedList;
 using support::LinkNode;
 
 constexpr uint32_t kMaxFusedOps = 256;
+/*! \brief The minimum relative time a cost-guided fusion must save. */
+constexpr double kCostGuidedMinGain = 0.1;
 
 static const Op& stop_fusion_op = Op::Get("annotation.stop_fusion");
 
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.max_depth", Integer);
 TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.link_params", Bool);
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.FuseOps.cost_guided", Bool);
 
-// Creator of post dominator tree of the dataflow
-class IndexedForwardGraphCreator : private ExprVisitor {
+// Creator of post dominator tree of the dataflow. It does not recurse along the dataflow, so the
+// inputs of a node may be visited before the node updates them.
+class IndexedForwardGraphCreator : private MixedModeVisitor {
  public:
   static IndexedForwardGraph Create(support::Arena* arena, const Expr& body) {
     IndexedForwardGraphCreator creator(arena);
@@ -113,17 +121,20 @@ class IndexedForwardGraphCreator : private ExprVisitor {
   IndexedForwardGraph graph_;
   // attribute equal comparator
   StructuralEqual attr_equal_;
-  // Update the message stored at the node.
-  void Update(const Expr& node, IndexedForwardGraph::Node* parent, OpPatternKind pattern) {
-    const tvm::Object* key = node.get();
-    IndexedForwardGraph::Node* current;
+  // Get the node of an expression, creating it on first use.
+  IndexedForwardGraph::Node* GetNode(const tvm::Object* key) {
     auto it = graph_.node_map.find(key);
     if (it != graph_.node_map.end()) {
-      current = it->second;
-    } else {
-      current = arena_->make<IndexedForwardGraph::Node>();
-      graph_.node_map[key] = current;
+      return it->second;
     }
+    IndexedForwardGraph::Node* node = arena_->make<IndexedForwardGraph::Node>();
+    graph_.node_map[key] = node;
+    return node;
+  }
+
+  // Update the message stored at the node.
+  void Update(const Expr& node, IndexedForwardGraph::Node* parent, OpPatternKind pattern) {
+    IndexedForwardGraph::Node* current = GetNode(node.get());
     if (parent != nullptr) {
       auto* link = arena_->make<LinkNode<IndexedForwardGraph::Edge>>();
       link->value.node = parent;
@@ -135,9 +146,7 @@ class IndexedForwardGraphCreator : private ExprVisitor {
   }
 
   void AddNode(const tvm::Object* key) {
-    auto it = graph_.node_map.find(key);
-    ICHECK(it != graph_.node_map.end()) << "Cannot find node " << GetRef<ObjectRef>(key);
-    IndexedForwardGraph::Node* node = it->second;
+    IndexedForwardGraph::Node* node = GetNode(key);
     ICHECK(node->ref == nullptr);
     node->ref = key;
     node->index = graph_.post_dfs_order.size();
@@ -174,8 +183,7 @@ class IndexedForwardGraphCreator : private ExprVisitor {
   }
 
   void VisitExpr_(const CallNode* call) final {
-    ICHECK(graph_.node_map.count(call));
-    IndexedForwardGraph::Node* node = graph_.node_map.at(call);
+    IndexedForwardGraph::Node* node = GetNode(call);
     static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
     // Now we set the pattern of this call.
     //
@@ -218,8 +226,7 @@ class IndexedForwardGraphCreator : private ExprVisitor {
   }
 
   void VisitExpr_(const TupleNode* op) final {
-    ICHECK(graph_.node_map.count(op));
-    IndexedForwardGraph::Node* tuple_node = graph_.node_map.at(op);
+    IndexedForwardGraph::Node* tuple_node = GetNode(op);
     tuple_node->pattern = kTuple;
     for (const Expr& field : op->fields) {
       if (field->checked_type().as<TensorTypeNode>()) {
@@ -250,8 +257,7 @@ class IndexedForwardGraphCreator : private ExprVisitor {
     if (has_non_tensor) {
       this->Update(op->tuple, nullptr, kOpaque);
     } else {
-      ICHECK(graph_.node_map.count(op));
-      IndexedForwardGraph::Node* node = graph_.node_map.at(op);
+      IndexedForwardGraph::Node* node = GetNode(op);
       node->pattern = kInjective;
       this->Update(op->tuple, node, kInjective);
     }
@@ -317,12 +323,138 @@ class IndexedForwardGraphCreator : private ExprVisitor {
   }
 };
 
+/*!
+ * \brief The roofline cost model of the cost-guided fusion. A fused function is estimated to take
+ * the larger of its flops over the peak throughput and the bytes of its inputs and outputs over the
+ * memory bandwidth, plus the overhead of a launch. The flops of each op are counted on its TIR
+ * lowered for the current target, falling back to its number of elements.
+ */
+class RooflineGroupCost {
+ public:
+  explicit RooflineGroupCost(Target target) : target_(std::move(target)) {}
+
+  double operator()(const std::vector<const Object*>& nodes) {
+    std::unordered_set<const Object*> members(nodes.begin(), nodes.end());
+    std::unordered_set<const Object*> inputs;
+    std::unordered_set<const Object*> consumed;
+    double flops = 0.0;
+    double bytes = 0.0;
+    for (const Object* node : nodes) {
+      Array<Expr> args;
+      ObjectRef ref = GetRef<ObjectRef>(node);
+      if (const auto* call = ref.as<CallNode>()) {
+        args = call->args;
+        flops += Flops(GetRef<Call>(call));
+      } else if (const auto* tuple = ref.as<TupleNode>()) {
+        args = tuple->fields;
+      } else if (const auto* tuple_get_item = ref.as<TupleGetItemNode>()) {
+        args = {tuple_get_item->tuple};
+      }
+      for (const Expr& arg : args) {
+        if (members.count(arg.get())) {
+          consumed.insert(arg.get());
+        } else if (inputs.insert(arg.get()).second) {
+          bytes += Bytes(arg->checked_type_);
+        }
+      }
+    }
+    // The nodes not consumed inside the group are its outputs
+    for (const Object* node : nodes) {
+      if (!consumed.count(node)) {
+        bytes += Bytes(static_cast<const RelayExprNode*>(node)->checked_type_);
+      }
+    }
+    return std::max(flops / kPeakFlops, bytes / kBandwidth) + kLaunchOverhead;
+  }
+
+ private:
+  /*! \brief The peak floating point operations per second. */
+  static constexpr double kPeakFlops = 1e11;
+  /*! \brief The memory bandwidth in bytes per second. */
+  static constexpr double kBandwidth = 2e10;
+  /*! \brief The overhead of launching a function in seconds. */
+  static constexpr double kLaunchOverhead = 2e-6;
+
+  static double NumElements(const Type& type) {
+    double num = 0.0;
+    if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+      num = 1.0;
+      for (const PrimExpr& dim : tensor_type->shape) {
+        const auto* extent = dim.as<IntImmNode>();
+        num *= extent != nullptr ? extent->value : 1;
+      }
+    } else if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+      for (const Type& field : tuple_type->fields) {
+        num += NumElements(field);
+      }
+    }
+    return num;
+  }
+
+  static double Bytes(const Type& type) {
+    if (const auto* tensor_type = type.as<TensorTypeNode>()) {
+      return NumElements(type) * tensor_type->dtype.bytes();
+    } else if (const auto* tuple_type = type.as<TupleTypeNode>()) {
+      double bytes = 0.0;
+      for (const Type& field : tuple_type->fields) {
+        bytes += Bytes(field);
+      }
+      return bytes;
+    }
+    return 0.0;
+  }
+
+  double Flops(const Call& call) {
+    const auto* op = call->op.as<OpNode>();
+    if (op == nullptr) return 0.0;
+    // Wrap the op in a primitive function of its own, with the same argument types
+    Array<Var> params;
+    Array<Expr> args;
+    for (const Expr& arg : call->args) {
+      Var param("p" + std::to_string(params.size()), arg->checked_type());
+      params.push_back(param);
+      args.push_back(param);
+    }
+    Function func(params, Call(call->op, args, call->attrs, call->type_args), Type(), {});
+    func = WithAttr(std::move(func), attr::kPrimitive, Integer(1));
+    auto it = flops_.find(func);
+    if (it != flops_.end()) return it->second;
+    double flops = -1.0;
+    try {
+      IRModule mod = transform::InferType()(IRModule::FromExpr(func));
+      Function typed = Downcast<Function>(mod->Lookup("main"));
+      Optional<tir::PrimFunc> prim_func =
+          tec::LowerToPrimFunc(typed, target_, NameSupply("")).first;
+      if (prim_func.defined()) {
+        flops = tir::EstimateTIRFlops(prim_func.value()->body);
+      }
+    } catch (const Error& e) {
+      DLOG(INFO) << "Cannot count the flops of " << op->name << ": " << e.what();
+    }
+    if (flops < 0.0) {
+      // A reduction does an operation per input element, others per output element
+      static auto fpattern = Op::GetAttrMap<TOpPattern>("TOpPattern");
+      bool is_reduce = fpattern.get(GetRef<Op>(op), kOpaque) == kCommReduce && !call->args.empty();
+      flops = NumElements(is_reduce ? call->args[0]->checked_type() : call->checked_type());
+    }
+    flops_.emplace(func, flops);
+    return flops;
+  }
+
+  /*! \brief The target to lower the ops for. */
+  Target target_;
+  /*! \brief The flops of each single-op function counted so far. */
+  std::unordered_map<Function, double, StructuralHash, StructuralEqual> flops_;
+};
+
 class FuseMutator : private MixedModeMutator {
  public:
-  FuseMutator(int fuse_opt_level, size_t max_fuse_depth, bool link_params)
+  FuseMutator(int fuse_opt_level, size_t max_fuse_depth, bool link_params,
+              bool cost_guided = false)
       : fuse_opt_level_(fuse_opt_level),
         max_fuse_depth_(max_fuse_depth),
-        link_params_(link_params) {}
+        link_params_(link_params),
+        cost_guided_(cost_guided) {}
 
   // Run the transform
   Expr Transform(const Expr& body) {
@@ -334,7 +466,14 @@ class FuseMutator : private MixedModeMutator {
   Expr Transform(const Expr& body, int fuse_opt_level, size_t max_fuse_depth, bool link_params) {
     // setup the group map.
     auto graph = IndexedForwardGraphCreator::Create(&arena_, body);
-    auto groups = GraphPartitioner(&arena_, fuse_opt_level, max_fuse_depth).Partition(graph);
+    FGroupCost group_cost = nullptr;
+    if (cost_guided_) {
+      Target target = Target::Current(true);
+      group_cost = RooflineGroupCost(target.defined() ? target : Target("llvm"));
+    }
+    auto groups = GraphPartitioner(&arena_, fuse_opt_level, max_fuse_depth, group_cost,
+                                   kCostGuidedMinGain)
+                      .Partition(graph);
     for (size_t nid = 0; nid < graph.post_dfs_order.size(); ++nid) {
       ICHECK(graph.post_dfs_order[nid]->ref != nullptr);
       gmap_[graph.post_dfs_order[nid]->ref] = groups[nid];
@@ -348,6 +487,7 @@ class FuseMutator : private MixedModeMutator {
   int fuse_opt_level_;
   size_t max_fuse_depth_;
   bool link_params_;
+  bool cost_guided_;
 
   using MixedModeMutator::VisitExpr_;
 
@@ -549,8 +689,8 @@ class FuseMutator : private MixedModeMutator {
 };
 
 Expr FuseOps(const Expr& expr, int fuse_opt_level, size_t max_fuse_depth, bool link_params,
-             const IRModule& module) {
-  return FuseMutator(fuse_opt_level, max_fuse_depth, link_params).Transform(expr);
+             const IRModule& module, bool cost_guided) {
+  return FuseMutator(fuse_opt_level, max_fuse_depth, link_params, cost_guided).Transform(expr);
 }
 
 namespace transform {
@@ -567,8 +707,9 @@ Pass FuseOps(int fuse_opt_level) {
         link_params = pc->GetConfig("relay.FuseOps.link_params", Bool(link_params)).value();
         int opt_level = fuse_opt_level == -1 ? pc->opt_level : fuse_opt_level;
         auto max_fuse_depth = pc->GetConfig("relay.FuseOps.max_depth", Integer(kMaxFusedOps));
-        return Downcast<Function>(
-            FuseOps(f, opt_level, max_fuse_depth.value().IntValue(), link_params, m));
+        bool cost_guided = pc->GetConfig("relay.FuseOps.cost_guided", Bool(false)).value();
+        return Downcast<Function>(FuseOps(f, opt_level, max_fuse_depth.value().IntValue(),
+                                          link_params, m, cost_guided));
       };
   return CreateFunctionPass(pass_func, 0, "FuseOps", {"InferType"});
 }
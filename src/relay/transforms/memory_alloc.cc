@@ -34,6 +34,7 @@
 #include <tvm/relay/op.h>
 #include <tvm/relay/transform.h>
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/vm/vm.h>
 #include <tvm/target/target.h>
 
 #include <cstdint>
@@ -288,6 +289,7 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     // Establish the arguments to the shape function.
     Array<Expr> shape_func_ins;
     int input_pos = 0;
+    bool is_pure = true;
     ICHECK_EQ(ins->fields.size(), input_states.size());
     for (size_t i = 0; i < ins->fields.size(); ++i) {
       const Expr& arg = ins->fields[i];
@@ -309,6 +311,7 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
           input_pos++;
         }
       } else if (state == tec::kNeedInputData) {
+        is_pure = false;
         auto new_arg = Mutate(arg);  // already accounts for device
         VirtualDevice arg_virtual_device = GetVirtualDevice(arg);
         ICHECK(!arg_virtual_device->IsFullyUnconstrained());
@@ -344,8 +347,16 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     }
 
     // Represent the call in DPS form.
-    auto shape_call = InvokeTVMOp(prim_fn_var, Tuple(shape_func_ins), Tuple(out_shapes),
-                                  Downcast<DictAttrs>(attrs.metadata.at("relay_attrs")));
+    auto relay_attrs = Downcast<DictAttrs>(attrs.metadata.at("relay_attrs"));
+    if (is_pure) {
+      // Only reading the input shapes, the shape function can be memoized by the VM.
+      Map<String, ObjectRef> dict;
+      if (relay_attrs.defined()) dict = relay_attrs->dict;
+      dict.Set(runtime::vm::kPureShapeFuncAttr, String("1"));
+      relay_attrs = DictAttrs(dict);
+    }
+    auto shape_call =
+        InvokeTVMOp(prim_fn_var, Tuple(shape_func_ins), Tuple(out_shapes), relay_attrs);
     Var shape_func_var("shape_func", Type(nullptr));
     scope->Push(shape_func_var, MaybeOnDeviceFixed(shape_call, host_virtual_device_));
     return out_shapes;
@@ -358,11 +369,22 @@ class DialectRewriter : public transform::DeviceAwareExprMutator {
     Array<Expr> out_shapes = EmitShapeFunc(scope, ins, attrs);
     std::vector<Var> storages;
     CHECK_EQ(out_shapes.size(), out_types.size());
+    // The storages of results with static upper bounds are sized for the bounds, so their sizes
+    // do not vary between invocations. The runtime checks the actual shapes fit.
+    std::vector<TensorType> upper_bound_types;
+    Optional<Type> upper_bound = Downcast<DictAttrs>(attrs.metadata.at("relay_attrs"))
+                                     .GetAttr<Type>(attr::kShapeUpperBound);
+    if (upper_bound.defined()) {
+      upper_bound_types = FlattenTupleType(upper_bound.value());
+      ICHECK_EQ(upper_bound_types.size(), out_types.size());
+    }
     for (size_t i = 0; i < out_shapes.size(); ++i) {
       auto out_shape = out_shapes[i];
       auto out_type = out_types[i];
-      auto size =
-          MaybeOnDeviceFixed(ComputeStorageInRelay(out_shape, out_type), host_virtual_device_);
+      auto size = MaybeOnDeviceFixed(upper_bound.defined()
+                                         ? ComputeStorage(upper_bound_types[i])
+                                         : ComputeStorageInRelay(out_shape, out_type),
+                                     host_virtual_device_);
       // Alignment is directly captured in the instruction so don't wrap in "on_device".
       auto alignment = ComputeAlignment(out_type->dtype);
       Var sto_var("storage_" + std::to_string(i), Type(nullptr));
@@ -69,7 +69,8 @@ Pass MergeComposite(const tvm::Array<runtime::String>& pattern_names,
         return Downcast<Function>(
             relay::merge_composite::MergeComposite(f, pattern_names, patterns, checks, m));
       };
-  auto func_pass = CreateFunctionPass(pass_func, 0, "MergeComposite", {});
+  // Type inference updates the main function of the module, and the checks may call python.
+  auto func_pass = CreateFunctionPass(pass_func, 0, "MergeComposite", {}, /*thread_safe=*/false);
   return func_pass;
 }
 
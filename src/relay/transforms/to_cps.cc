@@ -352,7 +352,8 @@ namespace transform {
 Pass ToCPS() {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) { return Function(ToCPS(f, m)); };
-  return CreateFunctionPass(pass_func, 1, "ToCPS", {});
+  // Adds the CPS versions of the global functions to the module.
+  return CreateFunctionPass(pass_func, 1, "ToCPS", {}, /*thread_safe=*/false);
 }
 
 TVM_REGISTER_GLOBAL("relay._transform.ToCPS").set_body_typed(ToCPS);
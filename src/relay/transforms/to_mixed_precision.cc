@@ -68,6 +68,25 @@ using CachedCastNodes = std::unordered_map<std::pair<const ExprNode*, DataType>,
 using FTVMMixedPrecisionConversionType = runtime::TypedPackedFunc<Array<ObjectRef>(
     const Call& call_node, const std::string& target_dtype_str)>;
 
+/*! \brief Whether the dtype is one of the FP8 types. */
+inline bool IsFP8Type(const DataType& dtype) {
+  return dtype.code() == DataType::kE4M3Float || dtype.code() == DataType::kE5M2Float;
+}
+
+/*! \brief Whether a call with args of the given types can run in FP8 with scaled args, which
+ * holds for the bilinear ops, e.g. conv and dense, that have two floating point tensor args.
+ */
+inline bool IsFP8Convertible(const Array<Type>& arg_types) {
+  if (arg_types.size() != 2) return false;
+  for (const Type& type : arg_types) {
+    const auto* tensor_type = type.as<TensorTypeNode>();
+    if (!tensor_type || !(tensor_type->dtype.is_float() || tensor_type->dtype.is_bfloat16())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /*! \brief This class transforms the given relay module into a version where
  * as many operations as possible operate in the target mixed precision dtype.
  *
@@ -93,6 +112,12 @@ using FTVMMixedPrecisionConversionType = runtime::TypedPackedFunc<Array<ObjectRe
  *         describe whether a larger dtype is used to accumulate the results
  *         of the operation. The output_dtype meanwhile describes the dtype
  *         most Ops should use from this accumulator.
+ *      4) For the FP8 dtypes, only ALWAYS Ops with two floating point tensor
+ *         args, e.g. conv and dense, are converted, and everything else is
+ *         NEVER. Each arg is divided by a per-tensor scale, amax / max_fp8,
+ *         before the cast to FP8, and the FP32 result is multiplied back by
+ *         the product of the scales. The amax values come from calibration in
+ *         the order of FP8CalibrationTaps, or are computed at runtime.
  */
 class MixedPrecisionPass : public MixedModeMutator {
  private:
@@ -109,6 +134,10 @@ class MixedPrecisionPass : public MixedModeMutator {
   const RelayExprNode* root_;
   std::vector<DataType> original_dtype_;
   bool keep_orig_output_dtype_;
+  /*! \brief The calibrated amax of the FP8 args, in the order they are converted. */
+  Array<FloatImm> fp8_amax_;
+  /*! \brief The number of FP8 args converted so far. */
+  size_t num_fp8_args_ = 0;
 
   Attrs GetNewAttrs(const CallNode* call, const DataType& accumulation_dtype) const {
     /* If the accumulation dtype is in the attributes make a copy and mutate the field. */
@@ -282,15 +311,63 @@ class MixedPrecisionPass : public MixedModeMutator {
     return {new_args, new_arg_types};
   }
 
+  bool IsFP8() const { return IsFP8Type(mixed_precision_type_); }
+
+  /*! \brief Scale a floating point tensor into the range of the FP8 type and cast it to FP8.
+   * \return The FP8 tensor and its FP32 scalar scale.
+   */
+  std::pair<Expr, Expr> ScaledCastFP8(const Expr& expr, const Type& expr_type) {
+    const DataType f32 = DataType::Float(32);
+    const double fp8_max = mixed_precision_type_.code() == DataType::kE4M3Float ? 448.0 : 57344.0;
+    Expr value = CastArg(expr, expr_type, f32);
+    Expr amax;
+    if (num_fp8_args_ < fp8_amax_.size()) {
+      amax = MakeConstantScalar(f32, fp8_amax_[num_fp8_args_]->value);
+    } else {
+      // Without calibration, use the amax of the tensor itself, folded for constants.
+      amax = Max(Abs(value), {}, false, false);
+    }
+    ++num_fp8_args_;
+    // Guard against all-zero tensors.
+    Expr scale = Divide(Maximum(amax, MakeConstantScalar(f32, 1e-12)),
+                        MakeConstantScalar(f32, fp8_max));
+    Expr scaled = Cast(Clip(Divide(value, scale), -fp8_max, fp8_max), mixed_precision_type_);
+    return {scaled, scale};
+  }
+
+  Expr RewriteFP8(const CallNode* pre_call_node, const CallNode* post_call_node,
+                  const Array<Type>& cur_arg_types) {
+    Array<Expr> new_args;
+    Array<Type> new_arg_types;
+    Expr scale;
+    for (size_t i = 0; i < post_call_node->args.size(); ++i) {
+      auto [scaled, arg_scale] = ScaledCastFP8(post_call_node->args[i], cur_arg_types[i]);
+      new_args.push_back(scaled);
+      new_arg_types.push_back(GetType(scaled));
+      scale = scale.defined() ? Multiply(scale, arg_scale) : arg_scale;
+    }
+    // FP8 products are always accumulated in FP32.
+    Attrs new_attrs = GetNewAttrs(pre_call_node, DataType::Float(32));
+    Expr output =
+        Call(post_call_node->op, new_args, new_attrs, new_arg_types, pre_call_node->span);
+    output = Multiply(CastArg(output, GetType(output), DataType::Float(32)), scale);
+    if (pre_call_node == root_ && keep_orig_output_dtype_) {
+      output = CastArg(output, GetType(output), original_dtype_[0]);
+    }
+    return output;
+  }
+
  public:
   using MixedModeMutator::VisitExpr_;
 
   explicit MixedPrecisionPass(Expr base, bool keep_orig_output_dtype,
-                              DataType mixed_precision_type = DataType::Float(16))
+                              DataType mixed_precision_type = DataType::Float(16),
+                              Array<FloatImm> fp8_amax = {})
       : MixedModeMutator(),
         mixed_precision_type_(mixed_precision_type),
         root_(Downcast<Function>(base)->body.get()),
-        keep_orig_output_dtype_(keep_orig_output_dtype) {
+        keep_orig_output_dtype_(keep_orig_output_dtype),
+        fp8_amax_(std::move(fp8_amax)) {
     if (keep_orig_output_dtype_) {
       if (root_->IsInstance<tvm::relay::TupleNode>()) {
         const TupleTypeNode* tuple_type = (root_->checked_type_).as<TupleTypeNode>();
@@ -302,9 +379,9 @@ class MixedPrecisionPass : public MixedModeMutator {
         original_dtype_.push_back((root_->checked_type_).as<TensorTypeNode>()->dtype);
       }
     }
-    if (!(mixed_precision_type_.is_float() || mixed_precision_type_.is_bfloat16())) {
-      LOG(FATAL) << "Only support IEEE floating point mixed precision types and bfloat16, but got "
-                 << mixed_precision_type_;
+    if (!(mixed_precision_type_.is_float() || mixed_precision_type_.is_bfloat16() || IsFP8())) {
+      LOG(FATAL) << "Only support IEEE floating point mixed precision types, bfloat16 and float8, "
+                 << "but got " << mixed_precision_type_;
     }
   }
 
@@ -375,6 +452,13 @@ class MixedPrecisionPass : public MixedModeMutator {
       }
     }
 
+    if (IsFP8()) {
+      if (initial_category == MIXED_PRECISION_ALWAYS && IsFP8Convertible(cur_arg_types)) {
+        return RewriteFP8(pre_call_node, post_call_node, cur_arg_types);
+      }
+      initial_category = MIXED_PRECISION_NEVER;
+    }
+
     // Determine the final category we want for conversion
     MixedTypeConversionCategory final_category = initial_category;
     if (initial_category == MIXED_PRECISION_FOLLOW) {
@@ -443,7 +527,9 @@ class MixedPrecisionPass : public MixedModeMutator {
 
   Expr VisitExpr_(const FunctionNode* func) final {
     // Erase the ret_type annotation and let the normal pass recalculate
-    const_cast<FunctionNode*>(func)->ret_type = Type(nullptr);
+    FunctionNode* mutable_func = const_cast<FunctionNode*>(func);
+    mutable_func->ret_type = Type(nullptr);
+    mutable_func->structural_hash_cache.Reset();
     return ExprMutator::VisitExpr_(func);
   }
 
@@ -464,11 +550,34 @@ class MixedPrecisionPass : public MixedModeMutator {
 
   // To access map of ops not registered for error reporting
   friend Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
-                               const DataType& mixed_precision_type, int missing_op_mode);
+                               const DataType& mixed_precision_type, int missing_op_mode,
+                               const Array<FloatImm>& fp8_amax);
 };
 
+Array<Expr> FP8CalibrationTaps(const Function& func, const DataType& fp8_type) {
+  ICHECK(IsFP8Type(fp8_type)) << "Expected a float8 type, but got " << fp8_type;
+  static auto attr_map =
+      Op::GetAttrMap<FTVMMixedPrecisionConversionType>("FTVMMixedPrecisionConversionType");
+  Array<Expr> taps;
+  PostOrderVisit(func->body, [&](const Expr& expr) {
+    const auto* call = expr.as<CallNode>();
+    if (!call || !call->op.as<OpNode>() || !attr_map.count(Downcast<Op>(call->op))) return;
+    Array<ObjectRef> op_descriptor =
+        attr_map[Downcast<Op>(call->op)](GetRef<Call>(call), DLDataType2String(fp8_type));
+    if (Downcast<Integer>(op_descriptor[0])->value != MIXED_PRECISION_ALWAYS) return;
+    Array<Type> arg_types;
+    for (const Expr& arg : call->args) arg_types.push_back(arg->checked_type());
+    if (!IsFP8Convertible(arg_types)) return;
+    for (const Expr& arg : call->args) taps.push_back(arg);
+  });
+  return taps;
+}
+
+TVM_REGISTER_GLOBAL("relay._transform.FP8CalibrationTaps").set_body_typed(FP8CalibrationTaps);
+
 Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
-                      const DataType& mixed_precision_type, int missing_op_mode) {
+                      const DataType& mixed_precision_type, int missing_op_mode,
+                      const Array<FloatImm>& fp8_amax) {
   /*
   missing_op_mode:
 
@@ -480,8 +589,12 @@ Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
       << " missing_op_mode must be either 0, 1, or 2 got " << missing_op_mode;
 
   MixedPrecisionPass converter =
-      MixedPrecisionPass(expr, keep_orig_output_dtype, mixed_precision_type);
+      MixedPrecisionPass(expr, keep_orig_output_dtype, mixed_precision_type, fp8_amax);
   auto result = converter.Mutate(expr);
+  if (!fp8_amax.empty() && fp8_amax.size() != converter.num_fp8_args_) {
+    LOG(WARNING) << "Got " << fp8_amax.size() << " calibrated amax values for "
+                 << converter.num_fp8_args_ << " FP8 args";
+  }
 
   for (auto it = converter.missing_ops_.begin();
        missing_op_mode != 2 && it != converter.missing_ops_.end(); it++) {
@@ -501,15 +614,16 @@ Expr ToMixedPrecision(const Expr& expr, bool keep_orig_output_dtype,
 
 namespace transform {
 
-Pass ToMixedPrecision(DataType mixed_precision_type, int missing_op_mode) {
+Pass ToMixedPrecision(DataType mixed_precision_type, int missing_op_mode,
+                      Array<FloatImm> fp8_amax) {
   runtime::TypedPackedFunc<Function(Function, IRModule, PassContext)> pass_func =
       [=](Function f, IRModule m, PassContext pc) {
         bool keep_orig_output_dtype = false;
         keep_orig_output_dtype = pc->GetConfig("relay.ToMixedPrecision.keep_orig_output_dtype",
                                                Bool(keep_orig_output_dtype))
                                      .value();
-        return Downcast<Function>(
-            ToMixedPrecision(f, keep_orig_output_dtype, mixed_precision_type, missing_op_mode));
+        return Downcast<Function>(ToMixedPrecision(f, keep_orig_output_dtype, mixed_precision_type,
+                                                   missing_op_mode, fp8_amax));
       };
   return CreateFunctionPass(pass_func, 0, "ToMixedPrecision", {});
 }
@@ -46,6 +46,13 @@
 #include <tvm/relay/pattern_functor.h>
 #include <tvm/relay/transform.h>
 
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 #include "../analysis/type_solver.h"
 #include "pass_utils.h"
 
@@ -761,6 +768,7 @@ class TypeInferencer::Resolver : public MixedModeMutator, PatternMutator {
       auto* fn_type = checked_type.as<FuncTypeNode>();
       ICHECK(fn_type != nullptr);
       new_fn->ret_type = fn_type->ret_type;
+      new_fn->structural_hash_cache.Reset();
     }
     return new_e;
   }
@@ -921,8 +929,135 @@ class SameTypedSubgraphExtractor : public ExprMutator {
   }
 };
 
+/*!
+ * \brief Remembers the functions InferType produced, so that the functions a pass left untouched
+ * are not inferred again.
+ *
+ * Relay functions are immutable, hence a function of the module that is the very object a
+ * previous InferType returned is clean: it only needs inferring again if a global it calls is
+ * dirty. Each entry keeps the typed function with the functions of the globals it called, and
+ * the least recently used entries are dropped past a fixed capacity.
+ */
+class InferTypeCache {
+ public:
+  static InferTypeCache* Global() {
+    static InferTypeCache* inst = new InferTypeCache();
+    return inst;
+  }
+
+  /*!
+   * \brief Returns the Relay functions of the module that need not be inferred again.
+   * \param mod The module before AddGlobalTypes.
+   */
+  std::unordered_set<const GlobalVarNode*> CleanFunctions(const IRModule& mod) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Step 1. The candidates are the functions typed by a previous InferType.
+    std::unordered_map<const GlobalVarNode*, const Entry*> candidates;
+    for (const auto& it : mod->functions) {
+      auto entry = entries_.find(it.first.get());
+      if (entry != entries_.end() && entry->second->typed.same_as(it.second)) {
+        candidates[it.first.get()] = &*entry->second;
+        entries_list_.splice(entries_list_.begin(), entries_list_, entry->second);
+      }
+    }
+    // Step 2. Drop the candidates calling a global whose function changed or is not clean,
+    // until none is dropped.
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (auto it = candidates.begin(); it != candidates.end();) {
+        bool clean = true;
+        for (const auto& callee : it->second->callees) {
+          auto func = mod->functions.find(callee.first);
+          bool callee_dirty =
+              callee.second->IsInstance<FunctionNode>() && !candidates.count(callee.first.get());
+          if (func == mod->functions.end() || !(*func).second.same_as(callee.second) ||
+              callee_dirty) {
+            clean = false;
+            break;
+          }
+        }
+        if (clean) {
+          ++it;
+        } else {
+          it = candidates.erase(it);
+          changed = true;
+        }
+      }
+    }
+    std::unordered_set<const GlobalVarNode*> result;
+    for (const auto& kv : candidates) {
+      result.insert(kv.first);
+    }
+    return result;
+  }
+
+  /*!
+   * \brief Records the typed functions of the module returned by InferType.
+   * \param mod The module returned by InferType.
+   * \param gvars The globals of the functions just inferred.
+   */
+  void Update(const IRModule& mod, const std::vector<GlobalVar>& gvars) {
+    std::vector<Entry> new_entries;
+    for (const GlobalVar& gvar : gvars) {
+      Function func = Downcast<Function>(mod->Lookup(gvar));
+      Entry entry{gvar, func, {}};
+      bool uses_adt = false;
+      std::unordered_set<const GlobalVarNode*> visited;
+      PostOrderVisit(func, [&](const Expr& e) {
+        if (const auto* callee = e.as<GlobalVarNode>()) {
+          GlobalVar callee_gvar = GetRef<GlobalVar>(callee);
+          auto callee_func = mod->functions.find(callee_gvar);
+          if (visited.insert(callee).second && callee_func != mod->functions.end()) {
+            entry.callees.emplace_back(callee_gvar, (*callee_func).second);
+          }
+        } else if (e->IsInstance<ConstructorNode>() || e->IsInstance<MatchNode>()) {
+          uses_adt = true;
+        }
+      });
+      // The type definitions of the module may change under the constructors, so such functions
+      // are always inferred again.
+      if (!uses_adt) {
+        new_entries.push_back(std::move(entry));
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Entry& entry : new_entries) {
+      const GlobalVarNode* key = entry.gvar.get();
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        entries_list_.erase(it->second);
+      }
+      entries_list_.push_front(std::move(entry));
+      entries_[key] = entries_list_.begin();
+      if (entries_list_.size() > kCapacity) {
+        entries_.erase(entries_list_.back().gvar.get());
+        entries_list_.pop_back();
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    /*! \brief The global, held so that its address is not reused. */
+    GlobalVar gvar;
+    /*! \brief The function returned by InferType. */
+    Function typed;
+    /*! \brief The globals called by the function, with their functions when it was inferred. */
+    std::vector<std::pair<GlobalVar, BaseFunc>> callees;
+  };
+
+  static constexpr size_t kCapacity = 4096;
+
+  std::mutex mutex_;
+  std::list<Entry> entries_list_;
+  std::unordered_map<const GlobalVarNode*, std::list<Entry>::iterator> entries_;
+};
+
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("relay.InferType.incremental", Bool);
+
 Type InferTypeLocal(const Expr& expr) {
   /*
   This type inference differs from InferType in that it uses existing type information
@@ -958,10 +1093,19 @@ Pass InferType() {
 
         pass_ctx->diag_ctx = DiagnosticContext::Default(updated_mod);
 
+        // Find the functions left untouched since a previous InferType typed them.
+        bool incremental =
+            pass_ctx->GetConfig<Bool>("relay.InferType.incremental", Bool(true)).value();
+        std::unordered_set<const GlobalVarNode*> clean;
+        if (incremental) {
+          clean = InferTypeCache::Global()->CleanFunctions(updated_mod);
+        }
+
         // Add all the type annotations to the functions in the model.
         AddGlobalTypes(mod);
 
         std::vector<std::pair<GlobalVar, Function>> updates;
+        std::vector<GlobalVar> inferred;
         for (const auto& it : updated_mod->functions) {
           // Currently we don't type check TIR.
           //
@@ -970,10 +1114,11 @@ Pass InferType() {
           // In the future we plan a unified type checker
           // that works on TIR and Relay at the same time.
           if (auto func = it.second.as<Function>()) {
-            // // If a function already has type information we can skip checking it.
-            // if (func->checked_type_.defined()) {
-            //   continue;
-            // }
+            // A clean function keeps its types, the global only gets its type back.
+            if (clean.count(it.first.get())) {
+              it.first->checked_type_ = func.value()->checked_type();
+              continue;
+            }
 
             // TODO(@jroesch): we should be able to move the type inferencer outside
             // of this function but it seems to be more stateful then I expect.
@@ -995,6 +1140,7 @@ Pass InferType() {
                 << "Found unbound type variables in " << updated_func << ": " << free_tvars;
             EnsureCheckedType(updated_func);
             updates.push_back({it.first, Downcast<Function>(updated_func)});
+            inferred.push_back(it.first);
           }
         }
 
@@ -1002,6 +1148,10 @@ Pass InferType() {
           updated_mod->Add(pair.first, pair.second, true);
         }
 
+        if (incremental) {
+          InferTypeCache::Global()->Update(updated_mod, inferred);
+        }
+
         return updated_mod;
       },
       0, "InferType", {});
@@ -25,24 +25,33 @@
 
 #include "aot_executor.h"
 
+#include <dmlc/memory_io.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/name_transforms.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <limits>
 #include <memory>
 
+#include "../file_utils.h"
 #include "../meta_data.h"
 
 namespace tvm {
 namespace runtime {
 
-AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs)
+AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs,
+                         const AotExecutor* base)
     : module_{module}, devices_{devs} {
-  auto fmetadata = module->GetFunction("get_metadata");
-  CHECK(fmetadata != nullptr) << "Expected a module with PackedFunc get_metadata";
-  auto ret_value = fmetadata();
-  metadata_ = ret_value.AsObjectRef<tvm::runtime::metadata::Metadata>();
+  if (base != nullptr) {
+    metadata_ = base->metadata_;
+    thread_pool_ = base->thread_pool_;
+  } else {
+    auto fmetadata = module->GetFunction("get_metadata");
+    CHECK(fmetadata != nullptr) << "Expected a module with PackedFunc get_metadata";
+    auto ret_value = fmetadata();
+    metadata_ = ret_value.AsObjectRef<tvm::runtime::metadata::Metadata>();
+  }
 
   ICHECK_EQ(devices_.size(), 1) << "Expect exactly 1 device passed.";
   DLDevice expected_device{kDLCPU, 0};
@@ -55,6 +64,11 @@ AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>&
       << "At this time, AOTExecutor supports only execution on kDLCPU 0 or kDLHexagon 0";
 
   for (auto input : metadata_->inputs()) {
+    size_t index = args_.size();
+    if (base != nullptr && base->is_shared_arg_[index]) {
+      args_.push_back(base->args_[index]);
+      continue;
+    }
     // TODO(areusch): Encode device information in Metadata.
     args_.emplace_back(NDArray::Empty(ShapeTuple(input->shape().begin(), input->shape().end()),
                                       input->dtype(), devices_[0]));
@@ -67,22 +81,27 @@ AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>&
 
   // USMP is used
   if (metadata_->num_workspace_pools()) {
-    // merge all constants into one ndarray
-    int64_t blob_len = 0;
-    for (const auto& c : metadata_->constant_pools()) {
-      auto data = c->data();
-      int64_t byte_size = GetDataSize(*data.operator->()) + c->byte_offset();
-      blob_len = blob_len > byte_size ? blob_len : byte_size;
-    }
-    ICHECK(blob_len < std::numeric_limits<int32_t>::max());
-    NDArray ci = NDArray::Empty({blob_len}, DataType::UInt(8), devices_[0]);
-    for (const auto& c : metadata_->constant_pools()) {
-      auto data = c->data();
-      data.CopyToBytes(static_cast<uint8_t*>(ci->data) + c->byte_offset(),
-                       GetDataSize(*data.operator->()));
+    if (base != nullptr) {
+      // Share the constant pool, the contexts only own their workspace pools.
+      args_.push_back(base->args_[args_.size()]);
+    } else {
+      // merge all constants into one ndarray
+      int64_t blob_len = 0;
+      for (const auto& c : metadata_->constant_pools()) {
+        auto data = c->data();
+        int64_t byte_size = GetDataSize(*data.operator->()) + c->byte_offset();
+        blob_len = blob_len > byte_size ? blob_len : byte_size;
+      }
+      ICHECK(blob_len < std::numeric_limits<int32_t>::max());
+      NDArray ci = NDArray::Empty({blob_len}, DataType::UInt(8), devices_[0]);
+      for (const auto& c : metadata_->constant_pools()) {
+        auto data = c->data();
+        data.CopyToBytes(static_cast<uint8_t*>(ci->data) + c->byte_offset(),
+                         GetDataSize(*data.operator->()));
+      }
+      // Emplace constant node pool only if workspace pools supplied
+      args_.emplace_back(ci);
     }
-    // Emplace constant node pool only if workspace pools supplied
-    args_.emplace_back(ci);
 
     int32_t pool_len = 0;
     for (auto pool : metadata_->workspace_pools()) {
@@ -91,6 +110,19 @@ AotExecutor::AotExecutor(tvm::runtime::Module module, const std::vector<Device>&
       args_.emplace_back(NDArray::Empty({pool_len}, DataType::UInt(8), devices_[0]));
     }
   }
+
+  if (base != nullptr) {
+    is_shared_arg_ = base->is_shared_arg_;
+  } else {
+    is_shared_arg_.assign(args_.size(), false);
+    if (metadata_->num_workspace_pools()) {
+      is_shared_arg_[metadata_->num_inputs() + metadata_->num_outputs()] = true;
+    }
+  }
+}
+
+Module AotExecutor::CreateContext() const {
+  return Module(make_object<AotExecutor>(module_, devices_, this));
 }
 
 PackedFunc AotExecutor::GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) {
@@ -122,6 +154,17 @@ PackedFunc AotExecutor::GetFunction(const String& name, const ObjectPtr<Object>&
         this->SetOutputZeroCopy(args[0], args[1]);
       }
     });
+  } else if (name == "load_params") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::string blob = args[0].operator std::string();
+      dmlc::MemoryStringStream strm(&blob);
+      this->LoadParams(&strm);
+    });
+  } else if (name == "load_params_from_file") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      SimpleBinaryFileStream strm(args[0].operator std::string(), "rb");
+      this->LoadParams(&strm);
+    });
   } else if (name == "get_output") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       if (args.num_args == 2) {
@@ -150,6 +193,32 @@ PackedFunc AotExecutor::GetFunction(const String& name, const ObjectPtr<Object>&
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
   } else if (name == "run") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "warmup") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Warmup(); });
+  } else if (name == "run_async") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      CHECK(args.size() % 2 == 1)
+          << "The arguments of run_async are a callback and key-value pairs of inputs";
+      std::vector<std::pair<int, NDArray>> inputs;
+      for (int i = 1; i < args.size(); i += 2) {
+        std::string name = args[i].operator String();
+        int in_idx = this->GetInputIndex(tvm::runtime::SanitizeName(name));
+        CHECK_GE(in_idx, 0) << "Cannot find input " << name;
+        inputs.emplace_back(in_idx, args[i + 1].operator NDArray());
+      }
+      auto run = [sptr_to_self, this, inputs = std::move(inputs)]() -> ObjectRef {
+        for (const auto& kv : inputs) {
+          this->SetInput(kv.first, const_cast<DLTensor*>(kv.second.operator->()));
+        }
+        this->Run();
+        Array<NDArray> outputs;
+        for (int i = 0; i < this->NumOutputs(); ++i) {
+          outputs.push_back(CopyOnCurrentStream(this->GetOutput(i)));
+        }
+        return outputs;
+      };
+      async_queue_->Submit(devices_[0], std::move(run), args[0]);
+    });
   } else if (name == "get_input_index") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
@@ -158,15 +227,36 @@ PackedFunc AotExecutor::GetFunction(const String& name, const ObjectPtr<Object>&
   } else if (name == "get_input_name") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetInputName(args[0]); });
+  } else if (name == "create_context") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->CreateContext(); });
+  } else if (name == "set_thread_pool") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->thread_pool_ = args[0].operator std::string();
+    });
+  } else if (name == "set_sampling_interval") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->sampler_.SetInterval(args[0].operator int64_t());
+    });
+  } else if (name == "get_sampled_profile") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->sampler_.Report(); });
   } else {
     return PackedFunc();
   }
 }
 
+void AotExecutor::Warmup() {
+  for (const Device& dev : devices_) {
+    PreloadModule(module_, dev);
+  }
+}
+
 void AotExecutor::Run() {
-  auto pf = module_.GetFunction(
-      get_name_mangled(metadata_->mod_name(), ::tvm::runtime::symbol::tvm_module_main),
-      true /* query_imports */);
+  threading::ThreadPoolScope thread_pool_scope(thread_pool_);
+  std::string main_name =
+      get_name_mangled(metadata_->mod_name(), ::tvm::runtime::symbol::tvm_module_main);
+  auto pf = module_.GetFunction(main_name, true /* query_imports */);
   ICHECK(pf != nullptr) << "Module entrypoint is not defined";
 
   const int num_args = args_.size();
@@ -180,7 +270,10 @@ void AotExecutor::Run() {
 
   TVMArgs args{call_values.get(), call_type_codes.get(), num_args};
   TVMRetValue rv;
+  bool sampled = sampler_.BeginRequest();
+  if (sampled) sampler_.StartOp(0, main_name, devices_[0]);
   pf.CallPacked(args, &rv);
+  if (sampled) sampler_.StopOp();
 }
 
 int AotExecutor::GetInputIndex(const std::string& name) {
@@ -210,6 +303,20 @@ int AotExecutor::GetOutputIndex(const std::string& name) {
 
 void AotExecutor::SetInput(int index, DLTensor* data_ref) { args_[index].CopyFrom(data_ref); }
 
+void AotExecutor::LoadParams(dmlc::Stream* strm) {
+  auto inputs = metadata_->inputs();
+  StreamParams(strm, [&](const std::string& name, const std::vector<int64_t>& shape,
+                         DLDataType dtype) -> NDArray {
+    for (unsigned int i = 0; i < inputs.size(); i++) {
+      if (inputs[i]->name() == name) {
+        is_shared_arg_[i] = true;
+        return args_[i];
+      }
+    }
+    return NDArray();
+  });
+}
+
 void AotExecutor::SetInputZeroCopy(int index, DLTensor* data_ref) {
   ICHECK(false) << "not implemented";
 }
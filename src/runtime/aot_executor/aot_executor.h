@@ -25,14 +25,19 @@
 #ifndef TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_H_
 #define TVM_RUNTIME_AOT_EXECUTOR_AOT_EXECUTOR_H_
 
+#include <dmlc/io.h>
 #include <tvm/runtime/metadata.h>
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/profiling.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "../async_run.h"
+
 namespace tvm {
 namespace runtime {
 
@@ -56,14 +61,36 @@ class TVM_DLL AotExecutor : public ModuleNode {
 
   void Run();
 
+  /*!
+   * \brief Do the lazy initialization of the kernels for the devices of the executor, e.g.
+   *  loading the device modules, without running the model, so that the first run is not slowed
+   *  down by it.
+   */
+  void Warmup();
+
   /*!
    * \brief Initialize the AOT executor with metadata, runtime::Module, and device.
    * \param module The module containing the compiled functions for the host
    *  processor.
    * \param devs A 1-element vector. The Device which AOT compute will run on. Currently, only
    *  Device(kDLCPU, 0) is supported.
+   * \param base The executor to share the metadata, the constant pool and the loaded parameters
+   *  of, when creating one of its execution contexts.
+   */
+  AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs,
+              const AotExecutor* base = nullptr);
+
+  /*!
+   * \brief Create an execution context of this executor.
+   *
+   *  The context shares the code, the metadata, the constant pool and the parameters loaded by
+   *  LoadParams with this executor, and only owns its other inputs, its outputs and its
+   *  workspace pools. The contexts of one executor thus run concurrently, e.g. one per thread,
+   *  without duplicating the constants. Setting a shared parameter sets it in all of them.
+   *
+   * \return The context, an AotExecutor module.
    */
-  AotExecutor(tvm::runtime::Module module, const std::vector<Device>& devs);
+  Module CreateContext() const;
 
   /*!
    * \brief Get the input index given the name of input.
@@ -92,6 +119,12 @@ class TVM_DLL AotExecutor : public ModuleNode {
    * \param data_in The input data.
    */
   void SetInput(int index, DLTensor* data_in);
+
+  /*!
+   * \brief Load parameters into the inputs named by them, streaming them tensor by tensor.
+   * \param strm The parameters, in the format written by SaveParams.
+   */
+  void LoadParams(dmlc::Stream* strm);
   /*!
    * \brief set index-th input to the graph without copying the data
    * \param index The input index.
@@ -149,6 +182,18 @@ class TVM_DLL AotExecutor : public ModuleNode {
 
   /*! \brief Holds one NDArray per function argument in the same order. */
   std::vector<NDArray> args_;
+
+  /*! \brief Whether each argument is shared with the execution contexts of the executor. */
+  std::vector<bool> is_shared_arg_;
+
+  /*! \brief The named thread pool the model runs on, empty for the default pool. */
+  std::string thread_pool_;
+
+  /*! \brief Times every Nth run, the operators are inlined in the entrypoint. */
+  profiling::SamplingProfiler sampler_{"AOT"};
+
+  /*! \brief Serializes the asynchronous runs. */
+  std::shared_ptr<AsyncRunQueue> async_queue_{std::make_shared<AsyncRunQueue>()};
 };
 
 }  // namespace runtime
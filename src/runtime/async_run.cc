@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file async_run.cc
+ * \brief Asynchronous runs of the executors, completed through a callback.
+ */
+#include "async_run.h"
+
+#include <tvm/runtime/logging.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+
+/*! \brief The host threads executing the asynchronous runs. */
+class AsyncRunPool {
+ public:
+  static AsyncRunPool* Global() {
+    // Leaked on purpose: the detached threads may still use it while the process exits.
+    static AsyncRunPool* pool = new AsyncRunPool();
+    return pool;
+  }
+
+  void Enqueue(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  AsyncRunPool() {
+    int num_threads = 2;
+    if (const char* val = getenv("TVM_NUM_ASYNC_RUN_THREADS")) {
+      num_threads = std::max(atoi(val), 1);
+    }
+    for (int i = 0; i < num_threads; ++i) {
+      std::thread([this]() { this->WorkerMain(); }).detach();
+    }
+  }
+
+  void WorkerMain() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+};
+
+/*! \return The stream of the calling pool thread on an accelerator, created on first use. */
+TVMStreamHandle WorkerStream(Device dev) {
+  // The streams live as long as the pool threads, i.e. the process.
+  thread_local std::map<std::pair<int, int>, TVMStreamHandle> streams;
+  auto key = std::make_pair(static_cast<int>(dev.device_type), dev.device_id);
+  auto it = streams.find(key);
+  if (it == streams.end()) {
+    it = streams.emplace(key, DeviceAPI::Get(dev)->CreateStream(dev)).first;
+  }
+  return it->second;
+}
+
+}  // namespace
+
+void AsyncRunQueue::Submit(Device dev, RunFunc run, PackedFunc callback) {
+  bool start;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(Job{dev, std::move(run), std::move(callback)});
+    start = !draining_;
+    draining_ = true;
+  }
+  if (start) {
+    // The task holds the queue, whose executor may be released by the last run.
+    auto self = shared_from_this();
+    AsyncRunPool::Global()->Enqueue([self]() { self->Drain(); });
+  }
+}
+
+void AsyncRunQueue::Drain() {
+  Job job;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job = std::move(pending_.front());
+    pending_.pop_front();
+  }
+  ObjectRef result;
+  std::string error;
+  try {
+    if (job.dev.device_type == kDLCPU) {
+      result = job.run();
+    } else {
+      DeviceAPI* api = DeviceAPI::Get(job.dev);
+      TVMStreamHandle stream = WorkerStream(job.dev);
+      api->SetStream(job.dev, stream);
+      result = job.run();
+      api->StreamSync(job.dev, stream);
+    }
+  } catch (const std::exception& e) {
+    result = ObjectRef();
+    error = e.what();
+  }
+  try {
+    job.callback(result, error);
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "The callback of an asynchronous run failed: " << e.what();
+  }
+  bool more;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    more = !pending_.empty();
+    draining_ = more;
+  }
+  if (more) {
+    // Go to the back of the pool, so that the busy queues share the pool threads.
+    auto self = shared_from_this();
+    AsyncRunPool::Global()->Enqueue([self]() { self->Drain(); });
+  }
+}
+
+NDArray CopyOnCurrentStream(const NDArray& src) {
+  Device dev = src->device;
+  NDArray dst = NDArray::Empty(src.Shape(), src->dtype, dev);
+  TVMStreamHandle stream =
+      dev.device_type == kDLCPU ? nullptr : DeviceAPI::Get(dev)->GetCurrentStream(dev);
+  NDArray::CopyFromTo(src.operator->(), const_cast<DLTensor*>(dst.operator->()), stream);
+  return dst;
+}
+
+}  // namespace runtime
+}  // namespace tvm
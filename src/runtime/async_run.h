@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file async_run.h
+ * \brief Asynchronous runs of the executors, completed through a callback.
+ *
+ *  The runs are executed by a small process-wide pool of host threads, set by the environment
+ *  variable TVM_NUM_ASYNC_RUN_THREADS (2 by default). On an accelerator, each pool thread issues
+ *  the runs to a stream of its own and waits for the stream, so neither the submitting thread
+ *  nor the other runs are blocked by it. On the CPU, the pool thread runs the operators itself.
+ */
+#ifndef TVM_RUNTIME_ASYNC_RUN_H_
+#define TVM_RUNTIME_ASYNC_RUN_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/packed_func.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Serializes the asynchronous runs of one executor.
+ *
+ *  An executor holds the state of a single run, so the runs submitted to one queue execute one
+ *  after the other in submission order, while the runs of different queues, e.g. of the replicas
+ *  of an executor, execute concurrently.
+ */
+class AsyncRunQueue : public std::enable_shared_from_this<AsyncRunQueue> {
+ public:
+  /*! \brief Issues a run on the current stream of the device and returns its result. */
+  using RunFunc = std::function<ObjectRef()>;
+
+  /*!
+   * \brief Submit a run.
+   * \param dev The accelerator the run issues its work to, or the CPU.
+   * \param run The run, called on a pool thread after the previous runs of the queue completed.
+   *  It must hold a reference to the executor.
+   * \param callback Called on the pool thread once the work of the run completed, with the
+   *  result and an empty string, or with a null result and the error message of the run.
+   */
+  void Submit(Device dev, RunFunc run, PackedFunc callback);
+
+ private:
+  struct Job {
+    Device dev;
+    RunFunc run;
+    PackedFunc callback;
+  };
+  /*! \brief Execute the next submitted run, on a pool thread. */
+  void Drain();
+
+  std::mutex mutex_;
+  std::deque<Job> pending_;
+  /*! \brief Whether a pool thread is draining the queue. */
+  bool draining_{false};
+};
+
+/*!
+ * \brief Copy an array into a new array on the same device, on the current stream.
+ *
+ *  The outputs of an asynchronous run are copied out of the executor, which reuses its storage
+ *  for the next run.
+ */
+NDArray CopyOnCurrentStream(const NDArray& src);
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_ASYNC_RUN_H_
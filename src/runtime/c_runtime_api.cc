@@ -658,3 +658,10 @@ TVM_REGISTER_GLOBAL("runtime.GetDeviceAttr").set_body([](TVMArgs args, TVMRetVal
 });
 
 TVM_REGISTER_GLOBAL("runtime.TVMSetStream").set_body_typed(TVMSetStream);
+
+TVM_REGISTER_GLOBAL("runtime.TVMGetCurrentStream").set_body([](TVMArgs args, TVMRetValue* ret) {
+  DLDevice dev;
+  dev.device_type = static_cast<DLDeviceType>(args[0].operator int());
+  dev.device_id = args[1];
+  *ret = DeviceAPIManager::Get(dev)->GetCurrentStream(dev);
+});
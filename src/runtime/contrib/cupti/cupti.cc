@@ -0,0 +1,520 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <cuda.h>
+#include <cuda_runtime.h>
+#include <cupti_profiler_target.h>
+#include <cupti_target.h>
+#include <nvperf_cuda_host.h>
+#include <nvperf_host.h>
+#include <nvperf_target.h>
+#include <tvm/runtime/contrib/cupti.h>
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+#define CUPTI_CALL(func)                                                     \
+  {                                                                          \
+    CUptiResult e = (func);                                                  \
+    if (e != CUPTI_SUCCESS) {                                                \
+      const char* msg = "";                                                  \
+      cuptiGetResultString(e, &msg);                                         \
+      LOG(FATAL) << "CUPTIError: in function " #func " " << e << " " << msg; \
+    }                                                                        \
+  }
+
+#define NVPW_CALL(func)                                       \
+  {                                                           \
+    NVPA_Status e = (func);                                   \
+    if (e != NVPA_STATUS_SUCCESS) {                           \
+      LOG(FATAL) << "NVPWError: in function " #func " " << e; \
+    }                                                         \
+  }
+
+static const std::vector<std::string> default_metric_names = {
+    // achieved occupancy
+    "sm__warps_active.avg.pct_of_peak_sustained_active",
+    // DRAM bytes
+    "dram__bytes.sum",
+    // L2 hit rate
+    "lts__t_sector_hit_rate.pct",
+    // tensor core utilization
+    "sm__pipe_tensor_cycles_active.avg.pct_of_peak_sustained_active",
+    // SM efficiency
+    "smsp__cycles_active.avg.pct_of_peak_sustained_elapsed"};
+
+/*! \brief The most kernels recorded by one profiling session, later kernels are dropped. */
+static constexpr uint32_t kMaxRanges = 2048;
+
+/*! \brief Object that holds the first kernel of a function call. */
+struct CUPTIRangeStartNode : public Object {
+  /*! \brief The device the kernels run on. */
+  Device dev;
+  /*! \brief The index of the first kernel of the call in the counter data. */
+  size_t first_range;
+
+  explicit CUPTIRangeStartNode(Device dev, size_t first_range)
+      : dev(dev), first_range(first_range) {}
+
+  static constexpr const char* _type_key = "CUPTIRangeStartNode";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CUPTIRangeStartNode, Object);
+};
+
+/*! \brief The profiling images and the metrics evaluator of a device. */
+struct CUPTIDeviceState {
+  /*! \brief The context of the device. */
+  CUcontext context{nullptr};
+  /*! \brief The collected metrics. */
+  std::vector<std::string> metric_names;
+  /*! \brief The requests evaluating the metrics, in the order of metric_names. */
+  std::vector<NVPW_MetricEvalRequest> requests;
+  /*! \brief The evaluator of the metrics from the raw counters. */
+  NVPW_MetricsEvaluator* evaluator{nullptr};
+  std::vector<uint8_t> evaluator_scratch;
+  /*! \brief The configuration of the counters, set for every session. */
+  std::vector<uint8_t> config_image;
+  /*! \brief The layout of the counter data. */
+  std::vector<uint8_t> counter_data_prefix;
+  /*! \brief The counters of every kernel of the current session. */
+  std::vector<uint8_t> counter_data_image;
+  std::vector<uint8_t> counter_data_scratch;
+  /*! \brief The number of calls in flight, the session is open while it is not zero. */
+  int depth{0};
+};
+
+/*! \brief MetricCollectorNode for the hardware counters of NVIDIA GPUs.
+ *
+ * Uses the range profiler of CUPTI (CUDA Profiling Tools Interface) in kernel
+ * replay mode: every kernel is its own range and is replayed until all its
+ * counters are collected. A session is open while calls are in flight on a
+ * device, a call gets the metrics of the kernels launched between its `Start`
+ * and `Stop`. Metrics summed over the units of the GPU (`.sum`) are summed
+ * over the kernels of the call, other metrics are averaged.
+ */
+struct CUPTIMetricCollectorNode final : public MetricCollectorNode {
+  /*! \brief Construct a metric collector that collects a specific set of metrics.
+   *
+   * \param metrics A mapping from a device to the metrics that should be
+   * collected on that device. You can find the names of available metrics by
+   * running `ncu --query-metrics`.
+   */
+  explicit CUPTIMetricCollectorNode(Map<DeviceWrapper, Array<String>> metrics) {
+    for (auto& p : metrics) {
+      metric_names[p.first->device] = {};
+      for (auto& metric : p.second) {
+        metric_names[p.first->device].push_back(metric);
+      }
+    }
+  }
+
+  /*! \brief Initialization call.
+   * \param devices The devices this collector will be running on
+   */
+  void Init(Array<DeviceWrapper> devices) final {
+    static bool initialized = false;
+    if (!initialized) {
+      NVPW_InitializeHost_Params host = {NVPW_InitializeHost_Params_STRUCT_SIZE};
+      NVPW_CALL(NVPW_InitializeHost(&host));
+      CUpti_Profiler_Initialize_Params profiler = {CUpti_Profiler_Initialize_Params_STRUCT_SIZE};
+      CUPTI_CALL(cuptiProfilerInitialize(&profiler));
+      initialized = true;
+    }
+    for (auto wrapped_device : devices) {
+      Device device = wrapped_device->device;
+      if (device.device_type != kDLCUDA || states.count(device)) {
+        continue;
+      }
+      auto it = metric_names.find(device);
+      if (it == metric_names.end()) {
+        it = metric_names.emplace(device, default_metric_names).first;
+      }
+      // skip devices with no metrics defined
+      if (it->second.size() == 0) {
+        continue;
+      }
+      InitDevice(device, it->second, &states[device]);
+    }
+  }
+  /*! \brief Called right before a function call. Opens the profiling session
+   * of the device if needed and remembers the first kernel of the call.
+   *
+   * \param dev The device the function will be run on.
+   * \returns A `CUPTIRangeStartNode`, passed to the corresponding `Stop` call.
+   */
+  ObjectRef Start(Device dev) final {
+    auto it = states.find(dev);
+    if (it == states.end()) {
+      return ObjectRef(nullptr);
+    }
+    CUPTIDeviceState& state = it->second;
+    if (state.depth == 0) {
+      BeginSession(dev, &state);
+    }
+    state.depth++;
+    return ObjectRef(make_object<CUPTIRangeStartNode>(dev, NumRanges(dev, state)));
+  }
+  /*! \brief Called right after a function call. Evaluates the metrics of the
+   * kernels launched since the corresponding `Start` call.
+   *
+   * \param obj `CUPTIRangeStartNode` created by a call to `Start`.
+   * \returns A mapping from metric name to value.
+   */
+  Map<String, ObjectRef> Stop(ObjectRef obj) final {
+    const CUPTIRangeStartNode* start = obj.as<CUPTIRangeStartNode>();
+    CUPTIDeviceState& state = states.at(start->dev);
+    size_t end = NumRanges(start->dev, state);
+    if (end == kMaxRanges) {
+      LOG(WARNING) << "More than " << kMaxRanges << " kernels were profiled by CUPTI, the "
+                   << "counters of the later kernels are dropped";
+    }
+
+    std::vector<double> sums(state.requests.size(), 0);
+    if (start->first_range < end) {
+      NVPW_MetricsEvaluator_SetDeviceAttributes_Params attributes = {
+          NVPW_MetricsEvaluator_SetDeviceAttributes_Params_STRUCT_SIZE};
+      attributes.pMetricsEvaluator = state.evaluator;
+      attributes.pCounterDataImage = state.counter_data_image.data();
+      attributes.counterDataImageSize = state.counter_data_image.size();
+      NVPW_CALL(NVPW_MetricsEvaluator_SetDeviceAttributes(&attributes));
+    }
+    std::vector<double> values(state.requests.size());
+    for (size_t range = start->first_range; range < end; range++) {
+      NVPW_MetricsEvaluator_EvaluateToGpuValues_Params evaluate = {
+          NVPW_MetricsEvaluator_EvaluateToGpuValues_Params_STRUCT_SIZE};
+      evaluate.pMetricsEvaluator = state.evaluator;
+      evaluate.pMetricEvalRequests = state.requests.data();
+      evaluate.numMetricEvalRequests = state.requests.size();
+      evaluate.metricEvalRequestStructSize = NVPW_MetricEvalRequest_STRUCT_SIZE;
+      evaluate.metricEvalRequestStrideSize = sizeof(NVPW_MetricEvalRequest);
+      evaluate.pCounterDataImage = state.counter_data_image.data();
+      evaluate.counterDataImageSize = state.counter_data_image.size();
+      evaluate.rangeIndex = range;
+      evaluate.isolated = true;
+      evaluate.pMetricValues = values.data();
+      NVPW_CALL(NVPW_MetricsEvaluator_EvaluateToGpuValues(&evaluate));
+      for (size_t i = 0; i < values.size(); i++) {
+        sums[i] += values[i];
+      }
+    }
+
+    state.depth--;
+    if (state.depth == 0) {
+      EndSession(&state);
+    }
+
+    size_t num_kernels = end - start->first_range;
+    std::unordered_map<String, ObjectRef> reported_metrics;
+    for (size_t i = 0; i < sums.size(); i++) {
+      const std::string& name = state.metric_names[i];
+      if (name.size() > 4 && name.compare(name.size() - 4, 4, ".sum") == 0) {
+        reported_metrics[name] = ObjectRef(make_object<CountNode>(static_cast<int64_t>(sums[i])));
+      } else {
+        reported_metrics[name] =
+            ObjectRef(make_object<RatioNode>(num_kernels ? sums[i] / num_kernels : 0));
+      }
+    }
+    return reported_metrics;
+  }
+
+  ~CUPTIMetricCollectorNode() final {
+    for (auto& p : states) {
+      if (p.second.depth > 0) {
+        EndSession(&p.second);
+      }
+      NVPW_MetricsEvaluator_Destroy_Params destroy = {
+          NVPW_MetricsEvaluator_Destroy_Params_STRUCT_SIZE};
+      destroy.pMetricsEvaluator = p.second.evaluator;
+      NVPW_MetricsEvaluator_Destroy(&destroy);
+    }
+  }
+
+  /*! \brief Device-specific metric names. */
+  std::unordered_map<Device, std::vector<std::string>> metric_names;
+  /*! \brief Device-specific profiling state, for the devices collecting metrics. */
+  std::unordered_map<Device, CUPTIDeviceState> states;
+
+  static constexpr const char* _type_key = "runtime.profiling.CUPTIMetricCollector";
+  TVM_DECLARE_FINAL_OBJECT_INFO(CUPTIMetricCollectorNode, MetricCollectorNode);
+
+ private:
+  /*! \brief Create the evaluator, the counter configuration and the counter data of a device. */
+  static void InitDevice(Device device, const std::vector<std::string>& names,
+                         CUPTIDeviceState* state) {
+    state->metric_names = names;
+    CHECK_EQ(cudaSetDevice(device.device_id), cudaSuccess);
+    // make sure the primary context of the device exists
+    CHECK_EQ(cudaFree(nullptr), cudaSuccess);
+    CHECK_EQ(cuCtxGetCurrent(&state->context), CUDA_SUCCESS);
+
+    CUpti_Device_GetChipName_Params chip = {CUpti_Device_GetChipName_Params_STRUCT_SIZE};
+    chip.deviceIndex = device.device_id;
+    CUPTI_CALL(cuptiDeviceGetChipName(&chip));
+    std::string chip_name = chip.pChipName;
+
+    CUpti_Profiler_GetCounterAvailability_Params availability_params = {
+        CUpti_Profiler_GetCounterAvailability_Params_STRUCT_SIZE};
+    availability_params.ctx = state->context;
+    CUPTI_CALL(cuptiProfilerGetCounterAvailability(&availability_params));
+    std::vector<uint8_t> availability(availability_params.counterAvailabilityImageSize);
+    availability_params.pCounterAvailabilityImage = availability.data();
+    CUPTI_CALL(cuptiProfilerGetCounterAvailability(&availability_params));
+
+    NVPW_CUDA_MetricsEvaluator_CalculateScratchBufferSize_Params scratch_size = {
+        NVPW_CUDA_MetricsEvaluator_CalculateScratchBufferSize_Params_STRUCT_SIZE};
+    scratch_size.pChipName = chip_name.c_str();
+    scratch_size.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_MetricsEvaluator_CalculateScratchBufferSize(&scratch_size));
+    state->evaluator_scratch.resize(scratch_size.scratchBufferSize);
+    NVPW_CUDA_MetricsEvaluator_Initialize_Params evaluator = {
+        NVPW_CUDA_MetricsEvaluator_Initialize_Params_STRUCT_SIZE};
+    evaluator.scratchBufferSize = state->evaluator_scratch.size();
+    evaluator.pScratchBuffer = state->evaluator_scratch.data();
+    evaluator.pChipName = chip_name.c_str();
+    evaluator.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_MetricsEvaluator_Initialize(&evaluator));
+    state->evaluator = evaluator.pMetricsEvaluator;
+
+    // The raw counters every metric is computed from.
+    std::set<std::string> raw_names;
+    for (const auto& name : names) {
+      NVPW_MetricEvalRequest request;
+      NVPW_MetricsEvaluator_ConvertMetricNameToMetricEvalRequest_Params convert = {
+          NVPW_MetricsEvaluator_ConvertMetricNameToMetricEvalRequest_Params_STRUCT_SIZE};
+      convert.pMetricsEvaluator = state->evaluator;
+      convert.pMetricName = name.c_str();
+      convert.pMetricEvalRequest = &request;
+      convert.metricEvalRequestStructSize = NVPW_MetricEvalRequest_STRUCT_SIZE;
+      NVPA_Status e = NVPW_MetricsEvaluator_ConvertMetricNameToMetricEvalRequest(&convert);
+      if (e != NVPA_STATUS_SUCCESS) {
+        LOG(FATAL) << "NVPWError: " << e << ": unknown metric " << name << " on " << chip_name
+                   << ".";
+      }
+      state->requests.push_back(request);
+
+      NVPW_MetricsEvaluator_GetMetricRawDependencies_Params dependencies = {
+          NVPW_MetricsEvaluator_GetMetricRawDependencies_Params_STRUCT_SIZE};
+      dependencies.pMetricsEvaluator = state->evaluator;
+      dependencies.pMetricEvalRequests = &request;
+      dependencies.numMetricEvalRequests = 1;
+      dependencies.metricEvalRequestStructSize = NVPW_MetricEvalRequest_STRUCT_SIZE;
+      dependencies.metricEvalRequestStrideSize = sizeof(NVPW_MetricEvalRequest);
+      NVPW_CALL(NVPW_MetricsEvaluator_GetMetricRawDependencies(&dependencies));
+      std::vector<const char*> raw_dependencies(dependencies.numRawDependencies);
+      dependencies.ppRawDependencies = raw_dependencies.data();
+      NVPW_CALL(NVPW_MetricsEvaluator_GetMetricRawDependencies(&dependencies));
+      raw_names.insert(raw_dependencies.begin(), raw_dependencies.end());
+    }
+    std::vector<NVPA_RawMetricRequest> raw_requests;
+    for (const auto& name : raw_names) {
+      NVPA_RawMetricRequest request = {NVPA_RAW_METRIC_REQUEST_STRUCT_SIZE};
+      request.pMetricName = name.c_str();
+      request.isolated = true;
+      request.keepInstances = true;
+      raw_requests.push_back(request);
+    }
+
+    // configuration of the counters
+    NVPW_CUDA_RawMetricsConfig_Create_V2_Params create_config = {
+        NVPW_CUDA_RawMetricsConfig_Create_V2_Params_STRUCT_SIZE};
+    create_config.activityKind = NVPA_ACTIVITY_KIND_PROFILER;
+    create_config.pChipName = chip_name.c_str();
+    create_config.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_RawMetricsConfig_Create_V2(&create_config));
+    NVPA_RawMetricsConfig* config = create_config.pRawMetricsConfig;
+    NVPW_RawMetricsConfig_SetCounterAvailability_Params set_availability = {
+        NVPW_RawMetricsConfig_SetCounterAvailability_Params_STRUCT_SIZE};
+    set_availability.pRawMetricsConfig = config;
+    set_availability.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_RawMetricsConfig_SetCounterAvailability(&set_availability));
+    NVPW_RawMetricsConfig_BeginPassGroup_Params begin_pass_group = {
+        NVPW_RawMetricsConfig_BeginPassGroup_Params_STRUCT_SIZE};
+    begin_pass_group.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_BeginPassGroup(&begin_pass_group));
+    NVPW_RawMetricsConfig_AddMetrics_Params add_metrics = {
+        NVPW_RawMetricsConfig_AddMetrics_Params_STRUCT_SIZE};
+    add_metrics.pRawMetricsConfig = config;
+    add_metrics.pRawMetricRequests = raw_requests.data();
+    add_metrics.numMetricRequests = raw_requests.size();
+    NVPW_CALL(NVPW_RawMetricsConfig_AddMetrics(&add_metrics));
+    NVPW_RawMetricsConfig_EndPassGroup_Params end_pass_group = {
+        NVPW_RawMetricsConfig_EndPassGroup_Params_STRUCT_SIZE};
+    end_pass_group.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_EndPassGroup(&end_pass_group));
+    NVPW_RawMetricsConfig_GenerateConfigImage_Params generate = {
+        NVPW_RawMetricsConfig_GenerateConfigImage_Params_STRUCT_SIZE};
+    generate.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_GenerateConfigImage(&generate));
+    NVPW_RawMetricsConfig_GetConfigImage_Params get_config = {
+        NVPW_RawMetricsConfig_GetConfigImage_Params_STRUCT_SIZE};
+    get_config.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_GetConfigImage(&get_config));
+    state->config_image.resize(get_config.bytesCopied);
+    get_config.bytesAllocated = state->config_image.size();
+    get_config.pBuffer = state->config_image.data();
+    NVPW_CALL(NVPW_RawMetricsConfig_GetConfigImage(&get_config));
+    NVPW_RawMetricsConfig_Destroy_Params destroy_config = {
+        NVPW_RawMetricsConfig_Destroy_Params_STRUCT_SIZE};
+    destroy_config.pRawMetricsConfig = config;
+    NVPW_CALL(NVPW_RawMetricsConfig_Destroy(&destroy_config));
+
+    // layout of the counter data
+    NVPW_CUDA_CounterDataBuilder_Create_Params create_builder = {
+        NVPW_CUDA_CounterDataBuilder_Create_Params_STRUCT_SIZE};
+    create_builder.pChipName = chip_name.c_str();
+    create_builder.pCounterAvailabilityImage = availability.data();
+    NVPW_CALL(NVPW_CUDA_CounterDataBuilder_Create(&create_builder));
+    NVPW_CounterDataBuilder_AddMetrics_Params builder_metrics = {
+        NVPW_CounterDataBuilder_AddMetrics_Params_STRUCT_SIZE};
+    builder_metrics.pCounterDataBuilder = create_builder.pCounterDataBuilder;
+    builder_metrics.pRawMetricRequests = raw_requests.data();
+    builder_metrics.numMetricRequests = raw_requests.size();
+    NVPW_CALL(NVPW_CounterDataBuilder_AddMetrics(&builder_metrics));
+    NVPW_CounterDataBuilder_GetCounterDataPrefix_Params get_prefix = {
+        NVPW_CounterDataBuilder_GetCounterDataPrefix_Params_STRUCT_SIZE};
+    get_prefix.pCounterDataBuilder = create_builder.pCounterDataBuilder;
+    NVPW_CALL(NVPW_CounterDataBuilder_GetCounterDataPrefix(&get_prefix));
+    state->counter_data_prefix.resize(get_prefix.bytesCopied);
+    get_prefix.bytesAllocated = state->counter_data_prefix.size();
+    get_prefix.pBuffer = state->counter_data_prefix.data();
+    NVPW_CALL(NVPW_CounterDataBuilder_GetCounterDataPrefix(&get_prefix));
+    NVPW_CounterDataBuilder_Destroy_Params destroy_builder = {
+        NVPW_CounterDataBuilder_Destroy_Params_STRUCT_SIZE};
+    destroy_builder.pCounterDataBuilder = create_builder.pCounterDataBuilder;
+    NVPW_CALL(NVPW_CounterDataBuilder_Destroy(&destroy_builder));
+  }
+
+  /*! \brief Initialize the counter data of a device and start profiling its kernels. */
+  static void BeginSession(Device dev, CUPTIDeviceState* state) {
+    CUpti_Profiler_CounterDataImageOptions options = {
+        CUpti_Profiler_CounterDataImageOptions_STRUCT_SIZE};
+    options.pCounterDataPrefix = state->counter_data_prefix.data();
+    options.counterDataPrefixSize = state->counter_data_prefix.size();
+    options.maxNumRanges = kMaxRanges;
+    options.maxNumRangeTreeNodes = kMaxRanges;
+    options.maxRangeNameLength = 64;
+    CUpti_Profiler_CounterDataImage_CalculateSize_Params image_size = {
+        CUpti_Profiler_CounterDataImage_CalculateSize_Params_STRUCT_SIZE};
+    image_size.pOptions = &options;
+    image_size.sizeofCounterDataImageOptions = CUpti_Profiler_CounterDataImageOptions_STRUCT_SIZE;
+    CUPTI_CALL(cuptiProfilerCounterDataImageCalculateSize(&image_size));
+    state->counter_data_image.resize(image_size.counterDataImageSize);
+    CUpti_Profiler_CounterDataImage_Initialize_Params image = {
+        CUpti_Profiler_CounterDataImage_Initialize_Params_STRUCT_SIZE};
+    image.sizeofCounterDataImageOptions = CUpti_Profiler_CounterDataImageOptions_STRUCT_SIZE;
+    image.pOptions = &options;
+    image.counterDataImageSize = state->counter_data_image.size();
+    image.pCounterDataImage = state->counter_data_image.data();
+    CUPTI_CALL(cuptiProfilerCounterDataImageInitialize(&image));
+    CUpti_Profiler_CounterDataImage_CalculateScratchBufferSize_Params scratch_size = {
+        CUpti_Profiler_CounterDataImage_CalculateScratchBufferSize_Params_STRUCT_SIZE};
+    scratch_size.counterDataImageSize = state->counter_data_image.size();
+    scratch_size.pCounterDataImage = state->counter_data_image.data();
+    CUPTI_CALL(cuptiProfilerCounterDataImageCalculateScratchBufferSize(&scratch_size));
+    state->counter_data_scratch.resize(scratch_size.counterDataScratchBufferSize);
+    CUpti_Profiler_CounterDataImage_InitializeScratchBuffer_Params scratch = {
+        CUpti_Profiler_CounterDataImage_InitializeScratchBuffer_Params_STRUCT_SIZE};
+    scratch.counterDataImageSize = state->counter_data_image.size();
+    scratch.pCounterDataImage = state->counter_data_image.data();
+    scratch.counterDataScratchBufferSize = state->counter_data_scratch.size();
+    scratch.pCounterDataScratchBuffer = state->counter_data_scratch.data();
+    CUPTI_CALL(cuptiProfilerCounterDataImageInitializeScratchBuffer(&scratch));
+
+    CHECK_EQ(cudaSetDevice(dev.device_id), cudaSuccess);
+    CUpti_Profiler_BeginSession_Params begin = {CUpti_Profiler_BeginSession_Params_STRUCT_SIZE};
+    begin.ctx = state->context;
+    begin.counterDataImageSize = state->counter_data_image.size();
+    begin.pCounterDataImage = state->counter_data_image.data();
+    begin.counterDataScratchBufferSize = state->counter_data_scratch.size();
+    begin.pCounterDataScratchBuffer = state->counter_data_scratch.data();
+    begin.range = CUPTI_AutoRange;
+    begin.replayMode = CUPTI_KernelReplay;
+    begin.maxRangesPerPass = kMaxRanges;
+    begin.maxLaunchesPerPass = kMaxRanges;
+    CUPTI_CALL(cuptiProfilerBeginSession(&begin));
+    CUpti_Profiler_SetConfig_Params config = {CUpti_Profiler_SetConfig_Params_STRUCT_SIZE};
+    config.ctx = state->context;
+    config.pConfig = state->config_image.data();
+    config.configSize = state->config_image.size();
+    config.passIndex = 0;
+    config.minNestingLevel = 1;
+    config.numNestingLevels = 1;
+    CUPTI_CALL(cuptiProfilerSetConfig(&config));
+    CUpti_Profiler_EnableProfiling_Params enable = {
+        CUpti_Profiler_EnableProfiling_Params_STRUCT_SIZE};
+    enable.ctx = state->context;
+    CUPTI_CALL(cuptiProfilerEnableProfiling(&enable));
+  }
+
+  /*! \brief Stop profiling the kernels of a device. */
+  static void EndSession(CUPTIDeviceState* state) {
+    CUpti_Profiler_DisableProfiling_Params disable = {
+        CUpti_Profiler_DisableProfiling_Params_STRUCT_SIZE};
+    disable.ctx = state->context;
+    CUPTI_CALL(cuptiProfilerDisableProfiling(&disable));
+    CUpti_Profiler_UnsetConfig_Params unset = {CUpti_Profiler_UnsetConfig_Params_STRUCT_SIZE};
+    unset.ctx = state->context;
+    CUPTI_CALL(cuptiProfilerUnsetConfig(&unset));
+    CUpti_Profiler_EndSession_Params end = {CUpti_Profiler_EndSession_Params_STRUCT_SIZE};
+    end.ctx = state->context;
+    CUPTI_CALL(cuptiProfilerEndSession(&end));
+  }
+
+  /*! \brief The number of kernels profiled in the current session of a device. */
+  static size_t NumRanges(Device dev, const CUPTIDeviceState& state) {
+    // In kernel replay mode the counters of a kernel are collected by the time it completes.
+    CHECK_EQ(cudaSetDevice(dev.device_id), cudaSuccess);
+    CHECK_EQ(cudaDeviceSynchronize(), cudaSuccess);
+    NVPW_CounterData_GetNumRanges_Params ranges = {
+        NVPW_CounterData_GetNumRanges_Params_STRUCT_SIZE};
+    ranges.pCounterDataImage = state.counter_data_image.data();
+    NVPW_CALL(NVPW_CounterData_GetNumRanges(&ranges));
+    return ranges.numRanges;
+  }
+};
+
+/*! \brief Wrapper for `CUPTIMetricCollectorNode`. */
+class CUPTIMetricCollector : public MetricCollector {
+ public:
+  explicit CUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics) {
+    data_ = make_object<CUPTIMetricCollectorNode>(metrics);
+  }
+  TVM_DEFINE_MUTABLE_OBJECT_REF_METHODS(CUPTIMetricCollector, MetricCollector,
+                                        CUPTIMetricCollectorNode);
+};
+
+MetricCollector CreateCUPTIMetricCollector(Map<DeviceWrapper, Array<String>> metrics) {
+  return CUPTIMetricCollector(metrics);
+}
+
+TVM_REGISTER_OBJECT_TYPE(CUPTIRangeStartNode);
+TVM_REGISTER_OBJECT_TYPE(CUPTIMetricCollectorNode);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.CUPTIMetricCollector")
+    .set_body_typed([](Map<DeviceWrapper, Array<String>> metrics) {
+      return CUPTIMetricCollector(metrics);
+    });
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
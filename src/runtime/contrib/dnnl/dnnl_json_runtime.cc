@@ -25,8 +25,12 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -63,20 +67,53 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     ICHECK_EQ(consts.size(), const_idx_.size())
         << "The number of input constants must match the number of required.";
 
-    // Setup constants entries for weights.
-    SetupConstants(consts);
-    BuildEngine();
+    // The instances of the same graph and weights, e.g. the replicas of a model, share the
+    // primitives and the reordered weights. Run only binds the inputs and outputs per call.
+    shared_ = GetOrCreateSharedState<SharedState>(consts, [&consts]() {
+      auto state = std::make_shared<SharedState>();
+      state->engine = dnnl::engine(dnnl::engine::kind::cpu, 0);
+      state->stream = dnnl::stream(state->engine);
+      state->consts = consts;
+      state->const_cache = std::make_shared<ConstReorderCache>();
+      return state;
+    });
+    engine_ = shared_->engine;
+    stream_ = shared_->stream;
+    // Setup constants entries for weights. The shared constants hold the same data as consts, and
+    // outlive this instance in the networks referring to them.
+    SetupConstants(shared_->consts);
+
+    // Build the primitives of a static graph ahead of the first run.
+    std::vector<std::vector<int64_t>> input_shapes;
+    bool is_static = true;
+    for (uint32_t eid : input_var_eid_) {
+      input_shapes.push_back(JSONEntryShape(eid));
+      for (int64_t dim : input_shapes.back()) is_static &= dim >= 0;
+    }
+    if (is_static) static_network_ = GetOrBuildNetwork(input_shapes);
   }
 
   /* Unused stub implementation */
   void Run() override { LOG(FATAL) << "Unreachable code"; }
 
-  /* Thread safe implementation of Run. Keep runtime instance immutable */
-  void Run(const TVMArgs& args) const {
+  /*
+   * Thread safe implementation of Run. The networks are built under the lock of the shared
+   * state, and are immutable once built.
+   */
+  void Run(const TVMArgs& args) {
     auto arg_data_provider = makeIODataProvider(args);
-    auto mem_solver = tensor_registry_.MakeSolver(arg_data_provider);
+    std::shared_ptr<const Network> network = static_network_;
+    if (network == nullptr) {
+      std::vector<std::vector<int64_t>> input_shapes;
+      for (uint32_t eid : input_var_eid_) {
+        const DLTensor* tensor = arg_data_provider(eid);
+        input_shapes.emplace_back(tensor->shape, tensor->shape + tensor->ndim);
+      }
+      network = GetOrBuildNetwork(input_shapes);
+    }
+    auto mem_solver = network->tensor_registry.MakeSolver(arg_data_provider);
     // Execute primitives one by one
-    for (const auto& act : net_) {
+    for (const auto& act : network->net) {
       auto prim = std::get<0>(act);
       auto arg_reqs = std::get<1>(act);
 
@@ -245,13 +282,91 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     return attr;
   }
 
+  /* The network built for a set of input shapes, immutable once built. */
+  struct Network {
+    /* The network layers that are represented in dnnl primitives. */
+    TensorRegistry::ActionQue net;
+    /* Storage for all memory objects */
+    TensorRegistry tensor_registry;
+  };
+
+  /* The state shared by the instances of the same graph and weights. */
+  struct SharedState {
+    dnnl::engine engine;
+    dnnl::stream stream;
+    /* The constants the memory of the networks refers to. */
+    Array<NDArray> consts;
+    /* The constants reordered into the layouts of the primitives, shared by all the networks. */
+    std::shared_ptr<ConstReorderCache> const_cache;
+    mutable std::mutex mutex;
+    /* The networks built for each set of input shapes, keyed by ShapeKey. */
+    mutable std::unordered_map<std::string, std::shared_ptr<const Network>> networks;
+  };
+
+  /* Get the shape of an entry in the graph, -1 for its dynamic dims. */
+  std::vector<int64_t> JSONEntryShape(uint32_t eid) const {
+    auto nid = static_cast<uint32_t>(
+        std::upper_bound(node_row_ptr_.begin(), node_row_ptr_.end(), eid) - node_row_ptr_.begin() -
+        1);
+    return nodes_[nid].GetOpShape()[eid - node_row_ptr_[nid]];
+  }
+
+  static std::string ShapeKey(const std::vector<std::vector<int64_t>>& shapes) {
+    std::ostringstream os;
+    for (const auto& shape : shapes) {
+      for (int64_t dim : shape) os << dim << ",";
+      os << ";";
+    }
+    return os.str();
+  }
+
+  /* Get the network for the input shapes, building it on first use. */
+  std::shared_ptr<const Network> GetOrBuildNetwork(
+      const std::vector<std::vector<int64_t>>& input_shapes) {
+    std::lock_guard<std::mutex> lock(shared_->mutex);
+    auto& network = shared_->networks[ShapeKey(input_shapes)];
+    if (network == nullptr) {
+      ResolveEntryShapes(input_shapes);
+      BuildEngine();
+      network = std::make_shared<Network>(Network{std::move(net_), std::move(tensor_registry_)});
+      net_.clear();
+      tensor_registry_ = TensorRegistry();
+    }
+    return network;
+  }
+
+  /*
+   * Resolve the shapes of all the entries from the input shapes. Only the leading dim may be
+   * dynamic, and it takes the batch size of the inputs.
+   */
+  void ResolveEntryShapes(const std::vector<std::vector<int64_t>>& input_shapes) {
+    ICHECK_EQ(input_shapes.size(), input_var_eid_.size());
+    int64_t batch = -1;
+    for (size_t i = 0; i < input_var_eid_.size(); ++i) {
+      auto shape = JSONEntryShape(input_var_eid_[i]);
+      if (!shape.empty() && shape[0] < 0 && !input_shapes[i].empty()) batch = input_shapes[i][0];
+    }
+    entry_shapes_.resize(data_entry_.size());
+    for (uint32_t eid = 0; eid < data_entry_.size(); ++eid) {
+      entry_shapes_[eid] = JSONEntryShape(eid);
+      if (!entry_shapes_[eid].empty() && entry_shapes_[eid][0] < 0) entry_shapes_[eid][0] = batch;
+    }
+    for (size_t i = 0; i < input_var_eid_.size(); ++i) {
+      entry_shapes_[input_var_eid_[i]] = input_shapes[i];
+    }
+    for (const auto& shape : entry_shapes_) {
+      for (int64_t dim : shape) {
+        ICHECK_GE(dim, 0) << "DNNL runtime only supports a dynamic batch dim, in subgraph "
+                          << symbol_name_;
+      }
+    }
+  }
+
   // Build up the engine based on the input graph.
   void BuildEngine() {
-    engine_ = dnnl::engine(dnnl::engine::kind::cpu, 0);
-    stream_ = dnnl::stream(engine_);
-
+    next_unique_eid_offset_ = data_entry_.size();
     std::set<uint32_t> io_eid_set(run_arg_eid_.begin(), run_arg_eid_.end());
-    tensor_registry_ = TensorRegistry(engine_, io_eid_set);
+    tensor_registry_ = TensorRegistry(engine_, io_eid_set, shared_->const_cache);
 
     std::regex conv_pat(".*conv[1-3]d.*");
     std::regex deconv_pat(".*deconv[1-3]d.*");
@@ -815,9 +930,9 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     ICHECK_LT(idx, node.GetInputs().size());
     auto data_entry = node.GetInputs()[idx];
 
-    auto shape = nodes_[data_entry.id_].GetOpShape()[data_entry.index_];
     auto dtype = nodes_[data_entry.id_].GetOpDataType()[data_entry.index_];
     auto eid = node_row_ptr_[data_entry.id_] + data_entry.index_;
+    auto shape = entry_shapes_[eid];
     auto const_dl_tensor = data_entry_[eid];
 
     auto desc = MakePlainDesc(shape, dtype);
@@ -844,9 +959,9 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
     const JSONGraphNode& node = nodes_[nid];
 
     ICHECK_LT(idx, node.GetNumOutput());
-    auto shape = node.GetOpShape()[idx];
     auto dtype = node.GetOpDataType()[idx];
     auto eid = node_row_ptr_[nid] + static_cast<uint32_t>(idx);
+    auto shape = entry_shapes_[eid];
 
     ICHECK(data_entry_[eid] == nullptr);
 
@@ -917,14 +1032,20 @@ class DNNLJSONRuntime : public JSONRuntimeBase {
   dnnl::engine engine_;
   /* The dnnl stream. */
   dnnl::stream stream_;
-  /* The network layers that are represented in dnnl primitives. */
+  /* The network layers being built. */
   TensorRegistry::ActionQue net_;
-  /* Storage for all memory objects */
+  /* Storage for all memory objects of the network being built. */
   TensorRegistry tensor_registry_;
+  /* The shapes of the entries of the network being built. */
+  std::vector<std::vector<int64_t>> entry_shapes_;
   /* Generator of new unique eid which doesn't match with existing data entry */
   uint32_t next_unique_eid_offset_;
   /* Map of Run arg idx to corresponding eid */
   std::vector<uint32_t> run_arg_eid_;
+  /* The state shared by the instances of the same graph and weights. */
+  std::shared_ptr<const SharedState> shared_;
+  /* The network of a graph with static shapes, built in Init. */
+  std::shared_ptr<const Network> static_network_;
 };
 
 runtime::Module DNNLJSONRuntimeCreate(String symbol_name, String graph_json,
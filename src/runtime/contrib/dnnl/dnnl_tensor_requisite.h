@@ -32,6 +32,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <tuple>
@@ -51,6 +52,38 @@ namespace contrib {
 
 using namespace utils;
 
+/*!
+ * \brief Cache of the constant tensors reordered into the layouts the primitives prefer.
+ *
+ * Each constant is reordered once per layout, however many primitives use it, e.g. the
+ * primitives built for the different input shapes of the same subgraph.
+ */
+class ConstReorderCache {
+ public:
+  /*! \brief Return src reordered into desc, reordering it on first request only. */
+  dnnl::memory GetOrReorder(const dnnl::memory& src, const dnnl::memory::desc& desc) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entries = cache_[src.get_data_handle()];
+    for (const auto& entry : entries) {
+      if (std::get<0>(entry) == src.get_desc() && std::get<1>(entry) == desc) {
+        return std::get<2>(entry);
+      }
+    }
+    auto eng = src.get_engine();
+    auto res = dnnl::memory{desc, eng};
+    dnnl::reorder(src, res).execute(dnnl::stream(eng), src, res);
+    entries.emplace_back(src.get_desc(), desc, res);
+    return res;
+  }
+
+ private:
+  std::mutex mutex_;
+  /*! \brief Map of source data handle to its source desc, reordered desc and reordered data. */
+  std::unordered_map<void*,
+                     std::vector<std::tuple<dnnl::memory::desc, dnnl::memory::desc, dnnl::memory>>>
+      cache_;
+};
+
 /*!
  * \brief Helper object to simplify tensor transformation description.
  *
@@ -399,14 +432,19 @@ class TensorRequisite {
   /*! \brief Check is tensor is scalar. */
   bool IsScalar() const { return t_desc_.dims().size() == 1 && t_desc_.dims()[0] == 1; }
 
-  /*! \brief Return const data memory if available. */
-  dnnl::memory GetConstData() const {
+  /*!
+   * \brief Return const data memory if available.
+   * \param cache If given, the reorders of the const data are taken from and added to it.
+   */
+  dnnl::memory GetConstData(ConstReorderCache* cache = nullptr) const {
     if (mem_) return mem_;
     if (!orig_) return {};
 
-    if (auto orig_const_data = orig_->GetConstData()) {
+    if (auto orig_const_data = orig_->GetConstData(cache)) {
       if (reinterpret_) {
         return {t_desc_, orig_const_data.get_engine(), orig_const_data.get_data_handle()};
+      } else if (cache != nullptr) {
+        return cache->GetOrReorder(orig_const_data, t_desc_);
       } else {
         auto eng = orig_const_data.get_engine();
         auto res = dnnl::memory{t_desc_, eng};
@@ -522,8 +560,13 @@ class TensorRegistry {
   using MemSolver = std::function<const dnnl::memory(ArgId)>;
 
   TensorRegistry() = default;
-  TensorRegistry(const dnnl::engine& eng, const std::set<uint32_t>& ext_io_eid)
-      : tmp_mem_collection_(1), ext_io_eid_(ext_io_eid), eng_(eng), stream_(eng) {}
+  TensorRegistry(const dnnl::engine& eng, const std::set<uint32_t>& ext_io_eid,
+                 std::shared_ptr<ConstReorderCache> const_cache = nullptr)
+      : tmp_mem_collection_(1),
+        ext_io_eid_(ext_io_eid),
+        eng_(eng),
+        stream_(eng),
+        const_cache_(std::move(const_cache)) {}
 
   /*!
    * \brief Register TR to registry
@@ -540,7 +583,7 @@ class TensorRegistry {
    */
   ArgId Register(const TensorRequisite& tr, ActionQue* action) {
     // 1) Constant tensor. Direct reference
-    if (auto const_data = tr.GetConstData()) {
+    if (auto const_data = tr.GetConstData(const_cache_.get())) {
       auto idx = const_mem_collection_.size();
       const_mem_collection_.push_back(const_data);
       return MakeArgReq(ArgReqFlag::CONST, static_cast<uint32_t>(idx));
@@ -736,6 +779,9 @@ class TensorRegistry {
 
   /* Execution stream use to reorder const data */
   dnnl::stream stream_;
+
+  /* Cache of the reordered const data, shared with the other registries of the same constants */
+  std::shared_ptr<ConstReorderCache> const_cache_;
 };
 
 }  // namespace contrib
@@ -28,7 +28,13 @@
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/ndarray.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -42,16 +48,143 @@ namespace tvm {
 namespace runtime {
 namespace json {
 
+/*!
+ * \brief The parsed JSON graph of a subgraph. It is immutable once loaded, and shared by all the
+ * runtime instances of the same graph, e.g. the replicas of a model loaded several times.
+ */
+struct JSONGraph {
+  /*! \brief The graph. */
+  std::string graph_json;
+  /*! \brief The json graph nodes. */
+  std::vector<JSONGraphNode> nodes;
+  /*! \brief The input nodes, including variables and constants. */
+  std::vector<uint32_t> input_nodes;
+  /*! \brief Used for quick entry indexing. */
+  std::vector<uint32_t> node_row_ptr;
+  /*! \brief Output entries. */
+  std::vector<JSONGraphNodeEntry> outputs;
+  /*! \brief Map the input name to entry id. */
+  std::vector<uint32_t> input_var_eid;
+  /*! \brief input const node index. */
+  std::vector<uint32_t> const_idx;
+
+  /*!
+   * \brief Get the parsed graph of graph_json, parsing it unless an instance alive already did.
+   *
+   * \param graph_json The graph in the json format.
+   * \param const_names The required constant names.
+   * \return The shared parsed graph.
+   */
+  static std::shared_ptr<const JSONGraph> Get(const std::string& graph_json,
+                                              const Array<String>& const_names) {
+    static std::mutex mutex;
+    static std::unordered_multimap<size_t, std::weak_ptr<const JSONGraph>> cache;
+    size_t hash = std::hash<std::string>()(graph_json);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto range = cache.equal_range(hash);
+    for (auto it = range.first; it != range.second;) {
+      std::shared_ptr<const JSONGraph> graph = it->second.lock();
+      if (graph == nullptr) {
+        it = cache.erase(it);
+        continue;
+      }
+      if (graph->graph_json == graph_json) {
+        return graph;
+      }
+      ++it;
+    }
+    auto graph = std::make_shared<JSONGraph>();
+    graph->Load(graph_json, const_names);
+    cache.emplace(hash, graph);
+    return graph;
+  }
+
+ private:
+  /*!
+   * \brief Load the graph and record the entries for inputs and constants.
+   *
+   * \param graph_json The graph in the json format.
+   * \param const_names The required constant names.
+   */
+  void Load(const std::string& graph_json, const Array<String>& const_names) {
+    this->graph_json = graph_json;
+    std::istringstream is(graph_json);
+    dmlc::JSONReader reader(&is);
+    this->Load(&reader);
+    std::vector<std::string> consts;
+    for (size_t i = 0; i < input_nodes.size(); i++) {
+      uint32_t nid = input_nodes[i];
+      std::string name = nodes[nid].GetOpName();
+      if (nodes[nid].GetOpType() == "input") {
+        ICHECK_EQ(nodes[nid].GetOpShape().size(), nodes[nid].GetOpDataType().size());
+        for (size_t j = 0; j < nodes[nid].GetOpShape().size(); ++j) {
+          input_var_eid.push_back(node_row_ptr[nid] + j);
+        }
+        nodes[nid].SetNumOutput(nodes[nid].GetOpShape().size());
+      } else {
+        ICHECK_EQ(nodes[nid].GetOpType(), "const");
+        auto pos = std::find(std::begin(const_names), std::end(const_names), name);
+        ICHECK(pos != std::end(const_names)) << "Found non-existent constant: " << name;
+        const_idx.push_back(nid);
+        consts.push_back(name);
+      }
+    }
+    ICHECK_EQ(consts.size(), const_names.size())
+        << "Found mismatch for the number of constants in the graph and required.";
+
+    for (size_t i = 0; i < consts.size(); i++) {
+      ICHECK_EQ(consts[i], const_names[i])
+          << "The position of constant in the graph must be the same as the required.";
+    }
+  }
+
+  // Load the graph.
+  void Load(dmlc::JSONReader* reader) {
+    reader->BeginObject();
+    std::string key;
+    std::string symbol_;
+    while (reader->NextObjectItem(&key)) {
+      if (key == "nodes") {
+        reader->Read(&nodes);
+      } else if (key == "arg_nodes") {
+        reader->Read(&input_nodes);
+      } else if (key == "node_row_ptr") {
+        reader->Read(&node_row_ptr);
+      } else if (key == "heads") {
+        reader->Read(&outputs);
+      } else if (key == "symbol") {
+        reader->Read(&symbol_);
+      } else {
+        LOG(FATAL) << "Unknown key: " << key;
+      }
+    }
+  }
+};
+
 /*!
  * \brief A json runtime that executes the serialized JSON format. This runtime
  * can be extended by user defined runtime for execution.
+ *
+ * The parsed graph is shared read-only by the instances of the same graph, and so can be the
+ * state a backend prepares from the constants, see GetOrCreateSharedState. Only the data
+ * entries binding the inputs and outputs of a run are per instance.
  */
 class JSONRuntimeBase : public ModuleNode {
  public:
   JSONRuntimeBase(const std::string& symbol_name, const std::string& graph_json,
                   const Array<String> const_names)
-      : symbol_name_(symbol_name), graph_json_(graph_json), const_names_(const_names) {
-    LoadGraph(graph_json_);
+      : symbol_name_(symbol_name),
+        graph_(JSONGraph::Get(graph_json, const_names)),
+        graph_json_(graph_->graph_json),
+        const_names_(const_names),
+        nodes_(graph_->nodes),
+        input_nodes_(graph_->input_nodes),
+        node_row_ptr_(graph_->node_row_ptr),
+        outputs_(graph_->outputs),
+        input_var_eid_(graph_->input_var_eid),
+        const_idx_(graph_->const_idx) {
+    // Reserve data entries.
+    data_entry_.resize(NumEntries());
   }
 
   ~JSONRuntimeBase() override = default;
@@ -178,45 +311,6 @@ class JSONRuntimeBase : public ModuleNode {
     }
   }
 
-  /*!
-   * \brief Load the graph and record the entries for inputs and constants.
-   *
-   * \param graph_json The graph in the json format.
-   */
-  void LoadGraph(const std::string& graph_json) {
-    std::istringstream is(graph_json);
-    dmlc::JSONReader reader(&is);
-    this->Load(&reader);
-    std::vector<std::string> consts;
-    for (size_t i = 0; i < input_nodes_.size(); i++) {
-      uint32_t nid = input_nodes_[i];
-      std::string name = nodes_[nid].name_;
-      if (nodes_[nid].op_type_ == "input") {
-        ICHECK_EQ(nodes_[nid].GetOpShape().size(), nodes_[nid].GetOpDataType().size());
-        for (size_t j = 0; j < nodes_[nid].GetOpShape().size(); ++j) {
-          input_var_eid_.push_back(EntryID(nid, j));
-        }
-        nodes_[nid].SetNumOutput(nodes_[nid].GetOpShape().size());
-      } else {
-        ICHECK_EQ(nodes_[nid].op_type_, "const");
-        auto pos = std::find(std::begin(const_names_), std::end(const_names_), name);
-        ICHECK(pos != std::end(const_names_)) << "Found non-existent constant: " << name;
-        const_idx_.push_back(nid);
-        consts.push_back(name);
-      }
-    }
-    ICHECK_EQ(consts.size(), const_names_.size())
-        << "Found mismatch for the number of constants in the graph and required.";
-
-    for (size_t i = 0; i < consts.size(); i++) {
-      ICHECK_EQ(consts[i], const_names_[i])
-          << "The position of constant in the graph must be the same as the required.";
-    }
-
-    // Reserve data entries.
-    data_entry_.resize(NumEntries());
-  }
-
   /*!
    * \brief Set up the constants/weights for inference by binding their DLTensor pointer to
    * the corresponding data entry.
@@ -229,26 +323,62 @@ class JSONRuntimeBase : public ModuleNode {
     }
   }
 
-  // Load the graph.
-  void Load(dmlc::JSONReader* reader) {
-    reader->BeginObject();
-    std::string key;
-    std::string symbol_;
-    while (reader->NextObjectItem(&key)) {
-      if (key == "nodes") {
-        reader->Read(&nodes_);
-      } else if (key == "arg_nodes") {
-        reader->Read(&input_nodes_);
-      } else if (key == "node_row_ptr") {
-        reader->Read(&node_row_ptr_);
-      } else if (key == "heads") {
-        reader->Read(&outputs_);
-      } else if (key == "symbol") {
-        reader->Read(&symbol_);
+  /*!
+   * \brief Get the state of type T a backend prepares from the constants, e.g. its reordered
+   * weights, shared read-only by the instances of the same backend and graph whose constants
+   * hold the same data. It is created by make for the first of them, and released with the last.
+   * The state must keep alive the constants it refers to.
+   *
+   * \param consts The constants of this instance.
+   * \param make The function creating the state from the constants of this instance.
+   * \return The shared state.
+   */
+  template <typename T>
+  std::shared_ptr<const T> GetOrCreateSharedState(const Array<NDArray>& consts,
+                                                  const std::function<std::shared_ptr<T>()>& make) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::weak_ptr<const T>> cache;
+    // The graph is unique per graph json, so its address names it while it is alive.
+    std::ostringstream os;
+    os << type_key() << "/" << symbol_name_ << "/" << graph_.get() << "/" << HashConstants(consts);
+    const std::string key = os.str();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (std::shared_ptr<const T> state = cache[key].lock()) {
+      return state;
+    }
+    for (auto it = cache.begin(); it != cache.end();) {
+      it = it->second.expired() ? cache.erase(it) : std::next(it);
+    }
+    std::shared_ptr<const T> state = make();
+    cache[key] = state;
+    return state;
+  }
+
+  /*!
+   * \brief Hash the shapes, types and data of the constants. The constants which are not on the
+   * host are hashed by address.
+   */
+  static size_t HashConstants(const Array<NDArray>& consts) {
+    // FNV-1a.
+    uint64_t hash = 14695981039346656037ULL;
+    auto update = [&hash](const void* data, size_t size) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+      }
+    };
+    for (const NDArray& value : consts) {
+      const DLTensor* tensor = value.operator->();
+      update(tensor->shape, tensor->ndim * sizeof(int64_t));
+      update(&tensor->dtype, sizeof(tensor->dtype));
+      if (tensor->device.device_type == kDLCPU && value.IsContiguous()) {
+        update(static_cast<const uint8_t*>(tensor->data) + tensor->byte_offset,
+               GetDataSize(*tensor));
       } else {
-        LOG(FATAL) << "Unknown key: " << key;
+        update(&tensor->data, sizeof(tensor->data));
       }
     }
+    return static_cast<size_t>(hash);
   }
 
   // Get the node entry index.
@@ -263,24 +393,26 @@ class JSONRuntimeBase : public ModuleNode {
  protected:
   /*! \brief The only subgraph name for this module. */
   std::string symbol_name_;
+  /*! \brief The parsed graph, shared by the instances of the same graph. */
+  std::shared_ptr<const JSONGraph> graph_;
   /*! \brief The graph. */
-  std::string graph_json_;
+  const std::string& graph_json_;
   /*! \brief The required constant names. */
   Array<String> const_names_;
   /*! \brief The json graph nodes. */
-  std::vector<JSONGraphNode> nodes_;
+  const std::vector<JSONGraphNode>& nodes_;
   /*! \brief The input nodes, including variables and constants. */
-  std::vector<uint32_t> input_nodes_;
+  const std::vector<uint32_t>& input_nodes_;
   /*! \brief Used for quick entry indexing. */
-  std::vector<uint32_t> node_row_ptr_;
+  const std::vector<uint32_t>& node_row_ptr_;
   /*! \brief Output entries. */
-  std::vector<JSONGraphNodeEntry> outputs_;
-  /*! \brief Data of that entry. */
-  std::vector<const DLTensor*> data_entry_;
+  const std::vector<JSONGraphNodeEntry>& outputs_;
   /*! \brief Map the input name to entry id. */
-  std::vector<uint32_t> input_var_eid_;
+  const std::vector<uint32_t>& input_var_eid_;
   /*! \brief input const node index. */
-  std::vector<uint32_t> const_idx_;
+  const std::vector<uint32_t>& const_idx_;
+  /*! \brief Data of that entry, the only graph state owned by the instance. */
+  std::vector<const DLTensor*> data_entry_;
   /*! \brief Indicate if the engine has been initialized. */
   bool initialized_{false};
   /*! \brief Initializer mutex*/
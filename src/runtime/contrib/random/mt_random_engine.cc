@@ -19,7 +19,8 @@
 
 /*!
  * \file random/mt_random_engine.cc
- * \brief mt19937 random engine
+ * \brief Random engine. The samples of randint, uniform and normal are drawn from the Philox
+ *  stream of the seed, in parallel, and the data of random_fill from mt19937.
  */
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/device_api.h>
@@ -33,6 +34,7 @@
 #include <thread>
 
 #include "../3rdparty/compiler-rt/builtin_fp16.h"
+#include "philox.h"
 
 namespace tvm {
 namespace contrib {
@@ -58,6 +60,7 @@ class RandomEngine {
   inline void Seed(unsigned seed) {
     rnd_engine_.seed(seed);
     this->rseed_ = static_cast<unsigned>(seed);
+    this->counter_ = 0;
   }
 
   /*!
@@ -70,6 +73,21 @@ class RandomEngine {
    */
   inline unsigned GetRandInt() { return rnd_engine_(); }
 
+  /*!
+   * \brief Fills a tensor with integers drawn uniformly from [low, high)
+   */
+  template <typename DType>
+  void SampleRandInt(DLTensor* data, int64_t low, int64_t high) {
+    ICHECK_GT(high, low) << "high must be bigger than low";
+    ICHECK(data->strides == nullptr);
+    uint64_t range = static_cast<uint64_t>(high - low);
+    FillBlocks<DType>(data, [&](const PhiloxBlock& block, DType* out) {
+      for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<DType>(low + static_cast<int64_t>(block[i] % range));
+      }
+    });
+  }
+
   /*!
    * \brief Fills a tensor with values drawn from Unif(low, high)
    */
@@ -78,20 +96,13 @@ class RandomEngine {
     ICHECK(data->strides == nullptr);
 
     DLDataType dtype = data->dtype;
-    int64_t size = 1;
-    for (int i = 0; i < data->ndim; ++i) {
-      size *= data->shape[i];
-    }
-
     ICHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
 
-    if (data->device.device_type == kDLCPU) {
-      std::uniform_real_distribution<float> uniform_dist(low, high);
-      std::generate_n(static_cast<float*>(data->data), size,
-                      [&]() { return uniform_dist(rnd_engine_); });
-    } else {
-      LOG(FATAL) << "Do not support random.uniform on this device yet";
-    }
+    FillBlocks<float>(data, [&](const PhiloxBlock& block, float* out) {
+      for (int i = 0; i < 4; ++i) {
+        out[i] = low + (high - low) * PhiloxToUniform(block[i]);
+      }
+    });
   }
 
   /*!
@@ -102,20 +113,14 @@ class RandomEngine {
     ICHECK(data->strides == nullptr);
 
     DLDataType dtype = data->dtype;
-    int64_t size = 1;
-    for (int i = 0; i < data->ndim; ++i) {
-      size *= data->shape[i];
-    }
-
     ICHECK(dtype.code == kDLFloat && dtype.bits == 32 && dtype.lanes == 1);
 
-    if (data->device.device_type == kDLCPU) {
-      std::normal_distribution<float> normal_dist(loc, scale);
-      std::generate_n(static_cast<float*>(data->data), size,
-                      [&]() { return normal_dist(rnd_engine_); });
-    } else {
-      LOG(FATAL) << "Do not support random.normal on this device yet";
-    }
+    FillBlocks<float>(data, [&](const PhiloxBlock& block, float* out) {
+      std::array<float, 4> normal = PhiloxToNormal(block);
+      for (int i = 0; i < 4; ++i) {
+        out[i] = loc + scale * normal[i];
+      }
+    });
   }
 
   void RandomFill(DLTensor* data) {
@@ -143,6 +148,69 @@ class RandomEngine {
   }
 
  private:
+  /*!
+   * \brief Fills a tensor with the next blocks of the Philox stream of the seed, mapped to
+   *  values by fblock(block, out), which writes four values to out. The blocks are filled in
+   *  parallel, and the values only depend on the seed and the index of the element, not on the
+   *  number of threads. Tensors on other devices are filled on the host and copied.
+   */
+  template <typename DType, typename FBlock>
+  void FillBlocks(DLTensor* data, FBlock fblock) {
+    int64_t size = 1;
+    for (int i = 0; i < data->ndim; ++i) {
+      size *= data->shape[i];
+    }
+    runtime::NDArray local;
+    DLTensor* tensor = data;
+    if (data->device.device_type != kDLCPU) {
+      local = runtime::NDArray::Empty(std::vector<int64_t>{data->shape, data->shape + data->ndim},
+                                      data->dtype, {kDLCPU, 0});
+      tensor = const_cast<DLTensor*>(local.operator->());
+    }
+    DType* out = reinterpret_cast<DType*>(static_cast<char*>(tensor->data) + tensor->byte_offset);
+    uint64_t key = rseed_;
+    uint64_t base = counter_;
+    int64_t num_blocks = (size + 3) / 4;
+    ParallelFor(num_blocks, [&](int64_t begin, int64_t end) {
+      DType values[4];
+      for (int64_t b = begin; b < end; ++b) {
+        fblock(Philox4x32(key, base + b), values);
+        std::copy_n(values, std::min<int64_t>(4, size - b * 4), out + b * 4);
+      }
+    });
+    counter_ += num_blocks;
+    if (tensor != data) {
+      runtime::NDArray::CopyFromTo(tensor, data);
+    }
+  }
+
+  /*! \brief Runs f(begin, end) over chunks of [0, n) on the thread pool. */
+  template <typename F>
+  static void ParallelFor(int64_t n, F f) {
+    // Small ranges are not worth waking up the thread pool.
+    constexpr int64_t kMinParallelSize = 4096;
+    if (n < kMinParallelSize) {
+      f(0, n);
+      return;
+    }
+    struct ParallelTask {
+      static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+        ParallelTask* task = static_cast<ParallelTask*>(cdata);
+        int64_t chunk_size = (task->n + penv->num_task - 1) / penv->num_task;
+        int64_t st = std::min(task_id * chunk_size, task->n);
+        int64_t ed = std::min(st + chunk_size, task->n);
+        (*task->f)(st, ed);
+        return 0;
+      }
+
+      F* f;
+      int64_t n;
+    };
+    ParallelTask task{&f, n};
+    int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+    ICHECK_EQ(res, 0) << "ParallelFor: TVMBackendParallelLaunch failed";
+  }
+
   void FillDataImpl(void* data, int64_t st, int64_t ed, DLDataType dtype) {
     // Make the value be 1.0 - 10.0, not (0.0 - 1.0) so that we could satisfy
     // quantized dtype (uint8 / int8) data non-empty requirement
@@ -229,6 +297,8 @@ class RandomEngine {
  private:
   std::mt19937 rnd_engine_;
   unsigned rseed_;
+  /*! \brief The index of the next block of the Philox stream. */
+  uint64_t counter_{0};
 };
 
 }  // namespace contrib
@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file random/philox.h
+ * \brief Philox4x32-10 counter-based random number generator.
+ *
+ * The generator maps a 64-bit key and a 128-bit counter to four 32-bit random words, see
+ * Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011. The i-th block of
+ * four words of a stream only depends on the key and i, so that any range of the stream is
+ * generated independently, e.g. by different threads, with the same result.
+ */
+#ifndef TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+#define TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace tvm {
+namespace contrib {
+
+/*! \brief Four 32-bit random words. */
+using PhiloxBlock = std::array<uint32_t, 4>;
+
+/*!
+ * \brief Returns the block of four random words at a counter of the stream of a key.
+ * \param key The key, i.e. the seed of the stream.
+ * \param counter The index of the block in the stream.
+ */
+inline PhiloxBlock Philox4x32(uint64_t key, uint64_t counter) {
+  constexpr uint32_t kMul0 = 0xD2511F53;
+  constexpr uint32_t kMul1 = 0xCD9E8D57;
+  constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  constexpr uint32_t kWeyl1 = 0xBB67AE85;
+  uint32_t k0 = static_cast<uint32_t>(key);
+  uint32_t k1 = static_cast<uint32_t>(key >> 32);
+  PhiloxBlock ctr = {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0};
+  for (int round = 0; round < 10; ++round) {
+    uint64_t p0 = static_cast<uint64_t>(kMul0) * ctr[0];
+    uint64_t p1 = static_cast<uint64_t>(kMul1) * ctr[2];
+    ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ k0, static_cast<uint32_t>(p1),
+           static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ k1, static_cast<uint32_t>(p0)};
+    k0 += kWeyl0;
+    k1 += kWeyl1;
+  }
+  return ctr;
+}
+
+/*! \brief Maps a random word to a float uniformly distributed in [0, 1). */
+inline float PhiloxToUniform(uint32_t x) { return (x >> 8) * (1.0f / 16777216.0f); }
+
+/*!
+ * \brief Maps four random words to four samples of the standard normal distribution, with the
+ * Box-Muller transform.
+ */
+inline std::array<float, 4> PhiloxToNormal(const PhiloxBlock& block) {
+  constexpr float kTwoPi = 6.283185307179586f;
+  std::array<float, 4> out;
+  for (int i = 0; i < 4; i += 2) {
+    // Sample u1 in (0, 1] so that its log is finite.
+    float u1 = ((block[i] >> 8) + 1) * (1.0f / 16777216.0f);
+    float u2 = PhiloxToUniform(block[i + 1]);
+    float r = std::sqrt(-2.0f * std::log(u1));
+    out[i] = r * std::cos(kTwoPi * u2);
+    out[i + 1] = r * std::sin(kTwoPi * u2);
+  }
+  return out;
+}
+
+}  // namespace contrib
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_CONTRIB_RANDOM_PHILOX_H_
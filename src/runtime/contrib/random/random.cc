@@ -74,34 +74,21 @@ TVM_REGISTER_GLOBAL("tvm.contrib.random.randint").set_body([](TVMArgs args, TVMR
   int64_t low = args[0];
   int64_t high = args[1];
   DLTensor* out = args[2];
-  ICHECK_GT(high, low) << "high must be bigger than low";
-  ICHECK(out->strides == nullptr);
 
-  DLDataType dtype = out->dtype;
-  int64_t size = 1;
-  for (int i = 0; i < out->ndim; ++i) {
-    size *= out->shape[i];
-  }
-
-  DLPACK_INTEGER_TYPE_SWITCH(dtype, DType, {
+  DLPACK_INTEGER_TYPE_SWITCH(out->dtype, DType, {
     int64_t numeric_low = std::numeric_limits<DType>::min();
     int64_t numeric_high = std::numeric_limits<DType>::max();
     numeric_high += 1;  // exclusive upper bound
     low = std::max(low, numeric_low);
     high = std::min(high, numeric_high);
-
-    if (out->device.device_type == kDLCPU) {
-      // file the data with random byte
-      std::generate_n(static_cast<DType*>(out->data), size, [&]() {
-        unsigned rint = entry->random_engine.GetRandInt();
-        return low + rint % (high - low);
-      });
-    } else {
-      LOG(FATAL) << "Do not support random.randint on this device yet";
-    }
+    entry->random_engine.SampleRandInt<DType>(out, low, high);
   })
 });
 
+TVM_REGISTER_GLOBAL("tvm.contrib.random.seed").set_body_typed([](int64_t seed) {
+  RandomThreadLocalEntry::ThreadLocal()->random_engine.Seed(static_cast<unsigned>(seed));
+});
+
 TVM_REGISTER_GLOBAL("tvm.contrib.random.uniform").set_body([](TVMArgs args, TVMRetValue* ret) {
   RandomThreadLocalEntry* entry = RandomThreadLocalEntry::ThreadLocal();
   double low = args[0];
@@ -22,9 +22,16 @@
  */
 
 #include <dlpack/dlpack.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 #include "../../../../3rdparty/compiler-rt/builtin_fp16.h"
@@ -152,60 +159,324 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.argsort_nms").set_body([](TVMArgs args, TV
   }
 });
 
-template <typename DataType, typename OutType>
-void sort_impl(
-    DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend,
-    std::function<void(OutType*, size_t, const std::pair<int64_t, DataType>&)> epilogue) {
-  auto data_ptr = static_cast<DataType*>(input->data);
-  auto out_ptr = static_cast<OutType*>(output->data);
-  std::vector<std::pair<int64_t, DataType>> sorter;
+// Rows shorter than this are sorted by comparison rather than by radix.
+constexpr int64_t kRadixSortMinLength = 256;
+// Rows at least this long are split across the threads when there are fewer rows than threads.
+constexpr int64_t kParallelRowMinLength = 1 << 16;
+// Work on fewer elements than this runs on the calling thread.
+constexpr int64_t kParallelMinElements = 1 << 14;
 
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
+/*!
+ * \brief Runs f(begin, end) over a partition of [0, num_items) on the TVM thread pool.
+ * \param work The number of elements processed, below kParallelMinElements f runs serially.
+ */
+void ParallelFor(int64_t num_items, int64_t work, const std::function<void(int64_t, int64_t)>& f) {
+  if (num_items <= 1 || work < kParallelMinElements) {
+    f(0, num_items);
+    return;
+  }
+  struct ParallelTask {
+    static int RunTask(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+      ParallelTask* task = static_cast<ParallelTask*>(cdata);
+      int64_t chunk_size = (task->num_items + penv->num_task - 1) / penv->num_task;
+      int64_t begin = std::min(task->num_items, task_id * chunk_size);
+      int64_t end = std::min(task->num_items, begin + chunk_size);
+      if (begin < end) {
+        (*task->f)(begin, end);
+      }
+      return 0;
+    }
+
+    int64_t num_items;
+    const std::function<void(int64_t, int64_t)>* f;
+  };
+  ParallelTask task{num_items, &f};
+  int res = TVMBackendParallelLaunch(ParallelTask::RunTask, &task, 0);
+  ICHECK_EQ(res, 0) << "Sort: TVMBackendParallelLaunch failed";
+}
+
+template <typename DataType>
+inline DataType ToComparable(const DataType& value) {
+  return value;
+}
+
+inline float ToComparable(const float16& value) { return value.to_float(); }
+
+#if (__ARM_FEATURE_FP16_SCALAR_ARITHMETIC == 1)
+inline float ToComparable(const __fp16& value) { return value; }
+#endif
+
+// The order of the keys, with NaN after all of the numbers so that it is a strict weak order.
+template <typename DataType>
+inline bool KeyLess(const DataType& lhs, const DataType& rhs) {
+  auto x = ToComparable(lhs);
+  auto y = ToComparable(rhs);
+  if constexpr (std::is_floating_point_v<decltype(x)>) {
+    if (std::isnan(y)) {
+      return !std::isnan(x);
+    }
+    if (std::isnan(x)) {
+      return false;
     }
   }
+  return x < y;
+}
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      sorter.clear();
-      int64_t base_idx = i * input->shape[axis] * axis_mul_after + j;
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        int64_t full_idx = base_idx + k * axis_mul_after;
-        sorter.emplace_back(std::make_pair(k, data_ptr[full_idx]));
+// Orders the positions of a row by their values, breaking ties by position, which gives the
+// order of a stable sort.
+template <typename DataType>
+struct IndexOrder {
+  const DataType* values;
+  bool is_ascend;
+
+  bool operator()(int64_t lhs, int64_t rhs) const {
+    const DataType& x = values[lhs];
+    const DataType& y = values[rhs];
+    if (is_ascend ? KeyLess(x, y) : KeyLess(y, x)) {
+      return true;
+    }
+    if (is_ascend ? KeyLess(y, x) : KeyLess(x, y)) {
+      return false;
+    }
+    return lhs < rhs;
+  }
+};
+
+// Encodes the keys sortable by radix as unsigned integers of the same order.
+template <typename DataType>
+struct RadixKey {
+  using Type = uint8_t;
+  static constexpr bool enabled = false;
+};
+
+template <>
+struct RadixKey<int32_t> {
+  using Type = uint32_t;
+  static constexpr bool enabled = true;
+  static Type Encode(int32_t value) { return static_cast<Type>(value) ^ 0x80000000u; }
+};
+
+template <>
+struct RadixKey<int64_t> {
+  using Type = uint64_t;
+  static constexpr bool enabled = true;
+  static Type Encode(int64_t value) { return static_cast<Type>(value) ^ (Type(1) << 63); }
+};
+
+template <typename Float, typename Bits>
+inline Bits EncodeFloat(Float value) {
+  constexpr Bits kSign = Bits(1) << (sizeof(Bits) * 8 - 1);
+  if (std::isnan(value)) {
+    return ~Bits(0);
+  }
+  // -0.0 and 0.0 are equal.
+  if (value == 0) {
+    value = 0;
+  }
+  Bits bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & kSign) ? ~bits : (bits | kSign);
+}
+
+template <>
+struct RadixKey<float> {
+  using Type = uint32_t;
+  static constexpr bool enabled = true;
+  static Type Encode(float value) { return EncodeFloat<float, Type>(value); }
+};
+
+template <>
+struct RadixKey<double> {
+  using Type = uint64_t;
+  static constexpr bool enabled = true;
+  static Type Encode(double value) { return EncodeFloat<double, Type>(value); }
+};
+
+// Buffers reused across the rows processed by one thread.
+template <typename DataType>
+struct SortWorkspace {
+  std::vector<DataType> values;
+  std::vector<int64_t> indices;
+  std::vector<int64_t> indices_tmp;
+  std::vector<typename RadixKey<DataType>::Type> keys;
+  std::vector<typename RadixKey<DataType>::Type> keys_tmp;
+};
+
+// Stable LSD radix sort of the indices by the keys, one byte per pass. The passes in which all
+// of the keys have the same byte are skipped.
+template <typename UKey>
+void RadixSort(UKey* keys, int64_t* indices, int64_t n, UKey* keys_tmp, int64_t* indices_tmp) {
+  UKey* src_keys = keys;
+  int64_t* src_indices = indices;
+  for (size_t shift = 0; shift < sizeof(UKey) * 8; shift += 8) {
+    int64_t offsets[256] = {0};
+    for (int64_t i = 0; i < n; ++i) {
+      ++offsets[(src_keys[i] >> shift) & 0xff];
+    }
+    if (offsets[(src_keys[0] >> shift) & 0xff] == n) {
+      continue;
+    }
+    int64_t sum = 0;
+    for (int digit = 0; digit < 256; ++digit) {
+      int64_t count = offsets[digit];
+      offsets[digit] = sum;
+      sum += count;
+    }
+    for (int64_t i = 0; i < n; ++i) {
+      int64_t pos = offsets[(src_keys[i] >> shift) & 0xff]++;
+      keys_tmp[pos] = src_keys[i];
+      indices_tmp[pos] = src_indices[i];
+    }
+    std::swap(src_keys, keys_tmp);
+    std::swap(src_indices, indices_tmp);
+  }
+  if (src_indices != indices) {
+    std::copy(src_indices, src_indices + n, indices);
+  }
+}
+
+// Sorts n positions of values, which must be in increasing order, in the order of IndexOrder.
+template <typename DataType>
+void SortIndices(const DataType* values, int64_t* indices, int64_t n, bool is_ascend,
+                 SortWorkspace<DataType>* workspace) {
+  if constexpr (RadixKey<DataType>::enabled) {
+    if (n >= kRadixSortMinLength) {
+      using UKey = typename RadixKey<DataType>::Type;
+      // Descending keys are inverted, so that the equal keys stay in increasing positions.
+      UKey flip = is_ascend ? UKey(0) : ~UKey(0);
+      workspace->keys.resize(n);
+      workspace->keys_tmp.resize(n);
+      workspace->indices_tmp.resize(n);
+      for (int64_t i = 0; i < n; ++i) {
+        workspace->keys[i] = RadixKey<DataType>::Encode(values[indices[i]]) ^ flip;
       }
-      if (is_ascend) {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareAscend<DataType>);
-      } else {
-        std::stable_sort(sorter.begin(), sorter.end(), CompareDescend<DataType>);
+      RadixSort(workspace->keys.data(), indices, n, workspace->keys_tmp.data(),
+                workspace->indices_tmp.data());
+      return;
+    }
+  }
+  std::sort(indices, indices + n, IndexOrder<DataType>{values, is_ascend});
+}
+
+// Sorts the positions of one long row: the chunks are sorted in parallel and merged pairwise.
+template <typename DataType>
+void ParallelSortIndices(const DataType* values, int64_t* indices, int64_t n, bool is_ascend,
+                         int num_chunks) {
+  int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+  ParallelFor(num_chunks, n, [&](int64_t begin, int64_t end) {
+    SortWorkspace<DataType> workspace;
+    for (int64_t chunk = begin; chunk < end; ++chunk) {
+      int64_t lo = std::min(n, chunk * chunk_size);
+      int64_t hi = std::min(n, lo + chunk_size);
+      SortIndices(values, indices + lo, hi - lo, is_ascend, &workspace);
+    }
+  });
+  IndexOrder<DataType> order{values, is_ascend};
+  for (int64_t width = chunk_size; width < n; width *= 2) {
+    int64_t num_merges = (n + 2 * width - 1) / (2 * width);
+    ParallelFor(num_merges, n, [&](int64_t begin, int64_t end) {
+      for (int64_t merge = begin; merge < end; ++merge) {
+        int64_t lo = merge * 2 * width;
+        int64_t mid = std::min(n, lo + width);
+        int64_t hi = std::min(n, lo + 2 * width);
+        std::inplace_merge(indices + lo, indices + mid, indices + hi, order);
       }
-      for (int64_t k = 0; k < input->shape[axis]; ++k) {
-        epilogue(out_ptr, base_idx + k * axis_mul_after, sorter[k]);
+    });
+  }
+}
+
+// The rows of a tensor along the sort axis.
+struct SortRows {
+  SortRows(const DLTensor* input, int axis) : length(input->shape[axis]) {
+    for (int i = 0; i < input->ndim; ++i) {
+      if (i < axis) {
+        axis_mul_before *= input->shape[i];
+      } else if (i > axis) {
+        axis_mul_after *= input->shape[i];
       }
     }
   }
+
+  int64_t num_rows() const { return axis_mul_before * axis_mul_after; }
+
+  // The offset of the first element of a row, in a tensor with row_length along the axis.
+  int64_t Base(int64_t row, int64_t row_length) const {
+    return row / axis_mul_after * row_length * axis_mul_after + row % axis_mul_after;
+  }
+
+  int64_t length;
+  int64_t axis_mul_before{1};
+  int64_t axis_mul_after{1};
+};
+
+// Returns the elements of a row contiguously, copying them to buffer if they are strided.
+template <typename DataType>
+const DataType* LoadRow(const DataType* data, int64_t base, int64_t stride, int64_t length,
+                        std::vector<DataType>* buffer) {
+  if (stride == 1) {
+    return data + base;
+  }
+  buffer->resize(length);
+  for (int64_t k = 0; k < length; ++k) {
+    (*buffer)[k] = data[base + k * stride];
+  }
+  return buffer->data();
+}
+
+// Sorts the rows of input in parallel, and writes either their sorted positions or their sorted
+// values to output.
+template <typename DataType, typename OutType, bool return_indices>
+void sort_impl(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
+  auto data_ptr = static_cast<const DataType*>(input->data);
+  auto out_ptr = static_cast<OutType*>(output->data);
+  SortRows rows(input, axis);
+  int64_t length = rows.length;
+  int64_t stride = rows.axis_mul_after;
+
+  auto write = [&](int64_t base, const DataType* values, const int64_t* indices) {
+    for (int64_t k = 0; k < length; ++k) {
+      if constexpr (return_indices) {
+        out_ptr[base + k * stride] = static_cast<OutType>(indices[k]);
+      } else {
+        out_ptr[base + k * stride] = values[indices[k]];
+      }
+    }
+  };
+
+  int num_threads = threading::MaxConcurrency();
+  if (rows.num_rows() < num_threads && length >= kParallelRowMinLength) {
+    SortWorkspace<DataType> workspace;
+    for (int64_t row = 0; row < rows.num_rows(); ++row) {
+      int64_t base = rows.Base(row, length);
+      const DataType* values = LoadRow(data_ptr, base, stride, length, &workspace.values);
+      workspace.indices.resize(length);
+      std::iota(workspace.indices.begin(), workspace.indices.end(), 0);
+      ParallelSortIndices(values, workspace.indices.data(), length, is_ascend, num_threads);
+      write(base, values, workspace.indices.data());
+    }
+    return;
+  }
+  ParallelFor(rows.num_rows(), rows.num_rows() * length, [&](int64_t begin, int64_t end) {
+    SortWorkspace<DataType> workspace;
+    for (int64_t row = begin; row < end; ++row) {
+      int64_t base = rows.Base(row, length);
+      const DataType* values = LoadRow(data_ptr, base, stride, length, &workspace.values);
+      workspace.indices.resize(length);
+      std::iota(workspace.indices.begin(), workspace.indices.end(), 0);
+      SortIndices(values, workspace.indices.data(), length, is_ascend, &workspace);
+      write(base, values, workspace.indices.data());
+    }
+  });
 }
 
 template <typename DataType, typename OutType>
 void argsort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
-  return sort_impl<DataType, OutType>(
-      input, output, axis, is_ascend,
-      [](OutType* out_ptr, size_t index, const std::pair<int64_t, DataType>& sort_pair) {
-        out_ptr[index] = static_cast<OutType>(sort_pair.first);
-      });
+  return sort_impl<DataType, OutType, true>(input, output, axis, is_ascend);
 }
 
 template <typename DataType>
 void sort(DLTensor* input, DLTensor* output, int32_t axis, bool is_ascend) {
-  return sort_impl<DataType, DataType>(
-      input, output, axis, is_ascend,
-      [](DataType* out_ptr, size_t index, const std::pair<int64_t, DataType>& sort_pair) {
-        out_ptr[index] = sort_pair.second;
-      });
+  return sort_impl<DataType, DataType, false>(input, output, axis, is_ascend);
 }
 
 // Argsort implemented C library sort.
@@ -346,90 +617,104 @@ TVM_REGISTER_GLOBAL("tvm.contrib.sort.sort").set_body([](TVMArgs args, TVMRetVal
   }
 });
 
+// Writes the positions of the top min(k, end - begin) elements of [begin, end) to top, best
+// first. A heap of k positions is kept when k is much smaller than the range, else the range is
+// partitioned by nth_element.
+template <typename DataType>
+void SelectTopK(const DataType* values, int64_t begin, int64_t end, int64_t k, bool is_ascend,
+                std::vector<int64_t>* top) {
+  IndexOrder<DataType> order{values, is_ascend};
+  int64_t n = end - begin;
+  int64_t m = std::min(k, n);
+  top->clear();
+  if (m * 8 < n) {
+    // The heap has the worst of the top elements at its front.
+    for (int64_t i = begin; i < begin + m; ++i) {
+      top->push_back(i);
+    }
+    std::make_heap(top->begin(), top->end(), order);
+    for (int64_t i = begin + m; i < end; ++i) {
+      if (order(i, top->front())) {
+        std::pop_heap(top->begin(), top->end(), order);
+        top->back() = i;
+        std::push_heap(top->begin(), top->end(), order);
+      }
+    }
+    std::sort_heap(top->begin(), top->end(), order);
+  } else {
+    top->resize(n);
+    std::iota(top->begin(), top->end(), begin);
+    std::nth_element(top->begin(), top->begin() + m, top->end(), order);
+    top->resize(m);
+    std::sort(top->begin(), top->end(), order);
+  }
+}
+
 template <typename DataType, typename IndicesType>
 void topk(DLTensor* input, DLTensor* out_values, DLTensor* out_indices, int k, int axis,
           bool is_ascend) {
-  DataType* data_ptr = static_cast<DataType*>(input->data);
+  auto data_ptr = static_cast<const DataType*>(input->data);
   DataType* values_ptr =
       (out_values == nullptr) ? nullptr : static_cast<DataType*>(out_values->data);
   IndicesType* indices_ptr =
       (out_indices == nullptr) ? nullptr : static_cast<IndicesType*>(out_indices->data);
 
-  // Maintain a min/max containing the top-k elements
-  std::vector<std::pair<int64_t, DataType>> running_heap;
-
-  // Need +1 when inserting new element before maintaining heap invariant
-  running_heap.reserve(k + 1);
-
-  int axis_mul_before = 1;
-  int axis_mul_after = 1;
-  for (int i = 0; i < input->ndim; ++i) {
-    if (i < axis) {
-      axis_mul_before *= input->shape[i];
-    } else if (i > axis) {
-      axis_mul_after *= input->shape[i];
-    }
-  }
+  SortRows rows(input, axis);
+  int64_t length = rows.length;
+  int64_t stride = rows.axis_mul_after;
   if (k < 1) {
-    k = input->shape[axis];
+    k = length;
   }
 
-  for (int i = 0; i < axis_mul_before; ++i) {
-    for (int j = 0; j < axis_mul_after; ++j) {
-      running_heap.clear();
-      int64_t src_base_idx = i * input->shape[axis] * axis_mul_after + j;
-      int64_t dst_base_idx = i * k * axis_mul_after + j;
-
-      // Start by creating min/max heap with fixed-k elements
-      int cur_axis_index = 0;
-      for (; cur_axis_index < k && cur_axis_index < input->shape[axis]; cur_axis_index++) {
-        int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        running_heap.emplace_back(std::make_pair(cur_axis_index, data_ptr[full_idx]));
-      }
-      if (!is_ascend) {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-      } else {
-        std::make_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
+  auto write = [&](int64_t row, const DataType* values, const std::vector<int64_t>& top) {
+    int64_t dst_base_idx = rows.Base(row, k);
+    for (int64_t kk = 0; kk < static_cast<int64_t>(top.size()); ++kk) {
+      if (indices_ptr != nullptr) {
+        indices_ptr[dst_base_idx + kk * stride] = static_cast<IndicesType>(top[kk]);
       }
-
-      // Iterate through all elements, adding to heap along the way
-      for (; cur_axis_index < input->shape[axis]; cur_axis_index++) {
-        int64_t full_idx = src_base_idx + cur_axis_index * axis_mul_after;
-        std::pair<int64_t, DataType> cur_val = {cur_axis_index, data_ptr[full_idx]};
-
-        // Eq. to cur_val.second > running_heap.second
-        if (!is_ascend && CompareDescend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-          running_heap.pop_back();
-        } else if (is_ascend && CompareAscend<DataType, true>(cur_val, running_heap[0])) {
-          running_heap.push_back(cur_val);
-          std::push_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          std::pop_heap(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-          running_heap.pop_back();
-        }
+      if (values_ptr != nullptr) {
+        values_ptr[dst_base_idx + kk * stride] = values[top[kk]];
       }
-
-      // finally sort heap and deliver results
-      if (is_ascend) {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareAscend<DataType, true>);
-      } else {
-        std::stable_sort(running_heap.begin(), running_heap.end(), CompareDescend<DataType, true>);
-      }
-
-      for (uint32_t kk = 0; kk < running_heap.size(); ++kk) {
-        if (indices_ptr != nullptr) {
-          indices_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<IndicesType>(running_heap[kk].first);
-        }
-        if (values_ptr != nullptr) {
-          values_ptr[dst_base_idx + kk * axis_mul_after] =
-              static_cast<DataType>(running_heap[kk].second);
+    }
+  };
+
+  int num_threads = threading::MaxConcurrency();
+  if (rows.num_rows() < num_threads && length >= kParallelRowMinLength) {
+    // Select the top k of each chunk of the row in parallel, then the top k of those.
+    std::vector<DataType> buffer;
+    std::vector<std::vector<int64_t>> candidates(num_threads);
+    std::vector<int64_t> top;
+    int64_t chunk_size = (length + num_threads - 1) / num_threads;
+    for (int64_t row = 0; row < rows.num_rows(); ++row) {
+      const DataType* values =
+          LoadRow(data_ptr, rows.Base(row, length), stride, length, &buffer);
+      ParallelFor(num_threads, length, [&](int64_t begin, int64_t end) {
+        for (int64_t chunk = begin; chunk < end; ++chunk) {
+          int64_t lo = std::min(length, chunk * chunk_size);
+          int64_t hi = std::min(length, lo + chunk_size);
+          SelectTopK(values, lo, hi, k, is_ascend, &candidates[chunk]);
         }
+      });
+      top.clear();
+      for (const auto& chunk_top : candidates) {
+        top.insert(top.end(), chunk_top.begin(), chunk_top.end());
       }
+      std::sort(top.begin(), top.end(), IndexOrder<DataType>{values, is_ascend});
+      top.resize(std::min<int64_t>(k, top.size()));
+      write(row, values, top);
     }
+    return;
   }
+  ParallelFor(rows.num_rows(), rows.num_rows() * length, [&](int64_t begin, int64_t end) {
+    std::vector<DataType> buffer;
+    std::vector<int64_t> top;
+    for (int64_t row = begin; row < end; ++row) {
+      const DataType* values =
+          LoadRow(data_ptr, rows.Base(row, length), stride, length, &buffer);
+      SelectTopK(values, 0, length, k, is_ascend, &top);
+      write(row, values, top);
+    }
+  });
 }
 
 // Argsort implemented C library sort.
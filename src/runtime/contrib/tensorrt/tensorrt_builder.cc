@@ -26,6 +26,7 @@
 
 #include <tvm/runtime/ndarray.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -95,6 +96,7 @@ void TensorRTBuilder::AddInput(int nid, uint32_t entry_id, const JSONGraphNode&
     node_output_map_[nid].push_back(TensorRTOpInput(input_tensor));
     network_input_names_.push_back(name);
     entry_id_map_[name] = entry_id + i;
+    input_shapes_[name] = shape;
   }
 }
 
@@ -123,6 +125,11 @@ void TensorRTBuilder::AddOutput(const JSONGraphNodeEntry& node, uint32_t entry_i
   entry_id_map_[name] = entry_id;
 }
 
+void TensorRTBuilder::SetOptimizationProfiles(std::vector<TensorRTOptimizationProfile> profiles) {
+  ICHECK(!use_implicit_batch_) << "Optimization profiles require explicit batch mode.";
+  profiles_ = std::move(profiles);
+}
+
 void TensorRTBuilder::AddLayer(int nid, const JSONGraphNode& node) {
   TensorRTOpConverterParams params(network_, nid, node, &trt_weights_);
   // Look up converter.
@@ -183,7 +190,35 @@ TensorRTEngineAndContext TensorRTBuilder::BuildEngine() {
   }
 
   // Add profiles.
-  if (!use_implicit_batch_) {
+  if (!use_implicit_batch_ && !profiles_.empty()) {
+    for (const TensorRTOptimizationProfile& profile : profiles_) {
+      auto trt_profile = builder_->createOptimizationProfile();
+      for (int i = 0; i < network_->getNbInputs(); ++i) {
+        const std::string name = network_->getInput(i)->getName();
+        const std::vector<int64_t>& graph_shape = input_shapes_[name];
+        auto get_dims = [&](const std::unordered_map<std::string, std::vector<int64_t>>& shapes) {
+          auto it = shapes.find(name);
+          if (it == shapes.end()) {
+            ICHECK(std::none_of(graph_shape.begin(), graph_shape.end(),
+                                [](int64_t dim) { return dim < 0; }))
+                << "Optimization profile is missing the dynamic input " << name;
+            return VectorToTrtDims(graph_shape);
+          }
+          ICHECK_EQ(it->second.size(), graph_shape.size())
+              << "Optimization profile has a wrong rank for input " << name;
+          return VectorToTrtDims(it->second);
+        };
+        trt_profile->setDimensions(name.c_str(), nvinfer1::OptProfileSelector::kMIN,
+                                   get_dims(profile.min_shapes));
+        trt_profile->setDimensions(name.c_str(), nvinfer1::OptProfileSelector::kOPT,
+                                   get_dims(profile.opt_shapes));
+        trt_profile->setDimensions(name.c_str(), nvinfer1::OptProfileSelector::kMAX,
+                                   get_dims(profile.max_shapes));
+      }
+      ICHECK(trt_profile->isValid()) << "Invalid optimization profile, min <= opt <= max must hold";
+      config_->addOptimizationProfile(trt_profile);
+    }
+  } else if (!use_implicit_batch_) {
     auto profile = builder_->createOptimizationProfile();
     for (int i = 0; i < network_->getNbInputs(); ++i) {
       auto name = network_->getInput(i)->getName();
@@ -207,7 +242,10 @@ TensorRTEngineAndContext TensorRTBuilder::BuildEngine() {
 #else
   nvinfer1::ICudaEngine* engine = builder_->buildCudaEngine(*network_);
 #endif
-  ICHECK_EQ(engine->getNbBindings(), network_input_names_.size() + network_output_names_.size());
+  // The bindings are repeated for each optimization profile.
+  const size_t num_profiles = profiles_.empty() ? 1 : profiles_.size();
+  ICHECK_EQ(engine->getNbBindings(),
+            (network_input_names_.size() + network_output_names_.size()) * num_profiles);
   nvinfer1::IExecutionContext* context = engine->createExecutionContext();
   CleanUp();
 
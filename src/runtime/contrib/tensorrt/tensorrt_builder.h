@@ -43,6 +43,20 @@ namespace contrib {
 using JSONGraphNode = tvm::runtime::json::JSONGraphNode;
 using JSONGraphNodeEntry = tvm::runtime::json::JSONGraphNodeEntry;
 
+/*!
+ * \brief An optimization profile of an engine in explicit batch mode: the range of input shapes
+ * the engine supports, and the shapes it is tuned for. The inputs which are not listed keep
+ * their static shapes.
+ */
+struct TensorRTOptimizationProfile {
+  /*! \brief Map of input binding name to its smallest shape. */
+  std::unordered_map<std::string, std::vector<int64_t>> min_shapes;
+  /*! \brief Map of input binding name to the shape to tune the kernels for. */
+  std::unordered_map<std::string, std::vector<int64_t>> opt_shapes;
+  /*! \brief Map of input binding name to its largest shape. */
+  std::unordered_map<std::string, std::vector<int64_t>> max_shapes;
+};
+
 /*!
  * \brief The product of TensorRTBuilder which provides everything needed to
  * perform inference.
@@ -52,6 +66,11 @@ struct TensorRTEngineAndContext {
   nvinfer1::IExecutionContext* context = nullptr;
   std::vector<std::string> inputs;
   std::vector<std::string> outputs;
+  /*!
+   * \brief One context per optimization profile, the first being context, when the engine was
+   * built for a set of optimization profiles. Empty otherwise.
+   */
+  std::vector<nvinfer1::IExecutionContext*> profile_contexts;
 };
 
 /*!
@@ -104,6 +123,13 @@ class TensorRTBuilder {
    */
   void AddOutput(const JSONGraphNodeEntry& entry, uint32_t entry_id);
 
+  /*!
+   * \brief Build the engine for the given optimization profiles instead of the shapes of the
+   * current inputs. Only supported in explicit batch mode.
+   * \param profiles The optimization profiles, each becoming one profile of the engine.
+   */
+  void SetOptimizationProfiles(std::vector<TensorRTOptimizationProfile> profiles);
+
   /*!
    * \brief Takes network definition and "compiles" a TensorRT engine which can be used for
    * inference. This step is time confusing.
@@ -144,6 +170,12 @@ class TensorRTBuilder {
   /*! \brief Map TensorRT binding name to index in data_entry_. */
   std::unordered_map<std::string, uint32_t> entry_id_map_;
 
+  /*! \brief Map TensorRT input binding name to its shape in the graph, -1 for dynamic dims. */
+  std::unordered_map<std::string, std::vector<int64_t>> input_shapes_;
+
+  /*! \brief Optimization profiles to build the engine for, if any. */
+  std::vector<TensorRTOptimizationProfile> profiles_;
+
   /*! \brief Max workspace size in bytes for TRT. */
   size_t max_workspace_size_;
 
@@ -26,8 +26,12 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include <cstdlib>
 #include <fstream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -113,7 +117,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
         << "The number of input constants must match the number of required.";
     LoadGlobalAttributes();
     SetupConstants(consts);
+    LoadOptimizationProfiles();
     GetCachedEnginesFromDisk();
+    BuildProfileEngine();
   }
 
   void LoadGlobalAttributes() {
@@ -145,6 +151,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
     for (auto& it : trt_engine_cache_) {
       VLOG(1) << "Destroying TensorRT context for function '" << it.first.first << "' (batch size "
               << it.first.second << ")";
+      for (size_t i = 1; i < it.second.profile_contexts.size(); ++i) {
+        it.second.profile_contexts[i]->destroy();
+      }
       it.second.context->destroy();
       VLOG(1) << "Destroying TensorRT engine for function '" << it.first.first << "' (batch size "
               << it.first.second << ")";
@@ -167,6 +176,13 @@ class TensorRTRuntime : public JSONRuntimeBase {
     auto engine = engine_and_context.engine;
     auto context = engine_and_context.context;
     const int num_bindings = engine->getNbBindings();
+    // The bindings of optimization profile k follow those of the k first profiles.
+    int binding_offset = 0;
+    if (!engine_and_context.profile_contexts.empty()) {
+      const int profile = SelectOptimizationProfile();
+      context = engine_and_context.profile_contexts[profile];
+      binding_offset = profile * num_bindings / engine_and_context.profile_contexts.size();
+    }
     std::vector<void*> bindings(num_bindings, nullptr);
     std::vector<size_t> binding_sizes(num_bindings, 0);
     // Setup input bindings.
@@ -178,6 +194,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
           const std::string name = nodes_[nid].GetOpName() + "_" + std::to_string(j);
           int binding_index = engine->getBindingIndex(name.c_str());
           ICHECK_NE(binding_index, -1);
+          binding_index += binding_offset;
 #if TRT_VERSION_GE(6, 0, 1)
           if (!use_implicit_batch_) {
             std::vector<int64_t> shape(data_entry_[eid]->shape,
@@ -219,6 +236,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
       const std::string& name = engine_and_context.outputs[i];
       int binding_index = engine->getBindingIndex(name.c_str());
       ICHECK_NE(binding_index, -1);
+      binding_index += binding_offset;
       if (data_entry_[eid]->device.device_type == kDLCUDA) {
         bindings[binding_index] = data_entry_[eid]->data;
       } else {
@@ -243,6 +261,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
       const std::string& name = engine_and_context.outputs[i];
       int binding_index = engine->getBindingIndex(name.c_str());
       ICHECK_NE(binding_index, -1);
+      binding_index += binding_offset;
       if (data_entry_[eid]->device.device_type != kDLCUDA) {
         auto device_buffer = GetOrAllocateDeviceBuffer(eid, binding_index);
         device_buffer.CopyTo(const_cast<DLTensor*>(data_entry_[eid]));
@@ -280,6 +299,10 @@ class TensorRTRuntime : public JSONRuntimeBase {
    * already built, do nothing.
    */
   TensorRTEngineAndContext& GetOrBuildEngine() {
+    if (!profiles_.empty()) {
+      // The engine of the optimization profiles is built ahead of time in Init.
+      return trt_engine_cache_.at(std::make_pair(symbol_name_, kProfileSetBatchSize));
+    }
     int batch_size = GetBatchSize();
     int compatible_engine_batch_size = -1;
     bool find_engine_flag = FindCompatibleEngine(batch_size, &compatible_engine_batch_size);
@@ -317,7 +340,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
 
     VLOG(1) << "Finished building TensorRT engine for subgraph " << symbol_name_
             << " with batch size " << batch_size;
-    CacheEngineToDisk();
+    CacheEngineToDisk(batch_size);
     return trt_engine_cache_.at(std::make_pair(symbol_name_, batch_size));
   }
 
@@ -325,6 +348,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
     const bool use_fp16 = dmlc::GetEnv("TVM_TENSORRT_USE_FP16", false) || use_fp16_;
     TensorRTBuilder builder(&logger_, data_entry_, max_workspace_size_, use_implicit_batch_,
                             use_fp16, batch_size, calibrator_.get());
+    if (!profiles_.empty()) {
+      builder.SetOptimizationProfiles(profiles_);
+    }
     for (size_t i = 0; i < input_nodes_.size(); ++i) {
       auto nid = input_nodes_[i];
       const auto& node = nodes_[nid];
@@ -351,6 +377,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
     }
 
     TensorRTEngineAndContext engine_and_context = builder.BuildEngine();
+    if (!profiles_.empty()) {
+      CreateProfileContexts(&engine_and_context);
+    }
     trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
   }
 
@@ -388,6 +417,9 @@ class TensorRTRuntime : public JSONRuntimeBase {
     helper.DeclareField("outputs", &engine_and_context.outputs);
     helper.DeclareField("batch_size", &batch_size);
     helper.ReadAllFields(&reader);
+    if (batch_size == kProfileSetBatchSize) {
+      CreateProfileContexts(&engine_and_context);
+    }
     trt_engine_cache_[std::make_pair(symbol_name_, batch_size)] = engine_and_context;
     max_batch_size_ = batch_size;
     LOG(INFO) << "finished loading engine and context ... ";
@@ -397,8 +429,7 @@ class TensorRTRuntime : public JSONRuntimeBase {
   /*! \brief If TVM_TENSORRT_CACHE_DIR is set, will save the engine to that
    * directory so it can be loaded later.
    */
-  void CacheEngineToDisk() {
-    int batch_size = GetBatchSize();
+  void CacheEngineToDisk(int batch_size) {
     std::string cache_dir = dmlc::GetEnv("TVM_TENSORRT_CACHE_DIR", std::string(""));
     if (cache_dir.empty()) return;
     std::string key = GetSubgraphKey();
@@ -428,7 +459,131 @@ class TensorRTRuntime : public JSONRuntimeBase {
     // Using this key will only allow a single model per TVM_TENSORRT_CACHE_DIR directory. We could
     // instead use a hash of graph_json and all weights to allow many models in the same directory,
     // but the cost of computing the hash is high.
-    return symbol_name_ + (dmlc::GetEnv("TVM_TENSORRT_USE_FP16", false) ? "_fp16" : "_fp32");
+    std::string key =
+        symbol_name_ + (dmlc::GetEnv("TVM_TENSORRT_USE_FP16", false) ? "_fp16" : "_fp32");
+    // Engines of different profile sets must not replace each other.
+    return profiles_.empty() ? key : key + "_profiles_" + profiles_key_;
+  }
+
+  /*!
+   * \brief If TVM_TENSORRT_PROFILES is set, read the optimization profiles of the subgraph from
+   * that JSON file. It maps each subgraph symbol name, or "*" for all subgraphs, to a list of
+   * profiles. Each profile maps input binding names to their "min", "opt" and "max" shapes:
+   *
+   *   {"tensorrt_0": [{"x_0": {"min": [1, 16], "opt": [8, 128], "max": [32, 512]}}]}
+   *
+   * The subgraph then runs on a single engine holding all of its profiles, which is built ahead
+   * of time in Init, so that no engine is built at inference time.
+   */
+  void LoadOptimizationProfiles() {
+    std::string path = dmlc::GetEnv("TVM_TENSORRT_PROFILES", std::string(""));
+    if (path.empty()) return;
+    using ProfileConfig = std::map<std::string, std::map<std::string, std::vector<int64_t>>>;
+    std::map<std::string, std::vector<ProfileConfig>> config;
+    std::string serialized_config;
+    LoadBinaryFromFile(path, &serialized_config);
+    std::istringstream is(serialized_config);
+    dmlc::JSONReader reader(&is);
+    reader.Read(&config);
+    auto it = config.count(symbol_name_) ? config.find(symbol_name_) : config.find("*");
+    if (it == config.end() || it->second.empty()) return;
+#if TRT_VERSION_GE(6, 0, 1)
+    if (use_implicit_batch_) {
+      LOG(WARNING) << "Ignoring the optimization profiles of TensorRT subgraph " << symbol_name_
+                   << ", which uses implicit batch mode.";
+      return;
+    }
+    ICHECK(!dmlc::GetEnv("TVM_TENSORRT_USE_INT8", false))
+        << "INT8 calibration is not supported with optimization profiles";
+    for (const ProfileConfig& profile_config : it->second) {
+      TensorRTOptimizationProfile profile;
+      for (const auto& kv : profile_config) {
+        for (const char* selector : {"min", "opt", "max"}) {
+          ICHECK(kv.second.count(selector))
+              << "Optimization profile is missing the " << selector << " shape of " << kv.first;
+        }
+        profile.min_shapes[kv.first] = kv.second.at("min");
+        profile.opt_shapes[kv.first] = kv.second.at("opt");
+        profile.max_shapes[kv.first] = kv.second.at("max");
+      }
+      profiles_.push_back(std::move(profile));
+    }
+    std::ostringstream os;
+    dmlc::JSONWriter writer(&os);
+    writer.Write(it->second);
+    profiles_key_ = std::to_string(std::hash<std::string>()(os.str()));
+#else
+    LOG(WARNING) << "Optimization profiles require TensorRT 6.0.1 or greater.";
+#endif
+  }
+
+  /*! \brief Build the engine of the optimization profiles, unless it was loaded from disk. */
+  void BuildProfileEngine() {
+    if (profiles_.empty() ||
+        trt_engine_cache_.count(std::make_pair(symbol_name_, kProfileSetBatchSize))) {
+      return;
+    }
+    LOG(INFO) << "Building TensorRT engine for subgraph " << symbol_name_ << " with "
+              << profiles_.size() << " optimization profiles";
+    BuildEngineFromJson(kProfileSetBatchSize);
+    CacheEngineToDisk(kProfileSetBatchSize);
+  }
+
+  /*! \brief Create the execution context of each optimization profile of the engine. */
+  void CreateProfileContexts(TensorRTEngineAndContext* engine_and_context) {
+#if TRT_VERSION_GE(6, 0, 1)
+    engine_and_context->profile_contexts = {engine_and_context->context};
+    for (int i = 1; i < engine_and_context->engine->getNbOptimizationProfiles(); ++i) {
+      nvinfer1::IExecutionContext* context = engine_and_context->engine->createExecutionContext();
+      ICHECK(context->setOptimizationProfile(i));
+      engine_and_context->profile_contexts.push_back(context);
+    }
+#endif
+  }
+
+  /*!
+   * \brief Select the optimization profile whose range holds the shapes of the current inputs,
+   * preferring the one whose opt shapes are the closest.
+   */
+  int SelectOptimizationProfile() {
+    int best = -1;
+    int64_t best_distance = std::numeric_limits<int64_t>::max();
+    for (size_t k = 0; k < profiles_.size(); ++k) {
+      const TensorRTOptimizationProfile& profile = profiles_[k];
+      bool fits = true;
+      int64_t distance = 0;
+      for (size_t i = 0; i < input_nodes_.size() && fits; ++i) {
+        auto nid = input_nodes_[i];
+        if (nodes_[nid].GetOpType() != "input") continue;
+        for (size_t j = 0; j < nodes_[nid].GetOpShape().size() && fits; ++j) {
+          const std::string name = nodes_[nid].GetOpName() + "_" + std::to_string(j);
+          auto it = profile.opt_shapes.find(name);
+          if (it == profile.opt_shapes.end()) continue;
+          const DLTensor* data = data_entry_[EntryID(nid, j)];
+          const std::vector<int64_t>& min_shape = profile.min_shapes.at(name);
+          const std::vector<int64_t>& max_shape = profile.max_shapes.at(name);
+          fits = static_cast<size_t>(data->ndim) == it->second.size();
+          for (int d = 0; d < data->ndim && fits; ++d) {
+            fits = min_shape[d] <= data->shape[d] && data->shape[d] <= max_shape[d];
+            distance += std::abs(data->shape[d] - it->second[d]);
+          }
+        }
+      }
+      if (fits && distance < best_distance) {
+        best = static_cast<int>(k);
+        best_distance = distance;
+      }
+    }
+    if (best == -1) {
+      std::ostringstream os;
+      for (uint32_t eid : input_var_eid_) {
+        const DLTensor* data = data_entry_[eid];
+        os << " " << ShapeTuple(data->shape, data->shape + data->ndim);
+      }
+      LOG(FATAL) << "No optimization profile of TensorRT subgraph " << symbol_name_
+                 << " holds the input shapes" << os.str();
+    }
+    return best;
   }
 
   /*! \brief Retreive a GPU buffer for input or output or allocate if needed. */
@@ -436,13 +591,14 @@ class TensorRTRuntime : public JSONRuntimeBase {
     std::vector<int64_t> shape(data_entry_[entry_id]->shape,
                                data_entry_[entry_id]->shape + data_entry_[entry_id]->ndim);
     if (device_buffers_.count(binding_index)) {
-      // Buffer is already initialized.
-      if (shape[0] > device_buffers_[binding_index]->shape[0]) {
+      // Buffer is already initialized. Any dim may be dynamic, so compare the sizes.
+      const DLTensor* buffer = device_buffers_[binding_index].operator->();
+      if (GetDataSize(*data_entry_[entry_id]) > GetDataSize(*buffer)) {
         // Buffer is too small. Need to allocate bigger buffer.
         device_buffers_[binding_index] =
             runtime::NDArray::Empty(shape, data_entry_[entry_id]->dtype, {kDLCUDA, 0});
-      } else if (shape[0] < device_buffers_[binding_index]->shape[0]) {
-        // Buffer is too large. Create view.
+      } else if (shape != std::vector<int64_t>(buffer->shape, buffer->shape + buffer->ndim)) {
+        // Buffer is too large or of another shape. Create view.
         return device_buffers_[binding_index].CreateView(shape, data_entry_[entry_id]->dtype);
       }
     } else {
@@ -464,10 +620,22 @@ class TensorRTRuntime : public JSONRuntimeBase {
     calibrator_.reset(new TensorRTCalibrator(batch_size, input_names));
   }
 
-  /*! \brief Map of function name and max batch size to TRT engine if built already. */
+  /*!
+   * \brief Map of function name and max batch size to TRT engine if built already. The engine of
+   * the optimization profiles has the batch size kProfileSetBatchSize.
+   */
   std::unordered_map<std::pair<std::string, int>, TensorRTEngineAndContext, PairHash>
       trt_engine_cache_;
 
+  /*! \brief The batch size key of the engine built for the optimization profiles. */
+  static constexpr int kProfileSetBatchSize = -1;
+
+  /*! \brief Optimization profiles of the subgraph, read from TVM_TENSORRT_PROFILES. */
+  std::vector<TensorRTOptimizationProfile> profiles_;
+
+  /*! \brief Hash of the optimization profiles, naming their engine in the disk cache. */
+  std::string profiles_key_;
+
   /*! \brief Calibrator for INT8 mode. */
   std::unique_ptr<TensorRTCalibrator> calibrator_;
 
@@ -491,9 +659,13 @@ class TensorRTRuntime : public JSONRuntimeBase {
                  << "Please build with USE_TENSORRT_RUNTIME.";
   }
 
+  void LoadOptimizationProfiles() {}
+
   bool GetCachedEnginesFromDisk() { return false; }
 
-  void CacheEngineToDisk() {}
+  void BuildProfileEngine() {}
+
+  void CacheEngineToDisk(int batch_size) {}
 #endif  // TVM_GRAPH_EXECUTOR_TENSORRT
 
   bool use_implicit_batch_;
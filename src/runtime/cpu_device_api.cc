@@ -24,18 +24,65 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 #include "workspace_pool.h"
 
 #ifdef __ANDROID__
 #include <android/api-level.h>
 #endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace tvm {
 namespace runtime {
+
+/*!
+ * \brief How CPUDeviceAPI backs its data space allocations, set from the environment
+ *  variables TVM_CPU_HUGE_PAGE_THRESHOLD, TVM_CPU_HUGETLB and TVM_CPU_PREFAULT, or from
+ *  runtime.SetCPUAllocPolicy. Only Linux honors it.
+ */
+struct CPUAllocPolicy {
+  /*! \brief Allocations of at least this many bytes get huge pages, none if negative. */
+  std::atomic<int64_t> huge_page_threshold{-1};
+  /*!
+   * \brief Take the huge pages from the hugetlbfs pool with MAP_HUGETLB instead of asking
+   *  for transparent huge pages, falling back to the latter when the pool is exhausted.
+   */
+  std::atomic<bool> use_hugetlb{false};
+  /*!
+   * \brief Touch every page when allocating, so the page faults of e.g. the storage of an
+   *  executor are taken at setup rather than by the first request.
+   */
+  std::atomic<bool> prefault{false};
+
+  static CPUAllocPolicy* Global() {
+    static auto* inst = []() {
+      auto* policy = new CPUAllocPolicy();
+      if (const char* val = getenv("TVM_CPU_HUGE_PAGE_THRESHOLD")) {
+        policy->huge_page_threshold = atoll(val);
+      }
+      if (const char* val = getenv("TVM_CPU_HUGETLB")) {
+        policy->use_hugetlb = atoi(val) != 0;
+      }
+      if (const char* val = getenv("TVM_CPU_PREFAULT")) {
+        policy->prefault = atoi(val) != 0;
+      }
+      return policy;
+    }();
+    return inst;
+  }
+};
+
 class CPUDeviceAPI final : public DeviceAPI {
  public:
   void SetDevice(Device dev) final {}
@@ -52,6 +99,46 @@ class CPUDeviceAPI final : public DeviceAPI {
 #elif defined(__ANDROID__) && __ANDROID_API__ < 17
     ptr = memalign(alignment, nbytes);
     if (ptr == nullptr) throw std::bad_alloc();
+#elif defined(__linux__) && !defined(__ANDROID__)
+    CPUAllocPolicy* policy = CPUAllocPolicy::Global();
+    int64_t huge_page_threshold = policy->huge_page_threshold;
+    bool huge = huge_page_threshold >= 0 && static_cast<int64_t>(nbytes) >= huge_page_threshold;
+    // Allocations of a thread pool bound to a NUMA node are placed on that node, which
+    // needs them to start on a page boundary.
+    int numa_node = threading::BoundNumaNode();
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    bool bind_numa = numa_node >= 0 && nbytes >= page_size;
+    ptr = nullptr;
+#ifdef MAP_HUGETLB
+    if (huge && policy->use_hugetlb) {
+      ptr = MapHugeTLB(nbytes);
+    }
+#endif
+    if (ptr == nullptr) {
+      if (huge) {
+        alignment = std::max(alignment, kHugePageSize);
+      } else if (bind_numa) {
+        alignment = std::max(alignment, page_size);
+      }
+      int ret = posix_memalign(&ptr, alignment, nbytes);
+      if (ret != 0) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+      if (huge) {
+        // Only a hint: the kernel may have transparent huge pages disabled.
+        madvise(ptr, nbytes, MADV_HUGEPAGE);
+      }
+#endif
+    }
+    if (bind_numa) {
+      threading::BindMemoryToNumaNode(ptr, nbytes, numa_node);
+    }
+    if (policy->prefault) {
+      // Touch the pages after binding them, so they are faulted in on the right node.
+      volatile char* bytes = static_cast<char*>(ptr);
+      for (size_t i = 0; i < nbytes; i += page_size) {
+        bytes[i] = 0;
+      }
+    }
 #else
     // posix_memalign is available in android ndk since __ANDROID_API__ >= 17
     int ret = posix_memalign(&ptr, alignment, nbytes);
@@ -64,6 +151,9 @@ class CPUDeviceAPI final : public DeviceAPI {
 #if _MSC_VER
     _aligned_free(ptr);
 #else
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (num_mapped_.load(std::memory_order_relaxed) != 0 && UnmapHugeTLB(ptr)) return;
+#endif
     free(ptr);
 #endif
   }
@@ -86,6 +176,47 @@ class CPUDeviceAPI final : public DeviceAPI {
                       TVMStreamHandle stream) final {
     memcpy(static_cast<char*>(to) + to_offset, static_cast<const char*>(from) + from_offset, size);
   }
+
+ private:
+#if defined(__linux__) && !defined(__ANDROID__)
+  /*! \brief The size of the default huge pages of x86-64 and aarch64. */
+  static constexpr size_t kHugePageSize = 2 << 20;
+
+#ifdef MAP_HUGETLB
+  /*! \return Memory of the hugetlbfs pool, or nullptr if the pool cannot provide it. */
+  void* MapHugeTLB(size_t nbytes) {
+    size_t mapped_bytes = (nbytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    void* ptr = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr == MAP_FAILED) return nullptr;
+    std::lock_guard<std::mutex> lock(mapped_mutex_);
+    mapped_[ptr] = mapped_bytes;
+    num_mapped_.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+  }
+#endif
+
+  /*! \return Whether \p ptr was mapped by MapHugeTLB, in which case it is unmapped. */
+  bool UnmapHugeTLB(void* ptr) {
+    size_t mapped_bytes;
+    {
+      std::lock_guard<std::mutex> lock(mapped_mutex_);
+      auto it = mapped_.find(ptr);
+      if (it == mapped_.end()) return false;
+      mapped_bytes = it->second;
+      mapped_.erase(it);
+      num_mapped_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    munmap(ptr, mapped_bytes);
+    return true;
+  }
+
+  std::mutex mapped_mutex_;
+  /*! \brief The size of the mappings made by MapHugeTLB, which are freed with munmap. */
+  std::unordered_map<void*, size_t> mapped_;
+  /*! \brief The size of mapped_, read without the lock to skip it in FreeDataSpace. */
+  std::atomic<size_t> num_mapped_{0};
+#endif
 };
 
 struct CPUWorkspacePool : public WorkspacePool {
@@ -104,5 +235,18 @@ TVM_REGISTER_GLOBAL("device_api.cpu").set_body([](TVMArgs args, TVMRetValue* rv)
   DeviceAPI* ptr = CPUDeviceAPI::Global();
   *rv = static_cast<void*>(ptr);
 });
+
+TVM_REGISTER_GLOBAL("runtime.SetCPUAllocPolicy")
+    .set_body_typed([](int64_t huge_page_threshold, bool use_hugetlb, bool prefault) {
+      CPUAllocPolicy* policy = CPUAllocPolicy::Global();
+      policy->huge_page_threshold = huge_page_threshold;
+      policy->use_hugetlb = use_hugetlb;
+      policy->prefault = prefault;
+    });
+
+TVM_REGISTER_GLOBAL("runtime.CPUWorkspacePoolStats").set_body_typed([]() {
+  Device dev{kDLCPU, 0};
+  return dmlc::ThreadLocalStore<CPUWorkspacePool>::Get()->GetStats(dev).AsMap();
+});
 }  // namespace runtime
 }  // namespace tvm
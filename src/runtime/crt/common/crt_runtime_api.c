@@ -641,3 +641,12 @@ TVM_WEAK tvm_crt_error_t TVMPlatformBeforeMeasurement() { return kTvmErrorNoErro
 
 // Default implementation, overridden by the platform runtime.
 TVM_WEAK tvm_crt_error_t TVMPlatformAfterMeasurement() { return kTvmErrorNoError; }
+
+// Default implementation, overridden by the platform runtime.
+TVM_WEAK tvm_crt_error_t TVMPlatformMemcpyAsync(void* dst, const void* src, uint32_t num_bytes) {
+  memcpy(dst, src, num_bytes);
+  return kTvmErrorNoError;
+}
+
+// Default implementation, overridden by the platform runtime.
+TVM_WEAK tvm_crt_error_t TVMPlatformMemcpyWait(void* dst) { return kTvmErrorNoError; }
@@ -727,6 +727,27 @@ uint32_t TVMGraphExecutor_GetEntryId(TVMGraphExecutor* executor, uint32_t nid, u
   return executor->node_row_ptr[nid] + index;
 }
 
+static const TVMGraphFlatNode* FlatGraph_GetNode(const TVMGraphExecutor* executor, uint32_t nid) {
+  const TVMGraphFlatHeader* header = (const TVMGraphFlatHeader*)executor->flat_graph;
+  return (const TVMGraphFlatNode*)(executor->flat_graph + header->nodes) + nid;
+}
+
+static const char* TVMGraphExecutor_GetNodeName(const TVMGraphExecutor* executor, uint32_t nid) {
+  if (executor->flat_graph) {
+    return executor->flat_graph + FlatGraph_GetNode(executor, nid)->name;
+  }
+  return executor->nodes[nid].name;
+}
+
+// The shape of an entry, the shapes of a flat graph have their own stride.
+static int64_t* TVMGraphExecutor_GetEntryShape(const TVMGraphExecutor* executor, uint32_t eid) {
+  uint32_t stride = TVM_CRT_MAX_NDIM;
+  if (executor->flat_graph) {
+    stride = ((const TVMGraphFlatHeader*)executor->flat_graph)->shape_stride;
+  }
+  return executor->attrs.shape + eid * stride;
+}
+
 /*!
  * \brief Get the number of input tensors allocated.
  * \param executor The graph executor.
@@ -747,7 +768,7 @@ int TVMGraphExecutor_GetInputIndex(TVMGraphExecutor* executor, const char* name)
   int32_t rv = -1;
   for (i = 0; i < executor->input_nodes_count; ++i) {
     uint32_t nid = executor->input_nodes[i];
-    if (!strcmp(executor->nodes[nid].name, name)) {
+    if (!strcmp(TVMGraphExecutor_GetNodeName(executor, nid), name)) {
       rv = i;
       break;
     }
@@ -934,14 +955,20 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   TVMGraphExecutorGraphAttr* attrs = &(executor->attrs);
   DLDataType* vtype = NULL;
   DLDevice alloc_dev = {kDLCPU, 0};
-  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(DLDataType) * attrs->dltype_count,
-                                                  alloc_dev, (void**)&vtype);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory allocate error: %08x", err);
-    return -1;
-  }
-  for (idx = 0; idx < attrs->dltype_count; idx++) {
-    vtype[idx] = String2DLDataType(attrs->dltype + idx * TVM_CRT_MAX_STRLEN_DLTYPE);
+  tvm_crt_error_t err;
+  if (executor->flat_graph) {
+    const TVMGraphFlatHeader* header = (const TVMGraphFlatHeader*)executor->flat_graph;
+    vtype = (DLDataType*)(executor->flat_graph + header->dltype);
+  } else {
+    err = TVMPlatformMemoryAllocate(sizeof(DLDataType) * attrs->dltype_count, alloc_dev,
+                                    (void**)&vtype);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory allocate error: %08x", err);
+      return -1;
+    }
+    for (idx = 0; idx < attrs->dltype_count; idx++) {
+      vtype[idx] = String2DLDataType(attrs->dltype + idx * TVM_CRT_MAX_STRLEN_DLTYPE);
+    }
   }
 
   // Size and device type of each storage pool entry.
@@ -959,7 +986,8 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
     int storage_id = attrs->storage_id[idx];
     // Use the fallback device if no device index is available.
     int device_type = executor->devices[0].device_type;
-    uint32_t size = Shape_Accumulate(attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx]);
+    uint32_t size =
+        Shape_Accumulate(TVMGraphExecutor_GetEntryShape(executor, idx), attrs->ndim[idx]);
     DLDataType t = vtype[idx];
     uint32_t bits = t.bits * t.lanes;
     size_t bytes = ((bits + 7U) / 8U) * size;
@@ -995,7 +1023,7 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
         tensor->data = linked_param_data;
         tensor->device = dev;
         tensor->ndim = attrs->ndim[pit.entry_id];
-        tensor->shape = attrs->shape + idx * TVM_CRT_MAX_NDIM;
+        tensor->shape = TVMGraphExecutor_GetEntryShape(executor, pit.entry_id);
         tensor->strides = NULL;
         tensor->byte_offset = 0;
         did_find_linked_param = 1;
@@ -1028,7 +1056,8 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
     uint32_t storage_id = attrs->storage_id[idx];
     CHECK(storage_id < executor->storage_pool_count);
     int status = TVMNDArray_CreateView(&(executor->storage_pool[storage_id].array),
-                                       attrs->shape + idx * TVM_CRT_MAX_NDIM, attrs->ndim[idx],
+                                       TVMGraphExecutor_GetEntryShape(executor, idx),
+                                       attrs->ndim[idx],
                                        vtype[idx], &executor->data_entry[idx]);
     CHECK_EQ(status, 0, "fail to create for node with idx=%d, storage_id=%u\n", idx, storage_id);
 
@@ -1036,10 +1065,12 @@ int TVMGraphExecutor_SetupStorage(TVMGraphExecutor* executor) {
   }
 
   // Release memory
-  err = TVMPlatformMemoryFree(vtype, alloc_dev);
-  if (err != kTvmErrorNoError) {
-    fprintf(stderr, "memory free error: %08x", err);
-    return err;
+  if (!executor->flat_graph) {
+    err = TVMPlatformMemoryFree(vtype, alloc_dev);
+    if (err != kTvmErrorNoError) {
+      fprintf(stderr, "memory free error: %08x", err);
+      return err;
+    }
   }
 
   err = TVMPlatformMemoryFree(pool_entry, alloc_dev);
@@ -1064,23 +1095,48 @@ int TVMGraphExecutor_SetupOpExecs(TVMGraphExecutor* executor) {
     return status;
   }
   for (nid = 0; nid < executor->nodes_count; nid++) {
-    const TVMGraphExecutorNode* inode = executor->nodes + nid;
-    if (strcmp(inode->op_type, "null")) {
+    const char* op_type;
+    const TVMGraphExecutorNodeEntry* inputs;
+    uint32_t inputs_count;
+    TVMOpParam param;
+    if (executor->flat_graph) {
+      const TVMGraphFlatNode* node = FlatGraph_GetNode(executor, nid);
+      const char* func_name = executor->flat_graph + node->func_name;
+      op_type = executor->flat_graph + node->op_type;
+      inputs = (const TVMGraphExecutorNodeEntry*)(executor->flat_graph + node->inputs);
+      inputs_count = node->inputs_count;
+      if (strlen(func_name) >= sizeof(param.func_name)) {
+        fprintf(stderr, "function name too long: %s\n", func_name);
+        status = -1;
+        break;
+      }
+      strcpy(param.func_name, func_name);
+      param.num_inputs = node->num_inputs;
+      param.num_outputs = node->num_outputs;
+      param.flatten_data = node->flatten_data;
+    } else {
+      const TVMGraphExecutorNode* inode = executor->nodes + nid;
+      op_type = inode->op_type;
+      inputs = inode->inputs;
+      inputs_count = inode->inputs_count;
+      param = inode->param;
+    }
+    if (strcmp(op_type, "null")) {
       DLTensorPtr args[TVM_CRT_MAX_ARGS];
       uint32_t args_count = 0;
-      for (idx = 0; idx < inode->inputs_count; idx++) {
-        const TVMGraphExecutorNodeEntry* entry = inode->inputs + idx;
+      for (idx = 0; idx < inputs_count; idx++) {
+        const TVMGraphExecutorNodeEntry* entry = inputs + idx;
         uint32_t eid = TVMGraphExecutor_GetEntryId(executor, entry->node_id, entry->index);
         args[idx] = &(executor->data_entry[eid].dl_tensor);
         args_count++;
       }
-      for (idx = 0; idx < inode->param.num_outputs; idx++) {
+      for (idx = 0; idx < param.num_outputs; idx++) {
         uint32_t eid = TVMGraphExecutor_GetEntryId(executor, nid, idx);
         args[args_count] = &(executor->data_entry[eid].dl_tensor);
         args_count++;
       }
-      if (strcmp(inode->op_type, "tvm_op")) {
-        fprintf(stderr, "Can only take tvm_op as op, but \"%s\" is found.\n", inode->op_type);
+      if (strcmp(op_type, "tvm_op")) {
+        fprintf(stderr, "Can only take tvm_op as op, but \"%s\" is found.\n", op_type);
         status = -1;
         break;
       }
@@ -1091,10 +1147,10 @@ int TVMGraphExecutor_SetupOpExecs(TVMGraphExecutor* executor) {
         break;
       }
 #if TVM_CRT_DEBUG
-      printf("tvm_op: creating %s with node_id=%d\n", inode->param.func_name, nid);
+      printf("tvm_op: creating %s with node_id=%d\n", param.func_name, nid);
 #endif  // TVM_CRT_DEBUG
       TVMPackedFunc pf;
-      TVMGraphExecutor_CreateTVMOp(executor, &(inode->param), args, args_count, &pf);
+      TVMGraphExecutor_CreateTVMOp(executor, &param, args, args_count, &pf);
       executor->op_execs[nid] = pf;
     } else {
       memset(&executor->op_execs[nid], 0, sizeof(TVMPackedFunc));
@@ -1152,6 +1208,261 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
   return status;
 }
 
+// A string of the binary graph format, pointing into the graph.
+typedef struct TVMGraphBinaryString {
+  const char* data;
+  uint32_t size;
+} TVMGraphBinaryString;
+
+static uint32_t GraphBinary_ReadU32(const char** cursor) {
+  uint32_t value;
+  memcpy(&value, *cursor, sizeof(value));
+  *cursor += sizeof(value);
+  return value;
+}
+
+static int64_t GraphBinary_ReadI64(const char** cursor) {
+  int64_t value;
+  memcpy(&value, *cursor, sizeof(value));
+  *cursor += sizeof(value);
+  return value;
+}
+
+static int GraphBinary_ReadString(const char** cursor, const TVMGraphBinaryString* strings,
+                                  uint32_t strings_count, char* out, size_t out_size) {
+  uint32_t id = GraphBinary_ReadU32(cursor);
+  if (id >= strings_count || strings[id].size >= out_size) {
+    fprintf(stderr, "invalid graph binary string %u\n", id);
+    return -1;
+  }
+  memcpy(out, strings[id].data, strings[id].size);
+  out[strings[id].size] = '\0';
+  return 0;
+}
+
+static int GraphBinary_ReadEntries(const char** cursor, TVMGraphExecutorNodeEntry** entries,
+                                   uint32_t* count) {
+  *count = GraphBinary_ReadU32(cursor);
+  DLDevice dev = {kDLCPU, 0};
+  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutorNodeEntry) * *count,
+                                                  dev, (void**)entries);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  uint32_t i;
+  for (i = 0; i < *count; ++i) {
+    (*entries)[i].node_id = GraphBinary_ReadU32(cursor);
+    (*entries)[i].index = GraphBinary_ReadU32(cursor);
+    (*entries)[i].version = GraphBinary_ReadU32(cursor);
+  }
+  return 0;
+}
+
+static int GraphBinary_ReadU32Array(const char** cursor, uint32_t count, uint32_t** values) {
+  DLDevice dev = {kDLCPU, 0};
+  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(uint32_t) * count, dev, (void**)values);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  uint32_t i;
+  for (i = 0; i < count; ++i) {
+    (*values)[i] = GraphBinary_ReadU32(cursor);
+  }
+  return 0;
+}
+
+static int GraphBinary_Load(TVMGraphExecutor* executor, const char* cursor,
+                            const TVMGraphBinaryString* strings, uint32_t strings_count) {
+  DLDevice dev = {kDLCPU, 0};
+  tvm_crt_error_t err;
+  uint32_t i, j;
+  uint32_t nodes_count = GraphBinary_ReadU32(&cursor);
+  err = TVMPlatformMemoryAllocate(sizeof(TVMGraphExecutorNode) * nodes_count, dev,
+                                  (void**)&executor->nodes);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  for (i = 0; i < nodes_count; ++i) {
+    TVMGraphExecutorNode* node = executor->nodes + i;
+    memset(node, 0, sizeof(TVMGraphExecutorNode));
+    executor->nodes_count++;
+    if (GraphBinary_ReadString(&cursor, strings, strings_count, node->op_type,
+                               sizeof(node->op_type)) != 0 ||
+        GraphBinary_ReadString(&cursor, strings, strings_count, node->name, sizeof(node->name)) !=
+            0 ||
+        GraphBinary_ReadString(&cursor, strings, strings_count, node->param.func_name,
+                               sizeof(node->param.func_name)) != 0) {
+      return -1;
+    }
+    node->param.num_inputs = GraphBinary_ReadU32(&cursor);
+    node->param.num_outputs = GraphBinary_ReadU32(&cursor);
+    node->param.flatten_data = GraphBinary_ReadU32(&cursor);
+    uint32_t inputs_count;
+    if (GraphBinary_ReadEntries(&cursor, &node->inputs, &inputs_count) != 0) {
+      return -1;
+    }
+    node->inputs_count = inputs_count;
+    // The other attributes are not used by the CRT, skip their key and value ids.
+    cursor += 2 * sizeof(uint32_t) * GraphBinary_ReadU32(&cursor);
+  }
+  executor->input_nodes_count = GraphBinary_ReadU32(&cursor);
+  if (GraphBinary_ReadU32Array(&cursor, executor->input_nodes_count, &executor->input_nodes) !=
+      0) {
+    return -1;
+  }
+  executor->node_row_ptr_count = GraphBinary_ReadU32(&cursor);
+  if (GraphBinary_ReadU32Array(&cursor, executor->node_row_ptr_count, &executor->node_row_ptr) !=
+      0) {
+    return -1;
+  }
+  if (GraphBinary_ReadEntries(&cursor, &executor->outputs, &executor->outputs_count) != 0) {
+    return -1;
+  }
+
+  TVMGraphExecutorGraphAttr* attr = &executor->attrs;
+  uint32_t entries_count = GraphBinary_ReadU32(&cursor);
+  if (GraphBinary_ReadU32Array(&cursor, entries_count, &attr->storage_id) != 0) {
+    return -1;
+  }
+  if (GraphBinary_ReadU32(&cursor) &&
+      GraphBinary_ReadU32Array(&cursor, entries_count, &attr->device_index) != 0) {
+    return -1;
+  }
+  err = TVMPlatformMemoryAllocate(TVM_CRT_MAX_STRLEN_DLTYPE * entries_count, dev,
+                                  (void**)&attr->dltype);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  for (i = 0; i < entries_count; ++i) {
+    if (GraphBinary_ReadString(&cursor, strings, strings_count,
+                               attr->dltype + i * TVM_CRT_MAX_STRLEN_DLTYPE,
+                               TVM_CRT_MAX_STRLEN_DLTYPE) != 0) {
+      return -1;
+    }
+  }
+  attr->dltype_count = entries_count;
+  // The CRT has no storage scopes, skip them.
+  if (GraphBinary_ReadU32(&cursor)) {
+    cursor += sizeof(uint32_t) * entries_count;
+  }
+  err = TVMPlatformMemoryAllocate(sizeof(int64_t) * TVM_CRT_MAX_NDIM * entries_count, dev,
+                                  (void**)&attr->shape);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  err = TVMPlatformMemoryAllocate(sizeof(uint32_t) * entries_count, dev, (void**)&attr->ndim);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  for (i = 0; i < entries_count; ++i) {
+    int64_t* shape = attr->shape + i * TVM_CRT_MAX_NDIM;
+    uint32_t ndim = GraphBinary_ReadU32(&cursor);
+    if (ndim > TVM_CRT_MAX_NDIM) {
+      fprintf(stderr, "The given shape has too many dimensions, %u > %d\n", ndim,
+              TVM_CRT_MAX_NDIM);
+      return -1;
+    }
+    memset(shape, 0, sizeof(int64_t) * TVM_CRT_MAX_NDIM);
+    for (j = 0; j < ndim; ++j) {
+      shape[j] = GraphBinary_ReadI64(&cursor);
+    }
+    attr->ndim[i] = ndim;
+  }
+  attr->shape_count = entries_count;
+  return 0;
+}
+
+/*!
+ * \brief Load a graph in the binary graph format.
+ * \param executor The graph executor.
+ * \param graph The graph, starting with TVM_GRAPH_BINARY_MAGIC.
+ * \return 0 on success.
+ */
+int TVMGraphExecutor_LoadBinary(TVMGraphExecutor* executor, const char* graph) {
+  if (strncmp(graph, TVM_GRAPH_BINARY_MAGIC, strlen(TVM_GRAPH_BINARY_MAGIC)) != 0) {
+    fprintf(stderr, "invalid graph binary format\n");
+    return -1;
+  }
+  // Skip the magic number and the reserved field.
+  const char* cursor = graph + 2 * sizeof(uint64_t);
+  uint32_t strings_count = GraphBinary_ReadU32(&cursor);
+  TVMGraphBinaryString* strings = NULL;
+  DLDevice dev = {kDLCPU, 0};
+  tvm_crt_error_t err = TVMPlatformMemoryAllocate(sizeof(TVMGraphBinaryString) * strings_count,
+                                                  dev, (void**)&strings);
+  if (err != kTvmErrorNoError) {
+    fprintf(stderr, "memory allocate error: %08x", err);
+    return -1;
+  }
+  uint32_t i;
+  for (i = 0; i < strings_count; ++i) {
+    strings[i].size = GraphBinary_ReadU32(&cursor);
+    strings[i].data = cursor;
+    cursor += strings[i].size;
+  }
+  int status = GraphBinary_Load(executor, cursor, strings, strings_count);
+  err = TVMPlatformMemoryFree(strings, dev);
+  if (err != kTvmErrorNoError) {
+    return -1;
+  }
+  return status;
+}
+
+/*!
+ * \brief Load a graph in the flat graph format, the executor uses its tables in place.
+ * \param executor The graph executor.
+ * \param graph The graph, starting with TVM_GRAPH_FLAT_MAGIC. It must be 8-byte aligned and
+ *  outlive the executor.
+ * \return 0 on success.
+ */
+int TVMGraphExecutor_LoadFlat(TVMGraphExecutor* executor, const char* graph) {
+  const TVMGraphFlatHeader* header = (const TVMGraphFlatHeader*)graph;
+  if (strncmp(header->magic, TVM_GRAPH_FLAT_MAGIC, sizeof(header->magic)) != 0) {
+    fprintf(stderr, "invalid graph flat format\n");
+    return -1;
+  }
+  if ((uintptr_t)graph % sizeof(int64_t) != 0) {
+    fprintf(stderr, "the flat graph must be %u-byte aligned\n", (unsigned)sizeof(int64_t));
+    return -1;
+  }
+  // The shapes are copied to TVM_CRT_MAX_NDIM arrays when the tensors are created.
+  if (header->shape_stride > TVM_CRT_MAX_NDIM) {
+    fprintf(stderr, "The given shape has too many dimensions, %u > %d\n", header->shape_stride,
+            TVM_CRT_MAX_NDIM);
+    return -1;
+  }
+  executor->flat_graph = graph;
+  executor->nodes = NULL;
+  executor->nodes_count = header->nodes_count;
+  executor->input_nodes = (uint32_t*)(graph + header->input_nodes);
+  executor->input_nodes_count = header->input_nodes_count;
+  executor->node_row_ptr = (uint32_t*)(graph + header->node_row_ptr);
+  executor->node_row_ptr_count = header->node_row_ptr_count;
+  executor->outputs = (TVMGraphExecutorNodeEntry*)(graph + header->outputs);
+  executor->outputs_count = header->outputs_count;
+
+  TVMGraphExecutorGraphAttr* attr = &executor->attrs;
+  attr->storage_id = (uint32_t*)(graph + header->storage_id);
+  attr->device_index = NULL;
+  attr->dltype = NULL;
+  attr->dltype_count = header->entries_count;
+  attr->shape = (int64_t*)(graph + header->shape);
+  attr->ndim = (uint32_t*)(graph + header->ndim);
+  attr->shape_count = header->entries_count;
+  if (executor->node_row_ptr_count == 0 ||
+      executor->node_row_ptr[executor->node_row_ptr_count - 1] != header->entries_count) {
+    fprintf(stderr, "invalid graph flat format\n");
+    return -1;
+  }
+  return 0;
+}
+
 /*!
  * \brief Initialize the graph executor with graph and device.
  * \param graph_json The execution graph.
@@ -1163,16 +1474,26 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
  */
 int TVMGraphExecutor_Init(TVMGraphExecutor* executor, const char* graph_json,
                           TVMModuleHandle module_handle, const DLDevice* devs) {
-  JSONReader reader;
-  tvm_crt_error_t err = JSONReader_Create(graph_json, &reader);
-  if (err != kTvmErrorNoError) {
-    return -1;
-  }
+  if (strncmp(graph_json, TVM_GRAPH_BINARY_MAGIC, strlen(TVM_GRAPH_BINARY_MAGIC)) == 0) {
+    if (TVMGraphExecutor_LoadBinary(executor, graph_json) != 0) {
+      return -1;
+    }
+  } else if (strncmp(graph_json, TVM_GRAPH_FLAT_MAGIC, strlen(TVM_GRAPH_FLAT_MAGIC)) == 0) {
+    if (TVMGraphExecutor_LoadFlat(executor, graph_json) != 0) {
+      return -1;
+    }
+  } else {
+    JSONReader reader;
+    tvm_crt_error_t err = JSONReader_Create(graph_json, &reader);
+    if (err != kTvmErrorNoError) {
+      return -1;
+    }
 
-  TVMGraphExecutor_Load(executor, &reader);
-  err = JSONReader_Release(&reader);
-  if (err != kTvmErrorNoError) {
-    return -1;
+    TVMGraphExecutor_Load(executor, &reader);
+    err = JSONReader_Release(&reader);
+    if (err != kTvmErrorNoError) {
+      return -1;
+    }
   }
   executor->module_handle = module_handle;
   executor->devices[0] = devs[0];
@@ -1205,20 +1526,23 @@ int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
   int status = 0;
   int32_t idx;
   TVMGraphExecutor* executor = (TVMGraphExecutor*)(*pptr);
-  for (idx = 0; idx < executor->nodes_count; ++idx) {
-    status = TVMGraphExecutorNodeRelease(&(executor->nodes[idx]));
+  DLDevice dev = {kDLCPU, 0};
+  // The tables of a flat graph point into the graph.
+  if (!executor->flat_graph) {
+    for (idx = 0; idx < executor->nodes_count; ++idx) {
+      status = TVMGraphExecutorNodeRelease(&(executor->nodes[idx]));
+      if (status != 0) {
+        return status;
+      }
+    }
+    status = TVMPlatformMemoryFree(executor->nodes, dev);
+    if (status != 0) {
+      return status;
+    }
+    status = TVMGraphExecutorGraphAttr_Release(&(executor->attrs));
     if (status != 0) {
       return status;
     }
-  }
-  DLDevice dev = {kDLCPU, 0};
-  status = TVMPlatformMemoryFree(executor->nodes, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMGraphExecutorGraphAttr_Release(&(executor->attrs));
-  if (status != 0) {
-    return status;
   }
   for (idx = 0; idx < executor->storage_pool_count; ++idx) {
     if (executor->storage_pool[idx].is_linked_param == 0) {
@@ -1234,17 +1558,19 @@ int TVMGraphExecutor_Release(TVMGraphExecutor** pptr) {
       return status;
     }
   }
-  status = TVMPlatformMemoryFree(executor->input_nodes, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMPlatformMemoryFree(executor->node_row_ptr, dev);
-  if (status != 0) {
-    return status;
-  }
-  status = TVMPlatformMemoryFree(executor->outputs, dev);
-  if (status != 0) {
-    return status;
+  if (!executor->flat_graph) {
+    status = TVMPlatformMemoryFree(executor->input_nodes, dev);
+    if (status != 0) {
+      return status;
+    }
+    status = TVMPlatformMemoryFree(executor->node_row_ptr, dev);
+    if (status != 0) {
+      return status;
+    }
+    status = TVMPlatformMemoryFree(executor->outputs, dev);
+    if (status != 0) {
+      return status;
+    }
   }
   status = TVMPlatformMemoryFree(executor->storage_pool, dev);
   if (status != 0) {
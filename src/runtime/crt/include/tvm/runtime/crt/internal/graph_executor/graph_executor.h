@@ -40,13 +40,11 @@ typedef struct TVMGraphExecutorPoolEntry {
   int entry_id;
 } TVMGraphExecutorPoolEntry;
 
-// Node entry
+// Node entry, laid out as the entries of the flat graph format.
 typedef struct TVMGraphExecutorNodeEntry {
   uint32_t node_id;
   uint32_t index;
   uint32_t version;
-  // JSON Loader
-  void (*Load)(JSONReader* reader);
 } TVMGraphExecutorNodeEntry;
 
 // Storage entry.
@@ -76,6 +74,11 @@ typedef struct TVMGraphExecutorNode {
 } TVMGraphExecutorNode;
 
 typedef struct TVMGraphExecutor {
+  /*!
+   * \brief The graph in the flat graph format when it was loaded from one, NULL otherwise.
+   *  The graph tables then point into it and nodes is NULL.
+   */
+  const char* flat_graph;
   /*! \brief The graph nodes. */
   TVMGraphExecutorNode* nodes;
   /*! \brief The graph nodes counter. */
@@ -122,6 +125,8 @@ int32_t TVMGraphExecutor_CreateTVMOp(TVMGraphExecutor* executor, const TVMOpPara
                                      DLTensorPtr* args, const uint32_t args_count,
                                      TVMPackedFunc* pf);
 int TVMGraphExecutor_Load(TVMGraphExecutor* executor, JSONReader* reader);
+int TVMGraphExecutor_LoadBinary(TVMGraphExecutor* executor, const char* graph);
+int TVMGraphExecutor_LoadFlat(TVMGraphExecutor* executor, const char* graph);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime/crt/include/tvm/runtime/crt/internal/memory/tlsf_allocator.h
+ * \brief Defines data types and functions used in the TLSF memory manager.
+ *     Exposed for testing.
+ */
+
+#ifndef TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
+#define TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief log2 of the alignment of the allocations, and of the size classes below 256 bytes. */
+#define TLSF_ALIGN_LOG2 4
+#define TLSF_ALIGN_BYTES (1 << TLSF_ALIGN_LOG2)
+/*! \brief log2 of the number of size classes per power of two. */
+#define TLSF_SL_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+/*! \brief Sizes below this are split into TLSF_SL_COUNT classes of TLSF_ALIGN_BYTES. */
+#define TLSF_SMALL_BLOCK_BYTES (1 << (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2))
+/*! \brief The number of first level classes. */
+#define TLSF_FL_COUNT 24
+/*! \brief The largest payload of a block, the last aligned size below the last class. */
+#define TLSF_MAX_BLOCK_BYTES \
+  (((size_t)1 << (TLSF_FL_COUNT + TLSF_SL_LOG2 + TLSF_ALIGN_LOG2 - 1)) - TLSF_ALIGN_BYTES)
+
+/*! \brief Flag in TLSFBlock::size: the block is free. */
+#define TLSF_BLOCK_FREE 0x1
+/*! \brief Flag in TLSFBlock::size: the previous block in memory is free. */
+#define TLSF_BLOCK_PREV_FREE 0x2
+#define TLSF_BLOCK_FLAGS (TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE)
+
+/*!
+ * \brief Header of a block of the pool, followed by its payload.
+ *
+ * Blocks tile the pool, the last one being a used block of size 0. The free list links of a
+ * free block are kept in its payload.
+ */
+typedef struct TLSFBlock {
+  /*! \brief The previous block in memory, valid when TLSF_BLOCK_PREV_FREE is set. */
+  struct TLSFBlock* prev_phys;
+  /*! \brief The size of the payload in bytes, with TLSF_BLOCK_FLAGS in the low bits. */
+  size_t size;
+} TLSFBlock;
+
+/*! \brief The bytes of a block header, rounded up so that payloads stay aligned. */
+#define TLSF_BLOCK_HEADER_BYTES \
+  ((sizeof(TLSFBlock) + TLSF_ALIGN_BYTES - 1) / TLSF_ALIGN_BYTES * TLSF_ALIGN_BYTES)
+
+/*! \brief The free list links kept in the payload of a free block. */
+typedef struct TLSFFreeLinks {
+  TLSFBlock* next;
+  TLSFBlock* prev;
+} TLSFFreeLinks;
+
+/*! \brief The smallest payload, large enough for the free list links. */
+#define TLSF_MIN_PAYLOAD_BYTES \
+  ((sizeof(TLSFFreeLinks) + TLSF_ALIGN_BYTES - 1) / TLSF_ALIGN_BYTES * TLSF_ALIGN_BYTES)
+
+typedef struct TLSFMemoryManager {
+  MemoryManagerInterface interface;
+  /*! \brief Bit i is set when free_lists[i] has a non-empty class. */
+  uint32_t fl_bitmap;
+  /*! \brief Bit j of sl_bitmap[i] is set when free_lists[i][j] is not empty. */
+  uint32_t sl_bitmap[TLSF_FL_COUNT];
+  /*! \brief The heads of the free lists of each size class. */
+  TLSFBlock* free_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+  /*! \brief The first block of the pool. */
+  TLSFBlock* first_block;
+  /*! \brief The counters, largest_free_bytes is computed by TLSFMemoryManagerGetStats. */
+  TLSFMemoryManagerStats stats;
+} TLSFMemoryManager;
+
+/*!
+ * \brief Compute the size class of a block.
+ * \param size The payload size of the block.
+ * \param fl Set to the first level index.
+ * \param sl Set to the second level index.
+ */
+void TLSF_MappingInsert(size_t size, int* fl, int* sl);
+
+/*!
+ * \brief Compute the smallest size class whose blocks all fit an allocation.
+ * \param size The payload size of the allocation, rounded to TLSF_ALIGN_BYTES.
+ * \param fl Set to the first level index.
+ * \param sl Set to the second level index.
+ */
+void TLSF_MappingSearch(size_t size, int* fl, int* sl);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TVM_RUNTIME_CRT_INCLUDE_TVM_RUNTIME_CRT_INTERNAL_MEMORY_TLSF_ALLOCATOR_H_
@@ -0,0 +1,315 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file tlsf_allocator.c
+ * \brief Two-level segregated fit memory manager.
+ *
+ * As the page allocator, it is not thread-safe.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/internal/memory/tlsf_allocator.h>
+#include <tvm/runtime/crt/logging.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+// Index of the lowest set bit of a non-zero word.
+static int TLSF_LowestBit(uint32_t word) {
+#if defined(__GNUC__)
+  return __builtin_ctz(word);
+#else
+  int bit = 0;
+  while ((word & 1) == 0) {
+    word >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+// Index of the highest set bit of a non-zero size.
+static int TLSF_HighestBit(size_t size) {
+#if defined(__GNUC__)
+  return (int)(sizeof(unsigned long long) * 8) - 1 -  // NOLINT(runtime/int)
+         __builtin_clzll((unsigned long long)size);   // NOLINT(runtime/int)
+#else
+  int bit = -1;
+  while (size != 0) {
+    size >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+static size_t TLSF_BlockSize(const TLSFBlock* block) { return block->size & ~TLSF_BLOCK_FLAGS; }
+
+static bool TLSF_BlockIsFree(const TLSFBlock* block) {
+  return (block->size & TLSF_BLOCK_FREE) != 0;
+}
+
+static uint8_t* TLSF_BlockPayload(TLSFBlock* block) {
+  return (uint8_t*)block + TLSF_BLOCK_HEADER_BYTES;
+}
+
+static TLSFBlock* TLSF_BlockFromPayload(void* ptr) {
+  return (TLSFBlock*)((uint8_t*)ptr - TLSF_BLOCK_HEADER_BYTES);
+}
+
+static TLSFBlock* TLSF_BlockNext(TLSFBlock* block) {
+  return (TLSFBlock*)(TLSF_BlockPayload(block) + TLSF_BlockSize(block));
+}
+
+static TLSFFreeLinks* TLSF_BlockLinks(TLSFBlock* block) {
+  return (TLSFFreeLinks*)TLSF_BlockPayload(block);
+}
+
+// Set the free flag of a block, and the matching flag of the next block.
+static void TLSF_BlockMarkFree(TLSFBlock* block, bool is_free) {
+  TLSFBlock* next = TLSF_BlockNext(block);
+  if (is_free) {
+    block->size |= TLSF_BLOCK_FREE;
+    next->size |= TLSF_BLOCK_PREV_FREE;
+    next->prev_phys = block;
+  } else {
+    block->size &= ~(size_t)TLSF_BLOCK_FREE;
+    next->size &= ~(size_t)TLSF_BLOCK_PREV_FREE;
+  }
+}
+
+void TLSF_MappingInsert(size_t size, int* fl, int* sl) {
+  if (size < TLSF_SMALL_BLOCK_BYTES) {
+    *fl = 0;
+    *sl = (int)(size >> TLSF_ALIGN_LOG2);
+  } else {
+    int msb = TLSF_HighestBit(size);
+    *fl = msb - (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2) + 1;
+    *sl = (int)((size >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT);
+  }
+}
+
+void TLSF_MappingSearch(size_t size, int* fl, int* sl) {
+  if (size >= TLSF_SMALL_BLOCK_BYTES) {
+    // Round up to the next class, so that any block of the class found fits.
+    size += ((size_t)1 << (TLSF_HighestBit(size) - TLSF_SL_LOG2)) - 1;
+  }
+  TLSF_MappingInsert(size, fl, sl);
+}
+
+static void TLSF_InsertFree(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  TLSF_MappingInsert(TLSF_BlockSize(block), &fl, &sl);
+  TLSFBlock* head = mgr->free_lists[fl][sl];
+  TLSF_BlockLinks(block)->next = head;
+  TLSF_BlockLinks(block)->prev = NULL;
+  if (head != NULL) {
+    TLSF_BlockLinks(head)->prev = block;
+  }
+  mgr->free_lists[fl][sl] = block;
+  mgr->fl_bitmap |= 1u << fl;
+  mgr->sl_bitmap[fl] |= 1u << sl;
+  TLSF_BlockMarkFree(block, true);
+  mgr->stats.free_bytes += TLSF_BlockSize(block);
+}
+
+static void TLSF_RemoveFree(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  int fl, sl;
+  TLSF_MappingInsert(TLSF_BlockSize(block), &fl, &sl);
+  TLSFBlock* next = TLSF_BlockLinks(block)->next;
+  TLSFBlock* prev = TLSF_BlockLinks(block)->prev;
+  if (next != NULL) {
+    TLSF_BlockLinks(next)->prev = prev;
+  }
+  if (prev != NULL) {
+    TLSF_BlockLinks(prev)->next = next;
+  } else {
+    mgr->free_lists[fl][sl] = next;
+    if (next == NULL) {
+      mgr->sl_bitmap[fl] &= ~(1u << sl);
+      if (mgr->sl_bitmap[fl] == 0) {
+        mgr->fl_bitmap &= ~(1u << fl);
+      }
+    }
+  }
+  TLSF_BlockMarkFree(block, false);
+  mgr->stats.free_bytes -= TLSF_BlockSize(block);
+}
+
+// Find a free block of the smallest class whose blocks all fit `size`, NULL if there is none.
+static TLSFBlock* TLSF_FindFree(TLSFMemoryManager* mgr, size_t size) {
+  int fl, sl;
+  TLSF_MappingSearch(size, &fl, &sl);
+  if (fl >= TLSF_FL_COUNT) {
+    return NULL;
+  }
+  uint32_t sl_map = mgr->sl_bitmap[fl] & (~0u << sl);
+  if (sl_map == 0) {
+    uint32_t fl_map = fl + 1 < TLSF_FL_COUNT ? mgr->fl_bitmap & (~0u << (fl + 1)) : 0;
+    if (fl_map == 0) {
+      return NULL;
+    }
+    fl = TLSF_LowestBit(fl_map);
+    sl_map = mgr->sl_bitmap[fl];
+  }
+  return mgr->free_lists[fl][TLSF_LowestBit(sl_map)];
+}
+
+// Merge a free block, not in a free list, with the next block, which is free and in its list.
+static void TLSF_MergeNext(TLSFMemoryManager* mgr, TLSFBlock* block) {
+  TLSFBlock* next = TLSF_BlockNext(block);
+  TLSF_RemoveFree(mgr, next);
+  block->size += TLSF_BLOCK_HEADER_BYTES + TLSF_BlockSize(next);
+}
+
+tvm_crt_error_t TLSFMemoryManager_Allocate(MemoryManagerInterface* interface, size_t num_bytes,
+                                           DLDevice dev, void** out_ptr) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  *out_ptr = NULL;
+
+  size_t size = (num_bytes + TLSF_ALIGN_BYTES - 1) & ~(size_t)(TLSF_ALIGN_BYTES - 1);
+  if (size < TLSF_MIN_PAYLOAD_BYTES) {
+    size = TLSF_MIN_PAYLOAD_BYTES;
+  }
+  bool size_ok = size >= num_bytes && size <= TLSF_MAX_BLOCK_BYTES;
+  TLSFBlock* block = size_ok ? TLSF_FindFree(mgr, size) : NULL;
+  if (block == NULL) {
+    mgr->stats.num_failed_allocations++;
+    if (size_ok && size <= mgr->stats.free_bytes) {
+      mgr->stats.num_fragmented_failures++;
+    }
+#if TVM_CRT_DEBUG > 1
+    TVMLogf("insufficient memory, size=%zu, free=%zu", size, mgr->stats.free_bytes);
+#endif
+    return kTvmErrorPlatformNoMemory;
+  }
+  TLSF_RemoveFree(mgr, block);
+
+  // Give the tail of the block back when it can hold a block of its own.
+  size_t block_size = TLSF_BlockSize(block);
+  if (block_size >= size + TLSF_BLOCK_HEADER_BYTES + TLSF_MIN_PAYLOAD_BYTES) {
+    block->size = size | (block->size & TLSF_BLOCK_FLAGS);
+    TLSFBlock* rest = TLSF_BlockNext(block);
+    rest->size = block_size - size - TLSF_BLOCK_HEADER_BYTES;
+    TLSF_InsertFree(mgr, rest);
+  }
+
+  mgr->stats.used_bytes += TLSF_BlockSize(block);
+  if (mgr->stats.used_bytes > mgr->stats.peak_used_bytes) {
+    mgr->stats.peak_used_bytes = mgr->stats.used_bytes;
+  }
+  mgr->stats.num_allocations++;
+  mgr->interface.vleak_size++;
+  *out_ptr = TLSF_BlockPayload(block);
+#if TVM_CRT_DEBUG > 1
+  TVMLogf("allocate: addr=%p, size=%zu, vleak=%d", *out_ptr, TLSF_BlockSize(block),
+          mgr->interface.vleak_size);
+#endif
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManager_Free(MemoryManagerInterface* interface, void* ptr, DLDevice dev) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  TLSFBlock* block = TLSF_BlockFromPayload(ptr);
+  if ((uint8_t*)block < (uint8_t*)mgr->first_block || TLSF_BlockIsFree(block) ||
+      TLSF_BlockSize(block) == 0) {
+    return kTvmErrorPlatformMemoryBadFree;
+  }
+#if TVM_CRT_DEBUG > 1
+  TVMLogf("release: addr=%p, size=%zu, vleak=%d", ptr, TLSF_BlockSize(block),
+          mgr->interface.vleak_size - 1);
+#endif
+  mgr->stats.used_bytes -= TLSF_BlockSize(block);
+  mgr->interface.vleak_size--;
+
+  if (TLSF_BlockIsFree(TLSF_BlockNext(block))) {
+    TLSF_MergeNext(mgr, block);
+  }
+  if ((block->size & TLSF_BLOCK_PREV_FREE) != 0) {
+    TLSFBlock* prev = block->prev_phys;
+    TLSF_RemoveFree(mgr, prev);
+    prev->size += TLSF_BLOCK_HEADER_BYTES + TLSF_BlockSize(block);
+    block = prev;
+  }
+  TLSF_InsertFree(mgr, block);
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerCreate(MemoryManagerInterface** interface, uint8_t* memory_pool,
+                                        size_t memory_pool_size_bytes) {
+  // The manager sits at the start of the pool, the first block after it, aligned so that
+  // every payload is aligned.
+  uintptr_t pool_begin = (uintptr_t)memory_pool;
+  uintptr_t pool_end = pool_begin + memory_pool_size_bytes;
+  uintptr_t first = pool_begin + sizeof(TLSFMemoryManager) + TLSF_BLOCK_HEADER_BYTES;
+  first = (first + TLSF_ALIGN_BYTES - 1) & ~(uintptr_t)(TLSF_ALIGN_BYTES - 1);
+  first -= TLSF_BLOCK_HEADER_BYTES;
+  // Room for the first block and the sentinel block.
+  if (pool_end < first + 2 * TLSF_BLOCK_HEADER_BYTES + TLSF_MIN_PAYLOAD_BYTES) {
+    return kTvmErrorPlatformNoMemory;
+  }
+  size_t first_size = pool_end - first - 2 * TLSF_BLOCK_HEADER_BYTES;
+  first_size &= ~(size_t)(TLSF_ALIGN_BYTES - 1);
+  if (first_size > TLSF_MAX_BLOCK_BYTES) {
+    first_size = TLSF_MAX_BLOCK_BYTES;
+  }
+
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)memory_pool;
+  memset(mgr, 0, sizeof(TLSFMemoryManager));
+  mgr->interface.Allocate = TLSFMemoryManager_Allocate;
+  mgr->interface.Free = TLSFMemoryManager_Free;
+  mgr->first_block = (TLSFBlock*)first;
+  mgr->first_block->prev_phys = NULL;
+  mgr->first_block->size = first_size;
+  TLSFBlock* sentinel = TLSF_BlockNext(mgr->first_block);
+  sentinel->prev_phys = NULL;
+  sentinel->size = 0;
+  TLSF_InsertFree(mgr, mgr->first_block);
+
+  *interface = &mgr->interface;
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerGetStats(MemoryManagerInterface* interface,
+                                          TLSFMemoryManagerStats* stats) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  *stats = mgr->stats;
+  stats->largest_free_bytes = 0;
+  // The largest free block is in the highest non-empty class.
+  if (mgr->fl_bitmap != 0) {
+    int fl = TLSF_HighestBit(mgr->fl_bitmap);
+    int sl = TLSF_HighestBit(mgr->sl_bitmap[fl]);
+    for (TLSFBlock* block = mgr->free_lists[fl][sl]; block != NULL;
+         block = TLSF_BlockLinks(block)->next) {
+      if (TLSF_BlockSize(block) > stats->largest_free_bytes) {
+        stats->largest_free_bytes = TLSF_BlockSize(block);
+      }
+    }
+  }
+  return kTvmErrorNoError;
+}
+
+tvm_crt_error_t TLSFMemoryManagerResetPeak(MemoryManagerInterface* interface) {
+  TLSFMemoryManager* mgr = (TLSFMemoryManager*)interface;
+  mgr->stats.peak_used_bytes = mgr->stats.used_bytes;
+  return kTvmErrorNoError;
+}
@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+// LINT_C_FILE
+
+/*!
+ * \file tlsf_allocator_rpc.c
+ * \brief Functions reading the counters of the TLSF memory manager over the microTVM RPC.
+ *
+ * Kept apart from tlsf_allocator.c, so that firmware not linking the CRT function registry
+ * can still use the allocator.
+ */
+
+#include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/crt/error_codes.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+/*! \brief The manager read by the registered functions. */
+static MemoryManagerInterface* g_tlsf_stats_manager;
+
+// Fill the int64 tensor in args[0] with the fields of TLSFMemoryManagerStats.
+static int TLSFGetStats(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_val,
+                        int* ret_type_code) {
+  if (num_args != 1) {
+    return kTvmErrorFunctionCallNumArguments;
+  }
+  if (type_codes[0] != kTVMDLTensorHandle) {
+    return kTvmErrorFunctionCallWrongArgType;
+  }
+
+  DLTensor* tensor = (DLTensor*)args[0].v_handle;
+  size_t num_fields = sizeof(TLSFMemoryManagerStats) / sizeof(size_t);
+  if (tensor->dtype.code != kDLInt || tensor->dtype.bits != 64 || tensor->ndim != 1 ||
+      tensor->shape[0] < (int64_t)num_fields) {
+    return kTvmErrorFunctionCallInvalidArg;
+  }
+
+  TLSFMemoryManagerStats stats;
+  tvm_crt_error_t err = TLSFMemoryManagerGetStats(g_tlsf_stats_manager, &stats);
+  if (err != kTvmErrorNoError) {
+    return err;
+  }
+  const size_t* fields = (const size_t*)&stats;
+  int64_t* out = (int64_t*)((uint8_t*)tensor->data + tensor->byte_offset);
+  for (size_t i = 0; i < num_fields; i++) {
+    out[i] = (int64_t)fields[i];
+  }
+  return kTvmErrorNoError;
+}
+
+static int TLSFResetPeak(TVMValue* args, int* type_codes, int num_args, TVMValue* ret_val,
+                         int* ret_type_code) {
+  if (num_args != 0) {
+    return kTvmErrorFunctionCallNumArguments;
+  }
+  return TLSFMemoryManagerResetPeak(g_tlsf_stats_manager);
+}
+
+tvm_crt_error_t TLSFMemoryManagerRegisterFuncs(MemoryManagerInterface* manager) {
+  g_tlsf_stats_manager = manager;
+  int error = TVMFuncRegisterGlobal("tvm.crt.memory.get_stats", &TLSFGetStats, 0);
+  if (error == 0) {
+    error = TVMFuncRegisterGlobal("tvm.crt.memory.reset_peak", &TLSFResetPeak, 0);
+  }
+  return (tvm_crt_error_t)error;
+}
@@ -31,9 +31,25 @@ namespace tvm {
 namespace runtime {
 namespace micro_rpc {
 
-struct microtvm_session_start_payload_t {
+#if defined(_MSC_VER)
+
+#pragma pack(push, 1)
+typedef struct microtvm_session_start_payload_t {
+  uint8_t version;
+  // Capacity of the receive buffer of the sender, in bytes.
+  uint32_t max_packet_size_bytes;
+} microtvm_session_start_payload_t;
+#pragma pack(pop)
+
+#else
+
+typedef struct microtvm_session_start_payload_t {
   uint8_t version;
-};
+  // Capacity of the receive buffer of the sender, in bytes.
+  uint32_t max_packet_size_bytes;
+} __attribute__((packed)) microtvm_session_start_payload_t;
+
+#endif
 
 void Session::RegenerateNonce() {
   local_nonce_ = (((local_nonce_ << 5) | (local_nonce_ >> 5)) + 1);
@@ -85,9 +101,7 @@ tvm_crt_error_t Session::StartSession() {
 
   RegenerateNonce();
   SetSessionId(local_nonce_, 0);
-  microtvm_session_start_payload_t payload = {Session::kVersion};
-  tvm_crt_error_t to_return = SendInternal(MessageType::kStartSessionInit,
-                                           reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
+  tvm_crt_error_t to_return = SendSessionStart(MessageType::kStartSessionInit);
   if (to_return == 0) {
     state_ = State::kStartSessionSent;
   }
@@ -102,6 +116,7 @@ tvm_crt_error_t Session::Initialize(uint8_t initial_session_nonce) {
 
 tvm_crt_error_t Session::TerminateSession() {
   SetSessionId(0, 0);
+  peer_max_packet_size_bytes_ = 0;
   state_ = State::kNoSessionEstablished;
   return SendInternal(MessageType::kTerminateSession, nullptr, 0);
 }
@@ -179,12 +194,19 @@ void Session::ClearReceiveBuffer() {
   receive_buffer_->Clear();
 }
 
-void Session::SendSessionStartReply(const SessionHeader& header) {
+tvm_crt_error_t Session::SendSessionStart(MessageType message_type) {
+  microtvm_session_start_payload_t payload;
+  payload.version = Session::kVersion;
+  payload.max_packet_size_bytes = receive_buffer_ != nullptr ? receive_buffer_->Capacity() : 0;
+  return SendInternal(message_type, reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
+}
+
+void Session::SendSessionStartReply(const SessionHeader& header,
+                                    uint32_t peer_max_packet_size_bytes) {
   RegenerateNonce();
   SetSessionId(InitiatorNonce(header.session_id), local_nonce_);
-  microtvm_session_start_payload_t payload = {Session::kVersion};
-  tvm_crt_error_t to_return = SendInternal(MessageType::kStartSessionReply,
-                                           reinterpret_cast<uint8_t*>(&payload), sizeof(payload));
+  peer_max_packet_size_bytes_ = peer_max_packet_size_bytes;
+  tvm_crt_error_t to_return = SendSessionStart(MessageType::kStartSessionReply);
   state_ = State::kSessionEstablished;
   CHECK_EQ(to_return, kTvmErrorNoError, "SendSessionStartReply");
   OnSessionEstablishedMessage();
@@ -205,14 +227,14 @@ void Session::ProcessStartSessionInit(const SessionHeader& header) {
     case State::kReset:
     case State::kNoSessionEstablished:
       // Normal case: received a StartSession packet from reset.
-      SendSessionStartReply(header);
+      SendSessionStartReply(header, payload.max_packet_size_bytes);
       break;
 
     case State::kStartSessionSent:
       // When two StartSessionInit packets sent simultaneously: lowest nonce wins; ties retry.
       if (InitiatorNonce(header.session_id) < local_nonce_) {
         if (payload.version == Session::kVersion) {
-          SendSessionStartReply(header);
+          SendSessionStartReply(header, payload.max_packet_size_bytes);
         }
       } else if (InitiatorNonce(header.session_id) == local_nonce_) {
         StartSession();
@@ -221,7 +243,7 @@ void Session::ProcessStartSessionInit(const SessionHeader& header) {
       break;
 
     case State::kSessionEstablished:
-      SendSessionStartReply(header);
+      SendSessionStartReply(header, payload.max_packet_size_bytes);
       OnSessionEstablishedMessage();
       break;
 
@@ -249,6 +271,7 @@ void Session::ProcessStartSessionReply(const SessionHeader& header) {
       if (InitiatorNonce(header.session_id) == local_nonce_ &&
           payload.version == Session::kVersion) {
         SetSessionId(local_nonce_, ResponderNonce(header.session_id));
+        peer_max_packet_size_bytes_ = payload.max_packet_size_bytes;
         state_ = State::kSessionEstablished;
         OnSessionEstablishedMessage();
       }
@@ -257,7 +280,7 @@ void Session::ProcessStartSessionReply(const SessionHeader& header) {
       if (InitiatorNonce(header.session_id) != kInvalidNonce &&
           ResponderNonce(header.session_id) == kInvalidNonce) {
         if (payload.version == Session::kVersion) {
-          SendSessionStartReply(header);
+          SendSessionStartReply(header, payload.max_packet_size_bytes);
         } else {
           SetSessionId(local_nonce_, 0);
           state_ = State::kReset;
@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <tvm/runtime/crt/error_codes.h>
 #include <tvm/runtime/crt/page_allocator.h>
 
@@ -63,6 +64,15 @@ tvm_crt_error_t TVMPlatformBeforeMeasurement() { return kTvmErrorNoError; }
 // Platform-specific after measurement call.
 tvm_crt_error_t TVMPlatformAfterMeasurement() { return kTvmErrorNoError; }
 
+// Start copying a buffer, e.g. with DMA.
+tvm_crt_error_t TVMPlatformMemcpyAsync(void* dst, const void* src, uint32_t num_bytes) {
+  memcpy(dst, src, num_bytes);
+  return kTvmErrorNoError;
+}
+
+// Wait for the copy into a buffer to complete.
+tvm_crt_error_t TVMPlatformMemcpyWait(void* dst) { return kTvmErrorNoError; }
+
 // Fill a buffer with random data.
 tvm_crt_error_t TVMPlatformGenerateRandom(uint8_t* buffer, size_t num_bytes) {
   return kTvmErrorNoError;
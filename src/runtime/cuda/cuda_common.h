@@ -27,7 +27,9 @@
 #include <cuda_runtime.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "../workspace_pool.h"
 
@@ -51,6 +53,47 @@ namespace runtime {
         << "CUDA: " << cudaGetErrorString(e);                 \
   }
 
+/*!
+ * \brief Pinned host buffers which stage the copies between pageable host memory and a device.
+ *
+ *  A copy is split into chunks which alternate between two buffers, so that the host memcpy of
+ *  one chunk overlaps the DMA of the other.
+ */
+class CUDAStagingPool {
+ public:
+  /*! \brief The size of each pinned buffer. */
+  static constexpr size_t kChunkSize = 4 << 20;
+  /*! \brief Smaller copies are not staged, the driver handles them as well. */
+  static constexpr size_t kMinStagedSize = 1 << 16;
+
+  explicit CUDAStagingPool(int device_id);
+  ~CUDAStagingPool();
+  CUDAStagingPool(const CUDAStagingPool&) = delete;
+  CUDAStagingPool& operator=(const CUDAStagingPool&) = delete;
+
+  /*!
+   * \brief Copy pageable host memory to the device.
+   *  Returns once the host memory can be reused, the copy completes in the order of the stream.
+   */
+  void CopyToDevice(const void* from, void* to, size_t size, cudaStream_t stream);
+  /*!
+   * \brief Copy device memory to pageable host memory.
+   *  Returns once the copy is complete.
+   */
+  void CopyFromDevice(const void* from, void* to, size_t size, cudaStream_t stream);
+
+ private:
+  static constexpr int kNumBuffers = 2;
+  /*! \brief Take the next buffer, once the copies still using it are done. */
+  int NextBuffer();
+
+  char* buffers_[kNumBuffers] = {nullptr, nullptr};
+  /*! \brief Recorded on the stream after the last copy using each buffer. */
+  cudaEvent_t events_[kNumBuffers] = {nullptr, nullptr};
+  bool pending_[kNumBuffers] = {false, false};
+  int next_{0};
+};
+
 /*! \brief Thread local workspace */
 class CUDAThreadEntry {
  public:
@@ -58,8 +101,12 @@ class CUDAThreadEntry {
   cudaStream_t stream{nullptr};
   /*! \brief thread local pool*/
   WorkspacePool pool;
+  /*! \brief The staging buffers of each device, created on first use. */
+  std::unordered_map<int, std::unique_ptr<CUDAStagingPool>> staging_pools;
   /*! \brief constructor */
   CUDAThreadEntry();
+  // get the staging pool of a device
+  CUDAStagingPool* StagingPool(int device_id);
   // get the threadlocal workspace
   static CUDAThreadEntry* ThreadLocal();
 };
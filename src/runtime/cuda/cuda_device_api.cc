@@ -28,7 +28,12 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 #include "cuda_common.h"
 
@@ -110,18 +115,32 @@ class CUDADeviceAPI final : public DeviceAPI {
   }
   void* AllocDataSpace(Device dev, size_t nbytes, size_t alignment, DLDataType type_hint) final {
     ICHECK_EQ(256 % alignment, 0U) << "CUDA space is aligned at 256 bytes";
-    void* ret;
+    void* ret = nullptr;
     if (dev.device_type == kDLCUDAHost) {
       VLOG(1) << "allocating " << nbytes << "bytes on host";
       CUDA_CALL(cudaMallocHost(&ret, nbytes));
+      return ret;
+    }
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    std::lock_guard<std::mutex> lock(alloc_mutex_);
+    AllocState& state = GetAllocState(dev.device_id);
+    if (state.stream_ordered) {
+#if CUDART_VERSION >= 11030
+      // The memory goes back to the pool of the device on free, so later requests of the
+      // stream do not synchronize the device.
+      CUDA_CALL(cudaMallocFromPoolAsync(&ret, nbytes, state.pool,
+                                        CUDAThreadEntry::ThreadLocal()->stream));
+#endif
     } else {
-      CUDA_CALL(cudaSetDevice(dev.device_id));
       size_t free_mem, total_mem;
       CUDA_CALL(cudaMemGetInfo(&free_mem, &total_mem));
       VLOG(1) << "allocating " << nbytes << " bytes on device, with " << free_mem
               << " bytes currently free out of " << total_mem << " bytes available";
       CUDA_CALL(cudaMalloc(&ret, nbytes));
     }
+    state.buffers[ret] = {nbytes, state.stream_ordered};
+    state.allocated_bytes += nbytes;
+    state.peak_allocated_bytes = std::max(state.peak_allocated_bytes, state.allocated_bytes);
     return ret;
   }
 
@@ -129,13 +148,69 @@ class CUDADeviceAPI final : public DeviceAPI {
     if (dev.device_type == kDLCUDAHost) {
       VLOG(1) << "freeing host memory";
       CUDA_CALL(cudaFreeHost(ptr));
+      return;
+    }
+    CUDA_CALL(cudaSetDevice(dev.device_id));
+    std::lock_guard<std::mutex> lock(alloc_mutex_);
+    AllocState& state = GetAllocState(dev.device_id);
+    auto it = state.buffers.find(ptr);
+    // A buffer is freed the way it was allocated, the mode may have changed since.
+    bool stream_ordered = it != state.buffers.end() && it->second.stream_ordered;
+    if (it != state.buffers.end()) {
+      state.allocated_bytes -= it->second.size;
+      state.buffers.erase(it);
+    }
+    if (stream_ordered) {
+#if CUDART_VERSION >= 11030
+      CUDA_CALL(cudaFreeAsync(ptr, CUDAThreadEntry::ThreadLocal()->stream));
+#endif
     } else {
-      CUDA_CALL(cudaSetDevice(dev.device_id));
       VLOG(1) << "freeing device memory";
       CUDA_CALL(cudaFree(ptr));
     }
   }
 
+  /*!
+   * \brief Select how the data space of a device is allocated.
+   * \param device_id The device.
+   * \param mode "default" for cudaMalloc, "stream_ordered" for cudaMallocAsync from the memory
+   *  pool of the device, which keeps the freed memory reserved for later requests.
+   */
+  void SetAllocatorMode(int device_id, const std::string& mode) {
+    ICHECK(mode == "default" || mode == "stream_ordered")
+        << "Unknown CUDA allocator mode " << mode << ", expected default or stream_ordered";
+    std::lock_guard<std::mutex> lock(alloc_mutex_);
+    SetAllocatorModeLocked(&GetAllocState(device_id), device_id, mode == "stream_ordered");
+  }
+
+  /*!
+   * \brief The memory statistics of the data space of a device.
+   * \param device_id The device.
+   * \return The bytes allocated and reserved from the device, and their peaks. The reserved
+   *  bytes include the freed memory kept by the stream ordered pool.
+   */
+  Map<String, ObjectRef> GetAllocatorStats(int device_id) {
+    std::lock_guard<std::mutex> lock(alloc_mutex_);
+    AllocState& state = GetAllocState(device_id);
+    uint64_t reserved = state.allocated_bytes, peak_reserved = state.peak_allocated_bytes;
+#if CUDART_VERSION >= 11030
+    if (state.pool != nullptr) {
+      CUDA_CALL(cudaMemPoolGetAttribute(state.pool, cudaMemPoolAttrReservedMemCurrent, &reserved));
+      CUDA_CALL(
+          cudaMemPoolGetAttribute(state.pool, cudaMemPoolAttrReservedMemHigh, &peak_reserved));
+    }
+#endif
+    auto count = [](size_t value) {
+      return ObjectRef(make_object<profiling::CountNode>(static_cast<int64_t>(value)));
+    };
+    Map<String, ObjectRef> stats;
+    stats.Set("allocated_bytes", count(state.allocated_bytes));
+    stats.Set("peak_allocated_bytes", count(state.peak_allocated_bytes));
+    stats.Set("reserved_bytes", count(reserved));
+    stats.Set("peak_reserved_bytes", count(peak_reserved));
+    return stats;
+  }
+
  protected:
   void CopyDataFromTo(const void* from, size_t from_offset, void* to, size_t to_offset, size_t size,
                       Device dev_from, Device dev_to, DLDataType type_hint,
@@ -167,10 +242,22 @@ class CUDADeviceAPI final : public DeviceAPI {
       }
     } else if (dev_from.device_type == kDLCUDA && dev_to.device_type == kDLCPU) {
       CUDA_CALL(cudaSetDevice(dev_from.device_id));
-      GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
+      if (size >= CUDAStagingPool::kMinStagedSize && IsPageable(to)) {
+        CUDAThreadEntry::ThreadLocal()
+            ->StagingPool(dev_from.device_id)
+            ->CopyFromDevice(from, to, size, cu_stream);
+      } else {
+        GPUCopy(from, to, size, cudaMemcpyDeviceToHost, cu_stream);
+      }
     } else if (dev_from.device_type == kDLCPU && dev_to.device_type == kDLCUDA) {
       CUDA_CALL(cudaSetDevice(dev_to.device_id));
-      GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      if (size >= CUDAStagingPool::kMinStagedSize && IsPageable(from)) {
+        CUDAThreadEntry::ThreadLocal()
+            ->StagingPool(dev_to.device_id)
+            ->CopyToDevice(from, to, size, cu_stream);
+      } else {
+        GPUCopy(from, to, size, cudaMemcpyHostToDevice, cu_stream);
+      }
     } else {
       LOG(FATAL) << "expect copy from/to GPU or between GPU";
     }
@@ -195,7 +282,8 @@ class CUDADeviceAPI final : public DeviceAPI {
     cudaStream_t src_stream = static_cast<cudaStream_t>(event_src);
     cudaStream_t dst_stream = static_cast<cudaStream_t>(event_dst);
     cudaEvent_t evt;
-    CUDA_CALL(cudaEventCreate(&evt));
+    // The event only orders the streams, timing it would make it more expensive to record.
+    CUDA_CALL(cudaEventCreateWithFlags(&evt, cudaEventDisableTiming));
     CUDA_CALL(cudaEventRecord(evt, src_stream));
     CUDA_CALL(cudaStreamWaitEvent(dst_stream, evt, 0));
     CUDA_CALL(cudaEventDestroy(evt));
@@ -210,6 +298,10 @@ class CUDADeviceAPI final : public DeviceAPI {
     CUDAThreadEntry::ThreadLocal()->stream = static_cast<cudaStream_t>(stream);
   }
 
+  TVMStreamHandle GetCurrentStream(Device dev) final {
+    return static_cast<TVMStreamHandle>(CUDAThreadEntry::ThreadLocal()->stream);
+  }
+
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final {
     return CUDAThreadEntry::ThreadLocal()->pool.AllocWorkspace(dev, size);
   }
@@ -226,6 +318,71 @@ class CUDADeviceAPI final : public DeviceAPI {
   }
 
  private:
+  /*! \brief The data space allocations of a device. */
+  struct AllocState {
+    struct BufferInfo {
+      size_t size;
+      bool stream_ordered;
+    };
+    bool initialized{false};
+    bool stream_ordered{false};
+#if CUDART_VERSION >= 11030
+    cudaMemPool_t pool{nullptr};
+#else
+    void* pool{nullptr};
+#endif
+    std::unordered_map<void*, BufferInfo> buffers;
+    size_t allocated_bytes{0};
+    size_t peak_allocated_bytes{0};
+  };
+
+  AllocState& GetAllocState(int device_id) {
+    AllocState& state = alloc_states_[device_id];
+    if (!state.initialized) {
+      state.initialized = true;
+      // TVM_CUDA_ALLOCATOR selects the mode of the devices which are not set explicitly.
+      const char* mode = std::getenv("TVM_CUDA_ALLOCATOR");
+      if (mode != nullptr && std::string(mode) == "stream_ordered") {
+        SetAllocatorModeLocked(&state, device_id, true);
+      }
+    }
+    return state;
+  }
+
+  void SetAllocatorModeLocked(AllocState* state, int device_id, bool stream_ordered) {
+    if (!stream_ordered || state->pool != nullptr) {
+      state->stream_ordered = stream_ordered;
+      return;
+    }
+#if CUDART_VERSION >= 11030
+    int supported = 0;
+    CUDA_CALL(cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported, device_id));
+    if (!supported) {
+      LOG(WARNING) << "CUDA device " << device_id
+                   << " does not support memory pools, use the default allocator";
+      return;
+    }
+    CUDA_CALL(cudaDeviceGetDefaultMemPool(&state->pool, device_id));
+    // Keep the freed memory in the pool instead of releasing it at every synchronization.
+    uint64_t threshold = UINT64_MAX;
+    CUDA_CALL(cudaMemPoolSetAttribute(state->pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+    state->stream_ordered = true;
+#else
+    LOG(WARNING) << "The stream ordered allocator needs CUDA 11.3, use the default allocator";
+#endif
+  }
+
+  /*! \brief Whether host memory is neither pinned nor registered with CUDA. */
+  static bool IsPageable(const void* ptr) {
+    cudaPointerAttributes attr;
+    if (cudaPointerGetAttributes(&attr, ptr) != cudaSuccess) {
+      // Clear the error of older runtimes, which reject unregistered pointers.
+      cudaGetLastError();
+      return true;
+    }
+    return attr.type == cudaMemoryTypeUnregistered;
+  }
+
   static void GPUCopy(const void* from, void* to, size_t size, cudaMemcpyKind kind,
                       cudaStream_t stream) {
     if (stream != nullptr) {
@@ -234,6 +391,10 @@ class CUDADeviceAPI final : public DeviceAPI {
       CUDA_CALL(cudaMemcpy(to, from, size, kind));
     }
   }
+
+  // Guards alloc_states_
+  std::mutex alloc_mutex_;
+  std::unordered_map<int, AllocState> alloc_states_;
 };
 
 typedef dmlc::ThreadLocalStore<CUDAThreadEntry> CUDAThreadStore;
@@ -242,6 +403,85 @@ CUDAThreadEntry::CUDAThreadEntry() : pool(kDLCUDA, CUDADeviceAPI::Global()) {}
 
 CUDAThreadEntry* CUDAThreadEntry::ThreadLocal() { return CUDAThreadStore::Get(); }
 
+CUDAStagingPool* CUDAThreadEntry::StagingPool(int device_id) {
+  std::unique_ptr<CUDAStagingPool>& staging = staging_pools[device_id];
+  if (staging == nullptr) {
+    staging = std::make_unique<CUDAStagingPool>(device_id);
+  }
+  return staging.get();
+}
+
+CUDAStagingPool::CUDAStagingPool(int device_id) {
+  // The events belong to the device of the streams they are recorded on.
+  CUDA_CALL(cudaSetDevice(device_id));
+  for (int i = 0; i < kNumBuffers; ++i) {
+    CUDA_CALL(cudaMallocHost(reinterpret_cast<void**>(&buffers_[i]), kChunkSize));
+    CUDA_CALL(cudaEventCreateWithFlags(&events_[i], cudaEventDisableTiming));
+  }
+}
+
+CUDAStagingPool::~CUDAStagingPool() {
+  for (int i = 0; i < kNumBuffers; ++i) {
+    if (pending_[i]) CUDA_CALL(cudaEventSynchronize(events_[i]));
+    CUDA_CALL(cudaEventDestroy(events_[i]));
+    CUDA_CALL(cudaFreeHost(buffers_[i]));
+  }
+}
+
+int CUDAStagingPool::NextBuffer() {
+  int index = next_;
+  next_ = (next_ + 1) % kNumBuffers;
+  if (pending_[index]) {
+    CUDA_CALL(cudaEventSynchronize(events_[index]));
+    pending_[index] = false;
+  }
+  return index;
+}
+
+void CUDAStagingPool::CopyToDevice(const void* from, void* to, size_t size, cudaStream_t stream) {
+  const char* src = static_cast<const char*>(from);
+  char* dst = static_cast<char*>(to);
+  for (size_t offset = 0; offset < size; offset += kChunkSize) {
+    size_t nbytes = std::min(kChunkSize, size - offset);
+    int index = NextBuffer();
+    std::memcpy(buffers_[index], src + offset, nbytes);
+    CUDA_CALL(cudaMemcpyAsync(dst + offset, buffers_[index], nbytes, cudaMemcpyHostToDevice,
+                              stream));
+    CUDA_CALL(cudaEventRecord(events_[index], stream));
+    pending_[index] = true;
+  }
+}
+
+void CUDAStagingPool::CopyFromDevice(const void* from, void* to, size_t size,
+                                     cudaStream_t stream) {
+  const char* src = static_cast<const char*>(from);
+  char* dst = static_cast<char*>(to);
+  // The chunk which is copied to the host after the DMA of the next one is issued.
+  int prev_index = -1;
+  size_t prev_offset = 0, prev_nbytes = 0;
+  size_t num_chunks = (size + kChunkSize - 1) / kChunkSize;
+  for (size_t i = 0; i <= num_chunks; ++i) {
+    size_t offset = i * kChunkSize;
+    size_t nbytes = i < num_chunks ? std::min(kChunkSize, size - offset) : 0;
+    int index = -1;
+    if (nbytes != 0) {
+      index = NextBuffer();
+      CUDA_CALL(cudaMemcpyAsync(buffers_[index], src + offset, nbytes, cudaMemcpyDeviceToHost,
+                                stream));
+      CUDA_CALL(cudaEventRecord(events_[index], stream));
+      pending_[index] = true;
+    }
+    if (prev_index >= 0) {
+      CUDA_CALL(cudaEventSynchronize(events_[prev_index]));
+      pending_[prev_index] = false;
+      std::memcpy(dst + prev_offset, buffers_[prev_index], prev_nbytes);
+    }
+    prev_index = index;
+    prev_offset = offset;
+    prev_nbytes = nbytes;
+  }
+}
+
 TVM_REGISTER_GLOBAL("device_api.cuda").set_body([](TVMArgs args, TVMRetValue* rv) {
   DeviceAPI* ptr = CUDADeviceAPI::Global();
   *rv = static_cast<void*>(ptr);
@@ -252,6 +492,19 @@ TVM_REGISTER_GLOBAL("device_api.cuda_host").set_body([](TVMArgs args, TVMRetValu
   *rv = static_cast<void*>(ptr);
 });
 
+TVM_REGISTER_GLOBAL("device_api.cuda.set_allocator_mode")
+    .set_body_typed([](Device dev, String mode) {
+      CUDADeviceAPI::Global()->SetAllocatorMode(dev.device_id, mode);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.CUDAAllocatorStats").set_body_typed([](Device dev) {
+  return CUDADeviceAPI::Global()->GetAllocatorStats(dev.device_id);
+});
+
+TVM_REGISTER_GLOBAL("runtime.CUDAWorkspacePoolStats").set_body_typed([](Device dev) {
+  return CUDAThreadEntry::ThreadLocal()->pool.GetStats(dev).AsMap();
+});
+
 class CUDATimerNode : public TimerNode {
  public:
   virtual void Start() {
@@ -300,5 +553,93 @@ TVM_DLL String GetCudaFreeMemory() {
 
 TVM_REGISTER_GLOBAL("runtime.GetCudaFreeMemory").set_body_typed(GetCudaFreeMemory);
 
+#if CUDA_VERSION >= 12000
+/*!
+ * \brief Encode the CUtensorMap of the tiles of a compact tensor into device memory, for the
+ *  bulk tensor copies of ptx_cp_async_bulk_tensor.
+ *
+ *  The arguments are the 128 byte device buffer of the tensor map, the tensor, the swizzle in
+ *  bytes (0, 32, 64 or 128) and the box shape, outermost dimension first.
+ */
+TVM_REGISTER_GLOBAL("runtime.cuTensorMapEncodeTiled").set_body([](TVMArgs args, TVMRetValue* rv) {
+  ICHECK_GE(args.num_args, 4) << "Expect the tensor map, the tensor, the swizzle and the box shape";
+  DLTensor* tensor_map = args[0];
+  DLTensor* tensor = args[1];
+  int swizzle = args[2];
+  int rank = tensor->ndim;
+  ICHECK(rank >= 1 && rank <= 5) << "The tensor map supports 1 to 5 dimensions, got " << rank;
+  ICHECK_EQ(args.num_args, 3 + rank) << "Expect one box size per dimension of the tensor";
+  ICHECK(tensor->strides == nullptr) << "The tensor map only supports compact tensors";
+  ICHECK_GE(GetDataSize(*tensor_map), sizeof(CUtensorMap));
+  ICHECK_EQ(tensor_map->device.device_type, kDLCUDA);
+  ICHECK_EQ(tensor->device.device_type, kDLCUDA);
+
+  DLDataType dtype = tensor->dtype;
+  CUtensorMapDataType map_dtype;
+  if (dtype.code == kDLFloat && dtype.bits == 16) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_FLOAT16;
+  } else if (dtype.code == kDLFloat && dtype.bits == 32) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_FLOAT32;
+  } else if (dtype.code == kDLFloat && dtype.bits == 64) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_FLOAT64;
+  } else if (dtype.code == kDLBfloat && dtype.bits == 16) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_BFLOAT16;
+  } else if (dtype.code == kDLInt && dtype.bits == 32) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_INT32;
+  } else if (dtype.code == kDLInt && dtype.bits == 64) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_INT64;
+  } else if (dtype.bits == 8) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_UINT8;
+  } else if (dtype.bits == 16) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_UINT16;
+  } else if (dtype.bits == 32) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_UINT32;
+  } else if (dtype.bits == 64) {
+    map_dtype = CU_TENSOR_MAP_DATA_TYPE_UINT64;
+  } else {
+    LOG(FATAL) << "Unsupported data type of the tensor map " << DLDataType2String(dtype);
+  }
+  CUtensorMapSwizzle map_swizzle;
+  if (swizzle == 0) {
+    map_swizzle = CU_TENSOR_MAP_SWIZZLE_NONE;
+  } else if (swizzle == 32) {
+    map_swizzle = CU_TENSOR_MAP_SWIZZLE_32B;
+  } else if (swizzle == 64) {
+    map_swizzle = CU_TENSOR_MAP_SWIZZLE_64B;
+  } else if (swizzle == 128) {
+    map_swizzle = CU_TENSOR_MAP_SWIZZLE_128B;
+  } else {
+    LOG(FATAL) << "The swizzle of the tensor map must be 0, 32, 64 or 128 bytes, got " << swizzle;
+  }
+
+  // The tensor map lists the dimensions innermost first.
+  cuuint64_t global_dim[5], global_strides[4];
+  cuuint32_t box_dim[5], element_strides[5];
+  cuuint64_t stride = (dtype.bits * dtype.lanes + 7) / 8;
+  for (int i = 0; i < rank; ++i) {
+    int dim = rank - 1 - i;
+    global_dim[i] = static_cast<cuuint64_t>(tensor->shape[dim]);
+    box_dim[i] = static_cast<cuuint32_t>(args[3 + dim].operator int());
+    element_strides[i] = 1;
+    stride *= global_dim[i];
+    if (i + 1 < rank) global_strides[i] = stride;
+  }
+  CUtensorMap map;
+  void* global_addr = static_cast<char*>(tensor->data) + tensor->byte_offset;
+  CUresult result = cuTensorMapEncodeTiled(
+      &map, map_dtype, rank, global_addr, global_dim, global_strides, box_dim, element_strides,
+      CU_TENSOR_MAP_INTERLEAVE_NONE, map_swizzle, CU_TENSOR_MAP_L2_PROMOTION_L2_128B,
+      CU_TENSOR_MAP_FLOAT_OOB_FILL_NONE);
+  if (result != CUDA_SUCCESS) {
+    const char* msg;
+    cuGetErrorName(result, &msg);
+    LOG(FATAL) << "Failed to encode the tensor map: " << msg;
+  }
+  CUDA_CALL(cudaSetDevice(tensor_map->device.device_id));
+  CUDA_CALL(cudaMemcpy(static_cast<char*>(tensor_map->data) + tensor_map->byte_offset, &map,
+                       sizeof(map), cudaMemcpyHostToDevice));
+});
+#endif
+
 }  // namespace runtime
 }  // namespace tvm
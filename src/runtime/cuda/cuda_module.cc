@@ -251,6 +251,20 @@ PackedFunc CUDAModuleNode::GetFunction(const String& name, const ObjectPtr<Objec
   ICHECK_NE(name, symbol::tvm_module_main) << "Device function do not have main";
   if (name == symbol::tvm_prepare_global_barrier) {
     return PackedFunc(CUDAPrepGlobalBarrier(this, sptr_to_self));
+  } else if (name == symbol::tvm_module_preload) {
+    return TypedPackedFunc<void(Device)>([sptr_to_self, this](Device dev) {
+      if (dev.device_type != kDLCUDA) return;
+      // The module is loaded into the primary context of the current device.
+      int prev_device_id;
+      CUDA_CALL(cudaGetDevice(&prev_device_id));
+      CUDA_CALL(cudaSetDevice(dev.device_id));
+      for (const auto& kv : fmap_) {
+        GetFunc(dev.device_id, kv.first);
+      }
+      CUDA_CALL(cudaSetDevice(prev_device_id));
+    });
+  } else if (name == "get_func_names") {
+    return GetFuncNamesFunc(fmap_, sptr_to_self, {symbol::tvm_prepare_global_barrier});
   }
   auto it = fmap_.find(name);
   if (it == fmap_.end()) return PackedFunc();
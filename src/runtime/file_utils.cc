@@ -24,14 +24,30 @@
 
 #include <dmlc/json.h>
 #include <dmlc/memory_io.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <memory>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "float_convert.h"
+
 namespace tvm {
 namespace runtime {
 
@@ -75,6 +91,21 @@ bool FunctionInfo::Load(dmlc::Stream* reader) {
   return true;
 }
 
+PackedFunc GetFuncNamesFunc(const std::unordered_map<std::string, FunctionInfo>& fmap,
+                            const ObjectPtr<Object>& sptr_to_self,
+                            std::vector<std::string> extra_names) {
+  return PackedFunc([&fmap, sptr_to_self, extra_names](TVMArgs args, TVMRetValue* rv) {
+    Array<String> names;
+    for (const std::string& name : extra_names) {
+      names.push_back(name);
+    }
+    for (const auto& kv : fmap) {
+      names.push_back(kv.first);
+    }
+    *rv = names;
+  });
+}
+
 std::string GetFileFormat(const std::string& file_name, const std::string& format) {
   std::string fmt = format;
   if (fmt.length() == 0) {
@@ -236,6 +267,322 @@ std::string SaveParams(const Map<String, NDArray>& params) {
   return bytes;
 }
 
+namespace {
+
+/*! \brief The header of a tensor written by SaveDLTensor. */
+struct TensorHeader {
+  std::vector<int64_t> shape;
+  DLDataType dtype;
+  uint64_t data_byte_size;
+  /*! \brief The number of bytes of one element, the data is byte swapped by elements. */
+  size_t elem_bytes;
+};
+
+TensorHeader ReadTensorHeader(dmlc::Stream* strm) {
+  uint64_t header, reserved;
+  ICHECK(strm->Read(&header)) << "Invalid DLTensor file format";
+  ICHECK(strm->Read(&reserved)) << "Invalid DLTensor file format";
+  ICHECK(header == kTVMNDArrayMagic) << "Invalid DLTensor file format";
+  Device dev;
+  int ndim;
+  TensorHeader ret;
+  ICHECK(strm->Read(&dev)) << "Invalid DLTensor file format";
+  ICHECK(strm->Read(&ndim)) << "Invalid DLTensor file format";
+  ICHECK(strm->Read(&ret.dtype)) << "Invalid DLTensor file format";
+  ICHECK_EQ(dev.device_type, kDLCPU) << "Invalid DLTensor device: can only save as CPU tensor";
+  ret.shape.resize(ndim);
+  if (ndim != 0) {
+    ICHECK(strm->ReadArray(&ret.shape[0], ndim)) << "Invalid DLTensor file format";
+  }
+  int64_t num_elems = 1;
+  for (int64_t dim : ret.shape) num_elems *= dim;
+  ret.elem_bytes = (ret.dtype.bits + 7) / 8;
+  int64_t data_byte_size;
+  ICHECK(strm->Read(&data_byte_size)) << "Invalid DLTensor file format";
+  ICHECK(data_byte_size == num_elems * static_cast<int64_t>(ret.elem_bytes))
+      << "Invalid DLTensor file format";
+  ret.data_byte_size = data_byte_size;
+  return ret;
+}
+
+/*!
+ * \brief Check that \p dest can receive the tensor of \p header, with the same dtype or one
+ *  converted by ConvertFloatArray.
+ */
+void CheckDestination(const std::string& name, const TensorHeader& header, const NDArray& dest) {
+  ICHECK(dest.IsContiguous()) << "Parameter " << name << " must be loaded into a contiguous array";
+  ICHECK(dest.Shape() == ShapeTuple(header.shape)) << "Shape mismatch for parameter " << name;
+  ICHECK(dest.DataType() == DataType(header.dtype) || IsFloatConvertible(header.dtype, dest->dtype))
+      << "DType mismatch for parameter " << name;
+}
+
+/*! \brief Whether the tensor of \p header is converted to the dtype of \p dest when loaded. */
+bool NeedsConversion(const TensorHeader& header, const NDArray& dest) {
+  return dest.DataType() != DataType(header.dtype);
+}
+
+/*! \brief Read \p nbytes of tensor data in place, swapping the bytes if needed. */
+void ReadTensorData(dmlc::Stream* strm, void* data, uint64_t nbytes, size_t elem_bytes) {
+  if (nbytes == 0) return;
+  ICHECK_EQ(strm->Read(data, nbytes), nbytes) << "Invalid DLTensor file format";
+  if (!DMLC_IO_NO_ENDIAN_SWAP) {
+    dmlc::ByteSwap(data, elem_bytes, nbytes / elem_bytes);
+  }
+}
+
+/*! \brief Copy \p nbytes from host memory to \p dest, at byte \p offset of its data. */
+void CopyChunkToDevice(const void* host, const NDArray& dest, uint64_t offset, uint64_t nbytes) {
+  int64_t chunk = static_cast<int64_t>(nbytes);
+  DLTensor from{const_cast<void*>(host), Device{kDLCPU, 0}, 1, DLDataType{kDLUInt, 8, 1},
+                &chunk,                  nullptr,           0};
+  DLTensor to = *dest.operator->();
+  to.ndim = 1;
+  to.dtype = DLDataType{kDLUInt, 8, 1};
+  to.shape = &chunk;
+  to.strides = nullptr;
+  to.byte_offset += offset;
+  DeviceAPI* api = DeviceAPI::Get(dest->device);
+  api->CopyDataFromTo(&from, &to, nullptr);
+  // The staging buffer is reused once the copy returns.
+  api->StreamSync(dest->device, nullptr);
+}
+
+/*! \brief The largest chunk of a tensor fitting in \p staging_bytes, in whole elements. */
+uint64_t ChunkBytes(size_t staging_bytes, size_t elem_bytes) {
+  uint64_t chunk = staging_bytes - staging_bytes % elem_bytes;
+  ICHECK_GT(chunk, 0) << "The staging buffer cannot hold an element";
+  return chunk;
+}
+
+/*! \brief The number of elements of the chunks of a tensor converted to the dtype of dest. */
+uint64_t ConvertedChunkElems(size_t staging_bytes, const TensorHeader& header,
+                             const NDArray& dest) {
+  size_t elem_bytes = std::max<size_t>(header.elem_bytes, (dest->dtype.bits + 7) / 8);
+  return ChunkBytes(staging_bytes, elem_bytes) / elem_bytes;
+}
+
+/*! \brief A dmlc stream reading an std::istream. */
+class IStreamAdapter : public dmlc::Stream {
+ public:
+  explicit IStreamAdapter(std::istream* is) : is_(is) {}
+  using dmlc::Stream::Read;
+  size_t Read(void* ptr, size_t size) final {
+    is_->read(static_cast<char*>(ptr), size);
+    return static_cast<size_t>(is_->gcount());
+  }
+  void Write(const void* ptr, size_t size) final { LOG(FATAL) << "The stream is read-only"; }
+
+ private:
+  std::istream* is_;
+};
+
+}  // namespace
+
+void StreamParams(dmlc::Stream* strm, const ParamDestination& fdest, size_t staging_bytes) {
+  uint64_t header, reserved;
+  ICHECK(strm->Read(&header)) << "Invalid parameters file format";
+  ICHECK(header == kTVMNDArrayListMagic) << "Invalid parameters file format";
+  ICHECK(strm->Read(&reserved)) << "Invalid parameters file format";
+  std::vector<std::string> names;
+  ICHECK(strm->Read(&names)) << "Invalid parameters file format";
+  uint64_t sz;
+  ICHECK(strm->Read(&sz)) << "Invalid parameters file format";
+  ICHECK(static_cast<size_t>(sz) == names.size()) << "Invalid parameters file format";
+
+  struct Chunk {
+    NDArray dest;
+    uint64_t offset;
+    uint64_t size;
+    int buffer;
+  };
+  std::vector<std::vector<char>> buffers(2);
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<Chunk> chunks;
+  std::vector<int> free_buffers{0, 1};
+  bool done = false, abort = false;
+  std::exception_ptr error;
+
+  // The reader thread parses the stream and reads the data, the calling thread copies the
+  // staged chunks to the devices.
+  std::thread reader([&]() {
+    try {
+      for (const std::string& name : names) {
+        TensorHeader tensor = ReadTensorHeader(strm);
+        NDArray dest = fdest(name, tensor.shape, tensor.dtype);
+        uint64_t chunk_bytes = ChunkBytes(staging_bytes, tensor.elem_bytes);
+        if (dest.defined()) CheckDestination(name, tensor, dest);
+        if (dest.defined() && NeedsConversion(tensor, dest)) {
+          // Read the tensor chunk by chunk, and convert each chunk into dest, or into a staging
+          // buffer copied to dest.
+          size_t dest_elem_bytes = (dest->dtype.bits + 7) / 8;
+          uint64_t num_elems = tensor.data_byte_size / tensor.elem_bytes;
+          uint64_t chunk_elems = ConvertedChunkElems(staging_bytes, tensor, dest);
+          std::vector<char> raw;
+          for (uint64_t begin = 0; begin < num_elems; begin += chunk_elems) {
+            uint64_t count = std::min(chunk_elems, num_elems - begin);
+            raw.resize(count * tensor.elem_bytes);
+            ReadTensorData(strm, raw.data(), raw.size(), tensor.elem_bytes);
+            if (dest->device.device_type == kDLCPU) {
+              ConvertFloatArray(raw.data(), tensor.dtype,
+                                static_cast<char*>(dest->data) + dest->byte_offset +
+                                    begin * dest_elem_bytes,
+                                dest->dtype, count);
+              continue;
+            }
+            int buffer;
+            {
+              std::unique_lock<std::mutex> lock(mutex);
+              cv.wait(lock, [&]() { return !free_buffers.empty() || abort; });
+              if (abort) return;
+              buffer = free_buffers.back();
+              free_buffers.pop_back();
+            }
+            uint64_t size = count * dest_elem_bytes;
+            buffers[buffer].resize(std::max<size_t>(buffers[buffer].size(), size));
+            ConvertFloatArray(raw.data(), tensor.dtype, buffers[buffer].data(), dest->dtype, count);
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.push_back(Chunk{dest, begin * dest_elem_bytes, size, buffer});
+            cv.notify_all();
+          }
+          continue;
+        }
+        if (dest.defined() && dest->device.device_type == kDLCPU) {
+          ReadTensorData(strm, static_cast<char*>(dest->data) + dest->byte_offset,
+                         tensor.data_byte_size, tensor.elem_bytes);
+          continue;
+        }
+        for (uint64_t offset = 0; offset < tensor.data_byte_size; offset += chunk_bytes) {
+          uint64_t size = std::min(chunk_bytes, tensor.data_byte_size - offset);
+          int buffer;
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&]() { return !free_buffers.empty() || abort; });
+            if (abort) return;
+            buffer = free_buffers.back();
+            free_buffers.pop_back();
+          }
+          buffers[buffer].resize(std::max<size_t>(buffers[buffer].size(), size));
+          ReadTensorData(strm, buffers[buffer].data(), size, tensor.elem_bytes);
+          std::lock_guard<std::mutex> lock(mutex);
+          if (dest.defined()) {
+            chunks.push_back(Chunk{dest, offset, size, buffer});
+            cv.notify_all();
+          } else {
+            free_buffers.push_back(buffer);
+          }
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+    cv.notify_all();
+  });
+
+  while (true) {
+    Chunk chunk;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return !chunks.empty() || done; });
+      if (chunks.empty()) break;
+      chunk = chunks.front();
+      chunks.pop_front();
+    }
+    try {
+      CopyChunkToDevice(buffers[chunk.buffer].data(), chunk.dest, chunk.offset, chunk.size);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error = std::current_exception();
+      abort = true;
+      cv.notify_all();
+      break;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    free_buffers.push_back(chunk.buffer);
+    cv.notify_all();
+  }
+  reader.join();
+  if (error) std::rethrow_exception(error);
+}
+
+LazyParams::LazyParams(const std::string& path) : file_(path, std::ios::binary) {
+  CHECK(file_.is_open()) << "Unable to open file " << path;
+  IStreamAdapter strm(&file_);
+  uint64_t header, reserved;
+  ICHECK(strm.Read(&header)) << "Invalid parameters file format";
+  ICHECK(header == kTVMNDArrayListMagic) << "Invalid parameters file format";
+  ICHECK(strm.Read(&reserved)) << "Invalid parameters file format";
+  ICHECK(strm.Read(&names_)) << "Invalid parameters file format";
+  uint64_t sz;
+  ICHECK(strm.Read(&sz)) << "Invalid parameters file format";
+  ICHECK(static_cast<size_t>(sz) == names_.size()) << "Invalid parameters file format";
+  for (const std::string& name : names_) {
+    TensorHeader tensor = ReadTensorHeader(&strm);
+    uint64_t offset = static_cast<uint64_t>(file_.tellg());
+    entries_[name] = Entry{tensor.shape, tensor.dtype, offset};
+    file_.seekg(tensor.data_byte_size, std::ios::cur);
+  }
+  ICHECK(file_.good()) << "Invalid parameters file format";
+}
+
+NDArray LazyParams::Load(const std::string& name, Device dev) {
+  auto it = entries_.find(name);
+  ICHECK(it != entries_.end()) << "No parameter called " << name;
+  NDArray dest = NDArray::Empty(ShapeTuple(it->second.shape), it->second.dtype, dev);
+  LoadInto(name, dest);
+  return dest;
+}
+
+void LazyParams::LoadInto(const std::string& name, NDArray dest) {
+  auto it = entries_.find(name);
+  ICHECK(it != entries_.end()) << "No parameter called " << name;
+  const Entry& entry = it->second;
+  TensorHeader tensor{entry.shape, entry.dtype, 0, static_cast<size_t>((entry.dtype.bits + 7) / 8)};
+  int64_t num_elems = 1;
+  for (int64_t dim : entry.shape) num_elems *= dim;
+  tensor.data_byte_size = num_elems * tensor.elem_bytes;
+  CheckDestination(name, tensor, dest);
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_.clear();
+  file_.seekg(entry.offset);
+  IStreamAdapter strm(&file_);
+  if (NeedsConversion(tensor, dest)) {
+    size_t dest_elem_bytes = (dest->dtype.bits + 7) / 8;
+    uint64_t chunk_elems = ConvertedChunkElems(kParamStagingBytes, tensor, dest);
+    std::vector<char> raw, converted;
+    for (uint64_t begin = 0; begin < static_cast<uint64_t>(num_elems); begin += chunk_elems) {
+      uint64_t count = std::min<uint64_t>(chunk_elems, num_elems - begin);
+      raw.resize(count * tensor.elem_bytes);
+      ReadTensorData(&strm, raw.data(), raw.size(), tensor.elem_bytes);
+      char* dest_data = static_cast<char*>(dest->data) + dest->byte_offset;
+      if (dest->device.device_type == kDLCPU) {
+        ConvertFloatArray(raw.data(), tensor.dtype, dest_data + begin * dest_elem_bytes,
+                          dest->dtype, count);
+        continue;
+      }
+      converted.resize(count * dest_elem_bytes);
+      ConvertFloatArray(raw.data(), tensor.dtype, converted.data(), dest->dtype, count);
+      CopyChunkToDevice(converted.data(), dest, begin * dest_elem_bytes, converted.size());
+    }
+    return;
+  }
+  if (dest->device.device_type == kDLCPU) {
+    ReadTensorData(&strm, static_cast<char*>(dest->data) + dest->byte_offset,
+                   tensor.data_byte_size, tensor.elem_bytes);
+    return;
+  }
+  uint64_t chunk_bytes = ChunkBytes(kParamStagingBytes, tensor.elem_bytes);
+  std::vector<char> staging(std::min(chunk_bytes, tensor.data_byte_size));
+  for (uint64_t offset = 0; offset < tensor.data_byte_size; offset += chunk_bytes) {
+    uint64_t size = std::min(chunk_bytes, tensor.data_byte_size - offset);
+    ReadTensorData(&strm, staging.data(), size, tensor.elem_bytes);
+    CopyChunkToDevice(staging.data(), dest, offset, size);
+  }
+}
+
 TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, NDArray>& params) {
   std::string s = ::tvm::runtime::SaveParams(params);
   // copy return array so it is owned by the ret value
@@ -244,6 +591,186 @@ TVM_REGISTER_GLOBAL("runtime.SaveParams").set_body_typed([](const Map<String, ND
   return rv;
 });
 
+namespace {
+
+/*! \brief Header entry describing one tensor of a mappable parameters file. */
+struct MappedTensorInfo {
+  std::string name;
+  DLDataType dtype;
+  std::vector<int64_t> shape;
+  /*! \brief Offset of the payload from the start of the file. */
+  uint64_t offset;
+  uint64_t nbytes;
+};
+
+void WriteMappedHeader(dmlc::Stream* strm, const std::vector<MappedTensorInfo>& infos) {
+  uint64_t header = kTVMMappedParamsMagic, alignment = kMappedParamsAlignment;
+  strm->Write(header);
+  strm->Write(alignment);
+  uint64_t sz = static_cast<uint64_t>(infos.size());
+  strm->Write(sz);
+  for (const MappedTensorInfo& info : infos) {
+    strm->Write(info.name);
+    strm->Write(info.dtype);
+    strm->Write(info.shape);
+    strm->Write(info.offset);
+    strm->Write(info.nbytes);
+  }
+}
+
+std::vector<MappedTensorInfo> ReadMappedHeader(dmlc::Stream* strm) {
+  uint64_t header, alignment, sz;
+  ICHECK(strm->Read(&header)) << "Invalid mappable parameters file format";
+  ICHECK(header == kTVMMappedParamsMagic) << "Invalid mappable parameters file format";
+  ICHECK(strm->Read(&alignment)) << "Invalid mappable parameters file format";
+  ICHECK(strm->Read(&sz)) << "Invalid mappable parameters file format";
+  std::vector<MappedTensorInfo> infos(static_cast<size_t>(sz));
+  for (MappedTensorInfo& info : infos) {
+    ICHECK(strm->Read(&info.name) && strm->Read(&info.dtype) && strm->Read(&info.shape) &&
+           strm->Read(&info.offset) && strm->Read(&info.nbytes))
+        << "Invalid mappable parameters file format";
+    ICHECK_EQ(info.offset % alignment, 0) << "Misaligned tensor '" << info.name << "'";
+  }
+  return infos;
+}
+
+inline uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+#if !defined(_WIN32)
+/*! \brief A read-only (copy-on-write) mapping of a whole file. */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    ICHECK_GE(fd, 0) << "Unable to open file " << path;
+    struct stat st;
+    ICHECK_EQ(fstat(fd, &st), 0) << "Unable to stat file " << path;
+    size_ = static_cast<size_t>(st.st_size);
+    // MAP_PRIVATE keeps the file untouched should a kernel ever write into a constant.
+    data_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    ICHECK(data_ != MAP_FAILED) << "Unable to mmap file " << path;
+  }
+  ~MappedFile() { munmap(data_, size_); }
+
+  char* data() const { return static_cast<char*>(data_); }
+  size_t size() const { return size_; }
+
+ private:
+  void* data_;
+  size_t size_;
+};
+
+/*! \brief The DLPack context of a tensor aliasing a \p MappedFile. */
+struct MappedTensorContext {
+  DLManagedTensor tensor;
+  std::vector<int64_t> shape;
+  std::shared_ptr<MappedFile> file;
+
+  static void Deleter(DLManagedTensor* tensor) {
+    delete static_cast<MappedTensorContext*>(tensor->manager_ctx);
+  }
+};
+#endif
+
+}  // namespace
+
+void SaveMappableParams(const std::string& path, const Map<String, NDArray>& params) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Mappable parameters are only supported on little-endian";
+  std::vector<MappedTensorInfo> infos;
+  std::vector<NDArray> arrays;
+  for (auto& p : params) {
+    const DLTensor* tensor = p.second.operator->();
+    MappedTensorInfo info;
+    info.name = p.first;
+    info.dtype = tensor->dtype;
+    info.shape.assign(tensor->shape, tensor->shape + tensor->ndim);
+    info.offset = 0;
+    info.nbytes = GetDataSize(*tensor);
+    infos.push_back(std::move(info));
+    arrays.push_back(p.second);
+  }
+  // The header has a fixed size for fixed names and shapes, so measure it with
+  // placeholder offsets before laying out the payloads after it.
+  std::string header;
+  {
+    dmlc::MemoryStringStream strm(&header);
+    WriteMappedHeader(&strm, infos);
+  }
+  uint64_t offset = AlignUp(header.size(), kMappedParamsAlignment);
+  for (MappedTensorInfo& info : infos) {
+    info.offset = offset;
+    offset = AlignUp(offset + info.nbytes, kMappedParamsAlignment);
+  }
+
+  SimpleBinaryFileStream strm(path, "wb");
+  WriteMappedHeader(&strm, infos);
+  uint64_t written = header.size();
+  std::vector<char> bytes;
+  for (size_t i = 0; i < infos.size(); ++i) {
+    std::vector<char> padding(infos[i].offset - written, 0);
+    strm.Write(padding.data(), padding.size());
+    bytes.resize(infos[i].nbytes);
+    arrays[i].CopyToBytes(bytes.data(), bytes.size());
+    strm.Write(bytes.data(), bytes.size());
+    written = infos[i].offset + infos[i].nbytes;
+  }
+}
+
+bool IsMappableParamsFile(const std::string& path) {
+  SimpleBinaryFileStream strm(path, "rb");
+  uint64_t header = 0;
+  return strm.Read(&header, sizeof(header)) == sizeof(header) && header == kTVMMappedParamsMagic;
+}
+
+Map<String, NDArray> LoadMappedParams(const std::string& path) {
+  ICHECK(DMLC_IO_NO_ENDIAN_SWAP) << "Mappable parameters are only supported on little-endian";
+  Map<String, NDArray> params;
+  Device cpu_dev{kDLCPU, 0};
+#if !defined(_WIN32)
+  auto file = std::make_shared<MappedFile>(path);
+  dmlc::MemoryFixedSizeStream strm(file->data(), file->size());
+  for (MappedTensorInfo& info : ReadMappedHeader(&strm)) {
+    ICHECK_LE(info.offset + info.nbytes, file->size()) << "Truncated tensor '" << info.name << "'";
+    auto* ctx = new MappedTensorContext();
+    ctx->shape = std::move(info.shape);
+    ctx->file = file;
+    DLTensor& tensor = ctx->tensor.dl_tensor;
+    tensor.data = file->data() + info.offset;
+    tensor.device = cpu_dev;
+    tensor.ndim = static_cast<int>(ctx->shape.size());
+    tensor.dtype = info.dtype;
+    tensor.shape = ctx->shape.data();
+    tensor.strides = nullptr;
+    tensor.byte_offset = 0;
+    ctx->tensor.manager_ctx = ctx;
+    ctx->tensor.deleter = MappedTensorContext::Deleter;
+    params.Set(info.name, NDArray::FromDLPack(&ctx->tensor));
+  }
+#else
+  // No mmap, fall back to reading the payloads into freshly allocated arrays.
+  SimpleBinaryFileStream strm(path, "rb");
+  std::vector<MappedTensorInfo> infos = ReadMappedHeader(&strm);
+  SimpleBinaryFileStream data(path, "rb");
+  uint64_t pos = 0;
+  std::vector<char> bytes;
+  for (const MappedTensorInfo& info : infos) {
+    bytes.resize(info.offset - pos);
+    data.Read(bytes.data(), bytes.size());
+    bytes.resize(info.nbytes);
+    ICHECK_EQ(data.Read(bytes.data(), bytes.size()), bytes.size())
+        << "Truncated tensor '" << info.name << "'";
+    pos = info.offset + info.nbytes;
+    NDArray array = NDArray::Empty(ShapeTuple(info.shape), info.dtype, cpu_dev);
+    array.CopyFromBytes(bytes.data(), bytes.size());
+    params.Set(info.name, array);
+  }
+#endif
+  return params;
+}
+
 TVM_REGISTER_GLOBAL("runtime.SaveParamsToFile")
     .set_body_typed([](const Map<String, NDArray>& params, const String& path) {
       tvm::runtime::SimpleBinaryFileStream strm(path, "wb");
@@ -259,5 +786,14 @@ TVM_REGISTER_GLOBAL("runtime.LoadParamsFromFile").set_body_typed([](const String
   return LoadParams(&strm);
 });
 
+TVM_REGISTER_GLOBAL("runtime.SaveMappableParamsToFile")
+    .set_body_typed([](const Map<String, NDArray>& params, const String& path) {
+      SaveMappableParams(path, params);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.LoadMappedParamsFromFile").set_body_typed([](const String& path) {
+  return LoadMappedParams(path);
+});
+
 }  // namespace runtime
 }  // namespace tvm
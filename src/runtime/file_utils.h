@@ -27,8 +27,12 @@
 #include <tvm/runtime/container/map.h>
 #include <tvm/runtime/container/string.h>
 
+#include <fstream>
+#include <functional>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "meta_data.h"
 
@@ -130,6 +134,103 @@ std::string SaveParams(const Map<String, NDArray>& params);
  */
 void SaveParams(dmlc::Stream* strm, const Map<String, NDArray>& params);
 
+/*! \brief The default size of each of the two staging buffers used by StreamParams. */
+constexpr size_t kParamStagingBytes = 16 << 20;
+
+/*!
+ * \brief Gives the array a streamed parameter is loaded into, or an undefined array to skip it.
+ *
+ *  The arguments are the name, shape and dtype of the parameter.
+ */
+using ParamDestination = std::function<NDArray(
+    const std::string& name, const std::vector<int64_t>& shape, DLDataType dtype)>;
+
+/*!
+ * \brief Load the parameters of a stream written by SaveParams one tensor at a time.
+ *
+ *  Unlike LoadParams the dictionary is never materialized in host memory: parameters going to
+ *  the CPU are read in place, the others go through two staging buffers of \p staging_bytes,
+ *  and a reader thread fills one while the other is copied to the device.
+ *
+ * \param strm Stream to load parameters from.
+ * \param fdest Gives the array each parameter is loaded into.
+ * \param staging_bytes The size of each staging buffer.
+ */
+void StreamParams(dmlc::Stream* strm, const ParamDestination& fdest,
+                  size_t staging_bytes = kParamStagingBytes);
+
+/*!
+ * \brief Parameters of a file written by SaveParams, which are read when first requested.
+ *
+ *  Opening the file only reads the headers of the tensors. The methods are thread-safe.
+ */
+class LazyParams {
+ public:
+  /*! \param path The parameters file. */
+  explicit LazyParams(const std::string& path);
+
+  /*! \return The names of the parameters in the file. */
+  const std::vector<std::string>& Names() const { return names_; }
+  /*! \return Whether the file has a parameter called \p name. */
+  bool Contains(const std::string& name) const { return entries_.count(name); }
+  /*!
+   * \brief Read the parameter \p name into a new array on \p dev.
+   * \param name The name of the parameter.
+   * \param dev The device of the array.
+   * \return The parameter.
+   */
+  NDArray Load(const std::string& name, Device dev);
+  /*!
+   * \brief Read the parameter \p name into \p dest, which has its shape and dtype.
+   */
+  void LoadInto(const std::string& name, NDArray dest);
+
+ private:
+  struct Entry {
+    std::vector<int64_t> shape;
+    DLDataType dtype;
+    /*! \brief The offset of the tensor data in the file. */
+    uint64_t offset;
+  };
+
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, Entry> entries_;
+  /*! \brief Guards file_. */
+  std::mutex mutex_;
+  std::ifstream file_;
+};
+
+constexpr uint64_t kTVMMappedParamsMagic = 0xF7E58D4F05049CB8;
+/*! \brief Alignment of the tensor payloads in a mappable parameters file. */
+constexpr uint64_t kMappedParamsAlignment = 4096;
+/*!
+ * \brief Serialize parameters to a file which can later be memory-mapped by
+ * \p LoadMappedParams.
+ *
+ * Unlike \p SaveParams the tensor payloads are stored raw and page-aligned after a header
+ * describing every tensor, so that loading never has to copy them.
+ *
+ * \param path The file to write.
+ * \param params Parameters to save.
+ */
+void SaveMappableParams(const std::string& path, const Map<String, NDArray>& params);
+/*!
+ * \brief Check whether the file at \p path was written by \p SaveMappableParams.
+ * \param path The file to check.
+ */
+bool IsMappableParamsFile(const std::string& path);
+/*!
+ * \brief Load parameters written by \p SaveMappableParams.
+ *
+ * The file is memory-mapped and the returned CPU arrays alias the mapping, so loading costs
+ * no more than the page faults of the tensors actually touched. The mapping stays alive as
+ * long as any of the returned arrays does.
+ *
+ * \param path The file to load.
+ * \return Map of parameter name to parameter value.
+ */
+Map<String, NDArray> LoadMappedParams(const std::string& path);
+
 /*!
  * \brief A dmlc stream which wraps standard file operations.
  */
@@ -0,0 +1,181 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file float_convert.cc
+ * \brief Bulk conversion of arrays between float32 and float16 or bfloat16.
+ */
+#include "float_convert.h"
+
+#include <builtin_fp16.h>
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/logging.h>
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TVM_FLOAT_CONVERT_F16C 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+
+inline uint16_t FloatToHalfScalar(float v) {
+  return __truncXfYf2__<float, uint32_t, 23, uint16_t, uint16_t, 10>(v);
+}
+
+inline float HalfToFloatScalar(uint16_t v) {
+  return __extendXfYf2__<uint16_t, uint16_t, 10, float, uint32_t, 23>(v);
+}
+
+#if TVM_FLOAT_CONVERT_F16C
+/*! \brief Whether the CPU has F16C, and the OS saves the AVX registers it uses. */
+bool HasF16C() {
+  static const bool supported = []() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+    return (ecx & bit_F16C) != 0 && __builtin_cpu_supports("avx");
+  }();
+  return supported;
+}
+
+__attribute__((target("avx,f16c"))) void FloatToHalfF16C(const float* src, uint16_t* dst,
+                                                         int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+  }
+  for (; i < n; ++i) {
+    dst[i] = FloatToHalfScalar(src[i]);
+  }
+}
+
+__attribute__((target("avx,f16c"))) void HalfToFloatF16C(const uint16_t* src, float* dst,
+                                                         int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+  }
+  for (; i < n; ++i) {
+    dst[i] = HalfToFloatScalar(src[i]);
+  }
+}
+#endif
+
+}  // namespace
+
+void FloatToHalf(const float* src, uint16_t* dst, int64_t n) {
+#if TVM_FLOAT_CONVERT_F16C
+  if (HasF16C()) {
+    FloatToHalfF16C(src, dst, n);
+    return;
+  }
+#endif
+  int64_t i = 0;
+#if defined(__aarch64__)
+  for (; i + 4 <= n; i += 4) {
+    vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = FloatToHalfScalar(src[i]);
+  }
+}
+
+void HalfToFloat(const uint16_t* src, float* dst, int64_t n) {
+#if TVM_FLOAT_CONVERT_F16C
+  if (HasF16C()) {
+    HalfToFloatF16C(src, dst, n);
+    return;
+  }
+#endif
+  int64_t i = 0;
+#if defined(__aarch64__)
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i] = HalfToFloatScalar(src[i]);
+  }
+}
+
+void FloatToBFloat16(const float* src, uint16_t* dst, int64_t n) {
+  // Branch-free, so that the compiler vectorizes the loop for the baseline instruction set.
+  for (int64_t i = 0; i < n; ++i) {
+    uint32_t bits;
+    std::memcpy(&bits, src + i, sizeof(bits));
+    uint32_t rounded = bits + 0x7FFF + ((bits >> 16) & 1);
+    // Rounding a NaN could overflow to infinity, truncate it to a quiet NaN instead.
+    bool is_nan = (bits & 0x7FFFFFFF) > 0x7F800000;
+    dst[i] = static_cast<uint16_t>(is_nan ? (bits >> 16) | 0x40 : rounded >> 16);
+  }
+}
+
+void BFloat16ToFloat(const uint16_t* src, float* dst, int64_t n) {
+  for (int64_t i = 0; i < n; ++i) {
+    uint32_t bits = static_cast<uint32_t>(src[i]) << 16;
+    std::memcpy(dst + i, &bits, sizeof(bits));
+  }
+}
+
+bool IsFloatConvertible(DLDataType src, DLDataType dst) {
+  auto is_f32 = [](DLDataType t) { return t.code == kDLFloat && t.bits == 32 && t.lanes == 1; };
+  auto is_f16 = [](DLDataType t) {
+    return (t.code == kDLFloat || t.code == kDLBfloat) && t.bits == 16 && t.lanes == 1;
+  };
+  return (is_f32(src) && is_f16(dst)) || (is_f16(src) && is_f32(dst));
+}
+
+void ConvertFloatArray(const void* src, DLDataType src_dtype, void* dst, DLDataType dst_dtype,
+                       int64_t n) {
+  ICHECK(IsFloatConvertible(src_dtype, dst_dtype))
+      << "Cannot convert from " << DLDataType2String(src_dtype) << " to "
+      << DLDataType2String(dst_dtype);
+  if (src_dtype.bits == 32) {
+    const float* from = static_cast<const float*>(src);
+    uint16_t* to = static_cast<uint16_t*>(dst);
+    if (dst_dtype.code == kDLBfloat) {
+      FloatToBFloat16(from, to, n);
+    } else {
+      FloatToHalf(from, to, n);
+    }
+  } else {
+    const uint16_t* from = static_cast<const uint16_t*>(src);
+    float* to = static_cast<float*>(dst);
+    if (src_dtype.code == kDLBfloat) {
+      BFloat16ToFloat(from, to, n);
+    } else {
+      HalfToFloat(from, to, n);
+    }
+  }
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file float_convert.h
+ * \brief Bulk conversion of arrays between float32 and float16 or bfloat16.
+ *
+ *  The conversions round to nearest even, the same way the scalar compiler-rt conversions of
+ *  builtin_fp16.cc do, and use the conversion instructions of the host when available: F16C on
+ *  x86-64, selected at runtime, and NEON on AArch64.
+ */
+#ifndef TVM_RUNTIME_FLOAT_CONVERT_H_
+#define TVM_RUNTIME_FLOAT_CONVERT_H_
+
+#include <dlpack/dlpack.h>
+
+#include <cstdint>
+
+namespace tvm {
+namespace runtime {
+
+/*! \brief Convert \p n float32 values to float16. */
+void FloatToHalf(const float* src, uint16_t* dst, int64_t n);
+
+/*! \brief Convert \p n float16 values to float32. */
+void HalfToFloat(const uint16_t* src, float* dst, int64_t n);
+
+/*! \brief Convert \p n float32 values to bfloat16. */
+void FloatToBFloat16(const float* src, uint16_t* dst, int64_t n);
+
+/*! \brief Convert \p n bfloat16 values to float32. */
+void BFloat16ToFloat(const uint16_t* src, float* dst, int64_t n);
+
+/*!
+ * \brief Whether ConvertFloatArray converts from \p src to \p dst, i.e. one of them is float32 and
+ *  the other float16 or bfloat16.
+ */
+bool IsFloatConvertible(DLDataType src, DLDataType dst);
+
+/*!
+ * \brief Convert \p n values of dtype \p src_dtype to \p dst_dtype.
+ * \note IsFloatConvertible(src_dtype, dst_dtype) must hold.
+ */
+void ConvertFloatArray(const void* src, DLDataType src_dtype, void* dst, DLDataType dst_dtype,
+                       int64_t n);
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_FLOAT_CONVERT_H_
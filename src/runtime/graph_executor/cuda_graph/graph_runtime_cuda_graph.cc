@@ -23,6 +23,10 @@
 
 #include <tvm/runtime/registry.h>
 
+#include <list>
+#include <utility>
+#include <vector>
+
 #include "../../cuda/cuda_common.h"
 #include "../graph_executor.h"
 
@@ -41,13 +45,25 @@ namespace runtime {
  */
 class GraphExecutorCudaGraph : public GraphExecutor {
  public:
+  ~GraphExecutorCudaGraph() {
+    for (auto& kv : graph_cache_) {
+      cudaGraphExecDestroy(kv.second);
+    }
+    if (capture_stream_ != nullptr) {
+      const Device& dev = data_entry_[entry_id(0, 0)]->device;
+      TVMStreamFree(dev.device_type, dev.device_id, capture_stream_);
+    }
+  }
+
   /*!
    * \brief Begin CUDA graph capture on stream, the stream enters capture mode.
    */
   void StartCapture() {
     const Device& dev = data_entry_[entry_id(0, 0)]->device;
 
-    TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    if (capture_stream_ == nullptr) {
+      TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    }
     TVMSetStream(dev.device_type, dev.device_id, capture_stream_);
 
     CUDA_CALL(cudaStreamBeginCapture(static_cast<cudaStream_t>(capture_stream_),
@@ -55,11 +71,26 @@ class GraphExecutorCudaGraph : public GraphExecutor {
   }
 
   /*!
-   * \brief Launch the instantiated graph on stream
+   * \brief Launch the instantiated graph on stream.
+   *
+   *  When inputs or outputs were rebound with the zero-copy setters since the capture, the
+   *  graph of the new bindings is taken from the cache, or captured again and either
+   *  instantiated or used to update the least recently used instance in place.
    */
   void RunCudaGraph() {
+    ICHECK(!graph_cache_.empty()) << "Capture a CUDA graph before running it";
+    std::vector<void*> binding = CurrentBinding();
+    auto it = graph_cache_.begin();
+    while (it != graph_cache_.end() && it->first != binding) ++it;
+    if (it == graph_cache_.end()) {
+      StartCapture();
+      Run();
+      UpdateOrInstantiate(EndCaptureGraph(), std::move(binding));
+    } else if (it != graph_cache_.begin()) {
+      graph_cache_.splice(graph_cache_.begin(), graph_cache_, it);
+    }
     cudaStream_t cuStream = static_cast<cudaStream_t>(capture_stream_);
-    CUDA_CALL(cudaGraphLaunch(cuda_graph_exec_, cuStream));
+    CUDA_CALL(cudaGraphLaunch(graph_cache_.front().second, cuStream));
     CUDA_CALL(cudaStreamSynchronize(cuStream));
   }
 
@@ -68,15 +99,17 @@ class GraphExecutorCudaGraph : public GraphExecutor {
    * instantiated.
    */
   void EndCapture() {
-    cudaGraph_t graph;
-    CUDA_CALL(cudaStreamEndCapture(static_cast<cudaStream_t>(capture_stream_), &graph));
-
+    cudaGraph_t graph = EndCaptureGraph();
     cudaGraphNode_t* nodes = NULL;
     size_t numNodes = 0;
     CUDA_CALL(cudaGraphGetNodes(graph, nodes, &numNodes));
     LOG(INFO) << "Num of nodes in the cuda graph created using stream capture API = " << numNodes;
 
-    CUDA_CALL(cudaGraphInstantiate(&cuda_graph_exec_, graph, NULL, NULL, 0));
+    for (auto& kv : graph_cache_) {
+      CUDA_CALL(cudaGraphExecDestroy(kv.second));
+    }
+    graph_cache_.clear();
+    UpdateOrInstantiate(graph, CurrentBinding());
   }
 
   /*!
@@ -87,10 +120,69 @@ class GraphExecutorCudaGraph : public GraphExecutor {
   PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self);
 
  private:
+  /*! \brief End the capture and return the captured graph. */
+  cudaGraph_t EndCaptureGraph() {
+    cudaGraph_t graph;
+    CUDA_CALL(cudaStreamEndCapture(static_cast<cudaStream_t>(capture_stream_), &graph));
+    return graph;
+  }
+
+  /*!
+   * \brief Make the front of the cache run \p graph, then destroy \p graph.
+   * \param graph The captured graph.
+   * \param binding The input and output addresses the graph was captured with.
+   */
+  void UpdateOrInstantiate(cudaGraph_t graph, std::vector<void*> binding) {
+    cudaGraphExec_t exec = nullptr;
+    if (graph_cache_.size() >= cache_size_) {
+      // Only the kernel parameters differ between bindings, so the update usually succeeds
+      // and is much cheaper than instantiating.
+      exec = graph_cache_.back().second;
+      graph_cache_.pop_back();
+#if CUDART_VERSION >= 12000
+      cudaGraphExecUpdateResultInfo info;
+      bool updated = cudaGraphExecUpdate(exec, graph, &info) == cudaSuccess;
+#else
+      cudaGraphNode_t error_node;
+      cudaGraphExecUpdateResult result;
+      bool updated = cudaGraphExecUpdate(exec, graph, &error_node, &result) == cudaSuccess;
+#endif
+      if (!updated) {
+        // Clear the error of the failed update.
+        cudaGetLastError();
+        CUDA_CALL(cudaGraphExecDestroy(exec));
+        exec = nullptr;
+      }
+    }
+    if (exec == nullptr) {
+      CUDA_CALL(cudaGraphInstantiate(&exec, graph, NULL, NULL, 0));
+    }
+    CUDA_CALL(cudaGraphDestroy(graph));
+    graph_cache_.emplace_front(std::move(binding), exec);
+  }
+
+  /*! \return The addresses the inputs and outputs of the graph are bound to. */
+  std::vector<void*> CurrentBinding() const {
+    std::vector<void*> binding;
+    for (uint32_t nid : input_nodes_) {
+      uint32_t eid = entry_id(nid, 0);
+      binding.push_back(input_dltensors_[eid].empty() ? data_entry_[eid]->data
+                                                      : input_dltensors_[eid][0]->data);
+    }
+    for (const NodeEntry& output : outputs_) {
+      uint32_t eid = entry_id(output);
+      binding.push_back(output_dltensors_[eid].empty() ? data_entry_[eid]->data
+                                                       : output_dltensors_[eid][0]->data);
+    }
+    return binding;
+  }
+
   /*! \brief The Cuda stream on which to capture a CUDA graph. */
-  TVMStreamHandle capture_stream_;
-  /*! \brief The captured CUDA graph will be instantiated to this. */
-  cudaGraphExec_t cuda_graph_exec_;
+  TVMStreamHandle capture_stream_{nullptr};
+  /*! \brief The instantiated graphs by input and output binding, most recently used first. */
+  std::list<std::pair<std::vector<void*>, cudaGraphExec_t>> graph_cache_;
+  /*! \brief The maximum number of instantiated graphs. */
+  size_t cache_size_{4};
 };
 
 PackedFunc GraphExecutorCudaGraph::GetFunction(const String& name,
@@ -103,6 +195,16 @@ PackedFunc GraphExecutorCudaGraph::GetFunction(const String& name,
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->StartCapture(); });
   } else if (name == "end_capture") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->EndCapture(); });
+  } else if (name == "set_cuda_graph_cache_size") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int cache_size = args[0];
+      ICHECK_GE(cache_size, 1) << "The CUDA graph cache holds at least one graph";
+      this->cache_size_ = cache_size;
+      while (this->graph_cache_.size() > this->cache_size_) {
+        CUDA_CALL(cudaGraphExecDestroy(this->graph_cache_.back().second));
+        this->graph_cache_.pop_back();
+      }
+    });
   } else {
     return GraphExecutor::GetFunction(name, sptr_to_self);
   }
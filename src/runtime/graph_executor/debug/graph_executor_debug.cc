@@ -37,6 +37,29 @@
 
 namespace tvm {
 namespace runtime {
+
+namespace {
+
+/*!
+ * \brief Encode the times of the ops, as the number of ops as an int64_t followed by the times of
+ *  each op as doubles.
+ */
+std::string EncodeOpTimes(const std::vector<std::vector<double>>& time_sec_per_op) {
+  std::ostringstream os;
+  int64_t size = time_sec_per_op.size();
+  os.write(reinterpret_cast<char*>(&size), sizeof(int64_t));
+  for (size_t index = 0; index < time_sec_per_op.size(); ++index) {
+    for (auto& repeat_data : time_sec_per_op[index]) {
+      // To have good behavior when calculating total time, etc.
+      double data = std::isnan(repeat_data) ? 0 : repeat_data;
+      os.write(reinterpret_cast<char*>(&data), sizeof(double));
+    }
+  }
+  return os.str();
+}
+
+}  // namespace
+
 std::string GraphExecutorDebug::RunIndividual(int number, int repeat, int min_repeat_ms,
                                               int limit_zero_time_iterations,
                                               int cooldown_interval_ms, int repeats_to_cooldown) {
@@ -72,17 +95,30 @@ std::string GraphExecutorDebug::RunIndividual(int number, int repeat, int min_re
     }
   }
 
-  std::ostringstream os;
-  int64_t size = time_sec_per_op.size();
-  os.write(reinterpret_cast<char*>(&size), sizeof(int64_t));
-  for (size_t index = 0; index < time_sec_per_op.size(); ++index) {
-    for (auto& repeat_data : time_sec_per_op[index]) {
-      // To have good behavior when calculating total time, etc.
-      double data = std::isnan(repeat_data) ? 0 : repeat_data;
-      os.write(reinterpret_cast<char*>(&data), sizeof(double));
+  return EncodeOpTimes(time_sec_per_op);
+}
+
+std::string GraphExecutorDebug::RunPipelined(int number, int warmup) {
+  for (int i = 0; i < warmup; ++i) {
+    GraphExecutor::Run();
+  }
+  std::vector<std::vector<double>> time_sec_per_op(op_execs_.size(),
+                                                   std::vector<double>(number, 0));
+  std::vector<std::pair<size_t, Timer>> timers;
+  timers.reserve(op_execs_.size());
+  for (int run = 0; run < number; ++run) {
+    for (size_t index = 0; index < op_execs_.size(); ++index) {
+      if (op_execs_[index]) {
+        timers.emplace_back(index, RunOpHost(index));
+      }
     }
+    // Only the first timer waits for the device, the run has completed for the others.
+    for (auto& it : timers) {
+      time_sec_per_op[it.first][run] = it.second->SyncAndGetElapsedNanos() / 1e9;
+    }
+    timers.clear();
   }
-  return os.str();
+  return EncodeOpTimes(time_sec_per_op);
 }
 
 std::string GraphExecutorDebug::RunIndividualNode(int node_index, int number, int repeat,
@@ -143,7 +179,7 @@ std::vector<double> GraphExecutorDebug::RunOpRPC(int index, int number, int repe
           ->
           operator()(module_, name, static_cast<int>(dev.device_type), dev.device_id, number,
                      repeat, min_repeat_ms, limit_zero_time_iterations, cooldown_interval_ms,
-                     repeats_to_cooldown, "");
+                     repeats_to_cooldown, "", 0.0, 0);
 
   int num_flat_args = num_inputs + num_outputs;
   auto values = std::make_unique<TVMValue[]>(num_flat_args);
@@ -257,6 +293,18 @@ PackedFunc GraphExecutorDebug::GetFunction(const String& name,
       arr.data = blob.data();
       *rv = arr;
     });
+  } else if (name == "run_pipelined") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int number = args[0];
+      int warmup = args[1];
+      ICHECK_GT(number, 0);
+      ICHECK_GE(warmup, 0);
+      std::string blob = this->RunPipelined(number, warmup);
+      TVMByteArray arr;
+      arr.size = blob.length();
+      arr.data = blob.data();
+      *rv = arr;
+    });
   } else if (name == "profile") {
     return TypedPackedFunc<profiling::Report(Array<profiling::MetricCollector>)>(
         [sptr_to_self, this](Array<profiling::MetricCollector> collectors) {
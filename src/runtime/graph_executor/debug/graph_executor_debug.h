@@ -74,6 +74,20 @@ class GraphExecutorDebug : public GraphExecutor {
 
   Timer RunOpHost(int index);
 
+  /*!
+   * \brief Run the whole graph and get the time of each op within the runs.
+   *
+   *  Unlike RunIndividual, the ops run back to back as in Run, without a device synchronization
+   *  around each of them: the timers of the device record events on its stream, which are
+   *  resolved once the run completed.
+   *
+   * \param number The number of timed runs.
+   * \param warmup The number of runs before the timed ones.
+   * \return Returns a string with an encoded byte array, in the format of RunIndividual with
+   *  the time of each op in each of the `number` runs.
+   */
+  std::string RunPipelined(int number, int warmup);
+
   /*!
    * \brief GetFunction Get the function based on input.
    * \param name The function which needs to be invoked.
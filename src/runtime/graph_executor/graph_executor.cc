@@ -23,6 +23,7 @@
 #include "graph_executor.h"
 
 #include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/device_api.h>
@@ -31,17 +32,22 @@
 #include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/serializer.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "../file_utils.h"
+#include "../library_module.h"
 #include "../texture.h"
 
 namespace tvm {
@@ -55,14 +61,83 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
 constexpr auto Is2DStorage = IsTextureStorage;
 }  // namespace details
 
+void GraphExecutor::Warmup() {
+  for (const Device& dev : devices_) {
+    PreloadModule(module_, dev);
+  }
+}
+
 /*!
- * \brief Run all the operations one by one.
+ * \brief Run all the operations one by one, or concurrently when inter-op threads are set.
  */
 void GraphExecutor::Run() {
+  if (lazy_params_ != nullptr) this->LoadLazyParams();
+  if (num_streams_ > 1) {
+    ICHECK_EQ(inter_op_threads_, 1) << "Inter-op threads and multiple streams are exclusive";
+    ICHECK(weight_prefetch_ == nullptr) << "Weight prefetch needs the operators run one by one";
+    this->RunMultiStream();
+    return;
+  }
+  if (inter_op_threads_ > 1) {
+    ICHECK(weight_prefetch_ == nullptr) << "Weight prefetch needs the operators run one by one";
+    if (inter_op_scheduler_ == nullptr) this->SetupInterOpScheduler();
+    inter_op_scheduler_->Run();
+    return;
+  }
+  threading::ThreadPoolScope thread_pool_scope(thread_pool_);
+  bool sampled = sampler_.BeginRequest();
   // setup the array and requirements.
   for (size_t i = 0; i < op_execs_.size(); ++i) {
-    if (op_execs_[i]) op_execs_[i]();
+    if (!op_execs_[i]) continue;
+    if (weight_prefetch_ != nullptr && prefetch_stage_[i] >= 0) {
+      weight_prefetch_(prefetch_stage_[i]);
+    }
+    if (sampled) {
+      sampler_.StartOp(i, nodes_[i].param.func_name, data_entry_[entry_id(i, 0)]->device);
+    }
+    op_execs_[i]();
+    if (sampled) sampler_.StopOp();
+  }
+}
+
+Device GraphExecutor::AcceleratorDevice() const {
+  auto it = std::find_if(devices_.begin(), devices_.end(),
+                         [](const Device& dev) { return dev.device_type != kDLCPU; });
+  return it == devices_.end() ? Device{kDLCPU, 0} : *it;
+}
+
+void GraphExecutor::RunOnStream(TVMStreamHandle stream) {
+  Device dev = this->AcceleratorDevice();
+  if (dev.device_type == kDLCPU) {
+    this->Run();
+    return;
   }
+  DeviceAPI* api = DeviceAPI::Get(dev);
+  TVMStreamHandle prev = api->GetCurrentStream(dev);
+  api->SetStream(dev, stream);
+  try {
+    this->Run();
+  } catch (...) {
+    api->SetStream(dev, prev);
+    throw;
+  }
+  api->SetStream(dev, prev);
+}
+
+void GraphExecutor::RunAsync(std::vector<std::pair<int, NDArray>> inputs, PackedFunc callback,
+                             ObjectPtr<Object> sptr_to_self) {
+  auto run = [this, sptr_to_self, inputs = std::move(inputs)]() -> ObjectRef {
+    for (const auto& kv : inputs) {
+      this->SetInput(kv.first, const_cast<DLTensor*>(kv.second.operator->()));
+    }
+    this->Run();
+    Array<NDArray> outputs;
+    for (int i = 0; i < this->NumOutputs(); ++i) {
+      outputs.push_back(CopyOnCurrentStream(this->GetOutput(i)));
+    }
+    return outputs;
+  };
+  async_queue_->Submit(this->AcceleratorDevice(), std::move(run), std::move(callback));
 }
 
 /*!
@@ -77,13 +152,20 @@ void GraphExecutor::Run() {
 void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module module,
                          const std::vector<Device>& devs,
                          const PackedFunc lookup_linked_param_func) {
-  std::istringstream is(graph_json);
-  dmlc::JSONReader reader(&is);
-  this->Load(&reader);
+  if (graph_json.size() >= sizeof(kTVMGraphBinaryMagic) &&
+      std::memcmp(graph_json.data(), &kTVMGraphBinaryMagic, sizeof(kTVMGraphBinaryMagic)) == 0) {
+    dmlc::MemoryStringStream strm(const_cast<std::string*>(&graph_json));
+    this->LoadGraphBinary(&strm);
+  } else {
+    std::istringstream is(graph_json);
+    dmlc::JSONReader reader(&is);
+    this->Load(&reader);
+  }
   module_ = module;
   devices_ = devs;
   lookup_linked_param_ = lookup_linked_param_func;
-  if (lookup_linked_param_ == nullptr) {
+  default_lookup_linked_param_ = lookup_linked_param_ == nullptr;
+  if (default_lookup_linked_param_) {
     lookup_linked_param_ = PackedFunc(
         [this](TVMArgs args, TVMRetValue* rv) { this->DefaultLookupLinkedParam(args, rv); });
   }
@@ -103,6 +185,377 @@ void GraphExecutor::Init(const std::string& graph_json, tvm::runtime::Module mod
   }
 }
 
+namespace {
+
+/*! \brief Writes the fields of the binary graph format. */
+class GraphBinaryWriter {
+ public:
+  explicit GraphBinaryWriter(dmlc::Stream* strm) : strm_(strm) {}
+
+  void WriteU32(uint32_t value) { strm_->Write(&value, sizeof(value)); }
+  void WriteI32(int32_t value) { strm_->Write(&value, sizeof(value)); }
+  void WriteI64(int64_t value) { strm_->Write(&value, sizeof(value)); }
+  void WriteEntry(uint32_t node_id, uint32_t index, uint32_t version) {
+    WriteU32(node_id);
+    WriteU32(index);
+    WriteU32(version);
+  }
+
+ private:
+  dmlc::Stream* strm_;
+};
+
+/*! \brief Reads the fields of the binary graph format. */
+class GraphBinaryReader {
+ public:
+  explicit GraphBinaryReader(dmlc::Stream* strm) : strm_(strm) {}
+
+  uint32_t ReadU32() { return Read<uint32_t>(); }
+  int32_t ReadI32() { return Read<int32_t>(); }
+  int64_t ReadI64() { return Read<int64_t>(); }
+  const std::string& ReadString() {
+    uint32_t id = ReadU32();
+    ICHECK_LT(id, strings.size()) << "Invalid graph binary format";
+    return strings[id];
+  }
+
+  /*! \brief The interned strings. */
+  std::vector<std::string> strings;
+
+ private:
+  template <typename T>
+  T Read() {
+    T value;
+    ICHECK_EQ(strm_->Read(&value, sizeof(value)), sizeof(value)) << "Invalid graph binary format";
+    return value;
+  }
+
+  dmlc::Stream* strm_;
+};
+
+}  // namespace
+
+void GraphExecutor::SaveGraphBinary(dmlc::Stream* strm) const {
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> string_ids;
+  auto intern = [&](const std::string& str) {
+    auto it = string_ids.emplace(str, static_cast<uint32_t>(strings.size())).first;
+    if (it->second == strings.size()) strings.push_back(str);
+    return it->second;
+  };
+  // Intern every string first, the string table comes before its users.
+  for (const Node& node : nodes_) {
+    intern(node.op_type);
+    intern(node.name);
+    intern(node.param.func_name);
+    for (const auto& kv : node.param.attrs) {
+      intern(kv.first);
+      intern(Downcast<String>(kv.second));
+    }
+  }
+  for (const std::string& dltype : attrs_.dltype) intern(dltype);
+  for (const std::string& scope : attrs_.storage_scope) intern(scope);
+
+  GraphBinaryWriter writer(strm);
+  uint64_t header = kTVMGraphBinaryMagic, reserved = 0;
+  strm->Write(&header, sizeof(header));
+  strm->Write(&reserved, sizeof(reserved));
+  writer.WriteU32(strings.size());
+  for (const std::string& str : strings) {
+    writer.WriteU32(str.size());
+    strm->Write(str.data(), str.size());
+  }
+  writer.WriteU32(nodes_.size());
+  for (const Node& node : nodes_) {
+    writer.WriteU32(string_ids.at(node.op_type));
+    writer.WriteU32(string_ids.at(node.name));
+    writer.WriteU32(string_ids.at(node.param.func_name));
+    writer.WriteU32(node.param.num_inputs);
+    writer.WriteU32(node.param.num_outputs);
+    writer.WriteU32(node.param.flatten_data);
+    writer.WriteU32(node.inputs.size());
+    for (const NodeEntry& e : node.inputs) writer.WriteEntry(e.node_id, e.index, e.version);
+    writer.WriteU32(node.param.attrs.size());
+    for (const auto& kv : node.param.attrs) {
+      writer.WriteU32(string_ids.at(kv.first));
+      writer.WriteU32(string_ids.at(Downcast<String>(kv.second)));
+    }
+  }
+  writer.WriteU32(input_nodes_.size());
+  for (uint32_t nid : input_nodes_) writer.WriteU32(nid);
+  writer.WriteU32(node_row_ptr_.size());
+  for (uint32_t ptr : node_row_ptr_) writer.WriteU32(ptr);
+  writer.WriteU32(outputs_.size());
+  for (const NodeEntry& e : outputs_) writer.WriteEntry(e.node_id, e.index, e.version);
+  writer.WriteU32(attrs_.storage_id.size());
+  for (int sid : attrs_.storage_id) writer.WriteI32(sid);
+  writer.WriteU32(!attrs_.device_index.empty());
+  for (int device_index : attrs_.device_index) writer.WriteI32(device_index);
+  for (const std::string& dltype : attrs_.dltype) writer.WriteU32(string_ids.at(dltype));
+  writer.WriteU32(!attrs_.storage_scope.empty());
+  for (const std::string& scope : attrs_.storage_scope) writer.WriteU32(string_ids.at(scope));
+  for (const std::vector<int64_t>& shape : attrs_.shape) {
+    writer.WriteU32(shape.size());
+    for (int64_t dim : shape) writer.WriteI64(dim);
+  }
+}
+
+void GraphExecutor::LoadGraphBinary(dmlc::Stream* strm) {
+  uint64_t header, reserved;
+  ICHECK(strm->Read(&header)) << "Invalid graph binary format";
+  ICHECK_EQ(header, kTVMGraphBinaryMagic) << "Invalid graph binary format";
+  ICHECK(strm->Read(&reserved)) << "Invalid graph binary format";
+  GraphBinaryReader reader(strm);
+  reader.strings.resize(reader.ReadU32());
+  for (std::string& str : reader.strings) {
+    str.resize(reader.ReadU32());
+    ICHECK_EQ(strm->Read(&str[0], str.size()), str.size()) << "Invalid graph binary format";
+  }
+  auto read_entries = [&reader](std::vector<NodeEntry>* entries) {
+    entries->resize(reader.ReadU32());
+    for (NodeEntry& e : *entries) {
+      e.node_id = reader.ReadU32();
+      e.index = reader.ReadU32();
+      e.version = reader.ReadU32();
+    }
+  };
+  nodes_.resize(reader.ReadU32());
+  for (Node& node : nodes_) {
+    node.op_type = reader.ReadString();
+    node.name = reader.ReadString();
+    node.param.func_name = reader.ReadString();
+    node.param.num_inputs = reader.ReadU32();
+    node.param.num_outputs = reader.ReadU32();
+    node.param.flatten_data = reader.ReadU32();
+    read_entries(&node.inputs);
+    uint32_t num_attrs = reader.ReadU32();
+    for (uint32_t i = 0; i < num_attrs; ++i) {
+      const std::string& key = reader.ReadString();
+      node.param.attrs[key] = String(reader.ReadString());
+    }
+  }
+  input_nodes_.resize(reader.ReadU32());
+  for (uint32_t& nid : input_nodes_) nid = reader.ReadU32();
+  node_row_ptr_.resize(reader.ReadU32());
+  for (uint32_t& ptr : node_row_ptr_) ptr = reader.ReadU32();
+  read_entries(&outputs_);
+  uint32_t num_entries = reader.ReadU32();
+  attrs_.storage_id.resize(num_entries);
+  for (int& sid : attrs_.storage_id) sid = reader.ReadI32();
+  attrs_.device_index.resize(reader.ReadU32() ? num_entries : 0);
+  for (int& device_index : attrs_.device_index) device_index = reader.ReadI32();
+  attrs_.dltype.resize(num_entries);
+  for (std::string& dltype : attrs_.dltype) dltype = reader.ReadString();
+  attrs_.storage_scope.resize(reader.ReadU32() ? num_entries : 0);
+  for (std::string& scope : attrs_.storage_scope) scope = reader.ReadString();
+  attrs_.shape.resize(num_entries);
+  for (std::vector<int64_t>& shape : attrs_.shape) {
+    shape.resize(reader.ReadU32());
+    for (int64_t& dim : shape) dim = reader.ReadI64();
+  }
+  ICHECK(!node_row_ptr_.empty() && node_row_ptr_.back() == num_entries)
+      << "Invalid graph binary format";
+}
+
+std::string GraphExecutor::GraphJSONToBinary(const std::string& graph_json) {
+  GraphExecutor graph;
+  std::istringstream is(graph_json);
+  dmlc::JSONReader reader(&is);
+  graph.Load(&reader);
+  std::string binary;
+  dmlc::MemoryStringStream strm(&binary);
+  graph.SaveGraphBinary(&strm);
+  return binary;
+}
+
+namespace {
+
+/*! \brief The header of the flat graph format, mirrors TVMGraphFlatHeader of the CRT. */
+struct GraphFlatHeader {
+  uint64_t magic;
+  uint32_t nodes_count;
+  uint32_t input_nodes_count;
+  uint32_t node_row_ptr_count;
+  uint32_t outputs_count;
+  uint32_t entries_count;
+  uint32_t shape_stride;
+  uint32_t nodes;
+  uint32_t input_nodes;
+  uint32_t node_row_ptr;
+  uint32_t outputs;
+  uint32_t storage_id;
+  uint32_t dltype;
+  uint32_t ndim;
+  uint32_t shape;
+};
+static_assert(sizeof(GraphFlatHeader) == 64, "GraphFlatHeader must match TVMGraphFlatHeader");
+
+/*! \brief A node of the flat graph format, mirrors TVMGraphFlatNode of the CRT. */
+struct GraphFlatNode {
+  uint32_t op_type;
+  uint32_t name;
+  uint32_t func_name;
+  uint32_t num_inputs;
+  uint32_t num_outputs;
+  uint32_t flatten_data;
+  uint32_t inputs;
+  uint32_t inputs_count;
+};
+
+/*! \brief Appends the tables of the flat graph format. */
+class GraphFlatWriter {
+ public:
+  explicit GraphFlatWriter(std::string* flat) : flat_(flat) {}
+
+  /*! \brief Pad to the next table, return its offset. */
+  uint32_t Align() {
+    flat_->resize((flat_->size() + 7) & ~static_cast<size_t>(7), '\0');
+    ICHECK_LE(flat_->size(), std::numeric_limits<uint32_t>::max()) << "The graph is too large";
+    return static_cast<uint32_t>(flat_->size());
+  }
+  template <typename T>
+  void Write(const T& value) {
+    flat_->append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  void WriteEntry(uint32_t node_id, uint32_t index, uint32_t version) {
+    Write(node_id);
+    Write(index);
+    Write(version);
+  }
+
+ private:
+  std::string* flat_;
+};
+
+}  // namespace
+
+std::string GraphExecutor::SaveGraphFlat() const {
+  std::string flat(sizeof(GraphFlatHeader), '\0');
+  GraphFlatWriter writer(&flat);
+  GraphFlatHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = kTVMGraphFlatMagic;
+
+  std::unordered_map<std::string, uint32_t> string_offsets;
+  auto intern = [&](const std::string& str) {
+    auto it = string_offsets.find(str);
+    if (it != string_offsets.end()) return it->second;
+    uint32_t offset = static_cast<uint32_t>(flat.size());
+    flat.append(str.c_str(), str.size() + 1);
+    return string_offsets[str] = offset;
+  };
+  std::vector<GraphFlatNode> nodes(nodes_.size());
+  for (size_t nid = 0; nid < nodes_.size(); ++nid) {
+    nodes[nid].op_type = intern(nodes_[nid].op_type);
+    nodes[nid].name = intern(nodes_[nid].name);
+    nodes[nid].func_name = intern(nodes_[nid].param.func_name);
+    nodes[nid].num_inputs = nodes_[nid].param.num_inputs;
+    nodes[nid].num_outputs = nodes_[nid].param.num_outputs;
+    nodes[nid].flatten_data = nodes_[nid].param.flatten_data;
+  }
+  writer.Align();
+  for (size_t nid = 0; nid < nodes_.size(); ++nid) {
+    nodes[nid].inputs = static_cast<uint32_t>(flat.size());
+    nodes[nid].inputs_count = nodes_[nid].inputs.size();
+    for (const NodeEntry& e : nodes_[nid].inputs) writer.WriteEntry(e.node_id, e.index, e.version);
+  }
+  header.nodes_count = nodes.size();
+  header.nodes = writer.Align();
+  for (const GraphFlatNode& node : nodes) writer.Write(node);
+  header.input_nodes_count = input_nodes_.size();
+  header.input_nodes = writer.Align();
+  for (uint32_t nid : input_nodes_) writer.Write(nid);
+  header.node_row_ptr_count = node_row_ptr_.size();
+  header.node_row_ptr = writer.Align();
+  for (uint32_t ptr : node_row_ptr_) writer.Write(ptr);
+  header.outputs_count = outputs_.size();
+  header.outputs = writer.Align();
+  for (const NodeEntry& e : outputs_) writer.WriteEntry(e.node_id, e.index, e.version);
+
+  header.entries_count = attrs_.storage_id.size();
+  ICHECK_EQ(attrs_.dltype.size(), header.entries_count);
+  ICHECK_EQ(attrs_.shape.size(), header.entries_count);
+  header.storage_id = writer.Align();
+  for (int sid : attrs_.storage_id) writer.Write(static_cast<uint32_t>(sid));
+  header.dltype = writer.Align();
+  for (const std::string& dltype : attrs_.dltype) writer.Write(String2DLDataType(dltype));
+  header.ndim = writer.Align();
+  header.shape_stride = 1;
+  for (const std::vector<int64_t>& shape : attrs_.shape) {
+    writer.Write(static_cast<uint32_t>(shape.size()));
+    header.shape_stride = std::max(header.shape_stride, static_cast<uint32_t>(shape.size()));
+  }
+  header.shape = writer.Align();
+  for (const std::vector<int64_t>& shape : attrs_.shape) {
+    for (uint32_t i = 0; i < header.shape_stride; ++i) {
+      writer.Write(i < shape.size() ? shape[i] : int64_t{0});
+    }
+  }
+  std::memcpy(&flat[0], &header, sizeof(header));
+  return flat;
+}
+
+std::string GraphExecutor::GraphJSONToFlat(const std::string& graph_json) {
+  GraphExecutor graph;
+  std::istringstream is(graph_json);
+  dmlc::JSONReader reader(&is);
+  graph.Load(&reader);
+  return graph.SaveGraphFlat();
+}
+
+void GraphExecutor::InitReplica(const GraphExecutor& base) {
+  ICHECK(base.lazy_params_ == nullptr)
+      << "Run the executor once to load its lazy parameters before replicating it";
+  nodes_ = base.nodes_;
+  input_nodes_ = base.input_nodes_;
+  param_names_ = base.param_names_;
+  input_map_ = base.input_map_;
+  output_map_ = base.output_map_;
+  node_row_ptr_ = base.node_row_ptr_;
+  outputs_ = base.outputs_;
+  attrs_ = base.attrs_;
+  module_ = base.module_;
+  devices_ = base.devices_;
+  op_funcs_ = base.op_funcs_;
+  thread_pool_ = base.thread_pool_;
+  inter_op_threads_ = base.inter_op_threads_;
+  module_lookup_linked_param_ = base.module_lookup_linked_param_;
+  module_lookup_linked_param_valid_ = base.module_lookup_linked_param_valid_;
+  default_lookup_linked_param_ = base.default_lookup_linked_param_;
+  if (default_lookup_linked_param_) {
+    lookup_linked_param_ = PackedFunc(
+        [this](TVMArgs args, TVMRetValue* rv) { this->DefaultLookupLinkedParam(args, rv); });
+  } else {
+    lookup_linked_param_ = base.lookup_linked_param_;
+  }
+  // Share the storage only holding parameters.
+  std::vector<bool> is_param(num_node_entries(), false);
+  for (uint32_t nid : input_nodes_) {
+    if (param_names_.count(nodes_[nid].name)) is_param[entry_id(nid, 0)] = true;
+  }
+  std::vector<NDArray> shared_storage(base.storage_pool_.size());
+  std::vector<bool> shared(base.storage_pool_.size(), true);
+  for (size_t eid = 0; eid < is_param.size(); ++eid) {
+    if (!is_param[eid]) shared[attrs_.storage_id[eid]] = false;
+  }
+  for (size_t eid = 0; eid < is_param.size(); ++eid) {
+    int sid = attrs_.storage_id[eid];
+    if (is_param[eid] && shared[sid]) shared_storage[sid] = base.storage_pool_[sid];
+  }
+  this->SetupStorage(&shared_storage);
+  // The base may refer to parameters shared from another executor.
+  for (size_t eid = 0; eid < is_param.size(); ++eid) {
+    if (!is_param[eid]) continue;
+    data_entry_[eid] = base.data_entry_[eid];
+    data_alignment_[eid] = base.data_alignment_[eid];
+  }
+  this->SetupOpExecs();
+  if (base.num_streams_ > 1) {
+    num_streams_ = base.num_streams_;
+    this->SetupStreams();
+  }
+}
+
 /*!
  * \brief Get the input index given the name of input.
  * \param name The name of the input.
@@ -303,14 +756,35 @@ void GraphExecutor::LoadParams(const std::string& param_blob) {
 }
 
 void GraphExecutor::LoadParams(dmlc::Stream* strm) {
-  Map<String, NDArray> params = ::tvm::runtime::LoadParams(strm);
-  for (auto& p : params) {
-    param_names_.insert(p.first);
-    int in_idx = GetInputIndex(p.first);
+  // Stream the tensors straight into the graph, rather than through a dictionary in memory.
+  StreamParams(strm, [this](const std::string& name, const std::vector<int64_t>& shape,
+                            DLDataType dtype) -> NDArray {
+    param_names_.insert(name);
+    int in_idx = GetInputIndex(name);
+    if (in_idx < 0) return NDArray();
+    return data_entry_[this->entry_id(input_nodes_[in_idx], 0)];
+  });
+}
+
+void GraphExecutor::LoadParamsFromFile(const std::string& path, bool lazy) {
+  if (lazy) {
+    lazy_params_ = std::make_unique<LazyParams>(path);
+    for (const std::string& name : lazy_params_->Names()) {
+      param_names_.insert(name);
+    }
+    return;
+  }
+  SimpleBinaryFileStream strm(path, "rb");
+  this->LoadParams(&strm);
+}
+
+void GraphExecutor::LoadLazyParams() {
+  for (const std::string& name : lazy_params_->Names()) {
+    int in_idx = GetInputIndex(name);
     if (in_idx < 0) continue;
-    uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
-    data_entry_[eid].CopyFrom(p.second);
+    lazy_params_->LoadInto(name, data_entry_[this->entry_id(input_nodes_[in_idx], 0)]);
   }
+  lazy_params_.reset();
 }
 
 void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm) {
@@ -325,6 +799,7 @@ void GraphExecutor::ShareParams(const GraphExecutor& other, dmlc::Stream* strm)
   size_t size = static_cast<size_t>(sz);
   ICHECK(size == names.size()) << "Invalid parameters file format";
   for (size_t i = 0; i < size; ++i) {
+    param_names_.insert(names[i]);
     int in_idx = GetInputIndex(names[i]);
     if (in_idx < 0) continue;
     uint32_t eid = this->entry_id(input_nodes_[in_idx], 0);
@@ -375,7 +850,7 @@ void GraphExecutor::DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv) {
   *rv = NDArray(GetObjectPtr<Object>(container));
 }
 
-void GraphExecutor::SetupStorage() {
+void GraphExecutor::SetupStorage(const std::vector<NDArray>* shared_storage) {
   // Grab saved optimization plan from graph.
   std::vector<DLDataType> vtype;
   for (const std::string& s_type : attrs_.dltype) {
@@ -448,7 +923,13 @@ void GraphExecutor::SetupStorage() {
   }
 
   // Allocate the space.
-  for (const auto& pit : pool_entry) {
+  for (size_t sid = 0; sid < pool_entry.size(); ++sid) {
+    const auto& pit = pool_entry[sid];
+    if (shared_storage != nullptr && sid < shared_storage->size() &&
+        (*shared_storage)[sid].defined()) {
+      storage_pool_.push_back((*shared_storage)[sid]);
+      continue;
+    }
     // This for loop is very fast since there are usually only a couple of
     // devices available on the same hardware.
     const auto& cit = std::find_if(devices_.begin(), devices_.end(), [&pit](const Device& d) {
@@ -487,6 +968,7 @@ void GraphExecutor::SetupStorage() {
 
 void GraphExecutor::SetupOpExecs() {
   op_execs_.resize(this->GetNumOfNodes());
+  op_args_.resize(this->GetNumOfNodes());
   input_dltensors_.resize(num_node_entries());
   output_dltensors_.resize(num_node_entries());
   both_output_opinput_dltensors_.resize(num_node_entries());
@@ -517,6 +999,7 @@ void GraphExecutor::SetupOpExecs() {
 
     std::shared_ptr<OpArgs> op_args = nullptr;
     std::tie(op_execs_[nid], op_args) = CreateTVMOp(inode.param, args);
+    op_args_[nid] = op_args;
 
     for (size_t i = 0; i < inode.inputs.size(); i++) {
       uint32_t input_eid = this->entry_id(inode.inputs[i]);
@@ -543,6 +1026,223 @@ void GraphExecutor::SetupOpExecs() {
   }
 }
 
+void GraphExecutor::SetupWeightPrefetch(int64_t max_region_bytes) {
+  // Free the regions of the previous prefetcher, and bind the operators to DDR again.
+  weight_prefetch_ = nullptr;
+  for (uint32_t nid = 0; nid < prefetch_args_.size(); ++nid) {
+    for (uint32_t i : prefetch_args_[nid]) {
+      const DLTensor* weight = data_entry_[this->entry_id(nodes_[nid].inputs[i])].operator->();
+      op_args_[nid]->args[i].data = weight->data;
+      op_args_[nid]->args[i].byte_offset = weight->byte_offset;
+    }
+  }
+  prefetch_stage_.assign(this->GetNumOfNodes(), -1);
+  prefetch_args_.assign(this->GetNumOfNodes(), {});
+  if (max_region_bytes == 0) return;
+  ICHECK_GT(max_region_bytes, 0) << "The size of the prefetch regions must be positive";
+  const PackedFunc* fcreate = Registry::Get("device_api.hexagon.dma_prefetcher");
+  ICHECK(fcreate != nullptr) << "Weight prefetch needs the Hexagon runtime";
+  if (lazy_params_ != nullptr) this->LoadLazyParams();
+  std::vector<bool> is_param(num_node_entries(), false);
+  for (uint32_t nid : input_nodes_) {
+    if (param_names_.count(nodes_[nid].name)) is_param[entry_id(nid, 0)] = true;
+  }
+  // One stage per operator reading parameters, in the order Run executes them.
+  Array<Array<NDArray>> weights;
+  std::vector<uint32_t> stage_nodes;
+  for (uint32_t nid = 0; nid < op_execs_.size(); ++nid) {
+    if (!op_execs_[nid] || op_args_[nid] == nullptr) continue;
+    Array<NDArray> stage;
+    for (uint32_t i = 0; i < nodes_[nid].inputs.size(); ++i) {
+      const NDArray& entry = data_entry_[this->entry_id(nodes_[nid].inputs[i])];
+      if (!is_param[this->entry_id(nodes_[nid].inputs[i])] ||
+          entry->device.device_type != kDLHexagon) {
+        continue;
+      }
+      stage.push_back(entry);
+      prefetch_args_[nid].push_back(i);
+    }
+    if (stage.empty()) continue;
+    prefetch_stage_[nid] = static_cast<int64_t>(weights.size());
+    weights.push_back(stage);
+    stage_nodes.push_back(nid);
+  }
+  if (weights.empty()) return;
+  Array<ObjectRef> prefetcher = (*fcreate)(weights, max_region_bytes);
+  Array<ShapeTuple> addresses = Downcast<Array<ShapeTuple>>(prefetcher[1]);
+  // The VTCM address of a weight does not change between runs, bind the operators once.
+  for (size_t stage = 0; stage < stage_nodes.size(); ++stage) {
+    uint32_t nid = stage_nodes[stage];
+    for (size_t k = 0; k < prefetch_args_[nid].size(); ++k) {
+      if (addresses[stage][k] == 0) continue;
+      DLTensor* arg = &op_args_[nid]->args[prefetch_args_[nid][k]];
+      arg->data = reinterpret_cast<void*>(addresses[stage][k]);
+      arg->byte_offset = 0;
+    }
+  }
+  weight_prefetch_ = Downcast<PackedFunc>(prefetcher[0]);
+}
+
+GraphExecutor::~GraphExecutor() {
+  for (TVMStreamHandle stream : side_streams_) {
+    DeviceAPI::Get(stream_device_)->FreeStream(stream_device_, stream);
+  }
+}
+
+void GraphExecutor::GetOpDependencies(std::vector<uint32_t>* op_nodes,
+                                      std::vector<std::vector<uint32_t>>* successors) {
+  uint32_t num_nodes = this->GetNumOfNodes();
+  op_nodes->clear();
+  successors->assign(num_nodes, {});
+  // The last operator writing each storage, and the operators reading it since.
+  std::unordered_map<int, uint32_t> last_writer;
+  std::unordered_map<int, std::vector<uint32_t>> readers;
+  auto add_dep = [&](uint32_t from, uint32_t to) {
+    if (from != to) (*successors)[from].push_back(to);
+  };
+  for (uint32_t nid = 0; nid < num_nodes; ++nid) {
+    const auto& inode = nodes_[nid];
+    if (inode.op_type == "null") continue;
+    op_nodes->push_back(nid);
+    for (const auto& e : inode.inputs) {
+      if (nodes_[e.node_id].op_type != "null") add_dep(e.node_id, nid);
+      int sid = attrs_.storage_id[this->entry_id(e)];
+      auto it = last_writer.find(sid);
+      if (it != last_writer.end()) add_dep(it->second, nid);
+      readers[sid].push_back(nid);
+    }
+    for (uint32_t index = 0; index < inode.param.num_outputs; ++index) {
+      int sid = attrs_.storage_id[this->entry_id(nid, index)];
+      auto it = last_writer.find(sid);
+      if (it != last_writer.end()) add_dep(it->second, nid);
+      for (uint32_t reader : readers[sid]) add_dep(reader, nid);
+      readers[sid].clear();
+      last_writer[sid] = nid;
+    }
+  }
+  for (auto& succs : *successors) {
+    std::sort(succs.begin(), succs.end());
+    succs.erase(std::unique(succs.begin(), succs.end()), succs.end());
+  }
+}
+
+void GraphExecutor::SetupInterOpScheduler() {
+  std::vector<uint32_t> op_nodes;
+  std::vector<std::vector<uint32_t>> successors;
+  this->GetOpDependencies(&op_nodes, &successors);
+  inter_op_scheduler_ = std::make_unique<InterOpScheduler>(
+      &op_execs_, std::move(op_nodes), std::move(successors), inter_op_threads_);
+}
+
+void GraphExecutor::SetupStreams() {
+  uint32_t num_nodes = this->GetNumOfNodes();
+  std::vector<uint32_t> op_nodes;
+  std::vector<std::vector<uint32_t>> successors;
+  this->GetOpDependencies(&op_nodes, &successors);
+  stream_device_ = Device{kDLCPU, 0};
+  for (const Device& dev : devices_) {
+    if (dev.device_type != kDLCPU) {
+      stream_device_ = dev;
+      break;
+    }
+  }
+  node_stream_.assign(num_nodes, -1);
+  stream_waits_.assign(num_nodes, {});
+  if (stream_device_.device_type == kDLCPU) return;
+  auto on_stream_device = [this](uint32_t nid) {
+    const Device& dev = data_entry_[this->entry_id(nid, 0)]->device;
+    return dev.device_type == stream_device_.device_type &&
+           dev.device_id == stream_device_.device_id;
+  };
+  // The length of the longest path from each node to the end of the graph.
+  std::vector<int> height(num_nodes, 0);
+  for (auto it = op_nodes.rbegin(); it != op_nodes.rend(); ++it) {
+    height[*it] = 1;
+    for (uint32_t succ : successors[*it]) {
+      height[*it] = std::max(height[*it], height[succ] + 1);
+    }
+  }
+  std::vector<std::vector<uint32_t>> predecessors(num_nodes);
+  for (uint32_t nid : op_nodes) {
+    for (uint32_t succ : successors[nid]) predecessors[succ].push_back(nid);
+  }
+  // Whether a successor already continued the stream of each node.
+  std::vector<bool> continued(num_nodes, false);
+  std::vector<int> stream_load(num_streams_, 0);
+  for (uint32_t nid : op_nodes) {
+    if (!on_stream_device(nid)) continue;
+    int critical_pred = -1;
+    for (uint32_t pred : predecessors[nid]) {
+      if (node_stream_[pred] < 0 || continued[pred]) continue;
+      if (critical_pred < 0 || height[pred] > height[critical_pred]) critical_pred = pred;
+    }
+    int stream;
+    if (critical_pred >= 0) {
+      continued[critical_pred] = true;
+      stream = node_stream_[critical_pred];
+    } else {
+      stream = static_cast<int>(std::min_element(stream_load.begin(), stream_load.end()) -
+                                stream_load.begin());
+    }
+    node_stream_[nid] = stream;
+    ++stream_load[stream];
+    for (uint32_t pred : predecessors[nid]) {
+      if (node_stream_[pred] >= 0 && node_stream_[pred] != stream) {
+        stream_waits_[nid].push_back(node_stream_[pred]);
+      }
+    }
+    std::sort(stream_waits_[nid].begin(), stream_waits_[nid].end());
+    stream_waits_[nid].erase(std::unique(stream_waits_[nid].begin(), stream_waits_[nid].end()),
+                             stream_waits_[nid].end());
+  }
+  DeviceAPI* api = DeviceAPI::Get(stream_device_);
+  for (TVMStreamHandle stream : side_streams_) api->FreeStream(stream_device_, stream);
+  side_streams_.clear();
+  for (int i = 1; i < num_streams_; ++i) {
+    side_streams_.push_back(api->CreateStream(stream_device_));
+  }
+}
+
+void GraphExecutor::RunMultiStream() {
+  if (node_stream_.empty()) this->SetupStreams();
+  threading::ThreadPoolScope thread_pool_scope(thread_pool_);
+  if (stream_device_.device_type == kDLCPU) {
+    for (size_t i = 0; i < op_execs_.size(); ++i) {
+      if (op_execs_[i]) op_execs_[i]();
+    }
+    return;
+  }
+  DeviceAPI* api = DeviceAPI::Get(stream_device_);
+  // The current stream is stream 0, it is the capture stream under CUDA graph capture. The
+  // side streams fork from it and join it again, so captures record the whole schedule.
+  TVMStreamHandle main_stream = api->GetCurrentStream(stream_device_);
+  auto get_stream = [&](int stream) {
+    return stream == 0 ? main_stream : side_streams_[stream - 1];
+  };
+  for (TVMStreamHandle stream : side_streams_) {
+    api->SyncStreamFromTo(stream_device_, main_stream, stream);
+  }
+  int current = 0;
+  for (size_t nid = 0; nid < op_execs_.size(); ++nid) {
+    if (!op_execs_[nid]) continue;
+    int stream = std::max(node_stream_[nid], 0);
+    // Waiting on the whole stream of a predecessor also waits for the operators issued after
+    // it there, which is conservative but keeps events out of the schedule.
+    for (int wait : stream_waits_[nid]) {
+      api->SyncStreamFromTo(stream_device_, get_stream(wait), get_stream(stream));
+    }
+    if (stream != current) {
+      api->SetStream(stream_device_, get_stream(stream));
+      current = stream;
+    }
+    op_execs_[nid]();
+  }
+  api->SetStream(stream_device_, main_stream);
+  for (TVMStreamHandle stream : side_streams_) {
+    api->SyncStreamFromTo(stream_device_, stream, main_stream);
+  }
+}
+
 std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphExecutor::CreateTVMOp(
     const TVMOpParam& param, const std::vector<DLTensor>& args) {
   std::shared_ptr<GraphExecutor::OpArgs> arg_ptr = std::make_shared<GraphExecutor::OpArgs>();
@@ -581,8 +1281,27 @@ std::pair<std::function<void()>, std::shared_ptr<GraphExecutor::OpArgs>> GraphEx
 
   // Get compiled function from the module that contains both host and device
   // code.
-  tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
-  ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
+  auto it = op_funcs_->find(param.func_name);
+  if (it == op_funcs_->end()) {
+    tvm::runtime::PackedFunc pf = module_.GetFunction(param.func_name, true);
+    ICHECK(pf != nullptr) << "no such function in module: " << param.func_name;
+    it = op_funcs_->emplace(param.func_name, pf).first;
+  }
+  tvm::runtime::PackedFunc pf = it->second;
+
+  if (TVMBackendPackedCFunc faddr = GetBackendPackedCFunc(module_, param.func_name)) {
+    // Call the kernel of the library directly, skipping the PackedFunc dispatch. The
+    // PackedFunc is kept to hold on to the library.
+    auto fexec = [arg_ptr, faddr, pf]() {
+      TVMValue ret_value;
+      int ret_type_code = kTVMNullptr;
+      int ret = (*faddr)(arg_ptr->arg_values.data(), arg_ptr->arg_tcodes.data(),
+                         static_cast<int>(arg_ptr->arg_values.size()), &ret_value, &ret_type_code,
+                         nullptr);
+      ICHECK_EQ(ret, 0) << TVMGetLastError();
+    };
+    return {fexec, arg_ptr};
+  }
 
   auto fexec = [arg_ptr, pf]() {
     TVMRetValue rv;
@@ -662,6 +1381,25 @@ PackedFunc GraphExecutor::GetFunction(const String& name, const ObjectPtr<Object
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->NumInputs(); });
   } else if (name == "run") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Run(); });
+  } else if (name == "warmup") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Warmup(); });
+  } else if (name == "run_async") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      CHECK(args.size() % 2 == 1)
+          << "The arguments of run_async are a callback and key-value pairs of inputs";
+      std::vector<std::pair<int, NDArray>> inputs;
+      for (int i = 1; i < args.size(); i += 2) {
+        std::string name = args[i].operator String();
+        int in_idx = this->GetInputIndex(name);
+        CHECK_GE(in_idx, 0) << "Cannot find input " << name;
+        inputs.emplace_back(in_idx, args[i + 1].operator NDArray());
+      }
+      this->RunAsync(std::move(inputs), args[0], sptr_to_self);
+    });
+  } else if (name == "run_on_stream") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->RunOnStream(args[0].operator void*());
+    });
   } else if (name == "run_from_inputs") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
@@ -694,6 +1432,11 @@ PackedFunc GraphExecutor::GetFunction(const String& name, const ObjectPtr<Object
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->LoadParams(args[0].operator std::string());
     });
+  } else if (name == "load_params_from_file") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      bool lazy = args.num_args > 1 && args[1].operator bool();
+      this->LoadParamsFromFile(args[0].operator std::string(), lazy);
+    });
   } else if (name == "share_params") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       const auto& module = args[0].operator Module();
@@ -707,6 +1450,40 @@ PackedFunc GraphExecutor::GetFunction(const String& name, const ObjectPtr<Object
       CHECK(String::CanConvertFrom(args[0])) << "Input key is not a string";
       *rv = this->GetInputIndex(args[0].operator String());
     });
+  } else if (name == "set_thread_pool") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->thread_pool_ = args[0].operator std::string();
+    });
+  } else if (name == "set_num_streams") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int num_streams = args[0];
+      ICHECK_GE(num_streams, 1) << "The number of streams must be positive";
+      if (num_streams != this->num_streams_) {
+        this->num_streams_ = num_streams;
+        // Create the streams now, stream creation is not allowed during a CUDA graph capture.
+        this->SetupStreams();
+      }
+    });
+  } else if (name == "set_weight_prefetch") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->SetupWeightPrefetch(args[0].operator int64_t());
+    });
+  } else if (name == "set_inter_op_threads") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int num_threads = args[0];
+      ICHECK_GE(num_threads, 1) << "The number of inter-op threads must be positive";
+      if (num_threads != this->inter_op_threads_) {
+        this->inter_op_threads_ = num_threads;
+        this->inter_op_scheduler_.reset();
+      }
+    });
+  } else if (name == "set_sampling_interval") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->sampler_.SetInterval(args[0].operator int64_t());
+    });
+  } else if (name == "get_sampled_profile") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->sampler_.Report(); });
   } else if (name == "get_input_info") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       auto [shape_info, dtype_info] = this->GetInputInfo();
@@ -755,6 +1532,18 @@ std::vector<Device> GetAllDevice(const TVMArgs& args, int dev_start_arg) {
 // execution support yet. For heterogenenous execution, at least 5 arguments will
 // be passed in. The third one is the number of devices.
 // Eventually, we will only probably pass Device for all the languages.
+TVM_REGISTER_GLOBAL("tvm.graph_executor.json_to_binary")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      std::string binary = GraphExecutor::GraphJSONToBinary(args[0]);
+      *rv = TVMByteArray{binary.data(), binary.size()};
+    });
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor.json_to_flat")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      std::string flat = GraphExecutor::GraphJSONToFlat(args[0]);
+      *rv = TVMByteArray{flat.data(), flat.size()};
+    });
+
 TVM_REGISTER_GLOBAL("tvm.graph_executor.create").set_body([](TVMArgs args, TVMRetValue* rv) {
   ICHECK_GE(args.num_args, 4) << "The expected number of arguments for graph_executor.create is "
                                  "at least 4, but it has "
@@ -30,6 +30,7 @@
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/packed_func.h>
+#include <tvm/runtime/profiling.h>
 
 #include <memory>
 #include <string>
@@ -39,6 +40,10 @@
 #include <utility>
 #include <vector>
 
+#include "../async_run.h"
+#include "../file_utils.h"
+#include "inter_op_scheduler.h"
+
 namespace tvm {
 namespace runtime {
 
@@ -50,6 +55,11 @@ namespace runtime {
   }
 
 /*! \brief operator attributes about tvm op */
+/*! \brief Magic number for the binary graph format, the bytes "TVMGRAPH". */
+constexpr uint64_t kTVMGraphBinaryMagic = 0x48504152474D5654;
+/*! \brief Magic number for the flat graph format, the bytes "TVMGFLAT". */
+constexpr uint64_t kTVMGraphFlatMagic = 0x54414C46474D5654;
+
 struct TVMOpParam {
   std::string func_name;
   std::unordered_map<std::string, ObjectRef> attrs;
@@ -87,7 +97,31 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \return The type key of the executor.
    */
   const char* type_key() const final { return "GraphExecutor"; }
+  ~GraphExecutor();
   void Run();
+  /*!
+   * \brief Do the lazy initialization of the kernels for the devices of the executor, e.g.
+   *  loading the device modules, without running the model, so that the first run is not slowed
+   *  down by it.
+   */
+  void Warmup();
+  /*!
+   * \brief Run the operators of the accelerator on the given stream instead of the current one.
+   *
+   *  Running on the stream of the consumer of the outputs, or the producer of the inputs, orders
+   *  the graph with the work of the other framework without synchronizing the host.
+   * \param stream The stream to run on.
+   */
+  void RunOnStream(TVMStreamHandle stream);
+  /*!
+   * \brief Set the inputs, run and copy out the outputs asynchronously, after the previous
+   *  asynchronous runs of the executor.
+   * \param inputs The index and value of the inputs to set.
+   * \param callback Called with the outputs, or with the error message of the run.
+   * \param sptr_to_self The executor, kept alive until the run completed.
+   */
+  void RunAsync(std::vector<std::pair<int, NDArray>> inputs, PackedFunc callback,
+                ObjectPtr<Object> sptr_to_self);
 
   /*! \brief Get the property of the runtime module .*/
   int GetPropertyMask() const final { return ModulePropertyMask::kRunnable; }
@@ -107,6 +141,83 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   void Init(const std::string& graph_json, tvm::runtime::Module module,
             const std::vector<Device>& devs, const PackedFunc lookup_linked_param_func = nullptr);
 
+  /*!
+   * \brief Serialize the graph in the binary graph format.
+   *
+   *  The format holds an interned string table, the node table, and the storage ids, dtypes
+   *  and shapes planned by the compiler. It loads without parsing JSON. All the integers
+   *  are little-endian:
+   *
+   *  - uint64 kTVMGraphBinaryMagic, uint64 reserved
+   *  - uint32 number of strings, then for each: uint32 length, the characters
+   *  - uint32 number of nodes, then for each: uint32 op type, name and function name as
+   *    string ids, uint32 num_inputs, num_outputs and flatten_data, uint32 number of inputs,
+   *    then uint32 node id, index and version of each, uint32 number of other attributes,
+   *    then their key and value string ids
+   *  - uint32 number of argument nodes, then their uint32 node ids
+   *  - uint32 number of node_row_ptr elements, then the uint32 elements
+   *  - uint32 number of outputs, then uint32 node id, index and version of each
+   *  - uint32 number of entries, then the int32 storage id of each entry
+   *  - uint32 whether device indices follow, then the int32 device index of each entry
+   *  - the uint32 dtype string id of each entry
+   *  - uint32 whether storage scopes follow, then the uint32 scope string id of each entry
+   *  - for each entry, uint32 ndim then the int64 dimensions
+   *
+   * \param strm The output stream.
+   */
+  void SaveGraphBinary(dmlc::Stream* strm) const;
+
+  /*!
+   * \brief Convert a JSON graph to the binary graph format.
+   * \param graph_json The JSON graph.
+   * \return The binary graph.
+   */
+  static std::string GraphJSONToBinary(const std::string& graph_json);
+
+  /*!
+   * \brief Serialize the graph in the flat graph format of the CRT graph executor.
+   *
+   *  Unlike the binary graph format, the flat format is laid out so that the CRT uses its
+   *  tables in place, e.g. from flash, see TVMGraphFlatHeader in
+   *  include/tvm/runtime/crt/graph_executor.h. All the integers are little-endian and every
+   *  table starts at a multiple of 8 bytes:
+   *
+   *  - the header: uint64 kTVMGraphFlatMagic, then uint32 counts of nodes, argument nodes,
+   *    node_row_ptr elements, outputs and entries, the shape stride, and the byte offsets of
+   *    the tables below
+   *  - the NUL-terminated strings
+   *  - the uint32 node id, index and version of the inputs of every node
+   *  - for each node: uint32 op type, name and function name as string offsets, uint32
+   *    num_inputs, num_outputs and flatten_data, uint32 offset and number of its inputs
+   *  - the uint32 argument node ids, the uint32 node_row_ptr elements, and the uint32 node id,
+   *    index and version of each output
+   *  - for each entry: the uint32 storage id, the DLDataType, the uint32 ndim, and the shape as
+   *    shape stride int64 dimensions padded with zeros
+   *
+   *  The CRT ignores device indices, storage scopes and the other node attributes, so the format
+   *  does not hold them.
+   *
+   * \return The flat graph.
+   */
+  std::string SaveGraphFlat() const;
+
+  /*!
+   * \brief Convert a JSON graph to the flat graph format.
+   * \param graph_json The JSON graph.
+   * \return The flat graph.
+   */
+  static std::string GraphJSONToFlat(const std::string& graph_json);
+
+  /*!
+   * \brief Initialize the graph executor as a replica of another one.
+   *
+   *  The replica reuses the parsed graph, the code module and the resolved kernels of \p base,
+   *  and shares its parameters. It only allocates the storage of the activations.
+   *
+   * \param base The initialized graph executor to replicate.
+   */
+  void InitReplica(const GraphExecutor& base);
+
   /*!
    * \brief Get the input index given the name of input.
    * \param name The name of the input.
@@ -193,6 +304,12 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * \param param_blob A binary blob of parameter.
    */
   void LoadParams(const std::string& param_blob);
+  /*!
+   * \brief Load parameters from a file written by SaveParams, streaming it tensor by tensor.
+   * \param path The parameters file.
+   * \param lazy Read the parameters at the first run rather than now.
+   */
+  void LoadParamsFromFile(const std::string& path, bool lazy);
 
   /*!
    * \brief Share parameters from pre-existing GraphExecutor instance.
@@ -416,14 +533,59 @@ class TVM_DLL GraphExecutor : public ModuleNode {
     }
     ICHECK_EQ(bitmask, 1 | 2 | 4 | 8 | 16) << "invalid format";
   }
+  /*! \brief Load the graph in the binary graph format, see SaveGraphBinary. */
+  void LoadGraphBinary(dmlc::Stream* strm);
   /*! \brief PackedFunc to lookup a linked paramter from a local Module. */
   void DefaultLookupLinkedParam(TVMArgs args, TVMRetValue* rv);
   /*! \brief Delete NDArray::Container with linked (i.e. static) data. */
   static void LinkedNDArrayDeleter(Object* container);
-  /*! \brief Setup the temporal storage */
-  void SetupStorage();
+  /*!
+   * \brief Setup the temporal storage
+   * \param shared_storage If given, the storage to reuse instead of allocating it, by storage id.
+   *  Undefined entries are allocated.
+   */
+  void SetupStorage(const std::vector<NDArray>* shared_storage = nullptr);
+  /*! \brief Read the parameters of lazy_params_ into the graph. */
+  void LoadLazyParams();
   /*! \brief Setup the executors. */
   void SetupOpExecs();
+  /*!
+   * \brief Compute the dependencies between the operators.
+   *
+   * An operator depends on the producers of its inputs, and an operator writing a storage
+   * waits for the operators which read or wrote it before, since the memory planner reuses
+   * storage between entries whose lifetimes do not overlap.
+   *
+   * \param op_nodes The ids of the operator nodes, in topological order.
+   * \param successors For each node id, the operator nodes depending on it.
+   */
+  void GetOpDependencies(std::vector<uint32_t>* op_nodes,
+                         std::vector<std::vector<uint32_t>>* successors);
+  /*! \brief Build the scheduler running the operators on inter-op threads. */
+  void SetupInterOpScheduler();
+  /*!
+   * \brief Assign the operators of the accelerator to streams.
+   *
+   * Walking the operators in order, each one continues the stream of its predecessor with the
+   * longest path to the end of the graph, unless another operator already continued it. Other
+   * operators start on the least loaded stream. An operator waits for the streams of its
+   * predecessors which run elsewhere.
+   */
+  void SetupStreams();
+  /*! \return The first accelerator the graph runs on, or the CPU. */
+  Device AcceleratorDevice() const;
+  /*! \brief Run the operators of the accelerator on several streams. */
+  void RunMultiStream();
+  /*!
+   * \brief Prefetch the parameters of the next operator into VTCM while the current one runs.
+   *
+   * The schedule is static, one stage per operator reading parameters on Hexagon, in execution
+   * order. The operators are bound to the VTCM copies of their parameters, apart from the
+   * parameters which do not fit the regions and stay in DDR.
+   *
+   * \param max_region_bytes The size bound of each of the two VTCM regions, 0 disables it.
+   */
+  void SetupWeightPrefetch(int64_t max_region_bytes);
   /*!
    * \brief Check the legality of external DLTensor*.
    * \param external The external DLTensor*.
@@ -450,6 +612,8 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<uint32_t> input_nodes_;
   /*! \brief The parameter names. */
   std::unordered_set<std::string> param_names_;
+  /*! \brief The parameters read at the next run, see LoadParamsFromFile. */
+  std::unique_ptr<LazyParams> lazy_params_;
   /*! \brief Map of input names to input indices. */
   std::unordered_map<std::string, uint32_t> input_map_;
   /*! \brief Map of output names to output indices. */
@@ -478,6 +642,11 @@ class TVM_DLL GraphExecutor : public ModuleNode {
   std::vector<size_t> data_alignment_;
   /*! \brief Operator on each node. */
   std::vector<std::function<void()>> op_execs_;
+  /*! \brief The arguments of the operator on each node. */
+  std::vector<std::shared_ptr<OpArgs>> op_args_;
+  /*! \brief The kernels looked up in module_ by name, shared with the replicas. */
+  std::shared_ptr<std::unordered_map<std::string, PackedFunc>> op_funcs_ =
+      std::make_shared<std::unordered_map<std::string, PackedFunc>>();
   /*! \brief Linked parameter lookup function. */
   PackedFunc lookup_linked_param_;
   /*! \brief Module's _lookup_linked_param function, used by DefaultLookupLinkedParam. */
@@ -487,6 +656,34 @@ class TVM_DLL GraphExecutor : public ModuleNode {
    * When the module does not include linked parmeters, module_lookup_linked_param_ will be nullptr.
    */
   bool module_lookup_linked_param_valid_;
+  /*! \brief True when lookup_linked_param_ is DefaultLookupLinkedParam of this executor. */
+  bool default_lookup_linked_param_{false};
+  /*! \brief The named thread pool the operators run on, empty for the default pool. */
+  std::string thread_pool_;
+  /*! \brief The number of operators run concurrently, 1 runs them one by one. */
+  int inter_op_threads_{1};
+  /*! \brief Runs the operators when inter_op_threads_ is more than 1. */
+  std::unique_ptr<InterOpScheduler> inter_op_scheduler_;
+  /*! \brief The number of streams the operators run on, 1 runs them on the current stream. */
+  int num_streams_{1};
+  /*! \brief The accelerator whose operators run on several streams. */
+  Device stream_device_{kDLCPU, 0};
+  /*! \brief Serializes the asynchronous runs. */
+  std::shared_ptr<AsyncRunQueue> async_queue_{std::make_shared<AsyncRunQueue>()};
+  /*! \brief The streams besides the current one, created by SetupStreams. */
+  std::vector<TVMStreamHandle> side_streams_;
+  /*! \brief For each node id, its stream, 0 being the current one and -1 the host. */
+  std::vector<int> node_stream_;
+  /*! \brief For each node id, the streams it waits for before running. */
+  std::vector<std::vector<int>> stream_waits_;
+  /*! \brief Waits for the parameters of a prefetch stage, null when prefetch is disabled. */
+  PackedFunc weight_prefetch_;
+  /*! \brief For each node id, its prefetch stage, -1 for none. */
+  std::vector<int64_t> prefetch_stage_;
+  /*! \brief For each node id, the inputs prefetched by its stage. */
+  std::vector<std::vector<uint32_t>> prefetch_args_;
+  /*! \brief Times the operators of every Nth run when they run one by one. */
+  profiling::SamplingProfiler sampler_{"Graph"};
 };
 
 std::vector<Device> GetAllDevice(const TVMArgs& args, int dev_start_arg);
@@ -0,0 +1,125 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file graph_executor_pool.cc
+ * \brief A bounded pool of graph executor replicas for serving concurrent requests.
+ */
+#include <tvm/runtime/registry.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "graph_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Hands out replicas of a graph executor with checkout and return semantics.
+ *
+ *  The replicas share the graph, the code and the parameters of the base executor, each one
+ *  only owns the storage of the activations. They are created on demand, up to a maximum
+ *  number, and reused once returned.
+ */
+class GraphExecutorPool : public ModuleNode {
+ public:
+  GraphExecutorPool(Module base, int max_size) : base_(base), max_size_(max_size) {
+    ICHECK_EQ(base->type_key(), std::string("GraphExecutor"));
+    ICHECK_GE(max_size_, 1) << "The pool holds at least one replica";
+  }
+
+  const char* type_key() const final { return "GraphExecutorPool"; }
+
+  /*! \return An idle replica, waiting for one to be returned when the pool is exhausted. */
+  Module Checkout() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return !idle_.empty() || num_replicas_ < max_size_; });
+      if (!idle_.empty()) {
+        Module replica = idle_.back();
+        idle_.pop_back();
+        return replica;
+      }
+      ++num_replicas_;
+    }
+    auto exec = make_object<GraphExecutor>();
+    exec->InitReplica(static_cast<const GraphExecutor&>(*base_.operator->()));
+    Module replica(exec);
+    std::lock_guard<std::mutex> lock(mutex_);
+    replicas_.insert(replica.operator->());
+    return replica;
+  }
+
+  /*! \brief Give a replica obtained from Checkout back to the pool. */
+  void Return(Module replica) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ICHECK(replicas_.count(replica.operator->())) << "The module is not a replica of this pool";
+      idle_.push_back(replica);
+    }
+    cv_.notify_one();
+  }
+
+  PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "checkout") {
+      return PackedFunc(
+          [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->Checkout(); });
+    } else if (name == "return") {
+      return PackedFunc(
+          [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Return(args[0]); });
+    } else if (name == "num_replicas") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *rv = num_replicas_;
+      });
+    } else if (name == "num_idle") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        *rv = static_cast<int>(idle_.size());
+      });
+    }
+    return PackedFunc();
+  }
+
+ private:
+  /*! \brief The executor the replicas are made from. */
+  Module base_;
+  /*! \brief The maximum number of replicas. */
+  int max_size_;
+  std::mutex mutex_;
+  /*! \brief Signals that a replica was returned. */
+  std::condition_variable cv_;
+  /*! \brief The number of replicas created, or being created. */
+  int num_replicas_{0};
+  /*! \brief The replicas which are not checked out. */
+  std::vector<Module> idle_;
+  /*! \brief The replicas created by this pool. */
+  std::unordered_set<const ModuleNode*> replicas_;
+};
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor.create_pool")
+    .set_body_typed([](Module base, int max_size) {
+      return Module(make_object<GraphExecutorPool>(base, max_size));
+    });
+
+}  // namespace runtime
+}  // namespace tvm
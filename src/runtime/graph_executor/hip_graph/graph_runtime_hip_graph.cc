@@ -0,0 +1,224 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file graph_runtime_hip_graph.cc
+ */
+
+#include <tvm/runtime/registry.h>
+
+#include <list>
+#include <utility>
+#include <vector>
+
+#include "../../rocm/rocm_common.h"
+#include "../graph_executor.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Graph executor with HIP Graph Support.
+ *
+ *  This is the ROCm counterpart of GraphExecutorCudaGraph: the kernels of a run are captured
+ *  from a HIP stream into a HIP graph, which is then launched at once instead of kernel by
+ *  kernel.
+ */
+class GraphExecutorHipGraph : public GraphExecutor {
+ public:
+  ~GraphExecutorHipGraph() {
+    for (auto& kv : graph_cache_) {
+      hipGraphExecDestroy(kv.second);
+    }
+    if (capture_stream_ != nullptr) {
+      const Device& dev = data_entry_[entry_id(0, 0)]->device;
+      TVMStreamFree(dev.device_type, dev.device_id, capture_stream_);
+    }
+  }
+
+  /*!
+   * \brief Begin HIP graph capture on stream, the stream enters capture mode.
+   */
+  void StartCapture() {
+    const Device& dev = data_entry_[entry_id(0, 0)]->device;
+
+    if (capture_stream_ == nullptr) {
+      TVMStreamCreate(dev.device_type, dev.device_id, &capture_stream_);
+    }
+    TVMSetStream(dev.device_type, dev.device_id, capture_stream_);
+
+    ROCM_CALL(hipStreamBeginCapture(static_cast<hipStream_t>(capture_stream_),
+                                    hipStreamCaptureModeGlobal));
+  }
+
+  /*!
+   * \brief Launch the instantiated graph on stream.
+   *
+   *  As for CUDA graphs, inputs or outputs rebound with the zero-copy setters since the capture
+   *  run the graph of the new bindings from the cache, or capture it again.
+   */
+  void RunHipGraph() {
+    ICHECK(!graph_cache_.empty()) << "Capture a HIP graph before running it";
+    std::vector<void*> binding = CurrentBinding();
+    auto it = graph_cache_.begin();
+    while (it != graph_cache_.end() && it->first != binding) ++it;
+    if (it == graph_cache_.end()) {
+      StartCapture();
+      Run();
+      UpdateOrInstantiate(EndCaptureGraph(), std::move(binding));
+    } else if (it != graph_cache_.begin()) {
+      graph_cache_.splice(graph_cache_.begin(), graph_cache_, it);
+    }
+    hipStream_t stream = static_cast<hipStream_t>(capture_stream_);
+    ROCM_CALL(hipGraphLaunch(graph_cache_.front().second, stream));
+    ROCM_CALL(hipStreamSynchronize(stream));
+  }
+
+  /*!
+   * \brief End HIP graph capture on stream, a graph will be created and
+   * instantiated.
+   */
+  void EndCapture() {
+    hipGraph_t graph = EndCaptureGraph();
+    size_t num_nodes = 0;
+    ROCM_CALL(hipGraphGetNodes(graph, nullptr, &num_nodes));
+    LOG(INFO) << "Num of nodes in the hip graph created using stream capture API = " << num_nodes;
+
+    for (auto& kv : graph_cache_) {
+      ROCM_CALL(hipGraphExecDestroy(kv.second));
+    }
+    graph_cache_.clear();
+    UpdateOrInstantiate(graph, CurrentBinding());
+  }
+
+  /*!
+   * \brief GetFunction Get the function based on input.
+   * \param name The function which needs to be invoked.
+   * \param sptr_to_self Packed function pointer.
+   */
+  PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self);
+
+ private:
+  /*! \brief End the capture and return the captured graph. */
+  hipGraph_t EndCaptureGraph() {
+    hipGraph_t graph;
+    ROCM_CALL(hipStreamEndCapture(static_cast<hipStream_t>(capture_stream_), &graph));
+    return graph;
+  }
+
+  /*!
+   * \brief Make the front of the cache run \p graph, then destroy \p graph.
+   * \param graph The captured graph.
+   * \param binding The input and output addresses the graph was captured with.
+   */
+  void UpdateOrInstantiate(hipGraph_t graph, std::vector<void*> binding) {
+    hipGraphExec_t exec = nullptr;
+    if (graph_cache_.size() >= cache_size_) {
+      exec = graph_cache_.back().second;
+      graph_cache_.pop_back();
+      hipGraphNode_t error_node;
+      hipGraphExecUpdateResult result;
+      if (hipGraphExecUpdate(exec, graph, &error_node, &result) != hipSuccess) {
+        // Clear the error of the failed update.
+        hipGetLastError();
+        ROCM_CALL(hipGraphExecDestroy(exec));
+        exec = nullptr;
+      }
+    }
+    if (exec == nullptr) {
+      ROCM_CALL(hipGraphInstantiate(&exec, graph, nullptr, nullptr, 0));
+    }
+    ROCM_CALL(hipGraphDestroy(graph));
+    graph_cache_.emplace_front(std::move(binding), exec);
+  }
+
+  /*! \return The addresses the inputs and outputs of the graph are bound to. */
+  std::vector<void*> CurrentBinding() const {
+    std::vector<void*> binding;
+    for (uint32_t nid : input_nodes_) {
+      uint32_t eid = entry_id(nid, 0);
+      binding.push_back(input_dltensors_[eid].empty() ? data_entry_[eid]->data
+                                                      : input_dltensors_[eid][0]->data);
+    }
+    for (const NodeEntry& output : outputs_) {
+      uint32_t eid = entry_id(output);
+      binding.push_back(output_dltensors_[eid].empty() ? data_entry_[eid]->data
+                                                       : output_dltensors_[eid][0]->data);
+    }
+    return binding;
+  }
+
+  /*! \brief The HIP stream on which to capture a HIP graph. */
+  TVMStreamHandle capture_stream_{nullptr};
+  /*! \brief The instantiated graphs by input and output binding, most recently used first. */
+  std::list<std::pair<std::vector<void*>, hipGraphExec_t>> graph_cache_;
+  /*! \brief The maximum number of instantiated graphs. */
+  size_t cache_size_{4};
+};
+
+PackedFunc GraphExecutorHipGraph::GetFunction(const String& name,
+                                              const ObjectPtr<Object>& sptr_to_self) {
+  if (name == "run_hip_graph") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->RunHipGraph(); });
+  } else if (name == "start_capture") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->StartCapture(); });
+  } else if (name == "end_capture") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->EndCapture(); });
+  } else if (name == "set_hip_graph_cache_size") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int cache_size = args[0];
+      ICHECK_GE(cache_size, 1) << "The HIP graph cache holds at least one graph";
+      this->cache_size_ = cache_size;
+      while (this->graph_cache_.size() > this->cache_size_) {
+        ROCM_CALL(hipGraphExecDestroy(this->graph_cache_.back().second));
+        this->graph_cache_.pop_back();
+      }
+    });
+  } else {
+    return GraphExecutor::GetFunction(name, sptr_to_self);
+  }
+}
+
+Module GraphExecutorHipGraphCreate(const std::string& sym_json, const tvm::runtime::Module& m,
+                                   const std::vector<Device>& devs,
+                                   PackedFunc lookup_linked_param_func) {
+  auto exec = make_object<GraphExecutorHipGraph>();
+  exec->Init(sym_json, m, devs, lookup_linked_param_func);
+  return Module(exec);
+}
+
+TVM_REGISTER_GLOBAL("tvm.graph_executor_hip_graph.create")
+    .set_body([](TVMArgs args, TVMRetValue* rv) {
+      ICHECK_GE(args.num_args, 4)
+          << "The expected number of arguments for graph_executor.create is "
+             "at least 4, but it has "
+          << args.num_args;
+      PackedFunc lookup_linked_param_func;
+      int dev_start_arg = 2;
+      if (args[2].type_code() == kTVMPackedFuncHandle) {
+        lookup_linked_param_func = args[2];
+        dev_start_arg++;
+      }
+
+      *rv = GraphExecutorHipGraphCreate(args[0], args[1], GetAllDevice(args, dev_start_arg),
+                                        lookup_linked_param_func);
+    });
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,160 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inter_op_scheduler.cc
+ */
+#include "inter_op_scheduler.h"
+
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/threading_backend.h>
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+namespace tvm {
+namespace runtime {
+
+InterOpScheduler::InterOpScheduler(const std::vector<std::function<void()>>* tasks,
+                                   std::vector<uint32_t> nodes,
+                                   std::vector<std::vector<uint32_t>> successors, int num_threads)
+    : tasks_(tasks),
+      nodes_(std::move(nodes)),
+      successors_(std::move(successors)),
+      num_deps_(successors_.size(), 0),
+      num_threads_(num_threads),
+      pending_(successors_.size(), 0) {
+  ICHECK_GE(num_threads_, 1);
+  for (const auto& succs : successors_) {
+    for (uint32_t succ : succs) {
+      ++num_deps_[succ];
+    }
+  }
+  // Split the cores between the inter-op threads.
+  int num_cores = std::max(threading::MaxConcurrency(), 1);
+  int cores_per_thread = std::max(num_cores / num_threads_, 1);
+  for (int worker_id = 0; worker_id < num_threads_; ++worker_id) {
+    std::vector<unsigned int> cpus;
+    for (int i = 0; i < cores_per_thread; ++i) {
+      cpus.push_back(static_cast<unsigned int>((worker_id * cores_per_thread + i) % num_cores));
+    }
+    threading::CreateThreadPool(IntraOpPoolName(worker_id), cpus, /*exist_ok=*/true);
+  }
+  for (int worker_id = 1; worker_id < num_threads_; ++worker_id) {
+    workers_.emplace_back([this, worker_id]() { this->WorkerMain(worker_id); });
+  }
+}
+
+InterOpScheduler::~InterOpScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::string InterOpScheduler::IntraOpPoolName(int worker_id) const {
+  std::ostringstream os;
+  os << "graph_executor.inter_op." << num_threads_ << "." << worker_id;
+  return os.str();
+}
+
+void InterOpScheduler::Run() {
+  threading::ThreadPoolScope thread_pool_scope(IntraOpPoolName(0));
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (uint32_t nid : nodes_) {
+    pending_[nid] = num_deps_[nid];
+    if (num_deps_[nid] == 0) {
+      ready_.push_back(nid);
+    }
+  }
+  remaining_ = nodes_.size();
+  error_ = nullptr;
+  ++generation_;
+  cv_.notify_all();
+  Work(&lock);
+  // Nodes still running on other threads touch the executor's state, wait for them to finish.
+  done_cv_.wait(lock, [this]() { return active_ == 0; });
+  ready_.clear();
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void InterOpScheduler::WorkerMain(int worker_id) {
+  threading::ThreadPoolScope thread_pool_scope(IntraOpPoolName(worker_id));
+  uint64_t seen_generation = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [&]() { return shutdown_ || generation_ != seen_generation; });
+    if (shutdown_) return;
+    seen_generation = generation_;
+    ++active_;
+    Work(&lock);
+    if (--active_ == 0) {
+      done_cv_.notify_all();
+    }
+  }
+}
+
+void InterOpScheduler::Work(std::unique_lock<std::mutex>* lock) {
+  while (true) {
+    cv_.wait(*lock, [this]() { return !ready_.empty() || remaining_ == 0 || error_; });
+    if (remaining_ == 0 || error_) {
+      return;
+    }
+    uint32_t nid = ready_.front();
+    ready_.pop_front();
+    lock->unlock();
+    std::exception_ptr error;
+    try {
+      if ((*tasks_)[nid]) (*tasks_)[nid]();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock->lock();
+    if (error) {
+      // Abandon the run, the nodes depending on the failed one must not run.
+      if (!error_) error_ = error;
+      cv_.notify_all();
+      return;
+    }
+    --remaining_;
+    size_t num_ready = 0;
+    for (uint32_t succ : successors_[nid]) {
+      if (--pending_[succ] == 0) {
+        ready_.push_back(succ);
+        ++num_ready;
+      }
+    }
+    if (remaining_ == 0) {
+      cv_.notify_all();
+    } else if (num_ready > 1) {
+      // This thread takes one of the ready nodes itself.
+      for (size_t i = 1; i < num_ready; ++i) cv_.notify_one();
+    }
+  }
+}
+
+}  // namespace runtime
+}  // namespace tvm
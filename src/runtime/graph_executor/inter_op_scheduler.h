@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inter_op_scheduler.h
+ * \brief Runs the operators of a graph concurrently, following their dependencies.
+ */
+#ifndef TVM_RUNTIME_GRAPH_EXECUTOR_INTER_OP_SCHEDULER_H_
+#define TVM_RUNTIME_GRAPH_EXECUTOR_INTER_OP_SCHEDULER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Schedules the operators of a graph over a set of inter-op threads.
+ *
+ * Every run starts from the operators without dependencies and releases an operator once all
+ * of its predecessors have finished, so independent branches run concurrently. The thread
+ * calling Run is one of the inter-op threads. Each inter-op thread launches its intra-op
+ * parallel loops on its own named thread pool, and the pools partition the cores so that
+ * inter-op x intra-op threads never exceed them.
+ */
+class InterOpScheduler {
+ public:
+  /*!
+   * \brief Create the scheduler and its worker threads.
+   * \param tasks The operator of each graph node, indexed by node id. It must outlive the
+   *  scheduler.
+   * \param nodes The ids of the nodes to run.
+   * \param successors For each node id, the nodes which must wait for it.
+   * \param num_threads The number of inter-op threads, the calling thread included.
+   */
+  InterOpScheduler(const std::vector<std::function<void()>>* tasks, std::vector<uint32_t> nodes,
+                   std::vector<std::vector<uint32_t>> successors, int num_threads);
+  ~InterOpScheduler();
+
+  /*! \brief Run every node once, rethrowing the first error raised by any of them. */
+  void Run();
+
+  /*! \return The number of inter-op threads. */
+  int num_threads() const { return num_threads_; }
+
+ private:
+  /*! \brief Main loop of the worker threads. */
+  void WorkerMain(int worker_id);
+  /*! \brief Run ready nodes until the current run is finished. Called with the lock held. */
+  void Work(std::unique_lock<std::mutex>* lock);
+  /*! \return The named thread pool inter-op thread \p worker_id launches its kernels on. */
+  std::string IntraOpPoolName(int worker_id) const;
+
+  const std::vector<std::function<void()>>* tasks_;
+  std::vector<uint32_t> nodes_;
+  std::vector<std::vector<uint32_t>> successors_;
+  /*! \brief For each node id, its number of predecessors. */
+  std::vector<int> num_deps_;
+  int num_threads_;
+
+  std::mutex mutex_;
+  /*! \brief Signals the workers that a run started, or nodes became ready. */
+  std::condition_variable cv_;
+  /*! \brief Signals Run that the workers left the current run. */
+  std::condition_variable done_cv_;
+  /*! \brief For each node id, its number of unfinished predecessors in the current run. */
+  std::vector<int> pending_;
+  std::deque<uint32_t> ready_;
+  size_t remaining_{0};
+  /*! \brief The number of worker threads inside the current run. */
+  int active_{0};
+  uint64_t generation_{0};
+  bool shutdown_{false};
+  std::exception_ptr error_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_GRAPH_EXECUTOR_INTER_OP_SCHEDULER_H_
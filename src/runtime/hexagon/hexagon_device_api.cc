@@ -26,7 +26,9 @@
 #include <dmlc/thread_local.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/runtime/threading_backend.h>
 
 #include <cstdlib>
 #include <cstring>
@@ -43,6 +45,23 @@ HexagonDeviceAPI* HexagonDeviceAPI::Global() {
   return inst;
 }
 
+namespace {
+
+int HexagonParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
+  return HexagonDeviceAPI::Global()->ThreadManager()->ParallelLaunch(flambda, cdata, num_task);
+}
+
+}  // namespace
+
+void HexagonDeviceAPI::SetParallelLaunch(int granularity) {
+  if (granularity == 0) {
+    threading::SetParallelLaunchBackend(nullptr);
+    return;
+  }
+  ThreadManager()->SetParallelGranularity(granularity);
+  threading::SetParallelLaunchBackend(HexagonParallelLaunch);
+}
+
 void HexagonDeviceAPI::GetAttr(Device dev, DeviceAttrKind kind, TVMRetValue* rv) {
   if (kind == kExist) {
     *rv = 1;
@@ -298,12 +317,44 @@ TVM_REGISTER_GLOBAL("device_api.hexagon.release_resources")
       api->ReleaseResources();
     });
 
+TVM_REGISTER_GLOBAL("device_api.hexagon.set_parallel_launch").set_body_typed([](int granularity) {
+  HexagonDeviceAPI::Global()->SetParallelLaunch(granularity);
+});
+
 TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_device_bytes")
     .set_body([](TVMArgs args, TVMRetValue* rv) {
       HexagonDeviceAPI* api = HexagonDeviceAPI::Global();
       *rv = static_cast<int32_t>(api->VtcmPool()->VtcmDeviceBytes());
     });
 
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_arena_begin")
+    .set_body_typed([](int64_t nbytes) {
+      HexagonDeviceAPI::Global()->VtcmPool()->ArenaBegin(static_cast<size_t>(nbytes));
+    });
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_arena_end").set_body_typed([]() {
+  HexagonDeviceAPI::Global()->VtcmPool()->ArenaEnd();
+});
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_stats").set_body_typed([]() {
+  HexagonVtcmPool::Stats stats = HexagonDeviceAPI::Global()->VtcmPool()->GetStats();
+  auto count = [](size_t value) {
+    return ObjectRef(make_object<profiling::CountNode>(static_cast<int64_t>(value)));
+  };
+  Map<String, ObjectRef> ret;
+  ret.Set("used_bytes", count(stats.used_bytes));
+  ret.Set("peak_used_bytes", count(stats.peak_used_bytes));
+  ret.Set("largest_free_bytes", count(stats.largest_free_bytes));
+  ret.Set("num_allocations", count(stats.num_allocations));
+  ret.Set("num_failed_allocations", count(stats.num_failed_allocations));
+  ret.Set("num_fragmented_failures", count(stats.num_fragmented_failures));
+  return ret;
+});
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.vtcm_reset_stats").set_body_typed([]() {
+  HexagonDeviceAPI::Global()->VtcmPool()->ResetStats();
+});
+
 TVM_REGISTER_GLOBAL("device_api.hexagon").set_body([](TVMArgs args, TVMRetValue* rv) {
   DeviceAPI* ptr = HexagonDeviceAPI::Global();
   *rv = static_cast<void*>(ptr);
@@ -79,6 +79,7 @@ class HexagonDeviceAPI final : public DeviceAPI {
     runtime_dma.reset();
 
     CHECK(runtime_threads) << "runtime_threads was not created in AcquireResources";
+    SetParallelLaunch(0);
     runtime_threads.reset();
 
     CHECK(runtime_hexbuffs) << "runtime_hexbuffs was not created in AcquireResources";
@@ -153,6 +154,14 @@ class HexagonDeviceAPI final : public DeviceAPI {
     return runtime_threads.get();
   }
 
+  /*!
+   * \brief Run the parallel loops of the kernels on the HVX threads of the thread manager,
+   * in place of the thread pool.
+   * \param granularity The number of tasks per HVX thread of a parallel loop, 0 restores the
+   * thread pool.
+   */
+  void SetParallelLaunch(int granularity);
+
   HexagonUserDMA* UserDMA() {
     CHECK(runtime_dma) << "runtime_dma has not been created";
     return runtime_dma.get();
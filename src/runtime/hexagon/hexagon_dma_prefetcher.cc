@@ -0,0 +1,167 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "hexagon_dma_prefetcher.h"
+
+#include <tvm/runtime/container/array.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "hexagon_common.h"
+#include "hexagon_device_api.h"
+
+namespace tvm {
+namespace runtime {
+namespace hexagon {
+
+namespace {
+
+constexpr size_t kInDDR = SIZE_MAX;
+
+size_t AlignUp(size_t value) {
+  return (value + kHexagonAllocAlignment - 1) / kHexagonAllocAlignment * kHexagonAllocAlignment;
+}
+
+}  // namespace
+
+HexagonDmaPrefetcher::HexagonDmaPrefetcher(std::vector<Stage> schedule, size_t max_region_bytes,
+                                           HexagonUserDMA* dma, HexagonVtcmPool* pool,
+                                           uint32_t queue_id)
+    : schedule_(std::move(schedule)), dma_(dma), pool_(pool), queue_id_(queue_id) {
+  CHECK_LT(queue_id_, static_cast<uint32_t>(MAX_DMA_QUEUES));
+  // Pack the transfers of every stage from the front of its region, in order.
+  offsets_.resize(schedule_.size());
+  for (size_t stage = 0; stage < schedule_.size(); ++stage) {
+    size_t used = 0;
+    for (const Transfer& transfer : schedule_[stage]) {
+      CHECK(transfer.src != nullptr || transfer.nbytes == 0);
+      if (transfer.nbytes != 0 && used + transfer.nbytes <= max_region_bytes) {
+        offsets_[stage].push_back(used);
+        used = AlignUp(used + transfer.nbytes);
+      } else {
+        offsets_[stage].push_back(kInDDR);
+      }
+    }
+    region_bytes_ = std::max(region_bytes_, std::min(used, max_region_bytes));
+  }
+  if (region_bytes_ == 0) return;
+  region_bytes_ = AlignUp(region_bytes_);
+  for (char*& region : regions_) {
+    region = static_cast<char*>(pool_->Allocate(region_bytes_));
+  }
+}
+
+HexagonDmaPrefetcher::~HexagonDmaPrefetcher() {
+  Drain();
+  for (char* region : regions_) {
+    if (region != nullptr) pool_->Free(region, region_bytes_);
+  }
+}
+
+void* HexagonDmaPrefetcher::Address(size_t stage, size_t index) const {
+  CHECK_LT(stage, offsets_.size());
+  CHECK_LT(index, offsets_[stage].size());
+  size_t offset = offsets_[stage][index];
+  if (offset == kInDDR) return nullptr;
+  return regions_[stage % 2] + offset;
+}
+
+void HexagonDmaPrefetcher::Issue(size_t stage) {
+  issued_stage_ = static_cast<int64_t>(stage);
+  const std::vector<size_t>& offsets = offsets_[stage];
+  if (std::all_of(offsets.begin(), offsets.end(), [](size_t x) { return x == kInDDR; })) return;
+  // One group per stage, so that the wait is for the whole stage.
+  dma_->StartGroup(queue_id_);
+  for (size_t i = 0; i < schedule_[stage].size(); ++i) {
+    if (offsets[i] == kInDDR) continue;
+    char* dst = regions_[stage % 2] + offsets[i];
+    char* src = static_cast<char*>(schedule_[stage][i].src);
+    size_t nbytes = schedule_[stage][i].nbytes;
+    // The length of a descriptor is limited to 24 bits.
+    for (size_t pos = 0; pos < nbytes; pos += DESC_LENGTH_MASK) {
+      uint32_t length = static_cast<uint32_t>(std::min<size_t>(DESC_LENGTH_MASK, nbytes - pos));
+      int ret = DMA_RETRY;
+      do {
+        ret = dma_->Copy(queue_id_, dst + pos, src + pos, length, false);
+      } while (ret == DMA_RETRY);
+      CHECK(ret == DMA_SUCCESS) << "DMA prefetch of stage " << stage << " failed";
+    }
+  }
+  dma_->EndGroup(queue_id_);
+}
+
+void HexagonDmaPrefetcher::Begin(size_t stage) {
+  CHECK_LT(stage, schedule_.size());
+  if (region_bytes_ == 0) return;
+  if (issued_stage_ == static_cast<int64_t>(stage)) {
+    ++num_prefetched_;
+  } else {
+    // The copies in flight may target the region of this stage.
+    Drain();
+    Issue(stage);
+    ++num_synchronous_;
+  }
+  dma_->Wait(queue_id_, 0);
+  // Nothing is in flight, and a single stage schedule must copy again on the next run.
+  issued_stage_ = -1;
+  if (stage + 1 < schedule_.size()) Issue(stage + 1);
+}
+
+void HexagonDmaPrefetcher::Drain() {
+  if (issued_stage_ >= 0) dma_->Wait(queue_id_, 0);
+}
+
+TVM_REGISTER_GLOBAL("device_api.hexagon.dma_prefetcher")
+    .set_body_typed([](Array<Array<NDArray>> weights, int64_t max_region_bytes) {
+      std::vector<HexagonDmaPrefetcher::Stage> schedule;
+      for (const Array<NDArray>& stage_weights : weights) {
+        HexagonDmaPrefetcher::Stage stage;
+        for (const NDArray& weight : stage_weights) {
+          const DLTensor* tensor = weight.operator->();
+          stage.push_back({static_cast<char*>(tensor->data) + tensor->byte_offset,
+                           GetDataSize(*tensor)});
+        }
+        schedule.push_back(std::move(stage));
+      }
+      HexagonDeviceAPI* api = HexagonDeviceAPI::Global();
+      auto prefetcher = std::make_shared<HexagonDmaPrefetcher>(
+          std::move(schedule), static_cast<size_t>(max_region_bytes), api->UserDMA(),
+          api->VtcmPool());
+      // The VTCM address of every weight, 0 for the weights staying in DDR.
+      Array<ShapeTuple> addresses;
+      for (size_t stage = 0; stage < weights.size(); ++stage) {
+        std::vector<int64_t> stage_addresses;
+        for (size_t i = 0; i < weights[stage].size(); ++i) {
+          stage_addresses.push_back(reinterpret_cast<int64_t>(prefetcher->Address(stage, i)));
+        }
+        addresses.push_back(ShapeTuple(stage_addresses));
+      }
+      PackedFunc fbegin = TypedPackedFunc<void(int64_t)>(
+          [prefetcher](int64_t stage) { prefetcher->Begin(static_cast<size_t>(stage)); });
+      return Array<ObjectRef>{fbegin, addresses};
+    });
+
+}  // namespace hexagon
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,147 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TVM_RUNTIME_HEXAGON_HEXAGON_DMA_PREFETCHER_H_
+#define TVM_RUNTIME_HEXAGON_HEXAGON_DMA_PREFETCHER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hexagon_user_dma.h"
+#include "hexagon_vtcm_pool.h"
+
+namespace tvm {
+namespace runtime {
+namespace hexagon {
+
+//! \brief The virtual DMA queue of the prefetcher, apart from the kernels and the sync copies
+constexpr uint32_t kPrefetchDMAQueue = SYNC_DMA_QUEUE - 1;
+
+/*!
+ * \brief Prefetches the weights of the next operator into VTCM while the current one runs.
+ *
+ * The schedule is static: one stage per operator, in execution order, listing the DDR buffers
+ * the operator reads.  Two VTCM regions are used in turn, stage i lands in region i % 2, so
+ * the address of every transfer is known when the prefetcher is created and the operators
+ * can be bound to their VTCM copies once.  Begin(i) waits for the copies of stage i and starts
+ * the copies of stage i + 1 into the other region, which the operator of stage i - 1 is done
+ * with.  Transfers not fitting their region stay in DDR.
+ */
+class HexagonDmaPrefetcher {
+ public:
+  //! \brief A copy of a DDR buffer into VTCM
+  struct Transfer {
+    //! \brief The DDR buffer
+    void* src{nullptr};
+    //! \brief The size of the buffer
+    size_t nbytes{0};
+  };
+
+  //! \brief The transfers of one operator
+  using Stage = std::vector<Transfer>;
+
+  /*!
+   * \brief Allocate the VTCM regions of a schedule.
+   *
+   * \param schedule The stages, in the order Begin is called.
+   * \param max_region_bytes The upper bound of the size of each of the two regions.
+   * \param dma The DMA engine.
+   * \param pool The VTCM pool the regions are allocated from.
+   * \param queue_id The virtual DMA queue used for the copies.
+   */
+  HexagonDmaPrefetcher(std::vector<Stage> schedule, size_t max_region_bytes, HexagonUserDMA* dma,
+                       HexagonVtcmPool* pool, uint32_t queue_id = kPrefetchDMAQueue);
+
+  //! \brief Waits for the copies in flight and frees the regions.
+  ~HexagonDmaPrefetcher();
+
+  HexagonDmaPrefetcher(const HexagonDmaPrefetcher&) = delete;
+  HexagonDmaPrefetcher& operator=(const HexagonDmaPrefetcher&) = delete;
+  HexagonDmaPrefetcher(HexagonDmaPrefetcher&&) = delete;
+  HexagonDmaPrefetcher& operator=(HexagonDmaPrefetcher&&) = delete;
+
+  /*!
+   * \brief The VTCM address of a transfer.
+   * \param stage The stage.
+   * \param index The index of the transfer in the stage.
+   * \returns The address, or nullptr when the transfer stays in DDR.
+   */
+  void* Address(size_t stage, size_t index) const;
+
+  /*!
+   * \brief Make the transfers of a stage available and start prefetching the next stage.
+   *
+   * A stage which was not prefetched, e.g. the first one of a run, is copied synchronously.
+   * The last stage does not prefetch the first one, the weights may change between runs.
+   *
+   * \param stage The stage whose operator runs next.
+   */
+  void Begin(size_t stage);
+
+  //! \brief Wait for the copies in flight, e.g. before the DDR buffers are written.
+  void Drain();
+
+  //! \brief The size of each of the two VTCM regions
+  size_t RegionBytes() const { return region_bytes_; }
+
+  //! \brief The number of stages prefetched behind the previous operator
+  size_t NumPrefetched() const { return num_prefetched_; }
+
+  //! \brief The number of stages copied synchronously by Begin
+  size_t NumSynchronous() const { return num_synchronous_; }
+
+ private:
+  //! \brief Start the copies of a stage on the queue.
+  void Issue(size_t stage);
+
+  //! \brief The stages
+  std::vector<Stage> schedule_;
+
+  //! \brief For each stage, the offsets of its transfers in their region, SIZE_MAX for DDR
+  std::vector<std::vector<size_t>> offsets_;
+
+  //! \brief The DMA engine
+  HexagonUserDMA* dma_;
+
+  //! \brief The pool of the regions
+  HexagonVtcmPool* pool_;
+
+  //! \brief The virtual DMA queue
+  uint32_t queue_id_;
+
+  //! \brief The size of each region
+  size_t region_bytes_{0};
+
+  //! \brief The two regions, stage i uses region i % 2
+  char* regions_[2] = {nullptr, nullptr};
+
+  //! \brief The stage whose copies were issued last, -1 for none
+  int64_t issued_stage_{-1};
+
+  //! \brief The counters of the stages issued ahead and on demand
+  size_t num_prefetched_{0};
+  size_t num_synchronous_{0};
+};
+
+}  // namespace hexagon
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_HEXAGON_HEXAGON_DMA_PREFETCHER_H_
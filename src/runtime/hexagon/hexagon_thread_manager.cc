@@ -19,10 +19,23 @@
 
 #include "hexagon_thread_manager.h"
 
+#include <algorithm>
+
 namespace tvm {
 namespace runtime {
 namespace hexagon {
 
+namespace {
+
+//! \brief Stride of the barrier counters, one cache line each as TVMBackendParallelBarrier expects.
+constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
+
+bool IsHvx(HardwareResourceType type) {
+  return (type == HVX_0) || (type == HVX_1) || (type == HVX_2) || (type == HVX_3);
+}
+
+}  // namespace
+
 HexagonThreadManager::HexagonThreadManager(unsigned num_threads, unsigned thread_stack_size_bytes,
                                            unsigned thread_pipe_size_words,
                                            const std::vector<HardwareResourceType> hw_resources) {
@@ -41,6 +54,15 @@ HexagonThreadManager::HexagonThreadManager(unsigned num_threads, unsigned thread
   hw_resources_ = hw_resources;
   CheckResources();
 
+  // Parallel jobs run on the threads holding an HVX instance, or on all of them.
+  for (unsigned i = 0; i < hw_resources_.size(); i++) {
+    if (IsHvx(hw_resources_[i])) parallel_threads_.push_back(i);
+  }
+  if (parallel_threads_.empty()) {
+    for (unsigned i = 0; i < nthreads_; i++) parallel_threads_.push_back(i);
+  }
+  parallel_sync_.reset(new std::atomic<int>[parallel_threads_.size() * kSyncStride]);
+
   if (create_resource_managers_) {
     DLOG(INFO) << "Initialize hardware resource managers";
     // This creates the manager objects, which reserves (acquires) the resources.
@@ -264,6 +286,77 @@ void HexagonThreadManager::WaitOnThreads() {
   }
 }
 
+void HexagonThreadManager::SetParallelGranularity(int granularity) {
+  CHECK_GE(granularity, 1);
+  parallel_granularity_ = granularity;
+}
+
+int HexagonThreadManager::ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
+  bool expected = false;
+  if (!parallel_busy_.compare_exchange_strong(expected, true)) {
+    // Nested in a task of the running job, or racing with it: run the job as a single task.
+    std::atomic<int> sync_counter{0};
+    TVMParallelGroupEnv env;
+    env.num_task = 1;
+    env.sync_handle = &sync_counter;
+    return (*flambda)(0, &env, cdata);
+  }
+
+  // In case Start() was never explicitly called, call it now to prevent deadlock
+  if (qurt_sem_get_val(&start_semaphore_) == 0) {
+    Start();
+  }
+
+  int num_threads = static_cast<int>(parallel_threads_.size());
+  ParallelJob job;
+  job.flambda = flambda;
+  job.cdata = cdata;
+  job.dynamic = num_task == 0 || num_task > num_threads;
+  job.env.num_task = num_task == 0 ? num_threads * parallel_granularity_ : num_task;
+  job.env.sync_handle = nullptr;
+  if (!job.dynamic) {
+    for (int i = 0; i < num_task; i++) {
+      parallel_sync_[i * kSyncStride].store(0, std::memory_order_relaxed);
+    }
+    job.env.sync_handle = parallel_sync_.get();
+  }
+  int num_participants = std::min(num_threads, job.env.num_task);
+  job.num_active.store(num_participants);
+  qurt_sem_init_val(&job.done, 0);
+
+  for (int i = 0; i < num_participants; i++) {
+    TVMStreamHandle thread = reinterpret_cast<TVMStreamHandle>(parallel_threads_[i]);
+    bool success = Dispatch(thread, thread_parallel, &job);
+    while (!success) {
+      success = Dispatch(thread, thread_parallel, &job);
+    }
+  }
+  qurt_sem_down(&job.done);
+  qurt_sem_destroy(&job.done);
+  parallel_busy_.store(false);
+
+  if (job.has_error.load()) {
+    TVMAPISetLastError(job.error.c_str());
+    return -1;
+  }
+  return 0;
+}
+
+void HexagonThreadManager::thread_parallel(void* job_ptr) {
+  ParallelJob* job = static_cast<ParallelJob*>(job_ptr);
+  int task_id;
+  while ((task_id = job->next_task.fetch_add(1, std::memory_order_relaxed)) <
+         job->env.num_task) {
+    if ((*job->flambda)(task_id, &job->env, job->cdata) != 0 && !job->has_error.exchange(true)) {
+      job->error = TVMGetLastError();
+    }
+    if (!job->dynamic) break;
+  }
+  if (job->num_active.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    qurt_sem_up(&job->done);
+  }
+}
+
 void HexagonThreadManager::CheckSemaphore(unsigned syncID) {
   // We want the success case to be fast, so do not lock the mutex
   if (semaphores_.find(syncID) == semaphores_.end()) {
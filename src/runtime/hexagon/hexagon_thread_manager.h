@@ -20,11 +20,14 @@
 #ifndef TVM_RUNTIME_HEXAGON_HEXAGON_THREAD_MANAGER_H_
 #define TVM_RUNTIME_HEXAGON_HEXAGON_THREAD_MANAGER_H_
 
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -144,6 +147,27 @@ class HexagonThreadManager {
   //! \brief Unblock threads to start execution if `Start` has not already been called; blocking
   //! call to wait until all threads have empty pipes.
   void WaitOnThreads();
+  /*!
+   * \brief Blocking run of a parallel job on the HVX threads, with the contract of
+   * `TVMBackendParallelLaunch`.
+   *
+   * Only the threads holding an HVX instance take part, or all threads when none does. A job
+   * without a task count is split into `granularity` tasks per thread, and the threads claim
+   * the next task from a shared atomic counter as they finish the previous one, so uneven
+   * tasks do not leave HVX contexts idle. A job with no more tasks than threads runs one task
+   * per thread, which keeps `TVMBackendParallelBarrier` working. Nested jobs, and jobs
+   * launched while another one runs, run on the calling thread.
+   * \param flambda The parallel lambda.
+   * \param cdata The closure data of the lambda.
+   * \param num_task The number of tasks, 0 to pick it from the number of threads.
+   * \returns 0 on success, -1 when a task failed.
+   */
+  int ParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task);
+  /*!
+   * \brief Set the number of tasks per thread of the jobs launched without a task count.
+   * \param granularity The number of tasks per thread, at least 1.
+   */
+  void SetParallelGranularity(int granularity);
 
  private:
   struct ThreadContext {
@@ -187,6 +211,27 @@ class HexagonThreadManager {
   //! \brief Void function executed by each thread as `main`.
   static void thread_main(void* context);
 
+  //! \brief A job of `ParallelLaunch`, shared by the threads taking part.
+  struct ParallelJob {
+    FTVMParallelLambda flambda;
+    void* cdata;
+    TVMParallelGroupEnv env;
+    //! \brief Whether the threads claim tasks until none is left, or one task each.
+    bool dynamic;
+    //! \brief The next unclaimed task.
+    std::atomic<int> next_task{0};
+    //! \brief The number of threads which have not left the job.
+    std::atomic<int> num_active{0};
+    std::atomic<bool> has_error{false};
+    //! \brief The error of the first failed task.
+    std::string error;
+    //! \brief Signaled by the last thread leaving the job.
+    qurt_sem_t done;
+  };
+
+  //! \brief Void function executed by a thread to run tasks of a `ParallelJob`.
+  static void thread_parallel(void* job);
+
   //! \brief Manages underlying HexagonBuffer allocations.
   HexagonBufferManager hexbuffs_;
 
@@ -234,6 +279,18 @@ class HexagonThreadManager {
   //! \brief Whether or not resource managers should be created
   bool create_resource_managers_{false};
 
+  //! \brief The threads running the parallel jobs, the HVX threads when there are some.
+  std::vector<unsigned> parallel_threads_;
+
+  //! \brief The number of tasks per thread of the jobs launched without a task count.
+  int parallel_granularity_{4};
+
+  //! \brief Whether a parallel job is running; later jobs run on the calling thread.
+  std::atomic<bool> parallel_busy_{false};
+
+  //! \brief The barrier counters of the one-task-per-thread jobs.
+  std::unique_ptr<std::atomic<int>[]> parallel_sync_;
+
   //! \brief HTP hardware resource.
   // TODO(HWE): Move binding of HTP to a specific thread
   std::unique_ptr<HexagonHtp> htp_;
@@ -18,6 +18,10 @@
  */
 #include "hexagon_vtcm_pool.h"
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+
 #include "HAP_compute_res.h"
 #include "hexagon_common.h"
 
@@ -61,65 +65,137 @@ HexagonVtcmPool::HexagonVtcmPool() {
 
 HexagonVtcmPool::~HexagonVtcmPool() { HEXAGON_SAFE_CALL(HAP_compute_res_release(context_id_)); }
 
+namespace {
+
+constexpr size_t kVtcmFrontAlignment = 0x800;
+constexpr size_t kVtcmMinAlignment = 0x80;
+
+char* AlignUp(char* ptr, size_t alignment) {
+  uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+  return reinterpret_cast<char*>((value + alignment - 1) & ~(alignment - 1));
+}
+
+}  // namespace
+
 void* HexagonVtcmPool::Allocate(size_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::unique_lock<std::mutex> lock(mutex_);
 
-  CHECK(!free_.empty()) << "No free VTCM";
   CHECK(nbytes >= 0x80) << "Minimum VTCM alloation must be 128 bytes - nbytes " << nbytes;
 
-  // If this is not aligned on a 2k block, allocate from the end to avoid fragmentation
-  if (nbytes & size_t(0x7FF)) {
-    DLOG(INFO) << "VTCM nbytes requested: " << nbytes << " allocate from the end";
-    auto last_free_entry = free_.end();
-    last_free_entry--;
-    CHECK(last_free_entry->second >= nbytes)
-        << "Not enough contiguous VTCM space at the end to allocate";
-    char* ptr = last_free_entry->first + (last_free_entry->second - nbytes);
-    allocations_.emplace_back(std::pair<char*, size_t>(ptr, nbytes));
-    last_free_entry->second -= nbytes;
-    if (last_free_entry->second == 0) {
-      free_.erase(last_free_entry);
+  if (!arenas_.empty()) {
+    Arena& arena = arenas_.back();
+    size_t alignment = (nbytes & (kVtcmFrontAlignment - 1)) ? kVtcmMinAlignment
+                                                              : kVtcmFrontAlignment;
+    char* ptr = AlignUp(arena.data + arena.offset, alignment);
+    if (ptr + nbytes <= arena.data + arena.nbytes) {
+      arena.offset = ptr + nbytes - arena.data;
+      arena.num_live++;
+      stats_.num_allocations++;
+      return ptr;
+    }
+    DLOG(INFO) << "VTCM arena of " << arena.nbytes << " bytes is full, allocate " << nbytes
+               << " from the pool";
+  }
+
+  char* ptr = AllocateFromFreeList(nbytes);
+  if (ptr == nullptr && fragmentation_hook_ && FreeBytes() >= nbytes) {
+    std::function<void()> hook = fragmentation_hook_;
+    lock.unlock();
+    hook();
+    lock.lock();
+    ptr = AllocateFromFreeList(nbytes);
+  }
+  if (ptr == nullptr) {
+    size_t free_bytes = FreeBytes();
+    stats_.num_failed_allocations++;
+    if (free_bytes >= nbytes) {
+      stats_.num_fragmented_failures++;
     }
-    // DebugDump();
-    return ptr;
+    CHECK(!free_.empty()) << "No free VTCM";
+    LOG(FATAL) << "Not enough contiguous VTCM space to allocate " << nbytes << " bytes, "
+               << free_bytes << " bytes are free in " << free_.size() << " blocks";
   }
+  allocations_.emplace_back(std::pair<char*, size_t>(ptr, nbytes));
+  stats_.num_allocations++;
+  stats_.used_bytes += nbytes;
+  stats_.peak_used_bytes = std::max(stats_.peak_used_bytes, stats_.used_bytes);
+  // DebugDump();
+  return ptr;
+}
 
-  auto entry_to_allocate = free_.begin();
+char* HexagonVtcmPool::AllocateFromFreeList(size_t nbytes) {
+  // Multiples of 2k are allocated from the front of a block, and other sizes from the back, so
+  // that the small allocations do not break the alignment of the large ones.
+  bool from_front = (nbytes & (kVtcmFrontAlignment - 1)) == 0;
+  auto best = free_.end();
+  char* best_ptr = nullptr;
   for (auto it = free_.begin(); it != free_.end(); it++) {
-    if ((entry_to_allocate->second < nbytes || it->second < entry_to_allocate->second) &&
-        it->second >= nbytes) {
-      entry_to_allocate = it;
-      if (entry_to_allocate->second == nbytes) {
+    char* block_end = it->first + it->second;
+    char* ptr;
+    if (from_front) {
+      ptr = AlignUp(it->first, kVtcmFrontAlignment);
+      if (ptr > block_end || static_cast<size_t>(block_end - ptr) < nbytes) continue;
+    } else {
+      if (it->second < nbytes) continue;
+      ptr = block_end - nbytes;
+    }
+    // The ties go to the first block from the front, and to the last block from the back.
+    if (best == free_.end() || it->second < best->second ||
+        (!from_front && it->second == best->second)) {
+      best = it;
+      best_ptr = ptr;
+      if (from_front && best->second == nbytes) {
         break;
       }
     }
   }
-  CHECK(entry_to_allocate->second >= nbytes) << "Not enough contiguous VTCM space to allocate";
-  char* ptr = entry_to_allocate->first;
-  allocations_.emplace(allocations_.end(), std::pair<char*, size_t>(ptr, nbytes));
+  if (best == free_.end()) {
+    return nullptr;
+  }
 
-  if (entry_to_allocate->second == nbytes) {
-    free_.erase(entry_to_allocate);
+  char* block_begin = best->first;
+  char* block_end = best->first + best->second;
+  char* ptr_end = best_ptr + nbytes;
+  if (best_ptr == block_begin && ptr_end == block_end) {
+    free_.erase(best);
+  } else if (best_ptr == block_begin) {
+    best->first = ptr_end;
+    best->second = block_end - ptr_end;
+  } else if (ptr_end == block_end) {
+    best->second = best_ptr - block_begin;
   } else {
-    entry_to_allocate->first = entry_to_allocate->first + nbytes;
-    entry_to_allocate->second = entry_to_allocate->second - nbytes;
+    // The alignment of the allocation leaves a free block in front of it.
+    best->second = best_ptr - block_begin;
+    free_.emplace(best + 1, std::pair<char*, size_t>(ptr_end, block_end - ptr_end));
   }
-  // DebugDump();
-  return ptr;
+  return best_ptr;
 }
 
 void HexagonVtcmPool::Free(void* ptr, size_t nbytes) {
   char* ptr_to_free = static_cast<char*>(ptr);
   std::lock_guard<std::mutex> lock(mutex_);
 
+  for (auto arena = arenas_.rbegin(); arena != arenas_.rend(); ++arena) {
+    if (ptr_to_free >= arena->data && ptr_to_free + nbytes <= arena->data + arena->nbytes) {
+      CHECK(arena->num_live > 0) << "Attempted to free a pointer of a VTCM arena twice";
+      arena->num_live--;
+      return;
+    }
+  }
+
   auto it = std::find_if(allocations_.begin(), allocations_.end(),
                          [&](auto entry) { return entry.first == ptr_to_free; });
   CHECK(it != allocations_.end()) << "Attempted to free a pointer that had not been allocated";
   CHECK(it->second == nbytes) << "Attempted to free a different size than was allocated";
   allocations_.erase(it);
+  stats_.used_bytes -= nbytes;
+  FreeToFreeList(ptr_to_free, nbytes);
+}
 
-  it = std::lower_bound(free_.begin(), free_.end(), std::pair<char*, size_t>(ptr_to_free, nbytes),
-                        [](auto p, auto q) { return p.first <= q.first; });
+void HexagonVtcmPool::FreeToFreeList(char* ptr_to_free, size_t nbytes) {
+  auto it =
+      std::lower_bound(free_.begin(), free_.end(), std::pair<char*, size_t>(ptr_to_free, nbytes),
+                       [](auto p, auto q) { return p.first <= q.first; });
   if (it == free_.end()) {
     // Insert an entry at the end
     it = free_.emplace(it, std::pair<char*, size_t>(ptr_to_free, nbytes));
@@ -151,6 +227,61 @@ void HexagonVtcmPool::Free(void* ptr, size_t nbytes) {
   // DebugDump();
 }
 
+void HexagonVtcmPool::ArenaBegin(size_t nbytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  nbytes = (nbytes + kVtcmFrontAlignment - 1) & ~(kVtcmFrontAlignment - 1);
+  char* ptr = AllocateFromFreeList(nbytes);
+  if (ptr == nullptr) {
+    stats_.num_failed_allocations++;
+    LOG(FATAL) << "Not enough contiguous VTCM space to open an arena of " << nbytes << " bytes";
+  }
+  arenas_.push_back(Arena{ptr, nbytes, 0, 0});
+  stats_.num_allocations++;
+  stats_.used_bytes += nbytes;
+  stats_.peak_used_bytes = std::max(stats_.peak_used_bytes, stats_.used_bytes);
+}
+
+void HexagonVtcmPool::ArenaEnd() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  CHECK(!arenas_.empty()) << "No VTCM arena is open";
+  Arena arena = arenas_.back();
+  CHECK(arena.num_live == 0) << arena.num_live << " allocations of the VTCM arena are not freed";
+  arenas_.pop_back();
+  stats_.used_bytes -= arena.nbytes;
+  FreeToFreeList(arena.data, arena.nbytes);
+}
+
+void HexagonVtcmPool::SetFragmentationHook(std::function<void()> hook) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  fragmentation_hook_ = std::move(hook);
+}
+
+HexagonVtcmPool::Stats HexagonVtcmPool::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Stats stats = stats_;
+  stats.largest_free_bytes = 0;
+  for (const auto& entry : free_) {
+    stats.largest_free_bytes = std::max(stats.largest_free_bytes, entry.second);
+  }
+  return stats;
+}
+
+void HexagonVtcmPool::ResetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.peak_used_bytes = stats_.used_bytes;
+  stats_.num_allocations = 0;
+  stats_.num_failed_allocations = 0;
+  stats_.num_fragmented_failures = 0;
+}
+
+size_t HexagonVtcmPool::FreeBytes() const {
+  size_t free_bytes = 0;
+  for (const auto& entry : free_) {
+    free_bytes += entry.second;
+  }
+  return free_bytes;
+}
+
 void HexagonVtcmPool::DebugDump() {
   LOG(INFO) << "VTCM list state";
   for (auto entry : allocations_) {
@@ -26,6 +26,8 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <functional>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -35,6 +37,22 @@ namespace hexagon {
 
 class HexagonVtcmPool {
  public:
+  //! \brief Telemetry of the VTCM use
+  struct Stats {
+    //! \brief The bytes currently allocated, open arenas count as a whole
+    size_t used_bytes{0};
+    //! \brief The peak of used_bytes
+    size_t peak_used_bytes{0};
+    //! \brief The size of the largest free block
+    size_t largest_free_bytes{0};
+    //! \brief The number of successful allocations
+    size_t num_allocations{0};
+    //! \brief The number of failed allocations
+    size_t num_failed_allocations{0};
+    //! \brief The failed allocations for which enough VTCM was free, but not contiguous
+    size_t num_fragmented_failures{0};
+  };
+
   //! \brief Allocates all of VTCM memory, and manages allocations from the runtime
   HexagonVtcmPool();
 
@@ -54,6 +72,10 @@ class HexagonVtcmPool {
   HexagonVtcmPool& operator=(HexagonVtcmPool&&) = delete;
 
   /* \brief Allocate memory from the VTCM manager
+   *
+   * The smallest free block which fits is used.  Multiples of 2k are allocated 2k aligned from
+   * the front of the block, other sizes from the back of the block.  While an arena is open,
+   * the allocation is taken from the arena first.
    *
    * \param nbytes The number of bytes to allocate.
    */
@@ -67,6 +89,38 @@ class HexagonVtcmPool {
    */
   void Free(void* ptr, size_t nbytes);
 
+  /* \brief Open an arena which serves the following allocations
+   *
+   * The arena is one contiguous block, which the allocations made until ArenaEnd are taken
+   * from in order, e.g. the scratch buffers of one operator invocation.  Allocations which do
+   * not fit the arena fall back to the pool.  Arenas can be nested.
+   *
+   * \param nbytes The size of the arena.
+   */
+  void ArenaBegin(size_t nbytes);
+
+  /* \brief Close the innermost arena and give its block back to the pool
+   *
+   * All allocations taken from the arena must have been freed.
+   */
+  void ArenaEnd();
+
+  /* \brief Set a hook which is called when an allocation fails from fragmentation
+   *
+   * The hook is called without the lock of the pool held when enough VTCM is free but not
+   * contiguous, so that the owners of VTCM buffers can free or move them.  The allocation is
+   * retried once after the hook returns.
+   *
+   * \param hook The hook, or nullptr to remove it.
+   */
+  void SetFragmentationHook(std::function<void()> hook);
+
+  //! \brief Returns the telemetry of the pool
+  Stats GetStats();
+
+  //! \brief Resets the peak and the counters of the telemetry
+  void ResetStats();
+
   //! \brief Returns the total number of bytes in this pool
   size_t VtcmDeviceBytes() { return reinterpret_cast<size_t>(vtcm_device_size_); }
 
@@ -104,9 +158,35 @@ class HexagonVtcmPool {
   //! \brief List of free segments
   std::vector<std::pair<char*, size_t>> free_;
 
+  //! \brief An open arena, the allocations are taken from its block in order
+  struct Arena {
+    char* data;
+    size_t nbytes;
+    size_t offset;
+    size_t num_live;
+  };
+
+  //! \brief Stack of the open arenas
+  std::vector<Arena> arenas_;
+
+  //! \brief Called when an allocation fails from fragmentation
+  std::function<void()> fragmentation_hook_;
+
+  //! \brief Telemetry of the pool
+  Stats stats_;
+
   //! \brief Mutext to protect access to the lists
   std::mutex mutex_;
 
+  //! \brief Best-fit allocation from the free list, returns nullptr when no block fits
+  char* AllocateFromFreeList(size_t nbytes);
+
+  //! \brief Returns a free block to the free list, merged with its free neighbours
+  void FreeToFreeList(char* ptr, size_t nbytes);
+
+  //! \brief The total number of free bytes
+  size_t FreeBytes() const;
+
   //! \brief Debug only dump of the state of the lists
   void DebugDump();
 };
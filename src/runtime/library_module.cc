@@ -27,10 +27,14 @@
 #include <tvm/runtime/module.h>
 #include <tvm/runtime/registry.h>
 
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "lz4.h"
+
 namespace tvm {
 namespace runtime {
 
@@ -62,6 +66,14 @@ class LibraryModuleNode final : public ModuleNode {
     return packed_func_wrapper_(faddr, sptr_to_self);
   }
 
+  // The address of a symbol, only when its functions are wrapped by the default WrapPackedFunc.
+  TVMBackendPackedCFunc GetBackendPackedCFunc(const String& name) {
+    using FWrapper = PackedFunc (*)(TVMBackendPackedCFunc, const ObjectPtr<Object>&);
+    const FWrapper* wrapper = packed_func_wrapper_.target<FWrapper>();
+    if (wrapper == nullptr || *wrapper != WrapPackedFunc) return nullptr;
+    return reinterpret_cast<TVMBackendPackedCFunc>(lib_->GetSymbol(name.c_str()));
+  }
+
  private:
   ObjectPtr<Library> lib_;
   PackedFuncWrapper packed_func_wrapper_;
@@ -89,6 +101,12 @@ PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>&
   });
 }
 
+TVMBackendPackedCFunc GetBackendPackedCFunc(const Module& mod, const String& name) {
+  if (!mod.defined() || std::string(mod->type_key()) != "library") return nullptr;
+  return static_cast<LibraryModuleNode*>(const_cast<ModuleNode*>(mod.operator->()))
+      ->GetBackendPackedCFunc(name);
+}
+
 void InitContextFunctions(std::function<void*(const char*)> fgetsymbol) {
 #define TVM_INIT_CONTEXT_FUNC(FuncName)                                                \
   if (auto* fp = reinterpret_cast<decltype(&FuncName)*>(fgetsymbol("__" #FuncName))) { \
@@ -102,6 +120,7 @@ void InitContextFunctions(std::function<void*(const char*)> fgetsymbol) {
   TVM_INIT_CONTEXT_FUNC(TVMBackendFreeWorkspace);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelLaunch);
   TVM_INIT_CONTEXT_FUNC(TVMBackendParallelBarrier);
+  TVM_INIT_CONTEXT_FUNC(TVMBackendProfileIntrinsic);
 
 #undef TVM_INIT_CONTEXT_FUNC
 }
@@ -129,6 +148,75 @@ Module LoadModuleFromBinary(const std::string& type_key, dmlc::Stream* stream) {
   return (*f)(static_cast<void*>(stream));
 }
 
+/*!
+ * \brief A module packed into the blob of a library, which is decoded on its first use.
+ *
+ *  Its payload points into the blob, which the library keeps mapped. When the blob lists the names
+ *  of its functions, looking up any other name neither decodes nor initializes the module, so the
+ *  search of a function through the imports of a library only decodes the module defining it.
+ */
+class PackedImportModuleNode final : public ModuleNode {
+ public:
+  PackedImportModuleNode(ObjectPtr<Library> lib, std::string type_key, std::string compression,
+                         uint64_t raw_size, const char* payload, uint64_t payload_size,
+                         const std::vector<std::string>& func_names = {})
+      : lib_(lib),
+        type_key_(type_key),
+        compression_(compression),
+        raw_size_(raw_size),
+        payload_(payload),
+        payload_size_(payload_size),
+        func_names_(func_names.begin(), func_names.end()) {}
+
+  const char* type_key() const final { return type_key_.c_str(); }
+
+  int GetPropertyMask() const final {
+    return ModulePropertyMask::kBinarySerializable | ModulePropertyMask::kRunnable;
+  }
+
+  PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (!func_names_.empty() && !func_names_.count(name)) return PackedFunc();
+    return Decoded().GetFunction(name);
+  }
+
+  void SaveToBinary(dmlc::Stream* stream) final { Decoded()->SaveToBinary(stream); }
+
+  String GetSource(const String& format) final { return Decoded()->GetSource(format); }
+
+  String GetFormat() final { return Decoded()->GetFormat(); }
+
+ private:
+  Module Decoded() {
+    std::lock_guard<std::mutex> lock(decode_mutex_);
+    if (module_.defined()) return module_;
+    std::string bin;
+    if (compression_ == "lz4") {
+      bin.resize(raw_size_);
+      LZ4Decompress(payload_, payload_size_, &bin[0], raw_size_);
+    } else {
+      ICHECK_EQ(compression_, "none") << "Unknown compression of a packed import: " << compression_;
+      bin.assign(payload_, payload_size_);
+    }
+    dmlc::MemoryFixedSizeStream fs(&bin[0], bin.size());
+    module_ = LoadModuleFromBinary(type_key_, &fs);
+    // The imports were attached to this module by the import tree.
+    auto* module_imports = ModuleInternal::GetImportsAddr(module_.operator->());
+    module_imports->insert(module_imports->end(), imports_.begin(), imports_.end());
+    return module_;
+  }
+
+  ObjectPtr<Library> lib_;
+  std::string type_key_;
+  std::string compression_;
+  uint64_t raw_size_;
+  const char* payload_;
+  uint64_t payload_size_;
+  // The names of the functions of the module, empty if unknown.
+  std::unordered_set<std::string> func_names_;
+  std::mutex decode_mutex_;
+  Module module_;
+};
+
 /*!
  * \brief Load and append module blob to module list
  * \param mblob The module blob.
@@ -170,6 +258,23 @@ void ProcessModuleBlob(const char* mblob, ObjectPtr<Library> lib,
     } else if (tkey == "_import_tree") {
       ICHECK(stream->Read(&import_tree_row_ptr));
       ICHECK(stream->Read(&import_tree_child_indices));
+    } else if (tkey == "_packed" || tkey == "_lazy") {
+      std::string type_key, compression;
+      std::vector<std::string> func_names;
+      uint64_t raw_size, payload_size;
+      ICHECK(stream->Read(&type_key));
+      if (tkey == "_lazy") {
+        ICHECK(stream->Read(&func_names));
+      }
+      ICHECK(stream->Read(&compression));
+      ICHECK(stream->Read(&raw_size));
+      ICHECK(stream->Read(&payload_size));
+      size_t offset = fs.Tell();
+      ICHECK_LE(offset + payload_size, nbytes) << "Truncated payload of a packed import";
+      fs.Seek(offset + payload_size);
+      modules.emplace_back(make_object<PackedImportModuleNode>(
+          lib, type_key, compression, raw_size, mblob + sizeof(nbytes) + offset, payload_size,
+          func_names));
     } else {
       auto m = LoadModuleFromBinary(tkey, stream);
       modules.emplace_back(m);
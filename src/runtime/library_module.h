@@ -27,9 +27,11 @@
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/module.h>
+#include <tvm/runtime/packed_func.h>
 
 #include <functional>
 #include <string>
+#include <utility>
 
 namespace tvm {
 namespace runtime {
@@ -72,6 +74,42 @@ class Library : public Object {
  */
 PackedFunc WrapPackedFunc(TVMBackendPackedCFunc faddr, const ObjectPtr<Object>& mptr);
 
+/*!
+ * \brief Get the TVMBackendPackedCFunc behind a function of a library module.
+ *
+ *  Calling the address directly skips the PackedFunc dispatch and the return value
+ *  conversion, see CallBackendPackedCFunc. Only the root module is searched, and only
+ *  when it wraps its functions with WrapPackedFunc.
+ *
+ * \param mod The module.
+ * \param name The name of the function.
+ * \return The function address, nullptr when it is not available.
+ */
+TVMBackendPackedCFunc GetBackendPackedCFunc(const Module& mod, const String& name);
+
+/*!
+ * \brief Call a TVMBackendPackedCFunc with arguments of statically known types.
+ *
+ *  The arguments are packed on the stack as PackedFunc::operator() does, then the
+ *  function is called without going through a PackedFunc. The return value of the
+ *  function is ignored, as generated kernels do not return any.
+ *
+ * \param faddr The function address.
+ * \param args The arguments.
+ */
+template <typename... Args>
+inline void CallBackendPackedCFunc(TVMBackendPackedCFunc faddr, Args&&... args) {
+  const int kNumArgs = sizeof...(Args);
+  const int kArraySize = kNumArgs > 0 ? kNumArgs : 1;
+  TVMValue values[kArraySize];
+  int type_codes[kArraySize];
+  detail::for_each(TVMArgsSetter(values, type_codes), std::forward<Args>(args)...);
+  TVMValue ret_value;
+  int ret_type_code = kTVMNullptr;
+  int ret = (*faddr)(values, type_codes, kNumArgs, &ret_value, &ret_type_code, nullptr);
+  ICHECK_EQ(ret, 0) << TVMGetLastError();
+}
+
 /*!
  * \brief Utility to initialize conext function symbols during startup
  * \param fgetsymbol A symbol lookup function.
@@ -0,0 +1,155 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file lz4.cc
+ * \brief A compressor and decompressor of the LZ4 block format.
+ */
+#include "lz4.h"
+
+#include <tvm/runtime/logging.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+/*! \brief The last bytes of a block are always literals. */
+constexpr size_t kLastLiterals = 5;
+/*! \brief A match starts at least this many bytes before the end of a block. */
+constexpr size_t kMatchStartLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 14;
+
+inline uint32_t Read32(const char* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+void EmitLength(std::string* out, size_t len) {
+  for (; len >= 255; len -= 255) {
+    out->push_back(static_cast<char>(255));
+  }
+  out->push_back(static_cast<char>(len));
+}
+
+// Emit the literals and the match of a sequence, the last sequence has no match.
+void EmitSequence(std::string* out, const char* literals, size_t num_literals, size_t offset,
+                  size_t match_len) {
+  size_t literal_code = std::min<size_t>(num_literals, 15);
+  size_t match_code = match_len != 0 ? std::min<size_t>(match_len - kMinMatch, 15) : 0;
+  out->push_back(static_cast<char>((literal_code << 4) | match_code));
+  if (num_literals >= 15) EmitLength(out, num_literals - 15);
+  out->append(literals, num_literals);
+  if (match_len == 0) return;
+  out->push_back(static_cast<char>(offset & 0xff));
+  out->push_back(static_cast<char>((offset >> 8) & 0xff));
+  if (match_len - kMinMatch >= 15) EmitLength(out, match_len - kMinMatch - 15);
+}
+
+}  // namespace
+
+std::string LZ4Compress(const char* data, size_t size) {
+  std::string out;
+  out.reserve(size + size / 255 + 16);
+  size_t anchor = 0;
+  if (size > kMatchStartLimit) {
+    std::vector<int64_t> table(1 << kHashBits, -1);
+    size_t match_limit = size - kLastLiterals;
+    size_t i = 0;
+    while (i + kMatchStartLimit < size) {
+      uint32_t seq = Read32(data + i);
+      uint32_t hash = (seq * 2654435761U) >> (32 - kHashBits);
+      int64_t ref = table[hash];
+      table[hash] = static_cast<int64_t>(i);
+      if (ref >= 0 && i - ref <= kMaxOffset && Read32(data + ref) == seq) {
+        size_t len = kMinMatch;
+        while (i + len < match_limit && data[ref + len] == data[i + len]) {
+          ++len;
+        }
+        EmitSequence(&out, data + anchor, i - anchor, i - ref, len);
+        i += len;
+        anchor = i;
+      } else {
+        ++i;
+      }
+    }
+  }
+  EmitSequence(&out, data + anchor, size - anchor, 0, 0);
+  return out;
+}
+
+void LZ4Decompress(const char* src, size_t src_size, char* dst, size_t dst_size) {
+  const uint8_t* ip = reinterpret_cast<const uint8_t*>(src);
+  const uint8_t* iend = ip + src_size;
+  uint8_t* op = reinterpret_cast<uint8_t*>(dst);
+  uint8_t* ostart = op;
+  uint8_t* oend = op + dst_size;
+  auto read_length = [&](size_t len) {
+    if (len == 15) {
+      uint8_t byte;
+      do {
+        ICHECK(ip < iend) << "Corrupted LZ4 block, truncated length";
+        byte = *ip++;
+        len += byte;
+      } while (byte == 255);
+    }
+    return len;
+  };
+  while (true) {
+    ICHECK(ip < iend) << "Corrupted LZ4 block, missing the last literals";
+    uint8_t token = *ip++;
+    size_t num_literals = read_length(token >> 4);
+    ICHECK(num_literals <= static_cast<size_t>(iend - ip) &&
+           num_literals <= static_cast<size_t>(oend - op))
+        << "Corrupted LZ4 block, literals out of bounds";
+    std::memcpy(op, ip, num_literals);
+    ip += num_literals;
+    op += num_literals;
+    if (ip == iend) break;
+    ICHECK_GE(iend - ip, 2) << "Corrupted LZ4 block, truncated offset";
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    ICHECK(offset != 0 && offset <= static_cast<size_t>(op - ostart))
+        << "Corrupted LZ4 block, offset out of bounds";
+    size_t match_len = read_length(token & 15) + kMinMatch;
+    ICHECK(match_len <= static_cast<size_t>(oend - op))
+        << "Corrupted LZ4 block, match out of bounds";
+    const uint8_t* match = op - offset;
+    if (offset >= match_len) {
+      std::memcpy(op, match, match_len);
+    } else {
+      // The match overlaps the output, copy byte by byte to repeat the pattern.
+      for (size_t k = 0; k < match_len; ++k) op[k] = match[k];
+    }
+    op += match_len;
+  }
+  ICHECK(op == oend) << "Corrupted LZ4 block, decompressed " << (op - ostart) << " bytes but "
+                     << dst_size << " bytes are expected";
+}
+
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file lz4.h
+ * \brief A compressor and decompressor of the LZ4 block format, used for the packed imports.
+ *
+ *  The compressor is a greedy single hash match finder, which trades ratio for a small and fast
+ *  implementation. Any block in the LZ4 block format can be decompressed.
+ */
+#ifndef TVM_RUNTIME_LZ4_H_
+#define TVM_RUNTIME_LZ4_H_
+
+#include <cstddef>
+#include <string>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief Compress bytes into an LZ4 block.
+ * \param data The bytes to compress.
+ * \param size The number of bytes.
+ * \return The compressed block, the size of the input is not recorded.
+ */
+std::string LZ4Compress(const char* data, size_t size);
+
+/*!
+ * \brief Decompress an LZ4 block, a corrupted block is a fatal error.
+ * \param src The compressed block.
+ * \param src_size The size of the compressed block.
+ * \param dst The output, which needs room for dst_size bytes.
+ * \param dst_size The size of the decompressed data.
+ */
+void LZ4Decompress(const char* src, size_t src_size, char* dst, size_t dst_size);
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_LZ4_H_
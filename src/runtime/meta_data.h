@@ -77,6 +77,17 @@ struct FunctionInfo {
   void Save(dmlc::Stream* writer) const;
   bool Load(dmlc::Stream* reader);
 };
+
+/*!
+ * \brief Create the "get_func_names" function of a device module, which lists its kernels and
+ *  \p extra_names. A library packing the module lazily decodes it only when one of them is used.
+ * \param fmap The kernels of the module.
+ * \param sptr_to_self The module.
+ * \param extra_names The names of the other functions of the module.
+ */
+PackedFunc GetFuncNamesFunc(const std::unordered_map<std::string, FunctionInfo>& fmap,
+                            const ObjectPtr<Object>& sptr_to_self,
+                            std::vector<std::string> extra_names = {});
 }  // namespace runtime
 }  // namespace tvm
 
@@ -28,13 +28,17 @@
 #import <Metal/MTLBuffer.h>
 #import <Metal/MTLCommandBuffer.h>
 #import <Metal/MTLCommandQueue.h>
+#import <Metal/MTLComputeCommandEncoder.h>
 #import <Metal/MTLDevice.h>
 #import <Metal/MTLLibrary.h>
+#include <dispatch/dispatch.h>
 #include <tvm/runtime/c_runtime_api.h>
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -102,29 +106,53 @@ class AutoReleasePoolWrapper {
 };
 
 /*!
- * \brief Structure for error handling in queues
+ * \brief A Metal command queue that batches the work issued to it.
+ *
+ *  Kernel dispatches and blits are encoded into one open command buffer, which is committed once
+ *  it holds TVM_METAL_MAX_DISPATCHES_PER_BUFFER dispatches (64 by default), or when the stream is
+ *  flushed or synchronized. At most TVM_METAL_MAX_INFLIGHT_BUFFERS committed buffers (3 by
+ *  default) are in flight at once, so the host encodes the next buffer while the GPU executes
+ *  the previous ones, and blocks only when it runs that far ahead.
  */
 class Stream {
  public:
-  explicit Stream(id<MTLDevice> device) : error_happened_(false) {
-    queue_ = [device newCommandQueue];
-  }
-  ~Stream() { [queue_ release]; }
-  id<MTLCommandBuffer> GetCommandBuffer() {
-    id<MTLCommandBuffer> cb = [queue_ commandBuffer];
-    [cb addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
-      if (buffer.status == MTLCommandBufferStatusError) SetErrorStatus();
-    }];
-    return cb;
-  }
+  explicit Stream(id<MTLDevice> device);
+  ~Stream();
+  /*! \brief Encode a kernel dispatch into the open command buffer. */
+  void EncodeDispatch(const std::function<void(id<MTLComputeCommandEncoder>)>& encode);
+  /*! \brief Encode a blit into the open command buffer. */
+  void EncodeBlit(const std::function<void(id<MTLBlitCommandEncoder>)>& encode);
+  /*! \brief Commit the open command buffer, without waiting for it. */
+  void Flush();
+  /*! \brief Commit the open command buffer and wait until the work of the stream completed. */
+  void Synchronize();
   bool HasErrorHappened() { return error_happened_; }
 
  private:
-  void SetErrorStatus() { error_happened_ = true; }
+  /*! \return The open command buffer, created on first use. Requires mutex_. */
+  id<MTLCommandBuffer> GetCommandBuffer();
+  /*! \brief End the open compute encoder, if any. Requires mutex_. */
+  void EndComputeEncoder();
+  /*! \brief Commit the open command buffer, if any. Requires mutex_. */
+  void Commit();
+
   // Queue
   id<MTLCommandQueue> queue_;
+  // Guards the open command buffer, the stream may be shared by threads
+  std::mutex mutex_;
+  // The open command buffer and its compute encoder, retained
+  id<MTLCommandBuffer> pending_{nil};
+  id<MTLComputeCommandEncoder> compute_encoder_{nil};
+  // Number of dispatches encoded into the open command buffer
+  int num_dispatches_{0};
+  int max_dispatches_;
+  int max_inflight_;
+  // Counts the command buffers that may still be committed
+  dispatch_semaphore_t inflight_;
+  // The last committed command buffer, retained
+  id<MTLCommandBuffer> last_committed_{nil};
   // Check if error happened in one previous run
-  bool error_happened_;
+  std::atomic<bool> error_happened_{false};
 };
 
 /*!
@@ -21,7 +21,12 @@
  * \file metal_device_api.mm
  */
 #include <dmlc/thread_local.h>
+#include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <cstdlib>
+
 #include "metal_common.h"
 
 namespace tvm {
@@ -33,6 +38,105 @@ AutoReleasePoolWrapper& AutoReleasePoolWrapper::GetInstance() {
   return instance;
 }
 
+namespace {
+/*! \return The positive value of the environment variable \p name, or \p default_value. */
+int GetEnvPositive(const char* name, int default_value) {
+  const char* val = getenv(name);
+  return val != nullptr ? std::max(atoi(val), 1) : default_value;
+}
+}  // namespace
+
+Stream::Stream(id<MTLDevice> device) {
+  queue_ = [device newCommandQueue];
+  max_dispatches_ = GetEnvPositive("TVM_METAL_MAX_DISPATCHES_PER_BUFFER", 64);
+  max_inflight_ = GetEnvPositive("TVM_METAL_MAX_INFLIGHT_BUFFERS", 3);
+  inflight_ = dispatch_semaphore_create(max_inflight_);
+}
+
+Stream::~Stream() {
+  AUTORELEASEPOOL {
+    Synchronize();
+    // The completed handlers signal the semaphore last, wait until none of them runs.
+    for (int i = 0; i < max_inflight_; ++i) {
+      dispatch_semaphore_wait(inflight_, DISPATCH_TIME_FOREVER);
+    }
+    for (int i = 0; i < max_inflight_; ++i) {
+      dispatch_semaphore_signal(inflight_);
+    }
+  };
+  [last_committed_ release];
+  dispatch_release(inflight_);
+  [queue_ release];
+}
+
+id<MTLCommandBuffer> Stream::GetCommandBuffer() {
+  if (pending_ == nil) {
+    pending_ = [[queue_ commandBuffer] retain];
+  }
+  return pending_;
+}
+
+void Stream::EndComputeEncoder() {
+  if (compute_encoder_ != nil) {
+    [compute_encoder_ endEncoding];
+    [compute_encoder_ release];
+    compute_encoder_ = nil;
+  }
+}
+
+void Stream::Commit() {
+  if (pending_ == nil) return;
+  EndComputeEncoder();
+  // Block the host once it runs max_inflight_ command buffers ahead of the GPU.
+  dispatch_semaphore_wait(inflight_, DISPATCH_TIME_FOREVER);
+  dispatch_semaphore_t inflight = inflight_;
+  std::atomic<bool>* error_happened = &error_happened_;
+  [pending_ addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+    if (buffer.status == MTLCommandBufferStatusError) error_happened->store(true);
+    dispatch_semaphore_signal(inflight);
+  }];
+  [pending_ commit];
+  [last_committed_ release];
+  last_committed_ = pending_;
+  pending_ = nil;
+  num_dispatches_ = 0;
+}
+
+void Stream::EncodeDispatch(const std::function<void(id<MTLComputeCommandEncoder>)>& encode) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (compute_encoder_ == nil) {
+    // Serial dispatch, a kernel sees the writes of the kernels encoded before it.
+    compute_encoder_ = [[GetCommandBuffer() computeCommandEncoder] retain];
+  }
+  encode(compute_encoder_);
+  if (++num_dispatches_ >= max_dispatches_) Commit();
+}
+
+void Stream::EncodeBlit(const std::function<void(id<MTLBlitCommandEncoder>)>& encode) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EndComputeEncoder();
+  id<MTLBlitCommandEncoder> encoder = [GetCommandBuffer() blitCommandEncoder];
+  encode(encoder);
+  [encoder endEncoding];
+}
+
+void Stream::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Commit();
+}
+
+void Stream::Synchronize() {
+  id<MTLCommandBuffer> last;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Commit();
+    last = [last_committed_ retain];
+  }
+  // The command buffers of a queue complete in commit order.
+  [last waitUntilCompleted];
+  [last release];
+}
+
 MetalWorkspace* MetalWorkspace::Global() {
   // NOTE: explicitly use new to avoid exit-time destruction of global state
   // Global state will be recycled by OS as the process exits.
@@ -179,15 +283,15 @@ void* MetalWorkspace::AllocDataSpace(Device device, size_t nbytes, size_t alignm
   AUTORELEASEPOOL {
     this->Init();
     id<MTLDevice> dev = GetDevice(device);
-    // GPU memory only
+    // On unified memory the host accesses shared buffers without staging copies, see HostView.
+    static const bool use_shared = []() {
+      const char* val = getenv("TVM_METAL_SHARED_STORAGE");
+      return val == nullptr || atoi(val) != 0;
+    }();
     MTLResourceOptions storage_mode = MTLResourceStorageModePrivate;
-    /*
-    #if TARGET_OS_IPHONE
-    storage_mode = MTLResourceStorageModeShared;
-    #else
-    storage_mode = MTLResourceStorageModeManaged;
-    #endif
-    */
+    if (use_shared && dev.hasUnifiedMemory) {
+      storage_mode = MTLResourceStorageModeShared;
+    }
     buf = [dev newBufferWithLength:nbytes options:storage_mode];
     ICHECK(buf != nil);
   };
@@ -225,35 +329,35 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
     if (s->HasErrorHappened()) {
       LOG(FATAL) << "Error! Some problems on GPU happaned! Cannot copy data to current stream";
     }
-    id<MTLCommandBuffer> cb = s->GetCommandBuffer();
     int from_dev_type = static_cast<int>(dev_from.device_type);
     int to_dev_type = static_cast<int>(dev_to.device_type);
 
     if (from_dev_type == kDLMetal && to_dev_type == kDLMetal) {
       ICHECK_EQ(dev_from.device_id, dev_to.device_id) << "Metal disallow cross device copy.";
-      id<MTLBlitCommandEncoder> encoder = [cb blitCommandEncoder];
-      [encoder copyFromBuffer:(id<MTLBuffer>)(from)
-                 sourceOffset:from_offset
-                     toBuffer:(id<MTLBuffer>)(to)destinationOffset:to_offset
-                         size:size];
-      [encoder endEncoding];
-      [cb commit];
+      // Ordered with the kernels of the stream, no need to wait.
+      s->EncodeBlit([&](id<MTLBlitCommandEncoder> encoder) {
+        [encoder copyFromBuffer:(id<MTLBuffer>)(from)
+                   sourceOffset:from_offset
+                       toBuffer:(id<MTLBuffer>)(to)destinationOffset:to_offset
+                           size:size];
+      });
     } else if (from_dev_type == kDLMetal && to_dev_type == kDLCPU) {
       // copy to a local buffer before get into global buffer.
       id<MTLBuffer> from_buf = (id<MTLBuffer>)(from);
       if (from_buf.storageMode != MTLStorageModeShared) {
         id<MTLBuffer> temp = MetalThreadEntry::ThreadLocal()->GetTempBuffer(dev_from, size);
-        id<MTLBlitCommandEncoder> encoder = [cb blitCommandEncoder];
-        [encoder copyFromBuffer:from_buf
-                   sourceOffset:from_offset
-                       toBuffer:temp
-              destinationOffset:0
-                           size:size];
-        [encoder endEncoding];
-        [cb commit];
-        [cb waitUntilCompleted];
+        s->EncodeBlit([&](id<MTLBlitCommandEncoder> encoder) {
+          [encoder copyFromBuffer:from_buf
+                     sourceOffset:from_offset
+                         toBuffer:temp
+                destinationOffset:0
+                             size:size];
+        });
+        s->Synchronize();
         memcpy(static_cast<char*>(to) + to_offset, static_cast<char*>([temp contents]), size);
       } else {
+        // Wait for the kernels writing the buffer.
+        s->Synchronize();
         memcpy(static_cast<char*>(to) + to_offset,
                static_cast<char*>([from_buf contents]) + from_offset, size);
       }
@@ -262,16 +366,18 @@ void MetalWorkspace::CopyDataFromTo(const void* from, size_t from_offset, void*
       if (to_buf.storageMode != MTLStorageModeShared) {
         id<MTLBuffer> temp = MetalThreadEntry::ThreadLocal()->GetTempBuffer(dev_to, size);
         memcpy([temp contents], static_cast<const char*>(from) + from_offset, size);
-        id<MTLBlitCommandEncoder> encoder = [cb blitCommandEncoder];
-        [encoder copyFromBuffer:temp
-                   sourceOffset:0
-                       toBuffer:to_buf
-              destinationOffset:to_offset
-                           size:size];
-        [encoder endEncoding];
-        [cb commit];
-        [cb waitUntilCompleted];
+        s->EncodeBlit([&](id<MTLBlitCommandEncoder> encoder) {
+          [encoder copyFromBuffer:temp
+                     sourceOffset:0
+                         toBuffer:to_buf
+                destinationOffset:to_offset
+                             size:size];
+        });
+        // The temp buffer is reused by the next copy.
+        s->Synchronize();
       } else {
+        // Wait for the kernels still accessing the buffer.
+        s->Synchronize();
         memcpy(static_cast<char*>([to_buf contents]) + to_offset,
                static_cast<const char*>(from) + from_offset, size);
       }
@@ -300,10 +406,8 @@ void MetalWorkspace::FreeStream(Device dev, TVMStreamHandle stream) {
 void MetalWorkspace::StreamSync(Device dev, TVMStreamHandle stream) {
   AUTORELEASEPOOL {
     Stream* s = CastStreamOrGetCurrent(stream, dev.device_id);
-    // commit an empty command buffer and wait until it completes.
-    id<MTLCommandBuffer> cb = s->GetCommandBuffer();
-    [cb commit];
-    [cb waitUntilCompleted];
+    // commit the batched work and wait until it completes.
+    s->Synchronize();
     if (s->HasErrorHappened()) {
       LOG(FATAL) << "Error! Some problems on GPU happaned!";
     }
@@ -361,6 +465,23 @@ TVM_REGISTER_GLOBAL("device_api.metal").set_body([](TVMArgs args, TVMRetValue* r
   *rv = static_cast<void*>(ptr);
 });
 
+/*!
+ * \brief Return a CPU array aliasing the memory of a Metal array in shared storage, after the
+ *  work of the current stream completed. The view holds the Metal array.
+ */
+TVM_REGISTER_GLOBAL("metal.HostView").set_body_typed([](NDArray arr) {
+  ICHECK_EQ(arr->device.device_type, kDLMetal) << "Expect a Metal array";
+  id<MTLBuffer> buf = (id<MTLBuffer>)(arr->data);
+  ICHECK(buf.storageMode == MTLStorageModeShared)
+      << "Only arrays in shared storage have a host view, see TVM_METAL_SHARED_STORAGE";
+  MetalWorkspace::Global()->StreamSync(arr->device, nullptr);
+  DLManagedTensor* view = arr.ToDLPack();
+  view->dl_tensor.data = static_cast<char*>([buf contents]) + arr->byte_offset;
+  view->dl_tensor.byte_offset = 0;
+  view->dl_tensor.device = Device{kDLCPU, 0};
+  return NDArray::FromDLPack(view);
+});
+
 TVM_REGISTER_GLOBAL("metal.ResetGlobalState").set_body_typed([]() {
   MetalWorkspace::Global()->ReinitializeStreams();
 });
@@ -200,24 +200,24 @@ class MetalWrappedFunc {
       int blockSize = wl.block_dim(0) * wl.block_dim(1) * wl.block_dim(2);
       auto maxTotalThreadsPerThreadgroup = scache_[device_id].maxTotalThreadsPerThreadgroup;
       CHECK_LE(blockSize, maxTotalThreadsPerThreadgroup);
-      id<MTLCommandBuffer> cb = stream->GetCommandBuffer();
-      id<MTLComputeCommandEncoder> encoder = [cb computeCommandEncoder];
-      [encoder setComputePipelineState:scache_[device_id]];
-      for (size_t i = 0; i < num_buffer_args_; ++i) {
-        void* buf = args[static_cast<int>(i)];
-        [encoder setBuffer:(id<MTLBuffer>)(buf) offset:0 atIndex:i];
-      }
-      if (num_pack_args_ != 0) {
-        [encoder setBytes:pack_args
-                   length:num_pack_args_ * sizeof(ArgUnion64)
-                  atIndex:num_buffer_args_];
-      }
-      // launch
-      MTLSize dimGrid = MTLSizeMake(wl.grid_dim(0), wl.grid_dim(1), wl.grid_dim(2));
-      MTLSize dimBlock = MTLSizeMake(wl.block_dim(0), wl.block_dim(1), wl.block_dim(2));
-      [encoder dispatchThreadgroups:dimGrid threadsPerThreadgroup:dimBlock];
-      [encoder endEncoding];
-      [cb commit];
+      id<MTLComputePipelineState> state = scache_[device_id];
+      // Batched with the other dispatches of the stream, committed when full or synchronized.
+      stream->EncodeDispatch([&](id<MTLComputeCommandEncoder> encoder) {
+        [encoder setComputePipelineState:state];
+        for (size_t i = 0; i < num_buffer_args_; ++i) {
+          void* buf = args[static_cast<int>(i)];
+          [encoder setBuffer:(id<MTLBuffer>)(buf) offset:0 atIndex:i];
+        }
+        if (num_pack_args_ != 0) {
+          [encoder setBytes:pack_args
+                     length:num_pack_args_ * sizeof(ArgUnion64)
+                    atIndex:num_buffer_args_];
+        }
+        // launch
+        MTLSize dimGrid = MTLSizeMake(wl.grid_dim(0), wl.grid_dim(1), wl.grid_dim(2));
+        MTLSize dimBlock = MTLSizeMake(wl.block_dim(0), wl.block_dim(1), wl.block_dim(2));
+        [encoder dispatchThreadgroups:dimGrid threadsPerThreadgroup:dimBlock];
+      });
     };
   }
 
@@ -246,6 +246,10 @@ PackedFunc MetalModuleNode::GetFunction(const String& name, const ObjectPtr<Obje
   AUTORELEASEPOOL {
     ICHECK_EQ(sptr_to_self.get(), this);
     ICHECK_NE(name, symbol::tvm_module_main) << "Device function do not have main";
+    if (name == "get_func_names") {
+      pf = GetFuncNamesFunc(fmap_, sptr_to_self);
+      return;
+    }
     auto it = fmap_.find(name);
     if (it == fmap_.end()) {
       pf = PackedFunc();
@@ -47,31 +47,46 @@ namespace tvm {
 namespace runtime {
 namespace micro_rpc {
 
+/*!
+ * \brief Writes to the transport through fsend.
+ *
+ *  The Framer emits a packet in small escaped pieces. They are collected until Flush(), so that
+ *  every packet costs a single transport write rather than one per piece.
+ */
 class CallbackWriteStream : public WriteStream {
  public:
   explicit CallbackWriteStream(PackedFunc fsend, ::std::chrono::microseconds write_timeout)
       : fsend_{fsend}, write_timeout_{write_timeout} {}
 
   ssize_t Write(const uint8_t* data, size_t data_size_bytes) override {
+    pending_.append(reinterpret_cast<const char*>(data), data_size_bytes);
+    return static_cast<ssize_t>(data_size_bytes);
+  }
+
+  void PacketDone(bool is_valid) override {}
+
+  /*! \brief Send the data written since the last flush. */
+  void Flush() {
+    if (pending_.empty()) {
+      return;
+    }
     TVMByteArray bytes;
-    bytes.data = (const char*)data;
-    bytes.size = data_size_bytes;
+    bytes.data = pending_.data();
+    bytes.size = pending_.size();
     if (write_timeout_ == ::std::chrono::microseconds::zero()) {
       fsend_(bytes, nullptr);
     } else {
       fsend_(bytes, write_timeout_.count());
     }
-
-    return static_cast<ssize_t>(data_size_bytes);
+    pending_.clear();
   }
 
-  void PacketDone(bool is_valid) override {}
-
   void SetWriteTimeout(::std::chrono::microseconds timeout) { write_timeout_ = timeout; }
 
  private:
   PackedFunc fsend_;
   ::std::chrono::microseconds write_timeout_;
+  ::std::string pending_;
 };
 
 class MicroTransportChannel : public RPCChannel {
@@ -107,7 +122,8 @@ class MicroTransportChannel : public RPCChannel {
         session_established_timeout_{session_established_timeout},
         write_stream_{fsend, session_start_timeout},
         framer_{&write_stream_},
-        receive_buffer_{new uint8_t[TVM_CRT_MAX_PACKET_SIZE_BYTES], TVM_CRT_MAX_PACKET_SIZE_BYTES},
+        receive_storage_{new uint8_t[TVM_CRT_MAX_PACKET_SIZE_BYTES]},
+        receive_buffer_{receive_storage_.get(), TVM_CRT_MAX_PACKET_SIZE_BYTES},
         session_{&framer_, &receive_buffer_, &HandleMessageReceivedCb, this},
         unframer_{session_.Receiver()},
         did_receive_message_{false},
@@ -141,7 +157,10 @@ class MicroTransportChannel : public RPCChannel {
       end_time += *timeout;
     }
     for (;;) {
-      if (ConsumeReceivedPayload(pf)) {
+      bool done = ConsumeReceivedPayload(pf);
+      // Send the session replies written while processing the received data.
+      write_stream_.Flush();
+      if (done) {
         return true;
       }
 
@@ -204,6 +223,7 @@ class MicroTransportChannel : public RPCChannel {
     steady_clock::time_point start_time = steady_clock::now();
     ICHECK_EQ(kTvmErrorNoError, session_.Initialize(GenerateRandomNonce()));
     ICHECK_EQ(kTvmErrorNoError, session_.StartSession());
+    write_stream_.Flush();
 
     if (session_start_timeout_ == microseconds::zero() &&
         session_start_retry_timeout_ == microseconds::zero()) {
@@ -235,6 +255,7 @@ class MicroTransportChannel : public RPCChannel {
 
       ICHECK_EQ(kTvmErrorNoError, session_.Initialize(GenerateRandomNonce()));
       ICHECK_EQ(kTvmErrorNoError, session_.StartSession());
+      write_stream_.Flush();
     }
 
     return true;
@@ -248,15 +269,21 @@ class MicroTransportChannel : public RPCChannel {
     bool to_return = StartSessionInternal();
     if (to_return) {
       write_stream_.SetWriteTimeout(session_established_timeout_);
+      ResizeReceiveBuffer(session_.PeerMaxPacketSizeBytes());
     }
 
     return to_return;
   }
 
   size_t Send(const void* data, size_t size) override {
+    size_t peer_max_packet_size = session_.PeerMaxPacketSizeBytes();
+    ICHECK(peer_max_packet_size == 0 || size + sizeof(SessionHeader) <= peer_max_packet_size)
+        << "MicroSession: a " << size << " byte message does not fit in the "
+        << peer_max_packet_size << " byte receive buffer of the remote";
     const uint8_t* data_bytes = static_cast<const uint8_t*>(data);
     tvm_crt_error_t err = session_.SendMessage(MessageType::kNormal, data_bytes, size);
     ICHECK(err == kTvmErrorNoError) << "SendMessage returned " << err;
+    write_stream_.Flush();
 
     return size;
   }
@@ -305,6 +332,23 @@ class MicroTransportChannel : public RPCChannel {
   }
 
  private:
+  /*!
+   * \brief Grow the receive buffer to hold the largest packet of the remote.
+   *
+   *  The remote sizes its replies after its own packets, e.g. a CopyFromRemote block, so a
+   *  device configured with larger packets than this host gets a matching buffer here. Called
+   *  after the session start, when no message is buffered.
+   *
+   * \param max_packet_size_bytes The receive capacity advertised by the remote, 0 if unknown.
+   */
+  void ResizeReceiveBuffer(size_t max_packet_size_bytes) {
+    if (max_packet_size_bytes <= receive_buffer_.Capacity()) {
+      return;
+    }
+    receive_storage_.reset(new uint8_t[max_packet_size_bytes]);
+    receive_buffer_ = FrameBuffer{receive_storage_.get(), max_packet_size_bytes};
+  }
+
   /*!
    * \brief Consume the entire received payload, unless the pf condition is met halfway through.
    *
@@ -391,6 +435,7 @@ class MicroTransportChannel : public RPCChannel {
   ::std::chrono::microseconds session_established_timeout_;
   CallbackWriteStream write_stream_;
   Framer framer_;
+  std::unique_ptr<uint8_t[]> receive_storage_;
   FrameBuffer receive_buffer_;
   Session session_;
   Unframer unframer_;
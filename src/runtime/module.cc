@@ -27,6 +27,7 @@
 
 #include <cstring>
 #include <unordered_set>
+#include <vector>
 
 #include "file_utils.h"
 
@@ -171,6 +172,33 @@ bool RuntimeEnabled(const String& target_str) {
   return runtime::Registry::Get(f_name) != nullptr;
 }
 
+void PreloadModule(Module mod, Device dev) {
+  std::unordered_set<const ModuleNode*> visited{mod.operator->()};
+  std::vector<Module> stack{mod};
+  while (!stack.empty()) {
+    Module m = stack.back();
+    stack.pop_back();
+    PackedFunc preload = m.GetFunction(symbol::tvm_module_preload);
+    if (preload != nullptr) {
+      preload(dev);
+    }
+    for (Module import : m->imports()) {
+      // Resolve the functions of the import as TVMBackendGetFuncFromEnv would on their first
+      // call, so those calls hit the cache of the importing module.
+      PackedFunc get_func_names = import.GetFunction("get_func_names");
+      if (get_func_names != nullptr) {
+        Array<String> names = get_func_names();
+        for (const String& name : names) {
+          m->GetFuncFromEnv(name);
+        }
+      }
+      if (visited.insert(import.operator->()).second) {
+        stack.push_back(import);
+      }
+    }
+  }
+}
+
 TVM_REGISTER_GLOBAL("runtime.RuntimeEnabled").set_body_typed(RuntimeEnabled);
 
 TVM_REGISTER_GLOBAL("runtime.ModuleGetSource").set_body_typed([](Module mod, std::string fmt) {
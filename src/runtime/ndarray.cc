@@ -27,6 +27,7 @@
 #include <tvm/runtime/ndarray.h>
 #include <tvm/runtime/registry.h>
 
+#include "float_convert.h"
 #include "runtime_base.h"
 
 extern "C" {
@@ -220,6 +221,23 @@ NDArray NDArray::CreateView(ShapeTuple shape, DLDataType dtype) {
 
 DLManagedTensor* NDArray::ToDLPack() const { return Internal::ToDLPack(get_mutable()); }
 
+/*!
+ * \brief Order the work submitted to the stream src before the work later submitted to the stream
+ *  dst, with an event so that the host does not wait.
+ */
+static void OrderStreams(Device dev, TVMStreamHandle src, TVMStreamHandle dst) {
+  if (src == dst) return;
+  DeviceAPI::Get(dev)->SyncStreamFromTo(dev, src, dst);
+}
+
+DLManagedTensor* NDArray::ToDLPack(TVMStreamHandle consumer_stream) const {
+  Device dev = get_mutable()->dl_tensor.device;
+  if (dev.device_type != kDLCPU) {
+    OrderStreams(dev, DeviceAPI::Get(dev)->GetCurrentStream(dev), consumer_stream);
+  }
+  return ToDLPack();
+}
+
 NDArray NDArray::Empty(ShapeTuple shape, DLDataType dtype, Device dev, Optional<String> mem_scope) {
   NDArray ret = Internal::Create(shape, dtype, dev);
   ret.get_mutable()->dl_tensor.data =
@@ -256,6 +274,14 @@ NDArray NDArray::NewFromDLTensor(DLTensor* tensor, const Device& dev) {
   return ary;
 }
 
+NDArray NDArray::FromDLPack(DLManagedTensor* tensor, TVMStreamHandle producer_stream) {
+  Device dev = tensor->dl_tensor.device;
+  if (dev.device_type != kDLCPU) {
+    OrderStreams(dev, producer_stream, DeviceAPI::Get(dev)->GetCurrentStream(dev));
+  }
+  return FromDLPack(tensor);
+}
+
 NDArray NDArray::FromDLPack(DLManagedTensor* tensor) {
   NDArray::Container* data = new NDArray::Container();
   // construct header
@@ -287,7 +313,48 @@ void NDArray::CopyFromBytes(const void* data, size_t nbytes) {
   ArrayCopyFromBytes(&get_mutable()->dl_tensor, data, nbytes);
 }
 
+/*!
+ * \brief Copy between arrays of float dtypes converted by ConvertFloatArray, through host
+ *  copies of the arrays which are not on the CPU.
+ */
+static void ConvertFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle stream) {
+  ICHECK(IsContiguous(*from) && IsContiguous(*to)) << "Can only convert contiguous arrays";
+  int64_t num_elems = 1;
+  for (int i = 0; i < from->ndim; ++i) num_elems *= from->shape[i];
+  int64_t to_num_elems = 1;
+  for (int i = 0; i < to->ndim; ++i) to_num_elems *= to->shape[i];
+  ICHECK_EQ(num_elems, to_num_elems) << "TVMArrayCopyFromTo: The number of elements must match";
+
+  auto host_copy = [](const DLTensor* t) {
+    return NDArray::Empty(ShapeTuple(t->shape, t->shape + t->ndim), t->dtype, {kDLCPU, 0});
+  };
+  NDArray host_from, host_to;
+  const DLTensor* src = from;
+  DLTensor* dst = to;
+  if (from->device.device_type != kDLCPU) {
+    host_from = host_copy(from);
+    src = host_from.operator->();
+    NDArray::CopyFromTo(from, const_cast<DLTensor*>(src), stream);
+    DeviceAPI::Get(from->device)->StreamSync(from->device, stream);
+  }
+  if (to->device.device_type != kDLCPU) {
+    host_to = host_copy(to);
+    dst = const_cast<DLTensor*>(host_to.operator->());
+  }
+  ConvertFloatArray(static_cast<const char*>(src->data) + src->byte_offset, src->dtype,
+                    static_cast<char*>(dst->data) + dst->byte_offset, dst->dtype, num_elems);
+  if (dst != to) {
+    NDArray::CopyFromTo(dst, to, stream);
+    // The host copy is freed on return.
+    DeviceAPI::Get(to->device)->StreamSync(to->device, stream);
+  }
+}
+
 void NDArray::CopyFromTo(const DLTensor* from, DLTensor* to, TVMStreamHandle stream) {
+  if (!TypeEqual(from->dtype, to->dtype) && IsFloatConvertible(from->dtype, to->dtype)) {
+    ConvertFromTo(from, to, stream);
+    return;
+  }
   size_t from_size = GetDataSize(*from);
   size_t to_size = GetDataSize(*to);
   ICHECK_EQ(from_size, to_size) << "TVMArrayCopyFromTo: The size must exactly match";
@@ -388,6 +455,17 @@ int TVMArrayToDLPack(TVMArrayHandle from, DLManagedTensor** out) {
   API_END();
 }
 
+int TVMArrayToDLPackWithStream(TVMArrayHandle from, TVMStreamHandle consumer_stream,
+                               DLManagedTensor** out) {
+  API_BEGIN();
+  DLDevice dev = from->device;
+  if (dev.device_type != kDLCPU) {
+    OrderStreams(dev, DeviceAPI::Get(dev)->GetCurrentStream(dev), consumer_stream);
+  }
+  *out = NDArray::Internal::ToDLPack(from);
+  API_END();
+}
+
 void TVMDLManagedTensorCallDeleter(DLManagedTensor* dltensor) { (*(dltensor->deleter))(dltensor); }
 
 int TVMArrayCopyFromBytes(TVMArrayHandle handle, void* data, size_t nbytes) {
@@ -21,6 +21,7 @@
  * \brief Object type management system.
  */
 #include <tvm/runtime/logging.h>
+#include <tvm/runtime/memory.h>
 #include <tvm/runtime/object.h>
 #include <tvm/runtime/registry.h>
 
@@ -234,6 +235,117 @@ TVM_REGISTER_GLOBAL("runtime.ObjectPtrHash").set_body_typed([](ObjectRef obj) {
 TVM_REGISTER_GLOBAL("runtime.DumpTypeTable").set_body_typed([](int min_child_count) {
   TypeContext::Global()->Dump(min_child_count);
 });
+
+/*!
+ * \brief Thread local free lists of the blocks of released objects, one per size class
+ *  of kObjectPoolAlignment bytes. Blocks are single operator new allocations, so they
+ *  can move between the pools of different threads.
+ */
+class ObjectPool {
+ public:
+  ~ObjectPool() {
+    Release();
+    destroyed_ = true;
+  }
+
+  // The pool of the calling thread, nullptr once the thread exits.
+  static ObjectPool* ThreadLocal() {
+    if (destroyed_) return nullptr;
+    thread_local ObjectPool pool;
+    return &pool;
+  }
+
+  void* Alloc(size_t size_class) {
+    ++stats_.num_allocs;
+    FreeBlock* block = heads_[size_class];
+    if (block == nullptr) {
+      return ::operator new(ClassBytes(size_class));
+    }
+    heads_[size_class] = block->next;
+    --counts_[size_class];
+    ++stats_.num_reused;
+    stats_.cached_bytes -= ClassBytes(size_class);
+    return block;
+  }
+
+  void Free(void* ptr, size_t size_class) {
+    ++stats_.num_frees;
+    if (counts_[size_class] >= kMaxCachedBlocks) {
+      ::operator delete(ptr);
+      return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = heads_[size_class];
+    heads_[size_class] = block;
+    ++counts_[size_class];
+    stats_.cached_bytes += ClassBytes(size_class);
+  }
+
+  void Release() {
+    for (size_t i = 0; i < kNumClasses; ++i) {
+      while (FreeBlock* block = heads_[i]) {
+        heads_[i] = block->next;
+        ::operator delete(block);
+      }
+      counts_[i] = 0;
+    }
+    stats_.cached_bytes = 0;
+  }
+
+  const ObjectPoolStats& stats() const { return stats_; }
+
+  static size_t SizeClass(size_t nbytes) {
+    return (nbytes + kObjectPoolAlignment - 1) / kObjectPoolAlignment - 1;
+  }
+
+  static constexpr size_t ClassBytes(size_t size_class) {
+    return (size_class + 1) * kObjectPoolAlignment;
+  }
+
+  static constexpr size_t kNumClasses = kObjectPoolMaxBytes / kObjectPoolAlignment;
+  static constexpr size_t kMaxCachedBlocks = 256;
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* heads_[kNumClasses] = {};
+  size_t counts_[kNumClasses] = {};
+  ObjectPoolStats stats_;
+  static thread_local bool destroyed_;
+};
+
+thread_local bool ObjectPool::destroyed_ = false;
+
+void* ObjectPoolAlloc(size_t nbytes) {
+  if (nbytes > kObjectPoolMaxBytes) return ::operator new(nbytes);
+  size_t size_class = ObjectPool::SizeClass(nbytes);
+  ObjectPool* pool = ObjectPool::ThreadLocal();
+  if (pool == nullptr) return ::operator new(ObjectPool::ClassBytes(size_class));
+  return pool->Alloc(size_class);
+}
+
+void ObjectPoolFree(void* ptr, size_t nbytes) {
+  ObjectPool* pool = ObjectPool::ThreadLocal();
+  if (nbytes > kObjectPoolMaxBytes || pool == nullptr) {
+    ::operator delete(ptr);
+    return;
+  }
+  pool->Free(ptr, ObjectPool::SizeClass(nbytes));
+}
+
+ObjectPoolStats GetObjectPoolStats() {
+  ObjectPool* pool = ObjectPool::ThreadLocal();
+  return pool == nullptr ? ObjectPoolStats() : pool->stats();
+}
+
+void ReleaseObjectPool() {
+  if (ObjectPool* pool = ObjectPool::ThreadLocal()) {
+    pool->Release();
+  }
+}
+
 }  // namespace runtime
 }  // namespace tvm
 
@@ -25,6 +25,11 @@
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/registry.h>
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -35,6 +40,137 @@
 namespace tvm {
 namespace runtime {
 
+namespace cl {
+
+std::string GetPlatformInfo(cl_platform_id pid, cl_platform_info param_name);
+std::string GetDeviceInfo(cl_device_id pid, cl_device_info param_name);
+
+}  // namespace cl
+
+namespace {
+
+/*!
+ * \brief The directory of the program binary cache, set by TVM_OPENCL_CACHE_DIR.
+ *  The cache is disabled when the variable is not set.
+ */
+std::string ProgramCacheDir() {
+  const char* dir = std::getenv("TVM_OPENCL_CACHE_DIR");
+  return dir != nullptr ? std::string(dir) : std::string();
+}
+
+uint64_t FNV1aHash(const std::string& data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/*!
+ * \brief The key of a program in the cache. The driver and device versions are part of the key,
+ *  so an entry built by another driver is never loaded.
+ */
+std::string ProgramCacheKey(cl_platform_id platform, cl_device_id dev, const std::string& source) {
+  std::ostringstream os;
+  os << "tvm-opencl-cache-v1\n"
+     << cl::GetDeviceInfo(dev, CL_DEVICE_NAME) << "\n"
+     << cl::GetDeviceInfo(dev, CL_DRIVER_VERSION) << "\n"
+     << cl::GetDeviceInfo(dev, CL_DEVICE_VERSION) << "\n"
+     << cl::GetPlatformInfo(platform, CL_PLATFORM_VERSION) << "\n"
+     << std::hex << FNV1aHash(source) << std::dec << " " << source.size() << "\n";
+  return os.str();
+}
+
+std::string ProgramCachePath(const std::string& dir, const std::string& key) {
+  std::ostringstream os;
+  os << dir << "/" << std::hex << FNV1aHash(key) << ".clbin";
+  return os.str();
+}
+
+/*!
+ * \brief Load the program binary of a key, the file starts with the key to rule out collisions.
+ * \return Whether a valid entry was found.
+ */
+bool LoadProgramBinary(const std::string& path, const std::string& key, std::string* binary) {
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  if (!fs) return false;
+  uint64_t key_size = 0;
+  if (!fs.read(reinterpret_cast<char*>(&key_size), sizeof(key_size)) || key_size != key.size()) {
+    return false;
+  }
+  std::string stored_key(key_size, '\0');
+  if (!fs.read(&stored_key[0], key_size) || stored_key != key) return false;
+  std::ostringstream os;
+  os << fs.rdbuf();
+  *binary = os.str();
+  return !binary->empty();
+}
+
+/*!
+ * \brief Store the program binary of a key. The entry is written to a temporary file and renamed
+ *  into place, so processes can share the directory. Failures only skip the cache.
+ */
+void StoreProgramBinary(const std::string& path, const std::string& key,
+                        const std::string& binary) {
+  std::string tmp_path =
+      path + ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  {
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+    if (!fs) {
+      LOG(WARNING) << "Cannot write the OpenCL program cache entry " << tmp_path;
+      return;
+    }
+    uint64_t key_size = key.size();
+    fs.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    fs.write(key.data(), key.size());
+    fs.write(binary.data(), binary.size());
+    if (!fs) {
+      fs.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+  }
+}
+
+/*! \brief Get the binary of a program built for a single device. */
+std::string GetProgramBinary(cl_program program) {
+  size_t binary_size = 0;
+  OPENCL_CALL(clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binary_size,
+                               nullptr));
+  std::string binary(binary_size, '\0');
+  if (binary_size == 0) return binary;
+  unsigned char* ptr = reinterpret_cast<unsigned char*>(&binary[0]);
+  OPENCL_CALL(
+      clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &ptr, nullptr));
+  return binary;
+}
+
+/*! \brief Create and build a program from a cached binary, nullptr when it is not accepted. */
+cl_program LoadCachedProgram(cl::OpenCLWorkspace* w, cl_platform_id platform, cl_device_id dev,
+                             const std::string& binary) {
+  const unsigned char* s = reinterpret_cast<const unsigned char*>(binary.data());
+  size_t len = binary.size();
+  cl_int binary_status, err;
+  cl_program program = clCreateProgramWithBinary(w->contexts[platform], 1, &dev, &len, &s,
+                                                 &binary_status, &err);
+  if (err != CL_SUCCESS || binary_status != CL_SUCCESS) {
+    if (program != nullptr) clReleaseProgram(program);
+    return nullptr;
+  }
+  // A binary the driver no longer accepts falls back to the source.
+  if (clBuildProgram(program, 1, &dev, nullptr, nullptr, nullptr) != CL_SUCCESS) {
+    clReleaseProgram(program);
+    return nullptr;
+  }
+  return program;
+}
+
+}  // namespace
+
 class OpenCLWrappedFunc {
  public:
   // initialize the OpenCL function.
@@ -221,19 +357,34 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
   auto did = w->GetCLDeviceID(device_id);
   auto platform = w->device_to_platform[did];
   if (programs_[func_name][device_id] == nullptr) {
+    cl_device_id dev = w->devices[device_id];
+    std::string cache_dir, cache_key;
+    bool built = false;
     // create program
     if (fmt_ == "cl") {
-      const char* s = parsed_kernels_[func_name].c_str();
-      size_t len = parsed_kernels_[func_name].length();
-      cl_int err;
-      programs_[func_name][device_id] =
-          clCreateProgramWithSource(w->contexts[platform], 1, &s, &len, &err);
-      OPENCL_CHECK_ERROR(err);
+      const std::string& source = parsed_kernels_[func_name];
+      cache_dir = ProgramCacheDir();
+      std::string binary;
+      if (!cache_dir.empty()) {
+        cache_key = ProgramCacheKey(platform, dev, source);
+        if (LoadProgramBinary(ProgramCachePath(cache_dir, cache_key), cache_key, &binary)) {
+          programs_[func_name][device_id] = LoadCachedProgram(w, platform, dev, binary);
+        }
+      }
+      if (programs_[func_name][device_id] != nullptr) {
+        built = true;
+      } else {
+        const char* s = source.c_str();
+        size_t len = source.length();
+        cl_int err;
+        programs_[func_name][device_id] =
+            clCreateProgramWithSource(w->contexts[platform], 1, &s, &len, &err);
+        OPENCL_CHECK_ERROR(err);
+      }
     } else if (fmt_ == "xclbin" || fmt_ == "awsxclbin" || fmt_ == "aocx") {
       const unsigned char* s = (const unsigned char*)data_.c_str();
       size_t len = data_.length();
       cl_int err;
-      cl_device_id dev = w->devices[device_id];
       programs_[func_name][device_id] =
           clCreateProgramWithBinary(w->contexts[platform], 1, &dev, &len, &s, nullptr, &err);
       OPENCL_CHECK_ERROR(err);
@@ -241,9 +392,10 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
       LOG(FATAL) << "Unknown OpenCL format " << fmt_;
     }
     // build program
-    cl_int err;
-    cl_device_id dev = w->devices[device_id];
-    err = clBuildProgram(programs_[func_name][device_id], 1, &dev, nullptr, nullptr, nullptr);
+    cl_int err = CL_SUCCESS;
+    if (!built) {
+      err = clBuildProgram(programs_[func_name][device_id], 1, &dev, nullptr, nullptr, nullptr);
+    }
     if (err != CL_SUCCESS) {
       size_t len;
       std::string log;
@@ -256,6 +408,12 @@ cl_kernel OpenCLModuleNode::InstallKernel(cl::OpenCLWorkspace* w, cl::OpenCLThre
                  << "\nError: " << cl::CLGetErrorString(err) << "\n"
                  << log;
     }
+    if (!built && !cache_dir.empty()) {
+      std::string binary = GetProgramBinary(programs_[func_name][device_id]);
+      if (!binary.empty()) {
+        StoreProgramBinary(ProgramCachePath(cache_dir, cache_key), cache_key, binary);
+      }
+    }
   }
   // build kernel
   cl_int err;
@@ -348,6 +506,24 @@ PackedFunc OpenCLModuleNode::GetFunction(const String& name,
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       this->SetPreCompiledPrograms(args[0]);
     });
+  } else if (name == symbol::tvm_module_preload) {
+    return TypedPackedFunc<void(Device)>([sptr_to_self, this](Device dev) {
+      if (dev.device_type != kDLOpenCL) return;
+      // Build the programs on the device and install the kernels of the calling thread, which
+      // keeps running on the device as after SetDevice.
+      cl::OpenCLThreadEntry* t = workspace_->GetThreadEntry();
+      t->device = dev;
+      t->kernel_table.resize(workspace_->num_registered_kernels);
+      for (const auto& kv : kid_map_) {
+        const auto& e = t->kernel_table[kv.second.kernel_id];
+        if (e.kernel == nullptr || e.version != kv.second.version) {
+          InstallKernel(workspace_, t, kv.first, kv.second);
+        }
+      }
+    });
+  } else if (name == "get_func_names") {
+    return GetFuncNamesFunc(fmap_, sptr_to_self,
+                            {"opencl.GetPreCompiledPrograms", "opencl.SetPreCompiledPrograms"});
   }
   return OpenCLModuleNodeBase::GetFunction(name, sptr_to_self);
 }
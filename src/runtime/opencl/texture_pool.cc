@@ -21,6 +21,12 @@
  * \file texture_pool.h
  * \brief Texture pool utility.
  */
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <limits>
 #include <memory>
 
@@ -29,80 +35,146 @@
 namespace tvm {
 namespace runtime {
 
-void* Pool2D::Alloc(Device dev, DeviceAPI* device, size_t width, size_t height,
-                    DLDataType type_hint) {
-  Entry e;
-  Entry new_mem;
-  // Processed several experiments and found that when we are trying to fit
-  // small texture to too big texture then it may lead to the performance
-  // degradation.
-  // Coefficient at 5 looks like robust variant for reusing textures.
-  const int64_t max_ratio = 5;
-  e.data = nullptr;
-  std::vector<Entry>::iterator best_mem;
-  if (free_list_.size() != 0) {
-    int64_t min_added_size_x = std::numeric_limits<int64_t>::max();
-    int64_t min_added_size_y = std::numeric_limits<int64_t>::max();
-    int64_t min_wasted_size_x = std::numeric_limits<int64_t>::max();
-    int64_t min_wasted_size_y = std::numeric_limits<int64_t>::max();
+namespace {
+
+std::atomic<size_t>& TexturePoolBudget() {
+  static std::atomic<size_t> budget([]() -> size_t {
+    const char* val = getenv("TVM_TEXTURE_POOL_BUDGET");
+    return val != nullptr ? static_cast<size_t>(atoll(val)) : 0;
+  }());
+  return budget;
+}
+
+/*! \return The bytes of a texture of 4 channels of \p type. */
+size_t TextureBytes(size_t width, size_t height, DLDataType type) {
+  return width * height * 4 * ((type.bits * type.lanes + 7) / 8);
+}
+
+bool SameType(DLDataType a, DLDataType b) {
+  return a.code == b.code && a.bits == b.bits && a.lanes == b.lanes;
+}
+
+}  // namespace
+
+void Pool2D::SetBudget(size_t bytes) { TexturePoolBudget() = bytes; }
+
+int Pool2D::Bucket(size_t size) {
+  int bucket = 0;
+  for (; size > 1; size >>= 1) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+void Pool2D::Evict(Device dev, DeviceAPI* device, size_t nbytes) {
+  size_t budget = TexturePoolBudget();
+  if (budget == 0) return;
+  while (stats_.reserved_bytes + nbytes > budget && !free_list_.empty()) {
+    auto largest_bucket = free_list_.end();
+    size_t largest_index = 0;
+    size_t largest_bytes = 0;
     for (auto it = free_list_.begin(); it != free_list_.end(); ++it) {
-      if (it->type.code != type_hint.code) {
-        continue;
-      }
-      // avoid reusing too small and too big textures
-      if (width / it->x > max_ratio || it->x / width > max_ratio || height / it->y > max_ratio ||
-          it->y / height > max_ratio) {
-        continue;
-      }
-      int64_t new_width = std::max(it->x, width);
-      int64_t new_height = std::max(it->y, height);
-      int64_t added_size_x = new_width - it->x;
-      int64_t added_size_y = new_height - it->y;
-      int64_t wasted_size_x = new_width - width;
-      int64_t wasted_size_y = new_height - height;
-      // Minimize added size first and wasted size thereafter
-      if ((min_added_size_x > 0 && added_size_x < min_added_size_x) ||
-          (min_added_size_y > 0 && added_size_y < min_added_size_y) ||
-          (min_added_size_x == added_size_x && wasted_size_x < min_wasted_size_x) ||
-          (min_added_size_y == added_size_y && wasted_size_y < min_wasted_size_y)) {
-        min_added_size_x = added_size_x;
-        min_added_size_y = added_size_y;
-        min_wasted_size_x = wasted_size_x;
-        min_wasted_size_y = wasted_size_y;
-        best_mem = it;
-        new_mem.x = new_width;
-        new_mem.y = new_height;
+      for (size_t i = 0; i < it->second.size(); ++i) {
+        const Entry& e = it->second[i];
+        size_t bytes = TextureBytes(e.x, e.y, e.type);
+        if (bytes > largest_bytes) {
+          largest_bucket = it;
+          largest_index = i;
+          largest_bytes = bytes;
+        }
       }
     }
+    std::vector<Entry>& entries = largest_bucket->second;
+    device->FreeDataSpace(dev, entries[largest_index].data);
+    entries.erase(entries.begin() + largest_index);
+    if (entries.empty()) free_list_.erase(largest_bucket);
+    stats_.reserved_bytes -= largest_bytes;
+    ++stats_.num_evictions;
+  }
+}
 
-    if (min_added_size_x == 0 && min_added_size_y == 0) {
-      // use existing block
-      e = *best_mem;
-      free_list_.erase(best_mem);
-    } else if (static_cast<size_t>(min_added_size_x) <= width ||
-               static_cast<size_t>(min_added_size_y) <= height) {
-      // if added size is less or equal to
-      // what is needed by alloc, then grow entry
-      device->FreeDataSpace(dev, best_mem->data);
-      free_list_.erase(best_mem);
-      new_mem.type = type_hint;
-      std::vector<int64_t> shape{int64_t(new_mem.y), int64_t(new_mem.x), 4};
-      new_mem.data = device->AllocDataSpace(dev, shape.size(), shape.data(), new_mem.type,
-                                            Optional<String>("global.texture"));
-      e = new_mem;
+void* Pool2D::Alloc(Device dev, DeviceAPI* device, size_t width, size_t height,
+                    DLDataType type_hint) {
+  const size_t max_ratio = static_cast<size_t>(kTextureReuseMaxRatio);
+  // The textures within the ratio are at most 3 buckets away, since max_ratio < 8.
+  int bucket_x = Bucket(width);
+  int bucket_y = Bucket(height);
+  // The best fitting free texture, which minimizes the wasted area.
+  std::vector<Entry>* fit_entries = nullptr;
+  size_t fit_index = 0;
+  size_t min_wasted_area = std::numeric_limits<size_t>::max();
+  // The best texture to grow, which minimizes the added area.
+  std::vector<Entry>* grow_entries = nullptr;
+  size_t grow_index = 0;
+  size_t min_added_area = std::numeric_limits<size_t>::max();
+  for (int bx = std::max(bucket_x - 3, 0); bx <= bucket_x + 3; ++bx) {
+    for (int by = std::max(bucket_y - 3, 0); by <= bucket_y + 3; ++by) {
+      auto it = free_list_.find({bx, by});
+      if (it == free_list_.end()) continue;
+      for (size_t i = 0; i < it->second.size(); ++i) {
+        const Entry& e = it->second[i];
+        if (!SameType(e.type, type_hint)) continue;
+        // avoid reusing too small and too big textures
+        if (width / e.x > max_ratio || e.x / width > max_ratio || height / e.y > max_ratio ||
+            e.y / height > max_ratio) {
+          continue;
+        }
+        size_t new_width = std::max(e.x, width);
+        size_t new_height = std::max(e.y, height);
+        if (new_width == e.x && new_height == e.y) {
+          size_t wasted_area = e.x * e.y - width * height;
+          if (wasted_area < min_wasted_area) {
+            min_wasted_area = wasted_area;
+            fit_entries = &it->second;
+            fit_index = i;
+          }
+        } else {
+          size_t added_area = new_width * new_height - e.x * e.y;
+          if (added_area < min_added_area) {
+            min_added_area = added_area;
+            grow_entries = &it->second;
+            grow_index = i;
+          }
+        }
+      }
     }
   }
 
-  if (e.data == nullptr) {
-    // create new block
-    std::vector<int64_t> shape{int64_t(height), int64_t(width), 4};
-    e.data = device->AllocDataSpace(dev, shape.size(), shape.data(), type_hint,
-                                    Optional<String>("global.texture"));
+  Entry e;
+  size_t requested_bytes = TextureBytes(width, height, type_hint);
+  if (fit_entries != nullptr) {
+    e = (*fit_entries)[fit_index];
+    fit_entries->erase(fit_entries->begin() + fit_index);
+    if (fit_entries->empty()) free_list_.erase({Bucket(e.x), Bucket(e.y)});
+    ++stats_.num_reuses;
+  } else {
+    e.type = type_hint;
     e.x = width;
     e.y = height;
-    e.type = type_hint;
+    // Grow a free texture if that adds no more than the request, as the planner does.
+    if (grow_entries != nullptr && min_added_area <= width * height) {
+      Entry old = (*grow_entries)[grow_index];
+      grow_entries->erase(grow_entries->begin() + grow_index);
+      if (grow_entries->empty()) free_list_.erase({Bucket(old.x), Bucket(old.y)});
+      device->FreeDataSpace(dev, old.data);
+      stats_.reserved_bytes -= TextureBytes(old.x, old.y, old.type);
+      e.x = std::max(old.x, width);
+      e.y = std::max(old.y, height);
+      ++stats_.num_grows;
+    } else {
+      ++stats_.num_allocs;
+    }
+    size_t nbytes = TextureBytes(e.x, e.y, e.type);
+    Evict(dev, device, nbytes);
+    std::vector<int64_t> shape{int64_t(e.y), int64_t(e.x), 4};
+    e.data = device->AllocDataSpace(dev, shape.size(), shape.data(), e.type,
+                                    Optional<String>("global.texture"));
+    stats_.reserved_bytes += nbytes;
   }
-
+  e.wasted_bytes = TextureBytes(e.x, e.y, e.type) - requested_bytes;
+  stats_.current_bytes += TextureBytes(e.x, e.y, e.type);
+  stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.current_bytes);
+  stats_.wasted_bytes += e.wasted_bytes;
   allocated_.push_back(e);
   return e.data;
 }
@@ -121,7 +193,9 @@ void Pool2D::Free(void* data) {
     e = allocated_[index];
     allocated_.erase(allocated_.begin() + index);
   }
-  free_list_.push_back(e);
+  stats_.current_bytes -= TextureBytes(e.x, e.y, e.type);
+  stats_.wasted_bytes -= e.wasted_bytes;
+  free_list_[{Bucket(e.x), Bucket(e.y)}].push_back(e);
 }
 
 // Release all resources immediately
@@ -129,11 +203,30 @@ void Pool2D::Release(Device dev, DeviceAPI* device) {
   for (auto& e : allocated_) {
     device->FreeDataSpace(dev, e.data);
   }
-  for (auto& e : free_list_) {
-    device->FreeDataSpace(dev, e.data);
+  for (auto& kv : free_list_) {
+    for (auto& e : kv.second) {
+      device->FreeDataSpace(dev, e.data);
+    }
   }
   allocated_.clear();
   free_list_.clear();
+  stats_.current_bytes = 0;
+  stats_.reserved_bytes = 0;
+  stats_.wasted_bytes = 0;
+}
+
+Map<String, ObjectRef> Pool2D::Stats::AsMap() const {
+  Map<String, ObjectRef> stats;
+  auto count = [](size_t value) { return ObjectRef(make_object<profiling::CountNode>(value)); };
+  stats.Set("current_bytes", count(current_bytes));
+  stats.Set("peak_bytes", count(peak_bytes));
+  stats.Set("reserved_bytes", count(reserved_bytes));
+  stats.Set("wasted_bytes", count(wasted_bytes));
+  stats.Set("num_reuses", count(num_reuses));
+  stats.Set("num_grows", count(num_grows));
+  stats.Set("num_allocs", count(num_allocs));
+  stats.Set("num_evictions", count(num_evictions));
+  return stats;
 }
 
 TexturePool::TexturePool(DLDeviceType device_type, DeviceAPI* device)
@@ -167,5 +260,16 @@ void TexturePool::FreeTexture(Device dev, void* ptr) {
   array_[dev.device_id]->Free(ptr);
 }
 
+Pool2D::Stats TexturePool::GetStats(Device dev) const {
+  if (static_cast<size_t>(dev.device_id) >= array_.size() || array_[dev.device_id] == nullptr) {
+    return Pool2D::Stats();
+  }
+  return array_[dev.device_id]->GetStats();
+}
+
+TVM_REGISTER_GLOBAL("runtime.SetTexturePoolBudget").set_body_typed([](int64_t bytes) {
+  Pool2D::SetBudget(static_cast<size_t>(bytes));
+});
+
 }  // namespace runtime
 }  // namespace tvm
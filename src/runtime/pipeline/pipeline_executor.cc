@@ -85,6 +85,15 @@ PackedFunc PipelineExecutor::GetFunction(const String& name,
   } else if (name == "get_execute_count") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetExecutionCount(); });
+  } else if (name == "get_statistics") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->GetStatistics(); });
+  } else if (name == "start_profiling") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->StartProfiling(); });
+  } else if (name == "stop_profiling") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = this->StopProfiling(); });
   } else {
     LOG(FATAL) << "Unknown packed function: " << name;
   }
@@ -235,6 +244,70 @@ std::pair<int, int> PipelineExecutor::GetInputIndex(const std::string& name) {
  * \brief Getting the count of running pipeline.
  */
 int PipelineExecutor::GetExecutionCount() { return runtimes_.back()->GetExecutionCount(); }
+/*!
+ * \brief Getting the scheduling counters of every runtime.
+ * \return The counters in JSON form.
+ */
+std::string PipelineExecutor::GetStatistics() {
+  std::ostringstream os;
+  dmlc::JSONWriter writer(&os);
+  writer.BeginArray();
+  for (auto runtime : runtimes_) {
+    writer.WriteArraySeperator();
+    runtime->SaveStatistics(&writer);
+  }
+  writer.EndArray();
+  return os.str();
+}
+/*!
+ * \brief Starting to record the runs of every runtime.
+ */
+void PipelineExecutor::StartProfiling() {
+  profiling_start_ = std::chrono::steady_clock::now();
+  for (auto runtime : runtimes_) {
+    runtime->StartProfiling();
+  }
+}
+/*!
+ * \brief Stopping to record the runs and building a report of them.
+ * \return The report, the runs of the runtime 'mod_idx' are on the thread 'mod_idx + 1' and the
+ *  whole profiling is on the thread 0.
+ */
+profiling::Report PipelineExecutor::StopProfiling() {
+  using Micros = std::chrono::duration<double, std::micro>;
+  std::vector<std::pair<std::shared_ptr<BackendRuntime>,
+                        std::vector<std::pair<std::chrono::steady_clock::time_point,
+                                              std::chrono::steady_clock::time_point>>>>
+      traces;
+  for (auto runtime : runtimes_) {
+    traces.emplace_back(runtime, runtime->StopProfiling());
+  }
+  double total_us = Micros(std::chrono::steady_clock::now() - profiling_start_).count();
+  String device = "pipeline";
+  Array<Map<String, ObjectRef>> calls;
+  for (const auto& trace : traces) {
+    int mod_idx = trace.first->GetModuleIndex();
+    for (const auto& run : trace.second) {
+      double us = Micros(run.second - run.first).count();
+      Map<String, ObjectRef> call;
+      call.Set("Name", String("mod" + std::to_string(mod_idx)));
+      call.Set("Device", device);
+      call.Set("Count", ObjectRef(make_object<profiling::CountNode>(1)));
+      call.Set("Duration (us)", ObjectRef(make_object<profiling::DurationNode>(us)));
+      call.Set("Percent", ObjectRef(make_object<profiling::PercentNode>(us / total_us * 100)));
+      call.Set("Start (us)", ObjectRef(make_object<profiling::DurationNode>(
+                                 Micros(run.first - profiling_start_).count())));
+      call.Set("Thread", ObjectRef(make_object<profiling::CountNode>(mod_idx + 1)));
+      calls.push_back(call);
+    }
+  }
+  Map<String, ObjectRef> total;
+  total.Set("Device", device);
+  total.Set("Duration (us)", ObjectRef(make_object<profiling::DurationNode>(total_us)));
+  total.Set("Start (us)", ObjectRef(make_object<profiling::DurationNode>(0)));
+  total.Set("Thread", ObjectRef(make_object<profiling::CountNode>(0)));
+  return profiling::Report(calls, {{device, total}}, {{"Executor", String("Pipeline")}});
+}
 /*!
  * \brief Initialize the pipeline executor with a list of modules to be pipelined
  *  and config in JSON format.
@@ -25,9 +25,11 @@
 #define TVM_RUNTIME_PIPELINE_PIPELINE_EXECUTOR_H_
 
 #include <tvm/relay/expr.h>
+#include <tvm/runtime/profiling.h>
 #include <tvm/runtime/registry.h>
 
 #include <array>
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -99,6 +101,20 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
    * \brief Getting the count of running pipeline.
    */
   int GetExecutionCount();
+  /*!
+   * \brief Getting the scheduling counters of every runtime in JSON form: the runs, the
+   *  requests, the run latency, the time spent blocked on full queues and the occupancy of the
+   *  input queues.
+   */
+  std::string GetStatistics();
+  /*!\brief Starting to record the runs of every runtime for a profiling report.*/
+  void StartProfiling();
+  /*!
+   * \brief Stopping to record the runs.
+   * \return A report with a call for every run since 'StartProfiling', the runtime of a run
+   *  being its thread in the timeline.
+   */
+  profiling::Report StopProfiling();
   /*!
    * \brief Use the parameters group name to get the specific backend runtime then use
    *  the param_key_name to set param data for the said backend runtime.
@@ -187,6 +203,8 @@ class TVM_DLL PipelineExecutor : public ModuleNode {
   /*!The list of backend runtime module.*/
   std::vector<std::shared_ptr<BackendRuntime>> runtimes_;
   std::shared_ptr<GlobalRuntime> global_runtime_;
+  /*!\brief When the profiling started.*/
+  std::chrono::steady_clock::time_point profiling_start_;
   /*!\brief Json loader.*/
   void LoadConfig(dmlc::JSONReader* reader) {
     reader->BeginObject();
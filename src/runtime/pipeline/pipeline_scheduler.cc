@@ -42,7 +42,12 @@ std::shared_ptr<GlobalRuntime> PipelineScheduler::PipelineInit(
   global_runtime_ = std::make_shared<GlobalRuntime>(GLOBAL_MODULE_INDEX);
   // Initializing the data structures used by pipeline logic.
   global_runtime_->InitializePipeline(input_connection_config, runtimes);
-  // Creating a list of NDArray in order to storage the outputs data.
+  // Initializing and then running the worker thread.
+  for (auto runtime : runtimes) {
+    runtime->InitializePipeline(pipeline_config, &runtimes, global_runtime_);
+  }
+  // Creating a list of NDArray in order to storage the outputs data, the runtimes know the
+  // shape of a request once they are initialized.
   auto global_output_map = pipeline_config.GetGlobalConfigOutputBindings();
   for (size_t i = 0; i < global_output_map.size(); i++) {
     if (global_output_map.find(i) == global_output_map.end()) {
@@ -52,10 +57,6 @@ std::shared_ptr<GlobalRuntime> PipelineScheduler::PipelineInit(
     NDArray output = runtimes[output_pair.first]->CreateFromOutput(output_pair.second);
     output_arrays_.push_back(output);
   }
-  // Initializing and then running the worker thread.
-  for (auto runtime : runtimes) {
-    runtime->InitializePipeline(pipeline_config, &runtimes, global_runtime_);
-  }
   return global_runtime_;
 }
 /*!
@@ -25,11 +25,16 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -176,24 +181,23 @@ class DataNotify {
    */
   bool GetExitState(void) { return exit_state_.load(std::memory_order_acquire); }
 };
-/*!\brief The container used to store the forwarding data of the pipeline.*/
+/*!
+ * \brief The container used to store the forwarding data of the pipeline.
+ *
+ * The data is either copied into a buffer owned by the container, for senders which will
+ * overwrite their tensor, or handed over by reference when the sender gives up the array.
+ */
 class QueueData {
  public:
-  explicit QueueData(DLTensor* data) {
-    if (data_ == data) {
-      LOG(FATAL) << "The value of 'data'(" << data << ") is the same as 'data_'(" << data_ << ")";
-    }
-    data_ = data;
-    SetAsDataOwner(false);
-  }
-  QueueData() { SetAsDataOwner(true); }
+  QueueData() = default;
   /*!\brief Doing a deep copy for the 'QueueData' structure.*/
   QueueData& operator=(const QueueData& data) {
     CreateCopyFrom(data.GetDLData());
     return *this;
   }
+  /*!\brief Taking over the array without copying it, the sender must not write it again.*/
   QueueData& operator=(const NDArray& from) {
-    CreateCopyFrom(const_cast<DLTensor*>(from.operator->()));
+    data_ = from;
     return *this;
   }
   QueueData& operator=(const DLTensor* from) {
@@ -206,41 +210,34 @@ class QueueData {
       LOG(FATAL) << "the 'from' pointer is a null pointer!";
     }
     size_t fromLen = tvm::runtime::GetDataSize(*from);
-    size_t toLen = data_ ? tvm::runtime::GetDataSize(*data_) : 0;
+    size_t toLen = owned_.defined() ? tvm::runtime::GetDataSize(*owned_.operator->()) : 0;
     if (fromLen != toLen) {
-      // If this container ownes the variable 'data_', then recreating the 'data_' variable.
-      if (IsDataOwner()) {
-        if (data_) {
-          TVMArrayFree(data_);
-          data_ = nullptr;
-        }
-        TVMArrayAlloc(from->shape, from->ndim, from->dtype.code, from->dtype.bits,
-                      from->dtype.lanes, from->device.device_type, from->device.device_id, &data_);
-      } else {
-        LOG(FATAL) << "The 'from' data is not matched with the  'data_'.";
-      }
+      owned_ = NDArray::Empty(ShapeTuple(from->shape, from->shape + from->ndim), from->dtype,
+                              from->device);
     }
-    TVMArrayCopyFromTo(const_cast<DLTensor*>(from), data_, nullptr);
-    return data_;
+    NDArray::CopyFromTo(from, const_cast<DLTensor*>(owned_.operator->()));
+    data_ = owned_;
+    return GetDLData();
   }
   /*!\brief Return a pointer to the 'DLTensor' data.*/
-  DLTensor* GetDLData() const { return data_; }
-  ~QueueData() {
-    if (IsDataOwner() && data_) {
-      TVMArrayFree(data_);
-      data_ = nullptr;
-    }
+  DLTensor* GetDLData() const {
+    return data_.defined() ? const_cast<DLTensor*>(data_.operator->()) : nullptr;
   }
+  /*!\brief Return the forwarding data.*/
+  NDArray GetNDArray() const { return data_; }
+  /*!
+   * \brief Whether the data was handed over by its sender, in which case the receiver may keep
+   *  the array rather than copying it.
+   */
+  bool IsHandedOver() const { return data_.defined() && !data_.same_as(owned_); }
+  /*!\brief Drop the reference to the forwarding data, the owned buffer is kept for reuse.*/
+  void Release() { data_ = NDArray(); }
 
  private:
-  /*!\brief Pointer to the forwarding data.*/
-  DLTensor* data_ = nullptr;
-  /*!\brief Whether this container is the owner of the 'data_'.*/
-  bool is_data_owner_ = false;
-  /*!\brief Set the current container as the owner of the 'data_'.*/
-  void SetAsDataOwner(bool is_owner) { is_data_owner_ = is_owner; }
-  /*!Check whether the current container is the owner of the 'data_'.*/
-  bool IsDataOwner() const { return is_data_owner_; }
+  /*!\brief The forwarding data.*/
+  NDArray data_;
+  /*!\brief The buffer the copied data lives in.*/
+  NDArray owned_;
 };
 /*!
  * \brief All binding information of an output interface.
@@ -325,6 +322,8 @@ class ConfigRuntime {
   ConfigRuntime& operator=(const ConfigRuntime& output) {
     output_binding_map_ = output.GetOutBindings();
     cpu_affinity_ = output.GetCPUAffinity();
+    micro_batch_ = output.GetMicroBatch();
+    queue_capacity_ = output.GetQueueCapacity();
     return *this;
   }
 
@@ -342,6 +341,20 @@ class ConfigRuntime {
    * \param Returning the cpu affinity in text form.
    */
   std::string GetCPUAffinity() const { return cpu_affinity_; }
+  /*!
+   * \brief Store the scheduling settings of the module.
+   * \param micro_batch The most requests coalesced into one run of the module.
+   * \param queue_capacity The most requests waiting in each input queue of the module, 0 for
+   *  the default.
+   */
+  void StoreScheduling(int micro_batch, int queue_capacity) {
+    micro_batch_ = micro_batch;
+    queue_capacity_ = queue_capacity;
+  }
+  /*!\brief Getting the most requests coalesced into one run of the module.*/
+  int GetMicroBatch() const { return micro_batch_; }
+  /*!\brief Getting the most requests waiting in each input queue, 0 for the default.*/
+  int GetQueueCapacity() const { return queue_capacity_; }
   /*!
    * \brief Enumerating the output configuration.
    * \param parse_function The callback function is used to parse the binding configeration.
@@ -413,6 +426,10 @@ class ConfigRuntime {
   std::unordered_map<int, ConfigBindings> output_binding_map_;
   /*!\brief The cpu affinity setting for the tvm thread pool.*/
   std::string cpu_affinity_;
+  /*!\brief The most requests coalesced into one run.*/
+  int micro_batch_ = 1;
+  /*!\brief The capacity of the input queues, 0 for the default.*/
+  int queue_capacity_ = 0;
 };
 
 /*!
@@ -433,6 +450,12 @@ class ConfigPipelineExecution {
     auto config_runtime = config->second;
     return config_runtime.GetCPUAffinity();
   }
+  /*!\brief Get the configuration of a runtime.*/
+  const ConfigRuntime& GetRuntimeConfig(int runtime_idx) const {
+    auto config = config_.find(runtime_idx);
+    ICHECK(config != config_.end()) << "Do not finding the runtime " << runtime_idx;
+    return config->second;
+  }
   /*!
    * \brief Enumerating the binding configuration for a specified runtime.
    * \param parse_function The callback function is used to parse the binding configuration.
@@ -503,6 +526,8 @@ class ConfigPipelineExecution {
       ConfigRuntime output;
       std::string dev;
       std::string cpu_affinity;
+      int micro_batch = 1;
+      int queue_capacity = 0;
       while (reader->NextObjectItem(&key)) {
         if (key == "mod_idx") {
           reader->Read(&mod_idx);
@@ -512,6 +537,10 @@ class ConfigPipelineExecution {
           reader->Read(&output);
         } else if (key == "cpu_affinity") {
           reader->Read(&cpu_affinity);
+        } else if (key == "micro_batch") {
+          reader->Read(&micro_batch);
+        } else if (key == "queue_capacity") {
+          reader->Read(&queue_capacity);
         } else {
           LOG(FATAL) << "do not support key " << key;
         }
@@ -521,6 +550,9 @@ class ConfigPipelineExecution {
       ICHECK(!output.Empty()) << "Invalid output binding result.";
       // Store the cpu affinity into the 'ConfigRuntime' structure.
       output.StoreCPUAffinity(cpu_affinity);
+      ICHECK(micro_batch >= 1) << "Invalid micro_batch value " << micro_batch;
+      ICHECK(queue_capacity >= 0) << "Invalid queue_capacity value " << queue_capacity;
+      output.StoreScheduling(micro_batch, queue_capacity);
       // Build the mapping of mod_idx and "ConfigRuntime".
       config_[mod_idx] = output;
     }
@@ -662,11 +694,74 @@ struct ParamConnectionConfig {
     }
   }
 };
+/*!\brief The number of slots of a forwarding queue.*/
+constexpr int kForwardQueueLength = 1024;
+/*!
+ * \brief The most buffers an output interface hands over to its children at a time, enough to
+ *  fill its forwarding queues, plus the array held by the children.
+ */
+constexpr size_t kMaxForwardBuffers = kForwardQueueLength + 1;
 /*!
  * \brief The single consumer single producer queue which is used to forward data between two
  * interfaces of backend cores.
+ *
+ * A producer finding the queue full waits until the consumer frees a slot, rather than spinning,
+ * so the stages ahead of a slow stage are held back at the capacity of the queue.
  */
-using ForwardQueue = SPSCLockFreeQueue<QueueData, ModuleInterfaceID>;
+class ForwardQueue : public SPSCLockFreeQueue<QueueData, ModuleInterfaceID, kForwardQueueLength> {
+ public:
+  explicit ForwardQueue(ModuleInterfaceID id) : SPSCLockFreeQueue(id) {}
+  /*!
+   * \brief Pushing the data into the queue, waiting while the queue is full.
+   * \param data The data which is pushed into the queue.
+   * \param is_stop Returning true when the pipeline stopped and the push should give up.
+   * \param blocked_ns Accumulating the nanoseconds spent waiting for a free slot.
+   * \return Return false when the pipeline stopped before the data was pushed.
+   */
+  template <typename DataType, typename StopFunc>
+  bool PushOrWait(const DataType& data, StopFunc is_stop, std::atomic<uint64_t>* blocked_ns) {
+    if (Push<DataType>(data)) return true;
+    auto start = std::chrono::steady_clock::now();
+    bool pushed = true;
+    {
+      std::unique_lock<std::mutex> lock(space_mutex_);
+      while (!Push<DataType>(data)) {
+        if (is_stop()) {
+          pushed = false;
+          break;
+        }
+        // Waking up now and then to notice the pipeline stopping.
+        space_cv_.wait_for(lock, std::chrono::milliseconds(1));
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    *blocked_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    return pushed;
+  }
+  /*!
+   * \brief Consuming the data at the front of the queue in place and waking up the producer
+   *  waiting for a free slot.
+   * \param consume The function called with a pointer to the slot.
+   * \return Returning false when the queue is empty. Otherwise, return true.
+   */
+  template <typename ConsumeFunc>
+  bool PollWith(ConsumeFunc consume) {
+    if (!SPSCLockFreeQueue::PollWith(consume)) return false;
+    {
+      // Taking the lock so that the wake up can not fall between the producer's check and its
+      // wait.
+      std::lock_guard<std::mutex> lock(space_mutex_);
+    }
+    space_cv_.notify_one();
+    return true;
+  }
+
+ private:
+  /*!\brief Guarding the wait for a free slot.*/
+  std::mutex space_mutex_;
+  /*!\brief Notified when the consumer frees a slot.*/
+  std::condition_variable space_cv_;
+};
 using ForwardQueueMap =
     std::unordered_map<ModuleInterfaceID, std::shared_ptr<ForwardQueue>, ModuleIDHash>;
 /*!\brief The basic class for runtime.*/
@@ -721,6 +816,8 @@ class BasicRuntime {
   std::unordered_map<int, ForwardQueueMap> forward_queue_;
   /*!\brief The state of the pipeline.*/
   std::atomic<PipelineState> pipeline_state_{STOPPED};
+  /*!\brief The nanoseconds spent waiting for the children to free a slot of their queues.*/
+  std::atomic<uint64_t> blocked_ns_{0};
   /*!
    * \brief Generate the ID of an input queue.
    * \param runtime_index The index of backend runtime.
@@ -735,11 +832,13 @@ class BasicRuntime {
    * \param forward_queue_map The map includes the id and the queue.
    * \param child_runtime The child runtime.
    * \param child_input_index The child runtime index.
-   * \param data The data is used for forwarding.
+   * \param data The data is used for forwarding. A 'DLTensor*' is copied into the queue, while
+   *  an 'NDArray' is handed over to the child without copying.
    */
+  template <typename DataType>
   bool ForwardData(const ForwardQueueMap* forward_queue_map,
                    std::shared_ptr<BasicRuntime> child_runtime, int child_input_index,
-                   const DLTensor* data) {
+                   const DataType& data) {
     auto child_runtime_index = child_runtime->GetModuleIndex();
     auto queue_id = GenerateQueueID(child_runtime_index, child_input_index, INPUT);
     if (forward_queue_map->find(queue_id) == forward_queue_map->end()) {
@@ -748,14 +847,12 @@ class BasicRuntime {
                  << runtime_idx_;
     }
     auto forward_queue = forward_queue_map->at(queue_id);
-    // If the queue is full, keep try until the push get success or the pipeline run into
+    // If the queue is full, wait until the child frees a slot or the pipeline run into
     // a STOP state.
-    while (!forward_queue->Push<const DLTensor*>(data)) {
-      if (PipelineIsStop()) {
-        LOG(INFO) << "The forwarding process is stopped after the pipeline status is changed"
-                  << " into stop.";
-        return false;
-      }
+    if (!forward_queue->PushOrWait(data, [this]() { return PipelineIsStop(); }, &blocked_ns_)) {
+      LOG(INFO) << "The forwarding process is stopped after the pipeline status is changed"
+                << " into stop.";
+      return false;
     }
     child_runtime->ParentNotify(child_input_index);
     return true;
@@ -766,9 +863,10 @@ class BasicRuntime {
    * \param child_runtime The backend runtime which owns the input interface.
    * \param input_index The index of an input interface. This interface will receive the
    * forwarding data.
+   * \param capacity The most data waiting in the queue, 0 for the default.
    */
   void CreateForwardingQueue(int forward_inf_idx, std::shared_ptr<BasicRuntime> child_runtime,
-                             int input_index) {
+                             int input_index, int capacity = 0) {
     auto queue_id = GenerateQueueID(child_runtime->GetModuleIndex(), input_index, INPUT);
     // The forwarding queue map of a specified output interface.
     auto& queue_map = forward_queue_[forward_inf_idx];
@@ -778,6 +876,11 @@ class BasicRuntime {
       return;
     }
     auto queue = std::make_shared<ForwardQueue>(queue_id);
+    if (capacity > 0) {
+      ICHECK(queue->SetCapacity(capacity))
+          << "The queue capacity " << capacity << " is out of the range [1, "
+          << kForwardQueueLength - 1 << "]";
+    }
     queue_map[queue_id] = queue;
     // Use the created queue as the consumer queue for the input interface of this forwarding
     // pair.
@@ -810,14 +913,44 @@ class BackendRuntime : public BasicRuntime {
   std::thread thread_;
   /*!\brief The execution count of the 'RunPipeline' function. */
   uint32_t pipeline_execution_count_ = 0;
+  /*!\brief The most requests coalesced into one run, see 'LoadQueuedRequests'.*/
+  int micro_batch_ = 1;
+  /*!\brief The number of requests in the current run.*/
+  int batch_size_ = 1;
+  /*!\brief The number of runs, readable while the pipeline runs.*/
+  std::atomic<uint64_t> num_runs_{0};
+  /*!\brief The number of requests run.*/
+  std::atomic<uint64_t> num_requests_{0};
+  /*!\brief The nanoseconds spent in the runs.*/
+  std::atomic<uint64_t> run_ns_{0};
+  /*!\brief Whether the runs are recorded into 'trace_'.*/
+  std::atomic<bool> profiling_{false};
+  /*!\brief The mutex protecting 'trace_'.*/
+  std::mutex trace_mutex_;
+  /*!\brief The start and the end of every run recorded while profiling.*/
+  std::vector<std::pair<std::chrono::steady_clock::time_point,
+                        std::chrono::steady_clock::time_point>>
+      trace_;
   /*!
    *\brief In order to transfer data from one backend runtime to another, we need a local
    * tensor variable as a medium. "input_tensor_local_copy_" is a map including
    * input data and local tensor vairable.
    */
   std::unordered_map<DLTensor*, DLTensor*> input_tensor_local_copy_;
+  /*!
+   * \brief The buffers the outputs forwarded to the children are written to, indexed by output.
+   * A buffer is handed over to the children after each run and is reused once they all dropped
+   * their reference to it.
+   */
+  std::unordered_map<int, std::vector<NDArray>> output_buffers_;
+  /*!\brief The buffers the current outputs are written to, indexed by output.*/
+  std::unordered_map<int, NDArray> current_outputs_;
+  /*!\brief The handed over arrays bound to the inputs without copying, indexed by input.*/
+  std::unordered_map<int, NDArray> bound_inputs_;
   /*!\brief The packed functions.*/
   tvm::runtime::PackedFunc set_input_;
+  tvm::runtime::PackedFunc set_input_zero_copy_;
+  tvm::runtime::PackedFunc set_output_zero_copy_;
   tvm::runtime::PackedFunc get_input_;
   tvm::runtime::PackedFunc get_output_;
   tvm::runtime::PackedFunc get_num_output_;
@@ -881,24 +1014,153 @@ class BackendRuntime : public BasicRuntime {
       }
       notifys.erase(notify);
     }
+    if (!exit_notify && micro_batch_ > 1) {
+      batch_size_ = LoadQueuedRequests();
+    }
     return exit_notify;
   }
   /*!
    * \brief Loading the binding data.
    * \param input_index The index of the interface which will receive the forwarding data.
+   * \param slot The position of the request in the micro-batch.
    * \return Returning 'true' when data is loaded successfully, otherwise returning 'false'.
    */
-  bool LoadBindingData(int input_index) {
+  bool LoadBindingData(int input_index, int slot = 0) {
     if (input_queue_.find(input_index) == input_queue_.end()) {
       LOG(FATAL) << "Not finding the associated input queue of the input " << input_index << " !";
     }
     auto queue = input_queue_[input_index];
-    QueueData data;
-    // TODO(huajsj): Doing the 'SetInput' inside the poll function to avoid one time data copy.
-    if (!queue->Poll<QueueData>(&data)) {
+    // Reading the data in its slot, the slot gets back to the producer without the reference to
+    // a handed over array so that the producer can reuse the array.
+    return queue->PollWith([&](QueueData* data) {
+      if (micro_batch_ > 1) {
+        SetInputSlice(input_index, slot, data->GetDLData());
+      } else if (data->IsHandedOver()) {
+        BindInput(input_index, data->GetNDArray());
+      } else {
+        SetInput(input_index, data->GetDLData());
+      }
+      data->Release();
+    });
+  }
+  /*!
+   * \brief Coalescing the requests already waiting in every input queue into the micro-batch
+   *  whose first request is loaded. Nothing is waited for, a lone request runs alone.
+   * \return The number of requests in the micro-batch.
+   */
+  int LoadQueuedRequests() {
+    size_t num_requests = micro_batch_;
+    for (const auto& queue : input_queue_) {
+      num_requests = std::min(num_requests, queue.second->Size() + 1);
+    }
+    // The producers push the requests in order, taking as many from every queue keeps the
+    // inputs of a request together.
+    for (size_t slot = 1; slot < num_requests; ++slot) {
+      for (const auto& queue : input_queue_) {
+        ICHECK(LoadBindingData(queue.first, slot));
+      }
+    }
+    return num_requests;
+  }
+  /*!
+   * \brief Viewing the part of a micro-batched tensor which holds one request.
+   * \param batch The tensor holding the micro-batch along its first axis.
+   * \param slot The position of the request in the micro-batch.
+   * \param shape Receiving the shape of the view, it must outlive the view.
+   */
+  DLTensor RequestView(const DLTensor* batch, int slot, std::vector<int64_t>* shape) {
+    shape->assign(batch->shape, batch->shape + batch->ndim);
+    if (micro_batch_ > 1) {
+      ICHECK(batch->ndim > 0 && batch->shape[0] % micro_batch_ == 0)
+          << "The first axis of a tensor of runtime " << runtime_idx_
+          << " can not hold a micro-batch of " << micro_batch_ << " requests";
+      (*shape)[0] /= micro_batch_;
+    }
+    DLTensor view = *batch;
+    view.shape = shape->data();
+    view.strides = nullptr;
+    view.byte_offset += slot * (GetDataSize(*batch) / micro_batch_);
+    return view;
+  }
+  /*!\brief Copying a request into its part of a micro-batched input.*/
+  void SetInputSlice(int index, int slot, DLTensor* data_in) {
+    NDArray input = GetInput(index);
+    DLTensor* dltensor_input = const_cast<DLTensor*>(input.operator->());
+    std::vector<int64_t> shape;
+    DLTensor view = RequestView(dltensor_input, slot, &shape);
+    ICHECK_EQ(GetDataSize(*data_in), GetDataSize(view))
+        << "The request for input " << index << " of runtime " << runtime_idx_
+        << " does not match a 1/" << micro_batch_ << " slice of the input";
+    CopyFromTo(data_in, &view, dltensor_input);
+  }
+  /*!
+   * \brief Binding a handed over array to an input. The array is used in place when it lives on
+   *  the device of the input and has its layout, otherwise it is copied.
+   */
+  void BindInput(int index, NDArray data) {
+    NDArray input = GetInput(index);
+    if (set_input_zero_copy_ == nullptr || !SameDeviceAndLayout(data, input)) {
+      SetInput(index, const_cast<DLTensor*>(data.operator->()));
+      return;
+    }
+    set_input_zero_copy_(index, data);
+    // Holding the array until the next one is bound, the producer will not reuse it before.
+    bound_inputs_[index] = data;
+  }
+  /*!\brief Whether two arrays live on the same device and have the same type and shape.*/
+  static bool SameDeviceAndLayout(const NDArray& a, const NDArray& b) {
+    const DLTensor* ta = a.operator->();
+    const DLTensor* tb = b.operator->();
+    if (ta->device.device_type != tb->device.device_type ||
+        ta->device.device_id != tb->device.device_id || ta->byte_offset != 0 ||
+        DataType(ta->dtype) != DataType(tb->dtype) || ta->ndim != tb->ndim) {
       return false;
     }
-    SetInput(input_index, data.GetDLData());
+    return std::equal(ta->shape, ta->shape + ta->ndim, tb->shape);
+  }
+  /*!\brief Whether the module writes the forwarded outputs straight into handed over buffers.*/
+  bool HandsOverOutputs() const { return set_output_zero_copy_ != nullptr && micro_batch_ == 1; }
+  /*!
+   * \brief Getting a free buffer for a request of the output forwarded to the children.
+   * \param output_idx The output index.
+   * \param buffer Receiving the buffer.
+   * \return Returning false when the pipeline stopped while waiting for a free buffer.
+   */
+  bool AcquireForwardBuffer(int output_idx, NDArray* buffer) {
+    auto& buffers = output_buffers_[output_idx];
+    while (true) {
+      for (const NDArray& candidate : buffers) {
+        // Only this thread hands the buffers over, nobody else can take a reference to a buffer
+        // held by this runtime alone.
+        if (candidate.use_count() == 1) {
+          std::atomic_thread_fence(std::memory_order_acquire);
+          *buffer = candidate;
+          return true;
+        }
+      }
+      // The children lag behind, allocate another buffer as long as the queues could hold it.
+      if (buffers.size() < kMaxForwardBuffers) {
+        buffers.push_back(CreateFromOutput(output_idx));
+        continue;
+      }
+      if (PipelineIsStop()) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+  }
+  /*!
+   * \brief Getting a free buffer for the output forwarded to the children, and pointing the
+   *  output of the module at it.
+   * \return Returning false when the pipeline stopped while waiting for a free buffer.
+   */
+  bool BindOutputBuffer(int output_idx) {
+    NDArray buffer;
+    if (!AcquireForwardBuffer(output_idx, &buffer)) {
+      return false;
+    }
+    set_output_zero_copy_(output_idx, buffer);
+    current_outputs_[output_idx] = buffer;
     return true;
   }
   /*!
@@ -912,18 +1174,43 @@ class BackendRuntime : public BasicRuntime {
       if (forward_queue_.find(output_idx) == forward_queue_.end()) {
         LOG(FATAL) << "Not find the forwarding queue map for output(" << output_idx << ")!";
       }
-      NDArray output = GetOutput(output_idx);
       auto forward_queue_map = forward_queue_[output_idx];
-      // Notifying the 'children runtime' that the forwarding data are ready.
-      for (auto module_pair : child.second) {
-        auto child_runtime = module_pair.first;
-        auto child_input_index = module_pair.second;
-        auto output_data = const_cast<DLTensor*>(output.operator->());
-        if (!ForwardData(&forward_queue_map, child_runtime, child_input_index, output_data)) {
-          return false;
+      for (int slot = 0; slot < batch_size_; ++slot) {
+        NDArray request;
+        if (HandsOverOutputs()) {
+          // Handing the output buffer over, the next run writes to another buffer.
+          request = current_outputs_[output_idx];
+        } else if (micro_batch_ > 1) {
+          // Splitting the micro-batch, each request goes on in a buffer of its own.
+          if (!AcquireForwardBuffer(output_idx, &request)) {
+            return false;
+          }
+          NDArray output = GetOutput(output_idx);
+          std::vector<int64_t> shape;
+          DLTensor view = RequestView(output.operator->(), slot, &shape);
+          NDArray::CopyFromTo(&view, const_cast<DLTensor*>(request.operator->()));
+        }
+        // Notifying the 'children runtime' that the forwarding data are ready.
+        for (auto module_pair : child.second) {
+          auto child_runtime = module_pair.first;
+          auto child_input_index = module_pair.second;
+          bool forwarded = false;
+          if (request.defined()) {
+            forwarded = ForwardData(&forward_queue_map, child_runtime, child_input_index, request);
+          } else {
+            NDArray output = GetOutput(output_idx);
+            auto data = const_cast<DLTensor*>(output.operator->());
+            forwarded = ForwardData(&forward_queue_map, child_runtime, child_input_index, data);
+          }
+          if (!forwarded) {
+            return false;
+          }
         }
       }
     }
+    // Dropping the references to the handed over buffers, they are free once the children are
+    // done with them.
+    current_outputs_.clear();
     return true;
   }
   /*!
@@ -947,18 +1234,20 @@ class BackendRuntime : public BasicRuntime {
   }
   /*
    *\brief Copying data from one DLTensor to another.
+   *\param bridge_key The tensor the CPU bridge is kept for, 'to' by default.
    */
-  void CopyFromTo(DLTensor* from, DLTensor* to) {
+  void CopyFromTo(DLTensor* from, DLTensor* to, DLTensor* bridge_key = nullptr) {
+    if (bridge_key == nullptr) bridge_key = to;
     // When the 'from' device and the 'to' device are not the same, we use a temporary CPU
     // DLTensor as the bridge.
     if (from->device.device_type != to->device.device_type && from->device.device_type != kDLCPU &&
         to->device.device_type != kDLCPU) {
       DLTensor* dltensor_local = nullptr;
-      if (input_tensor_local_copy_.find(to) == input_tensor_local_copy_.end()) {
+      if (input_tensor_local_copy_.find(bridge_key) == input_tensor_local_copy_.end()) {
         dltensor_local = CopyDLTensorToCPU(from);
-        input_tensor_local_copy_[to] = dltensor_local;
+        input_tensor_local_copy_[bridge_key] = dltensor_local;
       } else {
-        dltensor_local = input_tensor_local_copy_[to];
+        dltensor_local = input_tensor_local_copy_[bridge_key];
       }
       TVMArrayCopyFromTo(from, dltensor_local, nullptr);
       from = dltensor_local;
@@ -987,6 +1276,8 @@ class BackendRuntime : public BasicRuntime {
     get_num_output_ = module_.GetFunction("get_num_outputs");
     get_num_inputs_ = module_.GetFunction("get_num_inputs");
     set_input_ = module_.GetFunction("set_input");
+    set_input_zero_copy_ = module_.GetFunction("set_input_zero_copy");
+    set_output_zero_copy_ = module_.GetFunction("set_output_zero_copy");
     get_input_ = module_.GetFunction("get_input");
     get_output_ = module_.GetFunction("get_output");
     run_ = module_.GetFunction("run");
@@ -1002,6 +1293,53 @@ class BackendRuntime : public BasicRuntime {
    * \return The times of using pipeline function.
    */
   int GetExecutionCount() const { return pipeline_execution_count_; }
+  /*!
+   * \brief Writing the scheduling counters of the runtime, they can be read while the pipeline
+   *  runs.
+   * \param writer The JSON writer.
+   */
+  void SaveStatistics(dmlc::JSONWriter* writer) {
+    uint64_t num_runs = num_runs_.load();
+    uint64_t num_requests = num_requests_.load();
+    writer->BeginObject();
+    writer->WriteObjectKeyValue("mod_idx", runtime_idx_);
+    writer->WriteObjectKeyValue("num_runs", num_runs);
+    writer->WriteObjectKeyValue("num_requests", num_requests);
+    writer->WriteObjectKeyValue("micro_batch", micro_batch_);
+    writer->WriteObjectKeyValue("average_batch_size",
+                                num_runs ? static_cast<double>(num_requests) / num_runs : 0.0);
+    writer->WriteObjectKeyValue("average_latency_us",
+                                num_runs ? run_ns_.load() / 1e3 / num_runs : 0.0);
+    writer->WriteObjectKeyValue("blocked_us", blocked_ns_.load() / 1e3);
+    // The occupancy and the capacity of each input queue.
+    std::map<int, std::vector<size_t>> queues;
+    for (const auto& queue : input_queue_) {
+      queues[queue.first] = {queue.second->Size(), queue.second->Capacity()};
+    }
+    std::vector<std::vector<size_t>> occupancy;
+    for (const auto& queue : queues) {
+      occupancy.push_back({static_cast<size_t>(queue.first), queue.second[0], queue.second[1]});
+    }
+    writer->WriteObjectKeyValue("input_queues", occupancy);
+    writer->EndObject();
+  }
+  /*!\brief Starting to record the start and the end of every run.*/
+  void StartProfiling() {
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+    trace_.clear();
+    profiling_ = true;
+  }
+  /*!
+   * \brief Stopping to record the runs.
+   * \return The start and the end of every run since 'StartProfiling'.
+   */
+  std::vector<std::pair<std::chrono::steady_clock::time_point,
+                        std::chrono::steady_clock::time_point>>
+  StopProfiling() {
+    profiling_ = false;
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+    return std::move(trace_);
+  }
   /*!
    * \brief Initializing data structures for the pipeline execution.
    * \param config The pipeline configueration.
@@ -1012,11 +1350,17 @@ class BackendRuntime : public BasicRuntime {
                           std::shared_ptr<BasicRuntime> global_runtime) {
     // Getting the current BackendRuntime's cpu affinity setting.
     cpu_affinity_ = config.GetCPUAffinity(runtime_idx_);
+    micro_batch_ = config.GetRuntimeConfig(runtime_idx_).GetMicroBatch();
+    if (micro_batch_ > 1 && runtime_idx_ == 0) {
+      LOG(FATAL) << "The first runtime is fed by the caller one request at a time, it can not "
+                 << "coalesce requests into micro-batches";
+    }
     // Getting the 'binding configuration' for each child runtime.
     config.VisitRuntimeOutputConfig(
         [&](int output_idx, int child_idx, std::string child_input_name) {
           std::shared_ptr<BasicRuntime> child_runtime = nullptr;
           int input_index;
+          int queue_capacity = 0;
           if (GLOBAL_MODULE_INDEX == child_idx) {
             int global_output_index = std::stoi(child_input_name);
             input_index = global_output_index;
@@ -1033,6 +1377,7 @@ class BackendRuntime : public BasicRuntime {
               LOG(FATAL) << "Can not find the input " << input_index << "in runtime " << child_idx;
             }
             child_runtime = runtime;
+            queue_capacity = config.GetRuntimeConfig(child_idx).GetQueueCapacity();
           }
           ICHECK(child_runtime != nullptr);
           children_[output_idx].push_back(std::make_pair(child_runtime, input_index));
@@ -1040,7 +1385,7 @@ class BackendRuntime : public BasicRuntime {
           VLOG(1) << " parent_idx.output:" << runtime_idx_ << "." << output_idx
                   << " child.input:" << child_idx << "." << input_index;
           // Creating the pipeline forwarding queue.
-          this->CreateForwardingQueue(output_idx, child_runtime, input_index);
+          this->CreateForwardingQueue(output_idx, child_runtime, input_index, queue_capacity);
         },
         runtime_idx_);
 
@@ -1059,10 +1404,15 @@ class BackendRuntime : public BasicRuntime {
     }
     notify->second->Notify();
   }
-  /*!\brief Creating a NDArray containing same shape and data type with a module output. */
+  /*!
+   * \brief Creating a NDArray containing same shape and data type with a request of a module
+   *  output.
+   */
   NDArray CreateFromOutput(int idx) {
     NDArray data = get_output_(idx);
-    return CreateNDArrayFromDLTensor(const_cast<DLTensor*>(data.operator->()));
+    std::vector<int64_t> shape;
+    DLTensor request = RequestView(data.operator->(), 0, &shape);
+    return CreateNDArrayFromDLTensor(&request);
   }
   /*!\brief Return the number of output*/
   int NumOutputs() const { return get_num_output_(); }
@@ -1071,6 +1421,12 @@ class BackendRuntime : public BasicRuntime {
   /*!\brief Setting the data to this runtime via input index.*/
   void SetInput(const int index, DLTensor* data_in) {
     NDArray input = get_input_(index);
+    auto bound = bound_inputs_.find(index);
+    if (bound != bound_inputs_.end()) {
+      // Pointing the input back at its own storage, which the copy goes to.
+      set_input_zero_copy_(index, input);
+      bound_inputs_.erase(bound);
+    }
     DLTensor* dltensor_input = const_cast<DLTensor*>(input.operator->());
     CopyFromTo(data_in, dltensor_input);
   }
@@ -1092,7 +1448,23 @@ class BackendRuntime : public BasicRuntime {
    * \return Returning false if the forwarding function failed. Otherwise, returning true.;
    */
   bool RunPipeline() {
+    if (HandsOverOutputs()) {
+      for (const auto& child : children_) {
+        if (!BindOutputBuffer(child.first)) {
+          return false;
+        }
+      }
+    }
+    auto start = std::chrono::steady_clock::now();
     Run();
+    auto end = std::chrono::steady_clock::now();
+    run_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    if (profiling_) {
+      std::lock_guard<std::mutex> lock(trace_mutex_);
+      trace_.emplace_back(start, end);
+    }
+    num_requests_ += batch_size_;
+    num_runs_++;
     bool ret = ForwardingOutputDataToChildren();
     pipeline_execution_count_++;
     return ret;
@@ -1153,8 +1525,18 @@ class GlobalRuntime : public BasicRuntime {
     for (auto queue_pair : input_queue_) {
       auto output_index = queue_pair.first;
       auto queue = queue_pair.second;
-      QueueData data(const_cast<DLTensor*>(((*outputs)[output_index]).operator->()));
-      if (!queue->Poll<QueueData>(&data)) {
+      bool polled = queue->PollWith([&](QueueData* data) {
+        if (data->IsHandedOver()) {
+          // The output buffer is given to the caller, the backend writes its next outputs to
+          // other buffers.
+          outputs->Set(output_index, data->GetNDArray());
+        } else {
+          NDArray output = (*outputs)[output_index];
+          output.CopyFrom(data->GetDLData());
+        }
+        data->Release();
+      });
+      if (!polled) {
         LOG(FATAL) << "There is no data in the data queue, it should not happen!";
       }
     }
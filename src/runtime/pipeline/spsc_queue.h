@@ -18,6 +18,7 @@
  */
 #ifndef TVM_RUNTIME_PIPELINE_SPSC_QUEUE_H_
 #define TVM_RUNTIME_PIPELINE_SPSC_QUEUE_H_
+#include <atomic>
 #include <cstddef>
 #include <thread>
 /*!\brief A single producer and single consumer lock free queue.
@@ -40,6 +41,26 @@ class SPSCLockFreeQueue {
     read_barrier();
     return head_ == tail_;
   }
+  /*!\brief Getting the number of data in the queue.*/
+  size_t Size() {
+    read_barrier();
+    return (tail_ + len_ - head_) % len_;
+  }
+  /*!\brief Getting the most data the queue can hold.*/
+  size_t Capacity() const { return len_ - 1; }
+  /*!
+   * \brief Bounding the number of data the queue holds. Only call this function while the queue
+   *  is empty and neither the producer nor the consumer uses it.
+   * \param capacity The most data the queue holds, at most 'QueueLength - 1'.
+   * \return Return false when the capacity is out of range or the queue is not empty.
+   */
+  bool SetCapacity(size_t capacity) {
+    if (capacity == 0 || capacity >= QueueLength || !Empty()) return false;
+    head_ = tail_ = 0;
+    len_ = capacity + 1;
+    write_barrier();
+    return true;
+  }
   /*!
    * \brief Pushing the data into the queue. Only a single producer will call this function.
    * \param data The data which is pushed into the queue.
@@ -67,6 +88,21 @@ class SPSCLockFreeQueue {
     head_ = (head_ + 1) % len_;
     return true;
   }
+  /*!
+   * \brief Consume the data at the front of the queue in place, without copying it out of its
+   *  slot. Only the single consumer will call this function.
+   * \param consume The function called with a pointer to the slot, the slot is handed back to
+   *  the producer once it returns.
+   * \return Returning false when the queue is empty. Otherwise, return true.
+   */
+  template <typename ConsumeFunc>
+  bool PollWith(ConsumeFunc consume) {
+    if (Empty()) return false;
+    consume(&queue_[head_]);
+    write_barrier();
+    head_ = (head_ + 1) % len_;
+    return true;
+  }
 
  private:
   /*!\brief The pointer points to the first slot with valid data in the queue.*/
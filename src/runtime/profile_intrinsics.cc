@@ -0,0 +1,210 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file profile_intrinsics.cc
+ * \brief Runtime of the start_profile_intrinsic and end_profile_intrinsic builtins.
+ */
+#include <tvm/runtime/c_backend_api.h>
+#include <tvm/runtime/profiling.h>
+#include <tvm/runtime/registry.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace profiling {
+
+namespace {
+
+/*! \brief A recorded event, the id is shifted left by one with the end flag in the low bit. */
+struct ProfileEvent {
+  uint32_t tag;
+  uint64_t stamp;
+};
+
+/*! \brief The events of one thread, only written by that thread. */
+struct ProfileRing {
+  std::unique_ptr<ProfileEvent[]> events{new ProfileEvent[kProfileIntrinsicRingEntries]};
+  /*! \brief The number of events ever written since the last start. */
+  std::atomic<uint64_t> head{0};
+  /*! \brief The index of the thread in the report. */
+  int64_t thread{0};
+};
+
+// Read the cycle counter, the steady clock in nanoseconds is the fallback.
+inline uint64_t ReadTimestamp() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t value;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+  return value;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+class ProfileIntrinsicsState {
+ public:
+  static ProfileIntrinsicsState* Global() {
+    static ProfileIntrinsicsState* inst = new ProfileIntrinsicsState();
+    return inst;
+  }
+
+  // The ring of the calling thread, the rings are kept alive after their threads exit.
+  ProfileRing* ThreadRing() {
+    thread_local ProfileRing* ring = nullptr;
+    if (ring == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex);
+      rings.emplace_back(new ProfileRing());
+      ring = rings.back().get();
+      ring->thread = static_cast<int64_t>(rings.size()) - 1;
+    }
+    return ring;
+  }
+
+  std::atomic<bool> enabled{false};
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ProfileRing>> rings;
+  uint64_t start_stamp{0};
+  std::chrono::steady_clock::time_point start_time;
+};
+
+}  // namespace
+
+void StartProfileIntrinsics() {
+  ProfileIntrinsicsState* state = ProfileIntrinsicsState::Global();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  ICHECK(!state->enabled.load(std::memory_order_relaxed))
+      << "The profile intrinsics are already being recorded";
+  for (auto& ring : state->rings) {
+    ring->head.store(0, std::memory_order_relaxed);
+  }
+  state->start_time = std::chrono::steady_clock::now();
+  state->start_stamp = ReadTimestamp();
+  state->enabled.store(true, std::memory_order_release);
+}
+
+Report StopProfileIntrinsics() {
+  ProfileIntrinsicsState* state = ProfileIntrinsicsState::Global();
+  std::lock_guard<std::mutex> lock(state->mutex);
+  ICHECK(state->enabled.load(std::memory_order_relaxed))
+      << "The profile intrinsics are not being recorded, call StartProfileIntrinsics first";
+  state->enabled.store(false, std::memory_order_release);
+  uint64_t stop_stamp = ReadTimestamp();
+  double elapsed_us = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+                          std::chrono::steady_clock::now() - state->start_time)
+                          .count();
+  // Calibrate the counter against the steady clock over the recording.
+  double ticks_per_us =
+      elapsed_us > 0 ? static_cast<double>(stop_stamp - state->start_stamp) / elapsed_us : 1.0;
+  if (ticks_per_us <= 0) ticks_per_us = 1.0;
+  auto to_us = [&](uint64_t ticks) { return static_cast<double>(ticks) / ticks_per_us; };
+
+  String device = "cpu0";
+  Array<Map<String, ObjectRef>> calls;
+  int64_t dropped = 0;
+  for (const auto& ring : state->rings) {
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t begin = head > kProfileIntrinsicRingEntries ? head - kProfileIntrinsicRingEntries : 0;
+    // The timestamps of the open starts of every id, a stack as regions of an id can recurse.
+    std::unordered_map<uint32_t, std::vector<uint64_t>> open;
+    for (uint64_t i = begin; i < head; ++i) {
+      const ProfileEvent& event = ring->events[i % kProfileIntrinsicRingEntries];
+      uint32_t id = event.tag >> 1;
+      if ((event.tag & 1) == 0) {
+        open[id].push_back(event.stamp);
+        continue;
+      }
+      auto it = open.find(id);
+      if (it == open.end() || it->second.empty()) {
+        ++dropped;
+        continue;
+      }
+      uint64_t start = it->second.back();
+      it->second.pop_back();
+      double duration_us = to_us(event.stamp - start);
+      Map<String, ObjectRef> call;
+      call.Set("Name", String("region_" + std::to_string(id)));
+      call.Set("Device", device);
+      call.Set("Count", ObjectRef(make_object<CountNode>(1)));
+      call.Set("Duration (us)", ObjectRef(make_object<DurationNode>(duration_us)));
+      call.Set("Percent", ObjectRef(make_object<PercentNode>(
+                              elapsed_us > 0 ? duration_us / elapsed_us * 100 : 0)));
+      call.Set("Start (us)", ObjectRef(make_object<DurationNode>(
+                                 start > state->start_stamp ? to_us(start - state->start_stamp)
+                                                            : 0)));
+      call.Set("Thread", ObjectRef(make_object<CountNode>(ring->thread)));
+      calls.push_back(call);
+    }
+    for (const auto& kv : open) {
+      dropped += static_cast<int64_t>(kv.second.size());
+    }
+    if (begin != 0) {
+      // The oldest events were overwritten.
+      dropped += static_cast<int64_t>(begin);
+    }
+  }
+
+  Map<String, ObjectRef> total;
+  total.Set("Name", String("Total"));
+  total.Set("Duration (us)", ObjectRef(make_object<DurationNode>(elapsed_us)));
+  Map<String, ObjectRef> configuration;
+  configuration.Set("Executor", String("Profile Intrinsics"));
+  configuration.Set("Dropped Events", ObjectRef(make_object<CountNode>(dropped)));
+  return Report(calls, {{device, total}}, configuration);
+}
+
+TVM_REGISTER_GLOBAL("runtime.profiling.StartProfileIntrinsics")
+    .set_body_typed(StartProfileIntrinsics);
+
+TVM_REGISTER_GLOBAL("runtime.profiling.StopProfileIntrinsics")
+    .set_body_typed(StopProfileIntrinsics);
+
+}  // namespace profiling
+}  // namespace runtime
+}  // namespace tvm
+
+int TVMBackendProfileIntrinsic(int32_t id, int32_t is_end) {
+  using tvm::runtime::profiling::ProfileIntrinsicsState;
+  ProfileIntrinsicsState* state = ProfileIntrinsicsState::Global();
+  if (!state->enabled.load(std::memory_order_relaxed)) return 0;
+  uint64_t stamp = tvm::runtime::profiling::ReadTimestamp();
+  tvm::runtime::profiling::ProfileRing* ring = state->ThreadRing();
+  uint64_t head = ring->head.load(std::memory_order_relaxed);
+  ring->events[head % tvm::runtime::profiling::kProfileIntrinsicRingEntries] = {
+      (static_cast<uint32_t>(id) << 1) | (is_end != 0), stamp};
+  ring->head.store(head + 1, std::memory_order_release);
+  return 0;
+}
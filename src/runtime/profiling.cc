@@ -30,7 +30,9 @@
 #include <tvm/runtime/threading_backend.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -118,6 +120,13 @@ TVM_REGISTER_GLOBAL("profiling.start_timer").set_body_typed(Timer::Start);
 
 namespace profiling {
 
+// A small index for the calling thread, so that timelines get readable thread ids.
+static int64_t CurrentThreadIndex() {
+  static std::atomic<int64_t> num_threads{0};
+  thread_local int64_t index = num_threads++;
+  return index;
+}
+
 Profiler::Profiler(std::vector<Device> devs, std::vector<MetricCollector> metric_collectors,
                    std::unordered_map<String, ObjectRef> configuration)
     : devs_(devs), collectors_(metric_collectors), configuration_(configuration) {
@@ -138,6 +147,7 @@ Profiler::Profiler(std::vector<Device> devs, std::vector<MetricCollector> metric
 
 void Profiler::Start() {
   is_running_ = true;
+  start_time_ = std::chrono::steady_clock::now();
   for (auto dev : devs_) {
     StartCall("Total", dev, {});
   }
@@ -152,7 +162,9 @@ void Profiler::StartCall(String name, Device dev,
       objs.emplace_back(collector, obj);
     }
   }
-  in_flight_.push(CallFrame{dev, name, Timer::Start(dev), extra_metrics, objs});
+  std::chrono::duration<double, std::micro> start = std::chrono::steady_clock::now() - start_time_;
+  in_flight_.push(CallFrame{dev, name, Timer::Start(dev), extra_metrics, objs, start.count(),
+                            CurrentThreadIndex()});
 }
 
 void Profiler::StopCall(std::unordered_map<std::string, ObjectRef> extra_metrics) {
@@ -581,6 +593,8 @@ String ReportNode::AsTable(bool sort, bool aggregate, bool compute_col_sums) con
   std::set<std::string> unique_headers;
   for (auto row : aggregated_calls) {
     for (auto p : row) {
+      // the timeline metrics are meaningless once calls are aggregated, see AsChromeTrace
+      if (p.first == "Start (us)" || p.first == "Thread") continue;
       unique_headers.insert(p.first);
     }
   }
@@ -651,6 +665,61 @@ String ReportNode::AsTable(bool sort, bool aggregate, bool compute_col_sums) con
   return s.str();
 }
 
+String ReportNode::AsChromeTrace() const {
+  std::ostringstream s;
+  s << std::setprecision(3) << std::fixed;
+  // Processes in the trace format are numbered, give one to every device in order of appearance.
+  std::vector<std::string> devices;
+  bool first = true;
+  auto write_event = [&](const Map<String, ObjectRef>& call, const std::string& name) {
+    auto start = call.find("Start (us)");
+    auto duration = call.find("Duration (us)");
+    // Reports from before timestamps were recorded have no timeline.
+    if (start == call.end() || duration == call.end()) return;
+    auto device = call.find("Device");
+    std::string device_name = device != call.end() ? Downcast<String>((*device).second) : "";
+    size_t pid = std::find(devices.begin(), devices.end(), device_name) - devices.begin();
+    if (pid == devices.size()) {
+      devices.push_back(device_name);
+    }
+    auto thread = call.find("Thread");
+    int64_t tid = thread != call.end() ? (*thread).second.as<CountNode>()->value : 0;
+
+    s << (first ? "" : ",") << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"ts\":"
+      << (*start).second.as<DurationNode>()->microseconds
+      << ",\"dur\":" << (*duration).second.as<DurationNode>()->microseconds << ",\"pid\":" << pid
+      << ",\"tid\":" << tid << ",\"args\":{";
+    bool first_arg = true;
+    for (const auto& kv : call) {
+      if (kv.first == "Name" || kv.first == "Start (us)" || kv.first == "Duration (us)" ||
+          kv.first == "Device" || kv.first == "Thread") {
+        continue;
+      }
+      s << (first_arg ? "" : ",") << "\"" << kv.first << "\":\"" << print_metric(kv.second)
+        << "\"";
+      first_arg = false;
+    }
+    s << "}}";
+    first = false;
+  };
+
+  s << "{\"traceEvents\":[";
+  for (const auto& call : calls) {
+    write_event(call, Downcast<String>(call["Name"]));
+  }
+  for (const auto& kv : device_metrics) {
+    write_event(kv.second, "Total");
+  }
+  // metadata events naming the processes after their devices
+  for (size_t i = 0; i < devices.size(); i++) {
+    s << (first ? "" : ",") << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << i
+      << ",\"args\":{\"name\":\"" << devices[i] << "\"}}";
+    first = false;
+  }
+  s << "],\"displayTimeUnit\":\"ns\"}";
+  return s.str();
+}
+
 std::string DeviceString(Device dev) {
   return DeviceName(dev.device_type) + std::to_string(dev.device_id);
 }
@@ -665,6 +734,8 @@ Report Profiler::Report() {
     row["Count"] = ObjectRef(make_object<CountNode>(1));
     row["Name"] = cf.name;
     row["Device"] = String(DeviceString(cf.dev));
+    row["Start (us)"] = ObjectRef(make_object<DurationNode>(cf.start_us));
+    row["Thread"] = ObjectRef(make_object<CountNode>(cf.thread));
     for (auto p : cf.extra_metrics) {
       row[p.first] = p.second;
     }
@@ -697,6 +768,68 @@ Report Profiler::Report() {
   return profiling::Report(converted_rows, device_metrics, configuration_);
 }
 
+void SamplingProfiler::SetInterval(int64_t interval) {
+  ICHECK_GE(interval, 0) << "The sampling interval can not be negative";
+  std::lock_guard<std::mutex> lock(mutex_);
+  interval_ = interval;
+  num_sampled_ = 0;
+  pending_.clear();
+  ops_.clear();
+}
+
+void SamplingProfiler::ResolvePending() {
+  for (auto& op : pending_) {
+    if (ops_.size() <= op.index) {
+      ops_.resize(op.index + 1);
+    }
+    OpSamples& samples = ops_[op.index];
+    samples.name = op.name;
+    samples.dev = op.dev;
+    double us = op.timer->SyncAndGetElapsedNanos() / 1e3;
+    if (samples.window_us.size() < kSampleWindow) {
+      samples.window_us.push_back(us);
+    } else {
+      samples.window_us[samples.next] = us;
+    }
+    samples.next = (samples.next + 1) % kSampleWindow;
+    samples.count++;
+    samples.sum_us += us;
+  }
+  pending_.clear();
+}
+
+Report SamplingProfiler::Report() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ResolvePending();
+  Array<Map<String, ObjectRef>> calls;
+  for (const auto& samples : ops_) {
+    if (samples.count == 0) continue;
+    std::vector<double> sorted = samples.window_us;
+    std::sort(sorted.begin(), sorted.end());
+    // nearest rank percentile of the window
+    auto percentile = [&](double p) {
+      size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+      return ObjectRef(make_object<DurationNode>(sorted[std::max<size_t>(rank, 1) - 1]));
+    };
+    Map<String, ObjectRef> call;
+    call.Set("Name", samples.name);
+    call.Set("Device", String(DeviceString(samples.dev)));
+    call.Set("Count", ObjectRef(make_object<CountNode>(samples.count)));
+    call.Set("Duration (us)",
+             ObjectRef(make_object<DurationNode>(samples.sum_us / samples.count)));
+    call.Set("p50 (us)", percentile(0.5));
+    call.Set("p90 (us)", percentile(0.9));
+    call.Set("p99 (us)", percentile(0.99));
+    calls.push_back(call);
+  }
+  Map<String, ObjectRef> configuration;
+  configuration.Set("Executor", executor_);
+  configuration.Set("Sampling Interval",
+                    ObjectRef(make_object<CountNode>(interval_.load(std::memory_order_relaxed))));
+  configuration.Set("Sampled Requests", ObjectRef(make_object<CountNode>(num_sampled_)));
+  return profiling::Report(calls, {}, configuration);
+}
+
 Report::Report(Array<Map<String, ObjectRef>> calls,
                Map<String, Map<String, ObjectRef>> device_metrics,
                Map<String, ObjectRef> configuration) {
@@ -793,6 +926,9 @@ TVM_REGISTER_GLOBAL("runtime.profiling.AsCSV").set_body_typed([](Report n) { ret
 TVM_REGISTER_GLOBAL("runtime.profiling.AsJSON").set_body_typed([](Report n) {
   return n->AsJSON();
 });
+TVM_REGISTER_GLOBAL("runtime.profiling.AsChromeTrace").set_body_typed([](Report n) {
+  return n->AsChromeTrace();
+});
 TVM_REGISTER_GLOBAL("runtime.profiling.FromJSON").set_body_typed(Report::FromJSON);
 TVM_REGISTER_GLOBAL("runtime.profiling.DeviceWrapper").set_body_typed([](Device dev) {
   return DeviceWrapper(dev);
@@ -861,8 +997,11 @@ TVM_REGISTER_GLOBAL("runtime.profiling.ProfileFunction")
 
 PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat, int min_repeat_ms,
                              int limit_zero_time_iterations, int cooldown_interval_ms,
-                             int repeats_to_cooldown, PackedFunc f_preproc) {
+                             int repeats_to_cooldown, PackedFunc f_preproc, double max_rel_ci,
+                             int max_measure_ms) {
   ICHECK(pf != nullptr);
+  ICHECK(max_rel_ci <= 0 || max_measure_ms > 0)
+      << "The adaptive time evaluator needs a cap on the measurement time";
 
   if (static_cast<int>(dev.device_type) == static_cast<int>(kDLMicroDev)) {
     auto get_micro_time_evaluator = runtime::Registry::Get("micro._GetMicroTimeEvaluator");
@@ -871,8 +1010,8 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
   }
 
   auto ftimer = [pf, dev, number, repeat, min_repeat_ms, limit_zero_time_iterations,
-                 cooldown_interval_ms, repeats_to_cooldown,
-                 f_preproc](TVMArgs args, TVMRetValue* rv) mutable {
+                 cooldown_interval_ms, repeats_to_cooldown, f_preproc, max_rel_ci,
+                 max_measure_ms](TVMArgs args, TVMRetValue* rv) mutable {
     TVMRetValue temp;
     std::ostringstream os;
     // skip first time call, to activate lazy compilation components.
@@ -880,7 +1019,23 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
 
     DeviceAPI::Get(dev)->StreamSync(dev, nullptr);
 
-    for (int i = 0; i < repeat; ++i) {
+    // The running mean and sum of squared deviations of the repeats, by Welford's method.
+    double mean = 0.0;
+    double m2 = 0.0;
+    auto converged = [&](int n) {
+      if (n < 2 || mean <= 0.0) return false;
+      // The half width of the 95% confidence interval on the mean, relative to the mean.
+      double half_width = 1.96 * std::sqrt(m2 / (n - 1) / n);
+      return half_width <= max_rel_ci * mean;
+    };
+    auto begin = std::chrono::steady_clock::now();
+    auto out_of_time = [&]() {
+      auto elapsed = std::chrono::steady_clock::now() - begin;
+      return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() >=
+             max_measure_ms;
+    };
+
+    for (int i = 0; i < repeat || (max_rel_ci > 0 && !converged(i) && !out_of_time()); ++i) {
       if (f_preproc != nullptr) {
         f_preproc.CallPacked(args, &temp);
       }
@@ -906,6 +1061,9 @@ PackedFunc WrapTimeEvaluator(PackedFunc pf, Device dev, int number, int repeat,
 
       double speed = duration_ms / 1e3 / number;
       os.write(reinterpret_cast<char*>(&speed), sizeof(speed));
+      double delta = speed - mean;
+      mean += delta / (i + 1);
+      m2 += delta * (speed - mean);
 
       if (cooldown_interval_ms > 0 && (i % repeats_to_cooldown) == 0) {
         std::this_thread::sleep_for(std::chrono::milliseconds(cooldown_interval_ms));
@@ -0,0 +1,166 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file read_mostly_map.h
+ * \brief A hash map from keys to pointers, with lookups that never lock.
+ */
+#ifndef TVM_RUNTIME_READ_MOSTLY_MAP_H_
+#define TVM_RUNTIME_READ_MOSTLY_MAP_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief A hash map from keys to pointers, for the process-wide registries that are looked up
+ *  far more often than they are updated.
+ *
+ *  The writers are serialized by a mutex, while Find only follows atomic pointers. An entry is
+ *  published once fully constructed and then never freed nor unlinked: erasing it clears its
+ *  value, and growing the map publishes a new bucket array, leaking the old one to the readers
+ *  still walking it. The memory kept this way is bounded by twice the size of the final map.
+ *
+ * \tparam K The key type, hashed with std::hash.
+ * \tparam V The pointee type of the values.
+ */
+template <typename K, typename V>
+class ReadMostlyMap {
+ public:
+  ReadMostlyMap() : table_(new Table(kInitialBuckets)) {}
+  ReadMostlyMap(const ReadMostlyMap&) = delete;
+  ReadMostlyMap& operator=(const ReadMostlyMap&) = delete;
+
+  /*! \return The value of \p key, or nullptr if it is not in the map. */
+  V* Find(const K& key) const {
+    size_t hash = std::hash<K>()(key);
+    const Table* table = table_.load(std::memory_order_acquire);
+    for (const Entry* e = table->Head(hash); e != nullptr; e = e->next) {
+      if (e->hash == hash && e->key == key) return e->value.load(std::memory_order_acquire);
+    }
+    return nullptr;
+  }
+
+  /*!
+   * \brief Set the value of \p key.
+   * \param overwrite Whether to replace the value of \p key if it is in the map already.
+   * \return The previous value of \p key, or nullptr if it was not in the map.
+   */
+  V* Set(const K& key, V* value, bool overwrite = true) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t hash = std::hash<K>()(key);
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (Entry* e = table->Lookup(hash, key)) {
+      V* prev = e->value.load(std::memory_order_relaxed);
+      if (prev == nullptr || overwrite) e->value.store(value, std::memory_order_release);
+      return prev;
+    }
+    if (table->num_entries >= table->buckets.size()) {
+      table = Grow(table);
+    }
+    table->Insert(new Entry(key, hash, value));
+    return nullptr;
+  }
+
+  /*! \return The removed value of \p key, or nullptr if it was not in the map. */
+  V* Erase(const K& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry* e = table_.load(std::memory_order_relaxed)->Lookup(std::hash<K>()(key), key);
+    return e != nullptr ? e->value.exchange(nullptr, std::memory_order_acq_rel) : nullptr;
+  }
+
+  /*! \brief Call \p f with each key and value in the map. */
+  template <typename F>
+  void ForEach(F f) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& head : table_.load(std::memory_order_relaxed)->buckets) {
+      for (const Entry* e = head.load(std::memory_order_relaxed); e != nullptr; e = e->next) {
+        if (V* value = e->value.load(std::memory_order_relaxed)) f(e->key, value);
+      }
+    }
+  }
+
+ private:
+  static constexpr size_t kInitialBuckets = 1024;
+
+  struct Entry {
+    Entry(const K& key, size_t hash, V* value) : key(key), hash(hash), value(value) {}
+    const K key;
+    const size_t hash;
+    std::atomic<V*> value;
+    // Set before the entry is published, immutable afterwards.
+    Entry* next{nullptr};
+  };
+
+  struct Table {
+    explicit Table(size_t num_buckets) : buckets(num_buckets) {}
+
+    const Entry* Head(size_t hash) const {
+      return buckets[hash & (buckets.size() - 1)].load(std::memory_order_acquire);
+    }
+
+    Entry* Lookup(size_t hash, const K& key) const {
+      for (Entry* e = buckets[hash & (buckets.size() - 1)].load(std::memory_order_relaxed);
+           e != nullptr; e = e->next) {
+        if (e->hash == hash && e->key == key) return e;
+      }
+      return nullptr;
+    }
+
+    void Insert(Entry* e) {
+      std::atomic<Entry*>& head = buckets[e->hash & (buckets.size() - 1)];
+      e->next = head.load(std::memory_order_relaxed);
+      head.store(e, std::memory_order_release);
+      ++num_entries;
+    }
+
+    // The number of buckets is a power of two.
+    std::vector<std::atomic<Entry*>> buckets;
+    size_t num_entries{0};
+  };
+
+  /*! \brief Publish a copy of \p table with twice the buckets and without the erased entries. */
+  Table* Grow(const Table* table) {
+    Table* grown = new Table(table->buckets.size() * 2);
+    for (const auto& head : table->buckets) {
+      for (const Entry* e = head.load(std::memory_order_relaxed); e != nullptr; e = e->next) {
+        if (V* value = e->value.load(std::memory_order_relaxed)) {
+          grown->Insert(new Entry(e->key, e->hash, value));
+        }
+      }
+    }
+    table_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  std::atomic<Table*> table_;
+  // Serializes the writers.
+  mutable std::mutex mutex_;
+};
+
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_READ_MOSTLY_MAP_H_
@@ -29,8 +29,8 @@
 #include <array>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
+#include "read_mostly_map.h"
 #include "runtime_base.h"
 
 namespace tvm {
@@ -42,9 +42,8 @@ struct Registry::Manager {
   // This is because PackedFunc can contain callbacks into the host language (Python) and the
   // resource can become invalid because of indeterministic order of destruction and forking.
   // The resources will only be recycled during program exit.
-  std::unordered_map<String, Registry*> fmap;
-  // mutex
-  std::mutex mutex;
+  // Looked up without locking by every TVMFuncGetGlobal, e.g. from the FFI of each thread.
+  ReadMostlyMap<String, Registry> fmap;
 
   Manager() {}
 
@@ -64,42 +63,28 @@ Registry& Registry::set_body(PackedFunc f) {  // NOLINT(*)
 
 Registry& Registry::Register(const String& name, bool can_override) {  // NOLINT(*)
   Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  if (m->fmap.count(name)) {
-    ICHECK(can_override) << "Global PackedFunc " << name << " is already registered";
-  }
-
   Registry* r = new Registry();
   r->name_ = name;
-  m->fmap[name] = r;
+  if (m->fmap.Set(name, r, can_override) != nullptr && !can_override) {
+    delete r;
+    LOG(FATAL) << "Global PackedFunc " << name << " is already registered";
+  }
   return *r;
 }
 
 bool Registry::Remove(const String& name) {
-  Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return false;
-  m->fmap.erase(it);
-  return true;
+  return Manager::Global()->fmap.Erase(name) != nullptr;
 }
 
 const PackedFunc* Registry::Get(const String& name) {
-  Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
-  auto it = m->fmap.find(name);
-  if (it == m->fmap.end()) return nullptr;
-  return &(it->second->func_);
+  Registry* r = Manager::Global()->fmap.Find(name);
+  if (r == nullptr) return nullptr;
+  return &(r->func_);
 }
 
 std::vector<String> Registry::ListNames() {
-  Manager* m = Manager::Global();
-  std::lock_guard<std::mutex> lock(m->mutex);
   std::vector<String> keys;
-  keys.reserve(m->fmap.size());
-  for (const auto& kv : m->fmap) {
-    keys.push_back(kv.first);
-  }
+  Manager::Global()->fmap.ForEach([&keys](const String& name, Registry*) { keys.push_back(name); });
   return keys;
 }
 
@@ -163,6 +163,27 @@ class ROCMDeviceAPI final : public DeviceAPI {
     }
   }
 
+  TVMStreamHandle CreateStream(Device dev) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    hipStream_t retval;
+    ROCM_CALL(hipStreamCreate(&retval));
+    return static_cast<TVMStreamHandle>(retval);
+  }
+
+  void FreeStream(Device dev, TVMStreamHandle stream) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    ROCM_CALL(hipStreamDestroy(static_cast<hipStream_t>(stream)));
+  }
+
+  void SyncStreamFromTo(Device dev, TVMStreamHandle event_src, TVMStreamHandle event_dst) final {
+    ROCM_CALL(hipSetDevice(dev.device_id));
+    hipEvent_t evt;
+    ROCM_CALL(hipEventCreateWithFlags(&evt, hipEventDisableTiming));
+    ROCM_CALL(hipEventRecord(evt, static_cast<hipStream_t>(event_src)));
+    ROCM_CALL(hipStreamWaitEvent(static_cast<hipStream_t>(event_dst), evt, 0));
+    ROCM_CALL(hipEventDestroy(evt));
+  }
+
   void StreamSync(Device dev, TVMStreamHandle stream) final {
     ROCM_CALL(hipSetDevice(dev.device_id));
     ROCM_CALL(hipStreamSynchronize(static_cast<hipStream_t>(stream)));
@@ -172,6 +193,10 @@ class ROCMDeviceAPI final : public DeviceAPI {
     ROCMThreadEntry::ThreadLocal()->stream = static_cast<hipStream_t>(stream);
   }
 
+  TVMStreamHandle GetCurrentStream(Device dev) final {
+    return static_cast<TVMStreamHandle>(ROCMThreadEntry::ThreadLocal()->stream);
+  }
+
   void* AllocWorkspace(Device dev, size_t size, DLDataType type_hint) final {
     return ROCMThreadEntry::ThreadLocal()->pool.AllocWorkspace(dev, size);
   }
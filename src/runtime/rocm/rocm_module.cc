@@ -191,6 +191,7 @@ class ROCMWrappedFunc {
 PackedFunc ROCMModuleNode::GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) {
   ICHECK_EQ(sptr_to_self.get(), this);
   ICHECK_NE(name, symbol::tvm_module_main) << "Device function do not have main";
+  if (name == "get_func_names") return GetFuncNamesFunc(fmap_, sptr_to_self);
   auto it = fmap_.find(name);
   if (it == fmap_.end()) return PackedFunc();
   const FunctionInfo& info = it->second;
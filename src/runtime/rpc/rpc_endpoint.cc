@@ -653,23 +653,74 @@ RPCCode RPCEndpoint::HandleUntilReturnEvent(bool client_mode, RPCSession::FEncod
   return code;
 }
 
+void RPCEndpoint::FlushWriter() {
+  CHECK(channel_) << "Expected connection to server " << name_
+                  << " to be active, but the connection was previously closed";
+  while (writer_.bytes_available() != 0) {
+    size_t n = writer_.ReadWithCallback(
+        [this](const void* data, size_t size) { return channel_->Send(data, size); },
+        writer_.bytes_available());
+    if (n == 0) break;
+  }
+}
+
+uint64_t RPCEndpoint::AddPendingRequest(RPCCode code, void* to_bytes, uint64_t nbytes,
+                                        RPCSession::FAsyncCallback callback) {
+  uint64_t seq = ++last_request_seq_;
+  pending_requests_.push_back(PendingRequest{seq, code, to_bytes, nbytes, std::move(callback)});
+  // Push the request out so that the remote starts serving it.
+  this->FlushWriter();
+  return seq;
+}
+
+void RPCEndpoint::FinishPendingRequest() {
+  PendingRequest request = std::move(pending_requests_.front());
+  pending_requests_.pop_front();
+  // An error raised by the callback itself is not an error of the request.
+  bool returned = false;
+  try {
+    if (request.code == RPCCode::kCopyFromRemote) {
+      ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kCopyAck);
+      handler_->ReadArray(reinterpret_cast<char*>(request.to_bytes), request.nbytes);
+      handler_->FinishCopyAck();
+      TVMValue value;
+      int32_t tcode = kTVMNullptr;
+      value.v_handle = nullptr;
+      returned = true;
+      request.callback(RPCCode::kReturn, TVMArgs(&value, &tcode, 1));
+    } else {
+      RPCCode code = HandleUntilReturnEvent(true, [&](TVMArgs args) {
+        returned = true;
+        request.callback(RPCCode::kReturn, args);
+      });
+      ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
+    }
+  } catch (const std::exception& e) {
+    if (returned) throw;
+    TVMValue value;
+    int32_t tcode = kTVMStr;
+    value.v_str = e.what();
+    request.callback(RPCCode::kException, TVMArgs(&value, &tcode, 1));
+  }
+}
+
+void RPCEndpoint::FinishPendingRequests(uint64_t seq) {
+  while (!pending_requests_.empty() && pending_requests_.front().seq <= seq) {
+    this->FinishPendingRequest();
+  }
+}
+
 void RPCEndpoint::Init() {
   // callback to flush the writer.
-  auto flush_writer = [this]() {
-    while (writer_.bytes_available() != 0) {
-      size_t n = writer_.ReadWithCallback(
-          [this](const void* data, size_t size) { return channel_->Send(data, size); },
-          writer_.bytes_available());
-      if (n == 0) break;
-    }
-  };
+  auto flush_writer = [this]() { this->FlushWriter(); };
 
   // Event handler
   handler_ = std::make_shared<EventHandler>(&reader_, &writer_, name_, &remote_key_, flush_writer);
 
   // Quick function to for syscall remote.
   syscall_remote_ = PackedFunc([this](TVMArgs all_args, TVMRetValue* rv) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    this->FinishPendingRequests(last_request_seq_);
     RPCCode code = static_cast<RPCCode>(all_args[0].operator int());
     TVMArgs args(all_args.values + 1, all_args.type_codes + 1, all_args.num_args - 1);
 
@@ -714,6 +765,11 @@ RPCEndpoint::~RPCEndpoint() { this->Shutdown(); }
 
 void RPCEndpoint::Shutdown() {
   if (channel_ != nullptr) {
+    // the requests in flight complete before the connection goes down.
+    try {
+      this->FinishPendingRequests(last_request_seq_);
+    } catch (const Error& e) {
+    }
     RPCCode code = RPCCode::kShutdown;
     uint64_t packet_nbytes = sizeof(code);
 
@@ -765,7 +821,8 @@ int RPCEndpoint::ServerAsyncIOEventHandler(const std::string& in_bytes, int even
 }
 
 void RPCEndpoint::InitRemoteSession(TVMArgs args) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  this->FinishPendingRequests(last_request_seq_);
   RPCCode code = RPCCode::kInitServer;
   std::string protocol_ver = kRPCProtocolVer;
   uint64_t length = protocol_ver.length();
@@ -785,12 +842,8 @@ void RPCEndpoint::InitRemoteSession(TVMArgs args) {
   ICHECK(code == RPCCode::kReturn) << "code=" << static_cast<int>(code);
 }
 
-// Get remote function with name
-void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
-                           const int* arg_type_codes, int num_args,
-                           RPCSession::FEncodeReturn encode_return) {
-  std::lock_guard<std::mutex> lock(mutex_);
-
+void RPCEndpoint::WriteCallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
+                                const int* arg_type_codes, int num_args) {
   handler_->ValidateArguments(arg_values, arg_type_codes, num_args);
   RPCCode code = RPCCode::kCallFunc;
   uint64_t handle = reinterpret_cast<uint64_t>(h);
@@ -803,13 +856,32 @@ void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_v
   handler_->Write(code);
   handler_->Write(handle);
   handler_->SendPackedSeq(arg_values, arg_type_codes, num_args, true);
+}
+
+// Get remote function with name
+void RPCEndpoint::CallFunc(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
+                           const int* arg_type_codes, int num_args,
+                           RPCSession::FEncodeReturn encode_return) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  this->FinishPendingRequests(last_request_seq_);
+  this->WriteCallFunc(h, arg_values, arg_type_codes, num_args);
 
-  code = HandleUntilReturnEvent(true, encode_return);
+  RPCCode code = HandleUntilReturnEvent(true, encode_return);
   ICHECK(code == RPCCode::kReturn) << "code=" << RPCCodeToString(code);
 }
 
-void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+uint64_t RPCEndpoint::CallFuncAsync(RPCSession::PackedFuncHandle h, const TVMValue* arg_values,
+                                    const int* arg_type_codes, int num_args,
+                                    RPCSession::FAsyncCallback callback) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  if (pending_requests_.size() >= kRPCMaxOutstandingRequests) {
+    this->FinishPendingRequest();
+  }
+  this->WriteCallFunc(h, arg_values, arg_type_codes, num_args);
+  return this->AddPendingRequest(RPCCode::kCallFunc, nullptr, 0, std::move(callback));
+}
+
+void RPCEndpoint::WriteCopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
   RPCCode code = RPCCode::kCopyToRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*to));
@@ -825,11 +897,28 @@ void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes)
   RPCReference::SendDLTensor(handler_, to);
   handler_->Write(nbytes);
   handler_->WriteArray(reinterpret_cast<char*>(from_bytes), nbytes);
+}
+
+void RPCEndpoint::CopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  this->FinishPendingRequests(last_request_seq_);
+  this->WriteCopyToRemote(from_bytes, to, nbytes);
   ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kReturn);
 }
 
-void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
-  std::lock_guard<std::mutex> lock(mutex_);
+uint64_t RPCEndpoint::CopyToRemoteAsync(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                                        RPCSession::FAsyncCallback callback) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  // Do not send bulk data while the remote may be blocked on sending bulk data back.
+  this->FinishPendingRequests(last_copy_from_remote_seq_);
+  if (pending_requests_.size() >= kRPCMaxOutstandingRequests) {
+    this->FinishPendingRequest();
+  }
+  this->WriteCopyToRemote(from_bytes, to, nbytes);
+  return this->AddPendingRequest(RPCCode::kCopyToRemote, nullptr, 0, std::move(callback));
+}
+
+void RPCEndpoint::WriteCopyFromRemote(DLTensor* from, uint64_t nbytes) {
   RPCCode code = RPCCode::kCopyFromRemote;
 
   uint64_t tensor_total_size_bytes = static_cast<uint64_t>(GetDataSize(*from));
@@ -844,12 +933,35 @@ void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes
   handler_->Write(code);
   RPCReference::SendDLTensor(handler_, from);
   handler_->Write(nbytes);
+}
+
+void RPCEndpoint::CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  this->FinishPendingRequests(last_request_seq_);
+  this->WriteCopyFromRemote(from, nbytes);
   ICHECK(HandleUntilReturnEvent(true, [](TVMArgs) {}) == RPCCode::kCopyAck);
 
   handler_->ReadArray(reinterpret_cast<char*>(to_bytes), nbytes);
   handler_->FinishCopyAck();
 }
 
+uint64_t RPCEndpoint::CopyFromRemoteAsync(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                                          RPCSession::FAsyncCallback callback) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  if (pending_requests_.size() >= kRPCMaxOutstandingRequests) {
+    this->FinishPendingRequest();
+  }
+  this->WriteCopyFromRemote(from, nbytes);
+  last_copy_from_remote_seq_ =
+      this->AddPendingRequest(RPCCode::kCopyFromRemote, to_bytes, nbytes, std::move(callback));
+  return last_copy_from_remote_seq_;
+}
+
+void RPCEndpoint::WaitForRequests(uint64_t seq) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  this->FinishPendingRequests(seq);
+}
+
 // SysCallEventHandler functions
 void RPCGetGlobalFunc(RPCSession* handler, TVMArgs args, TVMRetValue* rv) {
   std::string name = args[0];
@@ -1016,58 +1128,76 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
     endpoint_->CallFunc(func, arg_values, arg_type_codes, num_args, fencode_return);
   }
 
+  // Large copies are streamed in chunks with a window of chunks in flight, so that the
+  // transfer of a chunk overlaps with the remote writing the previous ones into place.
   void CopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes) final {
-    RPCCode code = RPCCode::kCopyToRemote;
-    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_to, code, nbytes);
-    uint64_t rpc_max_size = GetRPCMaxTransferSize();
-    ICHECK_GT(rpc_max_size, overhead) << "CopyToRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* from_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, block_size);
+    std::string error;
+    uint64_t seq = SubmitCopyToRemote(local_from_bytes, remote_to, nbytes,
+                                      [&error](RPCCode status, TVMArgs args) {
+                                        if (status == RPCCode::kException) {
+                                          error = args.values[0].v_str;
+                                        }
+                                      });
+    endpoint_->WaitForRequests(seq);
+    if (!error.empty()) {
+      LOG(FATAL) << error;
     }
+  }
 
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_to->byte_offset = block_count * block_size;
-      from_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_from_bytes) + block_count * block_size));
-      endpoint_->CopyToRemote(from_bytes, remote_to, remainder_bytes);
+  void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) final {
+    std::string error;
+    uint64_t seq = SubmitCopyFromRemote(remote_from, local_to_bytes, nbytes,
+                                        [&error](RPCCode status, TVMArgs args) {
+                                          if (status == RPCCode::kException) {
+                                            error = args.values[0].v_str;
+                                          }
+                                        });
+    endpoint_->WaitForRequests(seq);
+    if (!error.empty()) {
+      LOG(FATAL) << error;
     }
   }
 
-  void CopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes) final {
-    RPCCode code = RPCCode::kCopyFromRemote;
-    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote_from, code, nbytes);
-    uint64_t rpc_max_size = GetRPCMaxTransferSize();
-    ICHECK_GT(rpc_max_size, overhead) << "CopyFromRemote: Invalid block size!";
-    const uint64_t block_size = rpc_max_size - overhead;
-    uint64_t block_count = 0;
-    const uint64_t num_blocks = nbytes / block_size;
-    void* to_bytes;
-
-    for (block_count = 0; block_count < num_blocks; block_count++) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, block_size);
+  uint64_t SubmitCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
+                          const int* arg_type_codes, int num_args,
+                          FAsyncCallback callback) final {
+    return endpoint_->CallFuncAsync(func, arg_values, arg_type_codes, num_args, callback);
+  }
+
+  uint64_t SubmitCopyToRemote(void* local_from_bytes, DLTensor* remote_to, uint64_t nbytes,
+                              FAsyncCallback on_complete) final {
+    if (nbytes == 0) {
+      return endpoint_->CopyToRemoteAsync(local_from_bytes, remote_to, 0, on_complete);
     }
+    auto first_error = std::make_shared<std::string>();
+    uint64_t seq = 0;
+    ForEachBlock(remote_to, RPCCode::kCopyToRemote, nbytes,
+                 [&](uint64_t offset, uint64_t block_bytes, bool last) {
+                   seq = endpoint_->CopyToRemoteAsync(
+                       static_cast<uint8_t*>(local_from_bytes) + offset, remote_to, block_bytes,
+                       JoinBlockCallback(first_error, last, on_complete));
+                 });
+    return seq;
+  }
 
-    const uint64_t remainder_bytes = nbytes % block_size;
-    if (remainder_bytes != 0) {
-      remote_from->byte_offset = block_count * block_size;
-      to_bytes = reinterpret_cast<void*>(
-          (reinterpret_cast<uint8_t*>(local_to_bytes) + block_count * block_size));
-      endpoint_->CopyFromRemote(remote_from, to_bytes, remainder_bytes);
+  uint64_t SubmitCopyFromRemote(DLTensor* remote_from, void* local_to_bytes, uint64_t nbytes,
+                                FAsyncCallback on_complete) final {
+    if (nbytes == 0) {
+      return endpoint_->CopyFromRemoteAsync(remote_from, local_to_bytes, 0, on_complete);
     }
+    auto first_error = std::make_shared<std::string>();
+    uint64_t seq = 0;
+    ForEachBlock(remote_from, RPCCode::kCopyFromRemote, nbytes,
+                 [&](uint64_t offset, uint64_t block_bytes, bool last) {
+                   seq = endpoint_->CopyFromRemoteAsync(
+                       remote_from, static_cast<uint8_t*>(local_to_bytes) + offset, block_bytes,
+                       JoinBlockCallback(first_error, last, on_complete));
+                 });
+    return seq;
   }
 
+  void WaitSubmitted(uint64_t seq) final { endpoint_->WaitForRequests(seq); }
+
   void FreeHandle(void* handle, int type_code) final {
     endpoint_->SysCallRemote(RPCCode::kFreeHandle, handle, type_code);
   }
@@ -1136,6 +1266,49 @@ class RPCClientSession : public RPCSession, public DeviceAPI {
   void Shutdown() final { endpoint_->Shutdown(); }
 
  private:
+  /*!
+   * \brief Split a copy into chunks fitting in the maximum transfer size.
+   * \param remote The remote array, its byte_offset is set to the offset of every block.
+   * \param code The code of the copy.
+   * \param nbytes The size of the copy in bytes.
+   * \param fblock Called with the offset, the size and whether it is the last one per block.
+   */
+  template <typename F>
+  void ForEachBlock(DLTensor* remote, RPCCode code, uint64_t nbytes, F fblock) {
+    uint64_t overhead = RemoteCopyCalculatePacketOverheadSize(remote, code, nbytes);
+    uint64_t rpc_max_size = GetRPCMaxTransferSize();
+    ICHECK_GT(rpc_max_size, overhead)
+        << (code == RPCCode::kCopyToRemote ? "CopyToRemote" : "CopyFromRemote")
+        << ": Invalid block size!";
+    const uint64_t block_size = std::min(rpc_max_size - overhead, kRPCCopyChunkBytes);
+    for (uint64_t offset = 0; offset < nbytes; offset += block_size) {
+      uint64_t block_bytes = std::min(block_size, nbytes - offset);
+      remote->byte_offset = offset;
+      fblock(offset, block_bytes, offset + block_bytes == nbytes);
+    }
+  }
+
+  /*!
+   * \brief The callback of a block of a submitted copy, the last block completes the copy.
+   * \param first_error The error of the first failed block, shared by the blocks.
+   * \param last Whether it is the last block.
+   * \param on_complete The callback of the copy.
+   */
+  FAsyncCallback JoinBlockCallback(std::shared_ptr<std::string> first_error, bool last,
+                                   FAsyncCallback on_complete) {
+    return [this, first_error, last, on_complete](RPCCode status, TVMArgs args) {
+      if (status == RPCCode::kException && first_error->empty()) {
+        *first_error = args.values[0].v_str;
+      }
+      if (!last) return;
+      if (!first_error->empty()) {
+        this->SendException(on_complete, first_error->c_str());
+      } else {
+        on_complete(RPCCode::kReturn, args);
+      }
+    };
+  }
+
   uint64_t GetRPCMaxTransferSize() {
     if (rpc_chunk_max_size_bytes_ > 0) {
       return (uint64_t)rpc_chunk_max_size_bytes_;
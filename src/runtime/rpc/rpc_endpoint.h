@@ -26,6 +26,7 @@
 
 #include <tvm/runtime/packed_func.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -48,6 +49,10 @@ const int kRPCTrackerMagic = 0x2f271;
 const int kRPCSuccess = kRPCMagic + 0;
 // cannot found matched key in server
 const int kRPCMismatch = kRPCMagic + 2;
+// maximum number of requests a client keeps in flight
+const size_t kRPCMaxOutstandingRequests = 16;
+// size of the chunks large copies are streamed in
+const uint64_t kRPCCopyChunkBytes = 1 << 20;
 
 /*! \brief Enumeration code for the RPC tracker */
 enum class TrackerCode : int {
@@ -163,6 +168,49 @@ class RPCEndpoint {
    */
   void CopyFromRemote(DLTensor* from, void* to_bytes, uint64_t nbytes);
 
+  /*!
+   * \brief Send a call into remote function without waiting for it to return.
+   *
+   *  The requests in flight are served by the remote in order, their replies are
+   *  handled by later calls into the endpoint. At most kRPCMaxOutstandingRequests
+   *  requests are kept in flight.
+   *
+   * \param handle The function handle
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param callback The callback to pass the return value or exception.
+   * \return The sequence number of the request.
+   */
+  uint64_t CallFuncAsync(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
+                         const int* arg_type_codes, int num_args,
+                         RPCSession::FAsyncCallback callback);
+  /*!
+   * \brief Send a copy of bytes into remote array content without waiting for it.
+   * \param from_bytes The source host data.
+   * \param to The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param callback The callback to signal copy complete.
+   * \return The sequence number of the request.
+   */
+  uint64_t CopyToRemoteAsync(void* from_bytes, DLTensor* to, uint64_t nbytes,
+                             RPCSession::FAsyncCallback callback);
+  /*!
+   * \brief Send a copy of bytes from remote array content without waiting for it.
+   * \param from The source array.
+   * \param to_bytes The target host data, alive until the callback is called.
+   * \param nbytes The size of the memory in bytes.
+   * \param callback The callback to signal copy complete.
+   * \return The sequence number of the request.
+   */
+  uint64_t CopyFromRemoteAsync(DLTensor* from, void* to_bytes, uint64_t nbytes,
+                               RPCSession::FAsyncCallback callback);
+  /*!
+   * \brief Handle the replies of the requests in flight up to a sequence number.
+   * \param seq The sequence number of the last request to wait for.
+   */
+  void WaitForRequests(uint64_t seq);
+
   /*!
    * \brief Call a remote defined system function with arguments.
    * \param fcode The function code.
@@ -186,16 +234,49 @@ class RPCEndpoint {
 
  private:
   class EventHandler;
+  /*! \brief A request sent to the remote whose reply is not handled yet. */
+  struct PendingRequest {
+    // The sequence number of the request.
+    uint64_t seq;
+    // The code of the request.
+    RPCCode code;
+    // The destination of a copy from remote.
+    void* to_bytes;
+    // The size of a copy from remote.
+    uint64_t nbytes;
+    // The callback to pass the reply to.
+    RPCSession::FAsyncCallback callback;
+  };
   // Handle events until receives a return
   // Also flushes channels so that the function advances.
   RPCCode HandleUntilReturnEvent(bool client_mode, RPCSession::FEncodeReturn setreturn);
+  // Send the bytes in the writer to the channel.
+  void FlushWriter();
+  // Write the requests into the writer.
+  void WriteCallFunc(RPCSession::PackedFuncHandle handle, const TVMValue* arg_values,
+                     const int* arg_type_codes, int num_args);
+  void WriteCopyToRemote(void* from_bytes, DLTensor* to, uint64_t nbytes);
+  void WriteCopyFromRemote(DLTensor* from, uint64_t nbytes);
+  // Record a request which was just written, return its sequence number.
+  uint64_t AddPendingRequest(RPCCode code, void* to_bytes, uint64_t nbytes,
+                             RPCSession::FAsyncCallback callback);
+  // Handle the reply of the oldest request in flight.
+  void FinishPendingRequest();
+  // Handle the replies of the requests in flight up to a sequence number.
+  void FinishPendingRequests(uint64_t seq);
   // Initalization
   void Init();
   // Internal channel.
   std::unique_ptr<RPCChannel> channel_;
 
-  // Internal mutex
-  std::mutex mutex_;
+  // Internal mutex, recursive as freeing the results of a request may call into the endpoint.
+  std::recursive_mutex mutex_;
+  // The requests in flight, in the order the remote replies.
+  std::deque<PendingRequest> pending_requests_;
+  // The sequence number of the last request sent.
+  uint64_t last_request_seq_{0};
+  // The sequence number of the last copy from remote sent.
+  uint64_t last_copy_from_remote_seq_{0};
   // Internal ring buffer.
   support::RingBuffer reader_, writer_;
   // Event handler.
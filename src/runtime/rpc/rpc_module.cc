@@ -86,9 +86,73 @@ class RPCWrappedFunc : public Object {
   RPCWrappedFunc(void* handle, std::shared_ptr<RPCSession> sess) : handle_(handle), sess_(sess) {}
 
   void operator()(TVMArgs args, TVMRetValue* rv) const {
-    std::vector<TVMValue> values(args.values, args.values + args.size());
-    std::vector<int> type_codes(args.type_codes, args.type_codes + args.size());
+    std::vector<TVMValue> values;
+    std::vector<int> type_codes;
     std::vector<std::unique_ptr<DLTensor>> temp_dltensors;
+    TranslateArgs(args, &values, &type_codes, &temp_dltensors);
+    auto set_return = [this, rv](TVMArgs args) { this->WrapRemoteReturnToValue(args, rv); };
+    sess_->CallFunc(handle_, values.data(), type_codes.data(), args.size(), set_return);
+  }
+
+  /*!
+   * \brief Send a call to the remote function without waiting for it to return.
+   * \param self The function.
+   * \param args The arguments.
+   * \return The future of the call, calling it waits for the call and returns its result.
+   */
+  static PackedFunc CallAsync(std::shared_ptr<RPCWrappedFunc> self, TVMArgs args) {
+    struct AsyncResult {
+      bool failed{false};
+      std::string error;
+      TVMRetValue value;
+    };
+    std::vector<TVMValue> values;
+    std::vector<int> type_codes;
+    std::vector<std::unique_ptr<DLTensor>> temp_dltensors;
+    self->TranslateArgs(args, &values, &type_codes, &temp_dltensors);
+    auto result = std::make_shared<AsyncResult>();
+    uint64_t seq = self->sess_->SubmitCallFunc(
+        self->handle_, values.data(), type_codes.data(), args.size(),
+        [self, result](RPCCode status, TVMArgs args) {
+          if (status == RPCCode::kException) {
+            result->failed = true;
+            result->error = args.values[0].v_str;
+          } else {
+            self->WrapRemoteReturnToValue(args, &result->value);
+          }
+        });
+    std::shared_ptr<RPCSession> sess = self->sess_;
+    return PackedFunc([sess, seq, result](TVMArgs args, TVMRetValue* rv) {
+      sess->WaitSubmitted(seq);
+      if (result->failed) {
+        LOG(FATAL) << result->error;
+      }
+      *rv = result->value;
+    });
+  }
+
+  ~RPCWrappedFunc() {
+    try {
+      sess_->FreeHandle(handle_, kTVMPackedFuncHandle);
+    } catch (const Error& e) {
+      // fault tolerance to remote close
+    }
+  }
+
+ private:
+  // remote function handle
+  void* handle_{nullptr};
+  // pointer to the session.
+  std::shared_ptr<RPCSession> sess_;
+
+  // rewrite the arguments to their remote variant.
+  void TranslateArgs(TVMArgs args, std::vector<TVMValue>* values_out,
+                     std::vector<int>* type_codes_out,
+                     std::vector<std::unique_ptr<DLTensor>>* temp_dltensors) const {
+    std::vector<TVMValue>& values = *values_out;
+    std::vector<int>& type_codes = *type_codes_out;
+    values.assign(args.values, args.values + args.size());
+    type_codes.assign(args.type_codes, args.type_codes + args.size());
 
     // scan and check whether we need rewrite these arguments
     // to their remote variant.
@@ -111,7 +175,7 @@ class RPCWrappedFunc : public Object {
           dptr->device = RemoveSessMask(dptr->device);
           dptr->data = static_cast<RemoteSpace*>(dptr->data)->data;
           values[i].v_handle = dptr.get();
-          temp_dltensors.emplace_back(std::move(dptr));
+          temp_dltensors->emplace_back(std::move(dptr));
           break;
         }
         case kDLDevice: {
@@ -125,24 +189,7 @@ class RPCWrappedFunc : public Object {
         }
       }
     }
-    auto set_return = [this, rv](TVMArgs args) { this->WrapRemoteReturnToValue(args, rv); };
-    sess_->CallFunc(handle_, values.data(), type_codes.data(), args.size(), set_return);
   }
-
-  ~RPCWrappedFunc() {
-    try {
-      sess_->FreeHandle(handle_, kTVMPackedFuncHandle);
-    } catch (const Error& e) {
-      // fault tolerance to remote close
-    }
-  }
-
- private:
-  // remote function handle
-  void* handle_{nullptr};
-  // pointer to the session.
-  std::shared_ptr<RPCSession> sess_;
-
   // unwrap a remote value to the underlying handle.
   void* UnwrapRemoteValueToHandle(const TVMArgValue& arg) const;
   // wrap a remote return via Set
@@ -198,7 +245,8 @@ class RPCModuleNode final : public ModuleNode {
   PackedFunc GetTimeEvaluator(const std::string& name, Device dev, int number, int repeat,
                               int min_repeat_ms, int limit_zero_time_iterations,
                               int cooldown_interval_ms, int repeats_to_cooldown,
-                              const std::string& f_preproc_name) {
+                              const std::string& f_preproc_name, double max_rel_ci,
+                              int max_measure_ms) {
     InitRemoteFunc(&remote_get_time_evaluator_, "runtime.RPCTimeEvaluator");
     // Remove session mask because we pass dev by parts.
     ICHECK_EQ(GetRPCSessionIndex(dev), sess_->table_index())
@@ -209,12 +257,14 @@ class RPCModuleNode final : public ModuleNode {
       return remote_get_time_evaluator_(GetRef<Module>(this), name,
                                         static_cast<int>(dev.device_type), dev.device_id, number,
                                         repeat, min_repeat_ms, limit_zero_time_iterations,
-                                        cooldown_interval_ms, repeats_to_cooldown, f_preproc_name);
+                                        cooldown_interval_ms, repeats_to_cooldown, f_preproc_name,
+                                        max_rel_ci, max_measure_ms);
     } else {
       return remote_get_time_evaluator_(Optional<Module>(nullptr), name,
                                         static_cast<int>(dev.device_type), dev.device_id, number,
                                         repeat, min_repeat_ms, limit_zero_time_iterations,
-                                        cooldown_interval_ms, repeats_to_cooldown, f_preproc_name);
+                                        cooldown_interval_ms, repeats_to_cooldown, f_preproc_name,
+                                        max_rel_ci, max_measure_ms);
     }
   }
 
@@ -228,6 +278,20 @@ class RPCModuleNode final : public ModuleNode {
     remote_import_module_(GetRef<Module>(this), other);
   }
 
+  /*!
+   * \brief Get a function sending its calls without waiting for them to return.
+   * \param name The name of the function.
+   * \return The function, returning the future of every call.
+   */
+  PackedFunc GetAsyncFunction(const std::string& name) {
+    RPCSession::PackedFuncHandle handle = GetFunctionHandle(name);
+    ICHECK(handle != nullptr) << "Cannot found remote function " << name;
+    auto wf = std::make_shared<RPCWrappedFunc>(handle, sess_);
+    return PackedFunc([wf](TVMArgs args, TVMRetValue* rv) {
+      *rv = RPCWrappedFunc::CallAsync(wf, args);
+    });
+  }
+
   const std::shared_ptr<RPCSession>& sess() { return sess_; }
 
   void* module_handle() const { return module_handle_; }
@@ -241,6 +305,29 @@ class RPCModuleNode final : public ModuleNode {
     *func = WrapRemoteFunc(handle);
   }
 
+  // Get the remote handle of a function, owned by the caller.
+  RPCSession::PackedFuncHandle GetFunctionHandle(const std::string& name) {
+    if (module_handle_ == nullptr) return sess_->GetFunction(name);
+    const std::string get_function_name = "tvm.rpc.server.ModuleGetFunction";
+    RPCSession::PackedFuncHandle get_function = sess_->GetFunction(get_function_name);
+    ICHECK(get_function != nullptr) << "Cannot found remote function " << get_function_name;
+    TVMValue values[3];
+    int type_codes[3];
+    values[0].v_handle = module_handle_;
+    type_codes[0] = kTVMModuleHandle;
+    values[1].v_str = name.c_str();
+    type_codes[1] = kTVMStr;
+    values[2].v_int64 = 1;
+    type_codes[2] = kDLInt;
+    RPCSession::PackedFuncHandle handle = nullptr;
+    sess_->CallFunc(get_function, values, type_codes, 3, [&handle](TVMArgs args) {
+      int tcode = args[0];
+      if (tcode == kTVMPackedFuncHandle) handle = args.values[1].v_handle;
+    });
+    sess_->FreeHandle(get_function, kTVMPackedFuncHandle);
+    return handle;
+  }
+
   PackedFunc WrapRemoteFunc(RPCSession::PackedFuncHandle handle) {
     if (handle == nullptr) return PackedFunc();
     auto wf = std::make_shared<RPCWrappedFunc>(handle, sess_);
@@ -253,7 +340,7 @@ class RPCModuleNode final : public ModuleNode {
   std::shared_ptr<RPCSession> sess_;
   // remote function to get time evaluator
   TypedPackedFunc<PackedFunc(Optional<Module>, std::string, int, int, int, int, int, int, int, int,
-                             std::string)>
+                             std::string, double, int)>
       remote_get_time_evaluator_;
   // remote function getter for modules.
   TypedPackedFunc<PackedFunc(Module, std::string, bool)> remote_mod_get_function_;
@@ -373,7 +460,7 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
     .set_body_typed([](Optional<Module> opt_mod, std::string name, int device_type, int device_id,
                        int number, int repeat, int min_repeat_ms, int limit_zero_time_iterations,
                        int cooldown_interval_ms, int repeats_to_cooldown,
-                       std::string f_preproc_name) {
+                       std::string f_preproc_name, double max_rel_ci, int max_measure_ms) {
       Device dev;
       dev.device_type = static_cast<DLDeviceType>(device_type);
       dev.device_id = device_id;
@@ -384,7 +471,8 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
           return static_cast<RPCModuleNode*>(m.operator->())
               ->GetTimeEvaluator(name, dev, number, repeat, min_repeat_ms,
                                  limit_zero_time_iterations, cooldown_interval_ms,
-                                 repeats_to_cooldown, f_preproc_name);
+                                 repeats_to_cooldown, f_preproc_name, max_rel_ci,
+                                 max_measure_ms);
         } else {
           PackedFunc f_preproc;
           if (!f_preproc_name.empty()) {
@@ -397,7 +485,8 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
           CHECK(pf != nullptr) << "Cannot find " << name << " in the global registry";
           return profiling::WrapTimeEvaluator(pf, dev, number, repeat, min_repeat_ms,
                                               limit_zero_time_iterations, cooldown_interval_ms,
-                                              repeats_to_cooldown, f_preproc);
+                                              repeats_to_cooldown, f_preproc, max_rel_ci,
+                                              max_measure_ms);
         }
       } else {
         auto* pf = runtime::Registry::Get(name);
@@ -411,7 +500,8 @@ TVM_REGISTER_GLOBAL("runtime.RPCTimeEvaluator")
         }
         return profiling::WrapTimeEvaluator(*pf, dev, number, repeat, min_repeat_ms,
                                             limit_zero_time_iterations, cooldown_interval_ms,
-                                            repeats_to_cooldown, f_preproc);
+                                            repeats_to_cooldown, f_preproc, max_rel_ci,
+                                            max_measure_ms);
       }
     });
 
@@ -442,6 +532,12 @@ TVM_REGISTER_GLOBAL("rpc.ImportRemoteModule").set_body_typed([](Module parent, M
   static_cast<RPCModuleNode*>(parent.operator->())->ImportModule(child);
 });
 
+TVM_REGISTER_GLOBAL("rpc.GetAsyncFunction").set_body_typed([](Module mod, std::string name) {
+  std::string tkey = mod->type_key();
+  ICHECK_EQ(tkey, "rpc");
+  return static_cast<RPCModuleNode*>(mod.operator->())->GetAsyncFunction(name);
+});
+
 TVM_REGISTER_GLOBAL("rpc.SessTableIndex").set_body([](TVMArgs args, TVMRetValue* rv) {
   Module m = args[0];
   std::string tkey = m->type_key();
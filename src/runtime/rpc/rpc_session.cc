@@ -93,6 +93,25 @@ void RPCSession::AsyncStreamWait(Device dev, TVMStreamHandle stream,
   }
 }
 
+uint64_t RPCSession::SubmitCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
+                                    const int* arg_type_codes, int num_args,
+                                    FAsyncCallback callback) {
+  RPCSession::AsyncCallFunc(func, arg_values, arg_type_codes, num_args, callback);
+  return ++num_submitted_;
+}
+
+uint64_t RPCSession::SubmitCopyToRemote(void* local_from_bytes, DLTensor* remote_to,
+                                        uint64_t nbytes, FAsyncCallback on_complete) {
+  RPCSession::AsyncCopyToRemote(local_from_bytes, remote_to, nbytes, on_complete);
+  return ++num_submitted_;
+}
+
+uint64_t RPCSession::SubmitCopyFromRemote(DLTensor* remote_from, void* local_to_bytes,
+                                          uint64_t nbytes, FAsyncCallback on_complete) {
+  RPCSession::AsyncCopyFromRemote(remote_from, local_to_bytes, nbytes, on_complete);
+  return ++num_submitted_;
+}
+
 class RPCSessTable {
  public:
   static constexpr int kMaxRPCSession = 32;
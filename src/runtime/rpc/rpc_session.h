@@ -27,6 +27,7 @@
 #include <tvm/runtime/device_api.h>
 #include <tvm/runtime/packed_func.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -241,6 +242,56 @@ class RPCSession {
    */
   virtual void AsyncStreamWait(Device dev, TVMStreamHandle stream, FAsyncCallback on_compelte);
 
+  // Pipelined variant of API
+  // These APIs are used by RPC clients to keep several requests in flight.
+  //
+  // The submitted requests are served in order. Their callbacks are invoked
+  // by later calls into the session, at the latest by WaitSubmitted, and must
+  // not call into the session themselves. Sessions that cannot pipeline
+  // requests serve them immediately.
+
+  /*!
+   * \brief Submit a call to func without waiting for it to return.
+   * \param func The function handle.
+   * \param arg_values The argument values.
+   * \param arg_type_codes the type codes of the argument.
+   * \param num_args Number of arguments.
+   * \param callback The callback to pass the return value or exception.
+   * \return The sequence number of the request.
+   */
+  virtual uint64_t SubmitCallFunc(PackedFuncHandle func, const TVMValue* arg_values,
+                                  const int* arg_type_codes, int num_args,
+                                  FAsyncCallback callback);
+
+  /*!
+   * \brief Submit a copy into remote array content without waiting for it to complete.
+   * \param local_from_bytes The source host data.
+   * \param remote_to The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param on_complete The callback to signal copy complete.
+   * \return The sequence number of the request.
+   */
+  virtual uint64_t SubmitCopyToRemote(void* local_from_bytes, DLTensor* remote_to,
+                                      uint64_t nbytes, FAsyncCallback on_complete);
+
+  /*!
+   * \brief Submit a copy from remote array content without waiting for it to complete.
+   * \param remote_from The source host data.
+   * \param local_to_bytes The target array.
+   * \param nbytes The size of the memory in bytes.
+   * \param on_complete The callback to signal copy complete.
+   * \return The sequence number of the request.
+   * \note local_to_bytes must stay alive until on_complete is called.
+   */
+  virtual uint64_t SubmitCopyFromRemote(DLTensor* remote_from, void* local_to_bytes,
+                                        uint64_t nbytes, FAsyncCallback on_complete);
+
+  /*!
+   * \brief Wait until the submitted requests up to a sequence number complete.
+   * \param seq The sequence number of the last request to wait for.
+   */
+  virtual void WaitSubmitted(uint64_t seq) {}
+
   /*!
    * \return The session table index of the session.
    */
@@ -268,6 +319,8 @@ class RPCSession {
  private:
   /*! \brief index of this session in RPC session table */
   int table_index_{0};
+  /*! \brief The number of requests submitted to a session serving them immediately. */
+  std::atomic<uint64_t> num_submitted_{0};
   /*! \brief Insert the current session to the session table.*/
   static void InsertToSessionTable(std::shared_ptr<RPCSession> sess);
   // friend declaration
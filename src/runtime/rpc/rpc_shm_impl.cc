@@ -0,0 +1,271 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file rpc_shm_impl.cc
+ * \brief Shared memory based RPC channel for sessions on the same host.
+ */
+// Linux only for now, as linux is the most common usecase.
+#if defined(__linux__) || defined(__ANDROID__)
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <tvm/runtime/registry.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "rpc_endpoint.h"
+
+namespace tvm {
+namespace runtime {
+
+/*!
+ * \brief A single producer single consumer byte ring living in shared memory.
+ *
+ *  The data of the ring directly follows the header.
+ */
+struct ShmRing {
+  /*! \brief The number of bytes ever written, only advanced by the writer. */
+  std::atomic<uint64_t> head{0};
+  /*! \brief The number of bytes ever read, only advanced by the reader. */
+  std::atomic<uint64_t> tail{0};
+  /*! \brief Futex word bumped after the head advances. */
+  std::atomic<uint32_t> head_signal{0};
+  /*! \brief Futex word bumped after the tail advances. */
+  std::atomic<uint32_t> tail_signal{0};
+  /*! \brief Set by the writer when it closes the ring. */
+  std::atomic<uint32_t> closed{0};
+  /*! \brief The size of the data in bytes. */
+  uint32_t capacity{0};
+
+  char* data() { return reinterpret_cast<char*>(this + 1); }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "The shared memory channel needs lock free atomics");
+
+/*! \brief The size of the data of every ring. */
+constexpr uint32_t kShmRingBytes = 4 << 20;
+
+class ShmChannel final : public RPCChannel {
+ public:
+  /*!
+   * \brief Constructor.
+   * \param fd The file descriptor of the shared memory holding the two rings.
+   * \param region The mapped shared memory.
+   * \param region_bytes The size of the shared memory.
+   * \param is_client Whether this is the client end, which writes into the first ring.
+   * \param peer_pid The process at the other end, the server of a client and the client of a
+   *  server.
+   */
+  ShmChannel(int fd, void* region, size_t region_bytes, bool is_client, pid_t peer_pid)
+      : fd_(fd),
+        region_(region),
+        region_bytes_(region_bytes),
+        is_client_(is_client),
+        peer_pid_(peer_pid) {
+    ShmRing* first = static_cast<ShmRing*>(region);
+    ShmRing* second = reinterpret_cast<ShmRing*>(first->data() + first->capacity);
+    out_ = is_client ? first : second;
+    in_ = is_client ? second : first;
+  }
+
+  ~ShmChannel() { Close(); }
+
+  size_t Send(const void* data, size_t size) final {
+    uint64_t head = out_->head.load(std::memory_order_relaxed);
+    uint64_t free_bytes = 0;
+    WaitFor(&out_->tail_signal, [&]() {
+      free_bytes = out_->capacity - (head - out_->tail.load(std::memory_order_acquire));
+      if (free_bytes != 0) return true;
+      if (in_->closed.load(std::memory_order_acquire) != 0 || peer_exited_) {
+        LOG(FATAL) << "Shared memory RPC channel write error, the peer has exited";
+      }
+      return false;
+    });
+    size_t n = static_cast<size_t>(std::min<uint64_t>(size, free_bytes));
+    WriteRing(out_, head, static_cast<const char*>(data), n);
+    out_->head.store(head + n, std::memory_order_release);
+    Notify(&out_->head_signal);
+    return n;
+  }
+
+  size_t Recv(void* data, size_t size) final {
+    uint64_t tail = in_->tail.load(std::memory_order_relaxed);
+    uint64_t avail_bytes = 0;
+    bool closed = false;
+    WaitFor(&in_->head_signal, [&]() {
+      // Read closed before head, the writer closes after its last write.
+      closed = in_->closed.load(std::memory_order_acquire) != 0 || peer_exited_;
+      avail_bytes = in_->head.load(std::memory_order_acquire) - tail;
+      return avail_bytes != 0 || closed;
+    });
+    if (avail_bytes == 0) return 0;
+    size_t n = static_cast<size_t>(std::min<uint64_t>(size, avail_bytes));
+    ReadRing(in_, tail, static_cast<char*>(data), n);
+    in_->tail.store(tail + n, std::memory_order_release);
+    Notify(&in_->tail_signal);
+    return n;
+  }
+
+  void Close() {
+    if (region_ == nullptr) return;
+    out_->closed.store(1, std::memory_order_release);
+    Notify(&out_->head_signal);
+    munmap(region_, region_bytes_);
+    close(fd_);
+    region_ = nullptr;
+    if (is_client_) {
+      kill(peer_pid_, SIGKILL);
+      waitpid(peer_pid_, nullptr, 0);
+    }
+  }
+
+ private:
+  // Wait until fready returns true, spinning first and then sleeping on the futex word.
+  template <typename FReady>
+  void WaitFor(std::atomic<uint32_t>* signal, FReady fready) {
+    for (int i = 0; i < kSpinCount; ++i) {
+      if (fready()) return;
+    }
+    while (true) {
+      uint32_t value = signal->load(std::memory_order_acquire);
+      if (fready()) return;
+      // Sleep with a timeout, so that an exited peer is noticed.
+      struct timespec timeout = {0, 100 * 1000 * 1000};
+      syscall(SYS_futex, reinterpret_cast<uint32_t*>(signal), FUTEX_WAIT, value, &timeout,
+              nullptr, 0);
+      if (!PeerAlive()) peer_exited_ = true;
+    }
+  }
+
+  static void Notify(std::atomic<uint32_t>* signal) {
+    signal->fetch_add(1, std::memory_order_release);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(signal), FUTEX_WAKE, INT_MAX, nullptr,
+            nullptr, 0);
+  }
+
+  // Copy bytes into the ring at a position.
+  static void WriteRing(ShmRing* ring, uint64_t pos, const char* data, size_t n) {
+    size_t offset = static_cast<size_t>(pos % ring->capacity);
+    size_t first = std::min<size_t>(n, ring->capacity - offset);
+    std::memcpy(ring->data() + offset, data, first);
+    std::memcpy(ring->data(), data + first, n - first);
+  }
+
+  // Copy bytes out of the ring at a position.
+  static void ReadRing(ShmRing* ring, uint64_t pos, char* data, size_t n) {
+    size_t offset = static_cast<size_t>(pos % ring->capacity);
+    size_t first = std::min<size_t>(n, ring->capacity - offset);
+    std::memcpy(data, ring->data() + offset, first);
+    std::memcpy(data + first, ring->data(), n - first);
+  }
+
+  bool PeerAlive() {
+    if (is_client_) {
+      return waitpid(peer_pid_, nullptr, WNOHANG) == 0;
+    } else {
+      return getppid() == peer_pid_;
+    }
+  }
+
+  static constexpr int kSpinCount = 1024;
+  int fd_;
+  void* region_;
+  size_t region_bytes_;
+  bool is_client_;
+  pid_t peer_pid_;
+  bool peer_exited_{false};
+  ShmRing* out_;
+  ShmRing* in_;
+};
+
+Module CreateShmClient(std::vector<std::string> cmd) {
+  int fd = static_cast<int>(syscall(SYS_memfd_create, "tvm_rpc_shm", 0));
+  ICHECK_GE(fd, 0) << "Cannot create the shared memory of the RPC channel, errno=" << errno;
+  size_t ring_bytes = sizeof(ShmRing) + kShmRingBytes;
+  size_t region_bytes = 2 * ring_bytes;
+  ICHECK_EQ(ftruncate(fd, region_bytes), 0);
+  void* region = mmap(nullptr, region_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ICHECK(region != MAP_FAILED) << "Cannot map the shared memory of the RPC channel";
+  for (int i = 0; i < 2; ++i) {
+    ShmRing* ring = new (static_cast<char*>(region) + i * ring_bytes) ShmRing();
+    ring->capacity = kShmRingBytes;
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    // child process
+    std::string sfd = std::to_string(fd);
+    std::vector<char*> argv;
+    for (auto& str : cmd) {
+      argv.push_back(dmlc::BeginPtr(str));
+    }
+    argv.push_back(dmlc::BeginPtr(sfd));
+    argv.push_back(nullptr);
+    execvp(argv[0], &argv[0]);
+    _exit(1);
+  }
+  // parent process
+  auto endpt = RPCEndpoint::Create(
+      std::make_unique<ShmChannel>(fd, region, region_bytes, true, pid), "shm", "shm");
+  endpt->InitRemoteSession(TVMArgs(nullptr, nullptr, 0));
+  return CreateRPCSessionModule(CreateClientSession(endpt));
+}
+
+void RPCShmServerLoop(int fd) {
+  struct stat st;
+  ICHECK_EQ(fstat(fd, &st), 0);
+  size_t region_bytes = static_cast<size_t>(st.st_size);
+  void* region = mmap(nullptr, region_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ICHECK(region != MAP_FAILED) << "Cannot map the shared memory of the RPC channel";
+  RPCEndpoint::Create(std::make_unique<ShmChannel>(fd, region, region_bytes, false, getppid()),
+                      "ShmServerLoop", "")
+      ->ServerLoop();
+}
+
+TVM_REGISTER_GLOBAL("rpc.CreateShmClient").set_body([](TVMArgs args, TVMRetValue* rv) {
+  std::vector<std::string> cmd;
+  for (int i = 0; i < args.size(); ++i) {
+    cmd.push_back(args[i].operator std::string());
+  }
+  *rv = CreateShmClient(cmd);
+});
+
+TVM_REGISTER_GLOBAL("rpc.ShmServerLoop").set_body_typed(RPCShmServerLoop);
+
+}  // namespace runtime
+}  // namespace tvm
+#endif
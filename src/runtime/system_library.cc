@@ -28,6 +28,7 @@
 #include <mutex>
 
 #include "library_module.h"
+#include "read_mostly_map.h"
 
 namespace tvm {
 namespace runtime {
@@ -35,24 +36,14 @@ namespace runtime {
 class SystemLibSymbolRegistry {
  public:
   void RegisterSymbol(const std::string& name, void* ptr) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = symbol_table_.find(name);
-    if (it != symbol_table_.end() && ptr != it->second) {
+    void* prev = symbol_table_.Set(name, ptr);
+    if (prev != nullptr && ptr != prev) {
       LOG(WARNING) << "SystemLib symbol " << name << " get overriden to a different address " << ptr
-                   << "->" << it->second;
+                   << "->" << prev;
     }
-    symbol_table_[name] = ptr;
   }
 
-  void* GetSymbol(const char* name) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = symbol_table_.find(name);
-    if (it != symbol_table_.end()) {
-      return it->second;
-    } else {
-      return nullptr;
-    }
-  }
+  void* GetSymbol(const char* name) { return symbol_table_.Find(name); }
 
   static SystemLibSymbolRegistry* Global() {
     static SystemLibSymbolRegistry* inst = new SystemLibSymbolRegistry();
@@ -60,10 +51,8 @@ class SystemLibSymbolRegistry {
   }
 
  private:
-  // Internal mutex
-  std::mutex mutex_;
-  // Internal symbol table
-  std::unordered_map<std::string, void*> symbol_table_;
+  // Internal symbol table, looked up without locking
+  ReadMostlyMap<std::string, void> symbol_table_;
 };
 
 class SystemLibrary : public Library {
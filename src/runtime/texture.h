@@ -26,8 +26,10 @@
 
 #include <tvm/runtime/device_api.h>
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tvm {
@@ -94,13 +96,61 @@ inline bool IsTextureStorage(std::string scope) {
   return scope.find("texture") != std::string::npos;
 }
 
+/*!
+ * \brief The largest ratio between the width, or the height, of a texture and of a request it
+ *  serves. Serving small requests from much larger textures, or growing much smaller ones, was
+ *  found to slow down the kernels. Shared by the memory planner and the runtime pools so that
+ *  both reuse textures alike.
+ */
+constexpr int64_t kTextureReuseMaxRatio = 5;
+
+/*!
+ * \brief A pool of the 2d textures of one device.
+ *
+ *  The free textures are kept in buckets by the power of two of their width and height, so a
+ *  request only looks at the few buckets within kTextureReuseMaxRatio of its size. It takes the
+ *  free texture that fits with the least wasted area, or else grows the free texture that needs
+ *  the least added area, as TokenAllocator2D does when planning, or else allocates a new one.
+ *  Free textures are released, largest first, to keep the pool within its budget.
+ */
 class TVM_DLL Pool2D {
  public:
+  /*! \brief Memory statistics of the pool. */
+  struct Stats {
+    /*! \brief The bytes of the textures in use. */
+    size_t current_bytes{0};
+    /*! \brief The peak of current_bytes. */
+    size_t peak_bytes{0};
+    /*! \brief The bytes of the textures in use and free. */
+    size_t reserved_bytes{0};
+    /*! \brief The bytes of the textures in use beyond the requested sizes. */
+    size_t wasted_bytes{0};
+    /*! \brief The requests served by a free texture as is. */
+    size_t num_reuses{0};
+    /*! \brief The requests served by replacing a free texture with a larger one. */
+    size_t num_grows{0};
+    /*! \brief The requests served by a new texture. */
+    size_t num_allocs{0};
+    /*! \brief The free textures released to stay within the budget. */
+    size_t num_evictions{0};
+    /*! \return The statistics as a map from name to profiling::CountNode. */
+    Map<String, ObjectRef> AsMap() const;
+  };
+
   Pool2D() = default;
   void* Alloc(Device dev, DeviceAPI* device, size_t width, size_t height, DLDataType type_hint);
   void Free(void* data);
   // Release all resources immediately
   void Release(Device dev, DeviceAPI* device);
+  /*! \return The memory statistics of the pool. */
+  const Stats& GetStats() const { return stats_; }
+
+  /*!
+   * \brief Set the bytes of textures above which each pool releases its free textures, read
+   *  from TVM_TEXTURE_POOL_BUDGET by default.
+   * \param bytes The budget, 0 for none.
+   */
+  static void SetBudget(size_t bytes);
 
  protected:
   struct Entry {
@@ -108,9 +158,18 @@ class TVM_DLL Pool2D {
     size_t x;
     size_t y;
     DLDataType type;
+    /*! \brief The bytes of the texture beyond the request it serves. */
+    size_t wasted_bytes;
   };
-  std::vector<Entry> free_list_;
+  /*! \brief The bucket of a size, its log2 rounded down. */
+  static int Bucket(size_t size);
+  /*! \brief Release free textures until \p nbytes more fit in the budget, if possible. */
+  void Evict(Device dev, DeviceAPI* device, size_t nbytes);
+
+  /*! \brief The free textures by the buckets of their width and height. */
+  std::map<std::pair<int, int>, std::vector<Entry>> free_list_;
   std::vector<Entry> allocated_;
+  Stats stats_;
 };
 
 /*!
@@ -153,6 +212,12 @@ class TVM_DLL TexturePool {
    * \param ptr The pointer to be freed.
    */
   void FreeTexture(Device dev, void* ptr);
+  /*!
+   * \brief Get the memory statistics of the pool of a device.
+   * \param dev The device of the pool.
+   * \return The statistics, all zero if the device has not been used.
+   */
+  Pool2D::Stats GetStats(Device dev) const;
 
  private:
   /*! \brief pool of device local array */
@@ -41,6 +41,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "../support/utils.h"
@@ -60,11 +61,28 @@ uint32_t GetSpinCount() {
   return atoi(val);
 }
 
+/*!
+ * \brief The number of tasks each worker gets when work stealing is enabled,
+ *  0 means the static one-task-per-worker split is used.
+ */
+int GetWorkStealingGranularity() {
+  const char* val = getenv("TVM_THREAD_POOL_WORK_STEALING");
+  if (!val) {
+    return 0;
+  }
+  return std::max(atoi(val), 0);
+}
+
+/*! \brief The launcher set by SetParallelLaunchBackend, nullptr for the thread pool. */
+std::atomic<threading::ParallelLaunchBackend> parallel_launch_backend{nullptr};
+
 }  // namespace
 
 // stride in the page, fit to cache line.
 constexpr int kSyncStride = 64 / sizeof(std::atomic<int>);
 
+class ThreadPool;
+
 /*!
  * \brief Thread local main environment.
  */
@@ -94,12 +112,67 @@ class ParallelLauncher {
       this->env.sync_handle = nullptr;
     }
   }
+  /*!
+   * \brief Split the task ids of the current job into contiguous ranges, one per participant.
+   *  Each participant drains its own range front to back and then steals from the back of
+   *  the ranges of the others.
+   * \param num_workers The number of workers taking part in the job.
+   */
+  void InitStealing(int num_workers) {
+    if (num_workers > num_ranges_) {
+      ranges_.reset(new TaskRange[num_workers]);
+      num_ranges_ = num_workers;
+    }
+    int num_task = env.num_task;
+    int start = 0;
+    for (int i = 0; i < num_workers; ++i) {
+      int end = start + num_task / num_workers + (i < num_task % num_workers ? 1 : 0);
+      std::lock_guard<std::mutex> lock(ranges_[i].mutex);
+      ranges_[i].begin = start;
+      ranges_[i].end = end;
+      start = end;
+    }
+    num_stealing_workers_ = num_workers;
+    num_active_workers_.store(num_workers);
+  }
+  /*!
+   * \brief Run tasks of the current job on the calling worker until no task is left.
+   * \param worker_id The participant index of the calling worker.
+   */
+  void RunStealingWorker(int worker_id) {
+    int32_t task_id;
+    while (PopTask(worker_id, &task_id) || StealTask(worker_id, &task_id)) {
+      RunTask(task_id);
+    }
+    num_active_workers_.fetch_sub(1, std::memory_order_release);
+  }
+  /*!
+   * \brief Run one task of the current job on the calling thread. The thread is marked as
+   *  being inside the parallel region, so jobs launched by the task become nested ones.
+   * \param task_id The task to run.
+   */
+  void RunTask(int32_t task_id) {
+    ParallelLauncher* self = ThreadLocal();
+    int depth = self->depth;
+    self->depth = level + 1;
+    if ((*flambda)(task_id, &env, cdata) == 0) {
+      SignalJobFinish();
+    } else {
+      SignalJobError(task_id);
+    }
+    self->depth = depth;
+  }
   ~ParallelLauncher() { delete[] sync_counter_; }
   // Wait n jobs to finish
   int WaitForJobs() {
     while (num_pending_.load() != 0) {
       tvm::runtime::threading::Yield();
     }
+    // The stealing workers still look at the task ranges after the last task finished,
+    // make sure all of them are gone before the launcher can be reused.
+    while (num_active_workers_.load(std::memory_order_acquire) != 0) {
+      tvm::runtime::threading::Yield();
+    }
     if (!has_error_.load()) return 0;
     std::ostringstream os;
     for (size_t i = 0; i < par_errors_.size(); ++i) {
@@ -127,11 +200,59 @@ class ParallelLauncher {
   void* cdata;
   // Local env
   TVMParallelGroupEnv env;
-  // Whether this thread is worker of the pool.
-  // used to prevent recursive launch.
-  bool is_worker{false};
+  // The nesting level of the current job, 0 for the outermost parallel region.
+  int level{0};
+  // The nesting depth of the job whose task this thread is running,
+  // 0 when the thread is outside of any parallel region.
+  int depth{0};
+  // The pool this thread is a worker of, nullptr for other threads.
+  ThreadPool* worker_pool{nullptr};
+  // The named pool the jobs of this thread are bound to by a ThreadPoolScope.
+  ThreadPool* bound_pool{nullptr};
+  // The workers borrowed by the current nested job.
+  std::vector<int> borrowed_workers;
 
  private:
+  /*! \brief Range of task ids owned by one participant of a work-stealing job. */
+  struct alignas(kL1CacheBytes) TaskRange {
+    std::mutex mutex;
+    int32_t begin{0};
+    int32_t end{0};
+  };
+  // Take the next task from the front of the worker's own range.
+  bool PopTask(int worker_id, int32_t* task_id) {
+    TaskRange& range = ranges_[worker_id];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin == range.end) return false;
+    *task_id = range.begin++;
+    return true;
+  }
+  // Steal the back half of the first non-empty range of another worker. The first stolen
+  // task is returned and the rest is placed into the worker's own (empty) range.
+  bool StealTask(int worker_id, int32_t* task_id) {
+    for (int i = 1; i < num_stealing_workers_; ++i) {
+      int victim = (worker_id + i) % num_stealing_workers_;
+      int32_t begin, end;
+      {
+        TaskRange& range = ranges_[victim];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        int32_t remain = range.end - range.begin;
+        if (remain == 0) continue;
+        end = range.end;
+        begin = end - (remain + 1) / 2;
+        range.end = begin;
+      }
+      *task_id = begin;
+      if (begin + 1 != end) {
+        TaskRange& own = ranges_[worker_id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.begin = begin + 1;
+        own.end = end;
+      }
+      return true;
+    }
+    return false;
+  }
   // The pending jobs.
   std::atomic<int32_t> num_pending_;
   // Whether error has been countered.
@@ -140,6 +261,14 @@ class ParallelLauncher {
   std::atomic<int32_t>* sync_counter_{nullptr};
   // The error message
   std::vector<std::string> par_errors_;
+  // The task ranges of the work-stealing participants.
+  std::unique_ptr<TaskRange[]> ranges_;
+  // The number of allocated task ranges.
+  int num_ranges_{0};
+  // The number of participants of the current work-stealing job.
+  int num_stealing_workers_{0};
+  // The number of participants which have not left the current work-stealing job.
+  std::atomic<int32_t> num_active_workers_{0};
 };
 
 /*! \brief Lock-free single-producer-single-consumer queue for each thread */
@@ -148,7 +277,10 @@ class SpscTaskQueue {
   /*! \brief The task entry */
   struct Task {
     ParallelLauncher* launcher;
+    /*! \brief The task id, or the participant index when stealing is set. */
     int32_t task_id;
+    /*! \brief Whether the worker runs the work-stealing loop of the launcher. */
+    bool stealing{false};
   };
 
   SpscTaskQueue() : buffer_(new Task[kRingSize]), head_(0), tail_(0) {}
@@ -259,7 +391,9 @@ class SpscTaskQueue {
 // The thread pool
 class ThreadPool {
  public:
-  ThreadPool() : num_workers_(tvm::runtime::threading::MaxConcurrency()) {
+  ThreadPool()
+      : num_workers_(tvm::runtime::threading::MaxConcurrency()),
+        steal_granularity_(GetWorkStealingGranularity()) {
     const char* exclude_worker0 = getenv("TVM_EXCLUDE_WORKER0");
     if (exclude_worker0 && atoi(exclude_worker0) == 0) {
       exclude_worker0_ = false;
@@ -267,6 +401,20 @@ class ThreadPool {
     Init();
   }
 
+  /*!
+   * \brief Construct a standalone pool with one worker pinned to each of the given cores.
+   *  The threads launching jobs into the pool do not run tasks themselves, so the jobs stay
+   *  on the cores of the pool.
+   * \param cpus The cores of the pool.
+   */
+  explicit ThreadPool(const std::vector<unsigned int>& cpus)
+      : num_workers_(static_cast<int>(cpus.size())),
+        steal_granularity_(GetWorkStealingGranularity()),
+        exclude_worker0_(false) {
+    Init();
+    UpdateWorkerConfiguration(threading::ThreadGroup::kSpecifyOneCorePerThread, 0, cpus);
+  }
+
   ~ThreadPool() {
     for (std::unique_ptr<SpscTaskQueue>& q : queues_) {
       q->SignalForKill();
@@ -286,10 +434,17 @@ class ThreadPool {
 
   int Launch(FTVMParallelLambda flambda, void* cdata, int num_task, int need_sync) {
     ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
-    ICHECK(!launcher->is_worker)
-        << "Cannot launch parallel job inside worker, consider fuse then parallel";
+    if (launcher->depth != 0) {
+      return LaunchNested(launcher, flambda, cdata, num_task, need_sync);
+    }
+    launcher->level = 0;
+    int budget = threading::NestedMaxConcurrency(0);
+    int num_threads = budget == 0 ? num_workers_used_ : std::min(budget, num_workers_used_);
+    if (steal_granularity_ != 0) {
+      return LaunchStealing(launcher, flambda, cdata, num_task, num_threads, need_sync);
+    }
     if (num_task == 0) {
-      num_task = num_workers_used_;
+      num_task = num_threads;
     }
     if (need_sync != 0) {
       ICHECK_LE(num_task, num_workers_used_)
@@ -302,16 +457,11 @@ class ThreadPool {
     // if worker0 is taken by the main, queues_[0] is abandoned
     for (int i = exclude_worker0_; i < num_task; ++i) {
       tsk.task_id = i;
-      queues_[i]->Push(tsk);
+      Dispatch(i, tsk);
     }
     // use the main thread to run task 0
     if (exclude_worker0_) {
-      TVMParallelGroupEnv* penv = &(tsk.launcher->env);
-      if ((*tsk.launcher->flambda)(0, penv, cdata) == 0) {
-        tsk.launcher->SignalJobFinish();
-      } else {
-        tsk.launcher->SignalJobError(tsk.task_id);
-      }
+      launcher->RunTask(0);
     }
     int res = launcher->WaitForJobs();
     return res;
@@ -319,6 +469,17 @@ class ThreadPool {
 
   static ThreadPool* ThreadLocal() { return dmlc::ThreadLocalStore<ThreadPool>::Get(); }
 
+  /*!
+   * \brief Get the pool parallel jobs of the calling thread are launched into. Worker
+   *  threads launch their nested jobs into the pool they belong to.
+   */
+  static ThreadPool* Current() {
+    ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
+    if (launcher->worker_pool != nullptr) return launcher->worker_pool;
+    if (launcher->bound_pool != nullptr) return launcher->bound_pool;
+    return ThreadLocal();
+  }
+
   void UpdateWorkerConfiguration(threading::ThreadGroup::AffinityMode mode, int nthreads,
                                  const std::vector<unsigned int>& cpus) {
     // this will also reset the affinity of the ThreadGroup
@@ -331,12 +492,110 @@ class ThreadPool {
 
   int32_t NumThreads() const { return num_workers_used_; }
 
+  /*!
+   * \brief Enable or disable the work-stealing mode.
+   * \param granularity The number of tasks per worker a job with unspecified task
+   *  count is split into, 0 disables work stealing.
+   */
+  void SetWorkStealingGranularity(int granularity) {
+    ICHECK_GE(granularity, 0) << "The work-stealing granularity cannot be negative";
+    steal_granularity_ = granularity;
+  }
+
  private:
+  /*!
+   * \brief Launch a job in work-stealing mode. The job is split into more tasks than
+   *  workers, which are distributed over per-worker ranges. Idle workers steal from the
+   *  ranges of busy ones, so a slow chunk does not hold back the whole parallel region.
+   */
+  int LaunchStealing(ParallelLauncher* launcher, FTVMParallelLambda flambda, void* cdata,
+                     int num_task, int num_threads, int need_sync) {
+    if (num_task == 0) {
+      num_task = num_threads * steal_granularity_;
+    }
+    int num_participants = std::min(num_task, num_threads);
+    // Barriers need all the tasks to be running at the same time, which only holds when no
+    // participant has to run more than one task. Otherwise no sync handle is provided.
+    launcher->Init(flambda, cdata, num_task, need_sync != 0 && num_task <= num_participants);
+    launcher->InitStealing(num_participants);
+    SpscTaskQueue::Task tsk;
+    tsk.launcher = launcher;
+    tsk.stealing = true;
+    for (int i = exclude_worker0_; i < num_participants; ++i) {
+      tsk.task_id = i;
+      Dispatch(i, tsk);
+    }
+    if (exclude_worker0_) {
+      launcher->RunStealingWorker(0);
+    }
+    return launcher->WaitForJobs();
+  }
+
+  /*!
+   * \brief Launch a job from inside a task of another parallel region. The calling thread
+   *  takes part and borrows the workers which are idle at the moment, bounded by the thread
+   *  budget of the nesting level, so the pool is never oversubscribed. Without idle workers
+   *  the job runs on the calling thread alone.
+   */
+  int LaunchNested(ParallelLauncher* launcher, FTVMParallelLambda flambda, void* cdata,
+                   int num_task, int need_sync) {
+    int level = launcher->depth;
+    int budget = threading::NestedMaxConcurrency(level);
+    int max_threads = budget == 0 ? num_workers_used_ : std::min(budget, num_workers_used_);
+    if (num_task != 0) {
+      max_threads = std::min(max_threads, num_task);
+    }
+    std::vector<int>& borrowed = launcher->borrowed_workers;
+    borrowed.clear();
+    for (int i = exclude_worker0_;
+         i < num_workers_used_ && static_cast<int>(borrowed.size()) + 1 < max_threads; ++i) {
+      if (TryClaim(i)) {
+        borrowed.push_back(i);
+      }
+    }
+    int num_participants = static_cast<int>(borrowed.size()) + 1;
+    if (num_task == 0) {
+      num_task = num_participants * std::max(steal_granularity_, 1);
+    }
+    launcher->level = level;
+    launcher->Init(flambda, cdata, num_task, need_sync != 0 && num_task <= num_participants);
+    launcher->InitStealing(num_participants);
+    SpscTaskQueue::Task tsk;
+    tsk.launcher = launcher;
+    tsk.stealing = true;
+    for (size_t i = 0; i < borrowed.size(); ++i) {
+      tsk.task_id = static_cast<int32_t>(i + 1);
+      queues_[borrowed[i]]->Push(tsk);
+    }
+    launcher->RunStealingWorker(0);
+    return launcher->WaitForJobs();
+  }
+
+  /*!
+   * \brief Try to reserve an idle worker. Only the thread holding the reservation may push
+   *  to the queue of the worker, which keeps the queues single producer even though nested
+   *  jobs are launched from several threads.
+   */
+  bool TryClaim(int worker_id) {
+    bool expected = false;
+    return claimed_[worker_id].compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+  }
+
+  // Reserve a worker, waiting for it to finish its previous task, and push a task to it.
+  void Dispatch(int worker_id, const SpscTaskQueue::Task& task) {
+    while (!TryClaim(worker_id)) {
+      tvm::runtime::threading::Yield();
+    }
+    queues_[worker_id]->Push(task);
+  }
+
   // Shared initialization code
   void Init() {
+    claimed_.reset(new std::atomic<bool>[num_workers_]);
     for (int i = 0; i < num_workers_; ++i) {
       // The SpscTaskQueue only hosts ONE item at a time
       queues_.emplace_back(std::make_unique<SpscTaskQueue>());
+      claimed_[i].store(false);
     }
     threads_ = std::make_unique<tvm::runtime::threading::ThreadGroup>(
         num_workers_, [this](int worker_id) { this->RunWorker(worker_id); },
@@ -348,31 +607,79 @@ class ThreadPool {
   void RunWorker(int worker_id) {
     SpscTaskQueue* queue = queues_[worker_id].get();
     SpscTaskQueue::Task task;
-    ParallelLauncher::ThreadLocal()->is_worker = true;
+    ParallelLauncher::ThreadLocal()->worker_pool = this;
     // Initialize the spin count (from envvar TVM_THREAD_POOL_SPIN_COUNT) on
     // the global first use of the ThreadPool.
     // TODO(tulloch): should we make this configurable via standard APIs?
     static size_t spin_count = GetSpinCount();
     while (queue->Pop(&task, spin_count)) {
       ICHECK(task.launcher != nullptr);
-      TVMParallelGroupEnv* penv = &(task.launcher->env);
-      void* cdata = task.launcher->cdata;
-      if ((*task.launcher->flambda)(task.task_id, penv, cdata) == 0) {
-        task.launcher->SignalJobFinish();
+      if (task.stealing) {
+        task.launcher->RunStealingWorker(task.task_id);
       } else {
-        task.launcher->SignalJobError(task.task_id);
+        task.launcher->RunTask(task.task_id);
       }
+      // the worker is idle again and can be borrowed by nested jobs
+      claimed_[worker_id].store(false, std::memory_order_release);
     }
   }
   int num_workers_;
   // number of workers used (can be restricted with affinity pref)
   int num_workers_used_;
+  // number of tasks per worker in work-stealing mode, 0 means static split
+  int steal_granularity_;
   // if or not to exclude worker 0 and use main to run task 0
   bool exclude_worker0_{true};
   std::vector<std::unique_ptr<SpscTaskQueue>> queues_;
+  // whether a worker is reserved by a producer, see TryClaim
+  std::unique_ptr<std::atomic<bool>[]> claimed_;
   std::unique_ptr<tvm::runtime::threading::ThreadGroup> threads_;
 };
 
+/*! \brief The named thread pools of the process. */
+class ThreadPoolRegistry {
+ public:
+  ThreadPool* Create(const std::string& name, const std::vector<unsigned int>& cpus,
+                     bool exist_ok) {
+    ICHECK(!name.empty()) << "The name of a thread pool cannot be empty";
+    ICHECK(!cpus.empty()) << "Thread pool " << name << " needs at least one core";
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pool = pools_[name];
+    if (pool != nullptr && exist_ok) {
+      return pool.get();
+    }
+    ICHECK(pool == nullptr) << "Thread pool " << name << " already exists";
+    pool = std::make_unique<ThreadPool>(cpus);
+    return pool.get();
+  }
+
+  ThreadPool* Get(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pools_.find(name);
+    ICHECK(it != pools_.end()) << "Cannot find thread pool " << name;
+    return it->second.get();
+  }
+
+  std::vector<std::string> ListNames() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    for (const auto& kv : pools_) {
+      names.push_back(kv.first);
+    }
+    return names;
+  }
+
+  static ThreadPoolRegistry* Global() {
+    // NOTE: explicitly use new to avoid exit-time destruction of the worker threads.
+    static auto* inst = new ThreadPoolRegistry();
+    return inst;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<ThreadPool>> pools_;
+};
+
 /*!
  * \brief args[0] is the AffinityMode, args[1] is the number of threads.
  *  args2 is a list of CPUs which is used to set the CPU affinity.
@@ -392,6 +699,35 @@ TVM_REGISTER_GLOBAL("runtime.config_threadpool").set_body([](TVMArgs args, TVMRe
   threading::Configure(mode, nthreads, cpus);
 });
 
+/*!
+ * \brief args[0] is the number of tasks per worker used in work-stealing mode,
+ *  0 restores the static split of one task per worker.
+ */
+TVM_REGISTER_GLOBAL("runtime.config_threadpool_work_stealing").set_body_typed([](int granularity) {
+  threading::ConfigureWorkStealing(granularity);
+});
+
+/*!
+ * \brief args[0] is the name of the new thread pool, args[1] is the list of its CPUs.
+ */
+TVM_REGISTER_GLOBAL("runtime.CreateThreadPool")
+    .set_body_typed([](String name, Array<String> cpu_array) {
+      std::vector<unsigned int> cpus;
+      for (auto cpu : cpu_array) {
+        ICHECK(IsNumber(cpu)) << "The CPU core information '" << cpu << "' is not a number.";
+        cpus.push_back(std::stoi(cpu));
+      }
+      threading::CreateThreadPool(name, cpus);
+    });
+
+TVM_REGISTER_GLOBAL("runtime.ListThreadPools").set_body_typed([]() {
+  Array<String> names;
+  for (const auto& name : ThreadPoolRegistry::Global()->ListNames()) {
+    names.push_back(name);
+  }
+  return names;
+});
+
 TVM_REGISTER_GLOBAL("runtime.NumThreads").set_body_typed([]() -> int32_t {
   return threading::NumThreads();
 });
@@ -414,7 +750,7 @@ static void ConfigureOMP(tvm::runtime::threading::ThreadGroup::AffinityMode mode
 #if defined(__linux__) || defined(__ANDROID__)
   const int num_workers = MaxConcurrency();
 
-  if (mode == ThreadGroup::kSpecifyOneCorePerThread) {
+  if (mode == ThreadGroup::kSpecifyOneCorePerThread || mode == ThreadGroup::kNumaNode) {
 #pragma omp parallel num_threads(num_workers)
     {
       int core_id = cpus[omp_get_thread_num()];
@@ -452,13 +788,22 @@ void ResetThreadPool() { tvm::runtime::ThreadPool::ThreadLocal()->Reset(); }
 /*!
  * \brief configure the CPU id affinity
  * \param mode The preferred CPU type (1 = big, -1 = little, -2 = kSpecifyOneCorePerThread,
- *  -3 = kSpecifyThreadShareAllCore).
+ *  -3 = kSpecifyThreadShareAllCore, -4 = kNumaNode).
  * \param nthreads The number of threads to use (0 = use all).
- * \param cpus cpus A list of CPUs is used to set the 'cpu affinity' for the worker threads.
+ * \param cpus cpus A list of CPUs is used to set the 'cpu affinity' for the worker threads,
+ *  or the id of the NUMA node for kNumaNode.
  *
  */
 TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode, int nthreads,
                        std::vector<unsigned int> cpus) {
+  int numa_node = -1;
+  if (mode == ThreadGroup::kNumaNode) {
+    ICHECK_EQ(cpus.size(), 1U) << "The NUMA affinity mode expects the id of one NUMA node";
+    numa_node = cpus[0];
+    cpus = NumaNodeCPUs(numa_node);
+    ICHECK(!cpus.empty()) << "Cannot find the CPUs of NUMA node " << numa_node;
+  }
+  SetBoundNumaNode(numa_node);
   tvm::runtime::threading::SetMaxConcurrency(cpus.size());
 #if !TVM_THREADPOOL_USE_OPENMP
   tvm::runtime::ThreadPool::ThreadLocal()->UpdateWorkerConfiguration(mode, nthreads, cpus);
@@ -467,11 +812,42 @@ TVM_DLL void Configure(tvm::runtime::threading::ThreadGroup::AffinityMode mode,
 #endif
 }
 int32_t NumThreads() { return tvm::runtime::ThreadPool::ThreadLocal()->NumThreads(); }
+void CreateThreadPool(const std::string& name, const std::vector<unsigned int>& cpus,
+                      bool exist_ok) {
+  ThreadPoolRegistry::Global()->Create(name, cpus, exist_ok);
+}
+
+ThreadPoolScope::ThreadPoolScope(const std::string& name) {
+  ParallelLauncher* launcher = ParallelLauncher::ThreadLocal();
+  prev_pool_ = launcher->bound_pool;
+  if (!name.empty()) {
+    launcher->bound_pool = ThreadPoolRegistry::Global()->Get(name);
+  }
+}
+
+ThreadPoolScope::~ThreadPoolScope() {
+  ParallelLauncher::ThreadLocal()->bound_pool = static_cast<ThreadPool*>(prev_pool_);
+}
+
+void ConfigureWorkStealing(int granularity) {
+#if !TVM_THREADPOOL_USE_OPENMP
+  tvm::runtime::ThreadPool::ThreadLocal()->SetWorkStealingGranularity(granularity);
+#endif
+}
+
+void SetParallelLaunchBackend(ParallelLaunchBackend backend) {
+  parallel_launch_backend.store(backend, std::memory_order_release);
+}
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
 
 int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_task) {
+  tvm::runtime::threading::ParallelLaunchBackend backend =
+      tvm::runtime::parallel_launch_backend.load(std::memory_order_acquire);
+  if (backend != nullptr) {
+    return (*backend)(flambda, cdata, num_task);
+  }
   int num_workers = tvm::runtime::threading::MaxConcurrency();
   if (num_workers == 1) {
     std::atomic<int32_t> sync_counter{0};
@@ -482,7 +858,7 @@ int TVMBackendParallelLaunch(FTVMParallelLambda flambda, void* cdata, int num_ta
     return 0;
   } else {
 #if !TVM_THREADPOOL_USE_OPENMP
-    int res = tvm::runtime::ThreadPool::ThreadLocal()->Launch(flambda, cdata, num_task, 1);
+    int res = tvm::runtime::ThreadPool::Current()->Launch(flambda, cdata, num_task, 1);
     return res;
 #else
     if (num_task == 0) num_task = num_workers;
@@ -503,6 +879,9 @@ int TVMBackendParallelBarrier(int task_id, TVMParallelGroupEnv* penv) {
 #pragma omp barrier
 #else
   using tvm::runtime::kSyncStride;
+  ICHECK(penv->sync_handle != nullptr)
+      << "Parallel barrier is not available when the job is split into more tasks than workers, "
+      << "consider disabling work stealing of the thread pool";
   int num_task = penv->num_task;
   std::atomic<int>* sync_counter = reinterpret_cast<std::atomic<int>*>(penv->sync_handle);
   int old_counter = sync_counter[task_id * kSyncStride].fetch_add(1, std::memory_order_release);
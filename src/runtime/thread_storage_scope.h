@@ -70,6 +70,8 @@ enum class StorageRank {
   kMMAMatrixB = 10,
   /*! \brief mma scope memory of accumulator */
   kMMAMatrixC = 11,
+  /*! \brief wgmma scope memory of accumulator, distributed over a warpgroup */
+  kWGMMAAccumulator = 12,
 };
 
 /*!
@@ -126,6 +128,8 @@ struct StorageScope {
         return "m16n8k8.matrixB" + tag;
       case StorageRank::kMMAMatrixC:
         return "m16n8k8.matrixC" + tag;
+      case StorageRank::kWGMMAAccumulator:
+        return "wgmma.accumulator" + tag;
       default:
         LOG(FATAL) << "unknown storage scope";
     }
@@ -175,6 +179,9 @@ struct StorageScope {
     } else if (s.compare(0, 15, "m16n8k8.matrixC") == 0) {
       r.rank = StorageRank::kMMAMatrixC;
       r.tag = s.substr(15, std::string::npos);
+    } else if (s.compare(0, 17, "wgmma.accumulator") == 0) {
+      r.rank = StorageRank::kWGMMAAccumulator;
+      r.tag = s.substr(17, std::string::npos);
     } else {
       LOG(FATAL) << "unknown storage scope " << s;
     }
@@ -34,6 +34,8 @@
 #endif
 #if defined(__linux__)
 #include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 #if defined(__hexagon__)
 extern "C" {
@@ -46,6 +48,10 @@ extern "C" {
 #define HEXAGON_STACK_ALIGNMENT 32
 #endif
 #include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
 #define CURRENT_THREAD_HANDLE (static_cast<std::thread::native_handle_type>(0))
 namespace tvm {
@@ -107,6 +113,25 @@ class QuRTThread {
 };
 #endif  // __hexagon__
 thread_local int max_concurrency = 0;
+// The NUMA node the pool of this thread is bound to.
+thread_local int bound_numa_node = -1;
+// The thread budget of each nesting level of parallel regions, 0 means no limit.
+std::atomic<int> nested_max_concurrency[kMaxNestedLevels];
+std::once_flag nested_max_concurrency_init;
+
+/*!
+ * \brief Read the initial per-level thread budget from the env variable
+ *  TVM_NESTED_NUM_THREADS, a comma separated list starting from the outermost level.
+ */
+void InitNestedMaxConcurrency() {
+  const char* val = getenv("TVM_NESTED_NUM_THREADS");
+  if (val == nullptr) return;
+  std::istringstream is(val);
+  std::string item;
+  for (int level = 0; level < kMaxNestedLevels && std::getline(is, item, ','); ++level) {
+    nested_max_concurrency[level].store(std::max(atoi(item.c_str()), 0));
+  }
+}
 class ThreadGroup::Impl {
  public:
   Impl(int num_workers, std::function<void(int)> worker_callback, bool exclude_worker0)
@@ -137,6 +162,7 @@ class ThreadGroup::Impl {
         break;
       case kSpecifyOneCorePerThread:
       case kSpecifyThreadShareAllCore:
+      case kNumaNode:
         num_workers_used = cpus.size();
         sorted_order_ = cpus;
         break;
@@ -205,6 +231,7 @@ class ThreadGroup::Impl {
         // let the threads share all the cpu cores.
         case kSpecifyOneCorePerThread:
         case kSpecifyThreadShareAllCore:
+        case kNumaNode:
           for (unsigned i = 0; i < threads_.size(); ++i) {
             SetThreadFullCpuAffinity(threads_[i].native_handle(), mode);
           }
@@ -230,6 +257,7 @@ class ThreadGroup::Impl {
         case kLittle:
         case kBig:
         case kSpecifyOneCorePerThread:
+        case kNumaNode:
           for (unsigned i = 0; i < threads_.size(); ++i) {
             bool reverse = mode == kLittle;
             unsigned core_id;
@@ -269,6 +297,7 @@ class ThreadGroup::Impl {
     switch (mode) {
       case kSpecifyOneCorePerThread:
       case kSpecifyThreadShareAllCore:
+      case kNumaNode:
         for (size_t i = 0; i < sorted_order_.size(); ++i) {
           ids.push_back(sorted_order_[i]);
         }
@@ -431,6 +460,76 @@ int MaxConcurrency() {
   return std::max(max_concurrency, 1);
 }
 
+void SetNestedMaxConcurrency(int level, int value) {
+  std::call_once(nested_max_concurrency_init, InitNestedMaxConcurrency);
+  ICHECK(level >= 0 && level < kMaxNestedLevels)
+      << "The nesting level " << level << " is out of range [0, " << kMaxNestedLevels << ")";
+  if (value < 0) {
+    LOG(WARNING) << "The thread budget '" << value << "' can not be negative "
+                 << "the setting of nested concurrency is not success.";
+    return;
+  }
+  nested_max_concurrency[level].store(value, std::memory_order_relaxed);
+}
+
+int NumNumaNodes() {
+  int num_nodes = 0;
+#if defined(__linux__)
+  while (true) {
+    std::ostringstream filepath;
+    filepath << "/sys/devices/system/node/node" << num_nodes << "/cpulist";
+    std::ifstream ifs(filepath.str());
+    if (ifs.fail()) break;
+    ++num_nodes;
+  }
+#endif
+  return num_nodes;
+}
+
+std::vector<unsigned int> NumaNodeCPUs(int node) {
+  std::vector<unsigned int> cpus;
+#if defined(__linux__)
+  // The cpulist is a comma separated list of ranges, e.g. "0-15,32-47".
+  std::ostringstream filepath;
+  filepath << "/sys/devices/system/node/node" << node << "/cpulist";
+  std::ifstream ifs(filepath.str());
+  std::string item;
+  while (std::getline(ifs, item, ',')) {
+    size_t dash = item.find('-');
+    unsigned int begin = std::stoul(item.substr(0, dash));
+    unsigned int end = dash == std::string::npos ? begin : std::stoul(item.substr(dash + 1));
+    for (unsigned int cpu = begin; cpu <= end; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+#endif
+  return cpus;
+}
+
+int BoundNumaNode() { return bound_numa_node; }
+
+void SetBoundNumaNode(int node) { bound_numa_node = node; }
+
+void BindMemoryToNumaNode(void* ptr, size_t nbytes, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // MPOL_PREFERRED from numaif.h, spelled out to avoid a dependency on libnuma.
+  constexpr int kMemPolicyPreferred = 1;
+  constexpr int kMaxNumaNodes = 1024;
+  ICHECK(node >= 0 && node < kMaxNumaNodes) << "Invalid NUMA node " << node;
+  uint64_t nodemask[kMaxNumaNodes / 64] = {0};
+  nodemask[node / 64] = 1UL << (node % 64);
+  if (syscall(SYS_mbind, ptr, nbytes, kMemPolicyPreferred, nodemask, kMaxNumaNodes, 0) != 0) {
+    LOG(WARNING) << "Failed to bind memory to NUMA node " << node;
+  }
+#endif
+}
+
+int NestedMaxConcurrency(int level) {
+  std::call_once(nested_max_concurrency_init, InitNestedMaxConcurrency);
+  if (level < 0 || level >= kMaxNestedLevels) return 1;
+  return nested_max_concurrency[level].load(std::memory_order_relaxed);
+}
+
 }  // namespace threading
 }  // namespace runtime
 }  // namespace tvm
@@ -0,0 +1,326 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/batcher.cc
+ * \brief Coalesces the requests to a function of the VM into batches.
+ */
+#include <tvm/runtime/container/adt.h>
+#include <tvm/runtime/container/shape_tuple.h>
+#include <tvm/runtime/data_type.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/module.h>
+#include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+namespace {
+
+/*!
+ * \brief Copy \p rows rows along \p axis from \p src, starting at row \p src_begin, into \p dst,
+ *  starting at row \p dst_begin. Both arrays are contiguous, on the CPU, and only differ in their
+ *  extent along the axis.
+ */
+void CopyRows(const NDArray& src, int64_t src_begin, const NDArray& dst, int64_t dst_begin,
+              int64_t rows, int axis) {
+  int64_t outer = 1;
+  for (int i = 0; i < axis; ++i) outer *= src->shape[i];
+  size_t inner = (src->dtype.bits * src->dtype.lanes + 7) / 8;
+  for (int i = axis + 1; i < src->ndim; ++i) inner *= src->shape[i];
+  int64_t src_rows = src->shape[axis];
+  int64_t dst_rows = dst->shape[axis];
+  const char* src_data = static_cast<const char*>(src->data) + src->byte_offset;
+  char* dst_data = static_cast<char*>(dst->data) + dst->byte_offset;
+  for (int64_t o = 0; o < outer; ++o) {
+    std::memcpy(dst_data + (o * dst_rows + dst_begin) * inner,
+                src_data + (o * src_rows + src_begin) * inner, rows * inner);
+  }
+}
+
+/*! \return The tensors of a result of the VM, copied to the CPU. */
+ObjectRef ToHost(const ObjectRef& obj) {
+  if (const auto* arr = obj.as<NDArray::ContainerType>()) {
+    NDArray nd = GetRef<NDArray>(arr);
+    return nd->device.device_type == kDLCPU ? nd : nd.CopyTo(Device{kDLCPU, 0});
+  }
+  ADT adt = Downcast<ADT>(obj);
+  std::vector<ObjectRef> fields;
+  for (size_t i = 0; i < adt.size(); ++i) fields.push_back(ToHost(adt[i]));
+  return ADT(adt.tag(), fields);
+}
+
+}  // namespace
+
+/*!
+ * \brief Accepts single requests to a function of the VM, and invokes the function on batches of
+ *  them.
+ *
+ *  A worker thread waits for the oldest pending request for at most the maximum latency, or until
+ *  the pending requests fill the largest batch bucket. It concatenates the inputs of the requests
+ *  along the batch axis, pads them with zeros to the smallest bucket holding them, so that the
+ *  function only sees the bucket sizes, and slices the outputs back along the same axis. The
+ *  inputs and outputs are on the CPU.
+ */
+class VMBatcher : public ModuleNode {
+ public:
+  VMBatcher(Module vm, std::string func_name, std::vector<int64_t> buckets, int batch_axis,
+            int64_t max_latency_us)
+      : vm_(vm),
+        func_name_(std::move(func_name)),
+        buckets_(std::move(buckets)),
+        batch_axis_(batch_axis),
+        max_latency_(max_latency_us) {
+    ICHECK(!buckets_.empty()) << "The batcher needs at least one batch bucket";
+    std::sort(buckets_.begin(), buckets_.end());
+    buckets_.erase(std::unique(buckets_.begin(), buckets_.end()), buckets_.end());
+    ICHECK_GE(buckets_.front(), 1) << "The batch buckets must be positive";
+    ICHECK_GE(batch_axis_, 0);
+    set_input_ = vm_.GetFunction("set_input");
+    invoke_ = vm_.GetFunction("invoke");
+    ICHECK(set_input_ != nullptr && invoke_ != nullptr) << "The module is not a VM";
+    worker_ = std::thread([this]() { this->WorkerMain(); });
+  }
+
+  ~VMBatcher() { this->Stop(); }
+
+  const char* type_key() const final { return "VMBatcher"; }
+
+  PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
+    if (name == "submit") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+        std::vector<NDArray> inputs;
+        for (int i = 1; i < args.size(); ++i) inputs.push_back(args[i]);
+        this->Submit(std::move(inputs), args[0]);
+      });
+    } else if (name == "stop") {
+      return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Stop(); });
+    }
+    return PackedFunc();
+  }
+
+  /*!
+   * \brief Queue a request.
+   * \param inputs The inputs of the function, with the same extent along the batch axis.
+   * \param callback Called on the worker thread with the outputs of the request and an empty
+   *  string, or with a null result and the error message of its batch.
+   */
+  void Submit(std::vector<NDArray> inputs, PackedFunc callback) {
+    Request req;
+    req.batch = -1;
+    for (NDArray& input : inputs) {
+      ICHECK_GT(input->ndim, batch_axis_) << "The input has no batch axis " << batch_axis_;
+      ICHECK(input.IsContiguous()) << "The inputs of the batcher must be contiguous";
+      int64_t batch = input->shape[batch_axis_];
+      ICHECK(req.batch < 0 || req.batch == batch)
+          << "The inputs of a request have different batch sizes";
+      req.batch = batch;
+      if (input->device.device_type != kDLCPU) input = input.CopyTo(Device{kDLCPU, 0});
+    }
+    ICHECK_GE(req.batch, 1) << "A request needs at least one batched input";
+    ICHECK_LE(req.batch, buckets_.back())
+        << "The request batch " << req.batch << " exceeds the largest bucket " << buckets_.back();
+    req.inputs = std::move(inputs);
+    req.callback = std::move(callback);
+    req.arrival = std::chrono::steady_clock::now();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ICHECK(!stop_) << "The batcher is stopped";
+      CheckSignature(req.inputs);
+      pending_rows_ += req.batch;
+      pending_.push_back(std::move(req));
+    }
+    cv_.notify_one();
+  }
+
+  /*! \brief Run the pending requests and stop the worker thread. */
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (stop_) return;
+      stop_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();
+  }
+
+ private:
+  struct Request {
+    std::vector<NDArray> inputs;
+    int64_t batch;
+    PackedFunc callback;
+    std::chrono::steady_clock::time_point arrival;
+  };
+
+  /*! \brief Check that the inputs match the ones of the first request, but for the batch size. */
+  void CheckSignature(const std::vector<NDArray>& inputs) {
+    if (signature_.empty()) {
+      signature_ = inputs;
+      return;
+    }
+    ICHECK_EQ(inputs.size(), signature_.size()) << "The requests have different numbers of inputs";
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const DLTensor* a = inputs[i].operator->();
+      const DLTensor* b = signature_[i].operator->();
+      bool same = a->ndim == b->ndim && DataType(a->dtype) == DataType(b->dtype);
+      for (int k = 0; same && k < a->ndim; ++k) {
+        same = k == batch_axis_ || a->shape[k] == b->shape[k];
+      }
+      ICHECK(same) << "Input " << i << " of the request does not match the previous requests";
+    }
+  }
+
+  void WorkerMain() {
+    int64_t max_batch = buckets_.back();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+      if (pending_.empty()) return;
+      // Wait for the batch to fill up, or the oldest request to reach the maximum latency.
+      cv_.wait_until(lock, pending_.front().arrival + max_latency_,
+                     [this, max_batch]() { return stop_ || pending_rows_ >= max_batch; });
+      std::vector<Request> batch;
+      int64_t rows = 0;
+      while (!pending_.empty() && rows + pending_.front().batch <= max_batch) {
+        rows += pending_.front().batch;
+        batch.push_back(std::move(pending_.front()));
+        pending_.pop_front();
+      }
+      pending_rows_ -= rows;
+      lock.unlock();
+      this->RunBatch(&batch, rows);
+      lock.lock();
+    }
+  }
+
+  void RunBatch(std::vector<Request>* batch, int64_t rows) {
+    int64_t bucket = *std::lower_bound(buckets_.begin(), buckets_.end(), rows);
+    std::vector<ObjectRef> results;
+    std::string error;
+    try {
+      std::vector<NDArray> inputs;
+      for (size_t i = 0; i < batch->front().inputs.size(); ++i) {
+        const NDArray& first = batch->front().inputs[i];
+        std::vector<int64_t> shape(first->shape, first->shape + first->ndim);
+        shape[batch_axis_] = bucket;
+        NDArray batched = NDArray::Empty(shape, first->dtype, Device{kDLCPU, 0});
+        if (rows < bucket) {
+          std::memset(batched->data, 0, GetDataSize(*batched.operator->()));
+        }
+        int64_t offset = 0;
+        for (const Request& req : *batch) {
+          CopyRows(req.inputs[i], 0, batched, offset, req.batch, batch_axis_);
+          offset += req.batch;
+        }
+        inputs.push_back(batched);
+      }
+      ObjectRef output = ToHost(this->Invoke(inputs));
+      int64_t offset = 0;
+      for (const Request& req : *batch) {
+        results.push_back(this->Slice(output, bucket, offset, req.batch));
+        offset += req.batch;
+      }
+    } catch (const std::exception& e) {
+      results.assign(batch->size(), ObjectRef());
+      error = e.what();
+    }
+    for (size_t i = 0; i < batch->size(); ++i) {
+      try {
+        (*batch)[i].callback(results[i], error);
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "The callback of a batched request failed: " << e.what();
+      }
+    }
+  }
+
+  ObjectRef Invoke(const std::vector<NDArray>& inputs) {
+    int num_args = static_cast<int>(inputs.size()) + 1;
+    std::vector<TVMValue> values(num_args);
+    std::vector<int> type_codes(num_args);
+    TVMArgsSetter setter(values.data(), type_codes.data());
+    setter(0, func_name_);
+    for (size_t i = 0; i < inputs.size(); ++i) setter(i + 1, inputs[i]);
+    TVMRetValue rv;
+    set_input_.CallPacked(TVMArgs(values.data(), type_codes.data(), num_args), &rv);
+    return invoke_(func_name_);
+  }
+
+  /*! \return The rows [begin, begin + rows) of the tensors of an output of the batch. */
+  ObjectRef Slice(const ObjectRef& obj, int64_t bucket, int64_t begin, int64_t rows) {
+    if (const auto* arr = obj.as<NDArray::ContainerType>()) {
+      NDArray src = GetRef<NDArray>(arr);
+      ICHECK(src->ndim > batch_axis_ && src->shape[batch_axis_] == bucket)
+          << "The outputs must be batched along the batch axis of the inputs";
+      std::vector<int64_t> shape(src->shape, src->shape + src->ndim);
+      shape[batch_axis_] = rows;
+      NDArray dst = NDArray::Empty(shape, src->dtype, src->device);
+      CopyRows(src, begin, dst, 0, rows, batch_axis_);
+      return dst;
+    }
+    ADT adt = Downcast<ADT>(obj);
+    std::vector<ObjectRef> fields;
+    for (size_t i = 0; i < adt.size(); ++i) fields.push_back(Slice(adt[i], bucket, begin, rows));
+    return ADT(adt.tag(), fields);
+  }
+
+  Module vm_;
+  std::string func_name_;
+  /*! \brief The batch sizes the function is invoked with, in increasing order. */
+  std::vector<int64_t> buckets_;
+  int batch_axis_;
+  std::chrono::microseconds max_latency_;
+  PackedFunc set_input_;
+  PackedFunc invoke_;
+
+  std::mutex mutex_;
+  /*! \brief Signals the worker that a request arrived, or the batcher stopped. */
+  std::condition_variable cv_;
+  std::deque<Request> pending_;
+  /*! \brief The sum of the batch sizes of the pending requests. */
+  int64_t pending_rows_{0};
+  /*! \brief The inputs of the first request. */
+  std::vector<NDArray> signature_;
+  bool stop_{false};
+  std::thread worker_;
+};
+
+TVM_REGISTER_GLOBAL("runtime._VMBatcher")
+    .set_body_typed([](Module vm, String func_name, ShapeTuple buckets, int batch_axis,
+                       int64_t max_latency_us) {
+      std::vector<int64_t> sizes(buckets.begin(), buckets.end());
+      return Module(make_object<VMBatcher>(vm, func_name, std::move(sizes), batch_axis,
+                                           max_latency_us));
+    });
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,316 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file runtime/best_fit_allocator.h
+ */
+#ifndef TVM_RUNTIME_VM_BEST_FIT_ALLOCATOR_H_
+#define TVM_RUNTIME_VM_BEST_FIT_ALLOCATOR_H_
+
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/vm/memory_manager.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+/*!
+ * \brief Allocator which carves buffers best-fit out of large device segments.
+ *
+ *  Freed buffers are merged with their free neighbours of the same segment, so requests of
+ *  varying sizes (e.g. dynamic sequence lengths) reuse memory instead of growing the pool.
+ *  The total device memory can be capped, and each thread keeps a small cache of recently
+ *  freed buffers which is used without taking the allocator lock.
+ */
+class BestFitAllocator final : public Allocator {
+ public:
+  static constexpr size_t kDefaultPageSize = 4096;
+  static constexpr size_t kDefaultSegmentSize = 2 << 20;
+  // Buffers up to this size are kept in the per-thread cache.
+  static constexpr size_t kMaxThreadCacheBufferSize = 1 << 20;
+  // The number of buffers each thread caches per allocator.
+  static constexpr size_t kMaxThreadCacheBuffers = 16;
+
+  /*!
+   * \brief Create the allocator.
+   * \param dev The device of the allocator.
+   * \param memory_limit The maximum number of bytes allocated from the device, 0 for no limit.
+   *  By default it is read in MB from the env variable TVM_VM_ALLOCATOR_MEMORY_LIMIT_MB.
+   * \param page_size The granularity of the buffers.
+   */
+  explicit BestFitAllocator(Device dev, size_t memory_limit = DefaultMemoryLimit(),
+                            size_t page_size = kDefaultPageSize)
+      : Allocator(kBestFit),
+        page_size_(page_size),
+        pool_(std::make_shared<Pool>(dev, memory_limit, page_size)) {}
+
+  ~BestFitAllocator() {
+    auto& caches = ThreadCaches();
+    auto it = caches.find(pool_.get());
+    if (it != caches.end()) {
+      caches.erase(it);
+    }
+    pool_->ReleaseFreeSegments();
+  }
+
+  Buffer Alloc(size_t nbytes, size_t alignment, DLDataType type_hint) override {
+    ICHECK_LE(alignment, page_size_) << "BestFitAllocator cannot align beyond the page size";
+    size_t size = std::max(((nbytes + page_size_ - 1) / page_size_) * page_size_, page_size_);
+    Buffer buf;
+    if (GetThreadCache()->Pop(size, &buf)) {
+      return buf;
+    }
+    return pool_->Alloc(size, alignment, type_hint);
+  }
+
+  void Free(const Buffer& buffer) override {
+    if (!GetThreadCache()->Push(buffer)) {
+      pool_->Free(buffer);
+    }
+  }
+
+  size_t UsedMemory() const override { return pool_->UsedMemory(); }
+
+ private:
+  static size_t DefaultMemoryLimit() {
+    const char* val = std::getenv("TVM_VM_ALLOCATOR_MEMORY_LIMIT_MB");
+    return val == nullptr ? 0 : static_cast<size_t>(std::atoll(val)) << 20;
+  }
+
+  /*! \brief The shared state of the allocator, kept alive by the thread caches using it. */
+  class Pool {
+   public:
+    Pool(Device dev, size_t memory_limit, size_t page_size)
+        : device_(dev), memory_limit_(memory_limit), page_size_(page_size) {
+      // Only devices with plain pointers can hand out parts of one allocation.
+      allow_split_ = dev.device_type == kDLCPU || dev.device_type == kDLCUDA ||
+                     dev.device_type == kDLCUDAHost || dev.device_type == kDLCUDAManaged ||
+                     dev.device_type == kDLROCM || dev.device_type == kDLROCMHost;
+    }
+
+    ~Pool() { ReleaseFreeSegments(); }
+
+    Buffer Alloc(size_t size, size_t alignment, DLDataType type_hint) {
+      std::lock_guard<std::mutex> lock(mu_);
+      Block* block;
+      auto it = free_blocks_.lower_bound(std::make_pair(size, static_cast<Block*>(nullptr)));
+      if (it != free_blocks_.end()) {
+        block = it->second;
+        free_blocks_.erase(it);
+      } else {
+        block = NewSegment(size, alignment, type_hint);
+      }
+      if (allow_split_ && block->size - size >= page_size_) {
+        Block* rest = new Block();
+        rest->data = static_cast<char*>(block->data) + size;
+        rest->size = block->size - size;
+        rest->free = true;
+        rest->prev = block;
+        rest->next = block->next;
+        if (block->next != nullptr) block->next->prev = rest;
+        block->next = rest;
+        block->size = size;
+        free_blocks_.emplace(rest->size, rest);
+      }
+      block->free = false;
+      used_blocks_[block->data] = block;
+      Buffer buf;
+      buf.device = device_;
+      buf.data = block->data;
+      buf.size = block->size;
+      return buf;
+    }
+
+    void Free(const Buffer& buffer) {
+      std::lock_guard<std::mutex> lock(mu_);
+      auto it = used_blocks_.find(buffer.data);
+      ICHECK(it != used_blocks_.end()) << "Buffer was not allocated by this allocator";
+      Block* block = it->second;
+      used_blocks_.erase(it);
+      block->free = true;
+      if (block->next != nullptr && block->next->free) {
+        Block* next = block->next;
+        free_blocks_.erase(std::make_pair(next->size, next));
+        block->size += next->size;
+        block->next = next->next;
+        if (next->next != nullptr) next->next->prev = block;
+        delete next;
+      }
+      if (block->prev != nullptr && block->prev->free) {
+        Block* prev = block->prev;
+        free_blocks_.erase(std::make_pair(prev->size, prev));
+        prev->size += block->size;
+        prev->next = block->next;
+        if (block->next != nullptr) block->next->prev = prev;
+        delete block;
+        block = prev;
+      }
+      free_blocks_.emplace(block->size, block);
+      VLOG(1) << "reclaim buffer " << buffer.size;
+    }
+
+    /*! \brief Give the segments which are entirely free back to the device. */
+    void ReleaseFreeSegments() {
+      std::lock_guard<std::mutex> lock(mu_);
+      ReleaseFreeSegmentsLocked();
+    }
+
+    size_t UsedMemory() const { return used_memory_.load(std::memory_order_relaxed); }
+
+   private:
+    /*! \brief A block of a segment, the blocks of a segment form a list in address order. */
+    struct Block {
+      void* data{nullptr};
+      size_t size{0};
+      bool free{false};
+      Block* prev{nullptr};
+      Block* next{nullptr};
+    };
+
+    Block* NewSegment(size_t size, size_t alignment, DLDataType type_hint) {
+      size_t segment_size = allow_split_ ? std::max(size, kDefaultSegmentSize) : size;
+      if (memory_limit_ != 0 && UsedMemory() + segment_size > memory_limit_) {
+        ReleaseFreeSegmentsLocked();
+        if (UsedMemory() + segment_size > memory_limit_) {
+          segment_size = size;
+        }
+        ICHECK_LE(UsedMemory() + segment_size, memory_limit_)
+            << "BestFitAllocator cannot allocate " << size << " B, " << UsedMemory()
+            << " B of the memory limit " << memory_limit_ << " B are in use";
+      }
+      // Segments are page aligned so every block carved out of them is as well.
+      alignment = allow_split_ ? page_size_ : alignment;
+      Block* block = new Block();
+      block->size = segment_size;
+      try {
+        block->data =
+            DeviceAPI::Get(device_)->AllocDataSpace(device_, segment_size, alignment, type_hint);
+      } catch (InternalError& err) {
+        LOG(WARNING) << "BestFitAllocator got InternalError during allocation: " << err.message();
+        LOG(WARNING) << "Trying to release all unused memory and reallocate...";
+        ReleaseFreeSegmentsLocked();
+        block->size = segment_size = size;
+        block->data =
+            DeviceAPI::Get(device_)->AllocDataSpace(device_, segment_size, alignment, type_hint);
+      }
+      used_memory_.fetch_add(segment_size, std::memory_order_relaxed);
+      VLOG(1) << "allocate segment of " << segment_size << " B, used memory " << used_memory_
+              << " B";
+      return block;
+    }
+
+    void ReleaseFreeSegmentsLocked() {
+      for (auto it = free_blocks_.begin(); it != free_blocks_.end();) {
+        Block* block = it->second;
+        if (block->prev == nullptr && block->next == nullptr) {
+          DeviceAPI::Get(device_)->FreeDataSpace(device_, block->data);
+          used_memory_.fetch_sub(block->size, std::memory_order_relaxed);
+          delete block;
+          it = free_blocks_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+      VLOG(1) << "release free segments, used memory " << used_memory_ << " B";
+    }
+
+    Device device_;
+    size_t memory_limit_;
+    size_t page_size_;
+    bool allow_split_;
+    std::atomic<size_t> used_memory_{0};
+    /*! \brief The free blocks ordered by size. */
+    std::set<std::pair<size_t, Block*>> free_blocks_;
+    /*! \brief The blocks in use, by data pointer. */
+    std::unordered_map<void*, Block*> used_blocks_;
+    std::mutex mu_;
+  };
+
+  /*! \brief Recently freed buffers of one thread, given back to the pool on thread exit. */
+  class ThreadCache {
+   public:
+    explicit ThreadCache(std::shared_ptr<Pool> pool) : pool_(std::move(pool)) {}
+    ThreadCache(ThreadCache&&) = default;
+    ThreadCache& operator=(ThreadCache&&) = default;
+    ~ThreadCache() {
+      if (pool_ == nullptr) return;
+      for (const Buffer& buf : buffers_) {
+        pool_->Free(buf);
+      }
+    }
+
+    bool Pop(size_t size, Buffer* buf) {
+      for (auto it = buffers_.rbegin(); it != buffers_.rend(); ++it) {
+        if (it->size == size) {
+          *buf = *it;
+          buffers_.erase(std::next(it).base());
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool Push(const Buffer& buf) {
+      if (buf.size > kMaxThreadCacheBufferSize) return false;
+      if (buffers_.size() == kMaxThreadCacheBuffers) {
+        pool_->Free(buffers_.front());
+        buffers_.erase(buffers_.begin());
+      }
+      buffers_.push_back(buf);
+      return true;
+    }
+
+   private:
+    std::shared_ptr<Pool> pool_;
+    std::vector<Buffer> buffers_;
+  };
+
+  static std::unordered_map<const Pool*, ThreadCache>& ThreadCaches() {
+    static thread_local std::unordered_map<const Pool*, ThreadCache> caches;
+    return caches;
+  }
+
+  ThreadCache* GetThreadCache() {
+    auto& caches = ThreadCaches();
+    auto it = caches.find(pool_.get());
+    if (it == caches.end()) {
+      it = caches.emplace(pool_.get(), ThreadCache(pool_)).first;
+    }
+    return &it->second;
+  }
+
+  size_t page_size_;
+  std::shared_ptr<Pool> pool_;
+};
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
+
+#endif  // TVM_RUNTIME_VM_BEST_FIT_ALLOCATOR_H_
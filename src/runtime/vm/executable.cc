@@ -24,6 +24,7 @@
 
 #include <dmlc/memory_io.h>
 #include <tvm/runtime/c_runtime_api.h>
+#include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/debug.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/runtime/vm/executable.h>
@@ -35,6 +36,7 @@
 #include <memory>
 #include <random>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -92,10 +94,15 @@ PackedFunc Executable::GetFunction(const String& name, const ObjectPtr<Object>&
     });
   } else if (name == "move_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
-      CHECK_EQ(args.size(), 2);
+      CHECK(args.size() == 2 || args.size() == 3);
       std::string path = args[0];
       uint64_t byte_limit = args[1];
-      MoveLateBoundConstantsToFile(path, static_cast<size_t>(byte_limit));
+      bool mappable = args.size() == 3 && static_cast<bool>(args[2]);
+      if (mappable) {
+        MoveLateBoundConstantsToMappableFile(path, static_cast<size_t>(byte_limit));
+      } else {
+        MoveLateBoundConstantsToFile(path, static_cast<size_t>(byte_limit));
+      }
     });
   } else if (name == "get_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
@@ -106,9 +113,10 @@ PackedFunc Executable::GetFunction(const String& name, const ObjectPtr<Object>&
     });
   } else if (name == "load_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
-      CHECK_EQ(args.size(), 1);
+      CHECK(args.size() == 1 || args.size() == 2);
       std::string path = args[0];
-      LoadLateBoundConstantsFromFile(path);
+      bool lazy = args.size() == 2 && args[1].operator bool();
+      LoadLateBoundConstantsFromFile(path, lazy);
     });
   } else if (name == "load_late_bound_consts_from_map") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
@@ -116,6 +124,66 @@ PackedFunc Executable::GetFunction(const String& name, const ObjectPtr<Object>&
       Map<String, NDArray> map = args[0];
       LoadLateBoundConstantsFromMap(map);
     });
+  } else if (name == "add_shape_specialization") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      CHECK_EQ(args.size(), 3) << "Expected (primitive name, argument shapes, kernel name)";
+      std::string prim_name = args[0];
+      Array<ShapeTuple> arg_shapes = args[1];
+      std::string func_name = args[2];
+      std::vector<std::vector<int64_t>> shapes;
+      for (const ShapeTuple& shape : arg_shapes) {
+        shapes.emplace_back(shape.begin(), shape.end());
+      }
+      AddShapeSpecialization(prim_name, shapes, func_name);
+    });
+  } else if (name == "get_shape_specializations") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      Map<String, ObjectRef> ret;
+      for (const auto& it : shape_specializations) {
+        Array<ObjectRef> specs;
+        for (const ShapeSpecialization& spec : it.second) {
+          specs.push_back(Array<ObjectRef>{ShapeTuple(spec.shape_key), String(spec.func_name)});
+        }
+        ret.Set(it.first, specs);
+      }
+      *rv = ret;
+    });
+  } else if (name == "add_kernel_variant") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      CHECK_EQ(args.size(), 2) << "Expected (primitive name, kernel name)";
+      AddKernelVariant(args[0], args[1]);
+    });
+  } else if (name == "set_variant_choice") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      CHECK_EQ(args.size(), 3) << "Expected (primitive name, argument shapes, kernel name)";
+      std::string prim_name = args[0];
+      Array<ShapeTuple> arg_shapes = args[1];
+      std::string func_name = args[2];
+      std::vector<std::vector<int64_t>> shapes;
+      for (const ShapeTuple& shape : arg_shapes) {
+        shapes.emplace_back(shape.begin(), shape.end());
+      }
+      SetVariantChoice(prim_name, shapes, func_name);
+    });
+  } else if (name == "get_kernel_variants") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
+      // For each primitive, its variants and the kernel chosen per shape bucket.
+      Map<String, ObjectRef> ret;
+      for (const auto& it : kernel_variants) {
+        Array<String> func_names;
+        for (const std::string& func_name : it.second.func_names) {
+          func_names.push_back(func_name);
+        }
+        Array<ObjectRef> choices;
+        for (const auto& choice : it.second.choices) {
+          choices.push_back(Array<ObjectRef>{ShapeTuple(choice.first), String(choice.second)});
+        }
+        ret.Set(it.first, Array<ObjectRef>{func_names, choices});
+      }
+      *rv = ret;
+    });
+  } else if (name == "release_device_constants") {
+    return PackedFunc([this](TVMArgs args, TVMRetValue* rv) { ReleaseDeviceConstants(); });
   }
   return nullptr;
 }
@@ -300,6 +368,12 @@ TVMByteArray Executable::Save() {
   // Code section.
   SaveCodeSection(&strm);
 
+  // Shape specialization section.
+  SaveShapeSpecializationSection(&strm);
+
+  // Kernel variant section.
+  SaveKernelVariantSection(&strm);
+
   TVMByteArray arr;
   arr.data = code_.c_str();
   arr.size = code_.length();
@@ -347,15 +421,42 @@ void Executable::MoveLateBoundConstantsToFile(const std::string& path, size_t by
   MoveLateBoundConstantsToStream(&stream, byte_limit);
 }
 
+void Executable::MoveLateBoundConstantsToMappableFile(const std::string& path,
+                                                      size_t byte_limit) {
+  Map<String, NDArray> map = GetLateBoundConstants(byte_limit);
+  runtime::SaveMappableParams(path, map);
+}
+
 void Executable::LoadLateBoundConstantsFromStream(dmlc::Stream* stream) {
   if (late_bound_constant_names.empty()) {
     VLOG(1) << "Found no late-bound constants to load";
     return;
   }
   ICHECK_EQ(late_bound_constant_names.size(), constants.size());
-  Map<String, NDArray> map = runtime::LoadParams(stream);
-  VLOG(1) << "loaded " << map.size() << " late-bound constants";
-  LoadLateBoundConstantsFromMap(map);
+  std::unordered_map<std::string, size_t> name_to_index;
+  for (size_t const_index = 0; const_index < constants.size(); ++const_index) {
+    if (late_bound_constant_names[const_index].defined()) {
+      name_to_index.emplace(late_bound_constant_names[const_index], const_index);
+    }
+  }
+  // Each tensor is read straight into its constant rather than through a dictionary.
+  size_t num_loaded = 0;
+  runtime::StreamParams(stream, [&](const std::string& name, const std::vector<int64_t>& shape,
+                                    DLDataType dtype) -> NDArray {
+    auto itr = name_to_index.find(name);
+    ICHECK(itr != name_to_index.end()) << "Unused late-bound constant '" << name << "'";
+    ICHECK(!constants[itr->second].defined()) << "Duplicate late-bound constant '" << name << "'";
+    NDArray array = NDArray::Empty(ShapeTuple(shape.begin(), shape.end()), dtype, {kDLCPU, 0});
+    constants[itr->second] = array;
+    ++num_loaded;
+    return array;
+  });
+  VLOG(1) << "loaded " << num_loaded << " late-bound constants";
+  for (const auto& kv : name_to_index) {
+    ICHECK(constants[kv.second].defined()) << "No binding for late-bound constant at index "
+                                           << kv.second << " with name '" << kv.first << "'";
+  }
+  late_bound_constant_names.clear();
 }
 
 void Executable::LoadLateBoundConstantsFromMap(Map<String, NDArray> map) {
@@ -377,11 +478,60 @@ void Executable::LoadLateBoundConstantsFromMap(Map<String, NDArray> map) {
   ICHECK(map.empty()) << "Have " << map.size() << " unused late-bound constants";
 }
 
-void Executable::LoadLateBoundConstantsFromFile(const std::string& path) {
+void Executable::LoadLateBoundConstantsFromFile(const std::string& path, bool lazy) {
+  // Mapped files are lazy already, they are read only as the constants are touched.
+  if (lazy && !late_bound_constant_names.empty() && !runtime::IsMappableParamsFile(path)) {
+    auto params = std::make_shared<LazyParams>(path);
+    for (size_t const_index = 0; const_index < constants.size(); ++const_index) {
+      const String& name = late_bound_constant_names[const_index];
+      if (!name.defined()) continue;
+      ICHECK(params->Contains(name)) << "No binding for late-bound constant at index "
+                                     << const_index << " with name '" << name << "'";
+    }
+    // The names are kept, they map constant indices to tensors of the file.
+    lazy_constants_ = std::move(params);
+    return;
+  }
+  if (!late_bound_constant_names.empty() && runtime::IsMappableParamsFile(path)) {
+    // The constants alias the mapping, nothing is read until it is touched.
+    Map<String, NDArray> map = runtime::LoadMappedParams(path);
+    VLOG(1) << "mapped " << map.size() << " late-bound constants";
+    LoadLateBoundConstantsFromMap(map);
+    return;
+  }
   tvm::runtime::SimpleBinaryFileStream stream(path, "rb");
   LoadLateBoundConstantsFromStream(&stream);
 }
 
+ObjectRef Executable::GetDeviceConstant(Index const_index, Device dev,
+                                        const std::function<ObjectRef()>& upload) {
+  ICHECK_LT(static_cast<size_t>(const_index), constants.size())
+      << "Constant index " << const_index << " is out of range";
+  // Uploads happen under the lock so that concurrent VMs racing on a cold constant end up
+  // sharing one copy rather than each allocating its own.
+  std::lock_guard<std::mutex> lock(device_constants_mutex_);
+  std::vector<ObjectRef>& pool = device_constants_[dev];
+  if (pool.size() < constants.size()) {
+    pool.resize(constants.size());
+  }
+  if (!pool[const_index].defined()) {
+    pool[const_index] = upload();
+  }
+  return pool[const_index];
+}
+
+NDArray Executable::LoadLazyConstant(Index const_index, Device dev) {
+  ICHECK(lazy_constants_ != nullptr && static_cast<size_t>(const_index) <
+                                           late_bound_constant_names.size())
+      << "Constant " << const_index << " has not been loaded";
+  return lazy_constants_->Load(late_bound_constant_names[const_index], dev);
+}
+
+void Executable::ReleaseDeviceConstants() {
+  std::lock_guard<std::mutex> lock(device_constants_mutex_);
+  device_constants_.clear();
+}
+
 void Executable::SaveGlobalSection(dmlc::Stream* strm) {
   std::vector<std::pair<std::string, Index>> globals(this->global_map.begin(),
                                                      this->global_map.end());
@@ -692,14 +842,28 @@ VMInstructionSerializer SerializeInstruction(const Instruction& instr) {
 }
 
 void Executable::SaveCodeSection(dmlc::Stream* strm) {
+  if (save_compact_code) {
+    strm->Write(kTVMVMCompactCodeMagic);
+  }
   // Save the number of functions.
   strm->Write(static_cast<uint64_t>(this->functions.size()));
+  std::string code;
   for (const auto& func : this->functions) {
     // Save the function info.
     VMFunctionSerializer func_format(func.name, func.register_file_size, func.instructions.size(),
                                      func.params, func.param_device_indexes);
     func_format.Save(strm);
 
+    if (save_compact_code) {
+      // Save the instructions of the function as one string.
+      code.clear();
+      for (const auto& instr : func.instructions) {
+        SerializeInstruction(instr).SaveCompact(&code);
+      }
+      strm->Write(code);
+      continue;
+    }
+
     // Serialize each instruction.
     for (const auto& instr : func.instructions) {
       const auto& serialized_instr = SerializeInstruction(instr);
@@ -772,6 +936,12 @@ runtime::Module Executable::Load(const std::string& code, const runtime::Module
   // Code section.
   exec->LoadCodeSection(&strm);
 
+  // Shape specialization section.
+  exec->LoadShapeSpecializationSection(&strm);
+
+  // Kernel variant section.
+  exec->LoadKernelVariantSection(&strm);
+
   return runtime::Module(exec);
 }
 
@@ -1013,9 +1183,15 @@ void Executable::LoadCodeSection(dmlc::Stream* strm) {
   // Load the number of functions.
   uint64_t sz;
   STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "code");
+  bool compact = sz == kTVMVMCompactCodeMagic;
+  if (compact) {
+    STREAM_CHECK(strm->Read(&sz, sizeof(sz)), "code");
+  }
 
   size_t num_funcs = static_cast<size_t>(sz);
   this->functions.resize(num_funcs);
+  std::string code;
+  VMInstructionSerializer compact_instr;
   for (size_t i = 0; i < num_funcs; i++) {
     // Load the function info.
     VMFunctionSerializer loaded_func;
@@ -1023,16 +1199,26 @@ void Executable::LoadCodeSection(dmlc::Stream* strm) {
 
     // Load the instructions.
     std::vector<Instruction> instructions;
-    for (size_t j = 0; j < loaded_func.num_instructions; j++) {
-      VMInstructionSerializer instr;
-      std::vector<Index> instr_fields;
-      STREAM_CHECK(instr.Load(strm), "code/instruction");
-      instructions.push_back(DeserializeInstruction(instr));
+    instructions.reserve(loaded_func.num_instructions);
+    if (compact) {
+      STREAM_CHECK(strm->Read(&code), "code/instruction");
+      size_t pos = 0;
+      for (size_t j = 0; j < loaded_func.num_instructions; j++) {
+        STREAM_CHECK(compact_instr.LoadCompact(code, &pos), "code/instruction");
+        instructions.push_back(DeserializeInstruction(compact_instr));
+      }
+      STREAM_CHECK(pos == code.size(), "code/instruction");
+    } else {
+      for (size_t j = 0; j < loaded_func.num_instructions; j++) {
+        VMInstructionSerializer instr;
+        STREAM_CHECK(instr.Load(strm), "code/instruction");
+        instructions.push_back(DeserializeInstruction(instr));
+      }
     }
 
     // Create the VM function.
     VMFunction vm_func =
-        VMFunction(loaded_func.name, loaded_func.params, instructions,
+        VMFunction(loaded_func.name, loaded_func.params, std::move(instructions),
                    loaded_func.register_file_size, loaded_func.param_device_indexes);
     auto it = this->global_map.find(loaded_func.name);
     ICHECK(it != this->global_map.end());
@@ -1041,6 +1227,152 @@ void Executable::LoadCodeSection(dmlc::Stream* strm) {
   }
 }
 
+void Executable::SaveShapeSpecializationSection(dmlc::Stream* strm) {
+  std::vector<std::string> prim_names;
+  std::vector<std::vector<std::vector<int64_t>>> shape_keys;
+  std::vector<std::vector<std::string>> func_names;
+  for (const auto& it : shape_specializations) {
+    prim_names.push_back(it.first);
+    shape_keys.emplace_back();
+    func_names.emplace_back();
+    for (const ShapeSpecialization& spec : it.second) {
+      shape_keys.back().push_back(spec.shape_key);
+      func_names.back().push_back(spec.func_name);
+    }
+  }
+  strm->Write(prim_names);
+  strm->Write(shape_keys);
+  strm->Write(func_names);
+}
+
+void Executable::LoadShapeSpecializationSection(dmlc::Stream* strm) {
+  std::vector<std::string> prim_names;
+  // The section is optional, executables saved without it simply end here.
+  if (!strm->Read(&prim_names)) {
+    return;
+  }
+  std::vector<std::vector<std::vector<int64_t>>> shape_keys;
+  std::vector<std::vector<std::string>> func_names;
+  STREAM_CHECK(strm->Read(&shape_keys), "shape specialization keys");
+  STREAM_CHECK(strm->Read(&func_names), "shape specialization functions");
+  STREAM_CHECK(shape_keys.size() == prim_names.size() && func_names.size() == prim_names.size(),
+               "shape specialization");
+  for (size_t i = 0; i < prim_names.size(); ++i) {
+    STREAM_CHECK(shape_keys[i].size() == func_names[i].size(), "shape specialization");
+    std::vector<ShapeSpecialization>& specs = shape_specializations[prim_names[i]];
+    for (size_t j = 0; j < shape_keys[i].size(); ++j) {
+      specs.push_back(
+          ShapeSpecialization{std::move(shape_keys[i][j]), std::move(func_names[i][j])});
+    }
+  }
+}
+
+void Executable::AddShapeSpecialization(const std::string& prim_name,
+                                        const std::vector<std::vector<int64_t>>& arg_shapes,
+                                        const std::string& func_name) {
+  ICHECK(primitive_map.count(prim_name)) << "Unknown primitive " << prim_name;
+  ShapeSpecialization spec;
+  for (const std::vector<int64_t>& shape : arg_shapes) {
+    spec.shape_key.push_back(static_cast<int64_t>(shape.size()));
+    spec.shape_key.insert(spec.shape_key.end(), shape.begin(), shape.end());
+  }
+  spec.func_name = func_name;
+  std::vector<ShapeSpecialization>& specs = shape_specializations[prim_name];
+  for (ShapeSpecialization& existing : specs) {
+    if (existing.shape_key == spec.shape_key) {
+      existing.func_name = func_name;
+      return;
+    }
+  }
+  specs.push_back(std::move(spec));
+}
+
+std::vector<int64_t> ShapeBucketKey(const std::vector<int64_t>& shape_key) {
+  std::vector<int64_t> bucket;
+  bucket.reserve(shape_key.size());
+  for (size_t i = 0; i < shape_key.size();) {
+    int64_t ndim = shape_key[i++];
+    bucket.push_back(ndim);
+    for (int64_t j = 0; j < ndim && i < shape_key.size(); ++j, ++i) {
+      int64_t dim = 1;
+      while (dim < shape_key[i]) dim <<= 1;
+      bucket.push_back(shape_key[i] > 0 ? dim : shape_key[i]);
+    }
+  }
+  return bucket;
+}
+
+void Executable::SaveKernelVariantSection(dmlc::Stream* strm) {
+  std::vector<std::string> prim_names;
+  std::vector<std::vector<std::string>> func_names;
+  std::vector<std::vector<std::vector<int64_t>>> bucket_keys;
+  std::vector<std::vector<std::string>> choices;
+  for (const auto& it : kernel_variants) {
+    prim_names.push_back(it.first);
+    func_names.push_back(it.second.func_names);
+    bucket_keys.emplace_back();
+    choices.emplace_back();
+    for (const auto& choice : it.second.choices) {
+      bucket_keys.back().push_back(choice.first);
+      choices.back().push_back(choice.second);
+    }
+  }
+  strm->Write(prim_names);
+  strm->Write(func_names);
+  strm->Write(bucket_keys);
+  strm->Write(choices);
+}
+
+void Executable::LoadKernelVariantSection(dmlc::Stream* strm) {
+  std::vector<std::string> prim_names;
+  // The section is optional, executables saved without it simply end here.
+  if (!strm->Read(&prim_names)) {
+    return;
+  }
+  std::vector<std::vector<std::string>> func_names;
+  std::vector<std::vector<std::vector<int64_t>>> bucket_keys;
+  std::vector<std::vector<std::string>> choices;
+  STREAM_CHECK(strm->Read(&func_names), "kernel variant functions");
+  STREAM_CHECK(strm->Read(&bucket_keys), "kernel variant buckets");
+  STREAM_CHECK(strm->Read(&choices), "kernel variant choices");
+  STREAM_CHECK(func_names.size() == prim_names.size() && bucket_keys.size() == prim_names.size() &&
+                   choices.size() == prim_names.size(),
+               "kernel variant");
+  for (size_t i = 0; i < prim_names.size(); ++i) {
+    STREAM_CHECK(bucket_keys[i].size() == choices[i].size(), "kernel variant");
+    KernelVariants& variants = kernel_variants[prim_names[i]];
+    variants.func_names = std::move(func_names[i]);
+    for (size_t j = 0; j < choices[i].size(); ++j) {
+      variants.choices[std::move(bucket_keys[i][j])] = std::move(choices[i][j]);
+    }
+  }
+}
+
+void Executable::AddKernelVariant(const std::string& prim_name, const std::string& func_name) {
+  ICHECK(primitive_map.count(prim_name)) << "Unknown primitive " << prim_name;
+  std::vector<std::string>& func_names = kernel_variants[prim_name].func_names;
+  if (std::find(func_names.begin(), func_names.end(), func_name) == func_names.end()) {
+    func_names.push_back(func_name);
+  }
+}
+
+void Executable::SetVariantChoice(const std::string& prim_name,
+                                  const std::vector<std::vector<int64_t>>& arg_shapes,
+                                  const std::string& func_name) {
+  ICHECK(primitive_map.count(prim_name)) << "Unknown primitive " << prim_name;
+  KernelVariants& variants = kernel_variants[prim_name];
+  ICHECK(func_name == prim_name || std::find(variants.func_names.begin(),
+                                             variants.func_names.end(),
+                                             func_name) != variants.func_names.end())
+      << func_name << " is not a variant of " << prim_name;
+  std::vector<int64_t> shape_key;
+  for (const std::vector<int64_t>& shape : arg_shapes) {
+    shape_key.push_back(static_cast<int64_t>(shape.size()));
+    shape_key.insert(shape_key.end(), shape.begin(), shape.end());
+  }
+  variants.choices[ShapeBucketKey(shape_key)] = func_name;
+}
+
 void Executable::SaveToBinary(dmlc::Stream* stream) {
   auto code_bytes = this->Save();
   std::string code(code_bytes.data, code_bytes.size);
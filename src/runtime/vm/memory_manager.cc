@@ -26,8 +26,10 @@
 #include <memory>
 #include <utility>
 
+#include "best_fit_allocator.h"
 #include "naive_allocator.h"
 #include "pooled_allocator.h"
+#include "stream_ordered_allocator.h"
 
 namespace tvm {
 namespace runtime {
@@ -76,12 +78,12 @@ inline size_t GetDataAlignment(const DLTensor& arr) {
   return align;
 }
 
-NDArray StorageObj::AllocNDArray(size_t offset, std::vector<int64_t> shape, DLDataType dtype) {
+NDArray StorageObj::AllocNDArray(size_t offset, ShapeTuple shape, DLDataType dtype) {
   VerifyDataType(dtype);
 
   // crtical zone: allocate header, cannot throw
   NDArray::Container* container =
-      new NDArray::Container(this->buffer.data, shape, dtype, this->buffer.device);
+      new NDArray::Container(this->buffer.data, std::move(shape), dtype, this->buffer.device);
   container->dl_tensor.byte_offset = offset;
 
   container->SetDeleter(StorageObj::Deleter);
@@ -130,6 +132,18 @@ Allocator* MemoryManager::GetOrCreateAllocator(Device dev, AllocatorType type) {
         alloc.reset(new PooledAllocator(dev));
         break;
       }
+      case kBestFit: {
+        VLOG(1) << "New best-fit allocator for " << DeviceName(dev.device_type) << "("
+                << dev.device_id << ")";
+        alloc.reset(new BestFitAllocator(dev));
+        break;
+      }
+      case kStreamOrdered: {
+        VLOG(1) << "New stream-ordered allocator for " << DeviceName(dev.device_type) << "("
+                << dev.device_id << ")";
+        alloc.reset(new StreamOrderedAllocator(dev));
+        break;
+      }
       default:
         LOG(FATAL) << "Unknown allocator type: " << type;
     }
@@ -0,0 +1,282 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file src/runtime/vm/paged_kv_cache.cc
+ * \brief A key/value cache of the attention layers, in fixed-size pages shared by sequences.
+ */
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/logging.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/runtime/vm/paged_kv_cache.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+
+TVM_REGISTER_OBJECT_TYPE(PagedKVCacheObj);
+
+PagedKVCacheObj::PagedKVCacheObj(int64_t num_layers, int64_t num_heads, int64_t head_dim,
+                                 int64_t page_size, int64_t num_pages, DLDataType dtype,
+                                 Device dev, AllocatorType alloc_type)
+    : num_layers_(num_layers),
+      num_pages_(num_pages),
+      page_size_(page_size),
+      token_elems_(num_heads * head_dim) {
+  ICHECK_GT(num_layers, 0);
+  ICHECK_GT(token_elems_, 0);
+  ICHECK_GT(page_size, 0);
+  ICHECK_GT(num_pages, 0);
+  allocator_ = MemoryManager::GetOrCreateAllocator(dev, alloc_type);
+  pages = allocator_->Empty({num_layers, 2, num_pages, page_size, num_heads, head_dim}, dtype, dev);
+  ref_counts_.resize(num_pages, 0);
+  // Hand out the pages in increasing order.
+  for (int64_t i = num_pages - 1; i >= 0; --i) free_pages_.push_back(static_cast<int32_t>(i));
+}
+
+PagedKVCacheObj::Sequence& PagedKVCacheObj::GetSequence(int64_t seq_id) {
+  auto it = seqs_.find(seq_id);
+  ICHECK(it != seqs_.end()) << "Sequence " << seq_id << " is not in the cache";
+  return it->second;
+}
+
+int64_t PagedKVCacheObj::GetSequenceLength(int64_t seq_id) const {
+  auto it = seqs_.find(seq_id);
+  ICHECK(it != seqs_.end()) << "Sequence " << seq_id << " is not in the cache";
+  return it->second.length;
+}
+
+void PagedKVCacheObj::AddSequence(int64_t seq_id) {
+  ICHECK(!seqs_.count(seq_id)) << "Sequence " << seq_id << " is already in the cache";
+  seqs_.emplace(seq_id, Sequence());
+}
+
+void PagedKVCacheObj::RemoveSequence(int64_t seq_id) {
+  for (int32_t page : GetSequence(seq_id).pages) ReleasePage(page);
+  seqs_.erase(seq_id);
+}
+
+void PagedKVCacheObj::ForkSequence(int64_t parent_seq_id, int64_t child_seq_id) {
+  ICHECK(!seqs_.count(child_seq_id)) << "Sequence " << child_seq_id << " is already in the cache";
+  Sequence child = GetSequence(parent_seq_id);
+  for (int32_t page : child.pages) ++ref_counts_[page];
+  seqs_.emplace(child_seq_id, std::move(child));
+}
+
+int32_t PagedKVCacheObj::AllocPage() {
+  ICHECK(!free_pages_.empty()) << "The paged KV cache is out of pages";
+  int32_t page = free_pages_.back();
+  free_pages_.pop_back();
+  ref_counts_[page] = 1;
+  return page;
+}
+
+void PagedKVCacheObj::ReleasePage(int32_t page) {
+  if (--ref_counts_[page] == 0) free_pages_.push_back(page);
+}
+
+DLTensor PagedKVCacheObj::SlotView(int64_t layer, int kv, int32_t page, int64_t slot,
+                                   int64_t* shape) const {
+  DLTensor view = *pages.operator->();
+  int64_t elem = ((layer * 2 + kv) * num_pages_ + page) * page_size_ + slot;
+  view.byte_offset += elem * token_elems_ * ((view.dtype.bits * view.dtype.lanes + 7) / 8);
+  view.ndim = 1;
+  view.shape = shape;
+  view.strides = nullptr;
+  return view;
+}
+
+void PagedKVCacheObj::CopyPage(int32_t src, int32_t dst, int64_t num_slots) {
+  Device dev = pages->device;
+  TVMStreamHandle stream =
+      dev.device_type == kDLCPU ? nullptr : DeviceAPI::Get(dev)->GetCurrentStream(dev);
+  int64_t shape = num_slots * token_elems_;
+  for (int64_t layer = 0; layer < num_layers_; ++layer) {
+    for (int kv = 0; kv < 2; ++kv) {
+      DLTensor from = SlotView(layer, kv, src, 0, &shape);
+      DLTensor to = SlotView(layer, kv, dst, 0, &shape);
+      NDArray::CopyFromTo(&from, &to, stream);
+    }
+  }
+}
+
+void PagedKVCacheObj::BeginForward(ShapeTuple seq_ids, ShapeTuple append_lengths) {
+  ICHECK_EQ(seq_ids.size(), append_lengths.size());
+  ICHECK_GT(seq_ids.size(), 0);
+  // Check that the new tokens fit before changing any sequence.
+  std::unordered_set<int64_t> seen;
+  int64_t num_new_pages = 0;
+  for (size_t i = 0; i < seq_ids.size(); ++i) {
+    ICHECK(seen.insert(seq_ids[i]).second) << "Sequence " << seq_ids[i] << " is repeated";
+    ICHECK_GE(append_lengths[i], 0);
+    const Sequence& seq = GetSequence(seq_ids[i]);
+    int64_t num_pages = (seq.length + append_lengths[i] + page_size_ - 1) / page_size_;
+    num_new_pages += num_pages - static_cast<int64_t>(seq.pages.size());
+    if (append_lengths[i] > 0 && seq.length % page_size_ != 0 &&
+        ref_counts_[seq.pages.back()] > 1) {
+      ++num_new_pages;
+    }
+  }
+  ICHECK_LE(num_new_pages, NumFreePages())
+      << "The paged KV cache is out of pages: " << num_new_pages << " more pages are needed and "
+      << NumFreePages() << " are free";
+
+  size_t batch = seq_ids.size();
+  fwd_seq_ids_.assign(seq_ids.begin(), seq_ids.end());
+  fwd_lengths_.assign(append_lengths.begin(), append_lengths.end());
+  fwd_begins_.resize(batch);
+  size_t max_pages = 1;
+  for (size_t i = 0; i < batch; ++i) {
+    Sequence& seq = GetSequence(seq_ids[i]);
+    fwd_begins_[i] = seq.length;
+    // Copy the last page when it is shared and written to.
+    int64_t used = seq.length % page_size_;
+    if (append_lengths[i] > 0 && used != 0 && ref_counts_[seq.pages.back()] > 1) {
+      int32_t page = AllocPage();
+      CopyPage(seq.pages.back(), page, used);
+      ReleasePage(seq.pages.back());
+      seq.pages.back() = page;
+    }
+    seq.length += append_lengths[i];
+    while (static_cast<int64_t>(seq.pages.size()) * page_size_ < seq.length) {
+      seq.pages.push_back(AllocPage());
+    }
+    max_pages = std::max(max_pages, seq.pages.size());
+  }
+
+  // Upload the page table of the batch, padded with page 0 that the kernels mask out.
+  DLDataType i32 = DataType::Int(32);
+  std::vector<int64_t> table_shape = {static_cast<int64_t>(batch), static_cast<int64_t>(max_pages)};
+  std::vector<int64_t> lens_shape = {static_cast<int64_t>(batch)};
+  NDArray host_table = NDArray::Empty(table_shape, i32, Device{kDLCPU, 0});
+  NDArray host_lens = NDArray::Empty(lens_shape, i32, Device{kDLCPU, 0});
+  int32_t* table_data = static_cast<int32_t*>(host_table->data);
+  int32_t* lens_data = static_cast<int32_t*>(host_lens->data);
+  std::fill(table_data, table_data + batch * max_pages, 0);
+  for (size_t i = 0; i < batch; ++i) {
+    const Sequence& seq = GetSequence(seq_ids[i]);
+    std::copy(seq.pages.begin(), seq.pages.end(), table_data + i * max_pages);
+    lens_data[i] = static_cast<int32_t>(seq.length);
+  }
+  page_table = allocator_->Empty(table_shape, i32, pages->device);
+  seq_lens = allocator_->Empty(lens_shape, i32, pages->device);
+  page_table.CopyFrom(host_table);
+  seq_lens.CopyFrom(host_lens);
+}
+
+void PagedKVCacheObj::Append(int64_t layer, NDArray key, NDArray value) {
+  ICHECK(!fwd_seq_ids_.empty()) << "Append must follow BeginForward";
+  ICHECK(layer >= 0 && layer < num_layers_) << "Layer " << layer << " is out of range";
+  int64_t num_tokens = 0;
+  for (int64_t length : fwd_lengths_) num_tokens += length;
+  for (const NDArray& arr : {key, value}) {
+    ICHECK_EQ(arr->ndim, 3) << "The keys and values must be [num_tokens, num_heads, head_dim]";
+    ICHECK_EQ(arr->shape[0], num_tokens);
+    ICHECK_EQ(arr->shape[1] * arr->shape[2], token_elems_);
+    ICHECK(arr.DataType() == pages.DataType())
+        << "Expected keys and values of type " << pages.DataType() << ", got " << arr.DataType();
+    ICHECK(arr.IsContiguous());
+  }
+
+  Device dev = pages->device;
+  TVMStreamHandle stream =
+      dev.device_type == kDLCPU ? nullptr : DeviceAPI::Get(dev)->GetCurrentStream(dev);
+  size_t elem_bytes = (key->dtype.bits * key->dtype.lanes + 7) / 8;
+  int64_t offset = 0;
+  for (size_t i = 0; i < fwd_seq_ids_.size(); ++i) {
+    const Sequence& seq = GetSequence(fwd_seq_ids_[i]);
+    int64_t pos = fwd_begins_[i];
+    int64_t end = pos + fwd_lengths_[i];
+    // Copy the runs of tokens that fall in the same page.
+    while (pos < end) {
+      int64_t slot = pos % page_size_;
+      int64_t num_slots = std::min(end - pos, page_size_ - slot);
+      int64_t shape = num_slots * token_elems_;
+      for (int kv = 0; kv < 2; ++kv) {
+        DLTensor from = *(kv == 0 ? key : value).operator->();
+        from.byte_offset += offset * token_elems_ * elem_bytes;
+        from.ndim = 1;
+        from.shape = &shape;
+        from.strides = nullptr;
+        DLTensor to = SlotView(layer, kv, seq.pages[pos / page_size_], slot, &shape);
+        NDArray::CopyFromTo(&from, &to, stream);
+      }
+      pos += num_slots;
+      offset += num_slots;
+    }
+  }
+}
+
+PagedKVCache::PagedKVCache(int64_t num_layers, int64_t num_heads, int64_t head_dim,
+                           int64_t page_size, int64_t num_pages, DLDataType dtype, Device dev,
+                           AllocatorType alloc_type) {
+  data_ = make_object<PagedKVCacheObj>(num_layers, num_heads, head_dim, page_size, num_pages,
+                                       dtype, dev, alloc_type);
+}
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCache")
+    .set_body_typed([](int64_t num_layers, int64_t num_heads, int64_t head_dim, int64_t page_size,
+                       int64_t num_pages, DLDataType dtype, Device dev, int alloc_type) {
+      return PagedKVCache(num_layers, num_heads, head_dim, page_size, num_pages, dtype, dev,
+                          static_cast<AllocatorType>(alloc_type));
+    });
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheAddSequence")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::AddSequence);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheRemoveSequence")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::RemoveSequence);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheForkSequence")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::ForkSequence);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheGetSequenceLength")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::GetSequenceLength);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheNumFreePages")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::NumFreePages);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheBeginForward")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::BeginForward);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheAppend")
+    .set_body_method<PagedKVCache>(&PagedKVCacheObj::Append);
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheGetPages").set_body_typed([](PagedKVCache cache) {
+  return cache->pages;
+});
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheGetPageTable").set_body_typed([](PagedKVCache cache) {
+  ICHECK(cache->page_table.defined()) << "No forward pass has begun";
+  return cache->page_table;
+});
+
+TVM_REGISTER_GLOBAL("runtime.PagedKVCacheGetSeqLens").set_body_typed([](PagedKVCache cache) {
+  ICHECK(cache->seq_lens.defined()) << "No forward pass has begun";
+  return cache->seq_lens;
+});
+
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
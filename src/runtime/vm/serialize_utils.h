@@ -40,6 +40,12 @@ namespace vm {
 /*! \brief The magic number for the serialized VM bytecode file  */
 constexpr uint64_t kTVMVMBytecodeMagic = 0xD225DE2F4214151D;
 
+/*!
+ * \brief The magic number starting a code section in the compact format. The code sections
+ *  saved before start with the number of functions instead.
+ */
+constexpr uint64_t kTVMVMCompactCodeMagic = 0xC0DE5EC7104D2B01;
+
 template <typename T>
 static inline uint64_t VectorHash(uint64_t key, const std::vector<T>& values) {
   for (const auto& it : values) {
@@ -48,6 +54,37 @@ static inline uint64_t VectorHash(uint64_t key, const std::vector<T>& values) {
   return key;
 }
 
+/*! \brief Append a signed integer to the compact bytecode, as a zigzag LEB128 varint. */
+inline void WriteVarint(std::string* code, Index value) {
+  uint64_t v = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  while (v >= 0x80) {
+    code->push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  code->push_back(static_cast<char>(v));
+}
+
+/*!
+ * \brief Read a varint of the compact bytecode.
+ * \param code The compact bytecode.
+ * \param pos The position of the varint, advanced past it.
+ * \param value The decoded integer.
+ * \return True if successful. Otherwise, false.
+ */
+inline bool ReadVarint(const std::string& code, size_t* pos, Index* value) {
+  uint64_t v = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*pos >= code.size()) return false;
+    uint8_t byte = static_cast<uint8_t>(code[(*pos)++]);
+    v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      *value = static_cast<Index>((v >> 1) ^ (0 - (v & 1)));
+      return true;
+    }
+  }
+  return false;
+}
+
 // A struct to hold the funciton info in the code section.
 struct VMFunctionSerializer {
   /*! \brief The name of the VMFunction. */
@@ -159,6 +196,40 @@ struct VMInstructionSerializer {
     serialized.insert(serialized.end(), fields.begin(), fields.end());
     strm->Write(serialized);
   }
+
+  /*!
+   * \brief Load an instruction of the compact bytecode, reusing the storage of the fields.
+   * \param code The compact bytecode of a function.
+   * \param pos The position of the instruction, advanced past it.
+   * \return True if successful. Otherwise, false.
+   */
+  bool LoadCompact(const std::string& code, size_t* pos) {
+    if (*pos >= code.size()) return false;
+    opcode = static_cast<uint8_t>(code[(*pos)++]);
+    Index num_fields;
+    // Every field takes at least a byte.
+    if (!ReadVarint(code, pos, &num_fields) || num_fields < 0 ||
+        static_cast<size_t>(num_fields) > code.size() - *pos) {
+      return false;
+    }
+    fields.resize(num_fields);
+    for (Index& field : fields) {
+      if (!ReadVarint(code, pos, &field)) return false;
+    }
+    return true;
+  }
+
+  /*!
+   * \brief Append the instruction to the compact bytecode of a function: the opcode in a byte,
+   *  then the number of fields and the fields as varints.
+   * \param code The compact bytecode of the function.
+   */
+  void SaveCompact(std::string* code) const {
+    ICHECK(opcode >= 0 && opcode < 256) << "Opcode " << opcode << " does not fit in a byte";
+    code->push_back(static_cast<char>(opcode));
+    WriteVarint(code, static_cast<Index>(fields.size()));
+    for (Index field : fields) WriteVarint(code, field);
+  }
 };
 
 }  // namespace vm
@@ -26,18 +26,24 @@
 #include <tvm/runtime/container/adt.h>
 #include <tvm/runtime/data_type.h>
 #include <tvm/runtime/debug.h>
+#include <tvm/runtime/device_api.h>
 #include <tvm/runtime/logging.h>
 #include <tvm/runtime/memory.h>
 #include <tvm/runtime/object.h>
+#include <tvm/runtime/threading_backend.h>
 #include <tvm/runtime/vm/vm.h>
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 #include <vector>
 
+#include "../async_run.h"
 #include "../file_utils.h"
+#include "../library_module.h"
 
 using namespace tvm::runtime;
 
@@ -66,6 +72,59 @@ std::ostream& operator<<(std::ostream& os, const VMFunction& vm_func) {
   return os;
 }
 
+#if defined(__GNUC__) || defined(__clang__)
+#define TVM_VM_THREADED_DISPATCH 1
+#else
+#define TVM_VM_THREADED_DISPATCH 0
+#endif
+
+/*!
+ * \brief Dispatch codes of the superinstructions, numbered after the last Opcode.
+ *
+ * A superinstruction runs a common sequence of instructions with a single dispatch. The
+ * bytecode itself is left untouched: \p ComputeDispatchCodes only rewrites the dispatch
+ * code of the first instruction of each sequence when the executable is loaded.
+ */
+enum SuperOpcode : uint8_t {
+  /*! \brief AllocStorage followed by an AllocTensor in that storage. */
+  kAllocStorageTensor = static_cast<uint8_t>(Opcode::KillRegister) + 1,
+  /*! \brief As above, followed by the InvokePacked writing the tensor. */
+  kAllocStorageTensorInvokePacked,
+  /*! \brief LoadConst followed by InvokePacked. */
+  kLoadConstInvokePacked,
+  kNumDispatchCodes,
+};
+
+/*! \brief Host arrays larger than this are uploaded to other devices chunk by chunk. */
+constexpr size_t kChunkedUploadBytes = 64 << 20;
+
+/*!
+ * \brief Copy the contiguous host array \p src to \p dev in chunks of \p kChunkedUploadBytes.
+ *
+ * For constants aliasing a memory-mapped params file this streams the file to the device,
+ * faulting pages in one chunk at a time instead of handing the driver one huge pageable copy.
+ */
+NDArray UploadInChunks(const NDArray& src, const DLDevice& dev) {
+  NDArray dst = NDArray::Empty(src.Shape(), src.DataType(), dev);
+  size_t nbytes = GetDataSize(*src.operator->());
+  DeviceAPI* api = DeviceAPI::Get(dev);
+  for (size_t offset = 0; offset < nbytes; offset += kChunkedUploadBytes) {
+    int64_t chunk = static_cast<int64_t>(std::min(kChunkedUploadBytes, nbytes - offset));
+    DLTensor from = *src.operator->();
+    DLTensor to = *dst.operator->();
+    for (DLTensor* view : {&from, &to}) {
+      view->ndim = 1;
+      view->dtype = DLDataType{kDLUInt, 8, 1};
+      view->shape = &chunk;
+      view->strides = nullptr;
+      view->byte_offset += offset;
+    }
+    api->CopyDataFromTo(&from, &to, nullptr);
+  }
+  api->StreamSync(dev, nullptr);
+  return dst;
+}
+
 inline ObjectRef CopyTo(ObjectRef src, const DLDevice& dev) {
   if (src->IsInstance<NDArray::ContainerType>()) {
     auto nd_array = Downcast<NDArray>(src);
@@ -79,6 +138,10 @@ inline ObjectRef CopyTo(ObjectRef src, const DLDevice& dev) {
       VLOG(2) << "copying from " << nd_array->device.device_type << "["
               << nd_array->device.device_id << "] to " << dev.device_type << "[" << dev.device_id
               << "]";
+      if (nd_array->device.device_type == kDLCPU && nd_array.IsContiguous() &&
+          GetDataSize(*nd_array.operator->()) > kChunkedUploadBytes) {
+        return UploadInChunks(nd_array, dev);
+      }
       return nd_array.CopyTo(dev);
     }
     return src;
@@ -94,49 +157,46 @@ inline ObjectRef CopyTo(ObjectRef src, const DLDevice& dev) {
   }
 }
 
-std::vector<int64_t> ToShape(NDArray shape_tensor) {
-  std::vector<int64_t> shape;
+ShapeTuple ToShape(NDArray shape_tensor) {
   auto rank = shape_tensor.Shape().size();
   auto dtype = shape_tensor.DataType();
 
   // For 0-rank shapes we need to allocate a single scalar.
   if (rank == 0) {
-    return shape;
+    return ShapeTuple();
   }
 
   // Otherwise we should be rank-1, and we will extract the number of dimensions
   // for the output vector.
   ICHECK_EQ(rank, 1U) << "shape tensor should be a k-length vector, found " << rank;
   int64_t ndim = shape_tensor.Shape().at(0);
-  shape.resize(ndim);
 
   const DLTensor* dl_tensor = shape_tensor.operator->();
   if (dtype.is_int() && dtype.bits() == 32 && dtype.lanes() == 1) {
     int32_t* dims = reinterpret_cast<int32_t*>(dl_tensor->data);
-    shape.assign(dims, dims + ndim);
+    return ShapeTuple(dims, dims + ndim);
   } else if (dtype.is_int() && dtype.bits() == 64 && dtype.lanes() == 1) {
     int64_t* dims = reinterpret_cast<int64_t*>(dl_tensor->data);
-    shape.assign(dims, dims + ndim);
-  } else {
-    LOG(FATAL) << "invalid shape tensor datatype: " << dtype;
+    return ShapeTuple(dims, dims + ndim);
   }
-
-  return shape;
+  LOG(FATAL) << "invalid shape tensor datatype: " << dtype;
+  return ShapeTuple();
 }
 
-void VirtualMachine::OpStartHook(Instruction instr) {}
+void VirtualMachine::OpStartHook(const Instruction& instr) {}
 void VirtualMachine::OpStopHook() {}
 
 PackedFunc VirtualMachine::GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) {
   if (name == "invoke") {
     return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
       ICHECK(exec_) << "The executable is not created yet.";
+      threading::ThreadPoolScope thread_pool_scope(thread_pool_);
 
       std::string func_name = args[0];
       auto git = exec_->global_map.find(func_name);
       ICHECK(git != exec_->global_map.end())
           << "Cannot find function " << func_name << " in the executable";
-      auto func = exec_->functions[git->second];
+      const auto& func = exec_->functions[git->second];
       if (func.params.empty()) {
         *rv = Invoke(func, {});
       } else {
@@ -154,6 +214,35 @@ PackedFunc VirtualMachine::GetFunction(const String& name, const ObjectPtr<Objec
         }
       }
     });
+  } else if (name == "invoke_async") {
+    if (async_queue_ == nullptr) async_queue_ = std::make_shared<AsyncRunQueue>();
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      ICHECK(exec_) << "The executable is not created yet.";
+      std::string func_name = args[1];
+      const auto& vm_func = CheckAndGetVMFunction(func_name);
+      ICHECK_EQ(args.size() - 2, vm_func.params.size())
+          << "The number of provided parameters doesn't match the number of arguments";
+      std::vector<ObjectRef> inputs;
+      for (int i = 2; i < args.size(); ++i) {
+        // A DLTensor is only valid during the call, the invocation happens later.
+        ICHECK_NE(args[i].type_code(), kTVMDLTensorHandle)
+            << "invoke_async takes NDArray arguments rather than DLTensor";
+        inputs.push_back(args[i].operator ObjectRef());
+      }
+      auto run = [sptr_to_self, this, func_name, inputs = std::move(inputs)]() -> ObjectRef {
+        threading::ThreadPoolScope thread_pool_scope(thread_pool_);
+        const auto& vm_func = CheckAndGetVMFunction(func_name);
+        std::vector<ObjectRef> func_args(inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+          func_args[i] = CopyTo(inputs[i], GetDevice(vm_func.param_device_indexes[i]));
+        }
+        return Invoke(vm_func, func_args);
+      };
+      auto it = std::find_if(devices_.begin(), devices_.end(),
+                             [](const Device& dev) { return dev.device_type != kDLCPU; });
+      Device dev = it == devices_.end() ? Device{kDLCPU, 0} : *it;
+      async_queue_->Submit(dev, std::move(run), args[0]);
+    });
   } else if (name == "invoke_stateful") {
     // TODO(tkonolige, jroesch, tqchen): invoke_stateful and get_output are
     // stop-gap measure to allow using vm over a remote connection.
@@ -234,12 +323,97 @@ PackedFunc VirtualMachine::GetFunction(const String& name, const ObjectPtr<Objec
   } else if (name == "set_outputs") {
     return PackedFunc(
         [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { SetOutputs(args[0], args); });
+  } else if (name == "set_thread_pool") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      this->thread_pool_ = args[0].operator std::string();
+    });
   } else if (name == "load_late_bound_consts") {
     return PackedFunc([this](TVMArgs args, TVMRetValue* rv) {
       CHECK_EQ(args.size(), 1);
       std::string path = args[0];
       exec_->LoadLateBoundConstantsFromFile(path);
     });
+  } else if (name == "set_record_kernel_shapes") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      record_kernel_shapes_ = args[0];
+      if (!record_kernel_shapes_) {
+        kernel_shape_counts_.assign(packed_funcs_.size(), {});
+      }
+    });
+  } else if (name == "get_kernel_shapes") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::vector<std::string> prim_names(packed_funcs_.size());
+      for (const auto& it : exec_->primitive_map) {
+        prim_names[it.second] = it.first;
+      }
+      // For each primitive, the observed shape keys and how often each was invoked.
+      Map<String, ObjectRef> ret;
+      for (size_t i = 0; i < kernel_shape_counts_.size(); ++i) {
+        if (kernel_shape_counts_[i].empty()) continue;
+        Array<ShapeTuple> keys;
+        std::vector<int64_t> counts;
+        for (const auto& it : kernel_shape_counts_[i]) {
+          keys.push_back(ShapeTuple(it.first));
+          counts.push_back(it.second);
+        }
+        ret.Set(prim_names[i], Array<ObjectRef>{keys, ShapeTuple(counts)});
+      }
+      *rv = ret;
+    });
+  } else if (name == "set_variant_trials") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      variant_trials_ = args[0];
+      for (VariantDispatch& variants : variant_dispatch_) {
+        variants.trials.clear();
+      }
+    });
+  } else if (name == "get_variant_choices") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      std::vector<std::string> prim_names(packed_funcs_.size());
+      for (const auto& it : exec_->primitive_map) {
+        prim_names[it.second] = it.first;
+      }
+      // For each primitive with variants, the shape buckets and the names of their kernels.
+      Map<String, ObjectRef> ret;
+      for (size_t i = 0; i < variant_dispatch_.size(); ++i) {
+        const VariantDispatch& variants = variant_dispatch_[i];
+        if (variants.choices.empty()) continue;
+        Array<ObjectRef> choices;
+        for (const auto& it : variants.choices) {
+          choices.push_back(
+              Array<ObjectRef>{ShapeTuple(it.first), String(variants.candidates[it.second].first)});
+        }
+        ret.Set(prim_names[i], choices);
+      }
+      *rv = ret;
+    });
+  } else if (name == "set_shape_func_cache_size") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      int64_t size = args[0];
+      ICHECK_GE(size, 0) << "The shape function cache size must be non-negative";
+      shape_func_cache_size_ = size;
+      shape_func_caches_.assign(packed_funcs_.size(), {});
+      shape_func_cache_hits_ = 0;
+    });
+  } else if (name == "get_shape_func_cache_hits") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = shape_func_cache_hits_; });
+  } else if (name == "set_sampling_interval") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) {
+      packed_names_.assign(packed_funcs_.size(), String());
+      for (const auto& it : exec_->primitive_map) {
+        packed_names_[it.second] = it.first;
+      }
+      sampler_.SetInterval(args[0].operator int64_t());
+    });
+  } else if (name == "get_sampled_profile") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { *rv = sampler_.Report(); });
+  } else if (name == "preload_constants") {
+    return PackedFunc(
+        [sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->PreloadConstants(); });
+  } else if (name == "warmup") {
+    return PackedFunc([sptr_to_self, this](TVMArgs args, TVMRetValue* rv) { this->Warmup(); });
   } else {
     LOG(FATAL) << "Unknown packed function: " << name;
   }
@@ -395,7 +569,8 @@ inline Allocator* VirtualMachine::GetAllocator(Index device_index) const {
 
 void VirtualMachine::PushFrame(Index arg_count, Index ret_pc, const VMFunction& vm_func) {
   auto frame = VMFrame(ret_pc, func_index_, arg_count, code_, vm_func.register_file_size);
-  frames_.push_back(frame);
+  frame.dispatch_code = dispatch_code_;
+  frames_.push_back(std::move(frame));
 }
 
 Index VirtualMachine::PopFrame() {
@@ -403,12 +578,25 @@ Index VirtualMachine::PopFrame() {
   const VMFrame& fr = frames_.back();
   func_index_ = fr.func_index;
   code_ = fr.code;
+  dispatch_code_ = fr.dispatch_code;
   pc_ = fr.pc;
   auto call_stack_size = frames_.size();
   frames_.pop_back();
   return call_stack_size;
 }
 
+const uint8_t* VirtualMachine::GetDispatchCode(const VMFunction& func) const {
+  const std::vector<VMFunction>& functions = exec_->functions;
+  std::less<const VMFunction*> less;
+  if (!less(&func, functions.data()) && less(&func, functions.data() + functions.size())) {
+    return dispatch_codes_[&func - functions.data()].data();
+  }
+  // A copy of one of the executable's functions, look it up by name instead.
+  auto it = exec_->global_map.find(func.name);
+  ICHECK(it != exec_->global_map.end()) << "Cannot find function " << func.name;
+  return dispatch_codes_[it->second].data();
+}
+
 void VirtualMachine::InvokeGlobal(const VMFunction& func, const std::vector<ObjectRef>& args) {
   VLOG(2) << "Invoking global " << func.name << " with " << args.size() << " args";
 
@@ -420,6 +608,7 @@ void VirtualMachine::InvokeGlobal(const VMFunction& func, const std::vector<Obje
   }
 
   code_ = func.instructions.data();
+  dispatch_code_ = GetDispatchCode(func);
   pc_ = 0;
 }
 
@@ -457,9 +646,21 @@ void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, In
     }
   }
 
-  std::vector<TVMValue> values(arity);
-  std::vector<int> codes(arity);
-  runtime::TVMArgsSetter setter(values.data(), codes.data());
+  // Pack the arguments of most kernels on the stack.
+  constexpr size_t kInlineArity = 16;
+  TVMValue inline_values[kInlineArity];
+  int inline_codes[kInlineArity];
+  std::vector<TVMValue> heap_values;
+  std::vector<int> heap_codes;
+  TVMValue* values = inline_values;
+  int* codes = inline_codes;
+  if (arity > kInlineArity) {
+    heap_values.resize(arity);
+    heap_codes.resize(arity);
+    values = heap_values.data();
+    codes = heap_codes.data();
+  }
+  runtime::TVMArgsSetter setter(values, codes);
   int idx = 0;
   bool is_empty_output = false;
   for (Index i = 0; i < arg_count; i++) {
@@ -485,10 +686,156 @@ void VirtualMachine::InvokePacked(Index packed_index, const PackedFunc& func, In
     }
   }
 
-  if (!is_empty_output) {
+  if (is_empty_output) return;
+  if (static_cast<size_t>(packed_index) < packed_cfuncs_.size() &&
+      packed_cfuncs_[packed_index] != nullptr && &func == &packed_funcs_[packed_index]) {
+    // Call the kernel of the library directly, skipping the PackedFunc dispatch.
+    TVMValue ret_value;
+    int ret_type_code = kTVMNullptr;
+    int ret = (*packed_cfuncs_[packed_index])(values, codes, static_cast<int>(arity), &ret_value,
+                                              &ret_type_code, nullptr);
+    ICHECK_EQ(ret, 0) << TVMGetLastError();
+  } else {
     TVMRetValue rv;
-    func.CallPacked(TVMArgs(values.data(), codes.data(), arity), &rv);
+    func.CallPacked(TVMArgs(values, codes, arity), &rv);
+  }
+}
+
+void VirtualMachine::InvokeShapeFunc(const Instruction& instr, const PackedFunc& func,
+                                     const std::vector<ObjectRef>& args) {
+  Index num_inputs = instr.arity - instr.output_size;
+  // The inputs are shape tensors on the host, keyed by their rank, dimensions and contents.
+  std::vector<int64_t> key;
+  for (Index i = 0; i < instr.arity; ++i) {
+    const auto* tensor = args[i].as<NDArray::ContainerType>();
+    if (tensor == nullptr) {
+      InvokePacked(instr.packed_index, func, instr.arity, instr.output_size, args);
+      return;
+    }
+    if (i >= num_inputs) continue;
+    const DLTensor& t = tensor->dl_tensor;
+    if (t.device.device_type != kDLCPU || t.dtype.code != kDLInt || t.dtype.lanes != 1 ||
+        (t.dtype.bits != 32 && t.dtype.bits != 64)) {
+      InvokePacked(instr.packed_index, func, instr.arity, instr.output_size, args);
+      return;
+    }
+    key.push_back(t.ndim);
+    key.insert(key.end(), t.shape, t.shape + t.ndim);
+    const void* data = static_cast<const char*>(t.data) + t.byte_offset;
+    size_t size = GetDataSize(t) / (t.dtype.bits / 8);
+    for (size_t j = 0; j < size; ++j) {
+      key.push_back(t.dtype.bits == 64 ? static_cast<const int64_t*>(data)[j]
+                                       : static_cast<const int32_t*>(data)[j]);
+    }
+  }
+
+  ShapeFuncCache& cache = shape_func_caches_[instr.packed_index];
+  auto it = cache.index.find(key);
+  if (it != cache.index.end()) {
+    cache.entries.splice(cache.entries.begin(), cache.entries, it->second);
+    const std::vector<NDArray>& outputs = it->second->second;
+    for (Index i = 0; i < instr.output_size; ++i) {
+      Downcast<NDArray>(args[num_inputs + i]).CopyFrom(outputs[i]);
+    }
+    ++shape_func_cache_hits_;
+    return;
   }
+
+  InvokePacked(instr.packed_index, func, instr.arity, instr.output_size, args);
+  std::vector<NDArray> outputs;
+  for (Index i = 0; i < instr.output_size; ++i) {
+    NDArray output = Downcast<NDArray>(args[num_inputs + i]);
+    outputs.push_back(output.CopyTo(output->device));
+  }
+  if (cache.entries.size() >= shape_func_cache_size_) {
+    cache.index.erase(cache.entries.back().first);
+    cache.entries.pop_back();
+  }
+  cache.entries.emplace_front(std::move(key), std::move(outputs));
+  cache.index.emplace(cache.entries.front().first, cache.entries.begin());
+}
+
+int VirtualMachine::SelectVariant(const VariantDispatch& variants, const PackedFunc** func) {
+  bucket_key_ = ShapeBucketKey(shape_key_);
+  auto it = variants.choices.find(bucket_key_);
+  if (it != variants.choices.end()) {
+    *func = &variants.candidates[it->second].second;
+    return -1;
+  }
+  if (variant_trials_ <= 0) return -1;
+  auto trials = variants.trials.find(bucket_key_);
+  int count = trials == variants.trials.end() ? 0 : trials->second.count;
+  return count % static_cast<int>(variants.candidates.size());
+}
+
+void VirtualMachine::InvokeVariantTrial(const Instruction& instr, VariantDispatch* variants,
+                                        int candidate, const std::vector<ObjectRef>& args) {
+  // The packed function runs on the device of its first output.
+  ObjectRef out = args.back();
+  if (const auto* adt = out.as<ADTObj>()) out = (*adt)[0];
+  Device dev = Downcast<NDArray>(out)->device;
+  DeviceAPI* api = DeviceAPI::Get(dev);
+  TVMStreamHandle stream = api->GetCurrentStream(dev);
+  api->StreamSync(dev, stream);
+  auto start = std::chrono::steady_clock::now();
+  InvokePacked(instr.packed_index, variants->candidates[candidate].second, instr.arity,
+               instr.output_size, args);
+  api->StreamSync(dev, stream);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  size_t num_candidates = variants->candidates.size();
+  VariantDispatch::Trials& trials = variants->trials[bucket_key_];
+  // The fastest run discards the one-time costs, such as loading the kernel.
+  trials.best.resize(num_candidates, std::numeric_limits<double>::infinity());
+  trials.best[candidate] = std::min(trials.best[candidate], seconds);
+  if (++trials.count >= variant_trials_ * static_cast<int>(num_candidates)) {
+    size_t best = std::min_element(trials.best.begin(), trials.best.end()) - trials.best.begin();
+    variants->choices[bucket_key_] = best;
+    variants->trials.erase(bucket_key_);
+  }
+}
+
+static std::vector<uint8_t> ComputeDispatchCodes(const VMFunction& func) {
+  const std::vector<Instruction>& code = func.instructions;
+  std::vector<uint8_t> dispatch_codes(code.size());
+  // Instructions reached by a jump rather than by falling through can't be folded into the
+  // superinstruction of the instruction before them.
+  std::vector<bool> is_jump_target(code.size(), false);
+  auto mark_jump_target = [&](size_t pc, Index offset) {
+    size_t target = pc + offset;
+    if (target < code.size()) {
+      is_jump_target[target] = true;
+    }
+  };
+  for (size_t pc = 0; pc < code.size(); ++pc) {
+    dispatch_codes[pc] = static_cast<uint8_t>(code[pc].op);
+    if (code[pc].op == Opcode::Goto) {
+      mark_jump_target(pc, code[pc].pc_offset);
+    } else if (code[pc].op == Opcode::If) {
+      mark_jump_target(pc, code[pc].if_op.true_offset);
+      mark_jump_target(pc, code[pc].if_op.false_offset);
+    }
+  }
+  auto can_fuse = [&](size_t pc, Opcode op) {
+    return pc < code.size() && code[pc].op == op && !is_jump_target[pc];
+  };
+  for (size_t pc = 0; pc < code.size(); ++pc) {
+    const Instruction& instr = code[pc];
+    if (instr.op == Opcode::AllocStorage && can_fuse(pc + 1, Opcode::AllocTensor) &&
+        code[pc + 1].alloc_tensor.storage == instr.dst) {
+      if (can_fuse(pc + 2, Opcode::InvokePacked)) {
+        dispatch_codes[pc] = kAllocStorageTensorInvokePacked;
+        pc += 2;
+      } else {
+        dispatch_codes[pc] = kAllocStorageTensor;
+        pc += 1;
+      }
+    } else if (instr.op == Opcode::LoadConst && can_fuse(pc + 1, Opcode::InvokePacked)) {
+      dispatch_codes[pc] = kLoadConstInvokePacked;
+      pc += 1;
+    }
+  }
+  return dispatch_codes;
 }
 
 void VirtualMachine::LoadExecutable(const ObjectPtr<Executable>& exec) {
@@ -513,9 +860,63 @@ void VirtualMachine::LoadExecutable(const ObjectPtr<Executable>& exec) {
     ICHECK(pf != nullptr) << "Cannot find function in module: " << packed_name;
     packed_funcs_[packed_index] = pf;
   }
+  packed_cfuncs_.assign(packed_funcs_.size(), nullptr);
+  for (const auto& it : exec_->primitive_map) {
+    packed_cfuncs_[it.second] = GetBackendPackedCFunc(lib, it.first);
+  }
   for (size_t i = 0; i < packed_funcs_.size(); ++i) {
     ICHECK(packed_funcs_[i] != nullptr) << "Packed function " << i << " is not initialized";
   }
+
+  specialized_funcs_.assign(packed_funcs_.size(), {});
+  kernel_shape_counts_.assign(packed_funcs_.size(), {});
+  is_pure_shape_func_.assign(packed_funcs_.size(), false);
+  for (const auto& it : exec_->op_attrs) {
+    if (static_cast<size_t>(it.first) < packed_funcs_.size() &&
+        it.second.count(kPureShapeFuncAttr)) {
+      is_pure_shape_func_[it.first] = true;
+    }
+  }
+  shape_func_caches_.assign(packed_funcs_.size(), {});
+
+  variant_dispatch_.assign(packed_funcs_.size(), {});
+  for (const auto& it : exec_->kernel_variants) {
+    auto prim = exec_->primitive_map.find(it.first);
+    ICHECK(prim != exec_->primitive_map.end()) << "Unknown primitive " << it.first;
+    VariantDispatch& variants = variant_dispatch_[prim->second];
+    variants.candidates.emplace_back(it.first, packed_funcs_[prim->second]);
+    for (const std::string& func_name : it.second.func_names) {
+      PackedFunc pf = lib.GetFunction(func_name, /*query_imports=*/true);
+      ICHECK(pf != nullptr) << "Cannot find kernel variant in module: " << func_name;
+      variants.candidates.emplace_back(func_name, pf);
+    }
+    for (const auto& choice : it.second.choices) {
+      size_t index = 0;
+      while (index < variants.candidates.size() &&
+             variants.candidates[index].first != choice.second) {
+        ++index;
+      }
+      ICHECK_LT(index, variants.candidates.size())
+          << choice.second << " is not a variant of " << it.first;
+      variants.choices[choice.first] = index;
+    }
+  }
+  for (const auto& it : exec_->shape_specializations) {
+    auto prim = exec_->primitive_map.find(it.first);
+    ICHECK(prim != exec_->primitive_map.end()) << "Unknown primitive " << it.first;
+    for (const ShapeSpecialization& spec : it.second) {
+      PackedFunc pf = lib.GetFunction(spec.func_name, /*query_imports=*/true);
+      ICHECK(pf != nullptr) << "Cannot find shape-specialized function in module: "
+                            << spec.func_name;
+      specialized_funcs_[prim->second].emplace_back(spec.shape_key, pf);
+    }
+  }
+
+  dispatch_codes_.clear();
+  dispatch_codes_.reserve(exec_->functions.size());
+  for (const VMFunction& func : exec_->functions) {
+    dispatch_codes_.push_back(ComputeDispatchCodes(func));
+  }
 }
 
 void VirtualMachine::Init(const std::vector<Device>& physical_devices,
@@ -546,11 +947,50 @@ void VirtualMachine::Init(const std::vector<Device>& physical_devices,
   }
 }
 
+void VirtualMachine::LoadConstant(Index const_index) {
+  if (const_pool_.size() <= static_cast<size_t>(const_index)) {
+    const_pool_.resize(const_index + 1);
+  }
+  // The device-resident copy is owned by the executable so that every VM running it on the
+  // same device shares one copy of the weights.
+  Device dev = GetDevice(exec_->const_device_indexes[const_index]);
+  const ObjectRef& constant_obj = exec_->constants[const_index];
+  const_pool_[const_index] =
+      exec_->GetDeviceConstant(const_index, dev, [&]() -> ObjectRef {
+        // Constants bound lazily are read from their file straight onto the device.
+        if (!constant_obj.defined()) return exec_->LoadLazyConstant(const_index, dev);
+        return CopyTo(constant_obj, dev);
+      });
+}
+
+void VirtualMachine::PreloadConstants() {
+  ICHECK(!devices_.empty()) << "The VM must be initialized before preloading constants";
+  for (size_t const_index = 0; const_index < exec_->constants.size(); ++const_index) {
+    if (const_pool_.size() <= const_index || !const_pool_[const_index].defined()) {
+      LoadConstant(static_cast<Index>(const_index));
+    }
+  }
+}
+
+void VirtualMachine::Warmup() {
+  PreloadConstants();
+  Module lib = exec_->GetLib();
+  for (const Device& dev : devices_) {
+    PreloadModule(lib, dev);
+  }
+}
+
 inline void VirtualMachine::WriteRegister(Index r, const ObjectRef& val) {
   frames_.back().register_file[r] = val;
 }
 
-ObjectRef VirtualMachine::ReadRegister(Index r) const { return frames_.back().register_file[r]; }
+inline void VirtualMachine::WriteRegister(Index r, ObjectRef&& val) {
+  frames_.back().register_file[r] = std::move(val);
+}
+
+const ObjectRef& VirtualMachine::ReadRegister(Index r) const {
+  return frames_.back().register_file[r];
+}
 
 int64_t VirtualMachine::LoadScalarInt(Index r) const {
   int64_t result = 0;
@@ -622,102 +1062,212 @@ std::vector<Index> VirtualMachine::GetOutputTensorRegIndices() {
   return reg_indices;
 }
 
+inline void VirtualMachine::ExecuteLoadConst(const Instruction& instr) {
+  bool is_not_cached = const_pool_.size() <= static_cast<size_t>(instr.const_index) ||
+                       !const_pool_[instr.const_index].defined();
+  // We cache the allocated object in the constant pool. To measure, the
+  // first iteration will set the pool up. The other iterations will
+  // directly reuse the allocated objects.
+  if (is_not_cached) {
+    OpStartHook(instr);
+    LoadConstant(instr.const_index);
+  }
+  WriteRegister(instr.dst, const_pool_[instr.const_index]);
+  if (is_not_cached) {
+    OpStopHook();
+  }
+}
+
+void VirtualMachine::MakeShapeKey(const std::vector<ObjectRef>& args,
+                                  std::vector<int64_t>* key) {
+  key->clear();
+  auto append = [key](const ObjectRef& arg) {
+    const auto* array = arg.as<NDArray::ContainerType>();
+    ICHECK(array) << "Primitive arguments must be tensors or tuples of tensors";
+    key->push_back(array->dl_tensor.ndim);
+    key->insert(key->end(), array->dl_tensor.shape, array->dl_tensor.shape + array->dl_tensor.ndim);
+  };
+  for (const ObjectRef& arg : args) {
+    if (const auto* adt = arg.as<ADTObj>()) {
+      for (size_t i = 0; i < adt->size; ++i) {
+        append((*adt)[i]);
+      }
+    } else {
+      append(arg);
+    }
+  }
+}
+
+inline void VirtualMachine::ExecuteInvokePacked(const Instruction& instr) {
+  ICHECK_LE(instr.packed_index, packed_funcs_.size());
+  const PackedFunc* func = &packed_funcs_[instr.packed_index];
+  const auto& arity = instr.arity;
+  std::vector<ObjectRef> args;
+  args.reserve(arity);
+  for (Index i = 0; i < arity; ++i) {
+    args.push_back(ReadRegister(instr.packed_args[i]));
+#if TVM_LOG_DEBUG
+    if (i < arity) {
+      const bool is_input = i < arity - instr.output_size;
+      VLOG(2) << (is_input ? "input" : "placeholder") << " arg " << i << " = "
+              << RuntimeObject2String(args.back(), GetDevice(exec_->host_device_index),
+                                      /*show_contents=*/is_input);
+    }
+#endif
+  }
+
+  const auto& specialized_funcs = specialized_funcs_[instr.packed_index];
+  VariantDispatch& variants = variant_dispatch_[instr.packed_index];
+  if (record_kernel_shapes_ || !specialized_funcs.empty() || !variants.candidates.empty()) {
+    MakeShapeKey(args, &shape_key_);
+    if (record_kernel_shapes_) {
+      ++kernel_shape_counts_[instr.packed_index][shape_key_];
+    }
+    for (const auto& it : specialized_funcs) {
+      if (it.first == shape_key_) {
+        func = &it.second;
+        break;
+      }
+    }
+  }
+  // An exact shape specialization takes precedence over the variants.
+  int timed_variant = -1;
+  if (!variants.candidates.empty() && func == &packed_funcs_[instr.packed_index]) {
+    timed_variant = SelectVariant(variants, &func);
+  }
+
+  if (sampled_) {
+    // The packed function runs on the device of its first output.
+    ObjectRef out = args.back();
+    if (const auto* adt = out.as<ADTObj>()) out = (*adt)[0];
+    sampler_.StartOp(instr.packed_index, packed_names_[instr.packed_index],
+                     Downcast<NDArray>(out)->device);
+  }
+  // We no longer need to write the registers back, we write directly
+  // through the registers mutably.
+  if (timed_variant >= 0) {
+    InvokeVariantTrial(instr, &variants, timed_variant, args);
+  } else if (shape_func_cache_size_ > 0 && is_pure_shape_func_[instr.packed_index]) {
+    InvokeShapeFunc(instr, *func, args);
+  } else {
+    InvokePacked(instr.packed_index, *func, arity, instr.output_size, args);
+  }
+  if (sampled_) sampler_.StopOp();
+
+#if TVM_LOG_DEBUG
+  for (Index i = arity - instr.output_size; i < arity; ++i) {
+    auto arg = ReadRegister(instr.packed_args[i]);
+    VLOG(2) << "output arg " << i << " = "
+            << RuntimeObject2String(arg, GetDevice(exec_->host_device_index));
+  }
+#endif
+}
+
+inline void VirtualMachine::ExecuteAllocTensor(
+    const Instruction& instr, const std::vector<Index>& output_tensor_reg_indices) {
+  OpStartHook(instr);
+  if (!output_tensor_reg_indices.empty() && FindIndex(output_tensor_reg_indices, instr.dst)) {
+    WriteAllocatedTensorFromOutside(instr);
+  } else {
+    WriteAllocatedTensor(instr);
+  }
+  OpStopHook();
+}
+
+inline void VirtualMachine::ExecuteAllocStorage(const Instruction& instr) {
+  OpStartHook(instr);
+  auto size = LoadScalarInt(instr.alloc_storage.allocation_size);
+  auto alignment = instr.alloc_storage.alignment;
+
+  auto storage_obj = make_object<StorageObj>();
+  Allocator* allocator = GetAllocator(instr.alloc_storage.device_index);
+  ICHECK(allocator) << "Did you forget to init the VirtualMachine with devices?";
+  VLOG(2) << "allocating with allocation_size=" << size << ", alignment=" << alignment
+          << ", dtype_hint=" << DLDataType2String(instr.alloc_storage.dtype_hint)
+          << ", device_index=" << instr.alloc_storage.device_index;
+
+  storage_obj->buffer = allocator->Alloc(size, alignment, instr.alloc_storage.dtype_hint);
+  WriteRegister(instr.dst, Storage(storage_obj));
+  OpStopHook();
+}
+
 void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices) {
   ICHECK(this->exec_);
   ICHECK(this->code_);
+  ICHECK(this->dispatch_code_);
   pc_ = 0;
   Index frame_start = frames_.size();
+  sampled_ = sampler_.BeginRequest();
+
+#if TVM_VM_THREADED_DISPATCH
+  // Direct-threaded dispatch: each handler jumps straight to the handler of the next
+  // instruction so that every handler gets its own, better predicted, indirect branch.
+  // The table is indexed by dispatch code and therefore follows the order of Opcode.
+  static const void* const kDispatchTable[kNumDispatchCodes] = {
+      &&op_Move, &&op_Ret, &&op_Invoke, &&op_InvokeClosure, &&op_InvokePacked,
+      &&op_AllocTensor, &&op_AllocTensorReg, &&op_AllocADT, &&op_AllocClosure, &&op_GetField,
+      &&op_If, &&op_LoadConst, &&op_Goto, &&op_GetTag, &&op_LoadConsti, &&op_Fatal,
+      &&op_AllocStorage, &&op_ShapeOf, &&op_ReshapeTensor, &&op_DeviceCopy, &&op_KillRegister,
+      // Superinstructions.
+      &&op_AllocStorageTensor, &&op_AllocStorageTensorInvokePacked, &&op_LoadConstInvokePacked};
+#define VM_DISPATCH()                                      \
+  do {                                                     \
+    VLOG(2) << "Executing(" << pc_ << "): " << code_[pc_]; \
+    goto* kDispatchTable[dispatch_code_[pc_]];             \
+  } while (0)
+#define VM_OPCODE(name) case static_cast<uint8_t>(Opcode::name) : op_##name
+#define VM_SUPEROPCODE(name) case k##name : op_##name
+#else
+#define VM_DISPATCH() goto main_loop
+#define VM_OPCODE(name) case static_cast<uint8_t>(Opcode::name)
+#define VM_SUPEROPCODE(name) case k##name
+#endif
+
   while (true) {
+#if !TVM_VM_THREADED_DISPATCH
   main_loop:
-    auto const& instr = code_[this->pc_];
-    VLOG(2) << "Executing(" << pc_ << "): " << instr;
-
-    switch (instr.op) {
-      case Opcode::Move: {
-        ObjectRef from_obj;
-        from_obj = ReadRegister(instr.from);
-        WriteRegister(instr.dst, from_obj);
+#endif
+    VLOG(2) << "Executing(" << pc_ << "): " << code_[pc_];
+
+    switch (dispatch_code_[pc_]) {
+      VM_OPCODE(Move) : {
+        const Instruction& instr = code_[pc_];
+        WriteRegister(instr.dst, ReadRegister(instr.from));
         pc_++;
-        goto main_loop;
-      }
-      case Opcode::Fatal: {
-        throw std::runtime_error("VM encountered fatal error");
+        VM_DISPATCH();
       }
-      case Opcode::LoadConst: {
-        bool is_not_cached = const_pool_.size() <= static_cast<size_t>(instr.const_index) ||
-                             !const_pool_[instr.const_index].defined();
-        if (is_not_cached) {
-          OpStartHook(instr);
-        }
-        auto constant_obj = exec_->constants[instr.const_index];
-        // We cache the allocated object in the constant pool. To measure, the
-        // first iteration will set the pool up. The other iterations will
-        // directly reuse the allocated objects.
-        if (const_pool_.size() <= static_cast<size_t>(instr.const_index)) {
-          const_pool_.resize(instr.const_index + 1);
-        }
-
-        if (!const_pool_[instr.const_index].defined()) {
-          Device dev = GetDevice(exec_->const_device_indexes[instr.const_index]);
-          const_pool_[instr.const_index] = CopyTo(constant_obj, dev);
-        }
-        WriteRegister(instr.dst, const_pool_[instr.const_index]);
-        if (is_not_cached) {
-          OpStopHook();
-        }
+      VM_OPCODE(Fatal) : { throw std::runtime_error("VM encountered fatal error"); }
+      VM_OPCODE(LoadConst) : {
+        ExecuteLoadConst(code_[pc_]);
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::LoadConsti: {
+      VM_OPCODE(LoadConsti) : {
+        const Instruction& instr = code_[pc_];
         auto tensor = NDArray::Empty({1}, {kDLInt, 64, 1}, GetDevice(exec_->host_device_index));
         reinterpret_cast<int64_t*>(tensor->data)[0] = instr.load_consti.val;
-        WriteRegister(instr.dst, tensor);
+        WriteRegister(instr.dst, std::move(tensor));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Invoke: {
+      VM_OPCODE(Invoke) : {
+        const Instruction& instr = code_[pc_];
         std::vector<ObjectRef> args;
+        args.reserve(instr.num_args);
         for (Index i = 0; i < instr.num_args; ++i) {
           args.push_back(ReadRegister(instr.invoke_args_registers[i]));
         }
         InvokeGlobal(exec_->functions[instr.func_index], args);
         frames_.back().caller_return_register = instr.dst;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::InvokePacked: {
-        ICHECK_LE(instr.packed_index, packed_funcs_.size());
-        const auto& func = packed_funcs_[instr.packed_index];
-        const auto& arity = instr.arity;
-        std::vector<ObjectRef> args;
-        for (Index i = 0; i < arity; ++i) {
-          auto arg = ReadRegister(instr.packed_args[i]);
-          args.push_back(arg);
-#if TVM_LOG_DEBUG
-          if (i < arity) {
-            const bool is_input = i < arity - instr.output_size;
-            VLOG(2) << (is_input ? "input" : "placeholder") << " arg " << i << " = "
-                    << RuntimeObject2String(arg, GetDevice(exec_->host_device_index),
-                                            /*show_contents=*/is_input);
-          }
-#endif
-        }
-
-        // We no longer need to write the registers back, we write directly
-        // through the registers mutably.
-        InvokePacked(instr.packed_index, func, arity, instr.output_size, args);
-
-#if TVM_LOG_DEBUG
-        for (Index i = arity - instr.output_size; i < arity; ++i) {
-          auto arg = ReadRegister(instr.packed_args[i]);
-          VLOG(2) << "output arg " << i << " = "
-                  << RuntimeObject2String(arg, GetDevice(exec_->host_device_index));
-        }
-#endif
-
+      VM_OPCODE(InvokePacked) : {
+        ExecuteInvokePacked(code_[pc_]);
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::InvokeClosure: {
+      VM_OPCODE(InvokeClosure) : {
+        const Instruction& instr = code_[pc_];
         auto object = ReadRegister(instr.closure);
         const auto* closure = object.as<VMClosureObj>();
         ICHECK(closure);
@@ -730,31 +1280,34 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         }
         InvokeGlobal(exec_->functions[closure->func_index], args);
         frames_.back().caller_return_register = instr.dst;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::GetField: {
+      VM_OPCODE(GetField) : {
+        const Instruction& instr = code_[pc_];
         auto object = ReadRegister(instr.object);
         const auto& tuple = Downcast<ADT>(object);
         auto field = tuple[instr.field_index];
-        WriteRegister(instr.dst, field);
+        WriteRegister(instr.dst, std::move(field));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::GetTag: {
+      VM_OPCODE(GetTag) : {
+        const Instruction& instr = code_[pc_];
         auto object = ReadRegister(instr.get_tag.object);
         const auto& adt = Downcast<ADT>(object);
         auto tag = adt.tag();
         auto tag_tensor = NDArray::Empty({1}, {kDLInt, 32, 1}, GetDevice(exec_->host_device_index));
         reinterpret_cast<int32_t*>(tag_tensor->data)[0] = tag;
-        WriteRegister(instr.dst, tag_tensor);
+        WriteRegister(instr.dst, std::move(tag_tensor));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Goto: {
-        pc_ += instr.pc_offset;
-        goto main_loop;
+      VM_OPCODE(Goto) : {
+        pc_ += code_[pc_].pc_offset;
+        VM_DISPATCH();
       }
-      case Opcode::If: {
+      VM_OPCODE(If) : {
+        const Instruction& instr = code_[pc_];
         int32_t test_val = LoadScalarInt(instr.if_op.test);
         int32_t target_val = LoadScalarInt(instr.if_op.target);
 
@@ -766,20 +1319,15 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
           pc_ += instr.if_op.false_offset;
         }
 
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocTensor: {
-        OpStartHook(instr);
-        if (!output_tensor_reg_indices.empty() && FindIndex(output_tensor_reg_indices, instr.dst)) {
-          WriteAllocatedTensorFromOutside(instr);
-        } else {
-          WriteAllocatedTensor(instr);
-        }
-        OpStopHook();
+      VM_OPCODE(AllocTensor) : {
+        ExecuteAllocTensor(code_[pc_], output_tensor_reg_indices);
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocTensorReg: {
+      VM_OPCODE(AllocTensorReg) : {
+        const Instruction& instr = code_[pc_];
         OpStartHook(instr);
         Device cpu_dev = GetDevice(exec_->host_device_index);
         auto shape_obj = ReadRegister(instr.alloc_tensor_reg.shape_register);
@@ -793,50 +1341,39 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
                 << RuntimeObject2String(obj, GetDevice(exec_->host_device_index),
                                         /*show_contents=*/false);
 
-        WriteRegister(instr.dst, obj);
+        WriteRegister(instr.dst, std::move(obj));
         OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocADT: {
+      VM_OPCODE(AllocADT) : {
+        const Instruction& instr = code_[pc_];
         std::vector<ObjectRef> fields;
         for (Index i = 0; i < instr.num_fields; ++i) {
           fields.push_back(ReadRegister(instr.datatype_fields[i]));
         }
         ObjectRef obj = ADT(instr.constructor_tag, fields);
-        WriteRegister(instr.dst, obj);
+        WriteRegister(instr.dst, std::move(obj));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocClosure: {
+      VM_OPCODE(AllocClosure) : {
+        const Instruction& instr = code_[pc_];
         std::vector<ObjectRef> free_vars;
         for (Index i = 0; i < instr.num_freevar; i++) {
           free_vars.push_back(ReadRegister(instr.free_vars[i]));
         }
         WriteRegister(instr.dst, VMClosure(instr.func_index, free_vars));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::AllocStorage: {
-        OpStartHook(instr);
-        auto size = LoadScalarInt(instr.alloc_storage.allocation_size);
-        auto alignment = instr.alloc_storage.alignment;
-
-        auto storage_obj = SimpleObjAllocator().make_object<StorageObj>();
-        Allocator* allocator = GetAllocator(instr.alloc_storage.device_index);
-        ICHECK(allocator) << "Did you forget to init the VirtualMachine with devices?";
-        VLOG(2) << "allocating with allocation_size=" << size << ", alignment=" << alignment
-                << ", dtype_hint=" << DLDataType2String(instr.alloc_storage.dtype_hint)
-                << ", device_index=" << instr.alloc_storage.device_index;
-
-        storage_obj->buffer = allocator->Alloc(size, alignment, instr.alloc_storage.dtype_hint);
-        Storage storage(storage_obj);
-        WriteRegister(instr.dst, storage);
-        OpStopHook();
+      VM_OPCODE(AllocStorage) : {
+        ExecuteAllocStorage(code_[pc_]);
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::ShapeOf: {
+      VM_OPCODE(ShapeOf) : {
+        const Instruction& instr = code_[pc_];
         auto input = ReadRegister(instr.shape_of.tensor);
         NDArray input_array = Downcast<NDArray>(input);
         int ndim = input_array->ndim;
@@ -847,11 +1384,12 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         }
         VLOG(2) << "shape = "
                 << RuntimeObject2String(out_tensor, GetDevice(exec_->host_device_index));
-        WriteRegister(instr.dst, out_tensor);
+        WriteRegister(instr.dst, std::move(out_tensor));
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::Ret: {
+      VM_OPCODE(Ret) : {
+        const Instruction& instr = code_[pc_];
         // If we have hit the point from which we started
         // running, we should return to the caller breaking
         // the dispatch loop.
@@ -863,10 +1401,11 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
           // Otherwise we are just returning from a local call.
         } else {
           WriteRegister(caller_return_register, return_register_);
-          goto main_loop;
+          VM_DISPATCH();
         }
       }
-      case Opcode::ReshapeTensor: {
+      VM_OPCODE(ReshapeTensor) : {
+        const Instruction& instr = code_[pc_];
         OpStartHook(instr);
         Device cpu_dev = GetDevice(exec_->host_device_index);
         auto tensor_obj = ReadRegister(instr.reshape_tensor.tensor);
@@ -879,18 +1418,18 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         ICHECK_EQ(dl_tensor->dtype.bits, 64u);
         int64_t* dims = reinterpret_cast<int64_t*>(dl_tensor->data);
         int64_t ndim = shape_tensor->shape[0];
-        std::vector<int64_t> shape(dims, dims + ndim);
         // Reshape the input tensor
-        auto out_tensor = tensor_arr.CreateView(shape, tensor_arr->dtype);
+        auto out_tensor = tensor_arr.CreateView(ShapeTuple(dims, dims + ndim), tensor_arr->dtype);
         VLOG(2) << "reshaped "
                 << RuntimeObject2String(tensor_obj, GetDevice(exec_->host_device_index)) << " to "
                 << RuntimeObject2String(out_tensor, GetDevice(exec_->host_device_index));
-        WriteRegister(instr.dst, out_tensor);
+        WriteRegister(instr.dst, std::move(out_tensor));
         OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::DeviceCopy: {
+      VM_OPCODE(DeviceCopy) : {
+        const Instruction& instr = code_[pc_];
         OpStartHook(instr);
         auto tensor_src = ReadRegister(instr.device_copy.src);
         NDArray src_data = Downcast<NDArray>(tensor_src);
@@ -901,30 +1440,51 @@ void VirtualMachine::RunLoop(const std::vector<Index>& output_tensor_reg_indices
         Device dst_dev = GetDevice(instr.device_copy.dst_device_index);
 
         NDArray dst_data = src_data.CopyTo(dst_dev);
-        WriteRegister(instr.dst, dst_data);
+        WriteRegister(instr.dst, std::move(dst_data));
         OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
       }
-      case Opcode::KillRegister: {
+      VM_OPCODE(KillRegister) : {
+        const Instruction& instr = code_[pc_];
         OpStartHook(instr);
         WriteRegister(instr.dst, ObjectRef());
         OpStopHook();
         pc_++;
-        goto main_loop;
+        VM_DISPATCH();
+      }
+      // Superinstructions, see ComputeDispatchCodes. The fused instructions are executed
+      // exactly as they would be one by one, only the dispatches between them are saved.
+      VM_SUPEROPCODE(AllocStorageTensor) : {
+        ExecuteAllocStorage(code_[pc_]);
+        ExecuteAllocTensor(code_[pc_ + 1], output_tensor_reg_indices);
+        pc_ += 2;
+        VM_DISPATCH();
+      }
+      VM_SUPEROPCODE(AllocStorageTensorInvokePacked) : {
+        ExecuteAllocStorage(code_[pc_]);
+        ExecuteAllocTensor(code_[pc_ + 1], output_tensor_reg_indices);
+        ExecuteInvokePacked(code_[pc_ + 2]);
+        pc_ += 3;
+        VM_DISPATCH();
+      }
+      VM_SUPEROPCODE(LoadConstInvokePacked) : {
+        ExecuteLoadConst(code_[pc_]);
+        ExecuteInvokePacked(code_[pc_ + 1]);
+        pc_ += 2;
+        VM_DISPATCH();
       }
       default:
-        LOG(FATAL) << "Unknown instruction opcode: " << int(instr.op);
+        LOG(FATAL) << "Unknown instruction opcode: " << int(code_[pc_].op);
     }
   }
+#undef VM_DISPATCH
+#undef VM_OPCODE
+#undef VM_SUPEROPCODE
 }
 
 void VirtualMachine::WriteAllocatedTensor(const Instruction& instr) {
-  auto shape = std::vector<int64_t>(instr.alloc_tensor.ndim);
-
-  for (uint32_t i = 0; i < instr.alloc_tensor.ndim; ++i) {
-    shape[i] = instr.alloc_tensor.shape[i];
-  }
+  ShapeTuple shape(instr.alloc_tensor.shape, instr.alloc_tensor.shape + instr.alloc_tensor.ndim);
 
   auto storage_obj = ReadRegister(instr.alloc_tensor.storage);
   auto offset = LoadScalarInt(instr.alloc_tensor.offset);
@@ -974,8 +1534,7 @@ void VirtualMachine::WriteAllocatedTensorFromOutside(const Instruction& instr) {
         << "Element number mismatching of internal and external output tensors";
     if (code_[preresult_op_index_].op == Opcode::ReshapeTensor) {
       int64_t* dims = instr.alloc_tensor.shape;
-      std::vector<int64_t> ref_shape(dims, dims + int64_t(in_size));
-      auto reshaped_tensor = ex_arr.CreateView(ref_shape, ex_dtype);
+      auto reshaped_tensor = ex_arr.CreateView(ShapeTuple(dims, dims + in_size), ex_dtype);
       WriteRegister(instr.dst, reshaped_tensor);
     } else {
       LOG(FATAL) << "Internal and external output tensor shapes are mismatched";
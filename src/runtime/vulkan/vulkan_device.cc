@@ -20,7 +20,14 @@
 #include "vulkan_device.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <mutex>
+#include <sstream>
 #include <unordered_map>
 #include <utility>
 
@@ -70,6 +77,10 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES};
   VkPhysicalDeviceShaderFloat16Int8Features float16_int8 = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES};
+#ifdef VK_KHR_cooperative_matrix
+  VkPhysicalDeviceCooperativeMatrixFeaturesKHR cooperative_matrix_khr = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_KHR};
+#endif
 
   // Set up linked list for feature query
   {
@@ -86,6 +97,12 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
       *pp_next = &float16_int8;
       pp_next = &float16_int8.pNext;
     }
+#ifdef VK_KHR_cooperative_matrix
+    if (device.HasExtension("VK_KHR_cooperative_matrix")) {
+      *pp_next = &cooperative_matrix_khr;
+      pp_next = &cooperative_matrix_khr.pNext;
+    }
+#endif
   }
 
   if (instance.HasExtension("VK_KHR_get_physical_device_properties2")) {
@@ -136,6 +153,10 @@ VulkanDeviceProperties::VulkanDeviceProperties(const VulkanInstance& instance,
 
   supports_cooperative_matrix = device.HasExtension("VK_NV_cooperative_matrix");
 
+#ifdef VK_KHR_cooperative_matrix
+  supports_cooperative_matrix_khr = cooperative_matrix_khr.cooperativeMatrix;
+#endif
+
   // The check of VK_SHADER_STAGE_COMPUTE_BIT isn't technically
   // needed, since it will be set so long at least one queue has
   // VK_QUEUE_COMPUTE_BIT.  Including it to avoid potential future
@@ -338,6 +359,8 @@ VulkanDevice::VulkanDevice(const VulkanInstance& instance, VkPhysicalDevice phy_
     queue_insert_debug_utils_label_functions =
         std::make_unique<VulkanQueueInsertDebugUtilsLabelFunctions>(instance);
   }
+
+  CreatePipelineCache();
 }
 
 VulkanDevice::~VulkanDevice() {
@@ -349,6 +372,11 @@ VulkanDevice::~VulkanDevice() {
   staging_buffer_per_thread.Clear();
   uniform_buffer_per_thread.Clear();
 
+  if (pipeline_cache_ != VK_NULL_HANDLE) {
+    SavePipelineCache();
+    vkDestroyPipelineCache(device_, pipeline_cache_, nullptr);
+  }
+
   if (device_) {
     vkDestroyDevice(device_, nullptr);
   }
@@ -384,6 +412,83 @@ void VulkanDevice::do_swap(VulkanDevice&& other) {
   std::swap(physical_device_, other.physical_device_);
   std::swap(enabled_extensions, other.enabled_extensions);
   std::swap(device_, other.device_);
+  std::swap(pipeline_cache_, other.pipeline_cache_);
+  std::swap(pipeline_cache_path_, other.pipeline_cache_path_);
+}
+
+void VulkanDevice::CreatePipelineCache() {
+  VkPhysicalDeviceProperties properties;
+  vkGetPhysicalDeviceProperties(physical_device_, &properties);
+
+  std::string initial_data;
+  if (const char* dir = std::getenv("TVM_VULKAN_PIPELINE_CACHE_DIR")) {
+    std::ostringstream os;
+    os << dir << "/";
+    for (uint8_t byte : properties.pipelineCacheUUID) {
+      os << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+    }
+    os << ".vkpipelinecache";
+    pipeline_cache_path_ = os.str();
+
+    std::ifstream fs(pipeline_cache_path_, std::ios::in | std::ios::binary);
+    if (fs) {
+      std::ostringstream data;
+      data << fs.rdbuf();
+      initial_data = data.str();
+    }
+    // Some drivers do not validate the initial data, so only pass on
+    // a cache written by this device and driver.
+    VkPipelineCacheHeaderVersionOne header;
+    if (initial_data.size() < sizeof(header)) {
+      initial_data.clear();
+    } else {
+      std::memcpy(&header, initial_data.data(), sizeof(header));
+      if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+          header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+          std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        initial_data.clear();
+      }
+    }
+  }
+
+  VkPipelineCacheCreateInfo cache_cinfo;
+  cache_cinfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  cache_cinfo.pNext = nullptr;
+  cache_cinfo.flags = 0;
+  cache_cinfo.initialDataSize = initial_data.size();
+  cache_cinfo.pInitialData = initial_data.data();
+  VULKAN_CALL(vkCreatePipelineCache(device_, &cache_cinfo, nullptr, &pipeline_cache_));
+}
+
+void VulkanDevice::SavePipelineCache() const {
+  if (pipeline_cache_path_.empty() || pipeline_cache_ == VK_NULL_HANDLE) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(pipeline_cache_mutex_);
+  size_t size = 0;
+  VULKAN_CALL(vkGetPipelineCacheData(device_, pipeline_cache_, &size, nullptr));
+  std::string data(size, '\0');
+  VULKAN_CALL(vkGetPipelineCacheData(device_, pipeline_cache_, &size, &data[0]));
+  data.resize(size);
+
+  // Write to a temporary file and rename it into place, so that
+  // processes sharing the directory never read a partial cache.
+  std::string tmp_path =
+      pipeline_cache_path_ + ".tmp" +
+      std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  {
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+    fs.write(data.data(), data.size());
+    if (!fs) {
+      LOG(WARNING) << "Cannot write the Vulkan pipeline cache " << tmp_path;
+      fs.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), pipeline_cache_path_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+  }
 }
 
 bool VulkanDevice::SupportsCompute() const { return queue_family_index != uint32_t(-1); }
@@ -438,7 +543,8 @@ std::vector<const char*> VulkanDevice::SelectEnabledExtensions() const {
                                                "VK_KHR_dedicated_allocation",
                                                "VK_KHR_spirv_1_4",
                                                "VK_KHR_shader_integer_dot_product",
-                                               "VK_NV_cooperative_matrix"};
+                                               "VK_NV_cooperative_matrix",
+                                               "VK_KHR_cooperative_matrix"};
 
   uint32_t device_extension_prop_count;
   VULKAN_CALL(vkEnumerateDeviceExtensionProperties(physical_device_, nullptr,
@@ -464,6 +570,10 @@ void VulkanDevice::CreateVkDevice(const VulkanInstance& instance) {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_16BIT_STORAGE_FEATURES};
   VkPhysicalDeviceShaderFloat16Int8Features float16_int8 = {
       VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES};
+#ifdef VK_KHR_cooperative_matrix
+  VkPhysicalDeviceCooperativeMatrixFeaturesKHR cooperative_matrix_khr = {
+      VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_COOPERATIVE_MATRIX_FEATURES_KHR};
+#endif
 
   void** pp_next = &enabled_features.pNext;
   bool needs_float16_int8 = false;
@@ -500,6 +610,13 @@ void VulkanDevice::CreateVkDevice(const VulkanInstance& instance) {
     *pp_next = &float16_int8;
     pp_next = &float16_int8.pNext;
   }
+#ifdef VK_KHR_cooperative_matrix
+  if (device_properties.supports_cooperative_matrix_khr) {
+    cooperative_matrix_khr.cooperativeMatrix = true;
+    *pp_next = &cooperative_matrix_khr;
+    pp_next = &cooperative_matrix_khr.pNext;
+  }
+#endif
 
   float priority = 1.0f;
 
@@ -89,6 +89,7 @@ struct VulkanDeviceProperties {
   bool supports_dedicated_allocation{false};
   bool supports_integer_dot_product{false};
   bool supports_cooperative_matrix{false};
+  bool supports_cooperative_matrix_khr{false};
   uint32_t supported_subgroup_operations{0};
   uint32_t max_num_threads{1};
   uint32_t thread_warp_size{1};
@@ -233,6 +234,21 @@ class VulkanDevice {
 
   VkQueue Queue() const { return queue; }
 
+  /*! \brief The pipeline cache used to create the compute pipelines of this device
+   *
+   * If the TVM_VULKAN_PIPELINE_CACHE_DIR environment variable is set,
+   * the cache is loaded from a file in that directory, named after the
+   * pipelineCacheUUID of the device.
+   */
+  VkPipelineCache PipelineCache() const { return pipeline_cache_; }
+
+  /*! \brief Write the pipeline cache back to its file
+   *
+   * Does nothing if TVM_VULKAN_PIPELINE_CACHE_DIR is not set.  Safe
+   * to call from multiple CPU threads.
+   */
+  void SavePipelineCache() const;
+
  private:
   /*! \brief Helper function for move assignment/construction
    *
@@ -261,6 +277,13 @@ class VulkanDevice {
    */
   void CreateVkDevice(const VulkanInstance& instance);
 
+  /*! \brief Initialize the VkPipelineCache
+   *
+   * Called during VulkanDevice construction, after device_ has been
+   * created.
+   */
+  void CreatePipelineCache();
+
   //! \brief Handle to the Vulkan API physical device
   VkPhysicalDevice physical_device_{nullptr};
 
@@ -299,6 +322,15 @@ class VulkanDevice {
 
   //! \brief The VulkanUniformBuffer for each CPU thread.
   ThreadMap<VulkanUniformBuffer> uniform_buffer_per_thread;
+
+  //! \brief Handle to the Vulkan API pipeline cache
+  VkPipelineCache pipeline_cache_{VK_NULL_HANDLE};
+
+  //! \brief The file of the pipeline cache, empty if it is not persisted
+  std::string pipeline_cache_path_;
+
+  //! \brief Mutex to protect writes of the pipeline cache file
+  mutable std::mutex pipeline_cache_mutex_;
 };
 
 uint32_t FindMemoryType(const VulkanDevice& device, VkBufferCreateInfo info,
@@ -245,6 +245,10 @@ void VulkanDeviceAPI::GetTargetProperty(Device dev, const std::string& property,
     *rv = prop.supports_cooperative_matrix;
   }
 
+  if (property == "supports_cooperative_matrix_khr") {
+    *rv = prop.supports_cooperative_matrix_khr;
+  }
+
   if (property == "device_name") {
     *rv = prop.device_name;
   }
@@ -19,6 +19,8 @@
 
 #include "vulkan_stream.h"
 
+#include <algorithm>
+
 #include "../../support/utils.h"
 #include "vulkan_device.h"
 
@@ -99,9 +101,9 @@ void VulkanStream::LaunchDeferred(const std::function<void()>& deferred_initiali
 
   // If the new kernel uses the same buffers in the same descriptor
   // set as an already-queued kernel, we don't need to initialize it
-  // again.  Since every VulkanWrappedFunc owns a single descriptor
-  // set, unless the same function is called with the same buffer
-  // arguments, deferred_initializer() will always be called.
+  // again.  The VulkanWrappedFunc selects its descriptor set with
+  // CanBindDescriptorSet, so a queued descriptor set is only reused
+  // when it is bound to the same buffer arguments.
   if (!std::any_of(deferred_tokens_[deferred_token.descriptor_set_].begin(),
                    deferred_tokens_[deferred_token.descriptor_set_].end(),
                    [&](const VulkanStreamToken& token) {
@@ -117,6 +119,16 @@ void VulkanStream::LaunchDeferred(const std::function<void()>& deferred_initiali
   deferred_tokens_[deferred_token.descriptor_set_].push_back(deferred_token);
 }
 
+bool VulkanStream::CanBindDescriptorSet(VkDescriptorSet descriptor_set,
+                                        const std::vector<VkBuffer>& buffers) const {
+  auto it = deferred_tokens_.find(descriptor_set);
+  if (it == deferred_tokens_.end()) {
+    return true;
+  }
+  return std::all_of(it->second.begin(), it->second.end(),
+                     [&](const VulkanStreamToken& token) { return token.buffers_ == buffers; });
+}
+
 void VulkanStream::Synchronize() {
   if (!device_->UseImmediate()) {
     for (const auto& deferred_kernel : deferred_kernels_) {
@@ -100,6 +100,18 @@ class VulkanStream {
                       const std::function<void(VulkanStreamState*)>& deferred_kernel,
                       const VulkanStreamToken& deferred_token);
 
+  /*! \brief Whether a deferred kernel can use the descriptor set without a synchronization
+   *
+   * True if no queued kernel uses the descriptor set, or if all
+   * queued kernels that use it are bound to the same buffers.
+   *
+   * \param descriptor_set The descriptor set to be used.
+   *
+   * \param buffers The buffers to be bound to the descriptor set.
+   */
+  bool CanBindDescriptorSet(VkDescriptorSet descriptor_set,
+                            const std::vector<VkBuffer>& buffers) const;
+
   // reset profiler state
   void ProfilerReset() {
     if (profiler_) {
@@ -30,6 +30,42 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
+namespace {
+
+/*! \brief Select a descriptor set of the pipeline for a deferred launch
+ *
+ * Prefers a descriptor set that the stream can bind to the buffers
+ * without a synchronization, and allocates a new one from the pool
+ * if all of them are queued with other buffers.  If the pool is
+ * exhausted, the first descriptor set is returned, and the stream
+ * synchronizes before the launch.
+ */
+VkDescriptorSet SelectDescriptorSet(const VulkanDevice& device, VulkanPipeline* pipeline,
+                                    const VulkanStream& stream,
+                                    const std::vector<VkBuffer>& buffers) {
+  std::lock_guard<std::mutex> lock(pipeline->descriptor_sets_mutex);
+  for (VkDescriptorSet descriptor_set : pipeline->descriptor_sets) {
+    if (stream.CanBindDescriptorSet(descriptor_set, buffers)) {
+      return descriptor_set;
+    }
+  }
+  if (pipeline->descriptor_sets.size() >= kMaxDescriptorSetsPerPipeline) {
+    return pipeline->descriptor_sets[0];
+  }
+  VkDescriptorSetAllocateInfo alloc_info;
+  alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  alloc_info.pNext = nullptr;
+  alloc_info.descriptorPool = pipeline->descriptor_pool;
+  alloc_info.descriptorSetCount = 1;
+  alloc_info.pSetLayouts = &(pipeline->descriptor_set_layout);
+  VkDescriptorSet descriptor_set;
+  VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &descriptor_set));
+  pipeline->descriptor_sets.push_back(descriptor_set);
+  return descriptor_set;
+}
+
+}  // namespace
+
 void VulkanWrappedFunc::Init(VulkanModuleNode* m, ObjectPtr<Object> sptr,
                              const std::string& func_name, size_t num_buffer_args,
                              size_t num_pack_args,
@@ -112,14 +148,24 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
   }
 
   // Otherwise, the more expensive deferred path.
+  VulkanStreamToken deferred_token;
+  deferred_token.buffers_.resize(descriptor_buffers.size());
+  for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
+    deferred_token.buffers_[i] = descriptor_buffers[i].buffer;
+  }
+  VulkanStream& stream = device.ThreadLocalStream();
+  VkDescriptorSet descriptor_set =
+      SelectDescriptorSet(device, pipeline.get(), stream, deferred_token.buffers_);
+  deferred_token.descriptor_set_ = descriptor_set;
+
   std::vector<ArgUnion64> pack_args_storage(pack_args, pack_args + num_pack_args_);
-  const auto& deferred_initializer = [&device, pipeline, descriptor_buffers]() {
+  const auto& deferred_initializer = [&device, descriptor_set, descriptor_buffers]() {
     std::vector<VkWriteDescriptorSet> write_descriptor_sets;
     write_descriptor_sets.resize(descriptor_buffers.size());
     for (size_t i = 0; i < write_descriptor_sets.size(); i++) {
       write_descriptor_sets[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
       write_descriptor_sets[i].pNext = nullptr;
-      write_descriptor_sets[i].dstSet = pipeline->descriptor_set;
+      write_descriptor_sets[i].dstSet = descriptor_set;
       write_descriptor_sets[i].dstBinding = i;
       write_descriptor_sets[i].dstArrayElement = 0;
       write_descriptor_sets[i].descriptorCount = 1;
@@ -137,14 +183,13 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
     vkUpdateDescriptorSets(device, write_descriptor_sets.size(), write_descriptor_sets.data(), 0,
                            nullptr);
   };
-  const auto& deferred_kernel = [this, pipeline, wl, pack_args_storage, nbytes_scalars,
-                                 device_id](VulkanStreamState* state) {
+  const auto& deferred_kernel = [this, pipeline, descriptor_set, wl, pack_args_storage,
+                                 nbytes_scalars, device_id](VulkanStreamState* state) {
     auto& device = VulkanDeviceAPI::Global()->device(device_id);
 
     vkCmdBindPipeline(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
     vkCmdBindDescriptorSets(state->cmd_buffer_, VK_PIPELINE_BIND_POINT_COMPUTE,
-                            pipeline->pipeline_layout, 0, 1, &(pipeline->descriptor_set), 0,
-                            nullptr);
+                            pipeline->pipeline_layout, 0, 1, &descriptor_set, 0, nullptr);
 
     if (pipeline->use_ubo) {
       auto& ubo = device.ThreadLocalUniformBuffer(nbytes_scalars);
@@ -166,13 +211,7 @@ void VulkanWrappedFunc::operator()(TVMArgs args, TVMRetValue* rv,
                          VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
                          1, &barrier_info, 0, nullptr, 0, nullptr);
   };
-  VulkanStreamToken deferred_token;
-  deferred_token.descriptor_set_ = pipeline->descriptor_set;
-  deferred_token.buffers_.resize(descriptor_buffers.size());
-  for (size_t i = 0; i < descriptor_buffers.size(); ++i) {
-    deferred_token.buffers_[i] = descriptor_buffers[i].buffer;
-  }
-  device.ThreadLocalStream().LaunchDeferred(deferred_initializer, deferred_kernel, deferred_token);
+  stream.LaunchDeferred(deferred_initializer, deferred_kernel, deferred_token);
 
   if (device.UseDebugUtilsLabel()) {
     VkDebugUtilsLabelEXT dispatch_label = {VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
@@ -202,6 +241,9 @@ VulkanModuleNode::~VulkanModuleNode() {
       vkDestroyDescriptorSetLayout(device, pe->descriptor_set_layout, nullptr);
       vkDestroyShaderModule(device, pe->shader, nullptr);
     }
+    if (!ecache_[device_id].empty()) {
+      VulkanDeviceAPI::Global()->device(device_id).SavePipelineCache();
+    }
   }
 }
 
@@ -209,6 +251,7 @@ PackedFunc VulkanModuleNode::GetFunction(const String& name,
                                          const ObjectPtr<Object>& sptr_to_self) {
   ICHECK_EQ(sptr_to_self.get(), this);
   ICHECK_NE(name, symbol::tvm_module_main) << "Device function do not have main";
+  if (name == "get_func_names") return GetFuncNamesFunc(fmap_, sptr_to_self);
   auto it = fmap_.find(name);
   if (it == fmap_.end()) return PackedFunc();
   const FunctionInfo& info = it->second;
@@ -324,7 +367,10 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
     descrip_pool_cinfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     descrip_pool_cinfo.pNext = nullptr;
     descrip_pool_cinfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-    descrip_pool_cinfo.maxSets = 1;
+    descrip_pool_cinfo.maxSets = kMaxDescriptorSetsPerPipeline;
+    for (VkDescriptorPoolSize& pool_size : descriptor_set_pool_sizes) {
+      pool_size.descriptorCount *= kMaxDescriptorSetsPerPipeline;
+    }
     descrip_pool_cinfo.poolSizeCount = descriptor_set_pool_sizes.size();
     descrip_pool_cinfo.pPoolSizes = descriptor_set_pool_sizes.data();
     VULKAN_CALL(
@@ -336,7 +382,8 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
     alloc_info.descriptorPool = pe->descriptor_pool;
     alloc_info.descriptorSetCount = 1;
     alloc_info.pSetLayouts = &(pe->descriptor_set_layout);
-    VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, &(pe->descriptor_set)));
+    pe->descriptor_sets.resize(1);
+    VULKAN_CALL(vkAllocateDescriptorSets(device, &alloc_info, pe->descriptor_sets.data()));
   }
 
   VkPushConstantRange crange;
@@ -382,8 +429,8 @@ std::shared_ptr<VulkanPipeline> VulkanModuleNode::GetPipeline(size_t device_id,
   pipeline_cinfo.layout = pe->pipeline_layout;
   pipeline_cinfo.basePipelineHandle = VK_NULL_HANDLE;
   pipeline_cinfo.basePipelineIndex = 0;
-  VULKAN_CALL(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipeline_cinfo, nullptr,
-                                       &(pe->pipeline)));
+  VULKAN_CALL(vkCreateComputePipelines(device, device.PipelineCache(), 1, &pipeline_cinfo,
+                                       nullptr, &(pe->pipeline)));
 
   if (device.UseImmediate()) {
     VkDescriptorUpdateTemplateCreateInfoKHR descrip_template_cinfo;
@@ -39,12 +39,25 @@ namespace tvm {
 namespace runtime {
 namespace vulkan {
 
+/*! \brief The maximum number of descriptor sets allocated for a pipeline
+ *
+ * Each deferred launch of a pipeline with different buffers needs its
+ * own descriptor set, as the descriptor sets are only updated before
+ * the command buffer is submitted.  Up to this many launches can be
+ * queued in a VulkanStream before the stream must be synchronized.
+ */
+constexpr uint32_t kMaxDescriptorSetsPerPipeline = 16;
+
 struct VulkanPipeline {
   VulkanDevice* device{nullptr};
   VkShaderModule shader{VK_NULL_HANDLE};
   VkDescriptorSetLayout descriptor_set_layout{VK_NULL_HANDLE};
   VkDescriptorPool descriptor_pool{VK_NULL_HANDLE};
-  VkDescriptorSet descriptor_set{VK_NULL_HANDLE};
+  // The descriptor sets allocated from descriptor_pool, which are
+  // reused across the launches of the pipeline.
+  std::vector<VkDescriptorSet> descriptor_sets;
+  // Guards accesses to `descriptor_sets`
+  std::mutex descriptor_sets_mutex;
   VkPipelineLayout pipeline_layout{VK_NULL_HANDLE};
   VkPipeline pipeline{VK_NULL_HANDLE};
   VkDescriptorUpdateTemplateKHR descriptor_update_template{VK_NULL_HANDLE};
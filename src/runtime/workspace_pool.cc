@@ -24,113 +24,195 @@
 #include "workspace_pool.h"
 
 #include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 namespace tvm {
 namespace runtime {
 
 // page size.
 constexpr size_t kWorkspacePageSize = 4 << 10;
+// number of small size classes, one per page count.
+constexpr size_t kNumSmallClasses = 16;
+// requests up to this size are served from the exact-size small classes.
+constexpr size_t kMaxSmallBytes = kNumSmallClasses * kWorkspacePageSize;
 
+/*!
+ * \brief Segregated-fit pool of one device.
+ *
+ *  Small requests are rounded to pages and served in constant time from per-size-class
+ *  free lists. Large requests are served best-fit from the free large blocks. When the
+ *  pointers of the device are addressable, a large block is split if the remainder is
+ *  big enough and adjacent free blocks of the same device allocation are coalesced.
+ */
 class WorkspacePool::Pool {
  public:
-  // constructor
-  Pool() {
-    // safe guard header on each list.
-    Entry e;
-    e.data = nullptr;
-    e.size = 0;
-    free_list_.push_back(e);
-    allocated_.push_back(e);
-  }
+  explicit Pool(bool allow_split) : allow_split_(allow_split) {}
   // allocate from pool
   void* Alloc(Device dev, DeviceAPI* device, size_t nbytes) {
     // Allocate align to page.
+    size_t requested = nbytes;
     nbytes = (nbytes + (kWorkspacePageSize - 1)) / kWorkspacePageSize * kWorkspacePageSize;
     if (nbytes == 0) nbytes = kWorkspacePageSize;
     Entry e;
-    DLDataType type;
-    type.code = kDLUInt;
-    type.bits = 8;
-    type.lanes = 1;
-    if (free_list_.size() == 2) {
-      e = free_list_.back();
-      free_list_.pop_back();
-      if (e.size < nbytes) {
-        // resize the page
-        device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-        e.size = nbytes;
-      }
-    } else if (free_list_.size() == 1) {
-      e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-      e.size = nbytes;
-    } else {
-      if (free_list_.back().size >= nbytes) {
-        // find smallest fit
-        auto it = free_list_.end() - 2;
-        for (; it->size >= nbytes; --it) {
-        }
-        e = *(it + 1);
-        free_list_.erase(it + 1);
+    e.size = nbytes;
+    e.requested = requested;
+    if (nbytes <= kMaxSmallBytes) {
+      std::vector<void*>& free_list = small_free_[nbytes / kWorkspacePageSize - 1];
+      if (!free_list.empty()) {
+        e.data = free_list.back();
+        free_list.pop_back();
       } else {
-        // resize the page
-        e = free_list_.back();
-        free_list_.pop_back();
-        device->FreeDataSpace(dev, e.data);
-        e.data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
-        e.size = nbytes;
+        e.data = AllocDataSpace(dev, device, nbytes);
       }
+    } else {
+      e.block = AllocLarge(dev, device, nbytes);
+      e.data = e.block->data;
+      e.size = e.block->size;
     }
-    allocated_.push_back(e);
+    allocated_[e.data] = e;
+    stats_.current_bytes += e.size;
+    stats_.wasted_bytes += e.size - e.requested;
+    stats_.peak_bytes = std::max(stats_.peak_bytes, stats_.current_bytes);
     return e.data;
   }
   // free resource back to pool
   void Free(void* data) {
-    Entry e;
-    if (allocated_.back().data == data) {
-      // quick path, last allocated.
-      e = allocated_.back();
-      allocated_.pop_back();
-    } else {
-      int index = static_cast<int>(allocated_.size()) - 2;
-      for (; index > 0 && allocated_[index].data != data; --index) {
-      }
-      ICHECK_GT(index, 0) << "trying to free things that has not been allocated";
-      e = allocated_[index];
-      allocated_.erase(allocated_.begin() + index);
-    }
-    if (free_list_.back().size < e.size) {
-      free_list_.push_back(e);
-    } else if (free_list_.size() == 2) {
-      free_list_.push_back(free_list_.back());
-      free_list_[1] = e;
+    auto it = allocated_.find(data);
+    ICHECK(it != allocated_.end()) << "trying to free things that has not been allocated";
+    Entry e = it->second;
+    allocated_.erase(it);
+    stats_.current_bytes -= e.size;
+    stats_.wasted_bytes -= e.size - e.requested;
+    if (e.block == nullptr) {
+      small_free_[e.size / kWorkspacePageSize - 1].push_back(e.data);
     } else {
-      size_t i = free_list_.size() - 1;
-      free_list_.resize(free_list_.size() + 1);
-      for (; e.size < free_list_[i].size; --i) {
-        free_list_[i + 1] = free_list_[i];
-      }
-      free_list_[i + 1] = e;
+      FreeLarge(e.block);
     }
   }
   // Release all resources
   void Release(Device dev, DeviceAPI* device) {
-    for (size_t i = 1; i < free_list_.size(); ++i) {
-      device->FreeDataSpace(dev, free_list_[i].data);
+    for (std::vector<void*>& free_list : small_free_) {
+      for (void* data : free_list) {
+        device->FreeDataSpace(dev, data);
+      }
+      free_list.clear();
+    }
+    for (const auto& kv : large_free_) {
+      Block* block = kv.second;
+      // blocks which are still in use keep the rest of their device allocation alive
+      if (block->prev == nullptr && block->next == nullptr) {
+        device->FreeDataSpace(dev, block->data);
+        delete block;
+      }
     }
-    free_list_.clear();
+    large_free_.clear();
+    stats_.reserved_bytes = stats_.current_bytes;
   }
 
+  const Stats& GetStats() const { return stats_; }
+
  private:
-  /*! \brief a single entry in the pool */
-  struct Entry {
-    void* data;
+  /*!
+   * \brief A large block, part of one device allocation. The blocks of one device
+   *  allocation form a list in address order.
+   */
+  struct Block {
+    char* data;
     size_t size;
+    bool free{false};
+    Block* prev{nullptr};
+    Block* next{nullptr};
   };
-  /*! \brief List of free items, sorted from small to big size */
-  std::vector<Entry> free_list_;
-  /*! \brief List of allocated items */
-  std::vector<Entry> allocated_;
+  /*! \brief a single allocated entry of the pool */
+  struct Entry {
+    void* data{nullptr};
+    size_t size{0};
+    size_t requested{0};
+    /*! \brief The large block of the entry, nullptr for small entries. */
+    Block* block{nullptr};
+  };
+
+  void* AllocDataSpace(Device dev, DeviceAPI* device, size_t nbytes) {
+    DLDataType type;
+    type.code = kDLUInt;
+    type.bits = 8;
+    type.lanes = 1;
+    void* data = device->AllocDataSpace(dev, nbytes, kTempAllocaAlignment, type);
+    stats_.reserved_bytes += nbytes;
+    return data;
+  }
+
+  Block* AllocLarge(Device dev, DeviceAPI* device, size_t nbytes) {
+    auto it = large_free_.lower_bound(std::make_pair(nbytes, static_cast<Block*>(nullptr)));
+    if (it == large_free_.end()) {
+      // Like a resize of the largest page: do not keep an unused device allocation which is
+      // too small for the growing request alive next to the new one.
+      if (!large_free_.empty()) {
+        Block* largest = large_free_.rbegin()->second;
+        if (largest->prev == nullptr && largest->next == nullptr) {
+          large_free_.erase(std::prev(large_free_.end()));
+          device->FreeDataSpace(dev, largest->data);
+          stats_.reserved_bytes -= largest->size;
+          delete largest;
+        }
+      }
+      Block* block = new Block();
+      block->data = static_cast<char*>(AllocDataSpace(dev, device, nbytes));
+      block->size = nbytes;
+      return block;
+    }
+    Block* block = it->second;
+    large_free_.erase(it);
+    block->free = false;
+    if (allow_split_ && block->size - nbytes > kMaxSmallBytes) {
+      Block* rest = new Block();
+      rest->data = block->data + nbytes;
+      rest->size = block->size - nbytes;
+      rest->free = true;
+      rest->prev = block;
+      rest->next = block->next;
+      if (block->next != nullptr) block->next->prev = rest;
+      block->next = rest;
+      block->size = nbytes;
+      large_free_.emplace(rest->size, rest);
+    }
+    return block;
+  }
+
+  void FreeLarge(Block* block) {
+    block->free = true;
+    if (block->next != nullptr && block->next->free) {
+      Block* next = block->next;
+      large_free_.erase(std::make_pair(next->size, next));
+      block->size += next->size;
+      block->next = next->next;
+      if (next->next != nullptr) next->next->prev = block;
+      delete next;
+    }
+    if (block->prev != nullptr && block->prev->free) {
+      Block* prev = block->prev;
+      large_free_.erase(std::make_pair(prev->size, prev));
+      prev->size += block->size;
+      prev->next = block->next;
+      if (block->next != nullptr) block->next->prev = prev;
+      delete block;
+      block = prev;
+    }
+    large_free_.emplace(block->size, block);
+  }
+
+  /*! \brief Whether large blocks can be split, i.e. device pointers are addressable. */
+  bool allow_split_;
+  /*! \brief Free small entries, one list per page count */
+  std::vector<void*> small_free_[kNumSmallClasses];
+  /*! \brief Free large blocks ordered by size */
+  std::set<std::pair<size_t, Block*>> large_free_;
+  /*! \brief The allocated entries */
+  std::unordered_map<void*, Entry> allocated_;
+  /*! \brief The memory statistics */
+  Stats stats_;
 };
 
 WorkspacePool::WorkspacePool(DLDeviceType device_type, DeviceAPI* device)
@@ -153,7 +235,11 @@ void* WorkspacePool::AllocWorkspace(Device dev, size_t size) {
     array_.resize(dev.device_id + 1, nullptr);
   }
   if (array_[dev.device_id] == nullptr) {
-    array_[dev.device_id] = new Pool();
+    // Only devices with plain pointers can hand out parts of one allocation.
+    bool allow_split = device_type_ == kDLCPU || device_type_ == kDLCUDA ||
+                       device_type_ == kDLCUDAHost || device_type_ == kDLCUDAManaged ||
+                       device_type_ == kDLROCM || device_type_ == kDLROCMHost;
+    array_[dev.device_id] = new Pool(allow_split);
   }
   return array_[dev.device_id]->Alloc(dev, device_, size);
 }
@@ -163,5 +249,21 @@ void WorkspacePool::FreeWorkspace(Device dev, void* ptr) {
   array_[dev.device_id]->Free(ptr);
 }
 
+WorkspacePool::Stats WorkspacePool::GetStats(Device dev) const {
+  if (static_cast<size_t>(dev.device_id) >= array_.size() || array_[dev.device_id] == nullptr) {
+    return Stats();
+  }
+  return array_[dev.device_id]->GetStats();
+}
+
+Map<String, ObjectRef> WorkspacePool::Stats::AsMap() const {
+  Map<String, ObjectRef> stats;
+  stats.Set("current_bytes", ObjectRef(make_object<profiling::CountNode>(current_bytes)));
+  stats.Set("peak_bytes", ObjectRef(make_object<profiling::CountNode>(peak_bytes)));
+  stats.Set("reserved_bytes", ObjectRef(make_object<profiling::CountNode>(reserved_bytes)));
+  stats.Set("wasted_bytes", ObjectRef(make_object<profiling::CountNode>(wasted_bytes)));
+  return stats;
+}
+
 }  // namespace runtime
 }  // namespace tvm
@@ -24,7 +24,10 @@
 #ifndef TVM_RUNTIME_WORKSPACE_POOL_H_
 #define TVM_RUNTIME_WORKSPACE_POOL_H_
 
+#include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/string.h>
 #include <tvm/runtime/device_api.h>
+#include <tvm/runtime/profiling.h>
 
 #include <memory>
 #include <vector>
@@ -44,6 +47,19 @@ namespace runtime {
  */
 class TVM_DLL WorkspacePool {
  public:
+  /*! \brief Memory statistics of the pool of one device. */
+  struct Stats {
+    /*! \brief The bytes of the blocks in use. */
+    size_t current_bytes{0};
+    /*! \brief The peak of current_bytes. */
+    size_t peak_bytes{0};
+    /*! \brief The bytes allocated from the device, both in use and cached. */
+    size_t reserved_bytes{0};
+    /*! \brief The bytes of the blocks in use beyond the requested sizes. */
+    size_t wasted_bytes{0};
+    /*! \return The statistics as a map from name to profiling::CountNode. */
+    Map<String, ObjectRef> AsMap() const;
+  };
   /*!
    * \brief Create pool with specific device type and device.
    * \param device_type The device type.
@@ -65,6 +81,12 @@ class TVM_DLL WorkspacePool {
    * \param ptr The pointer to be freed.
    */
   void FreeWorkspace(Device dev, void* ptr);
+  /*!
+   * \brief Get the memory statistics of the pool.
+   * \param dev The device of the pool.
+   * \return The statistics, all zero if the device has not been used.
+   */
+  Stats GetStats(Device dev) const;
 
  private:
   class Pool;
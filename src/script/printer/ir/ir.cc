@@ -17,6 +17,7 @@
  * under the License.
  */
 #include <tvm/ir/tensor_type.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include "./utils.h"
 
@@ -165,6 +166,120 @@ std::string ReprPrintIRModule(const ObjectRef& mod, const PrinterConfig& cfg) {
   return ReprPrintIR(mod, cfg);
 }
 
+/*! \brief Write the lines of text to a stream, indented by \p indent spaces. */
+void WriteIndented(const std::string& text, int indent, std::ostream* os) {
+  size_t begin = 0;
+  while (begin < text.size()) {
+    size_t end = std::min(text.find('\n', begin), text.size());
+    if (end > begin) {
+      *os << std::string(indent, ' ');
+      os->write(text.data() + begin, end - begin);
+    }
+    *os << '\n';
+    begin = end + 1;
+  }
+}
+
+/*!
+ * \brief Print an IRModule to a stream one function at a time, so that only the doc tree and the
+ *  text of a single function are alive at once. The output matches ReprPrintIRModule.
+ */
+void ScriptIRModuleToStream(const ObjectRef& obj, const PrinterConfig& cfg, std::ostream* os) {
+  IRModule mod = Downcast<IRModule>(obj);
+  if (const auto* f = runtime::Registry::Get("relay.ir.PrintRelayModule")) {
+    if (Optional<String> s = (*f)(mod)) {
+      *os << s.value();
+      return;
+    }
+  }
+  ICHECK(!cfg->show_meta) << "ValueError: The metadata is printed ahead of the module, so it "
+                             "cannot be streamed. Use script() to print it";
+  ICHECK(!cfg->print_line_numbers) << "ValueError: Line numbers cannot be streamed";
+  std::vector<SortableFunction> functions;
+  bool has_tir = false;
+  for (const auto& kv : mod->functions) {
+    functions.push_back(SortableFunction(kv));
+    has_tir |= kv.second->IsInstance<tir::PrimFuncNode>();
+  }
+  std::sort(functions.begin(), functions.end());
+  String module_name =
+      cfg->binding_names.empty() ? String("Module") : cfg->binding_names.back();
+
+  *os << "# from tvm.script import ir as " << cfg->ir_prefix << '\n';
+  if (has_tir) {
+    *os << "# from tvm.script import tir as " << cfg->tir_prefix << '\n';
+  }
+  *os << "\n@" << cfg->ir_prefix << ".ir_module\nclass " << module_name << ":\n";
+
+  // The metadata is carried from function to function, to keep the indices into it unique.
+  std::unordered_map<String, Array<ObjectRef>> metadata;
+  auto new_docsifier = [&]() {
+    IRDocsifier d(cfg);
+    d->metadata = std::move(metadata);
+    return d;
+  };
+  if (mod->attrs.defined() && !mod->attrs->dict.empty()) {
+    IRDocsifier d = new_docsifier();
+    With<IRFrame> f(d);
+    (*f)->AddDispatchToken(d, "ir");
+    StmtDoc attrs = ExprStmtDoc(IR(d, "module_attrs")  //
+                                    ->Call({d->AsDoc<ExprDoc>(mod->attrs,
+                                                              ObjectPath::Root()->Attr("attrs"))}));
+    WriteIndented(DocToPythonScript(StmtBlockDoc({attrs}), cfg), cfg->indent_spaces, os);
+    metadata = std::move(d->metadata);
+  }
+  for (size_t i = 0; i < functions.size(); ++i) {
+    const GlobalVar& gv = functions[i].gv;
+    const BaseFunc& func = functions[i].func;
+    IRDocsifier d = new_docsifier();
+    With<IRFrame> f(d);
+    (*f)->AddDispatchToken(d, "ir");
+    d->Define(mod, f(), module_name);
+    // Declare the function itself and the functions it calls, rather than the whole module.
+    std::unordered_set<GlobalVar, ObjectPtrHash, ObjectPtrEqual> gvars{gv};
+    if (const auto* prim_func = func.as<tir::PrimFuncNode>()) {
+      tir::PostOrderVisit(prim_func->body, [&gvars](const ObjectRef& node) {
+        if (const auto* call = node.as<tir::CallNode>()) {
+          if (const auto* callee = call->op.as<GlobalVarNode>()) {
+            gvars.insert(GetRef<GlobalVar>(callee));
+          }
+        }
+      });
+    } else {
+      for (const auto& entry : functions) {
+        gvars.insert(entry.gv);
+      }
+    }
+    for (const GlobalVar& var : gvars) {
+      d->Define(var, f(), [=]() {
+        return d->AsDoc<ExprDoc>(mod, ObjectPath::Root()->Attr("global_vars"))
+            ->Attr(var->name_hint);
+      });
+    }
+    cfg->binding_names.push_back(gv->name_hint);
+    Doc doc = d->AsDoc(func, ObjectPath::Root()->Attr("functions")->MapValue(gv));
+    cfg->binding_names.pop_back();
+    StmtDoc stmt{nullptr};
+    if (const auto* stmt_block = doc.as<StmtBlockDocNode>()) {
+      stmt = stmt_block->stmts.back();
+      stmt->source_paths = std::move(doc->source_paths);
+    } else {
+      stmt = Downcast<StmtDoc>(doc);
+    }
+    if (i > 0) {
+      *os << '\n';
+    }
+    WriteIndented(DocToPythonScript(StmtBlockDoc({stmt}), cfg), cfg->indent_spaces, os);
+    metadata = std::move(d->metadata);
+  }
+  if (!metadata.empty()) {
+    *os << "# Metadata omitted. Use show_meta=True in script() method to show it.";
+  }
+}
+
+TVM_STATIC_IR_FUNCTOR(TVMScriptPrinter, stream_vtable)
+    .set_dispatch<IRModuleNode>(ScriptIRModuleToStream);
+
 TVM_SCRIPT_REPR(TypeVarNode, ReprPrintIR);
 TVM_SCRIPT_REPR(GlobalTypeVarNode, ReprPrintIR);
 TVM_SCRIPT_REPR(GlobalVarNode, ReprPrintIR);
@@ -132,12 +132,21 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
           });
     });
 
+// The lanes of a ramp or broadcast, vscale() * n for the -n lanes of a scalable vector.
+static ExprDoc PrintVectorLanes(int lanes, const ObjectPath& p, const IRDocsifier& d) {
+  if (lanes > 0) {
+    return LiteralDoc::Int(lanes, p);
+  }
+  return OperationDoc(OperationDocNode::Kind::kMult,
+                      {TIR(d, "vscale")->Call({}), LiteralDoc::Int(-lanes, p)});
+}
+
 TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
     .set_dispatch<tir::Ramp>("", [](tir::Ramp ramp, ObjectPath ramp_p, IRDocsifier d) -> Doc {
       return TIR(d, "Ramp")->Call({
           d->AsDoc<ExprDoc>(ramp->base, ramp_p->Attr("base")),
           d->AsDoc<ExprDoc>(ramp->stride, ramp_p->Attr("stride")),
-          LiteralDoc::Int(ramp->lanes, ramp_p->Attr("lanes")),
+          PrintVectorLanes(ramp->lanes, ramp_p->Attr("lanes"), d),
       });
     });
 
@@ -146,7 +155,7 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
       return TIR(d, "Broadcast")
           ->Call({
               d->AsDoc<ExprDoc>(bc->value, bc_p->Attr("value")),
-              LiteralDoc::Int(bc->lanes, bc_p->Attr("lanes")),
+              PrintVectorLanes(bc->lanes, bc_p->Attr("lanes"), d),
           });
     });
 
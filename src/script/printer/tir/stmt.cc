@@ -233,27 +233,30 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
           return DoConciseScoping(lhs, rhs, &(*f)->stmts, concise);
         });
 
+/*!
+ * \brief Print the elements of a constant array.
+ * \param max_elems The maximum number of elements to print, or -1 to print all of them.
+ */
 template <typename T>
-ExprDoc PrintNDArray(::tvm::runtime::NDArray arr) {
+ExprDoc PrintNDArray(::tvm::runtime::NDArray arr, int max_elems) {
   // FIXME(@junrushao): this is a hack and can be wrong in most of the cases
-  constexpr int NUM_PRINT = 200;
-  int ndim = arr->ndim;
-  int tot_dim = 1;
-  for (int i = 0; i < ndim; i++) {
+  int64_t tot_dim = 1;
+  for (int i = 0; i < arr->ndim; i++) {
     tot_dim *= arr->shape[i];
   }
+  if (max_elems >= 0) {
+    tot_dim = std::min<int64_t>(tot_dim, max_elems);
+  }
   Array<ExprDoc> result;
+  result.reserve(tot_dim);
   T* data_ptr = reinterpret_cast<T*>(arr->data);
   runtime::DataType dtype = arr.DataType();
-  for (int i = 0; i < tot_dim; i++) {
+  for (int64_t i = 0; i < tot_dim; i++) {
     if (dtype.is_float()) {
       result.push_back(LiteralDoc::Float(data_ptr[i], NullOpt));
     } else {
       result.push_back(LiteralDoc::Int(data_ptr[i], NullOpt));
     }
-    if (i == NUM_PRINT) {
-      break;
-    }
   }
   return ListDoc(result);
 }
@@ -269,35 +272,35 @@ TVM_STATIC_IR_FUNCTOR(IRDocsifier, vtable)
           ExprDoc data_doc{nullptr};
           if (stmt->dtype.is_int()) {
             if (stmt->dtype.bits() == 8) {
-              data_doc = PrintNDArray<int8_t>(stmt->data.value());
+              data_doc = PrintNDArray<int8_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 16) {
-              data_doc = PrintNDArray<int16_t>(stmt->data.value());
+              data_doc = PrintNDArray<int16_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 32) {
-              data_doc = PrintNDArray<int32_t>(stmt->data.value());
+              data_doc = PrintNDArray<int32_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 64) {
-              data_doc = PrintNDArray<int64_t>(stmt->data.value());
+              data_doc = PrintNDArray<int64_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else {
               LOG(FATAL) << "DataType not supported";
             }
           } else if (stmt->dtype.is_uint()) {
             if (stmt->dtype.bits() == 8) {
-              data_doc = PrintNDArray<uint8_t>(stmt->data.value());
+              data_doc = PrintNDArray<uint8_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 16) {
-              data_doc = PrintNDArray<uint16_t>(stmt->data.value());
+              data_doc = PrintNDArray<uint16_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 32) {
-              data_doc = PrintNDArray<uint32_t>(stmt->data.value());
+              data_doc = PrintNDArray<uint32_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 64) {
-              data_doc = PrintNDArray<uint64_t>(stmt->data.value());
+              data_doc = PrintNDArray<uint64_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else {
               LOG(FATAL) << "DataType not supported";
             }
           } else if (stmt->dtype.is_float()) {
             if (stmt->dtype.bits() == 16) {
-              data_doc = PrintNDArray<int16_t>(stmt->data.value());
+              data_doc = PrintNDArray<int16_t>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 32) {
-              data_doc = PrintNDArray<float>(stmt->data.value());
+              data_doc = PrintNDArray<float>(stmt->data.value(), d->cfg->max_constant_elems);
             } else if (stmt->dtype.bits() == 64) {
-              data_doc = PrintNDArray<double>(stmt->data.value());
+              data_doc = PrintNDArray<double>(stmt->data.value(), d->cfg->max_constant_elems);
             } else {
               LOG(FATAL) << "DataType not supported";
             }
@@ -187,6 +187,10 @@
 #define TVM_INFO_USE_SORT "NOT-FOUND"
 #endif
 
+#ifndef TVM_INFO_USE_SPIRV_KHR_COOPERATIVE_MATRIX
+#define TVM_INFO_USE_SPIRV_KHR_COOPERATIVE_MATRIX "NOT-FOUND"
+#endif
+
 #ifndef TVM_INFO_USE_NNPACK
 #define TVM_INFO_USE_NNPACK "NOT-FOUND"
 #endif
@@ -282,6 +286,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_CUBLAS", TVM_INFO_USE_CUBLAS},
       {"USE_CUDA", TVM_INFO_USE_CUDA},
       {"USE_CUDNN", TVM_INFO_USE_CUDNN},
+      {"USE_CUPTI", TVM_INFO_USE_CUPTI},
       {"USE_CUSTOM_LOGGING", TVM_INFO_USE_CUSTOM_LOGGING},
       {"USE_CUTLASS", TVM_INFO_USE_CUTLASS},
       {"USE_AMX", TVM_INFO_USE_AMX},
@@ -291,6 +296,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_FALLBACK_STL_MAP", TVM_INFO_USE_FALLBACK_STL_MAP},
       {"USE_GRAPH_EXECUTOR_CUDA_GRAPH", TVM_INFO_USE_GRAPH_EXECUTOR_CUDA_GRAPH},
       {"USE_GRAPH_EXECUTOR", TVM_INFO_USE_GRAPH_EXECUTOR},
+      {"USE_GRAPH_EXECUTOR_HIP_GRAPH", TVM_INFO_USE_GRAPH_EXECUTOR_HIP_GRAPH},
       {"USE_GTEST", TVM_INFO_USE_GTEST},
       {"USE_HEXAGON", TVM_INFO_USE_HEXAGON},
       {"USE_HEXAGON_RPC", TVM_INFO_USE_HEXAGON_RPC},
@@ -324,6 +330,7 @@ TVM_DLL Map<String, String> GetLibInfo() {
       {"USE_RTTI", TVM_INFO_USE_RTTI},
       {"USE_RUST_EXT", TVM_INFO_USE_RUST_EXT},
       {"USE_SORT", TVM_INFO_USE_SORT},
+      {"USE_SPIRV_KHR_COOPERATIVE_MATRIX", TVM_INFO_USE_SPIRV_KHR_COOPERATIVE_MATRIX},
       {"USE_SPIRV_KHR_INTEGER_DOT_PRODUCT", TVM_INFO_USE_SPIRV_KHR_INTEGER_DOT_PRODUCT},
       {"USE_STACKVM_RUNTIME", TVM_INFO_USE_STACKVM_RUNTIME},
       {"USE_TARGET_ONNX", TVM_INFO_USE_TARGET_ONNX},
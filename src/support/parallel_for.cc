@@ -24,14 +24,176 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
-#include <future>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace tvm {
 namespace support {
 
+namespace {
+
+/*! \brief A parallel loop submitted to the thread pool, split into tasks. */
+struct ParallelJob {
+  /*! \brief The function running a task. */
+  std::function<void(int)> run;
+  /*! \brief The number of tasks. */
+  int num_tasks;
+  /*! \brief The next task to be claimed, guarded by the mutex of the thread pool. */
+  int next_task = 0;
+  /*! \brief The number of tasks not finished yet. */
+  std::atomic<int> remaining;
+  /*! \brief The first exception thrown by a task. */
+  std::exception_ptr error = nullptr;
+  /*! \brief The mutex guarding `error` and the condition variable. */
+  std::mutex mutex;
+  /*! \brief The condition variable notified when all tasks are finished. */
+  std::condition_variable finished;
+
+  ParallelJob(std::function<void(int)> run, int num_tasks)
+      : run(std::move(run)), num_tasks(num_tasks), remaining(num_tasks) {}
+
+  void RunTask(int task_id) {
+    try {
+      run(task_id);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+    if (--remaining == 0) {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished.notify_all();
+    }
+  }
+};
+
+/*!
+ * \brief The thread pool shared by all the parallel loops at compile time. The threads are
+ * created once, and the thread calling a parallel loop runs its tasks too. A thread waiting for
+ * the tasks of its loop taken by others runs the tasks pending in any loop meanwhile, so the loops
+ * can be nested without running out of threads.
+ */
+class CompileThreadPool {
+ public:
+  static CompileThreadPool* Global() {
+    static std::mutex mutex;
+    static CompileThreadPool* pool = nullptr;
+    std::lock_guard<std::mutex> lock(mutex);
+#ifndef _WIN32
+    // The threads are not inherited by a forked process, whose pool is created again. The pool of
+    // the parent is leaked, since its mutex may have been held by a thread at the fork.
+    static pid_t pid = 0;
+    if (pool != nullptr && pid != getpid()) {
+      pool = nullptr;
+    }
+    pid = getpid();
+#endif
+    if (pool == nullptr) {
+      pool = new CompileThreadPool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    }
+    return pool;
+  }
+
+  /*!
+   * \brief Run the tasks of a job on the pool and the calling thread, and wait for them.
+   * \param job The job to be run.
+   */
+  void Run(const std::shared_ptr<ParallelJob>& job) {
+    if (job->num_tasks > 1 && !workers_.empty()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Depth first, the loops nested in a task are run before the other tasks pending
+      pending_.push_front(job);
+      has_pending_.notify_all();
+    }
+    std::shared_ptr<ParallelJob> claimed;
+    int task_id;
+    while (job->remaining > 0) {
+      if (Claim(job, &claimed, &task_id)) {
+        claimed->RunTask(task_id);
+        continue;
+      }
+      // All the tasks left are running on other threads
+      std::unique_lock<std::mutex> lock(job->mutex);
+      job->finished.wait(lock, [&job]() { return job->remaining == 0; });
+    }
+  }
+
+ private:
+  explicit CompileThreadPool(int num_workers) {
+    workers_.reserve(num_workers);
+    for (int i = 0; i < num_workers; ++i) {
+      workers_.emplace_back([this]() { this->WorkerLoop(); });
+      workers_.back().detach();
+    }
+  }
+
+  /*!
+   * \brief Claim a task to run, preferring the job given, then the pending jobs in order.
+   * \param preferred The job whose tasks are claimed first.
+   * \param job The job of the task claimed.
+   * \param task_id The id of the task claimed.
+   * \return Whether a task is claimed.
+   */
+  bool Claim(const std::shared_ptr<ParallelJob>& preferred, std::shared_ptr<ParallelJob>* job,
+             int* task_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (preferred != nullptr && preferred->next_task < preferred->num_tasks) {
+      *job = preferred;
+    } else if (!pending_.empty()) {
+      *job = pending_.front();
+    } else {
+      return false;
+    }
+    *task_id = (*job)->next_task++;
+    if ((*job)->next_task == (*job)->num_tasks) {
+      auto it = std::find(pending_.begin(), pending_.end(), *job);
+      if (it != pending_.end()) {
+        pending_.erase(it);
+      }
+    }
+    return true;
+  }
+
+  void WorkerLoop() {
+    std::shared_ptr<ParallelJob> job;
+    int task_id;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        has_pending_.wait(lock, [this]() { return !pending_.empty(); });
+      }
+      while (Claim(nullptr, &job, &task_id)) {
+        job->RunTask(task_id);
+        job.reset();
+      }
+    }
+  }
+
+  /*! \brief The worker threads, detached since the pool lives until the process exits. */
+  std::vector<std::thread> workers_;
+  /*! \brief The mutex guarding the pending jobs and the tasks claimed. */
+  std::mutex mutex_;
+  /*! \brief The condition variable notified when a job is submitted. */
+  std::condition_variable has_pending_;
+  /*! \brief The jobs with tasks not claimed yet. */
+  std::deque<std::shared_ptr<ParallelJob>> pending_;
+};
+
+}  // namespace
+
 std::vector<std::vector<int>> rr_partitioner(int begin, int end, int step, int num_threads) {
   int total_task_count = (end - begin) / step;
   ICHECK_GE(total_task_count, 0) << "Infinite loop condition with begin: " << begin
@@ -49,47 +211,25 @@ std::vector<std::vector<int>> rr_partitioner(int begin, int end, int step, int n
 
 void parallel_for(int begin, int end, const std::function<void(int)>& f, int step,
                   const PartitionerFuncType partitioner) {
-  static bool GLOBAL_PARALLEL_FOR_FLAG{false};
-  static std::mutex M_GLOBAL_PARALLEL_FOR_FLAG;
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    ICHECK(!GLOBAL_PARALLEL_FOR_FLAG) << "There's another parallel_for running. Maybe you're "
-                                      << "currently inside another parallel_for loop.";
-    GLOBAL_PARALLEL_FOR_FLAG = true;
-  }
-
   int default_num_threads = std::thread::hardware_concurrency();
   const auto& run_partitions = partitioner(begin, end, step, default_num_threads);
-
-  std::vector<std::thread> threads;
-  threads.reserve(run_partitions.size());
-  std::vector<std::future<void>> res_vec;
-  res_vec.reserve(run_partitions.size());
-  for (const auto& run_partition : run_partitions) {
-    std::packaged_task<void(const std::vector<int>&, const std::function<void(int)>&)> task(
-        [](const std::vector<int>& run_partition, const std::function<void(int)>& f) {
-          for (const auto& i : run_partition) {
-            f(i);
-          }
-        });
-    res_vec.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), run_partition, f);
-  }
-
-  for (auto&& thread : threads) {
-    thread.join();
-  }
-  {
-    std::unique_lock<std::mutex> l(M_GLOBAL_PARALLEL_FOR_FLAG);
-    ICHECK(GLOBAL_PARALLEL_FOR_FLAG);
-    GLOBAL_PARALLEL_FOR_FLAG = false;
+  if (run_partitions.empty()) {
+    return;
   }
-  try {
-    for (auto&& i : res_vec) {
-      i.get();
+  auto job = std::make_shared<ParallelJob>(
+      [&run_partitions, &f](int partition_id) {
+        for (const auto& i : run_partitions[partition_id]) {
+          f(i);
+        }
+      },
+      run_partitions.size());
+  CompileThreadPool::Global()->Run(job);
+  if (job->error != nullptr) {
+    try {
+      std::rethrow_exception(job->error);
+    } catch (const std::exception& e) {
+      LOG(FATAL) << "Parallel_for error with " << e.what();
     }
-  } catch (const std::exception& e) {
-    LOG(FATAL) << "Parallel_for error with " << e.what();
   }
 }
 
@@ -101,42 +241,24 @@ void parallel_for_dynamic(int begin, int end, int num_threads,
   }
   CHECK_LE(begin, end) << "ValueError: The interval [begin, end) requires `begin <= end`";
   CHECK_GT(num_threads, 0) << "ValueError: `num_threads` should be positive";
-  // Step 2. Launch threads
-  // Step 2.1. Launch worker 1 to worker `num_threads - 1`
+  // Step 2. Run `num_threads` workers on the thread pool, each fetching the next task on the fly.
+  // A worker runs on one thread at a time, so the thread ids index thread-local states as before.
   std::atomic<int> counter{begin};
-  std::vector<std::future<void>> futures;
-  std::vector<std::thread> threads;
-  futures.reserve(num_threads - 1);
-  threads.reserve(num_threads - 1);
-  auto worker = [end, &counter, &f](int thread_id) -> void {
-    for (int task_id; (task_id = counter++) < end;) {
-      f(thread_id, task_id);
-    }
-  };
-  for (int thread_id = 1; thread_id < num_threads; ++thread_id) {
-    std::packaged_task<void(int)> task(worker);
-    futures.emplace_back(task.get_future());
-    threads.emplace_back(std::move(task), thread_id);
-  }
-  // Step 2.2. Launch worker 0 inplace
-  try {
-    worker(0);
-  } catch (const std::exception& e) {
-    for (auto&& thread : threads) {
-      thread.join();
-    }
-    LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
-  }
-  // Step 3. Join threads and check exceptions
-  for (auto&& thread : threads) {
-    thread.join();
-  }
-  try {
-    for (auto&& future : futures) {
-      future.get();
+  auto job = std::make_shared<ParallelJob>(
+      [end, &counter, &f](int thread_id) -> void {
+        for (int task_id; (task_id = counter++) < end;) {
+          f(thread_id, task_id);
+        }
+      },
+      num_threads);
+  CompileThreadPool::Global()->Run(job);
+  // Step 3. Check exceptions
+  if (job->error != nullptr) {
+    try {
+      std::rethrow_exception(job->error);
+    } catch (const std::exception& e) {
+      LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
     }
-  } catch (const std::exception& e) {
-    LOG(FATAL) << "RuntimeError: parallel_for_dynamic error with " << e.what();
   }
 }
 
@@ -37,6 +37,8 @@
 #include <unordered_set>
 #include <vector>
 
+#include "../runtime/lz4.h"
+
 namespace tvm {
 namespace codegen {
 
@@ -61,7 +63,13 @@ runtime::Module Build(IRModule mod, Target target) {
 /*! \brief Helper class to serialize module */
 class ModuleSerializer {
  public:
-  explicit ModuleSerializer(runtime::Module mod) : mod_(mod) { Init(); }
+  explicit ModuleSerializer(runtime::Module mod, std::string compression = "")
+      : mod_(mod), compression_(compression) {
+    ICHECK(compression_.empty() || compression_ == "none" || compression_ == "lz4")
+        << "ValueError: Unknown compression of the packed imports: " << compression_
+        << ", the supported ones are none and lz4";
+    Init();
+  }
 
   void SerializeModule(dmlc::Stream* stream) {
     // Only have one DSO module and it is in the root, then
@@ -86,8 +94,12 @@ class ModuleSerializer {
       if (!group[0]->IsDSOExportable()) {
         ICHECK_EQ(group.size(), 1U) << "Non DSO module is never merged";
         std::string mod_type_key = group[0]->type_key();
-        stream->Write(mod_type_key);
-        group[0]->SaveToBinary(stream);
+        if (compression_.empty()) {
+          stream->Write(mod_type_key);
+          group[0]->SaveToBinary(stream);
+        } else {
+          SavePackedModule(group[0], mod_type_key, stream);
+        }
       } else {
         // DSOExportable: do not need binary
         if (has_import_tree) {
@@ -107,6 +119,46 @@ class ModuleSerializer {
   }
 
  private:
+  // The names of the functions of a module, empty when the module does not list them. They let the
+  // loader find the module of a function without decoding the others.
+  static std::vector<std::string> ListFunctionNames(runtime::ModuleNode* mod) {
+    std::vector<std::string> names;
+    PackedFunc get_func_names = mod->GetFunction("get_func_names", false);
+    PackedFunc get_symbol = mod->GetFunction("get_symbol", false);
+    if (get_func_names != nullptr) {
+      Array<String> func_names = get_func_names();
+      for (const String& name : func_names) {
+        names.push_back(name);
+      }
+      names.push_back("get_func_names");
+    } else if (get_symbol != nullptr) {
+      // The external runtime modules, see JSONRuntimeBase.
+      std::string symbol = get_symbol();
+      names = {symbol, "__init_" + symbol, "get_symbol", "get_const_vars"};
+    }
+    return names;
+  }
+
+  // Save the binary of a module as a sized, optionally compressed, payload that the loader can
+  // skip over and decode on the first use of the module.
+  void SavePackedModule(runtime::ModuleNode* mod, const std::string& mod_type_key,
+                        dmlc::Stream* stream) {
+    std::string bin;
+    dmlc::MemoryStringStream ms(&bin);
+    mod->SaveToBinary(&ms);
+    uint64_t raw_size = bin.size();
+    std::string payload =
+        compression_ == "lz4" ? runtime::LZ4Compress(bin.data(), bin.size()) : std::move(bin);
+    uint64_t payload_size = payload.size();
+    stream->Write(std::string("_lazy"));
+    stream->Write(mod_type_key);
+    stream->Write(ListFunctionNames(mod));
+    stream->Write(compression_);
+    stream->Write(raw_size);
+    stream->Write(payload_size);
+    stream->Write(payload.data(), payload.size());
+  }
+
   void Init() {
     CreateModuleIndex();
     CreateImportTree();
@@ -219,6 +271,8 @@ class ModuleSerializer {
   }
 
   runtime::Module mod_;
+  // the compression of the packed modules, empty to save them in place
+  std::string compression_;
   // construct module to index
   std::unordered_map<runtime::ModuleNode*, size_t> mod2index_;
   // index -> module group
@@ -228,12 +282,12 @@ class ModuleSerializer {
 };
 
 namespace {
-std::string SerializeModule(const runtime::Module& mod) {
+std::string SerializeModule(const runtime::Module& mod, const std::string& compression) {
   std::string bin;
   dmlc::MemoryStringStream ms(&bin);
   dmlc::Stream* stream = &ms;
 
-  ModuleSerializer module_serializer(mod);
+  ModuleSerializer module_serializer(mod, compression);
   module_serializer.SerializeModule(stream);
 
   return bin;
@@ -241,8 +295,8 @@ std::string SerializeModule(const runtime::Module& mod) {
 }  // namespace
 
 std::string PackImportsToC(const runtime::Module& mod, bool system_lib,
-                           const std::string& c_symbol_prefix) {
-  std::string bin = SerializeModule(mod);
+                           const std::string& c_symbol_prefix, const std::string& compression) {
+  std::string bin = SerializeModule(mod, compression);
   std::string mdev_blob_name = c_symbol_prefix + runtime::symbol::tvm_dev_mblob;
 
   if (c_symbol_prefix.length() != 0) {
@@ -298,13 +352,14 @@ std::string PackImportsToC(const runtime::Module& mod, bool system_lib,
 
 runtime::Module PackImportsToLLVM(const runtime::Module& mod, bool system_lib,
                                   const std::string& llvm_target_string,
-                                  const std::string& c_symbol_prefix) {
+                                  const std::string& c_symbol_prefix,
+                                  const std::string& compression) {
   if (c_symbol_prefix.length() != 0) {
     CHECK(system_lib)
         << "c_symbol_prefix advanced option should be used in conjuction with system-lib";
   }
 
-  std::string bin = SerializeModule(mod);
+  std::string bin = SerializeModule(mod, compression);
 
   uint64_t nbytes = bin.length();
   std::string header;
@@ -541,6 +541,7 @@ void CodeGenCPU::InitGlobalContext(bool dynamic_lookup) {
       // Mark as context functions
       gv_func_map_["TVMBackendAllocWorkspace"] = nullptr;
       gv_func_map_["TVMBackendFreeWorkspace"] = nullptr;
+      gv_func_map_["TVMBackendProfileIntrinsic"] = nullptr;
     }
   }
 }
@@ -1425,6 +1426,14 @@ llvm::Value* CodeGenCPU::CreateIntrinsic(const CallNode* op) {
     return CreateCallPacked(op, false /* use_string_lookup */);
   } else if (op->op.same_as(builtin::tvm_static_handle())) {
     return CreateStaticHandle();
+  } else if (op->op.same_as(builtin::start_profile_intrinsic()) ||
+             op->op.same_as(builtin::end_profile_intrinsic())) {
+    // Defined in include/tvm/runtime/c_backend_api.h:
+    // int TVMBackendProfileIntrinsic(int32_t id, int32_t is_end);
+    ICHECK_EQ(op->args.size(), 1U);
+    PrimExpr is_end = IntImm(DataType::Int(32), op->op.same_as(builtin::end_profile_intrinsic()));
+    return CreateCallExtern(PrimType(DataType::Int(32)), "TVMBackendProfileIntrinsic",
+                            {cast(DataType::Int(32), op->args[0]), is_end}, false);
   } else if (op->op.same_as(builtin::tvm_throw_last_error())) {
     builder_->CreateRet(ConstInt32(-1));
     auto next_block = std::next(builder_->GetInsertBlock()->getIterator());
@@ -69,6 +69,7 @@
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
 #include <llvm/Linker/Linker.h>
+#include <llvm/MC/MCSubtargetInfo.h>
 #include <llvm/Pass.h>
 #if TVM_LLVM_VERSION >= 160
 #include <llvm/IR/Verifier.h>  // For VerifierPass
@@ -106,6 +107,7 @@
 #include "../../arith/pattern_match.h"
 #include "../build_common.h"
 #include "../func_registry_generator.h"
+#include "../source/codegen_params.h"
 #include "codegen_params.h"
 #include "llvm_instance.h"
 
@@ -186,6 +188,20 @@ void CodeGenLLVM::InitTarget() {
     }
   }
 
+  if (Optional<Bool> gather_scatter = llvm_target_->GetGatherScatter()) {
+    emit_gather_ = emit_scatter_ = force_gather_scatter_ = gather_scatter.value();
+  } else {
+    // Elsewhere llvm.masked.gather/scatter are scalarized, no faster than the per-lane accesses.
+    const llvm::MCSubtargetInfo* sti = tm->getMCSubtargetInfo();
+    const auto& arch = tm->getTargetTriple().getArch();
+    if (arch == llvm::Triple::x86_64 || arch == llvm::Triple::x86) {
+      emit_scatter_ = sti->checkFeatures("+avx512f");
+      emit_gather_ = emit_scatter_ || sti->checkFeatures("+avx2");
+    } else if (arch == llvm::Triple::aarch64) {
+      emit_gather_ = emit_scatter_ = sti->checkFeatures("+sve");
+    }
+  }
+
 #if TVM_LLVM_VERSION >= 60
   bool use_float16_abi = false;
 #if TVM_LLVM_VERSION >= 150
@@ -569,7 +585,13 @@ llvm::Type* CodeGenLLVM::DTypeToLLVMType(const DataType& dtype) const {
         LOG(FATAL) << "do not support " << dtype;
     }
   }
-  if (dtype.lanes() != 1) {
+  if (dtype.is_scalable_vector()) {
+#if TVM_LLVM_VERSION >= 130
+    return llvm::ScalableVectorType::get(etype, dtype.vscale_factor());
+#else
+    LOG(FATAL) << "Scalable vector type " << dtype << " requires LLVM 13 or newer";
+#endif
+  } else if (dtype.lanes() != 1) {
 #if TVM_LLVM_VERSION >= 110
     return llvm::FixedVectorType::get(etype, dtype.lanes());
 #else
@@ -732,6 +754,14 @@ std::unique_ptr<CodeGenLLVM::DebugInfo> CodeGenLLVM::CreateDebugInfo(llvm::Modul
 }
 
 llvm::Value* CodeGenLLVM::CreateBroadcast(llvm::Value* value, int lanes) {
+  if (lanes < 0) {
+    // A scalable vector of vscale * -lanes elements.
+#if TVM_LLVM_VERSION >= 130
+    return builder_->CreateVectorSplat(llvm::ElementCount::getScalable(-lanes), value);
+#else
+    LOG(FATAL) << "Scalable vectors require LLVM 13 or newer";
+#endif
+  }
 #if TVM_LLVM_VERSION >= 110
   llvm::Type* type = llvm::FixedVectorType::get(value->getType(), lanes);
 #else
@@ -1341,6 +1371,20 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
       }
     }
 
+    // The declaration of an intrinsic that is not overloaded has fixed parameter types, bit cast
+    // the arguments of the same size to them. For example, the bfloat16 vectors of the x86
+    // dot products are integer vectors before LLVM 17, and the AMX tile loads take i8 pointers.
+    if (!llvm::Intrinsic::isOverloaded(id)) {
+      llvm::FunctionType* f_type = f->getFunctionType();
+      for (size_t i = 0; i < arg_value.size() && i < f_type->getNumParams(); ++i) {
+        llvm::Type* param_type = f_type->getParamType(i);
+        if (param_type != arg_value[i]->getType() &&
+            llvm::CastInst::isBitCastable(arg_value[i]->getType(), param_type)) {
+          arg_value[i] = builder_->CreateBitCast(arg_value[i], param_type);
+        }
+      }
+    }
+
     return builder_->CreateCall(f, arg_value);
   } else if (op->op.same_as(builtin::bitwise_and())) {
     return builder_->CreateAnd(MakeValue(op->args[0]), MakeValue(op->args[1]));
@@ -1458,6 +1502,12 @@ llvm::Value* CodeGenLLVM::CreateIntrinsic(const CallNode* op) {
   } else if (op->op.same_as(builtin::assume())) {
     llvm::Value* cond = MakeValue(op->args[0]);
     return builder_->CreateAssumption(cond);
+  } else if (op->op.same_as(builtin::vscale())) {
+#if TVM_LLVM_VERSION >= 130
+    return builder_->CreateVScale(ConstInt32(1));
+#else
+    LOG(FATAL) << "vscale requires LLVM 13 or newer";
+#endif
   } else {
     LOG(FATAL) << "unknown intrinsic " << op->op;
   }
@@ -1661,14 +1711,29 @@ void CodeGenLLVM::BufferAccessHelper(
   }
 
   PrimExpr last_index = indices[indices.size() - 1];
+  bool is_volatile = volatile_buf_.count(buffer->data.get());
+
+  if (value_dtype.is_scalable_vector()) {
+    // The lanes of a scalable vector cannot be accessed one by one, only as a whole.
+    const RampNode* ramp_index = last_index.as<RampNode>();
+    ICHECK(ramp_index && is_one(ramp_index->stride))
+        << "Buffer " << buffer->name << " can only be accessed as a scalable vector "
+        << value_dtype << " with a contiguous index, but got " << last_index;
+    ICHECK_GE(value_dtype.bits(), 8);
+    std::vector<llvm::Value*> all_index_values = earlier_index_values;
+    all_index_values.push_back(MakeValue(ramp_index->base));
+    TypedPointer buffer_ptr = CreateBufferPtr(MakeValue(buffer->data), buffer_element_dtype,
+                                              all_index_values, value_dtype);
+    auto instruction = make_instruction(buffer_ptr, -1, value_dtype.bits() / 8, is_volatile);
+    AddAliasInfo(instruction, buffer->data.get(), last_index, buffer_element_dtype);
+    return;
+  }
   ICHECK_EQ(value_dtype.lanes(), last_index.dtype().lanes() * buffer_element_dtype.lanes());
 
   // Record index and elemtype in original form used for alias info
   PrimExpr last_index_origin = last_index;
   DataType buffer_element_dtype_origin = buffer_element_dtype;
 
-  bool is_volatile = volatile_buf_.count(buffer->data.get());
-
   // If the buffer index is a contiguous ramp node, we only need to
   // access the first element, then cast to the value type.
   if (const RampNode* ramp_index = last_index.as<RampNode>()) {
@@ -1727,13 +1792,67 @@ void CodeGenLLVM::BufferAccessHelper(
   }
 }
 
+bool CodeGenLLVM::IsGatherScatter(const Buffer& buffer, const Array<PrimExpr>& indices,
+                                  DataType value_dtype, bool is_predicated, bool is_store) const {
+  if (indices.size() != 1 || value_dtype.is_scalable_vector()) return false;
+  int lanes = indices[0].dtype().lanes();
+  if (lanes == 1 || value_dtype.element_of() != buffer->dtype || value_dtype.bits() < 8) {
+    return false;
+  }
+  if (const RampNode* ramp = indices[0].as<RampNode>(); ramp && is_one(ramp->stride)) {
+    return false;
+  }
+  if (volatile_buf_.count(buffer->data.get())) return false;
+  // A predicated access of non-contiguous elements has no other lowering.
+  if (is_predicated) return true;
+  if (!(is_store ? emit_scatter_ : emit_gather_)) return false;
+  // Otherwise, only the gathers/scatters of 32- or 64-bit elements filling a vector register are
+  // faster than the per-lane accesses.
+  return force_gather_scatter_ ||
+         (lanes >= 4 && (value_dtype.bits() == 32 || value_dtype.bits() == 64));
+}
+
+llvm::Value* CodeGenLLVM::CreateElementPtrs(const Buffer& buffer, const PrimExpr& index) {
+  llvm::Value* buffer_ptr = MakeValue(buffer->data);
+  llvm::PointerType* buffer_ptr_type = llvm::dyn_cast<llvm::PointerType>(buffer_ptr->getType());
+  ICHECK(buffer_ptr_type != nullptr);
+  llvm::Type* element_type = DTypeToLLVMType(buffer->dtype);
+  llvm::PointerType* element_ptr_type =
+      element_type->getPointerTo(buffer_ptr_type->getAddressSpace());
+  if (buffer_ptr_type != element_ptr_type) {
+    buffer_ptr = builder_->CreatePointerCast(buffer_ptr, element_ptr_type);
+  }
+  // A vector index makes a vector of pointers.
+  return builder_->CreateInBoundsGEP(element_type, buffer_ptr, MakeValue(index));
+}
+
 llvm::Value* CodeGenLLVM::VisitExpr_(const BufferLoadNode* op) {
   DataType value_dtype = op->dtype;
 
   std::vector<llvm::Value*> loads;
-
-  auto make_load = [this, &loads](TypedPointer buffer_ptr, int /* subelement_i */, int alignment,
-                                  bool is_volatile) {
+  llvm::Value* predicate = op->predicate ? MakeValue(op->predicate.value()) : nullptr;
+
+  if (IsGatherScatter(op->buffer, op->indices, value_dtype, predicate != nullptr, false)) {
+    llvm::Type* type = DTypeToLLVMType(value_dtype);
+    llvm::Value* passthru = predicate != nullptr ? llvm::Constant::getNullValue(type) : nullptr;
+    llvm::Instruction* gather =
+        CreateMaskedGather(type, CreateElementPtrs(op->buffer, op->indices[0]),
+                           value_dtype.bits() / 8, predicate, passthru);
+    AddAliasInfo(gather, op->buffer->data.get(), op->indices[0], op->buffer->dtype);
+    return gather;
+  }
+
+  auto make_load = [this, &loads, predicate](TypedPointer buffer_ptr, int subelement_i,
+                                             int alignment,
+                                             bool is_volatile) -> llvm::Instruction* {
+    if (predicate != nullptr) {
+      ICHECK_EQ(subelement_i, -1) << "A predicated load must access contiguous elements";
+      llvm::Value* passthru = llvm::Constant::getNullValue(buffer_ptr.type);
+      llvm::Instruction* load =
+          CreateMaskedLoad(buffer_ptr.type, buffer_ptr.addr, alignment, predicate, passthru);
+      loads.push_back(load);
+      return load;
+    }
 #if TVM_LLVM_VERSION >= 110
     auto load = builder_->CreateAlignedLoad(buffer_ptr.type, buffer_ptr.addr,
                                             llvm::Align(alignment), is_volatile);
@@ -1800,6 +1919,17 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const CallNode* op) {
 }
 
 llvm::Value* CodeGenLLVM::VisitExpr_(const RampNode* op) {
+  if (op->dtype.is_scalable_vector()) {
+#if TVM_LLVM_VERSION >= 130
+    // base + stepvector * stride, as the lanes are not known at compile time.
+    llvm::Value* step = builder_->CreateStepVector(DTypeToLLVMType(op->dtype));
+    llvm::Value* base = CreateBroadcast(MakeValue(op->base), op->lanes);
+    llvm::Value* stride = CreateBroadcast(MakeValue(op->stride), op->lanes);
+    return builder_->CreateAdd(base, builder_->CreateMul(step, stride));
+#else
+    LOG(FATAL) << "Scalable vectors require LLVM 13 or newer";
+#endif
+  }
   llvm::Value* vec = llvm::UndefValue::get(DTypeToLLVMType(op->dtype));
   for (int i = 0; i < op->lanes; ++i) {
     vec = builder_->CreateInsertElement(
@@ -1836,15 +1966,70 @@ llvm::Value* CodeGenLLVM::VisitExpr_(const BroadcastNode* op) {
   return CreateBroadcast(MakeValue(op->value), op->lanes);
 }
 
+llvm::Instruction* CodeGenLLVM::CreateMaskedLoad(llvm::Type* type, llvm::Value* ptr, int alignment,
+                                                 llvm::Value* mask, llvm::Value* passthru) {
+#if TVM_LLVM_VERSION >= 130
+  return builder_->CreateMaskedLoad(type, ptr, llvm::Align(alignment), mask, passthru);
+#elif TVM_LLVM_VERSION >= 110
+  return builder_->CreateMaskedLoad(ptr, llvm::Align(alignment), mask, passthru);
+#else
+  return builder_->CreateMaskedLoad(ptr, alignment, mask, passthru);
+#endif
+}
+
+llvm::Instruction* CodeGenLLVM::CreateMaskedStore(llvm::Value* value, llvm::Value* ptr,
+                                                  int alignment, llvm::Value* mask) {
+#if TVM_LLVM_VERSION >= 110
+  return builder_->CreateMaskedStore(value, ptr, llvm::Align(alignment), mask);
+#else
+  return builder_->CreateMaskedStore(value, ptr, alignment, mask);
+#endif
+}
+
+llvm::Instruction* CodeGenLLVM::CreateMaskedGather(llvm::Type* type, llvm::Value* ptrs,
+                                                   int alignment, llvm::Value* mask,
+                                                   llvm::Value* passthru) {
+#if TVM_LLVM_VERSION >= 130
+  return builder_->CreateMaskedGather(type, ptrs, llvm::Align(alignment), mask, passthru);
+#elif TVM_LLVM_VERSION >= 110
+  return builder_->CreateMaskedGather(ptrs, llvm::Align(alignment), mask, passthru);
+#else
+  return builder_->CreateMaskedGather(ptrs, alignment, mask, passthru);
+#endif
+}
+
+llvm::Instruction* CodeGenLLVM::CreateMaskedScatter(llvm::Value* value, llvm::Value* ptrs,
+                                                    int alignment, llvm::Value* mask) {
+#if TVM_LLVM_VERSION >= 110
+  return builder_->CreateMaskedScatter(value, ptrs, llvm::Align(alignment), mask);
+#else
+  return builder_->CreateMaskedScatter(value, ptrs, alignment, mask);
+#endif
+}
+
 void CodeGenLLVM::VisitStmt_(const BufferStoreNode* op) {
   EmitDebugLocation(op);
   DataType value_dtype = op->value.dtype();
   Var buffer_var = op->buffer->data;
 
   llvm::Value* value = MakeValue(op->value);
+  llvm::Value* predicate = op->predicate ? MakeValue(op->predicate.value()) : nullptr;
 
-  auto make_store = [this, value](TypedPointer buffer_ptr, int subelement_i, int alignment,
-                                  bool is_volatile) {
+  if (IsGatherScatter(op->buffer, op->indices, value_dtype, predicate != nullptr, true)) {
+    llvm::Instruction* scatter =
+        CreateMaskedScatter(value, CreateElementPtrs(op->buffer, op->indices[0]),
+                            value_dtype.bits() / 8, predicate);
+    AddAliasInfo(scatter, buffer_var.get(), op->indices[0], op->buffer->dtype);
+    return;
+  }
+
+  auto make_store = [this, value, predicate](TypedPointer buffer_ptr, int subelement_i,
+                                             int alignment,
+                                             bool is_volatile) -> llvm::Instruction* {
+    if (predicate != nullptr) {
+      ICHECK_EQ(subelement_i, -1) << "A predicated store must access contiguous elements";
+      return CreateMaskedStore(value, buffer_ptr.addr, alignment, predicate);
+    }
     llvm::Value* to_store = value;
     if (subelement_i != -1) {
       to_store = builder_->CreateExtractElement(value, subelement_i);
@@ -1919,10 +2104,22 @@ void CodeGenLLVM::VisitStmt_(const IfThenElseNode* op) {
 void CodeGenLLVM::VisitStmt_(const AllocateConstNode* op) {
   EmitDebugLocation(op);
   auto data = op->data.value();
-  auto array = NDArrayToLLVMArray(llvm_target_->GetContext(), data);
+  bool as_blob = tvm::transform::PassContext::Current()
+                     ->GetConfig<Bool>(kLinkParamsAsBlob, Bool(false))
+                     .value();
+  llvm::Constant* array = as_blob ? NDArrayToLLVMBlob(llvm_target_->GetContext(), data)
+                                  : NDArrayToLLVMArray(llvm_target_->GetContext(), data);
   std::string symbol_name = op->buffer_var->name_hint;
   llvm::GlobalVariable* param_symbol = new llvm::GlobalVariable(
       *module_, array->getType(), true, llvm::GlobalValue::InternalLinkage, array, symbol_name);
+  if (as_blob) {
+    param_symbol->setSection(".rodata.tvm");
+#if TVM_LLVM_VERSION >= 100
+    param_symbol->setAlignment(llvm::Align(runtime::kAllocAlignment));
+#else
+    param_symbol->setAlignment(runtime::kAllocAlignment);
+#endif
+  }
 
   var_map_[op->buffer_var.operator->()] = param_symbol;
   this->VisitStmt(op->body);
@@ -353,6 +353,27 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
       std::function<llvm::Instruction*(TypedPointer buffer_ptr, int subelement_i, int alignment,
                                        bool is_volatile)>
           make_instruction);
+  // Create the llvm.masked.load and llvm.masked.store of a predicated access.
+  llvm::Instruction* CreateMaskedLoad(llvm::Type* type, llvm::Value* ptr, int alignment,
+                                      llvm::Value* mask, llvm::Value* passthru);
+  llvm::Instruction* CreateMaskedStore(llvm::Value* value, llvm::Value* ptr, int alignment,
+                                       llvm::Value* mask);
+  /*!
+   * \brief Whether a vector access of non-contiguous elements is emitted as a gather/scatter.
+   *
+   *  Otherwise BufferAccessHelper accesses its elements one by one. Unless forced by the
+   *  "gather-scatter" target option, only the accesses the hardware gathers/scatters faster are.
+   */
+  bool IsGatherScatter(const Buffer& buffer, const Array<PrimExpr>& indices, DataType value_dtype,
+                       bool is_predicated, bool is_store) const;
+  // Create the vector of pointers to the elements of a 1-d buffer at a vector index.
+  llvm::Value* CreateElementPtrs(const Buffer& buffer, const PrimExpr& index);
+  // Create the llvm.masked.gather and llvm.masked.scatter of a non-contiguous access, of all
+  // the lanes if mask is nullptr.
+  llvm::Instruction* CreateMaskedGather(llvm::Type* type, llvm::Value* ptrs, int alignment,
+                                        llvm::Value* mask, llvm::Value* passthru);
+  llvm::Instruction* CreateMaskedScatter(llvm::Value* value, llvm::Value* ptrs, int alignment,
+                                         llvm::Value* mask);
   // Initialize target
   virtual void InitTarget();
   // Add module startup function if needed.
@@ -539,6 +560,11 @@ class CodeGenLLVM : public ExprFunctor<llvm::Value*(const PrimExpr&)>,
   std::vector<std::unique_ptr<llvm::Module>> link_modules_;
   /*! \brief native vector bits of current targetx*/
   int native_vector_bits_{0};
+  /*! \brief whether the vector loads/stores of non-contiguous elements may be gathers/scatters */
+  bool emit_gather_{false};
+  bool emit_scatter_{false};
+  /*! \brief whether they are, whatever their number of lanes and element type */
+  bool force_gather_scatter_{false};
   /*! \brief the storage scope of allocation */
   std::unordered_map<const VarNode*, StorageInfo> alloc_storage_info_;
   // The definition of local variable.
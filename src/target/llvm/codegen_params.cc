@@ -25,6 +25,7 @@
 #include "codegen_params.h"
 
 #include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/LLVMContext.h>
@@ -176,6 +177,48 @@ llvm::ConstantArray* NDArrayToLLVMArray(llvm::LLVMContext* ctx, ::tvm::runtime::
       llvm::ArrayType::get(element_type, num_elements), llvm::ArrayRef<llvm::Constant*>(elements)));
 }
 
+llvm::Constant* NDArrayToLLVMBlob(llvm::LLVMContext* ctx, ::tvm::runtime::NDArray arr) {
+  auto arr_type = arr.DataType();
+  CHECK(arr.IsContiguous()) << "CodegenParams: only support contiguous arrays";
+  CHECK_EQ(arr->device.device_type, kDLCPU) << "CodegenParams: only support contiguous arrays";
+  CHECK_EQ(arr_type.lanes(), 1) << "CodegenParams: only support generating 1-lane parameters; saw "
+                                << arr_type.lanes();
+  llvm::Type* element_type = nullptr;
+  switch (arr_type.code()) {
+    case runtime::DataType::kInt:
+    case runtime::DataType::kUInt:
+      CHECK(arr_type.bits() == 8 || arr_type.bits() == 16 || arr_type.bits() == 32 ||
+            arr_type.bits() == 64)
+          << "CodegenParams: only support generating 8-, 16-, 32-, or 64-bit integer params; saw "
+          << arr_type.bits() << "-bit array";
+      element_type = llvm::Type::getIntNTy(*ctx, arr_type.bits());
+      break;
+    case runtime::DataType::kFloat:
+      if (arr_type.bits() == 16) {
+        // NOTE: float16 is treated as uint16_t.
+        element_type = llvm::Type::getInt16Ty(*ctx);
+      } else if (arr_type.bits() == 32) {
+        element_type = llvm::Type::getFloatTy(*ctx);
+      } else if (arr_type.bits() == 64) {
+        element_type = llvm::Type::getDoubleTy(*ctx);
+      } else {
+        LOG(FATAL) << "CodegenParams: only support 32- or 64-bit floating point; saw "
+                   << arr_type.bits() << "-bit array";
+      }
+      break;
+    case runtime::DataType::kBFloat:
+      CHECK(arr_type.bits() == 16)
+          << "CodegenParams: only support 16-bit bfloat; saw " << arr_type.bits() << "-bit array";
+      element_type = llvm::Type::getInt16Ty(*ctx);
+      break;
+    default:
+      LOG(FATAL) << "Data type not supported";
+  }
+  size_t num_bytes = runtime::GetDataSize(*arr.operator->());
+  llvm::StringRef data(static_cast<const char*>(arr->data) + arr->byte_offset, num_bytes);
+  return llvm::ConstantDataArray::getRaw(data, num_bytes / arr_type.bytes(), element_type);
+}
+
 }  // namespace codegen
 }  // namespace tvm
 
@@ -27,6 +27,7 @@
 #include <tvm/runtime/ndarray.h>
 
 namespace llvm {
+class Constant;
 class ConstantArray;
 class LLVMContext;
 }  // namespace llvm
@@ -45,6 +46,18 @@ namespace codegen {
  */
 llvm::ConstantArray* NDArrayToLLVMArray(llvm::LLVMContext* ctx, tvm::runtime::NDArray arr);
 
+/*!
+ * \brief Convert an NDArray to an LLVM data array holding a copy of its raw bytes.
+ *
+ * Unlike NDArrayToLLVMArray, no constant is created per element, so the cost does not grow with
+ * the number of elements beyond the copy. The bytes are used in the byte order of the host.
+ *
+ * \param ctx LLVM context used to create the various primitive datatypes.
+ * \param arr NDArray to convert.
+ * \return LLVM constant data array of the element type of arr.
+ */
+llvm::Constant* NDArrayToLLVMBlob(llvm::LLVMContext* ctx, tvm::runtime::NDArray arr);
+
 }  // namespace codegen
 }  // namespace tvm
 
@@ -281,6 +281,8 @@ LLVMTargetInfo::LLVMTargetInfo(LLVMInstance& instance, const Target& target) {
 #endif
 #endif
   }
+
+  gather_scatter_ = target->GetAttr<Bool>("gather-scatter");
 }
 
 LLVMTargetInfo::LLVMTargetInfo(LLVMInstance& scope, const std::string& target_str)
@@ -362,6 +364,10 @@ std::string LLVMTargetInfo::str() const {
 #endif
   }
 
+  if (gather_scatter_.defined()) {
+    os << " -gather-scatter=" << (gather_scatter_.value() ? "1" : "0");
+  }
+
   if (opt_level_ != defaults::opt_level) {
     os << " -opt-level=";
     switch (opt_level_) {
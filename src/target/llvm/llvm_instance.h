@@ -212,6 +212,12 @@ class LLVMTargetInfo {
    * \return `llvm::FastMathFlags` for this target
    */
   llvm::FastMathFlags GetFastMathFlags() const { return fast_math_flags_; }
+  /*!
+   * \brief Get whether the vectorized accesses of non-contiguous elements use gathers/scatters
+   * \return the value of the "gather-scatter" option, or nullopt to leave it to the code
+   *         generator, depending on the hardware support
+   */
+  Optional<Bool> GetGatherScatter() const { return gather_scatter_; }
   /*!
    * \brief Get the LLVM optimization level
    * \return optimization level for this target
@@ -282,6 +288,7 @@ class LLVMTargetInfo {
   std::vector<Option> llvm_options_;
   llvm::TargetOptions target_options_;
   llvm::FastMathFlags fast_math_flags_;
+  Optional<Bool> gather_scatter_;
   llvm::CodeGenOpt::Level opt_level_;
   llvm::Reloc::Model reloc_model_ = llvm::Reloc::PIC_;
   llvm::CodeModel::Model code_model_ = llvm::CodeModel::Small;
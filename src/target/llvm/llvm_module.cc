@@ -27,10 +27,12 @@
 
 #include <dmlc/io.h>
 #include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/ExecutionEngine/MCJIT.h>  // Force linking of MCJIT
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Intrinsics.h>
@@ -40,13 +42,18 @@
 #include <llvm/IR/Metadata.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/CachePruning.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <tvm/ir/module.h>
+#include <tvm/ir/transform.h>
 #include <tvm/relay/runtime.h>
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/string.h>
@@ -59,13 +66,18 @@
 #include <tvm/support/with.h>
 #include <tvm/target/codegen.h>
 #include <tvm/target/target.h>
+#include <tvm/tir/stmt_functor.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -84,6 +96,118 @@ using runtime::PackedFunc;
 using runtime::TVMArgs;
 using runtime::TVMRetValue;
 
+/*!
+ * \brief A content addressed cache of object code in a directory, which processes can share.
+ *
+ *  The entries are keyed by the SHA1 of the bitcode of a module, which holds the target, and of
+ *  the kind of code it is compiled to. The least recently used entries are pruned once the
+ *  directory outgrows its size limit.
+ */
+class LLVMObjectCache final : public llvm::ObjectCache {
+ public:
+  LLVMObjectCache(std::string dir, uint64_t max_bytes)
+      : dir_(std::move(dir)), max_bytes_(max_bytes) {}
+
+  /*!
+   * \brief Get the cache created with the options of the current PassContext.
+   * \return The cache, or nullptr when "codegen.llvm.object_cache_dir" and the
+   *  TVM_LLVM_OBJECT_CACHE_DIR environment variable are both unset.
+   */
+  static std::unique_ptr<LLVMObjectCache> Create() {
+    tvm::transform::PassContext pass_ctx = tvm::transform::PassContext::Current();
+    std::string dir =
+        pass_ctx->GetConfig<String>("codegen.llvm.object_cache_dir", String("")).value();
+    if (dir.empty()) {
+      const char* env = std::getenv("TVM_LLVM_OBJECT_CACHE_DIR");
+      if (env == nullptr || *env == '\0') return nullptr;
+      dir = env;
+    }
+    int64_t max_mb =
+        pass_ctx->GetConfig<Integer>("codegen.llvm.object_cache_max_mb", Integer(1024))
+            .value()
+            ->value;
+    return std::make_unique<LLVMObjectCache>(dir, static_cast<uint64_t>(max_mb) << 20);
+  }
+
+  /*! \brief The key of the code of a kind, "obj" or "jit", compiled from module. */
+  std::string Key(const llvm::Module& module, const std::string& kind) const {
+    llvm::SmallString<0> bitcode;
+    llvm::raw_svector_ostream os(bitcode);
+#if TVM_LLVM_VERSION <= 60
+    llvm::WriteBitcodeToFile(&module, os);
+#else
+    llvm::WriteBitcodeToFile(module, os);
+#endif
+    std::string data = std::string(LLVM_VERSION_STRING) + '\0' + kind + '\0';
+    data.append(bitcode.data(), bitcode.size());
+    return "llvmcache-" + llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(data)), true);
+  }
+
+  /*! \brief Get the object code of key, nullptr on a miss. */
+  std::unique_ptr<llvm::MemoryBuffer> Lookup(const std::string& key) const {
+    auto buffer = llvm::MemoryBuffer::getFile(Path(key));
+    if (!buffer) return nullptr;
+    return std::move(buffer.get());
+  }
+
+  /*! \brief Store the object code of key, then prune the directory. */
+  void Store(const std::string& key, llvm::StringRef object) const {
+    if (llvm::sys::fs::create_directories(dir_)) return;
+    // Write to a temporary file first, so other processes never read a partial entry. The
+    // temporary files do not start with llvmcache- so they are not pruned.
+    int fd;
+    llvm::SmallString<128> tmp_path;
+    if (llvm::sys::fs::createUniqueFile(dir_ + "/tmp-%%%%%%%%", fd, tmp_path)) return;
+    {
+      llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+      os << object;
+    }
+    if (llvm::sys::fs::rename(tmp_path, Path(key))) {
+      llvm::sys::fs::remove(tmp_path);
+      return;
+    }
+    llvm::CachePruningPolicy policy;
+    policy.Interval = std::chrono::seconds(0);
+    policy.Expiration = std::chrono::seconds(0);
+    policy.MaxSizeBytes = max_bytes_;
+    llvm::pruneCache(dir_, policy);
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) final {
+    std::string key = Key(*module, "jit");
+    std::unique_ptr<llvm::MemoryBuffer> buffer = Lookup(key);
+    if (buffer == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_[module] = key;
+    }
+    return buffer;
+  }
+
+  void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) final {
+    std::string key;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_.find(module);
+      if (it == pending_.end()) return;
+      key = std::move(it->second);
+      pending_.erase(it);
+    }
+    Store(key, object.getBuffer());
+  }
+
+ private:
+  std::string Path(const std::string& key) const { return dir_ + "/" + key; }
+
+  std::string dir_;
+  uint64_t max_bytes_;
+  std::mutex mutex_;
+  // The keys of the modules the JIT is compiling.
+  std::unordered_map<const llvm::Module*, std::string> pending_;
+};
+
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.llvm.object_cache_dir", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.llvm.object_cache_max_mb", Integer);
+
 class LLVMModuleNode final : public runtime::ModuleNode {
  public:
   ~LLVMModuleNode();
@@ -105,6 +229,13 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   void Init(const IRModule& mod, const Target& target);
   void Init(std::unique_ptr<llvm::Module> module, std::unique_ptr<LLVMInstance> llvm_instance);
   void LoadIR(const std::string& file_name);
+  /*!
+   * \brief Emit the object code of the module now, instead of when it is saved to a file, so
+   *  that the modules of a sharded build are emitted in parallel.
+   */
+  void EmitObject();
+  /*! \brief Get the object code of the module, from the object cache when possible. */
+  std::string EmitObjectCode();
 
   bool ImplementsFunction(const String& name, bool query_imports) final;
 
@@ -127,6 +258,10 @@ class LLVMModuleNode final : public runtime::ModuleNode {
   std::unique_ptr<llvm::Module> module_owning_ptr_;
   /* \brief names of the external functions declared in this module */
   Array<String> function_names_;
+  /* \brief The object code emitted by EmitObject, or empty */
+  std::string object_code_;
+  /* \brief The cache of the object code, or nullptr */
+  std::unique_ptr<LLVMObjectCache> object_cache_;
 };
 
 LLVMModuleNode::~LLVMModuleNode() {
@@ -202,7 +337,7 @@ constexpr auto llvm_assembly_file_target = llvm::CGFT_AssemblyFile;
 #endif
 
 bool LLVMAddPassesToEmitFile(llvm::TargetMachine* tm, llvm::legacy::PassManager* pm,
-                             llvm::raw_fd_ostream* dest,
+                             llvm::raw_pwrite_stream* dest,
                              decltype(llvm_object_file_target) llvm_file_target) {
 #if TVM_LLVM_VERSION <= 60
   return tm->addPassesToEmitFile(*pm, *dest, llvm_file_target);
@@ -222,15 +357,19 @@ void LLVMModuleNode::SaveToFile(const String& file_name_str, const String& forma
   ICHECK_EQ(ecode.value(), 0) << "Cannot open file: " << file_name << " " << ecode.message();
   bool is_obj_file = fmt == "o" || fmt == "obj";
   bool is_asm_file = fmt == "s" || fmt == "asm";
-  if (is_obj_file || is_asm_file) {
-    auto llvm_file_target = is_obj_file ? llvm_object_file_target : llvm_assembly_file_target;
-
+  if (is_obj_file) {
+    if (object_code_.empty()) {
+      dest << EmitObjectCode();
+    } else {
+      dest << object_code_;
+    }
+  } else if (is_asm_file) {
     With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
     llvm::legacy::PassManager pass;
     llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
 
-    auto err = LLVMAddPassesToEmitFile(tm, &pass, &dest, llvm_file_target);
-    ICHECK(!err) << "Cannot emit target CGFT_ObjectFile";
+    auto err = LLVMAddPassesToEmitFile(tm, &pass, &dest, llvm_assembly_file_target);
+    ICHECK(!err) << "Cannot emit target CGFT_AssemblyFile";
 
     pass.run(*CloneLLVMModule(module_));
   } else if (fmt == "ll") {
@@ -248,6 +387,32 @@ void LLVMModuleNode::SaveToFile(const String& file_name_str, const String& forma
   dest.close();
 }
 
+void LLVMModuleNode::EmitObject() { object_code_ = EmitObjectCode(); }
+
+std::string LLVMModuleNode::EmitObjectCode() {
+  std::string key;
+  if (object_cache_ != nullptr) {
+    key = object_cache_->Key(*module_, "obj");
+    if (std::unique_ptr<llvm::MemoryBuffer> object = object_cache_->Lookup(key)) {
+      return object->getBuffer().str();
+    }
+  }
+  With<LLVMTarget> llvm_target(*llvm_instance_, LLVMTarget::GetTargetMetadata(*module_));
+  llvm::SmallString<0> buffer;
+  llvm::raw_svector_ostream dest(buffer);
+  llvm::legacy::PassManager pass;
+  llvm::TargetMachine* tm = llvm_target->GetOrCreateTargetMachine();
+
+  auto err = LLVMAddPassesToEmitFile(tm, &pass, &dest, llvm_object_file_target);
+  ICHECK(!err) << "Cannot emit target CGFT_ObjectFile";
+
+  pass.run(*CloneLLVMModule(module_));
+  if (object_cache_ != nullptr) {
+    object_cache_->Store(key, buffer.str());
+  }
+  return std::string(buffer.data(), buffer.size());
+}
+
 void LLVMModuleNode::SaveToBinary(dmlc::Stream* stream) {
   LOG(FATAL) << "LLVMModule: SaveToBinary not supported";
 }
@@ -355,6 +520,7 @@ void LLVMModuleNode::Init(const IRModule& mod, const Target& target) {
   if (tm->getTargetTriple().isOSDarwin()) {
     module_->addModuleFlag(llvm::Module::Override, "Dwarf Version", 2);
   }
+  object_cache_ = LLVMObjectCache::Create();
 }
 
 void LLVMModuleNode::Init(std::unique_ptr<llvm::Module> module,
@@ -371,7 +537,15 @@ void LLVMModuleNode::LoadIR(const std::string& file_name) {
 }
 
 bool LLVMModuleNode::ImplementsFunction(const String& name, bool query_imports) {
-  return std::find(function_names_.begin(), function_names_.end(), name) != function_names_.end();
+  if (std::find(function_names_.begin(), function_names_.end(), name) != function_names_.end()) {
+    return true;
+  }
+  if (query_imports) {
+    for (runtime::Module& mod : imports_) {
+      if (mod->ImplementsFunction(name, true)) return true;
+    }
+  }
+  return false;
 }
 
 void LLVMModuleNode::LazyInitJIT() {
@@ -397,6 +571,9 @@ void LLVMModuleNode::LazyInitJIT() {
       << " and ExecutionEngine (" << layout.getStringRepresentation() << ")";
   ee_ = builder.create(tm.release());
   ICHECK(ee_ != nullptr) << "Failed to initialize jit engine for " << module_->getTargetTriple();
+  if (object_cache_ != nullptr) {
+    ee_->setObjectCache(object_cache_.get());
+  }
   ee_->runStaticConstructorsDestructors(false);
 
   if (void** ctx_addr =
@@ -444,8 +621,84 @@ void* LLVMModuleNode::GetFunctionAddr(const std::string& name,
   }
 }
 
+/*!
+ * \brief Build the PrimFuncs of \p mod into \p num_shards LLVM modules, each in its own LLVM
+ *  context, which are optimized and emitted on as many threads.
+ * \return The shard holding the entry function with the other shards imported, or nullptr when
+ *  \p mod cannot be sharded.
+ */
+runtime::Module BuildLLVMSharded(const IRModule& mod, const Target& target, int num_shards) {
+  relay::Runtime runtime =
+      mod->GetAttr<relay::Runtime>(tvm::attr::kRuntime).value_or(relay::Runtime::Create("cpp"));
+  // The system library and the C runtime register the functions of a single module, and the
+  // LLVM command line options of the target are global.
+  if (runtime->name == "crt" || runtime->GetAttr<Bool>("system-lib").value_or(Bool(false)) ||
+      mod->GetAttr<String>(tvm::attr::kSystemLibPrefix) ||
+      !target->GetAttr<Array<String>>("cl-opt").value_or({}).empty()) {
+    return runtime::Module();
+  }
+  std::vector<std::pair<GlobalVar, PrimFunc>> funcs;
+  std::vector<size_t> costs;
+  for (auto kv : mod->functions) {
+    auto opt_func = kv.second.as<PrimFunc>();
+    if (!opt_func) continue;
+    size_t cost = 0;
+    bool calls_global = false;
+    tir::PostOrderVisit(opt_func.value()->body, [&](const ObjectRef& node) {
+      ++cost;
+      if (const auto* call = node.as<tir::CallNode>()) {
+        calls_global = calls_global || call->op->IsInstance<GlobalVarNode>();
+      }
+    });
+    // Functions calling each other must be in the same module.
+    if (calls_global) return runtime::Module();
+    funcs.emplace_back(kv.first, opt_func.value());
+    costs.push_back(cost);
+  }
+  num_shards = std::min<int>(num_shards, static_cast<int>(funcs.size()));
+  if (num_shards <= 1) return runtime::Module();
+
+  // Give the largest functions first to the shard with the smallest functions so far.
+  std::vector<size_t> order(funcs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return costs[a] > costs[b]; });
+  std::vector<size_t> loads(num_shards, 0);
+  std::vector<Map<GlobalVar, BaseFunc>> shard_funcs(num_shards);
+  int entry_shard = 0;
+  for (size_t i : order) {
+    int shard = std::min_element(loads.begin(), loads.end()) - loads.begin();
+    loads[shard] += costs[i];
+    shard_funcs[shard].Set(funcs[i].first, funcs[i].second);
+    if (funcs[i].second->HasNonzeroAttr(tir::attr::kIsEntryFunc)) entry_shard = shard;
+  }
+
+  std::vector<ObjectPtr<LLVMModuleNode>> shards(num_shards);
+  tvm::transform::ParallelForEach(
+      tvm::transform::PassContext::Current(), num_shards, num_shards, [&](size_t i) {
+        shards[i] = make_object<LLVMModuleNode>();
+        shards[i]->Init(IRModule(shard_funcs[i], {}, {}, {}, mod->attrs), target);
+        shards[i]->EmitObject();
+      });
+  runtime::Module entry(shards[entry_shard]);
+  for (int i = 0; i < num_shards; ++i) {
+    if (i != entry_shard) entry->Import(runtime::Module(shards[i]));
+  }
+  return entry;
+}
+
+TVM_REGISTER_PASS_CONFIG_OPTION("codegen.llvm.num_shards", Integer);
+
 TVM_REGISTER_GLOBAL("target.build.llvm")
     .set_body_typed([](IRModule mod, Target target) -> runtime::Module {
+      int num_shards = tvm::transform::PassContext::Current()
+                           ->GetConfig<Integer>("codegen.llvm.num_shards", Integer(1))
+                           .value()
+                           ->value;
+      if (num_shards > 1) {
+        runtime::Module sharded = BuildLLVMSharded(mod, target, num_shards);
+        if (sharded.defined()) return sharded;
+      }
       auto n = make_object<LLVMModuleNode>();
       n->Init(mod, target);
       return runtime::Module(n);
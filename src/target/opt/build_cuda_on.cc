@@ -28,8 +28,15 @@
 #endif
 #include <cuda_runtime.h>
 #include <nvrtc.h>
+#include <tvm/ir/transform.h>
 
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "../../runtime/cuda/cuda_common.h"
 #include "../../runtime/cuda/cuda_module.h"
@@ -78,31 +85,51 @@ std::string FindCUDAIncludePath() {
   return cuda_include_path;
 }
 
-std::string NVRTCCompile(const std::string& code, bool include_path = false) {
+/*!
+ * \brief The options of NVRTC.
+ * \param include_path Whether the code includes the headers of CUDA.
+ * \param sass_arch The SASS architecture to compile a cubin for, e.g. "sm_80", or an empty
+ *  string to compile PTX for the architecture of the device.
+ */
+std::vector<std::string> NVRTCOptions(bool include_path, const std::string& sass_arch) {
   std::vector<std::string> compile_params;
-  std::vector<const char*> param_cstrings{};
-  nvrtcProgram prog;
-  std::string cc = "30";
-  int major, minor;
-  cudaError_t e1 = cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0);
-  cudaError_t e2 = cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0);
-
-  if (e1 == cudaSuccess && e2 == cudaSuccess) {
-    cc = std::to_string(major) + std::to_string(minor);
+  if (!sass_arch.empty()) {
+    compile_params.push_back("-arch=" + sass_arch);
   } else {
-    LOG(WARNING) << "cannot detect compute capability from your device, "
-                 << "fall back to compute_30.";
-  }
+    std::string cc = "30";
+    int major, minor;
+    cudaError_t e1 = cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, 0);
+    cudaError_t e2 = cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, 0);
 
-  compile_params.push_back("-arch=compute_" + cc);
+    if (e1 == cudaSuccess && e2 == cudaSuccess) {
+      cc = std::to_string(major) + std::to_string(minor);
+      // The wgmma and the other arch specific features of Hopper need compute_90a.
+      if (cc == "90") cc = "90a";
+    } else {
+      LOG(WARNING) << "cannot detect compute capability from your device, "
+                   << "fall back to compute_30.";
+    }
+    compile_params.push_back("-arch=compute_" + cc);
+  }
 
   if (include_path) {
     std::string include_option = "--include-path=" + FindCUDAIncludePath();
 
     compile_params.push_back(include_option);
   }
+  return compile_params;
+}
 
-  for (const auto& string : compile_params) {
+/*!
+ * \brief Compile code with NVRTC.
+ * \param options The options of NVRTC, see NVRTCOptions.
+ * \param cubin Whether to get the cubin of a SASS architecture rather than PTX.
+ */
+std::string NVRTCCompile(const std::string& code, const std::vector<std::string>& options,
+                         bool cubin) {
+  std::vector<const char*> param_cstrings{};
+  nvrtcProgram prog;
+  for (const auto& string : options) {
     param_cstrings.push_back(string.c_str());
   }
   NVRTC_CALL(nvrtcCreateProgram(&prog, code.c_str(), nullptr, 0, nullptr, nullptr));
@@ -114,6 +141,18 @@ std::string NVRTCCompile(const std::string& code, bool include_path = false) {
   log.resize(log_size);
   NVRTC_CALL(nvrtcGetProgramLog(prog, &log[0]));
   ICHECK_EQ(compile_res, NVRTC_SUCCESS) << log;
+  if (cubin) {
+#if CUDART_VERSION >= 11010
+    size_t cubin_size;
+    NVRTC_CALL(nvrtcGetCUBINSize(prog, &cubin_size));
+    std::string data(cubin_size, '\0');
+    NVRTC_CALL(nvrtcGetCUBIN(prog, &data[0]));
+    NVRTC_CALL(nvrtcDestroyProgram(&prog));
+    return data;
+#else
+    LOG(FATAL) << "Compiling a cubin with NVRTC needs CUDA 11.1 or later";
+#endif
+  }
   size_t ptx_size;
   NVRTC_CALL(nvrtcGetPTXSize(prog, &ptx_size));
 
@@ -125,6 +164,92 @@ std::string NVRTCCompile(const std::string& code, bool include_path = false) {
   return ptx;
 }
 
+namespace {
+
+/*!
+ * \brief The directory of the cache of compiled CUDA code, set by "cuda.compile_cache_dir" or
+ *  by the TVM_CUDA_COMPILE_CACHE_DIR environment variable. The cache is disabled when both are
+ *  unset.
+ */
+std::string CompileCacheDir() {
+  std::string dir = transform::PassContext::Current()
+                        ->GetConfig<String>("cuda.compile_cache_dir", String(""))
+                        .value();
+  if (dir.empty()) {
+    const char* env = std::getenv("TVM_CUDA_COMPILE_CACHE_DIR");
+    if (env != nullptr) dir = env;
+  }
+  return dir;
+}
+
+uint64_t FNV1aHash(const std::string& data) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::string CompileCachePath(const std::string& dir, const std::string& key) {
+  std::ostringstream os;
+  os << dir << "/" << std::hex << FNV1aHash(key) << ".cudabin";
+  return os.str();
+}
+
+/*!
+ * \brief Load the compiled code of a key, the file starts with the key to rule out collisions.
+ * \return Whether a valid entry was found.
+ */
+bool LoadCompiledCode(const std::string& path, const std::string& key, std::string* fmt,
+                      std::string* data) {
+  std::ifstream fs(path, std::ios::in | std::ios::binary);
+  if (!fs) return false;
+  uint64_t key_size = 0;
+  if (!fs.read(reinterpret_cast<char*>(&key_size), sizeof(key_size)) || key_size != key.size()) {
+    return false;
+  }
+  std::string stored_key(key_size, '\0');
+  if (!fs.read(&stored_key[0], key_size) || stored_key != key) return false;
+  if (!std::getline(fs, *fmt)) return false;
+  std::ostringstream os;
+  os << fs.rdbuf();
+  *data = os.str();
+  return !data->empty();
+}
+
+/*!
+ * \brief Store the compiled code of a key. The entry is written to a temporary file and renamed
+ *  into place, so the builder processes can share the directory. Failures only skip the cache.
+ */
+void StoreCompiledCode(const std::string& path, const std::string& key, const std::string& fmt,
+                       const std::string& data) {
+  std::string tmp_path =
+      path + ".tmp" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+  {
+    std::ofstream fs(tmp_path, std::ios::out | std::ios::binary);
+    if (!fs) {
+      LOG(WARNING) << "Cannot write the CUDA compile cache entry " << tmp_path;
+      return;
+    }
+    uint64_t key_size = key.size();
+    fs.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    fs.write(key.data(), key.size());
+    fs << fmt << "\n";
+    fs.write(data.data(), data.size());
+    if (!fs) {
+      fs.close();
+      std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+  }
+}
+
+}  // namespace
+
 runtime::Module BuildCUDA(IRModule mod, Target target) {
   using tvm::runtime::Registry;
   bool output_ssa = false;
@@ -149,13 +274,45 @@ runtime::Module BuildCUDA(IRModule mod, Target target) {
   std::string ptx;
   const auto* f_enter = Registry::Get("target.TargetEnterScope");
   (*f_enter)(target);
-  if (const auto* f = Registry::Get("tvm_callback_cuda_compile")) {
-    ptx = (*f)(code, target).operator std::string();
-    // Dirty matching to check PTX vs cubin.
-    // TODO(tqchen) more reliable checks
-    if (ptx[0] != '/') fmt = "cubin";
+  Array<String> sass_archs = transform::PassContext::Current()
+                                 ->GetConfig<Array<String>>("cuda.sass_archs", Array<String>())
+                                 .value();
+  const auto* f_compile = Registry::Get("tvm_callback_cuda_compile");
+  std::vector<std::string> nvrtc_options;
+  // The key holds everything the compiled code depends on. The callback reads the SASS
+  // architectures from the PassContext and the others from the target.
+  std::ostringstream key;
+  key << "tvm-cuda-cache-v1\n" << target->str() << "\n";
+  for (const String& arch : sass_archs) key << arch << " ";
+  if (f_compile != nullptr) {
+    key << "\ncallback\n";
   } else {
-    ptx = NVRTCCompile(code, cg.need_include_path());
+    CHECK(sass_archs.size() <= 1)
+        << "NVRTC compiles the SASS of a single architecture, the nvcc compiler of "
+        << "tvm.contrib.nvcc embeds several of them";
+    nvrtc_options =
+        NVRTCOptions(cg.need_include_path(), sass_archs.empty() ? "" : sass_archs[0]);
+    int nvrtc_major = 0, nvrtc_minor = 0;
+    NVRTC_CALL(nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+    key << "\nnvrtc " << nvrtc_major << "." << nvrtc_minor << "\n";
+    for (const std::string& option : nvrtc_options) key << option << "\n";
+  }
+  key << std::hex << FNV1aHash(code) << std::dec << " " << code.size() << "\n";
+  std::string cache_dir = CompileCacheDir();
+  std::string cache_path = cache_dir.empty() ? "" : CompileCachePath(cache_dir, key.str());
+  if (cache_path.empty() || !LoadCompiledCode(cache_path, key.str(), &fmt, &ptx)) {
+    if (f_compile != nullptr) {
+      ptx = (*f_compile)(code, target).operator std::string();
+      // Dirty matching to check PTX vs cubin.
+      // TODO(tqchen) more reliable checks
+      if (ptx[0] != '/') fmt = "cubin";
+    } else {
+      if (!sass_archs.empty()) fmt = "cubin";
+      ptx = NVRTCCompile(code, nvrtc_options, !sass_archs.empty());
+    }
+    if (!cache_path.empty()) {
+      StoreCompiledCode(cache_path, key.str(), fmt, ptx);
+    }
   }
   const auto* f_exit = Registry::Get("target.TargetExitScope");
   (*f_exit)(target);
@@ -163,5 +320,7 @@ runtime::Module BuildCUDA(IRModule mod, Target target) {
 }
 
 TVM_REGISTER_GLOBAL("target.build.cuda").set_body_typed(BuildCUDA);
+TVM_REGISTER_PASS_CONFIG_OPTION("cuda.compile_cache_dir", String);
+TVM_REGISTER_PASS_CONFIG_OPTION("cuda.sass_archs", Array<String>);
 }  // namespace codegen
 }  // namespace tvm
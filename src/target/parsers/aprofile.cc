@@ -113,6 +113,8 @@ static TargetFeatures GetFeatures(TargetJSON target) {
   const bool simd_flag = HasFlag(mcpu, mattr, "+neon") || HasFlag(mcpu, mattr, "+simd");
   const bool has_asimd = is_aarch64 || simd_flag;
   const bool has_sve = HasFlag(mcpu, mattr, "+sve");
+  // SME is optional in every architecture version.
+  const bool has_sme = HasFlag(mcpu, mattr, "+sme");
 
   const bool i8mm_flag = HasFlag(mcpu, mattr, "+i8mm");
   const bool i8mm_disable = HasFlag(mcpu, mattr, "+noi8mm");
@@ -130,7 +132,7 @@ static TargetFeatures GetFeatures(TargetJSON target) {
   return {
       {"is_aarch64", Bool(is_aarch64)},  {"has_asimd", Bool(has_asimd)},
       {"has_sve", Bool(has_sve)},        {"has_dotprod", Bool(has_dotprod)},
-      {"has_matmul_i8", Bool(has_i8mm)},
+      {"has_matmul_i8", Bool(has_i8mm)}, {"has_sme", Bool(has_sme)},
   };
 }
 
@@ -648,6 +648,22 @@ void CodeGenC::VisitStmt_(const AllocateConstNode* op) {
     num_elements *= dim;
   }
 
+  bool as_blob = tvm::transform::PassContext::Current()
+                     ->GetConfig<Bool>(kLinkParamsAsBlob, Bool(false))
+                     .value();
+  if (as_blob) {
+    // The data is defined by the assembler, C only sees its declaration.
+    decl_stream << "\n";
+    NDArrayDataToAsm(data, symbol_name, ".rodata.tvm", constants_byte_alignment_->value,
+                     decl_stream);
+    decl_stream << "extern const ";
+    PrintType(data.DataType(), decl_stream);
+    decl_stream << " " << symbol_name << "[" << num_elements << "];\n";
+    var_idmap_[op->buffer_var.operator->()] = symbol_name;
+    this->PrintStmt(op->body);
+    return;
+  }
+
   decl_stream << "\n"
               << "#ifdef __cplusplus\n"
               << "extern \"C\" {\n"
@@ -674,6 +690,7 @@ void CodeGenC::VisitStmt_(const DeclBufferNode* op) { this->PrintStmt(op->body);
 
 void CodeGenC::VisitExpr_(const BufferLoadNode* op, std::ostream& os) {  // NOLINT(*)
   ICHECK_EQ(op->indices.size(), 1) << "Load from non-flat memory not supported.";
+  ICHECK(!op->predicate.defined()) << "Predicated buffer load is not supported.";
 
   DataType value_dtype = op->dtype;
   PrimExpr index = op->indices[0];
@@ -733,6 +750,7 @@ void CodeGenC::VisitExpr_(const BufferLoadNode* op, std::ostream& os) {  // NOLI
 
 void CodeGenC::VisitStmt_(const BufferStoreNode* op) {
   ICHECK_EQ(op->indices.size(), 1) << "Store to non-flat memory not supported.";
+  ICHECK(!op->predicate.defined()) << "Predicated buffer store is not supported.";
 
   DataType value_dtype = op->value.dtype();
   DataType element_dtype = op->buffer->dtype;
@@ -66,6 +66,12 @@ class ThreadIdxExtractor : public tir::StmtVisitor {
         threadIdx_z_ext = op->value;
       }
     }
+    if (op->attr_key == tir::attr::cluster_dims) {
+      cluster_dims = Downcast<Array<Integer>>(op->node);
+    }
+    if (op->attr_key == tir::attr::persistent_kernel) {
+      min_blocks_per_sm = Downcast<IntImm>(op->value)->value;
+    }
     StmtVisitor::VisitStmt_(op);
   }
 
@@ -73,11 +79,18 @@ class ThreadIdxExtractor : public tir::StmtVisitor {
   PrimExpr threadIdx_x_ext = Integer(1);
   PrimExpr threadIdx_y_ext = Integer(1);
   PrimExpr threadIdx_z_ext = Integer(1);
+  Array<Integer> cluster_dims;
+  int64_t min_blocks_per_sm{0};
 };
 
 void CodeGenCUDA::PrintExtraAttrs(const PrimFunc& f) {
   ThreadIdxExtractor extractor;
   extractor(f->body);
+  if (!extractor.cluster_dims.empty()) {
+    ICHECK_EQ(extractor.cluster_dims.size(), 3U) << "The cluster dims must be given in x, y and z";
+    stream << " __cluster_dims__(" << extractor.cluster_dims[0] << ", "
+           << extractor.cluster_dims[1] << ", " << extractor.cluster_dims[2] << ")";
+  }
   arith::Analyzer analyzer;
   PrimExpr threadIdx_ext = analyzer.Simplify(extractor.threadIdx_x_ext * extractor.threadIdx_y_ext *
                                              extractor.threadIdx_z_ext);
@@ -86,7 +99,12 @@ void CodeGenCUDA::PrintExtraAttrs(const PrimFunc& f) {
       // unable to extract the number of threads per block, hence directly return
       return;
     }
-    stream << " __launch_bounds__(" << threadIdx_ext_int->value << ")";
+    stream << " __launch_bounds__(" << threadIdx_ext_int->value;
+    if (extractor.min_blocks_per_sm > 0) {
+      // Limit the registers of a thread so that the blocks of a persistent kernel fit together.
+      stream << ", " << extractor.min_blocks_per_sm;
+    }
+    stream << ")";
   }
 }
 
@@ -141,6 +159,14 @@ std::string CodeGenCUDA::Finish() {
     decl_stream << "#include <mma.h>\n";
   }
 
+  if (need_wgmma_desc_) {
+    decl_stream << _cuda_wgmma_desc_def;
+  }
+
+  if (need_cluster_ld_) {
+    decl_stream << _cuda_cluster_ld_def;
+  }
+
   decl_stream << "\n#if (((__CUDACC_VER_MAJOR__ == 11) && (__CUDACC_VER_MINOR__ >= 4)) || \\\n";
   decl_stream << "     (__CUDACC_VER_MAJOR__ > 11))\n";
   decl_stream << "#define TVM_ENABLE_L2_PREFETCH 1\n";
@@ -951,6 +977,85 @@ void CodeGenCUDA::VisitExpr_(const CallNode* op, std::ostream& os) {
   } else if (op->op.same_as(builtin::ptx_wait_group())) {
     int n = Downcast<IntImm>(op->args[0])->value;
     this->stream << "__asm__ __volatile__(\"cp.async.wait_group " << n << ";\");\n\n";
+  } else if (op->op.same_as(builtin::ptx_init_barrier_thread_count())) {
+    std::string barrier = this->PrintExpr(op->args[0]) + " + " + this->PrintExpr(op->args[1]);
+    this->stream << PrintInitBarrierThreadCountAsm(barrier, this->PrintExpr(op->args[2]));
+  } else if (op->op.same_as(builtin::ptx_arrive_barrier())) {
+    std::string barrier = this->PrintExpr(op->args[0]) + " + " + this->PrintExpr(op->args[1]);
+    this->stream << PrintArriveBarrierAsm(barrier);
+  } else if (op->op.same_as(builtin::ptx_arrive_barrier_expect_tx())) {
+    std::string barrier = this->PrintExpr(op->args[0]) + " + " + this->PrintExpr(op->args[1]);
+    this->stream << PrintArriveBarrierExpectTxAsm(barrier, this->PrintExpr(op->args[2]));
+  } else if (op->op.same_as(builtin::ptx_wait_barrier())) {
+    std::string barrier = this->PrintExpr(op->args[0]) + " + " + this->PrintExpr(op->args[1]);
+    this->stream << PrintWaitBarrierAsm(barrier, this->PrintExpr(op->args[2]));
+  } else if (op->op.same_as(builtin::ptx_cp_async_bulk())) {
+    ICHECK_EQ(op->args.size(), 7U);
+    std::string dst = this->PrintExpr(op->args[0]);
+    std::string dst_offset = this->PrintExpr(op->args[1]);
+    std::string src = this->PrintExpr(op->args[2]);
+    std::string src_offset = this->PrintExpr(op->args[3]);
+    std::string size = this->PrintExpr(op->args[4]);
+    std::string barrier = this->PrintExpr(op->args[5]) + " + " + this->PrintExpr(op->args[6]);
+    this->stream << PrintCpAsyncBulkAsm(dst, dst_offset, src, src_offset, size, barrier);
+  } else if (op->op.same_as(builtin::ptx_cp_async_bulk_tensor())) {
+    // arg 0: the number of dimensions
+    // arg 1-2: the destination in shared memory
+    // arg 3: the tensor map
+    // arg 4-5: the mbarrier
+    // arg 6-: the coordinates of the tile, innermost dimension first
+    int dim = Downcast<IntImm>(op->args[0])->value;
+    ICHECK_EQ(op->args.size(), 6U + dim);
+    std::string dst = this->PrintExpr(op->args[1]);
+    std::string dst_offset = this->PrintExpr(op->args[2]);
+    std::string tensor_map = this->PrintExpr(op->args[3]);
+    std::string barrier = this->PrintExpr(op->args[4]) + " + " + this->PrintExpr(op->args[5]);
+    std::vector<std::string> coords;
+    for (int i = 0; i < dim; ++i) {
+      coords.push_back(this->PrintExpr(op->args[6 + i]));
+    }
+    this->stream << PrintCpAsyncBulkTensorAsm(dim, dst, dst_offset, tensor_map, barrier, coords);
+  } else if (op->op.same_as(builtin::ptx_cluster_sync())) {
+    this->stream << "asm volatile(\"barrier.cluster.arrive.aligned;\\n\"\n"
+                 << "             \"barrier.cluster.wait.aligned;\" ::: \"memory\");\n";
+  } else if (op->op.same_as(builtin::ptx_ld_shared_cluster())) {
+    need_cluster_ld_ = true;
+    os << "tvm_ld_shared_cluster(" << this->PrintExpr(op->args[0]) << " + "
+       << this->PrintExpr(op->args[1]) << ", " << this->PrintExpr(op->args[2]) << ")";
+  } else if (op->op.same_as(builtin::ptx_wgmma_ss())) {
+    // arg 0: shape: m64nNkK
+    // arg 1: A precision: fp16, bf16, tf32, int8, uint8
+    // arg 2: B precision: fp16, bf16, tf32, int8, uint8
+    // arg 3: C precision: fp32, fp16, int32
+    // arg 4-5: A multiplicand in shared memory
+    // arg 6-7: B multiplicand in shared memory
+    // arg 8-9: C accumulator
+    // arg 10: the swizzle of A and B in bytes
+    // arg 11: whether to add the result to the accumulator
+    ICHECK_EQ(op->args.size(), 12U);
+    need_wgmma_desc_ = true;
+    std::string shape = Downcast<StringImm>(op->args[0])->value;
+    std::string A_dtype = Downcast<StringImm>(op->args[1])->value;
+    std::string B_dtype = Downcast<StringImm>(op->args[2])->value;
+    std::string C_dtype = Downcast<StringImm>(op->args[3])->value;
+    int swizzle = Downcast<IntImm>(op->args[10])->value;
+    ICHECK(swizzle == 0 || swizzle == 32 || swizzle == 64 || swizzle == 128)
+        << "The swizzle of wgmma must be 0, 32, 64 or 128 bytes, but got " << swizzle;
+    auto f_desc = [&](int i) {
+      return "tvm_make_wgmma_desc(" + this->PrintExpr(op->args[i]) + " + " +
+             this->PrintExpr(op->args[i + 1]) + ", " + std::to_string(swizzle) + ")";
+    };
+    this->stream << PrintWGMMAAssembly(shape, A_dtype, B_dtype, C_dtype, f_desc(4), f_desc(6),
+                                       this->PrintExpr(op->args[8]), this->PrintExpr(op->args[9]),
+                                       this->PrintExpr(op->args[11]));
+  } else if (op->op.same_as(builtin::ptx_wgmma_fence())) {
+    this->stream << "__asm__ __volatile__(\"wgmma.fence.sync.aligned;\" ::: \"memory\");\n\n";
+  } else if (op->op.same_as(builtin::ptx_wgmma_commit_group())) {
+    this->stream << "__asm__ __volatile__(\"wgmma.commit_group.sync.aligned;\");\n\n";
+  } else if (op->op.same_as(builtin::ptx_wgmma_wait_group())) {
+    int n = Downcast<IntImm>(op->args[0])->value;
+    this->stream << "__asm__ __volatile__(\"wgmma.wait_group.sync.aligned " << n
+                 << ";\" ::: \"memory\");\n\n";
   } else if (op->op.same_as(builtin::ptx_ldg32())) {
     /*
     asm volatile (
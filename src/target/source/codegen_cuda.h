@@ -104,6 +104,10 @@ class CodeGenCUDA final : public CodeGenC {
   bool need_math_constants_h_{false};
   // whether need mma.h
   bool need_mma_h_{false};
+  // whether need the helper that builds the shared memory matrix descriptors of wgmma
+  bool need_wgmma_desc_{false};
+  // whether need the helper that loads from the shared memory of another block of the cluster
+  bool need_cluster_ld_{false};
   // Op attribute map
   OpAttrMap<bool> op_need_warp_shuffle_ = Op::GetAttrMap<bool>("cuda.need_warp_shuffle");
 
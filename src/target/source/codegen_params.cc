@@ -24,7 +24,9 @@
 #include "codegen_params.h"
 
 #include <dlpack/dlpack.h>
+#include <tvm/ir/transform.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <memory>
@@ -33,6 +35,8 @@
 namespace tvm {
 namespace codegen {
 
+TVM_REGISTER_PASS_CONFIG_OPTION(kLinkParamsAsBlob, Bool);
+
 /*! \brief maximum line length of generated parameters, including indent. */
 static constexpr const int kMaxLineLength = 80;
 
@@ -247,5 +251,32 @@ void NDArrayDataToC(::tvm::runtime::NDArray arr, int indent_chars, std::ostream&
   os.flags(old_fmtflags);
 }
 
+void NDArrayDataToAsm(::tvm::runtime::NDArray arr, const std::string& symbol,
+                      const std::string& section, int alignment, std::ostream& os) {
+  CHECK(arr.IsContiguous()) << "CodegenParams: only support contiguous arrays";
+  CHECK_EQ(arr->device.device_type, kDLCPU) << "CodegenParams: only support CPU arrays";
+  const uint8_t* data = static_cast<const uint8_t*>(arr->data) + arr->byte_offset;
+  size_t num_bytes = runtime::GetDataSize(*arr.operator->());
+  // The number of values of one .byte directive.
+  constexpr size_t kBytesPerRow = 32;
+  auto old_fmtflags = os.flags();
+  os.setf(std::ios::dec, std::ios::basefield);
+  os << "__asm__(\n"
+     << "    \".pushsection " << section << ", \\\"a\\\"\\n\"\n"
+     << "    \".balign " << alignment << "\\n\"\n"
+     << "    \".type " << symbol << ", %object\\n\"\n"
+     << "    \".size " << symbol << ", " << num_bytes << "\\n\"\n"
+     << "    \"" << symbol << ":\\n\"\n";
+  for (size_t i = 0; i < num_bytes; i += kBytesPerRow) {
+    os << "    \".byte ";
+    for (size_t j = i; j < std::min(num_bytes, i + kBytesPerRow); ++j) {
+      os << (j == i ? "" : ",") << static_cast<int>(data[j]);
+    }
+    os << "\\n\"\n";
+  }
+  os << "    \".popsection\\n\");\n";
+  os.flags(old_fmtflags);
+}
+
 }  // namespace codegen
 }  // namespace tvm
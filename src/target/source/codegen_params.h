@@ -48,6 +48,29 @@ namespace codegen {
 void NDArrayDataToC(::tvm::runtime::NDArray arr, int indent_chars, std::ostream& os,
                     const std::string& eol = "\n");
 
+/*!
+ * \brief The PassContext option to emit linked constants as binary blobs.
+ *
+ * The constants are then placed in their section by assembler directives of one byte per value,
+ * rather than through initializer lists that the C compiler has to type check element by element.
+ */
+constexpr const char* kLinkParamsAsBlob = "codegen.link_params_as_blob";
+
+/*!
+ * \brief Write a top level asm statement defining symbol as the raw bytes of arr.
+ *
+ * The bytes are emitted in the byte order of the host, and the symbol is local to the translation
+ * unit and needs an extern declaration to be referenced from C. Only ELF targets are supported.
+ *
+ * \param arr The array to generate
+ * \param symbol The name of the symbol holding the data.
+ * \param section The section the data is placed in.
+ * \param alignment The alignment of the data in bytes.
+ * \param os Output stream where the asm statement should be written.
+ */
+void NDArrayDataToAsm(::tvm::runtime::NDArray arr, const std::string& symbol,
+                      const std::string& section, int alignment, std::ostream& os);
+
 }  // namespace codegen
 }  // namespace tvm
 
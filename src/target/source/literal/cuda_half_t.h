@@ -376,4 +376,34 @@ static constexpr const char* _cuda_warp_intrinsic_util = R"(
 
 )";
 
+// The shared memory matrix descriptor of a k-major wgmma multiplicand. The multiplicands span
+// 32 bytes of the reduction dimension, so the core matrices of 8 rows are 8 * max(swizzle, 32)
+// bytes apart, and the two core matrices along the reduction dimension of an unswizzled
+// operand are 128 bytes apart.
+static constexpr const char* _cuda_wgmma_desc_def = R"(
+__forceinline__ __device__ unsigned long long tvm_make_wgmma_desc(const void* smem_ptr,
+                                                                  int swizzle_bytes) {
+  unsigned long long addr = static_cast<unsigned long long>(__cvta_generic_to_shared(smem_ptr));
+  unsigned long long leading_byte_offset = swizzle_bytes == 0 ? 128 : 16;
+  unsigned long long stride_byte_offset = 8 * (swizzle_bytes == 0 ? 32 : swizzle_bytes);
+  unsigned long long layout =
+      swizzle_bytes == 128 ? 1 : (swizzle_bytes == 64 ? 2 : (swizzle_bytes == 32 ? 3 : 0));
+  return ((addr & 0x3FFFF) >> 4) | (((leading_byte_offset & 0x3FFFF) >> 4) << 16) |
+         (((stride_byte_offset & 0x3FFFF) >> 4) << 32) | (layout << 62);
+}
+
+)";
+
+// Loads an element of the shared memory of the block of the given rank in the cluster, at the
+// address of ptr in the shared memory of the current block.
+static constexpr const char* _cuda_cluster_ld_def = R"(
+template <typename T>
+__forceinline__ __device__ T tvm_ld_shared_cluster(const T* ptr, unsigned rank) {
+  unsigned long long remote;
+  asm volatile("mapa.u64 %0, %1, %2;" : "=l"(remote) : "l"(ptr), "r"(rank));
+  return *reinterpret_cast<const volatile T*>(remote);
+}
+
+)";
+
 #endif  // TVM_TARGET_SOURCE_LITERAL_CUDA_HALF_T_H_
@@ -65,13 +65,16 @@ enum class DataType : int {
   kBit16 = 18,
   kBit32 = 19,
   kBit64 = 20,
+  kFloat8E4M3 = 21,
+  kFloat8E5M2 = 22,
 };
 
-static const char* dtype_str[] = {".s4",   ".u4",  ".s8",  ".u8",  ".s16",  ".u16",   ".s32",
-                                  ".u32",  ".s64", ".u64", ".f16", ".bf16", ".f16x2", ".f32",
-                                  ".tf32", ".f64", ".b1",  ".b8",  ".b16",  ".b32",   ".b64"};
-static const uint32_t num_bits[] = {4,  4,  8,  8,  16, 16, 32, 32, 64, 64, 16,
-                                    16, 32, 32, 32, 64, 1,  8,  16, 32, 64};
+static const char* dtype_str[] = {".s4",   ".u4",   ".s8",   ".u8",  ".s16",  ".u16",
+                                  ".s32",  ".u32",  ".s64",  ".u64", ".f16",  ".bf16",
+                                  ".f16x2", ".f32", ".tf32", ".f64", ".b1",   ".b8",
+                                  ".b16",  ".b32",  ".b64",  ".e4m3", ".e5m2"};
+static const uint32_t num_bits[] = {4,  4,  8,  8,  16, 16, 32, 32, 64, 64, 16, 16,
+                                    32, 32, 32, 64, 1,  8,  16, 32, 64, 8,  8};
 
 /*!
  * \brief Create PTX data type from string.
@@ -119,6 +122,10 @@ inline DataType DTypeFromString(const std::string str) {
     return DataType::kBit32;
   } else if (str == ".b64") {
     return DataType::kBit64;
+  } else if (str == "e4m3_float8" || str == ".e4m3") {
+    return DataType::kFloat8E4M3;
+  } else if (str == "e5m2_float8" || str == ".e5m2") {
+    return DataType::kFloat8E5M2;
   } else {
     LOG(FATAL) << "Unrecognized PTX data type " << str;
   }
@@ -218,6 +225,8 @@ const MMAConfig valid_mma_configs[] = {
     MMAConfig(8, 8, 128, DataType::kBit1, true, false),
     MMAConfig(16, 8, 128, DataType::kBit1, true, false),
     MMAConfig(16, 8, 256, DataType::kBit1, true, false),
+    MMAConfig(16, 8, 32, DataType::kFloat8E4M3, false, false),
+    MMAConfig(16, 8, 32, DataType::kFloat8E5M2, false, false),
     MMAConfig(16, 8, 16, DataType::kFloat16, false, true),
     MMAConfig(16, 8, 32, DataType::kFloat16, false, true),
     MMAConfig(16, 8, 16, DataType::kBFloat16, false, true),
@@ -263,6 +272,11 @@ void CheckMMADTypeCompatible(DataType dtype_a, DataType dtype_b, DataType dtype_
     case DataType::kUInt8:
       CHECK(dtype_b == DataType::kInt8 || dtype_b == DataType::kUInt8) << ab_not_match_err_str;
       break;
+    case DataType::kFloat8E4M3:
+    case DataType::kFloat8E5M2:
+      CHECK(dtype_b == DataType::kFloat8E4M3 || dtype_b == DataType::kFloat8E5M2)
+          << ab_not_match_err_str;
+      break;
     default:
       CHECK(false) << "Invalid multiplicand data types: " << DTypeToString(dtype_a)
                    << DTypeToString(dtype_b);
@@ -287,6 +301,11 @@ void CheckMMADTypeCompatible(DataType dtype_a, DataType dtype_b, DataType dtype_
       CHECK(dtype_c == DataType::kFloat32)
           << "For multiplicand data type bf16/tf32, accumulator data type can only be f32.";
       break;
+    case DataType::kFloat8E4M3:
+    case DataType::kFloat8E5M2:
+      CHECK(dtype_c == DataType::kFloat32)
+          << "For multiplicand data type e4m3/e5m2, accumulator data type can only be f32.";
+      break;
     case DataType::kFloat64:
       CHECK(dtype_c == DataType::kFloat64)
           << "For multiplicand data type f64, accumulator data type can only be f64.";
@@ -375,6 +394,8 @@ inline FragAttrs GetFragAttrs(DataType dtype) {
     case DataType::kFloat16:  // .f16x2 register
     case DataType::kBFloat16:
     case DataType::kTensorFloat32:
+    case DataType::kFloat8E4M3:
+    case DataType::kFloat8E5M2:
       return FragAttrs('r', 32, "(unsigned *)");
     case DataType::kInt32:
       return FragAttrs('r', 32, "(int *)");
@@ -724,5 +745,210 @@ std::string PrintPredicatedCpAsyncAssembly(const std::string& shared_ptr,
   return predicated_asm_code;
 }
 
+/*!
+ * \brief Print the conversion of a generic pointer into a 32 bit shared memory address.
+ */
+inline std::string PrintSharedAddr(const std::string& name, const std::string& ptr) {
+  return "    unsigned int " + name + ";\n" +
+         "    __asm__ __volatile__(\n"
+         "      \"{ .reg .u64 addr; cvta.to.shared.u64 addr, %1; cvt.u32.u64 %0, addr; }\"\n"
+         "      : \"=r\"(" +
+         name + ")\n" + "      : \"l\"((void *)(" + ptr + "))\n" + "    );\n";
+}
+
+std::string PrintInitBarrierThreadCountAsm(const std::string& barrier,
+                                           const std::string& thread_count) {
+  std::string asm_code = R"(
+  {
+{barrier_addr}    __asm__ __volatile__(
+      "mbarrier.init.shared.b64 [%0], %1;"
+      :: "r"(barrier_addr), "r"((int)({thread_count}))
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{barrier_addr}", PrintSharedAddr("barrier_addr", barrier));
+  replacer.register_rule("{thread_count}", thread_count);
+  return replacer.rewrite(asm_code);
+}
+
+std::string PrintArriveBarrierAsm(const std::string& barrier) {
+  std::string asm_code = R"(
+  {
+{barrier_addr}    __asm__ __volatile__(
+      "{ .reg .b64 state; mbarrier.arrive.shared.b64 state, [%0]; }"
+      :: "r"(barrier_addr)
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{barrier_addr}", PrintSharedAddr("barrier_addr", barrier));
+  return replacer.rewrite(asm_code);
+}
+
+std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
+                                          const std::string& byte_count) {
+  std::string asm_code = R"(
+  {
+{barrier_addr}    __asm__ __volatile__(
+      "{ .reg .b64 state; mbarrier.arrive.expect_tx.shared.b64 state, [%0], %1; }"
+      :: "r"(barrier_addr), "r"((int)({byte_count}))
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{barrier_addr}", PrintSharedAddr("barrier_addr", barrier));
+  replacer.register_rule("{byte_count}", byte_count);
+  return replacer.rewrite(asm_code);
+}
+
+std::string PrintWaitBarrierAsm(const std::string& barrier, const std::string& phase) {
+  std::string asm_code = R"(
+  {
+{barrier_addr}    __asm__ __volatile__(
+      "{\n"
+      ".reg .pred p;\n"
+      "WAIT:\n"
+      "mbarrier.try_wait.parity.shared.b64 p, [%0], %1;\n"
+      "@!p bra WAIT;\n"
+      "}\n"
+      :: "r"(barrier_addr), "r"((int)({phase}))
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{barrier_addr}", PrintSharedAddr("barrier_addr", barrier));
+  replacer.register_rule("{phase}", phase);
+  return replacer.rewrite(asm_code);
+}
+
+std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
+                                const std::string& shared_elem_offset,
+                                const std::string& global_ptr,
+                                const std::string& global_elem_offset, const std::string& bytes,
+                                const std::string& barrier) {
+  std::string asm_code = R"(
+  {
+{smem_addr}{barrier_addr}    __asm__ __volatile__(
+      "cp.async.bulk.shared::cluster.global.mbarrier::complete_tx::bytes [%0], [%1], %2, [%3];"
+      :: "r"(smem_addr), "l"((void*)({global_ptr})), "r"((int)({bytes})), "r"(barrier_addr)
+      : "memory"
+    );
+  }
+)";
+  Replacer replacer;
+  replacer.register_rule("{smem_addr}",
+                         PrintSharedAddr("smem_addr", shared_ptr + " + " + shared_elem_offset));
+  replacer.register_rule("{barrier_addr}", PrintSharedAddr("barrier_addr", barrier));
+  replacer.register_rule("{global_ptr}", global_ptr + " + " + global_elem_offset);
+  replacer.register_rule("{bytes}", bytes);
+  return replacer.rewrite(asm_code);
+}
+
+std::string PrintCpAsyncBulkTensorAsm(int dim, const std::string& shared_ptr,
+                                      const std::string& shared_elem_offset,
+                                      const std::string& tensor_map, const std::string& barrier,
+                                      const std::vector<std::string>& coords) {
+  CHECK(dim >= 1 && dim <= 5) << "cp.async.bulk.tensor only supports 1 to 5 dimensions";
+  CHECK_EQ(coords.size(), static_cast<size_t>(dim))
+      << "cp.async.bulk.tensor expects one coordinate per dimension";
+  std::string asm_code = R"(
+  {
+{smem_addr}{barrier_addr}    __asm__ __volatile__(
+      "cp.async.bulk.tensor.{dim}d.shared::cluster.global.tile.mbarrier::complete_tx::bytes"
+      " [%0], [%1, {{templates}}], [%2];"
+      :: "r"(smem_addr), "l"((const void*)({tensor_map})), "r"(barrier_addr), {inputs}
+      : "memory"
+    );
+  }
+)";
+  std::stringstream templates, inputs;
+  for (int i = 0; i < dim; ++i) {
+    templates << (i == 0 ? "" : ", ") << "%" << i + 3;
+    inputs << (i == 0 ? "" : ", ") << "\"r\"((int)(" << coords[i] << "))";
+  }
+  Replacer replacer;
+  replacer.register_rule("{smem_addr}",
+                         PrintSharedAddr("smem_addr", shared_ptr + " + " + shared_elem_offset));
+  replacer.register_rule("{barrier_addr}", PrintSharedAddr("barrier_addr", barrier));
+  replacer.register_rule("{dim}", std::to_string(dim));
+  replacer.register_rule("{tensor_map}", tensor_map);
+  replacer.register_rule("{templates}", templates.str());
+  replacer.register_rule("{inputs}", inputs.str());
+  return replacer.rewrite(asm_code);
+}
+
+std::string PrintWGMMAAssembly(const std::string& shape, const std::string& A_dtype,
+                               const std::string& B_dtype, const std::string& C_dtype,
+                               const std::string& a_desc, const std::string& b_desc,
+                               const std::string& c_ptr, const std::string& c_elem_offset,
+                               const std::string& scale_out) {
+  ptx::DataType dtype_a = ptx::DTypeFromString(A_dtype), dtype_b = ptx::DTypeFromString(B_dtype),
+                dtype_c = ptx::DTypeFromString(C_dtype);
+  auto [m, n, k] = ptx::ParseMMAShape(shape);
+  CHECK_EQ(m, 64) << "wgmma only supports m64, but got " << shape;
+  CHECK(n >= 8 && n <= 256 && n % 8 == 0) << "Invalid n of wgmma " << shape;
+  CHECK(dtype_a == dtype_b) << "The multiplicands of wgmma must have the same data type";
+  // The multiplicands of wgmma always span 32 bytes of the reduction dimension.
+  CHECK_EQ(k * ptx::DTypeBits(dtype_a), 256U)
+      << "Invalid k of wgmma " << shape << " for data type " << A_dtype;
+  bool is_int = false;
+  if (dtype_a == ptx::DataType::kFloat16) {
+    CHECK(dtype_c == ptx::DataType::kFloat16 || dtype_c == ptx::DataType::kFloat32);
+  } else if (dtype_a == ptx::DataType::kBFloat16 || dtype_a == ptx::DataType::kTensorFloat32) {
+    CHECK(dtype_c == ptx::DataType::kFloat32);
+  } else if (dtype_a == ptx::DataType::kInt8 || dtype_a == ptx::DataType::kUInt8) {
+    CHECK(dtype_c == ptx::DataType::kInt32);
+    CHECK(n <= 24 || n % 16 == 0) << "Invalid n of integer wgmma " << shape;
+    is_int = true;
+  } else {
+    LOG(FATAL) << "Unsupported data type of wgmma " << A_dtype;
+  }
+  std::string asm_code = R"(
+  {
+    __asm__ __volatile__(
+      "{\n"
+      ".reg .pred p;\n"
+      "setp.ne.b32 p, %{scale_id}, 0;\n"
+      "wgmma.mma_async.sync.aligned{.shape}{.dtype}{.atype}{.btype} "
+      "{{templates}}, %{a_id}, %{b_id}, p{imm};\n"
+      "}\n"
+      : {outputs}
+      : "l"((uint64_t)({a_desc})), "l"((uint64_t)({b_desc})), "r"((int)({scale_out})));
+  }
+)";
+  // Every thread holds n / 2 elements of the 32 bit accumulators and n / 4 registers of the
+  // packed half accumulators.
+  int num_regs = dtype_c == ptx::DataType::kFloat16 ? n / 4 : n / 2;
+  std::string reg_type = dtype_c == ptx::DataType::kFloat32 ? "float" : "unsigned";
+  std::string constraint = dtype_c == ptx::DataType::kFloat32 ? "\"+f\"" : "\"+r\"";
+  std::stringstream templates, outputs;
+  for (int i = 0; i < num_regs; ++i) {
+    templates << (i == 0 ? "" : ", ") << "%" << i;
+    outputs << (i == 0 ? "" : ", ") << constraint << "(((" << reg_type << "*)(" << c_ptr << " + "
+            << c_elem_offset << "))[" << i << "])";
+  }
+  // The immediate scales of A and B, and the transposes of half precision multiplicands.
+  std::string imm = is_int ? "" : ", 1, 1";
+  if (dtype_a == ptx::DataType::kFloat16 || dtype_a == ptx::DataType::kBFloat16) {
+    imm += ", 0, 0";
+  }
+  Replacer replacer;
+  replacer.register_rule("{.shape}", "." + shape);
+  replacer.register_rule("{.dtype}", ptx::DTypeToString(dtype_c));
+  replacer.register_rule("{.atype}", ptx::DTypeToString(dtype_a));
+  replacer.register_rule("{.btype}", ptx::DTypeToString(dtype_b));
+  replacer.register_rule("{templates}", templates.str());
+  replacer.register_rule("{outputs}", outputs.str());
+  replacer.register_rule("{imm}", imm);
+  replacer.register_rule("{a_id}", std::to_string(num_regs));
+  replacer.register_rule("{b_id}", std::to_string(num_regs + 1));
+  replacer.register_rule("{scale_id}", std::to_string(num_regs + 2));
+  replacer.register_rule("{a_desc}", a_desc);
+  replacer.register_rule("{b_desc}", b_desc);
+  replacer.register_rule("{scale_out}", scale_out);
+  return replacer.rewrite(asm_code);
+}
+
 }  // namespace codegen
 }  // namespace tvm
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace tvm {
 namespace codegen {
@@ -108,6 +109,82 @@ std::string PrintPredicatedCpAsyncAssembly(const std::string& shared_ptr,
                                            const std::string& bytes,
                                            const std::string& predicate_value);
 
+/*!
+ * \brief Print ptx mbarrier initialization assembly string given parameters.
+ * \param barrier: The pointer to the mbarrier in shared memory.
+ * \param thread_count: The number of threads expected to arrive at the barrier.
+ */
+std::string PrintInitBarrierThreadCountAsm(const std::string& barrier,
+                                           const std::string& thread_count);
+
+/*!
+ * \brief Print ptx mbarrier arrive assembly string given parameters.
+ * \param barrier: The pointer to the mbarrier in shared memory.
+ */
+std::string PrintArriveBarrierAsm(const std::string& barrier);
+
+/*!
+ * \brief Print ptx mbarrier arrive with expected transaction bytes assembly string.
+ * \param barrier: The pointer to the mbarrier in shared memory.
+ * \param byte_count: The number of bytes the asynchronous copies will complete on the barrier.
+ */
+std::string PrintArriveBarrierExpectTxAsm(const std::string& barrier,
+                                          const std::string& byte_count);
+
+/*!
+ * \brief Print ptx mbarrier wait assembly string given parameters.
+ * \param barrier: The pointer to the mbarrier in shared memory.
+ * \param phase: The parity of the phase to wait for.
+ */
+std::string PrintWaitBarrierAsm(const std::string& barrier, const std::string& phase);
+
+/*!
+ * \brief Print ptx cp.async.bulk assembly string given parameters.
+ * \param shared_ptr: The pointer to the destination shared memory.
+ * \param shared_elem_offset: The offset into the shared memory.
+ * \param global_ptr: The pointer to the global memory.
+ * \param global_elem_offset: The offset into the global memory.
+ * \param bytes: The number of bytes to copy, a multiple of 16.
+ * \param barrier: The pointer to the mbarrier the completion is signaled on.
+ */
+std::string PrintCpAsyncBulkAsm(const std::string& shared_ptr,
+                                const std::string& shared_elem_offset,
+                                const std::string& global_ptr,
+                                const std::string& global_elem_offset, const std::string& bytes,
+                                const std::string& barrier);
+
+/*!
+ * \brief Print ptx cp.async.bulk.tensor assembly string given parameters.
+ * \param dim: The number of dimensions of the tensor, from 1 to 5.
+ * \param shared_ptr: The pointer to the destination shared memory.
+ * \param shared_elem_offset: The offset into the shared memory.
+ * \param tensor_map: The pointer to the CUtensorMap of the tensor.
+ * \param barrier: The pointer to the mbarrier the completion is signaled on.
+ * \param coords: The coordinates of the tile in the tensor, innermost dimension first.
+ */
+std::string PrintCpAsyncBulkTensorAsm(int dim, const std::string& shared_ptr,
+                                      const std::string& shared_elem_offset,
+                                      const std::string& tensor_map, const std::string& barrier,
+                                      const std::vector<std::string>& coords);
+
+/*!
+ * \brief Print wgmma assembly string given parameters.
+ * \param shape The shape string m64nNkK.
+ * \param A_dtype The data type of multiplicand A.
+ * \param B_dtype The data type of multiplicand B.
+ * \param C_dtype The data type of the accumulator.
+ * \param a_desc The shared memory matrix descriptor of A.
+ * \param b_desc The shared memory matrix descriptor of B.
+ * \param c_ptr Pointer to the accumulator registers.
+ * \param c_elem_offset The offset of element in the accumulator.
+ * \param scale_out Whether the result is added to the accumulator.
+ */
+std::string PrintWGMMAAssembly(const std::string& shape, const std::string& A_dtype,
+                               const std::string& B_dtype, const std::string& C_dtype,
+                               const std::string& a_desc, const std::string& b_desc,
+                               const std::string& c_ptr, const std::string& c_elem_offset,
+                               const std::string& scale_out);
+
 }  // namespace codegen
 }  // namespace tvm
 
@@ -60,7 +60,12 @@ void IRBuilder::InitHeader() {
   }
 #endif
 
-  if (spirv_support_.supports_cooperative_matrix) {
+  if (UseCooperativeMatrixKHR()) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+    capabilities_used_.insert(spv::CapabilityCooperativeMatrixKHR);
+    extensions_used_.insert("SPV_KHR_cooperative_matrix");
+#endif
+  } else if (spirv_support_.supports_cooperative_matrix) {
     capabilities_used_.insert(spv::CapabilityCooperativeMatrixNV);
     extensions_used_.insert("SPV_NV_cooperative_matrix");
   }
@@ -112,7 +117,7 @@ std::vector<uint32_t> IRBuilder::Finalize() {
   return data;
 }
 
-SType IRBuilder::GetSType(const DataType& dtype, uint32_t row, uint32_t col) {
+SType IRBuilder::GetSType(const DataType& dtype, uint32_t row, uint32_t col, uint32_t use) {
   if (dtype == DataType::Int(32)) {
     return t_int32_;
   } else if (dtype == DataType::UInt(1)) {
@@ -131,13 +136,19 @@ SType IRBuilder::GetSType(const DataType& dtype, uint32_t row, uint32_t col) {
   } else {
     type_key |= static_cast<uint64_t>(row) << 32U;
     type_key |= static_cast<uint64_t>(col) << 40U;
+    // The NV matrix types do not depend on the use, and must not be declared twice.
+    if (UseCooperativeMatrixKHR()) {
+      type_key |= static_cast<uint64_t>(use) << 48U;
+    } else {
+      use = 0;
+    }
   }
 
   auto it = pod_type_tbl_.find(type_key);
   if (it != pod_type_tbl_.end()) {
     return it->second;
   }
-  SType t = DeclareType(dtype, row, col);
+  SType t = DeclareType(dtype, row, col, use);
   pod_type_tbl_[type_key] = t;
   return t;
 }
@@ -494,7 +505,7 @@ Value IRBuilder::GetConst_(const SType& dtype, const uint64_t* pvalue) {
   return ret;
 }
 
-SType IRBuilder::DeclareType(const DataType& dtype, uint32_t row, uint32_t col) {
+SType IRBuilder::DeclareType(const DataType& dtype, uint32_t row, uint32_t col, uint32_t use) {
   AddCapabilityFor(dtype);
 
   if (dtype.lanes() == 1) {
@@ -524,9 +535,24 @@ SType IRBuilder::DeclareType(const DataType& dtype, uint32_t row, uint32_t col)
       ICHECK((row == 0) && (col == 0));
       ib_.Begin(spv::OpTypeVector).AddSeq(t, base_type, dtype.lanes()).Commit(&global_);
     } else {
+      ICHECK(UseCooperativeMatrixKHR() || spirv_support_.supports_cooperative_matrix)
+          << "Vulkan target does not support cooperative matrices.  "
+          << "If your device supports VK_NV_cooperative_matrix or VK_KHR_cooperative_matrix, "
+          << "please either add -supports_cooperative_matrix=1 or "
+          << "-supports_cooperative_matrix_khr=1 to the target, "
+          << "or query all device parameters by adding -from_device=0.";
       Value v_row = GetSpecConst(GetSType(DataType::UInt(32)), row);
       Value v_col = GetSpecConst(GetSType(DataType::UInt(32)), col);
       Value scope = UIntImm(GetSType(DataType::UInt(32)), spv::ScopeSubgroup);
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+      if (UseCooperativeMatrixKHR()) {
+        Value v_use = UIntImm(GetSType(DataType::UInt(32)), use);
+        ib_.Begin(spv::OpTypeCooperativeMatrixKHR)
+            .AddSeq(t, base_type, scope, v_row, v_col, v_use)
+            .Commit(&global_);
+        return t;
+      }
+#endif
       ib_.Begin(spv::OpTypeCooperativeMatrixNV)
           .AddSeq(t, base_type, scope, v_row, v_col)
           .Commit(&global_);
@@ -772,6 +798,64 @@ Value IRBuilder::GetCompositeConst(const SType& ele_stype, const SType& composit
   return new_val;
 }
 
+bool IRBuilder::UseCooperativeMatrixKHR() const {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+  return spirv_support_.supports_cooperative_matrix_khr;
+#else
+  return false;
+#endif
+}
+
+Value IRBuilder::CooperativeMatrixLoad(const SType& matrix_type, Value ptr, Value stride,
+                                       bool column_major) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+  if (UseCooperativeMatrixKHR()) {
+    Value layout = UIntImm(GetSType(DataType::UInt(32)),
+                           column_major ? spv::CooperativeMatrixLayoutColumnMajorKHR
+                                        : spv::CooperativeMatrixLayoutRowMajorKHR);
+    return MakeValue(spv::OpCooperativeMatrixLoadKHR, matrix_type, ptr, layout, stride);
+  }
+#endif
+  return MakeValue(spv::OpCooperativeMatrixLoadNV, matrix_type, ptr, stride,
+                   UIntImm(t_bool_, column_major));
+}
+
+void IRBuilder::CooperativeMatrixStore(Value ptr, Value matrix, Value stride, bool column_major) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+  if (UseCooperativeMatrixKHR()) {
+    Value layout = UIntImm(GetSType(DataType::UInt(32)),
+                           column_major ? spv::CooperativeMatrixLayoutColumnMajorKHR
+                                        : spv::CooperativeMatrixLayoutRowMajorKHR);
+    MakeInst(spv::OpCooperativeMatrixStoreKHR, ptr, matrix, layout, stride);
+    return;
+  }
+#endif
+  MakeInst(spv::OpCooperativeMatrixStoreNV, ptr, matrix, stride, UIntImm(t_bool_, column_major));
+}
+
+Value IRBuilder::CooperativeMatrixMulAdd(const SType& result_type, Value a, Value b, Value c) {
+#ifdef TVM_SPIRV_KHR_COOPERATIVE_MATRIX
+  if (UseCooperativeMatrixKHR()) {
+    // Unlike the NV instruction, the signedness of integer operands is explicit.
+    uint32_t operands = spv::CooperativeMatrixOperandsMaskNone;
+    if (a.stype.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixASignedComponentsKHRMask;
+    }
+    if (b.stype.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixBSignedComponentsKHRMask;
+    }
+    if (c.stype.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixCSignedComponentsKHRMask;
+    }
+    if (result_type.type.is_int()) {
+      operands |= spv::CooperativeMatrixOperandsMatrixResultSignedComponentsKHRMask;
+    }
+    return MakeValue(spv::OpCooperativeMatrixMulAddKHR, result_type, a, b, c, operands);
+  }
+#endif
+  return MakeValue(spv::OpCooperativeMatrixMulAddNV, result_type, a, b, c);
+}
+
 Value IRBuilder::GetSpecConst(const SType& dtype, uint64_t value) {
   ICHECK_LE(dtype.type.bits(), 32);
   Value ret = NewValue(dtype, kSpecConst);
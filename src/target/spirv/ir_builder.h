@@ -442,9 +442,14 @@ class IRBuilder {
   /*!
    * \brief Get the spirv type for a given tvm data type.
    * \param dtype The data type.
+   * \param row The number of rows, if the type is a cooperative matrix.
+   * \param col The number of columns, if the type is a cooperative matrix.
+   * \param use The role of the cooperative matrix in a multiply-add, as a
+   *  spv::CooperativeMatrixUse.  Only distinguishes the KHR matrix types.
    * \return The corresponding spirv type.
    */
-  SType GetSType(const tvm::DataType& dtype, uint32_t row = 0, uint32_t col = 0);
+  SType GetSType(const tvm::DataType& dtype, uint32_t row = 0, uint32_t col = 0,
+                 uint32_t use = 0);
   /*!
    * \brief Get the pointer type that points to value_type
    * \param value_type.
@@ -600,6 +605,33 @@ class IRBuilder {
    * \param dval The initial value for all elements in the composite.
    */
   Value GetCompositeConst(const SType& ele_stype, const SType& composite_stype, double dval);
+  /*!
+   * \return Whether the cooperative matrices are emitted with
+   *  SPV_KHR_cooperative_matrix, rather than SPV_NV_cooperative_matrix.
+   */
+  bool UseCooperativeMatrixKHR() const;
+  /*!
+   * \brief Load a cooperative matrix from memory.
+   * \param matrix_type The cooperative matrix type.
+   * \param ptr The pointer to the first element.
+   * \param stride The number of elements between two rows, or columns if column major.
+   * \param column_major Whether the matrix is stored column major.
+   */
+  Value CooperativeMatrixLoad(const SType& matrix_type, Value ptr, Value stride,
+                              bool column_major);
+  /*!
+   * \brief Store a cooperative matrix to memory.
+   * \param ptr The pointer to the first element.
+   * \param matrix The cooperative matrix.
+   * \param stride The number of elements between two rows, or columns if column major.
+   * \param column_major Whether the matrix is stored column major.
+   */
+  void CooperativeMatrixStore(Value ptr, Value matrix, Value stride, bool column_major);
+  /*!
+   * \brief Compute a * b + c on cooperative matrices.
+   * \param result_type The cooperative matrix type of the result.
+   */
+  Value CooperativeMatrixMulAdd(const SType& result_type, Value a, Value b, Value c);
   /*
    * Get specialization constant
    * \param dtype The content value type
@@ -656,7 +688,7 @@ class IRBuilder {
   Value GetConst_(const SType& dtype, const uint64_t* pvalue);
 
   // declare type
-  SType DeclareType(const DataType& dtype, uint32_t row = 0, uint32_t col = 0);
+  SType DeclareType(const DataType& dtype, uint32_t row = 0, uint32_t col = 0, uint32_t use = 0);
 
   // Declare the appropriate SPIR-V capabilities and extensions to use
   // this data type.
@@ -106,6 +106,10 @@ SPIRVSupport::SPIRVSupport(tvm::Target target) {
   if (target->GetAttr<Bool>("supports_cooperative_matrix")) {
     supports_cooperative_matrix = target->GetAttr<Bool>("supports_cooperative_matrix").value();
   }
+  if (target->GetAttr<Bool>("supports_cooperative_matrix_khr")) {
+    supports_cooperative_matrix_khr =
+        target->GetAttr<Bool>("supports_cooperative_matrix_khr").value();
+  }
 }
 
 }  // namespace codegen
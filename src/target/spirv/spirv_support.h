@@ -290,6 +290,19 @@ struct SPIRVSupport {
    */
 
   bool supports_cooperative_matrix{false};
+
+  /*!
+   * \brief  Whether the driver supports the cross-vendor cooperative matrix.
+   *
+   * Vulkan extension: VK_KHR_cooperative_matrix
+   * SPV Extension name: SPV_KHR_cooperative_matrix
+   * SPV Capability: spv::CapabilityCooperativeMatrixKHR
+   *
+   * If support is present, cooperative matrix operations are emitted
+   * with the KHR instructions, in preference to the NV ones.  Only
+   * used if TVM was built with USE_SPIRV_KHR_COOPERATIVE_MATRIX.
+   */
+  bool supports_cooperative_matrix_khr{false};
 };
 
 }  // namespace codegen
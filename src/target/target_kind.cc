@@ -280,6 +280,9 @@ TVM_REGISTER_TARGET_KIND("llvm", kDLCPU)
     .add_attr_option<String>("mfloat-abi")
     .add_attr_option<String>("mabi")
     .add_attr_option<Integer>("num-cores")
+    // The sizes of the data caches of a core in bytes, used to size the tiles when tuning
+    .add_attr_option<Integer>("l1-cache-size")
+    .add_attr_option<Integer>("l2-cache-size")
     // Fast math flags, see https://llvm.org/docs/LangRef.html#fast-math-flags
     .add_attr_option<Bool>("fast-math")  // implies all the below
     .add_attr_option<Bool>("fast-math-nnan")
@@ -288,6 +291,9 @@ TVM_REGISTER_TARGET_KIND("llvm", kDLCPU)
     .add_attr_option<Bool>("fast-math-arcp")
     .add_attr_option<Bool>("fast-math-contract")
     .add_attr_option<Bool>("fast-math-reassoc")
+    // Vectorized accesses of non-contiguous elements as llvm.masked.gather/scatter: always when
+    // true, never when false, and where the hardware has them (AVX-512, SVE) when unset.
+    .add_attr_option<Bool>("gather-scatter")
     .add_attr_option<Integer>("opt-level")
     // LLVM command line flags, see below
     .add_attr_option<Array<String>>("cl-opt")
@@ -334,6 +340,7 @@ TVM_REGISTER_TARGET_KIND("cuda", kDLCUDA)
     .add_attr_option<Integer>("max_threads_per_block")
     .add_attr_option<Integer>("thread_warp_size", Integer(32))
     .add_attr_option<Integer>("registers_per_block")
+    .add_attr_option<Integer>("multi_processor_count")
     .add_attr_option<Integer>("max_num_threads", Integer(1024))  // TODO(@zxybazh): deprecate it
     .set_default_keys({"cuda", "gpu"})
     .set_target_parser(UpdateCUDAAttrs);
@@ -397,6 +404,7 @@ TVM_REGISTER_TARGET_KIND("vulkan", kDLVulkan)
     .add_attr_option<Bool>("supports_dedicated_allocation")
     .add_attr_option<Bool>("supports_integer_dot_product")
     .add_attr_option<Bool>("supports_cooperative_matrix")
+    .add_attr_option<Bool>("supports_cooperative_matrix_khr")
     .add_attr_option<Integer>("supported_subgroup_operations")
     // Physical device limits
     .add_attr_option<Integer>("max_num_threads", Integer(256))
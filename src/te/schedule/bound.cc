@@ -24,7 +24,9 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/te/operation.h>
 #include <tvm/te/schedule_pass.h>
+#include <tvm/tir/stmt_functor.h>
 
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -49,6 +51,8 @@ struct GraphContext {
   std::unordered_map<IterVar, IterVar> bind_map;
   /*! \brief map from op to stage */
   std::unordered_map<const Object*, Stage> op2stage_;
+  /*! \brief map from the var of each IterVar of the schedule to the IterVar */
+  std::unordered_map<const VarNode*, IterVar> var2iter;
 };
 
 bool NeedRelax(const IterVar& iv, bool found_attach,
@@ -69,6 +73,41 @@ bool NeedRelax(const IterVar& iv, bool found_attach,
   return static_cast<int>(scope.rank) <= ts.rank;
 }
 
+/*!
+ * \brief Bind the inferred ranges a consumer stage can refer to: those of its IterVars, of its
+ *  attach path and of the threads they are bound to, then transitively those of the vars in
+ *  these ranges. Binding every inferred range instead makes each consumer cost as much as the
+ *  whole schedule, quadratic in the number of stages.
+ */
+void BindConsumerRanges(const Stage& stage, const GraphContext& ctx,
+                        const std::unordered_map<IterVar, Range>& rmap,
+                        arith::Analyzer* analyzer) {
+  std::unordered_set<const VarNode*> visited;
+  std::function<void(const VarNode*)> bind_var = [&](const VarNode* var) {
+    if (!visited.insert(var).second) return;
+    auto it = ctx.var2iter.find(var);
+    if (it == ctx.var2iter.end()) return;
+    auto rit = rmap.find(it->second);
+    if (rit == rmap.end()) return;
+    const Range& range = rit->second;
+    // The vars of the range are bound first, so that its bound is known.
+    for (const PrimExpr& e : {range->min, range->extent}) {
+      tir::PostOrderVisit(e, [&](const ObjectRef& node) {
+        if (const auto* v = node.as<VarNode>()) bind_var(v);
+      });
+    }
+    analyzer->Bind(it->second->var, range);
+  };
+  auto bind_iter = [&](const IterVar& iv) {
+    bind_var(iv->var.get());
+    auto it = ctx.bind_map.find(iv);
+    if (it != ctx.bind_map.end()) bind_var(it->second->var.get());
+  };
+  for (const IterVar& iv : stage->all_iter_vars) bind_iter(iv);
+  for (const IterVar& iv : stage->env_threads) bind_iter(iv);
+  for (const IterVar& iv : ctx.attach_path.at(stage->op)) bind_iter(iv);
+}
+
 // infer storage scope, if not given
 StorageScope InferStorageScope(const Stage& stage, const GraphContext& ctx) {
   if (stage->scope.length() != 0) {
@@ -180,9 +219,7 @@ void InferRootBound(const Stage& stage, const GraphContext& ctx,
     // Relax if needed.
     std::unordered_map<const VarNode*, IntSet> dom_map;
     arith::Analyzer analyzer;
-    for (auto entry : *rmap) {
-      analyzer.Bind(entry.first->var, entry.second);
-    }
+    BindConsumerRanges(op_stage, ctx, *rmap, &analyzer);
     for (auto iv : op->root_iter_vars()) {
       Range r;
       if (up_state.count(iv)) {
@@ -220,8 +257,15 @@ Map<IterVar, Range> InferBound(const Schedule& sch) {
       if (kv.second->bind_thread.defined()) {
         ICHECK(!ctx.bind_map.count(kv.first));
         ctx.bind_map[kv.first] = kv.second->bind_thread;
+        ctx.var2iter[kv.second->bind_thread->var.get()] = kv.second->bind_thread;
       }
     }
+    for (IterVar iv : stage->all_iter_vars) {
+      ctx.var2iter[iv->var.get()] = iv;
+    }
+    for (IterVar iv : stage->env_threads) {
+      ctx.var2iter[iv->var.get()] = iv;
+    }
     ctx.op2stage_[stage->op.get()] = stage;
   }
   ctx.attach_path = CreateAttachPath(sch);
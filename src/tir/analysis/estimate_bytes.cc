@@ -0,0 +1,186 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tir/analysis/estimate_bytes.cc
+ * \brief Estimate the bytes moved from and to global memory by a PrimFunc, as the sum of the
+ * sizes of the regions of the global buffers it reads and writes. The regions are relaxed over
+ * the loops, the thread bindings and the block iterators, the same way the block access
+ * regions are.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/int_set.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+
+class GlobalAccessRegionCollector : public StmtExprVisitor {
+ public:
+  /*! \brief Returns the bytes of the regions read and written of the global buffers of func. */
+  static double Collect(const PrimFunc& func) {
+    GlobalAccessRegionCollector collector;
+    collector(func->body);
+    // The views of the same data are not combined, only the largest is counted.
+    std::unordered_map<const VarNode*, double> bytes_per_data;
+    for (const auto* regions : {&collector.read_regions_, &collector.write_regions_}) {
+      std::unordered_map<const VarNode*, double> bytes;
+      for (const auto& kv : *regions) {
+        double& data_bytes = bytes[kv.first->data.get()];
+        data_bytes =
+            std::max(data_bytes, collector.RegionBytes(GetRef<Buffer>(kv.first), kv.second));
+      }
+      for (const auto& kv : bytes) {
+        bytes_per_data[kv.first] += kv.second;
+      }
+    }
+    double total = 0.0;
+    for (const auto& kv : bytes_per_data) {
+      total += kv.second;
+    }
+    return total;
+  }
+
+ private:
+  using Region = std::vector<arith::IntSet>;
+
+  void VisitStmt_(const ForNode* op) final {
+    dom_map_[op->loop_var.get()] =
+        arith::IntSet::FromRange(Range::FromMinExtent(op->min, op->extent));
+    StmtExprVisitor::VisitStmt_(op);
+    dom_map_.erase(op->loop_var.get());
+  }
+
+  void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent || op->attr_key == attr::virtual_thread) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      dom_map_[iv->var.get()] = arith::IntSet::FromRange(
+          Range::FromMinExtent(make_zero(op->value.dtype()), op->value));
+      StmtExprVisitor::VisitStmt_(op);
+      dom_map_.erase(iv->var.get());
+    } else {
+      StmtExprVisitor::VisitStmt_(op);
+    }
+  }
+
+  void VisitStmt_(const BlockRealizeNode* op) final {
+    const BlockNode* block = op->block.get();
+    for (size_t i = 0; i < block->iter_vars.size(); ++i) {
+      dom_map_[block->iter_vars[i]->var.get()] = arith::EvalSet(op->iter_values[i], dom_map_);
+    }
+    StmtExprVisitor::VisitStmt_(op);
+    for (const IterVar& iv : block->iter_vars) {
+      dom_map_.erase(iv->var.get());
+    }
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    Update(&read_regions_, op->buffer, op->indices);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    Update(&write_regions_, op->buffer, op->indices);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void Update(std::unordered_map<const BufferNode*, Region>* regions, const Buffer& buffer,
+              const Array<PrimExpr>& indices) {
+    if (buffer.scope() != "global") {
+      return;
+    }
+    Region region;
+    for (const PrimExpr& index : indices) {
+      region.push_back(arith::EvalSet(index, dom_map_));
+    }
+    auto it = regions->find(buffer.get());
+    if (it == regions->end()) {
+      regions->emplace(buffer.get(), std::move(region));
+      return;
+    }
+    ICHECK_EQ(it->second.size(), region.size());
+    for (size_t i = 0; i < region.size(); ++i) {
+      it->second[i] = arith::Union({it->second[i], region[i]});
+    }
+  }
+
+  double RegionBytes(const Buffer& buffer, const Region& region) {
+    double elems = 1.0;
+    for (size_t i = 0; i < region.size(); ++i) {
+      const auto* shape = buffer->shape.size() == region.size()
+                              ? analyzer_.Simplify(buffer->shape[i]).as<IntImmNode>()
+                              : nullptr;
+      double extent = -1.0;
+      if (region[i].HasLowerBound() && region[i].HasUpperBound()) {
+        PrimExpr diff = analyzer_.Simplify(region[i].max() - region[i].min() + 1);
+        if (const auto* imm = diff.as<IntImmNode>()) {
+          extent = static_cast<double>(imm->value);
+        }
+      }
+      if (shape != nullptr && (extent < 0 || extent > shape->value)) {
+        extent = static_cast<double>(shape->value);
+      }
+      // Regions of unknown size are not counted.
+      if (extent < 0) {
+        return 0.0;
+      }
+      elems *= extent;
+    }
+    return elems * buffer->dtype.bytes() * buffer->dtype.lanes();
+  }
+
+  std::unordered_map<const VarNode*, arith::IntSet> dom_map_;
+  std::unordered_map<const BufferNode*, Region> read_regions_;
+  std::unordered_map<const BufferNode*, Region> write_regions_;
+  arith::Analyzer analyzer_;
+};
+
+double EstimateTIRBytes(const PrimFunc& func) { return GlobalAccessRegionCollector::Collect(func); }
+
+double EstimateTIRBytes(const IRModule& mod) {
+  double result = 0.0;
+  for (const auto& kv : mod->functions) {
+    if (auto func = kv.second.as<PrimFunc>()) {
+      result += EstimateTIRBytes(func.value());
+    }
+  }
+  return result;
+}
+
+TVM_REGISTER_GLOBAL("tir.analysis.EstimateTIRBytes").set_body_typed([](ObjectRef obj) -> double {
+  if (auto mod = obj.as<IRModule>()) {
+    return EstimateTIRBytes(mod.value());
+  } else if (auto func = obj.as<PrimFunc>()) {
+    return EstimateTIRBytes(func.value());
+  } else {
+    LOG(FATAL) << "TypeError: Expect the input to be either IRModule or PrimFunc, but gets: "
+               << obj->GetTypeKey();
+    throw;
+  }
+});
+
+}  // namespace tir
+}  // namespace tvm
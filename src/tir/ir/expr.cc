@@ -21,6 +21,7 @@
  * \file expr.cc
  */
 #include <tvm/runtime/registry.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
@@ -54,7 +55,8 @@ namespace tir {
     CHECK(a.dtype() == b.dtype()) << "TypeError: mismatched types. " << a.dtype() << " vs. " \
                                   << b.dtype() << "\n";                                      \
     ObjectPtr<T> node = make_object<T>();                                                    \
-    node->dtype = DataType::Bool(a.dtype().lanes());                                         \
+    node->dtype = DataType::Bool(a.dtype().get_lanes_or_vscale_factor(),                  \
+                                 a.dtype().is_scalable_vector());                        \
     node->a = std::move(a);                                                                  \
     node->b = std::move(b);                                                                  \
     node->span = std::move(span);                                                            \
@@ -186,7 +188,8 @@ TVM_REGISTER_NODE_TYPE(StringImmNode);
 // Cast
 Cast::Cast(DataType t, PrimExpr value, Span span) {
   ICHECK(value.defined());
-  ICHECK_EQ(t.lanes(), value.dtype().lanes());
+  ICHECK_EQ(t.get_lanes_or_vscale_factor(), value.dtype().get_lanes_or_vscale_factor());
+  ICHECK_EQ(t.is_scalable_vector(), value.dtype().is_scalable_vector());
   ObjectPtr<CastNode> node = make_object<CastNode>();
   node->dtype = t;
   node->value = std::move(value);
@@ -344,7 +347,7 @@ And::And(PrimExpr a, PrimExpr b, Span span) {
   ICHECK(a.dtype() == b.dtype()) << "TypeError: mismatched types";
 
   ObjectPtr<AndNode> node = make_object<AndNode>();
-  node->dtype = DataType::Bool(a.dtype().lanes());
+  node->dtype = a.dtype();
   node->a = std::move(a);
   node->b = std::move(b);
   node->span = std::move(span);
@@ -366,7 +369,7 @@ Or::Or(PrimExpr a, PrimExpr b, Span span) {
   ICHECK(a.dtype() == b.dtype()) << "TypeError: mismatched types";
 
   ObjectPtr<OrNode> node = make_object<OrNode>();
-  node->dtype = DataType::Bool(a.dtype().lanes());
+  node->dtype = a.dtype();
   node->a = std::move(a);
   node->b = std::move(b);
   node->span = std::move(span);
@@ -385,7 +388,7 @@ Not::Not(PrimExpr a, Span span) {
   ICHECK(a.dtype().is_bool());
 
   ObjectPtr<NotNode> node = make_object<NotNode>();
-  node->dtype = DataType::Bool(a.dtype().lanes());
+  node->dtype = a.dtype();
   node->a = std::move(a);
   node->span = std::move(span);
   data_ = std::move(node);
@@ -401,7 +404,10 @@ Select::Select(PrimExpr condition, PrimExpr true_value, PrimExpr false_value, Sp
   ICHECK(true_value.defined()) << "ValueError: true_value is undefined";
   ICHECK(false_value.defined()) << "ValueError: true_value is undefined";
   ICHECK(condition.dtype().is_bool());
-  ICHECK(condition.dtype().lanes() == true_value.dtype().lanes() || condition.dtype().lanes() == 1);
+  ICHECK(condition.dtype().is_scalar() ||
+         (condition.dtype().get_lanes_or_vscale_factor() ==
+              true_value.dtype().get_lanes_or_vscale_factor() &&
+          condition.dtype().is_scalable_vector() == true_value.dtype().is_scalable_vector()));
   ICHECK(false_value.dtype() == true_value.dtype())
       << "TypeError: mismatched types. "
       << "False type: " << false_value.dtype() << "; True type: " << true_value.dtype();
@@ -422,17 +428,31 @@ TVM_REGISTER_GLOBAL("tir.Select")
 
 TVM_REGISTER_NODE_TYPE(SelectNode);
 
+// The type of a vector of lanes elements of dtype, -n lanes are a scalable vector.
+static DataType VectorType(DataType dtype, int lanes) {
+  ICHECK(lanes > 1 || lanes < -1) << "Invalid number of lanes " << lanes;
+  return lanes > 0 ? dtype.with_lanes(lanes) : dtype.with_scalable_vscale_factor(-lanes);
+}
+
+// The lanes of a Ramp or Broadcast from the front end, either a constant or vscale * n.
+static int LanesFromExpr(const PrimExpr& lanes) {
+  Optional<Integer> value = VectorLanesFromExpr(lanes);
+  CHECK(value.defined())
+      << "ValueError: The lanes of a vector must be a constant or vscale * constant, but got "
+      << lanes;
+  return value.value()->value;
+}
+
 // Ramp
 Ramp::Ramp(PrimExpr base, PrimExpr stride, int lanes, Span span) {
   ICHECK(base.defined());
   ICHECK(stride.defined());
   ICHECK(base.dtype().is_scalar());
   ICHECK(stride.dtype().is_scalar());
-  ICHECK_GT(lanes, 1);
   ICHECK_EQ(stride.dtype(), base.dtype());
 
   ObjectPtr<RampNode> node = make_object<RampNode>();
-  node->dtype = base.dtype().with_lanes(lanes);
+  node->dtype = VectorType(base.dtype(), lanes);
   node->base = base;
   node->stride = stride;
   node->lanes = lanes;
@@ -441,8 +461,8 @@ Ramp::Ramp(PrimExpr base, PrimExpr stride, int lanes, Span span) {
 }
 
 TVM_REGISTER_GLOBAL("tir.Ramp")
-    .set_body_typed([](PrimExpr base, PrimExpr stride, int lanes, Span span) {
-      return Ramp(base, stride, lanes, span);
+    .set_body_typed([](PrimExpr base, PrimExpr stride, PrimExpr lanes, Span span) {
+      return Ramp(base, stride, LanesFromExpr(lanes), span);
     });
 
 TVM_REGISTER_NODE_TYPE(RampNode);
@@ -451,19 +471,19 @@ TVM_REGISTER_NODE_TYPE(RampNode);
 Broadcast::Broadcast(PrimExpr value, int lanes, Span span) {
   ICHECK(value.defined());
   ICHECK(value.dtype().is_scalar());
-  ICHECK_GT(lanes, 1);
 
   ObjectPtr<BroadcastNode> node = make_object<BroadcastNode>();
-  node->dtype = value.dtype().with_lanes(lanes);
+  node->dtype = VectorType(value.dtype(), lanes);
   node->value = std::move(value);
   node->lanes = lanes;
   node->span = std::move(span);
   data_ = node;
 }
 
-TVM_REGISTER_GLOBAL("tir.Broadcast").set_body_typed([](PrimExpr value, int lanes, Span span) {
-  return Broadcast(value, lanes, span);
-});
+TVM_REGISTER_GLOBAL("tir.Broadcast")
+    .set_body_typed([](PrimExpr value, PrimExpr lanes, Span span) {
+      return Broadcast(value, LanesFromExpr(lanes), span);
+    });
 
 TVM_REGISTER_NODE_TYPE(BroadcastNode);
 
@@ -708,13 +728,23 @@ void BufferLoadNode::LegalizeDType() {
         << "Only the last index of a buffer access may be a vector type.";
   }
 
-  int index_lanes = indices.size() ? indices.back().dtype().lanes() : 1;
+  DataType index_dtype = indices.size() ? indices.back().dtype() : DataType::Int(32);
+  if (index_dtype.is_scalable_vector()) {
+    ICHECK(buffer->dtype.is_scalar())
+        << "A scalable vector index can only access a buffer of scalars, but buffer "
+        << buffer->name << " has type " << buffer->dtype;
+    this->dtype = buffer->dtype.with_scalable_vscale_factor(index_dtype.vscale_factor());
+    return;
+  }
+
+  int index_lanes = index_dtype.lanes();
   int buffer_lanes = buffer->dtype.lanes();
 
   this->dtype = buffer->dtype.with_lanes(index_lanes * buffer_lanes);
 }
 
-BufferLoad::BufferLoad(Buffer buffer, Array<PrimExpr> indices, Span span) {
+BufferLoad::BufferLoad(Buffer buffer, Array<PrimExpr> indices, Optional<PrimExpr> predicate,
+                       Span span) {
   ICHECK_EQ(buffer->shape.size(), indices.size())
       << "Buffer " << buffer->name << " is " << buffer->shape.size()
       << "-dimensional, cannot be indexed with the " << indices.size()
@@ -723,15 +753,23 @@ BufferLoad::BufferLoad(Buffer buffer, Array<PrimExpr> indices, Span span) {
   ObjectPtr<BufferLoadNode> node = make_object<BufferLoadNode>();
   node->buffer = std::move(buffer);
   node->indices = std::move(indices);
+  node->predicate = std::move(predicate);
   node->span = std::move(span);
   node->LegalizeDType();
+  if (node->predicate.defined()) {
+    DataType predicate_dtype = node->predicate.value().dtype();
+    DataType expected = DataType::Bool(node->dtype.get_lanes_or_vscale_factor(),
+                                       node->dtype.is_scalable_vector());
+    ICHECK(predicate_dtype == expected)
+        << "The predicate of a load of " << node->dtype << " from buffer " << node->buffer->name
+        << " must be " << expected << ", but got " << predicate_dtype;
+  }
   data_ = std::move(node);
 }
 
 TVM_REGISTER_GLOBAL("tir.BufferLoad")
-    .set_body_typed([](Buffer buffer, Array<PrimExpr> indices, Span span) {
-      return BufferLoad(buffer, indices, span);
-    });
+    .set_body_typed([](Buffer buffer, Array<PrimExpr> indices, Optional<PrimExpr> predicate,
+                       Span span) { return BufferLoad(buffer, indices, predicate, span); });
 
 TVM_REGISTER_NODE_TYPE(BufferLoadNode);
 
@@ -458,7 +458,8 @@ TVM_REGISTER_GLOBAL("tir.Evaluate").set_body_typed([](PrimExpr value, Span span)
 TVM_REGISTER_NODE_TYPE(EvaluateNode);
 
 // BufferStore
-BufferStore::BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices, Span span) {
+BufferStore::BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
+                         Optional<PrimExpr> predicate, Span span) {
   ICHECK_EQ(buffer->shape.size(), indices.size())
       << "Buffer " << buffer->name << " is " << buffer->shape.size()
       << "-dimensional, cannot be indexed with the " << indices.size()
@@ -469,31 +470,54 @@ BufferStore::BufferStore(Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
         << "Only the last index of a buffer access may be a vector type.";
   }
 
-  int index_lanes = indices.size() ? indices.back().dtype().lanes() : 1;
-  int buffer_lanes = buffer->dtype.lanes();
-
-  ICHECK_EQ(index_lanes * buffer_lanes, value.dtype().lanes())
-      << "Cannot store value with " << value.dtype().lanes() << ", expected value with "
-      << index_lanes * buffer_lanes << " (" << index_lanes << " index lanes * " << buffer_lanes
-      << " buffer element lanes)";
-  if (buffer->dtype.with_lanes(buffer_lanes * index_lanes) != value.dtype()) {
-    LOG(FATAL) << "TypeError: dtype mismatch on BufferStore: "      //
-               << "buffer's dtype is `" << buffer->dtype            //
-               << "`, the lanes of indexing are: `" << index_lanes  //
-               << "`, but RHS's dtype is `" << value.dtype() << "`";
+  DataType index_dtype = indices.size() ? indices.back().dtype() : DataType::Int(32);
+  if (index_dtype.is_scalable_vector()) {
+    ICHECK(buffer->dtype.is_scalar())
+        << "A scalable vector index can only access a buffer of scalars, but buffer "
+        << buffer->name << " has type " << buffer->dtype;
+    if (buffer->dtype.with_scalable_vscale_factor(index_dtype.vscale_factor()) != value.dtype()) {
+      LOG(FATAL) << "TypeError: dtype mismatch on BufferStore: "       //
+                 << "buffer's dtype is `" << buffer->dtype             //
+                 << "`, the lanes of indexing are: `" << index_dtype  //
+                 << "`, but RHS's dtype is `" << value.dtype() << "`";
+    }
+  } else {
+    int index_lanes = index_dtype.lanes();
+    int buffer_lanes = buffer->dtype.lanes();
+
+    ICHECK_EQ(index_lanes * buffer_lanes, value.dtype().get_lanes_or_vscale_factor())
+        << "Cannot store value with " << value.dtype() << ", expected value with "
+        << index_lanes * buffer_lanes << " (" << index_lanes << " index lanes * "
+        << buffer_lanes << " buffer element lanes)";
+    if (buffer->dtype.with_lanes(buffer_lanes * index_lanes) != value.dtype()) {
+      LOG(FATAL) << "TypeError: dtype mismatch on BufferStore: "      //
+                 << "buffer's dtype is `" << buffer->dtype            //
+                 << "`, the lanes of indexing are: `" << index_lanes  //
+                 << "`, but RHS's dtype is `" << value.dtype() << "`";
+    }
+  }
+  if (predicate.defined()) {
+    DataType predicate_dtype = predicate.value().dtype();
+    DataType expected = DataType::Bool(value.dtype().get_lanes_or_vscale_factor(),
+                                       value.dtype().is_scalable_vector());
+    ICHECK(predicate_dtype == expected)
+        << "The predicate of a store of " << value.dtype() << " to buffer " << buffer->name
+        << " must be " << expected << ", but got " << predicate_dtype;
   }
 
   ObjectPtr<BufferStoreNode> node = make_object<BufferStoreNode>();
   node->buffer = std::move(buffer);
   node->value = std::move(value);
   node->indices = std::move(indices);
+  node->predicate = std::move(predicate);
   node->span = std::move(span);
   data_ = std::move(node);
 }
 
 TVM_REGISTER_GLOBAL("tir.BufferStore")
-    .set_body_typed([](Buffer buffer, PrimExpr value, Array<PrimExpr> indices, Span span) {
-      return BufferStore(buffer, value, indices, span);
+    .set_body_typed([](Buffer buffer, PrimExpr value, Array<PrimExpr> indices,
+                       Optional<PrimExpr> predicate, Span span) {
+      return BufferStore(buffer, value, indices, predicate, span);
     });
 
 TVM_REGISTER_NODE_TYPE(BufferStoreNode);
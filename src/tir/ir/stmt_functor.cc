@@ -69,6 +69,9 @@ void StmtVisitor::VisitStmt_(const DeclBufferNode* op) { this->VisitStmt(op->bod
 void StmtVisitor::VisitStmt_(const BufferStoreNode* op) {
   this->VisitExpr(op->value);
   VisitArray(op->indices, [this](const PrimExpr& e) { this->VisitExpr(e); });
+  if (op->predicate) {
+    this->VisitExpr(op->predicate.value());
+  }
 }
 
 void StmtVisitor::VisitStmt_(const BufferRealizeNode* op) {
@@ -392,13 +395,19 @@ Stmt StmtMutator::VisitStmt_(const IfThenElseNode* op) {
 Stmt StmtMutator::VisitStmt_(const BufferStoreNode* op) {
   PrimExpr value = this->VisitExpr(op->value);
   Array<PrimExpr> indices = Internal::Mutate(this, op->indices);
+  Optional<PrimExpr> predicate = op->predicate;
+  if (predicate) {
+    predicate = this->VisitExpr(predicate.value());
+  }
 
-  if (value.same_as(op->value) && indices.same_as(op->indices)) {
+  if (value.same_as(op->value) && indices.same_as(op->indices) &&
+      predicate.same_as(op->predicate)) {
     return GetRef<Stmt>(op);
   } else {
     auto n = CopyOnWrite(op);
     n->value = std::move(value);
     n->indices = std::move(indices);
+    n->predicate = std::move(predicate);
     return Stmt(n);
   }
 }
@@ -25,6 +25,9 @@
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/transform.h>
 
+#include <utility>
+#include <vector>
+
 namespace tvm {
 namespace tir {
 namespace transform {
@@ -93,17 +96,34 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
   IRModuleNode* mod_ptr = mod.CopyOnWrite();
   auto* func_dict = mod_ptr->functions.CopyOnWrite();
   // directly loop over the underlying dict
+  std::vector<std::pair<const ObjectRef*, ObjectRef*>> prim_funcs;
   for (auto& kv : *func_dict) {
     // only picks up tir::PrimFunc
     if (kv.second->IsInstance<PrimFuncNode>()) {
+      prim_funcs.emplace_back(&kv.first, &kv.second);
+    }
+  }
+  if (tvm::transform::NumFunctionPassThreads(pass_ctx, pass_info, prim_funcs.size()) > 1) {
+    // The functions stay in the module that the other threads read, and are updated
+    // once all of them are done.
+    std::vector<PrimFunc> results(prim_funcs.size());
+    tvm::transform::ForEachFunction(pass_ctx, pass_info, prim_funcs.size(), [&](size_t i) {
+      results[i] = pass_func(Downcast<PrimFunc>(*prim_funcs[i].second), mod, pass_ctx);
+    });
+    for (size_t i = 0; i < prim_funcs.size(); ++i) {
+      *prim_funcs[i].second = std::move(results[i]);
+    }
+  } else {
+    for (auto& kv : prim_funcs) {
       // move out the function so that it is the only copy.
-      PrimFunc func = Downcast<PrimFunc>(std::move(kv.second));
+      PrimFunc func = Downcast<PrimFunc>(std::move(*kv.second));
       func = pass_func(std::move(func), mod, pass_ctx);
-      kv.second = std::move(func);
-
-      if (!kv.second.defined()) {
-        deleted_list.push_back(Downcast<GlobalVar>(kv.first));
-      }
+      *kv.second = std::move(func);
+    }
+  }
+  for (const auto& kv : prim_funcs) {
+    if (!kv.second->defined()) {
+      deleted_list.push_back(Downcast<GlobalVar>(*kv.first));
     }
   }
 
@@ -118,8 +138,8 @@ IRModule PrimFuncPassNode::operator()(IRModule mod, const PassContext& pass_ctx)
 
 Pass CreatePrimFuncPass(
     const runtime::TypedPackedFunc<PrimFunc(PrimFunc, IRModule, PassContext)>& pass_func,
-    int opt_level, String name, tvm::Array<String> required) {
-  PassInfo pass_info = PassInfo(opt_level, name, required);
+    int opt_level, String name, tvm::Array<String> required, bool thread_safe) {
+  PassInfo pass_info = PassInfo(opt_level, name, required, thread_safe);
   return PrimFuncPass(pass_func, pass_info);
 }
 
@@ -90,6 +90,44 @@ PrimExpr LargeUIntImm(DataType t, int64_t low, int64_t high, Span span) {
       span);
 }
 
+// vscale
+PrimExpr vscale(Span span) {
+  return tir::Call(DataType::Int(32), tir::builtin::vscale(), {}, span);
+}
+
+PrimExpr VectorLanesToExpr(int lanes, DataType dtype) {
+  if (lanes > 0) {
+    return make_const(dtype, lanes);
+  }
+  return cast(dtype, vscale()) * make_const(dtype, -lanes);
+}
+
+Optional<Integer> VectorLanesFromExpr(const PrimExpr& lanes) {
+  if (const int64_t* value = as_const_int(lanes)) {
+    if (*value < 1) return NullOpt;
+    return Integer(static_cast<int>(*value));
+  }
+  auto fis_vscale = [](PrimExpr e) {
+    if (const auto* cast = e.as<tir::CastNode>()) {
+      e = cast->value;
+    }
+    const auto* call = e.as<tir::CallNode>();
+    return call != nullptr && call->op.same_as(tir::builtin::vscale());
+  };
+  if (const auto* mul = lanes.as<tir::MulNode>()) {
+    const int64_t* factor = nullptr;
+    if (fis_vscale(mul->a)) {
+      factor = as_const_int(mul->b);
+    } else if (fis_vscale(mul->b)) {
+      factor = as_const_int(mul->a);
+    }
+    if (factor != nullptr && *factor > 1) {
+      return Integer(-static_cast<int>(*factor));
+    }
+  }
+  return NullOpt;
+}
+
 // Q-multiplication
 PrimExpr q_multiply_shift(PrimExpr x, PrimExpr y, PrimExpr q, PrimExpr s, Span span) {
   return tir::Call(DataType::Int(32, x.dtype().lanes()), tir::builtin::q_multiply_shift(),
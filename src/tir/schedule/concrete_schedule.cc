@@ -70,6 +70,7 @@ class ScheduleCopier {
   /*! \brief Create the copier and properly set up the `old2new_` table */
   explicit ScheduleCopier(const ScheduleState& state) {
     // Create SRef tree without parents
+    old2new_.reserve(state->stmt2ref.size());
     for (const auto& kv : state->stmt2ref) {
       const StmtSRefNode* sref = kv.second.operator->();
       old2new_.emplace(sref,                          // the old StmtSRef
@@ -141,6 +142,7 @@ class ScheduleCopier {
   /*! \brief Copy SMap<StmtSRef, Scope> */
   SMap<StmtSRef, BlockInfo> Copy(const SMap<StmtSRef, BlockInfo>& scopes) {
     SMap<StmtSRef, BlockInfo> result;
+    result.reserve(scopes.size());
     for (const auto& kv : scopes) {
       const StmtSRef& old_sref = kv.first;
       const BlockInfo& old_info = kv.second;
@@ -383,6 +385,17 @@ LoopRV ConcreteScheduleNode::Merge(const Array<LoopRV>& loop_rvs) {
   return CreateRV<LoopRV>(result);
 }
 
+LoopRV ConcreteScheduleNode::HorizontalFuse(const Array<LoopRV>& loop_rvs) {
+  CHECK(loop_rvs.size() > 1) << "ValueError: 'horizontal_fuse' requires at least 2 loop(s)";
+  Array<StmtSRef> loop_srefs = this->GetSRefs(loop_rvs);
+  StmtSRef result{nullptr};
+  TVM_TIR_SCHEDULE_BEGIN();
+  result = tir::HorizontalFuse(state_, loop_srefs);
+  TVM_TIR_SCHEDULE_END("horizontal-fuse", this->error_render_level_);
+  this->state_->DebugVerify();
+  return CreateRV<LoopRV>(result);
+}
+
 LoopRV ConcreteScheduleNode::Fuse(const Array<LoopRV>& loop_rvs, bool preserve_unit_iters) {
   CHECK(!loop_rvs.empty()) << "ValueError: 'fuse' requires at least 1 loop(s)";
   Array<StmtSRef> loop_srefs = this->GetSRefs(loop_rvs);
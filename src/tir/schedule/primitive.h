@@ -220,6 +220,18 @@ TVM_DLL Array<StmtSRef> Split(ScheduleState self, const StmtSRef& loop_sref,
  * \return The new loop after merge
  */
 TVM_DLL StmtSRef Merge(ScheduleState self, const Array<StmtSRef>& loop_srefs);
+/*!
+ * \brief Fuse a list of sibling loops horizontally, so that their bodies run one after another
+ * in a single loop. It requires:
+ * 1) The loops are consecutive children of the same parent.
+ * 2) The loops can't have annotations or thread bindings, and must start with 0.
+ * 3) The loops have constant extents, or their extents are equal.
+ * 4) The blocks under different loops don't depend on each other.
+ * \param self The state of the schedule
+ * \param loop_srefs An array of srefs to the loops to be fused
+ * \return The new loop after fusion
+ */
+TVM_DLL StmtSRef HorizontalFuse(ScheduleState self, const Array<StmtSRef>& loop_srefs);
 
 /*!
  * \brief Fuse a list of consecutive loops into one. It requires:
@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "../utils.h"
+
+namespace tvm {
+namespace tir {
+
+/*! \brief The loops to be fused are not consecutive children of the same parent */
+class NotConsecutiveSiblingLoopsError : public ScheduleError {
+ public:
+  explicit NotConsecutiveSiblingLoopsError(IRModule mod, For lhs, For rhs)
+      : mod_(std::move(mod)), lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The loops to be fused horizontally are not consecutive children of the "
+           "same parent";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "The loops {0} and {1} to be fused horizontally are not consecutive children of the "
+           "same parent";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {lhs_, rhs_}; }
+
+  IRModule mod_;
+  For lhs_;
+  For rhs_;
+};
+
+/*! \brief The loop to be fused is annotated, bound to a thread, or of a non-constant extent */
+class HorizontalFuseLoopError : public ScheduleError {
+ public:
+  explicit HorizontalFuseLoopError(IRModule mod, For loop, bool is_extent_error)
+      : mod_(std::move(mod)), loop_(std::move(loop)), is_extent_error_(is_extent_error) {}
+
+  String FastErrorString() const final {
+    if (is_extent_error_) {
+      return "ScheduleError: The loops to be fused horizontally have extents that are neither "
+             "constant nor equal";
+    }
+    return "ScheduleError: The loop to be fused horizontally has annotation or thread binding";
+  }
+
+  String DetailRenderTemplate() const final {
+    if (is_extent_error_) {
+      return "The extent of the loop {0} is not constant, and not equal to the extents of the "
+             "other loops to be fused horizontally";
+    }
+    return "The loop {0} to be fused horizontally has annotation or thread binding";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {loop_}; }
+
+  IRModule mod_;
+  For loop_;
+  bool is_extent_error_;
+};
+
+/*! \brief The blocks under two of the loops to be fused depend on each other */
+class DependentSiblingBlocksError : public ScheduleError {
+ public:
+  explicit DependentSiblingBlocksError(IRModule mod, Block src, Block dst)
+      : mod_(std::move(mod)), src_(std::move(src)), dst_(std::move(dst)) {}
+
+  String FastErrorString() const final {
+    return "ScheduleError: The blocks under the loops to be fused horizontally are not "
+           "independent";
+  }
+
+  String DetailRenderTemplate() const final {
+    return "The block {1} depends on the block {0}, which are under different loops to be fused "
+           "horizontally";
+  }
+
+  IRModule mod() const final { return mod_; }
+  Array<ObjectRef> LocationsOfInterest() const final { return {src_, dst_}; }
+
+  IRModule mod_;
+  Block src_;
+  Block dst_;
+};
+
+/*!
+ * \brief Substitute the loop var of a loop being fused horizontally, append a predicate to the
+ * outermost block realizes if given, and collect the reuse mapping of opaque blocks
+ */
+class HorizontalFuseBodyRewriter : public StmtExprMutator {
+ public:
+  explicit HorizontalFuseBodyRewriter(const Var& old_var, const PrimExpr& new_value,
+                                      Optional<PrimExpr> predicate, Map<Block, Block>* block_reuse)
+      : old_var_(old_var),
+        new_value_(new_value),
+        predicate_(std::move(predicate)),
+        block_reuse_(block_reuse) {}
+
+ private:
+  PrimExpr VisitExpr_(const VarNode* op) final {
+    if (op == old_var_.get()) {
+      return new_value_;
+    }
+    return GetRef<PrimExpr>(op);
+  }
+
+  Stmt VisitStmt_(const BlockRealizeNode* op) final {
+    bool is_outermost = !inside_block_;
+    inside_block_ = true;
+    BlockRealize realize = Downcast<BlockRealize>(StmtExprMutator::VisitStmt_(op));
+    inside_block_ = !is_outermost;
+    if (realize->block->iter_vars.empty()) {
+      block_reuse_->Set(op->block, realize->block);
+    }
+    if (is_outermost && predicate_.defined()) {
+      BlockRealizeNode* n = realize.CopyOnWrite();
+      n->predicate =
+          is_one(n->predicate) ? predicate_.value() : (n->predicate && predicate_.value());
+    }
+    return std::move(realize);
+  }
+
+  /*! \brief The loop var to be substituted */
+  const Var& old_var_;
+  /*! \brief The value to substitute the loop var with */
+  const PrimExpr& new_value_;
+  /*! \brief The predicate to be appended to the outermost block realizes */
+  Optional<PrimExpr> predicate_;
+  /*! \brief The reuse mapping of opaque blocks */
+  Map<Block, Block>* block_reuse_;
+  /*! \brief Whether the statement visited is inside a block */
+  bool inside_block_ = false;
+};
+
+StmtSRef HorizontalFuse(ScheduleState self, const Array<StmtSRef>& loop_srefs) {
+  // Invariance
+  // - The blocks under different loops are independent, so interleaving their iterations does not
+  //   change the result.
+  // - Each block executes with the same bindings as before, the extra iterations being masked
+  //   out by block predicates.
+  arith::Analyzer analyzer;
+  // Step 1. Sort the loops by their positions and check they are consecutive siblings
+  std::vector<StmtSRef> srefs{loop_srefs.begin(), loop_srefs.end()};
+  std::sort(srefs.begin(), srefs.end(), [](const StmtSRef& a, const StmtSRef& b) {
+    return a->seq_index < b->seq_index;
+  });
+  std::vector<const ForNode*> loops;
+  loops.reserve(srefs.size());
+  for (const StmtSRef& sref : srefs) {
+    loops.push_back(TVM_SREF_TO_FOR(sref));
+  }
+  const StmtSRefNode* parent_sref = srefs[0]->parent;
+  for (int i = 1, n = srefs.size(); i < n; ++i) {
+    if (srefs[i]->parent != parent_sref || srefs[i - 1]->seq_index < 0 ||
+        srefs[i]->seq_index != srefs[i - 1]->seq_index + 1) {
+      throw NotConsecutiveSiblingLoopsError(self->mod, GetRef<For>(loops[i - 1]),
+                                            GetRef<For>(loops[i]));
+    }
+  }
+  // Step 2. Check the loops, and find the extent of the fused loop
+  PrimExpr extent = loops[0]->extent;
+  bool is_const_extent = true;
+  for (int i = 0, n = srefs.size(); i < n; ++i) {
+    const ForNode* loop = loops[i];
+    if (!loop->annotations.empty() || loop->thread_binding.defined()) {
+      throw HorizontalFuseLoopError(self->mod, GetRef<For>(loop), /*is_extent_error=*/false);
+    }
+    CheckLoopStartsWithZero(self, srefs[i], &analyzer);
+    is_const_extent = is_const_extent && loop->extent->IsInstance<IntImmNode>();
+  }
+  for (int i = 1, n = srefs.size(); i < n; ++i) {
+    const ForNode* loop = loops[i];
+    if (is_const_extent) {
+      if (Downcast<IntImm>(loop->extent)->value > Downcast<IntImm>(extent)->value) {
+        extent = loop->extent;
+      }
+    } else if (!analyzer.CanProveEqual(loop->extent, extent)) {
+      throw HorizontalFuseLoopError(self->mod, GetRef<For>(loop), /*is_extent_error=*/true);
+    }
+  }
+  // Step 3. Check the blocks under different loops are independent
+  StmtSRef scope_root_sref = GetScopeRoot(self, srefs[0], /*require_stage_pipeline=*/false);
+  BlockScope scope = self->GetBlockScope(scope_root_sref);
+  std::unordered_map<const StmtSRefNode*, int> block2loop;
+  for (int i = 0, n = srefs.size(); i < n; ++i) {
+    for (const StmtSRef& block_sref : GetChildBlockSRefOnSRefTree(self, srefs[i])) {
+      block2loop[block_sref.get()] = i;
+    }
+  }
+  for (const auto& kv : block2loop) {
+    for (const Dependency& dep : scope->GetDepsBySrc(GetRef<StmtSRef>(kv.first))) {
+      auto it = block2loop.find(dep->dst.get());
+      if (it != block2loop.end() && it->second != kv.second) {
+        const BlockNode* src = TVM_SREF_TO_BLOCK(dep->src);
+        const BlockNode* dst = TVM_SREF_TO_BLOCK(dep->dst);
+        throw DependentSiblingBlocksError(self->mod, GetRef<Block>(src), GetRef<Block>(dst));
+      }
+    }
+  }
+  // Step 4. Create the fused loop, masking out the extra iterations of the shorter loops
+  Var fused_var = loops[0]->loop_var.copy_with_suffix("_h");
+  DataType dtype = fused_var.dtype();
+  Map<Block, Block> block_reuse;
+  Array<Stmt> bodies;
+  for (const ForNode* loop : loops) {
+    PrimExpr value = cast(loop->loop_var.dtype(), fused_var);
+    Optional<PrimExpr> predicate = NullOpt;
+    if (is_const_extent && !analyzer.CanProveEqual(loop->extent, extent)) {
+      predicate = value < loop->extent;
+    }
+    HorizontalFuseBodyRewriter rewriter(loop->loop_var, value, predicate, &block_reuse);
+    bodies.push_back(rewriter(loop->body));
+  }
+  For fused_loop(fused_var, make_zero(dtype), cast(dtype, extent), ForKind::kSerial,
+                 SeqStmt::Flatten(bodies));
+  // Step 5. Replace the loops in the body of their parent with the fused loop
+  Stmt parent_body{nullptr};
+  if (const auto* parent_loop = parent_sref->StmtAs<ForNode>()) {
+    parent_body = parent_loop->body;
+  } else {
+    parent_body = TVM_SREF_TO_BLOCK(GetRef<StmtSRef>(parent_sref))->body;
+  }
+  const auto* seq = parent_body.as<SeqStmtNode>();
+  ICHECK(seq != nullptr) << "ValueError: Expect the sibling loops to be in a SeqStmt";
+  Array<Stmt> new_seq;
+  for (int i = 0, n = seq->seq.size(); i < n; ++i) {
+    if (i == srefs.front()->seq_index) {
+      new_seq.push_back(fused_loop);
+    } else if (i < srefs.front()->seq_index || i > srefs.back()->seq_index) {
+      new_seq.push_back(seq->seq[i]);
+    }
+  }
+  Stmt new_parent_body = new_seq.size() == 1 ? new_seq[0] : SeqStmt(new_seq);
+  StmtSRef parent = GetRef<StmtSRef>(parent_sref);
+  if (const auto* parent_loop = parent_sref->StmtAs<ForNode>()) {
+    ObjectPtr<ForNode> new_parent = make_object<ForNode>(*parent_loop);
+    new_parent->body = std::move(new_parent_body);
+    self->Replace(parent, For(new_parent), block_reuse);
+  } else {
+    const BlockNode* parent_block = TVM_SREF_TO_BLOCK(parent);
+    ObjectPtr<BlockNode> new_parent = make_object<BlockNode>(*parent_block);
+    new_parent->body = std::move(new_parent_body);
+    Block new_block(new_parent);
+    block_reuse.Set(GetRef<Block>(parent_block), new_block);
+    self->Replace(parent, new_block, block_reuse);
+  }
+  // Step 6. Update the cached flags of the scope
+  self->UpdateScopeBlockInfo(GetBlockRealize(self, scope_root_sref));
+  return self->stmt2ref.at(fused_loop.get());
+}
+
+/******** InstructionKind Registration ********/
+
+struct HorizontalFuseTraits : public UnpackedInstTraits<HorizontalFuseTraits> {
+  static constexpr const char* kName = "HorizontalFuse";
+  static constexpr bool kIsPure = false;
+
+ private:
+  static constexpr size_t kNumInputs = 1;
+  static constexpr size_t kNumAttrs = 0;
+  static constexpr size_t kNumDecisions = 0;
+
+  template <size_t delta>
+  static TVM_ALWAYS_INLINE void _SetInputs(const runtime::TVMArgsSetter& setter,
+                                           const Array<ObjectRef>& inputs) {
+    setter(delta, inputs);
+  }
+
+  static LoopRV UnpackedApplyToSchedule(Schedule sch, Array<LoopRV> loop_rvs) {
+    return sch->HorizontalFuse(loop_rvs);
+  }
+
+  static String UnpackedAsPython(Array<String> outputs, Array<String> loop_rvs) {
+    PythonAPICall py("horizontal_fuse");
+    for (const String& loop_rv : loop_rvs) {
+      py.Input("", loop_rv);
+    }
+    py.SingleOutput(outputs);
+    return py.Str();
+  }
+
+  template <typename>
+  friend struct ::tvm::tir::UnpackedInstTraits;
+};
+
+TVM_REGISTER_INST_KIND_TRAITS(HorizontalFuseTraits);
+
+}  // namespace tir
+}  // namespace tvm
@@ -213,6 +213,16 @@ LoopRV TracedScheduleNode::Merge(const Array<LoopRV>& loop_rvs) {
   return result;
 }
 
+LoopRV TracedScheduleNode::HorizontalFuse(const Array<LoopRV>& loop_rvs) {
+  LoopRV result = ConcreteScheduleNode::HorizontalFuse(loop_rvs);
+  static const InstructionKind& kind = InstructionKind::Get("HorizontalFuse");
+  trace_->Append(/*inst=*/Instruction(/*kind=*/kind,
+                                      /*inputs=*/{loop_rvs.begin(), loop_rvs.end()},
+                                      /*attrs=*/{},
+                                      /*outputs=*/{result}));
+  return result;
+}
+
 LoopRV TracedScheduleNode::Fuse(const Array<LoopRV>& loop_rvs, bool preserve_unit_loops) {
   LoopRV result = ConcreteScheduleNode::Fuse(loop_rvs, preserve_unit_loops);
 
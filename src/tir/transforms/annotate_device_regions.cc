@@ -41,7 +41,7 @@ class DeviceRegionAnnotater : public StmtMutator {
       // If a target attribute already exists, use it as-is.
       return GetRef<Stmt>(op);
     } else if (op->attr_key == attr::thread_extent || op->attr_key == attr::pipeline_exec_scope ||
-               op->attr_key == attr::device_scope) {
+               op->attr_key == attr::device_scope || op->attr_key == attr::cluster_dims) {
       // These attributes are only allowed in device-side code, so
       // they should be annotated with the function's default target.
       Stmt body = GetRef<Stmt>(op);
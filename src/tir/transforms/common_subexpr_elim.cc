@@ -119,42 +119,6 @@ bool CommonSubexpressionEliminator::CanContainEligibleComputations(const PrimExp
   return true;
 }
 
-/*!
- * \brief Implements an order on pairs (expression,frequency). First attempts to compare them
-          using the size of the expression. If it is the same, decides something else still
-          deterministic.
- * \param a The first pair
- * \param b The second pair
- * \return A boolean telling if the first pair `a` comes before the second pair `b`
- * \note We need this order to be deterministic in order to have a fully deterministic pass,
- *       as we will deal with elements that are coming from a hashtable, but the order in which
- *       they appeared in the hashtable was based on some runtime addresses, so it can potentially
- *       change with every execution.
- */
-bool CommonSubexpressionEliminator::OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a,
-                                                            std::pair<PrimExpr, size_t> b) {
-  size_t a_size = CalculateExprComplexity(a.first);
-  size_t b_size = CalculateExprComplexity(b.first);
-
-  // Criteria 1 - Size of the expression comes first
-  // `a` comes before `b` if the size of `a` is bigger
-  if (a_size > b_size) {
-    return true;
-  }
-  // `a` does NOT come before `b` if the size of `b` is bigger
-  if (b_size > a_size) {
-    return false;
-  }
-
-  // Criteria 2 - If they had the same size, use the lexicographic order as a last resort
-  // as we need a deterministic order
-  std::stringstream a_stream;
-  std::stringstream b_stream;
-  a_stream << AsLegacyRepr(a.first);
-  b_stream << AsLegacyRepr(b.first);
-  return (a_stream.str().compare(b_stream.str()) < 0);
-}
-
 /*!
  * \brief Generates a new fresh variable, whose name will be cse_var_i.
  * \param type_annotation The type of the new variable to generate
@@ -173,7 +137,7 @@ Var CommonSubexpressionEliminator::GenerateNewVar(DataType type_annotation) {
   // Check that the name that we want to use for the new variable isn't already being used
   // (names don't really have to be unique as they are just hints, and having the same name
   // doesn't means that it's the same variable, but it's clearer for dumps)
-  if (UsesVarName::StmtUsesVarName(initial_body_, string_name)) {
+  if (used_var_names_.count(name)) {
     // If the name is already used, call ourselves recursively for trying with the next one
     return GenerateNewVar(type_annotation);
   }
@@ -218,7 +182,60 @@ Stmt CommonSubexpressionEliminator::PerformCSE(const Stmt& stmt, const Context&
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(const Stmt& stmt,
                                                              const Context& context_init,
                                                              bool identify_equiv_terms)
-    : initial_body_(stmt), context_(context_init), identify_equiv_terms_(identify_equiv_terms) {}
+    : used_var_names_(VarNamesUsedBy(stmt)), identify_equiv_terms_(identify_equiv_terms) {
+  for (const auto& var_and_value : context_init) {
+    PushContext(var_and_value.first, var_and_value.second);
+  }
+}
+
+/*!
+ * \brief Adds a variable with its (maybe) value at the end of the context.
+ * \param var The variable
+ * \param value The value of the variable, if any
+ */
+void CommonSubexpressionEliminator::PushContext(const Var& var, const MaybeValue& value) {
+  context_.push_back({var, value});
+  context_vars_[var]++;
+  if (value.has_value()) {
+    // Keep the first variable of the context holding an equivalent value
+    context_value_to_var_.emplace(NormalizeTerm(value.value(), identify_equiv_terms_), var);
+  }
+}
+
+/*!
+ * \brief Removes the variables added to the context since it had the given size.
+ * \param size The size of the context to restore
+ */
+void CommonSubexpressionEliminator::RestoreContext(size_t size) {
+  while (context_.size() > size) {
+    const auto& var_and_value = context_.back();
+    if (--context_vars_[var_and_value.first] == 0) {
+      context_vars_.erase(var_and_value.first);
+    }
+    if (var_and_value.second.has_value()) {
+      auto it = context_value_to_var_.find(
+          NormalizeTerm(var_and_value.second.value(), identify_equiv_terms_));
+      if (it != context_value_to_var_.end() && it->second.same_as(var_and_value.first)) {
+        context_value_to_var_.erase(it);
+      }
+    }
+    context_.pop_back();
+  }
+}
+
+/*!
+ * \brief Checks that all the variables used by a computation are defined in the context.
+ * \param computation The computation to check
+ * \return Whether `computation` has no undefined variables in the current context
+ */
+bool CommonSubexpressionEliminator::AllVarsInContext(const PrimExpr& computation) const {
+  for (const Var& var : UndefinedVars(computation)) {
+    if (!context_vars_.count(var)) {
+      return false;
+    }
+  }
+  return true;
+}
 
 /*!
  * \brief The method which overrides the generic dispatcher of StmtExprMutator.
@@ -237,75 +254,57 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
 
   // Transform the hashtable of *syntactic* eligible computations into a vector of pairs
   // containing *semantic* entities, i.e. where equivalent computations are merged.
-  std::vector<std::pair<PrimExpr, size_t>> semantic_comp_done_by_expr =
-      SyntacticToSemanticComputations(table_syntactic_comp_done_by_expr, identify_equiv_terms_);
-
-  // Sort the vector of semantic entities by decreasing size
-  std::sort(semantic_comp_done_by_expr.begin(), semantic_comp_done_by_expr.end(),
-            OrderOnExprAndFrequency);
+  // They are sorted by decreasing size, and numbered by their normal form for merging the
+  // equivalent computations added later in constant time.
+  SortedSemanticComputations semantic_comp_done_by_expr(
+      SyntacticToSemanticComputations(table_syntactic_comp_done_by_expr, identify_equiv_terms_),
+      identify_equiv_terms_);
 
   // For each computation done (considering them from biggest to smallest)
-  for (size_t i = 0; i < semantic_comp_done_by_expr.size(); i++) {
-    std::pair<PrimExpr, size_t>& computation_and_nb = semantic_comp_done_by_expr[i];
+  for (auto it = semantic_comp_done_by_expr.begin(); it != semantic_comp_done_by_expr.end();
+       ++it) {
+    std::pair<PrimExpr, size_t>& computation_and_nb = it->second;
 
     bool ident_equiv_terms = identify_equiv_terms_;  // To avoid the capture of "this"
 
+    // The normal form of the current computation, computed once for all the comparisons
+    PrimExpr norm_computation = NormalizeTerm(computation_and_nb.first, ident_equiv_terms);
+
     // The predicate later used (when doing replacements) to select expressions that are
     // equivalent to the current computation (`computation_and_nb.first`)
     std::function<bool(const PrimExpr&)> predicate_selector =
-        [computation_and_nb, ident_equiv_terms](const PrimExpr& current_expr) {
+        [norm_computation, ident_equiv_terms](const PrimExpr& current_expr) {
           // `current_expr` should be equivalent to `computation_and_nb.first`, but we also check
           // that `current_expr` is an eligible computation even if we know that
           // `computation_and_nb.first` is eligible by construction, in case that one day the
           // equivalence relation would not preserve the eligibility any more (even though that
           // would probably be a very weird equivalence).
-          return (EquivalentTerms(current_expr, computation_and_nb.first, ident_equiv_terms) &&
+          return (EqualTerms(NormalizeTerm(current_expr, ident_equiv_terms), norm_computation) &&
                   IsEligibleComputation(current_expr));
         };
 
     // See if there is a pair (`var`, `value`) in the context where `value` is semantically
     // equivalent to `computation_and_nb.first`
-    auto it_on_var = std::find_if(
-        context_.begin(), context_.end(),
-        [computation_and_nb, ident_equiv_terms](const std::pair<Var, MaybeValue>& var_and_value) {
-          // Note : safe to call value() as we check has_value() just before
-          return (var_and_value.second.has_value() &&
-                  EquivalentTerms(var_and_value.second.value(), computation_and_nb.first,
-                                  ident_equiv_terms));
-        });
+    auto it_on_var = context_value_to_var_.find(norm_computation);
 
     // Case where we have a perfectly equivalent computation already available in a variable
     // introduced (i.e, present in context_).
     // Note that this case is needed when the user has written something like
     // [let x = A in ....A...A...] : we need to be able to replace all the occurrences of A by
     // an already existing variable holding A, when such a variable happens to exist.
-    if (it_on_var != context_.end()) {
+    if (it_on_var != context_value_to_var_.end()) {
       // Replace in the current `result` everything that is selected by the selector with
       // the existing variable, without diving into expressions in which we don't have the
       // right to dive.
       result = ReplaceSelectedExpr::ReplaceSelectedExprInExpr(
-          result, predicate_selector, it_on_var->first, CanContainEligibleComputations);
+          result, predicate_selector, it_on_var->second, CanContainEligibleComputations);
     } else {
       // The current computation is not equivalent to a computation already done. We will
       // need to see if we want to introduce it.
 
-      // --- Chunk needed for reusing the UndefinedVars() analysis ---
-      // 1 - Wraps the computation into a statement
-      Stmt computation_wrapped_in_stmt = Evaluate(computation_and_nb.first);
-      // 2.1 - Transform the context into a vector of variables instead of pairs
-      std::function<Var(const std::pair<Var, MaybeValue>&)> forget_value =
-          [](const std::pair<Var, MaybeValue>& pair) { return pair.first; };
-      std::vector<Var> vector_vars_known = VectorMap(context_, forget_value);
-      // 2.2 - Transform the std::vector into an Array
-      Array<Var> array_vars_known = Array<Var>(vector_vars_known);
-      // --- End of chunk needed for reusing the UndefinedVars() analysis ---
-
-      // We use the UndefinedVars() analysis to get the undefined vars of the computation
-      Array<Var> vars_undefined = UndefinedVars(computation_wrapped_in_stmt, array_vars_known);
-
       // Check if we can introduce it : if it contains no undefined variables and if we want
       // to introduce it according to the predicate
-      if (vars_undefined.empty() &&
+      if (AllVarsInContext(computation_and_nb.first) &&
           PredicateIntroVarForComputation(computation_and_nb.first, computation_and_nb.second)) {
         // Create a new variable for this computation
         Var new_var = GenerateNewVar(computation_and_nb.first.dtype());
@@ -335,13 +334,12 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr(const PrimExpr& expr) {
         std::vector<PrimExpr> direct_subexprs = DirectSubexpr::GetDirectSubexpressions(
             computation_and_nb.first, IsEligibleComputation, CanContainEligibleComputations);
         // The following insertion will maintain `semantic_comp_done_by_expr` sorted (by
-        // decreasing size/complexity), and it will only insert at locations > i as the
+        // decreasing size/complexity), and it will only insert after `it` as the
         // direct subexprs are necessarily smaller than the current computation.
-        InsertVectorToSortedSemanticComputations(&semantic_comp_done_by_expr, direct_subexprs,
-                                                 identify_equiv_terms_);
+        semantic_comp_done_by_expr.Insert(direct_subexprs);
       }
     }
-    // Note : we do not remove the current element, as we never look back in the local vector
+    // Note : we do not remove the current element, as we never look back in the worklist
   }  // End of for loop
 
   // If the CSE pass has created some variables, then we run it again as more commoning could
@@ -366,14 +364,14 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr_(const LetNode* op) {
   // was doable at the toplevel of the given let-in.
 
   // Save the context at the entry of the function
-  Context context_at_entry = context_;
+  size_t context_size_at_entry = context_.size();
 
   // Recurse on the `value` field for potentially rewriting it
   PrimExpr value_new = VisitExpr(op->value);
 
   // Augment the context with the association (`var`, `value`) for preparing the next recursion
   // on the `body`
-  context_.push_back({op->var, MaybeValue(op->value)});
+  PushContext(op->var, MaybeValue(op->value));
 
   // Recurse on the `body` (with this extended context)
   // The recursive call will have potentially done new simplifications, because in this recursive
@@ -384,7 +382,7 @@ PrimExpr CommonSubexpressionEliminator::VisitExpr_(const LetNode* op) {
 
   // Restaure the context to its content at the entrance to not carry out of scope declarations
   // as the variable introduced by the let-in is not in scope outside of its body
-  context_ = context_at_entry;
+  RestoreContext(context_size_at_entry);
 
   // Rebuild the let-in with a new `value_new` and `body_new` where new simplifications might
   // have been done.
@@ -417,75 +415,57 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
 
   // Transform the hashtable of *syntactic* eligible computations into a vector of pairs
   // containing *semantic* entities, i.e. where equivalent computations are merged.
-  std::vector<std::pair<PrimExpr, size_t>> semantic_comp_done_by_stmt =
-      SyntacticToSemanticComputations(table_syntactic_comp_done_by_stmt, identify_equiv_terms_);
-
-  // Sort the vector of semantic entities by decreasing size
-  std::sort(semantic_comp_done_by_stmt.begin(), semantic_comp_done_by_stmt.end(),
-            OrderOnExprAndFrequency);
+  // They are sorted by decreasing size, and numbered by their normal form for merging the
+  // equivalent computations added later in constant time.
+  SortedSemanticComputations semantic_comp_done_by_stmt(
+      SyntacticToSemanticComputations(table_syntactic_comp_done_by_stmt, identify_equiv_terms_),
+      identify_equiv_terms_);
 
   // For each computation done (considering them from biggest to smallest)
-  for (size_t i = 0; i < semantic_comp_done_by_stmt.size(); i++) {
-    std::pair<PrimExpr, size_t>& computation_and_nb = semantic_comp_done_by_stmt[i];
+  for (auto it = semantic_comp_done_by_stmt.begin(); it != semantic_comp_done_by_stmt.end();
+       ++it) {
+    std::pair<PrimExpr, size_t>& computation_and_nb = it->second;
 
     bool ident_equiv_terms = identify_equiv_terms_;  // To avoid the capture of "this"
 
+    // The normal form of the current computation, computed once for all the comparisons
+    PrimExpr norm_computation = NormalizeTerm(computation_and_nb.first, ident_equiv_terms);
+
     // The predicate later used (when doing replacements) to select expressions that are
     // equivalent to the current computation (`computation_and_nb.first`)
     std::function<bool(const PrimExpr&)> predicate_selector =
-        [computation_and_nb, ident_equiv_terms](const PrimExpr& current_expr) {
+        [norm_computation, ident_equiv_terms](const PrimExpr& current_expr) {
           // `current_expr` should be equivalent to `computation_and_nb.first`, but we also check
           // that `current_expr` is an eligible computation even if we know that
           // `computation_and_nb.first` is eligible by construction, in case that one day the
           // equivalence relation would not preserve the eligibility any more (even though that
           // would probably be a very weird equivalence).
-          return (EquivalentTerms(current_expr, computation_and_nb.first, ident_equiv_terms) &&
+          return (EqualTerms(NormalizeTerm(current_expr, ident_equiv_terms), norm_computation) &&
                   IsEligibleComputation(current_expr));
         };
 
     // See if there is a pair (`var`, `value`) in the context where `value` is semantically
     // equivalent to `computation_and_nb.first`
-    auto it_on_var = std::find_if(
-        context_.begin(), context_.end(),
-        [computation_and_nb, ident_equiv_terms](const std::pair<Var, MaybeValue>& var_and_value) {
-          // Note : safe to call value() as we check has_value() just before
-          return (var_and_value.second.has_value() &&
-                  EquivalentTerms(var_and_value.second.value(), computation_and_nb.first,
-                                  ident_equiv_terms));
-        });
+    auto it_on_var = context_value_to_var_.find(norm_computation);
 
     // Case where we have a perfectly equivalent computation already available in a variable
     // introduced (i.e, present in context_).
     // Note that this case is needed when the user has written something like
     // [let x = A in ....A...A...] : we need to be able to replace all the occurrences of A by
     // an already existing variable holding A, when such a variable happens to exist.
-    if (it_on_var != context_.end()) {
+    if (it_on_var != context_value_to_var_.end()) {
       // Replace in the current `result` everything that is selected by the selector with
       // the existing variable, without diving into expressions in which we don't have the
       // right to dive.
       result = ReplaceSelectedExpr::ReplaceSelectedExprInStmt(
-          result, predicate_selector, it_on_var->first, CanContainEligibleComputations);
+          result, predicate_selector, it_on_var->second, CanContainEligibleComputations);
     } else {
       // The current computation is not equivalent to a computation already done. We will
       // need to see if we want to introduce it.
 
-      // --- Chunk needed for reusing the UndefinedVars() analysis ---
-      // 1 - Wraps the computation into a statement
-      Stmt computation_wrapped_in_stmt = Evaluate(computation_and_nb.first);
-      // 2.1 - Transform the context into a vector of variables instead of pairs
-      std::function<Var(const std::pair<Var, MaybeValue>&)> forget_value =
-          [](const std::pair<Var, MaybeValue>& pair) { return pair.first; };
-      std::vector<Var> vector_vars_known = VectorMap(context_, forget_value);
-      // 2.2 - Transform the std::vector into an Array
-      Array<Var> array_vars_known = Array<Var>(vector_vars_known);
-      // --- End of chunk needed for reusing the UndefinedVars() analysis ---
-
-      // We use the UndefinedVars() analysis to get the undefined vars of the computation
-      Array<Var> vars_undefined = UndefinedVars(computation_wrapped_in_stmt, array_vars_known);
-
       // Check if we can introduce it : if it contains no undefined variables and if we want
       // to introduce it according to the predicate
-      if (vars_undefined.empty() &&
+      if (AllVarsInContext(computation_and_nb.first) &&
           PredicateIntroVarForComputation(computation_and_nb.first, computation_and_nb.second)) {
         // Create a new variable for this computation
         Var new_var = GenerateNewVar(computation_and_nb.first.dtype());
@@ -516,13 +496,12 @@ Stmt CommonSubexpressionEliminator::VisitStmt(const Stmt& stmt) {
         std::vector<PrimExpr> direct_subexprs = DirectSubexpr::GetDirectSubexpressions(
             computation_and_nb.first, IsEligibleComputation, CanContainEligibleComputations);
         // The following insertion will maintain `semantic_comp_done_by_stmt` sorted (by
-        // decreasing size/complexity), and it will only insert at locations > i as the
+        // decreasing size/complexity), and it will only insert after `it` as the
         // direct subexprs are necessarily smaller than the current computation.
-        InsertVectorToSortedSemanticComputations(&semantic_comp_done_by_stmt, direct_subexprs,
-                                                 identify_equiv_terms_);
+        semantic_comp_done_by_stmt.Insert(direct_subexprs);
       }
     }
-    // Note : we do not remove the current element, as we never look back in the local vector
+    // Note : we do not remove the current element, as we never look back in the worklist
   }  // End of for loop
 
   // If the CSE pass has created some variables, then we run it again as more commoning could
@@ -547,14 +526,14 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const LetStmtNode* op) {
   // was doable at the toplevel of the given let-in.
 
   // Save the context at the entry of the function
-  Context context_at_entry = context_;
+  size_t context_size_at_entry = context_.size();
 
   // Recurse on the `value` field for potentially rewriting it
   PrimExpr value_new = VisitExpr(op->value);
 
   // Augment the context with the association (`var`, `value`) for preparing the next recursion
   // on the `body`
-  context_.push_back({op->var, MaybeValue(op->value)});
+  PushContext(op->var, MaybeValue(op->value));
 
   // Recurse on the `body` (with this extended context)
   // The recursive call will have potentially done new simplifications, because in this recursive
@@ -565,7 +544,7 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const LetStmtNode* op) {
 
   // Restaure the context to its content at the entrance to not carry out of scope declarations
   // as the variable introduced by the let-in is not in scope outside of its body
-  context_ = context_at_entry;
+  RestoreContext(context_size_at_entry);
 
   // Rebuild the let-in with a new `value_new` and `body_new` where new simplifications might
   // have been done.
@@ -589,7 +568,7 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const ForNode* op) {
   // was doable at the toplevel of the given for loop.
 
   // Save the context at the entry of the function
-  Context context_at_entry = context_;
+  size_t context_size_at_entry = context_.size();
 
   // Recurse on the `min` field for potentially rewriting it
   PrimExpr min_new = VisitExpr(op->min);
@@ -599,14 +578,14 @@ Stmt CommonSubexpressionEliminator::VisitStmt_(const ForNode* op) {
 
   // Augment the context with the association {loop_var, no value} (no value as its value will
   // change during the execution of the loop) for preparing the next recursion on the `body`
-  context_.push_back({op->loop_var, MaybeValue()});
+  PushContext(op->loop_var, MaybeValue());
 
   // Recurse on the `body` (with this extended context)
   Stmt body_new = VisitStmt(op->body);
 
   // Restaure the context to its content at the entrance to not carry out of scope declarations
   // as the variable introduced by the for loop is not in scope outside of its body
-  context_ = context_at_entry;
+  RestoreContext(context_size_at_entry);
 
   // Rebuild the for loop with (potentially) a new `min_new`, `extent_new` and `body_new`, where
   // new simplifications might have been done.
@@ -34,6 +34,9 @@
 #include <tvm/tir/stmt_functor.h>  // For the class StmtExprMutator
 #include <tvm/tir/var.h>
 
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>  // For std::pair
 #include <vector>
 
@@ -73,18 +76,27 @@ class CommonSubexpressionEliminator : public StmtExprMutator {
   Stmt VisitStmt_(const ForNode* op) override;
 
  private:
-  Stmt initial_body_;     // Kept for checking if names of new variables already exist
+  // Names used in the initial body, kept for checking if names of new variables already exist
+  std::unordered_set<std::string> used_var_names_;
   Context context_;       // Context associating variables to (maybe) definitions
   int num_last_try_ = 0;  // Number of the last variable tried
   int nb_var_ = 0;        // Number of variables introduced by the CSE pass
 
+  // Scoped hashtables indexing `context_`, kept in sync by PushContext() and RestoreContext()
+  // The number of occurrences of each variable in the context
+  std::unordered_map<Var, size_t, ObjectPtrHash, ObjectPtrEqual> context_vars_;
+  // The first variable of the context holding each value, keyed by its normal form
+  std::unordered_map<PrimExpr, Var, StructuralHash, ExprDeepEqual> context_value_to_var_;
+
   bool identify_equiv_terms_ = false;
 
   static bool ForbiddenComputation(const PrimExpr& expr);
   static bool IsEligibleComputation(const PrimExpr& expr);
   static bool CanContainEligibleComputations(const PrimExpr& expr);
-  static bool OrderOnExprAndFrequency(std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b);
   Var GenerateNewVar(DataType type_annotation);
+  void PushContext(const Var& var, const MaybeValue& value);
+  void RestoreContext(size_t size);
+  bool AllVarsInContext(const PrimExpr& computation) const;
 };
 
 }  // namespace tir
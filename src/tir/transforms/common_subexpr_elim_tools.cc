@@ -36,8 +36,11 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>  // For the declaration of the pass
 
-#include <algorithm>      // For std::find_if
+#include <algorithm>  // For std::find_if
+#include <string>
+#include <tuple>
 #include <unordered_map>  // For the hashtable datatype
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -699,6 +702,34 @@ void UsesVarName::VisitStmt(const Stmt& stmt) {
   // As otherwise we already have our answer
 }
 
+/*!
+ * \brief Visitor collecting the names of all the variables that UsesVarName can find.
+ */
+class VarNamesCollector : public StmtExprVisitor {
+ public:
+  void VisitExpr(const PrimExpr& expr) override {
+    if (auto var_node = expr.as<VarNode>()) {
+      names_.insert(var_node->name_hint);
+    }
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  using StmtExprVisitor::VisitStmt;
+
+  std::unordered_set<std::string> names_;
+};
+
+/*!
+ * \brief Returns the names of all the variables used by a statement.
+ * \param stmt The statement to analyze
+ * \return The set of names for which UsesVarName::StmtUsesVarName(`stmt`, name) is true
+ */
+std::unordered_set<std::string> VarNamesUsedBy(const Stmt& stmt) {
+  VarNamesCollector collector;
+  collector.VisitStmt(stmt);
+  return std::move(collector.names_);
+}
+
 /* ********************************** Utility functions for CSE *********************************
 *********************************************************************************************** */
 
@@ -812,17 +843,19 @@ std::vector<std::pair<PrimExpr, size_t>> SyntacticToSemanticComputations(
   // (otherwise {x+y, y+x} could be both replaced by x+y, and on another run by y+x).
   std::vector<std::pair<PrimExpr, size_t>> sorted_items_of_table(table.begin(), table.end());
 
-  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering
-  sort(sorted_items_of_table.begin(), sorted_items_of_table.end(),
-       [](std::pair<PrimExpr, size_t> a, std::pair<PrimExpr, size_t> b) {
-         std::stringstream a_stream;
-         std::stringstream b_stream;
-         a_stream << AsLegacyRepr(a.first);
-         b_stream << AsLegacyRepr(b.first);
-         return a_stream.str().compare(b_stream.str()) < 0;
-       });
-
-  for (const auto& elem : sorted_items_of_table) {
+  // We do the ordering by comparing the string repr of each expr to get a determinstic ordering.
+  // The reprs are printed once for all, and not at each comparison.
+  std::vector<std::pair<std::string, size_t>> reprs;
+  reprs.reserve(sorted_items_of_table.size());
+  for (size_t i = 0; i < sorted_items_of_table.size(); i++) {
+    std::stringstream stream;
+    stream << AsLegacyRepr(sorted_items_of_table[i].first);
+    reprs.emplace_back(stream.str(), i);
+  }
+  std::sort(reprs.begin(), reprs.end());
+
+  for (const auto& repr : reprs) {
+    const auto& elem = sorted_items_of_table[repr.second];
     PrimExpr norm_elem = NormalizeTerm(elem.first, identify_equiv_terms);
     // If the normalized term is not already a key in the normalized table
     auto it_found = norm_table.find(norm_elem);
@@ -926,5 +959,65 @@ void InsertVectorToSortedSemanticComputations(std::vector<std::pair<PrimExpr, si
   }
 }
 
+/* ***************************** Class SortedSemanticComputations ******************************
+*********************************************************************************************** */
+
+/*!
+ * \brief Constructor of SortedSemanticComputations.
+ * \param computations The pairwise non-equivalent computations with their number of occurrences
+ * \param identify_equiv_terms Whether equivalent (and not only syntactically equal) computations
+                               are merged when added
+ */
+SortedSemanticComputations::SortedSemanticComputations(const std::vector<Entry>& computations,
+                                                       bool identify_equiv_terms)
+    : identify_equiv_terms_(identify_equiv_terms) {
+  // Sort by decreasing complexity, then by string representation, computing both only once
+  // for each computation instead of at each comparison
+  std::vector<std::tuple<size_t, std::string, size_t>> keys;
+  keys.reserve(computations.size());
+  for (size_t i = 0; i < computations.size(); i++) {
+    std::stringstream stream;
+    stream << AsLegacyRepr(computations[i].first);
+    keys.emplace_back(CalculateExprComplexity(computations[i].first), stream.str(), i);
+  }
+  std::sort(keys.begin(), keys.end(), [](const auto& a, const auto& b) {
+    if (std::get<0>(a) != std::get<0>(b)) {
+      return std::get<0>(a) > std::get<0>(b);
+    }
+    return std::get<1>(a) < std::get<1>(b);
+  });
+
+  index_.reserve(computations.size());
+  for (const auto& key : keys) {
+    const Entry& entry = computations[std::get<2>(key)];
+    auto it = entries_.emplace_hint(entries_.end(), std::make_pair(std::get<0>(key), next_rank_++),
+                                    entry);
+    index_.emplace(NormalizeTerm(entry.first, identify_equiv_terms_), it);
+  }
+}
+
+/*!
+ * \brief Adds computations to the worklist, merging them with equivalent ones already present.
+ * \param vec_to_add The computations to add
+ * \param increase_count The number of times that each computation is seen
+ */
+void SortedSemanticComputations::Insert(const std::vector<PrimExpr>& vec_to_add,
+                                        size_t increase_count) {
+  for (const PrimExpr& elem_to_add : vec_to_add) {
+    PrimExpr norm_elem = NormalizeTerm(elem_to_add, identify_equiv_terms_);
+    auto it_found = index_.find(norm_elem);
+    if (it_found != index_.end()) {
+      // An equivalent computation is already present, so we just increase its count
+      it_found->second->second.second += increase_count;
+    } else {
+      // Otherwise it goes after all the computations of greater or equal complexity
+      auto it = entries_.emplace(
+          std::make_pair(CalculateExprComplexity(elem_to_add), next_rank_++),
+          Entry(elem_to_add, increase_count));
+      index_.emplace(norm_elem, it.first);
+    }
+  }
+}
+
 }  // namespace tir
 }  // namespace tvm
@@ -33,9 +33,12 @@
 #include <tvm/tir/stmt.h>
 #include <tvm/tir/stmt_functor.h>  // For the class StmtExprVisitor
 
+#include <map>  // For the ordered worklist of SortedSemanticComputations
 #include <optional>
+#include <string>
 #include <unordered_map>  // For the hashtable datatype
-#include <utility>        // For pairs datatype
+#include <unordered_set>
+#include <utility>  // For pairs datatype
 #include <vector>
 
 namespace tvm {
@@ -171,6 +174,12 @@ class UsesVarName : public StmtExprVisitor {
   bool uses_var_name_ = false;
 };
 
+/*!
+ * \brief Returns the names of all the variables used by a statement, i.e. the names for which
+          UsesVarName::StmtUsesVarName() returns true, so that they can be checked in constant time.
+ */
+std::unordered_set<std::string> VarNamesUsedBy(const Stmt& stmt);
+
 /*!
  * \brief Various utility functions for the CSE pass
  */
@@ -215,6 +224,56 @@ void InsertVectorToSortedSemanticComputations(std::vector<std::pair<PrimExpr, si
                                               const std::vector<PrimExpr>& vec_to_add,
                                               bool identify_equiv_terms, size_t increase_count = 1);
 
+/*!
+ * \brief Semantic computations (pairs of a computation and its number of occurrences) sorted by
+          decreasing complexity, and by their string representation for the ones of the same
+          complexity, as a worklist for the CSE pass.
+          The computations are numbered by their normal form (i.e. hash-consed), so that adding
+          a computation equivalent to one already present increases its count in constant time
+          instead of searching the whole worklist. Added computations go after all the present
+          ones of the same complexity, and the iterators stay valid when adding computations, so
+          the worklist can grow while being iterated.
+ */
+class SortedSemanticComputations {
+ public:
+  using Entry = std::pair<PrimExpr, size_t>;
+
+ private:
+  struct KeyOrder {
+    bool operator()(const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) const {
+      return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+  };
+  // Entries keyed by (complexity, rank), the rank being the order of insertion
+  using EntryMap = std::map<std::pair<size_t, size_t>, Entry, KeyOrder>;
+
+ public:
+  using iterator = EntryMap::iterator;
+
+  /*!
+   * \brief Sorts the semantic computations, which must be pairwise non-equivalent, such as the
+            result of SyntacticToSemanticComputations().
+   */
+  SortedSemanticComputations(const std::vector<Entry>& computations, bool identify_equiv_terms);
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  size_t size() const { return entries_.size(); }
+
+  /*!
+   * \brief Adds the computations of `vec_to_add`, each seen `increase_count` times, merging
+            each with the computation equivalent to it, if any.
+   */
+  void Insert(const std::vector<PrimExpr>& vec_to_add, size_t increase_count = 1);
+
+ private:
+  bool identify_equiv_terms_;
+  size_t next_rank_ = 0;
+  EntryMap entries_;
+  // The entry of each computation, keyed by its normal form
+  std::unordered_map<PrimExpr, iterator, StructuralHash, ExprDeepEqual> index_;
+};
+
 }  // namespace tir
 }  // namespace tvm
 
@@ -23,14 +23,18 @@
 #include <tvm/arith/analyzer.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <functional>
 #include <queue>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "../../arith/interval_set.h"
 #include "../../arith/ir_mutator_with_analyzer.h"
@@ -53,6 +57,7 @@ enum class HoistedLetBindings : int {
   kRequiredByCondition = (1 << 0),
   kLetStmt = (1 << 1),
   kLetExpr = (1 << 2),
+  kBufferLoad = (1 << 3),
 };
 
 struct HoistExpressionConfigNode : public tvm::AttrsNode<HoistExpressionConfigNode> {
@@ -116,6 +121,127 @@ class HoistIfThenElseConfig : public Attrs {
 TVM_REGISTER_NODE_TYPE(HoistIfThenElseConfigNode);
 TVM_REGISTER_PASS_CONFIG_OPTION("tir.HoistIfThenElse", HoistIfThenElseConfig);
 
+/*!
+ * \brief Alias information of the buffers of a PrimFunc.
+ *
+ * Two buffers may alias unless they have distinct data vars and either one of them is allocated
+ * in the function, or both are arguments of a function with the tir.noalias attribute, as
+ * MakePackedAPI and the kernel launch declare them.
+ */
+struct BufferAliasInfo {
+  // The data vars of the arguments.
+  std::unordered_set<const VarNode*> params;
+  // The data vars allocated in the body.
+  std::unordered_set<const VarNode*> allocations;
+  // Whether the arguments are known not to alias each other.
+  bool noalias{false};
+
+  bool MayAlias(const VarNode* a, const VarNode* b) const {
+    if (a == b) {
+      return true;
+    }
+    if (allocations.count(a) || allocations.count(b)) {
+      return false;
+    }
+    return !(noalias && params.count(a) && params.count(b));
+  }
+};
+
+/*! \brief Collects the data vars written inside of each loop. */
+class LoopWriteCollector : public StmtExprVisitor {
+ public:
+  struct WriteInfo {
+    std::unordered_set<const VarNode*> data;
+    // Whether the loop contains a call which may write any memory.
+    bool opaque{false};
+  };
+
+  static std::unordered_map<const StmtNode*, WriteInfo> Collect(const Stmt& stmt,
+                                                                BufferAliasInfo* alias_info) {
+    LoopWriteCollector collector;
+    collector(stmt);
+    alias_info->allocations = std::move(collector.allocations_);
+    return std::move(collector.loop_writes_);
+  }
+
+ private:
+  using Parent = StmtExprVisitor;
+  using Parent::VisitExpr_;
+  using Parent::VisitStmt_;
+
+  void VisitLoop(const StmtNode* loop, std::function<void()> visit_body) {
+    loop_writes_[loop];
+    active_loops_.push_back(loop);
+    visit_body();
+    active_loops_.pop_back();
+  }
+
+  void VisitStmt_(const ForNode* op) final {
+    VisitLoop(op, [&]() { Parent::VisitStmt_(op); });
+  }
+
+  void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->node.as<IterVarNode>() || op->node.as<VarNode>()) {
+      VisitLoop(op, [&]() { Parent::VisitStmt_(op); });
+    } else {
+      Parent::VisitStmt_(op);
+    }
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    allocations_.insert(op->buffer_var.get());
+    Parent::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateConstNode* op) final {
+    allocations_.insert(op->buffer_var.get());
+    Parent::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    Record(op->buffer->data.get());
+    Parent::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::tvm_access_ptr())) {
+      const auto* data = op->args[1].as<VarNode>();
+      const auto* rw_mask = op->args[4].as<IntImmNode>();
+      if (data == nullptr || rw_mask == nullptr) {
+        RecordOpaque();
+      } else if (rw_mask->value & 2) {
+        Record(data);
+      }
+    } else if (op->op.same_as(builtin::address_of())) {
+      const auto* load = op->args[0].as<BufferLoadNode>();
+      if (load == nullptr) {
+        RecordOpaque();
+      } else {
+        Record(load->buffer->data.get());
+      }
+    } else if (SideEffect(GetRef<PrimExpr>(op)) >= CallEffectKind::kUpdateState) {
+      RecordOpaque();
+    }
+    Parent::VisitExpr_(op);
+  }
+
+  void Record(const VarNode* data) {
+    for (const StmtNode* loop : active_loops_) {
+      loop_writes_[loop].data.insert(data);
+    }
+  }
+
+  void RecordOpaque() {
+    for (const StmtNode* loop : active_loops_) {
+      loop_writes_[loop].opaque = true;
+    }
+  }
+
+  std::vector<const StmtNode*> active_loops_;
+  std::unordered_map<const StmtNode*, WriteInfo> loop_writes_;
+  std::unordered_set<const VarNode*> allocations_;
+};
+
 class HoistInfoCollector : public StmtExprVisitor {
  public:
   struct ConditionInfo {
@@ -180,13 +306,23 @@ class HoistInfoCollector : public StmtExprVisitor {
     // sequential node to outside.
     bool reached_sequential_node{false};
 
+    // The number of conditional scopes around the loop.  A buffer
+    // load may only be hoisted out of the loop if it is not inside
+    // of a conditional scope of the loop body.
+    int conditional_depth{0};
+
     // True if the loop variable representing a block variable
     // (e.g. blockIdx.x, threadIdx.x), false otherwise.
     bool IsBlockVariable() const { return !loop_def.as<ForNode>(); }
   };
 
-  static std::vector<HoistInfo> Collect(Stmt stmt, HoistExpressionConfig config) {
+  static std::vector<HoistInfo> Collect(Stmt stmt, HoistExpressionConfig config,
+                                        BufferAliasInfo alias_info) {
     HoistInfoCollector collector(config);
+    if (config->FlagSet(HoistedLetBindings::kBufferLoad)) {
+      collector.loop_writes = LoopWriteCollector::Collect(stmt, &alias_info);
+      collector.alias_info = std::move(alias_info);
+    }
     collector(stmt);
     return collector.completed_loops;
   }
@@ -230,17 +366,26 @@ class HoistInfoCollector : public StmtExprVisitor {
   void VisitExpr_(const AndNode* op) final {
     AttemptHoistConditional(op->a, HoistedConditionals::kBooleanExpression);
     AttemptHoistConditional(op->b, HoistedConditionals::kBooleanExpression);
-    Parent::VisitExpr_(op);
+    // The second operand may be short-circuited.
+    this->VisitExpr(op->a);
+    conditional_depth++;
+    this->VisitExpr(op->b);
+    conditional_depth--;
   }
 
   void VisitExpr_(const OrNode* op) final {
     AttemptHoistConditional(op->a, HoistedConditionals::kBooleanExpression);
     AttemptHoistConditional(op->b, HoistedConditionals::kBooleanExpression);
-    Parent::VisitExpr_(op);
+    // The second operand may be short-circuited.
+    this->VisitExpr(op->a);
+    conditional_depth++;
+    this->VisitExpr(op->b);
+    conditional_depth--;
   }
 
   void VisitStmt_(const ForNode* op) final {
     active_loops.push_back({op->loop_var, GetRef<Stmt>(op)});
+    active_loops.back().conditional_depth = conditional_depth;
     active_loop_vars.insert(op->loop_var.get());
 
     Parent::VisitStmt_(op);
@@ -263,6 +408,7 @@ class HoistInfoCollector : public StmtExprVisitor {
     active_block_vars.insert(var.get());
     active_loop_vars.insert(var.get());
     active_loops.push_back({var, GetRef<Stmt>(op)});
+    active_loops.back().conditional_depth = conditional_depth;
 
     Parent::VisitStmt_(op);
 
@@ -316,7 +462,11 @@ class HoistInfoCollector : public StmtExprVisitor {
   void VisitStmt_(const LetStmtNode* op) final {
     VisitBinding(op->var, op->value, HoistedLetBindings::kLetStmt);
 
-    Parent::VisitStmt_(op);
+    binding_depth++;
+    this->VisitExpr(op->value);
+    binding_depth--;
+    def_depth[op->var.get()] = active_loops.size();
+    this->VisitStmt(op->body);
 
     let_var_to_loop_vars.erase(op->var.get());
     let_var_to_let_vars.erase(op->var.get());
@@ -325,7 +475,9 @@ class HoistInfoCollector : public StmtExprVisitor {
   void VisitExpr_(const LetNode* op) final {
     VisitBinding(op->var, op->value, HoistedLetBindings::kLetExpr);
 
+    binding_depth++;
     Parent::VisitExpr_(op);
+    binding_depth--;
 
     let_var_to_loop_vars.erase(op->var.get());
     let_var_to_let_vars.erase(op->var.get());
@@ -334,17 +486,109 @@ class HoistInfoCollector : public StmtExprVisitor {
   void VisitStmt_(const IfThenElseNode* op) final {
     AttemptHoistConditional(op->condition, HoistedConditionals::kIfElseStmt,
                             op->else_case.defined());
+    this->VisitExpr(op->condition);
+    conditional_depth++;
+    this->VisitStmt(op->then_case);
+    if (op->else_case) {
+      this->VisitStmt(op->else_case.value());
+    }
+    conditional_depth--;
+  }
+
+  void VisitStmt_(const WhileNode* op) final {
+    conditional_depth++;
     Parent::VisitStmt_(op);
+    conditional_depth--;
   }
 
   void VisitExpr_(const CallNode* op) final {
     if (op->op.same_as(builtin::if_then_else())) {
       PrimExpr cond = op->args[0];
       AttemptHoistConditional(cond, HoistedConditionals::kIfElseExpr);
+      this->VisitExpr(cond);
+      conditional_depth++;
+      this->VisitExpr(op->args[1]);
+      this->VisitExpr(op->args[2]);
+      conditional_depth--;
+      return;
     }
     Parent::VisitExpr_(op);
   }
 
+  void VisitStmt_(const BlockNode* op) final {
+    // The block iterators hide the loop vars the accesses depend on.
+    block_depth++;
+    Parent::VisitStmt_(op);
+    block_depth--;
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    def_depth[op->buffer_var.get()] = active_loops.size();
+    Parent::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateConstNode* op) final {
+    def_depth[op->buffer_var.get()] = active_loops.size();
+    Parent::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const DeclBufferNode* op) final {
+    def_depth[op->buffer.get()] = active_loops.size();
+    Parent::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    if (HoistInfo* info = FindLoadHoistDestination(op)) {
+      Var var(op->buffer->name, op->dtype);
+      info->let_bindings.push_back(
+          LetBindingInfo(var, GetRef<PrimExpr>(op), HoistedLetBindings::kBufferLoad));
+    }
+    Parent::VisitExpr_(op);
+  }
+
+  // Find the outermost loop above which this load could be hoisted.
+  // Each loop crossed must iterate at least once, must not write a
+  // buffer which may alias the loaded one, and must not depend on
+  // the load indices.  If nullptr, the load cannot be hoisted.
+  HoistInfo* FindLoadHoistDestination(const BufferLoadNode* op) {
+    if (!config->FlagSet(HoistedLetBindings::kBufferLoad) || block_depth || binding_depth) {
+      return nullptr;
+    }
+    PrimExpr load = GetRef<PrimExpr>(op);
+    if (UsesVar(load, [&](const VarNode* var) { return let_var_to_loop_vars.count(var); })) {
+      return nullptr;
+    }
+    size_t min_depth = 0;
+    for (const Object* def : {static_cast<const Object*>(op->buffer.get()),
+                              static_cast<const Object*>(op->buffer->data.get())}) {
+      auto it = def_depth.find(def);
+      if (it != def_depth.end()) {
+        min_depth = std::max(min_depth, it->second);
+      }
+    }
+
+    HoistInfo* destination = nullptr;
+    for (size_t i = active_loops.size(); i > min_depth; i--) {
+      HoistInfo& info = active_loops[i - 1];
+      const auto* loop = info.loop_def.as<ForNode>();
+      if (loop == nullptr || info.conditional_depth != conditional_depth ||
+          UsesVar(load, [&](const VarNode* var) { return var == info.loop_var.get(); }) ||
+          !analyzer.CanProve(loop->extent > 0)) {
+        break;
+      }
+      const LoopWriteCollector::WriteInfo& writes = loop_writes.at(loop);
+      bool may_alias = writes.opaque;
+      for (const VarNode* data : writes.data) {
+        may_alias = may_alias || alias_info.MayAlias(data, op->buffer->data.get());
+      }
+      if (may_alias) {
+        break;
+      }
+      destination = &info;
+    }
+    return destination;
+  }
+
   void VisitStmt_(const SeqStmtNode* op) final {
     if (active_loops.size()) {
       active_loops.back().reached_sequential_node = true;
@@ -418,12 +662,35 @@ class HoistInfoCollector : public StmtExprVisitor {
 
   // Lookup table for the currently active loops.
   std::unordered_set<const VarNode*> active_loop_vars;
+
+  // The buffers and data vars written inside of each loop.
+  std::unordered_map<const StmtNode*, LoopWriteCollector::WriteInfo> loop_writes;
+
+  // The alias information of the buffers.
+  BufferAliasInfo alias_info;
+
+  // The number of active loops at the definition of each buffer and
+  // variable defined in the body.
+  std::unordered_map<const Object*, size_t> def_depth;
+
+  // The number of conditional scopes currently visited.
+  int conditional_depth{0};
+
+  // The number of blocks currently visited.
+  int block_depth{0};
+
+  // The number of let binding values currently visited.
+  int binding_depth{0};
+
+  // Analyzer to prove that the loops iterate at least once.
+  arith::Analyzer analyzer;
 };
 
 class ExpressionHoister : public arith::IRMutatorWithAnalyzer {
  public:
-  static Stmt Hoist(Stmt stmt, HoistExpressionConfig config) {
-    auto loop_info = HoistInfoCollector::Collect(stmt, config);
+  static Stmt Hoist(Stmt stmt, HoistExpressionConfig config,
+                    BufferAliasInfo alias_info = BufferAliasInfo()) {
+    auto loop_info = HoistInfoCollector::Collect(stmt, config, std::move(alias_info));
 
     arith::Analyzer analyzer;
     ExpressionHoister hoister(std::move(loop_info), config, &analyzer);
@@ -445,6 +712,9 @@ class ExpressionHoister : public arith::IRMutatorWithAnalyzer {
       for (const auto& binding : info.let_bindings) {
         if (binding.IsEnabled(config)) {
           hoisted_let_bindings.insert(binding.var.get());
+          if (binding.hoist_from == HoistedLetBindings::kBufferLoad) {
+            hoisted_loads[binding.value.as<BufferLoadNode>()] = binding.var;
+          }
         }
       }
 
@@ -518,8 +788,18 @@ class ExpressionHoister : public arith::IRMutatorWithAnalyzer {
     }
   }
 
+  PrimExpr VisitExpr_(const BufferLoadNode* op) final {
+    auto it = hoisted_loads.find(op);
+    if (it != hoisted_loads.end()) {
+      return it->second;
+    }
+    return Parent::VisitExpr_(op);
+  }
+
   HoistExpressionConfig config_;
 
+  std::unordered_map<const BufferLoadNode*, Var> hoisted_loads;
+
   std::unordered_map<const StmtNode*, HoistInfoCollector::HoistInfo> loop_info_lookup;
   std::unordered_set<const VarNode*> hoisted_let_bindings;
 };
@@ -538,7 +818,16 @@ Pass HoistExpression() {
     if (!cfg.defined()) {
       cfg = AttrsWithDefaultValues<HoistExpressionConfig>();
     }
-    n->body = ExpressionHoister::Hoist(std::move(n->body), cfg.value());
+    BufferAliasInfo alias_info;
+    alias_info.noalias = f->HasNonzeroAttr(tir::attr::kNoAlias);
+    for (const Var& param : f->params) {
+      if (auto it = f->buffer_map.find(param); it != f->buffer_map.end()) {
+        alias_info.params.insert((*it).second->data.get());
+      } else if (param.dtype().is_handle()) {
+        alias_info.params.insert(param.get());
+      }
+    }
+    n->body = ExpressionHoister::Hoist(std::move(n->body), cfg.value(), std::move(alias_info));
     return f;
   };
   auto insertion_pass = CreatePrimFuncPass(pass_func, 0, "tir.InsertHoistedExpression", {});
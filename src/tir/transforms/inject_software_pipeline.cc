@@ -22,7 +22,9 @@
  * \brief Transform annotated loops into pipelined one that parallelize producers and consumers
  */
 #include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
 #include <tvm/tir/builtin.h>
+#include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
 #include <unordered_set>
@@ -322,6 +324,18 @@ class PipelineRewriter : public StmtExprMutator {
     return rewriter.BuildPipeline();
   }
 
+  static Stmt RewriteWarpSpecialized(
+      Map<Var, Buffer> buffer_data_to_buffer,
+      const std::unordered_set<Buffer, ObjectPtrHash, ObjectPtrEqual>& double_buffers,
+      const Array<Buffer> pipeline_allocs, const For& pipeline_loop,
+      const PipelineInfo& pipeline_info,
+      const std::unordered_map<const VarNode*, FragmentInfo>& fragment_info,
+      const Map<String, ObjectRef> preserved_annotations, const For& thread_loop, int num_slots) {
+    PipelineRewriter rewriter(buffer_data_to_buffer, double_buffers, pipeline_allocs, pipeline_loop,
+                              pipeline_info, fragment_info, preserved_annotations);
+    return rewriter.BuildWarpSpecializedPipeline(thread_loop, num_slots);
+  }
+
  private:
   PipelineRewriter(Map<Var, Buffer> buffer_data_to_buffer,
                    const std::unordered_set<Buffer, ObjectPtrHash, ObjectPtrEqual>& double_buffers,
@@ -377,6 +391,117 @@ class PipelineRewriter : public StmtExprMutator {
     return BlockRealize({}, Bool(true), block);
   }
 
+  /*!
+   * \brief Build the warp-specialized pipeline.
+   *
+   * The threads of \p thread_loop are doubled by the caller. The additional threads run the
+   * statements of stage 0 (producers) and the original threads run the statements of stage 1
+   * (consumers), each role in its own copy of the loop. The buffers passed from the producers to
+   * the consumers become ring buffers of \p num_slots versions, and every slot is guarded by two
+   * mbarriers: the producers arrive on the "full" barrier of a slot after writing it, and the
+   * consumers arrive on the "empty" barrier of the slot after reading it.
+   *
+   * \code
+   * for i in range(n):                  # producers, tx >= num_threads
+   *   if i >= num_slots:
+   *     wait(empty[i % num_slots], (i // num_slots + 1) % 2)
+   *   producer statements, with tx - num_threads as the thread index
+   *   arrive(full[i % num_slots])
+   * for i in range(n):                  # consumers, tx < num_threads
+   *   wait(full[i % num_slots], (i // num_slots) % 2)
+   *   consumer statements
+   *   arrive(empty[i % num_slots])
+   * \endcode
+   *
+   * \param thread_loop The loop bound to threadIdx.x that encloses the pipeline.
+   * \param num_slots The number of slots of the ring buffers.
+   * \return The result statement.
+   */
+  Stmt BuildWarpSpecializedPipeline(const For& thread_loop, int num_slots) {
+    const Var& thread_var = thread_loop->loop_var;
+    const PrimExpr& num_threads = thread_loop->extent;
+
+    // Step 1: Turn the buffers passed from the producers to the consumers into ring buffers.
+    std::unordered_map<Buffer, BufferAccessInfo, ObjectPtrHash, ObjectPtrEqual> infos =
+        GetBufferAccessInfo();
+    for (const Buffer& buffer : pipeline_allocs_) {
+      auto it = infos.find(buffer);
+      if (it != infos.end() && it->second.def == 0 && it->second.use == 1) {
+        buffer_remap_.Set(buffer, RewriteAllocBuffer(buffer, num_slots));
+      }
+    }
+
+    ordered_stmts_.resize(pipeline_info_.size());
+    for (const auto& pair : pipeline_info_) {
+      ordered_stmts_.Set(pair.second.order, pair.first);
+    }
+
+    // Step 2: Emit the loop of each role. The full barrier of slot i is at offset i and the empty
+    // barrier at offset num_slots + i.
+    Buffer barrier =
+        decl_buffer({Integer(2 * num_slots)}, DataType::UInt(64), "mbarrier", "shared");
+    auto f_barrier = [&barrier](const Op& op, PrimExpr offset, Array<PrimExpr> args) -> Stmt {
+      Array<PrimExpr> call_args{barrier->data, offset};
+      call_args.insert(call_args.end(), args.begin(), args.end());
+      return Evaluate(Call(DataType::Void(), op, call_args));
+    };
+    auto f_role = [&](bool is_producer) -> Stmt {
+      Var loop_var = pipeline_loop_->loop_var.copy_with_suffix("");
+      PrimExpr iter = loop_var - pipeline_loop_->min;
+      PrimExpr slot = floormod(iter, num_slots);
+      PrimExpr phase = floormod(floordiv(iter, num_slots), 2);
+      Array<Stmt> stmts;
+      if (is_producer) {
+        stmts.push_back(IfThenElse(iter >= num_slots,
+                                   f_barrier(builtin::ptx_wait_barrier(), slot + num_slots,
+                                             {floormod(floordiv(iter, num_slots) + 1, 2)})));
+      } else {
+        stmts.push_back(f_barrier(builtin::ptx_wait_barrier(), slot, {phase}));
+      }
+      for (const Block& block : ordered_stmts_) {
+        if ((pipeline_info_.at(block).stage == 0) != is_producer) {
+          continue;
+        }
+        Block new_block = Downcast<Block>(PipelineBodyRewriter(
+            buffer_data_to_buffer_, buffer_remap_, pipeline_loop_, true, fragment_info_)(block));
+        Map<Var, PrimExpr> vmap{{pipeline_loop_->loop_var, loop_var}};
+        if (is_producer) {
+          vmap.Set(thread_var, thread_var - num_threads);
+        }
+        stmts.push_back(BlockRealize({}, Bool(true), Downcast<Block>(Substitute(new_block, vmap))));
+      }
+      if (is_producer) {
+        stmts.push_back(f_barrier(builtin::ptx_arrive_barrier(), slot, {}));
+      } else {
+        stmts.push_back(f_barrier(builtin::ptx_arrive_barrier(), slot + num_slots, {}));
+      }
+      return For(loop_var, pipeline_loop_->min, pipeline_loop_->extent, pipeline_loop_->kind,
+                 SeqStmt(stmts), NullOpt, preserved_annotations_);
+    };
+
+    // Step 3: Initialize the barriers. The leading sync keeps the barriers from being initialized
+    // again while the threads are still in the previous execution of the pipeline.
+    Array<Stmt> init;
+    for (int i = 0; i < 2 * num_slots; ++i) {
+      init.push_back(f_barrier(builtin::ptx_init_barrier_thread_count(), i, {num_threads}));
+    }
+    Stmt sync =
+        Evaluate(Call(DataType::Int(32), builtin::tvm_storage_sync(), {StringImm("shared")}));
+    Stmt stmt = SeqStmt({sync, IfThenElse(thread_var == thread_loop->min, SeqStmt(init)), sync,
+                         IfThenElse(thread_var >= num_threads, f_role(true), f_role(false))});
+
+    // Step 4: Make a new block that contains the ring buffers and the barriers.
+    Array<Buffer> alloc_buffers;
+    for (const auto& alloc : pipeline_allocs_) {
+      alloc_buffers.push_back(buffer_remap_.Get(alloc).value_or(alloc));
+      buffer_data_to_buffer_.erase(alloc->data);
+    }
+    alloc_buffers.push_back(barrier);
+    Block block = MakeBlock(stmt, buffer_data_to_buffer_);
+    block.CopyOnWrite()->alloc_buffers = std::move(alloc_buffers);
+    return BlockRealize({}, Bool(true), block);
+  }
+
  private:
   /*!
    * \brief Analyze accesses to the buffers in the software pipeline.
@@ -993,6 +1118,60 @@ void BuildDependencyGraph(
   }
 }
 
+/*!
+ * \brief Guard the statements of a kernel outside its warp-specialized pipelines, so that only the
+ * consumer threads run them once the threads bound to threadIdx.x are doubled. The statements
+ * enclosing a pipeline are run by both roles.
+ */
+class ConsumerGuardInserter : public StmtMutator {
+ public:
+  ConsumerGuardInserter(Var thread_var, PrimExpr num_threads,
+                        const std::unordered_set<const StmtNode*>& pipelines)
+      : thread_var_(std::move(thread_var)),
+        num_threads_(std::move(num_threads)),
+        pipelines_(pipelines) {}
+
+  Stmt VisitStmt(const Stmt& stmt) final {
+    if (pipelines_.count(stmt.get())) {
+      return stmt;
+    }
+    bool encloses_pipeline = false;
+    PostOrderVisit(stmt, [&](const ObjectRef& obj) {
+      if (const auto* node = obj.as<StmtNode>()) {
+        encloses_pipeline = encloses_pipeline || pipelines_.count(node);
+      }
+    });
+    if (!encloses_pipeline) {
+      return IfThenElse(thread_var_ < num_threads_, stmt);
+    }
+    Array<PrimExpr> exprs;
+    if (const auto* loop = stmt.as<ForNode>()) {
+      exprs = {loop->min, loop->extent};
+    } else if (const auto* realize = stmt.as<BlockRealizeNode>()) {
+      exprs = realize->iter_values;
+      exprs.push_back(realize->predicate);
+    } else if (const auto* let = stmt.as<LetStmtNode>()) {
+      exprs = {let->value};
+    } else if (const auto* if_then_else = stmt.as<IfThenElseNode>()) {
+      exprs = {if_then_else->condition};
+    } else if (const auto* attr = stmt.as<AttrStmtNode>()) {
+      exprs = {attr->value};
+    }
+    for (const PrimExpr& expr : exprs) {
+      CHECK(!UsesVar(expr, [this](const VarNode* var) { return var == thread_var_.get(); }))
+          << "ValueError: The statements enclosing a warp-specialized software pipeline cannot "
+             "depend on "
+          << thread_var_ << ", got " << expr;
+    }
+    return StmtMutator::VisitStmt(stmt);
+  }
+
+ private:
+  Var thread_var_;
+  PrimExpr num_threads_;
+  const std::unordered_set<const StmtNode*>& pipelines_;
+};
+
 class PipelineInjector : private StmtExprMutator {
  public:
   static Stmt Inject(const PrimFunc& func) {
@@ -1051,7 +1230,85 @@ class PipelineInjector : private StmtExprMutator {
     }
   }
 
+  /*!
+   * \brief Check the warp-specialized pipeline only passes shared buffers allocated in the
+   * pipeline from the producers (stage 0) to the consumers (stage 1), and the consumers don't
+   * write shared buffers, which are only synchronized by the mbarriers of the pipeline.
+   */
+  void ValidateWarpSpecializedPipeline(const PipelineInfo& pipeline_info,
+                                       const Array<Buffer>& pipeline_allocs) {
+    std::unordered_set<const BufferNode*> allocs;
+    for (const Buffer& buffer : pipeline_allocs) {
+      allocs.insert(buffer.get());
+    }
+    std::unordered_set<const BufferNode*> consumer_reads;
+    for (const auto& pair : pipeline_info) {
+      CHECK(pair.second.stage == 0 || pair.second.stage == 1)
+          << "ValueError: The warp-specialized software pipeline only supports stage 0 "
+             "(producers) and stage 1 (consumers), got stage "
+          << pair.second.stage;
+      if (pair.second.stage == 1) {
+        for (const BufferRegion& read : pair.first->reads) {
+          consumer_reads.insert(read->buffer.get());
+        }
+      }
+    }
+    for (const auto& pair : pipeline_info) {
+      for (const BufferRegion& write : pair.first->writes) {
+        const Buffer& buffer = write->buffer;
+        bool is_shared = buffer.scope() == "shared" || buffer.scope() == "shared.dyn";
+        if (pair.second.stage == 1) {
+          CHECK(!is_shared) << "ValueError: The consumers of a warp-specialized software pipeline "
+                               "cannot write the shared buffer "
+                            << buffer->name;
+        } else if (is_shared) {
+          CHECK(allocs.count(buffer.get()))
+              << "ValueError: The producers of a warp-specialized software pipeline can only write "
+                 "the shared buffers allocated in the pipeline, got "
+              << buffer->name;
+        } else {
+          CHECK(!consumer_reads.count(buffer.get()))
+              << "ValueError: The warp-specialized software pipeline can only pass shared buffers "
+                 "from the producers to the consumers, got "
+              << buffer->name << " in scope " << buffer.scope();
+        }
+      }
+    }
+  }
+
+  /*!
+   * \brief Visit a loop bound to threadIdx.x. If it encloses warp-specialized pipelines, its
+   * threads are doubled and the statements outside the pipelines are guarded to run on the
+   * consumers.
+   */
+  Stmt VisitThreadLoop(const ForNode* op) {
+    Optional<For> outer_thread_loop = std::move(thread_loop_);
+    std::unordered_set<const StmtNode*> outer_pipelines = std::move(warp_specialized_pipelines_);
+    thread_loop_ = GetRef<For>(op);
+    warp_specialized_pipelines_.clear();
+
+    For for_node = Downcast<For>(StmtExprMutator::VisitStmt_(op));
+    if (!warp_specialized_pipelines_.empty()) {
+      ForNode* n = for_node.CopyOnWrite();
+      n->body = ConsumerGuardInserter(n->loop_var, n->extent, warp_specialized_pipelines_)(n->body);
+      n->extent = n->extent * 2;
+      if (n->thread_binding.defined() && n->thread_binding.value()->dom.defined()) {
+        IterVar iter_var = n->thread_binding.value();
+        iter_var.CopyOnWrite()->dom = Range::FromMinExtent(n->min, n->extent);
+        n->thread_binding = iter_var;
+      }
+    }
+
+    thread_loop_ = std::move(outer_thread_loop);
+    warp_specialized_pipelines_ = std::move(outer_pipelines);
+    return std::move(for_node);
+  }
+
   Stmt VisitStmt_(const ForNode* op) final {
+    if (op->kind == ForKind::kThreadBinding && op->thread_binding.defined() &&
+        op->thread_binding.value()->thread_tag == "threadIdx.x") {
+      return VisitThreadLoop(op);
+    }
     // Step 1: Recursively rewrite the children first.
     For for_node = Downcast<For>(StmtExprMutator::VisitStmt_(op));
     if (!HasPipelineAnnotation(op)) {
@@ -1131,7 +1388,8 @@ class PipelineInjector : private StmtExprMutator {
     for (const auto& kv : op->annotations) {
       const String& key = kv.first;
       if (kv.first != attr::software_pipeline_stage && kv.first != attr::software_pipeline_order &&
-          kv.first != attr::software_pipeline_async_stages) {
+          kv.first != attr::software_pipeline_async_stages &&
+          kv.first != attr::software_pipeline_warp_specialize) {
         preserved_annotations.Set(key, kv.second);
       }
     }
@@ -1148,9 +1406,32 @@ class PipelineInjector : private StmtExprMutator {
     ValidatePipelineBody(pipeline_info, original_order);
 
     // Step 4: Rewrite the pipeline body.
-    Stmt pipeline = PipelineRewriter::Rewrite(buffer_data_to_buffer_, double_buffers,
-                                              pipeline_allocs, GetRef<For>(op), pipeline_info,
-                                              fragment_info_, preserved_annotations);
+    Stmt pipeline{nullptr};
+    if (auto annot = op->annotations.Get(attr::software_pipeline_warp_specialize)) {
+      int num_slots = Downcast<Integer>(annot)->value;
+      CHECK_GE(num_slots, 2)
+          << "ValueError: The warp-specialized software pipeline needs at least 2 slots, got "
+          << num_slots;
+      CHECK(pipeline_async_stages.empty())
+          << "ValueError: The warp-specialized software pipeline cannot have async stages";
+      CHECK(thread_loop_.defined()) << "ValueError: The warp-specialized software pipeline should "
+                                       "be nested in a loop bound to threadIdx.x";
+      const For& thread_loop = thread_loop_.value();
+      const auto* num_threads = thread_loop->extent.as<IntImmNode>();
+      CHECK(is_zero(thread_loop->min) && num_threads && num_threads->value % 32 == 0)
+          << "ValueError: The warp-specialized software pipeline requires the loop bound to "
+             "threadIdx.x to start from 0 and have a multiple of the warp size as extent, got "
+          << thread_loop->extent;
+      ValidateWarpSpecializedPipeline(pipeline_info, pipeline_allocs);
+      pipeline = PipelineRewriter::RewriteWarpSpecialized(
+          buffer_data_to_buffer_, double_buffers, pipeline_allocs, GetRef<For>(op), pipeline_info,
+          fragment_info_, preserved_annotations, thread_loop, num_slots);
+      warp_specialized_pipelines_.insert(pipeline.get());
+    } else {
+      pipeline = PipelineRewriter::Rewrite(buffer_data_to_buffer_, double_buffers, pipeline_allocs,
+                                           GetRef<For>(op), pipeline_info, fragment_info_,
+                                           preserved_annotations);
+    }
 
     if (const auto* realize = op->body.as<BlockRealizeNode>()) {
       const auto& block = realize->block;
@@ -1220,6 +1501,10 @@ class PipelineInjector : private StmtExprMutator {
   std::unordered_map<const VarNode*, FragmentInfo> fragment_info_;
   std::unordered_set<Buffer, ObjectPtrHash, ObjectPtrEqual> double_buffers;
   Optional<String> global_symbol_;
+  /*! \brief The innermost loop bound to threadIdx.x. */
+  Optional<For> thread_loop_;
+  /*! \brief The warp-specialized pipelines rewritten in thread_loop_. */
+  std::unordered_set<const StmtNode*> warp_specialized_pipelines_;
 };
 
 }  // namespace software_pipeline
@@ -0,0 +1,347 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file inject_software_prefetch.cc
+ * \brief Automatic insertion of software prefetches in the innermost loops of CPU functions.
+ *
+ * For every strided access to a global buffer in an innermost serial loop, a prefetch of the
+ * element accessed `distance` iterations later is inserted at the start of the loop body. The
+ * stride is found by arith::DetectLinearEquation on the flattened index, and the distance is
+ * either given, or derived from the memory latency and the estimated cost of the loop body.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/pattern.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/expr.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_set>
+#include <vector>
+
+#include "ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+struct InjectSoftwarePrefetchConfigNode
+    : public tvm::AttrsNode<InjectSoftwarePrefetchConfigNode> {
+  bool enable;
+  int distance;
+  int memory_latency;
+  int cache_line_bytes;
+
+  TVM_DECLARE_ATTRS(InjectSoftwarePrefetchConfigNode,
+                    "tir.transform.InjectSoftwarePrefetchConfig") {
+    TVM_ATTR_FIELD(enable)
+        .describe("Whether to insert prefetches in all the innermost loops of CPU functions, "
+                  "instead of only under the software_prefetch_distance pragma")
+        .set_default(false);
+    TVM_ATTR_FIELD(distance)
+        .describe("The prefetch distance in loop iterations, 0 to derive it from the cost of the "
+                  "loop body")
+        .set_default(0);
+    TVM_ATTR_FIELD(memory_latency)
+        .describe("The latency of a memory access in cycles, used to derive the distance")
+        .set_default(200);
+    TVM_ATTR_FIELD(cache_line_bytes).describe("The size of a cache line").set_default(64);
+  }
+};
+
+class InjectSoftwarePrefetchConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(InjectSoftwarePrefetchConfig, Attrs,
+                                            InjectSoftwarePrefetchConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(InjectSoftwarePrefetchConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.InjectSoftwarePrefetch", InjectSoftwarePrefetchConfig);
+
+/*! \brief Estimates the cost of a loop body in cycles, counting one cycle per operation. */
+class LoopBodyCost : public StmtExprVisitor {
+ public:
+  static int64_t Estimate(const Stmt& body) {
+    LoopBodyCost cost;
+    cost(body);
+    return cost.cost_;
+  }
+
+ private:
+  void VisitExpr(const PrimExpr& expr) final {
+    if (!expr->IsInstance<VarNode>() && !expr->IsInstance<IntImmNode>() &&
+        !expr->IsInstance<FloatImmNode>()) {
+      cost_ += std::max(expr->dtype.lanes(), 1);
+    }
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    cost_ += std::max(op->value->dtype.lanes(), 1);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  int64_t cost_{0};
+};
+
+/*! \brief Collects the variables defined in a loop body, which a prefetch cannot refer to. */
+class BodyDefinedVars : public StmtExprVisitor {
+ public:
+  static std::unordered_set<const VarNode*> Collect(const Stmt& body) {
+    BodyDefinedVars collector;
+    collector(body);
+    return std::move(collector.vars_);
+  }
+
+ private:
+  void VisitStmt_(const LetStmtNode* op) final {
+    vars_.insert(op->var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    vars_.insert(op->buffer_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const DeclBufferNode* op) final {
+    vars_.insert(op->buffer->data.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const LetNode* op) final {
+    vars_.insert(op->var.get());
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  std::unordered_set<const VarNode*> vars_;
+};
+
+/*! \brief A strided access to a buffer in an innermost loop. */
+struct StridedAccess {
+  /*! \brief The accessed buffer. */
+  Buffer buffer;
+  /*! \brief The flattened index of the access, with the lanes of a ramp folded into its base. */
+  PrimExpr index;
+  /*! \brief The index at the first iteration of the loop. */
+  PrimExpr base;
+  /*! \brief The change of the index per iteration. */
+  int64_t stride;
+  /*! \brief Whether the buffer is written. */
+  bool is_write;
+};
+
+/*! \brief Collects the strided accesses to global buffers in an innermost loop body. */
+class StridedAccessCollector : public StmtExprVisitor {
+ public:
+  StridedAccessCollector(const Var& loop_var, const std::unordered_set<const VarNode*>& defined)
+      : loop_var_(loop_var), defined_(defined) {}
+
+  std::vector<StridedAccess> accesses;
+
+ private:
+  void VisitExpr_(const BufferLoadNode* op) final {
+    Record(op->buffer, op->indices, false);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    Record(op->buffer, op->indices, true);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void Record(const Buffer& buffer, const Array<PrimExpr>& indices, bool is_write) {
+    if (indices.size() != 1) {
+      return;
+    }
+    String scope = GetPtrStorageScope(buffer->data);
+    if (scope != "global" && scope != "") {
+      return;
+    }
+    PrimExpr index = indices[0];
+    if (const auto* ramp = index.as<RampNode>()) {
+      index = ramp->base;
+    }
+    if (!index.dtype().is_scalar() ||
+        UsesVar(index, [this](const VarNode* var) { return defined_.count(var); })) {
+      return;
+    }
+    Array<PrimExpr> coeffs = arith::DetectLinearEquation(index, {loop_var_});
+    if (coeffs.empty()) {
+      return;
+    }
+    const auto* stride = coeffs[0].as<IntImmNode>();
+    if (stride == nullptr || stride->value == 0) {
+      return;
+    }
+    accesses.push_back({buffer, index, coeffs[1], stride->value, is_write});
+  }
+
+  const Var& loop_var_;
+  const std::unordered_set<const VarNode*>& defined_;
+};
+
+/*!
+ * \brief Inserts the prefetches in the innermost serial loops, in the whole function if the
+ * pass is enabled by its config, otherwise only under the software_prefetch_distance pragma.
+ */
+class SoftwarePrefetchInjector : public StmtMutator {
+ public:
+  explicit SoftwarePrefetchInjector(const InjectSoftwarePrefetchConfig& cfg)
+      : cfg_(cfg), distance_(cfg->enable ? cfg->distance : -1) {}
+
+ private:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key != attr::pragma_software_prefetch_distance) {
+      return StmtMutator::VisitStmt_(op);
+    }
+    const auto* distance = op->value.as<IntImmNode>();
+    ICHECK(distance) << "The " << attr::pragma_software_prefetch_distance
+                     << " pragma expects an integer distance, but got " << op->value;
+    int64_t outer_distance = distance_;
+    distance_ = distance->value >= 0 ? distance->value : -1;
+    Stmt body = this->VisitStmt(op->body);
+    distance_ = outer_distance;
+    return body;
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    innermost_ = true;
+    Stmt stmt = StmtMutator::VisitStmt_(op);
+    bool innermost = innermost_;
+    // Tell the enclosing loop that it is not innermost.
+    innermost_ = false;
+    if (innermost && distance_ >= 0 && op->kind == ForKind::kSerial) {
+      stmt = InjectPrefetches(Downcast<For>(stmt));
+    }
+    return stmt;
+  }
+
+  Stmt InjectPrefetches(For loop) {
+    int64_t distance = distance_;
+    if (distance == 0) {
+      int64_t cost = std::max<int64_t>(LoopBodyCost::Estimate(loop->body), 1);
+      distance = std::min<int64_t>((cfg_->memory_latency + cost - 1) / cost, kMaxDistance);
+    }
+    if (const auto* extent = loop->extent.as<IntImmNode>()) {
+      if (extent->value <= distance) {
+        return std::move(loop);
+      }
+    }
+
+    StridedAccessCollector collector(loop->loop_var, BodyDefinedVars::Collect(loop->body));
+    collector(loop->body);
+
+    // Keep one access per buffer, stride and cache line.
+    std::vector<StridedAccess> streams;
+    for (const StridedAccess& access : collector.accesses) {
+      int64_t elem_bytes = access.buffer->dtype.bytes();
+      bool covered = false;
+      for (StridedAccess& stream : streams) {
+        if (!stream.buffer->data.same_as(access.buffer->data) || stream.stride != access.stride) {
+          continue;
+        }
+        const auto* diff = analyzer_.Simplify(access.base - stream.base).as<IntImmNode>();
+        if (diff && std::abs(diff->value) * elem_bytes < cfg_->cache_line_bytes) {
+          stream.is_write = stream.is_write && access.is_write;
+          covered = true;
+          break;
+        }
+      }
+      if (!covered && streams.size() < kMaxStreams) {
+        streams.push_back(access);
+      }
+    }
+    if (streams.empty()) {
+      return std::move(loop);
+    }
+
+    Array<Stmt> seq;
+    for (const StridedAccess& stream : streams) {
+      PrimExpr ahead = loop->loop_var + make_const(loop->loop_var.dtype(), distance);
+      PrimExpr ahead_index = Substitute(stream.index, Map<Var, PrimExpr>{{loop->loop_var, ahead}});
+      PrimExpr load = BufferLoad(stream.buffer, {ahead_index});
+      PrimExpr address = Call(DataType::Handle(), builtin::address_of(), {load});
+      Stmt prefetch = Evaluate(Call(stream.buffer->dtype, builtin::prefetch(),
+                                    {address, stream.is_write ? 1 : 0, 3, 1}));
+      // Only prefetch once per cache line when several iterations share one.
+      int64_t stride_bytes = std::abs(stream.stride) * stream.buffer->dtype.bytes();
+      int64_t iters_per_line = cfg_->cache_line_bytes / std::max<int64_t>(stride_bytes, 1);
+      if (iters_per_line > 1) {
+        PrimExpr iter = loop->loop_var - loop->min;
+        prefetch = IfThenElse(
+            floormod(iter, make_const(iter.dtype(), iters_per_line)) == make_zero(iter.dtype()),
+            prefetch);
+      }
+      seq.push_back(prefetch);
+    }
+    seq.push_back(loop->body);
+    loop.CopyOnWrite()->body = SeqStmt(seq);
+    return std::move(loop);
+  }
+
+  /*! \brief The largest distance derived from the cost of a loop body. */
+  static constexpr int64_t kMaxDistance = 64;
+  /*! \brief The largest number of streams prefetched in a loop. */
+  static constexpr size_t kMaxStreams = 8;
+
+  const InjectSoftwarePrefetchConfig& cfg_;
+  /*! \brief The distance in the current scope, 0 for automatic, negative to disable. */
+  int64_t distance_;
+  /*! \brief Whether no loop was found in the body of the loop being visited. */
+  bool innermost_{false};
+  arith::Analyzer analyzer_;
+};
+
+Stmt InjectSoftwarePrefetch(Stmt stmt, const InjectSoftwarePrefetchConfig& cfg) {
+  return SoftwarePrefetchInjector(cfg)(std::move(stmt));
+}
+
+namespace transform {
+
+Pass InjectSoftwarePrefetch() {
+  auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
+    Optional<Target> target = f->GetAttr<Target>(tvm::attr::kTarget);
+    if (!target.defined() || target.value()->kind->name != "llvm" ||
+        target.value()->GetTargetDeviceType() != kDLCPU) {
+      return f;
+    }
+    auto cfg = ctx->GetConfig<InjectSoftwarePrefetchConfig>("tir.InjectSoftwarePrefetch");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<InjectSoftwarePrefetchConfig>();
+    }
+    auto* n = f.CopyOnWrite();
+    n->body = InjectSoftwarePrefetch(std::move(n->body), cfg.value());
+    return f;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.InjectSoftwarePrefetch", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.InjectSoftwarePrefetch").set_body_typed(InjectSoftwarePrefetch);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
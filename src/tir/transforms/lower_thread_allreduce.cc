@@ -29,6 +29,7 @@
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <functional>
 #include <unordered_set>
 
 #include "../../runtime/thread_storage_scope.h"
@@ -70,6 +71,17 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       thread_extents_.push_back(op);
       Stmt ret = StmtExprMutator::VisitStmt_(op);
       thread_extents_.pop_back();
+      if (thread_extents_.empty() && cluster_dims_.empty()) {
+        ret = InitGridWorkspaces(ret);
+      }
+      return ret;
+    } else if (op->attr_key == attr::cluster_dims) {
+      cluster_dims_.push_back(Downcast<Array<Integer>>(op->node));
+      Stmt ret = StmtExprMutator::VisitStmt_(op);
+      cluster_dims_.pop_back();
+      if (thread_extents_.empty() && cluster_dims_.empty()) {
+        ret = InitGridWorkspaces(ret);
+      }
       return ret;
     } else if (op->attr_key == attr::reduce_scope) {
       const CommReducerNode* combiner = op->node.as<CommReducerNode>();
@@ -219,6 +231,29 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       }
     }
 
+    // The reduction over blockIdx is done after the reduction within the block, on the
+    // partial result of each block.
+    std::vector<const AttrStmtNode*> vblock_red, vblock_par;
+    for (const AttrStmtNode* attr : thread_extents_) {
+      IterVar iv = Downcast<IterVar>(attr->node);
+      runtime::ThreadScope scope = runtime::ThreadScope::Create(iv->thread_tag);
+      if (scope.rank == 0) {
+        if (reduce_set.erase(iv->var.get())) {
+          if (!is_one(attr->value)) {
+            vblock_red.push_back(attr);
+          }
+        } else {
+          vblock_par.push_back(attr);
+        }
+      }
+    }
+    auto block_dim_index = [](const AttrStmtNode* a, const AttrStmtNode* b) {
+      return runtime::ThreadScope::Create(Downcast<IterVar>(a->node)->thread_tag).dim_index <
+             runtime::ThreadScope::Create(Downcast<IterVar>(b->node)->thread_tag).dim_index;
+    };
+    std::sort(vblock_red.begin(), vblock_red.end(), block_dim_index);
+    std::sort(vblock_par.begin(), vblock_par.end(), block_dim_index);
+
     size_t nmatch = 0;
     std::vector<ThreadEntry> vred, vpar;
     for (const AttrStmtNode* attr : thread_extents_) {
@@ -438,6 +473,11 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
         for (size_t i = 0; i < size; ++i) {
           stores.push_back(BufferStore(buffers[i], values[i], {0}));
         }
+        if (!vblock_red.empty()) {
+          stores.push_back(MakeCrossBlockAllreduce(combiner, types, buffers, vblock_red,
+                                                   vblock_par, reduce_index, group_index,
+                                                   group_extent));
+        }
         return SeqStmt::Flatten(stores);
       }
       // This sync is necessary because there might be incomplete read of
@@ -471,6 +511,11 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
       }
     }
 
+    if (!vblock_red.empty()) {
+      seq.push_back(MakeCrossBlockAllreduce(combiner, types, buffers, vblock_red, vblock_par,
+                                            reduce_index, group_index, group_extent));
+    }
+
     // Fix all local allocations as all statements are built.
     Stmt body = SeqStmt::Flatten(seq);
     for (Buffer buf : local_bufs) {
@@ -590,6 +635,225 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
     }
     return SeqStmt::Flatten(seq);
   }
+  // Reduce the partial results of the blocks reduced by vblock_red.
+  //
+  // If the innermost thread block cluster spans exactly the reduced blocks, the blocks
+  // exchange their partial results through distributed shared memory (sm_90):
+  //
+  //   red_cluster[group_index] <- partial        (reduce_index == 0)
+  //   cluster_sync
+  //   acc <- reduction of red_cluster[group_index] of the blocks of rank 0 .. C-1
+  //   cluster_sync
+  //
+  // Otherwise the partial results go through a global workspace, allocated outside of the
+  // kernel, synchronized with the global barrier. As all the blocks of the grid wait on the
+  // barrier, they all must be resident on the device at the same time.
+  //
+  // The result is then written back to where the in-block result lives, so that the
+  // remapped loads of the reduction buffers see the result across the blocks.
+  Stmt MakeCrossBlockAllreduce(const CommReducerNode* combiner, const std::vector<DataType>& types,
+                               const std::vector<Buffer>& buffers,
+                               const std::vector<const AttrStmtNode*>& vblock_red,
+                               const std::vector<const AttrStmtNode*>& vblock_par,
+                               PrimExpr reduce_index, PrimExpr group_index, int group_extent) {
+    ICHECK_EQ(target_->kind->name, "cuda")
+        << "The reduction across thread blocks is only supported on cuda";
+    size_t size = types.size();
+    PrimExpr is_reduce_lead = reduce_index == make_zero(reduce_index.dtype());
+
+    // The partial result of the block, and whether it lives in shared memory.
+    std::vector<BufferLoad> partials;
+    std::vector<bool> shared_partials;
+    for (size_t i = 0; i < size; ++i) {
+      const VarNode* buffer_var = buffers[i]->data.get();
+      if (auto it = load_remap_.find(buffer_var); it != load_remap_.end()) {
+        partials.push_back(Downcast<BufferLoad>(it->second));
+        shared_partials.push_back(!warp_allocs_.count(alloc_remap_.at(buffer_var).get()));
+      } else {
+        partials.push_back(BufferLoad(buffers[i], {0}));
+        shared_partials.push_back(false);
+      }
+    }
+
+    std::vector<Stmt> seq;
+    std::vector<Buffer> acc_bufs, cluster_bufs;
+    for (size_t i = 0; i < size; ++i) {
+      acc_bufs.push_back(decl_buffer({1}, types[i], "red_acc" + std::to_string(i)));
+    }
+    // Emit acc <- reduction of fload(r) over r in [0, num_ranks).
+    auto freduce = [&](std::function<PrimExpr(size_t, PrimExpr)> fload, PrimExpr num_ranks,
+                       ForKind kind) {
+      for (size_t i = 0; i < size; ++i) {
+        seq.push_back(BufferStore(acc_bufs[i], fload(i, make_zero(DataType::Int(32))), {0}));
+      }
+      Var r("r", DataType::Int(32));
+      Array<Var> a_vars, b_vars;
+      Array<PrimExpr> a, b;
+      for (size_t i = 0; i < size; ++i) {
+        a_vars.push_back(Var("a_" + std::to_string(i), types[i]));
+        b_vars.push_back(Var("b_" + std::to_string(i), types[i]));
+        a.push_back(a_vars[i]);
+        b.push_back(b_vars[i]);
+      }
+      Array<PrimExpr> ret = (*combiner)(a, b);
+      std::vector<Stmt> stores;
+      for (size_t i = 0; i < size; ++i) {
+        stores.push_back(BufferStore(acc_bufs[i], ret[i], {0}));
+      }
+      Stmt body = SeqStmt::Flatten(stores);
+      for (size_t i = 0; i < size; ++i) {
+        body = LetStmt(b_vars[i], fload(i, r), body);
+        body = LetStmt(a_vars[i], BufferLoad(acc_bufs[i], {0}), body);
+      }
+      seq.push_back(For(r, 1, analyzer_.Simplify(num_ranks - 1), kind, body));
+    };
+
+    Optional<Array<Integer>> cluster = NullOpt;
+    int cluster_size = 1;
+    if (!cluster_dims_.empty()) {
+      cluster = cluster_dims_.back();
+      ICHECK_EQ(cluster.value().size(), 3U) << "The cluster dims must be given in x, y and z";
+      std::vector<int64_t> expected(3, 1);
+      for (const AttrStmtNode* attr : vblock_red) {
+        int dim_index =
+            runtime::ThreadScope::Create(Downcast<IterVar>(attr->node)->thread_tag).dim_index;
+        const auto* extent = attr->value.as<IntImmNode>();
+        expected[dim_index] = extent ? extent->value : -1;
+      }
+      for (int d = 0; d < 3; ++d) {
+        if (cluster.value()[d]->value != expected[d]) {
+          cluster = NullOpt;
+          break;
+        }
+        cluster_size *= expected[d];
+      }
+    }
+
+    if (cluster.defined()) {
+      for (size_t i = 0; i < size; ++i) {
+        Buffer buf = decl_buffer({group_extent}, types[i], "red_cluster" + std::to_string(i));
+        cluster_bufs.push_back(buf);
+        seq.push_back(IfThenElse(is_reduce_lead, BufferStore(buf, partials[i], {group_index})));
+      }
+      seq.push_back(Evaluate(Call(DataType::Void(), builtin::ptx_cluster_sync(), {})));
+      freduce(
+          [&](size_t i, PrimExpr rank) -> PrimExpr {
+            return Call(types[i], builtin::ptx_ld_shared_cluster(),
+                        {cluster_bufs[i]->data, group_index, rank});
+          },
+          cluster_size, ForKind::kUnrolled);
+      // The shared memory of a block must outlive the loads of the other blocks.
+      seq.push_back(Evaluate(Call(DataType::Void(), builtin::ptx_cluster_sync(), {})));
+    } else {
+      PrimExpr rblock = make_zero(DataType::Int(32));
+      PrimExpr num_rblocks = make_const(DataType::Int(32), 1);
+      for (const AttrStmtNode* attr : vblock_red) {
+        rblock = rblock + Downcast<IterVar>(attr->node)->var * num_rblocks;
+        num_rblocks = num_rblocks * attr->value;
+      }
+      PrimExpr pblock = make_zero(DataType::Int(32));
+      PrimExpr num_pblocks = make_const(DataType::Int(32), 1);
+      for (const AttrStmtNode* attr : vblock_par) {
+        pblock = pblock + Downcast<IterVar>(attr->node)->var * num_pblocks;
+        num_pblocks = num_pblocks * attr->value;
+      }
+      rblock = analyzer_.Simplify(rblock);
+      num_rblocks = analyzer_.Simplify(num_rblocks);
+      PrimExpr group_base = analyzer_.Simplify((pblock * group_extent + group_index) * num_rblocks);
+      PrimExpr num_slots = analyzer_.Simplify(num_pblocks * group_extent * num_rblocks);
+      PrimExpr is_block_lead = const_true();
+      for (const AttrStmtNode* attr : thread_extents_) {
+        IterVar iv = Downcast<IterVar>(attr->node);
+        if (runtime::ThreadScope::Create(iv->thread_tag).rank == 1) {
+          is_block_lead = is_block_lead && iv->var == make_zero(iv->var.dtype());
+        }
+      }
+      Stmt global_sync =
+          Evaluate(Call(DataType::Int(32), builtin::tvm_storage_sync(),
+                        {StringImm("global"), analyzer_.Simplify(is_block_lead),
+                         analyzer_.Simplify(num_rblocks * num_pblocks)}));
+
+      std::vector<Buffer> grid_bufs;
+      for (size_t i = 0; i < size; ++i) {
+        Buffer buf =
+            decl_buffer({num_slots}, types[i], "red_grid" + std::to_string(i), "global");
+        grid_bufs.push_back(buf);
+        grid_workspaces_.push_back(buf);
+        seq.push_back(
+            IfThenElse(is_reduce_lead, BufferStore(buf, partials[i], {group_base + rblock})));
+      }
+      seq.push_back(global_sync);
+      freduce(
+          [&](size_t i, PrimExpr rank) -> PrimExpr {
+            return BufferLoad(grid_bufs[i], {group_base + rank});
+          },
+          num_rblocks, ForKind::kSerial);
+      // The workspace must not be overwritten before all the blocks have read it.
+      seq.push_back(global_sync);
+    }
+
+    // Write the result back.
+    bool has_shared_partial = false;
+    for (size_t i = 0; i < size; ++i) {
+      Stmt store = BufferStore(partials[i]->buffer, BufferLoad(acc_bufs[i], {0}),
+                               partials[i]->indices);
+      if (shared_partials[i]) {
+        has_shared_partial = true;
+        store = IfThenElse(is_reduce_lead, store);
+      }
+      seq.push_back(store);
+    }
+    if (has_shared_partial) {
+      seq.push_back(SyncThread("shared"));
+    }
+
+    Stmt body = SeqStmt::Flatten(seq);
+    for (const Buffer& buf : acc_bufs) {
+      body = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), body);
+      new_storage_scopes_[buf->data.get()] = "local";
+    }
+    for (const Buffer& buf : cluster_bufs) {
+      body = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), body);
+      new_storage_scopes_[buf->data.get()] = "shared";
+    }
+    return body;
+  }
+
+  // Allocate the global workspaces of the reductions across thread blocks of the kernel
+  // outside of it, and set up the global barrier the same way as ThreadSync does.
+  Stmt InitGridWorkspaces(Stmt kernel) {
+    if (grid_workspaces_.empty()) {
+      return kernel;
+    }
+    const auto* attr = kernel.as<AttrStmtNode>();
+    ICHECK(attr);
+    bool has_kinit = false;
+    PostOrderVisit(kernel, [&has_kinit](const ObjectRef& node) {
+      if (const auto* call = node.as<CallNode>()) {
+        has_kinit |= call->op.same_as(builtin::tvm_global_barrier_kinit());
+      }
+    });
+    Stmt body = attr->body;
+    for (const Buffer& buf : grid_workspaces_) {
+      body = AttrStmt(buf->data, attr::volatile_scope, 1, body);
+    }
+    if (!has_kinit) {
+      Stmt kinit = Evaluate(Call(DataType::Int(32), builtin::tvm_global_barrier_kinit(), {}));
+      body = SeqStmt({kinit, body});
+    }
+    Stmt ret = AttrStmt(attr->node, attr->attr_key, attr->value, body);
+    if (!has_kinit) {
+      Array<PrimExpr> pargs = {StringImm(runtime::symbol::tvm_prepare_global_barrier)};
+      Stmt prep = Evaluate(Call(DataType::Int(32), builtin::tvm_call_packed(), pargs));
+      ret = SeqStmt({prep, ret});
+    }
+    for (const Buffer& buf : grid_workspaces_) {
+      ret = Allocate(buf->data, buf->dtype, buf->shape, const_true(buf->dtype.lanes()), ret);
+    }
+    grid_workspaces_.clear();
+    return ret;
+  }
+
   // Flatten the thread index.
   // Also return a warp number,
   PrimExpr FlattenThread(const std::vector<ThreadEntry>& tvec, int* out_total_extent) {
@@ -693,6 +957,10 @@ class ThreadAllreduceBuilder final : public StmtExprMutator {
 
   // surrounding scope of thread extent.
   std::vector<const AttrStmtNode*> thread_extents_;
+  // surrounding thread block cluster dims.
+  std::vector<Array<Integer>> cluster_dims_;
+  // The global workspaces of the reductions across thread blocks in the current kernel.
+  std::vector<Buffer> grid_workspaces_;
   std::vector<const CommReducerNode*> reduce_combiner_;
   // The load remap
   std::unordered_map<const VarNode*, PrimExpr> load_remap_;
@@ -177,6 +177,98 @@ class SubroutineCallRewriter : public StmtExprMutator {
   bool made_change_{false};
 };
 
+class DirectCallRewriter : public StmtExprMutator {
+ public:
+  static Optional<Stmt> Apply(const Map<GlobalVar, GlobalVar>& direct_callees, Stmt stmt) {
+    DirectCallRewriter rewriter(direct_callees);
+    stmt = rewriter.VisitStmt(std::move(stmt));
+    if (rewriter.made_change_) {
+      return stmt;
+    } else {
+      return NullOpt;
+    }
+  }
+
+ private:
+  explicit DirectCallRewriter(const Map<GlobalVar, GlobalVar>& direct_callees)
+      : direct_callees(direct_callees) {}
+
+  PrimExpr VisitExpr_(const CallNode* op) override {
+    auto node = Downcast<Call>(StmtExprMutator::VisitExpr_(op));
+    if (auto* gvar_ptr = node->op.as<GlobalVarNode>()) {
+      if (auto impl = direct_callees.Get(GetRef<GlobalVar>(gvar_ptr))) {
+        made_change_ = true;
+        return Call(node->dtype, impl.value(), node->args, node->span);
+      }
+    }
+    return node;
+  }
+  const Map<GlobalVar, GlobalVar>& direct_callees;
+  bool made_change_{false};
+};
+
+/* \brief Split the externally visible subroutines into an internal implementation and a
+ * PackedFunc wrapper calling it.
+ *
+ * The subroutine calls within the module then call the implementation directly, without
+ * packing their arguments. Only subroutines without a buffer_map are split, as their callers
+ * pass the parameters as they are.
+ *
+ * \returns The map from the split subroutines to their implementations.
+ */
+Map<GlobalVar, GlobalVar> SplitDirectCallees(IRModule* mod,
+                                             const Map<GlobalVar, String>& packed_func_methods) {
+  std::unordered_set<const GlobalVarNode*> called;
+  for (const auto& [gvar, base_func] : (*mod)->functions) {
+    if (auto func = base_func.as<PrimFunc>()) {
+      PostOrderVisit(func.value()->body, [&](const ObjectRef& node) {
+        if (auto* call = node.as<CallNode>()) {
+          if (auto* callee = call->op.as<GlobalVarNode>()) called.insert(callee);
+        }
+      });
+    }
+  }
+
+  Map<GlobalVar, GlobalVar> direct_callees;
+  IRModule updates;
+  for (const auto& [gvar, base_func] : (*mod)->functions) {
+    auto func = base_func.as<PrimFunc>();
+    if (!func || !called.count(gvar.get()) || !packed_func_methods.count(gvar) ||
+        !func.value()->buffer_map.empty()) {
+      continue;
+    }
+    std::string impl_name = gvar->name_hint + "_impl";
+    for (int i = 1; (*mod)->ContainGlobalVar(impl_name); ++i) {
+      impl_name = gvar->name_hint + "_impl" + std::to_string(i);
+    }
+    GlobalVar impl_gvar(impl_name);
+    PrimFunc impl = WithoutAttr(func.value(), tvm::attr::kGlobalSymbol);
+    updates->Add(impl_gvar, impl);
+
+    PrimFunc wrapper = func.value();
+    Array<Var> params;
+    for (const Var& param : wrapper->params) {
+      params.push_back(param.copy_with_suffix(""));
+    }
+    Array<PrimExpr> args(params.begin(), params.end());
+    PrimExpr call;
+    if (auto* ret_type = wrapper->ret_type.as<PrimTypeNode>()) {
+      call = Call(ret_type->dtype, builtin::ret(), {Call(ret_type->dtype, impl_gvar, args)});
+    } else {
+      call = Call(DataType::Void(), impl_gvar, args);
+    }
+    auto* wrapper_ptr = wrapper.CopyOnWrite();
+    wrapper_ptr->params = params;
+    wrapper_ptr->body = Evaluate(call);
+    updates->Add(gvar, wrapper);
+    direct_callees.Set(gvar, impl_gvar);
+  }
+  if (updates->functions.size()) {
+    mod->CopyOnWrite()->Update(updates);
+  }
+  return direct_callees;
+}
+
 }  // namespace
 
 inline Stmt MakeAssertEQ(PrimExpr lhs, PrimExpr rhs, std::string msg) {
@@ -379,6 +471,8 @@ PrimFunc MakePackedAPI(PrimFunc func) {
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_direct_subroutine_calls", Bool);
+
 Pass MakePackedAPI() {
   auto pass_func = [](IRModule mod, PassContext ctx) {
     Map<GlobalVar, String> packed_func_methods;
@@ -391,6 +485,11 @@ Pass MakePackedAPI() {
       }
     }
 
+    Map<GlobalVar, GlobalVar> direct_callees;
+    if (ctx->GetConfig<Bool>("tir.enable_direct_subroutine_calls", Bool(false)).value()) {
+      direct_callees = SplitDirectCallees(&mod, packed_func_methods);
+    }
+
     IRModuleNode* mptr = mod.CopyOnWrite();
     IRModule updates;
 
@@ -399,6 +498,9 @@ Pass MakePackedAPI() {
         auto func = opt.value();
         auto orig_func = func;
 
+        if (auto body = DirectCallRewriter::Apply(direct_callees, func->body)) {
+          func.CopyOnWrite()->body = body.value();
+        }
         if (auto body = SubroutineCallRewriter::Apply(packed_func_methods, func->body)) {
           func.CopyOnWrite()->body = body.value();
         }
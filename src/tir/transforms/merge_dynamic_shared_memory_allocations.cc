@@ -21,12 +21,23 @@
  * \file merge_dynamic_shared_memory_allocations.cc
  * \brief Each GPU kernel is allowed to have only one dynamic shared memory allocation.
  * This pass merges multiple TIR-level dynamic shared memory allocations into one allocation.
+ *
+ * If the "tir.merge_static_smem" pass config option is set, the static shared memory
+ * allocations are planned together with the dynamic ones, so that buffers of both kinds whose
+ * lifetimes do not overlap share the same memory. The merged allocation is dynamic if any of the
+ * merged buffers is dynamic, and static otherwise.
+ *
+ * As the pass runs after ThreadSync, the memory of a buffer is only reused once a barrier
+ * follows its last access, so that no thread writes the new buffer while another thread may
+ * still access the old one.
  */
 #include <tvm/runtime/registry.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <list>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -40,11 +51,18 @@ namespace tir {
 using runtime::StorageRank;
 using runtime::StorageScope;
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.merge_static_smem", Bool);
+
 bool IsDynamicSharedMemory(Var buffer_var) {
   StorageScope storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(buffer_var));
   return storage_scope.rank == runtime::StorageRank::kShared && storage_scope.tag == ".dyn";
 }
 
+bool IsStaticSharedMemory(Var buffer_var) {
+  StorageScope storage_scope = runtime::StorageScope::Create(GetPtrStorageScope(buffer_var));
+  return storage_scope.rank == runtime::StorageRank::kShared && storage_scope.tag == "";
+}
+
 /*!
  * \brief collect the mapping from the buffer var to its allocate
  */
@@ -53,11 +71,15 @@ class AllocateCollector : public StmtExprVisitor {
   void VisitStmt_(const AllocateNode* op) final {
     if (IsDynamicSharedMemory(op->buffer_var)) {
       dyn_shmem_allocs_[op->buffer_var.get()] = op;
+    } else if (IsStaticSharedMemory(op->buffer_var)) {
+      static_shmem_allocs_[op->buffer_var.get()] = op;
     }
     StmtExprVisitor::VisitStmt_(op);
   }
   // The mapping from the original buffer var to its allocate
   std::unordered_map<const VarNode*, const AllocateNode*> dyn_shmem_allocs_;
+  // The mapping from the original static shared buffer var to its allocate
+  std::unordered_map<const VarNode*, const AllocateNode*> static_shmem_allocs_;
 };
 
 // Find a linear pattern of storage access
@@ -75,6 +97,10 @@ class AllocateCollector : public StmtExprVisitor {
 //
 class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
  public:
+  explicit DynSharedMemLinearAccessPatternFinder(
+      const std::unordered_map<const VarNode*, const AllocateNode*>& shmem_allocs)
+      : shmem_allocs_(shmem_allocs) {}
+
   /*! \brief record the touch list of statement. */
   struct StmtEntry {
     // The statement
@@ -86,6 +112,8 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     int64_t scope_pair_offset{0};
     // The buffer variables this statement touched.
     std::vector<const VarNode*> touched;
+    // Whether the statement is a barrier of the threads of a block.
+    bool is_sync{false};
   };
   // The scope of each allocation
   struct AllocEntry {
@@ -112,8 +140,9 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     auto it = alloc_info_.find(buf);
     if (it != alloc_info_.end() && it->second.alloc) {
       ICHECK_LT(it->second.level, scope_.size());
-      if (IsDynamicSharedMemory(GetRef<Var>(buf))) {
+      if (shmem_allocs_.count(buf)) {
         scope_[it->second.level].touched.push_back(buf);
+        last_access_index_[buf] = linear_seq_.size();
       }
     }
     StmtEntry e = scope_.back();
@@ -130,7 +159,8 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     StmtExprVisitor::VisitStmt_(op);
     StmtEntry e = scope_.back();
     scope_.pop_back();
-    if (e.touched.size() != 0) {
+    e.is_sync = IsBlockSync(op->value);
+    if (e.touched.size() != 0 || e.is_sync) {
       e.stmt = op;
       linear_seq_.push_back(e);
     }
@@ -143,8 +173,9 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     auto it = alloc_info_.find(buf);
     if (it != alloc_info_.end() && it->second.alloc) {
       ICHECK_LT(it->second.level, scope_.size()) << "Load memory in places other than store.";
-      if (IsDynamicSharedMemory(GetRef<Var>(buf))) {
+      if (shmem_allocs_.count(buf)) {
         scope_[it->second.level].touched.push_back(buf);
+        last_access_index_[buf] = linear_seq_.size();
       }
     }
   }
@@ -164,8 +195,9 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
     auto it = alloc_info_.find(buf);
     if (it != alloc_info_.end() && it->second.alloc) {
       ICHECK_LT(it->second.level, scope_.size());
-      if (IsDynamicSharedMemory(GetRef<Var>(buf))) {
+      if (shmem_allocs_.count(buf)) {
         scope_[it->second.level].touched.push_back(buf);
+        last_access_index_[buf] = linear_seq_.size();
       }
     }
   }
@@ -215,8 +247,22 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
   std::vector<StmtEntry> linear_seq_;
   // The storage scope of each buffer
   std::unordered_map<const VarNode*, AllocEntry> alloc_info_;
+  // The index in linear_seq_ from which a barrier follows the last access to each buffer.
+  std::unordered_map<const VarNode*, size_t> last_access_index_;
 
  private:
+  /*! \brief Whether the expression synchronizes all the threads of a block. */
+  static bool IsBlockSync(const PrimExpr& value) {
+    const auto* call = value.as<CallNode>();
+    if (call == nullptr || !call->op.same_as(builtin::tvm_storage_sync())) {
+      return false;
+    }
+    const auto* scope = call->args[0].as<StringImmNode>();
+    return scope != nullptr && scope->value != "warp";
+  }
+
+  // The buffers to plan.
+  const std::unordered_map<const VarNode*, const AllocateNode*>& shmem_allocs_;
   // Whether already in thread env.
   bool in_thread_env_{false};
   // The scope stack.
@@ -229,18 +275,22 @@ class DynSharedMemLinearAccessPatternFinder final : public StmtExprVisitor {
 class DynamicSharedMemoryRewriter : public StmtExprMutator {
  public:
   explicit DynamicSharedMemoryRewriter(
-      const std::unordered_map<const VarNode*, const AllocateNode*>& dyn_shmem_allocs)
-      : dyn_shmem_allocs_{dyn_shmem_allocs} {}
+      const std::unordered_map<const VarNode*, const AllocateNode*>& dyn_shmem_allocs,
+      bool is_dynamic = true)
+      : dyn_shmem_allocs_{dyn_shmem_allocs},
+        merged_buf_var_{is_dynamic ? "buf_dyn_shmem" : "buf_shmem",
+                        PointerType(PrimType(DataType::UInt(8)),
+                                    is_dynamic ? "shared.dyn" : "shared")} {}
 
   /*!
    * \brief plan the memory reuse for all the buffer allocated in the statement
    * \param stmt the statement
    */
   void PlanReuse(const Stmt& stmt) {
-    DynSharedMemLinearAccessPatternFinder finder;
+    DynSharedMemLinearAccessPatternFinder finder(dyn_shmem_allocs_);
     finder(stmt);
     this->LivenessAnalysis(finder.linear_seq_);
-    this->PlanMemory(finder.linear_seq_);
+    this->PlanMemory(finder.linear_seq_, finder.last_access_index_);
   }
 
  private:
@@ -293,7 +343,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   }
 
   Stmt VisitStmt_(const AllocateNode* op) final {
-    if (IsDynamicSharedMemory(op->buffer_var)) {
+    if (IsMerged(op->buffer_var)) {
       return StmtExprMutator::VisitStmt(op->body);
     }
     return StmtExprMutator::VisitStmt_(op);
@@ -319,7 +369,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
 
   template <typename Node>
   Node VisitBufferAccess(Node node) {
-    if (IsDynamicSharedMemory(node->buffer->data)) {
+    if (IsMerged(node->buffer->data)) {
       ICHECK_EQ(node->indices.size(), 1)
           << "MergeDynamicSharedMemoryAllocations expects flat memory buffers, "
           << "and is to be run after "
@@ -342,7 +392,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       return it->second;
     }
 
-    if (IsDynamicSharedMemory(buffer->data)) {
+    if (IsMerged(buffer->data)) {
       ICHECK_EQ(buffer->shape.size(), 1)
           << "Buffer " << buffer << " has shape " << buffer->shape << ".  "
           << "MergeDynamicSharedMemoryAllocations expects flat memory buffers, "
@@ -361,7 +411,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       ICHECK_EQ(op->args.size(), 5U);
       DataType dtype = op->args[0].dtype();
       Var buffer = Downcast<Var>(op->args[1]);
-      if (!IsDynamicSharedMemory(buffer)) {
+      if (!IsMerged(buffer)) {
         return StmtExprMutator::VisitExpr_(op);
       }
       PrimExpr extra_offset = GetBufferOffset(buffer, dtype);
@@ -375,6 +425,9 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
     }
   }
 
+  /*! \brief Whether the buffer var is one of the merged allocations. */
+  bool IsMerged(const Var& buffer_var) const { return dyn_shmem_allocs_.count(buffer_var.get()); }
+
   PrimExpr GetBufferOffset(Var buffer_var, DataType dtype) {
     auto it = buffer_byte_offsets_.find(buffer_var.get());
     ICHECK(it != buffer_byte_offsets_.end());
@@ -436,12 +489,24 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   /*!
    * \brief Memory plan algorithm
    * \param seq the linear pattern of storage access
-   * \param alloc_info
+   * \param last_access_index the index in seq from which a barrier follows the last access
+   * to each buffer
    */
-  void PlanMemory(const std::vector<StmtEntry>& seq) {
-    std::unordered_set<const VarNode*> inplace_flag;
+  void PlanMemory(const std::vector<StmtEntry>& seq,
+                  const std::unordered_map<const VarNode*, size_t>& last_access_index) {
+    // The buffers killed before a barrier follows their last access, which cannot be reused yet.
+    std::vector<const VarNode*> pending_free;
+    // The index of the last barrier seen, if any.
+    int64_t last_sync_index = -1;
 
     for (size_t i = 0; i < seq.size(); ++i) {
+      if (seq[i].is_sync) {
+        last_sync_index = static_cast<int64_t>(i);
+        for (const VarNode* var : pending_free) {
+          this->Free(var);
+        }
+        pending_free.clear();
+      }
       auto it = event_map_.find(seq[i].stmt);
       // scope_pair_offset <= 0 means it is either
       // - leaf stmt(offset = 0)
@@ -449,7 +514,13 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       // In both cases, we need to handle the kill event correctly
       if (it != event_map_.end() && seq[i].scope_pair_offset <= 0) {
         for (const VarNode* var : it->second.kill) {
-          this->Free(var);
+          auto access_it = last_access_index.find(var);
+          if (access_it != last_access_index.end() &&
+              last_sync_index >= static_cast<int64_t>(access_it->second)) {
+            this->Free(var);
+          } else {
+            pending_free.push_back(var);
+          }
         }
       }
       // scope_pair_offset >= 0 means it is either
@@ -465,6 +536,10 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
         }
       }
     }
+    // All the storage entries are collected from the free lists when allocating the merged buffer.
+    for (const VarNode* var : pending_free) {
+      this->Free(var);
+    }
   }
   /*!
    * \brief Allocate new storage entry.
@@ -509,6 +584,7 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       for (auto it = mid; it != end; ++it) {
         StorageEntry* e = it->second;
         e->const_nbits = std::max(const_nbits, e->const_nbits);
+        e->allocs.push_back({op->buffer_var.get()});
         const_free_map_.erase(it);
         return e;
       }
@@ -578,10 +654,10 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
       sym_free_list_.push_back(e);
     }
   }
-  // The var for the merged buffer
-  Var merged_buf_var_{"buf_dyn_shmem", PointerType(PrimType(DataType::UInt(8)), "shared.dyn")};
   // The mapping from the original buffer var to its allocate
   std::unordered_map<const VarNode*, const AllocateNode*> dyn_shmem_allocs_;
+  // The var for the merged buffer
+  Var merged_buf_var_;
   // The size of the merged buffer
   PrimExpr merged_alloc_size_{0};
   // The mapping from the original buffer var to its offset in the merged buffer
@@ -602,23 +678,53 @@ class DynamicSharedMemoryRewriter : public StmtExprMutator {
   support::Arena arena_;
 };
 
-Stmt MergeDynamicSharedMemoryAllocations(Stmt stmt) {
-  AllocateCollector collector;
-  collector(stmt);
-  if (collector.dyn_shmem_allocs_.size() > 1) {
-    DynamicSharedMemoryRewriter rewriter(collector.dyn_shmem_allocs_);
-    rewriter.PlanReuse(stmt);
-    return rewriter(std::move(stmt));
+/*!
+ * \brief Merge the shared memory allocations of each kernel, i.e. of each outermost
+ * thread_extent scope, so that the static allocations of different kernels of a function are
+ * never merged together.
+ */
+class KernelSharedMemoryMerger : public StmtMutator {
+ public:
+  explicit KernelSharedMemoryMerger(bool merge_static_smem)
+      : merge_static_smem_(merge_static_smem) {}
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key != attr::thread_extent) {
+      return StmtMutator::VisitStmt_(op);
+    }
+    Stmt kernel = GetRef<Stmt>(op);
+    AllocateCollector collector;
+    collector(kernel);
+    std::unordered_map<const VarNode*, const AllocateNode*> shmem_allocs =
+        collector.dyn_shmem_allocs_;
+    bool is_dynamic = !shmem_allocs.empty();
+    if (merge_static_smem_) {
+      shmem_allocs.insert(collector.static_shmem_allocs_.begin(),
+                          collector.static_shmem_allocs_.end());
+    }
+    if (shmem_allocs.size() > 1) {
+      DynamicSharedMemoryRewriter rewriter(shmem_allocs, is_dynamic);
+      rewriter.PlanReuse(kernel);
+      return rewriter(std::move(kernel));
+    }
+    return kernel;
   }
-  return stmt;
+
+ private:
+  bool merge_static_smem_;
+};
+
+Stmt MergeDynamicSharedMemoryAllocations(Stmt stmt, bool merge_static_smem) {
+  return KernelSharedMemoryMerger(merge_static_smem)(std::move(stmt));
 }
 
 namespace transform {
 
 Pass MergeDynamicSharedMemoryAllocations() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    bool merge_static_smem = ctx->GetConfig<Bool>("tir.merge_static_smem", Bool(false)).value();
     auto* n = f.CopyOnWrite();
-    n->body = MergeDynamicSharedMemoryAllocations(std::move(n->body));
+    n->body = MergeDynamicSharedMemoryAllocations(std::move(n->body), merge_static_smem);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.MergeDynamicSharedMemoryAllocations", {});
@@ -0,0 +1,366 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file merge_persistent_kernel.cc
+ * \brief Merge the consecutive kernel launches of a function into one persistent kernel.
+ */
+#include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../../runtime/thread_storage_scope.h"
+#include "ir_utils.h"
+
+namespace tvm {
+namespace tir {
+
+/*! \brief A kernel launch over blockIdx.x and threadIdx.x, with constant extents. */
+struct KernelLaunch {
+  Stmt launch;
+  Array<Var> block_vars;
+  Array<Var> thread_vars;
+  int64_t num_blocks{1};
+  int64_t num_threads{1};
+  /*! \brief The static shared memory of a block, in bytes. */
+  int64_t shared_bytes{0};
+  /*! \brief Whether the threads of a block work together, so they must all run it. */
+  bool is_cooperative{false};
+  /*! \brief The buffers read and written by the kernel, but not allocated by it, in order. */
+  std::vector<const VarNode*> reads;
+  std::vector<const VarNode*> writes;
+};
+
+/*! \brief Collect what merging a kernel launch needs, and whether it can be merged. */
+class KernelLaunchAnalyzer : public StmtExprVisitor {
+ public:
+  static bool Analyze(KernelLaunch* kernel) {
+    KernelLaunchAnalyzer analyzer(kernel);
+    analyzer(kernel->launch);
+    auto filter = [&analyzer](const std::unordered_set<const VarNode*>& vars) {
+      std::vector<const VarNode*> ret;
+      for (const VarNode* var : analyzer.order_) {
+        if (vars.count(var) && !analyzer.allocated_.count(var)) ret.push_back(var);
+      }
+      return ret;
+    };
+    kernel->reads = filter(analyzer.reads_);
+    kernel->writes = filter(analyzer.writes_);
+    return analyzer.mergeable_;
+  }
+
+ private:
+  explicit KernelLaunchAnalyzer(KernelLaunch* kernel) : kernel_(kernel) {}
+
+  void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent) {
+      IterVar iv = Downcast<IterVar>(op->node);
+      const auto* extent = op->value.as<IntImmNode>();
+      if (extent == nullptr) {
+        mergeable_ = false;
+      } else if (iv->thread_tag == "blockIdx.x") {
+        SetExtent(&kernel_->block_vars, &kernel_->num_blocks, iv->var, extent->value);
+      } else if (iv->thread_tag == "threadIdx.x") {
+        SetExtent(&kernel_->thread_vars, &kernel_->num_threads, iv->var, extent->value);
+      } else {
+        mergeable_ = false;
+      }
+    } else if (op->attr_key == attr::cluster_dims || op->attr_key == attr::persistent_kernel) {
+      mergeable_ = false;
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    allocated_.insert(op->buffer_var.get());
+    runtime::StorageScope scope = runtime::StorageScope::Create(GetPtrStorageScope(op->buffer_var));
+    if (scope.rank == runtime::StorageRank::kShared && scope.tag.empty()) {
+      int64_t size = op->ConstantAllocationSize();
+      if (size == 0) mergeable_ = false;
+      kernel_->shared_bytes += size * op->dtype.bytes() * op->dtype.lanes();
+      kernel_->is_cooperative = true;
+    } else if (scope.rank == runtime::StorageRank::kShared) {
+      // The dynamic shared memory is sized by the launch.
+      mergeable_ = false;
+    } else if (scope.rank != runtime::StorageRank::kLocal) {
+      kernel_->is_cooperative = true;
+    }
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    Access(op->buffer->data.get(), &writes_);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    Access(op->buffer->data.get(), &reads_);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const VarNode* op) final {
+    // A buffer passed by pointer, e.g. to tvm_access_ptr or extern calls, is read and written.
+    if (op->dtype.is_handle()) {
+      Access(op, &reads_);
+      Access(op, &writes_);
+    }
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::tvm_global_barrier_kinit())) {
+      mergeable_ = false;
+    } else if (op->op.same_as(builtin::tvm_storage_sync()) ||
+               op->op.same_as(builtin::tvm_thread_allreduce()) ||
+               op->op.same_as(builtin::tvm_warp_shuffle()) ||
+               op->op.same_as(builtin::tvm_warp_shuffle_up()) ||
+               op->op.same_as(builtin::tvm_warp_shuffle_down()) ||
+               op->op.same_as(builtin::tvm_warp_activemask())) {
+      kernel_->is_cooperative = true;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void SetExtent(Array<Var>* vars, int64_t* extent, const Var& var, int64_t value) {
+    if (!vars->empty() && *extent != value) mergeable_ = false;
+    *extent = value;
+    vars->push_back(var);
+  }
+
+  void Access(const VarNode* var, std::unordered_set<const VarNode*>* accesses) {
+    if (!reads_.count(var) && !writes_.count(var)) order_.push_back(var);
+    accesses->insert(var);
+  }
+
+  KernelLaunch* kernel_;
+  bool mergeable_{true};
+  std::unordered_set<const VarNode*> allocated_;
+  std::unordered_set<const VarNode*> reads_;
+  std::unordered_set<const VarNode*> writes_;
+  std::vector<const VarNode*> order_;
+};
+
+/*! \brief Remove the thread bindings of a kernel, to run its body in another launch. */
+class ThreadExtentRemover : public StmtMutator {
+ private:
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent) return VisitStmt(op->body);
+    return StmtMutator::VisitStmt_(op);
+  }
+};
+
+/*!
+ * \brief Merge the runs of consecutive kernel launches into persistent kernels.
+ *
+ *  The merged kernel launches as many blocks as can be resident on the device together, each
+ *  running the blocks of every kernel in turn, so the kernels are separated by global barriers
+ *  where they depend on each other.
+ */
+class PersistentKernelMerger : public StmtMutator {
+ public:
+  PersistentKernelMerger(int64_t num_sms, int64_t max_threads, int64_t max_shared_bytes)
+      : num_sms_(num_sms), max_threads_(max_threads), max_shared_bytes_(max_shared_bytes) {}
+
+ private:
+  // The most blocks an SM holds, in every CUDA architecture.
+  static constexpr int64_t kMaxBlocksPerSM = 16;
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent) return GetRef<Stmt>(op);
+    return StmtMutator::VisitStmt_(op);
+  }
+
+  Stmt VisitStmt_(const SeqStmtNode* op) final {
+    Array<Stmt> seq;
+    std::vector<KernelLaunch> run;
+    auto flush = [this, &seq, &run]() {
+      if (run.size() > 1) {
+        seq.push_back(Merge(run));
+      } else {
+        for (const KernelLaunch& kernel : run) seq.push_back(kernel.launch);
+      }
+      run.clear();
+    };
+    for (const Stmt& stmt : op->seq) {
+      Stmt new_stmt = VisitStmt(stmt);
+      const auto* attr = new_stmt.as<AttrStmtNode>();
+      KernelLaunch kernel;
+      kernel.launch = new_stmt;
+      if (attr == nullptr || attr->attr_key != attr::thread_extent ||
+          !KernelLaunchAnalyzer::Analyze(&kernel)) {
+        flush();
+        seq.push_back(new_stmt);
+        continue;
+      }
+      run.push_back(kernel);
+      if (!CanMerge(run)) {
+        run.pop_back();
+        flush();
+        run.push_back(kernel);
+      }
+    }
+    flush();
+    return SeqStmt::Flatten(seq);
+  }
+
+  bool CanMerge(const std::vector<KernelLaunch>& kernels) const {
+    int64_t num_threads = 1, shared_bytes = 0;
+    for (const KernelLaunch& kernel : kernels) {
+      num_threads = std::max(num_threads, kernel.num_threads);
+      shared_bytes += kernel.shared_bytes;
+    }
+    if (num_threads > max_threads_ || shared_bytes > max_shared_bytes_) return false;
+    // Only the threads a kernel launches may run it, unless they work independently.
+    return std::all_of(kernels.begin(), kernels.end(), [num_threads](const KernelLaunch& kernel) {
+      return !kernel.is_cooperative || kernel.num_threads == num_threads;
+    });
+  }
+
+  Stmt Merge(const std::vector<KernelLaunch>& kernels) {
+    int64_t num_threads = 1, shared_bytes = 0, max_blocks = 1;
+    for (const KernelLaunch& kernel : kernels) {
+      num_threads = std::max(num_threads, kernel.num_threads);
+      shared_bytes += kernel.shared_bytes;
+      max_blocks = std::max(max_blocks, kernel.num_blocks);
+    }
+    // The global barriers wait for every block, so all of them must be resident at once.
+    int64_t blocks_per_sm = std::min(kMaxBlocksPerSM, max_threads_ / num_threads);
+    if (shared_bytes > 0) blocks_per_sm = std::min(blocks_per_sm, max_shared_bytes_ / shared_bytes);
+    int64_t num_blocks = std::min(max_blocks, num_sms_ * blocks_per_sm);
+
+    DataType dtype = DataType::Int(32);
+    IterVar block_iv(Range::FromMinExtent(0, IntImm(dtype, num_blocks)), Var("blockIdx.x", dtype),
+                     IterVarType::kThreadIndex, "blockIdx.x");
+    IterVar thread_iv(Range::FromMinExtent(0, IntImm(dtype, num_threads)),
+                      Var("threadIdx.x", dtype), IterVarType::kThreadIndex, "threadIdx.x");
+
+    Array<Stmt> stages;
+    std::unordered_set<const VarNode*> pending_reads, pending_writes, all_reads, all_writes;
+    std::vector<const VarNode*> exchanged_buffers;
+    bool has_barrier = false;
+    auto overlaps = [](const std::vector<const VarNode*>& vars,
+                       const std::unordered_set<const VarNode*>& set) {
+      return std::any_of(vars.begin(), vars.end(), [&set](auto var) { return set.count(var); });
+    };
+    for (const KernelLaunch& kernel : kernels) {
+      if (overlaps(kernel.writes, pending_reads) || overlaps(kernel.writes, pending_writes) ||
+          overlaps(kernel.reads, pending_writes)) {
+        stages.push_back(Evaluate(Call(DataType::Int(32), builtin::tvm_storage_sync(),
+                                       {StringImm("global"), thread_iv->var == 0,
+                                        IntImm(DataType::Int(32), num_blocks)})));
+        pending_reads.clear();
+        pending_writes.clear();
+        has_barrier = true;
+      }
+      for (const VarNode* var : kernel.reads) {
+        pending_reads.insert(var);
+        if (all_writes.count(var) && !all_reads.count(var)) exchanged_buffers.push_back(var);
+        all_reads.insert(var);
+      }
+      for (const VarNode* var : kernel.writes) {
+        pending_writes.insert(var);
+        if (all_reads.count(var) && !all_writes.count(var)) exchanged_buffers.push_back(var);
+        all_writes.insert(var);
+      }
+      stages.push_back(MakeStage(kernel, block_iv->var, thread_iv->var, num_blocks, num_threads));
+    }
+
+    Stmt body = SeqStmt::Flatten(stages);
+    Array<Stmt> launch;
+    if (has_barrier) {
+      // Bypass the L1 cache, which is not coherent across the blocks, as ThreadSync("global").
+      for (const VarNode* var : exchanged_buffers) {
+        body = AttrStmt(GetRef<Var>(var), attr::volatile_scope, 1, body);
+      }
+      body = SeqStmt({Evaluate(Call(DataType::Int(32), builtin::tvm_global_barrier_kinit(), {})),
+                      body});
+      launch.push_back(Evaluate(Call(DataType::Int(32), builtin::tvm_call_packed(),
+                                     {StringImm(runtime::symbol::tvm_prepare_global_barrier)})));
+    }
+    body = AttrStmt(make_zero(DataType::Int(32)), attr::persistent_kernel,
+                    IntImm(DataType::Int(32), blocks_per_sm), body);
+    body = AttrStmt(thread_iv, attr::thread_extent, thread_iv->dom->extent, body);
+    body = AttrStmt(block_iv, attr::thread_extent, block_iv->dom->extent, body);
+    launch.push_back(body);
+    return SeqStmt::Flatten(launch);
+  }
+
+  /*! \brief Run the blocks of a kernel on the blocks of the persistent kernel, in turn. */
+  Stmt MakeStage(const KernelLaunch& kernel, const Var& block_var, const Var& thread_var,
+                 int64_t num_blocks, int64_t num_threads) {
+    int64_t num_iters = (kernel.num_blocks + num_blocks - 1) / num_blocks;
+    Var iter("block_iter", block_var.dtype());
+    PrimExpr block = num_iters > 1 ? block_var + iter * IntImm(block_var.dtype(), num_blocks)
+                                   : PrimExpr(block_var);
+    Map<Var, PrimExpr> vmap;
+    for (const Var& var : kernel.block_vars) vmap.Set(var, cast(var.dtype(), block));
+    for (const Var& var : kernel.thread_vars) vmap.Set(var, cast(var.dtype(), thread_var));
+    Stmt body = Substitute(ThreadExtentRemover()(kernel.launch), vmap);
+    if (kernel.num_threads < num_threads) {
+      body = IfThenElse(thread_var < IntImm(thread_var.dtype(), kernel.num_threads), body);
+    }
+    if (kernel.num_blocks != num_iters * num_blocks) {
+      body = IfThenElse(block < IntImm(block_var.dtype(), kernel.num_blocks), body);
+    }
+    if (num_iters > 1) {
+      body = For(iter, IntImm(iter.dtype(), 0), IntImm(iter.dtype(), num_iters), ForKind::kSerial,
+                 body);
+    }
+    return body;
+  }
+
+  int64_t num_sms_;
+  int64_t max_threads_;
+  int64_t max_shared_bytes_;
+};
+
+namespace transform {
+
+Pass MergePersistentKernel() {
+  auto pass_func = [](PrimFunc func, IRModule mod, PassContext ctx) -> PrimFunc {
+    auto opt_target = func->GetAttr<Target>(tvm::attr::kTarget);
+    ICHECK(opt_target) << "MergePersistentKernel: Require the target attribute";
+    Target target = opt_target.value();
+    if (target->kind->name != "cuda") return func;
+    auto num_sms = target->GetAttr<Integer>("multi_processor_count");
+    ICHECK(num_sms) << "MergePersistentKernel: The persistent kernels are sized by the number of "
+                    << "SMs, which requires the -multi_processor_count option of target " << target;
+    int64_t max_threads = target->GetAttr<Integer>("max_num_threads").value_or(1024)->value;
+    int64_t max_shared_bytes =
+        target->GetAttr<Integer>("max_shared_memory_per_block").value_or(48 * 1024)->value;
+    PersistentKernelMerger merger(num_sms.value()->value, max_threads, max_shared_bytes);
+    func.CopyOnWrite()->body = merger(func->body);
+    return func;
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.MergePersistentKernel", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.MergePersistentKernel").set_body_typed(MergePersistentKernel);
+
+}  // namespace transform
+}  // namespace tir
+}  // namespace tvm
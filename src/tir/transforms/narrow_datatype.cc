@@ -23,11 +23,17 @@
  */
 
 #include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
 #include <tvm/tir/builtin.h>
 #include <tvm/tir/data_type_rewriter.h>
 #include <tvm/tir/op.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 #include "../../arith/ir_mutator_with_analyzer.h"
 #include "../../arith/ir_visitor_with_analyzer.h"
 
@@ -56,6 +62,13 @@ namespace tir {
 // Algorithm:
 // - Use DataTypeVisitor to determine whether a Var can be narrowed or not.
 // - Use DataTypeRewritter to rewrite the components of an indexing expression.
+//
+// The dynamic shape vars of the buffers are unbounded, so the indexing
+// expressions which contain them are not narrowed. With the guard enabled
+// (by default for GPU targets), the shape vars are assumed to be small enough
+// for the buffers to hold at most 2^(target_bits-1) - 1 elements, narrowed
+// under this assumption, and the narrowed body runs when a runtime check of
+// the assumption passes, the body narrowed without it otherwise.
 
 using arith::Analyzer;
 using arith::ConstIntBound;
@@ -97,6 +110,13 @@ class DataTypeVisitor final : public StmtExprVisitor {
     }
   }
 
+  /*! \brief Assume the shape var is in [0, max_value], and narrow it as an iteration var. */
+  void AssumeShapeBound(const Var& var, int64_t max_value) {
+    analyzer_.Bind(var, Range::FromMinExtent(make_zero(var.dtype()),
+                                             make_const(var.dtype(), max_value + 1)));
+    vextent_[var.get()] = var.dtype();
+  }
+
   void VisitStmt_(const ForNode* op) {
     analyzer_.Bind(op->loop_var, Range::FromMinExtent(op->min, op->extent));
     vextent_[op->loop_var.as<VarNode>()] = op->extent.dtype();
@@ -201,6 +221,21 @@ class NarrowDataTypeRewriter : public IndexDataTypeRewriter {
   using Parent = IndexDataTypeRewriter;
   explicit NarrowDataTypeRewriter(int target_bits) : visitor_(target_bits) {}
 
+  /*!
+   * \brief Rewriter which assumes the bounds of the shape vars, and binds their narrowed
+   * copies at the beginning of the body.
+   */
+  NarrowDataTypeRewriter(int target_bits, const std::vector<std::pair<Var, int64_t>>& shape_bounds)
+      : visitor_(target_bits) {
+    for (const auto& [var, max_value] : shape_bounds) {
+      visitor_.AssumeShapeBound(var, max_value);
+      shape_vars_.push_back(var);
+    }
+  }
+
+  /*! \brief Whether a shape var was narrowed by the last rewrite. */
+  bool narrowed_shape_vars() const { return narrowed_shape_vars_; }
+
   Stmt operator()(Stmt s) {
     visitor_(s);
     for (auto i = visitor_.vmap.begin(), last = visitor_.vmap.end(); i != last;) {
@@ -211,7 +246,15 @@ class NarrowDataTypeRewriter : public IndexDataTypeRewriter {
         ++i;
       }
     }
-    return VisitStmt(s);
+    Stmt ret = VisitStmt(s);
+    for (auto it = shape_vars_.rbegin(); it != shape_vars_.rend(); ++it) {
+      auto remap = var_remap_.find(it->get());
+      if (remap != var_remap_.end()) {
+        ret = LetStmt(remap->second, cast(remap->second.dtype(), *it), ret);
+        narrowed_shape_vars_ = true;
+      }
+    }
+    return ret;
   }
 
  protected:
@@ -291,18 +334,104 @@ class NarrowDataTypeRewriter : public IndexDataTypeRewriter {
  private:
   // the internal visitor to deduce the narrowed dtype
   DataTypeVisitor visitor_;
+  // the shape vars with assumed bounds
+  std::vector<Var> shape_vars_;
+  // whether a shape var was narrowed
+  bool narrowed_shape_vars_{false};
 };
 
 Stmt NarrowDataType(Stmt stmt, int target_bits) {
   return NarrowDataTypeRewriter(target_bits)(stmt);
 }
 
+/*!
+ * \brief Returns the bound of each dynamic shape var of the buffers of the function for which
+ * every buffer holds at most 2^(target_bits-1) - 1 elements, or nothing if there is none.
+ *
+ * A buffer with a constant part c and d dynamic dimensions bounds its vars by
+ * (max / c)^(1/d), and a var gets the tightest bound of the buffers it is a dimension of.
+ */
+std::vector<std::pair<Var, int64_t>> ShapeVarBounds(const PrimFunc& func, int target_bits) {
+  const double max_elems = std::ldexp(1.0, target_bits - 1) - 1;
+  std::vector<std::pair<Var, int64_t>> bounds;
+  std::unordered_map<const VarNode*, size_t> index;
+  for (const Var& param : func->params) {
+    auto it = func->buffer_map.find(param);
+    if (it == func->buffer_map.end()) {
+      continue;
+    }
+    const Buffer& buffer = (*it).second;
+    double const_elems = 1;
+    std::vector<Var> dynamic_dims;
+    for (const PrimExpr& dim : buffer->shape) {
+      if (const auto* imm = dim.as<IntImmNode>()) {
+        const_elems *= imm->value;
+      } else if (const auto* var = dim.as<VarNode>()) {
+        if (var->dtype.is_int() && var->dtype.bits() > target_bits) {
+          dynamic_dims.push_back(GetRef<Var>(var));
+        }
+      } else {
+        // Composite dimensions are not bounded.
+        return {};
+      }
+    }
+    if (dynamic_dims.empty()) {
+      continue;
+    }
+    double limit = std::floor(std::pow(max_elems / const_elems, 1.0 / dynamic_dims.size()));
+    if (limit < 1) {
+      return {};
+    }
+    for (const Var& var : dynamic_dims) {
+      auto [pos, inserted] = index.emplace(var.get(), bounds.size());
+      if (inserted) {
+        bounds.emplace_back(var, static_cast<int64_t>(limit));
+      } else {
+        bounds[pos->second].second =
+            std::min(bounds[pos->second].second, static_cast<int64_t>(limit));
+      }
+    }
+  }
+  return bounds;
+}
+
+/*! \brief Returns whether the function is compiled for a GPU. */
+bool IsGPUFunction(const PrimFunc& func) {
+  Optional<Target> target = func->GetAttr<Target>(tvm::attr::kTarget);
+  if (!target.defined()) {
+    target = Target::Current(true);
+  }
+  if (!target.defined()) {
+    return false;
+  }
+  int device_type = target.value()->GetTargetDeviceType();
+  return device_type == kDLCUDA || device_type == kDLROCM || device_type == kDLOpenCL ||
+         device_type == kDLVulkan || device_type == kDLMetal;
+}
+
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.narrow_datatype_guard", Bool);
+
 Pass NarrowDataType(int target_bits) {
   auto pass_func = [target_bits](PrimFunc f, IRModule m, PassContext ctx) {
-    auto* n = f.CopyOnWrite();
-    n->body = NarrowDataTypeRewriter(target_bits)(std::move(n->body));
+    bool guard =
+        ctx->GetConfig<Bool>("tir.narrow_datatype_guard", Bool(IsGPUFunction(f))).value();
+    auto bounds = guard ? ShapeVarBounds(f, target_bits) : std::vector<std::pair<Var, int64_t>>();
+    Stmt body = NarrowDataTypeRewriter(target_bits)(f->body);
+    if (!bounds.empty()) {
+      NarrowDataTypeRewriter guarded_rewriter(target_bits, bounds);
+      Stmt guarded_body = guarded_rewriter(f->body);
+      if (guarded_rewriter.narrowed_shape_vars()) {
+        PrimExpr cond;
+        for (const auto& [var, max_value] : bounds) {
+          PrimExpr in_bound = var <= make_const(var.dtype(), max_value);
+          cond = cond.defined() ? cond && in_bound : in_bound;
+        }
+        body = IfThenElse(cond, guarded_body, body);
+      }
+    }
+    f.CopyOnWrite()->body = std::move(body);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.NarrowDataType", {});
@@ -0,0 +1,253 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file specialize_divisible_shapes.cc
+ * \brief Specialize a PrimFunc with dynamic shapes for the shapes divisible by its tile factors.
+ *
+ * A loop over a dynamic extent n split by a factor c iterates ceildiv(n, c) times, and checks
+ * likely(i_outer * c + i_inner < n) at every iteration. When n % c == 0 the check always holds.
+ * This pass collects the tile factors of the shape vars of the function from the extents of the
+ * form floordiv(n + c - 1, c), and rewrites the body into
+ *
+ *   if (n % c == 0) { fast path } else { original body }
+ *
+ * where the fast path substitutes n with n_tile * c, n_tile = n / c, which makes the trip counts
+ * exact and the boundary checks provable, so that they are removed.
+ */
+#include <tvm/arith/analyzer.h>
+#include <tvm/arith/int_set.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/builtin.h>
+#include <tvm/tir/op.h>
+#include <tvm/tir/stmt_functor.h>
+#include <tvm/tir/transform.h>
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../../arith/pattern_match.h"
+
+namespace tvm {
+namespace tir {
+
+/*! \brief Collects the tile factors of the shape vars from the ceildiv loop extents. */
+class TileFactorCollector : public StmtVisitor {
+ public:
+  static std::unordered_map<const VarNode*, int64_t> Collect(
+      const Stmt& body, const std::unordered_set<const VarNode*>& shape_vars) {
+    TileFactorCollector collector(shape_vars);
+    collector(body);
+    return collector.factors_;
+  }
+
+ private:
+  explicit TileFactorCollector(const std::unordered_set<const VarNode*>& shape_vars)
+      : shape_vars_(shape_vars) {}
+
+  void VisitStmt_(const ForNode* op) final {
+    Update(op->extent);
+    StmtVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key == attr::thread_extent) {
+      Update(op->value);
+    }
+    StmtVisitor::VisitStmt_(op);
+  }
+
+  void Update(const PrimExpr& extent) {
+    arith::PVar<Var> n;
+    arith::PVar<IntImm> c1, c2;
+    if (!floordiv(n + c1, c2).Match(extent)) {
+      return;
+    }
+    int64_t factor = c2.Eval()->value;
+    if (factor <= 1 || c1.Eval()->value != factor - 1 || !shape_vars_.count(n.Eval().get())) {
+      return;
+    }
+    int64_t& lcm = factors_[n.Eval().get()];
+    lcm = lcm == 0 ? factor : std::lcm(lcm, factor);
+  }
+
+  const std::unordered_set<const VarNode*>& shape_vars_;
+  std::unordered_map<const VarNode*, int64_t> factors_;
+};
+
+/*!
+ * \brief Rewrites the fast path: substitutes the shape vars with their multiples, simplifies the
+ * extents and removes the likely conditions which always hold.
+ */
+class DivisibleShapeRewriter : public StmtExprMutator {
+ public:
+  explicit DivisibleShapeRewriter(std::unordered_map<const VarNode*, PrimExpr> vmap)
+      : vmap_(std::move(vmap)) {}
+
+ private:
+  PrimExpr VisitExpr_(const VarNode* op) final {
+    auto it = vmap_.find(op);
+    return it != vmap_.end() ? it->second : GetRef<PrimExpr>(op);
+  }
+
+  PrimExpr VisitExpr_(const CallNode* op) final {
+    PrimExpr ret = StmtExprMutator::VisitExpr_(op);
+    op = ret.as<CallNode>();
+    if (op && op->op.same_as(builtin::if_then_else()) && AlwaysHolds(op->args[0])) {
+      return op->args[1];
+    }
+    return ret;
+  }
+
+  Stmt VisitStmt_(const ForNode* op) final {
+    PrimExpr min = analyzer_.Simplify(VisitExpr(op->min));
+    PrimExpr extent = analyzer_.Simplify(VisitExpr(op->extent));
+    dom_map_[op->loop_var.get()] = arith::IntSet::FromMinExtent(min, extent);
+    Stmt body = VisitStmt(op->body);
+    dom_map_.erase(op->loop_var.get());
+    auto n = CopyOnWrite(op);
+    n->min = min;
+    n->extent = extent;
+    n->body = body;
+    return For(n);
+  }
+
+  Stmt VisitStmt_(const AttrStmtNode* op) final {
+    if (op->attr_key != attr::thread_extent && op->attr_key != attr::virtual_thread) {
+      return StmtExprMutator::VisitStmt_(op);
+    }
+    IterVar iv = Downcast<IterVar>(op->node);
+    PrimExpr extent = analyzer_.Simplify(VisitExpr(op->value));
+    dom_map_[iv->var.get()] = arith::IntSet::FromMinExtent(make_zero(extent.dtype()), extent);
+    Stmt body = VisitStmt(op->body);
+    dom_map_.erase(iv->var.get());
+    return AttrStmt(op->node, op->attr_key, extent, body, op->span);
+  }
+
+  Stmt VisitStmt_(const IfThenElseNode* op) final {
+    Stmt ret = StmtExprMutator::VisitStmt_(op);
+    op = ret.as<IfThenElseNode>();
+    if (op && AlwaysHolds(op->condition)) {
+      return op->then_case;
+    }
+    return ret;
+  }
+
+  /*! \brief Returns whether a likely condition holds over the domains of the enclosing loops. */
+  bool AlwaysHolds(const PrimExpr& cond) {
+    const auto* call = cond.as<CallNode>();
+    if (call == nullptr || !call->op.same_as(builtin::likely())) {
+      return false;
+    }
+    return Proves(call->args[0]);
+  }
+
+  bool Proves(const PrimExpr& cond) {
+    if (const auto* op = cond.as<AndNode>()) {
+      return Proves(op->a) && Proves(op->b);
+    } else if (const auto* op = cond.as<LTNode>()) {
+      return ProvesNegative(op->a - op->b);
+    } else if (const auto* op = cond.as<LENode>()) {
+      return ProvesNegative(op->a - op->b - 1);
+    } else if (const auto* op = cond.as<GTNode>()) {
+      return ProvesNegative(op->b - op->a);
+    } else if (const auto* op = cond.as<GENode>()) {
+      return ProvesNegative(op->b - op->a - 1);
+    }
+    return false;
+  }
+
+  bool ProvesNegative(const PrimExpr& diff) {
+    arith::IntSet set = arith::EvalSet(analyzer_.Simplify(diff), dom_map_);
+    return set.HasUpperBound() && analyzer_.CanProve(set.max() < 0);
+  }
+
+  std::unordered_map<const VarNode*, PrimExpr> vmap_;
+  std::unordered_map<const VarNode*, arith::IntSet> dom_map_;
+  arith::Analyzer analyzer_;
+};
+
+PrimFunc SpecializeDivisibleShapes(PrimFunc func) {
+  std::unordered_set<const VarNode*> shape_vars;
+  for (const auto& kv : func->buffer_map) {
+    for (const PrimExpr& dim : kv.second->shape) {
+      if (const auto* var = dim.as<VarNode>()) {
+        shape_vars.insert(var);
+      }
+    }
+  }
+  for (const Var& param : func->params) {
+    if (param.dtype().is_int() || param.dtype().is_uint()) {
+      shape_vars.insert(param.get());
+    }
+  }
+  auto factors = TileFactorCollector::Collect(func->body, shape_vars);
+  if (factors.empty()) {
+    return func;
+  }
+
+  // Sort by name so that the guard does not depend on the hash order.
+  std::vector<std::pair<Var, int64_t>> sorted;
+  for (const auto& kv : factors) {
+    sorted.emplace_back(GetRef<Var>(kv.first), kv.second);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const auto& a, const auto& b) { return a.first->name_hint < b.first->name_hint; });
+
+  std::unordered_map<const VarNode*, PrimExpr> vmap;
+  std::vector<std::pair<Var, PrimExpr>> tile_vars;
+  PrimExpr guard;
+  for (const auto& [var, factor] : sorted) {
+    PrimExpr c = make_const(var.dtype(), factor);
+    Var tile_var(var->name_hint + "_tile", var.dtype());
+    vmap[var.get()] = tile_var * c;
+    tile_vars.emplace_back(tile_var, floordiv(var, c));
+    PrimExpr divisible = floormod(var, c) == make_zero(var.dtype());
+    guard = guard.defined() ? guard && divisible : divisible;
+  }
+
+  Stmt fast_path = DivisibleShapeRewriter(std::move(vmap))(func->body);
+  for (auto it = tile_vars.rbegin(); it != tile_vars.rend(); ++it) {
+    fast_path = LetStmt(it->first, it->second, fast_path);
+  }
+  auto* n = func.CopyOnWrite();
+  n->body = IfThenElse(guard, fast_path, func->body);
+  return func;
+}
+
+namespace transform {
+
+Pass SpecializeDivisibleShapes() {
+  auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    return SpecializeDivisibleShapes(std::move(f));
+  };
+  return CreatePrimFuncPass(pass_func, 0, "tir.SpecializeDivisibleShapes", {});
+}
+
+TVM_REGISTER_GLOBAL("tir.transform.SpecializeDivisibleShapes")
+    .set_body_typed(SpecializeDivisibleShapes);
+
+}  // namespace transform
+
+}  // namespace tir
+}  // namespace tvm
@@ -33,6 +33,7 @@
 #include <tvm/tir/transform.h>
 
 #include <map>
+#include <numeric>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -43,6 +44,29 @@
 namespace tvm {
 namespace tir {
 
+struct StorageRewriteConfigNode : public tvm::AttrsNode<StorageRewriteConfigNode> {
+  bool reuse_across_dtypes;
+  bool report_reuse;
+
+  TVM_DECLARE_ATTRS(StorageRewriteConfigNode, "tir.transform.StorageRewriteConfig") {
+    TVM_ATTR_FIELD(reuse_across_dtypes)
+        .describe("Share the storage of byte-addressable buffers of different dtypes")
+        .set_default(false);
+    TVM_ATTR_FIELD(report_reuse)
+        .describe("Attach the shared allocations to the PrimFunc as tir.storage_reuse")
+        .set_default(false);
+  }
+};
+
+class StorageRewriteConfig : public Attrs {
+ public:
+  TVM_DEFINE_NOTNULLABLE_OBJECT_REF_METHODS(StorageRewriteConfig, Attrs,
+                                            StorageRewriteConfigNode);
+};
+
+TVM_REGISTER_NODE_TYPE(StorageRewriteConfigNode);
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.StorageRewrite", StorageRewriteConfig);
+
 using runtime::StorageRank;
 using runtime::StorageScope;
 
@@ -379,8 +403,9 @@ class StoragePlanRewriter : public StmtExprMutator {
   using StmtEntry = LinearAccessPatternFinder::StmtEntry;
   using AllocEntry = LinearAccessPatternFinder::AllocEntry;
 
-  Stmt Rewrite(Stmt stmt, bool detect_inplace) {
+  Stmt Rewrite(Stmt stmt, bool detect_inplace, bool reuse_across_dtypes = false) {
     detect_inplace_ = detect_inplace;
+    reuse_across_dtypes_ = reuse_across_dtypes;
     // plan the rewrite
     LinearAccessPatternFinder finder;
     finder(stmt);
@@ -396,6 +421,33 @@ class StoragePlanRewriter : public StmtExprMutator {
     return stmt;
   }
 
+  /*!
+   * \brief Returns the allocations which share their storage: the backing variable, the scope,
+   *  the planned bytes (0 if not constant), the sum of the bytes of the sharing allocations and
+   *  their names.
+   */
+  Array<Map<String, ObjectRef>> ReuseReport() const {
+    Array<Map<String, ObjectRef>> report;
+    for (const auto& e : alloc_vec_) {
+      if (e->allocs.size() < 2 || !e->alloc_var.defined()) continue;
+      Array<String> buffers;
+      int64_t requested_bytes = 0;
+      for (const AllocateNode* op : e->allocs) {
+        buffers.push_back(op->buffer_var->name_hint);
+        requested_bytes +=
+            (op->ConstantAllocationSize() * op->dtype.bits() * op->dtype.lanes() + 7) / 8;
+      }
+      Map<String, ObjectRef> entry;
+      entry.Set("storage", String(e->alloc_var->name_hint));
+      entry.Set("scope", String(e->scope.to_string()));
+      entry.Set("bytes", Integer(static_cast<int64_t>((e->const_nbits + 7) / 8)));
+      entry.Set("requested_bytes", Integer(requested_bytes));
+      entry.Set("buffers", buffers);
+      report.push_back(entry);
+    }
+    return report;
+  }
+
   template <typename Node>
   Node VisitBufferAccess(Node node) {
     auto it = alloc_map_.find(node->buffer->data.get());
@@ -630,9 +682,14 @@ class StoragePlanRewriter : public StmtExprMutator {
         }
         // Get the allocation size;
         e->alloc_var = e->allocs[0]->buffer_var;
+        // Declare the storage with the widest element, so that it is aligned for all of the
+        // allocations sharing it.
         DataType alloc_type = e->allocs[0]->dtype;
         for (const AllocateNode* op : e->allocs) {
-          if (op->dtype.lanes() > alloc_type.lanes()) {
+          int op_bits = op->dtype.bits() * op->dtype.lanes();
+          int alloc_bits = alloc_type.bits() * alloc_type.lanes();
+          if (op_bits > alloc_bits ||
+              (op_bits == alloc_bits && op->dtype.lanes() > alloc_type.lanes())) {
             alloc_type = op->dtype;
           }
         }
@@ -736,6 +793,12 @@ class StoragePlanRewriter : public StmtExprMutator {
     if (info.defined()) {
       align = info->max_simd_bits;
     }
+    // The offset of each child must be a multiple of its element bits.
+    for (StorageEntry* child : e->merged_children) {
+      for (const AllocateNode* op : child->allocs) {
+        align = std::lcm(align, static_cast<size_t>(op->dtype.bits() * op->dtype.lanes()));
+      }
+    }
     // Always align to max_simd_bits
     // so we can remap types by keeping this property
     if (total_bits % align != 0) {
@@ -847,7 +910,8 @@ class StoragePlanRewriter : public StmtExprMutator {
                 StorageEntry* src_entry = alloc_map_.at(src);
                 if (src_entry->scope == storage_scope &&
                     src_entry->attach_scope_ == thread_scope_ &&
-                    src_entry->elem_type == alloc->dtype.element_of() &&
+                    src_entry->elem_type.bits() == alloc->dtype.bits() &&
+                    CanShareElemType(src_entry, alloc->dtype) &&
                     visitor.Check(s.stmt, var, src)) {
                   uint64_t const_nbits = static_cast<uint64_t>(alloc->ConstantAllocationSize()) *
                                          alloc->dtype.bits() * alloc->dtype.lanes();
@@ -915,6 +979,14 @@ class StoragePlanRewriter : public StmtExprMutator {
     return e;
   }
 
+  // Whether an allocation of dtype may share the storage of e. Across dtypes, only byte
+  // addressable elements are shared, so that all of the offsets stay aligned.
+  bool CanShareElemType(const StorageEntry* e, DataType dtype) const {
+    if (e->elem_type == dtype.element_of()) return true;
+    return reuse_across_dtypes_ && !e->elem_type.is_handle() && !dtype.is_handle() &&
+           e->elem_type.bits() % 8 == 0 && dtype.bits() % 8 == 0;
+  }
+
   StorageEntry* FindAlloc(const AllocateNode* op, const Object* attach_scope,
                           const StorageScope& scope, size_t num_physical_dimensions) {
     ICHECK(op != nullptr);
@@ -965,7 +1037,7 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = it->second;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
-        if (e->elem_type != op->dtype.element_of()) continue;
+        if (!CanShareElemType(e, op->dtype)) continue;
         e->const_nbits = std::max(const_nbits, e->const_nbits);
         const_free_map_.erase(it);
         return e;
@@ -976,7 +1048,7 @@ class StoragePlanRewriter : public StmtExprMutator {
         StorageEntry* e = *it;
         if (e->attach_scope_ != attach_scope) continue;
         if (e->scope != scope) continue;
-        if (e->elem_type != op->dtype.element_of()) continue;
+        if (!CanShareElemType(e, op->dtype)) continue;
         sym_free_list_.erase(it);
         return e;
       }
@@ -1009,6 +1081,8 @@ class StoragePlanRewriter : public StmtExprMutator {
   const Object* thread_scope_{nullptr};
   // whether enable inplace detection.
   bool detect_inplace_{false};
+  // whether allocations of different dtypes may share storage.
+  bool reuse_across_dtypes_{false};
   // Locations of free ops.
   std::unordered_map<const Object*, EventEntry> event_map_;
   // constant size free map.
@@ -1653,8 +1727,16 @@ namespace transform {
 
 Pass StorageRewrite() {
   auto pass_func = [](PrimFunc f, IRModule m, PassContext ctx) {
+    auto cfg = ctx->GetConfig<StorageRewriteConfig>("tir.StorageRewrite");
+    if (!cfg.defined()) {
+      cfg = AttrsWithDefaultValues<StorageRewriteConfig>();
+    }
+    StoragePlanRewriter rewriter;
     auto* n = f.CopyOnWrite();
-    n->body = StoragePlanRewriter().Rewrite(std::move(n->body), true);
+    n->body = rewriter.Rewrite(std::move(n->body), true, cfg.value()->reuse_across_dtypes);
+    if (cfg.value()->report_reuse) {
+      f = WithAttr(std::move(f), "tir.storage_reuse", rewriter.ReuseReport());
+    }
     // Parameters may not be rewritten, but internal allocations may.
     // Vectorization of AllocateConst is currently disabled, as it has
     // indexing issues for types that include padding (e.g. int8x3
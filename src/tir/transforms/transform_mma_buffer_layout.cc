@@ -39,6 +39,8 @@ namespace tir {
  *   We cannot use this kind of opaque access in matrixC too since the ptx stmatrix is only
  *   supported for sm90 or higher. Therefore, writeback of matrixC is limited to the
  *   transparent way.
+ *   wgmma.accumulator buffers are lowered in the same way. Each warp of the warpgroup holds 16
+ *   rows of every 64 x 8 block, laid out as the m16n8k8.matrixC of that warp.
  */
 class MmaBufferLayoutTransformer : public StmtExprMutator {
  public:
@@ -67,6 +69,28 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
         new_shape.insert(new_shape.end(),
                          {Integer(dim0->value / 16), Integer(dim1->value / 8), 2, 2});
 
+        Buffer new_buffer = decl_buffer(std::move(new_shape), buffer->dtype, buffer->name, "local",
+                                        buffer->axis_separators);
+        this->buffer_map_.insert({buffer, new_buffer});
+        this->buffer_var_map_.insert({buffer->data, new_buffer->data});
+        return std::move(new_buffer);
+      } else if (buffer.scope() == "wgmma.accumulator") {
+        // wgmma.accumulator
+        // bi = 64, bj = 8
+        size_t size = buffer->shape.size();
+        ICHECK_GE(size, 2);
+        const IntImmNode* dim0 = buffer->shape[size - 2].as<IntImmNode>();
+        const IntImmNode* dim1 = buffer->shape[size - 1].as<IntImmNode>();
+        ICHECK(dim0 != nullptr && dim1 != nullptr);
+        ICHECK(dim0->value % 64 == 0 && dim1->value % 8 == 0);
+
+        std::vector<PrimExpr> new_shape;
+        for (size_t i = 0; i < size - 2; ++i) {
+          new_shape.push_back(buffer->shape[i]);
+        }
+        new_shape.insert(new_shape.end(),
+                         {Integer(dim0->value / 64), Integer(dim1->value / 8), 2, 2});
+
         Buffer new_buffer = decl_buffer(std::move(new_shape), buffer->dtype, buffer->name, "local",
                                         buffer->axis_separators);
         this->buffer_map_.insert({buffer, new_buffer});
@@ -126,8 +150,10 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
     BufferStore store = Downcast<BufferStore>(StmtExprMutator::VisitStmt_(op));
     if (buffer_map_.count(store->buffer)) {
       auto* n = store.CopyOnWrite();
-      if (store->buffer.scope() == "m16n8k8.matrixC") {
-        const auto* index_map_func = runtime::Registry::Get("tir.index_map_m16n8k8.matrixC");
+      if (store->buffer.scope() == "m16n8k8.matrixC" ||
+          store->buffer.scope() == "wgmma.accumulator") {
+        const auto* index_map_func =
+            runtime::Registry::Get("tir.index_map_" + store->buffer.scope());
         ICHECK(index_map_func);
         auto index_map = IndexMap::FromFunc(2, *index_map_func);
         auto new_indices = index_map->MapIndices(store->indices);
@@ -145,8 +171,10 @@ class MmaBufferLayoutTransformer : public StmtExprMutator {
     BufferLoad load = Downcast<BufferLoad>(StmtExprMutator::VisitExpr_(op));
     if (buffer_map_.count(load->buffer)) {
       auto* n = load.CopyOnWrite();
-      if (load->buffer.scope() == "m16n8k8.matrixC") {
-        const auto* index_map_func = runtime::Registry::Get("tir.index_map_m16n8k8.matrixC");
+      if (load->buffer.scope() == "m16n8k8.matrixC" ||
+          load->buffer.scope() == "wgmma.accumulator") {
+        const auto* index_map_func =
+            runtime::Registry::Get("tir.index_map_" + load->buffer.scope());
         ICHECK(index_map_func);
         auto index_map = IndexMap::FromFunc(2, *index_map_func);
         auto new_indices = index_map->MapIndices(load->indices);
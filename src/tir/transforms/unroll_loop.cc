@@ -23,12 +23,17 @@
  */
 // Unrolls the loop as in Halide pipeline.
 #include <tvm/arith/analyzer.h>
+#include <tvm/arith/int_set.h>
 #include <tvm/runtime/registry.h>
+#include <tvm/target/target.h>
+#include <tvm/tir/analysis.h>
+#include <tvm/tir/builtin.h>
 #include <tvm/tir/expr.h>
 #include <tvm/tir/op.h>
 #include <tvm/tir/stmt_functor.h>
 #include <tvm/tir/transform.h>
 
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -45,6 +50,7 @@ struct UnrollLoopConfigNode : public tvm::AttrsNode<UnrollLoopConfigNode> {
   int auto_max_extent;
   int explicit_unroll;
   int unroll_local_access;
+  int auto_max_instructions;
 
   TVM_DECLARE_ATTRS(UnrollLoopConfigNode, "tir.transform.UnrollLoopConfig") {
     TVM_ATTR_FIELD(auto_max_step)
@@ -62,6 +68,11 @@ struct UnrollLoopConfigNode : public tvm::AttrsNode<UnrollLoopConfigNode> {
     TVM_ATTR_FIELD(unroll_local_access)
         .describe("Whether to always unroll local access")
         .set_default(false);
+    TVM_ATTR_FIELD(auto_max_instructions)
+        .describe(
+            "The maximum estimated instruction count of a loop to be automatically unrolled, "
+            "0 for no limit, -1 for a budget derived from the instruction cache of the target")
+        .set_default(0);
   }
 };
 
@@ -85,18 +96,187 @@ class VarLocalAccessMarker : public ExprVisitor {
   std::unordered_set<Var, ObjectPtrHash, ObjectPtrEqual>* var_touched_local_;
 };
 
+/*!
+ * \brief Estimates the number of instructions a statement executes, counting one per operation,
+ *  call, load and store, and multiplying the bodies of the loops by their extents.
+ */
+class InstructionCounter : public StmtExprVisitor {
+ public:
+  static int64_t Count(const Stmt& stmt) {
+    InstructionCounter counter;
+    counter(stmt);
+    return counter.count_;
+  }
+
+ private:
+  void VisitStmt_(const ForNode* op) final {
+    int64_t outer = count_;
+    count_ = 0;
+    StmtExprVisitor::VisitStmt_(op);
+    // One more for the loop increment and branch.
+    int64_t body = count_ + 1;
+    const auto* extent = op->extent.as<IntImmNode>();
+    count_ = outer + (extent != nullptr ? body * std::max<int64_t>(extent->value, 0) : body);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    ++count_;
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr(const PrimExpr& expr) final {
+    if (!expr->IsInstance<VarNode>() && !expr->IsInstance<IntImmNode>() &&
+        !expr->IsInstance<FloatImmNode>() && !expr->IsInstance<StringImmNode>()) {
+      ++count_;
+    }
+    StmtExprVisitor::VisitExpr(expr);
+  }
+
+  int64_t count_{0};
+};
+
+/*!
+ * \brief Returns the budget of instructions of an unrolled loop derived from the instruction cache
+ *  of the target of func: a quarter of a 32KB cache of 4 byte instructions on CPU, so that the
+ *  unrolled loop leaves room for its surroundings, and more on GPU, whose kernels are unrolled
+ *  aggressively to hide latency.
+ */
+int64_t TargetInstructionBudget(const PrimFunc& func) {
+  Optional<Target> target = func->GetAttr<Target>(tvm::attr::kTarget);
+  if (!target.defined()) {
+    target = Target::Current(true);
+  }
+  if (target.defined() && target.value()->GetTargetDeviceType() != kDLCPU) {
+    return 8192;
+  }
+  return 2048;
+}
+
+/*!
+ * \brief Checks whether the iterations of an outer loop access disjoint elements of the buffers
+ *  written in its body, so that the inner loop can be jammed: every buffer written in inner is
+ *  accessed with the same indices, whose region over the inner loops moves monotonically with
+ *  the outer loop var in one of the dimensions.
+ */
+class UnrollAndJamChecker : public StmtExprVisitor {
+ public:
+  static bool Check(const ForNode* outer, const ForNode* inner) {
+    UnrollAndJamChecker checker;
+    checker.dom_map_[inner->loop_var.get()] =
+        arith::IntSet::FromMinExtent(inner->min, inner->extent);
+    checker(inner->body);
+    if (checker.opaque_) {
+      return false;
+    }
+    arith::Analyzer analyzer;
+    analyzer.Bind(outer->loop_var, Range::FromMinExtent(outer->min, outer->extent));
+    Map<Var, PrimExpr> next{{outer->loop_var, outer->loop_var + make_const(outer->min.dtype(), 1)}};
+    for (const auto& kv : checker.indices_) {
+      if (!checker.written_.count(kv.first) || checker.local_.count(kv.first)) {
+        continue;
+      }
+      if (!kv.second.defined()) {
+        return false;
+      }
+      bool disjoint = false;
+      for (const PrimExpr& index : kv.second.value()) {
+        arith::IntSet set = arith::EvalSet(index, checker.dom_map_);
+        if (!set.HasLowerBound() || !set.HasUpperBound()) {
+          continue;
+        }
+        PrimExpr next_min = Substitute(set.min(), next);
+        PrimExpr next_max = Substitute(set.max(), next);
+        if (analyzer.CanProve(set.max() < next_min) || analyzer.CanProve(next_max < set.min())) {
+          disjoint = true;
+          break;
+        }
+      }
+      if (!disjoint) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  void VisitStmt_(const ForNode* op) final {
+    dom_map_[op->loop_var.get()] = arith::IntSet::FromMinExtent(op->min, op->extent);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const AllocateNode* op) final {
+    local_.insert(op->buffer_var.get());
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitStmt_(const BufferStoreNode* op) final {
+    written_.insert(op->buffer->data.get());
+    Update(op->buffer, op->indices);
+    StmtExprVisitor::VisitStmt_(op);
+  }
+
+  void VisitExpr_(const BufferLoadNode* op) final {
+    Update(op->buffer, op->indices);
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void VisitExpr_(const CallNode* op) final {
+    if (op->op.same_as(builtin::address_of()) || op->op.same_as(builtin::tvm_access_ptr()) ||
+        SideEffect(GetRef<PrimExpr>(op)) >= CallEffectKind::kUpdateState) {
+      opaque_ = true;
+    }
+    StmtExprVisitor::VisitExpr_(op);
+  }
+
+  void Update(const Buffer& buffer, const Array<PrimExpr>& indices) {
+    auto it = indices_.find(buffer->data.get());
+    if (it == indices_.end()) {
+      indices_.emplace(buffer->data.get(), indices);
+      buffers_[buffer->data.get()] = buffer.get();
+    } else if (it->second.defined() && (buffers_[buffer->data.get()] != buffer.get() ||
+                                        !ExprDeepEqualArray(it->second.value(), indices))) {
+      it->second = NullOpt;
+    }
+  }
+
+  static bool ExprDeepEqualArray(const Array<PrimExpr>& a, const Array<PrimExpr>& b) {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    ExprDeepEqual equal;
+    for (size_t i = 0; i < a.size(); ++i) {
+      if (!equal(a[i], b[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unordered_map<const VarNode*, arith::IntSet> dom_map_;
+  // The indices of the accesses of each data var, NullOpt if they differ or if the data var is
+  // accessed through several buffers.
+  std::unordered_map<const VarNode*, Optional<Array<PrimExpr>>> indices_;
+  std::unordered_map<const VarNode*, const BufferNode*> buffers_;
+  std::unordered_set<const VarNode*> written_;
+  // The buffers allocated in the body, which are private to an iteration.
+  std::unordered_set<const VarNode*> local_;
+  bool opaque_{false};
+};
+
 // The Visitor is used to check whether var is used as write index in a local memory
 // If a loop var is used as indices to a local memory, it must be unrolled so
 // the local memory access can be turned into register access.
 class LoopUnroller : public StmtExprMutator {
  public:
   explicit LoopUnroller(int auto_max_step, int auto_max_depth, int auto_max_extent,
-                        bool explicit_unroll, bool unroll_local_access)
+                        bool explicit_unroll, bool unroll_local_access,
+                        int64_t auto_max_instructions = 0)
       : auto_max_step_(auto_max_step),
         auto_max_depth_(auto_max_depth),
         auto_max_extent_(auto_max_extent),
         explicit_unroll_(explicit_unroll),
-        unroll_local_access_(unroll_local_access) {}
+        unroll_local_access_(unroll_local_access),
+        auto_max_instructions_(auto_max_instructions) {}
 
   Stmt VisitStmt_(const AttrStmtNode* op) final {
     if (op->attr_key == "pragma_auto_unroll_max_step") {
@@ -111,6 +291,9 @@ class LoopUnroller : public StmtExprMutator {
       Stmt ret = this->VisitStmt(op->body);
       std::swap(explicit_unroll, explicit_unroll_);
       return ret;
+    } else if (op->attr_key == "pragma_unroll_and_jam") {
+      int factor = static_cast<int>(Downcast<Integer>(op->value)->value);
+      return this->VisitStmt(UnrollAndJam(op->body, factor));
     } else {
       return StmtExprMutator::VisitStmt_(op);
     }
@@ -128,6 +311,11 @@ class LoopUnroller : public StmtExprMutator {
     auto_unroll =
         auto_unroll && (value * step_count_ <= auto_max_step_ || value <= auto_max_extent_);
 
+    // Keep the unrolled code within the instruction budget.
+    if (auto_unroll && auto_max_instructions_ > 0) {
+      auto_unroll = InstructionCounter::Count(stmt) <= auto_max_instructions_;
+    }
+
     if (op->kind == ForKind::kUnrolled) {
       ICHECK_GE(value, 0) << "Cannot unroll non-constant loop";
       auto_unroll = true;
@@ -228,6 +416,58 @@ class LoopUnroller : public StmtExprMutator {
     return SeqStmt::Flatten(unrolled);
   }
 
+  /*!
+   * \brief Unrolls the loop under the pragma wrappers of stmt by factor. When its body is a loop
+   *  whose iterations of the outer loop access disjoint elements of the written buffers, the copies
+   *  are jammed into the inner loop. The iterations left over are kept in a remainder loop.
+   */
+  Stmt UnrollAndJam(const Stmt& stmt, int factor) {
+    if (const auto* attr = stmt.as<AttrStmtNode>()) {
+      if (!attr::IsPragmaKey(attr->attr_key)) {
+        return stmt;
+      }
+      return AttrStmt(attr->node, attr->attr_key, attr->value, UnrollAndJam(attr->body, factor));
+    }
+    const auto* op = stmt.as<ForNode>();
+    if (op == nullptr || op->kind != ForKind::kSerial || op->thread_binding.defined()) {
+      return stmt;
+    }
+    int value = GetExtent(op);
+    if (factor <= 1 || value < factor) {
+      return stmt;
+    }
+    const ForNode* inner = op->body.as<ForNode>();
+    auto uses_outer_var = [op](const VarNode* var) { return var == op->loop_var.get(); };
+    bool jam = inner != nullptr && inner->kind != ForKind::kParallel &&
+               !inner->thread_binding.defined() && !UsesVar(inner->min, uses_outer_var) &&
+               !UsesVar(inner->extent, uses_outer_var) && UnrollAndJamChecker::Check(op, inner);
+
+    DataType dtype = op->loop_var.dtype();
+    Var outer_var = op->loop_var.copy_with_suffix(".outer");
+    Stmt body = jam ? inner->body : op->body;
+    Array<Stmt> copies;
+    for (int i = 0; i < factor; ++i) {
+      Map<Var, PrimExpr> vmap{{op->loop_var, op->min + outer_var * make_const(dtype, factor) +
+                                                 make_const(dtype, i)}};
+      copies.push_back(Substitute(body, vmap));
+    }
+    body = SeqStmt::Flatten(copies);
+    if (jam) {
+      body = For(inner->loop_var, inner->min, inner->extent, inner->kind, body,
+                 inner->thread_binding, inner->annotations);
+    }
+    Stmt main = For(outer_var, make_zero(dtype), make_const(dtype, value / factor), op->kind, body,
+                    op->thread_binding, op->annotations);
+    if (value % factor == 0) {
+      return main;
+    }
+    Stmt remainder =
+        For(op->loop_var, op->min + make_const(dtype, value / factor * factor),
+            make_const(dtype, value % factor), op->kind, op->body, op->thread_binding,
+            op->annotations);
+    return SeqStmt({main, remainder});
+  }
+
  private:
   // returns the extent of the loop if it's a constant integer, otherwise return -1
   int GetExtent(const ForNode* op) {
@@ -252,6 +492,8 @@ class LoopUnroller : public StmtExprMutator {
   bool explicit_unroll_;
   // Wether to unroll loops to local access.
   bool unroll_local_access_{false};
+  // The maximum estimated instruction count of an auto unrolled loop, 0 for no limit.
+  int64_t auto_max_instructions_{0};
   // Number of normal loops in scope
   int normal_loop_depth_{0};
   // number of unrolled cases in current scope.
@@ -264,9 +506,10 @@ class LoopUnroller : public StmtExprMutator {
   arith::Analyzer analyzer_;
 };
 
-Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg) {
+Stmt UnrollLoop(Stmt stmt, UnrollLoopConfig cfg, int64_t auto_max_instructions = 0) {
   Stmt ret = LoopUnroller(cfg->auto_max_step, cfg->auto_max_depth, cfg->auto_max_extent,
-                          cfg->explicit_unroll, cfg->unroll_local_access)(stmt);
+                          cfg->explicit_unroll, cfg->unroll_local_access,
+                          auto_max_instructions)(stmt);
   if (!ret.same_as(stmt)) {
     return ConvertSSA(ret);
   } else {
@@ -283,7 +526,11 @@ Pass UnrollLoop() {
     if (!cfg.defined()) {
       cfg = AttrsWithDefaultValues<UnrollLoopConfig>();
     }
-    n->body = UnrollLoop(std::move(f->body), cfg.value());
+    int64_t auto_max_instructions = cfg.value()->auto_max_instructions;
+    if (auto_max_instructions < 0) {
+      auto_max_instructions = TargetInstructionBudget(f);
+    }
+    n->body = UnrollLoop(std::move(f->body), cfg.value(), auto_max_instructions);
     return f;
   };
   return CreatePrimFuncPass(pass_func, 0, "tir.UnrollLoop", {});
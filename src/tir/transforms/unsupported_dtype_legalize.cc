@@ -329,7 +329,7 @@ class ComputeLegalizer : public StmtExprMutator {
         ICHECK(MatchDType(value->dtype));
         value = cast(new_buf->dtype.with_lanes(value.dtype().lanes()), value);
       }
-      return BufferStore(new_buf, value, indices);
+      return BufferStore(new_buf, value, indices, op->predicate);
     }
   }
 
@@ -400,7 +400,7 @@ class ComputeLegalizer : public StmtExprMutator {
     if (new_buf.same_as(op->buffer)) {
       return ret;
     } else {
-      return BufferLoad(new_buf, op->indices);
+      return BufferLoad(new_buf, op->indices, op->predicate);
     }
   }
 
@@ -557,7 +557,7 @@ class StorageLegalizer : public StmtExprMutator {
       if (MatchDType(op->value.dtype())) {
         ICHECK(new_buf->dtype.is_uint());
       }
-      return BufferStore(new_buf, value, indices);
+      return BufferStore(new_buf, value, indices, op->predicate);
     }
   }
 
@@ -590,7 +590,7 @@ class StorageLegalizer : public StmtExprMutator {
     if (new_buf.same_as(op->buffer)) {
       return ret;
     } else {
-      return BufferLoad(new_buf, op->indices);
+      return BufferLoad(new_buf, op->indices, op->predicate);
     }
   }
 
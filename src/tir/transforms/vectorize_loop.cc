@@ -38,15 +38,40 @@
 namespace tvm {
 namespace tir {
 
+// The lanes of a type in the encoding of Ramp and Broadcast, -n for vscale * n lanes.
+inline int GetLanes(DataType t) {
+  return t.is_scalable_vector() ? -t.vscale_factor() : t.lanes();
+}
+
+// The type t with the lanes in the encoding of Ramp and Broadcast.
+inline DataType WithLanes(DataType t, int lanes) {
+  return lanes > 0 ? t.with_lanes(lanes) : t.with_scalable_vscale_factor(-lanes);
+}
+
+// The lanes of an elementwise operation on operands of lanes a and b.
+inline int CombineLanes(int a, int b) {
+  if (a == 1) return b;
+  if (b == 1) return a;
+  ICHECK((a > 0 && b > 0) || a == b)
+      << "Cannot combine " << a << " and " << b << " lanes of a scalable vector";
+  return std::max(a, b);
+}
+
+// The lanes of a vector of a lanes, each with b lanes.
+inline int MultiplyLanes(int a, int b) {
+  ICHECK(a > 0 || b > 0) << "Cannot nest a scalable vector in a scalable vector";
+  return a * b;
+}
+
 inline PrimExpr BroadcastTo(PrimExpr e, int lanes) {
-  if (e.dtype().lanes() == lanes) return e;
+  if (GetLanes(e.dtype()) == lanes) return e;
   if (const BroadcastNode* op = e.as<BroadcastNode>()) {
-    if (lanes % op->lanes == 0) {
+    if ((lanes > 0) == (op->lanes > 0) && lanes % op->lanes == 0) {
       return Broadcast(op->value, lanes);
     }
   }
-  ICHECK_EQ(e.dtype().lanes(), 1) << "Cannot broadcast lane=" << e.dtype().lanes() << " to "
-                                  << lanes;
+  ICHECK(e.dtype().is_scalar()) << "Cannot broadcast " << e.dtype() << " to " << lanes
+                                << " lanes";
   return Broadcast(e, lanes);
 }
 
@@ -60,7 +85,7 @@ inline PrimExpr BroadcastTo(PrimExpr e, int lanes) {
 //
 class VecAllocAccess : public StmtExprMutator {
  public:
-  VecAllocAccess(const VarNode* buf, Var var, int var_lanes)
+  VecAllocAccess(const VarNode* buf, Var var, PrimExpr var_lanes)
       : buf_(buf), var_(var), var_lanes_(var_lanes) {}
 
   PrimExpr VisitExpr_(const BufferLoadNode* op) final {
@@ -136,7 +161,7 @@ class VecAllocAccess : public StmtExprMutator {
   // variable to be replaced
   Var var_;
   // the lanes.
-  int var_lanes_;
+  PrimExpr var_lanes_;
   // Analyzer for simplifications
   arith::Analyzer analyzer_;
 };
@@ -149,7 +174,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   using ExprFunctor::VisitExpr;
   using StmtMutator::operator();
 
-  Vectorizer(Var var, int var_lanes) : var_(var), var_lanes_(var_lanes) {
+  Vectorizer(Var var, int var_lanes, bool enable_predication)
+      : var_(var), var_lanes_(var_lanes), enable_predication_(enable_predication) {
     ramp_ = Ramp(IntImm(var->dtype, 0), IntImm(var->dtype, 1), var_lanes);
   }
 
@@ -158,6 +184,11 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     Stmt ret = StmtMutator::VisitStmt(stmt);
     if (need_scalarize_) {
       need_scalarize_ = false;
+      if (predicate_) {
+        // A part of a predicated body cannot be scalarized alone, give up the predication.
+        predication_failed_ = true;
+        return stmt;
+      }
       return Scalarize(stmt);
     } else {
       return ret;
@@ -180,14 +211,14 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (a.same_as(op->a) && b.same_as(op->b)) {
       return GetRef<PrimExpr>(op);
     } else {
-      int lanes = std::max(a.dtype().lanes(), b.dtype().lanes());
+      int lanes = CombineLanes(GetLanes(a.dtype()), GetLanes(b.dtype()));
       if (lanes != 1) {
         const RampNode* b_ramp = b.as<RampNode>();
         const RampNode* a_ramp = a.as<RampNode>();
-        if (a_ramp && b.dtype().lanes() == 1 && analyzer_.CanProve(b > 0)) {
+        if (a_ramp && b.dtype().is_scalar() && analyzer_.CanProve(b > 0)) {
           return Ramp(a_ramp->base * b, a_ramp->stride * b, a_ramp->lanes);
         }
-        if (b_ramp && a.dtype().lanes() == 1 && analyzer_.CanProve(a > 0)) {
+        if (b_ramp && a.dtype().is_scalar() && analyzer_.CanProve(a > 0)) {
           return Ramp(b_ramp->base * a, b_ramp->stride * a, b_ramp->lanes);
         }
       }
@@ -222,13 +253,19 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   PrimExpr VisitExpr_(const RampNode* op) final {
     PrimExpr base = this->VisitExpr(op->base);
     PrimExpr stride = this->VisitExpr(op->stride);
-    if (base.dtype().lanes() > 1 && stride.dtype().lanes() == 1) {
+    if (base.dtype().is_vector() && stride.dtype().is_scalar() && op->lanes > 0) {
       const RampNode* base_ramp = base.as<RampNode>();
-      if (analyzer_.CanProve(base_ramp->stride == stride * make_const(stride.dtype(), op->lanes))) {
-        return Ramp(base_ramp->base, stride, op->lanes * base_ramp->lanes);
+      if (base_ramp &&
+          analyzer_.CanProve(base_ramp->stride == stride * make_const(stride.dtype(), op->lanes))) {
+        return Ramp(base_ramp->base, stride, MultiplyLanes(op->lanes, base_ramp->lanes));
       }
     }
-    int lanes = std::max(base.dtype().lanes(), stride.dtype().lanes());
+    int lanes = CombineLanes(GetLanes(base.dtype()), GetLanes(stride.dtype()));
+    if (lanes < 0 || op->lanes < 0) {
+      // The lanes of a scalable vector cannot be concatenated one by one.
+      need_scalarize_ = true;
+      return GetRef<PrimExpr>(op);
+    }
     base = BroadcastTo(base, lanes);
     stride = BroadcastTo(stride, lanes);
     Array<PrimExpr> elems;
@@ -241,7 +278,7 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
   PrimExpr VisitExpr_(const BroadcastNode* op) final {
     PrimExpr value = this->VisitExpr(op->value);
-    if (value.dtype().lanes() != 1) {
+    if (!value.dtype().is_scalar()) {
       need_scalarize_ = true;
       return GetRef<PrimExpr>(op);
     }
@@ -259,7 +296,8 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (cond.same_as(op->condition) && t.same_as(op->true_value) && f.same_as(op->false_value)) {
       return GetRef<PrimExpr>(op);
     } else {
-      int lanes = std::max(std::max(cond.dtype().lanes(), t.dtype().lanes()), f.dtype().lanes());
+      int lanes = CombineLanes(CombineLanes(GetLanes(cond.dtype()), GetLanes(t.dtype())),
+                               GetLanes(f.dtype()));
       return Select(cond, BroadcastTo(t, lanes), BroadcastTo(f, lanes));
     }
   }
@@ -268,7 +306,7 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (value.same_as(op->value)) {
       return GetRef<PrimExpr>(op);
     } else {
-      return Cast(op->dtype.with_lanes(value.dtype().lanes()), value);
+      return Cast(WithLanes(op->dtype, GetLanes(value.dtype())), value);
     }
   }
 
@@ -304,10 +342,10 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (cond.same_as(op->args[0]) && t.same_as(op->args[1]) && f.same_as(op->args[2])) {
       return GetRef<PrimExpr>(op);
     } else {
-      int lanes = std::max(t.dtype().lanes(), f.dtype().lanes());
+      int lanes = CombineLanes(GetLanes(t.dtype()), GetLanes(f.dtype()));
       t = BroadcastTo(t, lanes);
       f = BroadcastTo(f, lanes);
-      return Call(op->dtype.with_lanes(lanes), op->op, {cond, t, f});
+      return Call(WithLanes(op->dtype, lanes), op->op, {cond, t, f});
     }
   }
   // Call
@@ -355,7 +393,7 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       if (op->args.same_as(new_args)) {
         return GetRef<PrimExpr>(op);
       } else {
-        return Call(op->dtype.with_lanes(lane), op->op, new_args);
+        return Call(WithLanes(op->dtype, lane), op->op, new_args);
       }
     }
   }
@@ -367,9 +405,20 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     Array<PrimExpr> indices = op->indices.Map(fmutate);
 
     if (!indices.same_as(op->indices)) {
+      if (op->predicate) {
+        need_scalarize_ = true;
+        return std::move(load);
+      }
       auto writer = load.CopyOnWrite();
       writer->indices = indices;
       writer->LegalizeDType();
+      if (predicate_) {
+        if (IsPredicableAccess(load->buffer, indices, load->dtype)) {
+          writer->predicate = predicate_;
+        } else {
+          predication_failed_ = true;
+        }
+      }
     }
 
     return std::move(load);
@@ -388,7 +437,7 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       ICHECK(deep_equal_(it->second, value))
           << "Let cannot bind the same var to two different values";
     }
-    if (value.dtype().lanes() != op->value.dtype().lanes()) {
+    if (GetLanes(value.dtype()) != GetLanes(op->value.dtype())) {
       Var new_var(op->var->name_hint, value.dtype());
       let_binding_[op->var] = new_var;
       return Let(new_var, value, this->VisitExpr(op->body));
@@ -414,18 +463,19 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (!indices.same_as(op->indices) || !value.same_as(op->value)) {
       // How many lanes of indexing are present in the index and
       // buffer element type, excluding the last index.  T
-      int other_index_lanes = op->buffer->dtype.lanes();
+      int other_index_lanes = GetLanes(op->buffer->dtype);
       for (size_t i = 0; i < indices.size() - 1; i++) {
-        other_index_lanes *= indices[i].dtype().lanes();
+        other_index_lanes = MultiplyLanes(other_index_lanes, GetLanes(indices[i].dtype()));
       }
 
       // The total number of lanes of indexing, including the last index.
-      int index_lanes = other_index_lanes * indices[indices.size() - 1].dtype().lanes();
+      int index_lanes =
+          MultiplyLanes(other_index_lanes, GetLanes(indices[indices.size() - 1].dtype()));
 
       // The total number of lanes in this store operation.  Either
       // the index or the value will be broadcast out to this number
       // of lanes, depending on which has more lanes.
-      int total_lanes = std::max(index_lanes, value.dtype().lanes());
+      int total_lanes = CombineLanes(index_lanes, GetLanes(value.dtype()));
 
       ICHECK_EQ(total_lanes % other_index_lanes, 0)
           << "When storing to buffer " << op->buffer->name << ", cannot produce " << total_lanes
@@ -436,10 +486,22 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       // lanes matches the desired number.
       indices.Set(indices.size() - 1, BroadcastTo(indices[indices.size() - 1], last_index_lanes));
 
+      if (op->predicate) {
+        need_scalarize_ = true;
+        return std::move(store);
+      }
       auto writer = store.CopyOnWrite();
       writer->indices = indices;
       writer->value = BroadcastTo(value, total_lanes);
     }
+    if (predicate_) {
+      if (IsPredicableAccess(store->buffer, store->indices, store->value.dtype())) {
+        store.CopyOnWrite()->predicate = predicate_;
+      } else {
+        // Includes the scalar stores, which must not happen when every lane is masked off.
+        predication_failed_ = true;
+      }
+    }
 
     return std::move(store);
   }
@@ -467,6 +529,11 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     ICHECK(!op->condition.dtype().is_vector());
     PrimExpr condition = this->VisitExpr(op->condition);
     if (condition.dtype().is_vector()) {
+      if (enable_predication_ && !op->else_case && !predicate_) {
+        if (Optional<Stmt> predicated = PredicateBody(condition, op->then_case)) {
+          return predicated.value();
+        }
+      }
       return Scalarize(GetRef<Stmt>(op));
     }
     Stmt then_case = this->VisitStmt(op->then_case);
@@ -491,7 +558,7 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     ICHECK(!let_binding_.count(op->var)) << "SSA violation, a single var is binded twice";
     let_binding_[op->var] = value;
 
-    if (value.dtype().lanes() != op->value.dtype().lanes()) {
+    if (GetLanes(value.dtype()) != GetLanes(op->value.dtype())) {
       Var new_var(op->var->name_hint, value.dtype());
       let_binding_[op->var] = new_var;
       return LetStmt(new_var, value, this->VisitStmt(op->body));
@@ -533,20 +600,96 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     // Extend the least significant dimension by a factor of
     // var_lanes_.  Typically, this will be a 1-d index into a flat
     // memory space.
-    extents.Set(extents.size() - 1, extents[extents.size() - 1] * var_lanes_);
+    PrimExpr var_lanes = VectorLanesToExpr(var_lanes_, var_->dtype);
+    extents.Set(extents.size() - 1, extents[extents.size() - 1] * var_lanes);
 
     // Rewrite access to the buffer in the body.
-    Stmt body = VecAllocAccess(op->buffer_var.get(), var_, var_lanes_)(op->body);
+    Stmt body = VecAllocAccess(op->buffer_var.get(), var_, var_lanes)(op->body);
     body = this->VisitStmt(body);
     return Allocate(op->buffer_var, op->dtype, extents, condition, body);
   }
 
+  /*!
+   * \brief Vectorize the body of a tail guard into loads and stores predicated by its vector
+   *  condition, e.g. `if i_0 * 16 + i_1 < n: B[i_0 * 16 + i_1] = A[i_0 * 16 + i_1]`.
+   * \return The predicated body, or NullOpt if the body cannot run with masked off lanes.
+   */
+  Optional<Stmt> PredicateBody(PrimExpr condition, const Stmt& body) {
+    if (const CallNode* call = condition.as<CallNode>()) {
+      if (call->op.same_as(builtin::likely())) {
+        condition = call->args[0];
+      }
+    }
+    if (GetLanes(condition.dtype()) != var_lanes_ || !IsPredicableBody(body)) {
+      return NullOpt;
+    }
+    predicate_ = condition;
+    predication_failed_ = false;
+    Stmt predicated = this->VisitStmt(body);
+    predicate_ = NullOpt;
+    if (predication_failed_) {
+      predication_failed_ = false;
+      return NullOpt;
+    }
+    return predicated;
+  }
+
+  /*!
+   * \brief Whether the body only stores into buffers, and computes nothing that can fault or has
+   *  side effects with the zeros loaded into the masked off lanes.
+   */
+  static bool IsPredicableBody(const Stmt& body) {
+    bool predicable = true;
+    auto fcheck_divisor = [&predicable](const auto* node) {
+      if (node && (node->dtype.is_int() || node->dtype.is_uint())) {
+        const int64_t* divisor = as_const_int(node->b);
+        if (divisor == nullptr || *divisor == 0) predicable = false;
+      }
+    };
+    auto fvisit_expr = [&](const ObjectRef& obj) {
+      if (const CallNode* call = obj.as<CallNode>()) {
+        if (SideEffect(GetRef<Call>(call)) > CallEffectKind::kReadState) predicable = false;
+      }
+      fcheck_divisor(obj.as<DivNode>());
+      fcheck_divisor(obj.as<ModNode>());
+      fcheck_divisor(obj.as<FloorDivNode>());
+      fcheck_divisor(obj.as<FloorModNode>());
+    };
+    std::function<bool(const Stmt&)> fcheck = [&](const Stmt& stmt) -> bool {
+      if (const auto* seq = stmt.as<SeqStmtNode>()) {
+        for (const Stmt& s : seq->seq) {
+          if (!fcheck(s)) return false;
+        }
+        return true;
+      } else if (const auto* let = stmt.as<LetStmtNode>()) {
+        PostOrderVisit(let->value, fvisit_expr);
+        return fcheck(let->body);
+      } else if (const auto* store = stmt.as<BufferStoreNode>()) {
+        PostOrderVisit(GetRef<Stmt>(store), fvisit_expr);
+        return true;
+      }
+      return false;
+    };
+    return fcheck(body) && predicable;
+  }
+
+  // Whether an access can be predicated by predicate_: a contiguous vector of its lanes, or a
+  // flat vector index of scalar elements, which becomes a masked gather/scatter.
+  bool IsPredicableAccess(const Buffer& buffer, const Array<PrimExpr>& indices,
+                          DataType value_dtype) const {
+    if (GetLanes(value_dtype) != GetLanes(predicate_.value().dtype())) return false;
+    const auto* ramp = indices.back().as<RampNode>();
+    if (ramp && is_one(ramp->stride)) return true;
+    return indices.size() == 1 && buffer->dtype.lanes() == 1 && !value_dtype.is_scalable_vector() &&
+           indices[0].dtype().lanes() == value_dtype.lanes();
+  }
+
   // scalarize the statment
   Stmt Scalarize(Stmt stmt) {
     Var idx(var_->name_hint + ".s", var_->dtype);
     stmt = Substitute(stmt, {{var_, idx}});
-    return For(idx, IntImm(var_->dtype, 0), IntImm(var_->dtype, var_lanes_), ForKind::kSerial,
-               stmt);
+    return For(idx, IntImm(var_->dtype, 0), VectorLanesToExpr(var_lanes_, var_->dtype),
+               ForKind::kSerial, stmt);
   }
   // ProducerStore
   Stmt VisitStmt_(const ProducerStoreNode* op) final {
@@ -560,12 +703,18 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
   ExprDeepEqual deep_equal_;
   // variable to be replaced
   Var var_;
-  // the lanes.
+  // the lanes, -n for the vscale * n lanes of a scalable vector.
   int var_lanes_;
   // ramp representing the var.
   PrimExpr ramp_;
   // flag to mark requirment of scalarization.
   bool need_scalarize_{false};
+  // Whether the bodies of tail guards may be predicated.
+  bool enable_predication_;
+  // The predicate of the loads and stores of the body being predicated.
+  Optional<PrimExpr> predicate_{NullOpt};
+  // Whether the body being predicated has an access that cannot be predicated.
+  bool predication_failed_{false};
   // Let binding
   std::unordered_map<Var, PrimExpr, ObjectPtrHash, ObjectPtrEqual> let_binding_;
   // vectorizable property
@@ -583,11 +732,12 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
       PrimExpr new_elem = this->VisitExpr(old_elem);
       if (!new_elem.same_as(old_elem)) changed = true;
       new_arr[i] = new_elem;
-      lanes = std::max(lanes, new_elem.dtype().lanes());
+      int elem_lanes = GetLanes(new_elem.dtype());
+      lanes = lanes == 0 ? elem_lanes : CombineLanes(lanes, elem_lanes);
     }
 
     for (size_t i = 0; i < arr.size(); ++i) {
-      if (new_arr[i].dtype().lanes() != lanes) {
+      if (GetLanes(new_arr[i].dtype()) != lanes) {
         new_arr[i] = BroadcastTo(new_arr[i], lanes);
         changed = true;
       }
@@ -603,7 +753,7 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (a.same_as(op->a) && b.same_as(op->b)) {
       return GetRef<PrimExpr>(op);
     } else {
-      int lanes = std::max(a.dtype().lanes(), b.dtype().lanes());
+      int lanes = CombineLanes(GetLanes(a.dtype()), GetLanes(b.dtype()));
       return TOp(BroadcastTo(a, lanes), BroadcastTo(b, lanes));
     }
   }
@@ -614,15 +764,15 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
     if (a.same_as(op->a) && b.same_as(op->b)) {
       return GetRef<PrimExpr>(op);
     } else {
-      int lanes = std::max(a.dtype().lanes(), b.dtype().lanes());
+      int lanes = CombineLanes(GetLanes(a.dtype()), GetLanes(b.dtype()));
       if (lanes != 1) {
         const RampNode* b_ramp = b.as<RampNode>();
         const RampNode* a_ramp = a.as<RampNode>();
-        if (a.dtype().lanes() == 1 && b_ramp) {
+        if (a.dtype().is_scalar() && b_ramp) {
           return Ramp(fcompute(a, b_ramp->base),
                       fcompute(make_zero(b_ramp->stride.dtype()), b_ramp->stride), b_ramp->lanes);
         }
-        if (b.dtype().lanes() == 1 && a_ramp) {
+        if (b.dtype().is_scalar() && a_ramp) {
           return Ramp(fcompute(a_ramp->base, b), a_ramp->stride, a_ramp->lanes);
         }
       }
@@ -633,18 +783,25 @@ class Vectorizer : public StmtMutator, public ExprFunctor<PrimExpr(const PrimExp
 
 class LoopVectorizer : public StmtMutator {
  public:
+  explicit LoopVectorizer(bool enable_predication = false)
+      : enable_predication_(enable_predication) {}
+
   Stmt VisitStmt_(const ForNode* op) final {
     if (op->kind == ForKind::kVectorized) {
       ICHECK(is_zero(op->min));
-      auto* extent_as_int = op->extent.as<IntImmNode>();
-      if (!extent_as_int || extent_as_int->value < 1) {
+      // The extent is a constant, or vscale * n for a scalable vector of -n lanes.
+      Optional<Integer> lanes = VectorLanesFromExpr(op->extent);
+      if (!lanes) {
         LOG(FATAL) << "Failed to vectorize loop with extent " << op->extent;
       }
-      return Vectorizer(op->loop_var, static_cast<int>(extent_as_int->value))(op->body);
+      return Vectorizer(op->loop_var, lanes.value()->value, enable_predication_)(op->body);
     } else {
       return StmtMutator::VisitStmt_(op);
     }
   }
+
+ private:
+  bool enable_predication_;
 };
 
 Stmt VectorizeLoop(Stmt stmt) { return LoopVectorizer()(std::move(stmt)); }
@@ -666,12 +823,16 @@ Stmt SkipVectorize(Stmt stmt) { return VectorizeSkipper()(std::move(stmt)); }
 
 namespace transform {
 
+TVM_REGISTER_PASS_CONFIG_OPTION("tir.enable_buffer_level_predication", Bool);
+
 // TODO(tvm-team): Make it as a target property.
 Pass VectorizeLoop(bool enable_vectorize) {
   auto pass_func = [=](PrimFunc f, IRModule m, PassContext ctx) {
     auto* n = f.CopyOnWrite();
     if (enable_vectorize) {
-      n->body = LoopVectorizer()(std::move(n->body));
+      bool enable_predication =
+          ctx->GetConfig<Bool>("tir.enable_buffer_level_predication", Bool(false)).value();
+      n->body = LoopVectorizer(enable_predication)(std::move(n->body));
     } else {
       n->body = VectorizeSkipper()(std::move(n->body));
     }
@@ -0,0 +1,168 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tir/usmp/algo/access_aware.cc
+ * \brief This source contains the access aware assignment of pool
+ * candidates, which runs before the memory planning algorithm when
+ * the tir.usmp.access_aware option is set.
+ *
+ * The pool candidates of each BufferInfo are ordered by the cost of
+ * an access to the pool, derived from the latency and bandwidth of
+ * the PoolInfo. As the cheap pools are usually small, the BufferInfo
+ * objects are then placed in the order of their access density
+ * (accesses per byte), each in the cheapest pool where it fits next
+ * to the already placed conflicting BufferInfo objects. Pool
+ * candidates cheaper than the one found are removed, so that the
+ * planning algorithm, whatever the order it places the BufferInfo
+ * objects in, leaves the space of the cheap pools to the most
+ * frequently accessed ones.
+ */
+
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/usmp/algo/greedy.h>
+#include <tvm/tir/usmp/algorithms.h>
+#include <tvm/tir/usmp/utils.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+namespace usmp {
+namespace algo {
+
+/*!
+ * \brief Returns the cost of an access to the pool, in cycles, or in seconds if
+ * \p use_clock_frequency is set.
+ */
+static double AccessCost(const PoolInfo& pool_info, bool use_clock_frequency) {
+  double cycles = (pool_info->read_latency_cycles->value + pool_info->write_latency_cycles->value) /
+                  2.0;
+  int64_t read_bandwidth = pool_info->read_bandwidth_bytes_per_cycle->value;
+  int64_t write_bandwidth = pool_info->write_bandwidth_bytes_per_cycle->value;
+  if (read_bandwidth > 0 && write_bandwidth > 0) {
+    cycles += (1.0 / read_bandwidth + 1.0 / write_bandwidth) / 2.0;
+  }
+  if (use_clock_frequency) {
+    return cycles / pool_info->clock_frequency_hz->value;
+  }
+  return cycles;
+}
+
+/*!
+ * \brief Places the BufferInfo objects, in the order of their access density, in the
+ * first of their pool candidates where they fit.
+ */
+class AccessAwarePlacement : public GreedyBase {
+ public:
+  AccessAwarePlacement() {}
+
+  /*!
+   * \brief Returns the simulated placement, leaving out the BufferInfo objects which
+   * do not fit in any of their pool candidates.
+   */
+  Map<BufferInfo, PoolAllocation> PlanMemory(const Array<BufferInfo>& buffer_info_arr) {
+    std::vector<BufferInfo> buffer_info_vec(buffer_info_arr.begin(), buffer_info_arr.end());
+    std::stable_sort(buffer_info_vec.begin(), buffer_info_vec.end(),
+                     [](const BufferInfo& a, const BufferInfo& b) {
+                       double a_density = static_cast<double>(a->access_count) /
+                                          std::max<int64_t>(a->size_bytes->value, 1);
+                       double b_density = static_cast<double>(b->access_count) /
+                                          std::max<int64_t>(b->size_bytes->value, 1);
+                       return a_density > b_density;
+                     });
+    Map<BufferInfo, PoolAllocation> pool_allocations;
+    for (const auto& buf_info : buffer_info_vec) {
+      size_t size_bytes = buf_info->size_bytes->value;
+      for (const auto& pool_info : buf_info->pool_candidates) {
+        size_t next_offset = 0;
+        for (const auto& conflict_buf_info_obj : buf_info->conflicts) {
+          auto conflict_buf_info = Downcast<BufferInfo>(conflict_buf_info_obj);
+          auto it = pool_allocations.find(conflict_buf_info);
+          if (it == pool_allocations.end() || (*it).second->pool_info != pool_info) {
+            continue;
+          }
+          size_t end_offset =
+              (*it).second->byte_offset.IntValue() + conflict_buf_info->size_bytes.IntValue();
+          next_offset = std::max(next_offset, round_up_to_byte_alignment(
+                                                  end_offset, conflict_buf_info->alignment->value));
+        }
+        if (IsValidPlacement(pool_info, next_offset, size_bytes)) {
+          pool_allocations.Set(buf_info, PoolAllocation(pool_info, Integer(next_offset)));
+          break;
+        }
+      }
+    }
+    return pool_allocations;
+  }
+};
+
+void AssignPoolsByAccessCost(const Array<BufferInfo>& buffer_info_arr) {
+  std::unordered_map<PoolInfo, double, ObjectPtrHash, ObjectPtrEqual> access_costs;
+  bool use_clock_frequency = true;
+  for (const auto& buf_info : buffer_info_arr) {
+    for (const auto& pool_info : buf_info->pool_candidates) {
+      use_clock_frequency &= pool_info->clock_frequency_hz->value > 0;
+    }
+  }
+  for (const auto& buf_info : buffer_info_arr) {
+    for (const auto& pool_info : buf_info->pool_candidates) {
+      access_costs[pool_info] = AccessCost(pool_info, use_clock_frequency);
+    }
+  }
+
+  for (const auto& buf_info : buffer_info_arr) {
+    std::vector<PoolInfo> pool_candidates(buf_info->pool_candidates.begin(),
+                                          buf_info->pool_candidates.end());
+    std::stable_sort(pool_candidates.begin(), pool_candidates.end(),
+                     [&access_costs](const PoolInfo& a, const PoolInfo& b) {
+                       return access_costs[a] < access_costs[b];
+                     });
+    buf_info->pool_candidates = Array<PoolInfo>(pool_candidates.begin(), pool_candidates.end());
+  }
+
+  Map<BufferInfo, PoolAllocation> pool_allocations =
+      AccessAwarePlacement().PlanMemory(buffer_info_arr);
+  for (const auto& buf_info : buffer_info_arr) {
+    auto it = pool_allocations.find(buf_info);
+    if (it == pool_allocations.end()) {
+      continue;
+    }
+    double placed_cost = access_costs[(*it).second->pool_info];
+    Array<PoolInfo> pool_candidates;
+    for (const auto& pool_info : buf_info->pool_candidates) {
+      if (access_costs[pool_info] >= placed_cost) {
+        pool_candidates.push_back(pool_info);
+      }
+    }
+    buf_info->pool_candidates = pool_candidates;
+  }
+}
+
+TVM_REGISTER_GLOBAL("tir.usmp.algo.assign_pools_by_access_cost")
+    .set_body_typed([](Array<BufferInfo> buffer_info_arr) {
+      AssignPoolsByAccessCost(buffer_info_arr);
+    });
+
+}  // namespace algo
+}  // namespace usmp
+}  // namespace tir
+}  // namespace tvm
@@ -0,0 +1,430 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/*!
+ * \file tir/usmp/algo/optimal.cc
+ * \brief Implement the branch-and-bound memory planning algorithm
+ *
+ * optimal : this algorithm searches the orders in which the BufferInfo
+ * objects are placed, placing each one at the lowest offset of its first
+ * pool candidate where it fits between the already placed conflicting
+ * BufferInfo objects. The search is depth-first, starting from the orders
+ * of greedy_by_size and greedy_by_conflicts, and prunes the partial orders
+ * whose lower bound of the total pool size is not better than the best
+ * one found. It stops when the search space is exhausted, when the best
+ * pool sizes reach the lower bound of the liveness cliques, or when the
+ * time budget given by the tir.usmp.optimal_time_budget_ms option runs
+ * out, returning the best allocation found so far.
+ */
+
+#include <tvm/ir/transform.h>
+#include <tvm/runtime/device_api.h>
+#include <tvm/runtime/registry.h>
+#include <tvm/tir/usmp/algo/greedy.h>
+#include <tvm/tir/usmp/algorithms.h>
+#include <tvm/tir/usmp/utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tvm {
+namespace tir {
+namespace usmp {
+namespace algo {
+
+/*!
+ * \brief Returns the symmetric liveness conflicts of each BufferInfo as indexes into
+ * \p buffer_info_arr, ignoring the conflicts of a BufferInfo with itself.
+ */
+static std::vector<std::vector<int>> ConflictIndexes(const Array<BufferInfo>& buffer_info_arr) {
+  std::unordered_map<const BufferInfoNode*, int> index;
+  for (size_t i = 0; i < buffer_info_arr.size(); ++i) {
+    index[buffer_info_arr[i].operator->()] = i;
+  }
+  std::vector<std::unordered_set<int>> conflict_sets(buffer_info_arr.size());
+  for (size_t i = 0; i < buffer_info_arr.size(); ++i) {
+    for (const auto& conflict : buffer_info_arr[i]->conflicts) {
+      auto it = index.find(conflict.as<BufferInfoNode>());
+      if (it == index.end() || it->second == static_cast<int>(i)) {
+        continue;
+      }
+      conflict_sets[i].insert(it->second);
+      conflict_sets[it->second].insert(i);
+    }
+  }
+  std::vector<std::vector<int>> conflicts(buffer_info_arr.size());
+  for (size_t i = 0; i < buffer_info_arr.size(); ++i) {
+    conflicts[i].assign(conflict_sets[i].begin(), conflict_sets[i].end());
+    std::sort(conflicts[i].begin(), conflicts[i].end());
+  }
+  return conflicts;
+}
+
+/*!
+ * \brief Returns a lower bound of the size of the pool holding the BufferInfo objects in
+ * \p members, which is the largest total size of a set of pairwise conflicting members.
+ * The sets are grown greedily from each member by decreasing size of its conflicts.
+ */
+static size_t CliqueLowerBound(const Array<BufferInfo>& buffer_info_arr,
+                               const std::vector<std::vector<int>>& conflicts,
+                               const std::vector<int>& members) {
+  std::unordered_set<int> member_set(members.begin(), members.end());
+  auto size_of = [&](int i) { return static_cast<size_t>(buffer_info_arr[i]->size_bytes->value); };
+  auto conflicting = [&](int a, int b) {
+    return std::binary_search(conflicts[a].begin(), conflicts[a].end(), b);
+  };
+  size_t bound = 0;
+  for (int seed : members) {
+    std::vector<int> candidates;
+    for (int c : conflicts[seed]) {
+      if (member_set.count(c)) candidates.push_back(c);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [&](int a, int b) { return size_of(a) > size_of(b); });
+    std::vector<int> clique = {seed};
+    size_t total = size_of(seed);
+    for (int c : candidates) {
+      if (std::all_of(clique.begin(), clique.end(), [&](int m) { return conflicting(c, m); })) {
+        clique.push_back(c);
+        total += size_of(c);
+      }
+    }
+    bound = std::max(bound, total);
+  }
+  return bound;
+}
+
+Map<PoolInfo, Integer> PoolSizeLowerBounds(
+    const Array<BufferInfo>& buffer_info_arr,
+    const Map<BufferInfo, PoolAllocation>& buffer_pool_allocations) {
+  std::vector<std::vector<int>> conflicts = ConflictIndexes(buffer_info_arr);
+  std::unordered_map<PoolInfo, std::vector<int>, ObjectPtrHash, ObjectPtrEqual> pool_members;
+  std::vector<PoolInfo> pools;
+  for (size_t i = 0; i < buffer_info_arr.size(); ++i) {
+    auto it = buffer_pool_allocations.find(buffer_info_arr[i]);
+    if (it == buffer_pool_allocations.end()) {
+      continue;
+    }
+    const PoolInfo& pool_info = (*it).second->pool_info;
+    if (!pool_members.count(pool_info)) {
+      pools.push_back(pool_info);
+    }
+    pool_members[pool_info].push_back(i);
+  }
+  Map<PoolInfo, Integer> bounds;
+  for (const PoolInfo& pool_info : pools) {
+    bounds.Set(pool_info, Integer(static_cast<int64_t>(CliqueLowerBound(
+                              buffer_info_arr, conflicts, pool_members[pool_info]))));
+  }
+  return bounds;
+}
+
+/*!
+ * \brief This class implements the branch-and-bound algorithm. Please refer to
+ * main documentation of the file for more details.
+ */
+class OptimalAllocator : public GreedyBase {
+ public:
+  explicit OptimalAllocator(int64_t time_budget_ms) : time_budget_ms_(time_budget_ms) {}
+
+  Map<BufferInfo, PoolAllocation> PlanMemory(const Array<BufferInfo>& buffer_info_arr) {
+    Map<BufferInfo, PoolAllocation> result;
+    if (buffer_info_arr.empty()) {
+      return result;
+    }
+    start_ = std::chrono::steady_clock::now();
+    Init(buffer_info_arr);
+    // Seed the search with the orders of the greedy algorithms
+    std::vector<int> by_size(num_buffers_);
+    std::iota(by_size.begin(), by_size.end(), 0);
+    std::vector<int> by_conflicts = by_size;
+    std::sort(by_size.begin(), by_size.end(), [&](int a, int b) {
+      if (sizes_[a] != sizes_[b]) return sizes_[a] > sizes_[b];
+      return conflicts_[a].size() > conflicts_[b].size();
+    });
+    std::sort(by_conflicts.begin(), by_conflicts.end(), [&](int a, int b) {
+      if (conflicts_[a].size() != conflicts_[b].size()) {
+        return conflicts_[a].size() > conflicts_[b].size();
+      }
+      return sizes_[a] > sizes_[b];
+    });
+    PlaceInOrder(by_size);
+    PlaceInOrder(by_conflicts);
+    if (best_total_ > lower_bound_) {
+      Search(0);
+    }
+    if (best_pools_.empty()) {
+      // Nothing fits, report the same error as the greedy algorithms
+      std::unordered_map<PoolInfo, size_t, ObjectPtrHash, ObjectPtrEqual> no_pools;
+      SelectPlacementPool(buffer_info_arr[0], no_pools);
+    }
+    for (int i = 0; i < num_buffers_; ++i) {
+      result.Set(buffer_info_arr[i],
+                 PoolAllocation(pools_[best_pools_[i]], Integer(best_offsets_[i])));
+    }
+    Report(buffer_info_arr, result);
+    return result;
+  }
+
+ private:
+  void Init(const Array<BufferInfo>& buffer_info_arr) {
+    num_buffers_ = buffer_info_arr.size();
+    conflicts_ = ConflictIndexes(buffer_info_arr);
+    std::unordered_map<PoolInfo, int, ObjectPtrHash, ObjectPtrEqual> pool_index;
+    bool single_candidates = true;
+    for (const BufferInfo& buf_info : buffer_info_arr) {
+      ICHECK(buf_info->pool_candidates.size())
+          << "Cannot process buffer \"" << buf_info->name_hint << "\" with no pool candidates";
+      sizes_.push_back(buf_info->size_bytes->value);
+      alignments_.push_back(std::max<int64_t>(buf_info->alignment->value, 1));
+      std::vector<int> candidates;
+      for (const PoolInfo& pool_info : buf_info->pool_candidates) {
+        auto it = pool_index.find(pool_info);
+        if (it == pool_index.end()) {
+          it = pool_index.emplace(pool_info, pools_.size()).first;
+          pools_.push_back(pool_info);
+        }
+        candidates.push_back(it->second);
+      }
+      single_candidates = single_candidates && candidates.size() == 1;
+      pool_candidates_.push_back(std::move(candidates));
+    }
+    pools_of_.assign(num_buffers_, -1);
+    offsets_.assign(num_buffers_, 0);
+    pool_peaks_.assign(pools_.size(), 0);
+    // With a single candidate per buffer the pools are known, and so are their lower bounds
+    lower_bound_ = 0;
+    if (single_candidates) {
+      std::vector<std::vector<int>> pool_members(pools_.size());
+      for (int i = 0; i < num_buffers_; ++i) {
+        pool_members[pool_candidates_[i][0]].push_back(i);
+      }
+      for (const std::vector<int>& members : pool_members) {
+        lower_bound_ += CliqueLowerBound(buffer_info_arr, conflicts_, members);
+      }
+    }
+  }
+
+  /*!
+   * \brief Finds the first pool candidate and the lowest offset in it where \p buf fits
+   * between the placed conflicting buffers. Returns false if it fits in none.
+   */
+  bool FirstFit(int buf, int* pool, size_t* offset) {
+    for (int candidate : pool_candidates_[buf]) {
+      std::vector<std::pair<size_t, size_t>> intervals;
+      for (int c : conflicts_[buf]) {
+        if (pools_of_[c] == candidate) {
+          intervals.emplace_back(offsets_[c], offsets_[c] + sizes_[c]);
+        }
+      }
+      std::sort(intervals.begin(), intervals.end());
+      size_t next_offset = 0;
+      for (const auto& interval : intervals) {
+        if (next_offset + sizes_[buf] <= interval.first) {
+          break;
+        }
+        next_offset = std::max(next_offset, round_up_to_byte_alignment(interval.second,
+                                                                       alignments_[buf]));
+      }
+      if (IsValidPlacement(pools_[candidate], next_offset, sizes_[buf])) {
+        *pool = candidate;
+        *offset = next_offset;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Place(int buf, int pool, size_t offset) {
+    pools_of_[buf] = pool;
+    offsets_[buf] = offset;
+  }
+
+  void Unplace(int buf) { pools_of_[buf] = -1; }
+
+  size_t Total(const std::vector<size_t>& peaks) const {
+    return std::accumulate(peaks.begin(), peaks.end(), size_t(0));
+  }
+
+  void RecordIfBetter() {
+    size_t total = Total(pool_peaks_);
+    if (total < best_total_) {
+      best_total_ = total;
+      best_pools_ = pools_of_;
+      best_offsets_ = offsets_;
+    }
+  }
+
+  /*! \brief Places the buffers in \p order, recording the allocation if it is the best. */
+  void PlaceInOrder(const std::vector<int>& order) {
+    std::vector<size_t> saved_peaks = pool_peaks_;
+    bool fits = true;
+    for (int buf : order) {
+      int pool;
+      size_t offset;
+      if (!FirstFit(buf, &pool, &offset)) {
+        fits = false;
+        break;
+      }
+      Place(buf, pool, offset);
+      pool_peaks_[pool] = std::max(pool_peaks_[pool], offset + sizes_[buf]);
+    }
+    if (fits) {
+      RecordIfBetter();
+    }
+    for (int buf : order) {
+      Unplace(buf);
+    }
+    pool_peaks_ = saved_peaks;
+  }
+
+  bool OutOfTime() {
+    if (++nodes_visited_ % 256 == 0) {
+      auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start_);
+      timed_out_ = elapsed.count() >= time_budget_ms_;
+    }
+    return timed_out_;
+  }
+
+  /*! \brief Extends the partial allocation of \p num_placed buffers in every possible order. */
+  void Search(int num_placed) {
+    if (OutOfTime() || best_total_ <= lower_bound_) {
+      return;
+    }
+    if (num_placed == num_buffers_) {
+      RecordIfBetter();
+      return;
+    }
+    // The first fit of each buffer left, whose offset only grows as more buffers are placed
+    struct Branch {
+      int buf;
+      int pool;
+      size_t offset;
+    };
+    std::vector<Branch> branches;
+    std::vector<size_t> bound_peaks = pool_peaks_;
+    for (int buf = 0; buf < num_buffers_; ++buf) {
+      if (pools_of_[buf] != -1) continue;
+      Branch branch{buf, -1, 0};
+      if (!FirstFit(buf, &branch.pool, &branch.offset)) {
+        return;
+      }
+      if (pool_candidates_[buf].size() == 1) {
+        size_t& peak = bound_peaks[branch.pool];
+        peak = std::max(peak, branch.offset + sizes_[buf]);
+      }
+      branches.push_back(branch);
+    }
+    if (Total(bound_peaks) >= best_total_) {
+      return;
+    }
+    // Try the lowest offsets first, then the largest buffers
+    std::sort(branches.begin(), branches.end(), [&](const Branch& a, const Branch& b) {
+      if (a.offset != b.offset) return a.offset < b.offset;
+      if (sizes_[a.buf] != sizes_[b.buf]) return sizes_[a.buf] > sizes_[b.buf];
+      return a.buf < b.buf;
+    });
+    for (const Branch& branch : branches) {
+      size_t saved_peak = pool_peaks_[branch.pool];
+      Place(branch.buf, branch.pool, branch.offset);
+      pool_peaks_[branch.pool] = std::max(saved_peak, branch.offset + sizes_[branch.buf]);
+      Search(num_placed + 1);
+      pool_peaks_[branch.pool] = saved_peak;
+      Unplace(branch.buf);
+      if (timed_out_ || best_total_ <= lower_bound_) {
+        return;
+      }
+    }
+  }
+
+  void Report(const Array<BufferInfo>& buffer_info_arr,
+              const Map<BufferInfo, PoolAllocation>& result) {
+    Map<PoolInfo, Integer> lower_bounds = PoolSizeLowerBounds(buffer_info_arr, result);
+    std::vector<size_t> sizes(pools_.size(), 0);
+    for (int i = 0; i < num_buffers_; ++i) {
+      size_t& size = sizes[best_pools_[i]];
+      size = std::max(size, best_offsets_[i] + sizes_[i]);
+    }
+    for (size_t p = 0; p < pools_.size(); ++p) {
+      if (!lower_bounds.count(pools_[p])) continue;
+      LOG(INFO) << "USMP optimal: pool \"" << pools_[p]->pool_name << "\" uses " << sizes[p]
+                << " bytes, lower bound " << lower_bounds[pools_[p]] << " bytes";
+    }
+    LOG(INFO) << "USMP optimal: "
+              << (best_total_ <= lower_bound_ ? "reached the lower bound"
+                  : timed_out_               ? "time budget exhausted"
+                                             : "search space exhausted")
+              << " after " << nodes_visited_ << " search nodes";
+  }
+
+  /*! \brief The time budget of the search in milliseconds. */
+  int64_t time_budget_ms_;
+  /*! \brief The time the search started. */
+  std::chrono::steady_clock::time_point start_;
+  /*! \brief The number of search nodes visited. */
+  int64_t nodes_visited_ = 0;
+  /*! \brief Whether the time budget ran out. */
+  bool timed_out_ = false;
+
+  int num_buffers_ = 0;
+  std::vector<size_t> sizes_;
+  std::vector<size_t> alignments_;
+  std::vector<std::vector<int>> conflicts_;
+  /*! \brief The pool candidates of each buffer, as indexes into pools_. */
+  std::vector<std::vector<int>> pool_candidates_;
+  std::vector<PoolInfo> pools_;
+  /*! \brief The lower bound of the total size, 0 if unknown. */
+  size_t lower_bound_ = 0;
+
+  /*! \brief The partial allocation, pools_of_ is -1 for the buffers not placed. */
+  std::vector<int> pools_of_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> pool_peaks_;
+
+  /*! \brief The best allocation found. */
+  size_t best_total_ = std::numeric_limits<size_t>::max();
+  std::vector<int> best_pools_;
+  std::vector<size_t> best_offsets_;
+};
+
+Map<BufferInfo, PoolAllocation> Optimal(const Array<BufferInfo>& buffer_info_arr,
+                                        const Integer& memory_pressure) {
+  transform::PassContext pass_ctx = transform::PassContext::Current();
+  int64_t time_budget_ms =
+      pass_ctx->GetConfig<Integer>(kUSMPOptimalTimeBudgetOption, Integer(1000)).value()->value;
+  return OptimalAllocator(time_budget_ms).PlanMemory(buffer_info_arr);
+}
+
+TVM_REGISTER_GLOBAL("tir.usmp.algo.optimal")
+    .set_body_typed([](Array<BufferInfo> buffer_info_arr, Integer memory_pressure) {
+      return Optimal(buffer_info_arr, memory_pressure);
+    });
+
+TVM_REGISTER_GLOBAL("tir.usmp.algo.pool_size_lower_bounds").set_body_typed(PoolSizeLowerBounds);
+
+}  // namespace algo
+}  // namespace usmp
+}  // namespace tir
+}  // namespace tvm
@@ -34,6 +34,7 @@
 #include <tvm/tir/usmp/analysis.h>
 #include <tvm/tir/usmp/utils.h>
 
+#include <algorithm>
 #include <stack>
 
 #include "../../../runtime/thread_storage_scope.h"
@@ -81,6 +82,7 @@ class BufferInfoExtractor : public StmtExprVisitor {
   void VisitStmt_(const ForNode* op) override;
 
   void UpdateAliases(const Array<PrimExpr>& args, const PrimFunc& func);
+  void RecordAccess(const Var& buffer_var);
   void RecordAllocateNodeInfo(const AllocateNode* op);
   void RecordAllocateConstNodeInfo(const AllocateConstNode* op);
   void VisitPrimFunc(const PrimFunc& func, const Call& call);
@@ -130,6 +132,14 @@ class BufferInfoExtractor : public StmtExprVisitor {
    * \brief Indicates a count of stmts visited so far to use as a metric of liveness
    */
   int current_stmt_idx_ = 0;
+  /*!
+   * \brief The product of the trip counts of the loops the visitor is currently in.
+   */
+  double loop_trip_count_ = 1.0;
+  /*!
+   * \brief The number of accesses to each allocate, weighted by their loop trip counts.
+   */
+  std::unordered_map<Stmt, double, ObjectPtrHash, ObjectPtrEqual> access_counts_;
   /*!
    * \brief This structure is supposed to contain information around the scope
    * the visitor is currently in.
@@ -362,7 +372,12 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   Call current_call = scope_stack_.top().call;
   PrimFunc current_primfunc = scope_stack_.top().func;
   scope_stack_.push(si);
+  double outer_trip_count = loop_trip_count_;
+  if (const auto* extent = op->extent.as<IntImmNode>()) {
+    loop_trip_count_ *= std::max<int64_t>(extent->value, 1);
+  }
   StmtExprVisitor::VisitStmt_(op);
+  loop_trip_count_ = outer_trip_count;
   // Extending the liveness to beginning of for-loop next and end of the current for-loop
   for (const Allocate& allocate : scope_stack_.top().allocate_nodes) {
     AllocateInfo ai = allocate_infos[allocate->buffer_var];
@@ -384,13 +399,22 @@ void BufferInfoExtractor::VisitStmt_(const ForNode* op) {
   scope_stack_.pop();
 }
 
+void BufferInfoExtractor::RecordAccess(const Var& buffer_var) {
+  auto it = allocate_infos.find(buffer_var);
+  if (it != allocate_infos.end()) {
+    access_counts_[it->second.Allocate] += loop_trip_count_;
+  }
+}
+
 void BufferInfoExtractor::VisitExpr_(const BufferLoadNode* op) {
   this->VisitExpr(op->buffer->data);
+  RecordAccess(op->buffer->data);
   StmtExprVisitor::VisitExpr_(op);
 }
 
 void BufferInfoExtractor::VisitStmt_(const BufferStoreNode* op) {
   this->VisitExpr(op->buffer->data);
+  RecordAccess(op->buffer->data);
   StmtExprVisitor::VisitStmt_(op);
 }
 
@@ -502,6 +526,14 @@ void BufferInfoExtractor::VisitExpr_(const CallNode* op) {
 BufferInfoAnalysis BufferInfoExtractor::operator()(const PrimFunc& main_func) {
   VisitPrimFunc(main_func, Call());
 
+  for (const auto& kv : buffer_info_map_) {
+    auto it = access_counts_.find(kv.second);
+    if (it != access_counts_.end()) {
+      double access_count = std::min(it->second, 9.0e18);
+      kv.first->SetAccessCount(static_cast<int64_t>(access_count));
+    }
+  }
+
   // Create a vector of liveness events
   // associated with each BufferNodes.
   std::vector<LivenessEvent> le_events_timeline;
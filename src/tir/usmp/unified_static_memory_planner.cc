@@ -42,6 +42,8 @@ TVM_REGISTER_PASS_CONFIG_OPTION(kUSMPEnableOption, Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION(kUSMPAlgorithmOption, String);
 TVM_REGISTER_PASS_CONFIG_OPTION(kUSMPUseWorkspaceIO, Bool);
 TVM_REGISTER_PASS_CONFIG_OPTION(kUSMPCustomAlgorithmOption, String);
+TVM_REGISTER_PASS_CONFIG_OPTION(kUSMPOptimalTimeBudgetOption, Integer);
+TVM_REGISTER_PASS_CONFIG_OPTION(kUSMPAccessAwareOption, Bool);
 
 namespace tir {
 namespace usmp {
@@ -52,10 +54,11 @@ static std::unordered_map<String, std::function<Map<BufferInfo, PoolAllocation>(
                                       const Array<BufferInfo>&, const Integer&)>>
     algorithms{{"greedy_by_size", algo::GreedyBySize},
                {"greedy_by_conflicts", algo::GreedyByConflicts},
-               {"hill_climb", algo::HillClimb}};
+               {"hill_climb", algo::HillClimb},
+               {"optimal", algo::Optimal}};
 
 IRModule PlanMemory(const IRModule& mod, String algo, bool use_workspace_io,
-                    Optional<String> opt_custom_algo) {
+                    Optional<String> opt_custom_algo, bool access_aware) {
   VLOG(1) << "workspace required = " << CalculateModuleWorkspaceSize(mod);
   IRModule module = mod->ShallowCopy();
   if (use_workspace_io) {
@@ -66,6 +69,9 @@ IRModule PlanMemory(const IRModule& mod, String algo, bool use_workspace_io,
   BufferInfoAnalysis buffer_info_analysis = ExtractBufferInfo(main_func, module);
   Array<BufferInfo> buffer_info_arr =
       ConvertToArrayOfBufferInfo(buffer_info_analysis->buffer_info_stmts);
+  if (access_aware) {
+    algo::AssignPoolsByAccessCost(buffer_info_arr);
+  }
   decltype(algorithms)::mapped_type algorithm;
   if (opt_custom_algo) {
     String algo_func_name = "tir.usmp.algo." + opt_custom_algo.value();
@@ -112,6 +118,7 @@ tvm::transform::Pass UnifiedStaticMemoryPlanner() {
     auto algorithm_str = ctx->GetConfig(kUSMPAlgorithmOption, String(usmp::kDefaultAlgo));
     auto use_workspace_io = ctx->GetConfig(kUSMPUseWorkspaceIO, Bool(false));
     auto custom_algorithm_str = ctx->GetConfig<String>(kUSMPCustomAlgorithmOption);
+    auto access_aware = ctx->GetConfig(kUSMPAccessAwareOption, Bool(false));
     tvm::relay::Executor executor_config =
         m->GetAttr<tvm::relay::Executor>(tvm::attr::kExecutor).value();
     String interface_api = executor_config->GetAttr<String>("interface-api").value_or("packed");
@@ -125,7 +132,8 @@ tvm::transform::Pass UnifiedStaticMemoryPlanner() {
     }
     return Downcast<IRModule>(
         usmp::PlanMemory(m, algorithm_str.value_or(String(usmp::kDefaultAlgo)),
-                         use_workspace_io.value_or(Bool(false)), custom_algorithm_str));
+                         use_workspace_io.value_or(Bool(false)), custom_algorithm_str,
+                         access_aware.value_or(Bool(false))));
   };
 
   return tvm::transform::CreateModulePass(usmp_main_pass_func, 0,
@@ -51,6 +51,8 @@ void BufferInfoNode::SetConflicts(Array<ObjectRef> conflicting_buffer_info_objs)
   this->conflicts = conflicting_buffer_info_objs;
 }
 
+void BufferInfoNode::SetAccessCount(int64_t access_count) { this->access_count = access_count; }
+
 TVM_REGISTER_NODE_TYPE(BufferInfoNode);
 TVM_REGISTER_GLOBAL("tir.usmp.BufferInfo")
     .set_body_typed([](String name_hint, Integer size_bytes, Array<PoolInfo> pool_candidates,
@@ -62,6 +64,8 @@ TVM_REGISTER_GLOBAL("tir.usmp.BufferInfo")
     });
 TVM_REGISTER_GLOBAL("tir.usmp.BufferInfoSetConflicts")
     .set_body_method<BufferInfo>(&BufferInfoNode::SetConflicts);
+TVM_REGISTER_GLOBAL("tir.usmp.BufferInfoSetAccessCount")
+    .set_body_method<BufferInfo>(&BufferInfoNode::SetAccessCount);
 
 TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
     .set_dispatch<BufferInfoNode>([](const ObjectRef& ref, ReprPrinter* p) {
@@ -74,7 +78,8 @@ TVM_STATIC_IR_FUNCTOR(ReprPrinter, vtable)
                 << "name_hint=" << node->name_hint << ",\n  size_bytes=" << node->size_bytes
                 << ",\n  pool_candidates=" << node->pool_candidates
                 << ",\n  alignment=" << node->alignment << ",\n  kind=" << toString[node->kind]
-                << ",\n  conflicts=" << node->conflicts.size() << ")";
+                << ",\n  conflicts=" << node->conflicts.size()
+                << ",\n  access_count=" << node->access_count << ")";
     });
 
 BufferInfoAnalysis::BufferInfoAnalysis(Map<BufferInfo, tir::Stmt> buffer_info_stmts,
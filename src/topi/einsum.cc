@@ -24,6 +24,8 @@
 #include <tvm/topi/broadcast.h>
 #include <tvm/topi/einsum.h>
 
+#include <limits>
+
 namespace tvm {
 namespace topi {
 
@@ -332,9 +334,161 @@ class EinsumBuilder {
   Optional<Array<PrimExpr>> ellipsis_shape_;
 };
 
-Tensor einsum(const std::string& subscripts_str, const Array<Tensor> inputs, std::string name,
-              std::string tag) {
-  EinsumEquation equation = EinsumEquation::FromString(subscripts_str);
+/*! \brief Cost model of the pairwise contraction path search */
+class EinsumPathCost {
+ public:
+  using LabelSet = std::set<EinsumEquation::Label>;
+
+  EinsumPathCost(std::unordered_map<EinsumEquation::Label, double> extents, LabelSet output)
+      : extents_(std::move(extents)), output_(std::move(output)) {}
+
+  /*! \brief The number of elements spanned by the labels */
+  double Size(const LabelSet& labels) const {
+    double size = 1;
+    for (auto label : labels) {
+      size *= extents_.at(label);
+    }
+    return size;
+  }
+
+  /*! \brief The labels read by contracting operands i and j */
+  LabelSet Union(const std::vector<LabelSet>& operands, int i, int j) const {
+    LabelSet labels = operands[i];
+    labels.insert(operands[j].begin(), operands[j].end());
+    return labels;
+  }
+
+  /*!
+   * \brief The labels of the result of contracting operands i and j, i.e. the labels still
+   * needed by the output or by the other operands
+   */
+  LabelSet Kept(const std::vector<LabelSet>& operands, int i, int j) const {
+    LabelSet kept;
+    for (auto label : Union(operands, i, j)) {
+      bool needed = output_.count(label);
+      for (int k = 0, n = operands.size(); k < n && !needed; ++k) {
+        needed = k != i && k != j && operands[k].count(label);
+      }
+      if (needed) kept.insert(label);
+    }
+    return kept;
+  }
+
+  /*! \brief Replace operands i and j by the result of their contraction */
+  static std::vector<LabelSet> Contract(const std::vector<LabelSet>& operands, int i, int j,
+                                        LabelSet result) {
+    std::vector<LabelSet> next;
+    for (int k = 0, n = operands.size(); k < n; ++k) {
+      if (k != i && k != j) next.push_back(operands[k]);
+    }
+    next.push_back(std::move(result));
+    return next;
+  }
+
+ private:
+  std::unordered_map<EinsumEquation::Label, double> extents_;
+  LabelSet output_;
+};
+
+// Equations with at most this many operands are searched exhaustively for the optimal path.
+constexpr int kEinsumOptimalPathMaxOperands = 4;
+
+void SearchOptimalEinsumPath(const EinsumPathCost& cost,
+                             const std::vector<EinsumPathCost::LabelSet>& operands,
+                             double current_cost, std::vector<std::pair<int, int>>* path,
+                             double* best_cost, std::vector<std::pair<int, int>>* best_path) {
+  if (operands.size() == 1) {
+    if (current_cost < *best_cost) {
+      *best_cost = current_cost;
+      *best_path = *path;
+    }
+    return;
+  }
+  for (int i = 0, n = operands.size(); i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      double step_cost = current_cost + cost.Size(cost.Union(operands, i, j));
+      if (step_cost >= *best_cost) continue;
+      path->emplace_back(i, j);
+      auto next = EinsumPathCost::Contract(operands, i, j, cost.Kept(operands, i, j));
+      SearchOptimalEinsumPath(cost, next, step_cost, path, best_cost, best_path);
+      path->pop_back();
+    }
+  }
+}
+
+double GreedyEinsumPath(const EinsumPathCost& cost, std::vector<EinsumPathCost::LabelSet> operands,
+                        std::vector<std::pair<int, int>>* path) {
+  double total_cost = 0;
+  while (operands.size() > 1) {
+    // Prefer the cheapest contraction, then the one that shrinks the operands the most.
+    int best_i = 0, best_j = 1;
+    double best_delta = std::numeric_limits<double>::infinity();
+    double best_flops = std::numeric_limits<double>::infinity();
+    for (int i = 0, n = operands.size(); i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        double delta = cost.Size(cost.Kept(operands, i, j)) - cost.Size(operands[i]) -
+                       cost.Size(operands[j]);
+        double flops = cost.Size(cost.Union(operands, i, j));
+        if (flops < best_flops || (flops == best_flops && delta < best_delta)) {
+          best_i = i;
+          best_j = j;
+          best_delta = delta;
+          best_flops = flops;
+        }
+      }
+    }
+    total_cost += best_flops;
+    path->emplace_back(best_i, best_j);
+    operands = EinsumPathCost::Contract(operands, best_i, best_j,
+                                        cost.Kept(operands, best_i, best_j));
+  }
+  return total_cost;
+}
+
+std::vector<std::pair<int, int>> EinsumContractionPath(const EinsumEquation& equation,
+                                                       const Array<Array<PrimExpr>>& input_shapes) {
+  int num_operands = equation.inputs.size();
+  if (num_operands < 3) return {};
+
+  // Collect the constant extent of each label, broadcasting between operands.
+  std::unordered_map<EinsumEquation::Label, double> extents;
+  std::vector<EinsumPathCost::LabelSet> operands;
+  EinsumPathCost::LabelSet all_labels;
+  for (int i = 0; i < num_operands; ++i) {
+    const EinsumEquation::Subscript& subscript = equation.inputs[i];
+    if (subscript.size() != input_shapes[i].size()) return {};
+    EinsumPathCost::LabelSet labels(subscript.begin(), subscript.end());
+    // Ellipses and repeated labels (diagonals) are left to the single compute.
+    if (labels.size() != subscript.size() || labels.count(EinsumEquation::kEllipsis)) return {};
+    for (size_t d = 0; d < subscript.size(); ++d) {
+      const auto* extent = input_shapes[i][d].as<IntImmNode>();
+      if (extent == nullptr) return {};
+      double& label_extent = extents[subscript[d]];
+      label_extent = std::max(label_extent, static_cast<double>(extent->value));
+    }
+    all_labels.insert(labels.begin(), labels.end());
+    operands.push_back(std::move(labels));
+  }
+  EinsumPathCost cost(extents,
+                      EinsumPathCost::LabelSet(equation.output.begin(), equation.output.end()));
+
+  std::vector<std::pair<int, int>> path;
+  double path_cost;
+  if (num_operands <= kEinsumOptimalPathMaxOperands) {
+    std::vector<std::pair<int, int>> current;
+    path_cost = std::numeric_limits<double>::infinity();
+    SearchOptimalEinsumPath(cost, operands, 0, &current, &path_cost, &path);
+  } else {
+    path_cost = GreedyEinsumPath(cost, operands, &path);
+  }
+  // A single compute visits every label combination once per multiplication.
+  double single_cost = cost.Size(all_labels) * (num_operands - 1);
+  if (path_cost >= single_cost) return {};
+  return path;
+}
+
+Tensor EinsumCompute(const EinsumEquation& equation, const Array<Tensor>& inputs,
+                     std::string name, std::string tag) {
   Array<Array<PrimExpr>> input_shapes;
   for (const Tensor& input : inputs) {
     input_shapes.push_back(input->shape);
@@ -347,6 +501,72 @@ Tensor einsum(const std::string& subscripts_str, const Array<Tensor> inputs, std
       name, tag);
 }
 
+Tensor einsum(const std::string& subscripts_str, const Array<Tensor> inputs, std::string name,
+              std::string tag) {
+  EinsumEquation equation = EinsumEquation::FromString(subscripts_str);
+  Array<Array<PrimExpr>> input_shapes;
+  for (const Tensor& input : inputs) {
+    input_shapes.push_back(input->shape);
+  }
+  auto path = EinsumContractionPath(equation, input_shapes);
+  if (path.empty()) {
+    return EinsumCompute(equation, inputs, name, tag);
+  }
+
+  std::vector<Tensor> operands(inputs.begin(), inputs.end());
+  std::vector<EinsumEquation::Subscript> subscripts = equation.inputs;
+  for (size_t step = 0; step < path.size(); ++step) {
+    int i = path[step].first;
+    int j = path[step].second;
+    bool last = step + 1 == path.size();
+    const EinsumEquation::Subscript& lhs = subscripts[i];
+    const EinsumEquation::Subscript& rhs = subscripts[j];
+    EinsumEquation pair;
+    pair.inputs = {lhs, rhs};
+    if (last) {
+      pair.output = equation.output;
+    } else {
+      // Keep the labels still needed by the output or the remaining operands, laid out as
+      // (batch, lhs free, rhs free) like the output of batch_matmul.
+      auto needed = [&](EinsumEquation::Label label) {
+        if (std::count(equation.output.begin(), equation.output.end(), label)) return true;
+        for (int k = 0, n = subscripts.size(); k < n; ++k) {
+          if (k != i && k != j &&
+              std::count(subscripts[k].begin(), subscripts[k].end(), label)) {
+            return true;
+          }
+        }
+        return false;
+      };
+      auto in_rhs = [&](EinsumEquation::Label label) {
+        return std::count(rhs.begin(), rhs.end(), label) > 0;
+      };
+      for (auto label : lhs) {
+        if (in_rhs(label) && needed(label)) pair.output.push_back(label);
+      }
+      for (auto label : lhs) {
+        if (!in_rhs(label) && needed(label)) pair.output.push_back(label);
+      }
+      for (auto label : rhs) {
+        if (std::count(lhs.begin(), lhs.end(), label) == 0 && needed(label)) {
+          pair.output.push_back(label);
+        }
+      }
+    }
+    Tensor result = EinsumCompute(pair, {operands[i], operands[j]},
+                                  last ? name : name + "_" + std::to_string(step), tag);
+    // i < j, erase the later one first to keep the index of the former valid.
+    operands.erase(operands.begin() + j);
+    operands.erase(operands.begin() + i);
+    subscripts.erase(subscripts.begin() + j);
+    subscripts.erase(subscripts.begin() + i);
+    operands.push_back(result);
+    subscripts.push_back(pair.output);
+  }
+  ICHECK_EQ(operands.size(), 1);
+  return operands[0];
+}
+
 Array<PrimExpr> InferEinsumShape(const std::string& subscripts,
                                  const std::vector<Array<PrimExpr>>& operands) {
   EinsumEquation equation = EinsumEquation::FromString(subscripts);
@@ -358,5 +578,15 @@ TVM_REGISTER_GLOBAL("topi.einsum").set_body([](TVMArgs args, TVMRetValue* rv) {
   *rv = einsum(args[0], args[1]);
 });
 
+TVM_REGISTER_GLOBAL("topi.einsum_path")
+    .set_body_typed([](std::string subscripts, Array<Array<PrimExpr>> input_shapes) {
+      Array<Array<Integer>> path;
+      for (auto [i, j] : EinsumContractionPath(EinsumEquation::FromString(subscripts),
+                                               input_shapes)) {
+        path.push_back({i, j});
+      }
+      return path;
+    });
+
 }  // namespace topi
 }  // namespace tvm
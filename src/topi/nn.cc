@@ -24,6 +24,7 @@
 #include <tvm/runtime/packed_func.h>
 #include <tvm/runtime/registry.h>
 #include <tvm/topi/nn.h>
+#include <tvm/topi/nn/attention.h>
 #include <tvm/topi/nn/bias_add.h>
 #include <tvm/topi/nn/bnn.h>
 #include <tvm/topi/nn/dense.h>
@@ -146,6 +147,11 @@ TVM_REGISTER_GLOBAL("topi.nn.log_softmax").set_body([](TVMArgs args, TVMRetValue
   *rv = nn::log_softmax(args[0]);
 });
 
+/* Ops from nn/attention.h */
+TVM_REGISTER_GLOBAL("topi.nn.fused_attention").set_body([](TVMArgs args, TVMRetValue* rv) {
+  *rv = nn::fused_attention(args[0], args[1], args[2], static_cast<double>(args[3]), args[4]);
+});
+
 TVM_REGISTER_GLOBAL("topi.nn.lrn").set_body([](TVMArgs args, TVMRetValue* rv) {
   *rv = nn::lrn(args[0], args[1], args[2], static_cast<double>(args[3]),
                 static_cast<double>(args[4]), static_cast<double>(args[5]));
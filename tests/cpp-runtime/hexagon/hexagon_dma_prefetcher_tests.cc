@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../src/runtime/hexagon/hexagon_device_api.h"
+#include "../src/runtime/hexagon/hexagon_dma_prefetcher.h"
+
+using namespace tvm::runtime;
+using namespace tvm::runtime::hexagon;
+
+class HexagonDmaPrefetcherTest : public ::testing::Test {
+  void SetUp() override {
+    user_dma = HexagonDeviceAPI::Global()->UserDMA();
+    vtcm_pool = HexagonDeviceAPI::Global()->VtcmPool();
+    for (size_t i = 0; i < num_weights; ++i) {
+      weights.emplace_back(length, static_cast<char>(i + 1));
+    }
+  }
+  void TearDown() override {}
+
+ public:
+  HexagonUserDMA* user_dma;
+  HexagonVtcmPool* vtcm_pool;
+  size_t num_weights = 3;
+  size_t length = 0x1000;  // 4KB
+  std::vector<std::vector<char>> weights;
+
+  std::vector<HexagonDmaPrefetcher::Stage> Schedule() {
+    std::vector<HexagonDmaPrefetcher::Stage> schedule;
+    for (std::vector<char>& weight : weights) {
+      schedule.push_back({{weight.data(), weight.size()}});
+    }
+    return schedule;
+  }
+
+  void CheckStage(const HexagonDmaPrefetcher& prefetcher, size_t stage) {
+    char* dst = static_cast<char*>(prefetcher.Address(stage, 0));
+    ASSERT_NE(dst, nullptr);
+    for (size_t i = 0; i < length; ++i) {
+      ASSERT_EQ(dst[i], weights[stage][i]);
+    }
+  }
+};
+
+TEST_F(HexagonDmaPrefetcherTest, double_buffered) {
+  HexagonDmaPrefetcher prefetcher(Schedule(), length, user_dma, vtcm_pool);
+  ASSERT_EQ(prefetcher.RegionBytes(), kHexagonAllocAlignment * 2);
+  ASSERT_EQ(prefetcher.Address(0, 0), prefetcher.Address(2, 0));
+  ASSERT_NE(prefetcher.Address(0, 0), prefetcher.Address(1, 0));
+  for (int run = 0; run < 2; ++run) {
+    for (size_t stage = 0; stage < num_weights; ++stage) {
+      prefetcher.Begin(stage);
+      CheckStage(prefetcher, stage);
+    }
+  }
+  ASSERT_EQ(prefetcher.NumSynchronous(), 2);
+  ASSERT_EQ(prefetcher.NumPrefetched(), 4);
+}
+
+TEST_F(HexagonDmaPrefetcherTest, out_of_order) {
+  HexagonDmaPrefetcher prefetcher(Schedule(), length, user_dma, vtcm_pool);
+  prefetcher.Begin(2);
+  CheckStage(prefetcher, 2);
+  prefetcher.Begin(0);
+  CheckStage(prefetcher, 0);
+  ASSERT_EQ(prefetcher.NumSynchronous(), 2);
+}
+
+TEST_F(HexagonDmaPrefetcherTest, single_stage_recopied) {
+  std::vector<HexagonDmaPrefetcher::Stage> schedule = {{{weights[0].data(), length}}};
+  HexagonDmaPrefetcher prefetcher(schedule, length, user_dma, vtcm_pool);
+  prefetcher.Begin(0);
+  CheckStage(prefetcher, 0);
+  weights[0][0] = 42;
+  prefetcher.Begin(0);
+  CheckStage(prefetcher, 0);
+  ASSERT_EQ(prefetcher.NumSynchronous(), 2);
+}
+
+TEST_F(HexagonDmaPrefetcherTest, oversized_stays_in_ddr) {
+  std::vector<HexagonDmaPrefetcher::Stage> schedule = {
+      {{weights[0].data(), length}, {weights[1].data(), length}}};
+  HexagonDmaPrefetcher prefetcher(schedule, length, user_dma, vtcm_pool);
+  ASSERT_NE(prefetcher.Address(0, 0), nullptr);
+  ASSERT_EQ(prefetcher.Address(0, 1), nullptr);
+  prefetcher.Begin(0);
+  CheckStage(prefetcher, 0);
+}
@@ -18,8 +18,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/logging.h>
 
+#include <atomic>
+#include <string>
+
 #include "../src/runtime/hexagon/hexagon_device_api.h"
 #include "../src/runtime/hexagon/hexagon_thread_manager.h"
 
@@ -359,3 +363,69 @@ TEST_F(HexagonThreadManagerTest, threads_for_resource_types) {
   thread = reinterpret_cast<TVMStreamHandle>(6);
   EXPECT_THROW(thread_manager->GetResourceTypeForStreamHandle(thread), InternalError);
 }
+
+struct ParallelCounts {
+  std::atomic<int> counts[64];
+};
+
+int count_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  reinterpret_cast<ParallelCounts*>(cdata)->counts[task_id]++;
+  return 0;
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch_dynamic) {
+  ParallelCounts counts{};
+  htm->SetParallelGranularity(4);
+  ASSERT_EQ(htm->ParallelLaunch(count_task, &counts, 0), 0);
+  for (unsigned i = 0; i < threads * 4; i++) {
+    CHECK_EQ(counts.counts[i], 1);
+  }
+  CHECK_EQ(counts.counts[threads * 4], 0);
+}
+
+int barrier_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  ParallelCounts* counts = reinterpret_cast<ParallelCounts*>(cdata);
+  counts->counts[task_id]++;
+  TVMBackendParallelBarrier(task_id, penv);
+  // every task passed the first increment before any task gets here
+  for (int i = 0; i < penv->num_task; i++) {
+    if (counts->counts[i] != 1) return -1;
+  }
+  return 0;
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch_barrier) {
+  ParallelCounts counts{};
+  ASSERT_EQ(htm->ParallelLaunch(barrier_task, &counts, threads), 0);
+}
+
+int failing_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  if (task_id == 1) {
+    TVMAPISetLastError("task failed");
+    return -1;
+  }
+  return 0;
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch_error) {
+  ASSERT_EQ(htm->ParallelLaunch(failing_task, nullptr, 0), -1);
+  CHECK_EQ(std::string(TVMGetLastError()), "task failed");
+}
+
+struct NestedLaunch {
+  HexagonThreadManager* htm;
+  ParallelCounts counts;
+};
+
+int nested_task(int task_id, TVMParallelGroupEnv* penv, void* cdata) {
+  NestedLaunch* nested = reinterpret_cast<NestedLaunch*>(cdata);
+  return nested->htm->ParallelLaunch(count_task, &nested->counts, 0);
+}
+
+TEST_F(HexagonThreadManagerTest, parallel_launch_nested) {
+  NestedLaunch nested{htm, {}};
+  ASSERT_EQ(htm->ParallelLaunch(nested_task, &nested, 2), 0);
+  // nested jobs run on the calling thread as a single task
+  CHECK_EQ(nested.counts.counts[0], 2);
+  CHECK_EQ(nested.counts.counts[1], 0);
+}
@@ -285,3 +285,106 @@ TEST_F(HexagonVtcmPoolTest, vtcm_alignment) {
   ptr = vtcm_pool->Allocate(max_bytes);
   vtcm_pool->Free(ptr, max_bytes);
 }
+
+TEST_F(HexagonVtcmPoolTest, best_fit_from_the_back) {
+  // Fill the pool with 2k blocks, then free two separated ones.
+  size_t num_blocks = max_bytes / two_k_block;
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < num_blocks; ++i) {
+    ptrs.push_back(vtcm_pool->Allocate(two_k_block));
+  }
+  vtcm_pool->Free(ptrs[1], two_k_block);
+  vtcm_pool->Free(ptrs[3], two_k_block);
+
+  // Unaligned allocations fit in any hole, not only the last free block.
+  void* ptr1 = vtcm_pool->Allocate(one_k_block);
+  CHECK(static_cast<char*>(ptr1) == static_cast<char*>(ptrs[3]) + one_k_block);
+  void* ptr2 = vtcm_pool->Allocate(one_k_block);
+  CHECK(ptr2 == ptrs[3]);
+  void* ptr3 = vtcm_pool->Allocate(one_k_block + min_bytes);
+  CHECK(static_cast<char*>(ptr3) == static_cast<char*>(ptrs[1]) + two_k_block - one_k_block -
+                                        min_bytes);
+
+  vtcm_pool->Free(ptr1, one_k_block);
+  vtcm_pool->Free(ptr2, one_k_block);
+  vtcm_pool->Free(ptr3, one_k_block + min_bytes);
+  for (size_t i = 0; i < num_blocks; ++i) {
+    if (i != 1 && i != 3) vtcm_pool->Free(ptrs[i], two_k_block);
+  }
+
+  // Make sure at the end we have the full amount available again
+  ptr1 = vtcm_pool->Allocate(max_bytes);
+  vtcm_pool->Free(ptr1, max_bytes);
+}
+
+TEST_F(HexagonVtcmPoolTest, aligned_allocation_in_unaligned_block) {
+  void* ptr1 = vtcm_pool->Allocate(max_bytes - four_k_block * 2);
+  void* ptr2 = vtcm_pool->Allocate(four_k_block - min_bytes);
+  void* ptr3 = vtcm_pool->Allocate(min_bytes);
+  // The free block [ptr3 + 128, ...) does not start on a 2k boundary.
+  vtcm_pool->Free(ptr2, four_k_block - min_bytes);
+  void* ptr4 = vtcm_pool->Allocate(two_k_block);
+  CHECK((reinterpret_cast<uintptr_t>(ptr4) & 0x7FF) == 0) << "Must be multiple of 2k " << ptr4;
+
+  vtcm_pool->Free(ptr1, max_bytes - four_k_block * 2);
+  vtcm_pool->Free(ptr3, min_bytes);
+  vtcm_pool->Free(ptr4, two_k_block);
+
+  // Make sure at the end we have the full amount available again
+  ptr1 = vtcm_pool->Allocate(max_bytes);
+  vtcm_pool->Free(ptr1, max_bytes);
+}
+
+TEST_F(HexagonVtcmPoolTest, arena) {
+  vtcm_pool->ArenaBegin(four_k_block * 2);
+  void* ptr1 = vtcm_pool->Allocate(two_k_block);
+  void* ptr2 = vtcm_pool->Allocate(min_bytes);
+  void* ptr3 = vtcm_pool->Allocate(two_k_block);
+  // The allocations are taken from the arena in order.
+  CHECK(static_cast<char*>(ptr1) + two_k_block == static_cast<char*>(ptr2));
+  CHECK(static_cast<char*>(ptr1) + two_k_block * 2 == static_cast<char*>(ptr3));
+  // Allocations which do not fit fall back to the pool.
+  void* ptr4 = vtcm_pool->Allocate(four_k_block * 2);
+  EXPECT_THROW(vtcm_pool->ArenaEnd(), InternalError);
+  vtcm_pool->Free(ptr1, two_k_block);
+  vtcm_pool->Free(ptr2, min_bytes);
+  vtcm_pool->Free(ptr3, two_k_block);
+  vtcm_pool->Free(ptr4, four_k_block * 2);
+  vtcm_pool->ArenaEnd();
+  EXPECT_THROW(vtcm_pool->ArenaEnd(), InternalError);
+
+  // Make sure at the end we have the full amount available again
+  ptr1 = vtcm_pool->Allocate(max_bytes);
+  vtcm_pool->Free(ptr1, max_bytes);
+}
+
+TEST_F(HexagonVtcmPoolTest, stats_and_fragmentation_hook) {
+  vtcm_pool->ResetStats();
+  void* ptr1 = vtcm_pool->Allocate(two_k_block);
+  void* ptr2 = vtcm_pool->Allocate(two_k_block);
+  void* ptr3 = vtcm_pool->Allocate(max_bytes - two_k_block * 2);
+  vtcm_pool->Free(ptr1, two_k_block);
+  vtcm_pool->Free(ptr3, max_bytes - two_k_block * 2);
+
+  HexagonVtcmPool::Stats stats = vtcm_pool->GetStats();
+  CHECK_EQ(stats.used_bytes, two_k_block);
+  CHECK_EQ(stats.peak_used_bytes, max_bytes);
+  CHECK_EQ(stats.largest_free_bytes, max_bytes - two_k_block * 2);
+  CHECK_EQ(stats.num_allocations, 3);
+
+  // Enough VTCM is free, but not contiguous.
+  EXPECT_THROW(vtcm_pool->Allocate(max_bytes - two_k_block), InternalError);
+  stats = vtcm_pool->GetStats();
+  CHECK_EQ(stats.num_failed_allocations, 1);
+  CHECK_EQ(stats.num_fragmented_failures, 1);
+
+  // The hook frees the buffer in the middle, so the retry succeeds.
+  vtcm_pool->SetFragmentationHook([&]() { vtcm_pool->Free(ptr2, two_k_block); });
+  void* ptr4 = vtcm_pool->Allocate(max_bytes - two_k_block);
+  vtcm_pool->SetFragmentationHook(nullptr);
+  vtcm_pool->Free(ptr4, max_bytes - two_k_block);
+
+  // Make sure at the end we have the full amount available again
+  ptr1 = vtcm_pool->Allocate(max_bytes);
+  vtcm_pool->Free(ptr1, max_bytes);
+}
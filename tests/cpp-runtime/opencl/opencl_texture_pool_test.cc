@@ -31,14 +31,25 @@ using namespace tvm::runtime::cl;
 // get and check internal state of class Pool
 class PoolWrapper : public Pool2D {
  public:
-  inline size_t FreeListSize() const { return free_list_.size(); }
+  inline size_t FreeListSize() const { return FreeList().size(); }
   inline size_t AllocatedListSize() const { return allocated_.size(); }
   inline std::pair<size_t, size_t> FreeListItemSize(size_t idx) const {
-    return std::make_pair(free_list_[idx].x, free_list_[idx].y);
+    auto free_list = FreeList();
+    return std::make_pair(free_list[idx].x, free_list[idx].y);
   }
   inline std::pair<size_t, size_t> AllocatedListItemSize(size_t idx) const {
     return std::make_pair(allocated_[idx].x, allocated_[idx].y);
   }
+
+ private:
+  // The free textures of all buckets, in the order of the buckets.
+  std::vector<Entry> FreeList() const {
+    std::vector<Entry> free_list;
+    for (const auto& kv : free_list_) {
+      free_list.insert(free_list.end(), kv.second.begin(), kv.second.end());
+    }
+    return free_list;
+  }
 };
 
 TEST(OpenCLTexturePool, textures_reallocation_optimal_size) {
@@ -149,3 +160,48 @@ TEST(OpenCLTexturePool, avoid_reusing_too_small_textures) {
   EXPECT_EQ(item.first, 12544);
   EXPECT_EQ(item.second, 64);
 }
+
+TEST(OpenCLTexturePool, best_fit_reuse_stats) {
+  OpenCLWorkspace* workspace = OpenCLWorkspace::Global();
+  OpenCLThreadEntry* t = workspace->GetThreadEntry();
+  PoolWrapper pool;
+  DLDataType type{kDLFloat, 16, 1};
+  void* data1 = pool.Alloc(t->device, workspace, 1024, 1024, type);
+  void* data2 = pool.Alloc(t->device, workspace, 512, 512, type);
+  EXPECT_EQ(pool.GetStats().num_allocs, 2);
+  EXPECT_EQ(pool.GetStats().current_bytes, (1024 * 1024 + 512 * 512) * 4 * 2);
+  pool.Free(data1);
+  pool.Free(data2);
+  EXPECT_EQ(pool.GetStats().current_bytes, 0);
+  EXPECT_EQ(pool.FreeListSize(), 2);
+
+  // Both free textures fit, the smaller one wastes less.
+  pool.Alloc(t->device, workspace, 500, 500, type);
+  EXPECT_EQ(pool.GetStats().num_reuses, 1);
+  EXPECT_EQ(pool.AllocatedListItemSize(0), std::make_pair<size_t, size_t>(512, 512));
+  EXPECT_EQ(pool.GetStats().wasted_bytes, (512 * 512 - 500 * 500) * 4 * 2);
+  EXPECT_EQ(pool.GetStats().peak_bytes, (1024 * 1024 + 512 * 512) * 4 * 2);
+  EXPECT_EQ(pool.GetStats().reserved_bytes, (1024 * 1024 + 512 * 512) * 4 * 2);
+  pool.Release(t->device, workspace);
+}
+
+TEST(OpenCLTexturePool, budget_evicts_largest_free_texture) {
+  OpenCLWorkspace* workspace = OpenCLWorkspace::Global();
+  OpenCLThreadEntry* t = workspace->GetThreadEntry();
+  PoolWrapper pool;
+  DLDataType type{kDLFloat, 16, 1};
+  void* data1 = pool.Alloc(t->device, workspace, 1024, 1024, type);
+  void* data2 = pool.Alloc(t->device, workspace, 256, 256, type);
+  pool.Free(data1);
+  pool.Free(data2);
+
+  Pool2D::SetBudget((256 * 256 + 4096 * 64) * 4 * 2);
+  // Neither free texture is within the ratio of the request.
+  pool.Alloc(t->device, workspace, 4096, 64, type);
+  Pool2D::SetBudget(0);
+  EXPECT_EQ(pool.GetStats().num_evictions, 1);
+  EXPECT_EQ(pool.FreeListSize(), 1);
+  EXPECT_EQ(pool.FreeListItemSize(0), std::make_pair<size_t, size_t>(256, 256));
+  EXPECT_EQ(pool.GetStats().reserved_bytes, (256 * 256 + 4096 * 64) * 4 * 2);
+  pool.Release(t->device, workspace);
+}
@@ -22,6 +22,7 @@
 #include <tvm/runtime/container/adt.h>
 #include <tvm/runtime/container/array.h>
 #include <tvm/runtime/container/map.h>
+#include <tvm/runtime/container/shape_tuple.h>
 #include <tvm/runtime/container/string.h>
 #include <tvm/tir/function.h>
 #include <tvm/tir/op.h>
@@ -523,6 +524,35 @@ TEST(Map, Erase) {
   }
 }
 
+TEST(Map, DenseIterator) {
+  // Sparse dense maps, so that iteration skips whole blocks of empty slots.
+  Map<String, Integer> map;
+  for (int i = 0; i < 1000; ++i) {
+    map.Set(std::to_string(i), i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    if (i % 37 != 0) map.erase(std::to_string(i));
+  }
+  std::vector<int64_t> forward;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    forward.push_back((*it).second.IntValue());
+  }
+  // Map::iterator only moves forward, walk the MapNode backward.
+  const MapNode* node = static_cast<const MapNode*>(map.get());
+  std::vector<int64_t> backward;
+  for (auto it = node->end(); it != node->begin();) {
+    --it;
+    backward.push_back(Downcast<Integer>((*it).second).IntValue());
+  }
+  ICHECK_EQ(forward.size(), 28U);
+  std::reverse(backward.begin(), backward.end());
+  ICHECK(forward == backward);
+  std::sort(forward.begin(), forward.end());
+  for (size_t i = 0; i < forward.size(); ++i) {
+    ICHECK_EQ(forward[i], static_cast<int64_t>(i) * 37);
+  }
+}
+
 #if TVM_LOG_DEBUG
 TEST(Map, Race) {
   using namespace tvm::runtime;
@@ -853,3 +883,32 @@ TEST(Optional, PackedCall) {
   test_ffi(s, static_cast<int>(kTVMObjectHandle));
   test_ffi(String(s), static_cast<int>(kTVMObjectRValueRefArg));
 }
+
+TEST(ShapeTuple, Inplace) {
+  using namespace tvm::runtime;
+  auto is_inplace = [](const ShapeTuple& shape) {
+    return reinterpret_cast<const void*>(shape.data()) ==
+           reinterpret_cast<const void*>(shape.get() + 1);
+  };
+  ShapeTuple empty;
+  ICHECK_EQ(empty.size(), 0U);
+  ICHECK(is_inplace(empty));
+
+  ShapeTuple small{2, 3, 4};
+  ICHECK(is_inplace(small));
+  ICHECK_EQ(small.size(), 3U);
+  ICHECK_EQ(small[2], 4);
+
+  int32_t dims[] = {5, 6};
+  ShapeTuple from_iter(dims, dims + 2);
+  ICHECK(is_inplace(from_iter));
+  ICHECK_EQ(from_iter[1], 6);
+
+  std::vector<int64_t> large(ShapeTuple::kMaxInplaceSize + 1, 7);
+  ShapeTuple from_small_vector(std::vector<int64_t>{8, 9});
+  ShapeTuple from_large_vector(large);
+  ICHECK(is_inplace(from_small_vector));
+  ICHECK(!is_inplace(from_large_vector));
+  ICHECK_EQ(from_large_vector.size(), large.size());
+  ICHECK(std::equal(large.begin(), large.end(), from_large_vector.begin()));
+}
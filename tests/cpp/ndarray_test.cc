@@ -20,6 +20,7 @@
 #include <dmlc/logging.h>
 #include <gtest/gtest.h>
 #include <tvm/runtime/ndarray.h>
+#include <tvm/runtime/registry.h>
 
 using namespace tvm;
 
@@ -71,3 +72,23 @@ TEST(NDArrayTest, IsContiguous_UncontiguousStride) {
   managed_tensor->dl_tensor.strides = nullptr;
   managed_tensor->deleter(managed_tensor);
 }
+
+TEST(NDArrayTest, CPUAllocPolicy) {
+  const runtime::PackedFunc* set_policy = runtime::Registry::Get("runtime.SetCPUAllocPolicy");
+  ICHECK(set_policy != nullptr);
+  // The huge pages are a best effort, the allocations must work either way.
+  for (bool use_hugetlb : {false, true}) {
+    (*set_policy)(1 << 20, use_hugetlb, true);
+    auto large = runtime::NDArray::Empty({1 << 20}, DataType::Float(32), {kDLCPU});
+    auto small = runtime::NDArray::Empty({16}, DataType::Float(32), {kDLCPU});
+    float* data = static_cast<float*>(large->data);
+    for (int i = 0; i < (1 << 20); i += 1000) {
+      data[i] = static_cast<float>(i);
+    }
+    for (int i = 0; i < (1 << 20); i += 1000) {
+      ICHECK_EQ(data[i], static_cast<float>(i));
+    }
+    static_cast<float*>(small->data)[15] = 1.0f;
+  }
+  (*set_policy)(-1, false, false);
+}
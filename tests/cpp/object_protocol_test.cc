@@ -95,3 +95,23 @@ TEST(ObjectHierachy, Basic) {
   ICHECK(refB.as<ObjAA>() == nullptr);
   ICHECK(refB.as<ObjB>() != nullptr);
 }
+
+TEST(ObjectPool, Reuse) {
+  using namespace tvm::runtime;
+  using namespace tvm::test;
+  ReleaseObjectPool();
+  ObjectPoolStats before = GetObjectPoolStats();
+  const Object* first = make_object<ObjB>().get();
+  // The block of the released object is recycled by the next object of its size.
+  ObjectRef ref(make_object<ObjB>());
+  ICHECK_EQ(ref.get(), first);
+  ObjectPoolStats after = GetObjectPoolStats();
+  ICHECK_EQ(after.num_allocs - before.num_allocs, 2);
+  ICHECK_EQ(after.num_reused - before.num_reused, 1);
+  ICHECK_EQ(after.num_frees - before.num_frees, 1);
+  ICHECK_EQ(after.cached_bytes, 0);
+  ref = ObjectRef();
+  ICHECK_GT(GetObjectPoolStats().cached_bytes, 0);
+  ReleaseObjectPool();
+  ICHECK_EQ(GetObjectPoolStats().cached_bytes, 0);
+}
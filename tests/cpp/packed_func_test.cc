@@ -24,6 +24,8 @@
 #include <tvm/tir/expr.h>
 #include <tvm/tir/transform.h>
 
+#include "../../src/runtime/library_module.h"
+
 TEST(PackedFunc, Basic) {
   using namespace tvm;
   using namespace tvm::tir;
@@ -319,3 +321,22 @@ TEST(TypedPackedFunc, RValue) {
     tf(1, true);
   }
 }
+
+static int BackendPackedCFuncAdd(TVMValue* args, int* type_codes, int num_args, TVMValue* out_ret,
+                                 int* out_ret_tcode, void* resource_handle) {
+  ICHECK_EQ(num_args, 3);
+  ICHECK_EQ(type_codes[0], kDLInt);
+  ICHECK_EQ(type_codes[1], kDLFloat);
+  ICHECK_EQ(type_codes[2], kTVMOpaqueHandle);
+  *static_cast<double*>(args[2].v_handle) = args[0].v_int64 + args[1].v_float64;
+  return 0;
+}
+
+TEST(PackedFunc, CallBackendPackedCFunc) {
+  using namespace tvm::runtime;
+  double out = 0;
+  CallBackendPackedCFunc(BackendPackedCFuncAdd, 1, 2.5, static_cast<void*>(&out));
+  ICHECK_EQ(out, 3.5);
+  // Only the functions of library modules have an address.
+  ICHECK(GetBackendPackedCFunc(Module(), "add") == nullptr);
+}
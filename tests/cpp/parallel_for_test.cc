@@ -22,6 +22,7 @@
 #include <tvm/runtime/logging.h>
 #include <tvm/support/parallel_for.h>
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -92,20 +93,42 @@ TEST(ParallelFor, NestedWithNormalForLoop) {
 }
 
 TEST(ParallelFor, NestedWithParallelFor) {
-  // Currently do not support using nested parallel_for
   using tvm::support::parallel_for;
 
-  bool exception = false;
-  try {
-    parallel_for(0, 100, [](int i) {
-      parallel_for(0, 100, [](int j) {
-        // Blank loop
-      });
+  int a[100][100], b[100][100];
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      a[i][j] = i * j;
+    }
+  }
+  parallel_for(0, 100, [&b](int i) {
+    parallel_for(0, 100, [&b, i](int j) { b[i][j] = i * j; });
+  });
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      ICHECK_EQ(a[i][j], b[i][j]);
+    }
+  }
+}
+
+TEST(ParallelFor, ConcurrentCallers) {
+  using tvm::support::parallel_for;
+
+  std::vector<std::vector<int>> results(4, std::vector<int>(1000, 0));
+  std::vector<std::thread> callers;
+  for (int t = 0; t < 4; t++) {
+    callers.emplace_back([&results, t]() {
+      parallel_for(0, 1000, [&results, t](int i) { results[t][i] = i + t; });
     });
-  } catch (const std::exception& e) {
-    exception = true;
   }
-  ICHECK(exception);
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  for (int t = 0; t < 4; t++) {
+    for (int i = 0; i < 1000; i++) {
+      ICHECK_EQ(results[t][i], i + t);
+    }
+  }
 }
 
 TEST(ParallelFor, Exception) {
@@ -130,6 +153,25 @@ TEST(ParallelForDynamic, Basic) {
   }
 }
 
+TEST(ParallelForDynamic, NestedWithThreadLocalStates) {
+  using tvm::support::parallel_for;
+  using tvm::support::parallel_for_dynamic;
+  int num_threads = 4;
+  std::vector<std::atomic<int>> running(num_threads);
+  std::atomic<int> sum{0};
+  parallel_for(0, 8, [&](int i) {
+    parallel_for_dynamic(0, 100, num_threads, [&](int thread_id, int task_id) {
+      sum += task_id;
+    });
+  });
+  parallel_for_dynamic(0, 1000, num_threads, [&running](int thread_id, int task_id) {
+    // A thread id is never used by two threads at the same time
+    ICHECK_EQ(running[thread_id]++, 0);
+    running[thread_id]--;
+  });
+  ICHECK_EQ(sum.load(), 8 * 4950);
+}
+
 TEST(ParallelForDynamic, ExceptionOnMain) {
   using tvm::support::parallel_for_dynamic;
   int num_threads = 1;
@@ -0,0 +1,88 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../src/runtime/vm/best_fit_allocator.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+constexpr size_t kPage = BestFitAllocator::kDefaultPageSize;
+const DLDataType kUInt8{kDLUInt, 8, 1};
+
+TEST(BestFitAllocator, SplitAndMerge) {
+  Device dev{kDLCPU, 0};
+  BestFitAllocator alloc(dev, 0);
+  // Buffers beyond the thread cache limit go straight back to the shared pool.
+  const size_t size = 2 * BestFitAllocator::kMaxThreadCacheBufferSize;
+  Buffer segment = alloc.Alloc(4 * size, 64, kUInt8);
+  alloc.Free(segment);
+  size_t used = alloc.UsedMemory();
+  Buffer a = alloc.Alloc(size, 64, kUInt8);
+  Buffer b = alloc.Alloc(size - kPage + 1, 64, kUInt8);
+  EXPECT_EQ(a.data, segment.data);
+  EXPECT_EQ(a.size, size);
+  EXPECT_EQ(b.size, size);
+  EXPECT_EQ(static_cast<char*>(b.data), static_cast<char*>(a.data) + size);
+  alloc.Free(a);
+  alloc.Free(b);
+  // The merged block serves a request of the combined size without growing.
+  Buffer c = alloc.Alloc(2 * size, 64, kUInt8);
+  EXPECT_EQ(c.data, segment.data);
+  EXPECT_EQ(alloc.UsedMemory(), used);
+  alloc.Free(c);
+}
+
+TEST(BestFitAllocator, MemoryLimit) {
+  Device dev{kDLCPU, 0};
+  const size_t limit = 2 * BestFitAllocator::kDefaultSegmentSize;
+  BestFitAllocator alloc(dev, limit);
+  Buffer a = alloc.Alloc(limit, 64, kUInt8);
+  EXPECT_EQ(alloc.UsedMemory(), limit);
+  EXPECT_THROW(alloc.Alloc(kPage, 64, kUInt8), InternalError);
+  alloc.Free(a);
+  Buffer b = alloc.Alloc(kPage, 64, kUInt8);
+  EXPECT_EQ(b.data, a.data);
+  alloc.Free(b);
+}
+
+TEST(BestFitAllocator, ThreadCache) {
+  Device dev{kDLCPU, 0};
+  BestFitAllocator alloc(dev, 0);
+  Buffer a = alloc.Alloc(kPage, 64, kUInt8);
+  alloc.Free(a);
+  Buffer b = alloc.Alloc(kPage, 64, kUInt8);
+  EXPECT_EQ(b.data, a.data);
+  // Buffers freed on another thread are given back when the thread exits.
+  std::thread t([&]() { alloc.Free(b); });
+  t.join();
+  Buffer c = alloc.Alloc(kPage, 64, kUInt8);
+  EXPECT_EQ(c.data, a.data);
+  alloc.Free(c);
+}
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
@@ -0,0 +1,69 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../src/runtime/lz4.h"
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/logging.h>
+
+#include <random>
+#include <string>
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+std::string RoundTrip(const std::string& data) {
+  std::string compressed = LZ4Compress(data.data(), data.size());
+  std::string decompressed(data.size(), '\0');
+  LZ4Decompress(compressed.data(), compressed.size(), &decompressed[0], data.size());
+  return decompressed;
+}
+
+TEST(LZ4, RoundTrip) {
+  std::mt19937 rng(0);
+  for (size_t size : {0, 1, 12, 13, 100, 4096, 300000}) {
+    std::string random(size, '\0'), repeated(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+      random[i] = static_cast<char>(rng());
+      repeated[i] = "tvm.runtime"[i % 11];
+    }
+    EXPECT_EQ(RoundTrip(random), random);
+    EXPECT_EQ(RoundTrip(repeated), repeated);
+  }
+}
+
+TEST(LZ4, Compresses) {
+  std::string zeros(1 << 20, '\0');
+  EXPECT_LT(LZ4Compress(zeros.data(), zeros.size()).size(), zeros.size() / 200);
+}
+
+TEST(LZ4, Corrupted) {
+  std::string data(1000, 'a');
+  std::string compressed = LZ4Compress(data.data(), data.size());
+  std::string out(data.size(), '\0');
+  EXPECT_THROW(LZ4Decompress(compressed.data(), compressed.size() - 1, &out[0], out.size()),
+               Error);
+  EXPECT_THROW(LZ4Decompress(compressed.data(), compressed.size(), &out[0], out.size() - 1),
+               Error);
+}
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
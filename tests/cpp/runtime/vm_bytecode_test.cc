@@ -0,0 +1,111 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/vm/vm.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../../../src/runtime/vm/serialize_utils.h"
+
+namespace tvm {
+namespace runtime {
+namespace vm {
+namespace {
+
+ObjectPtr<Executable> MakeExecutable() {
+  auto exec = make_object<Executable>();
+  exec->virtual_devices = {Device{kDLCPU, 0}};
+  exec->host_device_index = 0;
+  exec->primitive_map["prim"] = 0;
+  std::vector<Instruction> instrs = {
+      Instruction::LoadConsti(-7, 0),
+      Instruction::LoadConsti(int64_t{1} << 40, 1),
+      Instruction::AllocStorage(1, 64, DLDataType{kDLFloat, 32, 1}, 0, 2),
+      Instruction::AllocTensor(2, 0, {1, 3, 224, 224}, DLDataType{kDLFloat, 32, 1}, 3),
+      Instruction::InvokePacked(0, 2, 1, {0, 3}),
+      Instruction::If(0, 1, 1, 2),
+      Instruction::Goto(-1),
+      Instruction::Move(3, 4),
+      Instruction::Ret(4),
+  };
+  exec->functions.emplace_back("main", std::vector<std::string>{"x"}, instrs, 5,
+                               std::vector<Index>{0});
+  exec->global_map["main"] = 0;
+  return exec;
+}
+
+std::string Save(bool compact) {
+  ObjectPtr<Executable> exec = MakeExecutable();
+  exec->save_compact_code = compact;
+  TVMByteArray bytes = exec->Save();
+  return std::string(bytes.data, bytes.size);
+}
+
+std::string LoadBytecode(const std::string& bytes) {
+  Module mod = Executable::Load(bytes, Module());
+  return static_cast<Executable*>(mod.operator->())->GetBytecode();
+}
+
+TEST(VMBytecode, Varint) {
+  std::vector<Index> values = {0, 1, -1, 63, -64, 64, 127, 128, int64_t{1} << 40,
+                               std::numeric_limits<Index>::max(),
+                               std::numeric_limits<Index>::min()};
+  std::string code;
+  for (Index v : values) WriteVarint(&code, v);
+  // The small values take a byte.
+  EXPECT_EQ(code[0], 0);
+  size_t pos = 0;
+  for (Index v : values) {
+    Index loaded;
+    ASSERT_TRUE(ReadVarint(code, &pos, &loaded));
+    EXPECT_EQ(loaded, v);
+  }
+  EXPECT_EQ(pos, code.size());
+  Index loaded;
+  EXPECT_FALSE(ReadVarint(code, &pos, &loaded));
+}
+
+TEST(VMBytecode, CompactRoundTrip) {
+  std::string expected = MakeExecutable()->GetBytecode();
+  std::string compact = Save(true);
+  std::string legacy = Save(false);
+  EXPECT_LT(compact.size(), legacy.size());
+  EXPECT_EQ(LoadBytecode(compact), expected);
+  // The executables saved before the compact format still load.
+  EXPECT_EQ(LoadBytecode(legacy), expected);
+}
+
+TEST(VMBytecode, TruncatedCompactInstruction) {
+  VMInstructionSerializer instr(static_cast<Index>(Opcode::Move), {3, 4});
+  std::string code;
+  instr.SaveCompact(&code);
+  code.pop_back();
+  VMInstructionSerializer loaded;
+  size_t pos = 0;
+  EXPECT_FALSE(loaded.LoadCompact(code, &pos));
+}
+
+}  // namespace
+}  // namespace vm
+}  // namespace runtime
+}  // namespace tvm
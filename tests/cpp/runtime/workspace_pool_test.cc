@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "../../../src/runtime/workspace_pool.h"
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/device_api.h>
+
+namespace tvm {
+namespace runtime {
+namespace {
+
+constexpr size_t kPage = 4 << 10;
+
+TEST(WorkspacePool, SmallSizeClassReuse) {
+  Device dev{kDLCPU, 0};
+  WorkspacePool pool(kDLCPU, DeviceAPI::Get(dev));
+  void* a = pool.AllocWorkspace(dev, 100);
+  void* b = pool.AllocWorkspace(dev, 3 * kPage);
+  EXPECT_EQ(pool.GetStats(dev).current_bytes, 4 * kPage);
+  EXPECT_EQ(pool.GetStats(dev).wasted_bytes, kPage - 100);
+  pool.FreeWorkspace(dev, a);
+  pool.FreeWorkspace(dev, b);
+  // A small request is not served by a bigger cached block.
+  void* c = pool.AllocWorkspace(dev, 2 * kPage);
+  EXPECT_NE(c, b);
+  void* d = pool.AllocWorkspace(dev, 3 * kPage - 1);
+  EXPECT_EQ(d, b);
+  pool.FreeWorkspace(dev, c);
+  pool.FreeWorkspace(dev, d);
+  WorkspacePool::Stats stats = pool.GetStats(dev);
+  EXPECT_EQ(stats.current_bytes, 0);
+  EXPECT_EQ(stats.wasted_bytes, 0);
+  EXPECT_EQ(stats.peak_bytes, 5 * kPage);
+  EXPECT_EQ(stats.reserved_bytes, 6 * kPage);
+}
+
+TEST(WorkspacePool, LargeSplitAndCoalesce) {
+  Device dev{kDLCPU, 0};
+  WorkspacePool pool(kDLCPU, DeviceAPI::Get(dev));
+  const size_t large = 256 * kPage;
+  void* big = pool.AllocWorkspace(dev, large);
+  pool.FreeWorkspace(dev, big);
+  // Both halves are carved out of the cached block.
+  void* a = pool.AllocWorkspace(dev, large / 4);
+  void* b = pool.AllocWorkspace(dev, large / 4);
+  EXPECT_EQ(a, big);
+  EXPECT_EQ(static_cast<char*>(b), static_cast<char*>(a) + large / 4);
+  EXPECT_EQ(pool.GetStats(dev).reserved_bytes, large);
+  pool.FreeWorkspace(dev, a);
+  pool.FreeWorkspace(dev, b);
+  // The pieces are merged back into one block.
+  void* c = pool.AllocWorkspace(dev, large);
+  EXPECT_EQ(c, big);
+  EXPECT_EQ(pool.GetStats(dev).reserved_bytes, large);
+  pool.FreeWorkspace(dev, c);
+}
+
+}  // namespace
+}  // namespace runtime
+}  // namespace tvm
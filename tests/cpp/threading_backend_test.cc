@@ -22,7 +22,9 @@
 #include <tvm/runtime/c_backend_api.h>
 #include <tvm/runtime/threading_backend.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <sstream>
 #include <thread>
@@ -124,6 +126,29 @@ TEST(ThreadingBackend, TVMBackendParallelLaunch) {
   EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
 }
 
+static FTVMParallelLambda nested_launch_task_id = [](int task_id, TVMParallelGroupEnv* penv,
+                                                     void* cdata) -> int {
+  auto* data = reinterpret_cast<std::atomic<size_t>*>(cdata);
+  std::atomic<size_t> acc(0);
+  if (TVMBackendParallelLaunch(atomic_add_task_id, &acc, 0) != 0) return -1;
+  data->fetch_add(acc.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  return 0;
+};
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchNested) {
+  int num_threads = tvm::runtime::threading::NumThreads();
+  std::atomic<size_t> acc(0);
+  EXPECT_EQ(TVMBackendParallelLaunch(nested_launch_task_id, &acc, 0), 0);
+  EXPECT_EQ(acc.load(std::memory_order_relaxed), num_threads * N * (N - 1) / 2);
+
+  // Inner regions limited to a single thread run serially on the calling worker.
+  tvm::runtime::threading::SetNestedMaxConcurrency(1, 1);
+  acc.store(0);
+  EXPECT_EQ(TVMBackendParallelLaunch(nested_launch_task_id, &acc, 0), 0);
+  EXPECT_EQ(acc.load(std::memory_order_relaxed), num_threads * N * (N - 1) / 2);
+  tvm::runtime::threading::SetNestedMaxConcurrency(1, 0);
+}
+
 TEST(ThreadingBackend, TVMBackendParallelLaunchMultipleThreads) {
   // TODO(tulloch) use parameterised tests when available.
   size_t num_jobs_per_thread = 3;
@@ -185,3 +210,96 @@ TEST(ThreadingBackend, TVMBackendAffinityConfigure) {
     t->join();
   }
 }
+
+// Task 0 gets a much larger share of the work than the others, which makes the static
+// split wait on a single worker.
+static FTVMParallelLambda uneven_task_id = [](int task_id, TVMParallelGroupEnv* penv,
+                                              void* cdata) -> int {
+  auto* data = reinterpret_cast<std::atomic<size_t>*>(cdata);
+  AtomicCompute(task_id, N, data, penv);
+  if (task_id < penv->num_task / 8 + 1) {
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  }
+  return 0;
+};
+
+TEST(ThreadingBackend, TVMBackendParallelLaunchWorkStealing) {
+  auto measure_p99 = [](int granularity) {
+    tvm::runtime::threading::ConfigureWorkStealing(granularity);
+    std::vector<double> latency;
+    for (int i = 0; i < 100; ++i) {
+      std::atomic<size_t> acc(0);
+      auto start = std::chrono::high_resolution_clock::now();
+      EXPECT_EQ(TVMBackendParallelLaunch(uneven_task_id, &acc, 0), 0);
+      auto end = std::chrono::high_resolution_clock::now();
+      EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+      latency.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    std::sort(latency.begin(), latency.end());
+    return latency[latency.size() * 99 / 100];
+  };
+  double static_p99 = measure_p99(0);
+  double stealing_p99 = measure_p99(8);
+  LOG(INFO) << "p99 latency of uneven workload, static split: " << static_p99
+            << "us, work stealing: " << stealing_p99 << "us";
+
+  // Explicit task counts larger than the number of workers are also balanced.
+  std::atomic<size_t> acc(0);
+  EXPECT_EQ(TVMBackendParallelLaunch(atomic_add_task_id, &acc, 97), 0);
+  EXPECT_EQ(acc.load(std::memory_order_relaxed), N * (N - 1) / 2);
+  tvm::runtime::threading::ConfigureWorkStealing(0);
+}
+
+TEST(ThreadingBackend, TVMBackendNumaNodeConfigure) {
+  int num_nodes = tvm::runtime::threading::NumNumaNodes();
+  if (num_nodes == 0) {
+    return;
+  }
+  // One pool per NUMA node, each configured from its own thread.
+  std::vector<std::unique_ptr<std::thread>> ts;
+  for (int node = 0; node < num_nodes; ++node) {
+    ts.emplace_back(new std::thread(
+        [](int numa_node) {
+          std::vector<unsigned int> cpus = tvm::runtime::threading::NumaNodeCPUs(numa_node);
+          ASSERT_FALSE(cpus.empty());
+          std::atomic<size_t> acc(0);
+          AffinityCheck ac(numa_node, tvm::runtime::threading::MaxConcurrency(), &acc);
+          tvm::runtime::threading::Configure(tvm::runtime::threading::ThreadGroup::kNumaNode, 0,
+                                             {static_cast<unsigned int>(numa_node)});
+          EXPECT_EQ(tvm::runtime::threading::BoundNumaNode(), numa_node);
+          TVMBackendParallelLaunch(affinity_check_task_id, &ac, 0);
+          EXPECT_EQ(ac.GetComputeResult(), N * (N - 1) / 2);
+          EXPECT_EQ(ac.VerifyAffinity(cpus), true);
+        },
+        node));
+  }
+  for (auto& t : ts) {
+    t->join();
+  }
+}
+
+TEST(ThreadingBackend, TVMBackendNamedThreadPool) {
+  int max_concurrency = tvm::runtime::threading::MaxConcurrency();
+  std::vector<unsigned int> cpus;
+  for (int i = 0; i < std::min(max_concurrency, 2); ++i) {
+    cpus.push_back(i);
+  }
+  tvm::runtime::threading::CreateThreadPool("threading_backend_test", cpus);
+  // Several threads sharing one named pool.
+  std::vector<std::unique_ptr<std::thread>> ts;
+  for (int i = 0; i < 2; ++i) {
+    ts.emplace_back(new std::thread([&]() {
+      tvm::runtime::threading::ThreadPoolScope scope("threading_backend_test");
+      for (int j = 0; j < 3; ++j) {
+        std::atomic<size_t> acc(0);
+        AffinityCheck ac(0, max_concurrency, &acc);
+        TVMBackendParallelLaunch(affinity_check_task_id, &ac, 0);
+        EXPECT_EQ(ac.GetComputeResult(), N * (N - 1) / 2);
+        EXPECT_EQ(ac.VerifyAffinity(cpus), true);
+      }
+    }));
+  }
+  for (auto& t : ts) {
+    t->join();
+  }
+}
@@ -21,6 +21,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include "../../src/runtime/crt/include/tvm/runtime/crt/internal/graph_executor/load_json.h"
 
 namespace {
@@ -112,4 +116,98 @@ TEST(TVMGraphExecutor_Load, Parse) {
   EXPECT_EQ(executor.nodes_count, 3);
 }
 
+// Build kJson in the flat graph format, as GraphExecutor::SaveGraphFlat does.
+std::vector<uint64_t> MakeFlatGraph() {
+  std::string flat(sizeof(TVMGraphFlatHeader), '\0');
+  auto align = [&flat]() {
+    flat.resize((flat.size() + 7) & ~static_cast<size_t>(7), '\0');
+    return static_cast<uint32_t>(flat.size());
+  };
+  auto write = [&flat](const void* data, size_t size) {
+    flat.append(static_cast<const char*>(data), size);
+  };
+  auto write_u32s = [&write](std::vector<uint32_t> values) {
+    write(values.data(), values.size() * sizeof(uint32_t));
+  };
+  auto add_string = [&flat](const char* str) {
+    uint32_t offset = static_cast<uint32_t>(flat.size());
+    flat.append(str, strlen(str) + 1);
+    return offset;
+  };
+  TVMGraphFlatHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, TVM_GRAPH_FLAT_MAGIC, sizeof(header.magic));
+  uint32_t null_op = add_string("null");
+  uint32_t tvm_op = add_string("tvm_op");
+  uint32_t empty = add_string("");
+  uint32_t add = add_string("tvmgen_default_fused_add");
+  TVMGraphFlatNode nodes[3] = {
+      {null_op, add_string("x"), empty, 0, 1, 0, 0, 0},
+      {null_op, add_string("p0"), empty, 0, 1, 0, 0, 0},
+      {tvm_op, add, add, 2, 1, 0, align(), 2},
+  };
+  write_u32s({0, 0, 0, 1, 0, 0});
+  header.nodes_count = 3;
+  header.nodes = align();
+  write(nodes, sizeof(nodes));
+  header.input_nodes_count = 2;
+  header.input_nodes = align();
+  write_u32s({0, 1});
+  header.node_row_ptr_count = 4;
+  header.node_row_ptr = align();
+  write_u32s({0, 1, 2, 3});
+  header.outputs_count = 1;
+  header.outputs = align();
+  write_u32s({2, 0, 0});
+  header.entries_count = 3;
+  header.shape_stride = 2;
+  header.storage_id = align();
+  write_u32s({0, 1, 2});
+  header.dltype = align();
+  DLDataType float32 = {kDLFloat, 32, 1};
+  for (int i = 0; i < 3; ++i) write(&float32, sizeof(float32));
+  header.ndim = align();
+  write_u32s({2, 2, 2});
+  header.shape = align();
+  int64_t shapes[] = {10, 5, 1, 5, 10, 5};
+  write(shapes, sizeof(shapes));
+  memcpy(&flat[0], &header, sizeof(header));
+
+  std::vector<uint64_t> graph((flat.size() + 7) / 8);
+  memcpy(graph.data(), flat.data(), flat.size());
+  return graph;
+}
+
+// Check a flat graph is used in place.
+TEST(TVMGraphExecutor_LoadFlat, InPlace) {
+  std::vector<uint64_t> graph = MakeFlatGraph();
+  const char* flat = reinterpret_cast<const char*>(graph.data());
+  const TVMGraphFlatHeader* header = reinterpret_cast<const TVMGraphFlatHeader*>(flat);
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  EXPECT_EQ(TVMGraphExecutor_LoadFlat(&executor, flat), 0);
+  EXPECT_EQ(executor.nodes_count, 3);
+  EXPECT_EQ(executor.input_nodes_count, 2);
+  EXPECT_EQ(reinterpret_cast<const char*>(executor.node_row_ptr), flat + header->node_row_ptr);
+  EXPECT_EQ(executor.outputs_count, 1);
+  EXPECT_EQ(executor.outputs[0].node_id, 2);
+  EXPECT_EQ(executor.attrs.storage_id[2], 2);
+  EXPECT_EQ(executor.attrs.ndim[1], 2);
+  EXPECT_EQ(executor.attrs.shape[2 * header->shape_stride], 10);
+  EXPECT_EQ(TVMGraphExecutor_GetInputIndex(&executor, "p0"), 1);
+}
+
+// Check a flat graph is rejected when misaligned or without the magic.
+TEST(TVMGraphExecutor_LoadFlat, Invalid) {
+  std::vector<uint64_t> graph = MakeFlatGraph();
+  std::vector<uint64_t> shifted(graph.size() + 1);
+  char* misaligned = reinterpret_cast<char*>(shifted.data()) + 4;
+  memcpy(misaligned, graph.data(), graph.size() * sizeof(uint64_t));
+  TVMGraphExecutor executor;
+  memset(&executor, 0, sizeof(executor));
+  EXPECT_NE(TVMGraphExecutor_LoadFlat(&executor, misaligned), 0);
+  reinterpret_cast<char*>(graph.data())[0] = 'X';
+  EXPECT_NE(TVMGraphExecutor_LoadFlat(&executor, reinterpret_cast<const char*>(graph.data())), 0);
+}
+
 }  // namespace
@@ -136,17 +136,20 @@ TEST_F(SessionTest, NormalExchange) {
 
   err = alice_.sess.StartSession();
   EXPECT_EQ(err, kTvmErrorNoError);
-  EXPECT_FRAMED_PACKET(alice_, "\xff\xfd\x04\0\0\0\x82\0\0\x01{\xE9");
+  EXPECT_FRAMED_PACKET(alice_, "\xff\xfd\x08\0\0\0\x82\0\0\x02,\x01\0\0\x86\xe8");
 
   bob_.ClearBuffers();
   alice_.WriteTo(&bob_);
   EXPECT_FRAMED_PACKET(bob_,
-                       "\xff\xfd\x4\0\0\0\x82"
-                       "f\x01\x01\x81\xf3");
+                       "\xff\xfd\x08\0\0\0\x82"
+                       "f\x01\x02,\x01\0\0\x19\xbf");
   EXPECT_TRUE(bob_.sess.IsEstablished());
 
   bob_.WriteTo(&alice_);
   EXPECT_TRUE(alice_.sess.IsEstablished());
+  // Both ends learn the receive capacity of the other from the session start messages.
+  EXPECT_EQ(alice_.sess.PeerMaxPacketSizeBytes(), sizeof(bob_.receive_buffer_array));
+  EXPECT_EQ(bob_.sess.PeerMaxPacketSizeBytes(), sizeof(alice_.receive_buffer_array));
   ASSERT_EQ(alice_.messages_received.size(), 1UL);
   EXPECT_EQ(alice_.messages_received[0], ReceivedMessage(MessageType::kStartSessionReply, ""));
 
@@ -199,7 +202,7 @@ TEST_F(SessionTest, LogBeforeSessionStart) {
   EXPECT_EQ(alice_.messages_received[0], ReceivedMessage(MessageType::kLog, "zero"));
 }
 
-static constexpr const char kBobStartPacket[] = "\xff\xfd\x04\0\0\0f\0\0\x01`\xa7";
+static constexpr const char kBobStartPacket[] = "\xff\xfd\x08\0\0\0f\0\0\x02,\x01\0\0\xd2\x97";
 
 TEST_F(SessionTest, DoubleStart) {
   tvm_crt_error_t err;
@@ -221,7 +224,7 @@ TEST_F(SessionTest, DoubleStart) {
   alice_.ClearBuffers();
 
   EXPECT_EQ(kTvmErrorNoError, alice_.sess.StartSession());
-  EXPECT_FRAMED_PACKET(alice_, "\xff\xfd\x04\0\0\0\x82\0\0\x01{\xe9");
+  EXPECT_FRAMED_PACKET(alice_, "\xff\xfd\x08\0\0\0\x82\0\0\x02,\x01\0\0\x86\xe8");
   EXPECT_FALSE(alice_.sess.IsEstablished());
 
   EXPECT_EQ(kTvmErrorNoError, bob_.sess.StartSession());
@@ -241,7 +244,9 @@ TEST_F(SessionTest, DoubleStart) {
             alice_.unframer.Write(reinterpret_cast<const uint8_t*>(kBobStartPacket),
                                   sizeof(kBobStartPacket), &bytes_consumed));
   EXPECT_EQ(bytes_consumed, sizeof(kBobStartPacket));
-  EXPECT_FRAMED_PACKET(alice_, "\xFF\xFD\x4\0\0\0fE\x01\x01\fb");
+  EXPECT_FRAMED_PACKET(alice_,
+                       "\xFF\xFD\x08\0\0\0fE\x01\x02,\x01\0\0"
+                       "9v");
   EXPECT_TRUE(alice_.sess.IsEstablished());
 
   bob_.ClearBuffers();
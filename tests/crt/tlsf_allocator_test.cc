@@ -0,0 +1,149 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <tvm/runtime/crt/internal/memory/tlsf_allocator.h>
+#include <tvm/runtime/crt/tlsf_allocator.h>
+
+#include <vector>
+
+static constexpr const unsigned int kMemoryPoolSizeBytes = 16 * 1024;
+
+class TLSFAllocatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(memory_pool, 0, sizeof(memory_pool));
+    ASSERT_EQ(TLSFMemoryManagerCreate(&interface, memory_pool, kMemoryPoolSizeBytes),
+              kTvmErrorNoError);
+    dev_ = {kDLCPU, 0};
+  }
+
+  TLSFMemoryManagerStats Stats() {
+    TLSFMemoryManagerStats stats;
+    EXPECT_EQ(TLSFMemoryManagerGetStats(interface, &stats), kTvmErrorNoError);
+    return stats;
+  }
+
+  alignas(16) uint8_t memory_pool[kMemoryPoolSizeBytes];
+  MemoryManagerInterface* interface;
+  DLDevice dev_;
+};
+
+TEST_F(TLSFAllocatorTest, Mapping) {
+  int fl, sl;
+  TLSF_MappingInsert(16, &fl, &sl);
+  EXPECT_EQ(fl, 0);
+  EXPECT_EQ(sl, 1);
+  TLSF_MappingInsert(TLSF_SMALL_BLOCK_BYTES, &fl, &sl);
+  EXPECT_EQ(fl, 1);
+  EXPECT_EQ(sl, 0);
+  TLSF_MappingInsert(TLSF_SMALL_BLOCK_BYTES * 2 - 1, &fl, &sl);
+  EXPECT_EQ(fl, 1);
+  EXPECT_EQ(sl, TLSF_SL_COUNT - 1);
+  // Searching rounds up to the next class.
+  TLSF_MappingSearch(TLSF_SMALL_BLOCK_BYTES + TLSF_ALIGN_BYTES, &fl, &sl);
+  EXPECT_EQ(fl, 1);
+  EXPECT_EQ(sl, 1);
+  TLSF_MappingSearch(TLSF_SMALL_BLOCK_BYTES + 2 * TLSF_ALIGN_BYTES, &fl, &sl);
+  EXPECT_EQ(fl, 1);
+  EXPECT_EQ(sl, 2);
+}
+
+TEST_F(TLSFAllocatorTest, SmallAllocationsAreNotPageRounded) {
+  TLSFMemoryManagerStats initial = Stats();
+  EXPECT_EQ(initial.used_bytes, 0);
+  EXPECT_EQ(initial.free_bytes, initial.largest_free_bytes);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; i++) {
+    void* ptr;
+    ASSERT_EQ(interface->Allocate(interface, 20, dev_, &ptr), kTvmErrorNoError);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % TLSF_ALIGN_BYTES, 0);
+    memset(ptr, 0xff, 20);
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(interface->vleak_size, 100);
+  EXPECT_EQ(Stats().used_bytes, 100 * 32);
+
+  for (void* ptr : ptrs) {
+    EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  }
+  TLSFMemoryManagerStats stats = Stats();
+  EXPECT_EQ(interface->vleak_size, 0);
+  EXPECT_EQ(stats.used_bytes, 0);
+  EXPECT_EQ(stats.peak_used_bytes, 100 * 32);
+  EXPECT_EQ(stats.num_allocations, 100);
+  // Every block was merged back.
+  EXPECT_EQ(stats.free_bytes, initial.free_bytes);
+  EXPECT_EQ(stats.largest_free_bytes, initial.free_bytes);
+}
+
+TEST_F(TLSFAllocatorTest, MergeInAnyOrder) {
+  TLSFMemoryManagerStats initial = Stats();
+  void* ptrs[3];
+  for (int i = 0; i < 3; i++) {
+    ASSERT_EQ(interface->Allocate(interface, 1000, dev_, &ptrs[i]), kTvmErrorNoError);
+  }
+  EXPECT_EQ(interface->Free(interface, ptrs[0], dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptrs[2], dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptrs[1], dev_), kTvmErrorNoError);
+  EXPECT_EQ(Stats().largest_free_bytes, initial.free_bytes);
+
+  // The freed blocks are reused.
+  void* ptr;
+  ASSERT_EQ(interface->Allocate(interface, 1000, dev_, &ptr), kTvmErrorNoError);
+  EXPECT_EQ(ptr, ptrs[0]);
+  EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+}
+
+TEST_F(TLSFAllocatorTest, FragmentationCounters) {
+  std::vector<void*> ptrs;
+  void* ptr;
+  while (interface->Allocate(interface, 512, dev_, &ptr) == kTvmErrorNoError) {
+    ptrs.push_back(ptr);
+  }
+  EXPECT_EQ(Stats().num_failed_allocations, 1);
+  // Free every other block, leaving plenty of memory in holes too small for 1024 bytes.
+  for (size_t i = 0; i < ptrs.size(); i += 2) {
+    EXPECT_EQ(interface->Free(interface, ptrs[i], dev_), kTvmErrorNoError);
+  }
+  TLSFMemoryManagerStats stats = Stats();
+  EXPECT_GE(stats.free_bytes, 1024);
+  EXPECT_LT(stats.largest_free_bytes, 1024);
+  EXPECT_EQ(interface->Allocate(interface, 1024, dev_, &ptr), kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(Stats().num_fragmented_failures, 1);
+
+  EXPECT_EQ(TLSFMemoryManagerResetPeak(interface), kTvmErrorNoError);
+  EXPECT_EQ(Stats().peak_used_bytes, Stats().used_bytes);
+}
+
+TEST_F(TLSFAllocatorTest, BadFree) {
+  void* ptr;
+  ASSERT_EQ(interface->Allocate(interface, 64, dev_, &ptr), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorNoError);
+  EXPECT_EQ(interface->Free(interface, ptr, dev_), kTvmErrorPlatformMemoryBadFree);
+}
+
+TEST_F(TLSFAllocatorTest, TooLarge) {
+  void* ptr;
+  EXPECT_EQ(interface->Allocate(interface, kMemoryPoolSizeBytes, dev_, &ptr),
+            kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(interface->Allocate(interface, SIZE_MAX, dev_, &ptr), kTvmErrorPlatformNoMemory);
+  EXPECT_EQ(Stats().num_fragmented_failures, 0);
+}
@@ -60,6 +60,28 @@ def test_fp16_conversion():
         tvm.testing.assert_allclose(expected, real)
 
 
+@tvm.testing.uses_gpu
+def test_copy_converts_float_dtype():
+    x = (100 * np.random.randn(3, 100) - 50).astype("float32")
+    bits = x.view("uint32")
+    x_bf16 = ((bits + 0x7FFF + ((bits >> 16) & 1)) >> 16).astype("uint16")
+    for _, dev in tvm.testing.enabled_targets():
+        src = tvm.nd.array(x, device=dev)
+
+        half = tvm.nd.empty(x.shape, "float16", dev)
+        src.copyto(half)
+        np.testing.assert_equal(half.numpy(), x.astype("float16"))
+        back = tvm.nd.empty(x.shape, "float32", dev)
+        half.copyto(back)
+        np.testing.assert_equal(back.numpy(), x.astype("float16").astype("float32"))
+
+        bf16 = tvm.nd.empty(x.shape, "bfloat16", dev)
+        src.copyto(bf16)
+        np.testing.assert_equal(bf16.numpy(), x_bf16)
+        bf16.copyto(back)
+        np.testing.assert_equal(back.numpy(), (x_bf16.astype("uint32") << 16).view("float32"))
+
+
 def test_dtype():
     dtype = tvm.DataType("handle")
     assert dtype.type_code == tvm.DataTypeCode.HANDLE
@@ -68,4 +90,5 @@ def test_dtype():
 if __name__ == "__main__":
     test_nd_create()
     test_fp16_conversion()
+    test_copy_converts_float_dtype()
     test_dtype()
@@ -14,7 +14,9 @@
 # KIND, either express or implied.  See the License for the
 # specific language governing permissions and limitations
 # under the License.
+import json
 import logging
+import os
 import tempfile
 import math
 import tvm
@@ -32,6 +34,7 @@ from tvm.contrib.cutlass import (
     finalize_modules,
     finalize_modules_vm,
 )
+from tvm.contrib.cutlass.gen_tensor_op import TuningCache
 import tvm.testing
 
 logging.basicConfig(level=logging.INFO)
@@ -371,6 +374,8 @@ def profile_and_build_vm(
     tmp_dir="./tmp",
     use_fast_math=False,
     use_3xtf32=True,
+    dynamic_m_buckets=[],
+    tuning_cache="",
 ):
     mod = partition_for_cutlass(mod)
     num_cutlass_partition = num_cutlass_partitions(mod)
@@ -387,6 +392,8 @@ def profile_and_build_vm(
             "use_multiprocessing": True,
             "use_fast_math": use_fast_math,
             "tmp_dir": tmp_dir,
+            "dynamic_m_buckets": dynamic_m_buckets,
+            "tuning_cache": tuning_cache,
         },
         host=host,
     )
@@ -590,6 +597,49 @@ def test_dense_dynamic():
     )
 
 
+@tvm.testing.requires_cutlass
+def test_dense_dynamic_m_buckets():
+    data_shape = (relay.Any(), K)
+    weight_shape = (N, K)
+    func = get_dense_with_shape(data_shape, weight_shape, out_dtype="float32")
+    mod = tvm.IRModule.from_expr(func)
+    np_weight = get_random_ndarray((N, K), "float16")
+    params = {"weight": np_weight}
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        tuning_cache = os.path.join(tmp_dir, "tuning_cache.json")
+        rt_mod, dev, num_partition = profile_and_build_vm(
+            mod, params, 80, dynamic_m_buckets=[16, 256], tuning_cache=tuning_cache
+        )
+        assert num_partition > 0
+        with open(tuning_cache) as f:
+            assert len(json.load(f)) == 2
+
+        rt_mod_ref, dev = get_ref_vm(mod, params)
+        for batch in [1, 8, 16, 100, 256, 1000]:
+            x = tvm.nd.array(get_random_ndarray((batch, K), "float16"), device=dev)
+            out = get_output_vm(rt_mod, ["data"], [x])
+            ref_out = get_output_vm(rt_mod_ref, ["data"], [x])
+            np.testing.assert_allclose(out, ref_out, atol=1e-4, rtol=1e-4)
+
+
+def test_tuning_cache():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "tuning_cache.json")
+        workload = ("gemm", 80, 64, 128, 256, "float16", "float16", "float16", True, False, False)
+        cache = TuningCache(path)
+        assert cache.get(workload) is None
+        cache.put(workload, "cutlass_tensorop_h16816gemm_128x64_32x3_tn_align8", 0.01)
+
+        other = TuningCache(path)
+        other_workload = workload[:2] + (32,) + workload[3:]
+        other.put(other_workload, "cutlass_simt_sgemm_64x64_8x2_tn_align1", 0.1)
+
+        reloaded = TuningCache(path)
+        assert reloaded.get(workload)["name"] == "cutlass_tensorop_h16816gemm_128x64_32x3_tn_align8"
+        assert len(reloaded.records) == 2
+
+
 @tvm.testing.requires_cutlass
 def test_batch_matmul():
     batch = 8
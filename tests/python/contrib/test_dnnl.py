@@ -969,6 +969,29 @@ def test_dense(run_module, dtype="float32"):
     config = dense, dic, param_lst
     run_and_verify_func(config, run_module=run_module, dtype=dtype)
 
+
+def test_dense_dynamic_batch(run_module, dtype="float32"):
+    k_shape = (32, 16)
+    x = relay.var("x", shape=(relay.Any(), k_shape[1]), dtype=dtype)
+    kernel = relay.var("kernel", shape=k_shape, dtype=dtype)
+    mod = tvm.IRModule.from_expr(relay.nn.relu(relay.nn.dense(x, kernel, units=k_shape[0])))
+    k_data = np.random.uniform(-1, 1, k_shape).astype(dtype)
+    params = {"kernel": tvm.nd.array(k_data)}
+    mod = partition_for_dnnl(mod, params, alter_layout=False)
+    check_dnnl_used(mod)
+    with tvm.transform.PassContext(opt_level=3):
+        exe = relay.vm.compile(mod, target="llvm", params=params)
+    if not run_module:
+        return
+    vm = tvm.runtime.vm.VirtualMachine(exe, tvm.cpu())
+    # The networks built for each batch size are cached and reused.
+    for batch in [1, 4, 7, 4, 1]:
+        x_data = np.random.uniform(-1, 1, (batch, k_shape[1])).astype(dtype)
+        out = vm.run(x_data)
+        tvm.testing.assert_allclose(
+            out.numpy(), np.maximum(x_data @ k_data.T, 0), rtol=1e-5, atol=1e-5
+        )
+
     dense, dic, param_lst = get_dense(x_shape, k_shape, activation="gelu", dtype=dtype)
     dense = tvm.IRModule.from_expr(dense)
     config = dense, dic, param_lst
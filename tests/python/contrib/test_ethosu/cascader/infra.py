@@ -37,6 +37,7 @@ def make_options(
     disable_pareto_plans: bool = False,
     disable_pareto_proposals: bool = False,
     enable_striping: bool = True,
+    plan_time_budget: float = 0.0,
 ):
     return cs.CascaderOptions(
         cascade_region=cascade_region,
@@ -49,6 +50,7 @@ def make_options(
         disable_pareto_plans=disable_pareto_plans,
         disable_pareto_proposals=disable_pareto_proposals,
         enable_striping=enable_striping,
+        plan_time_budget=plan_time_budget,
     )
 
 
@@ -209,8 +209,9 @@ def test_generate_single_plans(SRAM, DRAM):
             assert open_config.state == cs.TensorConfigState.INTERIOR
 
 
-def test_generate_graph_plans(SRAM, DRAM):
-    num_part_groups = 3
+# Past the time budget, the Parts are not cascaded together any more
+@pytest.mark.parametrize("plan_time_budget, num_part_groups", [(0.0, 3), (1e-9, 2)])
+def test_generate_graph_plans(SRAM, DRAM, plan_time_budget, num_part_groups):
     stripe_factors = 4
     max_plan_size = 10
     subgraph = cs.TESubgraph([], None)
@@ -264,10 +265,13 @@ def test_generate_graph_plans(SRAM, DRAM):
         cascade_region=SRAM,
         stripe_factors=stripe_factors,
         max_plan_size=max_plan_size,
+        plan_time_budget=plan_time_budget,
     )
     closed_plans = _generate_graph_plans(graph, home_map, options)
 
     assert len(closed_plans) == num_part_groups
+    for part_group in closed_plans:
+        assert plan_time_budget == 0.0 or len(part_group) == 1
 
 
 if ethosu_enabled:
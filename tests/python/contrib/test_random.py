@@ -97,6 +97,42 @@ def test_normal():
     verify()
 
 
+def test_seed_reproducible():
+    """The samples only depend on the seed, not on the number of threads filling them."""
+    m = 1024
+    n = 1024
+    A = random.normal(0, 1, size=(m, n))
+    s = te.create_schedule(A.op)
+    if not tvm.testing.device_enabled("llvm"):
+        return
+    if not tvm.get_global_func("tvm.contrib.random.seed", True):
+        print("skip because extern function is not available")
+        return
+    f = tvm.build(s, [A], "llvm")
+    seed = tvm.get_global_func("tvm.contrib.random.seed")
+
+    def sample(num_threads=None):
+        if num_threads is not None:
+            tvm.get_global_func("runtime.config_threadpool")(1, num_threads)
+        seed(42)
+        a = tvm.nd.array(np.zeros((m, n), dtype=A.dtype), tvm.cpu(0))
+        f(a)
+        b = tvm.nd.array(np.zeros((m, n), dtype=A.dtype), tvm.cpu(0))
+        f(b)
+        return a.numpy(), b.numpy()
+
+    expected = sample()
+    assert not np.array_equal(expected[0], expected[1])
+
+    # The seed and the thread pool are thread local, sample on another thread with one worker.
+    result = []
+    x = threading.Thread(target=lambda: result.append(sample(num_threads=1)))
+    x.start()
+    x.join()
+    tvm.testing.assert_allclose(result[0][0], expected[0])
+    tvm.testing.assert_allclose(result[0][1], expected[1])
+
+
 @tvm.testing.uses_gpu
 def test_random_fill():
     def test_local(dev, dtype):
@@ -186,5 +222,6 @@ if __name__ == "__main__":
     test_randint()
     test_uniform()
     test_normal()
+    test_seed_reproducible()
     test_random_fill()
     test_random_fill_mt()
@@ -91,6 +91,35 @@ def test_sort_np():
     tvm.testing.assert_allclose(c.numpy(), np_out, rtol=1e-5)
 
 
+def test_argsort_topk_long_rows():
+    dev = tvm.cpu(0)
+    argsort = tvm.get_global_func("tvm.contrib.sort.argsort")
+    topk = tvm.get_global_func("tvm.contrib.sort.topk")
+    # Few long rows with many ties, which are split across the threads.
+    for dtype in ["float32", "int32", "int64", "float64"]:
+        np_data = np.random.randint(-1000, 1000, size=(2, 1 << 17)).astype(dtype)
+        a = tvm.nd.array(np_data, dev)
+        for is_ascend in [True, False]:
+            out = tvm.nd.array(np.zeros(np_data.shape, dtype="int64"), dev)
+            argsort(a, out, -1, is_ascend)
+            keys = np_data if is_ascend else -np_data
+            np.testing.assert_equal(out.numpy(), np.argsort(keys, axis=-1, kind="stable"))
+
+            k = 10
+            values = tvm.nd.array(np.zeros((2, k), dtype=dtype), dev)
+            indices = tvm.nd.array(np.zeros((2, k), dtype="int32"), dev)
+            topk(a, values, indices, k, -1, "both", is_ascend)
+            ref = np.argsort(keys, axis=-1, kind="stable")[:, :k]
+            np.testing.assert_equal(indices.numpy(), ref)
+            np.testing.assert_equal(values.numpy(), np.take_along_axis(np_data, ref, axis=-1))
+
+    # Many short rows along a strided axis.
+    np_data = np.random.randint(-10, 10, size=(16, 300, 3)).astype("float32")
+    out = tvm.nd.array(np.zeros(np_data.shape, dtype="int32"), dev)
+    argsort(tvm.nd.array(np_data, dev), out, 1, True)
+    np.testing.assert_equal(out.numpy(), np.argsort(np_data, axis=1, kind="stable"))
+
+
 def test_sort_by_key_gpu():
     size = 6
     keys = te.placeholder((size,), name="keys", dtype="int32")
@@ -126,4 +155,5 @@ def test_sort_by_key_gpu():
 if __name__ == "__main__":
     test_sort()
     test_sort_np()
+    test_argsort_topk_long_rows()
     test_sort_by_key_gpu()
@@ -248,6 +248,48 @@ def test_aot_input_name_with_special_character(target_kind: str, input_name: str
         assert (runner.get_output(0).asnumpy() == expected_output).all()
 
 
+@pytest.mark.parametrize("enable_usmp", [True, False])
+def test_create_context(enable_usmp: bool):
+    """Test running several execution contexts of one AOT executor."""
+    dtype = "float32"
+    input1 = relay.var("input", shape=(10, 5), dtype=dtype)
+    weight = relay.var("weight", shape=(1, 5), dtype=dtype)
+    output = relay.add(relay.add(input1, weight), input1)
+    func = relay.Function([input1, weight], output)
+    weight_data = np.random.rand(1, 5).astype(dtype)
+
+    with tvm.transform.PassContext(
+        opt_level=3, config={"tir.disable_vectorize": True, "tir.usmp.enable": enable_usmp}
+    ):
+        mod = tvm.relay.build(
+            tvm.IRModule.from_expr(func),
+            target="llvm",
+            params={"weight": weight_data},
+            executor=tvm.relay.backend.Executor("aot", {"interface-api": "packed"}),
+        )
+    temp_dir = tvm.contrib.utils.TempDirectory()
+    test_so_path = temp_dir / "test.so"
+    mod.export_library(test_so_path, cc="c++", options=["-std=gnu++17", "-g3", "-O0"])
+
+    loaded_mod = tvm.runtime.load_module(test_so_path)
+    runner = tvm.runtime.executor.AotModule(loaded_mod["default"](tvm.cpu(0)))
+    contexts = [runner.create_context() for _ in range(2)]
+    input_data = [np.random.rand(10, 5).astype(dtype) for _ in contexts]
+    for context, data in zip(contexts, input_data):
+        context.set_input(input=data)
+    # The inputs and outputs of a context are its own.
+    for context in contexts:
+        context.run()
+    for context, data in zip(contexts, input_data):
+        tvm.testing.assert_allclose(context.get_output(0).numpy(), 2 * data + weight_data)
+
+    futures = [
+        context.run_async(input=data) for context, data in zip(contexts, reversed(input_data))
+    ]
+    for future, data in zip(futures, reversed(input_data)):
+        tvm.testing.assert_allclose(future.result()[0].numpy(), 2 * data + weight_data)
+
+
 @pytest.mark.parametrize("target_kind", ["c", "llvm"])
 def test_aot_incorrect_input_name(target_kind: str):
     """Test passing incorrect input name."""
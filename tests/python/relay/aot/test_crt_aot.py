@@ -1055,6 +1055,42 @@ def test_aot_codegen_checks_returns():
     )
 
 
+def test_aot_codegen_constant_prefetch():
+    """Checks that the constant-prefetch executor option streams the weights into the workspace"""
+    input_x = relay.var("x", shape=(1, 16), dtype="float32")
+    weight_0 = relay.const(np.random.uniform(size=(16, 16)).astype("float32"))
+    weight_1 = relay.const(np.random.uniform(size=(8, 16)).astype("float32"))
+    dense_0 = relay.nn.dense(input_x, weight_0)
+    dense_1 = relay.nn.dense(dense_0, weight_1)
+    mod = IRModule.from_expr(relay.Function([input_x], dense_1))
+
+    executor = Executor(
+        "aot",
+        {"interface-api": "c", "unpacked-api": True, "constant-prefetch": True},
+    )
+    with tvm.transform.PassContext(opt_level=3, config={"tir.disable_vectorize": True}):
+        lib = tvm.relay.build(mod, "c", executor=executor, runtime=Runtime("crt"))
+
+    main_func = lib.lowered_ir_mods.items()[0][1]["__tvm_main__"]
+    calls = []
+
+    def _collect_extern_calls(node):
+        if isinstance(node, tvm.tir.Call) and node.op.name == "tir.call_extern":
+            calls.append(node.args[0].value)
+
+    tvm.tir.stmt_functor.post_order_visit(main_func.body, _collect_extern_calls)
+    operators = [call for call in calls if not call.startswith("TVMPlatform")]
+    assert len(operators) == 2
+    assert calls == [
+        "TVMPlatformMemcpyAsync",
+        "TVMPlatformMemcpyWait",
+        "TVMPlatformMemcpyAsync",
+        operators[0],
+        "TVMPlatformMemcpyWait",
+        operators[1],
+    ]
+
+
 def test_aot_uses_anf():
     """Checks that A-Normal Form is being used in the AOT lowering pipeline."""
     input_x = relay.var("x", shape=(1, 10, 10, 10))
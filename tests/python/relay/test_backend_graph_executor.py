@@ -184,6 +184,60 @@ def test_plan_memory():
     )
 
 
+@pytest.mark.parametrize("algorithm", ["greedy", "greedy_by_size", "hill_climb"])
+def test_plan_memory_algorithms(algorithm):
+    x = relay.var("x", shape=(16, 64))
+    a = relay.exp(x)
+    b = relay.sum(a, axis=1, keepdims=True)
+    c = relay.nn.relu(relay.subtract(a, b))
+    d = relay.tile(relay.sqrt(b), (1, 64))
+    z = relay.multiply(relay.sigmoid(c), d)
+    mod = tvm.IRModule.from_expr(relay.Function([x], z))
+    mod = relay.transform.InferType()(mod)
+    mod = relay.transform.FuseOps(0)(mod)
+    mod = relay.transform.InferType()(mod)
+
+    config = {"relay.backend.graph_plan_memory.algorithm": algorithm}
+    with tvm.transform.PassContext(config=config):
+        stats = relay.backend._backend.GraphPlanMemoryStats(mod["main"])
+        lib = relay.build(tvm.IRModule.from_expr(relay.Function([x], z)), "llvm")
+    assert 0 < int(stats["lower_bound_bytes"]) <= int(stats["planned_bytes"])
+
+    x_data = np.random.rand(16, 64).astype("float32")
+    a_np = np.exp(x_data)
+    b_np = a_np.sum(axis=1, keepdims=True)
+    ref = np.tile(np.sqrt(b_np), (1, 64)) / (1 + np.exp(-np.maximum(a_np - b_np, 0)))
+    gmod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data)
+    gmod.run()
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), ref, rtol=1e-5)
+
+
+@pytest.mark.parametrize("enable_inplace", [False, True])
+def test_plan_memory_inplace(enable_inplace):
+    x = relay.var("x", shape=(10, 4))
+    a = relay.exp(x)
+    b = relay.negative(a)
+    c = relay.sigmoid(b)
+    mod = tvm.IRModule.from_expr(relay.Function([x], c))
+
+    config = {"relay.backend.enable_inplace": enable_inplace}
+    with tvm.transform.PassContext(opt_level=0, config=config):
+        lib = relay.build(mod, "llvm")
+    graph_json = json.loads(lib.get_graph_json())
+
+    # with in-place execution, negative and sigmoid write into the output of exp
+    storage_ids = graph_json["attrs"]["storage_id"][1]
+    assert len(set(storage_ids)) == (2 if enable_inplace else 3)
+
+    x_data = np.random.rand(10, 4).astype("float32")
+    gmod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+    gmod.set_input(x=x_data)
+    gmod.run()
+    ref = 1 / (1 + np.exp(np.exp(x_data)))
+    tvm.testing.assert_allclose(gmod.get_output(0).numpy(), ref, rtol=1e-5)
+
+
 def test_plan_2d_memory():
     """Verification if GraphPlanMemory manages 2d memory reffered as
     global.texture* memory scopes in json file."""
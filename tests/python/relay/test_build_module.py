@@ -15,6 +15,7 @@
 # specific language governing permissions and limitations
 # under the License.
 
+import numpy as np
 import pytest
 
 import tvm
@@ -99,5 +100,37 @@ def test_schedule_record():
     check_schedule(graph_executor_factory)
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.parametrize("executor", [Executor("graph"), Executor("aot")])
+def test_peak_memory_report(executor):
+    """Test the compile-time peak memory estimate of a built model"""
+    data = relay.var("data", shape=(1, 64), dtype="float32")
+    weight = relay.var("weight", shape=(256, 64), dtype="float32")
+    out = relay.nn.relu(relay.nn.dense(data, weight))
+    out = relay.nn.softmax(relay.nn.dense(out, relay.var("weight2", shape=(64, 256))))
+    mod = tvm.IRModule.from_expr(relay.Function(relay.analysis.free_vars(out), out))
+    params = {
+        "weight": tvm.nd.array(np.zeros((256, 64), "float32")),
+        "weight2": tvm.nd.array(np.zeros((64, 256), "float32")),
+    }
+
+    with tvm.transform.PassContext(opt_level=3):
+        factory = relay.build(mod, "llvm", executor=executor, params=params)
+
+    report = factory.get_peak_memory_report(overhead_bytes=1024)
+    cpu = tvm.cpu(0)
+    entry = report.devices[cpu.device_type]
+    assert entry.constant_bytes >= 2 * 256 * 64 * 4
+    assert entry.io_bytes == 2 * 64 * 4
+    assert entry.overhead_bytes == 1024
+    assert report.peak_bytes(cpu) == report.peak_bytes()
+    assert report.peak_bytes(cpu) >= entry.constant_bytes + entry.io_bytes + 1024
+    assert report.fits(cpu, report.peak_bytes(cpu))
+    assert not report.fits(cpu, report.peak_bytes(cpu) - 1)
+    assert report.operators
+    assert all(op.live_bytes <= report.peak_bytes(cpu) for op in report.operators)
+    assert report.operators[0].name in report.table()
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -823,6 +823,58 @@ def test_rewrite():
     assert sub_pattern.match(out)
 
 
+def test_rewrite_root_ops():
+    x = relay.var("x")
+    y = relay.var("y")
+    z = relay.var("z")
+
+    class TestRewrite(DFPatternCallback):
+        def __init__(self, pattern):
+            super(TestRewrite, self).__init__()
+            self.pattern = pattern
+
+        def callback(self, pre, post, node_map):
+            return relay.op.tanh(post.args[0])
+
+    # Both operators of an alternative are roots of the pattern.
+    unary = (is_op("nn.relu") | is_op("sigmoid"))(wildcard())
+    out = rewrite(TestRewrite(unary), relay.nn.relu(x) + relay.sigmoid(y))
+    assert tvm.ir.structural_equal(out, relay.op.tanh(x) + relay.op.tanh(y))
+
+    # A multiplication is associated with a division rooted pattern.
+    div = is_op("divide")(is_op("multiply")(wildcard(), wildcard()), wildcard())
+    out = rewrite(TestRewrite(div), x * (y / z))
+    assert isinstance(out, relay.Call) and out.op.name == "tanh"
+
+
+def test_rewrite_rematch_changed():
+    x = relay.var("x")
+    y = relay.var("y")
+
+    class ExpToRelu(DFPatternCallback):
+        def __init__(self):
+            super(ExpToRelu, self).__init__()
+            self.pattern = is_op("exp")(wildcard())
+
+        def callback(self, pre, post, node_map):
+            return relay.nn.relu(post.args[0])
+
+    class AddReluToMultiply(DFPatternCallback):
+        def __init__(self):
+            super(AddReluToMultiply, self).__init__()
+            self.pattern = is_op("add")(wildcard(), is_op("nn.relu")(wildcard()))
+
+        def callback(self, pre, post, node_map):
+            return post.args[0] * post.args[1]
+
+    # The add only matches after its input is rewritten by the next callback, while the
+    # unchanged sigmoid branch is not matched again.
+    expr = relay.sigmoid(x) + relay.sigmoid(x + relay.exp(y))
+    out = rewrite([AddReluToMultiply(), ExpToRelu()], expr)
+    expected = relay.sigmoid(x) + relay.sigmoid(x * relay.nn.relu(y))
+    assert tvm.ir.structural_equal(out, expected)
+
+
 def test_rewrite_func():
     x = relay.var("x")
     w = relay.var("w")
@@ -1028,5 +1028,37 @@ def test_init_module_and_metatable():
     roundtrip(mod)
 
 
+def test_parse_fast():
+    funcs = "".join(
+        """
+        def @f%d(%%x: Tensor[(2, 3), float32]) -> Tensor[(2, 3), float32] {
+          %%0 = negative(%%x); // a comment
+          add(%%0, %d.0f)
+        }
+        """
+        % (i, i)
+        for i in range(8)
+    )
+    text = (
+        SEMVER
+        + funcs
+        + """
+        def @main(%x: Tensor[(2, 3), float32]) -> Tensor[(2, 3), float32] {
+          @f0(@f7(%x))
+        }
+        """
+    )
+    expected = tvm.relay.parse(text)
+    for num_threads in [1, 4]:
+        mod = tvm.relay.parse(text, track_spans=False, num_threads=num_threads)
+        tvm.ir.assert_structural_equal(mod, expected)
+        assert not mod["main"].span
+        mod = tvm.relay.parse(text, num_threads=num_threads)
+        assert mod["f7"].span.line == expected["f7"].span.line
+
+    with pytest.raises(tvm.error.DiagnosticError):
+        tvm.relay.parse(text.replace("negative(%x)", "negative(%y)", 1), num_threads=4)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
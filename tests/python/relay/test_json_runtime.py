@@ -713,6 +713,56 @@ def test_partial_constant():
     check_result(mod, ref_mod, {"in_2": data2, "in_4": data4}, (10, 10), tol=1e-5)
 
 
+
+def test_replicas_share_constants():
+    """Test that replicas of a model loaded several times run independently on shared state."""
+    if not tvm.get_global_func("runtime.DNNLJSONRuntimeCreate", True):
+        print("skip because DNNL codegen is not available")
+        return
+    if sys.platform == "win32":
+        print("Skip test on Windows for now")
+        return
+
+    dtype = "float32"
+    ishape = (1, 8, 14, 14)
+    wshape = (8, 8, 3, 3)
+    data = relay.var("data", shape=ishape, dtype=dtype)
+    weight = relay.const(np.random.uniform(-1, 1, wshape).astype(dtype))
+    out = relay.nn.relu(relay.nn.conv2d(data, weight, kernel_size=(3, 3), padding=(1, 1)))
+    ref_mod = tvm.IRModule.from_expr(relay.Function([data], out))
+    ref_mod = relay.transform.InferType()(ref_mod)
+    mod = tvm.transform.Sequential(
+        [
+            transform.MergeComposite(get_pattern_table("dnnl")),
+            transform.AnnotateTarget("dnnl"),
+            transform.PartitionGraph(),
+        ]
+    )(ref_mod)
+
+    te_compiler.get().clear()
+    with tvm.transform.PassContext(opt_level=3):
+        ref_lib = relay.build(ref_mod, target="llvm")
+        lib = relay.build(mod, target="llvm")
+    tmp_path = utils.tempdir()
+    lib_path = tmp_path.relpath("lib.so")
+    lib.export_library(lib_path)
+
+    replicas = [
+        tvm.contrib.graph_executor.GraphModule(runtime.load_module(lib_path)["default"](tvm.cpu()))
+        for _ in range(2)
+    ]
+    ref = tvm.contrib.graph_executor.GraphModule(ref_lib["default"](tvm.cpu()))
+    inputs = [np.random.uniform(0, 1, ishape).astype(dtype) for _ in replicas]
+    for replica, i_data in zip(replicas, inputs):
+        replica.set_input("data", i_data)
+        replica.run()
+    for replica, i_data in zip(replicas, inputs):
+        ref.set_input("data", i_data)
+        ref.run()
+        tvm.testing.assert_allclose(
+            replica.get_output(0).numpy(), ref.get_output(0).numpy(), rtol=1e-5, atol=1e-5
+        )
+
 if __name__ == "__main__":
     test_conv2d()
     test_add()
@@ -724,3 +774,4 @@ if __name__ == "__main__":
     test_composite()
     test_constant()
     test_partial_constant()
+    test_replicas_share_constants()
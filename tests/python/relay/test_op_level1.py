@@ -760,6 +760,33 @@ def test_bitserial_dense():
     assert yy.checked_type == relay.TensorType((m, 32), "int16")
 
 
+@tvm.testing.uses_gpu
+@pytest.mark.parametrize("bits", [4, 8])
+def test_dense_weight_only(bits):
+    m, k, n, group_size = 4, 256, 48, 64
+    qmax = (1 << (bits - 1)) - 1
+    a_np = np.random.uniform(-1, 1, size=(m, k)).astype("float32")
+    w_np = np.random.randint(-qmax - 1, qmax + 1, size=(n, k)).astype("int8")
+    s_np = np.random.uniform(0.01, 0.1, size=(n, k // group_size)).astype("float32")
+    ref = np.dot(a_np, (w_np * np.repeat(s_np, group_size, axis=1)).transpose())
+
+    w = relay.var("w", relay.TensorType((n, k), "int8"))
+    packed = relay.nn.dense_weight_only_pack(w, bits=bits)
+    assert run_infer_type(packed).checked_type == relay.TensorType((n, k * bits // 32), "uint32")
+
+    a = relay.var("a", relay.TensorType((m, k), "float32"))
+    s = relay.var("s", relay.TensorType((n, k // group_size), "float32"))
+    y = relay.nn.dense_weight_only(a, packed, s, bits=bits, group_size=group_size)
+    assert run_infer_type(y).checked_type == relay.TensorType((m, n), "float32")
+
+    func = relay.Function([a, w, s], y)
+    for target, dev in tvm.testing.enabled_targets():
+        op_res = relay.create_executor("graph", device=dev, target=target).evaluate(func)(
+            a_np, w_np, s_np
+        )
+        tvm.testing.assert_allclose(op_res.numpy(), ref, rtol=1e-4, atol=1e-4)
+
+
 def dense_x86_test(m, n, k, target="llvm -mcpu=cascadelake", intrins=["vpdpbusd"]):
     data_shape = (m, k)
     weight_shape = (n, k)
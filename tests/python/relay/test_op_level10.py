@@ -817,6 +817,34 @@ def test_matrix_set_diag(executor_kind):
     _verify((2, 3, 4), (2, 4, 3), "int32", (-1, 2), "RIGHT_RIGHT")
 
 
+@tvm.testing.parametrize_targets("llvm", "cuda")
+def test_fused_attention(executor_kind, dev, target):
+    b, h, m, n = te.size_var("b"), te.size_var("h"), te.size_var("m"), te.size_var("n")
+    q = relay.var("q", relay.TensorType((b, h, m, 32), "float32"))
+    k = relay.var("k", relay.TensorType((b, h, n, 32), "float32"))
+    v = relay.var("v", relay.TensorType((b, h, n, 16), "float32"))
+    zz = run_infer_type(relay.nn.fused_attention(q, k, v))
+    assert zz.checked_type == relay.TensorType((b, h, m, 16), "float32")
+
+    def _verify(q_shape, k_shape, v_shape, scale=None, causal=False, dtype="float32"):
+        q = relay.var("q", relay.TensorType(q_shape, dtype))
+        k = relay.var("k", relay.TensorType(k_shape, dtype))
+        v = relay.var("v", relay.TensorType(v_shape, dtype))
+        func = relay.Function([q, k, v], relay.nn.fused_attention(q, k, v, scale, causal))
+        q_np = np.random.uniform(-1, 1, size=q_shape).astype(dtype)
+        k_np = np.random.uniform(-1, 1, size=k_shape).astype(dtype)
+        v_np = np.random.uniform(-1, 1, size=v_shape).astype(dtype)
+        ref = tvm.topi.testing.fused_attention_python(q_np, k_np, v_np, scale, causal)
+        out = relay.create_executor(executor_kind, device=dev, target=target).evaluate(func)(
+            q_np, k_np, v_np
+        )
+        tvm.testing.assert_allclose(out.numpy(), ref, rtol=1e-5, atol=1e-5)
+
+    _verify((1, 2, 16, 32), (1, 2, 16, 32), (1, 2, 16, 32))
+    _verify((2, 4, 8, 16), (2, 4, 24, 16), (2, 4, 24, 8), causal=True)
+    _verify((1, 1, 4, 8), (1, 1, 4, 8), (1, 1, 4, 8), scale=0.5)
+
+
 @tvm.testing.parametrize_targets
 def test_nll_loss(executor_kind, dev, target):
     def _get_oshape(target_shape, reduction):
@@ -0,0 +1,93 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.relay import transform
+from tvm.relay.testing import check_grad
+
+
+def annotate(func, memory_budget_bytes=0):
+    mod = tvm.IRModule.from_expr(func)
+    mod = transform.AnnotateCheckpoints(memory_budget_bytes)(mod)
+    return relay.transform.InferType()(mod)["main"]
+
+
+def count_checkpoints(func):
+    checkpoint_op = relay.op.get("annotation.checkpoint")
+    count = [0]
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and expr.op == checkpoint_op:
+            count[0] += 1
+
+    relay.analysis.post_order_visit(func.body, visit)
+    return count[0]
+
+
+def chain(length):
+    x = relay.var("x", shape=(4,), dtype="float32")
+    y = x
+    for _ in range(length):
+        y = relay.sigmoid(y)
+    return relay.Function([x], y)
+
+
+def test_chain_sqrt_segments():
+    # 16 values of 16 bytes are split in 4 segments of 64 bytes.
+    assert count_checkpoints(annotate(chain(16))) == 3
+
+
+def test_chain_memory_budget():
+    assert count_checkpoints(annotate(chain(16), memory_budget_bytes=32)) == 7
+    assert count_checkpoints(annotate(chain(16), memory_budget_bytes=1024)) == 0
+
+
+def test_residual_segments_are_closed():
+    x = relay.var("x", shape=(4,), dtype="float32")
+    y = x
+    for _ in range(4):
+        z = relay.sigmoid(relay.sigmoid(y))
+        y = relay.add(y, z)
+    for memory_budget_bytes in [16, 32, 48, 64]:
+        func = annotate(relay.Function([x], y), memory_budget_bytes)
+        assert count_checkpoints(func) > 0
+        # The values of a segment are only used through its checkpoint.
+        assert relay.analysis.well_formed(func)
+        assert len(relay.analysis.free_vars(func)) == 0
+
+
+def test_non_dataflow_unchanged():
+    x = relay.var("x", shape=(4,), dtype="float32")
+    y = relay.var("y")
+    func = relay.Function([x], relay.Let(y, relay.sigmoid(x), relay.sigmoid(relay.sigmoid(y))))
+    assert count_checkpoints(annotate(func, memory_budget_bytes=1)) == 0
+
+
+def test_gradient_of_checkpoints():
+    x = relay.var("x", shape=(4,), dtype="float32")
+    w = relay.var("w", shape=(4,), dtype="float32")
+    y = x
+    for _ in range(8):
+        y = relay.tanh(relay.multiply(y, w))
+    func = annotate(relay.Function([x, w], y))
+    assert count_checkpoints(func) > 0
+    check_grad(func)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
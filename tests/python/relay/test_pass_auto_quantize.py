@@ -173,6 +173,49 @@ def test_calibrate_percentile():
         relay.quantize.quantize(mod, params, dataset)
 
 
+def test_calibrate_parallel():
+    mod, params = testing.synthetic.get_workload()
+    dataset = get_calibration_dataset(mod, "data")
+    results = []
+    for num_workers in [1, 4]:
+        with relay.quantize.qconfig(
+            calibrate_mode="kl_divergence", calibrate_num_workers=num_workers
+        ):
+            results.append(relay.quantize.quantize(mod, params, dataset))
+    tvm.ir.assert_structural_equal(results[0], results[1])
+
+
+def test_weight_per_channel():
+    data = relay.var("data", shape=(1, 16, 8, 8))
+    channel_range = np.logspace(-3, 0, 8).reshape(8, 1, 1, 1)
+    weight_np = (np.random.uniform(-1, 1, size=(8, 16, 3, 3)) * channel_range).astype("float32")
+    out = relay.nn.conv2d(
+        data, relay.const(weight_np), kernel_size=(3, 3), padding=(1, 1), channels=8
+    )
+    mod = tvm.IRModule.from_expr(relay.Function([data], out))
+    data_np = np.random.uniform(-1, 1, size=(1, 16, 8, 8)).astype("float32")
+    expected = relay.create_executor("graph", mod=mod).evaluate()(data_np).numpy()
+
+    with relay.quantize.qconfig(
+        skip_conv_layers=[], global_scale=16.0, weight_scale="max", weight_per_channel=True
+    ):
+        qmod = relay.quantize.quantize(mod)
+
+    # every output channel of the weight uses the full int8 range
+    weights = []
+
+    def visit(expr):
+        if isinstance(expr, relay.Call) and expr.op.name == "nn.conv2d":
+            weights.append(expr.args[1].data.numpy())
+
+    relay.analysis.post_order_visit(qmod["main"], visit)
+    assert len(weights) == 1 and weights[0].dtype == "int8"
+    assert np.all(np.abs(weights[0]).max(axis=(1, 2, 3)) >= 126)
+
+    result = relay.create_executor("graph", mod=qmod).evaluate()(data_np).numpy()
+    np.testing.assert_allclose(result, expected, atol=0.1 * np.abs(expected).max())
+
+
 ####################################
 # Quant/Dequant Partitioning Tests #
 ####################################
@@ -448,6 +491,8 @@ if __name__ == "__main__":
     test_calibrate_target(True)
     test_calibrate_memory_bound()
     test_calibrate_percentile()
+    test_calibrate_parallel()
+    test_weight_per_channel()
 
     test_add_partition()
     test_conv2d_partition()
@@ -56,11 +56,18 @@ def _mock_get_pattern_table(target):
 
 
 def run_collage(
-    input_mod, targets, cost_estimator, expected_mod, tvm_max_depth=8, byoc_max_depth=8
+    input_mod,
+    targets,
+    cost_estimator,
+    expected_mod,
+    tvm_max_depth=8,
+    byoc_max_depth=8,
+    extra_config=None,
 ):
     ctxt = {
         "relay.collage.tvm_max_depth": tvm_max_depth,
         "relay.collage.byoc_max_depth": byoc_max_depth,
+        **(extra_config or {}),
     }
     expected_mod = InferType()(expected_mod)
     pass_ctxt = tvm.transform.PassContext(config=ctxt)
@@ -152,6 +159,44 @@ def test_partition_single_op_byoc(mock_get_pattern_table):
     run_collage(mod, targets, cost_estimator, expected_mod)
 
 
+@patch("tvm.relay.op.contrib.get_pattern_table", wraps=_mock_get_pattern_table)
+def test_cost_cache_path(mock_get_pattern_table, tmp_path):
+    mod_txt = """
+      #[version = "0.0.5"]
+      def @main(%x: Tensor[(10, 10), float32]) {
+        nn.relu(%x)
+      }
+    """
+    mod = tvm.relay.fromtext(mod_txt)
+
+    expected_txt = """
+      #[version = "0.0.5"]
+      def @collage_example_target_hook_nn_relu(%FunctionVar_0: Tensor[(10, 10), float32], Primitive=1, Compiler="example_target_hook", global_symbol="collage_example_target_hook_nn_relu") -> Tensor[(10, 10), float32] {
+        %0 = fn (%FunctionVar_01: Tensor[(10, 10), float32], Composite="relu") -> Tensor[(10, 10), float32] {
+          nn.relu(%FunctionVar_01)
+        };
+        %0(%FunctionVar_0)
+      }
+
+      def @main(%x: Tensor[(10, 10), float32]) -> Tensor[(10, 10), float32] {
+        @collage_example_target_hook_nn_relu(%x)
+      }
+    """
+    expected_mod = tvm.relay.fromtext(expected_txt)
+
+    targets = [
+        tvm.target.Target("llvm"),
+        tvm.target.Target("example_target_hook"),
+    ]
+    extra_config = {"relay.collage.cost_cache_path": str(tmp_path / "collage_costs.tsv")}
+    # The first run estimates the candidates and saves their costs.
+    cost_estimator = MockCostEstimator({"llvm": 2, "example_target_hook": 1})
+    run_collage(mod, targets, cost_estimator, expected_mod, extra_config=extra_config)
+    # The second run reuses the saved costs, so the different estimates have no effect.
+    cost_estimator = MockCostEstimator({"llvm": 1, "example_target_hook": 2})
+    run_collage(mod, targets, cost_estimator, expected_mod, extra_config=extra_config)
+
+
 @pytest.mark.parametrize("byoc_max_depth", [1, 3])
 @patch("tvm.relay.op.contrib.get_pattern_table", wraps=_mock_get_pattern_table)
 def test_partition_diamond_valid_topology(mock_get_pattern_table, byoc_max_depth):
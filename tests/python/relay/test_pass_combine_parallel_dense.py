@@ -70,7 +70,7 @@ def test_combine_parallel_dense():
         x = relay.var("x", shape=(i, k))
         w1 = relay.var("w1", shape=(j, k))
         w2 = relay.var("w2", shape=(j, k))
-        w3 = relay.var("w3", shape=(j + 1, k))
+        w3 = relay.var("w3", shape=(2 * j + 1, k))
         w4 = relay.var("w4", shape=(j, k))
 
         y_before = before(x, w1, w2, w3, w4)
@@ -137,6 +137,50 @@ def test_combine_parallel_dense_biasadd():
     check(100, 200, 300, True)
 
 
+def test_combine_parallel_dense_padded_biasadd():
+    """Testcase of combining dense + 1d biasadd with different units"""
+
+    def before(x, w1, w2, b1, b2):
+        args = [x, w1, w2, b1, b2]
+        y1 = relay.add(relay.nn.dense(x, w1), b1)
+        y2 = relay.add(relay.nn.dense(x, w2), b2)
+        y = relay.Tuple((y1, y2))
+        return relay.Function(args, y)
+
+    def expected(x, w1, w2, b1, b2, pad):
+        args = [x, w1, w2, b1, b2]
+        zero = relay.const(0.0)
+        x_stacked = relay.stack((x, x), axis=0)
+        w2 = relay.nn.pad(w2, ((0, pad), (0, 0)), pad_value=zero)
+        w = relay.stack((w1, w2), axis=0)
+        y = relay.nn.batch_matmul(x_stacked, w)
+        b1 = relay.expand_dims(b1, 0)
+        b2 = relay.nn.pad(relay.expand_dims(b2, 0), ((0, 0), (0, pad)), pad_value=zero)
+        y = relay.add(y, relay.stack((b1, b2), axis=0))
+        (y1, y2) = relay.split(y, 2)
+        y1 = relay.squeeze(y1, [0])
+        y2 = relay.squeeze(y2, [0])
+        y2 = relay.strided_slice(y2, [0, 0], [-1, 6 - pad], [1, 1], slice_mode="size")
+        y = relay.Tuple((y1, y2))
+        return relay.Function(args, y)
+
+    def check(i, k, pad):
+        x = relay.var("x", shape=(i, k))
+        w1 = relay.var("w1", shape=(6, k))
+        w2 = relay.var("w2", shape=(6 - pad, k))
+        b1 = relay.var("b1", shape=(6,))
+        b2 = relay.var("b2", shape=(6 - pad,))
+
+        y_before = before(x, w1, w2, b1, b2)
+        y = run_opt_pass(y_before, transform.CombineParallelDense(min_num_branches=2))
+        y_expected = expected(x, w1, w2, b1, b2, pad)
+        y_expected = run_opt_pass(y_expected, transform.InferType())
+        tvm.ir.assert_structural_equal(y, y_expected, map_free_vars=True)
+
+    check(3, 4, 2)
+    check(100, 300, 3)
+
+
 def test_combine_parallel_dense_biasadd_scale_reshape():
     """Testcase of combining dense + 1d biasadd + multiply with non-fused reshape"""
 
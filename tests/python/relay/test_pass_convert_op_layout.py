@@ -2834,5 +2834,44 @@ def test_conv_l2n_convert_layout():
     assert tvm.ir.structural_equal(a, b), "Actual = \n" + str(a) + "\n\n Expected = \n" + str(b)
 
 
+def test_convert_layout_auto():
+    def before():
+        x = relay.var("x", shape=(1, 64, 56, 56))
+        weight1 = relay.var("weight1", shape=(64, 64, 3, 3))
+        weight2 = relay.var("weight2", shape=(64, 64, 3, 3))
+        y = relay.nn.conv2d(x, weight1, channels=64, kernel_size=(3, 3), padding=(1, 1))
+        y = relay.nn.relu(y)
+        y = relay.nn.conv2d(y, weight2, channels=64, kernel_size=(3, 3), padding=(1, 1))
+        return relay.Function(analysis.free_vars(y), y)
+
+    def data_layouts(func):
+        layouts = []
+        relay.analysis.post_order_visit(
+            func,
+            lambda e: layouts.append(e.attrs.data_layout)
+            if isinstance(e, relay.Call) and e.op.name == "nn.conv2d"
+            else None,
+        )
+        return layouts
+
+    candidates = {"nn.conv2d": [["NCHW", "default"], ["NHWC", "default"]]}
+
+    def kernel_cost(nhwc_saving):
+        return lambda call, layouts: 1e-3 - (nhwc_saving if layouts[0] == "NHWC" else 0.0)
+
+    # A large saving is worth the layout transforms at the boundary.
+    a = run_opt_pass(before(), transform.ConvertLayoutAuto(candidates, kernel_cost(1e-4)))
+    assert data_layouts(a) == ["NHWC", "NHWC"]
+
+    # A tiny saving is not.
+    a = run_opt_pass(before(), transform.ConvertLayoutAuto(candidates, kernel_cost(1e-9)))
+    assert data_layouts(a) == ["NCHW", "NCHW"]
+
+    # Unsupported candidates are never selected.
+    unsupported = lambda call, layouts: -1.0 if layouts[0] == "NHWC" else 1.0
+    a = run_opt_pass(before(), transform.ConvertLayoutAuto(candidates, unsupported))
+    assert data_layouts(a) == ["NCHW", "NCHW"]
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -76,8 +76,31 @@ def test_softmax():
     assert "nn.fast_softmax" in fast_mod[0].astext()
 
 
+def test_deep_graph():
+    # The rewrite does not recurse, so a graph deeper than the native stack is fine.
+    depth = 10000
+    x = relay.var("x", shape=(4,), dtype="float32")
+    y = x
+    for i in range(depth):
+        y = relay.exp(y) if i % 2 == 0 else relay.Let(relay.var("v%d" % i), y, relay.tanh(y))
+    mod = tvm.IRModule.from_expr(relay.Function([x], y))
+
+    fast_mod = FastMath()(mod)
+    expr = fast_mod["main"].body
+    num_calls = 0
+    while not isinstance(expr, relay.Var):
+        if isinstance(expr, relay.Let):
+            expr = expr.body
+        else:
+            assert expr.op.name in ["fast_exp", "fast_tanh"]
+            num_calls += 1
+            expr = expr.args[0]
+    assert num_calls == depth
+
+
 if __name__ == "__main__":
     test_exp()
     test_tanh()
     test_erf()
     test_softmax()
+    test_deep_graph()
@@ -572,5 +572,39 @@ def test_pass_link_params():
     mod = tvm.relay.transform.FoldConstant()(mod)
 
 
+def test_fold_constant_subgraphs():
+    """The constant subgraphs are evaluated together, and shared ones are folded once"""
+    x = relay.var("x", shape=(4, 8), dtype="float32")
+    weights = [np.random.uniform(size=(8, 4)).astype("float32") for _ in range(8)]
+
+    def before():
+        out = x
+        for i, w in enumerate(weights):
+            # A chain of ops on each weight
+            c = relay.transpose(relay.const(w))
+            c = relay.multiply(c, relay.const(float(i + 1)))
+            out = relay.add(out, relay.nn.relu(c))
+        # A constant subgraph with two consumers, one of which is foldable
+        shared = relay.negative(relay.const(weights[0].T))
+        out = relay.add(out, relay.add(shared, relay.const(1.0)))
+        out = relay.subtract(out, shared)
+        return relay.Function([x], out)
+
+    def expected():
+        out = x
+        for i, w in enumerate(weights):
+            out = relay.add(out, relay.const(np.maximum(w.T * (i + 1), 0)))
+        shared = -weights[0].T
+        out = relay.add(out, relay.const(shared + 1))
+        out = relay.subtract(out, relay.const(shared))
+        return relay.Function([x], out)
+
+    zexpected = run_opt_pass(expected(), transform.InferType())
+    # Folding again hits the values cached by the first run
+    for _ in range(2):
+        zz = run_opt_pass(before(), transform.FoldConstant())
+        tvm.ir.assert_structural_equal(zz, zexpected, map_free_vars=True)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -828,5 +828,34 @@ def test_fuse_softmax():
         tvm.testing.assert_allclose(result, ref, rtol=1e-4, atol=1e-4)
 
 
+def test_fuse_cost_guided():
+    """Test the cost-guided fusion of reductions with their consumers."""
+
+    def before():
+        x = relay.var("x", shape=(32, 1024))
+        mean = relay.mean(x, axis=1, keepdims=True)
+        diff = relay.subtract(x, mean)
+        var = relay.mean(relay.multiply(diff, diff), axis=1, keepdims=True)
+        out = relay.divide(diff, relay.sqrt(relay.add(var, relay.const(1e-5))))
+        return relay.Function([x], out)
+
+    def num_primitive_functions(func):
+        funcs = []
+
+        def visit(node):
+            if isinstance(node, relay.Function) and node.attrs and "Primitive" in node.attrs:
+                funcs.append(node)
+
+        relay.analysis.post_order_visit(func, visit)
+        return len(funcs)
+
+    default = run_opt_pass(before(), transform.FuseOps(fuse_opt_level=2))
+    with tvm.transform.PassContext(config={"relay.FuseOps.cost_guided": True}):
+        cost_guided = run_opt_pass(before(), transform.FuseOps(fuse_opt_level=2))
+    assert num_primitive_functions(default) > 1
+    assert num_primitive_functions(cost_guided) < num_primitive_functions(default)
+    assert tvm.ir.structural_equal(default.checked_type, cost_guided.checked_type)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
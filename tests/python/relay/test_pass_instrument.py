@@ -16,11 +16,13 @@
 # under the License.
 """ Instrument test cases.
 """
+import json
+
 import pytest
 import tvm
 import tvm.relay
 from tvm.relay import op
-from tvm.ir.instrument import PassTimingInstrument, pass_instrument
+from tvm.ir.instrument import PassProfilingInstrument, PassTimingInstrument, pass_instrument
 
 
 def get_test_model():
@@ -59,6 +61,35 @@ def test_pass_timing_instrument():
     assert profiles == ""
 
 
+def test_pass_profiling_instrument():
+    profiler = PassProfilingInstrument()
+    seq = tvm.transform.Sequential(
+        [tvm.relay.transform.InferType(), tvm.relay.transform.FoldConstant()], name="Seq"
+    )
+    with tvm.transform.PassContext(opt_level=3, instruments=[profiler]):
+        mod = seq(get_test_model())
+
+    # The passes of the Sequential are nested under it
+    report = profiler.render().splitlines()
+    assert report[0].startswith("Seq: ")
+    assert any(line.startswith("\tInferType: ") for line in report)
+    assert any(line.startswith("\tFoldConstant: ") for line in report)
+    assert "nodes" in report[0] and "allocs" in report[0]
+
+    events = json.loads(profiler.chrome_trace())["traceEvents"]
+    seq_event = [e for e in events if e["name"] == "Seq"][0]
+    for event in events:
+        assert event["ph"] == "X"
+        assert event["args"]["nodes_before"] > 0 and event["args"]["nodes_after"] > 0
+        assert seq_event["ts"] <= event["ts"]
+        assert event["ts"] + event["dur"] <= seq_event["ts"] + seq_event["dur"] + 1
+
+    # The records are kept until entering another context
+    with tvm.transform.PassContext(instruments=[profiler]):
+        pass
+    assert profiler.render() == ""
+
+
 instrument_definition_type = tvm.testing.parameter("decorator", "subclass")
 
 
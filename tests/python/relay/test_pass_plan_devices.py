@@ -1877,5 +1877,55 @@ def test_conflicated_inputs():
     exercise(input(), expected(), ref, rands((5, 7), 3))
 
 
+def test_auto_placement():
+    # The convolution is much faster on the GPU, but argwhere stays on the CPU
+    def input():
+        return tvm.relay.parse(
+            """
+            #[version = "0.0.5"]
+            def @main(%data: Tensor[(1, 64, 56, 56), float32], %weight: Tensor[(64, 64, 3, 3), float32]) {
+              %0 = nn.conv2d(%data, %weight, padding=[1, 1, 1, 1], channels=64, kernel_size=[3, 3]);
+              %1 = nn.relu(%0);
+              argwhere(%1)
+            }
+        """,
+            "from_string",
+        )
+
+    def device_copies(mod):
+        copies = []
+
+        def visit(expr):
+            if isinstance(expr, relay.Call) and expr.op == relay.op.get("device_copy"):
+                body = expr.args[0]
+                while isinstance(body, relay.Call) and body.op == relay.op.get("on_device"):
+                    body = body.args[0]
+                copies.append(
+                    (
+                        body.op.name,
+                        expr.attrs.src_virtual_device.device_type_int,
+                        expr.attrs.dst_virtual_device.device_type_int,
+                    )
+                )
+
+        relay.analysis.post_order_visit(mod["main"], visit)
+        return copies
+
+    config = tvm.target.make_compilation_config(CTXT, TARGETS)
+    with tvm.transform.PassContext(
+        config={
+            "relay.fallback_device_type": DEFAULT.device_type_int,
+            "relay.PlanDevices.auto_placement": True,
+        }
+    ):
+        actual_mod = relay.transform.InferType()(input())
+        actual_mod = relay.transform.PlanDevices(config)(actual_mod)
+    assert device_copies(actual_mod) == [("nn.relu", GPU.device_type_int, CPU.device_type_int)]
+
+    # Without the option everything defaults to the GPU
+    actual_mod = relay.transform.InferType()(input())
+    actual_mod = relay.transform.PlanDevices(config)(actual_mod)
+    assert device_copies(actual_mod) == []
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -16,6 +16,7 @@
 # under the License.
 
 import pytest
+import json
 import os
 import time
 import numpy as np
@@ -25,6 +26,7 @@ from tvm import relay
 from tvm.relay import transform, build_module
 from tvm.relay.testing import run_opt_pass
 from tvm.contrib import graph_executor, pipeline_executor, pipeline_executor_build
+from tvm.contrib import pipeline_partition
 from tvm._ffi import get_global_func
 from tvm.contrib import cc as _cc
 
@@ -265,6 +267,8 @@ def get_manual_conf(mods, target):
     pipe_config1 = {
         "mod_idx": 0,
         "cpu_affinity": "0",
+        "micro_batch": 1,
+        "queue_capacity": 0,
         "output": [
             {"output_idx": 0, "dependencies": [{"mod_idx": 1, "input_name": "data_n_0"}]},
             {"output_idx": 1, "dependencies": [{"mod_idx": 2, "input_name": "data_n_2"}]},
@@ -284,6 +288,8 @@ def get_manual_conf(mods, target):
     pipe_config2 = {
         "mod_idx": 1,
         "cpu_affinity": "0",
+        "micro_batch": 1,
+        "queue_capacity": 0,
         "output": [
             {"output_idx": 0, "dependencies": [{"mod_idx": 2, "input_name": "data_n_1"}]},
         ],
@@ -302,6 +308,8 @@ def get_manual_conf(mods, target):
     pipe_config3 = {
         "mod_idx": 2,
         "cpu_affinity": "0",
+        "micro_batch": 1,
+        "queue_capacity": 0,
         "output": [{"output_idx": 0, "dependencies": [{"global_output_index": 0}]}],
     }
     mod_config[mods[2]] = {
@@ -603,6 +611,7 @@ def test_pipeline():
                 # Running the pipeline executor in the pipeline mode.
                 pipeline_module_test.run()
 
+            pipeline_outputs = []
             for k in range(0, len(datas)):
                 statistic_time = 0
                 outputs = pipeline_module_test.get_output()
@@ -618,10 +627,151 @@ def test_pipeline():
                     assert not (normal_output[i] == wrong_output[i]).all()
 
                     assert pipeline_module_test.num_executing_pipeline == round + 1
+                pipeline_outputs.append(outputs)
+
+            # The outputs are handed over without copying, later runs do not overwrite them.
+            for k, outputs in enumerate(pipeline_outputs):
+                for i in range(len(outputs)):
+                    tvm.testing.assert_allclose(normal_outputs[k][i], outputs[i].numpy())
 
             # Reset the cpu affinity after a test.
             reset_cpu_affinity(affinity)
 
 
+def test_pipeline_micro_batch():
+    if not pipeline_executor_build.pipeline_executor_build_enabled():
+        return
+    x = relay.var("x", shape=(1, 4))
+    mod_a = tvm.IRModule.from_expr(relay.Function([x], relay.add(x, relay.const(1.0))))
+    # The second stage coalesces two requests into one run.
+    y = relay.var("y", shape=(2, 4))
+    mod_b = tvm.IRModule.from_expr(relay.Function([y], relay.multiply(y, relay.const(2.0))))
+
+    pipe_config = pipeline_executor_build.PipelineConfig()
+    pipe_config["input"]["data"].connect(pipe_config[mod_a]["input"]["x"])
+    pipe_config[mod_a]["output"][0].connect(pipe_config[mod_b]["input"]["y"])
+    pipe_config[mod_b]["output"][0].connect(pipe_config["output"]["0"])
+    for mod in [mod_a, mod_b]:
+        pipe_config[mod].target = "llvm"
+        pipe_config[mod].dev = tvm.cpu(0)
+    pipe_config[mod_b].micro_batch = 2
+    pipe_config[mod_b].queue_capacity = 4
+    with tvm.transform.PassContext(opt_level=3):
+        pipeline_mod_factory = pipeline_executor_build.build(pipe_config)
+    pipeline_module = pipeline_executor.PipelineModule(pipeline_mod_factory)
+
+    datas = [np.full((1, 4), i).astype("float32") for i in range(6)]
+    for data in datas:
+        pipeline_module.set_input("data", tvm.nd.array(data))
+        pipeline_module.run()
+    for data in datas:
+        outputs = pipeline_module.get_output()
+        assert outputs[0].shape == (1, 4)
+        tvm.testing.assert_allclose(outputs[0].numpy(), (data + 1.0) * 2.0)
+
+    statistics = pipeline_module.get_statistics()
+    assert len(statistics) == 2
+    assert statistics[1]["num_requests"] == len(datas)
+    assert statistics[1]["num_runs"] <= len(datas)
+    assert statistics[1]["input_queues"] == [[0, 0, 4]]
+
+
+def get_chain_mod():
+    x = relay.var("x", shape=(1, 16))
+    w = relay.var("w", shape=(1, 16))
+    # The second input is used at the start and at the end of the chain of 15 operators.
+    out = relay.add(x, w)
+    for i in range(6):
+        out = relay.nn.relu(relay.add(out, relay.const(float(i))))
+    out = relay.multiply(out, relay.exp(w))
+    return tvm.IRModule.from_expr(relay.Function([x, w], out))
+
+
+def run_partition(partition, inputs):
+    with tvm.transform.PassContext(opt_level=3):
+        pipeline_mod_factory = pipeline_executor_build.build(partition.config)
+    pipeline_module = pipeline_executor.PipelineModule(pipeline_mod_factory)
+    for name, data in inputs.items():
+        pipeline_module.set_input(name, tvm.nd.array(data))
+    pipeline_module.run()
+    return pipeline_module.get_output()
+
+
+def test_pipeline_partition_balanced():
+    if not pipeline_executor_build.pipeline_executor_build_enabled():
+        return
+    mod = get_chain_mod()
+    devices = [("llvm", tvm.cpu(0))] * 3
+    # Every operator costs as much, the cuts give every stage a third of them.
+    partition = pipeline_partition.partition(mod, devices, cost_model=lambda expr, device: 1.0)
+    assert len(partition.stages) == 3
+    assert partition.stage_costs == [5.0, 5.0, 5.0]
+    assert partition.bottleneck == 5.0
+
+    inputs = {name: np.random.uniform(size=(1, 16)).astype("float32") for name in ["x", "w"]}
+    outputs = run_partition(partition, inputs)
+    expected = relay.create_executor(kind="graph", mod=mod).evaluate()(**inputs)
+    tvm.testing.assert_allclose(outputs[0].numpy(), expected.numpy(), rtol=1e-5)
+
+
+def test_pipeline_partition_transfer_cost():
+    if not pipeline_executor_build.pipeline_executor_build_enabled():
+        return
+    mod = get_chain_mod()
+    devices = [("llvm", tvm.cpu(0)), ("llvm", tvm.cpu(1))]
+
+    def cost_model(expr, device):
+        return 1.0
+
+    # The copy of a (1, 16) float32 tensor between the devices costs 2 operators, the second
+    # stage takes two of them: the chain and the second input.
+    partition = pipeline_partition.partition(
+        mod, devices, cost_model=cost_model, transfer_bandwidth=64 / 2e-6
+    )
+    assert partition.stage_costs == [10.0, 9.0]
+    assert partition.bottleneck == 10.0
+
+
+def test_pipeline_partition_profiled():
+    if not pipeline_executor_build.pipeline_executor_build_enabled():
+        return
+    mod = get_chain_mod()
+    partition = pipeline_partition.partition(mod, [("llvm", tvm.cpu(0))] * 2, number=1)
+    assert all(cost >= 0 for cost in partition.stage_costs)
+    inputs = {name: np.random.uniform(size=(1, 16)).astype("float32") for name in ["x", "w"]}
+    outputs = run_partition(partition, inputs)
+    expected = relay.create_executor(kind="graph", mod=mod).evaluate()(**inputs)
+    tvm.testing.assert_allclose(outputs[0].numpy(), expected.numpy(), rtol=1e-5)
+
+
+def test_pipeline_profiling():
+    if not pipeline_executor_build.pipeline_executor_build_enabled():
+        return
+    mod = get_chain_mod()
+    partition = pipeline_partition.partition(mod, [("llvm", tvm.cpu(0))] * 2, number=1)
+    with tvm.transform.PassContext(opt_level=3):
+        pipeline_mod_factory = pipeline_executor_build.build(partition.config)
+    pipeline_module = pipeline_executor.PipelineModule(pipeline_mod_factory)
+
+    pipeline_module.start_profiling()
+    num_requests = 4
+    for _ in range(num_requests):
+        for name in ["x", "w"]:
+            pipeline_module.set_input(name, tvm.nd.array(np.ones((1, 16), "float32")))
+        pipeline_module.run()
+    for _ in range(num_requests):
+        pipeline_module.get_output()
+    report = pipeline_module.stop_profiling()
+
+    assert report.configuration["Executor"] == "Pipeline"
+    assert len(report.calls) == 2 * num_requests
+    trace = json.loads(report.chrome_trace())
+    runs = [e for e in trace["traceEvents"] if e["ph"] == "X" and e["name"] != "Total"]
+    assert sorted(set(e["tid"] for e in runs)) == [1, 2]
+    for tid in [1, 2]:
+        starts = [e["ts"] for e in runs if e["tid"] == tid]
+        assert starts == sorted(starts)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -24,6 +24,7 @@ from tvm import topi
 from tvm.relay.backend import te_compiler
 from tvm.relay.testing import run_infer_type
 from tvm.relay.testing.temp_op_attr import TempOpAttr
+from tvm.contrib import graph_executor, utils
 
 
 @autotvm.register_topi_compute("test/conv2d_1")
@@ -284,6 +285,58 @@ def test_compile_propogate_hash():
         assert "hash" in f.attrs.keys()
 
 
+def test_compile_parallel_lowering():
+    data = relay.var("data", shape=(1, 3, 16, 16))
+    out = data
+    for i in range(4):
+        weight = relay.var("weight%d" % i, shape=(3, 3, 3, 3))
+        out = relay.nn.relu(relay.nn.conv2d(out, weight, padding=(i % 2, i % 2)))
+        out = relay.add(out, relay.const(float(i)))
+    mod = tvm.IRModule.from_expr(relay.Function(relay.analysis.free_vars(out), out))
+
+    def build(num_threads):
+        with tvm.transform.PassContext(
+            opt_level=3, config={"relay.backend.num_lowering_threads": num_threads}
+        ):
+            return relay.build(mod, target="llvm")
+
+    serial = build(1)
+    parallel = build(4)
+    # The names do not depend on the number of threads.
+    assert list(serial.function_metadata.keys()) == list(parallel.function_metadata.keys())
+    assert serial.get_graph_json() == parallel.get_graph_json()
+
+
+def test_compile_disk_cache():
+    data = relay.var("data", shape=(1, 3, 16, 16))
+    weight = relay.var("weight", shape=(8, 3, 3, 3))
+    out = relay.nn.relu(relay.nn.conv2d(data, weight, padding=(1, 1)))
+    out = relay.nn.softmax(relay.add(out, relay.const(1.0)))
+    mod = tvm.IRModule.from_expr(relay.Function(relay.analysis.free_vars(out), out))
+    temp = utils.tempdir()
+
+    def build():
+        with tvm.transform.PassContext(
+            opt_level=3, config={"relay.backend.te_compiler_cache_dir": temp.temp_dir}
+        ):
+            return relay.build(mod, target="llvm")
+
+    def run(lib):
+        module = graph_executor.GraphModule(lib["default"](tvm.cpu()))
+        module.set_input("data", np.ones((1, 3, 16, 16), "float32"))
+        module.set_input("weight", np.full((8, 3, 3, 3), 0.1, "float32"))
+        module.run()
+        return module.get_output(0).numpy()
+
+    lowered = build()
+    assert any(name.endswith(".tvmbin") for name in temp.listdir())
+    loaded = build()
+    # The functions loaded from the disk get the names they were lowered with.
+    assert list(lowered.function_metadata.keys()) == list(loaded.function_metadata.keys())
+    assert lowered.get_graph_json() == loaded.get_graph_json()
+    tvm.testing.assert_allclose(run(lowered), run(loaded))
+
+
 if __name__ == "__main__":
     test_get_valid_implementations()
     test_select_implementation()
@@ -293,3 +346,5 @@ if __name__ == "__main__":
     test_compile_tuple_dup()
     test_compile_full()
     test_compile_nhwc_pack()
+    test_compile_parallel_lowering()
+    test_compile_disk_cache()
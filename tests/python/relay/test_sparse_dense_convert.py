@@ -86,5 +86,32 @@ def test_bsr_sparse_dense():
     np.testing.assert_allclose(sparse_output, dense_output, atol=1e-5, rtol=1e-5)
 
 
+
+def test_bsr_sparse_dense_auto():
+    data = relay.var("data", shape=(1, 128), dtype="float32")
+    x = relay.nn.relu(data)
+    w_sparse = np.asarray(random_bsr_matrix(768, 128, 16, 1, 0.1).todense())
+    w_dense = np.random.randn(64, 768).astype("float32")
+    y = relay.nn.dense(x, relay.const(w_sparse))
+    z = relay.nn.dense(relay.nn.relu(y), relay.const(w_dense))
+    func = relay.Function([data], z)
+
+    mod = tvm.IRModule.from_expr(func)
+    sparse_mod = relay.transform.ToSparseAuto([(16, 1), (4, 1)], 0.5)(mod)
+    ops = []
+    relay.analysis.post_order_visit(
+        sparse_mod["main"],
+        lambda e: ops.append(e.op.name) if isinstance(e, relay.Call) else None,
+    )
+    # The weight without zeros is kept dense.
+    assert ops.count("nn.sparse_dense") == 1 and ops.count("nn.dense") == 1
+
+    x_np = np.random.randn(1, 128).astype("float32")
+    dense_output = run_func(func, {}, x_np)
+    sparse_output = run_func(sparse_mod["main"], {}, x_np)
+    np.testing.assert_allclose(sparse_output, dense_output, atol=1e-4, rtol=1e-4)
+
+
 if __name__ == "__main__":
     test_bsr_sparse_dense()
+    test_bsr_sparse_dense_auto()
@@ -537,5 +537,30 @@ def test_convert_follow_node_with_integer_arguments(target_precision):
     assert tvm.ir.structural_equal(expected_mod, output_mod)
 
 
+
+def test_fp8_dense_scaled():
+    """The dense runs on per-tensor scaled FP8 args, and the relu is kept in FP32."""
+    data = relay.var("data", shape=[4, 32], dtype="float32")
+    weight_np = np.random.uniform(-1, 1, size=[16, 32]).astype("float32")
+    out = relay.nn.relu(relay.nn.dense(data, relay.const(weight_np)))
+    mod = InferType()(tvm.IRModule.from_expr(relay.Function([data], out)))
+
+    dataset = [{"data": np.random.uniform(-4, 4, size=[4, 32]).astype("float32")} for _ in range(4)]
+    fp8_amax = mixed_precision.calibrate_fp8(mod, dataset)
+    assert len(fp8_amax) == 2
+    np.testing.assert_allclose(fp8_amax[1], np.abs(weight_np).max(), rtol=1e-6)
+
+    fp8_mod = ToMixedPrecision("e4m3_float8", fp8_amax=fp8_amax)(mod)
+    fp8_mod = InferType()(fp8_mod)
+    assert "e4m3_float8" in fp8_mod.astext()
+    assert fp8_mod["main"].ret_type.dtype == "float32"
+
+    inputs = dataset[0]
+    result_fp32 = run_module(mod, inputs)[0]
+    result_fp8 = run_module(fp8_mod, inputs)[0]
+    # E4M3 keeps 3 mantissa bits, so compare relative to the magnitude of the output.
+    np.testing.assert_allclose(result_fp8, result_fp32, atol=0.1 * np.abs(result_fp32).max())
+
+
 if __name__ == "__main__":
     tvm.testing.main()
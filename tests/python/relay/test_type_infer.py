@@ -590,5 +590,33 @@ def test_argreduce_infer_return_type():
         )
 
 
+def test_infer_type_incremental():
+    x = relay.var("x", shape=(4,), dtype="float32")
+    mod = tvm.IRModule()
+    callee = relay.GlobalVar("callee")
+    mod[callee] = relay.Function([x], relay.add(x, x))
+    y = relay.var("y", shape=(4,), dtype="float32")
+    mod["main"] = relay.Function([y], relay.Call(callee, [y]))
+    mod["other"] = relay.Function([y], relay.exp(y))
+    mod = transform.InferType()(mod)
+    main, other = mod["main"], mod["other"]
+
+    # Untouched functions keep their typed objects.
+    inferred = transform.InferType()(mod)
+    assert inferred["main"].same_as(main)
+    assert inferred["other"].same_as(other)
+
+    # Changing the callee makes its callers dirty as well.
+    z = relay.var("z", shape=(4,), dtype="float32")
+    inferred[callee] = relay.Function([z], relay.cast(z, "float16"))
+    inferred = transform.InferType()(inferred)
+    assert not inferred["main"].same_as(main)
+    assert inferred["main"].body.checked_type == relay.TensorType((4,), "float16")
+    assert inferred["other"].same_as(other)
+
+    with tvm.transform.PassContext(config={"relay.InferType.incremental": False}):
+        assert not transform.InferType()(inferred)["other"].same_as(other)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
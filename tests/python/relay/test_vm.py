@@ -20,7 +20,7 @@ import time
 from unittest.mock import patch
 
 import tvm
-from tvm import runtime
+from tvm import runtime, te, topi
 from tvm import relay, IRModule
 from tvm.relay.backend import vm
 from tvm.relay.scope_builder import ScopeBuilder
@@ -30,10 +30,12 @@ from tvm.relay import testing
 from tvm.contrib import utils
 from tvm import rpc
 import tvm.testing
+import tvm.topi.testing
 from tvm.relay.transform import InferType
 from tvm.relay.testing import mlp
 from tvm.relay.dataflow_pattern import wildcard, is_op
 from tvm.relay.backend.vm import VMCompiler
+from tvm.topi.utils import get_const_tuple
 
 
 def check_result(target, dev, args, expected_result, mod):
@@ -705,6 +707,21 @@ def test_vm_optimize_dynamic():
     assert "shape_func" in opt_mod.astext(False)
 
 
+def test_vm_shape_upper_bounds():
+    x = relay.var("x", shape=(relay.Any(), 1024), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.nn.relu(relay.add(x, x))))
+    config = {"relay.vm.shape_upper_bounds": [["x", [8, 1024]]]}
+    with tvm.transform.PassContext(opt_level=3, config=config):
+        exe = relay.vm.compile(mod, "llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+
+    x_data = np.random.uniform(-1, 1, size=(5, 1024)).astype("float32")
+    tvm.testing.assert_allclose(vm.invoke("main", x_data).numpy(), np.maximum(2 * x_data, 0))
+    # The storage sized for the upper bound cannot hold a larger result
+    with pytest.raises(tvm.error.TVMError):
+        vm.invoke("main", np.zeros((64, 1024), "float32"))
+
+
 def test_vm_optimize():
     mod, params = testing.synthetic.get_workload()
     comp = relay.vm.VMCompiler()
@@ -1421,6 +1438,65 @@ def test_large_constants():
     tvm.testing.assert_allclose(expected, actual.numpy())
 
 
+def test_large_constants_mapped():
+    """Large constants can be saved in a mappable file and memory-mapped back"""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+
+    x = relay.var("x", shape=(1000, 1000))
+    const_data = np.random.rand(1000, 1000).astype("float32")
+    small_data = np.random.rand(3, 1000).astype("float32")
+    out = relay.op.add(x, relay.const(const_data, dtype="float32"))
+    out = relay.op.concatenate([out, relay.const(small_data, dtype="float32")], axis=0)
+    mod = tvm.IRModule.from_expr(relay.Function([x], out))
+    vm_exec = vm.compile(mod, target=target)
+
+    temp = utils.tempdir()
+    path_consts = temp.relpath("consts")
+    vm_exec.move_late_bound_consts(path_consts, byte_limit=256, mappable=True)
+    path_dso = temp.relpath("lib.so")
+    vm_exec.mod.export_library(path_dso)
+
+    exe = runtime.vm.Executable(runtime.load_module(path_dso))
+    exe.load_late_bound_consts(path_consts)
+
+    x_data = np.random.rand(1000, 1000).astype("float32")
+    the_vm = runtime.vm.VirtualMachine(exe, dev)
+    actual = the_vm.invoke("main", x_data)
+    expected = np.concatenate([x_data + const_data, small_data], axis=0)
+    tvm.testing.assert_allclose(expected, actual.numpy())
+
+    params = tvm.get_global_func("runtime.LoadMappedParamsFromFile")(path_consts)
+    assert len(params) == 2
+
+
+def test_large_constants_lazy():
+    """Large constants can be read lazily, straight onto the device using them"""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+
+    x = relay.var("x", shape=(1000, 1000))
+    const_data = np.random.rand(1000, 1000).astype("float32")
+    out = relay.op.add(x, relay.const(const_data, dtype="float32"))
+    mod = tvm.IRModule.from_expr(relay.Function([x], out))
+    vm_exec = vm.compile(mod, target=target)
+
+    temp = utils.tempdir()
+    path_consts = temp.relpath("consts")
+    vm_exec.move_late_bound_consts(path_consts, byte_limit=256)
+    path_dso = temp.relpath("lib.so")
+    vm_exec.mod.export_library(path_dso)
+
+    exe = runtime.vm.Executable(runtime.load_module(path_dso))
+    exe.load_late_bound_consts(path_consts, lazy=True)
+
+    x_data = np.random.rand(1000, 1000).astype("float32")
+    for _ in range(2):
+        the_vm = runtime.vm.VirtualMachine(exe, dev)
+        actual = the_vm.invoke("main", x_data)
+        tvm.testing.assert_allclose(x_data + const_data, actual.numpy())
+
+
 def test_load_late_bound_consts_with_no_late_bound_consts():
     """Check that load_late_bound_consts handles a model with no late bound consts."""
     target = tvm.target.Target("llvm")
@@ -1563,5 +1639,264 @@ def test_load_late_bound_consts_via_map_with_no_late_bound_consts():
     tvm.testing.assert_allclose(expected, actual.numpy())
 
 
+
+def test_warmup():
+    """Check that a warmed up VM uploads its constants and still runs correctly."""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+
+    const_data = np.random.rand(16).astype("float32")
+    x = relay.var("x", shape=(16,), dtype="float32")
+    func = relay.Function([x], relay.op.exp(relay.op.add(x, relay.const(const_data))))
+    vm_exec = vm.compile(tvm.IRModule.from_expr(func), target=target)
+
+    vm_obj = runtime.vm.VirtualMachine(vm_exec, dev)
+    vm_obj.warmup()
+    x_data = np.random.rand(16).astype("float32")
+    res = vm_obj.invoke("main", tvm.nd.array(x_data, dev))
+    tvm.testing.assert_allclose(res.numpy(), np.exp(x_data + const_data), rtol=1e-5)
+
+
+def test_shared_device_constants():
+    """Check that VMs created from one executable can share preloaded constants."""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+
+    const_data = np.random.rand(16).astype("float32")
+    x = relay.var("x", shape=(16,), dtype="float32")
+    func = relay.Function([x], relay.op.add(x, relay.const(const_data)))
+    mod = tvm.IRModule.from_expr(func)
+    vm_exec = vm.compile(mod, target=target)
+
+    x_data = np.random.rand(16).astype("float32")
+    vms = [runtime.vm.VirtualMachine(vm_exec, dev) for _ in range(2)]
+    vms[0].preload_constants()
+    for vm_ in vms:
+        tvm.testing.assert_allclose(vm_.invoke("main", x_data).numpy(), x_data + const_data)
+
+    vm_exec.release_device_constants()
+    tvm.testing.assert_allclose(vms[1].invoke("main", x_data).numpy(), x_data + const_data)
+
+
+
+def test_shape_specialization():
+    """Check observed kernel shapes and that shape specializations survive serialization."""
+    target = tvm.target.Target("llvm")
+    dev = tvm.cpu()
+
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.op.add(x, x)))
+    vm_exec = vm.compile(mod, target=target)
+
+    x_data = np.random.rand(2, 4).astype("float32")
+    the_vm = runtime.vm.VirtualMachine(vm_exec, dev)
+    the_vm.record_kernel_shapes()
+    for _ in range(3):
+        the_vm.invoke("main", x_data)
+    kernel_shapes = the_vm.get_kernel_shapes()
+    prim_name = [name for name in kernel_shapes if "add" in name][0]
+    shapes, count = kernel_shapes[prim_name][0]
+    assert shapes == [(2, 4), (2, 4)] and count == 3
+
+    # Any kernel with the same calling convention may serve as the specialization, the
+    # generic one is used here since it is readily available in the library.
+    vm_exec.add_shape_specialization(prim_name, shapes, prim_name)
+    code, lib = vm_exec.save()
+    exe = runtime.vm.Executable.load_exec(code, lib)
+    assert exe.shape_specializations == {prim_name: [(shapes, prim_name)]}
+
+    loaded_vm = runtime.vm.VirtualMachine(exe, dev)
+    for data in [x_data, np.random.rand(5, 4).astype("float32")]:
+        tvm.testing.assert_allclose(loaded_vm.invoke("main", data).numpy(), data + data)
+
+
+def test_sampled_profile():
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.op.add(x, x)))
+    vm_exec = vm.compile(mod, target="llvm")
+    the_vm = runtime.vm.VirtualMachine(vm_exec, tvm.cpu())
+    x_data = np.random.rand(2, 4).astype("float32")
+
+    the_vm.set_sampling_interval(2)
+    for _ in range(5):
+        tvm.testing.assert_allclose(the_vm.invoke("main", x_data).numpy(), x_data + x_data)
+    report = the_vm.get_sampled_profile()
+    assert report.configuration["Executor"] == "VM"
+    assert report.configuration["Sampled Requests"].value == 3
+    names = [str(call["Name"]) for call in report.calls]
+    assert any("add" in name for name in names)
+    for call in report.calls:
+        assert call["Count"].value == 3
+        assert call["p50 (us)"].microseconds <= call["p90 (us)"].microseconds
+
+
+def test_kernel_variant_selection():
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.op.add(x, x)))
+    vm_exec = vm.compile(mod, target="llvm")
+    prim_name = [name for name in vm_exec.primitive_ops if "add" in name][0]
+    vm_exec.add_kernel_variant(prim_name, prim_name)
+    the_vm = runtime.vm.VirtualMachine(vm_exec, tvm.cpu())
+    the_vm.set_variant_trials(2)
+
+    # Rows 3 and 4 share a bucket, two trials of both candidates make a choice.
+    for rows in [3, 4, 3, 4, 9]:
+        data = np.random.rand(rows, 4).astype("float32")
+        tvm.testing.assert_allclose(the_vm.invoke("main", data).numpy(), data + data)
+    choices = the_vm.get_variant_choices()
+    assert choices == {prim_name: [([(4, 4), (4, 4)], prim_name)]}
+
+    for shapes, func_name in choices[prim_name]:
+        vm_exec.set_variant_choice(prim_name, shapes, func_name)
+    code, lib = vm_exec.save()
+    exe = runtime.vm.Executable.load_exec(code, lib)
+    assert exe.kernel_variants[prim_name][1] == choices[prim_name]
+    loaded_vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    assert loaded_vm.get_variant_choices() == choices
+
+
+def test_shape_func_memoization():
+    x = relay.var("x", shape=(relay.Any(), 4), dtype="float32")
+    y = relay.var("y", shape=(relay.Any(), 4), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x, y], relay.op.add(x, y) * x))
+    vm_exec = vm.compile(mod, target="llvm")
+    code, lib = vm_exec.save()
+    exe = runtime.vm.Executable.load_exec(code, lib)
+    the_vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    the_vm.set_shape_func_cache_size(2)
+
+    # More shapes than the cache holds, so memoized outputs are also evicted.
+    for rows in [2, 3, 2, 3, 5, 2, 5]:
+        x_data = np.random.rand(rows, 4).astype("float32")
+        y_data = np.random.rand(rows, 4).astype("float32")
+        res = the_vm.invoke("main", x_data, y_data)
+        tvm.testing.assert_allclose(res.numpy(), (x_data + y_data) * x_data)
+    assert the_vm.get_shape_func_cache_hits() > 0
+
+    the_vm.set_shape_func_cache_size(0)
+    the_vm.invoke("main", x_data, y_data)
+    assert the_vm.get_shape_func_cache_hits() == 0
+
+
+@tvm.testing.requires_cuda
+def test_stream_ordered_allocator():
+    x = relay.var("x", shape=(1024,), dtype="float32")
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.exp(x) + x))
+    exe = relay.vm.compile(mod, "cuda")
+    dev = tvm.cuda()
+    vm = runtime.vm.VirtualMachine(exe, dev, memory_cfg="stream_ordered")
+    x_data = np.random.rand(1024).astype("float32")
+    for _ in range(3):
+        res = vm.invoke("main", tvm.nd.array(x_data, dev))
+    tvm.testing.assert_allclose(res.numpy(), np.exp(x_data) + x_data, rtol=1e-5)
+    stats = tvm.get_global_func("runtime.CUDAAllocatorStats")(dev)
+    assert stats["peak_allocated_bytes"].value >= 1024 * 4
+    assert stats["reserved_bytes"].value >= stats["allocated_bytes"].value
+
+
+def test_invoke_async(target, dev):
+    x = relay.var("x", shape=(8, 8))
+    y = relay.var("y", shape=(8, 8))
+    mod = tvm.IRModule.from_expr(relay.Function([x, y], relay.add(x, relay.exp(y))))
+    exe = relay.vm.compile(mod, target)
+    vm = runtime.vm.VirtualMachine(exe, dev)
+
+    inputs = [
+        [np.random.uniform(size=(8, 8)).astype("float32") for _ in range(2)] for _ in range(4)
+    ]
+    futures = [vm.invoke_async("main", x_in, y_in) for x_in, y_in in inputs]
+    for (x_in, y_in), future in zip(inputs, futures):
+        tvm.testing.assert_allclose(future.result().numpy(), x_in + np.exp(y_in), rtol=1e-5)
+
+
+def test_batcher():
+    x = relay.var("x", shape=(relay.Any(), 3))
+    w = relay.const(np.random.uniform(size=(3, 3)).astype("float32"))
+    mod = tvm.IRModule.from_expr(relay.Function([x], relay.Tuple([relay.nn.dense(x, w), x])))
+    exe = relay.vm.compile(mod, "llvm")
+    vm = runtime.vm.VirtualMachine(exe, tvm.cpu())
+    batcher = runtime.vm.Batcher(vm, buckets=[2, 4], max_latency_ms=50.0)
+
+    # Requests of 1 and 2 rows are padded to the buckets and sliced back.
+    inputs = [np.random.uniform(size=(i % 2 + 1, 3)).astype("float32") for i in range(7)]
+    futures = [batcher.submit(x_in) for x_in in inputs]
+    for x_in, future in zip(inputs, futures):
+        dense, identity = future.result()
+        tvm.testing.assert_allclose(dense.numpy(), x_in @ w.data.numpy().T, rtol=1e-5)
+        np.testing.assert_equal(identity.numpy(), x_in)
+
+    with pytest.raises(tvm.TVMError):
+        batcher.submit(np.zeros((5, 3), "float32"))
+    batcher.stop()
+
+
+def test_paged_kv_cache():
+    num_layers, heads, head_dim, page_size = 2, 2, 8, 4
+    cache = runtime.vm.PagedKVCache(
+        num_layers, heads, head_dim, page_size, num_pages=8, dtype="float32"
+    )
+    history = {}
+
+    def forward(seq_ids, lengths):
+        cache.begin_forward(seq_ids, lengths)
+        for layer in range(num_layers):
+            kv = np.random.uniform(size=(2, sum(lengths), heads, head_dim)).astype("float32")
+            cache.append(layer, tvm.nd.array(kv[0]), tvm.nd.array(kv[1]))
+            begin = 0
+            for seq_id, length in zip(seq_ids, lengths):
+                prev = history.get((seq_id, layer), np.zeros((2, 0, heads, head_dim), "float32"))
+                new = kv[:, begin : begin + length]
+                history[(seq_id, layer)] = np.concatenate([prev, new], axis=1)
+                begin += length
+
+    def check(seq_ids):
+        pages = cache.pages.numpy()
+        page_table = cache.page_table.numpy()
+        np.testing.assert_equal(cache.seq_lens.numpy(), [len(history[(i, 0)][0]) for i in seq_ids])
+        for b, seq_id in enumerate(seq_ids):
+            for layer in range(num_layers):
+                expected = history[(seq_id, layer)]
+                stored = pages[layer][:, page_table[b]].reshape(2, -1, heads, head_dim)
+                np.testing.assert_equal(stored[:, : expected.shape[1]], expected)
+
+    cache.add_sequence(0)
+    cache.add_sequence(1)
+    forward([0, 1], [6, 3])
+    check([0, 1])
+    assert cache.num_free_pages == 5
+
+    # The forked sequence shares the pages of its parent until it writes to them.
+    cache.fork_sequence(0, 2)
+    history.update({(2, layer): history[(0, layer)] for layer in range(num_layers)})
+    assert cache.num_free_pages == 5
+    forward([0, 1, 2], [1, 1, 1])
+    check([0, 1, 2])
+    assert cache.get_sequence_length(2) == 7
+    assert cache.num_free_pages == 4
+
+    # Decode with the attention kernel reading through the page table.
+    q = te.placeholder((3, heads, 1, head_dim), name="q")
+    pages = te.placeholder(cache.pages.shape, name="pages")
+    page_table = te.placeholder(cache.page_table.shape, "int32", name="page_table")
+    seq_lens = te.placeholder((3,), "int32", name="seq_lens")
+    out = topi.nn.paged_attention(q, pages, page_table, seq_lens, layer=1)
+    s = topi.generic.schedule_paged_attention([out])
+    f = tvm.build(s, [q, pages, page_table, seq_lens, out], "llvm")
+    q_np = np.random.uniform(size=get_const_tuple(q.shape)).astype("float32")
+    out_tvm = tvm.nd.empty(get_const_tuple(out.shape))
+    f(tvm.nd.array(q_np), cache.pages, cache.page_table, cache.seq_lens, out_tvm)
+    for b, seq_id in enumerate([0, 1, 2]):
+        k_np, v_np = history[(seq_id, 1)].transpose(0, 2, 1, 3)[:, None]
+        out_np = tvm.topi.testing.fused_attention_python(q_np[b : b + 1], k_np, v_np)
+        tvm.testing.assert_allclose(out_tvm.numpy()[b : b + 1], out_np, rtol=1e-5, atol=1e-5)
+
+    cache.remove_sequence(0)
+    cache.remove_sequence(2)
+    assert cache.num_free_pages == 7
+    with pytest.raises(tvm.TVMError):
+        cache.begin_forward([1], [64])
+    assert cache.get_sequence_length(1) == 4
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,118 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+"""Test code for fused_attention and paged_attention."""
+import numpy as np
+import pytest
+import tvm
+from tvm import te
+from tvm import topi
+from tvm.topi.utils import get_const_tuple
+import tvm.topi.testing
+
+import tvm.testing
+
+
+_fused_attention_schedule = {
+    "generic": topi.generic.schedule_fused_attention,
+    "gpu": topi.cuda.schedule_fused_attention,
+}
+
+_paged_attention_schedule = {
+    "generic": topi.generic.schedule_paged_attention,
+    "gpu": topi.cuda.schedule_paged_attention,
+}
+
+
+@tvm.testing.parametrize_targets("llvm", "cuda")
+@pytest.mark.parametrize(
+    "batch,heads,q_len,kv_len,head_dim,value_dim",
+    [(1, 2, 16, 16, 32, 32), (2, 4, 8, 24, 16, 8), (1, 1, 1, 33, 64, 64)],
+)
+@pytest.mark.parametrize("causal", [False, True])
+def test_fused_attention(
+    target, dev, batch, heads, q_len, kv_len, head_dim, value_dim, causal, dtype="float32"
+):
+    q = te.placeholder((batch, heads, q_len, head_dim), dtype=dtype, name="q")
+    k = te.placeholder((batch, heads, kv_len, head_dim), dtype=dtype, name="k")
+    v = te.placeholder((batch, heads, kv_len, value_dim), dtype=dtype, name="v")
+    out = topi.nn.fused_attention(q, k, v, causal=causal)
+    assert get_const_tuple(out.shape) == (batch, heads, q_len, value_dim)
+
+    q_np = np.random.uniform(-1, 1, size=get_const_tuple(q.shape)).astype(dtype)
+    k_np = np.random.uniform(-1, 1, size=get_const_tuple(k.shape)).astype(dtype)
+    v_np = np.random.uniform(-1, 1, size=get_const_tuple(v.shape)).astype(dtype)
+    out_np = tvm.topi.testing.fused_attention_python(q_np, k_np, v_np, causal=causal)
+
+    with tvm.target.Target(target):
+        s_func = tvm.topi.testing.dispatch(target, _fused_attention_schedule)
+        s = s_func([out])
+    f = tvm.build(s, [q, k, v, out], target)
+    out_tvm = tvm.nd.array(np.zeros(get_const_tuple(out.shape), dtype=dtype), dev)
+    f(tvm.nd.array(q_np, dev), tvm.nd.array(k_np, dev), tvm.nd.array(v_np, dev), out_tvm)
+    tvm.testing.assert_allclose(out_tvm.numpy(), out_np, rtol=1e-5, atol=1e-5)
+
+
+@tvm.testing.parametrize_targets("llvm", "cuda")
+@pytest.mark.parametrize("q_len", [1, 3])
+def test_paged_attention(target, dev, q_len, dtype="float32"):
+    num_layers, num_pages, page_size, heads, head_dim = 2, 10, 4, 2, 16
+    seq_lens_np = np.array([9, 3, 12], dtype="int32")
+    batch, max_pages = len(seq_lens_np), 3
+    # Scatter the pages of the sequences over the pool.
+    page_table_np = np.random.permutation(num_pages)[: batch * max_pages].reshape(batch, -1)
+    page_table_np = page_table_np.astype("int32")
+
+    q = te.placeholder((batch, heads, q_len, head_dim), dtype=dtype, name="q")
+    pages = te.placeholder(
+        (num_layers, 2, num_pages, page_size, heads, head_dim), dtype=dtype, name="pages"
+    )
+    page_table = te.placeholder((batch, max_pages), "int32", name="page_table")
+    seq_lens = te.placeholder((batch,), "int32", name="seq_lens")
+    out = topi.nn.paged_attention(q, pages, page_table, seq_lens, layer=1)
+
+    q_np = np.random.uniform(-1, 1, size=get_const_tuple(q.shape)).astype(dtype)
+    pages_np = np.random.uniform(-1, 1, size=get_const_tuple(pages.shape)).astype(dtype)
+
+    with tvm.target.Target(target):
+        s_func = tvm.topi.testing.dispatch(target, _paged_attention_schedule)
+        s = s_func([out])
+    f = tvm.build(s, [q, pages, page_table, seq_lens, out], target)
+    out_tvm = tvm.nd.array(np.zeros(get_const_tuple(out.shape), dtype=dtype), dev)
+    args = [q_np, pages_np, page_table_np, seq_lens_np]
+    f(*[tvm.nd.array(arg, dev) for arg in args], out_tvm)
+
+    for b, seq_len in enumerate(seq_lens_np):
+        # [2, max_pages * page_size, heads, head_dim] -> [2, 1, heads, seq_len, head_dim]
+        kv = pages_np[1][:, page_table_np[b]].reshape(2, -1, heads, head_dim)[:, :seq_len]
+        k_np, v_np = kv.transpose(0, 2, 1, 3)[:, None]
+        out_np = tvm.topi.testing.fused_attention_python(q_np[b : b + 1], k_np, v_np, causal=True)
+        tvm.testing.assert_allclose(out_tvm.numpy()[b : b + 1], out_np, rtol=1e-5, atol=1e-5)
+
+
+def test_fused_attention_prim_func():
+    """Every stage lowers to its own block so meta_schedule can tile it."""
+    q = te.placeholder((1, 2, 16, 32), name="q")
+    k = te.placeholder((1, 2, 16, 32), name="k")
+    v = te.placeholder((1, 2, 16, 32), name="v")
+    out = topi.nn.fused_attention(q, k, v, scale=0.125, causal=True)
+    sch = tvm.tir.Schedule(te.create_prim_func([q, k, v, out]))
+    for stage in ["_scores", "_max", "_sum", "_acc", ""]:
+        sch.get_block("T_fused_attention" + stage)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
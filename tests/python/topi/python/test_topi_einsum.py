@@ -72,10 +72,8 @@ def verify_einsum(subscripts, shapes, shape_dict={}):
         c2 = with_tvm(lambda A: topi.einsum(subscripts, A), symbolic_shapes, ops, out_shape)
     elif len(ops) == 2:
         c2 = with_tvm(lambda A, B: topi.einsum(subscripts, A, B), symbolic_shapes, ops, out_shape)
-    elif len(ops) == 3:
-        c2 = with_tvm(
-            lambda A, B, C: topi.einsum(subscripts, A, B, C), symbolic_shapes, ops, out_shape
-        )
+    else:
+        c2 = with_tvm(lambda *args: topi.einsum(subscripts, *args), symbolic_shapes, ops, out_shape)
 
     tvm.testing.assert_allclose(c1, c2, rtol=1e-5, atol=1e-5)
 
@@ -102,6 +100,25 @@ def test_einsum(equation, inputs):
     verify_einsum(equation, inputs)
 
 
+@pytest.mark.parametrize(
+    "equation,inputs,path",
+    [
+        ("ij,jk->ik", [(2, 3), (3, 4)], []),
+        ("ij,jk,kl->il", [(2, 50), (50, 60), (60, 70)], [(0, 1), (0, 1)]),
+        ("ij,jk,kl->il", [(70, 60), (60, 50), (50, 2)], [(1, 2), (0, 1)]),
+        ("bij,bjk,bkl,blm->bim", [(2, 8, 4), (2, 4, 16), (2, 16, 4), (2, 4, 8)], None),
+        ("ai,bi,ci,di,ei->abcde", [(2, 3), (2, 3), (2, 3), (2, 3), (2, 3)], None),
+        ("...ij,...jk,...kl->...il", [(2, 50), (50, 60), (60, 70)], []),
+    ],
+)
+def test_einsum_path(equation, inputs, path):
+    if path is not None:
+        assert topi.einsum_path(equation, *inputs) == path
+    else:
+        assert len(topi.einsum_path(equation, *inputs)) == len(inputs) - 1
+    verify_einsum(equation, inputs)
+
+
 @pytest.mark.parametrize(
     "equation,inputs,shape_dict",
     [
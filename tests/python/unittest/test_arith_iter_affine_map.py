@@ -853,6 +853,21 @@ def test_complex():
     assert_iter_sum_pattern({res[0][0]: (8, 0), res[1][0]: (4, 0)}, var_dom([l0, l1]))
 
 
+def test_detect_iter_map_cache():
+    x = tvm.tir.Var("x", "int32")
+    y = tvm.tir.Var("y", "int32")
+    # The cached results are only shared by the same variables
+    for var in [x, y, x]:
+        res = tvm.arith.detect_iter_map([floordiv(var, 4), floormod(var, 4)], var_dom([(var, 8)]))
+        assert len(res.indices) == 2
+        used_vars = []
+        tvm.tir.stmt_functor.post_order_visit(
+            convert_iter_expr(res.indices[0]),
+            lambda e: used_vars.append(e) if isinstance(e, tvm.tir.Var) else None,
+        )
+        assert len(used_vars) > 0 and all(v.same_as(var) for v in used_vars)
+
+
 def test_normalize_iter_map_to_expr():
     fld = tvm.tir.floordiv
     flm = tvm.tir.floormod
@@ -65,5 +65,28 @@ def test_regression_simplify_inf_recursion():
     ana.rewrite_simplify(res)
 
 
+def test_simplify_memo():
+    ana = tvm.arith.Analyzer()
+    ana.enable_simplify_memo()
+    x = tir.Var("x", "int32")
+    expr = tir.floormod(x, 4)
+
+    assert ana.simplify(expr).same_as(ana.simplify(expr))
+    assert ana.simplify_memo_stats.hits == 1
+    assert ana.simplify_memo_stats.misses == 1
+
+    # Bind drops the results, also those of the outer scopes
+    with ana.constraint_scope(x < 4):
+        ana.bind(x, tvm.ir.Range(0, 4))
+        tvm.ir.assert_structural_equal(ana.simplify(expr), x)
+    tvm.ir.assert_structural_equal(ana.simplify(expr), x)
+    assert ana.simplify_memo_stats.invalidations == 1
+
+    ana.reset_simplify_memo_stats()
+    ana.enable_simplify_memo(False)
+    ana.simplify(expr)
+    assert ana.simplify_memo_stats.hits == 0
+
+
 if __name__ == "__main__":
     tvm.testing.main()
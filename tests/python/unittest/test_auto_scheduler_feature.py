@@ -92,6 +92,39 @@ def test_cpu_matmul():
     assert fequal(fea_dict["parallel_prod"], math.log2((512 * 512 / 16 / 8) + 1))
 
 
+def test_feature_cache():
+    dag = auto_scheduler.ComputeDAG(matmul_auto_scheduler_test(128, 128, 128))
+    target = tvm.target.Target("llvm")
+    task = auto_scheduler.SearchTask(compute_dag=dag, workload_key="test_cache", target=target)
+    states = []
+    for factor in [4, 8, 16]:
+        s = dag.get_init_state()
+        C = s.stage_ops[2]
+        i, _, _ = s[C].iters
+        s.split(C, i, [factor])
+        states.append(s)
+
+    auto_scheduler.feature.clear_feature_cache()
+    fea = auto_scheduler.feature.get_per_store_features_from_states(states, task)
+    assert auto_scheduler.feature.feature_cache_size() == 3
+    # The features of the recurring states are looked up
+    cached = auto_scheduler.feature.get_per_store_features_from_states(states[::-1], task)
+    assert auto_scheduler.feature.feature_cache_size() == 3
+    for a, b in zip(fea, cached[::-1]):
+        assert a.shape == b.shape and (a == b).all()
+
+    # The same steps on another computation with the same workload key are not mixed up
+    other_dag = auto_scheduler.ComputeDAG(matmul_auto_scheduler_test(256, 256, 256))
+    other = auto_scheduler.SearchTask(
+        compute_dag=other_dag, workload_key="test_cache", target=target
+    )
+    auto_scheduler.feature.get_per_store_features_from_states([other_dag.get_init_state()], task)
+    auto_scheduler.feature.get_per_store_features_from_states([other_dag.get_init_state()], other)
+    assert auto_scheduler.feature.feature_cache_size() == 5
+    auto_scheduler.feature.clear_feature_cache()
+    assert auto_scheduler.feature.feature_cache_size() == 0
+
+
 def test_cpu_fusion():
     def fusion_test(N, M):
         A = te.placeholder((N, M), name="A")
@@ -301,5 +334,6 @@ def test_zero_dim():
 
 if __name__ == "__main__":
     test_cpu_matmul()
+    test_feature_cache()
     test_cpu_fusion()
     test_gpu_feature()
@@ -17,6 +17,7 @@
 
 """ Test measurement and log serialization. """
 import json
+import os
 
 import multiprocessing
 import numpy as np
@@ -203,6 +204,55 @@ def test_recover_measure_input():
         assert str(correct_inp.state) == str(inp.state)
 
 
+def test_indexed_records():
+    tasks = [
+        auto_scheduler.SearchTask(func=matmul_auto_scheduler_test, args=(n, n, n), target="llvm")
+        for n in [128, 256]
+    ]
+    inputs, results = [], []
+    for i, cost in enumerate([0.5, 0.3, 0.4, 0.1, 0.2, 0.6]):
+        task = tasks[i % 2]
+        inputs.append(auto_scheduler.measure.MeasureInput(task, task.compute_dag.init_state))
+        results.append(auto_scheduler.measure.MeasureResult([cost], 0, "", 0.2, i))
+    # A failed record is never indexed
+    inputs.append(inputs[0])
+    results.append(auto_scheduler.measure.MeasureResult([0.01], 2, "", 0.2, 6))
+
+    tmpdir = tempfile.TemporaryDirectory()
+    log = os.path.join(tmpdir.name, "log.json")
+    # The index is updated as records are appended
+    auto_scheduler.save_records(log, inputs[:3], results[:3], index_best_k=2)
+    auto_scheduler.save_records(log, inputs[3:], results[3:], index_best_k=2)
+    assert len(list(auto_scheduler.load_records(log))) == 7
+
+    def timestamps(records):
+        return sorted(res.timestamp for _, res in records)
+
+    assert timestamps(auto_scheduler.load_indexed_records(log)) == [1, 2, 3, 4]
+    key = tasks[0].workload_key
+    assert timestamps(auto_scheduler.load_indexed_records(log, key)) == [2, 4]
+    inp, res = auto_scheduler.load_best_record(log, key)
+    assert res.timestamp == 4 and inp.task.workload_key == key
+
+    # Records appended without updating the index are picked up by the readers
+    auto_scheduler.save_records(log, [inputs[0]], [results[0]])
+    with open(log, "a") as fp:
+        fp.write(auto_scheduler.measure_record.dump_record_to_string(inputs[1], results[3]))
+    assert timestamps(auto_scheduler.load_indexed_records(log)) == [2, 3, 3, 4]
+
+    # Compaction keeps the best records in the order of the input file
+    compact = os.path.join(tmpdir.name, "compact.json")
+    auto_scheduler.compact_record_file(log, compact, best_k=1)
+    assert [res.timestamp for _, res in auto_scheduler.load_records(compact)] == [3, 4]
+    assert timestamps(auto_scheduler.load_indexed_records(compact)) == [3, 4]
+
+    # A file without an index is read entirely
+    plain = os.path.join(tmpdir.name, "plain.json")
+    auto_scheduler.save_records(plain, inputs, results)
+    assert len(list(auto_scheduler.load_indexed_records(plain))) == 7
+    tmpdir.cleanup()
+
+
 def test_workload_dis_factor():
     calc = auto_scheduler.utils.calc_workload_dis_factor
     decode = auto_scheduler.utils.decode_workload_key
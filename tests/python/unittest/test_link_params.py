@@ -328,6 +328,34 @@ def test_c_link_params(linkable_dtype):
         np.testing.assert_allclose(unlinked_output.numpy(), linked_output.numpy())
 
 
+@tvm.testing.requires_llvm
+def test_link_params_as_blob(linkable_dtype):
+    temp_dir = utils.tempdir()
+    mod, param_init = _make_mod_and_params(linkable_dtype)
+    rand_input = _make_random_tensor(linkable_dtype, INPUT_SHAPE)
+    config = {"tir.disable_vectorize": True, "codegen.link_params_as_blob": True}
+    executor = Executor("graph", {"link-params": True})
+    outputs = []
+    for target in ["c", "llvm"]:
+        with tvm.transform.PassContext(opt_level=3, config=config):
+            lib = tvm.relay.build(mod, target, executor=executor, params=param_init)
+        if target == "c":
+            src = lib.lib.get_source()
+            assert '".pushsection .rodata.tvm, \\"a\\"\\n"' in src
+            assert '__attribute__((section(".rodata.tvm")' not in src
+        else:
+            assert 'section ".rodata.tvm"' in lib.lib.get_source("ll")
+
+        lib_path = temp_dir.relpath(f"test-{linkable_dtype}-{target}-blob.so")
+        lib["remove_params"]().export_library(lib_path)
+        lib_mod = tvm.runtime.load_module(lib_path)
+        graph_rt = tvm.contrib.graph_executor.GraphModule(lib_mod["default"](tvm.cpu(0)))
+        graph_rt.set_input("rand_input", rand_input)
+        graph_rt.run()
+        outputs.append(graph_rt.get_output(0).numpy())
+    np.testing.assert_equal(outputs[0], outputs[1])
+
+
 @tvm.testing.requires_micro
 def test_crt_link_params(linkable_dtype):
     from tvm import micro
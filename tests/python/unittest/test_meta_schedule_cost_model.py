@@ -26,9 +26,9 @@ from typing import List
 import numpy as np
 import tvm
 import tvm.testing
-from tvm.meta_schedule.cost_model import PyCostModel, RandomModel, XGBModel
+from tvm.meta_schedule.cost_model import GBDTModel, PyCostModel, RandomModel, XGBModel
 from tvm.meta_schedule.cost_model.xgb_model import PackSum, _get_custom_call_back
-from tvm.meta_schedule.feature_extractor import RandomFeatureExtractor
+from tvm.meta_schedule.feature_extractor import PyFeatureExtractor, RandomFeatureExtractor
 from tvm.meta_schedule.runner import RunnerResult
 from tvm.meta_schedule.search_strategy import MeasureCandidate
 from tvm.meta_schedule.tune_context import TuneContext
@@ -257,6 +257,77 @@ def test_meta_schedule_xgb_model_reupdate():
     model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
 
 
+def test_meta_schedule_gbdt_model():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=2, seed=0)
+    update_sample_count = 60
+    predict_sample_count = 100
+    for _ in range(3):
+        model.update(
+            TuneContext(),
+            [_dummy_candidate() for i in range(update_sample_count)],
+            [_dummy_result() for i in range(update_sample_count)],
+        )
+    res = model.predict(TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)])
+    assert res.shape == (predict_sample_count,)
+    assert np.isfinite(res).all()
+
+
+def test_meta_schedule_gbdt_model_learns():
+    feature_size = 4
+
+    @derived_object
+    class FirstColumnFeatureExtractor(PyFeatureExtractor):
+        """One feature row per candidate, whose first column is its cost"""
+
+        def __init__(self):
+            self.costs = []
+
+        def extract_from(self, context, candidates):
+            return [
+                tvm.nd.array(np.full((1, feature_size), cost, dtype="float32"))
+                for cost in self.costs[: len(candidates)]
+            ]
+
+    extractor = FirstColumnFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=0, seed=0)
+    costs = list(np.random.uniform(1.0, 10.0, size=64))
+    extractor.costs = costs
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for _ in costs],
+        [RunnerResult([cost], None) for cost in costs],
+    )
+    extractor.costs = [1.5, 9.5]
+    fast, slow = model.predict(TuneContext(), [_dummy_candidate(), _dummy_candidate()])
+    assert fast > slow
+
+
+def test_meta_schedule_gbdt_model_reload():
+    extractor = RandomFeatureExtractor()
+    model = GBDTModel(extractor=extractor, num_warmup_samples=10, seed=0)
+    update_sample_count = 20
+    predict_sample_count = 30
+    model.update(
+        TuneContext(),
+        [_dummy_candidate() for i in range(update_sample_count)],
+        [_dummy_result() for i in range(update_sample_count)],
+    )
+    with tempfile.NamedTemporaryFile() as path:
+        random_state = extractor.random_state
+        model.save(path.name)
+        res1 = model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+        extractor.random_state = random_state
+        new_model = GBDTModel(extractor=extractor, num_warmup_samples=10, seed=0)
+        new_model.load(path.name)
+        res2 = new_model.predict(
+            TuneContext(), [_dummy_candidate() for i in range(predict_sample_count)]
+        )
+    assert (res1 == res2).all()
+
+
 def xgb_version_check():
 
     # pylint: disable=import-outside-toplevel
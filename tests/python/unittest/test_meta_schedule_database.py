@@ -414,6 +414,121 @@ def test_meta_schedule_database_reload():
             _equal_record(ret[1], records[2])
 
 
+def test_meta_schedule_database_multiple_workloads():
+    mod: IRModule = Matmul
+    mod_2: IRModule = MatmulRelu
+    with tempfile.TemporaryDirectory() as tmpdir:
+        database = _create_tmp_database(tmpdir)
+        token = database.commit_workload(mod)
+        token_2 = database.commit_workload(mod_2)
+        trace = _create_schedule(mod, _schedule_matmul).trace
+        trace_2 = _create_schedule(mod_2, lambda sch: None).trace
+        entries = [(mod, trace, token), (mod_2, trace_2, token_2)]
+        for i, run_secs in enumerate([[3.0], [1.0], [4.0], [2.0]]):
+            m, t, w = entries[i % 2]
+            database.commit_tuning_record(
+                ms.database.TuningRecord(
+                    t,
+                    w,
+                    run_secs,
+                    tvm.target.Target("llvm"),
+                    ms.arg_info.ArgInfo.from_prim_func(func=m["main"]),
+                )
+            )
+        new_database = ms.database.JSONDatabase(
+            path_workload=database.path_workload,
+            path_tuning_record=database.path_tuning_record,
+        )
+        for db in [database, new_database]:
+            ret = db.get_top_k(db.commit_workload(mod), 3)
+            assert [[v.value for v in r.run_secs] for r in ret] == [[3.0], [4.0]]
+            ret = db.get_top_k(db.commit_workload(mod_2), 3)
+            assert [[v.value for v in r.run_secs] for r in ret] == [[1.0], [2.0]]
+
+
+def test_meta_schedule_binary_database():
+    mod: IRModule = Matmul
+    mod_2: IRModule = MatmulRelu
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = osp.join(tmpdir, "database.bin")
+        database = ms.database.BinaryDatabase(path)
+        # A second handle on the same file stands in for another tuning process
+        other = ms.database.BinaryDatabase(path)
+        token = database.commit_workload(mod)
+        assert other.has_workload(mod)
+        assert not other.has_workload(mod_2)
+        token_2 = other.commit_workload(mod_2)
+        assert database.has_workload(mod_2)
+        trace = _create_schedule(mod, _schedule_matmul).trace
+        for i, run_secs in enumerate([[3.0], [1.0], [4.0], [2.0], None]):
+            db = database if i % 2 == 0 else other
+            db.commit_tuning_record(
+                ms.database.TuningRecord(
+                    trace,
+                    db.commit_workload(mod),
+                    run_secs,
+                    tvm.target.Target("llvm"),
+                    ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+                )
+            )
+        reloaded = ms.database.BinaryDatabase(path, allow_missing=False)
+        for db in [database, other, reloaded]:
+            assert len(db) == 5
+            ret = db.get_top_k(db.commit_workload(mod), 3)
+            assert [[v.value for v in r.run_secs] for r in ret] == [[1.0], [2.0], [3.0]]
+            assert len(db.get_top_k(db.commit_workload(mod_2), 3)) == 0
+            assert len(db.get_all_tuning_records()) == 5
+        assert reloaded.commit_workload(mod_2).shash == token_2.shash
+        with pytest.raises(tvm.TVMError):
+            ms.database.BinaryDatabase(path, module_equality="anchor-block")
+        with pytest.raises(tvm.TVMError):
+            ms.database.BinaryDatabase(osp.join(tmpdir, "missing.bin"), allow_missing=False)
+
+
+def test_meta_schedule_rpc_database():
+    mod: IRModule = Matmul
+    mod_2: IRModule = MatmulRelu
+    with tempfile.TemporaryDirectory() as tmpdir:
+        server = ms.database.rpc_database.serve(osp.join(tmpdir, "database.bin"), "127.0.0.1")
+        # Two clients stand in for tuning jobs sharing the server
+        database = ms.database.RPCDatabase("127.0.0.1", server.port, cache_ttl=0.0)
+        other = ms.database.RPCDatabase("127.0.0.1", server.port, cache_ttl=60.0)
+        database.commit_workload(mod)
+        assert other.has_workload(mod)
+        assert not other.has_workload(mod_2)
+        assert len(other.get_top_k(other.commit_workload(mod), 3)) == 0
+        trace = _create_schedule(mod, _schedule_matmul).trace
+        for i, run_secs in enumerate([[3.0], [1.0], [4.0], [2.0], None]):
+            db = database if i % 2 == 0 else other
+            db.commit_tuning_record(
+                ms.database.TuningRecord(
+                    trace,
+                    db.commit_workload(mod),
+                    run_secs,
+                    tvm.target.Target("llvm"),
+                    ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+                )
+            )
+        for db in [database, other]:
+            assert len(db) == 5
+            ret = db.get_top_k(db.commit_workload(mod), 3)
+            assert [[v.value for v in r.run_secs] for r in ret] == [[1.0], [2.0], [3.0]]
+            assert len(db.get_all_tuning_records()) == 5
+        # The cached top-k of `other` does not see records committed by `database`
+        database.commit_tuning_record(
+            ms.database.TuningRecord(
+                trace,
+                database.commit_workload(mod),
+                [0.5],
+                tvm.target.Target("llvm"),
+                ms.arg_info.ArgInfo.from_prim_func(func=mod["main"]),
+            )
+        )
+        assert database.get_top_k(database.commit_workload(mod), 1)[0].run_secs[0].value == 0.5
+        assert other.get_top_k(other.commit_workload(mod), 1)[0].run_secs[0].value == 1.0
+        server.terminate()
+
+
 def test_meta_schedule_database_union():
     mod: IRModule = Matmul
     target = tvm.target.Target("llvm")
@@ -1632,5 +1632,27 @@ def test_negative_extent():
     assert named_features["B0.unique_bytes"] == 0
 
 
+def test_feature_cache():
+    def _create_schedule():
+        func = matmul
+        sch = tir.Schedule(func, debug_mask="all")
+        block = sch.get_block("C")
+        i, j, _ = sch.get_loops(block)
+        sch.reorder(j, i)
+        return sch
+
+    context = _make_context(tvm.target.Target("llvm"))
+    candidates = [_make_candidate(_create_schedule), _make_candidate(_create_schedule)]
+    (expected, _) = ms.feature_extractor.PerStoreFeature(feature_cache_size=0).extract_from(
+        context, candidates
+    )
+    extractor = ms.feature_extractor.PerStoreFeature(feature_cache_size=1)
+    for _ in range(2):
+        features = extractor.extract_from(context, candidates)
+        assert len(features) == 2
+        for feature in features:
+            assert_allclose(feature.numpy(), expected.numpy(), rtol=1e-5, atol=1e-5)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -17,7 +17,7 @@
 # pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
 import operator
 from functools import reduce
-from typing import List
+from typing import List, Optional
 
 from tvm import meta_schedule as ms
 from tvm.script import tir as T
@@ -66,14 +66,16 @@ def _sch(decisions: List[List[int]]) -> Schedule:
     return sch
 
 
-def _make_mutator(target: Target) -> ms.Mutator:
+def _make_mutator(target: Target, mutator: Optional[ms.Mutator] = None) -> ms.Mutator:
+    if mutator is None:
+        mutator = ms.mutator.MutateTileSize()
     ctx = ms.TuneContext(
         mod=matmul,
         target=target,
         space_generator=ms.space_generator.PostOrderApply(
             sch_rules=[],
             postprocs=[],
-            mutator_probs={ms.mutator.MutateTileSize(): 1.0},
+            mutator_probs={mutator: 1.0},
         ),
     )
     return list(ctx.space_generator.mutator_probs.keys())[0]
@@ -95,6 +97,43 @@ def test_mutate_tile_size_matmul():
     assert len(results) > 15
 
 
+def test_mutate_tile_size_matmul_guided():
+    mutator = _make_mutator(
+        target=Target("llvm --num-cores=16"),
+        mutator=ms.mutator.MutateTileSize(num_candidates=8, exploration=0.0),
+    )
+    sch = _sch(decisions=[[4, 32, 4, 1]])
+
+    def _decision(trace):
+        assert trace.insts[4].kind.name == "SamplePerfectTile"
+        return [int(x) for x in trace.decisions[trace.insts[4]]]
+
+    for _ in range(100):
+        batch = []
+
+        def f_score(traces):
+            scores = [float(_decision(trace)[-1]) for trace in traces]
+            batch.extend(scores)
+            return scores
+
+        trace = mutator.apply_guided(sch.trace, f_score)
+        decision = _decision(trace)
+        assert reduce(operator.mul, decision, 1) == 512
+        assert 0 < len(batch) <= 8
+        # Without exploration, the neighbor scored the highest is picked
+        assert decision[-1] == max(batch)
+
+
+def test_mutate_tile_size_guided_all_invalid():
+    mutator = _make_mutator(
+        target=Target("llvm --num-cores=16"),
+        mutator=ms.mutator.MutateTileSize(num_candidates=4),
+    )
+    sch = _sch(decisions=[[4, 32, 4, 1]])
+    trace = mutator.apply_guided(sch.trace, lambda traces: [float("-inf")] * len(traces))
+    assert trace is None
+
+
 def test_mutate_sample_categorical_single_candidate():
     mutator = _make_mutator(
         target=Target("llvm --num-cores=16"),
@@ -109,4 +148,6 @@ def test_mutate_sample_categorical_single_candidate():
 
 if __name__ == "__main__":
     test_mutate_tile_size_matmul()
+    test_mutate_tile_size_matmul_guided()
+    test_mutate_tile_size_guided_all_invalid()
     test_mutate_sample_categorical_single_candidate()
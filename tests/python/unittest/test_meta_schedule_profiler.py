@@ -15,6 +15,10 @@
 # specific language governing permissions and limitations
 # under the License.
 """ Test Meta Schedule Profiler """
+import json
+import os
+import tempfile
+import threading
 import time
 
 from tvm import meta_schedule as ms
@@ -36,6 +40,45 @@ def test_meta_schedule_profiler_context_manager():
     assert 1.9 <= result["Level1"] <= 2.1
 
 
+def test_meta_schedule_profiler_task_stats_and_timeline():
+    with ms.Profiler() as profiler:
+        with ms.Profiler.task_scope("task_a"):
+            with ms.Profiler.timeit("Phase"):
+                time.sleep(0.2)
+        with ms.Profiler.task_scope("task_b"):
+            with ms.Profiler.timeit("Phase"):
+                time.sleep(0.1)
+        # Scopes on threads without a profiler are recorded in the one entered
+        def _worker():
+            with ms.Profiler.timeit("Worker"):
+                time.sleep(0.01)
+
+        thread = threading.Thread(target=_worker)
+        thread.start()
+        thread.join()
+        ms.Profiler.record_workers("Pool", 2, 4, 0.1)
+
+    task_stats = profiler.get_task_stats()
+    assert set(task_stats.keys()) == {"task_a", "task_b"}
+    assert 0.15 <= task_stats["task_a"]["Phase"] <= 0.3
+    assert 0.05 <= task_stats["task_b"]["Phase"] <= 0.2
+    assert 0.25 <= profiler.get()["Phase"] <= 0.5
+    assert "Worker" in profiler.get()
+    total = profiler.get()["Total"]
+    assert abs(profiler.get_utilization()["Pool"] - 0.1 / (2 * total)) < 1e-6
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, "timeline.json")
+        profiler.export_timeline(path)
+        with open(path, "r", encoding="utf-8") as file:
+            events = json.load(file)["traceEvents"]
+    assert [(e["name"], e["cat"]) for e in events if e["name"] == "Phase"] == [
+        ("Phase", "task_a"),
+        ("Phase", "task_b"),
+    ]
+    assert events[-1]["name"] == "Total"
+
+
 def test_meta_schedule_no_context():
     with ms.Profiler.timeit("Level0"):
         assert ms.Profiler.current() is None
@@ -43,4 +86,5 @@ def test_meta_schedule_no_context():
 
 if __name__ == "__main__":
     test_meta_schedule_profiler_context_manager()
+    test_meta_schedule_profiler_task_stats_and_timeline()
     test_meta_schedule_no_context()
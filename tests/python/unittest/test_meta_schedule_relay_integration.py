@@ -103,6 +103,14 @@ def test_meta_schedule_integration_extract_from_resnet():
     for t in extracted_tasks:
         assert t.task_name in expected_task_names, t.task_name
 
+    # The hashes precomputed during extraction are the ones the database uses
+    database = ms.database.MemoryDatabase(module_equality="anchor-block")
+    for t in extracted_tasks:
+        assert t.module_equality == "anchor-block"
+        assert len(t.dispatched_hashes) == 1
+        shash, _ = database.commit_workload(t.dispatched[0]).as_json()
+        assert int(shash) == t.dispatched_hashes[0].value % 2**64
+
 
 @pytest.mark.skipif(
     platform.machine() == "aarch64",
@@ -36,6 +36,7 @@ from tvm.meta_schedule.runner import (
     RPCRunner,
     RunnerFuture,
     RunnerInput,
+    RunnerResult,
 )
 from tvm.meta_schedule.runner.local_runner import (
     default_alloc_argument as local_default_alloc_argument,
@@ -312,6 +313,65 @@ def test_meta_schedule_rpc_multiple_runs():
         _clean_build(builder_result.artifact_path)
 
 
+def test_meta_schedule_rpc_batched_runs():
+    """Test meta schedule rpc runner measuring the runner inputs in batches"""
+    mods = [
+        MatmulModule,
+        MatmulReluModule,
+        MatmulModule,
+    ]
+    builder = LocalBuilder()
+    builder_inputs = [BuilderInput(mod, Target("llvm")) for mod in mods]
+    builder_results = builder.build(builder_inputs)
+    for builder_result in builder_results:
+        assert builder_result.artifact_path is not None
+        assert builder_result.error_msg is None
+
+    args_info = [
+        TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+        TensorInfo("float32", (MATMUL_N, MATMUL_N)),
+    ]
+    runner_inputs = [
+        RunnerInput(builder_result.artifact_path, "llvm", args_info)
+        for builder_result in builder_results
+    ]
+    # An artifact that does not exist only fails its own runner input
+    runner_inputs.insert(1, RunnerInput("/path/to/missing/tvm_tmp_mod.tar", "llvm", args_info))
+
+    with LocalRPC() as rpc:
+        rpc_config = RPCConfig(
+            tracker_host=rpc.tracker_host,
+            tracker_port=rpc.tracker_port,
+            tracker_key=rpc.tracker_key,
+            session_priority=1,
+            session_timeout_sec=100,
+        )
+        evaluator_config = EvaluatorConfig(
+            number=1,
+            repeat=1,
+            min_repeat_ms=0,
+            enable_cpu_cache_flush=False,
+        )
+        runner = RPCRunner(rpc_config, evaluator_config, max_batch_size=3)
+        runner_futures = runner.run(runner_inputs)
+        runner_results = [runner_future.result() for runner_future in runner_futures]
+
+    assert len(runner_results) == 4
+    assert runner_results[1].error_msg is not None
+    assert runner_results[1].error_msg.startswith("RPCRunner: An exception occurred")
+    for i in [0, 2, 3]:
+        assert runner_results[i].error_msg is None
+        for result in runner_results[i].run_secs:
+            if isinstance(result, FloatImm):
+                result = result.value
+            assert isinstance(result, float)
+            assert result >= 0.0
+
+    for builder_result in builder_results:
+        _clean_build(builder_result.artifact_path)
+
+
 def test_meta_schedule_local_multiple_runs():
     """Test meta schedule local runner for multiple runs"""
     # Build the module
@@ -388,6 +448,14 @@ def test_meta_schedule_py_runner():
         runner.run([])
 
 
+def test_meta_schedule_runner_result_variance():
+    """Test the variance of the run time in RunnerResult"""
+    result = RunnerResult(run_secs=[1.0, 2.0, 3.0], error_msg=None)
+    assert result.run_sec_var.value == pytest.approx(1.0)
+    assert RunnerResult(run_secs=[1.0], error_msg=None).run_sec_var is None
+    assert RunnerResult(run_secs=None, error_msg="error").run_sec_var is None
+
+
 def test_meta_schedule_rpc_runner_time_out():
     """Test meta schedule RPC Runner time out by using a super large workload"""
 
@@ -0,0 +1,119 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+from tvm import meta_schedule as ms
+from tvm.meta_schedule.testing.space_generation import (
+    check_sketches,
+    generate_design_space,
+)
+from tvm.script import tir as T
+from tvm.target import Target
+
+
+@T.prim_func
+def two_element_wise(
+    A: T.Buffer((128, 128), "float32"),
+    B: T.Buffer((128, 128), "float32"),
+    C: T.Buffer((64, 64), "float32"),
+    D: T.Buffer((64, 64), "float32"),
+) -> None:
+    for i, j in T.grid(128, 128):
+        with T.block("B"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            B[vi, vj] = A[vi, vj] + 1.0
+    for i, j in T.grid(64, 64):
+        with T.block("D"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            D[vi, vj] = C[vi, vj] * 2.0
+
+
+@T.prim_func
+def producer_consumer(
+    A: T.Buffer((128, 128), "float32"),
+    C: T.Buffer((128, 128), "float32"),
+) -> None:
+    B = T.alloc_buffer((128, 128))
+    for i, j in T.grid(128, 128):
+        with T.block("B"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            B[vi, vj] = A[vi, vj] + 1.0
+    for i, j in T.grid(128, 128):
+        with T.block("C"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            C[vi, vj] = B[vi, vj] * 2.0
+
+
+def test_cuda_two_element_wise():
+    @T.prim_func
+    def two_element_wise_0(
+        A: T.Buffer((128, 128), "float32"),
+        B: T.Buffer((128, 128), "float32"),
+        C: T.Buffer((64, 64), "float32"),
+        D: T.Buffer((64, 64), "float32"),
+    ) -> None:
+        for i_j_fused_h in range(16384):
+            with T.block("B"):
+                vi = T.axis.spatial(128, i_j_fused_h // 128)
+                vj = T.axis.spatial(128, i_j_fused_h % 128)
+                T.reads(A[vi, vj])
+                T.writes(B[vi, vj])
+                B[vi, vj] = A[vi, vj] + T.float32(1)
+            with T.block("D"):
+                vi = T.axis.spatial(64, i_j_fused_h // 64)
+                vj = T.axis.spatial(64, i_j_fused_h % 64)
+                T.where(i_j_fused_h < 4096)
+                T.reads(C[vi, vj])
+                T.writes(D[vi, vj])
+                D[vi, vj] = C[vi, vj] * T.float32(2)
+
+    mod = two_element_wise
+    actual = generate_design_space(
+        kind="cuda",
+        mod=mod,
+        target=Target("nvidia/geforce-rtx-3080", host="llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.HorizontalFusion()],
+    )
+    check_sketches(
+        mod,
+        sketches=actual,
+        expected_mods=[two_element_wise_0],
+        expected_decisions=[[]],
+    )
+
+
+def test_cuda_producer_consumer():
+    mod = producer_consumer
+    actual = generate_design_space(
+        kind="cuda",
+        mod=mod,
+        target=Target("nvidia/geforce-rtx-3080", host="llvm"),
+        types=None,
+        sch_rules=[ms.schedule_rule.HorizontalFusion()],
+    )
+    check_sketches(
+        mod,
+        sketches=actual,
+        expected_mods=[producer_consumer],
+        expected_decisions=[[]],
+    )
+
+
+if __name__ == "__main__":
+    test_cuda_two_element_wise()
+    test_cuda_producer_consumer()
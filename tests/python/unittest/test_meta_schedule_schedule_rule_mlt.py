@@ -884,5 +884,51 @@ def test_max_pool_blocked():
     )
 
 
+def test_cpu_matmul_l1_cache_size():
+    mod = te.create_prim_func(te_workload.matmul(512, 512, 512))
+    # The innermost tiles of A, B and C in float32 fit in 64 bytes only if their factors are <= 2
+    actual = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm -l1-cache-size=64"),
+        types=ms.schedule_rule.MultiLevelTiling,
+    )
+    assert len(actual) > 0
+    for sch in actual:
+        for inst in sch.trace.insts:
+            if inst.kind.name == "SamplePerfectTile":
+                assert int(inst.attrs[1]) == 2
+
+
+def test_cpu_matmul_tile_footprint():
+    @T.prim_func
+    def matmul_tiled(
+        A: T.Buffer((64, 64), "float32"),
+        B: T.Buffer((64, 64), "float32"),
+        C: T.Buffer((64, 64), "float32"),
+    ) -> None:
+        for i0, j0, i1, j1, k0, i2, j2, k1, i3, j3 in T.grid(2, 2, 2, 2, 8, 4, 4, 8, 4, 4):
+            with T.block("C"):
+                vi = T.axis.spatial(64, i0 * 32 + i1 * 16 + i2 * 4 + i3)
+                vj = T.axis.spatial(64, j0 * 32 + j1 * 16 + j2 * 4 + j3)
+                vk = T.axis.reduce(64, k0 * 8 + k1)
+                T.reads(A[vi, vk], B[vk, vj])
+                T.writes(C[vi, vj])
+                T.block_attr({"meta_schedule.tiling_structure": "SSRSRS"})
+                with T.init():
+                    C[vi, vj] = T.float32(0)
+                C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vk, vj]
+
+    check = tvm.get_global_func("meta_schedule.CheckTileFootprint")
+    sch = tvm.tir.Schedule(matmul_tiled)
+    # Under the first reduction level: A[16, 64], B[64, 16] and C[16, 16], i.e. 9216 bytes
+    assert check(Target("llvm -l2-cache-size=16384"), sch)
+    assert not check(Target("llvm -l2-cache-size=8192"), sch)
+    # Under the last reduction level: A[4, 8], B[8, 4] and C[4, 4], i.e. 320 bytes
+    assert check(Target("llvm -l1-cache-size=512"), sch)
+    assert not check(Target("llvm -l1-cache-size=256"), sch)
+    assert check(Target("llvm"), sch)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
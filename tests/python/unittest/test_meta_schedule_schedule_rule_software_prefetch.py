@@ -0,0 +1,74 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+from tvm import meta_schedule as ms
+from tvm.meta_schedule.testing.space_generation import (
+    check_sketches,
+    generate_design_space,
+)
+from tvm.script import tir as T
+from tvm.target import Target
+
+
+@T.prim_func
+def transpose(A: T.Buffer((1024, 1024), "float32"), B: T.Buffer((1024, 1024), "float32")) -> None:
+    T.func_attr({"global_symbol": "main"})
+    for i, j in T.grid(1024, 1024):
+        with T.block("B"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            B[vi, vj] = A[vj, vi]
+
+
+def test_software_prefetch():
+    @T.prim_func
+    def transpose_0(
+        A: T.Buffer((1024, 1024), "float32"), B: T.Buffer((1024, 1024), "float32")
+    ) -> None:
+        T.func_attr({"global_symbol": "main"})
+        with T.block("root"):
+            T.reads()
+            T.writes()
+            T.block_attr({"pragma_software_prefetch_distance": 8})
+            for i, j in T.grid(1024, 1024):
+                with T.block("B"):
+                    vi, vj = T.axis.remap("SS", [i, j])
+                    T.reads(A[vj, vi])
+                    T.writes(B[vi, vj])
+                    B[vi, vj] = A[vj, vi]
+
+    decision_0 = [
+        ("SampleCategorical", 1),
+    ]
+
+    mod = transpose
+    actual = generate_design_space(
+        kind="llvm",
+        mod=mod,
+        target=Target("llvm --num-cores=32"),
+        types=None,
+        sch_rules=[ms.schedule_rule.SoftwarePrefetch(distances=[0, 8, 32])],
+    )
+    check_sketches(
+        mod,
+        sketches=actual,
+        expected_mods=[transpose_0],
+        expected_decisions=[decision_0],
+    )
+
+
+if __name__ == "__main__":
+    test_software_prefetch()
@@ -0,0 +1,64 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-module-docstring,missing-function-docstring,missing-class-docstring
+import tvm
+import tvm.testing
+from tvm import te, tir
+from tvm.target import Target
+
+
+def _check(mod, target="nvidia/geforce-rtx-3080") -> bool:
+    func = tvm.get_global_func("meta_schedule.CheckStaticValidity")
+    return bool(func(Target(target), mod))
+
+
+def _matmul_schedule(n: int, num_threads: int, shared_input: int = -1) -> tir.Schedule:
+    A = te.placeholder((n, n), name="A")
+    B = te.placeholder((n, n), name="B")
+    k = te.reduce_axis((0, n), name="k")
+    C = te.compute((n, n), lambda i, j: te.sum(A[i, k] * B[k, j], axis=[k]), name="C")
+    sch = tir.Schedule(te.create_prim_func([A, B, C]))
+    block = sch.get_block("C")
+    i, j, _ = sch.get_loops(block)
+    fused = sch.fuse(i, j)
+    bx, tx = sch.split(fused, factors=[None, num_threads])
+    sch.bind(bx, "blockIdx.x")
+    sch.bind(tx, "threadIdx.x")
+    if shared_input != -1:
+        shared = sch.cache_read(block, shared_input, "shared")
+        sch.compute_at(shared, bx)
+    return sch
+
+
+def test_static_validity_threads_per_block():
+    assert _check(_matmul_schedule(64, 32).mod)
+    assert not _check(_matmul_schedule(64, 2048).mod)
+
+
+def test_static_validity_shared_memory():
+    # Each block reads a row of A, i.e. 4 KB
+    assert _check(_matmul_schedule(1024, 128, shared_input=0).mod)
+    # Each block reads 128 columns of B, i.e. 512 KB
+    assert not _check(_matmul_schedule(1024, 128, shared_input=1).mod)
+
+
+def test_static_validity_non_gpu_target():
+    assert _check(_matmul_schedule(64, 2048).mod, target="llvm")
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
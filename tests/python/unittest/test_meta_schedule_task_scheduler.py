@@ -231,6 +231,58 @@ def test_meta_schedule_task_scheduler_multiple():
         )
 
 
+def test_meta_schedule_task_scheduler_overlap_build_and_run():  # pylint: disable=invalid-name
+    num_running = [0]
+    overlapped = []
+
+    @ms.derived_object
+    class CountingRunnerFuture(ms.runner.PyRunnerFuture):
+        def done(self) -> bool:
+            return True
+
+        def result(self) -> ms.runner.RunnerResult:
+            num_running[0] -= 1
+            return ms.runner.RunnerResult([1.0], None)
+
+    @ms.derived_object
+    class CountingRunner(ms.runner.PyRunner):
+        def run(self, runner_inputs):
+            num_running[0] += len(runner_inputs)
+            return [CountingRunnerFuture() for _ in runner_inputs]
+
+    @ms.derived_object
+    class CountingBuilder(ms.builder.PyBuilder):
+        def build(self, build_inputs):
+            overlapped.append(num_running[0] > 0)
+            return [ms.builder.BuilderResult("test_path", None) for _ in build_inputs]
+
+    database = ms.database.MemoryDatabase()
+    ms.task_scheduler.RoundRobin().tune(
+        [
+            ms.TuneContext(
+                MatmulModule,
+                target=tvm.target.Target("llvm"),
+                space_generator=_schedule_matmul,
+                search_strategy=ms.search_strategy.ReplayTrace(),
+                task_name="Test",
+                rand_state=42,
+            )
+        ],
+        [1.0],
+        max_trials_global=30,
+        max_trials_per_task=30,
+        num_trials_per_iter=10,
+        builder=CountingBuilder(),
+        runner=CountingRunner(),
+        database=database,
+        measure_callbacks=[ms.measure_callback.AddToDatabase()],
+        cost_model=None,
+    )
+    assert len(database) == 30
+    # Every batch but the first is built while the previous one is running
+    assert overlapped == [False, True, True]
+
+
 def test_meta_schedule_task_scheduler_NIE():  # pylint: disable=invalid-name
     @ms.derived_object
     class NIETaskScheduler(ms.task_scheduler.PyTaskScheduler):
@@ -436,6 +488,90 @@ def test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
     assert len(database.get_top_k(database.commit_workload(MatmulReluModule), 100)) == 10
 
 
+@ms.derived_object
+class ConstantRunnerFuture(ms.runner.PyRunnerFuture):
+    def done(self) -> bool:
+        return True
+
+    def result(self) -> ms.runner.RunnerResult:
+        return ms.runner.RunnerResult([1.0], None)
+
+
+@ms.derived_object
+class ConstantRunner(ms.runner.PyRunner):
+    def run(self, runner_inputs):
+        return [ConstantRunnerFuture() for _ in runner_inputs]  # type: ignore
+
+
+def test_meta_schedule_task_scheduler_time_budget_early_stopping():
+    num_trials_per_iter = 6
+    max_trials_per_task = 101
+    patience = 2
+    tasks = [
+        ms.TuneContext(
+            MatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="Matmul",
+            rand_state=42,
+        ),
+        ms.TuneContext(
+            BatchMatmulModule,
+            target=tvm.target.Target("llvm"),
+            space_generator=_schedule_batch_matmul,
+            search_strategy=ms.search_strategy.ReplayTrace(),
+            task_name="BatchMatmul",
+            rand_state=0x114514,
+        ),
+    ]
+    database = ms.database.MemoryDatabase()
+    time_budget = ms.task_scheduler.TimeBudget(time_budget_sec=3600.0, patience=patience)
+    time_budget.tune(
+        tasks,
+        task_weights=[1.0, 1.0],
+        builder=DummyBuilder(),
+        runner=ConstantRunner(),
+        database=database,
+        measure_callbacks=[ms.measure_callback.AddToDatabase()],
+        max_trials_global=max_trials_per_task * len(tasks),
+        max_trials_per_task=max_trials_per_task,
+        num_trials_per_iter=num_trials_per_iter,
+        cost_model=None,
+    )
+    # The latency never improves after the first round, so each task stops after `patience` more
+    for task in tasks:
+        num_records = len(database.get_top_k(database.commit_workload(task.mod), 10000))
+        assert (patience + 1) * num_trials_per_iter <= num_records < max_trials_per_task
+
+
+def test_meta_schedule_task_scheduler_time_budget_used_up():
+    database = ms.database.MemoryDatabase()
+    time_budget = ms.task_scheduler.TimeBudget(time_budget_sec=1e-6)
+    time_budget.tune(
+        [
+            ms.TuneContext(
+                MatmulModule,
+                target=tvm.target.Target("llvm"),
+                space_generator=_schedule_matmul,
+                search_strategy=ms.search_strategy.ReplayTrace(),
+                task_name="Matmul",
+                rand_state=42,
+            )
+        ],
+        task_weights=[1.0],
+        builder=DummyBuilder(),
+        runner=DummyRunner(),
+        database=database,
+        measure_callbacks=[ms.measure_callback.AddToDatabase()],
+        max_trials_global=10,
+        max_trials_per_task=10,
+        num_trials_per_iter=5,
+        cost_model=None,
+    )
+    assert len(database) == 0
+
+
 if __name__ == "__main__":
     test_meta_schedule_task_scheduler_single()
     test_meta_schedule_task_scheduler_multiple()
@@ -444,3 +580,5 @@ if __name__ == "__main__":
     test_meta_schedule_task_scheduler_override_next_task_id_only()
     test_meta_schedule_task_scheduler_multiple_gradient_based()
     test_meta_schedule_task_scheduler_gradient_based_with_null_search_strategy()
+    test_meta_schedule_task_scheduler_time_budget_early_stopping()
+    test_meta_schedule_task_scheduler_time_budget_used_up()
@@ -19,8 +19,9 @@ import pytest
 import tvm
 import tvm.testing
 import tvm.meta_schedule as ms
+from tvm import te
 from tvm.script import tir as T
-from tvm.tir import Schedule, floormod, floordiv
+from tvm.tir import Schedule, Trace, floormod, floordiv
 from tvm.tir.tensor_intrin.cuda import *
 from tvm.target import Target
 from tvm.target.codegen import llvm_lookup_intrinsic_id
@@ -3368,5 +3369,41 @@ def test_inline_order():
     )
 
 
+def test_transfer_trace():
+    def _matmul(n):
+        a = te.placeholder((n, n), name="A")
+        b = te.placeholder((n, n), name="B")
+        k = te.reduce_axis((0, n), name="k")
+        c = te.compute((n, n), lambda i, j: te.sum(a[i, k] * b[k, j], axis=k), name="matmul")
+        return tvm.IRModule({"main": te.create_prim_func([a, b, c])})
+
+    def _schedule(mod, i_tiles=None, k_tiles=None):
+        sch = Schedule(mod)
+        i, _, k = sch.get_loops(sch.get_block("matmul"))
+        sch.split(i, sch.sample_perfect_tile(i, n=3, decision=i_tiles))
+        sch.split(k, sch.sample_perfect_tile(k, n=2, decision=k_tiles))
+        return sch
+
+    def _tiles(trace):
+        return [
+            [int(x) for x in trace.decisions[inst]]
+            for inst in trace.insts
+            if inst.kind.name == "SamplePerfectTile"
+        ]
+
+    tuned = _schedule(_matmul(64), i_tiles=[2, 4, 8], k_tiles=[4, 16]).trace
+    mod = _matmul(256)
+    design_space = Trace(_schedule(mod).trace.insts, {})
+    transferred = ms.trace_apply.transfer_trace(mod, design_space, tuned)
+    assert transferred is not None
+    # The tiles keep their ratios in log scale, and the innermost one is at most 16
+    assert _tiles(transferred) == [[2, 8, 16], [16, 16]]
+
+    sch = Schedule(mod)
+    i, _, _ = sch.get_loops(sch.get_block("matmul"))
+    sch.split(i, sch.sample_perfect_tile(i, n=3))
+    assert ms.trace_apply.transfer_trace(mod, Trace(sch.trace.insts, {}), tuned) is None
+
+
 if __name__ == "__main__":
     tvm.testing.main()
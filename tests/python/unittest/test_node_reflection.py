@@ -195,5 +195,30 @@ def test_alloc_const():
     np.testing.assert_array_equal(np_data, alloc_const2.data.numpy())
 
 
+def test_binary_saveload():
+    dev = tvm.cpu(0)
+    dtype = "float32"
+    shape = (16,)
+    buf = tvm.tir.decl_buffer(shape, dtype)
+    np_data = np.random.rand(*shape).astype(dtype)
+    data = tvm.nd.array(np_data, device=dev)
+    body = tvm.tir.Evaluate(0)
+    alloc_const = tvm.tir.AllocateConst(buf.data, dtype, shape, data, body)
+    func = tvm.tir.PrimFunc([], alloc_const).with_attr("global_symbol", "main")
+    mod = tvm.IRModule({"main": func})
+
+    mod2 = tvm.ir.load_binary(tvm.ir.save_binary(mod))
+    tvm.ir.assert_structural_equal(mod, mod2)
+    tvm.ir.assert_structural_equal(tvm.ir.load_json(tvm.ir.save_json(mod)), mod2)
+    np.testing.assert_array_equal(np_data, mod2["main"].body.data.numpy())
+
+    m1 = {"key1": tvm.tir.const(1.5, "float16"), "key2": [tvm.runtime.String("x"), None]}
+    m2 = tvm.ir.load_binary(tvm.ir.save_binary(m1))
+    tvm.ir.assert_structural_equal(m1, m2)
+
+    with pytest.raises(tvm.error.TVMError):
+        tvm.ir.load_binary(tvm.ir.save_binary(mod)[:-8])
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -131,5 +131,24 @@ def test_roofline_analysis(target, dev):
                 assert 90 >= call["Percent of Theoretical Optimal"].ratio >= 0.01
 
 
+def test_kernels_by_roofline_gap():
+    def call(name, duration, percent):
+        return {
+            "Name": name,
+            "Duration (us)": tvm.runtime.profiling.Duration(duration),
+            "Percent of Attainable": tvm.runtime.profiling.Ratio(percent),
+        }
+
+    report = Report(
+        [call("a", 100.0, 90.0), call("b", 50.0, 10.0), call("c", 200.0, 50.0), {"Name": "d"}],
+        {},
+        {},
+    )
+    calls = tvm.utils.kernels_by_roofline_gap(report)
+    assert [call["Name"] for call in calls] == ["c", "b", "a"]
+    assert calls[0]["Roofline Gap (us)"] == pytest.approx(100.0)
+    assert calls[1]["Roofline Gap (us)"] == pytest.approx(45.0)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -61,5 +61,42 @@ def test_from_dlpack_strided():
     np.testing.assert_equal(inp.numpy().reshape(2, 8), view.numpy())
 
 
+def test_dlpack_stream_cpu():
+    x = np.random.uniform(size=(4, 8)).astype("float32")
+    a = tvm.nd.array(x)
+    for stream in [None, -1]:
+        b = tvm.runtime.ndarray.from_dlpack(a.__dlpack__(stream=stream))
+        np.testing.assert_equal(b.numpy(), x)
+    np.testing.assert_equal(tvm.runtime.ndarray.from_dlpack(a).numpy(), x)
+
+
+@tvm.testing.requires_cuda
+@tvm.testing.requires_package("torch")
+def test_dlpack_stream_torch_cuda():
+    import torch
+
+    n = 1 << 20
+    A = te.placeholder((n,), name="A")
+    B = te.compute(A.shape, lambda i: A[i] * 2.0, name="B")
+    s = te.create_schedule(B.op)
+    bx, tx = s[B].split(B.op.axis[0], factor=256)
+    s[B].bind(bx, te.thread_axis("blockIdx.x"))
+    s[B].bind(tx, te.thread_axis("threadIdx.x"))
+    fdouble = tvm.build(s, [A, B], "cuda")
+
+    dev = tvm.cuda(0)
+    side = torch.cuda.Stream()
+    with torch.cuda.stream(side):
+        # Produced on a side stream, the import orders it before the current stream of TVM.
+        x = torch.arange(n, dtype=torch.float32, device="cuda") + 1
+        a = tvm.runtime.ndarray.from_dlpack(x)
+        b = tvm.nd.empty((n,), "float32", dev)
+        fdouble(a, b)
+        # Consumed on the side stream, the export orders the current stream of TVM before it.
+        y = torch.from_dlpack(b) + 1
+    side.synchronize()
+    torch.testing.assert_close(y.cpu(), (torch.arange(n, dtype=torch.float32) + 1) * 2 + 1)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
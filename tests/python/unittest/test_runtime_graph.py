@@ -15,6 +15,8 @@
 # specific language governing permissions and limitations
 # under the License.
 import tempfile
+
+import pytest
 import tvm
 import tvm.testing
 from tvm import te, runtime
@@ -119,6 +121,201 @@ def test_graph_simple():
     check_sharing()
 
 
+def test_inter_op_threads():
+    shape = (8, 16)
+    x = relay.var("x", shape=shape)
+    branches = [relay.nn.relu(x * relay.const(float(i + 1))) for i in range(4)]
+    out = relay.add(relay.add(branches[0], branches[1]), relay.add(branches[2], branches[3]))
+    out = relay.sigmoid(out) + x
+    func = relay.Function([x], out)
+    graph, lib, params = relay.build(tvm.IRModule.from_expr(func), target="llvm")
+
+    x_in = np.random.uniform(-1, 1, size=shape).astype("float32")
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    mod.run(x=x_in)
+    expected = mod.get_output(0).numpy()
+
+    for num_threads in [2, 4, 1]:
+        mod.set_inter_op_threads(num_threads)
+        for _ in range(10):
+            mod.run(x=x_in)
+            tvm.testing.assert_allclose(mod.get_output(0).numpy(), expected, rtol=1e-6)
+
+
+def test_replica_pool():
+    x = relay.var("x", shape=(1, 10))
+    y = relay.var("y", shape=(1, 10))
+    func = relay.Function([x, y], relay.nn.relu(relay.add(x, y)))
+    y_in = np.random.uniform(size=(1, 10)).astype("float32")
+    graph, lib, params = relay.build(func, target="llvm", params={"y": y_in})
+    base = graph_executor.create(graph, lib, tvm.cpu(0))
+    base.load_params(runtime.save_param_dict(params))
+
+    pool = graph_executor.GraphModulePool(base, max_size=2)
+    first = pool.checkout()
+    second = pool.checkout()
+    assert pool.num_replicas == 2
+    inputs = [np.random.uniform(-1, 1, size=(1, 10)).astype("float32") for _ in range(2)]
+    for mod, x_in in zip([first, second], inputs):
+        mod.set_input("x", x_in)
+    for mod, x_in in zip([first, second], inputs):
+        mod.run()
+        np.testing.assert_allclose(mod.get_output(0).numpy(), np.maximum(x_in + y_in, 0))
+    pool.checkin(first)
+    pool.checkin(second)
+
+    # Returned replicas are reused.
+    with pool.replica() as mod:
+        mod.set_input("x", inputs[0])
+        mod.run()
+        np.testing.assert_allclose(mod.get_output(0).numpy(), np.maximum(inputs[0] + y_in, 0))
+    assert pool.num_replicas == 2
+
+
+def test_sampled_profile():
+    x = relay.var("x", shape=(8, 16))
+    func = relay.Function([x], relay.sigmoid(relay.nn.relu(x) * relay.const(2.0)))
+    graph, lib, params = relay.build(tvm.IRModule.from_expr(func), target="llvm")
+    mod = graph_executor.create(graph, lib, tvm.cpu(0))
+    x_in = np.random.uniform(-1, 1, size=(8, 16)).astype("float32")
+
+    assert len(mod.get_sampled_profile().calls) == 0
+    mod.set_sampling_interval(4)
+    for _ in range(10):
+        mod.run(x=x_in)
+    report = mod.get_sampled_profile()
+    assert report.configuration["Sampled Requests"].value == 3
+    assert len(report.calls) > 0
+    for call in report.calls:
+        assert call["Count"].value == 3
+        assert 0 <= call["p50 (us)"].microseconds <= call["p99 (us)"].microseconds
+    assert "p99 (us)" in report.table()
+
+    mod.set_sampling_interval(0)
+    mod.run(x=x_in)
+    assert len(mod.get_sampled_profile().calls) == 0
+
+
+def test_graph_binary():
+    x = relay.var("x", shape=(2, 8))
+    y = relay.var("y", shape=(2, 8))
+    out = relay.nn.relu(relay.multiply(relay.add(x, y), relay.const(2.0)))
+    func = relay.Function([x, y], relay.reshape(out, (4, 4)))
+    lib = relay.build(tvm.IRModule.from_expr(func), target="llvm")
+    graph_binary = lib.get_graph_binary()
+    assert bytes(graph_binary[:8]) == b"TVMGRAPH"
+
+    x_in = np.random.uniform(-1, 1, size=(2, 8)).astype("float32")
+    y_in = np.random.uniform(-1, 1, size=(2, 8)).astype("float32")
+    outputs = []
+    for graph in [lib.get_graph_json(), graph_binary]:
+        mod = graph_executor.create(graph, lib.lib, tvm.cpu(0))
+        mod.run(x=x_in, y=y_in)
+        outputs.append(mod.get_output(0).numpy())
+        assert mod.get_input_info()["shape"]["x"] == (2, 8)
+    np.testing.assert_equal(outputs[0], outputs[1])
+    np.testing.assert_allclose(outputs[1], np.maximum((x_in + y_in) * 2, 0).reshape(4, 4))
+
+
+def test_graph_flat():
+    x = relay.var("x", shape=(2, 8))
+    func = relay.Function([x], relay.reshape(relay.nn.relu(x), (4, 4)))
+    lib = relay.build(tvm.IRModule.from_expr(func), target="llvm")
+    graph_flat = bytes(lib.get_graph_flat())
+    assert graph_flat[:8] == b"TVMGFLAT"
+    header = np.frombuffer(graph_flat[8:64], dtype="<u4")
+    nodes_count, input_nodes_count, _, outputs_count, entries_count, shape_stride = header[:6]
+    graph = json.loads(lib.get_graph_json())
+    assert nodes_count == len(graph["nodes"])
+    assert input_nodes_count == len(graph["arg_nodes"])
+    assert outputs_count == len(graph["heads"])
+    assert entries_count == graph["node_row_ptr"][-1]
+    assert shape_stride == 2
+    # Every table starts 8-byte aligned, so the CRT can use it in place.
+    assert all(offset % 8 == 0 for offset in header[6:])
+    shape_offset = header[13]
+    shapes = np.frombuffer(graph_flat, dtype="<i8", offset=shape_offset, count=entries_count * 2)
+    np.testing.assert_equal(shapes.reshape(-1, 2), graph["attrs"]["shape"][1])
+
+
+def test_load_params_from_file():
+    x = relay.var("x", shape=(1, 10))
+    y = relay.var("y", shape=(1, 10))
+    w = relay.var("w", shape=(1, 10), dtype="int32")
+    out = relay.add(relay.add(x, y), relay.cast(w, "float32"))
+    lib = relay.build(tvm.IRModule.from_expr(relay.Function([x, y, w], out)), target="llvm")
+    y_in = np.random.uniform(-1, 1, size=(1, 10)).astype("float32")
+    w_in = np.arange(10, dtype="int32").reshape(1, 10)
+    temp = utils.tempdir()
+    path = temp.relpath("params")
+    with open(path, "wb") as f:
+        f.write(runtime.save_param_dict({"y": y_in, "w": w_in, "unused": np.ones((3,))}))
+
+    x_in = np.random.uniform(-1, 1, size=(1, 10)).astype("float32")
+    for lazy in [False, True]:
+        mod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+        mod.load_params_from_file(path, lazy=lazy)
+        mod.run(x=x_in)
+        np.testing.assert_allclose(mod.get_output(0).numpy(), x_in + y_in + w_in, rtol=1e-6)
+
+
+def test_load_params_converts_float_dtype():
+    x = relay.var("x", shape=(4, 16), dtype="float16")
+    w = relay.var("w", shape=(4, 16), dtype="float16")
+    lib = relay.build(tvm.IRModule.from_expr(relay.Function([x, w], relay.add(x, w))), "llvm")
+    # The weights are saved in float32 and converted to the float16 of the graph when loaded.
+    w_in = np.random.uniform(-1, 1, size=(4, 16)).astype("float32")
+    temp = utils.tempdir()
+    path = temp.relpath("params")
+    with open(path, "wb") as f:
+        f.write(runtime.save_param_dict({"w": w_in}))
+
+    x_in = np.random.uniform(-1, 1, size=(4, 16)).astype("float16")
+    for lazy in [False, True]:
+        mod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+        mod.load_params_from_file(path, lazy=lazy)
+        mod.run(x=x_in)
+        np.testing.assert_equal(mod.get_output(0).numpy(), x_in + w_in.astype("float16"))
+
+
+def test_run_async():
+    x = relay.var("x", shape=(4, 16))
+    y = relay.var("y", shape=(4, 16))
+    out = relay.Tuple([relay.add(x, y), relay.multiply(x, y)])
+    lib = relay.build(tvm.IRModule.from_expr(relay.Function([x, y], out)), "llvm")
+    mod = graph_executor.GraphModule(lib["default"](tvm.cpu(0)))
+
+    inputs = [
+        [np.random.uniform(size=(4, 16)).astype("float32") for _ in range(2)] for _ in range(8)
+    ]
+    # The runs are queued without waiting, and each one gets its own copy of the outputs.
+    futures = [mod.run_async(x=x_in, y=y_in) for x_in, y_in in inputs]
+    for (x_in, y_in), future in zip(inputs, futures):
+        added, multiplied = future.result()
+        tvm.testing.assert_allclose(added.numpy(), x_in + y_in)
+        tvm.testing.assert_allclose(multiplied.numpy(), x_in * y_in)
+
+    with pytest.raises(tvm.TVMError):
+        mod.run_async(z=inputs[0][0])
+
+
+@tvm.testing.parametrize_targets("llvm", "cuda", "opencl")
+def test_warmup(target, dev):
+    x = relay.var("x", shape=(4, 16))
+    y = relay.var("y", shape=(4, 16))
+    out = relay.add(relay.exp(x), y)
+    lib = relay.build(tvm.IRModule.from_expr(relay.Function([x, y], out)), target)
+    mod = graph_executor.GraphModule(lib["default"](dev))
+
+    # Warming up twice is harmless and leaves the executor ready to run.
+    mod.warmup()
+    mod.warmup()
+    x_in = np.random.uniform(size=(4, 16)).astype("float32")
+    y_in = np.random.uniform(size=(4, 16)).astype("float32")
+    mod.run(x=x_in, y=y_in)
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), np.exp(x_in) + y_in, rtol=1e-5)
+
+
 def test_load_unexpected_params():
     # Test whether graph_executor.load_params works if parameters
     # are provided that are not an expected input.
@@ -24,7 +24,7 @@ import pytest
 
 import tvm
 import tvm.testing
-from tvm import te
+from tvm import te, relay
 import numpy as np
 
 from tvm.contrib import utils, graph_executor
@@ -96,5 +96,61 @@ def test_graph_simple():
     check_verify()
 
 
+@tvm.testing.requires_cudagraph
+def test_multi_stream():
+    shape = (64, 64)
+    x = relay.var("x", shape=shape)
+    branches = [relay.nn.relu(x * relay.const(float(i + 1))) for i in range(4)]
+    out = relay.add(relay.add(branches[0], branches[1]), relay.add(branches[2], branches[3]))
+    func = relay.Function([x], relay.sigmoid(out))
+    with tvm.transform.PassContext(opt_level=0):
+        graph, lib, _ = relay.build(tvm.IRModule.from_expr(func), target="cuda")
+    dev = tvm.cuda(0)
+    x_in = np.random.uniform(-1, 1, size=shape).astype("float32")
+
+    ref = graph_executor.create(graph, lib, dev)
+    ref.run(x=x_in)
+    expected = ref.get_output(0).numpy()
+
+    mod = graph_executor.create(graph, lib, dev)
+    mod.set_num_streams(3)
+    for _ in range(3):
+        mod.run(x=x_in)
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), expected, rtol=1e-5)
+
+    mod = cuda_graph_executor.create(graph, lib, dev)
+    mod.set_num_streams(3)
+    for _ in range(3):
+        mod.run(x=x_in)  # The first run captured the multi-stream schedule
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), expected, rtol=1e-5)
+
+
+@tvm.testing.requires_cudagraph
+def test_zero_copy_rebinding():
+    shape = (16, 16)
+    x = relay.var("x", shape=shape)
+    func = relay.Function([x], relay.nn.relu(x) + relay.const(1.0))
+    graph, lib, _ = relay.build(tvm.IRModule.from_expr(func), target="cuda")
+    dev = tvm.cuda(0)
+
+    mod = cuda_graph_executor.create(graph, lib, dev)
+    mod.set_cuda_graph_cache_size(2)
+    mod.run(x=np.zeros(shape, "float32"))
+    inputs = [
+        tvm.nd.array(np.random.uniform(-1, 1, shape).astype("float32"), dev) for _ in range(3)
+    ]
+    outputs = [tvm.nd.empty(shape, "float32", dev) for _ in range(3)]
+    # Cycle through more bindings than the cache holds, so graphs are also updated in place.
+    for _ in range(2):
+        for x_nd, out_nd in zip(inputs, outputs):
+            mod.set_input_zero_copy("x", x_nd)
+            mod.set_output_zero_copy(0, out_nd)
+            mod.run_cuda_graph()
+            expected = np.maximum(x_nd.numpy(), 0) + 1
+            tvm.testing.assert_allclose(out_nd.numpy(), expected, rtol=1e-6)
+
+
 if __name__ == "__main__":
     test_graph_simple()
+    test_multi_stream()
+    test_zero_copy_rebinding()
@@ -275,6 +275,30 @@ def test_run_single_node(graph, n, A, myadd):
         mod.run_individual_node(2)
 
 
+@tvm.testing.requires_llvm
+@pytest.mark.skipif(
+    tvm.support.libinfo()["USE_PROFILER"] != "ON", reason="TVM was not built with profiler support"
+)
+def test_run_pipelined(graph, n, A, myadd):
+    mlib_proxy = tvm.support.FrontendTestModule()
+    mlib_proxy["myadd"] = myadd
+    mod: debug_executor.GraphModuleDebug = debug_executor.create(graph, mlib_proxy, tvm.cpu(0))
+
+    a = np.random.uniform(size=(n,)).astype(A.dtype)
+    mod.set_input(x=a)
+
+    results = mod.run_pipelined(number=5, warmup=1)
+    assert len(results) == 2
+    # The param node has no associated function
+    assert results[0].mean == 0
+    assert results[1].mean > 0
+    assert len(results[1].results) == 5
+    assert results[1].min <= results[1].percentile(50) <= results[1].max
+
+    with pytest.raises(TVMError):
+        mod.run_pipelined(number=0)
+
+
 @tvm.testing.requires_llvm
 def test_multiple_output():
     x = relay.var("x", shape=(1, 3, 48, 16), dtype="float32")
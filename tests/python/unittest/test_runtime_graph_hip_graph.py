@@ -0,0 +1,77 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import relay
+from tvm.contrib import graph_executor
+from tvm.contrib.hip_graph import hip_graph_executor
+
+
+@tvm.testing.requires_hipgraph
+def test_graph_simple():
+    shape = (64, 64)
+    x = relay.var("x", shape=shape)
+    func = relay.Function([x], relay.sigmoid(relay.nn.relu(x) * relay.const(2.0)))
+    graph, lib, _ = relay.build(tvm.IRModule.from_expr(func), target="rocm")
+    dev = tvm.rocm(0)
+
+    ref = graph_executor.create(graph, lib, dev)
+    mod = hip_graph_executor.create(graph, lib, dev)
+    for _ in range(3):
+        x_in = np.random.uniform(-1, 1, size=shape).astype("float32")
+        ref.run(x=x_in)
+        mod.run(x=x_in)  # The first run captured a HIP graph
+        tvm.testing.assert_allclose(mod.get_output(0).numpy(), ref.get_output(0).numpy())
+
+    # capture / run HIP graph manually
+    mod.capture_hip_graph()
+    x_in = np.random.uniform(-1, 1, size=shape).astype("float32")
+    ref.run(x=x_in)
+    mod.set_input(x=x_in)
+    mod.run_hip_graph()
+    tvm.testing.assert_allclose(mod.get_output(0).numpy(), ref.get_output(0).numpy())
+
+
+@tvm.testing.requires_hipgraph
+def test_zero_copy_rebinding():
+    shape = (16, 16)
+    x = relay.var("x", shape=shape)
+    func = relay.Function([x], relay.nn.relu(x) + relay.const(1.0))
+    graph, lib, _ = relay.build(tvm.IRModule.from_expr(func), target="rocm")
+    dev = tvm.rocm(0)
+
+    mod = hip_graph_executor.create(graph, lib, dev)
+    mod.set_hip_graph_cache_size(2)
+    mod.run(x=np.zeros(shape, "float32"))
+    inputs = [
+        tvm.nd.array(np.random.uniform(-1, 1, shape).astype("float32"), dev) for _ in range(3)
+    ]
+    outputs = [tvm.nd.empty(shape, "float32", dev) for _ in range(3)]
+    # Cycle through more bindings than the cache holds, so graphs are also updated in place.
+    for _ in range(2):
+        for x_nd, out_nd in zip(inputs, outputs):
+            mod.set_input_zero_copy("x", x_nd)
+            mod.set_output_zero_copy(0, out_nd)
+            mod.run_hip_graph()
+            expected = np.maximum(x_nd.numpy(), 0) + 1
+            tvm.testing.assert_allclose(out_nd.numpy(), expected, rtol=1e-6)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
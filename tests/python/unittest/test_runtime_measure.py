@@ -57,6 +57,34 @@ def test_min_repeat_ms():
     assert ct > 10 + 2
 
 
+def test_adaptive_repeat():
+    @tvm.register_func
+    def my_sleep():
+        """one call lasts for at least 5 ms"""
+        time.sleep(0.005)
+
+    X = te.compute((), lambda: tvm.tir.call_packed("my_sleep"))
+    s = te.create_schedule(X.op)
+    func = tvm.build(s, [X])
+    x = tvm.nd.empty((), dtype="int32")
+
+    # A loose interval is reached after the first repeats.
+    ftimer = func.time_evaluator(
+        func.entry_name, tvm.cpu(), number=1, repeat=3, max_rel_ci=10.0, max_measure_ms=10000
+    )
+    assert len(ftimer(x).results) == 3
+
+    # An interval that is never reached stops at the time cap.
+    ftimer = func.time_evaluator(
+        func.entry_name, tvm.cpu(), number=1, repeat=3, max_rel_ci=1e-12, max_measure_ms=200
+    )
+    tic = time.time()
+    results = ftimer(x).results
+    assert len(results) > 3
+    assert time.time() - tic < 5
+    assert all(r >= 0.005 for r in results)
+
+
 def test_benchmark_result():
     r = BenchmarkResult([1, 2, 2, 5])
     assert r.mean == 2.5
@@ -68,4 +96,5 @@ def test_benchmark_result():
 
 if __name__ == "__main__":
     test_min_repeat_ms()
+    test_adaptive_repeat()
     test_benchmark_result()
@@ -95,6 +95,21 @@ def test_mod_export():
         #  dso modules are merged together
         assert len(loaded_lib.imported_modules) == 1
 
+        # The packed imports are decoded on their first use.
+        path_compressed = temp.relpath("compressed_" + file_name)
+        synthetic_gpu_lib.export_library(path_compressed, compress_imports="lz4")
+        loaded_lib = tvm.runtime.load_module(path_compressed)
+        assert loaded_lib.imported_modules[0].type_key == "cuda"
+        kernel_names = synthetic_gpu_lib.imported_modules[0].get_function("get_func_names")()
+        loaded_names = loaded_lib.imported_modules[0].get_function("get_func_names")()
+        assert set(kernel_names) == set(loaded_names)
+
+        # Without lazy imports, the imports are decoded when the library is loaded.
+        path_eager = temp.relpath("eager_" + file_name)
+        synthetic_gpu_lib.export_library(path_eager, lazy_imports=False)
+        loaded_lib = tvm.runtime.load_module(path_eager)
+        assert loaded_lib.imported_modules[0].type_key == "cuda"
+
     def verify_multi_dso_mod_export(obj_format):
         for device in ["llvm"]:
             if not tvm.testing.device_enabled(device):
@@ -138,6 +138,34 @@ def test_papi(target, dev):
     assert any([float(x) > 0 for x in csv[metric]])
 
 
+@tvm.testing.requires_cuda
+@pytest.mark.skipif(
+    tvm.get_global_func("runtime.profiling.CUPTIMetricCollector", allow_missing=True) is None,
+    reason="CUPTI profiling not enabled",
+)
+def test_cupti():
+    dev = tvm.cuda()
+    mod, params = mlp.get_workload(1)
+    exe = relay.build(mod, "cuda", params=params)
+    gr = debug_executor.create(exe.get_graph_json(), exe.lib, dev)
+
+    data = np.random.rand(1, 1, 28, 28).astype("float32")
+    metric = "smsp__inst_executed.sum"
+    report = gr.profile(
+        data=data, collectors=[tvm.runtime.profiling.CUPTIMetricCollector({dev: [metric]})]
+    )
+    csv = read_csv(report)
+    assert list(csv.keys()).count(metric) == 1
+    assert any([float(x) > 0 for x in csv[metric] if x])
+
+    # Devices without metric names collect the default metrics.
+    report = gr.profile(data=data, collectors=[tvm.runtime.profiling.CUPTIMetricCollector()])
+    csv = read_csv(report)
+    assert "dram__bytes.sum" in csv.keys()
+    assert any([float(x) > 0 for x in csv["dram__bytes.sum"] if x])
+    assert "sm__warps_active.avg.pct_of_peak_sustained_active" in csv.keys()
+
+
 @tvm.testing.requires_llvm
 def test_json():
     mod, params = mlp.get_workload(1)
@@ -217,6 +245,30 @@ def test_report_serialization():
     )
 
 
+@tvm.testing.requires_llvm
+def test_chrome_trace():
+    mod, params = mlp.get_workload(1)
+    exe = relay.build(mod, "llvm", params=params)
+    gr = debug_executor.create(exe.get_graph_json(), exe.lib, tvm.cpu())
+
+    data = np.random.rand(1, 1, 28, 28).astype("float32")
+    report = gr.profile(data=data)
+    trace = json.loads(report.chrome_trace())
+    events = [e for e in trace["traceEvents"] if e["ph"] == "X"]
+    assert len(events) == len(report.calls) + 1
+    total = [e for e in events if e["name"] == "Total"][0]
+    for event in events:
+        assert event["ts"] >= total["ts"]
+        assert event["dur"] >= 0
+    assert any(e["name"].startswith("fused_nn_softmax") for e in events)
+    processes = [e for e in trace["traceEvents"] if e["ph"] == "M"]
+    assert [p["args"]["name"] for p in processes] == ["cpu0"]
+    # The timeline survives serialization, but not the table.
+    trace2 = json.loads(Report.from_json(report.json()).chrome_trace())
+    assert len(trace2["traceEvents"]) == len(trace["traceEvents"])
+    assert "Start (us)" not in report.table()
+
+
 @T.prim_func
 def axpy_cpu(a: T.handle, b: T.handle, c: T.handle) -> None:
     A = T.match_buffer(a, [10], "float64")
@@ -109,6 +109,32 @@ def test_rpc_simple():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_async_call():
+    server = rpc.Server(key="x1")
+    client = rpc.connect("127.0.0.1", server.port, key="x1")
+
+    def check(sess):
+        faddone = sess.get_function_async("rpc.test.addone")
+        fexcept = sess.get_function_async("rpc.test.except")
+        fstrcat = sess.get_function_async("rpc.test.strcat")
+        # More calls than the requests kept in flight.
+        futures = [faddone(i) for i in range(40)]
+        failed = fexcept("abc")
+        joined = fstrcat("abc", 11)
+        # A blocking call completes the calls in flight first.
+        assert sess.get_function("rpc.test.addone")(1) == 2
+        assert [future() for future in futures] == list(range(1, 41))
+        with pytest.raises(tvm._ffi.base.TVMError):
+            failed()
+        assert joined() == "abc:11"
+        # The future can be waited on again.
+        assert futures[0]() == 1
+
+    check(client)
+    check(rpc.LocalSession())
+
+
 @tvm.testing.requires_rpc
 def test_rpc_simple_wlog():
     server = rpc.Server(key="x1")
@@ -176,6 +202,26 @@ def test_rpc_large_array():
     check_remote()
 
 
+@tvm.testing.requires_rpc
+def test_rpc_chunked_array():
+    # the copies of arrays larger than a chunk are streamed in chunks
+    server = rpc.Server()
+    remote = rpc.connect("127.0.0.1", server.port)
+
+    def check_remote():
+        dev = remote.cpu(0)
+        a_np = np.random.uniform(size=(1000, 1111)).astype("float32")
+        a = tvm.nd.array(a_np, dev)
+        b = tvm.nd.empty(a_np.shape, "float32", dev)
+        a.copyto(b)
+        np.testing.assert_equal(b.numpy(), a_np)
+        b.copyfrom(a_np[::-1].copy())
+        np.testing.assert_equal(b.numpy(), a_np[::-1])
+        np.testing.assert_equal(a.numpy(), a_np)
+
+    check_remote()
+
+
 @tvm.testing.skip_if_32bit(reason="skipping test for i386.")
 @tvm.testing.requires_rpc
 def test_rpc_echo():
@@ -435,6 +481,30 @@ def test_rpc_return_ndarray():
     run_arr_test()
 
 
+@tvm.testing.requires_rpc
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="shared memory RPC is Linux only")
+def test_shm_session():
+    client = rpc.ShmSession()
+
+    def check_remote():
+        f1 = client.get_function("rpc.test.addone")
+        assert f1(10) == 11
+        f2 = client.get_function("rpc.test.strcat")
+        assert f2("abc", 11) == "abc:11"
+
+        # larger than the rings, so that the copies wrap around them
+        dev = client.cpu(0)
+        a_np = np.random.uniform(size=(1500, 1111)).astype("float32")
+        a = tvm.nd.array(a_np, dev)
+        np.testing.assert_equal(a.numpy(), a_np)
+
+        blob = bytearray(np.random.randint(0, 10, size=(10)))
+        client.upload(blob, "dat.bin")
+        assert client.download("dat.bin") == blob
+
+    check_remote()
+
+
 @tvm.testing.requires_rpc
 def test_local_func():
     client = rpc.LocalSession()
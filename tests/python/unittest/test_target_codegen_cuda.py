@@ -1044,5 +1044,53 @@ def test_try_unaligned_vector_load():
     assert np.allclose(c, expected), f"expected={expected}\nactual={c}"
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_staged_pageable_copy():
+    dev = tvm.cuda(0)
+    # Chunk sizes and remainders of the pinned staging buffers.
+    for num_bytes in [1 << 16, (4 << 20) + 12, 3 * (4 << 20)]:
+        np_data = np.random.randint(0, 255, size=num_bytes, dtype="uint8")
+        arr = tvm.nd.array(np_data, dev)
+        tvm.testing.assert_allclose(arr.numpy(), np_data)
+        part = np.random.randint(0, 255, size=num_bytes, dtype="uint8")
+        arr.copyfrom(part)
+        tvm.testing.assert_allclose(arr.numpy(), part)
+
+
+@tvm.testing.requires_gpu
+@tvm.testing.requires_cuda
+def test_cuda_compile_cache(tmp_path):
+    n = 64
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    s[B].bind(B.op.axis[0], tx)
+    dev = tvm.cuda(0)
+    sass_arch = "sm_" + dev.compute_version.replace(".", "")
+
+    def build(config):
+        with tvm.transform.PassContext(config=config):
+            return tvm.build(s, [A, B], "cuda")
+
+    cache_dir = str(tmp_path)
+    first = build({"cuda.compile_cache_dir": cache_dir})
+    entries = sorted(tmp_path.iterdir())
+    assert len(entries) == 1
+    mtime = entries[0].stat().st_mtime_ns
+    second = build({"cuda.compile_cache_dir": cache_dir})
+    # The second build hits the entry written by the first one.
+    assert sorted(tmp_path.iterdir()) == entries
+    assert entries[0].stat().st_mtime_ns == mtime
+    sass = build({"cuda.compile_cache_dir": cache_dir, "cuda.sass_archs": [sass_arch]})
+    assert len(list(tmp_path.iterdir())) == 2
+
+    a = tvm.nd.array(np.random.uniform(size=n).astype(A.dtype), dev)
+    for mod in [first, second, sass]:
+        b = tvm.nd.empty((n,), B.dtype, dev)
+        mod(a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -18,6 +18,7 @@ import collections
 import ctypes
 import json
 import math
+import os
 import numpy as np
 import pytest
 import re
@@ -1109,5 +1110,94 @@ def test_call_extern_returning_void():
     built = tvm.build(func, target="llvm")
 
 
+@tvm.testing.requires_llvm
+def test_llvm_sharded_build():
+    n = 64
+    A = te.placeholder((n,), name="A")
+    funcs = {}
+    for i, fcompute in enumerate(
+        [lambda x: x + 1, lambda x: x * 2, lambda x: te.exp(x), lambda x: x - 3, lambda x: x / 5]
+    ):
+        B = te.compute((n,), lambda j: fcompute(A[j]), name="B")
+        funcs["func%d" % i] = te.create_prim_func([A, B]).with_attr("global_symbol", "func%d" % i)
+    mod = tvm.IRModule(funcs)
+    with tvm.transform.PassContext(config={"codegen.llvm.num_shards": 3}):
+        lib = tvm.build(mod, target="llvm")
+    # The shards are imported by the module holding the entry function.
+    assert len(lib.imported_modules) == 2
+    assert all(lib.implements_function("func%d" % i, True) for i in range(len(funcs)))
+
+    temp = utils.tempdir()
+    path_dso = temp.relpath("sharded.so")
+    lib.export_library(path_dso)
+    loaded = tvm.runtime.load_module(path_dso)
+    a_np = np.random.uniform(size=n).astype(A.dtype)
+    expected = [a_np + 1, a_np * 2, np.exp(a_np), a_np - 3, a_np / 5]
+    for i in range(len(funcs)):
+        for f in [lib, loaded]:
+            a = tvm.nd.array(a_np)
+            b = tvm.nd.empty((n,), A.dtype)
+            f["func%d" % i](a, b)
+            tvm.testing.assert_allclose(b.numpy(), expected[i], rtol=1e-5)
+
+
+@tvm.testing.requires_llvm
+def test_llvm_object_cache():
+    n = 64
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] * 2 + 1, name="B")
+    func = te.create_prim_func([A, B]).with_attr("global_symbol", "main")
+    temp = utils.tempdir()
+    cache_dir = temp.relpath("cache")
+
+    def build_and_run(index):
+        with tvm.transform.PassContext(config={"codegen.llvm.object_cache_dir": cache_dir}):
+            lib = tvm.build(func, target="llvm")
+        path_dso = temp.relpath("lib%d.so" % index)
+        lib.export_library(path_dso)
+        a_np = np.random.uniform(size=n).astype(A.dtype)
+        for f in [lib, tvm.runtime.load_module(path_dso)]:
+            a = tvm.nd.array(a_np)
+            b = tvm.nd.empty((n,), A.dtype)
+            f(a, b)
+            tvm.testing.assert_allclose(b.numpy(), a_np * 2 + 1)
+
+    build_and_run(0)
+    entries = sorted(name for name in os.listdir(cache_dir) if name.startswith("llvmcache-"))
+    # One entry for the object file and one for the JIT.
+    assert len(entries) == 2
+    build_and_run(1)
+    assert sorted(name for name in os.listdir(cache_dir) if name.startswith("llvmcache-")) == entries
+
+
+@tvm.testing.requires_llvm
+def test_llvm_gather_scatter():
+    n, m = 64, 16
+
+    @T.prim_func
+    def func(
+        table: T.Buffer((n,), "float32"),
+        ids: T.Buffer((m,), "int32"),
+        out: T.Buffer((n,), "float32"),
+    ):
+        T.func_attr({"global_symbol": "main", "tir.noalias": True})
+        for i in T.vectorized(m):
+            out[ids[i]] = table[ids[i]] * T.float32(2)
+
+    ids_np = np.random.permutation(n)[:m].astype("int32")
+    table_np = np.random.uniform(size=n).astype("float32")
+    expected = np.zeros(n, "float32")
+    expected[ids_np] = table_np[ids_np] * 2
+    for gather_scatter in [True, False]:
+        target = "llvm -gather-scatter=%d" % gather_scatter
+        f = tvm.build(func, target=target)
+        ll = f.get_source("ll")
+        assert ("llvm.masked.gather" in ll) == gather_scatter
+        assert ("llvm.masked.scatter" in ll) == gather_scatter
+        out = tvm.nd.array(np.zeros(n, "float32"))
+        f(tvm.nd.array(table_np), tvm.nd.array(ids_np), out)
+        tvm.testing.assert_allclose(out.numpy(), expected)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
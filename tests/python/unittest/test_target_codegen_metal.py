@@ -169,5 +169,34 @@ def test_vectorized_uint8():
     np.testing.assert_allclose(b_nd.numpy(), a.astype("float32"), atol=1e-5, rtol=1e-5)
 
 
+@tvm.testing.requires_gpu
+@tvm.testing.requires_metal
+def test_batched_dispatches():
+    @T.prim_func
+    def func(A: T.Buffer((16), "float32")):
+        for i in T.thread_binding(16, thread="threadIdx.x"):
+            with T.block("block"):
+                vi = T.axis.spatial(16, i)
+                A[vi] = A[vi] + T.float32(1)
+
+    dev = tvm.metal()
+    a_nd = tvm.nd.array(np.zeros(16, "float32"), dev)
+    f = tvm.build(func, target="metal")
+    # More dispatches than fit in one command buffer, each sees the writes of the previous ones.
+    for _ in range(200):
+        f(a_nd)
+    np.testing.assert_allclose(a_nd.numpy(), np.full(16, 200, "float32"))
+
+    get_host_view = tvm.get_global_func("metal.HostView")
+    try:
+        view = get_host_view(a_nd)
+    except tvm.TVMError:
+        return  # the device does not have unified memory
+    assert view.device == tvm.cpu()
+    f(a_nd)
+    view = get_host_view(a_nd)
+    np.testing.assert_allclose(view.numpy(), np.full(16, 201, "float32"))
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -611,8 +611,7 @@ def test_negative_operand_divmod(target, dev):
     np.testing.assert_array_equal(a[:, 1], (np.arange(N) - offset) % divisor)
 
 
-@pytest.mark.parametrize("out_dtype", ["float32", "float16"])
-def test_cooperative_matrix(out_dtype):
+def _schedule_cooperative_matrix(M, N, K, out_dtype):
     def get_matmul(m, n, k, out_dtype="float32"):
         X = te.placeholder((m, k), name="X", dtype="float16")
         W = te.placeholder((k, n), name="W", dtype="float16")
@@ -636,7 +635,6 @@ def test_cooperative_matrix(out_dtype):
 
         return te.create_prim_func([X, W, matmul])
 
-    M, N, K = 16, 16, 32
     func = get_matmul(M, N, K, out_dtype)
     sch = Schedule(func)
     block = sch.get_block("compute")
@@ -706,11 +704,20 @@ def test_cooperative_matrix(out_dtype):
     if out_dtype == "float16":
         intrin = WMMA_SYNC_16x16x16_f16f16f16_INTRIN
     sch.tensorize(sch.get_loops(block)[2], intrin)
+    return sch
+
+
+@pytest.mark.parametrize("out_dtype", ["float32", "float16"])
+def test_cooperative_matrix(out_dtype):
+    M, N, K = 16, 16, 32
+    sch = _schedule_cooperative_matrix(M, N, K, out_dtype)
 
     target = "vulkan -from_device=0"
     tgt_attrs = tvm.target.Target(target).attrs
 
-    if tgt_attrs.get("supports_cooperative_matrix"):
+    if tgt_attrs.get("supports_cooperative_matrix") or tgt_attrs.get(
+        "supports_cooperative_matrix_khr"
+    ):
         f = tvm.build(sch.mod, target=target)
 
         dev = tvm.device(target, 0)
@@ -728,6 +735,36 @@ def test_cooperative_matrix(out_dtype):
         tvm.testing.assert_allclose(C.numpy(), ref, rtol=1e-2, atol=1e-2)
 
 
+@tvm.testing.requires_vulkan(support_required="compile-only")
+@pytest.mark.skipif(
+    tvm.support.libinfo().get("USE_SPIRV_KHR_COOPERATIVE_MATRIX") != "ON",
+    reason="TVM was not built with SPV_KHR_cooperative_matrix support",
+)
+def test_cooperative_matrix_khr_codegen():
+    """The KHR cooperative matrix instructions are preferred over the NV ones"""
+    sch = _schedule_cooperative_matrix(16, 16, 32, "float32")
+    target = " ".join(
+        [
+            "vulkan",
+            "-supports_float16=1",
+            "-supports_16bit_buffer=1",
+            "-supports_storage_buffer_storage_class=1",
+            "-supports_cooperative_matrix=1",
+            "-supports_cooperative_matrix_khr=1",
+        ]
+    )
+    f = tvm.build(sch.mod, target=target)
+    assembly = f.imported_modules[0].get_source()
+
+    assert "OpCapability CooperativeMatrixKHR" in assembly
+    assert "CooperativeMatrixNV" not in assembly
+    # The A, B and accumulator fragments each have a type of their own.
+    assert len(re.findall("OpTypeCooperativeMatrixKHR", assembly)) == 3
+    assert len(re.findall("OpCooperativeMatrixLoadKHR", assembly)) == 2
+    assert len(re.findall("OpCooperativeMatrixMulAddKHR", assembly)) == 1
+    assert len(re.findall("OpCooperativeMatrixStoreKHR", assembly)) == 1
+
+
 @tvm.testing.requires_vulkan(support_required="compile-only")
 def test_codegen_decl_buffer():
     """The codegen should accept DeclBuffer nodes in its input"""
@@ -59,7 +59,41 @@ def test_split_uneven_unique_likely():
     assert isinstance(stmt.body.body, tvm.tir.stmt.IfThenElse)
 
 
+def test_build_cache():
+    import numpy as np
+
+    def lower_add(name, value):
+        A = te.placeholder((16,), name="A")
+        B = te.compute(A.shape, lambda i: A[i] + value, name="B")
+        return tvm.lower(te.create_schedule(B.op), [A, B], name=name)
+
+    def build(value):
+        mod = tvm.IRModule({})
+        mod.update(lower_add("add_one", 1.0))
+        mod.update(lower_add("add_other", value))
+        return tvm.build(mod, target="llvm", build_cache=cache)
+
+    cache = tvm.driver.BuildCache()
+    build(2.0)
+    assert cache.num_hits == 0
+    # Only the changed function is lowered again.
+    rt_mod = build(3.0)
+    assert cache.num_hits == 1
+
+    a = tvm.nd.array(np.arange(16, dtype="float32"))
+    b = tvm.nd.empty((16,), "float32")
+    rt_mod["add_other"](a, b)
+    np.testing.assert_allclose(b.numpy(), a.numpy() + 3.0)
+    rt_mod["add_one"](a, b)
+    np.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+
+    # Nothing changed, the generated module is reused as well.
+    build(3.0)
+    assert cache.num_hits == 4
+
+
 if __name__ == "__main__":
     test_lower_rfactor()
     test_dependent_output_shape()
     test_split_uneven_unique_likely()
+    test_build_cache()
@@ -508,5 +508,27 @@ def test_bound_block():
     _check((1, 3, 6, 6), 3)
 
 
+def test_bound_long_chain_compute_at():
+    n = 64
+    A = te.placeholder((n, n), name="A")
+    stages = [A]
+    for i in range(32):
+        prev = stages[-1]
+        stages.append(te.compute((n, n), lambda x, y: prev[x, y] + 1, name="B%d" % i))
+    out = stages[-1]
+    s = te.create_schedule(out.op)
+    xo, xi = s[out].split(out.op.axis[0], 8)
+    s[out].bind(xo, te.thread_axis("blockIdx.x"))
+    s[out].bind(xi, te.thread_axis("threadIdx.x"))
+    for stage in stages[1:-1]:
+        s[stage].set_scope("shared")
+        s[stage].compute_at(s[out], xo)
+    bounds = tvm.te.schedule.InferBound(s)
+    for stage in stages[1:-1]:
+        # Relaxed over threadIdx.x for the shared scope, not over blockIdx.x.
+        assert bounds[stage.op.axis[0]].extent.value == 8
+        assert bounds[stage.op.axis[1]].extent.value == n
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -0,0 +1,71 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import sys
+import tvm.testing
+from tvm.ir import IRModule
+from tvm.script import tir as T
+from tvm.tir.analysis import estimate_tir_bytes
+
+
+@T.prim_func
+def matmul(
+    A: T.Buffer((128, 128), "float32"),
+    B: T.Buffer((128, 128), "float32"),
+    C: T.Buffer((128, 128), "float32"),
+):
+    for i, j, k in T.grid(128, 128, 128):
+        with T.block("update"):
+            vi, vj, vk = T.axis.remap("SSR", [i, j, k])
+            with T.init():
+                C[vi, vj] = T.float32(0)
+            C[vi, vj] = C[vi, vj] + A[vi, vk] * B[vj, vk]
+
+
+def test_matmul():
+    # A, B and C are read, and C is written, once each.
+    assert estimate_tir_bytes(matmul) == 4 * 128 * 128 * 4
+
+
+@T.prim_func
+def thread_bound_copy(A: T.Buffer(1024, "float32"), B: T.Buffer(1024, "float32")):
+    blockIdx_x = T.launch_thread("blockIdx.x", 8)
+    threadIdx_x = T.launch_thread("threadIdx.x", 128)
+    B[blockIdx_x * 128 + threadIdx_x] = A[blockIdx_x * 128 + threadIdx_x]
+
+
+def test_thread_bound():
+    assert estimate_tir_bytes(IRModule({"main": thread_bound_copy})) == 2 * 1024 * 4
+
+
+@T.prim_func
+def partial_access(A: T.Buffer(1024, "float32"), B: T.Buffer(16, "float32")):
+    A_local_data = T.allocate([16], "float32", "local")
+    A_local = T.Buffer(16, data=A_local_data, scope="local")
+    for i in range(16):
+        A_local[i] = A[i * 2]
+    for i in range(16):
+        B[i] = A_local[i]
+
+
+def test_partial_access():
+    # The region of A spans 31 elements, the local buffer is not counted.
+    assert estimate_tir_bytes(partial_access) == (31 + 16) * 4
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -0,0 +1,129 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import tvm
+from tvm.script import tir as T
+import numpy as np
+import tvm.testing
+
+
+@T.prim_func
+def ptx_cp_async_bulk(A: T.Buffer((64, 128), "float16"), B: T.Buffer((64, 128), "float16")):
+    T.func_attr({"global_symbol": "default_function", "tir.noalias": True})
+    with T.attr([2, 1, 1], "cluster_dims", 2):
+        bx = T.env_thread("blockIdx.x")
+        tx = T.env_thread("threadIdx.x")
+        T.launch_thread(bx, 2)
+        T.launch_thread(tx, 32)
+        with T.block():
+            A_shared = T.alloc_buffer([32, 128], "float16", scope="shared", align=128)
+            barrier = T.alloc_buffer([1], "uint64", scope="shared")
+            T.reads(A[bx * 32 : bx * 32 + 32, 0:128])
+            T.writes(B[bx * 32 : bx * 32 + 32, 0:128])
+            if tx == 0:
+                T.evaluate(T.ptx_init_barrier_thread_count(barrier.data, 0, 1))
+            T.tvm_storage_sync("shared")
+            if tx == 0:
+                T.evaluate(T.ptx_arrive_barrier_expect_tx(barrier.data, 0, 32 * 128 * 2))
+                T.evaluate(
+                    T.ptx_cp_async_bulk(
+                        A_shared.data, 0, A.data, bx * 32 * 128, 32 * 128 * 2, barrier.data, 0
+                    )
+                )
+            T.evaluate(T.ptx_wait_barrier(barrier.data, 0, 0))
+            for i in range(128):
+                B[bx * 32 + tx, i] = A_shared[tx, i]
+
+
+@tvm.testing.requires_cuda_compute_version(9)
+def test_ptx_cp_async_bulk():
+    mod = tvm.build(ptx_cp_async_bulk, target="cuda")
+    assert "__cluster_dims__(2, 1, 1)" in mod.imported_modules[0].get_source()
+    A_np = np.random.rand(64, 128).astype("float16")
+    dev = tvm.cuda(0)
+    A_nd = tvm.nd.array(A_np, device=dev)
+    B_nd = tvm.nd.array(np.zeros((64, 128), "float16"), device=dev)
+    mod(A_nd, B_nd)
+    tvm.testing.assert_allclose(B_nd.numpy(), A_np)
+
+
+@T.prim_func
+def ptx_wgmma_ss(
+    A: T.Buffer((64, 16), "float16"),
+    B: T.Buffer((64, 16), "float16"),
+    C: T.Buffer((64, 64), "float32"),
+):
+    T.func_attr({"global_symbol": "default_function", "tir.noalias": True})
+    bx = T.env_thread("blockIdx.x")
+    tx = T.env_thread("threadIdx.x")
+    T.launch_thread(bx, 1)
+    T.launch_thread(tx, 128)
+    with T.block():
+        # The unswizzled k-major layout of wgmma, where every 8 x 8 core matrix is contiguous
+        # and the two core matrices of the reduction dimension are adjacent.
+        A_shared = T.alloc_buffer([1024], "float16", scope="shared", align=128)
+        B_shared = T.alloc_buffer([1024], "float16", scope="shared", align=128)
+        C_local = T.alloc_buffer([32], "float32", scope="local")
+        T.reads(A[0:64, 0:16], B[0:64, 0:16])
+        T.writes(C[0:64, 0:64])
+        for i in range(8):
+            row = T.meta_var(i * 8 + tx // 16)
+            col = T.meta_var(tx % 16)
+            A_shared[((row // 8) * 2 + col // 8) * 64 + (row % 8) * 8 + col % 8] = A[row, col]
+            B_shared[((row // 8) * 2 + col // 8) * 64 + (row % 8) * 8 + col % 8] = B[row, col]
+        T.tvm_storage_sync("shared")
+        T.evaluate(T.ptx_wgmma_fence())
+        T.evaluate(
+            T.ptx_wgmma_ss(
+                "m64n64k16",
+                "fp16",
+                "fp16",
+                "fp32",
+                A_shared.data,
+                0,
+                B_shared.data,
+                0,
+                C_local.data,
+                0,
+                0,
+                0,
+                dtype="float32",
+            )
+        )
+        T.evaluate(T.ptx_wgmma_commit_group())
+        T.evaluate(T.ptx_wgmma_wait_group(0))
+        for b, h, p in T.grid(8, 2, 2):
+            C[(tx // 32) * 16 + (tx % 32) // 4 + h * 8, b * 8 + (tx % 4) * 2 + p] = C_local[
+                b * 4 + h * 2 + p
+            ]
+
+
+@tvm.testing.requires_cuda_compute_version(9)
+def test_ptx_wgmma_ss():
+    mod = tvm.build(ptx_wgmma_ss, target="cuda")
+    A_np = np.random.uniform(-1, 1, (64, 16)).astype("float16")
+    B_np = np.random.uniform(-1, 1, (64, 16)).astype("float16")
+    dev = tvm.cuda(0)
+    A_nd = tvm.nd.array(A_np, device=dev)
+    B_nd = tvm.nd.array(B_np, device=dev)
+    C_nd = tvm.nd.array(np.zeros((64, 64), "float32"), device=dev)
+    mod(A_nd, B_nd, C_nd)
+    C_np = A_np.astype("float32") @ B_np.astype("float32").T
+    tvm.testing.assert_allclose(C_nd.numpy(), C_np, rtol=1e-3, atol=1e-3)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
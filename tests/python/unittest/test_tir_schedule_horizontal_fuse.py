@@ -0,0 +1,185 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+# pylint: disable=missing-function-docstring,missing-module-docstring
+import pytest
+import tvm
+import tvm.testing
+from tvm import tir
+from tvm.script import tir as T
+from tvm.tir.schedule.testing import verify_trace_roundtrip
+
+# pylint: disable=no-member,invalid-name,unused-variable
+
+
+@T.prim_func
+def independent(
+    A: T.Buffer((128,), "float32"),
+    B: T.Buffer((128,), "float32"),
+    C: T.Buffer((64,), "float32"),
+    D: T.Buffer((64,), "float32"),
+) -> None:
+    for i in range(128):
+        with T.block("B"):
+            vi = T.axis.spatial(128, i)
+            T.reads(A[vi])
+            T.writes(B[vi])
+            B[vi] = A[vi] * T.float32(2)
+    for i in range(64):
+        with T.block("D"):
+            vi = T.axis.spatial(64, i)
+            T.reads(C[vi])
+            T.writes(D[vi])
+            D[vi] = C[vi] + T.float32(1)
+
+
+@T.prim_func
+def independent_fused(
+    A: T.Buffer((128,), "float32"),
+    B: T.Buffer((128,), "float32"),
+    C: T.Buffer((64,), "float32"),
+    D: T.Buffer((64,), "float32"),
+) -> None:
+    for i_h in range(128):
+        with T.block("B"):
+            vi = T.axis.spatial(128, i_h)
+            T.reads(A[vi])
+            T.writes(B[vi])
+            B[vi] = A[vi] * T.float32(2)
+        with T.block("D"):
+            vi = T.axis.spatial(64, i_h)
+            T.where(i_h < 64)
+            T.reads(C[vi])
+            T.writes(D[vi])
+            D[vi] = C[vi] + T.float32(1)
+
+
+@T.prim_func
+def independent_same_extent(
+    A: T.Buffer((64, 64), "float32"),
+    B: T.Buffer((64, 64), "float32"),
+    C: T.Buffer((64, 64), "float32"),
+    D: T.Buffer((64, 64), "float32"),
+) -> None:
+    for i, j in T.grid(64, 64):
+        with T.block("B"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            T.reads(A[vi, vj])
+            T.writes(B[vi, vj])
+            B[vi, vj] = A[vi, vj] * T.float32(2)
+    for i, j in T.grid(64, 64):
+        with T.block("D"):
+            vi, vj = T.axis.remap("SS", [i, j])
+            T.reads(C[vi, vj])
+            T.writes(D[vi, vj])
+            D[vi, vj] = C[vi, vj] + T.float32(1)
+
+
+@T.prim_func
+def independent_same_extent_fused(
+    A: T.Buffer((64, 64), "float32"),
+    B: T.Buffer((64, 64), "float32"),
+    C: T.Buffer((64, 64), "float32"),
+    D: T.Buffer((64, 64), "float32"),
+) -> None:
+    for i_h in range(64):
+        for j in range(64):
+            with T.block("B"):
+                vi, vj = T.axis.remap("SS", [i_h, j])
+                T.reads(A[vi, vj])
+                T.writes(B[vi, vj])
+                B[vi, vj] = A[vi, vj] * T.float32(2)
+        for j in range(64):
+            with T.block("D"):
+                vi, vj = T.axis.remap("SS", [i_h, j])
+                T.reads(C[vi, vj])
+                T.writes(D[vi, vj])
+                D[vi, vj] = C[vi, vj] + T.float32(1)
+
+
+@T.prim_func
+def dependent(
+    A: T.Buffer((128,), "float32"),
+    C: T.Buffer((128,), "float32"),
+) -> None:
+    B = T.alloc_buffer((128,))
+    for i in range(128):
+        with T.block("B"):
+            vi = T.axis.spatial(128, i)
+            B[vi] = A[vi] * T.float32(2)
+    for i in range(128):
+        with T.block("C"):
+            vi = T.axis.spatial(128, i)
+            C[vi] = B[127 - vi] + T.float32(1)
+
+
+@T.prim_func
+def not_consecutive(
+    A: T.Buffer((128,), "float32"),
+    B: T.Buffer((128,), "float32"),
+    C: T.Buffer((128,), "float32"),
+    D: T.Buffer((128,), "float32"),
+) -> None:
+    for i in range(128):
+        with T.block("B"):
+            vi = T.axis.spatial(128, i)
+            B[vi] = A[vi] * T.float32(2)
+    for i in range(128):
+        with T.block("C"):
+            vi = T.axis.spatial(128, i)
+            C[vi] = A[vi] * T.float32(3)
+    for i in range(128):
+        with T.block("D"):
+            vi = T.axis.spatial(128, i)
+            D[vi] = A[vi] * T.float32(4)
+
+
+def test_horizontal_fuse():
+    sch = tir.Schedule(independent, debug_mask="all")
+    (i,) = sch.get_loops(sch.get_block("B"))
+    (j,) = sch.get_loops(sch.get_block("D"))
+    sch.horizontal_fuse(i, j)
+    tvm.ir.assert_structural_equal(independent_fused, sch.mod["main"])
+    verify_trace_roundtrip(sch=sch, mod=independent)
+
+
+def test_horizontal_fuse_same_extent():
+    sch = tir.Schedule(independent_same_extent, debug_mask="all")
+    i = sch.get_loops(sch.get_block("B"))[0]
+    j = sch.get_loops(sch.get_block("D"))[0]
+    sch.horizontal_fuse(j, i)
+    tvm.ir.assert_structural_equal(independent_same_extent_fused, sch.mod["main"])
+    verify_trace_roundtrip(sch=sch, mod=independent_same_extent)
+
+
+def test_horizontal_fuse_fail_dependent():
+    sch = tir.Schedule(dependent, debug_mask="all")
+    (i,) = sch.get_loops(sch.get_block("B"))
+    (j,) = sch.get_loops(sch.get_block("C"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.horizontal_fuse(i, j)
+
+
+def test_horizontal_fuse_fail_not_consecutive():
+    sch = tir.Schedule(not_consecutive, debug_mask="all")
+    (i,) = sch.get_loops(sch.get_block("B"))
+    (j,) = sch.get_loops(sch.get_block("D"))
+    with pytest.raises(tvm.tir.ScheduleError):
+        sch.horizontal_fuse(i, j)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
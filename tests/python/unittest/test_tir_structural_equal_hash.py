@@ -131,6 +131,27 @@ def test_prim_func():
     tvm.ir.assert_structural_equal(mod0, mod1)
 
 
+def test_prim_func_cached_hash():
+    x = te.var("x")
+    y = te.var("y")
+    func = tvm.tir.PrimFunc([x, y], tvm.tir.Evaluate(x + y))
+    # the second hash is read from the cache of the function
+    hash0 = tvm.ir.structural_hash(func)
+    assert tvm.ir.structural_hash(func) == hash0
+    # a copy starts without a cache and hashes to the same value
+    copy = tvm.ir.load_json(tvm.ir.save_json(func))
+    assert tvm.ir.structural_hash(copy) == hash0
+    # the cache is only used without mapping free variables
+    assert tvm.ir.structural_hash(func, True) == tvm.ir.structural_hash(copy, True)
+    # a modified function gets its own hash, the original keeps its cache
+    func_attr = func.with_attr("global_symbol", "main")
+    assert tvm.ir.structural_hash(func_attr) != hash0
+    assert tvm.ir.structural_hash(func) == hash0
+    assert tvm.ir.structural_hash(func_attr) == tvm.ir.structural_hash(
+        copy.with_attr("global_symbol", "main")
+    )
+
+
 def test_prim_func_param_count_mismatch():
     x = te.var("x")
     y = te.var("y")
@@ -419,5 +440,30 @@ def test_ir_module_equal():
     assert '<root>.functions[I.GlobalVar("func")].body.extent.value' in err.value.args[0]
 
 
+def test_ir_module_parallel():
+    def generate(n: int, shared_var=None):
+        funcs = {}
+        for i in range(n):
+            x = shared_var if shared_var is not None else te.var("x")
+            buf = tvm.tir.decl_buffer((16,), "float32", name="A")
+            body = tvm.tir.BufferStore(buf, tvm.tir.Cast("float32", x + i), [0])
+            funcs["func%d" % i] = tvm.tir.PrimFunc([x, buf.data], body, buffer_map={})
+        return tvm.IRModule(funcs)
+
+    for mod in [generate(3), generate(12), generate(12, te.var("x"))]:
+        copy = tvm.ir.load_json(tvm.ir.save_json(mod))
+        for map_free_vars in [False, True]:
+            expected = tvm.ir.structural_hash(mod, map_free_vars)
+            assert tvm.ir.structural_hash(mod, map_free_vars, num_threads=4) == expected
+        assert tvm.ir.structural_equal(mod, copy, num_threads=4)
+        assert tvm.ir.structural_equal(mod, copy, True, num_threads=4)
+
+    mod = generate(12)
+    changed = generate(12)
+    changed["func5"] = changed["func6"]
+    assert not tvm.ir.structural_equal(mod, changed, num_threads=4)
+    assert tvm.ir.structural_hash(changed, num_threads=4) == tvm.ir.structural_hash(changed)
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -489,6 +489,44 @@ def test_deterministic_cse_2():
         assert new_hash == initial_hash
 
 
+# -----------------------------------------------------
+# Regression test for the complexity of the pass on large unrolled bodies
+# -----------------------------------------------------
+def test_cse_large_unrolled_body():
+    """Test the commoning in a large straight-line body
+
+    Each store of the body uses the index i * 64 + k three times, so the pass
+    introduces at least one variable per store. The body is large enough for
+    a quadratic implementation of the pass to take minutes.
+    """
+    NUM_STORES = 512
+
+    i = te.var("i")
+    A = tvm.tir.decl_buffer((NUM_STORES * 64,), name="A")
+    B = tvm.tir.decl_buffer((NUM_STORES * 64,), name="B")
+    C = tvm.tir.decl_buffer((NUM_STORES * 64,), name="C")
+
+    stores = []
+    for k in range(NUM_STORES):
+        index = i * 64 + k
+        value = tvm.tir.BufferLoad(B, [index]) + tvm.tir.BufferLoad(C, [index])
+        stores.append(tvm.tir.BufferStore(A, value, [index]))
+    body = tvm.tir.For(i, 0, NUM_STORES, tvm.tir.ForKind.SERIAL, tvm.tir.SeqStmt(stores))
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A, B, C], body))
+
+    body = tvm.tir.transform.CommonSubexprElimTIR()(mod)["main"].body
+
+    cse_vars = []
+
+    def collect_cse_vars(node):
+        if isinstance(node, tvm.tir.LetStmt) and node.var.name.startswith("cse_var"):
+            cse_vars.append(node.var)
+
+    tvm.tir.stmt_functor.post_order_visit(body, collect_cse_vars)
+    assert len(cse_vars) >= NUM_STORES
+    assert len({var.name for var in cse_vars}) == len(cse_vars)
+
+
 if __name__ == "__main__":
     # Basic test:
     test_cse()
@@ -505,3 +543,5 @@ if __name__ == "__main__":
     # Tests that verify the determinism of the pass:
     test_deterministic_cse()
     test_deterministic_cse_2()
+    # Regression test for the complexity of the pass:
+    test_cse_large_unrolled_body()
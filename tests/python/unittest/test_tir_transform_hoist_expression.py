@@ -471,5 +471,110 @@ class TestSuppressHoistLetExpr(BaseBeforeAfter):
     expected = before
 
 
+class TestHoistBufferLoad(BaseBeforeAfter):
+    """Loop-invariant loads of buffers which cannot alias a written one are hoisted"""
+
+    hoisted_let_bindings = tvm.testing.parameter(HoistedLetBindings.BufferLoad)
+
+    @T.prim_func
+    def before(
+        A: T.Buffer((16, 16), "float32"),
+        S: T.Buffer((16,), "float32"),
+        B: T.Buffer((16, 16), "float32"),
+    ):
+        T.func_attr({"tir.noalias": True})
+        for i in T.serial(16):
+            for j in T.serial(16):
+                B[i, j] = A[i, j] * S[i]
+
+    @T.prim_func
+    def expected(
+        A: T.Buffer((16, 16), "float32"),
+        S: T.Buffer((16,), "float32"),
+        B: T.Buffer((16, 16), "float32"),
+    ):
+        T.func_attr({"tir.noalias": True})
+        for i in T.serial(16):
+            scale = S[i]
+            for j in T.serial(16):
+                B[i, j] = A[i, j] * scale
+
+
+class TestHoistBufferLoadToTop(TestHoistBufferLoad):
+    @T.prim_func
+    def before(
+        A: T.Buffer((16, 16), "float32"),
+        Index: T.Buffer((1,), "int32"),
+        B: T.Buffer((16, 16), "float32"),
+    ):
+        T.func_attr({"tir.noalias": True})
+        for i in T.serial(16):
+            for j in T.serial(16):
+                B[i, j] = A[Index[0], j]
+
+    @T.prim_func
+    def expected(
+        A: T.Buffer((16, 16), "float32"),
+        Index: T.Buffer((1,), "int32"),
+        B: T.Buffer((16, 16), "float32"),
+    ):
+        T.func_attr({"tir.noalias": True})
+        index = Index[0]
+        for i in T.serial(16):
+            for j in T.serial(16):
+                B[i, j] = A[index, j]
+
+
+class TestSuppressHoistBufferLoadMayAlias(TestHoistBufferLoad):
+    """Without tir.noalias, the arguments may alias each other"""
+
+    @T.prim_func
+    def before(
+        A: T.Buffer((16, 16), "float32"),
+        S: T.Buffer((16,), "float32"),
+        B: T.Buffer((16, 16), "float32"),
+    ):
+        for i in T.serial(16):
+            for j in T.serial(16):
+                B[i, j] = A[i, j] * S[i]
+
+    expected = before
+
+
+class TestSuppressHoistBufferLoadWritten(TestHoistBufferLoad):
+    """A load of a buffer written in the loop is not hoisted"""
+
+    @T.prim_func
+    def before(A: T.Buffer((16, 16), "float32"), S: T.Buffer((16,), "float32")):
+        T.func_attr({"tir.noalias": True})
+        for i in T.serial(16):
+            for j in T.serial(16):
+                A[i, j] = A[i, j] * S[i]
+                S[j] = 1.0
+
+    expected = before
+
+
+class TestSuppressHoistConditionalBufferLoad(TestHoistBufferLoad):
+    """A load under a condition may not be valid outside of it"""
+
+    hoisted_conditionals = tvm.testing.parameter(HoistedConditionals.Never)
+
+    @T.prim_func
+    def before(
+        A: T.Buffer((16, 16), "float32"),
+        S: T.Buffer((16,), "float32"),
+        B: T.Buffer((16, 16), "float32"),
+        n: T.int32,
+    ):
+        T.func_attr({"tir.noalias": True})
+        for i in T.serial(16):
+            for j in T.serial(16):
+                if i < n:
+                    B[i, j] = A[i, j] * S[i]
+
+    expected = before
+
+
 if __name__ == "__main__":
     tvm.testing.main()
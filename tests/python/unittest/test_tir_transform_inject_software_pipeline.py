@@ -1059,6 +1059,40 @@ def simple_compute_missing_annotation(
                     C[tx, i] = B[tx, 0] + T.float32(1)
 
 
+def gen_warp_specialized_compute(num_slots):
+    @T.prim_func
+    def warp_specialized_compute(
+        A: T.Buffer((32, 16), "float32"),
+        C: T.Buffer((32, 16), "float32"),
+        D: T.Buffer((32,), "float32"),
+    ):
+        for tx in T.thread_binding(0, 32, thread="threadIdx.x"):
+            for i in T.serial(
+                0,
+                16,
+                annotations={
+                    "software_pipeline_stage": [0, 1],
+                    "software_pipeline_order": [0, 1],
+                    "software_pipeline_warp_specialize": num_slots,
+                },
+            ):
+                with T.block("compute"):
+                    T.reads(A[tx, i])
+                    T.writes(C[tx, i])
+                    B = T.alloc_buffer((32, 1), dtype="float32", scope="shared")
+                    with T.block():
+                        T.reads(A[tx, i])
+                        T.writes(B[tx, 0])
+                        B[tx, 0] = A[tx, i] * T.float32(2)
+                    with T.block():
+                        T.reads(B[tx, 0])
+                        T.writes(C[tx, i])
+                        C[tx, i] = B[tx, 0] + T.float32(1)
+            D[tx] = T.float32(1)
+
+    return warp_specialized_compute
+
+
 def test_simple_compute():
     _check(gen_simple_compute(1), transformed_simple_compute)
 
@@ -1107,6 +1141,79 @@ def test_error_missing_annotation():
     _check_error(simple_compute_missing_annotation)
 
 
+def test_warp_specialized_compute():
+    def _barrier_calls(stmt):
+        calls = []
+
+        def _visit(node):
+            if isinstance(node, tir.Call) and node.op.name.startswith("tir.ptx_"):
+                calls.append(node.op.name)
+
+        tvm.tir.stmt_functor.post_order_visit(stmt, _visit)
+        return calls
+
+    mod = tvm.IRModule.from_expr(gen_warp_specialized_compute(3))
+    mod = tvm.tir.transform.InjectSoftwarePipeline()(mod)
+    thread_loops = []
+    tvm.tir.stmt_functor.post_order_visit(
+        mod["main"].body,
+        lambda node: thread_loops.append(node)
+        if isinstance(node, tir.For) and node.kind == tir.ForKind.THREAD_BINDING
+        else None,
+    )
+    (thread_loop,) = thread_loops
+    tx = thread_loop.loop_var
+    assert int(thread_loop.extent) == 64
+
+    pipeline, epilogue = thread_loop.body
+    # The statements outside the pipeline only run on the consumers.
+    assert isinstance(epilogue, tir.IfThenElse)
+    tvm.ir.assert_structural_equal(epilogue.condition, tx < 32)
+
+    B, barrier = pipeline.block.alloc_buffers
+    assert [int(dim) for dim in B.shape] == [3, 32, 1]
+    assert [int(dim) for dim in barrier.shape] == [6]
+    assert barrier.scope() == "shared"
+
+    init = pipeline.block.body[1]
+    assert _barrier_calls(init) == ["tir.ptx_init_barrier_thread_count"] * 6
+
+    split = pipeline.block.body[3]
+    tvm.ir.assert_structural_equal(split.condition, tx >= 32)
+    producer, consumer = split.then_case, split.else_case
+    assert _barrier_calls(producer) == ["tir.ptx_wait_barrier", "tir.ptx_arrive_barrier"]
+    assert _barrier_calls(consumer) == ["tir.ptx_wait_barrier", "tir.ptx_arrive_barrier"]
+
+    # The producers run on the additional threads with the thread index shifted back.
+    store = producer.body[1].block.body
+    assert store.buffer.same_as(B)
+    tvm.ir.assert_structural_equal(store.indices[1], tx - 32)
+    load = consumer.body[1].block.body.value.a
+    assert load.buffer.same_as(B)
+    tvm.ir.assert_structural_equal(load.indices[1], tx)
+
+
+def test_error_warp_specialized_thread_extent():
+    mod = tvm.IRModule.from_expr(gen_simple_compute(1))
+    sch = tvm.tir.Schedule(mod)
+    _, loop = sch.get_loops(sch.get_block("compute"))
+    sch.annotate(loop, ann_key="software_pipeline_warp_specialize", ann_val=2)
+    _check_error(sch.mod["main"])
+
+
+@tvm.testing.requires_cuda_compute_version(9)
+def test_warp_specialized_compute_build():
+    f = tvm.build(gen_warp_specialized_compute(2), target="cuda")
+    A_np = np.random.rand(32, 16).astype("float32")
+    dev = tvm.cuda(0)
+    A_nd = tvm.nd.array(A_np, device=dev)
+    C_nd = tvm.nd.array(np.zeros((32, 16), "float32"), device=dev)
+    D_nd = tvm.nd.array(np.zeros((32,), "float32"), device=dev)
+    f(A_nd, C_nd, D_nd)
+    tvm.testing.assert_allclose(C_nd.numpy(), A_np * 2 + 1)
+    tvm.testing.assert_allclose(D_nd.numpy(), np.ones((32,), "float32"))
+
+
 def test_simple_compute_async():
     mod = tvm.IRModule.from_expr(gen_simple_compute(1))
     sch = tvm.tir.Schedule(mod)
@@ -0,0 +1,118 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm.script import tir as T
+
+
+def _prefetches(func):
+    """Returns the prefetch calls of a function, with whether each is guarded by a condition"""
+    prefetches = []
+
+    def visit(node, guarded):
+        if isinstance(node, tvm.tir.IfThenElse):
+            visit(node.then_case, True)
+        elif isinstance(node, tvm.tir.Evaluate) and isinstance(node.value, tvm.tir.Call):
+            if node.value.op.same_as(tvm.ir.Op.get("tir.prefetch")):
+                prefetches.append((node.value, guarded))
+        elif isinstance(node, tvm.tir.SeqStmt):
+            for stmt in node.seq:
+                visit(stmt, guarded)
+        elif isinstance(node, (tvm.tir.For, tvm.tir.AttrStmt, tvm.tir.LetStmt)):
+            visit(node.body, guarded)
+
+    visit(func.body, False)
+    return prefetches
+
+
+def _prefetched_buffer(call):
+    return call.args[0].args[0].buffer.name
+
+
+@T.prim_func
+def strided_copy(A: T.Buffer((16384,), "float32"), B: T.Buffer((1024,), "float32")):
+    T.func_attr({"global_symbol": "main", "target": T.target("llvm")})
+    with T.attr(0, "pragma_software_prefetch_distance", 8):
+        for i in range(1024):
+            B[i] = A[i * 16] * T.float32(2)
+
+
+@T.prim_func
+def embedding_lookup(
+    table: T.Buffer((65536,), "float32"),
+    ids: T.Buffer((128,), "int32"),
+    out: T.Buffer((8192,), "float32"),
+):
+    T.func_attr({"global_symbol": "main", "target": T.target("llvm")})
+    for i in range(128):
+        for j in range(64):
+            out[i * 64 + j] = table[ids[i] * 64 + j]
+
+
+def test_prefetch_under_pragma():
+    mod = tvm.IRModule.from_expr(strided_copy)
+    after = tvm.tir.transform.InjectSoftwarePrefetch()(mod)["main"]
+    prefetches = _prefetches(after)
+    assert {_prefetched_buffer(call): guarded for call, guarded in prefetches} == {
+        # Each access to A is on its own cache line
+        "A": False,
+        # 16 iterations share a cache line of B
+        "B": True,
+    }
+    read_write = {_prefetched_buffer(call): call.args[1].value for call, _ in prefetches}
+    assert read_write == {"A": 0, "B": 1}
+    # The pragma is consumed by the pass
+    assert not isinstance(after.body, tvm.tir.AttrStmt)
+
+
+def test_no_prefetch_without_pragma():
+    mod = tvm.IRModule.from_expr(embedding_lookup)
+    after = tvm.tir.transform.InjectSoftwarePrefetch()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+def test_prefetch_indirect_base():
+    mod = tvm.IRModule.from_expr(embedding_lookup)
+    with tvm.transform.PassContext(config={"tir.InjectSoftwarePrefetch": {"enable": True}}):
+        after = tvm.tir.transform.InjectSoftwarePrefetch()(mod)["main"]
+    buffers = sorted(_prefetched_buffer(call) for call, _ in _prefetches(after))
+    # The row of the table read by the inner loop only depends on the outer loop.
+    assert buffers == ["out", "table"]
+
+
+def test_no_prefetch_for_gpu():
+    mod = tvm.IRModule.from_expr(embedding_lookup.with_attr("target", tvm.target.Target("cuda")))
+    with tvm.transform.PassContext(config={"tir.InjectSoftwarePrefetch": {"enable": True}}):
+        after = tvm.tir.transform.InjectSoftwarePrefetch()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+@tvm.testing.requires_llvm
+def test_build_with_prefetch():
+    with tvm.transform.PassContext(config={"tir.InjectSoftwarePrefetch": {"enable": True}}):
+        func = tvm.build(embedding_lookup, target="llvm")
+    table = np.random.rand(65536).astype("float32")
+    ids = np.random.randint(0, 1024, size=128).astype("int32")
+    out = tvm.nd.empty((8192,), "float32")
+    func(tvm.nd.array(table), tvm.nd.array(ids), out)
+    tvm.testing.assert_allclose(out.numpy(), table.reshape(1024, 64)[ids].reshape(-1))
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -235,5 +235,96 @@ class TestReduceSummation(BaseCompare):
                 B[i] = reduce[0]
 
 
+def _cross_block_sum(cluster_dims=None):
+    @T.prim_func
+    def func(A: T.Buffer((4, 512), "float32"), B: T.Buffer(4, "float32")):
+        T.func_attr({"target": T.target("cuda", host="llvm")})
+        A_flat = T.Buffer(2048, data=A.data)
+
+        blockIdx_y = T.launch_thread("blockIdx.y", 4)
+        blockIdx_x = T.launch_thread("blockIdx.x", 4)
+        threadIdx_x = T.launch_thread("threadIdx.x", 128)
+
+        reduce_data = T.allocate([1], "float32", "local")
+        reduce = T.Buffer(1, data=reduce_data, scope="local")
+
+        with T.attr(
+            T.comm_reducer(lambda x, y: x + y, [T.float32(0)]),
+            "reduce_scope",
+            T.reinterpret("handle", T.uint64(0)),
+        ):
+            T.tvm_thread_allreduce(
+                T.uint32(1),
+                A_flat[blockIdx_y * 512 + blockIdx_x * 128 + threadIdx_x],
+                T.bool(True),
+                reduce[0],
+                blockIdx_x,
+                threadIdx_x,
+            )
+        if blockIdx_x == 0 and threadIdx_x == 0:
+            B[blockIdx_y] = reduce[0]
+
+    if cluster_dims is not None:
+        cluster_size = cluster_dims[0] * cluster_dims[1] * cluster_dims[2]
+        body = tvm.tir.AttrStmt(cluster_dims, "cluster_dims", cluster_size, func.body)
+        func = func.with_body(body)
+    return tvm.IRModule.from_expr(func)
+
+
+def _collect_calls(mod, op_name):
+    calls = []
+    op = tvm.ir.Op.get(op_name)
+
+    def fvisit(node):
+        if isinstance(node, tvm.tir.Call) and node.op.same_as(op):
+            calls.append(node)
+
+    tvm.tir.stmt_functor.post_order_visit(mod["main"].body, fvisit)
+    return calls
+
+
+def test_cross_block_allreduce_cluster():
+    mod = tvm.tir.transform.LowerThreadAllreduce()(_cross_block_sum([4, 1, 1]))
+    assert len(_collect_calls(mod, "tir.ptx_cluster_sync")) == 2
+    loads = _collect_calls(mod, "tir.ptx_ld_shared_cluster")
+    assert len(loads) == 2
+    assert all(load.dtype == "float32" for load in loads)
+    global_syncs = [
+        call
+        for call in _collect_calls(mod, "tir.tvm_storage_sync")
+        if call.args[0].value == "global"
+    ]
+    assert not global_syncs
+
+
+def test_cross_block_allreduce_grid():
+    mod = tvm.tir.transform.LowerThreadAllreduce()(_cross_block_sum())
+    assert not _collect_calls(mod, "tir.ptx_cluster_sync")
+    global_syncs = [
+        call
+        for call in _collect_calls(mod, "tir.tvm_storage_sync")
+        if call.args[0].value == "global"
+    ]
+    assert len(global_syncs) == 2
+    assert global_syncs[0].args[2].value == 16
+    assert len(_collect_calls(mod, "tir.tvm_global_barrier_kinit")) == 1
+
+    # The workspace is allocated outside of the kernel.
+    body = mod["main"].body
+    assert isinstance(body, tvm.tir.Allocate)
+    assert body.buffer_var.type_annotation.storage_scope == "global"
+    assert body.extents[0].value == 16
+    assert isinstance(body.body, tvm.tir.SeqStmt)
+    assert isinstance(body.body[1], tvm.tir.AttrStmt)
+    assert body.body[1].attr_key == "thread_extent"
+
+
+def test_cross_block_allreduce_cluster_mismatch():
+    # A cluster which does not span the reduced blocks falls back to the global workspace.
+    mod = tvm.tir.transform.LowerThreadAllreduce()(_cross_block_sum([2, 1, 1]))
+    assert not _collect_calls(mod, "tir.ptx_cluster_sync")
+    assert len(_collect_calls(mod, "tir.tvm_global_barrier_kinit")) == 1
+
+
 if __name__ == "__main__":
     tvm.testing.main()
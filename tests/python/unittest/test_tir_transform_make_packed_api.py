@@ -282,5 +282,38 @@ def test_subroutine_call_to_externally_visible_subroutine():
     )
 
 
+def test_direct_call_to_externally_visible_subroutine():
+    """With direct subroutine calls, the callers skip the PackedFunc API
+
+    The subroutine is split into an internal implementation, which the
+    callers call directly, and a PackedFunc wrapper exposed under the
+    global symbol.
+    """
+
+    @I.ir_module
+    class before:
+        @T.prim_func
+        def main(A: T.Buffer(1, "float32")):
+            T.func_attr({"global_symbol": "main", "target": T.target("llvm", host="llvm")})
+            before.subroutine(A.data)
+
+        @T.prim_func
+        def subroutine(A_data: T.handle("float32")):
+            T.func_attr({"global_symbol": "subroutine", "target": T.target("llvm", host="llvm")})
+            T.evaluate(A_data)
+
+    with tvm.transform.PassContext(config={"tir.enable_direct_subroutine_calls": True}):
+        after = tvm.tir.transform.MakePackedAPI()(before)
+
+    impl = after.get_global_var("subroutine_impl")
+    assert "global_symbol" not in after[impl].attrs
+    tvm.ir.assert_structural_equal(after[impl].body, before["subroutine"].body)
+
+    main_compute_scope = _find_compute_scope(after["main"])
+    assert main_compute_scope.body.value.op.same_as(impl)
+    subroutine_compute_scope = _find_compute_scope(after["subroutine"])
+    assert subroutine_compute_scope.body.value.op.same_as(impl)
+
+
 if __name__ == "__main__":
     test_makeapi()
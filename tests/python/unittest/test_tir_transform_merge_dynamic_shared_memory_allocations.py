@@ -308,7 +308,8 @@ def test_dyn_shared_more_dtype():
     s = te.create_schedule(C.op)
 
     mod = run_passes(s, [A, B, C])
-    verify_single_allocation(mod["main"].body, n * 4)
+    # C_sh cannot reuse the memory of A_sh and B_sh, as no barrier follows their last access
+    verify_single_allocation(mod["main"].body, n * 7)
 
     def check_target(target):
         if not tvm.testing.device_enabled(target):
@@ -454,5 +455,92 @@ class TestMatmul(tvm.testing.CompareBeforeAfter):
         return func
 
 
+def _shared_allocations(func):
+    allocations = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Allocate):
+            scope = node.buffer_var.type_annotation.storage_scope
+            if scope in ["shared", "shared.dyn"]:
+                allocations.append((scope, int(node.extents[0])))
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return sorted(allocations)
+
+
+def _two_stage_kernel(first_scope, middle_sync):
+    @T.prim_func
+    def func(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        threadIdx_x = T.launch_thread("threadIdx.x", 128)
+        X_sh_data = T.allocate([128], "float32", first_scope)
+        X_sh = T.Buffer(128, data=X_sh_data, scope=first_scope)
+        Y_sh_data = T.allocate([128], "float32", "shared.dyn")
+        Y_sh = T.Buffer(128, data=Y_sh_data, scope="shared.dyn")
+        X_sh[threadIdx_x] = A[threadIdx_x]
+        T.tvm_storage_sync("shared")
+        B[threadIdx_x] = X_sh[127 - threadIdx_x]
+        T.tvm_storage_sync(middle_sync)
+        Y_sh[threadIdx_x] = B[threadIdx_x] * T.float32(2)
+        T.tvm_storage_sync("shared")
+        B[threadIdx_x] = Y_sh[127 - threadIdx_x]
+
+    return func
+
+
+def test_dyn_shared_reuse_after_sync():
+    transform = tvm.tir.transform.MergeDynamicSharedMemoryAllocations()
+    func = _two_stage_kernel("shared.dyn", "shared")
+    assert _shared_allocations(transform(tvm.IRModule.from_expr(func))["main"]) == [
+        ("shared.dyn", 512)
+    ]
+    # Without a block barrier, another thread may still read X_sh while Y_sh is written
+    func = _two_stage_kernel("shared.dyn", "warp")
+    assert _shared_allocations(transform(tvm.IRModule.from_expr(func))["main"]) == [
+        ("shared.dyn", 1024)
+    ]
+
+
+def test_merge_static_smem():
+    transform = tvm.tir.transform.MergeDynamicSharedMemoryAllocations()
+    mod = tvm.IRModule.from_expr(_two_stage_kernel("shared", "shared"))
+    assert _shared_allocations(transform(mod)["main"]) == [("shared", 128), ("shared.dyn", 128)]
+    with tvm.transform.PassContext(config={"tir.merge_static_smem": True}):
+        after = transform(mod)["main"]
+    # The static buffer is overlaid with the dynamic one
+    assert _shared_allocations(after) == [("shared.dyn", 512)]
+
+
+def test_merge_static_smem_per_kernel():
+    @T.prim_func
+    def func(A: T.Buffer((128,), "float32"), B: T.Buffer((128,), "float32")):
+        tx_0 = T.env_thread("threadIdx.x")
+        tx_1 = T.env_thread("threadIdx.x")
+        with T.launch_thread(tx_0, 128):
+            X_sh_data = T.allocate([128], "float32", "shared")
+            X_sh = T.Buffer(128, data=X_sh_data, scope="shared")
+            Y_sh_data = T.allocate([128], "float32", "shared")
+            Y_sh = T.Buffer(128, data=Y_sh_data, scope="shared")
+            X_sh[tx_0] = A[tx_0]
+            Y_sh[tx_0] = B[tx_0]
+            T.tvm_storage_sync("shared")
+            B[tx_0] = X_sh[127 - tx_0] + Y_sh[127 - tx_0]
+        with T.launch_thread(tx_1, 128):
+            Z_sh_data = T.allocate([128], "float32", "shared")
+            Z_sh = T.Buffer(128, data=Z_sh_data, scope="shared")
+            W_sh_data = T.allocate([128], "float32", "shared")
+            W_sh = T.Buffer(128, data=W_sh_data, scope="shared")
+            Z_sh[tx_1] = A[tx_1]
+            W_sh[tx_1] = B[tx_1]
+            T.tvm_storage_sync("shared")
+            A[tx_1] = Z_sh[127 - tx_1] * W_sh[127 - tx_1]
+
+    with tvm.transform.PassContext(config={"tir.merge_static_smem": True}):
+        after = tvm.tir.transform.MergeDynamicSharedMemoryAllocations()(
+            tvm.IRModule.from_expr(func)
+        )["main"]
+    # Each kernel gets its own merged static allocation
+    assert _shared_allocations(after) == [("shared", 1024), ("shared", 1024)]
+
+
 if __name__ == "__main__":
     tvm.testing.main()
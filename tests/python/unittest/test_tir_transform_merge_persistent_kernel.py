@@ -0,0 +1,100 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+import pytest
+
+import tvm
+import tvm.testing
+from tvm.script import tir as T
+
+
+def _collect(func):
+    launches, syncs, attrs = [], [], {}
+
+    def visit(node):
+        if isinstance(node, tvm.tir.AttrStmt):
+            if node.attr_key == "thread_extent":
+                launches.append((node.node.thread_tag, node.value.value))
+            else:
+                attrs[node.attr_key] = node.value
+        elif isinstance(node, tvm.tir.Call) and node.op.name == "tir.tvm_storage_sync":
+            syncs.append(node.args[0].value)
+
+    tvm.tir.stmt_functor.post_order_visit(func.body, visit)
+    return launches, syncs, attrs
+
+
+def _run(func, target):
+    mod = tvm.IRModule({"main": func.with_attr("target", tvm.target.Target(target))})
+    return tvm.tir.transform.MergePersistentKernel()(mod)["main"]
+
+
+def test_merge_dependent_kernels():
+    @T.prim_func
+    def func(A: T.Buffer(4096, "float32"), B: T.Buffer(4096, "float32")):
+        C = T.allocate([4096], "float32", "global")
+        C_1 = T.Buffer(4096, data=C)
+        with T.launch_thread("blockIdx.x", 64) as bx:
+            tx = T.launch_thread("threadIdx.x", 64)
+            C_1[bx * 64 + tx] = A[bx * 64 + tx] + T.float32(1)
+        with T.launch_thread("blockIdx.x", 64) as bx:
+            tx = T.launch_thread("threadIdx.x", 32)
+            for i in range(2):
+                B[bx * 64 + i * 32 + tx] = C_1[4095 - bx * 64 - i * 32 - tx]
+
+    merged = _run(func, "cuda -multi_processor_count=2")
+    launches, syncs, attrs = _collect(merged)
+    # 16 blocks of 64 threads per SM.
+    assert launches == [("threadIdx.x", 64), ("blockIdx.x", 32)]
+    assert syncs == ["global"]
+    assert attrs["persistent_kernel"].value == 16
+    assert "volatile_scope" in attrs
+    assert "tvm_global_barrier_kinit" in merged.script()
+
+
+def test_merge_independent_kernels():
+    @T.prim_func
+    def func(A: T.Buffer(256, "float32"), B: T.Buffer(256, "float32")):
+        with T.launch_thread("blockIdx.x", 4) as bx:
+            tx = T.launch_thread("threadIdx.x", 64)
+            A[bx * 64 + tx] = T.float32(0)
+        with T.launch_thread("blockIdx.x", 2) as bx:
+            tx = T.launch_thread("threadIdx.x", 128)
+            B[bx * 128 + tx] = T.float32(1)
+
+    launches, syncs, attrs = _collect(_run(func, "cuda -multi_processor_count=80"))
+    assert launches == [("threadIdx.x", 128), ("blockIdx.x", 4)]
+    assert syncs == []
+    assert attrs["persistent_kernel"].value == 8
+
+
+def test_keep_kernels_of_other_targets():
+    @T.prim_func
+    def func(A: T.Buffer(128, "float32")):
+        with T.launch_thread("threadIdx.x", 64) as tx:
+            A[tx] = T.float32(0)
+        with T.launch_thread("threadIdx.x", 64) as tx:
+            A[tx + 64] = T.float32(1)
+
+    launches, _, _ = _collect(_run(func, "vulkan"))
+    assert len(launches) == 2
+    with pytest.raises(tvm.TVMError):
+        _run(func, "cuda")
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
@@ -346,6 +346,33 @@ def test_block():
     tvm.ir.assert_structural_equal(after, expected_after)
 
 
+def test_dynamic_shape_guard():
+    @T.prim_func
+    def before(a: T.handle, b: T.handle):
+        n = T.int64()
+        A = T.match_buffer(a, (n,), "float32")
+        B = T.match_buffer(b, (n,), "float32")
+        for i in T.serial(n):
+            B[i] = A[i] + T.float32(1)
+
+    mod = tvm.IRModule.from_expr(before)
+    # Without the guard, the indices depending on the shape are not narrowed.
+    after = tvm.tir.transform.NarrowDataType(32)(mod)["main"]
+    assert isinstance(after.body, tvm.tir.For)
+    assert after.body.loop_var.dtype == "int64"
+
+    with tvm.transform.PassContext(config={"tir.narrow_datatype_guard": True}):
+        after = tvm.tir.transform.NarrowDataType(32)(mod)["main"]
+    n = after.buffer_map[after.params[0]].shape[0]
+    assert isinstance(after.body, tvm.tir.IfThenElse)
+    tvm.ir.assert_structural_equal(after.body.condition, n <= T.int64(2**31 - 1))
+    narrowed = after.body.then_case
+    assert isinstance(narrowed, tvm.tir.LetStmt)
+    assert narrowed.var.dtype == "int32"
+    assert narrowed.body.loop_var.dtype == "int32"
+    assert after.body.else_case.loop_var.dtype == "int64"
+
+
 def test_avg_pool2d():
     @T.prim_func
     def before(PSUM: T.Buffer((313600,), "int32"), PAVG: T.Buffer((313600,), "int32")):
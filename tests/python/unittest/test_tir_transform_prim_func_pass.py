@@ -63,6 +63,26 @@ def test_cow_pass():
     assert func_hash == mod["main"].__hash__()
 
 
+def test_parallel_prim_func_pass():
+    funcs = {}
+    for i in range(8):
+        x = te.var("x")
+        body = tvm.tir.Evaluate(tvm.tir.floordiv(x * (i + 2) + 1, i + 2))
+        funcs["func%d" % i] = tvm.tir.PrimFunc([x], body).with_attr("global_symbol", "func%d" % i)
+    mod = tvm.IRModule(funcs)
+    expected = tvm.tir.transform.Simplify()(mod)
+
+    with tvm.transform.PassContext(config={"transform.num_function_pass_threads": 4}):
+        actual = tvm.tir.transform.Simplify()(mod)
+        # passes written in python run sequentially
+        actual = tvm.tir.transform.Apply(lambda f: f)(actual)
+    tvm.ir.assert_structural_equal(actual, expected)
+    assert [gv.name_hint for gv in actual.get_global_vars()] == [
+        gv.name_hint for gv in expected.get_global_vars()
+    ]
+
+
 if __name__ == "__main__":
     test_cow_pass()
     test_prim_func_pass()
+    test_parallel_prim_func_pass()
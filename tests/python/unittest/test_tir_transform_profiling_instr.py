@@ -336,5 +336,26 @@ def test6():
     tvm.ir.assert_structural_equal(mod["main"], test6_expected_output)
 
 
+# test7: Run the instrumented loops of test1 on the CPU and decode the recorded events.
+@tvm.testing.requires_llvm
+def test7():
+    with tvm.transform.PassContext(config=default_lwp_test_config):
+        f = tvm.build(input1, target="llvm")
+    dev = tvm.cpu()
+    a = tvm.nd.array(numpy.ones((8, 8, 128), dtype="int32"), dev)
+    b = tvm.nd.empty((8, 8, 128), "int32", dev)
+    c = tvm.nd.empty((8, 8, 128), "int32", dev)
+    tvm.runtime.profiling.start_profile_intrinsics()
+    f(a, b, c)
+    report = tvm.runtime.profiling.stop_profile_intrinsics()
+    numpy.testing.assert_equal(c.numpy(), 4)
+
+    names = [call["Name"] for call in report.calls]
+    assert names.count("region_3") == 64
+    assert names.count("region_5") == 64
+    assert report.configuration["Dropped Events"].value == 0
+    assert "region_3" in report.table()
+
+
 if __name__ == "__main__":
     tvm.testing.main()
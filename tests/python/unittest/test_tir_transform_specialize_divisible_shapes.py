@@ -0,0 +1,78 @@
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+import numpy as np
+
+import tvm
+import tvm.testing
+from tvm import te
+
+
+def collect_visit(stmt, f):
+    ret = []
+    tvm.tir.stmt_functor.post_order_visit(stmt, lambda x: ret.append(f(x)))
+    return ret
+
+
+def _split_add(factor):
+    n = te.size_var("n")
+    A = te.placeholder((n,), name="A")
+    B = te.compute((n,), lambda i: A[i] + 1.0, name="B")
+    s = te.create_schedule(B.op)
+    if factor is not None:
+        s[B].split(B.op.axis[0], factor=factor)
+    return n, s, [A, B]
+
+
+def _schedule_to_module(n, s):
+    bounds = tvm.te.schedule.InferBound(s)
+    stmt = tvm.te.schedule.ScheduleOps(s, bounds)
+    return tvm.IRModule.from_expr(tvm.tir.PrimFunc([n], stmt))
+
+
+def test_specialize_split_loop():
+    n, s, _ = _split_add(8)
+    mod = tvm.tir.transform.SpecializeDivisibleShapes()(_schedule_to_module(n, s))
+    body = mod["main"].body
+    assert isinstance(body, tvm.tir.IfThenElse)
+    tvm.ir.assert_structural_equal(body.condition, tvm.tir.floormod(n, 8) == 0)
+    fast_path, fallback = body.then_case, body.else_case
+    assert not any(collect_visit(fast_path, lambda x: isinstance(x, tvm.tir.IfThenElse)))
+    assert any(collect_visit(fallback, lambda x: isinstance(x, tvm.tir.IfThenElse)))
+
+
+def test_no_tile_factor_unchanged():
+    n, s, _ = _split_add(None)
+    mod = _schedule_to_module(n, s)
+    after = tvm.tir.transform.SpecializeDivisibleShapes()(mod)
+    tvm.ir.assert_structural_equal(after, mod)
+
+
+@tvm.testing.requires_llvm
+def test_specialize_divisible_shapes_correct():
+    _, s, args = _split_add(8)
+    with tvm.transform.PassContext(config={"tir.specialize_divisible_shapes": True}):
+        func = tvm.build(s, args, "llvm")
+    dev = tvm.cpu()
+    for n in [16, 21]:
+        a = tvm.nd.array(np.random.uniform(size=n).astype("float32"), dev)
+        b = tvm.nd.array(np.zeros(n, dtype="float32"), dev)
+        func(a, b)
+        tvm.testing.assert_allclose(b.numpy(), a.numpy() + 1.0)
+
+
+if __name__ == "__main__":
+    tvm.testing.main()
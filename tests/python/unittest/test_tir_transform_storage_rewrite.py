@@ -926,5 +926,51 @@ class TestNoOrphanedDeclBuffer(BaseCompare):
             D[i] = C[i]
 
 
+def test_reuse_across_dtypes():
+    @T.prim_func
+    def func(A: T.Buffer(128, "int8"), E: T.Buffer(64, "int32")):
+        B_data = T.allocate([128], "int8", "global")
+        B = T.Buffer(128, "int8", data=B_data)
+        C_data = T.allocate([128], "int8", "global")
+        C = T.Buffer(128, "int8", data=C_data)
+        D_data = T.allocate([64], "int32", "global")
+        D = T.Buffer(64, "int32", data=D_data)
+        for i in range(128):
+            B[i] = A[i]
+        for i in range(128):
+            C[i] = B[127 - i]
+        for i in range(64):
+            D[i] = T.Cast("int32", C[i * 2])
+        for i in range(64):
+            E[i] = D[i]
+
+    def allocations(mod):
+        allocs = []
+        tvm.tir.stmt_functor.post_order_visit(
+            mod["main"].body,
+            lambda n: allocs.append(n) if isinstance(n, tvm.tir.Allocate) else None,
+        )
+        return allocs
+
+    mod = tvm.IRModule.from_expr(func)
+    # By default, the int32 buffer does not reuse the smaller int8 one.
+    assert len(allocations(tvm.tir.transform.StorageRewrite()(mod))) == 3
+
+    config = {"tir.StorageRewrite": {"reuse_across_dtypes": True, "report_reuse": True}}
+    with tvm.transform.PassContext(config=config):
+        after = tvm.tir.transform.StorageRewrite()(mod)
+    allocs = allocations(after)
+    assert len(allocs) == 2
+    # The shared storage is declared with the widest element type.
+    shared = [alloc for alloc in allocs if alloc.dtype == "int32"]
+    assert len(shared) == 1 and shared[0].extents[0].value == 64
+
+    report = after["main"].attrs["tir.storage_reuse"]
+    assert len(report) == 1
+    assert sorted(str(name) for name in report[0]["buffers"]) == ["B_data", "D_data"]
+    assert int(report[0]["bytes"]) == 256
+    assert int(report[0]["requested_bytes"]) == 384
+
+
 if __name__ == "__main__":
     tvm.testing.main()
@@ -175,9 +175,92 @@ def test_unroll_local_access():
     tvm.ir.assert_structural_equal(after, Expected)
 
 
+def test_unroll_max_instructions():
+    @tvm.script.ir_module
+    class Before:
+        @T.prim_func
+        def main(A: T.Buffer((16,), "float32"), B: T.Buffer((16,), "float32")):
+            for i in T.serial(16):
+                B[i] = A[i] + T.float32(1)
+
+    def num_loops(mod):
+        loops = []
+        tvm.tir.stmt_functor.post_order_visit(
+            mod["main"].body, lambda n: loops.append(n) if isinstance(n, tvm.tir.For) else None
+        )
+        return len(loops)
+
+    with tvm.transform.PassContext(config={"tir.UnrollLoop": {"auto_max_step": 64}}):
+        assert num_loops(tvm.tir.transform.UnrollLoop()(Before)) == 0
+
+    # The 16 iterations of a load, an add and a store exceed the budget.
+    config = {"tir.UnrollLoop": {"auto_max_step": 64, "auto_max_instructions": 32}}
+    with tvm.transform.PassContext(config=config):
+        assert num_loops(tvm.tir.transform.UnrollLoop()(Before)) == 1
+
+
+def test_unroll_and_jam():
+    @tvm.script.ir_module
+    class Before:
+        @T.prim_func
+        def main(
+            A: T.Buffer((10, 8), "float32"),
+            B: T.Buffer((8,), "float32"),
+            C: T.Buffer((10, 8), "float32"),
+        ):
+            with T.attr(0, "pragma_unroll_and_jam", 4):
+                for i in T.serial(10):
+                    for j in T.serial(8):
+                        C[i, j] = A[i, j] * B[j]
+
+    @tvm.script.ir_module
+    class Expected:
+        @T.prim_func
+        def main(
+            A: T.Buffer((10, 8), "float32"),
+            B: T.Buffer((8,), "float32"),
+            C: T.Buffer((10, 8), "float32"),
+        ):
+            for i_outer, j in T.grid(2, 8):
+                C[i_outer * 4, j] = A[i_outer * 4, j] * B[j]
+                C[i_outer * 4 + 1, j] = A[i_outer * 4 + 1, j] * B[j]
+                C[i_outer * 4 + 2, j] = A[i_outer * 4 + 2, j] * B[j]
+                C[i_outer * 4 + 3, j] = A[i_outer * 4 + 3, j] * B[j]
+            for i in T.serial(8, 10):
+                for j in T.serial(8):
+                    C[i, j] = A[i, j] * B[j]
+
+    after = tvm.tir.transform.UnrollLoop()(Before)
+    after = tvm.tir.transform.Simplify()(after)
+    tvm.ir.assert_structural_equal(after, Expected)
+
+
+def test_unroll_and_jam_overlapping_writes():
+    @tvm.script.ir_module
+    class Before:
+        @T.prim_func
+        def main(A: T.Buffer((4, 4), "float32"), C: T.Buffer((8,), "float32")):
+            with T.attr(0, "pragma_unroll_and_jam", 2):
+                for i in T.serial(4):
+                    for j in T.serial(4):
+                        C[i + j] = C[i + j] + A[i, j]
+
+    loops = []
+    tvm.tir.stmt_functor.post_order_visit(
+        tvm.tir.transform.UnrollLoop()(Before)["main"].body,
+        lambda n: loops.append(n) if isinstance(n, tvm.tir.For) else None,
+    )
+    # Iterations i and i + 1 write the same elements, so the outer loop is unrolled by 2
+    # without jamming the copies of the inner loop.
+    assert len(loops) == 3
+
+
 if __name__ == "__main__":
     test_unroll_local_access()
     test_unroll_loop()
     test_unroll_fake_loop()
     test_unroll_single_count_loops()
     test_unroll_allocations()
+    test_unroll_max_instructions()
+    test_unroll_and_jam()
+    test_unroll_and_jam_overlapping_writes()
@@ -226,6 +226,59 @@ def test_vectorize_dtype_mismatch():
     tvm.lower(s, [A], "llvm", simple_mode=True)
 
 
+def test_vectorize_tail_predication():
+    n = te.var("n")
+    ib = tvm.tir.ir_builder.create()
+    A = ib.buffer_ptr(tvm.tir.decl_buffer((n,), "float32", name="A"))
+    B = ib.buffer_ptr(tvm.tir.decl_buffer((n,), "float32", name="B"))
+    with ib.for_range(0, tvm.tir.indexdiv(n + 15, 16), name="xo") as xo:
+        with ib.for_range(0, 16, kind="vectorize", name="xi") as xi:
+            with ib.if_scope(tvm.tir.likely(xo * 16 + xi < n)):
+                B[xo * 16 + xi] = A[xo * 16 + xi] + 1.0
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A.buffer, B.buffer, n], ib.get()))
+
+    def find_accesses(stmt):
+        accesses = []
+
+        def fvisit(node):
+            if isinstance(node, (tvm.tir.BufferLoad, tvm.tir.BufferStore)):
+                accesses.append(node)
+
+        tvm.tir.stmt_functor.post_order_visit(stmt, fvisit)
+        return accesses
+
+    # Without predication the guarded body is scalarized.
+    body = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert all(access.predicate is None for access in find_accesses(body))
+    assert isinstance(body.body, tvm.tir.For)
+
+    with tvm.transform.PassContext(config={"tir.enable_buffer_level_predication": True}):
+        body = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(body.body, tvm.tir.BufferStore)
+    accesses = find_accesses(body)
+    assert len(accesses) == 2
+    for access in accesses:
+        assert isinstance(access.indices[0], tvm.tir.Ramp)
+        assert access.predicate is not None
+        assert access.predicate.dtype == "boolx16"
+
+
+def test_vectorize_scalable():
+    assert tvm.DataType("float32xvscalex4").vscale_factor == 4
+    assert str(tvm.DataType("float32xvscalex4")) == "float32xvscalex4"
+
+    ib = tvm.tir.ir_builder.create()
+    A = ib.buffer_ptr(tvm.tir.decl_buffer((64,), "float32", name="A"))
+    B = ib.buffer_ptr(tvm.tir.decl_buffer((64,), "float32", name="B"))
+    with ib.for_range(0, 4 * tvm.tir.vscale(), kind="vectorize", name="x") as x:
+        B[x] = A[x] + 1.0
+    mod = tvm.IRModule.from_expr(tvm.tir.PrimFunc([A.buffer, B.buffer], ib.get()))
+    stmt = tvm.tir.transform.VectorizeLoop()(mod)["main"].body
+    assert isinstance(stmt, tvm.tir.BufferStore)
+    assert isinstance(stmt.indices[0], tvm.tir.Ramp)
+    assert stmt.value.dtype == "float32xvscalex4"
+
+
 if __name__ == "__main__":
     test_vectorize_vector()
     test_vectorize_with_if()
@@ -236,3 +289,5 @@ if __name__ == "__main__":
     test_vectorize_let()
     test_vectorize_while_fail()
     test_vectorize_dtype_mismatch()
+    test_vectorize_tail_predication()
+    test_vectorize_scalable()
@@ -161,7 +161,7 @@ def test_name_based_ordering(algorithm):
 
 @pytest.mark.parametrize(
     ["algorithm", "workspace_size"],
-    [("greedy_by_size", 140), ("greedy_by_conflicts", 140), ("hill_climb", 140)],
+    [("greedy_by_size", 140), ("greedy_by_conflicts", 140), ("hill_climb", 140), ("optimal", 140)],
 )
 def test_linear(algorithm, workspace_size):
     """
@@ -292,6 +292,98 @@ def test_fanout(algorithm, workspace_size):
     _check_max_workspace_size(buffer_pool_allocations, global_workspace_pool, workspace_size)
 
 
+def test_optimal():
+    """
+    The test case here represent BufferInfo objects of an interval graph
+    where placing the largest buffers first is not optimal. The optimal
+    size is the total size of the clique bi_a, bi_b, bi_d, bi_e, bi_f.
+    """
+    target = Target("c")
+    global_workspace_pool = WorkspacePoolInfo(
+        "global_workspace",
+        targets=[target],
+    )
+    sizes = {"bi_a": 48, "bi_b": 16, "bi_c": 16, "bi_d": 64, "bi_e": 32, "bi_f": 48}
+    buffer_infos = {
+        name: usmp_utils.BufferInfo(
+            name_hint=name, size_bytes=size, pool_candidates=[global_workspace_pool]
+        )
+        for name, size in sizes.items()
+    }
+    conflicts = {
+        "bi_a": ["bi_b", "bi_d", "bi_e", "bi_f"],
+        "bi_b": ["bi_a", "bi_c", "bi_d", "bi_e", "bi_f"],
+        "bi_c": ["bi_b", "bi_e", "bi_f"],
+        "bi_d": ["bi_a", "bi_b", "bi_e", "bi_f"],
+        "bi_e": ["bi_a", "bi_b", "bi_c", "bi_d", "bi_f"],
+        "bi_f": ["bi_a", "bi_b", "bi_c", "bi_d", "bi_e"],
+    }
+    for name, conflict_names in conflicts.items():
+        buffer_infos[name].set_conflicts([buffer_infos[c] for c in conflict_names])
+
+    buffer_info_arr = list(buffer_infos.values())
+    fusmp_algo = tvm.get_global_func("tir.usmp.algo.optimal")
+    buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
+    _check_max_workspace_size(buffer_pool_allocations, global_workspace_pool, 208)
+
+    lower_bounds = tvm.get_global_func("tir.usmp.algo.pool_size_lower_bounds")(
+        buffer_info_arr, buffer_pool_allocations
+    )
+    assert lower_bounds[global_workspace_pool] == 208
+
+    # A time budget too small to search still returns a valid allocation
+    with tvm.transform.PassContext(config={"tir.usmp.optimal_time_budget_ms": 0}):
+        buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
+    for buffer_info, pool_allocation in buffer_pool_allocations.items():
+        for conflict in buffer_info.conflicts:
+            conflict_allocation = buffer_pool_allocations[conflict]
+            assert (
+                pool_allocation.byte_offset + buffer_info.size_bytes
+                <= conflict_allocation.byte_offset
+                or conflict_allocation.byte_offset + conflict.size_bytes
+                <= pool_allocation.byte_offset
+            )
+
+
+def test_access_aware():
+    """
+    The test case here represent a small fast pool and a large slow pool, where
+    placing the largest buffer first would leave the frequently accessed buffer
+    in the slow pool.
+    """
+    target = Target("c")
+    fast_memory_pool = WorkspacePoolInfo(
+        "fast_memory",
+        [target],
+        PoolInfoProperties(size_hint_bytes=100, read_latency_cycles=1, write_latency_cycles=1),
+    )
+    slow_memory_pool = WorkspacePoolInfo(
+        "slow_memory",
+        [target],
+        PoolInfoProperties(read_latency_cycles=10, write_latency_cycles=10),
+    )
+    bi_cold = usmp_utils.BufferInfo(
+        name_hint="bi_cold", size_bytes=100, pool_candidates=[slow_memory_pool, fast_memory_pool]
+    )
+    bi_hot = usmp_utils.BufferInfo(
+        name_hint="bi_hot", size_bytes=60, pool_candidates=[slow_memory_pool, fast_memory_pool]
+    )
+    bi_cold.set_access_count(10)
+    bi_hot.set_access_count(10000)
+    bi_cold.set_conflicts([bi_hot])
+    bi_hot.set_conflicts([bi_cold])
+    buffer_info_arr = [bi_cold, bi_hot]
+
+    tvm.get_global_func("tir.usmp.algo.assign_pools_by_access_cost")(buffer_info_arr)
+    assert list(bi_hot.pool_candidates) == [fast_memory_pool, slow_memory_pool]
+    assert list(bi_cold.pool_candidates) == [slow_memory_pool]
+
+    fusmp_algo = tvm.get_global_func("tir.usmp.algo.greedy_by_size")
+    buffer_pool_allocations = fusmp_algo(buffer_info_arr, 0)
+    assert buffer_pool_allocations[bi_hot].pool_info == fast_memory_pool
+    assert buffer_pool_allocations[bi_cold].pool_info == slow_memory_pool
+
+
 # fmt: off
 @tvm.script.ir_module
 class MobilenetStructure:
@@ -48,5 +48,26 @@ class Module:
     )
 
 
+def test_ir_module_script_to_file(tmp_path):
+    from tvm.script import ir as I_, tir as T_  # pylint: disable=import-outside-toplevel
+
+    @I_.ir_module
+    class Module:  # pylint: disable=too-few-public-methods
+        @T_.prim_func
+        def add(A: T_.Buffer((8,), "float32"), B: T_.Buffer((8,), "float32")):
+            for i in range(8):
+                B[i] = A[i] + T_.float32(1)
+
+        @T_.prim_func
+        def main(A: T_.Buffer((8,), "float32"), B: T_.Buffer((8,), "float32")):
+            for i in range(8):
+                B[i] = A[i] * T_.float32(2)
+
+    path = str(tmp_path / "module.py")
+    Module.script_to_file(path)
+    with open(path) as f:  # pylint: disable=unspecified-encoding
+        assert f.read().strip() == Module.script().strip()
+
+
 if __name__ == "__main__":
     test_ir_module()
@@ -155,6 +155,12 @@ class WebGPUModuleNode final : public runtime::ModuleNode {
     auto* fp = tvm::runtime::Registry::Get("wasm.WebGPUCreateShader");
     CHECK(fp != nullptr);
     create_shader_ = *fp;
+    // Compile all the pipelines in parallel in the background, ahead of their first call.
+    if (auto* fprecompile = tvm::runtime::Registry::Get("wasm.WebGPUPrecompileShader")) {
+      for (const auto& kv : smap_) {
+        (*fprecompile)(FunctionInfoJSON(kv.first), kv.second);
+      }
+    }
   }
 
   const char* type_key() const final { return "webgpu"; }
@@ -162,12 +168,7 @@ class WebGPUModuleNode final : public runtime::ModuleNode {
   PackedFunc GetFunction(const String& name, const ObjectPtr<Object>& sptr_to_self) final {
     auto it = smap_.find(name);
     if (it != smap_.end()) {
-      FunctionInfo info = fmap_.at(name);
-      info.name = name;
-      std::ostringstream os;
-      dmlc::JSONWriter writer(&os);
-      info.Save(&writer);
-      return create_shader_(os.str(), it->second);
+      return create_shader_(FunctionInfoJSON(name), it->second);
     } else {
       return PackedFunc(nullptr);
     }
@@ -185,6 +186,15 @@ class WebGPUModuleNode final : public runtime::ModuleNode {
   }
 
  private:
+  std::string FunctionInfoJSON(const std::string& name) const {
+    FunctionInfo info = fmap_.at(name);
+    info.name = name;
+    std::ostringstream os;
+    dmlc::JSONWriter writer(&os);
+    info.Save(&writer);
+    return os.str();
+  }
+
   // function information table.
   std::unordered_map<std::string, std::string> smap_;
   // function information table.
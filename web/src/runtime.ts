@@ -1370,9 +1370,15 @@ export class Instance implements Disposable {
     this.registerFunc("wasm.WebGPUCreateShader", (info: string, code: string) => {
       return webGPUContext.createShader(info, code);
     });
+    this.registerFunc("wasm.WebGPUPrecompileShader", (info: string, code: string) => {
+      webGPUContext.precompileShader(info, code);
+    });
     this.registerAsyncServerFunc("wasm.WebGPUWaitForTasks", async () => {
       await webGPUContext.sync();
     });
+    this.registerAsyncServerFunc("wasm.WebGPUWaitForPipelines", async () => {
+      await webGPUContext.waitForPipelines();
+    });
     this.lib.webGPUContext = webGPUContext;
   }
 
@@ -42,6 +42,31 @@ interface FunctionInfo {
   launch_param_tags: Array<string>;
 }
 
+/** The pipeline of a shader, with the layout of its arguments. */
+interface ShaderPipeline {
+  bindGroupLayout: GPUBindGroupLayout;
+  pipeline: GPUComputePipeline;
+}
+
+/** A bind group, with the argument buffers it binds. */
+interface CachedBindGroup {
+  buffers: Array<GPUBuffer>;
+  bindGroup: GPUBindGroup;
+}
+
+/**
+ * Round an allocation size up to its pool bucket.
+ *
+ * There are four buckets per power of two, so a pooled buffer
+ * wastes at most a quarter of its size.
+ */
+function bufferBucketSize(nbytes: number): number {
+  const minBucket = 256;
+  if (nbytes <= minBucket) return minBucket;
+  const step = Math.pow(2, Math.floor(Math.log2(nbytes)) - 2);
+  return Math.ceil(nbytes / step) * step;
+}
+
 /**
  * WebGPU context
  * Manages all the webgpu resources here.
@@ -55,10 +80,23 @@ export class WebGPUContext {
   private bufferTableFreeId: Array<number> = [];
   private pendingRead: Promise<void> = Promise.resolve();
   private numPendingReads = 0;
+  // pipelines keyed by shader, the precompiled ones are filled in asynchronously.
+  private pipelineCache: Map<string, ShaderPipeline> = new Map();
+  private pendingPipelines: Array<Promise<void>> = [];
+  // freed buffers kept for reuse, keyed by bucket size.
+  private bufferPool: Map<number, Array<GPUBuffer>> = new Map();
+  private bufferPoolBytes = 0;
+  private maxBufferPoolBytes: number;
 
-  constructor(memory: Memory, device: GPUDevice) {
+  /**
+   * @param memory The memory of the runtime.
+   * @param device The GPU device.
+   * @param maxBufferPoolBytes The maximum total size of the freed buffers kept for reuse.
+   */
+  constructor(memory: Memory, device: GPUDevice, maxBufferPoolBytes = 1 << 28) {
     this.memory = memory;
     this.device = device;
+    this.maxBufferPoolBytes = maxBufferPoolBytes;
   }
 
   /**
@@ -76,43 +114,72 @@ export class WebGPUContext {
   }
 
   /**
-   * Create a PackedFunc that runs the given shader
+   * Wait for the shaders being precompiled.
+   */
+  async waitForPipelines(): Promise<void> {
+    const pending = this.pendingPipelines;
+    this.pendingPipelines = [];
+    await Promise.all(pending);
+  }
+
+  /**
+   * Release the freed buffers kept for reuse.
+   */
+  releaseBufferPool(): void {
+    this.bufferPool.forEach((buffers) => {
+      buffers.forEach((buffer) => buffer.destroy());
+    });
+    this.bufferPool.clear();
+    this.bufferPoolBytes = 0;
+  }
+
+  /**
+   * Start compiling the pipeline of a shader in the background,
+   * so that the first call of the shader does not compile it.
    *
    * @param info The function information in json.
    * @param code The shader data(in WGSL)
    */
-  createShader(info: string, code: string): Function {
-    const finfo = JSON.parse(info);
-    const layoutEntries: Array<GPUBindGroupLayoutEntry> = [];
-    for (let i = 0; i < finfo.arg_types.length; ++i) {
-      const dtype = finfo.arg_types[i];
-      if (dtype == "handle") {
-        layoutEntries.push({
-          binding: i,
-          visibility: GPUShaderStage.COMPUTE,
-          buffer :  {
-            type: "storage"
-          }
-        });
-      } else {
-        throw new Error("Cannot handle argument type " + dtype + " in WebGPU shader");
+  precompileShader(info: string, code: string): void {
+    const finfo: FunctionInfo = JSON.parse(info);
+    const key = finfo.name + "\n" + code;
+    if (this.pipelineCache.has(key)) return;
+    const bindGroupLayout = this.createBindGroupLayout(finfo);
+    const task = this.device.createComputePipelineAsync(
+      this.pipelineDescriptor(bindGroupLayout, code)
+    ).then((pipeline: GPUComputePipeline) => {
+      if (!this.pipelineCache.has(key)) {
+        this.pipelineCache.set(key, { bindGroupLayout: bindGroupLayout, pipeline: pipeline });
       }
-    }
-    const bindGroupLayout = this.device.createBindGroupLayout({
-      entries: layoutEntries
+    }).catch((err: Error) => {
+      // leave it to the synchronous compilation on first call, which reports the error.
+      console.warn("Failed to precompile shader " + finfo.name + ": " + err.message);
     });
+    this.pendingPipelines.push(task);
+  }
 
-    const pipeline = this.device.createComputePipeline({
-      layout: this.device.createPipelineLayout({
-        bindGroupLayouts: [ bindGroupLayout ]
-      }),
-      compute: {
-        module: this.device.createShaderModule({
-          code: code
-        }),
-        entryPoint: "main"
-      }
-    });
+  /**
+   * Create a PackedFunc that runs the given shader
+   *
+   * @param info The function information in json.
+   * @param code The shader data(in WGSL)
+   */
+  createShader(info: string, code: string): Function {
+    const finfo: FunctionInfo = JSON.parse(info);
+    const key = finfo.name + "\n" + code;
+    let cached = this.pipelineCache.get(key);
+    if (cached === undefined) {
+      // not precompiled, or still compiling.
+      const layout = this.createBindGroupLayout(finfo);
+      cached = {
+        bindGroupLayout: layout,
+        pipeline: this.device.createComputePipeline(this.pipelineDescriptor(layout, code))
+      };
+      this.pipelineCache.set(key, cached);
+    }
+    const bindGroupLayout = cached.bindGroupLayout;
+    const pipeline = cached.pipeline;
+    const numBufferArgs = finfo.arg_types.length;
 
     const dispatchToDim: Array<number> = [];
 
@@ -131,29 +198,49 @@ export class WebGPUContext {
       }
     }
 
-    const submitShader = (...args: Array<GPUPointer | number>): void => {
-      const commandEncoder = this.device.createCommandEncoder();
-      const compute = commandEncoder.beginComputePass();
-      compute.setPipeline(pipeline);
+    // bind groups keyed by the argument pointers, which are reused by other buffers
+    // once freed, hence the check of the buffers on lookup.
+    const bindGroupCache: Map<string, CachedBindGroup> = new Map();
+    const maxCachedBindGroups = 64;
+    const getBindGroup = (args: Array<GPUPointer | number>): GPUBindGroup => {
+      const buffers: Array<GPUBuffer> = [];
+      for (let i = 0; i < numBufferArgs; ++i) {
+        buffers.push(this.gpuBufferFromPtr(args[i]));
+      }
+      const key = args.slice(0, numBufferArgs).join(",");
+      const entry = bindGroupCache.get(key);
+      if (entry !== undefined && entry.buffers.every((b, i) => b === buffers[i])) {
+        return entry.bindGroup;
+      }
       const bindGroupEntries: Array<GPUBindGroupEntry> = [];
-      assert(args.length == layoutEntries.length + dispatchToDim.length);
-
-      for (let i = 0; i < layoutEntries.length; ++i) {
+      for (let i = 0; i < numBufferArgs; ++i) {
         bindGroupEntries.push({
           binding: i,
           resource: {
-            buffer: this.gpuBufferFromPtr(args[i])
+            buffer: buffers[i]
           }
         });
       }
-
-      compute.setBindGroup(0, this.device.createBindGroup({
+      const bindGroup = this.device.createBindGroup({
         layout: bindGroupLayout,
         entries: bindGroupEntries
-      }));
+      });
+      if (entry === undefined && bindGroupCache.size >= maxCachedBindGroups) {
+        bindGroupCache.clear();
+      }
+      bindGroupCache.set(key, { buffers: buffers, bindGroup: bindGroup });
+      return bindGroup;
+    };
+
+    const submitShader = (...args: Array<GPUPointer | number>): void => {
+      const commandEncoder = this.device.createCommandEncoder();
+      const compute = commandEncoder.beginComputePass();
+      compute.setPipeline(pipeline);
+      assert(args.length == numBufferArgs + dispatchToDim.length);
+      compute.setBindGroup(0, getBindGroup(args));
       const wl: Array<number> = [1, 1, 1, 1, 1, 1];
       for (let i = 0; i < dispatchToDim.length; ++i) {
-        wl[dispatchToDim[i]] = args[layoutEntries.length + i];
+        wl[dispatchToDim[i]] = args[numBufferArgs + i];
       }
       compute.dispatchWorkgroups(wl[0], wl[1], wl[2])
       compute.end()
@@ -164,6 +251,44 @@ export class WebGPUContext {
     return submitShader;
   }
 
+  private createBindGroupLayout(finfo: FunctionInfo): GPUBindGroupLayout {
+    const layoutEntries: Array<GPUBindGroupLayoutEntry> = [];
+    for (let i = 0; i < finfo.arg_types.length; ++i) {
+      const dtype = finfo.arg_types[i];
+      if (dtype == "handle") {
+        layoutEntries.push({
+          binding: i,
+          visibility: GPUShaderStage.COMPUTE,
+          buffer :  {
+            type: "storage"
+          }
+        });
+      } else {
+        throw new Error("Cannot handle argument type " + dtype + " in WebGPU shader");
+      }
+    }
+    return this.device.createBindGroupLayout({
+      entries: layoutEntries
+    });
+  }
+
+  private pipelineDescriptor(
+    bindGroupLayout: GPUBindGroupLayout,
+    code: string
+  ): GPUComputePipelineDescriptor {
+    return {
+      layout: this.device.createPipelineLayout({
+        bindGroupLayouts: [ bindGroupLayout ]
+      }),
+      compute: {
+        module: this.device.createShaderModule({
+          code: code
+        }),
+        entryPoint: "main"
+      }
+    };
+  }
+
   /**
    * Get the device API according to its name
    * @param The name of the API.
@@ -214,8 +339,15 @@ export class WebGPUContext {
 
   // DeviceAPI
   private deviceAllocDataSpace(nbytes: number): GPUPointer {
+    const size = bufferBucketSize(nbytes);
+    const pooled = this.bufferPool.get(size);
+    if (pooled !== undefined && pooled.length != 0) {
+      const buffer = pooled.pop() as GPUBuffer;
+      this.bufferPoolBytes -= size;
+      return this.attachToBufferTable(buffer);
+    }
     const buffer = this.device.createBuffer({
-      size: nbytes,
+      size: size,
       usage: GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST,
     });
     return this.attachToBufferTable(buffer);
@@ -227,7 +359,18 @@ export class WebGPUContext {
     this.bufferTable[idx] = undefined;
     assert(buffer !== undefined);
     this.bufferTableFreeId.push(idx);
-    buffer.destroy();
+    // the queue orders the work of the next owner after the pending work on the buffer.
+    if (this.bufferPoolBytes + buffer.size <= this.maxBufferPoolBytes) {
+      const pooled = this.bufferPool.get(buffer.size);
+      if (pooled === undefined) {
+        this.bufferPool.set(buffer.size, [buffer]);
+      } else {
+        pooled.push(buffer);
+      }
+      this.bufferPoolBytes += buffer.size;
+    } else {
+      buffer.destroy();
+    }
   }
 
   private deviceCopyToGPU(